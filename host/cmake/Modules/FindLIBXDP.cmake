@@ -0,0 +1,41 @@
+#
+# Copyright 2020 Ettus Research, a National Instruments Brand
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+# - Find libxdp (and libbpf, which it depends on) for AF_XDP sockets
+# This module defines
+#  LIBXDP_INCLUDE_DIRS, where to find xdp/xsk.h
+#  LIBXDP_LIBRARIES, the libraries needed to use AF_XDP sockets
+#  LIBXDP_FOUND, If false, do not try to use libxdp.
+# Override LIBXDP_INCLUDE_DIRS and LIBXDP_LIBRARIES to manually set
+
+include(FindPkgConfig)
+pkg_check_modules(PC_LIBXDP QUIET libxdp)
+pkg_check_modules(PC_LIBBPF QUIET libbpf)
+
+find_path(LIBXDP_INCLUDE_DIRS
+    NAMES xdp/xsk.h
+    HINTS $ENV{LIBXDP_DIR}/include ${PC_LIBXDP_INCLUDEDIR}
+    PATHS /usr/local/include /usr/include
+)
+
+find_library(LIBXDP_LIBRARY
+    NAMES xdp
+    HINTS $ENV{LIBXDP_DIR}/lib ${PC_LIBXDP_LIBDIR}
+    PATHS /usr/local/lib /usr/lib
+)
+
+find_library(LIBBPF_LIBRARY
+    NAMES bpf
+    HINTS $ENV{LIBBPF_DIR}/lib ${PC_LIBBPF_LIBDIR}
+    PATHS /usr/local/lib /usr/lib
+)
+
+if(NOT LIBXDP_LIBRARIES AND LIBXDP_LIBRARY AND LIBBPF_LIBRARY)
+    set(LIBXDP_LIBRARIES ${LIBXDP_LIBRARY} ${LIBBPF_LIBRARY})
+endif()
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(LIBXDP DEFAULT_MSG LIBXDP_LIBRARIES LIBXDP_INCLUDE_DIRS)
+mark_as_advanced(LIBXDP_INCLUDE_DIRS LIBXDP_LIBRARIES LIBXDP_LIBRARY LIBBPF_LIBRARY)
@@ -0,0 +1,464 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+// Benchmark of the control path: register access rate and latency through
+// the control endpoint of a radio block, timed-command throughput, and the
+// latency of common multi_usrp calls.
+
+#include <uhd/exception.hpp>
+#include <uhd/rfnoc/radio_control.hpp>
+#include <uhd/usrp/multi_usrp.hpp>
+#include <uhd/utils/safe_main.hpp>
+#include <uhd/utils/thread.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace po = boost::program_options;
+
+namespace {
+
+// Registers of the radio block (see rfnoc_block_radio_regs.vh). The compat
+// number is read-only. Writing the TX idle value back unchanged has no effect.
+constexpr uint32_t REG_COMPAT_NUM    = 0x0000;
+constexpr uint32_t REG_TX_IDLE_VALUE = 0x1000 + 0x40;
+
+//! Timeout for the future of an async transaction
+constexpr auto ASYNC_TIMEOUT = std::chrono::seconds(1);
+
+/***********************************************************************
+ * Results
+ **********************************************************************/
+//! The result of one test
+struct result_t
+{
+    std::string name;
+    std::string path;
+    //! Latency of each operation in microseconds. Empty for throughput tests.
+    std::vector<double> latencies_us;
+    size_t num_ops      = 0;
+    double total_time_s = 0.0;
+
+    double get_rate() const
+    {
+        return total_time_s > 0 ? num_ops / total_time_s : 0.0;
+    }
+
+    //! Return the latency at percentile p (0 to 100), using the nearest rank
+    double get_percentile(const double p) const
+    {
+        if (latencies_us.empty()) {
+            return 0.0;
+        }
+        std::vector<double> sorted = latencies_us;
+        std::sort(sorted.begin(), sorted.end());
+        const size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+        return sorted[std::min(std::max<size_t>(rank, 1), sorted.size()) - 1];
+    }
+
+    double get_mean() const
+    {
+        if (latencies_us.empty()) {
+            return 0.0;
+        }
+        return std::accumulate(latencies_us.begin(), latencies_us.end(), 0.0)
+               / latencies_us.size();
+    }
+};
+
+using clock_type = std::chrono::steady_clock;
+
+inline double elapsed_us(const clock_type::time_point& start)
+{
+    return std::chrono::duration<double, std::micro>(clock_type::now() - start).count();
+}
+
+//! Time each call of op, run num_iters times after num_warmup untimed calls
+result_t time_op(const std::string& name,
+    const std::string& path,
+    const size_t num_iters,
+    const size_t num_warmup,
+    const std::function<void(size_t)>& op)
+{
+    for (size_t i = 0; i < num_warmup; i++) {
+        op(i);
+    }
+    result_t result;
+    result.name = name;
+    result.path = path;
+    result.latencies_us.reserve(num_iters);
+    const auto start = clock_type::now();
+    for (size_t i = 0; i < num_iters; i++) {
+        const auto op_start = clock_type::now();
+        op(i);
+        result.latencies_us.push_back(elapsed_us(op_start));
+    }
+    result.num_ops      = num_iters;
+    result.total_time_s = elapsed_us(start) / 1e6;
+    return result;
+}
+
+//! Time a batch of num_ops operations as a whole
+result_t time_batch(const std::string& name,
+    const std::string& path,
+    const size_t num_ops,
+    const std::function<void()>& batch)
+{
+    result_t result;
+    result.name         = name;
+    result.path         = path;
+    result.num_ops      = num_ops;
+    const auto start    = clock_type::now();
+    batch();
+    result.total_time_s = elapsed_us(start) / 1e6;
+    return result;
+}
+
+void print_results(const std::vector<result_t>& results)
+{
+    std::cout << boost::format("\n%-22s %-6s %12s %9s %9s %9s %9s %9s") % "Test"
+                     % "Path" % "Rate [op/s]" % "Mean" % "p50" % "p90" % "p99"
+                     % "Max"
+              << std::endl;
+    std::cout << std::string(92, '-') << std::endl;
+    for (const auto& result : results) {
+        std::cout << boost::format("%-22s %-6s %12.1f") % result.name % result.path
+                         % result.get_rate();
+        if (!result.latencies_us.empty()) {
+            std::cout << boost::format(" %9.1f %9.1f %9.1f %9.1f %9.1f")
+                             % result.get_mean() % result.get_percentile(50)
+                             % result.get_percentile(90) % result.get_percentile(99)
+                             % result.get_percentile(100);
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "(Latencies in microseconds)" << std::endl;
+}
+
+void write_json(const std::string& filename,
+    const std::string& args,
+    const std::vector<result_t>& results)
+{
+    std::ofstream out(filename);
+    if (!out) {
+        throw uhd::os_error("Could not open " + filename);
+    }
+    out << "{\n  \"args\": \"" << args << "\",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const result_t& result = results[i];
+        out << (i ? ",\n" : "\n") << "    {\"name\": \"" << result.name
+            << "\", \"path\": \"" << result.path
+            << "\", \"num_ops\": " << result.num_ops
+            << ", \"total_time_s\": " << result.total_time_s
+            << ", \"rate\": " << result.get_rate();
+        if (!result.latencies_us.empty()) {
+            out << ", \"latency_us\": {\"mean\": " << result.get_mean()
+                << ", \"min\": " << result.get_percentile(0)
+                << ", \"p50\": " << result.get_percentile(50)
+                << ", \"p90\": " << result.get_percentile(90)
+                << ", \"p99\": " << result.get_percentile(99)
+                << ", \"max\": " << result.get_percentile(100) << "}";
+        }
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+/***********************************************************************
+ * Tests
+ **********************************************************************/
+//! Register access through the control endpoint of the radio block
+void benchmark_regs(uhd::usrp::multi_usrp::sptr usrp,
+    uhd::rfnoc::radio_control& radio,
+    const std::vector<std::string>& tests,
+    const size_t num_iters,
+    const size_t batch_size,
+    const double timed_lead,
+    const double timed_spacing,
+    std::vector<result_t>& results)
+{
+    auto& regs              = radio.regs();
+    const size_t num_warmup = std::min<size_t>(num_iters, 10);
+    auto has_test           = [&tests](const std::string& test) {
+        return std::find(tests.begin(), tests.end(), test) != tests.end();
+    };
+    const uint32_t idle_value = regs.peek32(REG_TX_IDLE_VALUE);
+
+    if (has_test("peek")) {
+        std::cout << "Timing peek32()..." << std::endl;
+        results.push_back(time_op("peek32", "sync", num_iters, num_warmup, [&](size_t) {
+            regs.peek32(REG_COMPAT_NUM);
+        }));
+        results.push_back(
+            time_op("peek32", "async", num_iters, num_warmup, [&](size_t) {
+                auto result = regs.peek32_async(REG_COMPAT_NUM);
+                if (result.wait_for(ASYNC_TIMEOUT) != std::future_status::ready) {
+                    throw uhd::op_timeout("Timeout while waiting for peek32_async()");
+                }
+                result.get();
+            }));
+        // Throughput with many reads in flight
+        results.push_back(time_batch("peek32 pipelined", "async", num_iters, [&]() {
+            std::vector<std::future<uint32_t>> pending;
+            pending.reserve(num_iters);
+            for (size_t i = 0; i < num_iters; i++) {
+                pending.push_back(regs.peek32_async(REG_COMPAT_NUM));
+            }
+            for (auto& result : pending) {
+                result.get();
+            }
+        }));
+    }
+
+    if (has_test("poke")) {
+        std::cout << "Timing poke32()..." << std::endl;
+        results.push_back(
+            time_op("poke32 (ack)", "sync", num_iters, num_warmup, [&](size_t) {
+                regs.poke32(REG_TX_IDLE_VALUE, idle_value, uhd::time_spec_t::ASAP, true);
+            }));
+        results.push_back(time_op("poke32", "sync", num_iters, num_warmup, [&](size_t) {
+            regs.poke32(REG_TX_IDLE_VALUE, idle_value);
+        }));
+        results.push_back(time_batch("poke32 pipelined", "async", num_iters, [&]() {
+            std::vector<std::future<void>> pending;
+            pending.reserve(num_iters);
+            for (size_t i = 0; i < num_iters; i++) {
+                pending.push_back(regs.poke32_async(REG_TX_IDLE_VALUE, idle_value));
+            }
+            for (auto& result : pending) {
+                result.get();
+            }
+        }));
+        // The read at the end of each batch makes sure its writes went through
+        const size_t num_batches = std::max<size_t>(num_iters / batch_size, 1);
+        result_t batched = time_op(
+            "poke32 batch", "batch", num_batches, 1, [&](size_t) {
+                {
+                    uhd::rfnoc::noc_block_base::batch_scope batch(radio);
+                    for (size_t i = 0; i < batch_size; i++) {
+                        regs.poke32(REG_TX_IDLE_VALUE, idle_value);
+                    }
+                }
+                regs.peek32(REG_COMPAT_NUM);
+            });
+        batched.name += " of " + std::to_string(batch_size);
+        batched.num_ops *= batch_size;
+        results.push_back(batched);
+    }
+
+    if (has_test("timed")) {
+        std::cout << "Timing timed commands..." << std::endl;
+        // Commands are scheduled timed_lead after the current device time,
+        // which is extrapolated from one reading with the host clock. This
+        // assumes the devices are synchronized if there are several.
+        const uhd::time_spec_t dev_start = usrp->get_time_now();
+        const auto host_start            = clock_type::now();
+        auto get_cmd_time                = [&](const double offset) {
+            return dev_start + uhd::time_spec_t(elapsed_us(host_start) / 1e6 + offset);
+        };
+        // The latency includes the lead time, the command waits for it on the
+        // device
+        results.push_back(
+            time_op("timed poke32 (ack)", "sync", num_iters, num_warmup, [&](size_t) {
+                regs.poke32(
+                    REG_TX_IDLE_VALUE, idle_value, get_cmd_time(timed_lead), true);
+            }));
+        // Commands that execute timed_spacing apart. If they can't be sent
+        // at that rate, they execute late, and their futures throw.
+        const double num_cmds_time = num_iters * timed_spacing;
+        try {
+            result_t queued =
+                time_batch("timed poke32 queue", "async", num_iters, [&]() {
+                    const uhd::time_spec_t cmd_time = get_cmd_time(timed_lead);
+                    std::vector<std::future<void>> pending;
+                    pending.reserve(num_iters);
+                    for (size_t i = 0; i < num_iters; i++) {
+                        pending.push_back(regs.poke32_async(REG_TX_IDLE_VALUE,
+                            idle_value,
+                            cmd_time + uhd::time_spec_t(i * timed_spacing)));
+                    }
+                    for (auto& result : pending) {
+                        result.get();
+                    }
+                });
+            // Don't count the time until the first command was due
+            queued.total_time_s =
+                std::max(queued.total_time_s - timed_lead, num_cmds_time);
+            results.push_back(queued);
+        } catch (const uhd::op_timerr&) {
+            std::cout << "Timed commands " << (timed_spacing * 1e6)
+                      << " us apart executed late, increase --timed_spacing."
+                      << std::endl;
+        }
+    }
+}
+
+//! Latency of the multi_usrp calls that applications make the most
+void benchmark_api(uhd::usrp::multi_usrp::sptr usrp,
+    const size_t chan,
+    const size_t num_iters,
+    std::vector<result_t>& results)
+{
+    const size_t num_warmup = std::min<size_t>(num_iters, 2);
+    std::cout << "Timing multi_usrp calls..." << std::endl;
+
+    // Alternate between two values, so no call is short-circuited
+    const double freq      = usrp->get_rx_freq(chan);
+    const double freq_step = 1e6;
+    results.push_back(time_op("set_rx_freq", "api", num_iters, num_warmup, [&](size_t i) {
+        usrp->set_rx_freq(uhd::tune_request_t(freq + (i % 2) * freq_step), chan);
+    }));
+    usrp->set_rx_freq(uhd::tune_request_t(freq), chan);
+
+    const double gain          = usrp->get_rx_gain(chan);
+    const uhd::gain_range_t gr = usrp->get_rx_gain_range(chan);
+    const double gain_step     = gain + 1.0 <= gr.stop() ? 1.0 : -1.0;
+    results.push_back(time_op("set_rx_gain", "api", num_iters, num_warmup, [&](size_t i) {
+        usrp->set_rx_gain(gain + (i % 2) * gain_step, chan);
+    }));
+    usrp->set_rx_gain(gain, chan);
+
+    const double rate = usrp->get_rx_rate(chan);
+    results.push_back(time_op("set_rx_rate", "api", num_iters, num_warmup, [&](size_t i) {
+        usrp->set_rx_rate(i % 2 ? rate / 2 : rate, chan);
+    }));
+    usrp->set_rx_rate(rate, chan);
+
+    results.push_back(time_op("get_time_now", "api", num_iters, num_warmup, [&](size_t) {
+        usrp->get_time_now();
+    }));
+}
+
+/*! Latency of a motherboard sensor read
+ *
+ * The sensors are read through the control path of the motherboard, which is
+ * the firmware over UDP on X3x0, and the RPC connection to MPM on N3xx, E3xx
+ * and X4xx devices.
+ */
+void benchmark_mb_sensor(uhd::usrp::multi_usrp::sptr usrp,
+    std::string sensor,
+    const size_t num_iters,
+    std::vector<result_t>& results)
+{
+    const std::vector<std::string> sensors = usrp->get_mboard_sensor_names(0);
+    if (sensor.empty()) {
+        if (sensors.empty()) {
+            std::cout << "Motherboard has no sensors, skipping sensor test." << std::endl;
+            return;
+        }
+        sensor = sensors.front();
+    }
+    std::cout << "Timing reads of mboard sensor " << sensor << "..." << std::endl;
+    results.push_back(time_op("mb sensor " + sensor,
+        "mb",
+        num_iters,
+        std::min<size_t>(num_iters, 2),
+        [&](size_t) { usrp->get_mboard_sensor(sensor, 0); }));
+}
+
+} // namespace
+
+int UHD_SAFE_MAIN(int argc, char* argv[])
+{
+    std::string args, tests_list, json_file, sensor;
+    size_t chan, num_iters, num_api_iters, batch_size;
+    double timed_lead, timed_spacing;
+
+    // clang-format off
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("help", "help message")
+        ("args", po::value<std::string>(&args)->default_value(""), "single uhd device address args")
+        ("tests", po::value<std::string>(&tests_list)->default_value("peek,poke,timed,sensor,api"),
+         "comma-separated list of tests (peek, poke, timed, sensor, api)")
+        ("chan", po::value<size_t>(&chan)->default_value(0), "channel whose radio block and API calls are timed")
+        ("iterations", po::value<size_t>(&num_iters)->default_value(1000), "number of register accesses per test")
+        ("api_iterations", po::value<size_t>(&num_api_iters)->default_value(100), "number of calls per multi_usrp and sensor test")
+        ("batch_size", po::value<size_t>(&batch_size)->default_value(32), "number of writes per batch")
+        ("timed_lead", po::value<double>(&timed_lead)->default_value(0.001), "seconds from now that timed commands are scheduled for")
+        ("timed_spacing", po::value<double>(&timed_spacing)->default_value(10e-6), "seconds between queued timed commands")
+        ("sensor", po::value<std::string>(&sensor)->default_value(""), "mboard sensor to read (default: the first one)")
+        ("json", po::value<std::string>(&json_file)->default_value(""), "also write the results to this JSON file")
+    ;
+    // clang-format on
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << boost::format("UHD Benchmark Control %s") % desc << std::endl;
+        std::cout << "    Measures the rate and latency of register accesses, timed\n"
+                     "    commands and common API calls on a device.\n"
+                  << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (num_iters == 0 or num_api_iters == 0 or batch_size == 0) {
+        throw uhd::value_error("iterations, api_iterations and batch_size must be > 0");
+    }
+
+    std::vector<std::string> tests;
+    boost::split(tests, tests_list, boost::is_any_of(","));
+    for (const auto& test : tests) {
+        if (test != "peek" and test != "poke" and test != "timed" and test != "sensor"
+            and test != "api") {
+            throw uhd::value_error("Invalid test: " + test);
+        }
+    }
+    auto has_test = [&tests](const std::string& test) {
+        return std::find(tests.begin(), tests.end(), test) != tests.end();
+    };
+
+    uhd::set_thread_priority_safe();
+
+    std::cout << "Creating the usrp device with: " << args << "..." << std::endl;
+    uhd::usrp::multi_usrp::sptr usrp = uhd::usrp::multi_usrp::make(args);
+    std::cout << "Using Device: " << usrp->get_pp_string() << std::endl;
+
+    std::vector<result_t> results;
+    if (has_test("peek") or has_test("poke") or has_test("timed")) {
+        try {
+            uhd::rfnoc::radio_control& radio = usrp->get_radio_control(chan);
+            std::cout << "Accessing the registers of " << radio.get_unique_id()
+                      << std::endl;
+            benchmark_regs(usrp,
+                radio,
+                tests,
+                num_iters,
+                batch_size,
+                timed_lead,
+                timed_spacing,
+                results);
+        } catch (const uhd::not_implemented_error&) {
+            std::cout << "This device has no RFNoC radio blocks, skipping the register "
+                         "tests."
+                      << std::endl;
+        }
+    }
+    if (has_test("sensor")) {
+        benchmark_mb_sensor(usrp, sensor, num_api_iters, results);
+    }
+    if (has_test("api")) {
+        benchmark_api(usrp, chan, num_api_iters, results);
+    }
+
+    print_results(results);
+    if (!json_file.empty()) {
+        write_json(json_file, args, results);
+        std::cout << "Wrote results to " << json_file << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
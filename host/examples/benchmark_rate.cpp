@@ -17,7 +17,9 @@
 #include <chrono>
 #include <complex>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <thread>
 
 namespace po = boost::program_options;
@@ -32,16 +34,25 @@ using start_time_type = std::chrono::time_point<std::chrono::steady_clock>;
 /***********************************************************************
  * Test result variables
  **********************************************************************/
-unsigned long long num_overruns      = 0;
-unsigned long long num_underruns     = 0;
-unsigned long long num_rx_samps      = 0;
-unsigned long long num_tx_samps      = 0;
-unsigned long long num_dropped_samps = 0;
-unsigned long long num_seq_errors    = 0;
-unsigned long long num_seqrx_errors  = 0; // "D"s
-unsigned long long num_late_commands = 0;
-unsigned long long num_timeouts_rx   = 0;
-unsigned long long num_timeouts_tx   = 0;
+// These are atomic, because they may be updated by several streaming threads,
+// and are read while streaming for the time series
+std::atomic<unsigned long long> num_overruns{0};
+std::atomic<unsigned long long> num_underruns{0};
+std::atomic<unsigned long long> num_rx_samps{0};
+std::atomic<unsigned long long> num_tx_samps{0};
+std::atomic<unsigned long long> num_dropped_samps{0};
+std::atomic<unsigned long long> num_seq_errors{0};
+std::atomic<unsigned long long> num_seqrx_errors{0}; // "D"s
+std::atomic<unsigned long long> num_late_commands{0};
+std::atomic<unsigned long long> num_timeouts_rx{0};
+std::atomic<unsigned long long> num_timeouts_tx{0};
+
+//! Samples per channel moved by one streamer, for the time series
+struct streamer_samps_t
+{
+    std::vector<size_t> channels;
+    std::atomic<unsigned long long> num_samps{0};
+};
 
 inline auto time_delta(const start_time_type& ref_time)
 {
@@ -67,136 +78,196 @@ inline std::string time_delta_str(const start_time_type& ref_time)
 /***********************************************************************
  * Benchmark RX Rate
  **********************************************************************/
-void benchmark_rx_rate(uhd::usrp::multi_usrp::sptr usrp,
-    const std::string& rx_cpu,
-    uhd::rx_streamer::sptr rx_stream,
-    bool random_nsamps,
-    const start_time_type& start_time,
-    std::atomic<bool>& burst_timer_elapsed,
-    bool elevate_priority,
-    double rx_delay)
+/*!
+ * Receive state of one RX streamer
+ *
+ * This is split into start() and recv_once(), so one thread can service
+ * several streamers.
+ */
+class rx_rate_benchmark
 {
-    if (elevate_priority) {
-        uhd::set_thread_priority_safe();
+public:
+    rx_rate_benchmark(uhd::usrp::multi_usrp::sptr usrp,
+        const std::string& rx_cpu,
+        uhd::rx_streamer::sptr rx_stream,
+        bool random_nsamps,
+        const start_time_type& start_time,
+        std::atomic<bool>& burst_timer_elapsed,
+        double rx_delay,
+        bool timed_start,
+        streamer_samps_t& samps)
+        : usrp(usrp)
+        , rx_stream(rx_stream)
+        , random_nsamps(random_nsamps)
+        , start_time(start_time)
+        , burst_timer_elapsed(burst_timer_elapsed)
+        , rx_delay(rx_delay)
+        , samps(samps)
+        , max_samps_per_packet(rx_stream->get_max_num_samps())
+        , buff(max_samps_per_packet * uhd::convert::get_bytes_per_item(rx_cpu))
+        , rate(usrp->get_rx_rate())
+        , cmd(uhd::stream_cmd_t::STREAM_MODE_START_CONTINUOUS)
+    {
+        for (size_t ch = 0; ch < rx_stream->get_num_channels(); ch++)
+            buffs.push_back(&buff.front()); // same buffer for each channel
+        // Streamers that must start together need a timed command
+        stream_now = (buffs.size() == 1) and not timed_start;
+        burst_pkt_time =
+            std::max<float>(0.100f, (2 * max_samps_per_packet / rate));
     }
 
-    // print pre-test summary
-    auto time_stamp   = NOW();
-    auto rx_rate      = usrp->get_rx_rate() / 1e6;
-    auto num_channels = rx_stream->get_num_channels();
-    std::cout << boost::format("[%s] Testing receive rate %f Msps on %u channels\n")
-                     % time_stamp % rx_rate % num_channels;
+    //! Issue the initial stream command
+    void start()
+    {
+        cmd.num_samps = max_samps_per_packet;
+        if (random_nsamps) {
+            cmd.stream_mode = uhd::stream_cmd_t::STREAM_MODE_NUM_SAMPS_AND_DONE;
+            cmd.num_samps   = (rand() % max_samps_per_packet) + 1;
+        }
+        cmd.time_spec  = usrp->get_time_now() + uhd::time_spec_t(rx_delay);
+        cmd.stream_now = stream_now;
+        rx_stream->issue_stream_cmd(cmd);
+        recv_timeout = burst_pkt_time + rx_delay;
+    }
+
+    //! Receive once, returns false when this streamer is done
+    bool recv_once();
+
+private:
+    uhd::usrp::multi_usrp::sptr usrp;
+    uhd::rx_streamer::sptr rx_stream;
+    const bool random_nsamps;
+    const start_time_type& start_time;
+    std::atomic<bool>& burst_timer_elapsed;
+    const double rx_delay;
+    streamer_samps_t& samps;
 
     // setup variables and allocate buffer
     uhd::rx_metadata_t md;
-    const size_t max_samps_per_packet = rx_stream->get_max_num_samps();
-    std::vector<char> buff(
-        max_samps_per_packet * uhd::convert::get_bytes_per_item(rx_cpu));
+    const size_t max_samps_per_packet;
+    std::vector<char> buff;
     std::vector<void*> buffs;
-    for (size_t ch = 0; ch < rx_stream->get_num_channels(); ch++)
-        buffs.push_back(&buff.front()); // same buffer for each channel
     bool had_an_overflow = false;
     uhd::time_spec_t last_time;
-    const double rate = usrp->get_rx_rate();
+    const double rate;
+    uhd::stream_cmd_t cmd;
+    bool stream_now;
+    float burst_pkt_time;
+    float recv_timeout = 0.0;
+    bool stop_called   = false;
+};
 
-    uhd::stream_cmd_t cmd(uhd::stream_cmd_t::STREAM_MODE_START_CONTINUOUS);
-    cmd.num_samps = max_samps_per_packet;
+bool rx_rate_benchmark::recv_once()
+{
+    if (burst_timer_elapsed and not stop_called) {
+        rx_stream->issue_stream_cmd(uhd::stream_cmd_t::STREAM_MODE_STOP_CONTINUOUS);
+        stop_called = true;
+    }
     if (random_nsamps) {
-        cmd.stream_mode = uhd::stream_cmd_t::STREAM_MODE_NUM_SAMPS_AND_DONE;
+        cmd.time_spec  = usrp->get_time_now() + uhd::time_spec_t(rx_delay);
         cmd.num_samps = (rand() % max_samps_per_packet) + 1;
+        rx_stream->issue_stream_cmd(cmd);
+    }
+    try {
+        const size_t num_samps_recvd =
+            rx_stream->recv(buffs, cmd.num_samps, md, recv_timeout);
+        num_rx_samps += num_samps_recvd * rx_stream->get_num_channels();
+        samps.num_samps += num_samps_recvd;
+        recv_timeout = burst_pkt_time;
+    } catch (uhd::io_error& e) {
+        std::cerr << "[" << NOW() << "] Caught an IO exception. " << std::endl;
+        std::cerr << e.what() << std::endl;
+        return false;
     }
-    cmd.time_spec  = usrp->get_time_now() + uhd::time_spec_t(rx_delay);
-    cmd.stream_now = (buffs.size() == 1);
-    rx_stream->issue_stream_cmd(cmd);
 
-    const float burst_pkt_time =
-        std::max<float>(0.100f, (2 * max_samps_per_packet / rate));
-    float recv_timeout = burst_pkt_time + rx_delay;
+    // handle the error codes
+    switch (md.error_code) {
+        case uhd::rx_metadata_t::ERROR_CODE_NONE:
+            if (had_an_overflow) {
+                had_an_overflow          = false;
+                const long dropped_samps = (md.time_spec - last_time).to_ticks(rate);
+                if (dropped_samps < 0) {
+                    std::cerr << "[" << NOW()
+                              << "] Timestamp after overrun recovery "
+                                 "ahead of error timestamp! Unable to calculate "
+                                 "number of dropped samples."
+                                 "(Delta: "
+                              << dropped_samps << " ticks)\n";
+                }
+                num_dropped_samps += std::max<long>(1, dropped_samps);
+            }
+            if ((burst_timer_elapsed or stop_called) and md.end_of_burst) {
+                return false;
+            }
+            break;
 
-    bool stop_called = false;
-    while (true) {
-        if (burst_timer_elapsed and not stop_called) {
-            rx_stream->issue_stream_cmd(uhd::stream_cmd_t::STREAM_MODE_STOP_CONTINUOUS);
-            stop_called = true;
-        }
-        if (random_nsamps) {
-            cmd.time_spec  = usrp->get_time_now() + uhd::time_spec_t(rx_delay);
-            cmd.num_samps = (rand() % max_samps_per_packet) + 1;
-            rx_stream->issue_stream_cmd(cmd);
-        }
-        try {
-            num_rx_samps += rx_stream->recv(buffs, cmd.num_samps, md, recv_timeout)
-                            * rx_stream->get_num_channels();
-            recv_timeout = burst_pkt_time;
-        } catch (uhd::io_error& e) {
-            std::cerr << "[" << NOW() << "] Caught an IO exception. " << std::endl;
-            std::cerr << e.what() << std::endl;
-            return;
-        }
+        // ERROR_CODE_OVERFLOW can indicate overflow or sequence error
+        case uhd::rx_metadata_t::ERROR_CODE_OVERFLOW:
+            last_time       = md.time_spec;
+            had_an_overflow = true;
+            // check out_of_sequence flag to see if it was a sequence error or
+            // overflow
+            if (!md.out_of_sequence) {
+                num_overruns++;
+            } else {
+                num_seqrx_errors++;
+                std::cerr << "[" << NOW() << "] Detected Rx sequence error."
+                          << std::endl;
+            }
+            break;
 
-        // handle the error codes
-        switch (md.error_code) {
-            case uhd::rx_metadata_t::ERROR_CODE_NONE:
-                if (had_an_overflow) {
-                    had_an_overflow          = false;
-                    const long dropped_samps = (md.time_spec - last_time).to_ticks(rate);
-                    if (dropped_samps < 0) {
-                        std::cerr << "[" << NOW()
-                                  << "] Timestamp after overrun recovery "
-                                     "ahead of error timestamp! Unable to calculate "
-                                     "number of dropped samples."
-                                     "(Delta: "
-                                  << dropped_samps << " ticks)\n";
-                    }
-                    num_dropped_samps += std::max<long>(1, dropped_samps);
-                }
-                if ((burst_timer_elapsed or stop_called) and md.end_of_burst) {
-                    return;
-                }
-                break;
+        case uhd::rx_metadata_t::ERROR_CODE_LATE_COMMAND:
+            std::cerr << "[" << NOW() << "] Receiver error: " << md.strerror()
+                      << ", restart streaming..." << std::endl;
+            num_late_commands++;
+            // Radio core will be in the idle state. Issue stream command to restart
+            // streaming.
+            cmd.time_spec  = usrp->get_time_now() + uhd::time_spec_t(0.05);
+            cmd.stream_now = stream_now;
+            rx_stream->issue_stream_cmd(cmd);
+            break;
 
-            // ERROR_CODE_OVERFLOW can indicate overflow or sequence error
-            case uhd::rx_metadata_t::ERROR_CODE_OVERFLOW:
-                last_time       = md.time_spec;
-                had_an_overflow = true;
-                // check out_of_sequence flag to see if it was a sequence error or
-                // overflow
-                if (!md.out_of_sequence) {
-                    num_overruns++;
-                } else {
-                    num_seqrx_errors++;
-                    std::cerr << "[" << NOW() << "] Detected Rx sequence error."
-                              << std::endl;
-                }
-                break;
+        case uhd::rx_metadata_t::ERROR_CODE_TIMEOUT:
+            if (burst_timer_elapsed) {
+                return false;
+            }
+            std::cerr << "[" << NOW() << "] Receiver error: " << md.strerror()
+                      << ", continuing..." << std::endl;
+            num_timeouts_rx++;
+            break;
 
-            case uhd::rx_metadata_t::ERROR_CODE_LATE_COMMAND:
-                std::cerr << "[" << NOW() << "] Receiver error: " << md.strerror()
-                          << ", restart streaming..." << std::endl;
-                num_late_commands++;
-                // Radio core will be in the idle state. Issue stream command to restart
-                // streaming.
-                cmd.time_spec  = usrp->get_time_now() + uhd::time_spec_t(0.05);
-                cmd.stream_now = (buffs.size() == 1);
-                rx_stream->issue_stream_cmd(cmd);
-                break;
+            // Otherwise, it's an error
+        default:
+            std::cerr << "[" << NOW() << "] Receiver error: " << md.strerror()
+                      << std::endl;
+            std::cerr << "[" << NOW() << "] Unexpected error on recv, continuing..."
+                      << std::endl;
+            break;
+    }
+    return true;
+}
 
-            case uhd::rx_metadata_t::ERROR_CODE_TIMEOUT:
-                if (burst_timer_elapsed) {
-                    return;
-                }
-                std::cerr << "[" << NOW() << "] Receiver error: " << md.strerror()
-                          << ", continuing..." << std::endl;
-                num_timeouts_rx++;
-                break;
+/*!
+ * Receive from one or more streamers on the calling thread, until all of them
+ * are done. Streamers are serviced round-robin, one recv() call each.
+ */
+void benchmark_rx_rate(
+    std::vector<std::shared_ptr<rx_rate_benchmark>> benchmarks, bool elevate_priority)
+{
+    if (elevate_priority) {
+        uhd::set_thread_priority_safe();
+    }
 
-                // Otherwise, it's an error
-            default:
-                std::cerr << "[" << NOW() << "] Receiver error: " << md.strerror()
-                          << std::endl;
-                std::cerr << "[" << NOW() << "] Unexpected error on recv, continuing..."
-                          << std::endl;
-                break;
+    for (auto& benchmark : benchmarks) {
+        benchmark->start();
+    }
+    while (not benchmarks.empty()) {
+        for (auto it = benchmarks.begin(); it != benchmarks.end();) {
+            if ((*it)->recv_once()) {
+                ++it;
+            } else {
+                it = benchmarks.erase(it);
+            }
         }
     }
 }
@@ -204,75 +275,134 @@ void benchmark_rx_rate(uhd::usrp::multi_usrp::sptr usrp,
 /***********************************************************************
  * Benchmark TX Rate
  **********************************************************************/
-void benchmark_tx_rate(uhd::usrp::multi_usrp::sptr usrp,
-    const std::string& tx_cpu,
-    uhd::tx_streamer::sptr tx_stream,
-    std::atomic<bool>& burst_timer_elapsed,
-    const start_time_type& start_time,
-    const size_t spp,
-    bool elevate_priority,
-    double tx_delay,
-    bool random_nsamps = false)
+/*!
+ * Transmit state of one TX streamer
+ *
+ * This is split into start() and send_once(), so one thread can service
+ * several streamers.
+ */
+class tx_rate_benchmark
 {
-    if (elevate_priority) {
-        uhd::set_thread_priority_safe();
+public:
+    tx_rate_benchmark(uhd::usrp::multi_usrp::sptr usrp,
+        const std::string& tx_cpu,
+        uhd::tx_streamer::sptr tx_stream,
+        std::atomic<bool>& burst_timer_elapsed,
+        const start_time_type& start_time,
+        const size_t spp,
+        double tx_delay,
+        bool random_nsamps,
+        bool timed_start,
+        streamer_samps_t& samps)
+        : usrp(usrp)
+        , tx_stream(tx_stream)
+        , burst_timer_elapsed(burst_timer_elapsed)
+        , start_time(start_time)
+        , spp(spp)
+        , tx_delay(tx_delay)
+        , random_nsamps(random_nsamps)
+        , samps(samps)
+        , max_samps_per_packet(tx_stream->get_max_num_samps())
+        , buff(max_samps_per_packet * uhd::convert::get_bytes_per_item(tx_cpu))
+    {
+        for (size_t ch = 0; ch < tx_stream->get_num_channels(); ch++)
+            buffs.push_back(&buff.front()); // same buffer for each channel
+        // Streamers that must start together need a timed burst
+        md.has_time_spec = (buffs.size() != 1) or timed_start;
     }
 
-    // print pre-test summary
-    auto time_stamp   = NOW();
-    auto tx_rate      = usrp->get_tx_rate() / 1e6;
-    auto num_channels = tx_stream->get_num_channels();
-    std::cout << boost::format("[%s] Testing transmit rate %f Msps on %u channels\n")
-                     % time_stamp % tx_rate % num_channels;
-
-    // setup variables and allocate buffer
-    const size_t max_samps_per_packet = tx_stream->get_max_num_samps();
-    std::vector<char> buff(
-        max_samps_per_packet * uhd::convert::get_bytes_per_item(tx_cpu));
-    std::vector<const void*> buffs;
-    for (size_t ch = 0; ch < tx_stream->get_num_channels(); ch++)
-        buffs.push_back(&buff.front()); // same buffer for each channel
-    // Create the metadata, and populate the time spec at the latest possible moment
-    uhd::tx_metadata_t md;
-    md.has_time_spec = (buffs.size() != 1);
-    md.time_spec     = usrp->get_time_now() + uhd::time_spec_t(tx_delay);
+    //! Populate the time spec, at the latest possible moment
+    void start()
+    {
+        md.time_spec = usrp->get_time_now() + uhd::time_spec_t(tx_delay);
+    }
 
-    const float timeout = 1.0;
+    /*!
+     * Send one packet (or one burst of random size), returns false when this
+     * streamer is done
+     */
+    bool send_once()
+    {
+        if (burst_timer_elapsed) {
+            // send a mini EOB packet
+            md.end_of_burst = true;
+            tx_stream->send(buffs, 0, md);
+            return false;
+        }
 
-    if (random_nsamps) {
-        std::srand((unsigned int)time(NULL));
-        while (not burst_timer_elapsed) {
+        if (random_nsamps) {
             size_t total_num_samps = (rand() % max_samps_per_packet) + 1;
             size_t num_acc_samps   = 0;
 
             while (num_acc_samps < total_num_samps) {
                 // send a single packet
-                num_tx_samps += tx_stream->send(buffs, spp, md, timeout)
-                                * tx_stream->get_num_channels();
-                num_acc_samps += std::min(
-                    total_num_samps - num_acc_samps, max_samps_per_packet);
+                const size_t num_samps_sent = tx_stream->send(buffs, spp, md, timeout);
+                num_tx_samps += num_samps_sent * tx_stream->get_num_channels();
+                samps.num_samps += num_samps_sent;
+                num_acc_samps +=
+                    std::min(total_num_samps - num_acc_samps, max_samps_per_packet);
             }
-            md.has_time_spec = false;
-        }
-    } else {
-        while (not burst_timer_elapsed) {
-            const size_t num_tx_samps_sent_now =
-                tx_stream->send(buffs, spp, md, timeout) * tx_stream->get_num_channels();
-            num_tx_samps += num_tx_samps_sent_now;
-            if (num_tx_samps_sent_now == 0) {
-                num_timeouts_tx++;
-                if ((num_timeouts_tx % 10000) == 1) {
-                    std::cerr << "[" << NOW() << "] Tx timeouts: " << num_timeouts_tx
+        } else {
+            const size_t num_samps_sent = tx_stream->send(buffs, spp, md, timeout);
+            num_tx_samps += num_samps_sent * tx_stream->get_num_channels();
+            samps.num_samps += num_samps_sent;
+            if (num_samps_sent == 0) {
+                const unsigned long long num_timeouts = ++num_timeouts_tx;
+                if ((num_timeouts % 10000) == 1) {
+                    std::cerr << "[" << NOW() << "] Tx timeouts: " << num_timeouts
                               << std::endl;
                 }
             }
-            md.has_time_spec = false;
         }
+        md.has_time_spec = false;
+        return true;
     }
 
-    // send a mini EOB packet
-    md.end_of_burst = true;
-    tx_stream->send(buffs, 0, md);
+private:
+    uhd::usrp::multi_usrp::sptr usrp;
+    uhd::tx_streamer::sptr tx_stream;
+    std::atomic<bool>& burst_timer_elapsed;
+    const start_time_type& start_time;
+    const size_t spp;
+    const double tx_delay;
+    const bool random_nsamps;
+    streamer_samps_t& samps;
+
+    // setup variables and allocate buffer
+    const size_t max_samps_per_packet;
+    std::vector<char> buff;
+    std::vector<const void*> buffs;
+    uhd::tx_metadata_t md;
+    const float timeout = 1.0;
+};
+
+/*!
+ * Transmit on one or more streamers from the calling thread, until the test
+ * duration elapsed. Streamers are serviced round-robin, one packet each.
+ */
+void benchmark_tx_rate(std::vector<std::shared_ptr<tx_rate_benchmark>> benchmarks,
+    bool elevate_priority,
+    bool random_nsamps = false)
+{
+    if (elevate_priority) {
+        uhd::set_thread_priority_safe();
+    }
+
+    if (random_nsamps) {
+        std::srand((unsigned int)time(NULL));
+    }
+    for (auto& benchmark : benchmarks) {
+        benchmark->start();
+    }
+    while (not benchmarks.empty()) {
+        for (auto it = benchmarks.begin(); it != benchmarks.end();) {
+            if ((*it)->send_once()) {
+                ++it;
+            } else {
+                it = benchmarks.erase(it);
+            }
+        }
+    }
 }
 
 void benchmark_tx_rate_async_helper(uhd::tx_streamer::sptr tx_stream,
@@ -318,6 +448,206 @@ void benchmark_tx_rate_async_helper(uhd::tx_streamer::sptr tx_stream,
     }
 }
 
+/***********************************************************************
+ * Time series
+ **********************************************************************/
+/*!
+ * Turn on the statistics of a streamer, returns false if the streamer does not
+ * provide any
+ */
+template <typename streamer_type>
+bool enable_streamer_stats(streamer_type& stream)
+{
+    try {
+        stream->set_stats_enabled(true);
+        return true;
+    } catch (const uhd::not_implemented_error&) {
+        return false;
+    }
+}
+
+/*!
+ * Writes the progress of the benchmark at regular intervals, either as CSV
+ * (with a header row) or as JSON lines (one object per interval). Both use the
+ * same fields: the time in seconds since streaming started, the rate of every
+ * channel in samples per second, and the error counts of the interval. If the
+ * streamers provide statistics, their stalls, wait time and conversion time
+ * (summed over all streamers of a direction) are added.
+ */
+class time_series_writer
+{
+public:
+    using samps_list_t = std::vector<std::shared_ptr<streamer_samps_t>>;
+
+    time_series_writer(std::ostream& out,
+        const bool json,
+        const samps_list_t& rx_samps,
+        const samps_list_t& tx_samps,
+        const std::vector<uhd::rx_streamer::sptr>& rx_streams,
+        const std::vector<uhd::tx_streamer::sptr>& tx_streams)
+        : _out(out)
+        , _json(json)
+        , _rx_samps(rx_samps)
+        , _tx_samps(tx_samps)
+        , _rx_streams(rx_streams)
+        , _tx_streams(tx_streams)
+        , _start_time(std::chrono::steady_clock::now())
+        , _last_time(_start_time)
+    {
+        _last_rx_samps.resize(rx_samps.size());
+        _last_tx_samps.resize(tx_samps.size());
+        _last_counts.resize(_counters.size());
+        for (auto& stream : _rx_streams) {
+            _has_rx_stats = enable_streamer_stats(stream) or _has_rx_stats;
+        }
+        for (auto& stream : _tx_streams) {
+            _has_tx_stats = enable_streamer_stats(stream) or _has_tx_stats;
+        }
+    }
+
+    //! Write the record of the interval that ends now
+    void write()
+    {
+        const auto now      = std::chrono::steady_clock::now();
+        const double period = std::chrono::duration<double>(now - _last_time).count();
+        const double time   = std::chrono::duration<double>(now - _start_time).count();
+        _last_time          = now;
+
+        std::vector<std::pair<std::string, std::string>> fields;
+        fields.emplace_back("time", str(boost::format("%.3f") % time));
+        _add_rates(fields, "rx", _rx_samps, _last_rx_samps, period);
+        _add_rates(fields, "tx", _tx_samps, _last_tx_samps, period);
+        for (size_t i = 0; i < _counters.size(); i++) {
+            const unsigned long long count = *_counters[i].second;
+            fields.emplace_back(
+                _counters[i].first, std::to_string(count - _last_counts[i]));
+            _last_counts[i] = count;
+        }
+        if (_has_rx_stats) {
+            _add_stats(fields, "rx", _get_stats(_rx_streams), _last_rx_stats);
+        }
+        if (_has_tx_stats) {
+            _add_stats(fields, "tx", _get_stats(_tx_streams), _last_tx_stats);
+        }
+
+        if (_json) {
+            _out << "{";
+            for (size_t i = 0; i < fields.size(); i++) {
+                _out << (i ? ", " : "") << "\"" << fields[i].first
+                     << "\": " << fields[i].second;
+            }
+            _out << "}" << std::endl;
+            return;
+        }
+        if (not _header_written) {
+            for (size_t i = 0; i < fields.size(); i++) {
+                _out << (i ? "," : "") << fields[i].first;
+            }
+            _out << std::endl;
+            _header_written = true;
+        }
+        for (size_t i = 0; i < fields.size(); i++) {
+            _out << (i ? "," : "") << fields[i].second;
+        }
+        _out << std::endl;
+    }
+
+private:
+    using fields_t = std::vector<std::pair<std::string, std::string>>;
+
+    void _add_rates(fields_t& fields,
+        const std::string& dir,
+        const samps_list_t& samps,
+        std::vector<unsigned long long>& last_samps,
+        const double period)
+    {
+        for (size_t i = 0; i < samps.size(); i++) {
+            const unsigned long long num_samps = samps[i]->num_samps;
+            const double rate = (num_samps - last_samps[i]) / period;
+            last_samps[i]     = num_samps;
+            // All channels of a streamer move the same number of samples
+            for (const size_t chan : samps[i]->channels) {
+                fields.emplace_back(str(boost::format("%s_sps_ch%u") % dir % chan),
+                    str(boost::format("%.1f") % rate));
+            }
+        }
+    }
+
+    template <typename streams_type>
+    static uhd::streamer_stats_t _get_stats(const streams_type& streams)
+    {
+        uhd::streamer_stats_t total;
+        for (const auto& stream : streams) {
+            try {
+                const uhd::streamer_stats_t stats = stream->get_stats();
+                total.stalls += stats.stalls;
+                total.wait_time_ns += stats.wait_time_ns;
+                total.convert_time_ns += stats.convert_time_ns;
+            } catch (const uhd::not_implemented_error&) {
+            }
+        }
+        return total;
+    }
+
+    static void _add_stats(fields_t& fields,
+        const std::string& dir,
+        const uhd::streamer_stats_t& stats,
+        uhd::streamer_stats_t& last_stats)
+    {
+        fields.emplace_back(
+            dir + "_stalls", std::to_string(stats.stalls - last_stats.stalls));
+        fields.emplace_back(dir + "_wait_time_ns",
+            std::to_string(stats.wait_time_ns - last_stats.wait_time_ns));
+        fields.emplace_back(dir + "_convert_time_ns",
+            std::to_string(stats.convert_time_ns - last_stats.convert_time_ns));
+        last_stats = stats;
+    }
+
+    const std::vector<std::pair<std::string, const std::atomic<unsigned long long>*>>
+        _counters{{"overruns", &num_overruns},
+            {"dropped_samps", &num_dropped_samps},
+            {"rx_seq_errors", &num_seqrx_errors},
+            {"tx_seq_errors", &num_seq_errors},
+            {"underruns", &num_underruns},
+            {"late_commands", &num_late_commands},
+            {"rx_timeouts", &num_timeouts_rx},
+            {"tx_timeouts", &num_timeouts_tx}};
+
+    std::ostream& _out;
+    const bool _json;
+    const samps_list_t _rx_samps;
+    const samps_list_t _tx_samps;
+    const std::vector<uhd::rx_streamer::sptr> _rx_streams;
+    const std::vector<uhd::tx_streamer::sptr> _tx_streams;
+    const start_time_type _start_time;
+    start_time_type _last_time;
+    std::vector<unsigned long long> _last_rx_samps;
+    std::vector<unsigned long long> _last_tx_samps;
+    std::vector<unsigned long long> _last_counts;
+    bool _has_rx_stats = false;
+    bool _has_tx_stats = false;
+    uhd::streamer_stats_t _last_rx_stats;
+    uhd::streamer_stats_t _last_tx_stats;
+    bool _header_written = false;
+};
+
+/*!
+ * Split the channels into the channel lists of the streamers: one streamer
+ * for all channels, or one streamer per channel
+ */
+std::vector<std::vector<size_t>> get_streamer_channels(
+    const std::vector<size_t>& channel_nums, const bool one_per_channel)
+{
+    if (not one_per_channel) {
+        return {channel_nums};
+    }
+    std::vector<std::vector<size_t>> streamer_channels;
+    for (const size_t chan : channel_nums) {
+        streamer_channels.push_back({chan});
+    }
+    return streamer_channels;
+}
+
 /***********************************************************************
  * Main code + dispatcher
  **********************************************************************/
@@ -340,6 +670,9 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     double tx_delay, rx_delay;
     std::string priority;
     bool elevate_priority = false;
+    std::string multi_streamer;
+    double stats_interval;
+    std::string stats_file, stats_format;
 
     // setup the program options
     po::options_description desc("Allowed options");
@@ -378,6 +711,13 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         ("tx_delay", po::value<double>(&tx_delay)->default_value(0.25), "delay before starting TX in seconds")
         ("rx_delay", po::value<double>(&rx_delay)->default_value(0.05), "delay before starting RX in seconds")
         ("priority", po::value<std::string>(&priority)->default_value("normal"), "thread priority (normal, high)")
+        ("multi_streamer", po::value<std::string>(&multi_streamer)->default_value("none"),
+         "none: one streamer for all channels, shared: one streamer per channel, all serviced by one thread, "
+         "per_channel: one streamer and one thread per channel")
+        ("stats_interval", po::value<double>(&stats_interval)->default_value(0.0),
+         "write a time series of rates and errors every this many seconds (0 to disable)")
+        ("stats_file", po::value<std::string>(&stats_file)->default_value(""), "file for the time series (default: stdout)")
+        ("stats_format", po::value<std::string>(&stats_format)->default_value("json"), "format of the time series (json, csv)")
     ;
     // clang-format on
     po::variables_map vm;
@@ -394,6 +734,14 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         return ~0;
     }
 
+    if (multi_streamer != "none" and multi_streamer != "shared"
+        and multi_streamer != "per_channel") {
+        throw std::runtime_error("Invalid multi_streamer mode: " + multi_streamer);
+    }
+    if (stats_format != "json" and stats_format != "csv") {
+        throw std::runtime_error("Invalid stats_format: " + stats_format);
+    }
+
     if (priority == "high") {
         uhd::set_thread_priority_safe();
         elevate_priority = true;
@@ -533,61 +881,136 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         usrp->set_time_now(0.0);
     }
 
-    // spawn the receive test thread
+    const bool one_streamer_per_channel = (multi_streamer != "none");
+    const bool thread_per_streamer      = (multi_streamer != "shared");
+    time_series_writer::samps_list_t rx_samps, tx_samps;
+    std::vector<uhd::rx_streamer::sptr> rx_streams;
+    std::vector<uhd::tx_streamer::sptr> tx_streams;
+
+    // create the receive streamers
+    std::vector<std::shared_ptr<rx_rate_benchmark>> rx_benchmarks;
     if (vm.count("rx_rate")) {
         usrp->set_rx_rate(rx_rate);
         if (vm.count("rx_spp")) {
             std::cout << boost::format("Setting RX spp to %u\n") % rx_spp;
             usrp->set_rx_spp(rx_spp);
         }
-        // create a receive streamer
-        uhd::stream_args_t stream_args(rx_cpu, rx_otw);
-        stream_args.channels             = rx_channel_nums;
-        stream_args.args                 = uhd::device_addr_t(rx_stream_args);
-        uhd::rx_streamer::sptr rx_stream = usrp->get_rx_stream(stream_args);
-        auto rx_thread = thread_group.create_thread([=, &burst_timer_elapsed]() {
-            benchmark_rx_rate(usrp,
+        const auto streamer_channels =
+            get_streamer_channels(rx_channel_nums, one_streamer_per_channel);
+        for (const auto& channels : streamer_channels) {
+            uhd::stream_args_t stream_args(rx_cpu, rx_otw);
+            stream_args.channels             = channels;
+            stream_args.args                 = uhd::device_addr_t(rx_stream_args);
+            uhd::rx_streamer::sptr rx_stream = usrp->get_rx_stream(stream_args);
+            auto samps                       = std::make_shared<streamer_samps_t>();
+            samps->channels                  = channels;
+            rx_streams.push_back(rx_stream);
+            rx_samps.push_back(samps);
+            rx_benchmarks.push_back(std::make_shared<rx_rate_benchmark>(usrp,
                 rx_cpu,
                 rx_stream,
                 random_nsamps,
                 start_time,
                 burst_timer_elapsed,
-                elevate_priority,
-                rx_delay);
-        });
-        uhd::set_thread_name(rx_thread, "bmark_rx_stream");
+                rx_delay,
+                streamer_channels.size() > 1,
+                *samps));
+        }
     }
 
-    // spawn the transmit test thread
+    // create the transmit streamers
+    std::vector<std::shared_ptr<tx_rate_benchmark>> tx_benchmarks;
     if (vm.count("tx_rate")) {
         usrp->set_tx_rate(tx_rate);
-        // create a transmit streamer
-        uhd::stream_args_t stream_args(tx_cpu, tx_otw);
-        stream_args.channels             = tx_channel_nums;
-        stream_args.args                 = uhd::device_addr_t(tx_stream_args);
-        uhd::tx_streamer::sptr tx_stream = usrp->get_tx_stream(stream_args);
-        const size_t max_spp             = tx_stream->get_max_num_samps();
-        size_t spp                       = max_spp;
-        if (vm.count("tx_spp")) {
-            spp = std::min(spp, tx_spp);
-        }
-        std::cout << boost::format("Setting TX spp to %u\n") % spp;
-        auto tx_thread = thread_group.create_thread([=, &burst_timer_elapsed]() {
-            benchmark_tx_rate(usrp,
+        const auto streamer_channels =
+            get_streamer_channels(tx_channel_nums, one_streamer_per_channel);
+        size_t spp = 0;
+        for (const auto& channels : streamer_channels) {
+            uhd::stream_args_t stream_args(tx_cpu, tx_otw);
+            stream_args.channels             = channels;
+            stream_args.args                 = uhd::device_addr_t(tx_stream_args);
+            uhd::tx_streamer::sptr tx_stream = usrp->get_tx_stream(stream_args);
+            spp                              = tx_stream->get_max_num_samps();
+            if (vm.count("tx_spp")) {
+                spp = std::min(spp, tx_spp);
+            }
+            auto samps      = std::make_shared<streamer_samps_t>();
+            samps->channels = channels;
+            tx_streams.push_back(tx_stream);
+            tx_samps.push_back(samps);
+            tx_benchmarks.push_back(std::make_shared<tx_rate_benchmark>(usrp,
                 tx_cpu,
                 tx_stream,
                 burst_timer_elapsed,
                 start_time,
                 spp,
-                elevate_priority,
                 tx_delay,
-                random_nsamps);
-        });
-        uhd::set_thread_name(tx_thread, "bmark_tx_stream");
-        auto tx_async_thread = thread_group.create_thread([=, &burst_timer_elapsed]() {
-            benchmark_tx_rate_async_helper(tx_stream, start_time, burst_timer_elapsed);
-        });
-        uhd::set_thread_name(tx_async_thread, "bmark_tx_helper");
+                random_nsamps,
+                streamer_channels.size() > 1,
+                *samps));
+        }
+        std::cout << boost::format("Setting TX spp to %u\n") % spp;
+    }
+
+    std::ofstream stats_ofstream;
+    std::unique_ptr<time_series_writer> stats_writer;
+    if (stats_interval > 0) {
+        if (not stats_file.empty()) {
+            stats_ofstream.open(stats_file);
+            if (not stats_ofstream) {
+                throw std::runtime_error("Unable to open " + stats_file);
+            }
+        }
+        stats_writer = std::make_unique<time_series_writer>(
+            stats_file.empty() ? std::cout : stats_ofstream,
+            stats_format == "json",
+            rx_samps,
+            tx_samps,
+            rx_streams,
+            tx_streams);
+    }
+
+    // spawn the receive test threads
+    if (vm.count("rx_rate")) {
+        // print pre-test summary
+        std::cout << boost::format("[%s] Testing receive rate %f Msps on %u channels\n")
+                         % NOW() % (usrp->get_rx_rate() / 1e6) % rx_channel_nums.size();
+        const size_t num_threads = thread_per_streamer ? rx_benchmarks.size() : 1;
+        for (size_t i = 0; i < num_threads; i++) {
+            auto benchmarks = rx_benchmarks;
+            if (thread_per_streamer) {
+                benchmarks = {rx_benchmarks[i]};
+            }
+            auto rx_thread = thread_group.create_thread(
+                [=]() { benchmark_rx_rate(benchmarks, elevate_priority); });
+            uhd::set_thread_name(rx_thread, "bmark_rx_stream");
+        }
+    }
+
+    // spawn the transmit test threads
+    if (vm.count("tx_rate")) {
+        // print pre-test summary
+        std::cout << boost::format("[%s] Testing transmit rate %f Msps on %u channels\n")
+                         % NOW() % (usrp->get_tx_rate() / 1e6) % tx_channel_nums.size();
+        const size_t num_threads = thread_per_streamer ? tx_benchmarks.size() : 1;
+        for (size_t i = 0; i < num_threads; i++) {
+            auto benchmarks = tx_benchmarks;
+            if (thread_per_streamer) {
+                benchmarks = {tx_benchmarks[i]};
+            }
+            auto tx_thread = thread_group.create_thread([=]() {
+                benchmark_tx_rate(benchmarks, elevate_priority, random_nsamps);
+            });
+            uhd::set_thread_name(tx_thread, "bmark_tx_stream");
+        }
+        for (auto& tx_stream : tx_streams) {
+            auto tx_async_thread =
+                thread_group.create_thread([=, &burst_timer_elapsed]() {
+                    benchmark_tx_rate_async_helper(
+                        tx_stream, start_time, burst_timer_elapsed);
+                });
+            uhd::set_thread_name(tx_async_thread, "bmark_tx_helper");
+        }
     }
 
     // sleep for the required duration (add any initial delay)
@@ -598,10 +1021,17 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     } else {
         duration += tx_delay;
     }
-    const int64_t secs  = int64_t(duration);
-    const int64_t usecs = int64_t((duration - secs) * 1e6);
-    std::this_thread::sleep_for(
-        std::chrono::seconds(secs) + std::chrono::microseconds(usecs));
+    const auto end_time = std::chrono::steady_clock::now()
+                          + std::chrono::microseconds(int64_t(duration * 1e6));
+    if (stats_writer) {
+        const auto interval = std::chrono::microseconds(int64_t(stats_interval * 1e6));
+        for (auto next = std::chrono::steady_clock::now() + interval; next <= end_time;
+             next += interval) {
+            std::this_thread::sleep_until(next);
+            stats_writer->write();
+        }
+    }
+    std::this_thread::sleep_until(end_time);
 
     // interrupt and join the threads
     burst_timer_elapsed = true;
@@ -631,9 +1061,11 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
                                "  Num late commands:        %u\n"
                                "  Num timeouts (Tx):        %u\n"
                                "  Num timeouts (Rx):        %u\n")
-                     % num_rx_samps % num_dropped_samps % num_overruns % num_tx_samps
-                     % num_seq_errors % num_seqrx_errors % num_underruns
-                     % num_late_commands % num_timeouts_tx % num_timeouts_rx
+                     % num_rx_samps.load() % num_dropped_samps.load()
+                     % num_overruns.load() % num_tx_samps.load() % num_seq_errors.load()
+                     % num_seqrx_errors.load() % num_underruns.load()
+                     % num_late_commands.load() % num_timeouts_tx.load()
+                     % num_timeouts_rx.load()
               << std::endl;
     // finished
     std::cout << std::endl << "Done!" << std::endl << std::endl;
@@ -642,23 +1074,23 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         || seq_threshold_err) {
         std::cout << "The following error thresholds were exceeded:\n";
         if (overrun_threshold_err) {
-            std::cout << boost::format("  * Overruns (%d/%d)") % num_overruns
+            std::cout << boost::format("  * Overruns (%d/%d)") % num_overruns.load()
                              % overrun_threshold
                       << std::endl;
         }
         if (underrun_threshold_err) {
-            std::cout << boost::format("  * Underruns (%d/%d)") % num_underruns
+            std::cout << boost::format("  * Underruns (%d/%d)") % num_underruns.load()
                              % underrun_threshold
                       << std::endl;
         }
         if (drop_threshold_err) {
             std::cout << boost::format("  * Dropped packets (RX) (%d/%d)")
-                             % num_seqrx_errors % drop_threshold
+                             % num_seqrx_errors.load() % drop_threshold
                       << std::endl;
         }
         if (seq_threshold_err) {
             std::cout << boost::format("  * Dropped packets (TX) (%d/%d)")
-                             % num_seq_errors % seq_threshold
+                             % num_seq_errors.load() % seq_threshold
                       << std::endl;
         }
         return EXIT_FAILURE;
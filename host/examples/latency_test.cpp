@@ -15,6 +15,29 @@
 
 namespace po = boost::program_options;
 
+//! Print the latencies measured by the latency probe of a streamer
+template <typename streamer_type>
+void print_latency_stats(const std::string& name, streamer_type& stream)
+{
+    const uhd::streamer_stats_t stats = stream->get_stats();
+    for (const auto& stage : stats.latency) {
+        const auto& latency = stage.second;
+        std::cout << boost::format("%s %s: %u packets, mean %.1f us, max %.1f us\n")
+                         % name % stage.first % latency.count
+                         % (latency.total_ns / 1e3 / latency.count)
+                         % (latency.max_ns / 1e3);
+        for (size_t i = 0; i < latency.hist.size(); i++) {
+            if (latency.hist[i] == 0) {
+                continue;
+            }
+            // Bucket 0 is below 1 us, bucket i starts at 2^(i-1) us
+            const size_t start_us = i ? (1 << (i - 1)) : 0;
+            std::cout << boost::format("    >= %6u us: %u\n") % start_us
+                             % latency.hist[i];
+        }
+    }
+}
+
 int UHD_SAFE_MAIN(int argc, char* argv[])
 {
     // variables to be set by po
@@ -36,6 +59,7 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         ("rate",   po::value<double>(&rate)->default_value(100e6/4), "sample rate for receive and transmit (sps)")
         ("from-eob", "specify to define rtt to not include the time to clock out the RX samples (removes dependence on nsamps and rate)")
         ("verbose", "specify to enable inner-loop verbose")
+        ("latency-probe", "specify to print the latency of the stages of the streaming path (link, recv(), send())")
     ;
     // clang-format on
     po::variables_map vm;
@@ -96,6 +120,9 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
 
     // create RX and TX streamers
     uhd::stream_args_t stream_args("fc32"); // complex floats
+    if (vm.count("latency-probe")) {
+        stream_args.args["enable_latency_probe"] = "1";
+    }
     uhd::rx_streamer::sptr rx_stream = usrp->get_rx_stream(stream_args);
     uhd::tx_streamer::sptr tx_stream = usrp->get_tx_stream(stream_args);
 
@@ -222,5 +249,9 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
               << "Late packets:     " << time_error << std::endl
               << "Other errors:     " << other << std::endl
               << std::endl;
+    if (vm.count("latency-probe")) {
+        print_latency_stats("RX", rx_stream);
+        print_latency_stats("TX", tx_stream);
+    }
     return EXIT_SUCCESS;
 }
@@ -63,17 +63,21 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     try {
         size_t num_mboards    = usrp->get_num_mboards();
         size_t num_gps_locked = 0;
-        for (size_t mboard = 0; mboard < num_mboards; mboard++) {
-            std::cout << "Synchronizing mboard " << mboard << ": "
-                      << usrp->get_mboard_name(mboard) << std::endl;
 
-            // Set references to GPSDO
+        // Set references to GPSDO on all mboards first, so they all lock at
+        // the same time rather than one after the other
+        for (size_t mboard = 0; mboard < num_mboards; mboard++) {
             usrp->set_clock_source("gpsdo", mboard);
             usrp->set_time_source("gpsdo", mboard);
+        }
+
+        std::cout << std::endl;
+        print_notes();
+        std::cout << std::endl;
 
-            std::cout << std::endl;
-            print_notes();
-            std::cout << std::endl;
+        for (size_t mboard = 0; mboard < num_mboards; mboard++) {
+            std::cout << "Synchronizing mboard " << mboard << ": "
+                      << usrp->get_mboard_name(mboard) << std::endl;
 
             // Check for 10 MHz lock
             std::vector<std::string> sensor_names = usrp->get_mboard_sensor_names(mboard);
@@ -116,17 +120,20 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
             uhd::time_spec_t gps_time = uhd::time_spec_t(
                 int64_t(usrp->get_mboard_sensor("gps_time", mboard).to_int()));
             usrp->set_time_next_pps(gps_time + 1.0, mboard);
+        }
 
-            // Wait for it to apply
-            // The wait is 2 seconds because N-Series has a known issue where
-            // the time at the last PPS does not properly update at the PPS edge
-            // when the time is actually set.
-            std::this_thread::sleep_for(std::chrono::seconds(2));
+        // Wait for the times to apply, on all mboards at once
+        // The wait is 2 seconds because N-Series has a known issue where
+        // the time at the last PPS does not properly update at the PPS edge
+        // when the time is actually set.
+        std::this_thread::sleep_for(std::chrono::seconds(2));
 
+        for (size_t mboard = 0; mboard < num_mboards; mboard++) {
             // Check times
-            gps_time = uhd::time_spec_t(
+            uhd::time_spec_t gps_time = uhd::time_spec_t(
                 int64_t(usrp->get_mboard_sensor("gps_time", mboard).to_int()));
             uhd::time_spec_t time_last_pps = usrp->get_time_last_pps(mboard);
+            std::cout << "Mboard " << mboard << ":" << std::endl;
             std::cout << "USRP time: "
                       << (boost::format("%0.9f") % time_last_pps.get_real_secs())
                       << std::endl;
@@ -5,16 +5,15 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
-#include "wavetable.hpp"
 #include <uhd/exception.hpp>
 #include <uhd/usrp/multi_usrp.hpp>
 #include <uhd/utils/safe_main.hpp>
 #include <uhd/utils/static.hpp>
 #include <uhd/utils/thread.hpp>
+#include <uhd/utils/waveform_generator.hpp>
 #include <stdint.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
-#include <boost/math/special_functions/round.hpp>
 #include <boost/program_options.hpp>
 #include <chrono>
 #include <csignal>
@@ -39,7 +38,7 @@ void sig_int_handler(int)
 int UHD_SAFE_MAIN(int argc, char* argv[])
 {
     // variables to be set by po
-    std::string args, wave_type, ant, subdev, ref, pps, otw, channel_list;
+    std::string args, wave_type, wave_args, ant, subdev, ref, pps, otw, channel_list;
     uint64_t total_num_samps;
     size_t spb;
     double rate, freq, gain, power, wave_freq, bw, lo_offset;
@@ -63,8 +62,9 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         ("ant", po::value<std::string>(&ant), "antenna selection")
         ("subdev", po::value<std::string>(&subdev), "subdevice specification")
         ("bw", po::value<double>(&bw), "analog frontend filter bandwidth in Hz")
-        ("wave-type", po::value<std::string>(&wave_type)->default_value("CONST"), "waveform type (CONST, SQUARE, RAMP, SINE)")
+        ("wave-type", po::value<std::string>(&wave_type)->default_value("CONST"), "waveform type (CONST, SQUARE, RAMP, SINE, CHIRP, MULTITONE, NOISE)")
         ("wave-freq", po::value<double>(&wave_freq)->default_value(0), "waveform frequency in Hz")
+        ("wave-args", po::value<std::string>(&wave_args)->default_value(""), "further waveform options, e.g., freqs=-1e6:2e6 for MULTITONE or period=1e-3 for CHIRP")
         ("ref", po::value<std::string>(&ref)->default_value("internal"), "clock reference (internal, external, mimo, gpsdo)")
         ("pps", po::value<std::string>(&pps), "PPS source (internal, external, mimo, gpsdo)")
         ("otw", po::value<std::string>(&otw)->default_value("sc16"), "specify the over-the-wire sample mode")
@@ -128,21 +128,18 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         return ~0;
     }
 
-    // for the const wave, set the wave freq for small samples per period
-    if (wave_freq == 0) {
-        if (wave_type == "CONST") {
-            wave_freq = usrp->get_tx_rate() / 2;
-        } else {
-            throw std::runtime_error(
-                "wave freq cannot be 0 with wave type other than CONST");
-        }
+    if (wave_freq == 0 and wave_type != "CONST" and wave_type != "MULTITONE"
+        and wave_type != "NOISE") {
+        throw std::runtime_error("wave freq cannot be 0 with wave type " + wave_type);
     }
 
-    // pre-compute the waveform values
-    const wave_table_class wave_table(wave_type, ampl);
-    const size_t step =
-        boost::math::iround(wave_freq / usrp->get_tx_rate() * wave_table_len);
-    size_t index = 0;
+    // create the waveform generator, which throws when the waveform is not
+    // possible to generate
+    uhd::device_addr_t generator_args(wave_args);
+    generator_args["ampl"] = std::to_string(ampl);
+    generator_args["freq"] = std::to_string(wave_freq);
+    const uhd::waveform_generator::sptr generator =
+        uhd::waveform_generator::make(wave_type, usrp->get_tx_rate(), generator_args);
 
     for (size_t ch = 0; ch < channel_nums.size(); ch++) {
         std::cout << boost::format("Setting TX Freq: %f MHz...") % (freq / 1e6)
@@ -166,9 +163,9 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
                 return EXIT_FAILURE;
             }
             std::cout << "Setting TX output power: " << power << " dBm..." << std::endl;
-            usrp->set_tx_power_reference(power - wave_table.get_power(), ch);
+            usrp->set_tx_power_reference(power - generator->get_power(), ch);
             std::cout << "Actual TX output power: "
-                      << usrp->get_tx_power_reference(ch) + wave_table.get_power()
+                      << usrp->get_tx_power_reference(ch) + generator->get_power()
                       << " dBm..." << std::endl;
             if (vm.count("gain")) {
                 std::cout << "WARNING: If you specify both --power and --gain, "
@@ -202,14 +199,6 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
 
     std::this_thread::sleep_for(std::chrono::seconds(1)); // allow for some setup time
 
-    // error when the waveform is not possible to generate
-    if (std::abs(wave_freq) > usrp->get_tx_rate() / 2) {
-        throw std::runtime_error("wave freq out of Nyquist zone");
-    }
-    if (usrp->get_tx_rate() / std::abs(wave_freq) > wave_table_len / 2) {
-        throw std::runtime_error("wave freq too small for table");
-    }
-
     // create a transmit streamer
     // linearly map channels (index0 = channel0, index1 = channel1, ...)
     uhd::stream_args_t stream_args("fc32", otw);
@@ -224,9 +213,7 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     std::vector<std::complex<float>*> buffs(channel_nums.size(), &buff.front());
 
     // pre-fill the buffer with the waveform
-    for (size_t n = 0; n < buff.size(); n++) {
-        buff[n] = wave_table(index += step);
-    }
+    generator->generate(&buff.front(), buff.size());
 
     std::cout << boost::format("Setting device timestamp to 0...") << std::endl;
     if (channel_nums.size() > 1) {
@@ -313,9 +300,7 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         num_acc_samps += tx_stream->send(buffs, buff.size(), md);
 
         // fill the buffer with the waveform
-        for (size_t n = 0; n < buff.size(); n++) {
-            buff[n] = wave_table(index += step);
-        }
+        generator->generate(&buff.front(), buff.size());
 
         md.start_of_burst = false;
         md.has_time_spec  = false;
@@ -39,6 +39,16 @@ public:
     //! Populate this class from the serialized data
     virtual void deserialize(const std::vector<uint8_t>& data) = 0;
 
+    //! Populate this class from serialized data anywhere in memory
+    //
+    // This allows deserializing data without first copying it into a vector,
+    // e.g., from a uhd::usrp::cal::cal_data_view. The default implementation
+    // does copy the data, containers should override it if they can avoid that.
+    virtual void deserialize(const uint8_t* data, const size_t size)
+    {
+        deserialize(std::vector<uint8_t>(data, data + size));
+    }
+
     //! Generic factory for cal data from serialized data
     //
     // \tparam container_type The class type of cal data which should be
@@ -51,6 +61,20 @@ public:
         cal_data->deserialize(data);
         return cal_data;
     }
+
+    //! Generic factory for cal data from serialized data anywhere in memory
+    //
+    // \tparam container_type The class type of cal data which should be
+    //                        generated from \p data
+    // \param data Pointer to the serialized data
+    // \param size The size of the serialized data in bytes
+    template <typename container_type>
+    static std::shared_ptr<container_type> make(const uint8_t* data, const size_t size)
+    {
+        auto cal_data = container_type::make();
+        cal_data->deserialize(data, size);
+        return cal_data;
+    }
 };
 
 }}} // namespace uhd::usrp::cal
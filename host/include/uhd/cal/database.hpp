@@ -8,9 +8,11 @@
 
 #include <uhd/config.hpp>
 #include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
-#include <functional>
 
 namespace uhd { namespace usrp { namespace cal {
 
@@ -28,6 +30,26 @@ enum class source {
     USER //!< Provided by the user
 };
 
+/*! Read-only view of a calibration data BLOB
+ *
+ * Views are returned by database::map_cal_data(). The data they point to stays
+ * valid for as long as the view exists, even if the calibration data is
+ * replaced with database::write_cal_data() in the meantime.
+ */
+class UHD_API cal_data_view
+{
+public:
+    using sptr = std::shared_ptr<const cal_data_view>;
+
+    virtual ~cal_data_view() = default;
+
+    //! Return a pointer to the first byte of the data
+    virtual const uint8_t* data() const = 0;
+
+    //! Return the size of the data in bytes
+    virtual size_t size() const = 0;
+};
+
 /*! Calibration Data Storage/Retrieval Class
  *
  * UHD can store calibration data on disk or compiled within UHD. This class
@@ -87,6 +109,29 @@ public:
         const std::string& serial,
         const source source_type = source::ANY);
 
+    //! Return a read-only view of a calibration data set without copying it
+    //
+    // This looks up data like read_cal_data(), but instead of copying the data
+    // into a new array, files are memory-mapped, and data compiled into UHD is
+    // accessed in place. Only data read from flash is copied.
+    //
+    // Views of files are cached by key and serial for the lifetime of the
+    // process. Looking up the same data again (e.g., for another channel, or
+    // when a device is re-initialized) returns the same view, unless the file
+    // was changed in the meantime.
+    //
+    // \param key The calibration type key (e.g., "rx_iq")
+    // \param serial The serial number of the device this data is for. See also
+    //               \ref cal_db_serial
+    // \param source_type Where to read the calibration data from, see
+    //                    read_cal_data()
+    //
+    // \throws uhd::key_error if no calibration data is found matching the source
+    //                        type.
+    static cal_data_view::sptr map_cal_data(const std::string& key,
+        const std::string& serial,
+        const source source_type = source::ANY);
+
     //! Check if calibration data exists for a given source type
     //
     // This can be called before calling read_cal_data() to avoid having to
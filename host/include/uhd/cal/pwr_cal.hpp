@@ -40,6 +40,10 @@ namespace uhd { namespace usrp { namespace cal {
  * Within a data set, frequency and gain are interpolated in two dimensions (the
  * same is true for frequency and power for get_gain() and get_gain_coerced())
  * using a bilinear interpolation.
+ *
+ * For applications that look up power or gain values at a high rate, the data
+ * can be resampled onto uniform lookup grids (see set_lookup_grid()), which
+ * makes every look-up take constant time.
  */
 class UHD_API pwr_cal : public container
 {
@@ -139,6 +143,31 @@ public:
         const double freq,
         const boost::optional<int> temperature = boost::none) const = 0;
 
+    /*! Resample the data onto uniform lookup grids
+     *
+     * By default, get_power() and get_gain() search the data for the bounding
+     * data points on every call. After calling this, they interpolate on a
+     * uniform grid per temperature instead, which is computed here once and
+     * takes constant time to look up.
+     *
+     * The grid values are computed with the regular interpolation, so both
+     * agree on the grid points. Between grid points, the results differ by the
+     * resampling error, which shrinks as the grids get denser. A grid takes up
+     * 16 bytes per point. get_power_limits() is not affected.
+     *
+     * Adding power tables or clearing the data removes the grids, so this needs
+     * to be called again after the data has been loaded.
+     *
+     * \param num_freq_points The number of grid points on the frequency axis
+     * \param num_gain_points The number of grid points on the gain axis. The
+     *                        grids for get_gain() use the same number of points
+     *                        on the power axis.
+     * \throws uhd::value_error if either number of points is 1, or only one of
+     *         them is zero. If both are zero, the grids are removed.
+     */
+    virtual void set_lookup_grid(
+        const size_t num_freq_points, const size_t num_gain_points) = 0;
+
     //! Factory for new cal data sets
     static sptr make(
         const std::string& name, const std::string& serial, const uint64_t timestamp);
@@ -29,6 +29,10 @@ public:
     //! Set the scale factor (used in floating point conversions)
     virtual void set_scalar(const double) = 0;
 
+    //! Signature of a conversion kernel, see get_kernel()
+    typedef void (*kernel_type)(
+        converter*, const input_type&, const output_type&, const size_t);
+
     //! The public conversion method to convert inputs -> outputs
     UHD_INLINE void conv(const input_type& in, const output_type& out, const size_t num)
     {
@@ -36,7 +40,30 @@ public:
             (*this)(in, out, num);
     }
 
+    /*!
+     * Get a function that runs this converter without virtual dispatch
+     *
+     * This is for callers which run the same converter many times, like the
+     * streamers. The kernel must be called with this converter as its first
+     * argument. It reads the scale factor from the converter, so it remains
+     * valid after calling set_scalar(). Unlike conv(), it must not be called
+     * with zero items.
+     *
+     * Converters which don't override this return a kernel that forwards to
+     * the virtual call operator.
+     */
+    virtual kernel_type get_kernel(void)
+    {
+        return &converter::_virtual_kernel;
+    }
+
 private:
+    static void _virtual_kernel(
+        converter* self, const input_type& in, const output_type& out, const size_t num)
+    {
+        (*self)(in, out, num);
+    }
+
     //! Callable method: input vectors, output vectors, num samples
     //
     // This is the guts of the converter. When deriving new converter types,
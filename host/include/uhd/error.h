@@ -139,6 +139,37 @@ UHD_API void set_c_global_error_string(const std::string &msg);
     set_c_global_error_string("None"); \
     return UHD_ERROR_NONE;
 
+/*!
+ * Like UHD_SAFE_C_SAVE_ERROR(), for calls in the streaming path. Nothing is
+ * locked or assigned when the code succeeds: the handle's error string is
+ * cleared rather than set to "None", and the global error string is only set
+ * on errors.
+ */
+#define UHD_SAFE_C_SAVE_ERROR_FAST(h, ...) \
+    h->last_error.clear(); \
+    try{ __VA_ARGS__ } \
+    catch (const uhd::exception &e) { \
+        set_c_global_error_string(e.what()); \
+        h->last_error = e.what(); \
+        return error_from_uhd_exception(&e); \
+    } \
+    catch (const boost::exception &e) { \
+        set_c_global_error_string(boost::diagnostic_information(e)); \
+        h->last_error = boost::diagnostic_information(e); \
+        return UHD_ERROR_BOOSTEXCEPT; \
+    } \
+    catch (const std::exception &e) { \
+        set_c_global_error_string(e.what()); \
+        h->last_error = e.what(); \
+        return UHD_ERROR_STDEXCEPT; \
+    } \
+    catch (...) { \
+        set_c_global_error_string("Unrecognized exception caught."); \
+        h->last_error = "Unrecognized exception caught."; \
+        return UHD_ERROR_UNKNOWN; \
+    } \
+    return UHD_ERROR_NONE;
+
 extern "C" {
 #endif
 
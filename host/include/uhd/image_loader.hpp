@@ -13,6 +13,7 @@
 #include <uhd/utils/noncopyable.hpp>
 #include <functional>
 #include <string>
+#include <vector>
 
 namespace uhd {
 
@@ -67,6 +68,23 @@ public:
      */
     static bool load(const image_loader_args_t& image_loader_args);
 
+    //! Load firmware and/or FPGA onto several devices in parallel
+    /*!
+     * Every set of arguments is loaded as if by load(), each in its own thread.
+     * Loaders that read the same image file (e.g., the MPM loader) only read it
+     * from disk once for all devices.
+     *
+     * \param image_loader_args arguments for each device
+     * \param max_parallel the maximum number of devices to load at the same
+     *        time, or 0 to load all of them at once
+     * \return for each set of arguments, the return value of load()
+     * \throws uhd::runtime_error after all loads finished, if any of them threw.
+     *         The error message lists the arguments and errors of each failure.
+     */
+    static std::vector<bool> load_all(
+        const std::vector<image_loader_args_t>& image_loader_args,
+        const size_t max_parallel = 0);
+
     //! Get the instructions on how to recovery a particular device
     /*!
      * These instructions should be queried if the user interrupts an image loading
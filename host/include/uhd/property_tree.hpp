@@ -10,6 +10,7 @@
 
 #include <uhd/config.hpp>
 #include <uhd/utils/noncopyable.hpp>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
@@ -61,6 +62,10 @@ namespace uhd {
  * notification using the desired and coerced subscribers.
  * Publishers are useful for creating read-only properties.
  *
+ * In a property_tree::transaction, set() only updates the desired value right
+ * away. The subscribers and the coercer run when the transaction is committed,
+ * or when the value of the property is read before that.
+ *
  * Requirements for the template type T:
  * - T must have a copy constructor
  * - T must have an assignment operator
@@ -189,6 +194,51 @@ property<T>::~property(void)
     /* NOP */
 }
 
+/*! The sets of a property tree that wait for its transaction to commit
+ *
+ * This is used by the properties of a tree, use property_tree::transaction to
+ * defer sets.
+ */
+class UHD_API property_set_queue : uhd::noncopyable
+{
+public:
+    typedef std::shared_ptr<property_set_queue> sptr;
+
+    virtual ~property_set_queue(void) = 0;
+
+    //! True if a transaction is open on the tree
+    bool active(void) const
+    {
+        return _active.load(std::memory_order_acquire);
+    }
+
+    /*! Queues the rest of a set, if the calling thread has a transaction open
+     *
+     * A property is only queued once, at the position of its first set, so
+     * that its subscribers and coercer run once per transaction.
+     *
+     * \param prop The property
+     * \param apply Runs the subscribers and coercer of the property
+     * \return false if the set must be applied right away instead
+     */
+    virtual bool defer(const void* prop, const std::function<void(void)>& apply) = 0;
+
+    //! Applies the queued set of a property now, e.g., because it's read
+    virtual void apply(const void* prop) = 0;
+
+    //! Drops the queued set of a property that is destroyed
+    virtual void cancel(const void* prop) = 0;
+
+    //! Opens a transaction on the calling thread, see property_tree::transaction
+    virtual void begin(void) = 0;
+
+    //! Applies all queued sets once the outermost transaction is committed
+    virtual void commit(void) = 0;
+
+protected:
+    std::atomic<bool> _active{false};
+};
+
 /*!
  * FS Path: A glorified string with path manipulations.
  * Inspired by boost filesystem path, but without the dependency.
@@ -243,11 +293,71 @@ public:
     template <typename T>
     property<T>& access(const fs_path& path);
 
+    /*! Get a handle to a property in the tree
+     *
+     * The path is only looked up once, so this is the preferred way to access
+     * a property repeatedly (e.g., from a streaming thread). The handle keeps
+     * the property alive even if it is removed from the tree.
+     */
+    template <typename T>
+    std::shared_ptr<property<T>> get_handle(const fs_path& path);
+
     //! Pop a property off the tree, and returns the property
     template <typename T>
     std::shared_ptr<property<T>> pop(const fs_path& path);
 
+    /*! Defers the sets on the properties of a tree while it exists
+     *
+     * Configuring many values one after another (e.g., rates, frequencies, and
+     * gains of several channels) runs the subscribers and coercers of each set
+     * right away, even if the same property is set again later on. Within a
+     * transaction, set() only updates the desired value of a property. Its
+     * subscribers and coercer run once, when the transaction is committed:
+     * \code{.cpp}
+     * {
+     *     uhd::property_tree::transaction txn(*tree);
+     *     for (const auto& setting : settings) {
+     *         tree->access<double>(setting.first).set(setting.second);
+     *     }
+     *     txn.commit();
+     * }
+     * \endcode
+     *
+     * The queued sets are applied in the order in which the properties were
+     * first set. Reading a property whose set is still queued (e.g., from
+     * the coercer of another property) applies that set first, so a property
+     * is applied before the properties that depend on it.
+     *
+     * A transaction only defers the sets of the thread that opened it, and
+     * applies to the whole tree, including its subtrees. Transactions may be
+     * nested, the sets are applied when the outermost one is committed. A
+     * transaction on another thread waits for the open one to be committed.
+     */
+    class UHD_API transaction : uhd::noncopyable
+    {
+    public:
+        //! Opens a transaction on the tree
+        transaction(property_tree& tree);
+
+        //! Commits the transaction, if it wasn't yet. Errors are logged.
+        ~transaction(void);
+
+        /*! Applies the queued sets
+         *
+         * If a subscriber or coercer throws, the sets that are still queued
+         * are dropped, and the exception is passed on.
+         */
+        void commit(void);
+
+    private:
+        property_set_queue::sptr _queue;
+        bool _open;
+    };
+
 private:
+    //! Internal access to the queue of deferred sets (see transaction)
+    virtual property_set_queue::sptr _get_set_queue(void) const = 0;
+
     //! Internal pop function
     virtual std::shared_ptr<void> _pop(const fs_path& path) = 0;
 
@@ -260,7 +370,7 @@ private:
     virtual std::shared_ptr<void>& _access(const fs_path& path) const = 0;
 
     //! Internal access property with wild-card type but with type verification
-    virtual std::shared_ptr<void>& _access_with_type_check(
+    virtual std::shared_ptr<void> _access_with_type_check(
         const fs_path& path, std::type_index expected_prop_type) const = 0;
 };
 
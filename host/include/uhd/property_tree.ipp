@@ -22,7 +22,9 @@ template <typename T>
 class property_impl : public property<T>
 {
 public:
-    property_impl<T>(property_tree::coerce_mode_t mode) : _coerce_mode(mode)
+    property_impl<T>(property_tree::coerce_mode_t mode,
+        property_set_queue::sptr set_queue = property_set_queue::sptr())
+        : _coerce_mode(mode), _set_queue(set_queue)
     {
         if (_coerce_mode == property_tree::AUTO_COERCE) {
             _coercer = DEFAULT_COERCER;
@@ -31,7 +33,9 @@ public:
 
     ~property_impl<T>(void)
     {
-        /* NOP */
+        if (_set_queue && _set_queue->active()) {
+            _set_queue->cancel(this);
+        }
     }
 
     property<T>& set_coercer(const typename property<T>::coercer_type& coercer)
@@ -89,6 +93,16 @@ public:
     property<T>& set(const T& value)
     {
         init_or_set_value(_value, value);
+        // In a transaction, the rest waits for the commit
+        if (!(_set_queue && _set_queue->active()
+                && _set_queue->defer(this, [this]() { _apply_set(); }))) {
+            _apply_set();
+        }
+        return *this;
+    }
+
+    void _apply_set(void)
+    {
         for (typename property<T>::subscriber_type& dsub : _desired_subscribers) {
             dsub(get_value_ref(_value)); // let errors propagate
         }
@@ -98,7 +112,6 @@ public:
             if (_coerce_mode == property_tree::AUTO_COERCE)
                 uhd::assertion_error("coercer missing for an auto coerced property");
         }
-        return *this;
     }
 
     property<T>& set_coerced(const T& value)
@@ -114,6 +127,9 @@ public:
         if (empty()) {
             throw uhd::runtime_error("Cannot get() on an uninitialized (empty) property");
         }
+        if (_set_queue && _set_queue->active()) {
+            _set_queue->apply(this);
+        }
         if (_publisher) {
             return _publisher();
         } else {
@@ -162,6 +178,7 @@ private:
     }
 
     const property_tree::coerce_mode_t _coerce_mode;
+    const property_set_queue::sptr _set_queue;
     std::vector<typename property<T>::subscriber_type> _desired_subscribers;
     std::vector<typename property<T>::subscriber_type> _coerced_subscribers;
     typename property<T>::publisher_type _publisher;
@@ -181,7 +198,8 @@ template <typename T>
 property<T>& property_tree::create(const fs_path& path, coerce_mode_t coerce_mode)
 {
     this->_create(path,
-        typename std::shared_ptr<property<T> >(new property_impl<T>(coerce_mode)),
+        typename std::shared_ptr<property<T> >(
+            new property_impl<T>(coerce_mode, this->_get_set_queue())),
         std::type_index(typeid(T)));
     return this->access<T>(path);
 }
@@ -193,6 +211,13 @@ property<T>& property_tree::access(const fs_path& path)
         this->_access_with_type_check(path, std::type_index(typeid(T))));
 }
 
+template <typename T>
+typename std::shared_ptr<property<T> > property_tree::get_handle(const fs_path& path)
+{
+    return std::static_pointer_cast<property<T> >(
+        this->_access_with_type_check(path, std::type_index(typeid(T))));
+}
+
 template <typename T>
 typename std::shared_ptr<property<T> > property_tree::pop(const fs_path& path)
 {
@@ -78,6 +78,29 @@ protected:
     rx_event_action_info(uhd::rx_metadata_t::error_code_t error_code);
 };
 
+/*! A timed command that changes the samples of an RX stream
+ *
+ * The radio posts this downstream when a tune or gain change is issued for a
+ * command time, so the streamer can tag the samples (see rx_metadata_t::tags).
+ */
+struct UHD_API rx_tag_action_info : public action_info
+{
+public:
+    using sptr = std::shared_ptr<rx_tag_action_info>;
+
+    //! What the command changed
+    uhd::rx_tag_t::tag_type_t type;
+
+    //! When the command takes effect, in ticks
+    uint64_t tsf;
+
+    //! Factory function
+    static sptr make(const uhd::rx_tag_t::tag_type_t type, const uint64_t tsf);
+
+protected:
+    rx_tag_action_info(const uhd::rx_tag_t::tag_type_t type, const uint64_t tsf);
+};
+
 struct UHD_API tx_event_action_info : public action_info
 {
 public:
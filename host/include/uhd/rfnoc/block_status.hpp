@@ -0,0 +1,30 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/rfnoc/block_id.hpp>
+#include <cstdint>
+
+namespace uhd { namespace rfnoc {
+
+/*! Status of an RFNoC block, as reported by the backend of its device
+ *
+ * See uhd::rfnoc_graph::get_block_status().
+ */
+struct block_status_t
+{
+    //! The ID of the block, e.g. "0/Radio#0"
+    block_id_t block_id;
+    //! The NoC ID of the block
+    uint32_t noc_id = 0;
+    //! True while the data ports of the block are being flushed
+    bool flush_active = false;
+    //! True once flushing the data ports of the block has completed
+    bool flush_done = false;
+};
+
+}} // namespace uhd::rfnoc
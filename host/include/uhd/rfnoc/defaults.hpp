@@ -37,6 +37,7 @@ static const io_type_t IO_TYPE_U8   = "u8";
 static const std::string ACTION_KEY_STREAM_CMD("stream_cmd");
 static const std::string ACTION_KEY_RX_EVENT("rx_event");
 static const std::string ACTION_KEY_RX_RESTART_REQ("restart_request");
+static const std::string ACTION_KEY_RX_TAG("rx_tag");
 static const std::string ACTION_KEY_TX_EVENT("tx_event");
 
 //! If the block name can't be automatically detected, this name is used
@@ -12,11 +12,44 @@
 namespace uhd { namespace rfnoc {
 
 /*! DMA FIFO Block Control Class
+ *
+ * The DMA FIFO block buffers every channel in DRAM. When it sits between a
+ * TX stream endpoint and the radio, the host can send in bursts at the full
+ * rate of the link, and the FIFO absorbs the jitter of the host's scheduling:
+ * The stream endpoint hands its data on to the FIFO right away, so flow
+ * control only pushes back on the host once the DRAM buffer is full, not
+ * when the much smaller endpoint buffer is. At typical sample rates, the
+ * DRAM holds seconds worth of samples.
+ *
+ * The fill level of the FIFO tells the host how far ahead of the radio it
+ * is. It's read in a single register transaction, so it's cheap enough to
+ * poll while streaming, e.g., to keep the fill level within a window.
  */
 class UHD_API dmafifo_block_control : public noc_block_base
 {
 public:
     RFNOC_DECLARE_BLOCK(dmafifo_block_control)
+
+    /*! Return the size of the FIFO of a channel
+     *
+     * \param chan The block channel
+     * \returns The FIFO size in bytes
+     */
+    virtual uint64_t get_fifo_size(const size_t chan = 0) const = 0;
+
+    /*! Return the fill level of the FIFO of a channel
+     *
+     * \param chan The block channel
+     * \returns The number of bytes currently held in the FIFO
+     */
+    virtual uint64_t get_fifo_fullness(const size_t chan = 0) = 0;
+
+    /*! Return the number of packets that went through the FIFO of a channel
+     *
+     * \param chan The block channel
+     * \returns The packet count. This is a 32-bit counter that wraps around.
+     */
+    virtual uint32_t get_packet_count(const size_t chan = 0) = 0;
 };
 
 }} // namespace uhd::rfnoc
@@ -51,6 +51,9 @@ public:
      * larger than the maximum number of coefficients supported by the block,
      * a `uhd::value_error` is thrown.
      *
+     * The coefficients are stored in the selected coefficient bank, see
+     * select_coefficient_bank().
+     *
      * \param coeffs A vector of integer coefficients for the FIR filter
      */
     virtual void set_coefficients(const std::vector<int16_t>& coeffs) = 0;
@@ -62,6 +65,65 @@ public:
      * \returns The vector of current filter coefficients
      */
     virtual std::vector<int16_t> get_coefficients() const = 0;
+
+    /*! Get the number of coefficient banks
+     *
+     * A coefficient bank is a set of filter coefficients that is loaded ahead
+     * of time, so that switching the filter to it later takes only
+     * select_coefficient_bank(). The FIR filter block holds a single set of
+     * coefficients, so the banks are stored by the block controller. Bank 0
+     * is selected when the block is created, and every bank starts out with
+     * an impulse response.
+     *
+     * \returns The number of coefficient banks
+     */
+    virtual size_t get_num_coefficient_banks() const = 0;
+
+    /*! Set the filter coefficients of a bank
+     *
+     * The coefficients are padded with zeroes like with set_coefficients().
+     * If \p bank is the selected bank, the hardware is reprogrammed right
+     * away, otherwise the coefficients take effect when the bank is selected.
+     *
+     * \param bank The index of the coefficient bank
+     * \param coeffs A vector of integer coefficients for the FIR filter
+     * \throws uhd::value_error if there are too many coefficients, or if the
+     *         bank does not exist
+     */
+    virtual void set_bank_coefficients(
+        const size_t bank, const std::vector<int16_t>& coeffs) = 0;
+
+    /*! Get the filter coefficients of a bank
+     *
+     * \param bank The index of the coefficient bank
+     * \returns The padded vector of the coefficients of this bank
+     * \throws uhd::value_error if the bank does not exist
+     */
+    virtual std::vector<int16_t> get_bank_coefficients(const size_t bank) const = 0;
+
+    /*! Switch the filter to the coefficients of a bank
+     *
+     * All coefficients but the last one are written to the block right away,
+     * as one batch of register writes. The hardware only starts using them
+     * with the write of the last coefficient, which is a single register
+     * write that is executed at \p time. This makes the switch between two
+     * filters happen at a well-defined sample, e.g., at a slot boundary.
+     *
+     * Note that a timed register write holds back all following register
+     * writes to this block until it has been executed.
+     *
+     * \param bank The index of the coefficient bank
+     * \param time The time at which the filter switches to the bank
+     * \throws uhd::value_error if the bank does not exist
+     */
+    virtual void select_coefficient_bank(
+        const size_t bank, const uhd::time_spec_t& time = uhd::time_spec_t::ASAP) = 0;
+
+    /*! Get the selected coefficient bank
+     *
+     * \returns The index of the coefficient bank that was selected last
+     */
+    virtual size_t get_coefficient_bank() const = 0;
 };
 
 }} // namespace uhd::rfnoc
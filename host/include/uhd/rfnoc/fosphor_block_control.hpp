@@ -93,7 +93,8 @@ enum class fosphor_waterfall_predivision_ratio {
  *
  * These streams are intended to be inputs to the GNU Radio Fosphor
  * display block, which renders the streams in a entertaining graphical
- * format.
+ * format. To receive whole histograms (which end at EOB) or waterfall rows
+ * on the host, use a u8 streamer with a uhd::rx_frame_streamer.
  */
 class UHD_API fosphor_block_control : public noc_block_base
 {
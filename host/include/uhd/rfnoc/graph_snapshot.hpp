@@ -0,0 +1,68 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/rfnoc/graph_edge.hpp>
+#include <string>
+#include <vector>
+
+namespace uhd { namespace rfnoc {
+
+/*! A snapshot of the configuration of an uhd::rfnoc_graph
+ *
+ * A snapshot holds the connections between blocks of a graph, and the values
+ * of the user properties of its blocks. It is taken with
+ * uhd::rfnoc_graph::export_snapshot(), and can be stored as a string. A new
+ * session on the same devices can apply it with
+ * uhd::rfnoc_graph::import_snapshot() instead of making all the connections
+ * and setting all the properties one by one.
+ *
+ * Connections to streamers are not part of a snapshot, since streamers only
+ * live as long as the session that created them.
+ */
+struct UHD_API graph_snapshot_t
+{
+    //! The value of a user property of a block
+    struct property_value_t
+    {
+        //! The ID of the block, e.g. "0/Radio#0"
+        std::string block_id;
+        //! The ID of the property
+        std::string prop_id;
+        //! The instance of the property
+        size_t instance = 0;
+        //! The value of the property, as it would be passed to set_properties()
+        std::string value;
+
+        bool operator==(const property_value_t& rhs) const
+        {
+            return block_id == rhs.block_id && prop_id == rhs.prop_id
+                   && instance == rhs.instance && value == rhs.value;
+        }
+    };
+
+    //! The connections between blocks, static and dynamic
+    std::vector<graph_edge_t> edges;
+    //! The values of the block properties, in the order they are set
+    std::vector<property_value_t> properties;
+
+    /*! Return a text representation of this snapshot
+     *
+     * The text has one line per edge or property, and can be read back with
+     * from_string().
+     */
+    std::string to_string() const;
+
+    /*! Read a snapshot from its text representation
+     *
+     * \throws uhd::value_error if \p snapshot is not a valid snapshot
+     */
+    static graph_snapshot_t from_string(const std::string& snapshot);
+};
+
+}} /* namespace uhd::rfnoc */
@@ -16,6 +16,9 @@ namespace uhd { namespace rfnoc {
  * The Log Power Block is an RFNoC block that takes in a packet of signed
  * 16-bit complex samples and computes an estimate of 1024 * log2(i^2 + q^2),
  * putting the result in the upper 16 bits of each 32-bit output sample.
+ *
+ * To receive the output one FFT at a time, e.g., for a display, use an
+ * s16 streamer with a uhd::rx_frame_streamer.
  */
 class UHD_API logpwr_block_control : public noc_block_base
 {
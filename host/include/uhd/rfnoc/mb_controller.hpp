@@ -12,13 +12,19 @@
 #include <uhd/types/time_spec.hpp>
 #include <uhd/usrp/mboard_eeprom.hpp>
 #include <uhd/utils/noncopyable.hpp>
+#include <uhd/utils/tasks.hpp>
 #include <unordered_map>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <vector>
 
 namespace uhd { namespace rfnoc {
 
+namespace detail {
+class time_correlator;
+}
+
 /*! A default block controller for blocks that can't be found in the registry
  */
 class UHD_API mb_controller : public uhd::noncopyable
@@ -103,6 +109,50 @@ public:
             return _tick_rate;
         }
 
+        /*! Estimate the current time without reading it from the device
+         *
+         * Every call to get_time_now() also tells the timekeeper how the
+         * device time relates to the host clock. From those readings, it
+         * estimates the offset and the drift of the device time, and this
+         * method uses that estimate instead of going to the device. To keep
+         * the estimate fresh without calling get_time_now(), enable the time
+         * correlation of this timekeeper (see
+         * mb_controller::set_time_correlation_interval()).
+         *
+         * Setting the time drops the estimate. Until the device time was
+         * read again, there is no estimate.
+         *
+         * \throws uhd::runtime_error if there is no estimate
+         */
+        uhd::time_spec_t get_time_estimate();
+
+        /*! Estimate the device time at a given host time
+         *
+         * See get_time_estimate(). Host times are times of
+         * std::chrono::steady_clock.
+         *
+         * \throws uhd::runtime_error if there is no estimate
+         */
+        uhd::time_spec_t get_time_estimate(
+            const std::chrono::steady_clock::time_point host_time);
+
+        /*! Estimate when the device reaches a given time
+         *
+         * This returns the host time (a time of std::chrono::steady_clock)
+         * at which the device time will be \p device_time, e.g. to tell if a
+         * timed command can still make its deadline. See also
+         * get_time_estimate().
+         *
+         * \throws uhd::runtime_error if there is no estimate
+         */
+        std::chrono::steady_clock::time_point get_host_time(
+            const uhd::time_spec_t& device_time);
+
+        /*! Returns true if get_time_estimate() and get_host_time() can be
+         *  called
+         */
+        bool has_time_estimate() const;
+
     protected:
         /*! Set the tick rate
          *
@@ -123,6 +173,8 @@ public:
     private:
         //! Ticks/Second
         double _tick_rate = 1.0;
+        //! Relation between the device time and the host clock
+        std::shared_ptr<detail::time_correlator> _time_correlator;
     };
 
     //! Returns the number of timekeepers, which equals the number of timebases
@@ -134,6 +186,22 @@ public:
     // \throws uhd::index_error if \p tk_idx is not valid
     timekeeper::sptr get_timekeeper(const size_t tk_idx) const;
 
+    /*! Keep the time estimate of a timekeeper up to date
+     *
+     * This reads the time of timekeeper \p tk_idx every \p interval seconds
+     * in the background, so timekeeper::get_time_estimate() and
+     * timekeeper::get_host_time() stay accurate without the application
+     * reading the time itself. An interval of zero stops the background
+     * reads.
+     *
+     * \param tk_idx The index of the timekeeper
+     * \param interval The time between two reads of the device time, in
+     *                 seconds
+     * \throws uhd::index_error if \p tk_idx is not valid
+     * \throws uhd::value_error if \p interval is negative
+     */
+    void set_time_correlation_interval(const size_t tk_idx, const double interval);
+
     /**************************************************************************
      * Motherboard Control
      *************************************************************************/
@@ -335,6 +403,18 @@ public:
      */
     virtual std::vector<std::string> get_sensor_names() = 0;
 
+    /*! Get several motherboard sensor values at once
+     *
+     * The default implementation calls get_sensor() for every name. Devices
+     * where every sensor read is a round trip (e.g., an RPC call) read all
+     * sensors in one go instead.
+     *
+     * \param names the names of the sensors
+     * \return the sensor values, in the order of \p names
+     */
+    virtual std::vector<uhd::sensor_value_t> get_sensors(
+        const std::vector<std::string>& names);
+
     /*! Return the motherboard EEPROM data
      */
     virtual uhd::usrp::mboard_eeprom_t get_eeprom() = 0;
@@ -396,6 +476,8 @@ private:
      * Attributes
      *************************************************************************/
     std::unordered_map<size_t, timekeeper::sptr> _timekeepers;
+    //! Background tasks that read the timekeeper times, by timekeeper index
+    std::unordered_map<size_t, uhd::task::sptr> _time_correlation_tasks;
 };
 
 }} // namespace uhd::rfnoc
@@ -12,6 +12,7 @@
 #include <uhd/types/time_spec.hpp>
 #include <cstdint>
 #include <functional>
+#include <future>
 #include <memory>
 #include <vector>
 
@@ -65,6 +66,25 @@ public:
         _reg_iface_holder.regs().poke32(_get_addr(addr, instance), data, time, ack);
     }
 
+    /*! Write a 32-bit register without waiting for the transaction to complete.
+     *
+     * See register_iface::poke32_async().
+     *
+     * \param addr The byte address of the register to write to (truncated to 20 bits).
+     * \param data New value of this register.
+     * \param instance The index of the block of registers to which the write applies
+     * \param time The time at which the transaction should be executed.
+     * \return A future that is ready when the transaction has completed.
+     */
+    inline std::future<void> poke32_async(uint32_t addr,
+        uint32_t data,
+        const size_t instance = 0,
+        uhd::time_spec_t time = uhd::time_spec_t::ASAP)
+    {
+        return _reg_iface_holder.regs().poke32_async(
+            _get_addr(addr, instance), data, time);
+    }
+
     /*! Write two consecutive 32-bit registers implemented in the NoC block from
      * one 64-bit value.
      *
@@ -276,6 +296,19 @@ public:
             _get_addr(addr, instance), data, mask, timeout, time, ack);
     }
 
+    /*! Mark a register as volatile in the shadow register cache
+     *
+     * See register_iface_holder::set_volatile_reg(). This has no effect if
+     * the shadow register cache is not enabled.
+     *
+     * \param addr The byte address of the register (truncated to 20 bits).
+     * \param instance The index of the block of registers the register belongs to.
+     */
+    inline void set_volatile(uint32_t addr, const size_t instance = 0)
+    {
+        _reg_iface_holder.set_volatile_reg(_get_addr(addr, instance));
+    }
+
 private:
     register_iface_holder& _reg_iface_holder;
     uint32_t _block_base_addr;
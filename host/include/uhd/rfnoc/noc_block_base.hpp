@@ -13,6 +13,7 @@
 #include <uhd/rfnoc/node.hpp>
 #include <uhd/rfnoc/register_iface_holder.hpp>
 #include <uhd/types/device_addr.hpp>
+#include <uhd/utils/noncopyable.hpp>
 
 //! Shorthand for block constructor
 #define RFNOC_BLOCK_CONSTRUCTOR(CLASS_NAME) \
@@ -145,6 +146,34 @@ public:
         return _tree;
     }
 
+    /*! Batches the register writes of a block while it exists
+     *
+     * This calls register_iface::begin_batch() on the block's registers when
+     * constructed, and register_iface::end_batch() when destroyed, e.g.:
+     * \code{.cpp}
+     * {
+     *     noc_block_base::batch_scope batch(*this);
+     *     for (size_t i = 0; i < coeffs.size(); i++) {
+     *         regs().poke32(COEFF_ADDR + 4 * i, coeffs[i]);
+     *     }
+     * } // Writes are sent here
+     * \endcode
+     *
+     * Errors while sending the writes at the end of the scope are logged, not
+     * thrown. Use an ACK'ed transaction after the scope to make sure the
+     * writes went through.
+     */
+    class UHD_API batch_scope : uhd::noncopyable
+    {
+    public:
+        batch_scope(noc_block_base& block);
+        ~batch_scope();
+
+    private:
+        register_iface& _regs;
+        const std::string _unique_id;
+    };
+
 protected:
     noc_block_base(make_args_ptr make_args);
 
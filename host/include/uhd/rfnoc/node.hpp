@@ -25,6 +25,61 @@
 
 namespace uhd { namespace rfnoc {
 
+class node_t;
+
+/*! A typed reference to a property of a node
+ *
+ * node_t::set_property() and node_t::get_property() find the property by its
+ * ID and source info, and check its type, on every call. A handle does this
+ * once, when it is created by node_t::get_property_handle(). Accessing the
+ * property through the handle has the same access rules, and triggers the
+ * same property resolution, but skips the lookup.
+ *
+ * A handle is only valid as long as the node that it was created by.
+ *
+ * \tparam prop_data_t The data type of the property
+ */
+template <typename prop_data_t>
+class property_handle
+{
+public:
+    //! Create an invalid handle. Accessing it throws a uhd::lookup_error.
+    property_handle() = default;
+
+    /*! Set the value of the property
+     *
+     * This is equivalent to node_t::set_property(), and triggers a property
+     * resolution.
+     */
+    void set(const prop_data_t& val);
+
+    /*! Get the value of the property
+     *
+     * This is equivalent to node_t::get_property(). Like that, it is not
+     * const, because it resolves the properties before reading the value.
+     */
+    const prop_data_t& get();
+
+    //! Returns true if this handle refers to a property
+    bool is_valid() const
+    {
+        return _node != nullptr;
+    }
+
+private:
+    friend class node_t;
+
+    property_handle(node_t* node, property_t<prop_data_t>* prop)
+        : _node(node), _prop(prop)
+    {
+    }
+
+    void _assert_valid() const;
+
+    node_t* _node                  = nullptr;
+    property_t<prop_data_t>* _prop = nullptr;
+};
+
 /*! The base class for all nodes within an RFNoC graph
  *
  * The block supports the following types of data access:
@@ -182,6 +237,24 @@ public:
     const prop_data_t& get_property(
         const std::string& id, const size_t instance = 0) /* mutable */;
 
+    /*! Get a handle to a specific user property that belongs to this block
+     *
+     * This finds the property only once. Calling set() or get() on the handle
+     * is equivalent to calling set_property() or get_property(), but skips
+     * finding the property by its ID, and checking its type. This is useful
+     * for properties that are accessed often.
+     *
+     * \tparam prop_data_t The data type of the property
+     * \param id The identifier of the property
+     * \param instance The instance number of this property
+     * \return A handle to the property
+     * \throws uhd::lookup_error if the property can't be found.
+     * \throws uhd::type_error if the property has a different type
+     */
+    template <typename prop_data_t>
+    property_handle<prop_data_t> get_property_handle(
+        const std::string& id, const size_t instance = 0);
+
     /*! Standard API for setting the command time
      *
      * There are instances where commands need a time associated with them.
@@ -349,6 +422,33 @@ protected:
     const prop_data_t& get_property(
         const std::string& id, const res_source_info& src_info) /* mutable */;
 
+    /*! Get a handle to a property
+     *
+     * This is like get_property_handle(), but it also allows accessing edge
+     * properties.
+     *
+     * \tparam prop_data_t The data type of the property
+     * \param id The identifier of the property
+     * \param src_info Source info of this property
+     * \return A handle to the property
+     * \throws uhd::lookup_error if the property can't be found.
+     * \throws uhd::type_error if the property has a different type
+     */
+    template <typename prop_data_t>
+    property_handle<prop_data_t> get_property_handle(
+        const std::string& id, const res_source_info& src_info);
+
+    /*! Get a handle to a property that this node registered
+     *
+     * This requires no lookup at all, so blocks can use it to set their own
+     * properties. A handle is cheap to create, it does not need to be stored.
+     *
+     * \param prop A property that was registered with register_property()
+     * \return A handle to the property
+     */
+    template <typename prop_data_t>
+    property_handle<prop_data_t> get_property_handle(property_t<prop_data_t>* prop);
+
     /******************************************
      * Internal action forwarding
      ******************************************/
@@ -466,6 +566,8 @@ protected:
 
 private:
     friend class node_accessor_t;
+    template <typename prop_data_t>
+    friend class property_handle;
 
     /*! Return a reference to a property, if it exists.
      *
@@ -88,5 +88,63 @@ const prop_data_t& node_t::get_property(
     return prop_ptr->get();
 }
 
+template <typename prop_data_t>
+property_handle<prop_data_t> node_t::get_property_handle(
+    const std::string& id, const size_t instance)
+{
+    res_source_info src_info{res_source_info::USER, instance};
+    return get_property_handle<prop_data_t>(id, src_info);
+}
+
+template <typename prop_data_t>
+property_handle<prop_data_t> node_t::get_property_handle(
+    const std::string& id, const res_source_info& src_info)
+{
+    return property_handle<prop_data_t>(this,
+        _assert_prop<prop_data_t>(_find_property(src_info, id), get_unique_id(), id));
+}
+
+template <typename prop_data_t>
+property_handle<prop_data_t> node_t::get_property_handle(property_t<prop_data_t>* prop)
+{
+    return property_handle<prop_data_t>(this, prop);
+}
+
+template <typename prop_data_t>
+void property_handle<prop_data_t>::set(const prop_data_t& val)
+{
+    _assert_valid();
+    UHD_LOG_TRACE(_node->get_unique_id(),
+        "Setting property " << _prop->get_id() << "@"
+                            << _prop->get_src_info().to_string());
+    {
+        auto prop_access = _node->_request_property_access(_prop, property_base_t::RW);
+        _prop->set(val);
+    }
+
+    // Now trigger a property resolution, like node_t::set_property() does
+    _node->resolve_all();
+}
+
+template <typename prop_data_t>
+const prop_data_t& property_handle<prop_data_t>::get()
+{
+    _assert_valid();
+    UHD_LOG_TRACE(_node->get_unique_id(),
+        "Getting property " << _prop->get_id() << "@"
+                            << _prop->get_src_info().to_string());
+    _node->resolve_all();
+    auto prop_access = _node->_request_property_access(_prop, property_base_t::RO);
+    return _prop->get();
+}
+
+template <typename prop_data_t>
+void property_handle<prop_data_t>::_assert_valid() const
+{
+    if (!_node) {
+        throw uhd::lookup_error("Cannot access a property through an invalid handle");
+    }
+}
+
 }} /* namespace uhd::rfnoc */
 
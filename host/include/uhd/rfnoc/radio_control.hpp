@@ -15,6 +15,7 @@
 #include <uhd/types/ranges.hpp>
 #include <uhd/types/sensors.hpp>
 #include <uhd/types/stream_cmd.hpp>
+#include <future>
 
 namespace uhd { namespace rfnoc {
 
@@ -144,6 +145,66 @@ public:
      */
     virtual uhd::freq_range_t get_rx_frequency_range(const size_t chan) const = 0;
 
+    /*! Prepare a table of TX frequencies for fast hopping on channel \p chan.
+     *
+     * This tunes the channel to every frequency in \p freqs, and records the
+     * register writes of each tune. A hop with tx_hop() then only replays the
+     * writes of one entry as a burst of register writes, without repeating
+     * the tuning calculations and property propagation.
+     *
+     * The driver may only write the registers that change between two tunes,
+     * so each entry is recorded starting from the state of the previous one
+     * (and the first entry starting from the last one). Hops must therefore
+     * visit the entries in the order of the table, wrapping around at its end.
+     * When this returns, the channel is tuned to the last frequency of the
+     * table, so the first hop must be to entry 0.
+     *
+     * Hops only repeat the parts of a tune that go through the registers of
+     * this block, they don't wait for LOs to lock, and they don't change the
+     * value returned by get_tx_frequency().
+     *
+     * \param freqs The frequencies of the table entries in Hz. An empty list
+     *              clears the table.
+     * \param chan The channel
+     * \return The actual frequencies of the table entries
+     */
+    virtual std::vector<double> set_tx_hop_table(
+        const std::vector<double>& freqs, const size_t chan) = 0;
+
+    /*! Hop to an entry of the TX hop table of channel \p chan.
+     *
+     * The hop is executed at the current command time, see set_tx_hop_table()
+     * for its limitations.
+     *
+     * \param index The table entry, which must follow the previous hop
+     * \param chan The channel
+     * \throws uhd::index_error if the table has no entry \p index
+     */
+    virtual void tx_hop(const size_t index, const size_t chan) = 0;
+
+    /*! Prepare a table of RX frequencies for fast hopping on channel \p chan.
+     *
+     * See set_tx_hop_table(), which works the same way for TX.
+     *
+     * \param freqs The frequencies of the table entries in Hz. An empty list
+     *              clears the table.
+     * \param chan The channel
+     * \return The actual frequencies of the table entries
+     */
+    virtual std::vector<double> set_rx_hop_table(
+        const std::vector<double>& freqs, const size_t chan) = 0;
+
+    /*! Hop to an entry of the RX hop table of channel \p chan.
+     *
+     * The hop is executed at the current command time, see set_tx_hop_table()
+     * for its limitations.
+     *
+     * \param index The table entry, which must follow the previous hop
+     * \param chan The channel
+     * \throws uhd::index_error if the table has no entry \p index
+     */
+    virtual void rx_hop(const size_t index, const size_t chan) = 0;
+
     /*! Return a list of valid TX gain names
      */
     virtual std::vector<std::string> get_tx_gain_names(const size_t chan) const = 0;
@@ -768,6 +829,48 @@ public:
      */
     virtual uint32_t get_gpio_attr(const std::string& bank, const std::string& attr) = 0;
 
+    //! One write of a GPIO sequence, see set_gpio_sequence()
+    struct gpio_sequence_entry_t
+    {
+        //! When the bits change. time_spec_t::ASAP writes them right away.
+        uhd::time_spec_t time;
+        //! The name of the GPIO bank (e.g., FP0)
+        std::string bank;
+        //! The bits to change
+        uint32_t mask;
+        //! The new value of the bits in \p mask
+        uint32_t value;
+        //! The attribute to write: OUT, or one of the ATR registers
+        std::string attr = "OUT";
+    };
+
+    /*!
+     * Write a sequence of timed GPIO changes
+     *
+     * This is more efficient than a call to set_gpio_attr() for every change.
+     * The entries are sorted by time (entries with the same time keep their
+     * order). All entries with the same time are merged into a single write
+     * per bank and attribute, and the writes of one time are sent as a batch.
+     *
+     * The writes are timed commands, which wait in the command queue of the
+     * radio until their time. For sequences that exceed its capacity, set
+     * the max_held_cmds policy of the register interface (see
+     * register_iface::set_policy()), so the host holds back the writes and
+     * sends them as room frees up.
+     *
+     * Patterns that follow the TX/RX state of the radio don't need timed
+     * writes at all: entries for the ATR registers (ATR_0X, ATR_RX, ATR_TX,
+     * ATR_XX) preload them, and the ATR engine switches the pins.
+     *
+     * The command time of the radio is restored when this returns.
+     *
+     * \param sequence the writes
+     * \throws uhd::not_implemented_error if the radio doesn't support GPIO
+     * \throws uhd::key_error if an entry names an invalid attribute
+     */
+    virtual void set_gpio_sequence(
+        const std::vector<gpio_sequence_entry_t>& sequence) = 0;
+
     /**************************************************************************
      * Sensor API
      *************************************************************************/
@@ -810,6 +913,69 @@ public:
     virtual void issue_stream_cmd(
         const uhd::stream_cmd_t& stream_cmd, const size_t port) = 0;
 
+    /*! Issue a stream command without waiting for the radio to receive it
+     *
+     * This writes the same registers as issue_stream_cmd(), but does not wait
+     * for the transactions to complete. The stream commands of many channels
+     * can thus be in flight at the same time, which shortens the lead time a
+     * timed start of all channels requires. Unlike issue_stream_cmd(), the
+     * command goes straight to the radio, so the number of samples of a
+     * finite burst is counted at the sample rate of the radio.
+     *
+     * \param stream_cmd The actual stream command to execute
+     * \param port The port for which the stream command is meant
+     * \return A future that is ready once the radio has received the command.
+     *         Its get() method throws if the command could not be delivered.
+     */
+    virtual std::future<void> issue_stream_cmd_async(
+        const uhd::stream_cmd_t& stream_cmd, const size_t port) = 0;
+
+    //! The hop_index of a scan entry that doesn't retune
+    static constexpr size_t NO_HOP = size_t(~0);
+
+    //! One burst of a scan, see issue_rx_scan()
+    struct rx_scan_entry_t
+    {
+        //! The time of the first sample of the burst
+        uhd::time_spec_t time;
+        //! The number of samples of the burst, at the sample rate of the radio
+        size_t num_samps;
+        //! The entry of the RX hop table to tune to before the burst, or NO_HOP
+        size_t hop_index = NO_HOP;
+    };
+
+    /*! Issue a schedule of timed bursts, with a retune before each of them
+     *
+     * This replaces a loop of stream commands for a finite burst, each
+     * followed by a retune, with a single call. All bursts and retunes are
+     * sent as timed commands, which wait in the command queue of the radio:
+     * settling_time before each burst, the radio hops to the RX hop table
+     * entry of the burst (see set_rx_hop_table()), and receives its stream
+     * command. The host thus doesn't need a round trip between bursts.
+     *
+     * recv() returns each burst with an end-of-burst flag, and
+     * rx_metadata_t::burst_index tells which burst the samples belong to.
+     *
+     * Each burst must be over settling_time before the next one starts. Like
+     * issue_stream_cmd_async(), the command goes straight to the radio, so the
+     * number of samples is counted at the sample rate of the radio. Schedules
+     * that exceed the command queue rely on the max_held_cmds policy of the
+     * register interface (see register_iface::set_policy()), so the host holds
+     * back the commands and sends them as room frees up.
+     *
+     * The command time of the channel is restored when this returns.
+     *
+     * \param schedule The bursts, in order of time
+     * \param settling_time How long before a burst the radio hops
+     * \param chan The channel
+     * \throws uhd::value_error if the times don't increase, or an entry has no
+     *         samples
+     * \throws uhd::index_error if an entry names a hop that's not in the table
+     */
+    virtual void issue_rx_scan(const std::vector<rx_scan_entry_t>& schedule,
+        const uhd::time_spec_t& settling_time,
+        const size_t chan) = 0;
+
     /*! Enable or disable the setting of timestamps on Rx.
      */
     virtual void enable_rx_timestamps(const bool enable, const size_t chan) = 0;
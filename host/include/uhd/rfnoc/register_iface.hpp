@@ -9,7 +9,9 @@
 #include <uhd/types/device_addr.hpp>
 #include <uhd/types/time_spec.hpp>
 #include <cstdint>
+#include <exception>
 #include <functional>
+#include <future>
 #include <memory>
 #include <vector>
 
@@ -203,6 +205,100 @@ public:
         size_t length,
         time_spec_t time = uhd::time_spec_t::ASAP) = 0;
 
+    /*! Read multiple 32-bit registers implemented in the NoC block.
+     *
+     * This method should be called when multiple reads need to happen that
+     * are at non-consecutive addresses. For consecutive reads, cf.
+     * block_peek32(). Implementations may keep several reads in flight at
+     * the same time, so this takes far fewer round trips than calling peek32()
+     * for every register.
+     *
+     * The default implementation calls peek32() for every register.
+     *
+     * \param addrs The byte addresses of the registers to read from
+     *              (each truncated to 20 bits).
+     * \param time The time at which the first transaction should be executed.
+     * \return The values of the registers, in the order of \p addrs
+     *
+     * \throws op_failed if a transaction fails
+     * \throws op_timeout if no response is received
+     * \throws op_seqerr if a sequence error occurs
+     */
+    virtual std::vector<uint32_t> multi_peek32(
+        const std::vector<uint32_t>& addrs, time_spec_t time = uhd::time_spec_t::ASAP)
+    {
+        std::vector<uint32_t> values;
+        values.reserve(addrs.size());
+        for (size_t i = 0; i < addrs.size(); i++) {
+            values.push_back(peek32(addrs[i], (i == 0) ? time : uhd::time_spec_t::ASAP));
+        }
+        return values;
+    }
+
+    /*! Write a 32-bit register without waiting for the transaction to complete.
+     *
+     * Unlike poke32(), this always tracks the ACK for the transaction, and
+     * returns a future that becomes ready once it has been received. Many
+     * transactions can be in flight at the same time this way, which hides the
+     * round trip time to the device. The call itself only blocks if the
+     * command buffer of the device is full.
+     *
+     * Implementations may only notice that a transaction timed out when they
+     * issue the next one, so use wait_for() on the future to bound the time
+     * spent waiting for it.
+     *
+     * The default implementation calls poke32() and returns a future that is
+     * already ready.
+     *
+     * \param addr The byte address of the register to write to (truncated to 20 bits).
+     * \param data New value of this register.
+     * \param time The time at which the transaction should be executed.
+     * \return A future that is ready when the transaction has completed. Its
+     *         get() method throws the same exceptions as poke32() with an ACK.
+     */
+    virtual std::future<void> poke32_async(
+        uint32_t addr, uint32_t data, time_spec_t time = uhd::time_spec_t::ASAP)
+    {
+        std::promise<void> result;
+        try {
+            poke32(addr, data, time, true);
+            result.set_value();
+        } catch (...) {
+            result.set_exception(std::current_exception());
+        }
+        return result.get_future();
+    }
+
+    /*! Read a 32-bit register without waiting for the transaction to complete.
+     *
+     * This returns a future that becomes ready once the response has been
+     * received. Many transactions can be in flight at the same time this way,
+     * which hides the round trip time to the device. The call itself only
+     * blocks if the command buffer of the device is full.
+     *
+     * Like for poke32_async(), use wait_for() on the future to bound the time
+     * spent waiting for it.
+     *
+     * The default implementation calls peek32() and returns a future that is
+     * already ready.
+     *
+     * \param addr The byte address of the register to read from (truncated to 20 bits).
+     * \param time The time at which the transaction should be executed.
+     * \return A future for the value of the register. Its get() method throws
+     *         the same exceptions as peek32().
+     */
+    virtual std::future<uint32_t> peek32_async(
+        uint32_t addr, time_spec_t time = uhd::time_spec_t::ASAP)
+    {
+        std::promise<uint32_t> result;
+        try {
+            result.set_value(peek32(addr, time));
+        } catch (...) {
+            result.set_exception(std::current_exception());
+        }
+        return result.get_future();
+    }
+
     /*! Poll a 32-bit register until its value for all bits in mask match data&mask
      *
      * This will insert a command into the command queue to wait until a
@@ -260,6 +356,30 @@ public:
      */
     virtual void sleep(time_spec_t duration, bool ack = false) = 0;
 
+    /*! Start batching register writes.
+     *
+     * Until the matching call to end_batch(), poke32() calls that don't
+     * request an ACK are held back instead of being sent right away. Any other
+     * transaction first sends the writes held back so far, so the order of
+     * all transactions is preserved. Calls may be nested, writes are sent when
+     * the outermost batch ends.
+     *
+     * Holding back writes allows the implementation to coalesce them, e.g.,
+     * by sending writes to consecutive addresses as a single block write.
+     *
+     * The default implementation does not batch, writes are sent right away.
+     * See also noc_block_base::batch_scope.
+     */
+    virtual void begin_batch() {}
+
+    /*! Stop batching register writes, see begin_batch().
+     *
+     * At the end of the outermost batch, all writes held back are sent.
+     *
+     * \throws uhd::runtime_error if there is no batch to end
+     */
+    virtual void end_batch() {}
+
     /*! Register a callback function to validate a received async message
      *
      * The purpose of this callback is to provide a method to the framework to
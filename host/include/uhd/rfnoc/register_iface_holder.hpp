@@ -6,16 +6,27 @@
 
 #pragma once
 
+#include <uhd/config.hpp>
 #include <uhd/rfnoc/register_iface.hpp>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace uhd { namespace rfnoc {
 
+class shadow_register_iface;
+
 /*! Register interface holder class
  *
  * Classes derived from this class have access to a uhd::rfnoc::register_iface
  * object.
+ *
+ * Optionally, the holder can keep a write-through shadow copy of the registers
+ * (see enable_shadow_regs()). Reading back a register that was previously
+ * written then doesn't require a round trip to the device.
  */
-class register_iface_holder
+class UHD_API register_iface_holder
 {
 public:
     register_iface_holder(register_iface::sptr reg) : _reg(reg){};
@@ -30,11 +41,58 @@ public:
         return *(_reg.get());
     };
 
+    /*! Enable the shadow register cache
+     *
+     * From now on, regs() stores the values of all written registers. Reads of
+     * registers that were written before are served from this copy, without
+     * accessing the device, unless they are timed or the register has been
+     * marked as volatile. Reads of registers that were never written always go
+     * to the device, and their values are not stored.
+     *
+     * Only use this when the values of the written registers can't change
+     * otherwise, or mark the registers that can as volatile. Note that the
+     * shadow copy holds the value of a timed write as soon as it is issued.
+     *
+     * \param volatile_addrs The byte addresses of the registers that must
+     *                       always be read from the device
+     */
+    void enable_shadow_regs(const std::vector<uint32_t>& volatile_addrs = {});
+
+    /*! Mark a register as volatile, i.e., always read it from the device
+     *
+     * This has no effect if the shadow register cache is not enabled.
+     *
+     * \param addr The byte address of the register
+     */
+    void set_volatile_reg(const uint32_t addr);
+
+    /*! Forget all values in the shadow register cache
+     *
+     * Call this when the registers of the device have changed without being
+     * written through regs(), e.g., after a reset.
+     */
+    void invalidate_shadow_regs();
+
 protected:
     void update_reg_iface(register_iface::sptr new_iface = nullptr);
 
+    /*! Record the register writes that a function makes through regs()
+     *
+     * The writes are still executed. Only writes that go through regs() while
+     * \p fn is running are recorded, so no other thread must access the
+     * registers at the same time.
+     *
+     * \param fn The function to run
+     * \return The (address, value) pairs of all writes, in the order they were
+     *         made. Their timestamps are not recorded.
+     */
+    std::vector<std::pair<uint32_t, uint32_t>> record_reg_writes(
+        const std::function<void()>& fn);
+
 private:
     register_iface::sptr _reg;
+    //! The shadow register cache, if enabled. This is the same object as _reg.
+    std::shared_ptr<shadow_register_iface> _shadow;
 };
 
 }} /* namespace uhd::rfnoc */
@@ -24,6 +24,22 @@ namespace uhd { namespace rfnoc {
 
 enum class siggen_waveform { CONSTANT, SINE_WAVE, NOISE };
 
+/*! Settings of a function generator port
+ *
+ * See siggen_block_control::set_config(), which applies all of them at once.
+ */
+struct siggen_config_t
+{
+    //! Function generator waveform type, see set_waveform()
+    siggen_waveform waveform = siggen_waveform::CONSTANT;
+    //! Amplitude of noise and sine wave data, see set_amplitude()
+    double amplitude = 1.0;
+    //! Value to generate in constant mode, see set_constant()
+    std::complex<double> constant = {1.0, 1.0};
+    //! Phase increment in sine wave mode, see set_sine_phase_increment()
+    double phase_inc = 1.0;
+};
+
 class UHD_API siggen_block_control : public noc_block_base
 {
 public:
@@ -178,6 +194,36 @@ public:
      */
     virtual size_t get_samples_per_packet(const size_t port) const = 0;
 
+    /*! Set the waveform type and all waveform parameters at once
+     *
+     * Changes the waveform type, amplitude, constant value and phase
+     * increment of the given port on the block together. All values are
+     * range checked before anything changes, with the same limits as the
+     * individual setters.
+     *
+     * Calling the individual setters writes the registers of the function
+     * generator one by one, and sends a control packet per write. This
+     * writes all of them in a single block write instead, so the new
+     * waveform starts within a few clock cycles, without generating data
+     * from a mix of the old and the new settings in between. The control
+     * packet is sent as soon as possible; the function generator does not
+     * support timed commands.
+     *
+     * \param config The new settings. In constant mode, the amplitude is
+     *               ignored and reads back as 1.0.
+     * \param port The port on the block whose settings to change
+     * \throws uhd::value_error if any of the settings is out of range
+     */
+    virtual void set_config(const siggen_config_t& config, const size_t port) = 0;
+
+    /*! Get the waveform type and all waveform parameters
+     *
+     * \param port The port on the block whose settings to return
+     * \returns The current settings, as set by set_config() or by the
+     *          individual setters
+     */
+    virtual siggen_config_t get_config(const size_t port) const = 0;
+
     /*! Configure the sinusoidal waveform generator given frequency and rate
      *
      * Convenience function to configure the current phase increment between
@@ -8,6 +8,7 @@
 
 #include <uhd/config.hpp>
 #include <uhd/rfnoc/noc_block_base.hpp>
+#include <map>
 
 namespace uhd { namespace rfnoc {
 
@@ -22,6 +23,16 @@ namespace uhd { namespace rfnoc {
  *
  * NOTE: This block is not intended to switch during the transmission of packets.
  *       Data on disconnected inputs will stall.
+ *
+ * \section swboard_routes Switching Between Routes
+ *
+ * connect() goes through property resolution, like any other setting of a
+ * block. To switch between a few known paths on a running system (e.g., between
+ * two antenna paths or processing chains), the routes can be added ahead of
+ * time with add_route(), which validates them. select_route() then only writes
+ * the select registers that change, as a single batch of register writes, and
+ * takes no longer than those writes. No streams need to be stopped, and the
+ * graph is not committed again.
  */
 class UHD_API switchboard_block_control : public noc_block_base
 {
@@ -43,6 +54,46 @@ public:
      * \param output Index of the output port.
      */
     virtual void connect(const size_t input, const size_t output) = 0;
+
+    //! A route through the switchboard: Maps input ports to their output ports
+    using route_t = std::map<size_t, size_t>;
+
+    /*! Adds a route that can be switched to with select_route()
+     *
+     * A route needs to list only the connections it changes. Any existing
+     * connection on the inputs or outputs of the route is dropped when it is
+     * selected, like with connect().
+     *
+     * \param route The connections of the route
+     * \returns The index of the route, to pass to select_route()
+     * \throws uhd::value_error if a port does not exist, or if the route
+     *         connects two inputs to the same output
+     */
+    virtual size_t add_route(const route_t& route) = 0;
+
+    /*! Switches the block to a route that was added with add_route()
+     *
+     * Unlike connect(), this does not run a property resolution. Properties
+     * are not propagated between the ports that the route connects, so the
+     * blocks on either side must already agree on them (e.g., on the sample
+     * rate). The forwarding of actions such as stream commands follows the
+     * new route. The input_select and output_select properties keep the values
+     * of the last connect().
+     *
+     * The switchboard block executes register writes as they arrive, so the
+     * switch cannot be timed.
+     *
+     * \param route The index of the route
+     * \throws uhd::value_error if the route does not exist
+     */
+    virtual void select_route(const size_t route) = 0;
+
+    /*! Returns the current connections of the block
+     *
+     * \returns The connected inputs and the outputs they are connected to. This
+     *          includes the connections made with connect().
+     */
+    virtual route_t get_route() const = 0;
 };
 
 }} // namespace uhd::rfnoc
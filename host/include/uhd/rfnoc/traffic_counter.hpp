@@ -7,12 +7,14 @@
 
 #pragma once
 
+#include <uhd/exception.hpp>
 #include <uhd/property_tree.hpp>
 #include <uhdlib/utils/narrow.hpp>
 #include <stdint.h>
 #include <type_traits>
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace uhd { namespace rfnoc {
 
@@ -22,22 +24,51 @@ public:
     typedef std::shared_ptr<traffic_counter> sptr;
     typedef std::function<void(const uint32_t addr, const uint32_t data)> write_reg_fn_t;
     typedef std::function<uint64_t(const uint32_t addr)> read_reg_fn_t;
+    //! Reads \p num_regs consecutive counters, starting at \p first_addr
+    typedef std::function<std::vector<uint64_t>(
+        const uint32_t first_addr, const size_t num_regs)>
+        block_read_reg_fn_t;
 
+    //! The values of all counters, read in one pass
+    struct values_t
+    {
+        uint64_t bus_clock_ticks          = 0;
+        uint64_t xbar_to_shell_xfer_count = 0;
+        uint64_t xbar_to_shell_pkt_count  = 0;
+        uint64_t shell_to_xbar_xfer_count = 0;
+        uint64_t shell_to_xbar_pkt_count  = 0;
+        uint64_t shell_to_ce_xfer_count   = 0;
+        uint64_t shell_to_ce_pkt_count    = 0;
+        uint64_t ce_to_shell_xfer_count   = 0;
+        uint64_t ce_to_shell_pkt_count    = 0;
+    };
+
+    /*!
+     * \param tree The property tree to add the counters to
+     * \param root_path The path the counters are added below
+     * \param write_reg_fn Writes a register of the traffic counter
+     * \param read_reg_fn Reads a single counter
+     * \param block_read_reg_fn Reads several counters in one pass, for
+     *        get_values(). If empty, get_values() reads one counter at a time.
+     */
     traffic_counter(uhd::property_tree::sptr tree,
         uhd::fs_path root_path,
         write_reg_fn_t write_reg_fn,
-        read_reg_fn_t read_reg_fn)
-        : _write_reg_fn(write_reg_fn), _read_reg_fn(read_reg_fn)
+        read_reg_fn_t read_reg_fn,
+        block_read_reg_fn_t block_read_reg_fn = block_read_reg_fn_t())
+        : _write_reg_fn(write_reg_fn)
+        , _read_reg_fn(read_reg_fn)
+        , _block_read_reg_fn(block_read_reg_fn)
     {
-        const uint32_t id_reg_offset        = 0;
-        const uint32_t first_counter_offset = 1;
-        const uint64_t traffic_counter_id   = 0x712AFF1C00000000ULL;
+        const uint32_t id_reg_offset      = 0;
+        const uint64_t traffic_counter_id = 0x712AFF1C00000000ULL;
 
         // Check traffic counter id to determine if it's present
         const uint64_t id = _read_reg_fn(id_reg_offset);
+        _present          = (id == traffic_counter_id);
 
         // If present, add properties
-        if (id == traffic_counter_id) {
+        if (_present) {
             tree->create<bool>(root_path / "traffic_counter/enable")
                 .add_coerced_subscriber([this](const bool enable) {
                     uint32_t val = enable ? 1 : 0;
@@ -54,20 +85,72 @@ public:
                 "shell_to_ce_pkt_count",
                 "ce_to_shell_xfer_count",
                 "ce_to_shell_pkt_count"};
+            static_assert(std::extent<decltype(counters)>::value == NUM_COUNTERS,
+                "Counter names don't match the number of counters");
 
-            for (size_t i = 0; i < std::extent<decltype(counters)>::value; i++) {
+            for (size_t i = 0; i < NUM_COUNTERS; i++) {
                 tree->create<uint64_t>(root_path / "traffic_counter" / counters[i])
-                    .set_publisher([this, i, first_counter_offset]() {
+                    .set_publisher([this, i]() {
                         return _read_reg_fn(
-                            uhd::narrow_cast<uint32_t>(i) + first_counter_offset);
+                            uhd::narrow_cast<uint32_t>(i) + FIRST_COUNTER_OFFSET);
                     });
             }
         }
     }
 
+    //! Returns true if the device has this traffic counter
+    bool is_present() const
+    {
+        return _present;
+    }
+
+    /*! Read all counters at once
+     *
+     * Reading the counters one property at a time takes a transaction per
+     * counter, and the counters move on in between. This reads them in one
+     * pass instead, so the values are close to consistent with each other
+     * (e.g., to compute throughputs relative to bus_clock_ticks).
+     *
+     * \throws uhd::not_implemented_error if the device has no traffic counter
+     */
+    values_t get_values() const
+    {
+        if (!_present) {
+            throw uhd::not_implemented_error("Device has no traffic counter");
+        }
+        std::vector<uint64_t> regs;
+        if (_block_read_reg_fn) {
+            regs = _block_read_reg_fn(FIRST_COUNTER_OFFSET, NUM_COUNTERS);
+        } else {
+            for (size_t i = 0; i < NUM_COUNTERS; i++) {
+                regs.push_back(
+                    _read_reg_fn(uhd::narrow_cast<uint32_t>(i) + FIRST_COUNTER_OFFSET));
+            }
+        }
+        if (regs.size() != NUM_COUNTERS) {
+            throw uhd::runtime_error("Failed to read traffic counters");
+        }
+        values_t values;
+        values.bus_clock_ticks          = regs[0];
+        values.xbar_to_shell_xfer_count = regs[1];
+        values.xbar_to_shell_pkt_count  = regs[2];
+        values.shell_to_xbar_xfer_count = regs[3];
+        values.shell_to_xbar_pkt_count  = regs[4];
+        values.shell_to_ce_xfer_count   = regs[5];
+        values.shell_to_ce_pkt_count    = regs[6];
+        values.ce_to_shell_xfer_count   = regs[7];
+        values.ce_to_shell_pkt_count    = regs[8];
+        return values;
+    }
+
 private:
+    static constexpr uint32_t FIRST_COUNTER_OFFSET = 1;
+    static constexpr size_t NUM_COUNTERS           = 9;
+
     write_reg_fn_t _write_reg_fn;
     read_reg_fn_t _read_reg_fn;
+    block_read_reg_fn_t _block_read_reg_fn;
+    bool _present = false;
 };
 
 }} /* namespace uhd::rfnoc */
@@ -8,7 +8,9 @@
 
 #include <uhd/config.hpp>
 #include <uhd/rfnoc/block_id.hpp>
+#include <uhd/rfnoc/block_status.hpp>
 #include <uhd/rfnoc/graph_edge.hpp>
+#include <uhd/rfnoc/graph_snapshot.hpp>
 #include <uhd/rfnoc/noc_block_base.hpp>
 #include <uhd/stream.hpp>
 #include <uhd/transport/adapter_id.hpp>
@@ -311,6 +313,41 @@ public:
      */
     virtual void release() = 0;
 
+    /*! Take a snapshot of the connections between blocks, and of the user
+     * properties of the connected blocks
+     *
+     * A service that sets up the same graph every time it starts can store
+     * the snapshot, e.g. with uhd::rfnoc::graph_snapshot_t::to_string(), and
+     * apply it with import_snapshot() rather than setting up the graph one
+     * connection and one property at a time. Connections to streamers are not
+     * part of the snapshot. Only properties of type bool, int, double, and
+     * std::string are.
+     *
+     * \return A snapshot of the current graph configuration
+     */
+    virtual graph_snapshot_t export_snapshot() = 0;
+
+    /*! Apply a snapshot that was taken with export_snapshot()
+     *
+     * All connections and properties of the snapshot are validated before
+     * anything is changed. Then, the graph is released, all connections are
+     * made and all properties are set at once, and the graph is committed
+     * again. That way, the graph is only checked and its properties are only
+     * propagated once, instead of for every connection.
+     *
+     * A snapshot can only be applied to the same kind of devices, with the
+     * same FPGA images, that it was taken from. The connections it holds are
+     * made in addition to the existing ones.
+     *
+     * \param snapshot The snapshot to apply
+     * \throws uhd::lookup_error if a block or property of the snapshot does
+     *         not exist in this graph
+     * \throws uhd::routing_error if a connection of the snapshot can't be
+     *         routed the way it was when the snapshot was taken
+     * \throws uhd::resolve_error if the properties fail to resolve
+     */
+    virtual void import_snapshot(const graph_snapshot_t& snapshot) = 0;
+
     /******************************************
      * Streaming
      ******************************************/
@@ -374,6 +411,19 @@ public:
     virtual bool synchronize_devices(
         const uhd::time_spec_t& time_spec, const bool quiet) = 0;
 
+    /*! Read the backend status of all blocks of a motherboard
+     *
+     * All status registers are read in one pipelined pass, so this is cheap
+     * enough to poll periodically (e.g., for a dashboard), and only takes a
+     * short time away from other control transactions.
+     *
+     * \param mb_index The index of the motherboard
+     * \return The status of every block on the motherboard, in the order of
+     *         the block ports
+     * \throws uhd::index_error if there's no motherboard \p mb_index
+     */
+    virtual std::vector<block_status_t> get_block_status(const size_t mb_index = 0) = 0;
+
     //! Return a reference to the property tree
     virtual uhd::property_tree::sptr get_tree(void) const = 0;
 }; // class rfnoc_graph
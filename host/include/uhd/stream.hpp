@@ -14,6 +14,9 @@
 #include <uhd/types/stream_cmd.hpp>
 #include <uhd/utils/noncopyable.hpp>
 #include <boost/utility.hpp>
+#include <complex>
+#include <functional>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -88,6 +91,7 @@ struct UHD_API stream_args_t
      *  - sc16 - Q16 I16
      *  - sc8 - Q8_1 I8_1 Q8_0 I8_0
      *  - sc12 (Only some devices)
+     *  - sc4 - I4_0 Q4_0 I4_1 Q4_1 I4_2 Q4_2 I4_3 Q4_3 (Only some devices)
      *
      * The following are not implemented, but are listed to demonstrate naming convention:
      *  - s16 - R16_1 R16_0
@@ -128,6 +132,90 @@ struct UHD_API stream_args_t
      * Users should specify this option to request smaller than default
      * packets, probably with the intention of reducing packet latency.
      *
+     * - interleave: (RX only) when set to 1, recv() takes a single buffer
+     * which receives the samples of all channels, interleaved by channel
+     * (ch0, ch1, ..., ch0, ch1, ...). The buffer must hold nsamps_per_buff
+     * samples for every channel. All channels use the same scale factor. Only
+     * some combinations of CPU and OTW format support this.
+     *
+     * - host_rate, host_freq_shift: resample the samples on the host, and
+     * shift them by host_freq_shift Hz, for rates that the device cannot
+     * provide. host_rate is the rate of the samples passed to recv() or
+     * send(). On RX, a positive shift moves a signal at -host_freq_shift Hz
+     * to 0 Hz, and on TX, it moves 0 Hz to +host_freq_shift Hz. The low-pass
+     * filter of the resampler delays the signal by about 8 samples per unit of
+     * decimation, at the higher of the two rates. Timestamps and RX fragment
+     * offsets count the samples at the device rate, and TX bursts end with
+     * the response of the filter. Only supported for the sc16 OTW format and
+     * the fc32 CPU format, and not with interleave.
+     *
+     * - convert_threads: (RX only) the number of threads that convert the
+     * samples of each packet, including the thread that calls recv(). For
+     * single channels at rates that one core cannot convert. The other
+     * threads spin for a while after each packet, so they take up most of a
+     * core each while streaming. convert_cpus pins them to CPUs, in the
+     * format of the Linux kernel (e.g., "4-7"). Not supported with interleave
+     * or host DSP.
+     *
+     * - enable_stats: when set to 1, the streamer starts out collecting the
+     * statistics returned by get_stats(). See also set_stats_enabled().
+     *
+     * - enable_latency_probe: when set to 1, the streamer starts out measuring
+     * the latency of the stages of the streaming path, see
+     * streamer_stats_t::latency and set_latency_probe_enabled().
+     *
+     * - signal_stats: when set to 1, the streamer starts out collecting the
+     * power, peak, clipping and DC offset of the samples of each channel while
+     * converting them, see get_signal_stats() and set_signal_stats_enabled().
+     *
+     * - adaptive_fc: (RFNoC devices only, RX only) when set to 1, the host
+     * adapts how often it sends flow control responses to the stream: more
+     * often when the device runs low on credit or packets get lost, less
+     * often while the device has plenty of credit. The frequencies chosen
+     * are logged at debug level.
+     *
+     * - fast_overrun_recovery: (RFNoC devices only, RX only) when set to 1, an
+     * overrun while streaming continuously restarts the radios right away,
+     * instead of after recv() has returned the data buffered prior to the
+     * overrun. recv() returns that data, followed by ERROR_CODE_OVERFLOW with
+     * the time of the first lost sample and the number of lost samples
+     * (rx_metadata_t::num_lost_samps), found from the timestamps of the
+     * packets. It then continues with the samples received after the restart.
+     *
+     * - reuse_xport: (RFNoC devices only, RX only) when set to 1, the
+     * transports of the streamer are kept when it is destroyed, and are
+     * reused by the next streamer with the same args that connects to the
+     * same stream endpoint. This skips setting up the endpoint, its route and
+     * flow control, which saves time for applications that create streamers
+     * over and over, e.g. for repeated captures on different channels. The
+     * transports stay allocated until the graph is destroyed.
+     *
+     * - late_drop_margin: (RFNoC devices only, TX only) when set, bursts that
+     * start more than this many seconds in the past are dropped on the host,
+     * instead of being sent to the device, which would reject them. The
+     * device time is estimated from a correlation with the host clock that is
+     * refreshed in the background, so no time is read per burst. Every
+     * dropped burst posts an EVENT_CODE_TIME_ERROR message on each channel
+     * and counts in streamer_stats_t::late_bursts. A negative margin also
+     * drops bursts that are not late yet, but would be by the time they
+     * reach the device. Not supported with host DSP or the zero-copy API.
+     *
+     * - samp_rate: (RFNoC devices only) the sample rate of the streamer, in
+     * samples per second. On devices with more than one link, e.g. an N320
+     * with two 10GbE links, the graph puts each new streamer on the link that
+     * has the most bandwidth left, unless an adapter is given explicitly.
+     * multi_usrp sets this from the rate of the channels. The allocation is
+     * logged at debug level. Without it, streamers are spread by their number.
+     *
+     * - latency_mode: (RFNoC devices only) when set to "ultra", configures the
+     * whole streaming path for the shortest turnaround, at the expense of
+     * throughput and CPU time: small packets (spp=64), short link queues,
+     * shallow flow control windows with an ack for every packet, inline I/O
+     * that polls before it blocks, and a real-time streamer thread pinned to
+     * its CPU (or to streamer_thread_cpu). Args that are set explicitly take
+     * precedence, and the resolved configuration is logged. This can also be
+     * a device arg, which then applies to all streamers.
+     *
      * - noclear: Used by tx_dsp_core_200 and rx_dsp_core_200
      *
      * The following are not implemented, but are listed for conceptual purposes:
@@ -161,6 +249,160 @@ struct UHD_API stream_args_t
     std::vector<size_t> channels;
 };
 
+/*!
+ * Statistics about the work done by a streamer, see rx_streamer::get_stats()
+ * and tx_streamer::get_stats().
+ *
+ * All counters start at zero when the streamer is created and only count
+ * while statistics are enabled.
+ */
+struct UHD_API streamer_stats_t
+{
+    //! Number of buckets in wait_time_hist
+    static constexpr size_t NUM_WAIT_TIME_BUCKETS = 16;
+
+    //! Counters for a single channel of the streamer
+    struct chan_stats_t
+    {
+        //! Number of packets received or sent
+        uint64_t packets = 0;
+        //! Number of payload bytes received or sent
+        uint64_t bytes = 0;
+        /*!
+         * Number of packets for which the arrival skew was measured (RX only).
+         * The arrival skew of a channel is the time from the link receiving
+         * the earliest packet of a set of aligned packets until it received
+         * the packet of this channel. It is only measured by streamers with
+         * more than one channel while the latency probe is enabled, and only
+         * for links that timestamp packets. When channels come from different
+         * devices, this shows which device delivers its packets late.
+         */
+        uint64_t skew_count = 0;
+        //! Sum of the arrival skews, in nanoseconds
+        uint64_t skew_total_ns = 0;
+        //! Largest arrival skew, in nanoseconds
+        uint64_t skew_max_ns = 0;
+        /*!
+         * Largest number of packets that were queued for the streamer at once
+         * (RX only). This is only measured when an offload thread receives the
+         * packets (recv_offload=1), and is 0 otherwise. A value close to the
+         * number of receive frames means the streamer was about to fall
+         * behind, see the recv_buff_ms transport argument.
+         */
+        uint64_t recv_queue_hwm = 0;
+    };
+
+    //! Latency measurements of one stage of the streaming path
+    struct latency_stats_t
+    {
+        //! Number of packets measured
+        uint64_t count = 0;
+        //! Sum of the latencies of all packets, in nanoseconds
+        uint64_t total_ns = 0;
+        //! Largest latency, in nanoseconds
+        uint64_t max_ns = 0;
+        //! Histogram of the latencies, with the buckets of wait_time_hist
+        std::vector<uint64_t> hist;
+    };
+
+    //! Whether the streamer is currently collecting statistics
+    bool enabled = false;
+
+    //! Counters for each channel
+    std::vector<chan_stats_t> chans;
+
+    //! Number of sequence errors detected (RX only)
+    uint64_t seq_errors = 0;
+
+    /*!
+     * Number of times the streamer had to wait for frame buffers, because
+     * none were available right away. For TX, this usually means the device
+     * did not have flow control credit for another packet.
+     */
+    uint64_t stalls = 0;
+
+    //! Total time in nanoseconds spent waiting for frame buffers
+    uint64_t wait_time_ns = 0;
+
+    /*!
+     * Histogram of the time spent waiting in each stall. Bucket 0 counts the
+     * waits that took less than 1 us, bucket i counts the waits that took
+     * from 2^(i-1) us to just under 2^i us. The last bucket also counts all
+     * waits that took longer.
+     */
+    std::vector<uint64_t> wait_time_hist;
+
+    //! Total time in nanoseconds spent converting samples
+    uint64_t convert_time_ns = 0;
+
+    /*!
+     * Number of bursts the streamer dropped without sending them, because
+     * they were already late (TX only, see the late_drop_margin stream arg)
+     */
+    uint64_t late_bursts = 0;
+
+    /*!
+     * Latencies measured by the latency probe, by stage (see
+     * rx_streamer::set_latency_probe_enabled()). Packets are timestamped with
+     * the host's steady clock. RX streamers measure these stages:
+     * - link_to_streamer: From the link receiving a packet until the streamer
+     *   picks it up. This is mostly time spent queued in the I/O service.
+     * - link_to_recv_return: From the link receiving the first packet used by
+     *   a call to recv() until that call returns.
+     *
+     * TX streamers measure these stages, for every packet:
+     * - send_to_release: From entering send() until the streamer hands the
+     *   packet to the transport. This includes waiting for flow control
+     *   credit and converting samples.
+     * - send_to_link: From entering send() until the link transmits the
+     *   packet.
+     *
+     * Stages that were not measured (yet) are left out. Not all links
+     * timestamp packets, so link_to_* and send_to_link may be missing.
+     */
+    std::map<std::string, latency_stats_t> latency;
+};
+
+/*!
+ * Statistics of the samples of a streamer channel, see
+ * rx_streamer::get_signal_stats() and tx_streamer::get_signal_stats().
+ *
+ * The values are in the units of the fc32 samples, i.e., with full scale at
+ * 1.0 by default.
+ */
+struct UHD_API signal_stats_t
+{
+    //! The number of samples
+    uint64_t num_samps = 0;
+
+    //! The sum of the powers I^2 + Q^2 of the samples
+    double sum_power = 0.0;
+
+    //! The largest power I^2 + Q^2 of a sample
+    double peak_power = 0.0;
+
+    //! The sum of the samples
+    std::complex<double> sum{0.0, 0.0};
+
+    /*!
+     * RX: The number of I and Q values at the limits of the wire format,
+     * i.e., that the ADC or the DSP of the device clipped.
+     *
+     * TX: The number of I and Q values that exceeded the wire format, which
+     * the conversion saturated.
+     */
+    uint64_t num_clipped = 0;
+
+    //! Returns the mean power of the samples, or 0 without samples
+    double get_mean_power() const;
+
+    //! Returns the mean of the samples, an estimate of the DC offset
+    std::complex<double> get_dc_offset() const;
+
+    //! Adds the statistics of other samples
+    signal_stats_t& operator+=(const signal_stats_t& other);
+};
+
 /*!
  * The RX streamer is the host interface to receiving samples.
  * It represents the layer between the samples on the host
@@ -237,6 +479,186 @@ public:
      * \param stream_cmd the stream command to issue
      */
     virtual void issue_stream_cmd(const stream_cmd_t& stream_cmd) = 0;
+
+    /*!
+     * Get statistics about the work done by this streamer.
+     *
+     * The counters are cheap to read and may be polled from another thread
+     * while the streamer is in use.
+     *
+     * \return the current value of the counters
+     * \throws uhd::not_implemented_error if the streamer has no statistics
+     */
+    virtual streamer_stats_t get_stats(void) const;
+
+    /*!
+     * Enable or disable collecting statistics. This may be called from
+     * another thread while the streamer is in use.
+     *
+     * \param enable true to start collecting statistics, false to stop
+     * \throws uhd::not_implemented_error if the streamer has no statistics
+     */
+    virtual void set_stats_enabled(const bool enable);
+
+    /*!
+     * Enable or disable the latency probe, which measures the latency of the
+     * stages of the streaming path (see streamer_stats_t::latency). This is
+     * independent of set_stats_enabled(). While any streamer has the probe
+     * enabled, links take a timestamp of every packet they receive, which
+     * costs a clock read per packet. This may be called from another thread
+     * while the streamer is in use.
+     *
+     * \param enable true to start measuring, false to stop
+     * \throws uhd::not_implemented_error if the streamer has no statistics
+     */
+    virtual void set_latency_probe_enabled(const bool enable);
+
+    /*!
+     * Enable or disable the signal statistics of the channels.
+     *
+     * The statistics (see signal_stats_t) are accumulated by the converters
+     * while they convert the samples, which saves a pass over the samples
+     * after recv() returns. This swaps the converters of all channels, so it
+     * must not be called while another thread is in recv().
+     *
+     * \param enable true to start collecting the statistics, false to stop
+     * \throws uhd::not_implemented_error if the streamer can't collect them
+     *         for its formats (only sc16 over the wire and fc32 on the host
+     *         are supported), or for its configuration
+     */
+    virtual void set_signal_stats_enabled(const bool enable);
+
+    /*!
+     * Get the signal statistics of a channel.
+     *
+     * \param chan the channel of the streamer
+     * \param reset true to start over with the next samples, e.g., to get the
+     *        statistics of each block of samples
+     * \return the statistics of the samples since the last reset
+     * \throws uhd::not_implemented_error if the streamer has no signal
+     *         statistics
+     */
+    virtual signal_stats_t get_signal_stats(const size_t chan, const bool reset = true);
+
+    /*!
+     * Activate or deactivate a channel of a running streamer.
+     *
+     * The channel stays connected, so this doesn't tear down or rebuild any
+     * transport. recv() returns zeros for an inactive channel, and the
+     * streamer drops the packets it receives for it. The metadata comes from
+     * the first active channel. Starting and stopping the stream of the
+     * channel's radio is left to the application, with issue_stream_cmd() or
+     * with the stream commands of the device.
+     *
+     * This may be called from any thread, also while another thread is in
+     * recv(). The change takes effect with the next call to recv(). A change
+     * replaces the changes of the channel that haven't taken effect yet.
+     *
+     * \param chan the channel of the streamer
+     * \param active true to return the samples of the channel
+     * \throws uhd::runtime_error if this would deactivate all channels
+     * \throws uhd::not_implemented_error if the streamer can't switch channels
+     */
+    virtual void set_channel_active(const size_t chan, const bool active);
+
+    /*!
+     * Activate or deactivate a channel of a running streamer at a given time.
+     *
+     * The change applies from the sample at \p time_spec on: recv() stops
+     * before that sample, so the change takes effect at the start of a call
+     * to recv(). A channel that becomes active is aligned with the others
+     * from that sample on. This needs timestamps in the packets. Otherwise,
+     * the change takes effect right away.
+     *
+     * \param chan the channel of the streamer
+     * \param active true to return the samples of the channel
+     * \param time_spec the time of the first sample the change applies to
+     * \throws uhd::runtime_error if this would deactivate all channels
+     * \throws uhd::not_implemented_error if the streamer can't switch channels
+     */
+    virtual void set_channel_active(
+        const size_t chan, const bool active, const time_spec_t& time_spec);
+
+    /*!
+     * Check whether a channel is active, or is going to be once the changes
+     * requested with set_channel_active() took effect.
+     *
+     * \param chan the channel of the streamer
+     * \return false if the channel is, or is going to be, inactive
+     */
+    virtual bool is_channel_active(const size_t chan) const;
+
+    //! Callback for received packets, see set_recv_ready_callback()
+    using recv_ready_callback_t = std::function<void()>;
+
+    /*!
+     * Call a function whenever a packet is queued for this streamer.
+     *
+     * This tells an application that recv() has data to return, without a
+     * thread blocking in recv(). The callback runs in the I/O thread that
+     * received the packet, so it must not block, and must not call recv().
+     * See uhd::rx_streamer_poller for a way to service many streamers with
+     * a few threads.
+     *
+     * This only works if the packets are received by an I/O thread, i.e.,
+     * with the recv_offload stream arg, or with DPDK. For streamers with
+     * more than one channel, the callback runs for the packets of every
+     * channel.
+     * This replaces a callback set with set_recv_packet_callback().
+     *
+     * \param callback the callback, or an empty function to stop the
+     *        notifications. Once this returns, the previous callback does not
+     *        run any more.
+     * \throws uhd::not_implemented_error if the streamer can't notify
+     */
+    virtual void set_recv_ready_callback(recv_ready_callback_t callback);
+
+    //! Callback that receives packets, see set_recv_packet_callback()
+    using recv_packet_callback_t = std::function<void(
+        const std::vector<const void*>& buffs, size_t nsamps, const rx_metadata_t& md)>;
+
+    /*!
+     * Hand every received packet to a function instead of returning it from
+     * recv().
+     *
+     * The callback runs in the I/O thread that received the packet, right
+     * after it was received. This saves waking up a thread that waits in
+     * recv(), which takes a context switch per packet. It gets the same
+     * samples and metadata that recv() with the one_packet option would
+     * return. The contract for the callback is:
+     * - It must return quickly, and must not block, sleep, or call into the
+     *   device (e.g., to issue stream commands). While it runs, the I/O thread
+     *   does not receive, which causes overruns, possibly also for other
+     *   streamers that share the I/O thread.
+     * - The buffers are only valid until it returns.
+     * - Errors are passed with nsamps set to 0, and an error code in the
+     *   metadata. A stream that pauses is not an error, so the callback never
+     *   sees ERROR_CODE_TIMEOUT. Errors that are not caused by a packet (e.g.,
+     *   overruns) may be passed from another UHD thread, but never while the
+     *   callback runs for a packet.
+     * - Exceptions it throws are logged and dropped.
+     *
+     * While a callback is set, the application must not call recv(). This
+     * replaces a callback set with set_recv_ready_callback(), and vice versa.
+     * Packets that were received before the callback was set are passed
+     * along with the next packet.
+     *
+     * This only works if the packets are received by an I/O thread, i.e.,
+     * with the recv_offload stream arg, or with DPDK.
+     *
+     * \param callback the callback, or an empty function to go back to
+     *        recv(). Once this returns, the previous callback does not run any
+     *        more.
+     * \param raw if false, the samples are converted to the cpu_format into
+     *        buffers that belong to the streamer, one per channel (or a single
+     *        one if the channels are interleaved). If true, the buffers point
+     *        into the packets, and hold the samples in the over-the-wire
+     *        format, without any copy.
+     * \throws uhd::not_implemented_error if the streamer can't run callbacks
+     *         on the I/O thread
+     */
+    virtual void set_recv_packet_callback(
+        recv_packet_callback_t callback, const bool raw = false);
 };
 
 /*!
@@ -301,6 +723,244 @@ public:
      */
     virtual bool recv_async_msg(
         async_metadata_t& async_metadata, double timeout = 0.1) = 0;
+
+    /*!
+     * Receive up to \p max_num_msgs asynchronous messages from this TX stream.
+     *
+     * This waits for the first message with \p timeout, and then returns the
+     * messages that are already queued without waiting any longer. It is
+     * meant for collecting the burst ACKs and late indications after a call
+     * to send_bursts().
+     *
+     * \param msgs the vector to which to append the messages
+     * \param max_num_msgs the most messages to receive
+     * \param timeout the timeout in seconds to wait for the first message
+     * \return the number of messages appended to \p msgs
+     */
+    virtual size_t recv_async_msgs(std::vector<async_metadata_t>& msgs,
+        const size_t max_num_msgs,
+        const double timeout = 0.1);
+
+    //! A timed burst, see send_bursts()
+    struct burst_t
+    {
+        //! One buffer per channel, holding the samples of the burst
+        std::vector<const void*> buffs;
+
+        //! The number of samples in each buffer
+        size_t nsamps = 0;
+
+        //! When to send the first sample
+        time_spec_t time_spec;
+    };
+
+    /*!
+     * Send a list of timed bursts.
+     *
+     * This is the same as calling send() for each burst with start_of_burst,
+     * end_of_burst and has_time_spec set, but the bursts are sent in a single
+     * pass, so a whole TDMA frame can be scheduled with one call. Streamers
+     * that support it skip the per-call handling of send() and compute the
+     * timestamps of all packets from the ones of the bursts in ticks.
+     *
+     * The device reports a burst ACK per channel for each burst, and a time
+     * error for each burst that arrives late. Use recv_async_msgs() to
+     * collect them.
+     *
+     * All bursts are validated before any of them is sent. If a timeout
+     * occurs, the burst that was being sent is not terminated, and the caller
+     * should end it with a call to send() with end_of_burst set.
+     *
+     * \param bursts the bursts to send, in the order of their time specs
+     * \param timeout the timeout in seconds to wait on a packet
+     * \return the number of bursts sent completely
+     * \throws uhd::value_error if a burst has no samples, or does not have
+     *         one buffer per channel
+     */
+    virtual size_t send_bursts(
+        const std::vector<burst_t>& bursts, const double timeout = 0.1);
+
+    //! A contiguous block of samples, see send_segments()
+    struct segment_t
+    {
+        //! The samples
+        const void* buff = nullptr;
+
+        //! The number of samples in the block
+        size_t nsamps = 0;
+    };
+
+    //! The blocks that make up the samples of one channel, in order
+    using segments_type = std::vector<segment_t>;
+
+    /*!
+     * Send samples that are split up into several buffers per channel.
+     *
+     * This is the same as calling send() with each channel's segments
+     * concatenated into one buffer, but the samples are converted straight
+     * from the segments into the packets, which saves the copy. For example,
+     * a frame made of a header block and payload blocks can be sent as is.
+     *
+     * The segments of the channels may have different lengths, but each
+     * channel must have the same total number of samples. Streamers that can't
+     * convert across segment boundaries send one segment at a time, which
+     * requires the segments of all channels to have the same lengths.
+     *
+     * \param segments one list of segments per channel
+     * \param metadata data describing the samples, as for send()
+     * \param timeout the timeout in seconds to wait on a packet
+     * \return the number of samples sent, per channel
+     * \throws uhd::value_error if there is not one list of segments per
+     *         channel, or the channels have different numbers of samples
+     * \throws uhd::not_implemented_error if the streamer can only send whole
+     *         segments, and the segments of the channels don't line up
+     */
+    virtual size_t send_segments(const std::vector<segments_type>& segments,
+        const tx_metadata_t& metadata,
+        const double timeout = 0.1);
+
+    /*!
+     * Transmit a waveform over and over, until stop_cyclic() is called.
+     *
+     * The samples are converted to the over-the-wire format once, and a
+     * thread of the streamer sends them in a continuous burst, so looping a
+     * test signal or a beacon costs no conversions, and the application
+     * doesn't have to keep calling send(). The packets of the burst have
+     * consecutive timestamps, and the waveform starts over right after its
+     * last sample, so its length should be a whole number of periods.
+     *
+     * The scale factor in effect when this is called applies to the whole
+     * transmission. send() and its variants can't be called until the
+     * transmission is stopped. Use recv_async_msg() to check for underflows.
+     *
+     * \param buffs one buffer per channel, holding the waveform
+     * \param nsamps_per_buff the number of samples of the waveform
+     * \param metadata the time spec, if any, is the time of the first sample.
+     *        The burst flags are ignored.
+     * \throws uhd::value_error if the waveform is empty
+     * \throws uhd::runtime_error if a cyclic transmission is already running
+     * \throws uhd::not_implemented_error if the streamer has no cyclic mode
+     */
+    virtual void start_cyclic(const buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        const tx_metadata_t& metadata);
+
+    /*!
+     * Stop a transmission started by start_cyclic().
+     *
+     * This ends the burst after the packet that is being sent, so the
+     * waveform does not necessarily end on its last sample. It does nothing if
+     * there is no cyclic transmission.
+     *
+     * \param timeout the timeout in seconds to wait on the end-of-burst packet
+     */
+    virtual void stop_cyclic(const double timeout = 0.1);
+
+    //! Callback for asynchronous messages, see set_async_msg_callback()
+    using async_msg_callback_t = std::function<void(const async_metadata_t&)>;
+
+    /*!
+     * Deliver the asynchronous messages of this TX stream to a callback.
+     *
+     * Instead of queueing messages for recv_async_msg(), the streamer calls
+     * the callback as soon as it gets a message (a burst ACK, an underflow,
+     * etc.). The callback runs in the thread that handles the message, which
+     * is usually the I/O thread of the transport, so it must not block. This
+     * lets an application react to an underflow without the latency of
+     * waiting in recv_async_msg().
+     *
+     * This may be called while the streamer is in use. Messages that are
+     * already queued can still be read with recv_async_msg().
+     *
+     * \param callback the callback, or an empty function to queue messages
+     *        for recv_async_msg() again
+     * \throws uhd::not_implemented_error if the streamer has no callback
+     *         delivery
+     */
+    virtual void set_async_msg_callback(async_msg_callback_t callback);
+
+    //! Callback for free send buffers, see set_send_ready_callback()
+    using send_ready_callback_t = std::function<void()>;
+
+    /*!
+     * Call a function whenever the streamer gets a buffer to send a packet.
+     *
+     * This tells an application that send() can make progress (because flow
+     * control credit came back), without a thread blocking in send(). The
+     * callback runs in the I/O thread that freed the buffer, so it must not
+     * block, and must not call send(). See uhd::async_tx_streamer for a way
+     * to send on many streamers from a few threads.
+     *
+     * This only works if the packets are sent by an I/O thread, i.e., with the
+     * send_offload stream arg. For streamers with more than one channel, the
+     * callback runs for the buffers of every channel.
+     *
+     * \param callback the callback, or an empty function to stop the
+     *        notifications. Once this returns, the previous callback does not
+     *        run any more.
+     * \throws uhd::not_implemented_error if the streamer can't notify
+     */
+    virtual void set_send_ready_callback(send_ready_callback_t callback);
+
+    /*!
+     * Get statistics about the work done by this streamer.
+     *
+     * The counters are cheap to read and may be polled from another thread
+     * while the streamer is in use.
+     *
+     * \return the current value of the counters
+     * \throws uhd::not_implemented_error if the streamer has no statistics
+     */
+    virtual streamer_stats_t get_stats(void) const;
+
+    /*!
+     * Enable or disable collecting statistics. This may be called from
+     * another thread while the streamer is in use.
+     *
+     * \param enable true to start collecting statistics, false to stop
+     * \throws uhd::not_implemented_error if the streamer has no statistics
+     */
+    virtual void set_stats_enabled(const bool enable);
+
+    /*!
+     * Enable or disable the latency probe, which measures the latency of the
+     * stages of the streaming path (see streamer_stats_t::latency). This is
+     * independent of set_stats_enabled(). While any streamer has the probe
+     * enabled, links take a timestamp of every packet they receive, which
+     * costs a clock read per packet. This may be called from another thread
+     * while the streamer is in use.
+     *
+     * \param enable true to start measuring, false to stop
+     * \throws uhd::not_implemented_error if the streamer has no statistics
+     */
+    virtual void set_latency_probe_enabled(const bool enable);
+
+    /*!
+     * Enable or disable the signal statistics of the channels.
+     *
+     * The statistics (see signal_stats_t) are accumulated by the converters
+     * while they convert the samples, which saves a pass over the samples
+     * before send() is called. This swaps the converters of all channels, so
+     * it must not be called while another thread is in send().
+     *
+     * \param enable true to start collecting the statistics, false to stop
+     * \throws uhd::not_implemented_error if the streamer can't collect them
+     *         for its formats (only sc16 over the wire and fc32 on the host
+     *         are supported), or for its configuration
+     */
+    virtual void set_signal_stats_enabled(const bool enable);
+
+    /*!
+     * Get the signal statistics of a channel.
+     *
+     * \param chan the channel of the streamer
+     * \param reset true to start over with the next samples, e.g., to get the
+     *        statistics of each block of samples
+     * \return the statistics of the samples since the last reset
+     * \throws uhd::not_implemented_error if the streamer has no signal
+     *         statistics
+     */
+    virtual signal_stats_t get_signal_stats(const size_t chan, const bool reset = true);
 };
 
 } // namespace uhd
@@ -6,10 +6,13 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 namespace uhd { namespace transport {
 
+class latency_hist;
+
 /*!
  * Contains a reference to a frame buffer managed by a link.
  */
@@ -55,12 +58,57 @@ public:
         _packet_size = size;
     }
 
+    /*!
+     * Returns the latency probe timestamp of the frame: when the link
+     * received it, or when the samples of a packet to send entered send().
+     * \return the time in nanoseconds of std::chrono::steady_clock, or 0 if
+     *         the frame was not timestamped
+     */
+    uint64_t get_timestamp() const
+    {
+        return _timestamp;
+    }
+
+    /*!
+     * Sets the latency probe timestamp of the frame
+     * \param timestamp the time in nanoseconds of std::chrono::steady_clock,
+     *        or 0 to clear it
+     */
+    void set_timestamp(const uint64_t timestamp)
+    {
+        _timestamp = timestamp;
+    }
+
+    /*!
+     * Returns the histogram into which the link records the time from the
+     * timestamp until it transmits the frame, or nullptr
+     */
+    latency_hist* get_latency_hist() const
+    {
+        return _latency_hist;
+    }
+
+    /*!
+     * Sets the histogram into which the link records the time from the
+     * timestamp until it transmits the frame
+     */
+    void set_latency_hist(latency_hist* hist)
+    {
+        _latency_hist = hist;
+    }
+
 protected:
     /*! Pointer to data of current frame */
     void* _data = nullptr;
 
     /*! Size of packet in current frame */
     size_t _packet_size = 0;
+
+    /*! Latency probe timestamp of current frame */
+    uint64_t _timestamp = 0;
+
+    /*! Latency histogram for the transmit time of current frame */
+    latency_hist* _latency_hist = nullptr;
 };
 
 }} // namespace uhd::transport
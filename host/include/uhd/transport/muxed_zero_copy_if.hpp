@@ -23,6 +23,11 @@ namespace uhd { namespace transport {
  * This class handles demuxing receive streams into the
  * appropriate virtual streams with the given classifier
  * function. A worker therad is spawned to handle the demuxing.
+ *
+ * The virtual streams hand out the frames of the base transport without
+ * copying them. A frame goes back to the base transport when the consumer of
+ * the virtual stream releases it, so frames that are held on to by a consumer
+ * are not available to the other streams.
  */
 class muxed_zero_copy_if : private uhd::noncopyable
 {
@@ -98,6 +98,12 @@ public:
     */
     inline nirio_scalar_type_t get_scalar_type() const { return _datatype_info.scalar_type; }
 
+    /*!
+    * Claimed elements accessor
+    * \return Number of elements that acquire() can hand out without a call into the driver
+    */
+    inline size_t get_num_claimed_elements() const { return _remaining_in_claimed_block; }
+
     /*!
     * Starts the DMA transfer between host and device, pre-acquires any available blocks
     * \return status
@@ -10,6 +10,7 @@
 #include <uhd/transport/usb_device_handle.hpp>
 #include <uhd/transport/zero_copy.hpp>
 #include <uhd/types/device_addr.hpp>
+#include <vector>
 
 namespace uhd { namespace transport {
 
@@ -28,8 +29,54 @@ class UHD_API usb_zero_copy : public virtual zero_copy_if
 public:
     typedef std::shared_ptr<usb_zero_copy> sptr;
 
+    /*!
+     * Statistics about the transfers on one endpoint of the transport, see
+     * get_recv_xfer_stats() and get_send_xfer_stats().
+     */
+    struct xfer_stats_t
+    {
+        //! Number of buckets in latency_hist
+        static constexpr size_t NUM_LATENCY_BUCKETS = 16;
+
+        //! Number of transfers currently allocated
+        size_t num_frames = 0;
+
+        //! Number of transfers that completed successfully
+        uint64_t xfers = 0;
+
+        //! Total time in nanoseconds from submitting to completing the transfers
+        uint64_t latency_ns = 0;
+
+        /*!
+         * Histogram of the time from submitting to completing each transfer.
+         * Bucket 0 counts the transfers that took less than 1 us, bucket i
+         * counts the transfers that took from 2^(i-1) us to just under 2^i us.
+         * The last bucket also counts all transfers that took longer.
+         */
+        std::vector<uint64_t> latency_hist;
+
+        /*!
+         * Number of times all receive transfers had completed by the time one
+         * was handed out, so none were left for the device to fill. The
+         * device may overflow when this happens.
+         */
+        uint64_t starved = 0;
+    };
+
     virtual ~usb_zero_copy(void);
 
+    //! Get the statistics of the receive transfers
+    virtual xfer_stats_t get_recv_xfer_stats(void) const
+    {
+        return xfer_stats_t();
+    }
+
+    //! Get the statistics of the send transfers
+    virtual xfer_stats_t get_send_xfer_stats(void) const
+    {
+        return xfer_stats_t();
+    }
+
     /*!
      * Make a new zero copy USB transport:
      * This transport is for sending and receiving between the host
@@ -8,14 +8,151 @@
 #pragma once
 
 #include <uhd/config.hpp>
+#include <functional>
 #include <list>
 #include <map>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 namespace uhd {
 
+namespace dict_detail {
+
+//! Whether dict looks up keys of this type through a hash index
+template <typename Key, typename Enable = void>
+struct dict_key_is_hashable : std::false_type
+{
+};
+
+template <typename Key>
+struct dict_key_is_hashable<Key,
+    typename std::enable_if<std::is_arithmetic<Key>::value || std::is_enum<Key>::value
+                            || std::is_pointer<Key>::value>::type> : std::true_type
+{
+};
+
+template <>
+struct dict_key_is_hashable<std::string> : std::true_type
+{
+};
+
+//! Hash function for dict keys
+template <typename Key, typename Enable = void>
+struct dict_key_hash
+{
+    std::size_t operator()(const Key& key) const
+    {
+        return std::hash<Key>()(key);
+    }
+};
+
+template <typename Key>
+struct dict_key_hash<Key, typename std::enable_if<std::is_enum<Key>::value>::type>
+{
+    std::size_t operator()(const Key& key) const
+    {
+        using underlying_t = typename std::underlying_type<Key>::type;
+        return std::hash<underlying_t>()(static_cast<underlying_t>(key));
+    }
+};
+
+/*! Key index of a dict
+ *
+ * Maps the keys to the list elements that hold them. The index refers to the
+ * keys stored in the list elements rather than keeping copies of them, so it
+ * has to be updated before an element is removed from the list.
+ */
+template <typename Key, typename Iterator, bool = dict_key_is_hashable<Key>::value>
+class dict_index
+{
+public:
+    //! Return the element with key \p key, or \p end if there is none
+    template <typename It>
+    It find(const Key& key, It /*begin*/, It end) const
+    {
+        const auto entry = _index.find(std::cref(key));
+        return entry == _index.end() ? end : It(entry->second);
+    }
+
+    //! Add an element. If its key is already indexed, the old element wins.
+    void insert(Iterator it)
+    {
+        _index.emplace(std::cref(it->first), it);
+    }
+
+    void erase(const Key& key)
+    {
+        _index.erase(std::cref(key));
+    }
+
+    void clear()
+    {
+        _index.clear();
+    }
+
+    void swap(dict_index& other)
+    {
+        _index.swap(other._index);
+    }
+
+private:
+    using key_ref_t = std::reference_wrapper<const Key>;
+
+    struct key_ref_hash
+    {
+        std::size_t operator()(const key_ref_t& key) const
+        {
+            return dict_key_hash<Key>()(key.get());
+        }
+    };
+
+    struct key_ref_equal
+    {
+        bool operator()(const key_ref_t& lhs, const key_ref_t& rhs) const
+        {
+            return lhs.get() == rhs.get();
+        }
+    };
+
+    std::unordered_map<key_ref_t, Iterator, key_ref_hash, key_ref_equal> _index;
+};
+
+//! Keys that can't be hashed are looked up by scanning the list
+template <typename Key, typename Iterator>
+class dict_index<Key, Iterator, false>
+{
+public:
+    template <typename It>
+    It find(const Key& key, It begin, It end) const
+    {
+        for (; begin != end; ++begin) {
+            if (begin->first == key) {
+                return begin;
+            }
+        }
+        return end;
+    }
+
+    void insert(Iterator) {}
+
+    void erase(const Key&) {}
+
+    void clear() {}
+
+    void swap(dict_index&) {}
+};
+
+} // namespace dict_detail
+
 /*!
  * A templated dictionary class with a python-like interface.
+ *
+ * Elements are kept in insertion order. Keys that are strings, numbers,
+ * enums, or pointers are also hash-indexed, so looking them up takes
+ * constant time; other keys are looked up by a linear scan, so they only
+ * need an equality operator.
  */
 template <typename Key, typename Val>
 class dict
@@ -35,6 +172,11 @@ public:
     template <typename InputIterator>
     dict(InputIterator first, InputIterator last);
 
+    dict(const dict<Key, Val>& other);
+    dict(dict<Key, Val>&& other);
+    dict<Key, Val>& operator=(const dict<Key, Val>& other);
+    dict<Key, Val>& operator=(dict<Key, Val>&& other);
+
     /*!
      * Get the number of elements in this dict.
      * \return the number of elements
@@ -146,7 +288,12 @@ public:
 
 private:
     typedef std::pair<Key, Val> pair_t;
+    typedef std::list<pair_t> list_t;
     std::list<pair_t> _map; // private container
+    dict_detail::dict_index<Key, typename list_t::iterator> _index;
+
+    //! Re-create the index after the list was replaced
+    void _rebuild_index(void);
 };
 
 } // namespace uhd
@@ -11,6 +11,8 @@
 #include <uhd/exception.hpp>
 #include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <iterator>
 #include <typeinfo>
 
 namespace uhd{
@@ -39,7 +41,49 @@ namespace uhd{
     dict<Key, Val>::dict(InputIterator first, InputIterator last):
         _map(first, last)
     {
-        /* NOP */
+        _rebuild_index();
+    }
+
+    template <typename Key, typename Val>
+    dict<Key, Val>::dict(const dict<Key, Val> &other):
+        _map(other._map)
+    {
+        _rebuild_index();
+    }
+
+    template <typename Key, typename Val>
+    dict<Key, Val>::dict(dict<Key, Val> &&other){
+        // Swapping lists keeps the iterators valid, so the index can move along
+        _map.swap(other._map);
+        _index.swap(other._index);
+    }
+
+    template <typename Key, typename Val>
+    dict<Key, Val> &dict<Key, Val>::operator=(const dict<Key, Val> &other){
+        if (this != &other){
+            _map = other._map;
+            _rebuild_index();
+        }
+        return *this;
+    }
+
+    template <typename Key, typename Val>
+    dict<Key, Val> &dict<Key, Val>::operator=(dict<Key, Val> &&other){
+        if (this != &other){
+            _map.swap(other._map);
+            _index.swap(other._index);
+            other._index.clear();
+            other._map.clear();
+        }
+        return *this;
+    }
+
+    template <typename Key, typename Val>
+    void dict<Key, Val>::_rebuild_index(void){
+        _index.clear();
+        for (auto it = _map.begin(); it != _map.end(); ++it){
+            _index.insert(it);
+        }
     }
 
     template <typename Key, typename Val>
@@ -67,26 +111,18 @@ namespace uhd{
 
     template <typename Key, typename Val>
     bool dict<Key, Val>::has_key(const Key &key) const{
-        for(const pair_t &p : _map){
-            if (p.first == key) return true;
-        }
-        return false;
+        return _index.find(key, _map.cbegin(), _map.cend()) != _map.cend();
     }
 
     template <typename Key, typename Val>
     const Val &dict<Key, Val>::get(const Key &key, const Val &other) const{
-        for(const pair_t &p : _map){
-            if (p.first == key) return p.second;
-        }
-        return other;
+        const auto it = _index.find(key, _map.cbegin(), _map.cend());
+        return it == _map.cend() ? other : it->second;
     }
 
     template <typename Key, typename Val>
     const Val &dict<Key, Val>::get(const Key &key) const{
-        for(const pair_t &p : _map){
-            if (p.first == key) return p.second;
-        }
-        throw key_not_found<Key, Val>(key);
+        return (*this)[key];
     }
 
     template <typename Key, typename Val>
@@ -96,18 +132,17 @@ namespace uhd{
 
     template <typename Key, typename Val>
     const Val &dict<Key, Val>::operator[](const Key &key) const{
-        for(const pair_t &p : _map){
-            if (p.first == key) return p.second;
-        }
-        throw key_not_found<Key, Val>(key);
+        const auto it = _index.find(key, _map.cbegin(), _map.cend());
+        if (it == _map.cend()) throw key_not_found<Key, Val>(key);
+        return it->second;
     }
 
     template <typename Key, typename Val>
     Val &dict<Key, Val>::operator[](const Key &key){
-        for(pair_t &p : _map){
-            if (p.first == key) return p.second;
-        }
+        const auto it = _index.find(key, _map.begin(), _map.end());
+        if (it != _map.end()) return it->second;
         _map.push_back(std::make_pair(key, Val()));
+        _index.insert(std::prev(_map.end()));
         return _map.back().second;
     }
 
@@ -117,7 +152,9 @@ namespace uhd{
             return false;
         }
         for(const pair_t& p : _map) {
-            if (not (other.has_key(p.first) and other.get(p.first) == p.second)){
+            const auto it =
+                other._index.find(p.first, other._map.cbegin(), other._map.cend());
+            if (it == other._map.cend() or not (it->second == p.second)){
                 return false;
             }
         }
@@ -131,28 +168,37 @@ namespace uhd{
 
     template <typename Key, typename Val>
     Val dict<Key, Val>::pop(const Key &key){
-        typename std::list<pair_t>::iterator it;
-        for (it = _map.begin(); it != _map.end(); it++){
-            if (it->first == key){
-                Val val = it->second;
-                _map.erase(it);
-                return val;
-            }
-        }
-        throw key_not_found<Key, Val>(key);
+        const auto it = _index.find(key, _map.begin(), _map.end());
+        if (it == _map.end()) throw key_not_found<Key, Val>(key);
+        Val val = it->second;
+        // The range constructor keeps duplicate keys, of which only the first
+        // one is indexed, so the next one takes its place
+        const auto dup = std::find_if(std::next(it), _map.end(),
+            [&key](const pair_t &p){ return p.first == key; });
+        // The index refers to the key in the list, so drop it first
+        _index.erase(it->first);
+        _map.erase(it);
+        if (dup != _map.end()) _index.insert(dup);
+        return val;
     }
 
     template <typename Key, typename Val>
     void dict<Key, Val>::update(const dict<Key, Val> &new_dict, bool fail_on_conflict)
     {
-        for(const Key &key : new_dict.keys()) {
-            if (fail_on_conflict and has_key(key) and get(key) != new_dict[key]) {
+        for(const pair_t &p : new_dict._map) {
+            const auto it = _index.find(p.first, _map.begin(), _map.end());
+            if (it == _map.end()) {
+                _map.push_back(p);
+                _index.insert(std::prev(_map.end()));
+                continue;
+            }
+            if (fail_on_conflict and it->second != p.second) {
                 throw uhd::value_error(str(
                     boost::format("Option merge conflict: %s:%s != %s:%s")
-                    % key % get(key) % key % new_dict[key]
+                    % p.first % it->second % p.first % p.second
                 ));
             }
-            set(key, new_dict[key]);
+            it->second = p.second;
         }
     }
 
@@ -14,6 +14,66 @@
 
 namespace uhd {
 
+/*!
+ * A timed command that took effect within the samples of a call to recv(),
+ * see rx_metadata_t::tags.
+ */
+struct UHD_API rx_tag_t
+{
+    //! What the command changed
+    enum tag_type_t {
+        //! The RF frequency, by a tune or a hop
+        TAG_FREQ = 0x1,
+        //! The RX gain
+        TAG_GAIN = 0x2
+    } type;
+
+    //! The channel of the streamer that the command was for
+    size_t channel;
+
+    /*!
+     * The offset of the first sample after the command took effect, relative
+     * to the beginning of the call to recv(). Commands that took effect before
+     * the samples of the call started are reported at offset 0.
+     */
+    size_t offset;
+
+    //! The time at which the command took effect, in ticks
+    uint64_t time_ticks;
+};
+
+/*!
+ * The timing and flags of one packet within the samples of a call to recv(),
+ * see rx_metadata_t::packets.
+ */
+struct UHD_API rx_packet_info_t
+{
+    //! The flags of the packet, ORed together
+    enum flags_t {
+        //! time_ticks is valid
+        HAS_TIME_TICKS = 0x1,
+        //! The packet starts a burst
+        START_OF_BURST = 0x2,
+        //! The packet ends a burst
+        END_OF_BURST = 0x4,
+        //! The rest of the packet is returned by the next call to recv()
+        MORE_FRAGMENTS = 0x8
+    };
+
+    //! The offset of the first sample of the packet, relative to the beginning
+    // of the call to recv()
+    size_t offset;
+
+    //! The number of samples of the packet that this call to recv() returned
+    size_t num_samps;
+
+    //! The time of the first sample, in ticks
+    uint64_t time_ticks;
+
+    //! See flags_t
+    uint32_t flags;
+};
+
 /*!
  * RX metadata structure for describing sent IF data.
  * Includes time specification, fragmentation flags, burst flags, and error codes.
@@ -32,6 +92,8 @@ struct UHD_API rx_metadata_t
     {
         has_time_spec       = false;
         time_spec           = time_spec_t(0.0);
+        has_time_ticks      = false;
+        time_ticks          = 0;
         more_fragments      = false;
         fragment_offset     = 0;
         start_of_burst      = false;
@@ -39,8 +101,16 @@ struct UHD_API rx_metadata_t
         eov_positions       = nullptr;
         eov_positions_size  = 0;
         eov_positions_count = 0;
+        tags                = nullptr;
+        tags_size           = 0;
+        tags_count          = 0;
+        packets             = nullptr;
+        packets_size        = 0;
+        packets_count       = 0;
         error_code          = ERROR_CODE_NONE;
         out_of_sequence     = false;
+        num_lost_samps      = 0;
+        burst_index         = 0;
     }
 
     //! Has time specification?
@@ -49,6 +119,24 @@ struct UHD_API rx_metadata_t
     //! Time of the first sample.
     time_spec_t time_spec;
 
+    /*!
+     * Has the time of the first sample in ticks?
+     *
+     * Streamers that receive integer timestamps from the device (RFNoC
+     * devices) set this along with has_time_spec.
+     */
+    bool has_time_ticks;
+
+    /*!
+     * Time of the first sample, in ticks of the device's tick rate.
+     *
+     * This is the timestamp as the device sent it, and time_spec is converted
+     * from it. Unlike time_spec, it is exact, so sample counts converted to
+     * ticks can be added to it over arbitrarily long captures without
+     * rounding drift.
+     */
+    uint64_t time_ticks;
+
     /*!
      * Fragmentation flag:
      * Similar to IPv4 fragmentation:
@@ -96,6 +184,46 @@ struct UHD_API rx_metadata_t
      */
     size_t eov_positions_count;
 
+    /*!
+     * If this pointer is not null, it specifies the address of an array of
+     * rx_tag_t into which recv() writes the timed commands (tunes and gain
+     * changes with a command time) that took effect within the samples it
+     * returns. This saves computing from the timestamps which samples follow
+     * the change, e.g., to skip the settling samples.
+     *
+     * As for `eov_positions`, the caller allocates the array and sets its
+     * size in `tags_size`. If the array runs out, recv() returns early, and
+     * the next call reports the remaining tags. Only rfnoc streamers
+     * with timestamps report tags.
+     */
+    rx_tag_t* tags;
+    size_t tags_size;
+
+    /*!
+     * Upon return from `recv()`, holds the number of tags in the `tags` array.
+     */
+    size_t tags_count;
+
+    /*!
+     * If this pointer is not null, it specifies the address of an array of
+     * rx_packet_info_t into which recv() writes one record for each packet
+     * (or fragment of a packet) that it returns samples from. The rest of
+     * the metadata describes the first packet only, so this keeps the
+     * timestamps and burst flags of all packets when receiving many packets
+     * per call, instead of calling recv() with one_packet set.
+     *
+     * As for `eov_positions`, the caller allocates the array and sets its
+     * size in `packets_size`. If the array runs out, recv() returns early.
+     */
+    rx_packet_info_t* packets;
+    size_t packets_size;
+
+    /*!
+     * Upon return from `recv()`, holds the number of records in the `packets`
+     * array.
+     */
+    size_t packets_count;
+
     /*!
      * The error condition on a receive call.
      *
@@ -139,6 +267,24 @@ struct UHD_API rx_metadata_t
     //! of order.
     bool out_of_sequence;
 
+    /*!
+     * Number of samples lost in an overflow, per channel. It is only known
+     * when the streamer finds the overflow as a gap in the timestamps of the
+     * packets, which rfnoc streamers do with the stream arg
+     * fast_overrun_recovery=1. Otherwise, this is 0.
+     */
+    uint64_t num_lost_samps;
+
+    /*!
+     * The index of the burst that the samples belong to, i.e., the number of
+     * bursts the streamer received completely before them. It counts from the
+     * creation of the streamer, so for a scan (see
+     * uhd::rfnoc::radio_control::issue_rx_scan()) that starts on a new
+     * streamer, it is the index of the schedule entry. Only rfnoc streamers
+     * set this, it is 0 for other devices.
+     */
+    size_t burst_index;
+
     /*!
      * Convert a rx_metadata_t into a pretty print string.
      *
@@ -171,6 +317,18 @@ struct UHD_API tx_metadata_t
     //! When to send the first sample.
     time_spec_t time_spec;
 
+    /*!
+     * Has the time to send in ticks?
+     * - Set false to have time_spec converted to ticks.
+     * - Set true to use time_ticks instead of time_spec (for streamers that
+     *   send integer timestamps to the device, i.e. RFNoC devices). Only used
+     *   if has_time_spec is true.
+     */
+    bool has_time_ticks;
+
+    //! When to send the first sample, in ticks of the device's tick rate.
+    uint64_t time_ticks;
+
     //! Set start of burst to true for the first packet in the chain.
     bool start_of_burst;
 
@@ -193,6 +193,23 @@ public:
     virtual void write_spi(
         unit_t unit, const spi_config_t& config, uint32_t data, size_t num_bits) = 0;
 
+    /*!
+     * Write a sequence of words to SPI bus peripheral.
+     *
+     * This does the same as calling write_spi() for every word, in order.
+     * Implementations may send the words as a batch, which is faster, e.g.,
+     * for synthesizers that are programmed with many registers at once.
+     *
+     * \param unit which unit, rx or tx
+     * \param config configuration settings
+     * \param data the words to write, each MSB first
+     * \param num_bits the number of bits in every word
+     */
+    virtual void write_spi_batch(unit_t unit,
+        const spi_config_t& config,
+        const std::vector<uint32_t>& data,
+        size_t num_bits);
+
     /*!
      * Read and write data to SPI bus peripheral.
      *
@@ -684,6 +684,27 @@ public:
     virtual tune_result_t set_rx_freq(
         const tune_request_t& tune_request, size_t chan = 0) = 0;
 
+    /*!
+     * Set the RX center frequency of several channels at once.
+     *
+     * All channels get the same tune request. If \p cmd_time is given, the
+     * tunes are timed commands for that device time, so the channels retune
+     * together, even when they are spread across several devices. The
+     * command time is cleared afterwards, as with clear_command_time().
+     *
+     * On RFNoC devices, the channels of different devices are tuned in
+     * parallel, rather than one after the other.
+     *
+     * \param tune_request tune request instructions
+     * \param chans the channel indexes
+     * \param cmd_time the time at which the tunes take effect. Zero means
+     *        the channels are tuned right away.
+     * \return a tune result object per channel, in the order of \p chans
+     */
+    virtual std::vector<tune_result_t> set_rx_freqs(const tune_request_t& tune_request,
+        const std::vector<size_t>& chans,
+        const time_spec_t& cmd_time = time_spec_t(0.0)) = 0;
+
     /*!
      * Get the RX center frequency.
      * \param chan the channel index 0 to N-1
@@ -709,6 +730,30 @@ public:
      */
     virtual freq_range_t get_fe_rx_freq_range(size_t chan = 0) = 0;
 
+    /*!
+     * Prepare a table of RX RF frequencies for fast hopping.
+     * A hop with rx_hop() then retunes the RF frontend without repeating
+     * the tuning calculations. The DSP frequency is not part of a hop. See
+     * uhd::rfnoc::radio_control::set_rx_hop_table() for the details, which
+     * depend on the device. On AD9361-based devices (B2xx, E3xx), the hops go
+     * through a precomputed set of synthesizer settings, and may visit the
+     * entries in any order.
+     * \param freqs the RF frequencies in Hz. An empty list clears the table.
+     * \param chan the channel index 0 to N-1
+     * \return the actual RF frequencies of the table entries
+     * \throws uhd::not_implemented_error if the device can't hop
+     */
+    virtual std::vector<double> set_rx_hop_table(
+        const std::vector<double>& freqs, size_t chan = 0) = 0;
+
+    /*!
+     * Hop to an entry of the RX hop table.
+     * \param index the table entry
+     * \param chan the channel index 0 to N-1
+     * \throws uhd::index_error if the table has no entry \p index
+     */
+    virtual void rx_hop(size_t index, size_t chan = 0) = 0;
+
     /**************************************************************************
      * LO controls
      *************************************************************************/
@@ -1329,6 +1374,27 @@ public:
     virtual tune_result_t set_tx_freq(
         const tune_request_t& tune_request, size_t chan = 0) = 0;
 
+    /*!
+     * Set the TX center frequency of several channels at once.
+     *
+     * All channels get the same tune request. If \p cmd_time is given, the
+     * tunes are timed commands for that device time, so the channels retune
+     * together, even when they are spread across several devices. The
+     * command time is cleared afterwards, as with clear_command_time().
+     *
+     * On RFNoC devices, the channels of different devices are tuned in
+     * parallel, rather than one after the other.
+     *
+     * \param tune_request tune request instructions
+     * \param chans the channel indexes
+     * \param cmd_time the time at which the tunes take effect. Zero means
+     *        the channels are tuned right away.
+     * \return a tune result object per channel, in the order of \p chans
+     */
+    virtual std::vector<tune_result_t> set_tx_freqs(const tune_request_t& tune_request,
+        const std::vector<size_t>& chans,
+        const time_spec_t& cmd_time = time_spec_t(0.0)) = 0;
+
     /*!
      * Get the TX center frequency.
      * \param chan the channel index 0 to N-1
@@ -1354,6 +1420,30 @@ public:
      */
     virtual freq_range_t get_fe_tx_freq_range(size_t chan = 0) = 0;
 
+    /*!
+     * Prepare a table of TX RF frequencies for fast hopping.
+     * A hop with tx_hop() then retunes the RF frontend without repeating
+     * the tuning calculations. The DSP frequency is not part of a hop. See
+     * uhd::rfnoc::radio_control::set_tx_hop_table() for the details, which
+     * depend on the device. On AD9361-based devices (B2xx, E3xx), the hops go
+     * through a precomputed set of synthesizer settings, and may visit the
+     * entries in any order.
+     * \param freqs the RF frequencies in Hz. An empty list clears the table.
+     * \param chan the channel index 0 to N-1
+     * \return the actual RF frequencies of the table entries
+     * \throws uhd::not_implemented_error if the device can't hop
+     */
+    virtual std::vector<double> set_tx_hop_table(
+        const std::vector<double>& freqs, size_t chan = 0) = 0;
+
+    /*!
+     * Hop to an entry of the TX hop table.
+     * \param index the table entry
+     * \param chan the channel index 0 to N-1
+     * \throws uhd::index_error if the table has no entry \p index
+     */
+    virtual void tx_hop(size_t index, size_t chan = 0) = 0;
+
     /*!
      * Set the TX gain value for the specified gain element.
      * For an empty name, distribute across all gain elements.
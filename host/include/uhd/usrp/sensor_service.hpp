@@ -0,0 +1,123 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/types/sensors.hpp>
+#include <uhd/usrp/multi_usrp.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <boost/optional.hpp>
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace uhd { namespace usrp {
+
+/*! Background polling of sensors
+ *
+ * Reading a sensor through multi_usrp blocks the caller until the value has
+ * been read from the device, which can take a network round trip (e.g., an
+ * RPC call on MPM devices). The sensor service reads sensors in a background
+ * thread instead, and hands out the most recent values to any number of
+ * readers without blocking them.
+ *
+ * Applications subscribe to a sensor with the rate at which they need fresh
+ * values. Every sensor is read at the highest rate it was subscribed to, no
+ * matter how many subscriptions or readers there are. All motherboard sensors
+ * of a motherboard that are due are read together, which MPM devices do in a
+ * single RPC call.
+ *
+ * Example:
+ * \code{.cpp}
+ * auto usrp    = uhd::usrp::multi_usrp::make(args);
+ * auto sensors = uhd::usrp::sensor_service::make(usrp);
+ * sensors->subscribe(uhd::usrp::sensor_service::MBOARD, "ref_locked", 1.0);
+ * // ... later, from any thread:
+ * auto reading = sensors->get_reading(uhd::usrp::sensor_service::MBOARD, "ref_locked");
+ * if (reading && reading->value.to_bool()) {
+ *     // ...
+ * }
+ * \endcode
+ */
+class UHD_API sensor_service : uhd::noncopyable
+{
+public:
+    using sptr       = std::shared_ptr<sensor_service>;
+    using clock_type = std::chrono::steady_clock;
+
+    //! Identifies a subscription, see subscribe()
+    using subscription_id_t = size_t;
+
+    //! Where a sensor lives
+    enum sensor_type_t {
+        //! Motherboard sensor, the index is the motherboard index
+        MBOARD,
+        //! RX sensor, the index is the channel
+        RX,
+        //! TX sensor, the index is the channel
+        TX
+    };
+
+    //! A sensor value, and when it was read
+    struct sensor_reading_t
+    {
+        uhd::sensor_value_t value;
+        //! Host time at which the value was read
+        clock_type::time_point timestamp;
+    };
+
+    virtual ~sensor_service(void) = 0;
+
+    /*! Create a sensor service for a device
+     *
+     * The background thread runs until the sensor service is destroyed.
+     *
+     * \param usrp The device whose sensors are polled
+     */
+    static sptr make(multi_usrp::sptr usrp);
+
+    /*! Start polling a sensor
+     *
+     * The first value is read right away. Subscribing to the same sensor more
+     * than once is allowed, it is then read at the highest rate.
+     *
+     * \param type The type of sensor
+     * \param name The name of the sensor, e.g. "lo_locked"
+     * \param rate How often the sensor is read (in Hz)
+     * \param idx The motherboard index or channel, depending on \p type
+     * \return an ID for unsubscribe()
+     * \throws uhd::value_error if \p rate is not positive
+     */
+    virtual subscription_id_t subscribe(const sensor_type_t type,
+        const std::string& name,
+        const double rate,
+        const size_t idx = 0) = 0;
+
+    /*! Cancel a subscription
+     *
+     * A sensor is no longer read once all its subscriptions are cancelled.
+     *
+     * \throws uhd::key_error if \p id is not a current subscription
+     */
+    virtual void unsubscribe(const subscription_id_t id) = 0;
+
+    /*! Return the most recent value of a sensor
+     *
+     * This does not access the device, and is safe to call from any thread,
+     * including streaming threads.
+     *
+     * \param type The type of sensor
+     * \param name The name of the sensor
+     * \param idx The motherboard index or channel, depending on \p type
+     * \return the most recent reading, or boost::none if the sensor is not
+     *         subscribed to or hasn't been read successfully yet
+     */
+    virtual boost::optional<sensor_reading_t> get_reading(
+        const sensor_type_t type, const std::string& name, const size_t idx = 0) = 0;
+};
+
+}} // namespace uhd::usrp
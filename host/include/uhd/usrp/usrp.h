@@ -162,6 +162,52 @@ UHD_API uhd_error uhd_rx_streamer_recv(
     size_t *items_recvd
 );
 
+//! Receive buffers, without error bookkeeping on success
+/*!
+ * This is the same as uhd_rx_streamer_recv(), for streaming threads that call
+ * it at high rates. It does not take any locks or touch the global error
+ * string unless an error occurs, so several threads can stream through the C
+ * API without waiting for each other. Errors are still reported by
+ * uhd_rx_streamer_last_error() and uhd_get_last_error().
+ */
+UHD_API uhd_error uhd_rx_streamer_recv_fast(
+    uhd_rx_streamer_handle h,
+    void** buffs,
+    size_t samps_per_buff,
+    uhd_rx_metadata_handle *md,
+    double timeout,
+    bool one_packet,
+    size_t *items_recvd
+);
+
+//! Receive into several sets of buffers in one call
+/*!
+ * This calls recv() for each set of buffers in turn, with the same
+ * bookkeeping as uhd_rx_streamer_recv_fast(). It stops early when a call
+ * times out or returns an error in its metadata.
+ *
+ * \param h RX streamer handle
+ * \param buffs num_batches sets of buffers, one buffer per channel each
+ * \param num_batches the number of sets of buffers
+ * \param samps_per_buff max number of samples per buffer
+ * \param md num_batches handles to RX metadata, one per set of buffers
+ * \param timeout timeout in seconds to wait for each set of buffers
+ * \param items_recvd num_batches output variables for the number of samples
+ *        received into each set of buffers
+ * \param num_batches_recvd pointer to output variable for the number of sets
+ *        of buffers that were received into
+ */
+UHD_API uhd_error uhd_rx_streamer_recv_batch(
+    uhd_rx_streamer_handle h,
+    void*** buffs,
+    size_t num_batches,
+    size_t samps_per_buff,
+    uhd_rx_metadata_handle *md,
+    double timeout,
+    size_t *items_recvd,
+    size_t *num_batches_recvd
+);
+
 //! Issue the given stream command
 /*!
  * See uhd::rx_streamer::issue_stream_cmd() for more details.
@@ -240,6 +286,48 @@ UHD_API uhd_error uhd_tx_streamer_send(
     size_t *items_sent
 );
 
+//! Send buffers, without error bookkeeping on success
+/*!
+ * This is the same as uhd_tx_streamer_send(), for streaming threads that call
+ * it at high rates. See uhd_rx_streamer_recv_fast().
+ */
+UHD_API uhd_error uhd_tx_streamer_send_fast(
+    uhd_tx_streamer_handle h,
+    const void **buffs,
+    size_t samps_per_buff,
+    uhd_tx_metadata_handle *md,
+    double timeout,
+    size_t *items_sent
+);
+
+//! Send several sets of buffers in one call
+/*!
+ * This calls send() for each set of buffers in turn, with the same
+ * bookkeeping as uhd_tx_streamer_send_fast(). It stops early when a call
+ * doesn't send all samples of its buffers.
+ *
+ * \param h TX streamer handle
+ * \param buffs num_batches sets of buffers, one buffer per channel each
+ * \param num_batches the number of sets of buffers
+ * \param samps_per_buff number of samples per buffer
+ * \param md num_batches handles to TX metadata, one per set of buffers
+ * \param timeout timeout in seconds to wait for each set of buffers
+ * \param items_sent num_batches output variables for the number of samples
+ *        sent from each set of buffers
+ * \param num_batches_sent pointer to output variable for the number of sets
+ *        of buffers that were sent from
+ */
+UHD_API uhd_error uhd_tx_streamer_send_batch(
+    uhd_tx_streamer_handle h,
+    const void ***buffs,
+    size_t num_batches,
+    size_t samps_per_buff,
+    uhd_tx_metadata_handle *md,
+    double timeout,
+    size_t *items_sent,
+    size_t *num_batches_sent
+);
+
 //! Receive an asynchronous message from this streamer
 /*!
  * See uhd::tx_streamer::recv_async_msg() for more details.
@@ -0,0 +1,323 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#ifdef __cpp_impl_coroutine
+#    include <coroutine>
+#endif
+
+namespace uhd {
+
+/*! Runs a function on the executor of the application
+ *
+ * The async streamers use this to run completion handlers where the
+ * application wants them, e.g. on the thread pool of an async runtime,
+ * instead of on the UHD thread that completed the operation.
+ */
+using async_post_fn_t = std::function<void(std::function<void()>)>;
+
+/*! Receive from an RX streamer without blocking a thread
+ *
+ * async_recv() returns right away, and calls a handler once samples were
+ * received. The receive runs on the I/O thread when packets come in, so a few
+ * application threads can serve many streamers. With C++20, uhd::async_recv()
+ * wraps it into an awaitable for coroutines:
+ *
+ * \code{.cpp}
+ * auto async_rx = uhd::async_rx_streamer::make(rx_stream, post_to_executor);
+ * while (true) {
+ *     const size_t num_samps = co_await uhd::async_recv(*async_rx, buffs, n, md);
+ *     // process the samples
+ * }
+ * \endcode
+ *
+ * This relies on rx_streamer::set_recv_ready_callback(), i.e., the packets
+ * need to be received by an I/O thread (the recv_offload stream arg, or
+ * DPDK). The async streamer owns that callback while it exists.
+ */
+class UHD_API async_rx_streamer : uhd::noncopyable
+{
+public:
+    using sptr = std::shared_ptr<async_rx_streamer>;
+    //! Gets the number of samples received per buffer
+    using recv_handler_t = std::function<void(size_t num_samps)>;
+
+    virtual ~async_rx_streamer() = 0;
+
+    //! Return the streamer this receives from
+    virtual rx_streamer::sptr get_rx_stream() const = 0;
+
+    /*! Start receiving
+     *
+     * The receive completes as soon as there are samples, or an error, like
+     * rx_streamer::recv() with a zero timeout that is retried whenever a
+     * packet arrives. The handler then runs with the number of samples, and
+     * the metadata is filled in. A stream that pauses does not complete the
+     * receive, so the metadata never holds ERROR_CODE_TIMEOUT, unless the
+     * receive was cancelled.
+     *
+     * The buffers and the metadata must remain valid until the handler runs.
+     * Only one receive can be pending at a time, and the application must
+     * not call recv() on the streamer in the meantime.
+     *
+     * \param buffs the buffers to receive into, one per channel
+     * \param nsamps_per_buff the size of each buffer in samples
+     * \param metadata returns the metadata of the received samples
+     * \param handler runs once the receive completes
+     * \param one_packet complete with the samples of a single packet
+     * \throws uhd::runtime_error if a receive is already pending
+     */
+    virtual void async_recv(const rx_streamer::buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        rx_metadata_t& metadata,
+        recv_handler_t handler,
+        const bool one_packet = false) = 0;
+
+    /*! Cancel the pending receive
+     *
+     * Its handler runs with 0 samples, and the metadata holds
+     * ERROR_CODE_TIMEOUT.
+     *
+     * \return false if there was no pending receive
+     */
+    virtual bool cancel() = 0;
+
+    /*! Create an async streamer
+     *
+     * A receive that is pending when the async streamer is destroyed never
+     * completes.
+     *
+     * \param rx_stream the streamer to receive from
+     * \param post runs the handlers. Without it, they run on the thread that
+     *        completes the receive, which is usually an I/O thread, so they
+     *        must not block.
+     * \throws uhd::not_implemented_error if the streamer can't notify about
+     *         received packets
+     */
+    static sptr make(rx_streamer::sptr rx_stream, async_post_fn_t post = nullptr);
+};
+
+/*! Send on a TX streamer without blocking a thread
+ *
+ * The counterpart of uhd::async_rx_streamer. async_send() returns right
+ * away, and calls a handler once all samples were sent. Packets are sent
+ * whenever flow control credit frees up a buffer, on the I/O thread. With
+ * C++20, uhd::async_send() wraps it into an awaitable for coroutines.
+ *
+ * This relies on tx_streamer::set_send_ready_callback(), i.e., the packets
+ * need to be sent by an I/O thread (the send_offload stream arg). The async
+ * streamer owns that callback while it exists.
+ */
+class UHD_API async_tx_streamer : uhd::noncopyable
+{
+public:
+    using sptr = std::shared_ptr<async_tx_streamer>;
+    //! Gets the number of samples sent per buffer
+    using send_handler_t = std::function<void(size_t num_samps)>;
+
+    virtual ~async_tx_streamer() = 0;
+
+    //! Return the streamer this sends on
+    virtual tx_streamer::sptr get_tx_stream() const = 0;
+
+    /*! Start sending
+     *
+     * The send completes once all samples were handed to the I/O thread, like
+     * tx_streamer::send() without a timeout. If not all of them can be sent
+     * right away, the rest is sent as a continuation of the burst, i.e.,
+     * without start of burst and time spec.
+     *
+     * The buffers must remain valid until the handler runs. Only one send can
+     * be pending at a time, and the application must not call send() on the
+     * streamer in the meantime.
+     *
+     * \param buffs the buffers to send from, one per channel
+     * \param nsamps_per_buff the number of samples to send from each buffer.
+     *        Must not be 0; to end a burst, set end_of_burst with the last
+     *        samples.
+     * \param metadata the metadata of the samples
+     * \param handler runs once the send completes
+     * \throws uhd::runtime_error if a send is already pending
+     * \throws uhd::value_error if nsamps_per_buff is 0
+     */
+    virtual void async_send(const tx_streamer::buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        const tx_metadata_t& metadata,
+        send_handler_t handler) = 0;
+
+    /*! Cancel the pending send
+     *
+     * Its handler runs with the number of samples that were sent so far.
+     *
+     * \return false if there was no pending send
+     */
+    virtual bool cancel() = 0;
+
+    /*! Create an async streamer
+     *
+     * A send that is pending when the async streamer is destroyed never
+     * completes.
+     *
+     * \param tx_stream the streamer to send on
+     * \param cpu_format the CPU format of the streamer (e.g., "fc32")
+     * \param post runs the handlers. Without it, they run on the thread that
+     *        completes the send, which is usually an I/O thread, so they
+     *        must not block.
+     * \throws uhd::not_implemented_error if the streamer can't notify about
+     *         free send buffers
+     */
+    static sptr make(tx_streamer::sptr tx_stream,
+        const std::string& cpu_format,
+        async_post_fn_t post = nullptr);
+};
+
+#ifdef __cpp_impl_coroutine
+
+/*! Awaitable for async_rx_streamer::async_recv(), see uhd::async_recv()
+ *
+ * The result of co_await is the number of samples received.
+ */
+class recv_awaitable
+{
+public:
+    recv_awaitable(async_rx_streamer& rx,
+        const rx_streamer::buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        rx_metadata_t& metadata,
+        const bool one_packet)
+        : _rx(rx)
+        , _buffs(buffs.size())
+        , _nsamps_per_buff(nsamps_per_buff)
+        , _metadata(metadata)
+        , _one_packet(one_packet)
+    {
+        // A ref_vector may point to itself, so it can't be kept over a suspension
+        for (size_t i = 0; i < buffs.size(); i++) {
+            _buffs[i] = buffs[i];
+        }
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        _rx.async_recv(_buffs,
+            _nsamps_per_buff,
+            _metadata,
+            [this, handle](const size_t num_samps) {
+                _num_samps = num_samps;
+                handle.resume();
+            },
+            _one_packet);
+    }
+
+    size_t await_resume() const noexcept
+    {
+        return _num_samps;
+    }
+
+private:
+    async_rx_streamer& _rx;
+    std::vector<void*> _buffs;
+    const size_t _nsamps_per_buff;
+    rx_metadata_t& _metadata;
+    const bool _one_packet;
+    size_t _num_samps = 0;
+};
+
+/*! Awaitable for async_tx_streamer::async_send(), see uhd::async_send()
+ *
+ * The result of co_await is the number of samples sent.
+ */
+class send_awaitable
+{
+public:
+    send_awaitable(async_tx_streamer& tx,
+        const tx_streamer::buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        const tx_metadata_t& metadata)
+        : _tx(tx)
+        , _buffs(buffs.size())
+        , _nsamps_per_buff(nsamps_per_buff)
+        , _metadata(metadata)
+    {
+        for (size_t i = 0; i < buffs.size(); i++) {
+            _buffs[i] = buffs[i];
+        }
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        _tx.async_send(
+            _buffs, _nsamps_per_buff, _metadata, [this, handle](const size_t num_samps) {
+                _num_samps = num_samps;
+                handle.resume();
+            });
+    }
+
+    size_t await_resume() const noexcept
+    {
+        return _num_samps;
+    }
+
+private:
+    async_tx_streamer& _tx;
+    std::vector<const void*> _buffs;
+    const size_t _nsamps_per_buff;
+    const tx_metadata_t _metadata;
+    size_t _num_samps = 0;
+};
+
+/*! Receive in a coroutine: co_await uhd::async_recv(rx, buffs, nsamps, md)
+ *
+ * The coroutine resumes where the async streamer runs its handlers, see
+ * async_rx_streamer::make(). See async_rx_streamer::async_recv() for the
+ * arguments.
+ */
+inline recv_awaitable async_recv(async_rx_streamer& rx,
+    const rx_streamer::buffs_type& buffs,
+    const size_t nsamps_per_buff,
+    rx_metadata_t& metadata,
+    const bool one_packet = false)
+{
+    return recv_awaitable(rx, buffs, nsamps_per_buff, metadata, one_packet);
+}
+
+/*! Send in a coroutine: co_await uhd::async_send(tx, buffs, nsamps, md)
+ *
+ * The coroutine resumes where the async streamer runs its handlers, see
+ * async_tx_streamer::make(). See async_tx_streamer::async_send() for the
+ * arguments.
+ */
+inline send_awaitable async_send(async_tx_streamer& tx,
+    const tx_streamer::buffs_type& buffs,
+    const size_t nsamps_per_buff,
+    const tx_metadata_t& metadata)
+{
+    return send_awaitable(tx, buffs, nsamps_per_buff, metadata);
+}
+
+#endif // __cpp_impl_coroutine
+
+} // namespace uhd
@@ -172,6 +172,50 @@ private:
     std::vector<uint64_t> _mdata;
 };
 
+/*! The header fields of a packet in a buffer of concatenated packets
+ *
+ * The layout of this struct is fixed, the Python API returns arrays of it as
+ * NumPy structured arrays.
+ */
+struct chdr_packet_info_t
+{
+    //! Offset of the packet in the buffer, in bytes
+    uint64_t offset;
+    //! Offset of the payload in the buffer, in bytes
+    uint64_t payload_offset;
+    //! The timestamp, only valid if has_timestamp is set
+    uint64_t timestamp;
+    //! Size of the payload in bytes
+    uint32_t payload_size;
+    uint16_t length;
+    uint16_t seq_num;
+    uint16_t dst_epid;
+    uint8_t vc;
+    uint8_t pkt_type;
+    uint8_t num_mdata;
+    uint8_t eob;
+    uint8_t eov;
+    uint8_t has_timestamp;
+};
+
+/*! Parses the headers of all packets in a buffer of concatenated packets
+ *
+ * Unlike chdr_packet::deserialize(), this does not copy the payload of the
+ * packets, which makes it fast enough for captures of millions of packets.
+ *
+ * \param chdr_w the CHDR_W of the packets
+ * \param data the start of the buffer
+ * \param size the size of the buffer in bytes
+ * \param endianness the endianness of the buffer (link endianness)
+ * \return the fields of each packet, in the order of the buffer
+ * \throws uhd::value_error if a packet is truncated, or has a length that is
+ *         less than its header
+ */
+UHD_API std::vector<chdr_packet_info_t> parse_packets(uhd::rfnoc::chdr_w_t chdr_w,
+    const void* data,
+    const size_t size,
+    endianness_t endianness = uhd::ENDIANNESS_LITTLE);
+
 }}} // namespace uhd::utils::chdr
 
 #include <uhd/utils/chdr/chdr_packet.ipp>
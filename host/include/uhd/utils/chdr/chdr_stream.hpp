@@ -0,0 +1,312 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/rfnoc/chdr_types.hpp>
+#include <uhd/rfnoc/rfnoc_types.hpp>
+#include <uhd/types/endianness.hpp>
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uhd { namespace utils { namespace chdr {
+
+//! A number of bytes and packets, e.g. a buffer capacity or a transfer count
+struct chdr_stream_counts_t
+{
+    uint64_t bytes   = 0;
+    uint64_t packets = 0;
+};
+
+/*! The data path of an output stream endpoint (device to host)
+ *
+ * This generates the data packets of a stream, like a stream endpoint of the
+ * FPGA does when a radio streams to the host. The packets carry consecutive
+ * sequence numbers and timestamps, and the source never sends more than the
+ * destination has buffer capacity for:
+ *
+ * 1. write_strc_init() writes the STRC INIT packet that requests the flow
+ *    control frequency from the destination.
+ * 2. The destination answers with an STRS packet with its buffer capacity,
+ *    which goes to handle_strs(). The source can't send before that.
+ * 3. After start(), write_next() writes data packets as long as the
+ *    destination has room for them. handle_strs() frees up that room again.
+ *
+ * The source only writes packets into buffers, it does not send them. It is
+ * not thread-safe.
+ */
+class UHD_API chdr_stream_source
+{
+public:
+    using sptr = std::shared_ptr<chdr_stream_source>;
+
+    virtual ~chdr_stream_source() = 0;
+
+    /*! Writes the STRC INIT packet that starts the flow control of the stream
+     *
+     * This also resets the flow control, the source is blocked until the
+     * destination answers the packet.
+     *
+     * \param buff The buffer to write the packet to
+     * \param max_size The size of the buffer in bytes
+     * \return the size of the packet in bytes
+     */
+    virtual size_t write_strc_init(void* buff, const size_t max_size) = 0;
+
+    /*! Processes a stream status from the destination
+     *
+     * The first status after write_strc_init() sets the buffer capacity, the
+     * following ones update the number of bytes and packets the destination
+     * consumed.
+     */
+    virtual void handle_strs(const uhd::rfnoc::chdr::strs_payload& strs) = 0;
+
+    /*! Starts a burst
+     *
+     * \param spp The number of samples per packet
+     * \param bytes_per_sample The size of a sample, 4 for sc16
+     * \param num_samples The number of samples of the burst, or 0 to stream
+     *        until stop() is called
+     * \param timestamp The timestamp of the first sample, in samples
+     */
+    virtual void start(const size_t spp,
+        const size_t bytes_per_sample,
+        const uint64_t num_samples,
+        const uint64_t timestamp) = 0;
+
+    //! Ends the burst, the next packet carries the EOB flag
+    virtual void stop() = 0;
+
+    /*! Writes the next data packet of the burst
+     *
+     * \param buff The buffer to write the packet to
+     * \param max_size The size of the buffer in bytes
+     * \return the size of the packet in bytes, or 0 if there is no burst, or
+     *         the destination has no room for the packet
+     */
+    virtual size_t write_next(void* buff, const size_t max_size) = 0;
+
+    //! Returns true while a burst has packets left to send
+    virtual bool is_streaming() const = 0;
+
+    //! Returns the number of samples sent since start()
+    virtual uint64_t get_num_samples_sent() const = 0;
+
+    //! Returns the number of bytes and data packets sent since the flow control
+    // was initialized
+    virtual chdr_stream_counts_t get_counts() const = 0;
+
+    /*!
+     * \param chdr_w The CHDR width of the packets
+     * \param endianness The endianness of the link
+     * \param src_epid The EPID of this stream endpoint
+     * \param dst_epid The EPID the data is streamed to
+     * \param fc_freq How often the destination reports its transfer count
+     */
+    static sptr make(const uhd::rfnoc::chdr_w_t chdr_w,
+        const uhd::endianness_t endianness,
+        const uint16_t src_epid,
+        const uint16_t dst_epid,
+        const chdr_stream_counts_t& fc_freq);
+};
+
+/*! The data path of an input stream endpoint (host to device)
+ *
+ * This consumes the data packets of a stream, like a stream endpoint of the
+ * FPGA does when the host streams to a radio. It answers the stream commands
+ * of the source, and sends a stream status with the transfer count every time
+ * the flow control frequency that the STRC INIT packet requested is reached.
+ * Sequence errors are counted, and reported in the next stream status.
+ *
+ * The sink is not thread-safe.
+ */
+class UHD_API chdr_stream_sink
+{
+public:
+    using sptr = std::shared_ptr<chdr_stream_sink>;
+
+    virtual ~chdr_stream_sink() = 0;
+
+    /*! Processes a data or STRC packet of the stream
+     *
+     * \param pkt The packet
+     * \param len The size of the packet in bytes
+     * \param resp The buffer to write the response to
+     * \param resp_max_size The size of the response buffer in bytes
+     * \return the size of the STRS response in bytes, or 0 if the packet needs
+     *         none
+     * \throws uhd::value_error if the packet is truncated
+     */
+    virtual size_t handle_packet(const void* pkt,
+        const size_t len,
+        void* resp,
+        const size_t resp_max_size) = 0;
+
+    //! Returns the number of bytes and packets received since the last STRC INIT
+    virtual chdr_stream_counts_t get_counts() const = 0;
+
+    //! Returns the number of packets that were out of sequence
+    virtual uint64_t get_num_seq_errors() const = 0;
+
+    //! Returns the number of packets with the EOB flag
+    virtual uint64_t get_num_bursts() const = 0;
+
+    /*!
+     * \param chdr_w The CHDR width of the packets
+     * \param endianness The endianness of the link
+     * \param epid The EPID of this stream endpoint
+     * \param capacity The buffer capacity reported to the source
+     */
+    static sptr make(const uhd::rfnoc::chdr_w_t chdr_w,
+        const uhd::endianness_t endianness,
+        const uint16_t epid,
+        const chdr_stream_counts_t& capacity);
+};
+
+//! A UDP datagram, and the address it came from
+struct chdr_datagram_t
+{
+    std::vector<uint8_t> data;
+    std::string addr;
+    uint16_t port = 0;
+};
+
+/*! Streams CHDR data over UDP at the rates of a real device
+ *
+ * This is the data path of emulated devices, such as the simulator of MPM.
+ * The engine owns the UDP socket of the device. A background thread receives
+ * all packets, and handles the data path itself:
+ *
+ * - Data and STRC packets to an EPID added with add_sink() are consumed by a
+ *   chdr_stream_sink, which also sends the STRS responses.
+ * - STRS packets to an EPID added with add_source() update the flow control of
+ *   the chdr_stream_source of that EPID.
+ *
+ * All other packets (management and control packets) are queued for recv().
+ * A second thread sends the data packets of all sources, paced to their
+ * sample rates.
+ *
+ * The configuration of the streams is left to the management and control
+ * packets, i.e., the caller of recv().
+ */
+class UHD_API chdr_stream_engine
+{
+public:
+    using sptr = std::shared_ptr<chdr_stream_engine>;
+
+    virtual ~chdr_stream_engine() = 0;
+
+    /*! Receives the next packet that is not part of the data path
+     *
+     * \param timeout The timeout in seconds
+     * \return the packet, or none on timeout
+     */
+    virtual boost::optional<chdr_datagram_t> recv(const double timeout) = 0;
+
+    /*! Sends a packet from the socket of the engine
+     *
+     * \param data The packet
+     * \param len The size of the packet in bytes
+     * \param addr The IP address to send to
+     * \param port The UDP port to send to
+     */
+    virtual void send(const void* data,
+        const size_t len,
+        const std::string& addr,
+        const uint16_t port) = 0;
+
+    /*! Adds an output stream, and sends its STRC INIT packet
+     *
+     * An existing stream of the same EPID is replaced.
+     *
+     * \param src_epid The EPID of the stream endpoint
+     * \param dst_epid The EPID the data is streamed to
+     * \param addr The IP address of the destination
+     * \param port The UDP port of the destination
+     * \param fc_freq How often the destination reports its transfer count
+     */
+    virtual void add_source(const uint16_t src_epid,
+        const uint16_t dst_epid,
+        const std::string& addr,
+        const uint16_t port,
+        const chdr_stream_counts_t& fc_freq) = 0;
+
+    /*! Starts a burst of an output stream
+     *
+     * \param src_epid The EPID of the stream endpoint
+     * \param spp The number of samples per packet
+     * \param bytes_per_sample The size of a sample, 4 for sc16
+     * \param num_samples The number of samples, or 0 to stream until
+     *        stop_source() is called
+     * \param rate The sample rate to pace the packets to, or 0 to send as
+     *        fast as the flow control allows
+     * \param timestamp The timestamp of the first sample, in samples
+     * \throws uhd::key_error if there is no such stream
+     */
+    virtual void start_source(const uint16_t src_epid,
+        const size_t spp,
+        const size_t bytes_per_sample,
+        const uint64_t num_samples,
+        const double rate,
+        const uint64_t timestamp) = 0;
+
+    //! Ends the burst of an output stream, does nothing if there is no stream
+    virtual void stop_source(const uint16_t src_epid) = 0;
+
+    //! Removes an output stream
+    virtual void remove_source(const uint16_t src_epid) = 0;
+
+    /*! Adds an input stream
+     *
+     * An existing stream of the same EPID is replaced.
+     *
+     * \param epid The EPID of the stream endpoint
+     * \param capacity The buffer capacity reported to the source
+     */
+    virtual void add_sink(const uint16_t epid, const chdr_stream_counts_t& capacity) = 0;
+
+    //! Removes an input stream
+    virtual void remove_sink(const uint16_t epid) = 0;
+
+    /*! Returns the bytes and packets an output stream sent
+     *
+     * \throws uhd::key_error if there is no such stream
+     */
+    virtual chdr_stream_counts_t get_source_counts(const uint16_t src_epid) = 0;
+
+    /*! Returns the bytes and packets an input stream received
+     *
+     * \throws uhd::key_error if there is no such stream
+     */
+    virtual chdr_stream_counts_t get_sink_counts(const uint16_t epid) = 0;
+
+    /*! Returns the number of out-of-sequence packets of an input stream
+     *
+     * \throws uhd::key_error if there is no such stream
+     */
+    virtual uint64_t get_sink_seq_errors(const uint16_t epid) = 0;
+
+    /*! Opens the socket and starts the threads
+     *
+     * \param chdr_w The CHDR width of the packets
+     * \param endianness The endianness of the link
+     * \param addr The IP address to bind the socket to
+     * \param port The UDP port to bind the socket to
+     * \param frame_size The largest packet the engine receives, in bytes
+     * \throws uhd::io_error if the socket can't be bound
+     */
+    static sptr make(const uhd::rfnoc::chdr_w_t chdr_w,
+        const uhd::endianness_t endianness,
+        const std::string& addr,
+        const uint16_t port,
+        const size_t frame_size = 8000);
+};
+
+}}} // namespace uhd::utils::chdr
@@ -10,11 +10,13 @@
 #include <uhd/config.hpp>
 #include <boost/current_function.hpp>
 #include <boost/thread/thread.hpp>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <ostream>
 #include <sstream>
 #include <string>
+#include <type_traits>
 
 /*! \file log.hpp
  *
@@ -234,8 +236,18 @@ UHD_API void set_logger_level(const std::string& logger, uhd::log::severity_leve
 // through the regular backends. Mostly used for printing the UOSDL characters
 // during streaming.
 #    define UHD_LOG_FASTPATH(message) uhd::_log::log_fastpath(message);
+//! Fastpath logging with arguments, formatted by the logging thread
+// The format must be a string literal, every {} in it is replaced by the next
+// argument. Arguments may be integers or floating point values, up to
+// uhd::_log::FASTPATH_MAX_ARGS of them. The calling thread only stores the
+// format and the arguments, which neither locks nor allocates memory.
+//
+// Example: UHD_LOG_FASTPATH_FMT("Sequence error: {} != {}\n", expected, actual)
+#    define UHD_LOG_FASTPATH_FMT(format, ...) \
+        uhd::_log::log_fastpath_fmt("" format, ##__VA_ARGS__);
 #else
 #    define UHD_LOG_FASTPATH(message)
+#    define UHD_LOG_FASTPATH_FMT(format, ...)
 #endif
 
 // iostream-style logging
@@ -272,6 +284,72 @@ namespace _log {
 //! Fastpath logging
 void UHD_API log_fastpath(const std::string&);
 
+//! Fastpath logging of a message that needs no copy into a std::string
+void UHD_API log_fastpath(const char*);
+
+//! Maximum number of arguments of UHD_LOG_FASTPATH_FMT()
+constexpr size_t FASTPATH_MAX_ARGS = 4;
+
+//! Argument of a fastpath log record
+struct fastpath_arg_t
+{
+    enum type_t : char { INT = 'i', UINT = 'u', REAL = 'r' };
+
+    type_t type;
+    union {
+        int64_t i;
+        uint64_t u;
+        double r;
+    };
+};
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value,
+    fastpath_arg_t>::type
+make_fastpath_arg(const T value)
+{
+    fastpath_arg_t arg;
+    arg.type = fastpath_arg_t::INT;
+    arg.i    = value;
+    return arg;
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value,
+    fastpath_arg_t>::type
+make_fastpath_arg(const T value)
+{
+    fastpath_arg_t arg;
+    arg.type = fastpath_arg_t::UINT;
+    arg.u    = value;
+    return arg;
+}
+
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, fastpath_arg_t>::type
+make_fastpath_arg(const T value)
+{
+    fastpath_arg_t arg;
+    arg.type = fastpath_arg_t::REAL;
+    arg.r    = value;
+    return arg;
+}
+
+//! Fastpath logging of a format string literal and its arguments
+void UHD_API log_fastpath(
+    const char* format, const fastpath_arg_t* args, const size_t num_args);
+
+//! Called by UHD_LOG_FASTPATH_FMT()
+template <typename... Args>
+void log_fastpath_fmt(const char* format, const Args... args)
+{
+    static_assert(sizeof...(Args) <= FASTPATH_MAX_ARGS,
+        "Too many arguments for fastpath logging!");
+    // The extra element avoids a zero-sized array
+    const fastpath_arg_t arg_list[] = {make_fastpath_arg(args)..., fastpath_arg_t()};
+    log_fastpath(format, arg_list, sizeof...(Args));
+}
+
 //! Internal logging object (called by UHD_LOG* macros)
 class UHD_API log
 {
@@ -0,0 +1,29 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace uhd {
+
+/*! Return the memory that UHD currently has allocated, by subsystem
+ *
+ * This accounts for the large allocations that UHD makes while running, which
+ * are the bulk of its memory footprint:
+ * - "transport": The frame buffers of all links
+ * - "convert": The lookup tables of converters
+ *
+ * Subsystems that have never allocated anything are not listed.
+ *
+ * \return the number of bytes currently allocated, for each subsystem
+ */
+UHD_API std::map<std::string, size_t> get_memory_usage();
+
+} // namespace uhd
@@ -0,0 +1,108 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uhd {
+
+/*! Send time-aligned bursts to several devices at once
+ *
+ * A single TX streamer that spans several devices sends the packets of all
+ * channels from the thread that calls send(), one channel after another. When
+ * one device is congested, waiting for its flow control credit holds up all
+ * other devices as well.
+ *
+ * This streamer combines one TX streamer per device. send() copies the
+ * samples into a ring of blocks, which is shared by all devices, and returns.
+ * Every device has a worker thread which sends the blocks to its streamer, so
+ * the devices make progress independently of each other. A device can fall
+ * behind the others by as many blocks as the ring holds, only then does
+ * send() wait for it.
+ *
+ * The channels of the streamer are the channels of the device streamers, in
+ * order: The first channels are those of the first device, and so on. Every
+ * device gets the same metadata for a block, so all of them start a burst at
+ * the same time spec, and end it after the same samples. The bursts are only
+ * aligned if the times of the devices are (e.g., set with
+ * multi_usrp::set_time_unknown_pps()).
+ *
+ * The asynchronous messages of all devices are merged, with their channels
+ * mapped to the channels of this streamer. Use get_device_status() to see how
+ * each device is doing.
+ *
+ * send() takes samples in the CPU format of the device streamers, which must
+ * be the same for all of them. EOV positions, send_bursts(), and the other
+ * optional streamer functions are not supported.
+ */
+class UHD_API multi_tx_streamer : public tx_streamer
+{
+public:
+    using sptr = std::shared_ptr<multi_tx_streamer>;
+
+    //! What a device reported, and how far it is behind
+    struct device_status_t
+    {
+        //! The number of samples per channel that were sent to the device
+        uint64_t num_samps_sent = 0;
+        //! The number of blocks the device still has to send
+        size_t num_blocks_queued = 0;
+        //! The number of time errors, i.e., bursts that were late
+        uint64_t num_late = 0;
+        //! The number of underflows, within and between packets
+        uint64_t num_underflows = 0;
+        //! The number of sequence errors, within and between bursts
+        uint64_t num_seq_errors = 0;
+        //! The number of bursts the device acknowledged
+        uint64_t num_burst_acks = 0;
+        //! The number of send() calls to the device that failed
+        uint64_t num_send_errors = 0;
+    };
+
+    virtual ~multi_tx_streamer() = 0;
+
+    //! Return the number of devices
+    virtual size_t get_num_devices() const = 0;
+
+    //! Return the status of a device
+    virtual device_status_t get_device_status(const size_t device) const = 0;
+
+    /*! Wait until all devices sent all blocks
+     *
+     * \param timeout Timeout in seconds
+     * \return true if all blocks were sent, false on a timeout
+     */
+    virtual bool wait_sent(const double timeout) = 0;
+
+    /*! Create a streamer
+     *
+     * The streamer starts a worker thread per device. Destroying the streamer
+     * stops them right away, and ends open bursts. Blocks that weren't sent by
+     * then are dropped, see wait_sent().
+     *
+     * \param tx_streams One streamer per device
+     * \param cpu_format The CPU format of the streamers (e.g., "fc32")
+     * \param args Options:
+     *        - block_size: Samples per channel per block. Defaults to the
+     *          maximum number of samples per packet of the streamers.
+     *        - num_blocks: Number of blocks in the ring. Defaults to 64.
+     * \throws uhd::value_error if there are no streamers, or the arguments are
+     *         invalid
+     */
+    static sptr make(const std::vector<tx_streamer::sptr>& tx_streams,
+        const std::string& cpu_format,
+        const uhd::device_addr_t& args = uhd::device_addr_t());
+};
+
+} // namespace uhd
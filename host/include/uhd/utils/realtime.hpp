@@ -0,0 +1,130 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <cstddef>
+
+namespace uhd {
+
+/*! The threads of a streaming process, which can get different priorities
+ *
+ * - STREAMER: The threads that create streamers. With inline I/O, these are
+ *   also the threads that call recv() and send().
+ * - IO: The offload threads of the I/O services, which move frames between
+ *   the links and the streamers.
+ * - CONVERT: The worker threads that convert samples (see the convert_threads
+ *   stream arg).
+ */
+enum class thread_role_t { STREAMER, IO, CONVERT };
+
+/*! How to set up a streaming process for real-time operation
+ *
+ * Page faults while streaming cost far more than a packet period. They happen
+ * when memory is touched for the first time, e.g. the frame buffers of a link
+ * when its first packets arrive, or when the kernel swapped pages out. For the
+ * first seconds of a stream, this is enough to cause overflows. These settings
+ * move that cost to the setup of the process and of the streamers.
+ *
+ * The device args that set these fields are:
+ *
+ * - rt_lock_memory: "none" (default), "current" to lock the pages the process
+ *   has mapped, or "all" to also lock the pages it maps from then on (see
+ *   mlockall()). Needs the memlock limit, or CAP_IPC_LOCK.
+ * - rt_prefault: 1 to fault in the frame buffers of the links and the
+ *   buffers of the streamers when they are created.
+ * - rt_priority_streamer, rt_priority_io, rt_priority_convert: The SCHED_FIFO
+ *   priority (1 to 99) of the threads of each role, or 0 (default) to leave
+ *   their scheduling unchanged. Needs the rtprio limit, or CAP_SYS_NICE.
+ */
+struct UHD_API realtime_config_t
+{
+    enum lock_mode_t { LOCK_NONE, LOCK_CURRENT, LOCK_ALL };
+
+    //! Which pages of the process to lock into memory
+    lock_mode_t lock_memory = LOCK_NONE;
+
+    //! Whether to fault in link and streamer buffers when they are created
+    bool prefault = false;
+
+    //! SCHED_FIFO priorities of the thread roles, 0 to leave them unchanged
+    int streamer_priority = 0;
+    int io_priority       = 0;
+    int convert_priority  = 0;
+
+    //! Returns the priority of a role
+    int get_priority(const thread_role_t role) const;
+
+    //! Returns true if any of the settings differs from the default
+    bool is_enabled() const;
+};
+
+/*! Reads a real-time configuration from the rt_* device args
+ *
+ * \param args The device args
+ * \return The configuration, with the defaults for the args that are not set
+ * \throws uhd::value_error if an arg has an invalid value
+ */
+UHD_API realtime_config_t parse_realtime_args(const device_addr_t& args);
+
+/*! Sets up the process for real-time streaming
+ *
+ * This locks the memory of the process as configured, and stores the
+ * configuration for the streamers, links and threads that are created later.
+ * Failures are logged, but not fatal: streaming still works, it may just
+ * overflow or underflow more while it starts up.
+ *
+ * Calling this again replaces the configuration. Memory that is locked stays
+ * locked, though.
+ *
+ * \param config The configuration
+ */
+UHD_API void setup_realtime_process(const realtime_config_t& config);
+
+//! Returns the configuration passed to setup_realtime_process()
+UHD_API realtime_config_t get_realtime_config();
+
+/*! Sets the scheduling of the calling thread for its role
+ *
+ * Does nothing if the configuration has no priority for the role.
+ *
+ * \param role The role of the calling thread
+ * \return false if the priority could not be set, which is logged
+ */
+UHD_API bool setup_realtime_thread(const thread_role_t role);
+
+/*! Faults in the pages of a buffer
+ *
+ * Every page is read and written back, so the contents of the buffer are
+ * kept. Nothing else may write to the buffer meanwhile.
+ *
+ * \param mem The buffer
+ * \param size The size of the buffer in bytes
+ */
+UHD_API void prefault_memory(void* mem, const size_t size);
+
+/*! Locks a buffer into memory, and faults in its pages
+ *
+ * Use this for buffers of the application that samples are received into or
+ * sent from, unless rt_lock_memory is "all" anyway. The buffer stays locked
+ * until unlock_memory() is called, or it is unmapped.
+ *
+ * \param mem The buffer
+ * \param size The size of the buffer in bytes
+ * \return false if the buffer could not be locked, which is logged
+ */
+UHD_API bool lock_memory(void* mem, const size_t size);
+
+/*! Unlocks a buffer that lock_memory() locked
+ *
+ * \param mem The buffer
+ * \param size The size of the buffer in bytes
+ */
+UHD_API void unlock_memory(void* mem, const size_t size);
+
+} // namespace uhd
@@ -0,0 +1,226 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/rfnoc/replay_block_control.hpp>
+#include <uhd/rfnoc_graph.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uhd { namespace rfnoc {
+
+/*! Bulk transfers between host memory and the memory of a Replay block
+ *
+ * These functions fill or read back the memory of a Replay block through a
+ * streamer that is created for the transfer, and destroyed afterwards. The
+ * data is transferred as-is, the Replay block doesn't know about sample
+ * formats. Large transfers are sent in chunks of a few megabytes, so the link
+ * is kept busy while the next chunk is read.
+ *
+ * The port of the Replay block must not be connected to anything else while
+ * the transfer is in progress: uploads use the input port, downloads the
+ * output port. Offsets and sizes must be multiples of the memory word size
+ * (see replay_block_control::get_word_size()).
+ */
+
+/*! Upload a buffer to the memory of a Replay block
+ *
+ * This returns once the data has been written to the memory.
+ *
+ * \param graph The graph that contains the Replay block
+ * \param replay The Replay block
+ * \param port The input port of the Replay block to upload through
+ * \param buf The data to upload
+ * \param size The number of bytes to upload
+ * \param offset The memory address to write the data to
+ * \param streamer_args Additional arguments for the streamer (e.g., "spp")
+ * \throws uhd::value_error if \p offset or \p size are not aligned, or if they
+ *         exceed the memory
+ * \throws uhd::io_error if the data could not be sent, or if it was not
+ *         written to the memory in time
+ */
+void UHD_API replay_upload(rfnoc_graph::sptr graph,
+    replay_block_control::sptr replay,
+    const size_t port,
+    const void* buf,
+    const uint64_t size,
+    const uint64_t offset,
+    const uhd::device_addr_t& streamer_args = uhd::device_addr_t());
+
+/*! Upload a file to the memory of a Replay block
+ *
+ * See replay_upload(). The size of the file is rounded down to a multiple of
+ * the memory word size.
+ *
+ * \param graph The graph that contains the Replay block
+ * \param replay The Replay block
+ * \param port The input port of the Replay block to upload through
+ * \param path The file to upload
+ * \param offset The memory address to write the data to
+ * \param use_mmap If true, the file is memory-mapped instead of read in chunks
+ * \param streamer_args Additional arguments for the streamer (e.g., "spp")
+ * \return the number of bytes uploaded
+ * \throws uhd::os_error if the file can't be read
+ */
+uint64_t UHD_API replay_upload_file(rfnoc_graph::sptr graph,
+    replay_block_control::sptr replay,
+    const size_t port,
+    const std::string& path,
+    const uint64_t offset,
+    const bool use_mmap                     = true,
+    const uhd::device_addr_t& streamer_args = uhd::device_addr_t());
+
+/*! Download data from the memory of a Replay block
+ *
+ * This plays back the requested memory region into a streamer. The play
+ * configuration of the port (see replay_block_control::config_play()) is
+ * changed by this function.
+ *
+ * \param graph The graph that contains the Replay block
+ * \param replay The Replay block
+ * \param port The output port of the Replay block to download through
+ * \param buf The buffer to write the data to, must hold \p size bytes
+ * \param size The number of bytes to download
+ * \param offset The memory address to read the data from
+ * \param streamer_args Additional arguments for the streamer
+ * \throws uhd::value_error if \p offset or \p size are not aligned, or if they
+ *         exceed the memory
+ * \throws uhd::io_error if not all data was received
+ */
+void UHD_API replay_download(rfnoc_graph::sptr graph,
+    replay_block_control::sptr replay,
+    const size_t port,
+    void* buf,
+    const uint64_t size,
+    const uint64_t offset,
+    const uhd::device_addr_t& streamer_args = uhd::device_addr_t());
+
+/*! Download data from the memory of a Replay block into a vector
+ *
+ * See replay_download().
+ *
+ * \return the downloaded data
+ */
+std::vector<uint8_t> UHD_API replay_download(rfnoc_graph::sptr graph,
+    replay_block_control::sptr replay,
+    const size_t port,
+    const uint64_t size,
+    const uint64_t offset,
+    const uhd::device_addr_t& streamer_args = uhd::device_addr_t());
+
+/*! Use the memory of a Replay block as a ring buffer towards the host
+ *
+ * Bursts that are faster than the link to the host can be recorded losslessly
+ * into the memory of the Replay block, and read by the host at the rate of the
+ * link. The ring reader plays back what has been recorded so far through a
+ * streamer, while the input port of the Replay block keeps recording.
+ *
+ * The Replay block records into a window of memory, and stops accepting data
+ * (i.e., it stalls the upstream block) once the window is full. It cannot wrap
+ * around by itself. The ring reader therefore moves the window forward every
+ * time the block has filled it: the new window starts where the recording
+ * stopped, and ends at the end of the ring, or where the host still has to
+ * read data, whichever comes first. This happens in read() and service(), so
+ * these need to be called often enough for the window to move on in time.
+ * While the block waits for a new window, the upstream block is stalled,
+ * e.g., a radio will report overruns. A single window per lap keeps this to
+ * once per trip around the ring when the host keeps up.
+ *
+ * The input port of the Replay block must be connected to the source of the
+ * data before the reader is created. The reader starts recording when it is
+ * created, and connects the output port to a streamer of its own. The data is
+ * read as-is, in the format it was recorded in.
+ *
+ * The reader is not thread-safe. Call read() and service() from one thread.
+ */
+class UHD_API replay_ring_reader : uhd::noncopyable
+{
+public:
+    using sptr = std::shared_ptr<replay_ring_reader>;
+
+    //! Counters of the data that went through the ring
+    struct stats_t
+    {
+        //! Number of bytes recorded to the ring
+        uint64_t bytes_recorded = 0;
+        //! Number of bytes read by the host
+        uint64_t bytes_read = 0;
+        //! Number of times recording reached the end of the ring and wrapped around
+        uint64_t num_write_wraps = 0;
+        //! Number of times reading reached the end of the ring and wrapped around
+        uint64_t num_read_wraps = 0;
+        //! Number of times the record window was moved on
+        uint64_t num_window_moves = 0;
+        /*! Number of times the ring was found full
+         *
+         * While the ring is full, data coming into the Replay block is stalled,
+         * which means data is lost if the source can't hold it back (e.g., a
+         * radio).
+         */
+        uint64_t num_overflows = 0;
+        /*! Time in seconds the Replay block was found to be stalled
+         *
+         * This is measured from the first read() or service() that saw the
+         * block stalled, at the end of a full ring or of a window, so it's a
+         * lower bound.
+         */
+        double stall_time = 0.0;
+    };
+
+    virtual ~replay_ring_reader() = 0;
+
+    /*! Read the next data from the ring
+     *
+     * \param buf The buffer to write the data to
+     * \param max_bytes The size of the buffer in bytes. The data is read in
+     *        multiples of 4 bytes.
+     * \param timeout The time in seconds to wait for data
+     * \return The number of bytes read, 0 on a timeout
+     * \throws uhd::io_error if the streamer reports an error
+     */
+    virtual size_t read(void* buf, const size_t max_bytes, const double timeout) = 0;
+
+    /*! Move the record window and issue playback, without reading
+     *
+     * read() calls this, too. Call it separately if there are times the host
+     * can't read, but recording should go on.
+     */
+    virtual void service() = 0;
+
+    //! Number of bytes recorded, but not read yet
+    virtual uint64_t get_fill() const = 0;
+
+    //! Returns the counters of the ring
+    virtual stats_t get_stats() const = 0;
+
+    /*! Create a ring reader, and start recording
+     *
+     * \param graph The graph that contains the Replay block
+     * \param replay The Replay block
+     * \param record_port The input port of the Replay block to record from
+     * \param play_port The output port of the Replay block to read through
+     * \param offset The memory address of the ring
+     * \param size The size of the ring in bytes
+     * \param streamer_args Additional arguments for the streamer
+     * \throws uhd::value_error if \p offset or \p size are not aligned, or if
+     *         they exceed the memory
+     */
+    static sptr make(rfnoc_graph::sptr graph,
+        replay_block_control::sptr replay,
+        const size_t record_port,
+        const size_t play_port,
+        const uint64_t offset,
+        const uint64_t size,
+        const uhd::device_addr_t& streamer_args = uhd::device_addr_t());
+};
+
+}} // namespace uhd::rfnoc
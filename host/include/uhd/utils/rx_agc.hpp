@@ -0,0 +1,135 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/rfnoc/radio_control.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/types/ranges.hpp>
+#include <uhd/types/time_spec.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uhd {
+
+/*! Automatic gain control for an RX streamer
+ *
+ * The AGC receives from a single-channel RX streamer, like recv() does, and
+ * measures the power of the samples while they are still in the cache, right
+ * after they were converted. For every block of samples, it compares the
+ * power to a target, and moves the gain towards the target: quickly when the
+ * signal is too strong (attack), and slowly when it's too weak (decay).
+ *
+ * When the samples have time specs, gain changes are timed commands, which
+ * take effect a little after the last sample that was measured. Every change
+ * is reported with the time of the first sample it applies to, so an
+ * application can tell exactly which samples were received at which gain.
+ * Samples that were received before a change takes effect are not used to
+ * measure the power, so the loop never reacts to the same signal twice.
+ *
+ * Gain changes go through the gain setter, e.g.
+ * uhd::rfnoc::radio_control::set_rx_gain(). Where the device distributes the
+ * gain across several stages, it does so through its gain tables.
+ */
+class UHD_API rx_agc : uhd::noncopyable
+{
+public:
+    using sptr = std::shared_ptr<rx_agc>;
+
+    /*! Sets the gain, and returns the actual gain
+     *
+     * The time is the command time for the change, or zero if the change is
+     * to happen right away.
+     */
+    using gain_setter_t = std::function<double(double, const uhd::time_spec_t&)>;
+
+    //! A gain change of the AGC
+    struct gain_change_t
+    {
+        //! The time of the first sample received at the new gain
+        uhd::time_spec_t time;
+        //! False if the change is not timed, as the samples have no time specs
+        bool has_time_spec;
+        //! The actual gain
+        double gain;
+    };
+
+    virtual ~rx_agc() = 0;
+
+    /*! Receive samples, and adjust the gain
+     *
+     * This takes the same arguments as uhd::rx_streamer::recv(), for a single
+     * channel.
+     */
+    virtual size_t recv(void* buff,
+        const size_t nsamps,
+        rx_metadata_t& metadata,
+        const double timeout = 0.1,
+        const bool one_packet = false) = 0;
+
+    //! Return the current gain
+    virtual double get_gain() const = 0;
+
+    //! Return the power of the last measured block, in dBFS
+    virtual double get_power() const = 0;
+
+    /*! Return the gain changes since the last call
+     *
+     * A change may apply to samples that haven't been received yet.
+     */
+    virtual std::vector<gain_change_t> get_gain_changes() = 0;
+
+    /*! Create an AGC
+     *
+     * \param rx_stream The streamer to receive from, with a single channel
+     * \param cpu_format The CPU format of the streamer: fc64, fc32, sc16 or sc8
+     * \param rate The sample rate of the streamer
+     * \param gain_range The range of gains that the AGC may set
+     * \param gain The current gain
+     * \param set_gain The function to change the gain
+     * \param args Options:
+     *        - target: The target power in dBFS. Defaults to -20.
+     *        - block_size: The number of samples per measurement. Defaults to
+     *          1024.
+     *        - attack: The fraction of the error to correct per block when
+     *          the power is above the target, between 0 and 1. Defaults to 1.
+     *        - decay: The same, for when the power is below the target.
+     *          Defaults to 0.1.
+     *        - hysteresis: Errors up to this many dB are not corrected.
+     *          Defaults to 1.
+     *        - cmd_delay: The time in seconds from the last measured sample to
+     *          a timed gain change. It must cover the latency of the control
+     *          path. Defaults to 1e-3.
+     * \throws uhd::value_error if the arguments are invalid
+     */
+    static sptr make(rx_streamer::sptr rx_stream,
+        const std::string& cpu_format,
+        const double rate,
+        const uhd::gain_range_t& gain_range,
+        const double gain,
+        gain_setter_t set_gain,
+        const uhd::device_addr_t& args = uhd::device_addr_t());
+
+    /*! Create an AGC that sets the overall gain of a radio channel
+     *
+     * The gain range and the current gain are read from the radio. See the
+     * other make() for the arguments.
+     */
+    static sptr make(rx_streamer::sptr rx_stream,
+        const std::string& cpu_format,
+        const double rate,
+        uhd::rfnoc::radio_control::sptr radio,
+        const size_t chan,
+        const uhd::device_addr_t& args = uhd::device_addr_t());
+};
+
+} // namespace uhd
@@ -0,0 +1,108 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace uhd {
+
+/*! Receive into blocks of memory that belong to the application
+ *
+ * Accelerators (e.g., GPUs) process samples in large blocks, in memory they
+ * can access directly, like page-locked host memory that is mapped into the
+ * device. Receiving into a host buffer, and then copying that into such a
+ * block costs a copy of every sample. The block receiver instead receives
+ * straight into the blocks of the application, in a thread of its own, so
+ * receiving the next block overlaps with processing the previous ones:
+ *
+ * \code{.cpp}
+ * // Blocks allocated with, e.g., cudaHostAlloc(..., cudaHostAllocMapped)
+ * auto receiver = uhd::rx_block_receiver::make(rx_stream, blocks, samps_per_block);
+ * uhd::rx_block_receiver::block_t block;
+ * while (receiver->get_block(block, 1.0)) {
+ *     process_on_device(block.buffs, block.nsamps);
+ *     receiver->release_block(block.index);
+ * }
+ * \endcode
+ *
+ * The samples are converted to the CPU format of the streamer as they are
+ * received. To convert them on the accelerator instead, use the sc16 CPU
+ * format with the sc16 over-the-wire format: Then the samples are only
+ * copied.
+ *
+ * When the application holds on to all blocks, the receiver waits for a block
+ * to be released, and the device eventually overruns.
+ */
+class UHD_API rx_block_receiver : uhd::noncopyable
+{
+public:
+    using sptr = std::shared_ptr<rx_block_receiver>;
+
+    //! A block that holds received samples
+    struct block_t
+    {
+        //! The index of the block in the list it was passed to make() with
+        size_t index = 0;
+        //! The buffers of the block, one per channel
+        std::vector<void*> buffs;
+        /*! The number of samples in each buffer. This is less than the size of
+         *  the block when the stream paused or ended, and 0 on errors.
+         */
+        size_t nsamps = 0;
+        //! The metadata of the first sample
+        rx_metadata_t metadata;
+    };
+
+    virtual ~rx_block_receiver() = 0;
+
+    /*! Get the next block with samples
+     *
+     * The block belongs to the application until it calls release_block().
+     *
+     * \param block Returns the block
+     * \param timeout Time in seconds to wait for a block
+     * \return false on a timeout
+     */
+    virtual bool get_block(block_t& block, const double timeout = 0.1) = 0;
+
+    /*! Hand a block back to the receiver, to receive into it again
+     *
+     * \throws uhd::value_error if the application doesn't hold the block
+     */
+    virtual void release_block(const size_t index) = 0;
+
+    /*! Return the number of times the receiver had to wait for a block to be
+     *  released
+     */
+    virtual uint64_t get_num_stalls() const = 0;
+
+    /*! Make a block receiver, and start receiving
+     *
+     * The receiver doesn't issue stream commands.
+     *
+     * \param rx_stream The streamer to receive from. Nothing else may receive
+     *        from it while the receiver exists.
+     * \param blocks The blocks, every block has one buffer per channel of the
+     *        streamer. The memory has to remain valid for as long as the
+     *        receiver exists.
+     * \param samps_per_block The number of samples each buffer holds
+     * \throws uhd::value_error if there are no blocks, or they don't have a
+     *         buffer per channel
+     */
+    static sptr make(rx_streamer::sptr rx_stream,
+        const std::vector<std::vector<void*>>& blocks,
+        const size_t samps_per_block);
+};
+
+} // namespace uhd
@@ -0,0 +1,123 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/types/time_spec.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace uhd {
+
+/*! Keep the last few seconds of an RX stream, and capture windows around
+ *  trigger times
+ *
+ * To capture transient signals, the stream has to run all the time, but only
+ * the samples around an event are of interest, including the ones that were
+ * received before the event was detected. The capture buffer keeps the most
+ * recent samples of a stream in a ring, in the over-the-wire format, so
+ * receiving them only costs a copy. It gets the packets from the I/O thread
+ * of the streamer (see rx_streamer::set_recv_packet_callback()), so the
+ * streamer must use an I/O thread (e.g., the recv_offload stream arg), and
+ * the application must not call recv() on it.
+ *
+ * A call to trigger() pins a window around a time. Once the ring holds the
+ * whole window, a worker thread converts it to the CPU format, and passes
+ * it to a handler. So only the samples of the windows are converted.
+ *
+ * The ring keeps receiving while a window is converted. Should it overwrite
+ * part of a window before the worker is done with it (because the ring holds
+ * little more than the window), the capture is flagged as incomplete.
+ */
+class UHD_API rx_capture_buffer : uhd::noncopyable
+{
+public:
+    using sptr = std::shared_ptr<rx_capture_buffer>;
+
+    //! Samples captured around a trigger
+    struct capture_t
+    {
+        //! One buffer per channel, with the samples in the CPU format
+        std::vector<std::vector<char>> buffs;
+        //! The number of samples in each buffer
+        size_t nsamps = 0;
+        //! The time of the first sample
+        time_spec_t time_spec;
+        //! The trigger time that was passed to trigger()
+        time_spec_t trigger_time;
+        /*! False if samples are missing, because they had been dropped from
+         *  the ring (or overwritten while converting), or because the stream
+         *  had a gap (e.g., an overrun). Then the samples in the buffers are
+         *  not contiguous, or not all from the requested window.
+         */
+        bool complete = false;
+    };
+
+    /*! Gets a capture, runs on the worker thread
+     *
+     * Exceptions it throws are logged and dropped.
+     */
+    using capture_handler_t = std::function<void(capture_t& capture)>;
+
+    virtual ~rx_capture_buffer() = 0;
+
+    /*! Capture the window [trigger_time - pre_time, trigger_time + post_time)
+     *
+     * The trigger time can be in the past, as long as the window is still in
+     * the ring, or in the future. The handler runs once the ring holds the
+     * end of the window. Windows that haven't ended when the capture buffer
+     * is destroyed are dropped.
+     *
+     * \param trigger_time The device time of the event
+     * \param pre_time The time before the event to capture, in seconds
+     * \param post_time The time after the event to capture, in seconds
+     * \param handler Gets the samples
+     * \throws uhd::value_error if the window is longer than the ring, or if
+     *         one of the times is negative
+     */
+    virtual void trigger(const time_spec_t& trigger_time,
+        const double pre_time,
+        const double post_time,
+        capture_handler_t handler) = 0;
+
+    //! Return the time span the ring can hold, in seconds
+    virtual double get_capacity() const = 0;
+
+    //! Return the number of windows that haven't been passed to their handler yet
+    virtual size_t get_num_pending() const = 0;
+
+    /*! Make a capture buffer, and start receiving
+     *
+     * The capture buffer doesn't issue stream commands.
+     *
+     * Arguments:
+     * - hugepages: Back the ring with hugepages ("2M" or "1G"). Falls back to
+     *   regular pages with a warning if not enough are reserved.
+     * - scalar: The factor that scales the over-the-wire samples to the CPU
+     *   format (defaults to full scale for the over-the-wire format).
+     *
+     * \param rx_stream The streamer to receive from
+     * \param stream_args The stream args the streamer was made with
+     * \param rate The sample rate of the stream
+     * \param capacity The time the ring can hold, in seconds
+     * \param args Additional arguments, see above
+     * \throws uhd::not_implemented_error if the streamer can't pass packets to
+     *         callbacks on its I/O thread
+     */
+    static sptr make(rx_streamer::sptr rx_stream,
+        const stream_args_t& stream_args,
+        const double rate,
+        const double capacity,
+        const device_addr_t& args = device_addr_t());
+};
+
+} // namespace uhd
@@ -0,0 +1,103 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <cstddef>
+#include <memory>
+
+namespace uhd {
+
+/*! Split one wideband RX stream into narrow channels on the host
+ *
+ * The channelizer is a polyphase filter bank: It receives from a single
+ * channel RX streamer in a thread of its own, and splits the band into
+ * \p num_chans channels of equal width. Channel k is centered at
+ * k * rate / num_chans from the center of the band, so the channels from
+ * num_chans / 2 on are the negative frequencies (see get_channel_freq()).
+ * Every channel is filtered with the same prototype lowpass filter, and
+ * decimated by \p decim, which must divide num_chans. With decim equal to
+ * num_chans (the default), the channels are critically sampled; a smaller
+ * decimation oversamples them, so that signals which straddle the edge of a
+ * channel don't alias.
+ *
+ * Every channel is an rx_streamer of its own, with one channel, which returns
+ * fc32 samples. Each can be read from its own thread. The time spec of a
+ * sample is the time of the input sample it was computed from, minus the
+ * group delay of the filter, so all channels line up with each other and
+ * with the input stream. Each channel queues a number of blocks. When a
+ * channel isn't read for long enough, its oldest blocks are dropped, and recv()
+ * reports ERROR_CODE_OVERFLOW, like a device does. Overflows and other errors
+ * of the input streamer are passed to all channels.
+ *
+ * The filter bank costs (taps_per_chan + log2(num_chans)) multiply-adds per
+ * input sample and channel, divided by decim. The work can be spread over
+ * several threads with the num_threads argument.
+ *
+ * Stream commands issued to any channel go to the input streamer, so they
+ * start and stop all channels. The number of samples of a NUM_SAMPS command
+ * is scaled by the decimation.
+ */
+class UHD_API rx_channelizer : uhd::noncopyable
+{
+public:
+    using sptr = std::shared_ptr<rx_channelizer>;
+
+    virtual ~rx_channelizer() = 0;
+
+    //! Return the number of channels
+    virtual size_t get_num_channels() const = 0;
+
+    /*! Return the streamer of a channel
+     *
+     * \throws uhd::index_error if there is no such channel
+     */
+    virtual rx_streamer::sptr get_channel(const size_t chan) const = 0;
+
+    //! Return the sample rate of the channels (Hz)
+    virtual double get_channel_rate() const = 0;
+
+    /*! Return the center frequency of a channel, relative to the center of
+     * the input band (Hz)
+     *
+     * \throws uhd::index_error if there is no such channel
+     */
+    virtual double get_channel_freq(const size_t chan) const = 0;
+
+    /*! Create a channelizer, and start receiving
+     *
+     * The channelizer receives until it is destroyed. The channel streamers
+     * can outlive it, and then time out once they've returned their queued
+     * samples.
+     *
+     * \param rx_stream The streamer to receive from. It must have one channel,
+     *        and the CPU format fc32. Nothing else may receive from it while
+     *        the channelizer exists.
+     * \param rate The sample rate of the streamer (Hz)
+     * \param args Options:
+     *        - num_chans: The number of channels, a power of two. Defaults
+     *          to 16.
+     *        - decim: The decimation, which divides num_chans. Defaults to
+     *          num_chans.
+     *        - taps_per_chan: The length of the prototype filter divided by
+     *          num_chans. Longer filters have steeper edges. Defaults to 12.
+     *        - num_threads: The number of threads which compute the channels,
+     *          including the receive thread. Defaults to 1.
+     *        - queue_size: The number of blocks a channel can queue. Defaults
+     *          to 64.
+     * \throws uhd::value_error if the streamer has more than one channel, or
+     *         the arguments are invalid
+     */
+    static sptr make(rx_streamer::sptr rx_stream,
+        const double rate,
+        const uhd::device_addr_t& args = uhd::device_addr_t());
+};
+
+} // namespace uhd
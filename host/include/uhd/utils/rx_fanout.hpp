@@ -0,0 +1,116 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uhd {
+
+/*! Share one RX stream among several consumers in the same process
+ *
+ * The fan-out receives from an RX streamer in a thread of its own, one packet
+ * at a time, and hands every packet to all of its subscribers. The packets
+ * are reference counted, so the samples are converted only once, and are then
+ * shared by all subscribers without copying. Their memory is recycled once
+ * every subscriber has dropped its reference.
+ *
+ * Every subscriber has its own queue of packets, and reads at its own pace.
+ * When a queue is full, the subscriber's overflow policy decides what
+ * happens:
+ * - DROP_OLDEST: The oldest packet in the queue is dropped, so a slow
+ *   subscriber misses packets, but doesn't hold up the others. See
+ *   subscriber::get_num_dropped().
+ * - BACKPRESSURE: The fan-out waits until the subscriber makes room. This
+ *   holds up all subscribers, and once the streamer buffers are full, the
+ *   device reports an overrun, which every subscriber sees.
+ *
+ * The fan-out doesn't own the link buffers: Holding them until the slowest
+ * subscriber is done would starve the link, which only has a few of them.
+ *
+ * The fan-out doesn't issue stream commands.
+ */
+class UHD_API rx_fanout : uhd::noncopyable
+{
+public:
+    using sptr = std::shared_ptr<rx_fanout>;
+
+    //! A packet of samples, shared by all subscribers
+    struct packet_t
+    {
+        //! One buffer per channel, in the CPU format of the streamer
+        std::vector<const void*> buffs;
+        //! The number of samples in each buffer
+        size_t nsamps;
+        //! The metadata returned by recv(). Errors come with nsamps set to 0.
+        rx_metadata_t metadata;
+    };
+
+    using packet_sptr = std::shared_ptr<const packet_t>;
+
+    //! What to do when the queue of a subscriber is full
+    enum class overflow_policy_t { DROP_OLDEST, BACKPRESSURE };
+
+    //! Reads the packets of a fan-out. Drop it to unsubscribe.
+    class UHD_API subscriber : uhd::noncopyable
+    {
+    public:
+        using sptr = std::shared_ptr<subscriber>;
+
+        virtual ~subscriber() = 0;
+
+        /*! Get the next packet
+         *
+         * \param timeout Time in seconds to wait for a packet
+         * \return the packet, or nullptr on a timeout
+         */
+        virtual packet_sptr pop(const double timeout = 0.1) = 0;
+
+        //! Return the number of packets that are waiting to be read
+        virtual size_t get_num_queued() const = 0;
+
+        //! Return the number of packets that were dropped because the queue was full
+        virtual uint64_t get_num_dropped() const = 0;
+    };
+
+    virtual ~rx_fanout() = 0;
+
+    /*! Add a subscriber
+     *
+     * The subscriber gets the packets received from now on.
+     *
+     * \param queue_size The number of packets the subscriber can queue
+     * \param policy What to do when the queue is full
+     * \throws uhd::value_error if queue_size is 0
+     */
+    virtual subscriber::sptr subscribe(const size_t queue_size = 64,
+        const overflow_policy_t policy = overflow_policy_t::DROP_OLDEST) = 0;
+
+    //! Return the number of subscribers
+    virtual size_t get_num_subscribers() const = 0;
+
+    /*! Create a fan-out, and start receiving
+     *
+     * The fan-out receives until it is destroyed, even without subscribers,
+     * so the streamer doesn't overrun. Subscribers can outlive it, and then
+     * time out in pop() once they've read all their packets.
+     *
+     * \param rx_stream The streamer to receive from. Nothing else may receive
+     *        from it while the fan-out exists.
+     * \param cpu_format The CPU format of the streamer (e.g., "fc32")
+     */
+    static sptr make(rx_streamer::sptr rx_stream, const std::string& cpu_format);
+};
+
+} // namespace uhd
@@ -0,0 +1,97 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace uhd {
+
+/*! Receive whole frames of display data, e.g., from a Fosphor or LogPwr block
+ *
+ * Blocks like Fosphor and LogPwr output frames of data (a histogram, a
+ * waterfall row, an FFT worth of power values) rather than a sample stream.
+ * The frame streamer receives from a single-channel RX streamer, and only
+ * ever returns complete frames, starting at the beginning of the buffer. The
+ * samples are received straight into the caller's buffer. Use the CPU format
+ * that matches the block output (u8 for Fosphor, s16 for LogPwr) and the same
+ * OTW format, so receiving is no more than a copy out of the transport
+ * buffers.
+ *
+ * Frames are delimited in one of two ways:
+ * - By packets: every packet holds one frame (e.g., a Fosphor waterfall row,
+ *   or LogPwr output when the packet size equals the FFT size).
+ * - By EOB: a frame spans several packets, and its last packet has the EOB
+ *   flag set (e.g., the 66 packets of a Fosphor histogram).
+ *
+ * Frames that are incomplete or don't have the frame size, e.g., because of
+ * an overrun, are discarded, and the streamer resumes at the start of the
+ * next frame.
+ *
+ * A display rarely needs every frame. The frame streamer can skip frames
+ * (one in N, or down to a maximum frame rate), so that recv_frame() always
+ * returns a recent frame and the application does not need to keep up with
+ * the block. Skipped frames still cross the link; to lower the link rate
+ * too, raise the decimation of the block itself (e.g.,
+ * fosphor_block_control::set_histogram_decimation()).
+ */
+class UHD_API rx_frame_streamer : uhd::noncopyable
+{
+public:
+    using sptr = std::shared_ptr<rx_frame_streamer>;
+
+    virtual ~rx_frame_streamer() = 0;
+
+    //! Return the number of items per frame
+    virtual size_t get_frame_size() const = 0;
+
+    /*! Receive the next frame that is not skipped
+     *
+     * \param buff Buffer for get_frame_size() items of the CPU format
+     * \param metadata Returns the metadata of the first packet of the frame,
+     *        or the error that ended receiving
+     * \param timeout Time in seconds to wait for the frame
+     * \returns get_frame_size() if a frame was received, or 0 on errors. On a
+     *          timeout, the error code is ERROR_CODE_TIMEOUT.
+     */
+    virtual size_t recv_frame(
+        void* buff, rx_metadata_t& metadata, const double timeout = 0.1) = 0;
+
+    //! Number of complete frames that were skipped to reduce the frame rate
+    virtual uint64_t get_num_frames_skipped() const = 0;
+
+    //! Number of incomplete or misaligned frames that were discarded
+    virtual uint64_t get_num_frames_discarded() const = 0;
+
+    /*! Create a frame streamer
+     *
+     * The frame streamer doesn't issue stream commands.
+     *
+     * \param rx_stream The streamer to receive from, with a single channel
+     * \param cpu_format The CPU format of the streamer (e.g., "u8")
+     * \param frame_size The number of items per frame
+     * \param args Options:
+     *        - eob: Set to 1 if frames end at EOB rather than at the end of
+     *          every packet.
+     *        - decim: Return only one in this many frames. Defaults to 1.
+     *        - max_frame_rate: Return at most this many frames per second.
+     *          Defaults to 0, which means no limit.
+     * \throws uhd::value_error if the arguments are invalid
+     */
+    static sptr make(rx_streamer::sptr rx_stream,
+        const std::string& cpu_format,
+        const size_t frame_size,
+        const uhd::device_addr_t& args = uhd::device_addr_t());
+};
+
+} // namespace uhd
@@ -0,0 +1,127 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uhd {
+
+/*! Record the samples of an RX streamer to disk
+ *
+ * Writing to a file from the thread that calls recv() means that every disk
+ * stall turns into an overrun. The recorder calls recv() on its own thread,
+ * which only fills blocks of memory. The blocks are written by one thread per
+ * file, so recordings can be striped over several drives to add up their
+ * bandwidth. Where available, the files are written with O_DIRECT, so the
+ * samples don't go through the page cache.
+ *
+ * Every block holds the same number of samples for every channel, one channel
+ * after the other. Block N is written to file N % (number of files), at offset
+ * (N / (number of files)) * (block size). A block always holds contiguous
+ * samples: when an overrun happens, the block is ended and the next block
+ * starts after the gap. The same goes for the end of a burst. Blocks that
+ * aren't full are padded with zeros.
+ *
+ * The recorder also writes an index file, a text file with one line per block:
+ * the block number, the file number, the offset in the file, the number of
+ * samples per channel, whether there's a time spec, the time of the first
+ * sample (full and fractional seconds), and whether samples were lost right
+ * before the block.
+ *
+ * With the compress option, the blocks of sc16 samples are compressed without
+ * loss, which cuts the size of recordings of noise and of weak signals. The
+ * blocks are then of different sizes, see decode_block().
+ *
+ * The recorder doesn't issue stream commands, so the caller can start the
+ * streamer once the recorder is running (e.g., at a given time).
+ */
+class UHD_API rx_recorder : uhd::noncopyable
+{
+public:
+    using sptr = std::shared_ptr<rx_recorder>;
+
+    virtual ~rx_recorder() = 0;
+
+    //! Start receiving and writing samples. A recorder can only be started once.
+    virtual void start() = 0;
+
+    /*! Stop receiving, and wait until all blocks were written
+     *
+     * \throws uhd::os_error if writing a file failed
+     * \throws uhd::io_error if the streamer reported an error
+     */
+    virtual void stop() = 0;
+
+    /*! Returns false once the recorder was stopped, or stopped itself
+     *
+     * The recorder stops itself on errors. Call stop() to find out what went
+     * wrong.
+     */
+    virtual bool is_running() const = 0;
+
+    //! Number of samples per channel received so far
+    virtual uint64_t get_num_samps_recorded() const = 0;
+
+    //! Number of overruns reported by the streamer so far
+    virtual size_t get_num_overflows() const = 0;
+
+    /*! Create a recorder
+     *
+     * Existing files are overwritten.
+     *
+     * \param rx_stream The streamer to receive from
+     * \param cpu_format The CPU format of the streamer (e.g., "sc16")
+     * \param paths The files to stripe the samples over
+     * \param args Options:
+     *        - block_size: Bytes per channel per block, must be a multiple of
+     *          4096. Defaults to 1 MiB.
+     *        - num_blocks: Number of blocks that are buffered in memory.
+     *          Defaults to 32.
+     *        - direct_io: Set to 0 to write through the page cache.
+     *        - index_path: The index file. Defaults to the first path with a
+     *          ".idx" suffix.
+     *        - compress: Set to 1 to compress the blocks without loss, see
+     *          decode_block(). Only for the sc16 CPU format.
+     * \throws uhd::value_error if the arguments are invalid
+     * \throws uhd::os_error if a file can't be opened
+     */
+    static sptr make(rx_streamer::sptr rx_stream,
+        const std::string& cpu_format,
+        const std::vector<std::string>& paths,
+        const uhd::device_addr_t& args = uhd::device_addr_t());
+
+    /*! Decode a compressed block
+     *
+     * A compressed block holds each channel as a 32-bit little-endian byte
+     * count, followed by the samples encoded with uhd::sc16_codec. It is
+     * padded with zeros to a multiple of 4096 bytes, and the blocks of a file
+     * follow each other. The index file lists the offset and the size of each
+     * block without the padding in its last column, stored_size.
+     *
+     * \param data The block, as read from the offset of the index entry
+     * \param size The stored size of the block
+     * \param num_channels The number of channels of the recording
+     * \param num_samps The number of samples per channel of the block
+     * \return the samples of each channel
+     * \throws uhd::value_error if the block is truncated or corrupt
+     */
+    static std::vector<std::vector<std::complex<int16_t>>> decode_block(
+        const void* data,
+        const size_t size,
+        const size_t num_channels,
+        const size_t num_samps);
+};
+
+} // namespace uhd
@@ -0,0 +1,115 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <complex>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace uhd {
+
+/*! Receive averaged power spectra, computed on the host
+ *
+ * This is the host counterpart of an FFT block followed by a magnitude and an
+ * averaging stage, for FPGA images without them. The spectrum streamer
+ * receives from a single-channel fc32 RX streamer, straight into its own
+ * buffer, and splits the samples into windows of \p fft_size samples, which
+ * overlap by a configurable fraction. Every window is multiplied with a
+ * window function, transformed, and the powers of its bins are averaged
+ * (Welch's method). recv_frame() returns one averaged spectrum per call.
+ *
+ * The powers are scaled so that a tone in the middle of a bin yields the
+ * square of its amplitude, e.g., 1.0 (or 0 dB) for a full scale tone. With
+ * the default options, the bins are shifted like for a display: the first
+ * value is the lowest frequency, and DC is at fft_size / 2.
+ *
+ * Two kinds of averages are available:
+ * - block: Every frame is the mean of num_avg consecutive windows. Frames
+ *   that are skipped (see decim and max_frame_rate) aren't computed at all,
+ *   so a display that only needs a few frames per second costs little more
+ *   than receiving the samples.
+ * - exp: An exponential average, which weighs every window by 1 / num_avg,
+ *   and yields a frame per window.
+ *
+ * Averages don't span gaps in the samples: After an overflow, or at the end
+ * of a burst, averaging starts over.
+ *
+ * The spectrum streamer doesn't issue stream commands.
+ */
+class UHD_API rx_spectrum_streamer : uhd::noncopyable
+{
+public:
+    using sptr = std::shared_ptr<rx_spectrum_streamer>;
+
+    /*! Transforms fft_size samples in place, without scaling
+     *
+     * This computes a forward DFT, i.e., with a negative exponent, like
+     * FFTW_FORWARD.
+     */
+    using fft_fn_t = std::function<void(std::complex<float>* data)>;
+
+    virtual ~rx_spectrum_streamer() = 0;
+
+    //! Return the number of bins per frame
+    virtual size_t get_fft_size() const = 0;
+
+    /*! Receive the next spectrum that is not skipped
+     *
+     * \param buff Buffer for get_fft_size() power values
+     * \param metadata Returns the time of the first sample that went into the
+     *        frame (for exponential averages, that of the newest window), or
+     *        the error that ended receiving
+     * \param timeout Time in seconds to wait for the frame
+     * \returns get_fft_size() if a frame was received, or 0 on errors. On a
+     *          timeout, the error code is ERROR_CODE_TIMEOUT.
+     */
+    virtual size_t recv_frame(
+        float* buff, rx_metadata_t& metadata, const double timeout = 0.1) = 0;
+
+    //! Number of frames that were skipped to reduce the frame rate
+    virtual uint64_t get_num_frames_skipped() const = 0;
+
+    //! Number of overflows, each of which restarted the average
+    virtual uint64_t get_num_overflows() const = 0;
+
+    /*! Create a spectrum streamer
+     *
+     * \param rx_stream The streamer to receive from. It must have one channel,
+     *        and the CPU format fc32.
+     * \param rate The sample rate of the streamer (Hz)
+     * \param args Options:
+     *        - fft_size: The number of bins. Defaults to 1024. Without \p fft,
+     *          this must be a power of two.
+     *        - window: hann (default), hamming, blackman_harris, or rect.
+     *        - overlap: The fraction of a window that overlaps with the next
+     *          one, at least 0 and less than 1. Defaults to 0.5.
+     *        - averaging: block (default) or exp.
+     *        - num_avg: The number of windows to average. Defaults to 8.
+     *        - decim: Return only one in this many frames. Defaults to 1.
+     *        - max_frame_rate: Return at most this many frames per second.
+     *          Defaults to 0, which means no limit.
+     *        - log: Set to 1 to return the powers in dB.
+     *        - shift: Set to 0 to return the bins in natural order, with DC
+     *          first.
+     * \param fft The FFT to use, e.g., one that calls an optimized library.
+     *        Defaults to a built-in radix-2 FFT.
+     * \throws uhd::value_error if the streamer has more than one channel, or
+     *         the arguments are invalid
+     */
+    static sptr make(rx_streamer::sptr rx_stream,
+        const double rate,
+        const uhd::device_addr_t& args = uhd::device_addr_t(),
+        fft_fn_t fft                   = nullptr);
+};
+
+} // namespace uhd
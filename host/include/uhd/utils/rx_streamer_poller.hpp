@@ -0,0 +1,97 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace uhd {
+
+/*! Wait for data on many RX streamers at once
+ *
+ * rx_streamer::recv() blocks on a single streamer, so servicing many
+ * independent streamers takes a thread per streamer. The poller instead
+ * returns the streamers that have data, so a few threads can service them
+ * all, like select() or epoll() do for sockets.
+ *
+ * A streamer returned by wait() is handed out to one caller only, and
+ * wait() doesn't return it again until that caller calls release(). The
+ * caller receives from it until recv() with timeout 0 returns no more
+ * samples, and then releases it:
+ *
+ * \code{.cpp}
+ * for (auto& rx_stream : poller->wait(0.1)) {
+ *     while (rx_stream->recv(buffs, nsamps, md, 0.0) > 0) {
+ *         // process the samples
+ *     }
+ *     poller->release(rx_stream);
+ * }
+ * \endcode
+ *
+ * If a packet arrives while the streamer is handed out, the streamer is ready
+ * again as soon as it is released, so no data is missed between the last
+ * recv() and release(). Streamers can occasionally be returned without data,
+ * recv() then times out right away.
+ *
+ * This relies on rx_streamer::set_recv_ready_callback(), i.e., the packets
+ * need to be received by an I/O thread (the recv_offload stream arg, or
+ * DPDK). The poller owns the callbacks of its streamers. All methods are
+ * thread-safe.
+ */
+class UHD_API rx_streamer_poller : uhd::noncopyable
+{
+public:
+    using sptr = std::shared_ptr<rx_streamer_poller>;
+
+    virtual ~rx_streamer_poller() = 0;
+
+    /*! Add a streamer
+     *
+     * The streamer counts as ready until it is first returned by wait(),
+     * because it may already hold data.
+     *
+     * \throws uhd::not_implemented_error if the streamer can't notify about
+     *         received packets
+     * \throws uhd::value_error if the streamer was already added
+     */
+    virtual void add(rx_streamer::sptr rx_stream) = 0;
+
+    /*! Remove a streamer
+     *
+     * Does nothing if the streamer was not added. Once this returns, the
+     * poller holds no reference to the streamer any more.
+     */
+    virtual void remove(rx_streamer::sptr rx_stream) = 0;
+
+    /*! Wait until at least one streamer is ready
+     *
+     * \param timeout Time in seconds to wait for a streamer
+     * \param max_streamers Return at most this many streamers, or all ready
+     *        streamers if 0. The order follows the arrival of the data.
+     * \returns The ready streamers, or an empty list on a timeout
+     */
+    virtual std::vector<rx_streamer::sptr> wait(
+        const double timeout = 0.1, const size_t max_streamers = 0) = 0;
+
+    /*! Hand back a streamer that was returned by wait()
+     *
+     * \throws uhd::value_error if the streamer was not added
+     */
+    virtual void release(rx_streamer::sptr rx_stream) = 0;
+
+    //! Return the number of streamers
+    virtual size_t size() const = 0;
+
+    //! Create an empty poller
+    static sptr make();
+};
+
+} // namespace uhd
@@ -0,0 +1,62 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace uhd { namespace sc16_codec {
+
+/*! Lossless compression of 16-bit samples by bit packing
+ *
+ * Captures of noise, or of signals well below full scale, only use a few of
+ * the 16 bits of each value. The codec splits the values (I and Q count as
+ * separate values) into groups of GROUP_SIZE, and stores each group with the
+ * fewest bits that hold all of its values as two's complement numbers. This
+ * is block floating point without any loss: the bit width of a group works as
+ * its exponent, and the values are its mantissas.
+ *
+ * A group is stored as one byte with the bit width (0 to 16), followed by the
+ * values, packed LSB first into ceil(n * width / 8) bytes. The last group can
+ * hold fewer than GROUP_SIZE values. A group of zeros takes a single byte.
+ *
+ * Decoding returns exactly the values that were encoded. The encoded data
+ * doesn't depend on the byte order of the host.
+ */
+
+//! The number of values that share a bit width
+constexpr size_t GROUP_SIZE = 64;
+
+/*! Return the largest number of bytes encode() can write for \p num_values
+ *  values
+ */
+UHD_API size_t get_max_encoded_size(const size_t num_values);
+
+/*! Encode values
+ *
+ * \param in The values, e.g. the interleaved I and Q of sc16 samples
+ * \param num_values The number of values (twice the number of sc16 samples)
+ * \param out The buffer for the encoded data, which must have room for
+ *            get_max_encoded_size() bytes
+ * \return the number of bytes written to \p out
+ */
+UHD_API size_t encode(const int16_t* in, const size_t num_values, uint8_t* out);
+
+/*! Decode values
+ *
+ * \param in The encoded data
+ * \param size The number of bytes available at \p in
+ * \param num_values The number of values to decode, as passed to encode()
+ * \param out The buffer for the values
+ * \return the number of bytes of \p in that were decoded
+ * \throws uhd::value_error if the data is truncated or corrupt
+ */
+UHD_API size_t decode(
+    const uint8_t* in, const size_t size, const size_t num_values, int16_t* out);
+
+}} // namespace uhd::sc16_codec
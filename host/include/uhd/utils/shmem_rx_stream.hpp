@@ -0,0 +1,104 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace uhd {
+
+/*! Share one RX stream with other processes through shared memory
+ *
+ * Only one process can stream from a device. The publisher lets any number of
+ * other processes (and the publishing process itself) read the same RX
+ * stream: It receives from an RX streamer in a thread of its own, straight
+ * into a ring of packets in a shared memory region, so the samples are
+ * converted once, and never pass through a socket. The clients read the
+ * packets out of the ring with a shmem_rx_streamer, which is a regular
+ * uhd::rx_streamer.
+ *
+ * The ring is a broadcast ring: The publisher never waits for the clients.
+ * A client that falls more than a ring's worth of packets behind misses the
+ * packets that were overwritten, and gets an overflow error from recv(), like
+ * it would when the device overruns. Clients don't see each other.
+ *
+ * Clients find the publisher by its name. They get the shared memory region
+ * (a memfd) from the publisher over a Unix socket, and are woken up by a
+ * futex when a packet comes in.
+ *
+ * The publisher doesn't issue stream commands, and clients can't either: The
+ * process that owns the device also owns the stream (see the uhd_stream_server
+ * utility for a process that does nothing else).
+ *
+ * Shared memory streams are only available on Linux.
+ */
+class UHD_API shmem_rx_publisher : uhd::noncopyable
+{
+public:
+    using sptr = std::shared_ptr<shmem_rx_publisher>;
+
+    //! Default number of packets in the ring
+    static constexpr size_t DEFAULT_NUM_PACKETS = 256;
+
+    virtual ~shmem_rx_publisher() = 0;
+
+    //! Return the name clients attach with
+    virtual std::string get_name() const = 0;
+
+    //! Return the number of packets published so far (excluding errors)
+    virtual uint64_t get_num_packets() const = 0;
+
+    /*! Create a publisher, and start receiving
+     *
+     * The publisher receives until it is destroyed, even without clients, so
+     * the streamer doesn't overrun. Clients that are attached at that point
+     * time out in recv() once they've read everything.
+     *
+     * \param rx_stream The streamer to receive from. Nothing else may receive
+     *        from it while the publisher exists.
+     * \param cpu_format The CPU format of the streamer (e.g., "fc32")
+     * \param rate The sample rate of the stream. Used to compute the time of
+     *        the samples when a client reads part of a packet.
+     * \param name The name of the stream. Clients attach with the same name.
+     * \param num_packets The number of packets in the ring
+     * \throws uhd::key_error if another publisher has the same name
+     * \throws uhd::not_implemented_error on platforms other than Linux
+     */
+    static sptr make(rx_streamer::sptr rx_stream,
+        const std::string& cpu_format,
+        const double rate,
+        const std::string& name,
+        const size_t num_packets = DEFAULT_NUM_PACKETS);
+};
+
+//! Reads the RX stream of a shmem_rx_publisher, possibly in another process
+class UHD_API shmem_rx_streamer
+{
+public:
+    /*! Attach to a publisher
+     *
+     * The streamer reads the packets published from now on. Every call to
+     * recv() returns samples from one packet at most. issue_stream_cmd() is
+     * ignored, the publisher owns the stream.
+     *
+     * \param name The name of the publisher
+     * \param cpu_format The CPU format the caller expects. If it's not empty,
+     *        it has to match the format of the publisher.
+     * \throws uhd::io_error if there is no publisher with that name
+     * \throws uhd::value_error if the CPU formats don't match
+     * \throws uhd::not_implemented_error on platforms other than Linux
+     */
+    static rx_streamer::sptr make(
+        const std::string& name, const std::string& cpu_format = "");
+};
+
+} // namespace uhd
@@ -0,0 +1,123 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/types/time_spec.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uhd {
+
+/*! Record the samples of an RX streamer as SigMF recordings
+ *
+ * This records like uhd::rx_recorder (receiving and writing happen on
+ * separate threads), but writes one SigMF recording per channel: the samples
+ * go to <path>.sigmf-data, and the metadata to <path>.sigmf-meta, which is
+ * written when the recording is stopped.
+ *
+ * A new capture segment starts with the recording, after every overrun, at
+ * every start of burst, and at every frequency change. Capture segments hold
+ * the device time of their first sample (uhd:full_secs and uhd:frac_secs), if
+ * the streamer provides it. Overruns are also marked by an annotation, starting
+ * at the first sample after the samples that were lost.
+ *
+ * To find samples by device time in long recordings without reading the
+ * metadata, a binary time index is written along with the samples. It maps the
+ * device time of the first sample of every block and capture segment to the
+ * sample number, see find_sample(). All its fields are little-endian:
+ * - Header: "UHDTIDX" and a 0 byte, a uint32_t version (1), a uint32_t entry
+ *   size (16), and the sample rate as a double.
+ * - Entries, sorted by time: the time in nanoseconds (int64_t) and the sample
+ *   number (uint64_t).
+ */
+class UHD_API sigmf_recorder : uhd::noncopyable
+{
+public:
+    using sptr = std::shared_ptr<sigmf_recorder>;
+
+    virtual ~sigmf_recorder() = 0;
+
+    //! Start receiving and writing samples. Can only be called once.
+    virtual void start() = 0;
+
+    /*! Stop receiving, wait until all samples were written, and write the
+     *  metadata files
+     *
+     * \throws uhd::os_error if writing a file failed
+     * \throws uhd::io_error if the streamer reported an error
+     */
+    virtual void stop() = 0;
+
+    //! Returns false once the recorder was stopped, or stopped itself on an error
+    virtual bool is_running() const = 0;
+
+    //! Number of samples per channel received so far
+    virtual uint64_t get_num_samps_recorded() const = 0;
+
+    //! Number of overruns reported by the streamer so far
+    virtual size_t get_num_overflows() const = 0;
+
+    /*! Note a frequency change of a channel
+     *
+     * The new capture segment starts at the sample that is being received
+     * when this is called. Call this before start() to set the frequency of
+     * the first capture segment.
+     */
+    virtual void set_frequency(const double freq, const size_t chan) = 0;
+
+    /*! Note a timed frequency change of a channel
+     *
+     * The new capture segment starts at the sample received at \p time.
+     */
+    virtual void set_frequency(
+        const double freq, const uhd::time_spec_t& time, const size_t chan) = 0;
+
+    /*! Create a recorder
+     *
+     * Existing files are overwritten.
+     *
+     * \param rx_stream The streamer to receive from
+     * \param cpu_format The CPU format of the streamer ("fc64", "fc32", "sc16"
+     *                   or "sc8")
+     * \param paths The recording of every channel, without extension
+     * \param rate The sample rate of the streamer
+     * \param args Options:
+     *        - block_size, num_blocks, direct_io: See uhd::rx_recorder::make()
+     *        - index_path: The time index. Defaults to the first path with a
+     *          ".uhd-tidx" suffix.
+     *        - description, author, hw: Go into the global metadata
+     * \throws uhd::value_error if the arguments are invalid
+     * \throws uhd::os_error if a file can't be opened
+     */
+    static sptr make(rx_streamer::sptr rx_stream,
+        const std::string& cpu_format,
+        const std::vector<std::string>& paths,
+        const double rate,
+        const uhd::device_addr_t& args = uhd::device_addr_t());
+
+    /*! Find the sample that was received at a given device time
+     *
+     * This does a binary search on a time index. Times within a gap (samples
+     * that were lost) map to the first sample after the gap.
+     *
+     * \param index_path The time index of a recording
+     * \param time Device time
+     * \return the sample number, counted from the start of the recording
+     * \throws uhd::os_error if the time index can't be read
+     * \throws uhd::value_error if \p time is before the start of the recording
+     */
+    static uint64_t find_sample(
+        const std::string& index_path, const uhd::time_spec_t& time);
+};
+
+} // namespace uhd
@@ -0,0 +1,97 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/types/time_spec.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uhd {
+
+/*! Play sample files through a TX streamer
+ *
+ * Reading a file from the thread that calls send() means that every page
+ * cache miss turns into an underrun. The player memory-maps the files, and a
+ * worker thread reads ahead of the streamer, converting the samples into
+ * blocks of the CPU format of the streamer. The thread that calls send() only
+ * sends blocks that are ready.
+ *
+ * There is one file per channel, each holding the samples of that channel
+ * only. If the files differ in size, the shortest one determines how many
+ * samples are played. The file format may differ from the CPU format of the
+ * streamer, both can be "fc64", "fc32", "sc16" or "sc8". When converting
+ * between floating point and integer formats, full scale is 1.0.
+ *
+ * All samples are sent as one burst, with an end of burst at the end of the
+ * files (or when the player is stopped). A send() call that times out is
+ * retried until the player is stopped, so a timed start may be any time in the
+ * future.
+ */
+class UHD_API tx_player : uhd::noncopyable
+{
+public:
+    using sptr = std::shared_ptr<tx_player>;
+
+    virtual ~tx_player() = 0;
+
+    //! Start sending the samples right away. A player can only be started once.
+    virtual void start() = 0;
+
+    //! Start sending the samples at \p time
+    virtual void start(const uhd::time_spec_t& time) = 0;
+
+    //! Stop sending, and end the burst
+    virtual void stop() = 0;
+
+    /*! Wait for the player to send all samples
+     *
+     * When looping, this only returns once the player was stopped.
+     *
+     * \param timeout Timeout in seconds
+     * \return true if the player is done, false on a timeout
+     */
+    virtual bool wait_done(const double timeout) = 0;
+
+    //! Number of samples per channel sent so far
+    virtual uint64_t get_num_samps_sent() const = 0;
+
+    /*! Number of times the streaming thread had to wait for the worker thread
+     *
+     * If this keeps growing, the files can't be read or converted fast enough,
+     * and the streamer will underrun.
+     */
+    virtual size_t get_num_stalls() const = 0;
+
+    /*! Create a player
+     *
+     * \param tx_stream The streamer to send to
+     * \param cpu_format The CPU format of the streamer (e.g., "fc32")
+     * \param paths One file per channel of the streamer
+     * \param args Options:
+     *        - file_format: The format of the files. Defaults to \p cpu_format.
+     *        - block_size: Samples per channel per block. Defaults to the
+     *          maximum number of samples per packet of the streamer.
+     *        - num_blocks: Number of blocks that are converted ahead of the
+     *          streamer. Defaults to 64.
+     *        - loop: Set to 1 to restart at the beginning of the files when
+     *          their end is reached, until the player is stopped.
+     * \throws uhd::value_error if the arguments are invalid
+     * \throws uhd::os_error if a file can't be mapped
+     */
+    static sptr make(tx_streamer::sptr tx_stream,
+        const std::string& cpu_format,
+        const std::vector<std::string>& paths,
+        const uhd::device_addr_t& args = uhd::device_addr_t());
+};
+
+} // namespace uhd
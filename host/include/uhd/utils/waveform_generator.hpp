@@ -0,0 +1,78 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace uhd {
+
+/*! Synthesize test waveforms at high sample rates
+ *
+ * A generator writes the samples of a waveform straight into the buffers that
+ * are passed to send(), without a table lookup per sample. Tones are computed
+ * with an oscillator that runs in several independent lanes, which the
+ * compiler vectorizes, and that is realigned to a phase kept in double
+ * precision at the start of every block of samples. The waveform is
+ * continuous across calls to generate().
+ *
+ * The following waveform types are supported:
+ * - CONST: I = ampl, Q = 0.
+ * - SQUARE: I toggles between 0 and ampl at \p freq, Q = 0.
+ * - RAMP: I ramps from -ampl to ampl at \p freq, Q = 0.
+ * - SINE: A complex tone at \p freq.
+ * - CHIRP: A complex tone whose frequency sweeps linearly from \p start_freq
+ *   to \p stop_freq in \p period seconds, and then starts over.
+ * - MULTITONE: Complex tones at each of \p freqs, with phases chosen to keep
+ *   the crest factor low, which together have a peak amplitude of ampl.
+ * - NOISE: I and Q uniformly distributed in [-ampl, ampl).
+ */
+class UHD_API waveform_generator : uhd::noncopyable
+{
+public:
+    using sptr = std::shared_ptr<waveform_generator>;
+
+    virtual ~waveform_generator() = 0;
+
+    //! Fill \p buff with the next \p nsamps samples of the waveform
+    virtual void generate(std::complex<float>* buff, const size_t nsamps) = 0;
+
+    //! Fill \p buff with the next \p nsamps samples, with full scale at 32767
+    virtual void generate(std::complex<int16_t>* buff, const size_t nsamps) = 0;
+
+    //! Restart the waveform from its beginning
+    virtual void reset() = 0;
+
+    //! Return the average power of the waveform in dBFS
+    virtual double get_power() const = 0;
+
+    /*! Create a generator
+     *
+     * \param wave_type The waveform type, see above (e.g., "SINE")
+     * \param samp_rate The sample rate in Hz
+     * \param args Options:
+     *        - ampl: The amplitude, full scale is 1.0. Defaults to 0.3.
+     *        - freq: The frequency in Hz for SQUARE, RAMP and SINE.
+     *        - start_freq, stop_freq, period: The sweep of CHIRP. The
+     *          frequencies default to -freq and freq, the period to 1 ms.
+     *        - freqs: The tone frequencies in Hz of MULTITONE, separated by
+     *          colons (e.g., "freqs=-1e6:2e6:5e6").
+     *        - seed: The seed of the NOISE generator.
+     * \throws uhd::value_error if the type is unknown, or a frequency is
+     *         outside of the Nyquist zone
+     */
+    static sptr make(const std::string& wave_type,
+        const double samp_rate,
+        const uhd::device_addr_t& args = uhd::device_addr_t());
+};
+
+} // namespace uhd
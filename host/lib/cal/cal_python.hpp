@@ -123,7 +123,11 @@ void export_cal(py::module& m)
             &pwr_cal::get_gain,
             py::arg("power_dbm"),
             py::arg("freq"),
-            py::arg("temperature") = boost::optional<int>());
+            py::arg("temperature") = boost::optional<int>())
+        .def("set_lookup_grid",
+            &pwr_cal::set_lookup_grid,
+            py::arg("num_freq_points"),
+            py::arg("num_gain_points"));
 }
 
 #endif /* INCLUDED_UHD_CAL_PYTHON_HPP */
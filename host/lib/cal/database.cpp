@@ -11,9 +11,13 @@
 #include <uhd/utils/static.hpp>
 #include <cmrc/cmrc.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <array>
 #include <ctime>
 #include <fstream>
+#include <map>
+#include <mutex>
 #include <tuple>
 #include <vector>
 
@@ -33,6 +37,74 @@ constexpr char CAL_EXT[] = ".cal";
 // we first load it entirely into heap space, and then deserialize it from there.
 constexpr size_t CALDATA_MAX_SIZE = 10 * 1024 * 1024; // 10 MiB
 
+/******************************************************************************
+ * Data views
+ *****************************************************************************/
+//! View of data that is owned by the view itself
+class vector_view : public cal_data_view
+{
+public:
+    vector_view(std::vector<uint8_t>&& data) : _data(std::move(data)) {}
+
+    const uint8_t* data() const override
+    {
+        return _data.data();
+    }
+
+    size_t size() const override
+    {
+        return _data.size();
+    }
+
+private:
+    const std::vector<uint8_t> _data;
+};
+
+//! View of data compiled into UHD, which stays valid forever
+class rc_view : public cal_data_view
+{
+public:
+    rc_view(const cmrc::file& file) : _file(file) {}
+
+    const uint8_t* data() const override
+    {
+        return reinterpret_cast<const uint8_t*>(_file.cbegin());
+    }
+
+    size_t size() const override
+    {
+        return _file.size();
+    }
+
+private:
+    const cmrc::file _file;
+};
+
+//! View of a memory-mapped file
+class file_view : public cal_data_view
+{
+public:
+    file_view(const std::string& path)
+        : _mapping(path.c_str(), boost::interprocess::read_only)
+        , _region(_mapping, boost::interprocess::read_only)
+    {
+    }
+
+    const uint8_t* data() const override
+    {
+        return static_cast<const uint8_t*>(_region.get_address());
+    }
+
+    size_t size() const override
+    {
+        return _region.get_size();
+    }
+
+private:
+    boost::interprocess::file_mapping _mapping;
+    boost::interprocess::mapped_region _region;
+};
+
 /******************************************************************************
  * RC implementation
  *****************************************************************************/
@@ -66,6 +138,17 @@ std::vector<uint8_t> get_cal_data_rc(const std::string& key, const std::string&)
     }
 }
 
+//! Return a view of a given cal resource
+cal_data_view::sptr map_cal_data_rc(const std::string& key, const std::string&)
+{
+    try {
+        auto fs = rc::get_filesystem();
+        return std::make_shared<rc_view>(fs.open(get_cal_path_rc(key)));
+    } catch (const std::system_error&) {
+        throw uhd::key_error(std::string("Unable to open resource with key: ") + key);
+    }
+}
+
 /******************************************************************************
  * Filesystem implementation
  *****************************************************************************/
@@ -153,6 +236,72 @@ std::vector<uint8_t> get_cal_data_fs(const std::string& key, const std::string&
     return result;
 }
 
+//! Cache of the views of mapped files, shared by all devices in this process
+struct fs_view_cache_t
+{
+    struct entry_t
+    {
+        cal_data_view::sptr view;
+        std::time_t mtime;
+        size_t size;
+    };
+
+    std::mutex mutex;
+    std::map<std::pair<std::string /* key */, std::string /* serial */>, entry_t>
+        entries;
+};
+UHD_SINGLETON_FCN(fs_view_cache_t, get_fs_view_cache);
+
+//! Return a view of a given filesystem resource
+cal_data_view::sptr map_cal_data_fs(const std::string& key, const std::string& serial)
+{
+    if (!has_cal_data_fs(key, serial)) {
+        throw uhd::key_error(
+            std::string("Cannot find cal file for key=") + key + ", serial=" + serial);
+    }
+    const auto cal_file_path =
+        fs::path(uhd::get_cal_data_path()) / get_cal_path_fs(key, serial);
+    const size_t filesize = fs::file_size(cal_file_path);
+    if (filesize > CALDATA_MAX_SIZE) {
+        throw uhd::key_error(
+            std::string("The following cal data file exceeds maximum size limitations: ")
+            + cal_file_path.string());
+    }
+    const std::time_t mtime = fs::last_write_time(cal_file_path);
+
+    auto& cache = get_fs_view_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto& entry = cache.entries[{key, serial}];
+    if (entry.view && entry.mtime == mtime && entry.size == filesize) {
+        UHD_LOG_TRACE(LOG_ID, "Using cached mapping of " << cal_file_path);
+        return entry.view;
+    }
+    UHD_LOG_TRACE(LOG_ID, "Mapping " << filesize << " bytes from " << cal_file_path);
+    try {
+        // Empty regions can't be mapped
+        entry.view = (filesize == 0)
+                         ? cal_data_view::sptr(
+                             std::make_shared<vector_view>(std::vector<uint8_t>()))
+                         : cal_data_view::sptr(
+                             std::make_shared<file_view>(cal_file_path.string()));
+    } catch (const boost::interprocess::interprocess_exception& ex) {
+        cache.entries.erase({key, serial});
+        throw uhd::key_error(std::string("Unable to map cal file ")
+                             + cal_file_path.string() + ": " + ex.what());
+    }
+    entry.mtime = mtime;
+    entry.size  = filesize;
+    return entry.view;
+}
+
+//! Drop a filesystem resource from the cache of views
+void forget_cal_data_fs(const std::string& key, const std::string& serial)
+{
+    auto& cache = get_fs_view_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.entries.erase({key, serial});
+}
+
 } // namespace
 
 /******************************************************************************
@@ -187,19 +336,27 @@ std::vector<uint8_t> get_cal_data_flash(const std::string& key, const std::strin
         std::string("Cannot find flash cal data for key=") + key + ", serial=" + serial);
 }
 
+// Flash data is only available as a copy, so we don't cache it
+cal_data_view::sptr map_cal_data_flash(const std::string& key, const std::string& serial)
+{
+    return std::make_shared<vector_view>(get_cal_data_flash(key, serial));
+}
+
 
 /******************************************************************************
  * Function lookup
  *****************************************************************************/
 typedef bool (*has_cal_data_fn)(const std::string&, const std::string&);
 typedef std::vector<uint8_t> (*get_cal_data_fn)(const std::string&, const std::string&);
-typedef std::tuple<source, has_cal_data_fn, get_cal_data_fn> cal_data_fn_tuple;
+typedef cal_data_view::sptr (*map_cal_data_fn)(const std::string&, const std::string&);
+typedef std::tuple<source, has_cal_data_fn, get_cal_data_fn, map_cal_data_fn>
+    cal_data_fn_tuple;
 // These are in order of priority!
 // clang-format off
 constexpr std::array<cal_data_fn_tuple, 3> data_fns{{
-    cal_data_fn_tuple{source::FILESYSTEM, &has_cal_data_fs,    &get_cal_data_fs   },
-    cal_data_fn_tuple{source::FLASH,      &has_cal_data_flash, &get_cal_data_flash},
-    cal_data_fn_tuple{source::RC,         &has_cal_data_rc,    &get_cal_data_rc   }
+    cal_data_fn_tuple{source::FILESYSTEM, &has_cal_data_fs,    &get_cal_data_fs,    &map_cal_data_fs   },
+    cal_data_fn_tuple{source::FLASH,      &has_cal_data_flash, &get_cal_data_flash, &map_cal_data_flash},
+    cal_data_fn_tuple{source::RC,         &has_cal_data_rc,    &get_cal_data_rc,    &map_cal_data_rc   }
 }};
 // clang-format on
 
@@ -224,6 +381,23 @@ std::vector<uint8_t> database::read_cal_data(
     throw uhd::key_error(err_msg);
 }
 
+cal_data_view::sptr database::map_cal_data(
+    const std::string& key, const std::string& serial, const source source_type)
+{
+    for (auto& data_fn : data_fns) {
+        if (source_type == source::ANY || source_type == std::get<0>(data_fn)) {
+            if (std::get<1>(data_fn)(key, serial)) {
+                return std::get<3>(data_fn)(key, serial);
+            }
+        }
+    }
+
+    const std::string err_msg =
+        std::string("Calibration Data not found for: key=") + key + ", serial=" + serial;
+    UHD_LOG_ERROR(LOG_ID, err_msg);
+    throw uhd::key_error(err_msg);
+}
+
 bool database::has_cal_data(
     const std::string& key, const std::string& serial, const source source_type)
 {
@@ -248,6 +422,10 @@ void database::write_cal_data(const std::string& key,
     const auto cal_file_path =
         (fs::path(uhd::get_cal_data_path()) / get_cal_path_fs(key, serial)).string();
 
+    // Existing views keep pointing at the old file, but new look-ups must see
+    // the new one even if its size and timestamp happen to match
+    forget_cal_data_fs(key, serial);
+
     if (fs::exists(cal_file_path)) {
         const auto ext = backup_ext.empty() ? std::to_string(time(NULL)) : backup_ext;
         const auto cal_file_path_backup = fs::path(uhd::get_cal_data_path())
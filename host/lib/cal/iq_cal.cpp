@@ -153,11 +153,16 @@ public:
     // necessary to call clear() ahead of time.
     void deserialize(const std::vector<uint8_t>& data)
     {
-        auto verifier = flatbuffers::Verifier(data.data(), data.size());
+        deserialize(data.data(), data.size());
+    }
+
+    void deserialize(const uint8_t* data, const size_t size)
+    {
+        auto verifier = flatbuffers::Verifier(data, size);
         if (!VerifyIQCalCoeffsBuffer(verifier)) {
             throw uhd::runtime_error("iq_cal: Invalid data provided!");
         }
-        auto cal_table = GetIQCalCoeffs(static_cast<const void*>(data.data()));
+        auto cal_table = GetIQCalCoeffs(static_cast<const void*>(data));
         // TODO we can handle this more nicely
         UHD_ASSERT_THROW(cal_table->metadata()->version_major() == VERSION_MAJOR);
         _name          = std::string(cal_table->metadata()->name()->c_str());
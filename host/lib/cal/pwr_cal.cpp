@@ -10,8 +10,10 @@
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/math.hpp>
 #include <uhdlib/utils/interpolation.hpp>
+#include <algorithm>
 #include <map>
 #include <string>
+#include <vector>
 
 using namespace uhd::usrp::cal;
 using namespace uhd::math;
@@ -39,6 +41,78 @@ map_type reverse_map(const map_type& map)
     return result;
 }
 
+//! Like at_nearest(), but returns an iterator instead of a copy of the value
+template <typename map_type>
+typename map_type::const_iterator find_nearest(
+    const map_type& data, const typename map_type::key_type& key)
+{
+    const auto iters = get_bounding_iterators(data, key);
+    return (iters.second->first - key < key - iters.first->first) ? iters.second
+                                                                   : iters.first;
+}
+
+/*! Uniformly spaced axis of a lookup grid
+ *
+ * Maps a coordinate to the index of the grid point below it, and the position
+ * between that point and the next one. Coordinates outside the axis are
+ * clamped to its ends.
+ */
+struct grid_axis_t
+{
+    grid_axis_t() = default;
+
+    grid_axis_t(const double start_, const double stop_, const size_t num_points_)
+        : start(start_)
+        , step((num_points_ > 1) ? (stop_ - start_) / (num_points_ - 1) : 0.0)
+        , inv_step((stop_ > start_) ? 1.0 / step : 0.0)
+        , num_points(num_points_)
+    {
+    }
+
+    double at(const size_t index) const
+    {
+        return start + step * index;
+    }
+
+    std::pair<size_t, double> locate(const double x) const
+    {
+        const double pos =
+            std::min(std::max((x - start) * inv_step, 0.0), double(num_points - 1));
+        const size_t index = std::min(static_cast<size_t>(pos), num_points - 2);
+        return {index, pos - index};
+    }
+
+    double start      = 0.0;
+    double step       = 0.0;
+    double inv_step   = 0.0;
+    size_t num_points = 0;
+};
+
+/*! Values sampled on a uniform two-dimensional grid
+ *
+ * The values are stored in one flat array, with all values for one x-value
+ * next to each other, so a look-up touches two short runs of memory.
+ */
+struct lookup_grid_t
+{
+    grid_axis_t x_axis;
+    grid_axis_t y_axis;
+    std::vector<double> values;
+
+    double at_bilin_interp(const double x, const double y) const
+    {
+        const auto x_pos   = x_axis.locate(x);
+        const auto y_pos   = y_axis.locate(y);
+        const size_t i     = y_pos.first;
+        const double t     = y_pos.second;
+        const double* row0 = values.data() + x_pos.first * y_axis.num_points;
+        const double* row1 = row0 + y_axis.num_points;
+        const double v0    = row0[i] + t * (row0[i + 1] - row0[i]);
+        const double v1    = row1[i] + t * (row1[i + 1] - row1[i]);
+        return v0 + x_pos.second * (v1 - v0);
+    }
+};
+
 } // namespace
 
 
@@ -89,6 +163,7 @@ public:
         const int temp    = bool(temperature) ? temperature.get() : _default_temp;
         _data[temp][static_cast<uint64_t>(freq)] = {
             gain_power_map, reverse_map(gain_power_map), min_power, max_power};
+        _grids.clear();
     }
 
     // Note: This is very similar to at_bilin_interp(), but we can't use that
@@ -99,6 +174,9 @@ public:
         const boost::optional<int> temperature = boost::none) const
     {
         UHD_ASSERT_THROW(!_data.empty());
+        if (!_grids.empty()) {
+            return _get_grids(temperature).g2p.at_bilin_interp(freq, gain);
+        }
         const uint64_t freqi = static_cast<uint64_t>(freq);
         const auto& table = _get_table(temperature);
 
@@ -137,6 +215,7 @@ public:
     void clear()
     {
         _data.clear();
+        _grids.clear();
     }
 
     void set_temperature(const int temperature)
@@ -162,7 +241,7 @@ public:
     uhd::meta_range_t get_power_limits(
         const double freq, const boost::optional<int> temperature = boost::none) const
     {
-        const auto table = at_nearest(_get_table(temperature), uint64_t(freq));
+        const auto& table = find_nearest(_get_table(temperature), uint64_t(freq))->second;
         return uhd::meta_range_t(table.min_power, table.max_power);
     }
 
@@ -171,6 +250,9 @@ public:
         const boost::optional<int> temperature = boost::none) const
     {
         UHD_ASSERT_THROW(!_data.empty());
+        if (!_grids.empty()) {
+            return _get_grids(temperature).p2g.at_bilin_interp(freq, power_dbm);
+        }
         const uint64_t freqi = static_cast<uint64_t>(freq);
         const auto& table = _get_table(temperature);
         const double power_coerced = get_power_limits(freq, temperature).clip(power_dbm);
@@ -220,6 +302,26 @@ public:
             freq, power_coerced, f1, pwr1, f2, pwr2, gain11, gain12, gain21, gain22);
     }
 
+    void set_lookup_grid(const size_t num_freq_points, const size_t num_gain_points)
+    {
+        _grids.clear();
+        if (num_freq_points == 0 && num_gain_points == 0) {
+            return;
+        }
+        if (num_freq_points < 2 || num_gain_points < 2) {
+            throw uhd::value_error("pwr_cal: Lookup grids need at least 2 points "
+                                   "per axis!");
+        }
+        std::map<int, grids_t> grids;
+        for (const auto& temp_table : _data) {
+            grids[temp_table.first] =
+                _make_grids(temp_table.first, num_freq_points, num_gain_points);
+        }
+        // Only switch over once the grids are complete, the get_*() calls
+        // used to compute them must take the regular path
+        _grids = std::move(grids);
+    }
+
     /**************************************************************************
      * Container API (Serialization/Deserialization)
      *************************************************************************/
@@ -270,11 +372,16 @@ public:
     // necessary to call clear() ahead of time.
     void deserialize(const std::vector<uint8_t>& data)
     {
-        auto verifier = flatbuffers::Verifier(data.data(), data.size());
+        deserialize(data.data(), data.size());
+    }
+
+    void deserialize(const uint8_t* data, const size_t size)
+    {
+        auto verifier = flatbuffers::Verifier(data, size);
         if (!VerifyPowerCalBuffer(verifier)) {
             throw uhd::runtime_error("pwr_cal: Invalid data provided!");
         }
-        auto cal_table = GetPowerCal(static_cast<const void*>(data.data()));
+        auto cal_table = GetPowerCal(static_cast<const void*>(data));
         if (cal_table->metadata()->version_major() != VERSION_MAJOR) {
             throw uhd::runtime_error("pwr_cal: Compat number mismatch!");
         }
@@ -329,10 +436,60 @@ private:
 
     using freq_table_map = std::map<uint64_t /* freq */, pwr_cal_table>;
 
-    freq_table_map _get_table(const boost::optional<int> temperature) const
+    //! Lookup grids for one temperature
+    struct grids_t
+    {
+        lookup_grid_t g2p; //!< Power over frequency and gain
+        lookup_grid_t p2g; //!< Gain over frequency and power
+    };
+
+    const freq_table_map& _get_table(const boost::optional<int> temperature) const
+    {
+        UHD_ASSERT_THROW(!_data.empty());
+        const int temp = bool(temperature) ? temperature.get() : _default_temp;
+        return find_nearest(_data, temp)->second;
+    }
+
+    const grids_t& _get_grids(const boost::optional<int> temperature) const
     {
         const int temp = bool(temperature) ? temperature.get() : _default_temp;
-        return at_nearest(_data, temp);
+        return find_nearest(_grids, temp)->second;
+    }
+
+    grids_t _make_grids(
+        const int temp, const size_t num_freq_points, const size_t num_gain_points) const
+    {
+        const freq_table_map& table = _data.at(temp);
+        double min_gain  = table.cbegin()->second.g2p.cbegin()->first;
+        double max_gain  = table.cbegin()->second.g2p.crbegin()->first;
+        double min_power = table.cbegin()->second.min_power;
+        double max_power = table.cbegin()->second.max_power;
+        for (const auto& freq_table : table) {
+            min_gain  = std::min(min_gain, freq_table.second.g2p.cbegin()->first);
+            max_gain  = std::max(max_gain, freq_table.second.g2p.crbegin()->first);
+            min_power = std::min(min_power, freq_table.second.min_power);
+            max_power = std::max(max_power, freq_table.second.max_power);
+        }
+        const grid_axis_t freq_axis(static_cast<double>(table.cbegin()->first),
+            static_cast<double>(table.crbegin()->first),
+            num_freq_points);
+
+        grids_t grids;
+        grids.g2p.x_axis = freq_axis;
+        grids.g2p.y_axis = grid_axis_t(min_gain, max_gain, num_gain_points);
+        grids.p2g.x_axis = freq_axis;
+        grids.p2g.y_axis = grid_axis_t(min_power, max_power, num_gain_points);
+        grids.g2p.values.reserve(num_freq_points * num_gain_points);
+        grids.p2g.values.reserve(num_freq_points * num_gain_points);
+        for (size_t f = 0; f < num_freq_points; f++) {
+            const double freq = freq_axis.at(f);
+            for (size_t i = 0; i < num_gain_points; i++) {
+                grids.g2p.values.push_back(
+                    get_power(grids.g2p.y_axis.at(i), freq, temp));
+                grids.p2g.values.push_back(get_gain(grids.p2g.y_axis.at(i), freq, temp));
+            }
+        }
+        return grids;
     }
 
     std::string _name;
@@ -343,6 +500,9 @@ private:
     std::map<int /* temp */, freq_table_map> _data;
     double _ref_gain  = 0.0;
     int _default_temp = NORMAL_TEMPERATURE;
+
+    //! Lookup grids for every temperature in _data, empty unless enabled
+    std::map<int /* temp */, grids_t> _grids;
 };
 
 
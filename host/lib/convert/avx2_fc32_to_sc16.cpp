@@ -0,0 +1,87 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+/*
+ * Convert 8 fc32 samples (16 floats) to interleaved, saturated sc16.
+ *
+ * _mm256_packs_epi32() packs within 128-bit lanes, which leaves the pairs of
+ * samples in the order 0, 2, 1, 3; the final permute puts them back in order.
+ */
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE __m256i fc32_x8_to_sc16(
+    const fc32_t* input, const __m256 scalar)
+{
+    const __m256 tmplo = _mm256_loadu_ps(reinterpret_cast<const float*>(input + 0));
+    const __m256 tmphi = _mm256_loadu_ps(reinterpret_cast<const float*>(input + 4));
+
+    const __m256i tmpilo = _mm256_cvtps_epi32(_mm256_mul_ps(tmplo, scalar));
+    const __m256i tmpihi = _mm256_cvtps_epi32(_mm256_mul_ps(tmphi, scalar));
+
+    const __m256i tmpi = _mm256_packs_epi32(tmpilo, tmpihi);
+    return _mm256_permute4x64_epi64(tmpi, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+DECLARE_CONVERTER_FOR_CPU(fc32, 1, sc16_item32_le, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const __m256 scalar = _mm256_set1_ps(float(scale_factor));
+    const __m256i shuf  =
+        _mm256_broadcastsi128_si256(_mm_set_epi8(SC16_SWAP_PAIRS_SHUFFLE));
+
+    size_t i = 0;
+    for (; i + 7 < nsamps; i += 8) {
+        const __m256i tmpi =
+            _mm256_shuffle_epi8(fc32_x8_to_sc16(input + i, scalar), shuf);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), tmpi);
+    }
+
+    // convert any remaining samples
+    xx_to_item32_sc16<uhd::htowx>(input + i, output + i, nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(fc32, 1, sc16_item32_be, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const __m256 scalar = _mm256_set1_ps(float(scale_factor));
+    const __m256i shuf  =
+        _mm256_broadcastsi128_si256(_mm_set_epi8(SC16_SWAP_BYTES_SHUFFLE));
+
+    size_t i = 0;
+    for (; i + 7 < nsamps; i += 8) {
+        const __m256i tmpi =
+            _mm256_shuffle_epi8(fc32_x8_to_sc16(input + i, scalar), shuf);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), tmpi);
+    }
+
+    // convert any remaining samples
+    xx_to_item32_sc16<uhd::htonx>(input + i, output + i, nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(fc32, 1, sc16_chdr, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    sc16_t* output      = reinterpret_cast<sc16_t*>(outputs[0]);
+
+    const __m256 scalar = _mm256_set1_ps(float(scale_factor));
+
+    size_t i = 0;
+    for (; i + 7 < nsamps; i += 8) {
+        const __m256i tmpi = fc32_x8_to_sc16(input + i, scalar);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), tmpi);
+    }
+
+    // convert any remaining samples
+    xx_to_chdr_sc16(input + i, output + i, nsamps - i, scale_factor);
+}
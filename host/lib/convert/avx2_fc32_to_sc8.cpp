@@ -0,0 +1,79 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+// Reverses the bytes in each item32, which turns the sc8_item32_be order
+// (I0, Q0, I1, Q1, ...) into sc8_item32_le
+#define SC8_ITEM32_BSWAP_SHUFFLE 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3
+
+/*
+ * Convert 16 fc32 samples (32 floats) to saturated sc8, in I0, Q0, I1, Q1, ...
+ * byte order.
+ *
+ * The pack instructions operate within 128-bit lanes, which leaves the item32s
+ * interleaved between the two lanes. The final permute restores their order.
+ */
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE __m256i fc32_x16_to_sc8(
+    const fc32_t* input, const __m256 scalar)
+{
+    const __m256 tmp0 = _mm256_loadu_ps(reinterpret_cast<const float*>(input + 0));
+    const __m256 tmp1 = _mm256_loadu_ps(reinterpret_cast<const float*>(input + 4));
+    const __m256 tmp2 = _mm256_loadu_ps(reinterpret_cast<const float*>(input + 8));
+    const __m256 tmp3 = _mm256_loadu_ps(reinterpret_cast<const float*>(input + 12));
+
+    const __m256i tmpi0 = _mm256_cvtps_epi32(_mm256_mul_ps(tmp0, scalar));
+    const __m256i tmpi1 = _mm256_cvtps_epi32(_mm256_mul_ps(tmp1, scalar));
+    const __m256i tmpi2 = _mm256_cvtps_epi32(_mm256_mul_ps(tmp2, scalar));
+    const __m256i tmpi3 = _mm256_cvtps_epi32(_mm256_mul_ps(tmp3, scalar));
+
+    const __m256i lo   = _mm256_packs_epi32(tmpi0, tmpi1);
+    const __m256i hi   = _mm256_packs_epi32(tmpi2, tmpi3);
+    const __m256i tmpi = _mm256_packs_epi16(lo, hi);
+
+    return _mm256_permutevar8x32_epi32(tmpi, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+DECLARE_CONVERTER_FOR_CPU(fc32, 1, sc8_item32_be, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const __m256 scalar = _mm256_set1_ps(float(scale_factor));
+
+    size_t i = 0;
+    for (size_t j = 0; i + 15 < nsamps; i += 16, j += 8) {
+        const __m256i tmpi = fc32_x16_to_sc8(input + i, scalar);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + j), tmpi);
+    }
+
+    // convert remainder
+    xx_to_item32_sc8<uhd::htonx>(input + i, output + (i / 2), nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(fc32, 1, sc8_item32_le, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const __m256 scalar = _mm256_set1_ps(float(scale_factor));
+    const __m256i shuf  =
+        _mm256_broadcastsi128_si256(_mm_set_epi8(SC8_ITEM32_BSWAP_SHUFFLE));
+
+    size_t i = 0;
+    for (size_t j = 0; i + 15 < nsamps; i += 16, j += 8) {
+        const __m256i tmpi =
+            _mm256_shuffle_epi8(fc32_x16_to_sc8(input + i, scalar), shuf);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + j), tmpi);
+    }
+
+    // convert remainder
+    xx_to_item32_sc8<uhd::htowx>(input + i, output + (i / 2), nsamps - i, scale_factor);
+}
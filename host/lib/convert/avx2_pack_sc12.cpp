@@ -0,0 +1,220 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_pack_sc12.hpp"
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+/*
+ * Shuffle Orderings - One 3 x 32-bit block per 128-bit lane
+ *
+ * Each sample is first combined into a single 24-bit value (I << 12) | Q,
+ * which is exactly the bit sequence the sample occupies in the block when the
+ * three lines are read MSB first. With the four samples of a block in the
+ * lower 24 bits of four 32-bit lanes, a byte shuffle emits the block in wire
+ * byte order.
+ *
+ *   24-bit packed samples
+ *  -------------------------------------------
+ * | 0 | I3 Q3 | 0 | I2 Q2 | 0 | I1 Q1 | 0 | I0 Q0 | Input
+ *  -------------------------------------------
+ * | 127                                     0 |
+ *
+ *     12-bit packed I/Q byteswapped
+ *      -----------------------
+ *     |   I0   |   Q0   |  I1 | 0
+ *     |-----------------------|
+ *     | I1 |  Q1  |  I2  | Q2 |             Output (Shuffle)
+ *     |-----------------------|
+ *     | Q2  |   I3   |   Q3   | 2
+ *      -----------------------
+ *     31                     0
+ */
+#define SC12_LE_PACK_SHUFFLE \
+    6, 0, 1, 2, 9, 10, 4, 5, 12, 13, 14, 8, -128, -128, -128, -128
+#define SC12_BE_PACK_SHUFFLE \
+    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -128, -128, -128, -128
+
+/*
+ * Convert 4 fc32 samples into 24-bit packed samples, which end up in the
+ * lower 128-bit lane
+ */
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE __m256i convert_fc32_4_to_sc24(
+    const fc32_t* input, const __m256 scalar)
+{
+    const __m256 m0 = _mm256_loadu_ps(reinterpret_cast<const float*>(input));
+
+    // Truncate like the generic converter does
+    __m256i m1 = _mm256_cvttps_epi32(_mm256_mul_ps(m0, scalar));
+    m1         = _mm256_and_si256(m1, _mm256_set1_epi32(0xfff));
+    m1         = _mm256_or_si256(_mm256_slli_epi64(m1, 12), _mm256_srli_epi64(m1, 32));
+
+    return _mm256_permutevar8x32_epi32(m1, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+}
+
+/*
+ * Convert 8 fc32 samples into two 3 x 32-bit blocks.
+ *
+ * Blocks are only 12 bytes long, so they are written with a masked store to
+ * avoid touching memory past the end of the second block.
+ */
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE void convert_fc32_8_to_sc12_item32_6(
+    const fc32_t* input, item32_sc12_3x* output, const __m256i shuf, const __m256 scalar)
+{
+    const __m256i lo = convert_fc32_4_to_sc24(input + 0, scalar);
+    const __m256i hi = convert_fc32_4_to_sc24(input + 4, scalar);
+
+    __m256i m0 = _mm256_permute2x128_si256(lo, hi, 0x20);
+    m0         = _mm256_shuffle_epi8(m0, shuf);
+
+    const __m128i mask = _mm_setr_epi32(-1, -1, -1, 0);
+    _mm_maskstore_epi32(
+        reinterpret_cast<int*>(output + 0), mask, _mm256_castsi256_si128(m0));
+    _mm_maskstore_epi32(
+        reinterpret_cast<int*>(output + 1), mask, _mm256_extracti128_si256(m0, 1));
+}
+
+template <towire32_type towire>
+struct convert_fc32_1_to_sc12_item32_1_avx2 : public converter
+{
+    convert_fc32_1_to_sc12_item32_1_avx2(void) : _scalar(0.0) {}
+
+    void set_scalar(const double scalar)
+    {
+        _scalar = scalar;
+    }
+
+    UHD_CONVERT_TARGET_AVX2 void operator()(
+        const input_type& inputs, const output_type& outputs, const size_t nsamps)
+    {
+        const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+
+        const size_t head_samps = size_t(outputs[0]) & 0x3;
+        int enable;
+        size_t rewind = 0;
+        switch (head_samps) {
+            case 0:
+                break;
+            case 1:
+                rewind = 9;
+                break;
+            case 2:
+                rewind = 6;
+                break;
+            case 3:
+                rewind = 3;
+                break;
+        }
+        item32_sc12_3x* output =
+            reinterpret_cast<item32_sc12_3x*>(size_t(outputs[0]) - rewind);
+
+        // helper variables
+        size_t i = 0, o = 0;
+
+        // handle the head case
+        switch (head_samps) {
+            case 0:
+                break; // no head
+            case 1:
+                enable = CONVERT12_LINE2;
+                convert_star_4_to_sc12_item32_3<float, towire>(
+                    0, 0, 0, input[0], enable, output[o++], _scalar);
+                break;
+            case 2:
+                enable = CONVERT12_LINE2 | CONVERT12_LINE1;
+                convert_star_4_to_sc12_item32_3<float, towire>(
+                    0, 0, input[0], input[1], enable, output[o++], _scalar);
+                break;
+            case 3:
+                enable = CONVERT12_LINE2 | CONVERT12_LINE1 | CONVERT12_LINE0;
+                convert_star_4_to_sc12_item32_3<float, towire>(
+                    0, input[0], input[1], input[2], enable, output[o++], _scalar);
+                break;
+        }
+        i += head_samps;
+
+        // convert the body, two blocks at a time
+        const __m256i shuf = _mm256_broadcastsi128_si256(
+            towire == uhd::wtohx<item32_t> ? _mm_setr_epi8(SC12_LE_PACK_SHUFFLE)
+                                           : _mm_setr_epi8(SC12_BE_PACK_SHUFFLE));
+        const __m256 scalar = _mm256_set1_ps(float(_scalar));
+        while (i + 7 < nsamps) {
+            convert_fc32_8_to_sc12_item32_6(&input[i], &output[o], shuf, scalar);
+            o += 2;
+            i += 8;
+        }
+        if (i + 3 < nsamps) {
+            convert_star_4_to_sc12_item32_3<float, towire>(input[i + 0],
+                input[i + 1],
+                input[i + 2],
+                input[i + 3],
+                CONVERT12_LINE_ALL,
+                output[o],
+                _scalar);
+            o++;
+            i += 4;
+        }
+
+        // handle the tail case
+        const size_t tail_samps = nsamps - i;
+        switch (tail_samps) {
+            case 0:
+                break; // no tail
+            case 1:
+                enable = CONVERT12_LINE0;
+                convert_star_4_to_sc12_item32_3<float, towire>(
+                    input[i + 0], 0, 0, 0, enable, output[o], _scalar);
+                break;
+            case 2:
+                enable = CONVERT12_LINE0 | CONVERT12_LINE1;
+                convert_star_4_to_sc12_item32_3<float, towire>(
+                    input[i + 0], input[i + 1], 0, 0, enable, output[o], _scalar);
+                break;
+            case 3:
+                enable = CONVERT12_LINE0 | CONVERT12_LINE1 | CONVERT12_LINE2;
+                convert_star_4_to_sc12_item32_3<float, towire>(input[i + 0],
+                    input[i + 1],
+                    input[i + 2],
+                    0,
+                    enable,
+                    output[o],
+                    _scalar);
+                break;
+        }
+    }
+
+    double _scalar;
+};
+
+static converter::sptr make_convert_fc32_1_to_sc12_item32_le_1(void)
+{
+    return converter::sptr(new convert_fc32_1_to_sc12_item32_1_avx2<uhd::wtohx>());
+}
+
+static converter::sptr make_convert_fc32_1_to_sc12_item32_be_1(void)
+{
+    return converter::sptr(new convert_fc32_1_to_sc12_item32_1_avx2<uhd::ntohx>());
+}
+
+UHD_STATIC_BLOCK(register_avx2_pack_sc12)
+{
+    if (!uhd_convert_cpu_has_AVX2()) {
+        return;
+    }
+
+    uhd::convert::id_type id;
+    id.num_inputs   = 1;
+    id.num_outputs  = 1;
+    id.input_format = "fc32";
+
+    id.output_format = "sc12_item32_le";
+    uhd::convert::register_converter(
+        id, &make_convert_fc32_1_to_sc12_item32_le_1, PRIORITY_SIMD_AVX2);
+    id.output_format = "sc12_item32_be";
+    uhd::convert::register_converter(
+        id, &make_convert_fc32_1_to_sc12_item32_be_1, PRIORITY_SIMD_AVX2);
+}
@@ -0,0 +1,132 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_sc4.hpp"
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+// Reverses the bytes in each item32, which turns the sc4_item32_be order of
+// samples into sc4_item32_le
+#define SC4_ITEM32_BSWAP_SHUFFLE 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3
+
+// Packs 8 sc16 samples into the lowest byte of each 32-bit lane
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE __m256i sc4_lanes_x8(
+    const sc16_t* input, const __m256)
+{
+    // Each lane holds Q in the upper and I in the lower 16 bits
+    const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input));
+    return _mm256_or_si256(
+        _mm256_and_si256(_mm256_srli_epi32(in, 8), _mm256_set1_epi32(0xF0)),
+        _mm256_srli_epi32(in, 28));
+}
+
+// Packs 8 fc32 samples into the lowest byte of each 32-bit lane
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE __m256i sc4_lanes_x8(
+    const fc32_t* input, const __m256 scalar)
+{
+    const __m256 min = _mm256_set1_ps(-8.f);
+    const __m256 max = _mm256_set1_ps(7.f);
+    const __m256 in0 = _mm256_loadu_ps(reinterpret_cast<const float*>(input + 0));
+    const __m256 in1 = _mm256_loadu_ps(reinterpret_cast<const float*>(input + 4));
+    const __m256i tmpi0 = _mm256_cvttps_epi32(
+        _mm256_max_ps(min, _mm256_min_ps(max, _mm256_mul_ps(in0, scalar))));
+    const __m256i tmpi1 = _mm256_cvttps_epi32(
+        _mm256_max_ps(min, _mm256_min_ps(max, _mm256_mul_ps(in1, scalar))));
+    // The pack operates within 128-bit lanes, the permute restores the order
+    // of the samples. Each lane then holds Q in the upper and I in the lower
+    // 16 bits.
+    const __m256i iq = _mm256_permute4x64_epi64(
+        _mm256_packs_epi32(tmpi0, tmpi1), _MM_SHUFFLE(3, 1, 2, 0));
+    return _mm256_or_si256(
+        _mm256_and_si256(_mm256_slli_epi32(iq, 4), _mm256_set1_epi32(0xF0)),
+        _mm256_and_si256(_mm256_srli_epi32(iq, 16), _mm256_set1_epi32(0x0F)));
+}
+
+/*
+ * Packs 32 samples in sc4_item32_be order.
+ *
+ * The pack instructions operate within 128-bit lanes, which leaves the item32s
+ * interleaved between the two lanes. The final permute restores their order.
+ */
+template <typename type>
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE __m256i pack_sc4_x32(
+    const std::complex<type>* input, const __m256 scalar)
+{
+    const __m256i tmpi0 = sc4_lanes_x8(input + 0, scalar);
+    const __m256i tmpi1 = sc4_lanes_x8(input + 8, scalar);
+    const __m256i tmpi2 = sc4_lanes_x8(input + 16, scalar);
+    const __m256i tmpi3 = sc4_lanes_x8(input + 24, scalar);
+
+    const __m256i lo   = _mm256_packs_epi32(tmpi0, tmpi1);
+    const __m256i hi   = _mm256_packs_epi32(tmpi2, tmpi3);
+    const __m256i tmpi = _mm256_packus_epi16(lo, hi);
+
+    return _mm256_permutevar8x32_epi32(tmpi, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+template <bool swap, typename type>
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE void avx2_pack_sc4(const std::complex<type>* input,
+    void* output,
+    const size_t nsamps,
+    const double scale_factor)
+{
+    const __m256 scalar = _mm256_set1_ps(float(scale_factor));
+    const __m256i shuf =
+        _mm256_broadcastsi128_si256(_mm_set_epi8(SC4_ITEM32_BSWAP_SHUFFLE));
+
+    // pack the samples up to the next item32 boundary one by one
+    size_t i = sc4_head_samps(output, nsamps);
+    pack_sc4<swap>(input, output, i, float(scale_factor));
+
+    uint8_t* out = reinterpret_cast<uint8_t*>(output);
+    for (; i + 31 < nsamps; i += 32) {
+        __m256i tmpi = pack_sc4_x32(input + i, scalar);
+        if (swap) {
+            tmpi = _mm256_shuffle_epi8(tmpi, shuf);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), tmpi);
+    }
+
+    // convert remainder
+    pack_sc4<swap>(input + i, out + i, nsamps - i, float(scale_factor));
+}
+
+DECLARE_CONVERTER_FOR_CPU(fc32, 1, sc4_item32_be, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    avx2_pack_sc4<false>(input, outputs[0], nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(fc32, 1, sc4_item32_le, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    avx2_pack_sc4<true>(input, outputs[0], nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(fc32, 1, sc4_chdr, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    avx2_pack_sc4<false>(input, outputs[0], nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16, 1, sc4_item32_be, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    avx2_pack_sc4<false>(input, outputs[0], nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16, 1, sc4_item32_le, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    avx2_pack_sc4<true>(input, outputs[0], nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16, 1, sc4_chdr, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    avx2_pack_sc4<false>(input, outputs[0], nsamps, scale_factor);
+}
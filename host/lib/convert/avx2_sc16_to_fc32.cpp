@@ -0,0 +1,87 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+/*
+ * Convert 8 interleaved sc16 samples to fc32, writing 16 floats to output.
+ * Unaligned loads and stores are used throughout, since they come at no extra
+ * cost on CPUs supporting AVX2 if the data happens to be aligned anyway.
+ */
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE void sc16_x8_to_fc32(
+    const __m256i in, fc32_t* output, const __m256 scalar)
+{
+    const __m256i tmpilo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(in));
+    const __m256i tmpihi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(in, 1));
+
+    const __m256 tmplo = _mm256_mul_ps(_mm256_cvtepi32_ps(tmpilo), scalar);
+    const __m256 tmphi = _mm256_mul_ps(_mm256_cvtepi32_ps(tmpihi), scalar);
+
+    _mm256_storeu_ps(reinterpret_cast<float*>(output + 0), tmplo);
+    _mm256_storeu_ps(reinterpret_cast<float*>(output + 4), tmphi);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16_item32_le, 1, fc32, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    fc32_t* output        = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    const __m256 scalar = _mm256_set1_ps(float(scale_factor));
+    const __m256i shuf  =
+        _mm256_broadcastsi128_si256(_mm_set_epi8(SC16_SWAP_PAIRS_SHUFFLE));
+
+    size_t i = 0;
+    for (; i + 7 < nsamps; i += 8) {
+        __m256i tmpi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        tmpi = _mm256_shuffle_epi8(tmpi, shuf);
+        sc16_x8_to_fc32(tmpi, output + i, scalar);
+    }
+
+    // convert any remaining samples
+    item32_sc16_to_xx<uhd::htowx>(input + i, output + i, nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16_item32_be, 1, fc32, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    fc32_t* output        = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    const __m256 scalar = _mm256_set1_ps(float(scale_factor));
+    const __m256i shuf  =
+        _mm256_broadcastsi128_si256(_mm_set_epi8(SC16_SWAP_BYTES_SHUFFLE));
+
+    size_t i = 0;
+    for (; i + 7 < nsamps; i += 8) {
+        __m256i tmpi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        tmpi = _mm256_shuffle_epi8(tmpi, shuf);
+        sc16_x8_to_fc32(tmpi, output + i, scalar);
+    }
+
+    // convert any remaining samples
+    item32_sc16_to_xx<uhd::htonx>(input + i, output + i, nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16_chdr, 1, fc32, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    fc32_t* output      = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    const __m256 scalar = _mm256_set1_ps(float(scale_factor));
+
+    size_t i = 0;
+    for (; i + 7 < nsamps; i += 8) {
+        const __m256i tmpi =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        sc16_x8_to_fc32(tmpi, output + i, scalar);
+    }
+
+    // convert any remaining samples
+    chdr_sc16_to_xx(input + i, output + i, nsamps - i, scale_factor);
+}
@@ -0,0 +1,81 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+/*
+ * Apply a byte shuffle to 8 complex 16-bit integers at a time. Both shuffles
+ * are their own inverse, so the same function serves both directions.
+ */
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE size_t shuffle_sc16_x8(
+    const void* input, void* output, const size_t nsamps, const __m256i shuf)
+{
+    const __m256i* in = reinterpret_cast<const __m256i*>(input);
+    __m256i* out      = reinterpret_cast<__m256i*>(output);
+
+    size_t i = 0;
+    for (; i + 7 < nsamps; i += 8) {
+        const __m256i m0 = _mm256_loadu_si256(in++);
+        _mm256_storeu_si256(out++, _mm256_shuffle_epi8(m0, shuf));
+    }
+    return i;
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16, 1, sc16_item32_le, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const __m256i shuf =
+        _mm256_broadcastsi128_si256(_mm_set_epi8(SC16_SWAP_PAIRS_SHUFFLE));
+    const size_t i = shuffle_sc16_x8(input, output, nsamps, shuf);
+
+    // convert any remaining samples
+    xx_to_item32_sc16<uhd::htowx>(input + i, output + i, nsamps - i, 1.0);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16, 1, sc16_item32_be, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const __m256i shuf =
+        _mm256_broadcastsi128_si256(_mm_set_epi8(SC16_SWAP_BYTES_SHUFFLE));
+    const size_t i = shuffle_sc16_x8(input, output, nsamps, shuf);
+
+    // convert any remaining samples
+    xx_to_item32_sc16<uhd::htonx>(input + i, output + i, nsamps - i, 1.0);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16_item32_le, 1, sc16, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    sc16_t* output        = reinterpret_cast<sc16_t*>(outputs[0]);
+
+    const __m256i shuf =
+        _mm256_broadcastsi128_si256(_mm_set_epi8(SC16_SWAP_PAIRS_SHUFFLE));
+    const size_t i = shuffle_sc16_x8(input, output, nsamps, shuf);
+
+    // convert any remaining samples
+    item32_sc16_to_xx<uhd::htowx>(input + i, output + i, nsamps - i, 1.0);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16_item32_be, 1, sc16, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    sc16_t* output        = reinterpret_cast<sc16_t*>(outputs[0]);
+
+    const __m256i shuf =
+        _mm256_broadcastsi128_si256(_mm_set_epi8(SC16_SWAP_BYTES_SHUFFLE));
+    const size_t i = shuffle_sc16_x8(input, output, nsamps, shuf);
+
+    // convert any remaining samples
+    item32_sc16_to_xx<uhd::htonx>(input + i, output + i, nsamps - i, 1.0);
+}
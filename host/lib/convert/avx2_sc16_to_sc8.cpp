@@ -0,0 +1,88 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+// Reverses the bytes in each item32, which turns the sc8_item32_be order
+// (I0, Q0, I1, Q1, ...) into sc8_item32_le
+#define SC8_ITEM32_BSWAP_SHUFFLE 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3
+
+// Sign extends 4 sc16 samples, then scales them and rounds them half away from
+// zero, like the scalar sc16_to_sc8_x1()
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE __m256i quantize_sc8_x4(
+    const sc16_t* input, const __m256 factor)
+{
+    const __m256i in = _mm256_cvtepi16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input)));
+    const __m256 scaled = _mm256_mul_ps(_mm256_cvtepi32_ps(in), factor);
+    const __m256 half   = _mm256_or_ps(
+        _mm256_and_ps(scaled, _mm256_set1_ps(-0.f)), _mm256_set1_ps(SC8_ROUND_HALF));
+    const __m256 rounded = _mm256_max_ps(_mm256_set1_ps(-129.f),
+        _mm256_min_ps(_mm256_set1_ps(128.f), _mm256_add_ps(scaled, half)));
+    return _mm256_cvttps_epi32(rounded);
+}
+
+/*
+ * Convert 16 sc16 samples to saturated sc8, in I0, Q0, I1, Q1, ... byte order.
+ *
+ * The pack instructions operate within 128-bit lanes, which leaves the item32s
+ * interleaved between the two lanes. The final permute restores their order.
+ */
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE __m256i sc16_x16_to_sc8(
+    const sc16_t* input, const __m256 factor)
+{
+    const __m256i tmpi0 = quantize_sc8_x4(input + 0, factor);
+    const __m256i tmpi1 = quantize_sc8_x4(input + 4, factor);
+    const __m256i tmpi2 = quantize_sc8_x4(input + 8, factor);
+    const __m256i tmpi3 = quantize_sc8_x4(input + 12, factor);
+
+    const __m256i lo   = _mm256_packs_epi32(tmpi0, tmpi1);
+    const __m256i hi   = _mm256_packs_epi32(tmpi2, tmpi3);
+    const __m256i tmpi = _mm256_packs_epi16(lo, hi);
+
+    return _mm256_permutevar8x32_epi32(tmpi, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16, 1, sc8_item32_be, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const __m256 factor = _mm256_set1_ps(sc16_to_sc8_factor(scale_factor));
+
+    size_t i = 0;
+    for (size_t j = 0; i + 15 < nsamps; i += 16, j += 8) {
+        const __m256i tmpi = sc16_x16_to_sc8(input + i, factor);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + j), tmpi);
+    }
+
+    // convert remainder
+    sc16_to_item32_sc8<uhd::htonx>(input + i, output + (i / 2), nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16, 1, sc8_item32_le, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const __m256 factor = _mm256_set1_ps(sc16_to_sc8_factor(scale_factor));
+    const __m256i shuf  =
+        _mm256_broadcastsi128_si256(_mm_set_epi8(SC8_ITEM32_BSWAP_SHUFFLE));
+
+    size_t i = 0;
+    for (size_t j = 0; i + 15 < nsamps; i += 16, j += 8) {
+        const __m256i tmpi =
+            _mm256_shuffle_epi8(sc16_x16_to_sc8(input + i, factor), shuf);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + j), tmpi);
+    }
+
+    // convert remainder
+    sc16_to_item32_sc8<uhd::htowx>(input + i, output + (i / 2), nsamps - i, scale_factor);
+}
@@ -0,0 +1,82 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+// Reverses the bytes in each item32, which turns sc8_item32_le into the order
+// of sc8_item32_be (I0, Q0, I1, Q1, ...)
+#define SC8_ITEM32_BSWAP_SHUFFLE 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3
+
+/*
+ * Convert 8 sc8 samples, given in I0, Q0, I1, Q1, ... byte order, to fc32,
+ * writing 16 floats to output
+ */
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE void sc8_x8_to_fc32(
+    const __m128i in, fc32_t* output, const __m256 scalar)
+{
+    const __m256i tmpilo = _mm256_cvtepi8_epi32(in);
+    const __m256i tmpihi = _mm256_cvtepi8_epi32(_mm_srli_si128(in, 8));
+
+    const __m256 tmplo = _mm256_mul_ps(_mm256_cvtepi32_ps(tmpilo), scalar);
+    const __m256 tmphi = _mm256_mul_ps(_mm256_cvtepi32_ps(tmpihi), scalar);
+
+    _mm256_storeu_ps(reinterpret_cast<float*>(output + 0), tmplo);
+    _mm256_storeu_ps(reinterpret_cast<float*>(output + 4), tmphi);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc8_item32_be, 1, fc32, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(size_t(inputs[0]) & ~0x3);
+    fc32_t* output        = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    const __m256 scalar = _mm256_set1_ps(float(scale_factor));
+
+    size_t i = 0, j = 0;
+    size_t num_samps = nsamps;
+
+    if ((size_t(inputs[0]) & 0x3) != 0) {
+        item32_sc8_to_xx<uhd::ntohx>(input++, output++, 1, scale_factor);
+        num_samps--;
+    }
+
+    for (; j + 7 < num_samps; j += 8, i += 4) {
+        const __m128i tmpi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        sc8_x8_to_fc32(tmpi, output + j, scalar);
+    }
+
+    // convert remainder
+    item32_sc8_to_xx<uhd::ntohx>(input + i, output + j, num_samps - j, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc8_item32_le, 1, fc32, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(size_t(inputs[0]) & ~0x3);
+    fc32_t* output        = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    const __m256 scalar = _mm256_set1_ps(float(scale_factor));
+    const __m128i shuf  = _mm_set_epi8(SC8_ITEM32_BSWAP_SHUFFLE);
+
+    size_t i = 0, j = 0;
+    size_t num_samps = nsamps;
+
+    if ((size_t(inputs[0]) & 0x3) != 0) {
+        item32_sc8_to_xx<uhd::wtohx>(input++, output++, 1, scale_factor);
+        num_samps--;
+    }
+
+    for (; j + 7 < num_samps; j += 8, i += 4) {
+        const __m128i tmpi = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)), shuf);
+        sc8_x8_to_fc32(tmpi, output + j, scalar);
+    }
+
+    // convert remainder
+    item32_sc8_to_xx<uhd::wtohx>(input + i, output + j, num_samps - j, scale_factor);
+}
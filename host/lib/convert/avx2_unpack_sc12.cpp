@@ -0,0 +1,198 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_unpack_sc12.hpp"
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+/*
+ * Shuffle Orderings - One 3 x 32-bit block per 128-bit lane
+ *
+ * Reading the three lines of a block MSB first gives a stream of eight 12-bit
+ * values I0, Q0, I1, Q1, I2, Q2, I3, Q3. Value k starts at bit 12 * k of that
+ * stream, so it is always contained in the two stream bytes starting at byte
+ * (3 * k) / 2: the upper 12 bits of those two bytes for even k, and the lower
+ * 12 bits for odd k.
+ *
+ * The shuffle gathers these byte pairs into eight 16-bit lanes, undoing the
+ * byte order of the lines on the way. Shifting the odd lanes up by 4 bits and
+ * masking then leaves all values high-bit aligned, just like the generic
+ * converter produces them.
+ *
+ *   12-bit interleaved packed I/Q (byte pairs, 16-bit lanes)
+ *  ---------------------------------------
+ * | Q3 | I3 | Q2 | I2 | Q1 | I1 | Q0 | I0 | Shuffle
+ *  ---------------------------------------
+ * | 127                                 0 |
+ */
+#define SC12_LE_UNPACK_SHUFFLE 2, 3, 1, 2, 7, 0, 6, 7, 4, 5, 11, 4, 9, 10, 8, 9
+#define SC12_BE_UNPACK_SHUFFLE 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10
+
+/*
+ * Convert two 3 x 32-bit blocks (8 samples) into fc32.
+ *
+ * Blocks are only 12 bytes long, so they are read with a masked load to avoid
+ * touching memory past the end of the second block.
+ */
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE void convert_sc12_item32_6_to_fc32_8(
+    const item32_sc12_3x* input, fc32_t* output, const __m256i shuf, const __m256 scalar)
+{
+    const __m128i mask = _mm_setr_epi32(-1, -1, -1, 0);
+    const __m128i lo   = _mm_maskload_epi32(reinterpret_cast<const int*>(input), mask);
+    const __m128i hi = _mm_maskload_epi32(reinterpret_cast<const int*>(input + 1), mask);
+
+    __m256i m0 = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    m0         = _mm256_shuffle_epi8(m0, shuf);
+    m0         = _mm256_blend_epi16(m0, _mm256_slli_epi16(m0, 4), 0xaa);
+    m0         = _mm256_and_si256(m0, _mm256_set1_epi16(int16_t(0xfff0)));
+
+    const __m256i m1 = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(m0));
+    const __m256i m2 = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(m0, 1));
+
+    const __m256 m3 = _mm256_mul_ps(_mm256_cvtepi32_ps(m1), scalar);
+    const __m256 m4 = _mm256_mul_ps(_mm256_cvtepi32_ps(m2), scalar);
+
+    _mm256_storeu_ps(reinterpret_cast<float*>(output + 0), m3);
+    _mm256_storeu_ps(reinterpret_cast<float*>(output + 4), m4);
+}
+
+template <tohost32_type tohost>
+struct convert_sc12_item32_1_to_fc32_1_avx2 : public converter
+{
+    convert_sc12_item32_1_to_fc32_1_avx2(void) : _scalar(0.0)
+    {
+        // NOP
+    }
+
+    void set_scalar(const double scalar)
+    {
+        const int unpack_growth = 16;
+        _scalar                 = scalar / unpack_growth;
+    }
+
+    UHD_CONVERT_TARGET_AVX2 void operator()(
+        const input_type& inputs, const output_type& outputs, const size_t nsamps)
+    {
+        const size_t head_samps = size_t(inputs[0]) & 0x3;
+        size_t rewind           = 0;
+        switch (head_samps) {
+            case 0:
+                break;
+            case 1:
+                rewind = 9;
+                break;
+            case 2:
+                rewind = 6;
+                break;
+            case 3:
+                rewind = 3;
+                break;
+        }
+
+        const item32_sc12_3x* input =
+            reinterpret_cast<const item32_sc12_3x*>(size_t(inputs[0]) - rewind);
+        fc32_t* output = reinterpret_cast<fc32_t*>(outputs[0]);
+
+        // helper variables
+        fc32_t dummy0, dummy1, dummy2;
+        size_t i = 0, o = 0;
+
+        // handle the head case
+        switch (head_samps) {
+            case 0:
+                break; // no head
+            case 1:
+                convert_sc12_item32_3_to_star_4<float, tohost>(
+                    input[i++], dummy0, dummy1, dummy2, output[0], _scalar);
+                break;
+            case 2:
+                convert_sc12_item32_3_to_star_4<float, tohost>(
+                    input[i++], dummy0, dummy1, output[0], output[1], _scalar);
+                break;
+            case 3:
+                convert_sc12_item32_3_to_star_4<float, tohost>(
+                    input[i++], dummy0, output[0], output[1], output[2], _scalar);
+                break;
+        }
+        o += head_samps;
+
+        // convert the body, two blocks at a time
+        const __m256i shuf = _mm256_broadcastsi128_si256(
+            tohost == uhd::wtohx<item32_t> ? _mm_setr_epi8(SC12_LE_UNPACK_SHUFFLE)
+                                           : _mm_setr_epi8(SC12_BE_UNPACK_SHUFFLE));
+        const __m256 scalar = _mm256_set1_ps(float(_scalar));
+        while (o + 7 < nsamps) {
+            convert_sc12_item32_6_to_fc32_8(&input[i], &output[o], shuf, scalar);
+            i += 2;
+            o += 8;
+        }
+        if (o + 3 < nsamps) {
+            convert_sc12_item32_3_to_star_4<float, tohost>(input[i],
+                output[o + 0],
+                output[o + 1],
+                output[o + 2],
+                output[o + 3],
+                _scalar);
+            i++;
+            o += 4;
+        }
+
+        // handle the tail case
+        const size_t tail_samps = nsamps - o;
+        switch (tail_samps) {
+            case 0:
+                break; // no tail
+            case 1:
+                convert_sc12_item32_3_to_star_4<float, tohost>(
+                    input[i], output[o + 0], dummy0, dummy1, dummy2, _scalar);
+                break;
+            case 2:
+                convert_sc12_item32_3_to_star_4<float, tohost>(
+                    input[i], output[o + 0], output[o + 1], dummy1, dummy2, _scalar);
+                break;
+            case 3:
+                convert_sc12_item32_3_to_star_4<float, tohost>(input[i],
+                    output[o + 0],
+                    output[o + 1],
+                    output[o + 2],
+                    dummy2,
+                    _scalar);
+                break;
+        }
+    }
+
+    double _scalar;
+};
+
+static converter::sptr make_convert_sc12_item32_le_1_to_fc32_1(void)
+{
+    return converter::sptr(new convert_sc12_item32_1_to_fc32_1_avx2<uhd::wtohx>());
+}
+
+static converter::sptr make_convert_sc12_item32_be_1_to_fc32_1(void)
+{
+    return converter::sptr(new convert_sc12_item32_1_to_fc32_1_avx2<uhd::ntohx>());
+}
+
+UHD_STATIC_BLOCK(register_avx2_unpack_sc12)
+{
+    if (!uhd_convert_cpu_has_AVX2()) {
+        return;
+    }
+
+    uhd::convert::id_type id;
+    id.num_inputs    = 1;
+    id.num_outputs   = 1;
+    id.output_format = "fc32";
+
+    id.input_format = "sc12_item32_le";
+    uhd::convert::register_converter(
+        id, &make_convert_sc12_item32_le_1_to_fc32_1, PRIORITY_SIMD_AVX2);
+    id.input_format = "sc12_item32_be";
+    uhd::convert::register_converter(
+        id, &make_convert_sc12_item32_be_1_to_fc32_1, PRIORITY_SIMD_AVX2);
+}
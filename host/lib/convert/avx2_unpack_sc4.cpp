@@ -0,0 +1,106 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_sc4.hpp"
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+/*
+ * Unpacks 8 sc4 samples to sc16
+ *
+ * Each byte is zero extended to a 32-bit lane, and its nibbles are shifted
+ * into the upper bits of the I and the Q half of the lane.
+ */
+template <bool swap>
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE __m256i unpack_sc4_x8(const uint8_t* input)
+{
+    __m256i in = _mm256_cvtepu8_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(input)));
+    if (swap) {
+        in = _mm256_shuffle_epi32(in, _MM_SHUFFLE(0, 1, 2, 3));
+    }
+    return _mm256_or_si256(
+        _mm256_and_si256(_mm256_slli_epi32(in, 8), _mm256_set1_epi32(0xF000)),
+        _mm256_slli_epi32(in, 28));
+}
+
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE void store_x8(
+    const __m256i in, sc16_t* output, const __m256)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), in);
+}
+
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE void store_x8(
+    const __m256i in, fc32_t* output, const __m256 factor)
+{
+    const __m256i tmpi0 = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(in));
+    const __m256i tmpi1 = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(in, 1));
+    _mm256_storeu_ps(reinterpret_cast<float*>(output + 0),
+        _mm256_mul_ps(_mm256_cvtepi32_ps(tmpi0), factor));
+    _mm256_storeu_ps(reinterpret_cast<float*>(output + 4),
+        _mm256_mul_ps(_mm256_cvtepi32_ps(tmpi1), factor));
+}
+
+template <bool swap, typename type>
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE void avx2_unpack_sc4(const void* input,
+    std::complex<type>* output,
+    const size_t nsamps,
+    const double scale_factor)
+{
+    const float factor  = sc4_unpack_factor(scale_factor);
+    const __m256 scalar = _mm256_set1_ps(factor);
+
+    // unpack the samples up to the next item32 boundary one by one
+    size_t i = sc4_head_samps(input, nsamps);
+    unpack_sc4<swap>(input, output, i, factor);
+
+    const uint8_t* in = reinterpret_cast<const uint8_t*>(input);
+    for (; i + 31 < nsamps; i += 32) {
+        for (size_t k = 0; k < 32; k += 8) {
+            store_x8(unpack_sc4_x8<swap>(in + i + k), output + i + k, scalar);
+        }
+    }
+
+    // convert remainder
+    unpack_sc4<swap>(in + i, output + i, nsamps - i, factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc4_item32_be, 1, fc32, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    fc32_t* output = reinterpret_cast<fc32_t*>(outputs[0]);
+    avx2_unpack_sc4<false>(inputs[0], output, nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc4_item32_le, 1, fc32, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    fc32_t* output = reinterpret_cast<fc32_t*>(outputs[0]);
+    avx2_unpack_sc4<true>(inputs[0], output, nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc4_chdr, 1, fc32, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    fc32_t* output = reinterpret_cast<fc32_t*>(outputs[0]);
+    avx2_unpack_sc4<false>(inputs[0], output, nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc4_item32_be, 1, sc16, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    sc16_t* output = reinterpret_cast<sc16_t*>(outputs[0]);
+    avx2_unpack_sc4<false>(inputs[0], output, nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc4_item32_le, 1, sc16, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    sc16_t* output = reinterpret_cast<sc16_t*>(outputs[0]);
+    avx2_unpack_sc4<true>(inputs[0], output, nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc4_chdr, 1, sc16, 1, PRIORITY_SIMD_AVX2, AVX2)
+{
+    sc16_t* output = reinterpret_cast<sc16_t*>(outputs[0]);
+    avx2_unpack_sc4<false>(inputs[0], output, nsamps, scale_factor);
+}
@@ -0,0 +1,84 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+/*
+ * Convert 16 fc32 samples (32 floats) to interleaved, saturated sc16. Unlike
+ * the AVX2 pack instructions, the AVX-512 down-conversions keep the element
+ * order, so no permute is needed.
+ */
+UHD_CONVERT_TARGET_AVX512 UHD_INLINE __m512i fc32_x16_to_sc16(
+    const fc32_t* input, const __m512 scalar)
+{
+    const __m512 tmplo = _mm512_loadu_ps(reinterpret_cast<const float*>(input + 0));
+    const __m512 tmphi = _mm512_loadu_ps(reinterpret_cast<const float*>(input + 8));
+
+    const __m512i tmpilo = _mm512_cvtps_epi32(_mm512_mul_ps(tmplo, scalar));
+    const __m512i tmpihi = _mm512_cvtps_epi32(_mm512_mul_ps(tmphi, scalar));
+
+    return _mm512_inserti64x4(_mm512_castsi256_si512(_mm512_cvtsepi32_epi16(tmpilo)),
+        _mm512_cvtsepi32_epi16(tmpihi),
+        1);
+}
+
+DECLARE_CONVERTER_FOR_CPU(fc32, 1, sc16_item32_le, 1, PRIORITY_SIMD_AVX512, AVX512)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const __m512 scalar = _mm512_set1_ps(float(scale_factor));
+    const __m512i shuf  = _mm512_broadcast_i32x4(_mm_set_epi8(SC16_SWAP_PAIRS_SHUFFLE));
+
+    size_t i = 0;
+    for (; i + 15 < nsamps; i += 16) {
+        const __m512i tmpi =
+            _mm512_shuffle_epi8(fc32_x16_to_sc16(input + i, scalar), shuf);
+        _mm512_storeu_si512(output + i, tmpi);
+    }
+
+    // convert any remaining samples
+    xx_to_item32_sc16<uhd::htowx>(input + i, output + i, nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(fc32, 1, sc16_item32_be, 1, PRIORITY_SIMD_AVX512, AVX512)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const __m512 scalar = _mm512_set1_ps(float(scale_factor));
+    const __m512i shuf  = _mm512_broadcast_i32x4(_mm_set_epi8(SC16_SWAP_BYTES_SHUFFLE));
+
+    size_t i = 0;
+    for (; i + 15 < nsamps; i += 16) {
+        const __m512i tmpi =
+            _mm512_shuffle_epi8(fc32_x16_to_sc16(input + i, scalar), shuf);
+        _mm512_storeu_si512(output + i, tmpi);
+    }
+
+    // convert any remaining samples
+    xx_to_item32_sc16<uhd::htonx>(input + i, output + i, nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(fc32, 1, sc16_chdr, 1, PRIORITY_SIMD_AVX512, AVX512)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    sc16_t* output      = reinterpret_cast<sc16_t*>(outputs[0]);
+
+    const __m512 scalar = _mm512_set1_ps(float(scale_factor));
+
+    size_t i = 0;
+    for (; i + 15 < nsamps; i += 16) {
+        _mm512_storeu_si512(output + i, fc32_x16_to_sc16(input + i, scalar));
+    }
+
+    // convert any remaining samples
+    xx_to_chdr_sc16(input + i, output + i, nsamps - i, scale_factor);
+}
@@ -0,0 +1,79 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+/*
+ * Convert 16 interleaved sc16 samples to fc32, writing 32 floats to output
+ */
+UHD_CONVERT_TARGET_AVX512 UHD_INLINE void sc16_x16_to_fc32(
+    const __m512i in, fc32_t* output, const __m512 scalar)
+{
+    const __m512i tmpilo = _mm512_cvtepi16_epi32(_mm512_castsi512_si256(in));
+    const __m512i tmpihi = _mm512_cvtepi16_epi32(_mm512_extracti64x4_epi64(in, 1));
+
+    const __m512 tmplo = _mm512_mul_ps(_mm512_cvtepi32_ps(tmpilo), scalar);
+    const __m512 tmphi = _mm512_mul_ps(_mm512_cvtepi32_ps(tmpihi), scalar);
+
+    _mm512_storeu_ps(reinterpret_cast<float*>(output + 0), tmplo);
+    _mm512_storeu_ps(reinterpret_cast<float*>(output + 8), tmphi);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16_item32_le, 1, fc32, 1, PRIORITY_SIMD_AVX512, AVX512)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    fc32_t* output        = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    const __m512 scalar = _mm512_set1_ps(float(scale_factor));
+    const __m512i shuf  = _mm512_broadcast_i32x4(_mm_set_epi8(SC16_SWAP_PAIRS_SHUFFLE));
+
+    size_t i = 0;
+    for (; i + 15 < nsamps; i += 16) {
+        const __m512i tmpi = _mm512_shuffle_epi8(_mm512_loadu_si512(input + i), shuf);
+        sc16_x16_to_fc32(tmpi, output + i, scalar);
+    }
+
+    // convert any remaining samples
+    item32_sc16_to_xx<uhd::htowx>(input + i, output + i, nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16_item32_be, 1, fc32, 1, PRIORITY_SIMD_AVX512, AVX512)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    fc32_t* output        = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    const __m512 scalar = _mm512_set1_ps(float(scale_factor));
+    const __m512i shuf  = _mm512_broadcast_i32x4(_mm_set_epi8(SC16_SWAP_BYTES_SHUFFLE));
+
+    size_t i = 0;
+    for (; i + 15 < nsamps; i += 16) {
+        const __m512i tmpi = _mm512_shuffle_epi8(_mm512_loadu_si512(input + i), shuf);
+        sc16_x16_to_fc32(tmpi, output + i, scalar);
+    }
+
+    // convert any remaining samples
+    item32_sc16_to_xx<uhd::htonx>(input + i, output + i, nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16_chdr, 1, fc32, 1, PRIORITY_SIMD_AVX512, AVX512)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    fc32_t* output      = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    const __m512 scalar = _mm512_set1_ps(float(scale_factor));
+
+    size_t i = 0;
+    for (; i + 15 < nsamps; i += 16) {
+        sc16_x16_to_fc32(_mm512_loadu_si512(input + i), output + i, scalar);
+    }
+
+    // convert any remaining samples
+    chdr_sc16_to_xx(input + i, output + i, nsamps - i, scale_factor);
+}
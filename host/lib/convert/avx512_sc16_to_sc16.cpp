@@ -0,0 +1,78 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+/*
+ * Apply a byte shuffle to 16 complex 16-bit integers at a time. Both shuffles
+ * are their own inverse, so the same function serves both directions.
+ */
+UHD_CONVERT_TARGET_AVX512 UHD_INLINE size_t shuffle_sc16_x16(
+    const void* input, void* output, const size_t nsamps, const __m128i shuf128)
+{
+    const __m512i* in  = reinterpret_cast<const __m512i*>(input);
+    __m512i* out       = reinterpret_cast<__m512i*>(output);
+    const __m512i shuf = _mm512_broadcast_i32x4(shuf128);
+
+    size_t i = 0;
+    for (; i + 15 < nsamps; i += 16) {
+        const __m512i m0 = _mm512_loadu_si512(in++);
+        _mm512_storeu_si512(out++, _mm512_shuffle_epi8(m0, shuf));
+    }
+    return i;
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16, 1, sc16_item32_le, 1, PRIORITY_SIMD_AVX512, AVX512)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const size_t i =
+        shuffle_sc16_x16(input, output, nsamps, _mm_set_epi8(SC16_SWAP_PAIRS_SHUFFLE));
+
+    // convert any remaining samples
+    xx_to_item32_sc16<uhd::htowx>(input + i, output + i, nsamps - i, 1.0);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16, 1, sc16_item32_be, 1, PRIORITY_SIMD_AVX512, AVX512)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const size_t i =
+        shuffle_sc16_x16(input, output, nsamps, _mm_set_epi8(SC16_SWAP_BYTES_SHUFFLE));
+
+    // convert any remaining samples
+    xx_to_item32_sc16<uhd::htonx>(input + i, output + i, nsamps - i, 1.0);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16_item32_le, 1, sc16, 1, PRIORITY_SIMD_AVX512, AVX512)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    sc16_t* output        = reinterpret_cast<sc16_t*>(outputs[0]);
+
+    const size_t i =
+        shuffle_sc16_x16(input, output, nsamps, _mm_set_epi8(SC16_SWAP_PAIRS_SHUFFLE));
+
+    // convert any remaining samples
+    item32_sc16_to_xx<uhd::htowx>(input + i, output + i, nsamps - i, 1.0);
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16_item32_be, 1, sc16, 1, PRIORITY_SIMD_AVX512, AVX512)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    sc16_t* output        = reinterpret_cast<sc16_t*>(outputs[0]);
+
+    const size_t i =
+        shuffle_sc16_x16(input, output, nsamps, _mm_set_epi8(SC16_SWAP_BYTES_SHUFFLE));
+
+    // convert any remaining samples
+    item32_sc16_to_xx<uhd::htonx>(input + i, output + i, nsamps - i, 1.0);
+}
@@ -11,9 +11,11 @@
 #include <uhd/convert.hpp>
 #include <uhd/utils/static.hpp>
 #include <stdint.h>
+#include <algorithm>
 #include <complex>
 
-#define _DECLARE_CONVERTER(name, in_form, num_in, out_form, num_out, prio)    \
+#define _DECLARE_CONVERTER_FOR_CPU(                                           \
+    name, in_form, num_in, out_form, num_out, prio, target, cpu_supported)    \
     struct name : public uhd::convert::converter                              \
     {                                                                         \
         static sptr make(void)                                                \
@@ -25,10 +27,26 @@
         {                                                                     \
             scale_factor = s;                                                 \
         }                                                                     \
-        void operator()(const input_type&, const output_type&, const size_t); \
+        kernel_type get_kernel(void)                                          \
+        {                                                                     \
+            return &name::kernel;                                             \
+        }                                                                     \
+        static void kernel(uhd::convert::converter* self,                     \
+            const input_type& inputs,                                         \
+            const output_type& outputs,                                       \
+            const size_t nsamps)                                              \
+        {                                                                     \
+            static_cast<name*>(self)->name::operator()(                       \
+                inputs, outputs, nsamps);                                     \
+        }                                                                     \
+        target void operator()(                                               \
+            const input_type&, const output_type&, const size_t);             \
     };                                                                        \
     UHD_STATIC_BLOCK(__register_##name##_##prio)                              \
     {                                                                         \
+        if (!(cpu_supported)) {                                               \
+            return;                                                           \
+        }                                                                     \
         uhd::convert::id_type id;                                             \
         id.input_format  = #in_form;                                          \
         id.num_inputs    = num_in;                                            \
@@ -36,9 +54,13 @@
         id.num_outputs   = num_out;                                           \
         uhd::convert::register_converter(id, &name::make, prio);              \
     }                                                                         \
-    void name::operator()(                                                    \
+    target void name::operator()(                                             \
         const input_type& inputs, const output_type& outputs, const size_t nsamps)
 
+#define _DECLARE_CONVERTER(name, in_form, num_in, out_form, num_out, prio) \
+    _DECLARE_CONVERTER_FOR_CPU(                                            \
+        name, in_form, num_in, out_form, num_out, prio, , true)
+
 /*! Convenience macro to declare a single-function converter
  *
  * Most converters consist of a single for loop, and can make use of
@@ -61,6 +83,72 @@
         num_out,                                                                         \
         prio)
 
+/*! Declare a converter that uses a non-baseline instruction set
+ *
+ * Works like DECLARE_CONVERTER(), but the conversion function is compiled for
+ * the given instruction set (`AVX2`, `AVX512` or `SVE`) using a function attribute,
+ * and the converter is only registered if the CPU we are running on supports
+ * it. The rest of the translation unit is compiled for the baseline target, so
+ * a single binary still runs on older machines. Helper functions that use the
+ * wider intrinsics must be declared with the matching UHD_CONVERT_TARGET_*
+ * attribute.
+ */
+#define DECLARE_CONVERTER_FOR_CPU(in_form, num_in, out_form, num_out, prio, isa) \
+    _DECLARE_CONVERTER_FOR_CPU(                                                  \
+        __convert_##in_form##_##num_in##_##out_form##_##num_out##_##prio,        \
+        in_form,                                                                 \
+        num_in,                                                                  \
+        out_form,                                                                \
+        num_out,                                                                 \
+        prio,                                                                    \
+        UHD_CONVERT_TARGET_##isa,                                                \
+        uhd_convert_cpu_has_##isa())
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+// GCC's AVX-512 intrinsics pass undefined vectors as the unused operands of
+// their masked builtins, which -Wmaybe-uninitialized reports where inlined
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wuninitialized"
+#    pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#    include <immintrin.h>
+#    pragma GCC diagnostic pop
+#    define UHD_CONVERT_TARGET_AVX2 __attribute__((target("avx2")))
+#    define UHD_CONVERT_TARGET_AVX512 \
+        __attribute__((target("avx2,avx512f,avx512bw")))
+
+// These are called from static initializers, which may run before the CPU
+// feature detection of the runtime has, hence the explicit init.
+UHD_INLINE bool uhd_convert_cpu_has_AVX2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+UHD_INLINE bool uhd_convert_cpu_has_AVX512()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("avx512f")
+           && __builtin_cpu_supports("avx512bw");
+}
+
+// Byte shuffles between host sc16 and the item32 wire formats, applied within
+// each 128-bit lane. Both are their own inverse.
+// Swap the 16-bit halves of each item32 (little-endian wire format)
+#    define SC16_SWAP_PAIRS_SHUFFLE 13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2
+// Swap the bytes of each 16-bit value (big-endian wire format)
+#    define SC16_SWAP_BYTES_SHUFFLE 14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1
+#elif defined(__GNUC__) && defined(__aarch64__) && defined(__linux__)
+#    include <sys/auxv.h>
+#    define UHD_CONVERT_TARGET_SVE __attribute__((target("+sve")))
+
+// The kernel reports SVE in the hardware capabilities (HWCAP_SVE, which older
+// C libraries don't define)
+UHD_INLINE bool uhd_convert_cpu_has_SVE()
+{
+    return (getauxval(AT_HWCAP) & (1UL << 22)) != 0;
+}
+#endif
+
 /***********************************************************************
  * Setup priorities
  **********************************************************************/
@@ -76,6 +164,12 @@ static const int PRIORITY_TABLE =
 static const int PRIORITY_SIMD  = 3;
 static const int PRIORITY_TABLE = 1;
 #endif
+// Wider SIMD kernels are only registered if the CPU supports them, in which
+// case they take precedence over the SSE2 ones
+static const int PRIORITY_SIMD_AVX2   = PRIORITY_SIMD + 1;
+static const int PRIORITY_SIMD_AVX512 = PRIORITY_SIMD + 2;
+// Likewise, SVE kernels take precedence over the NEON ones on AArch64
+static const int PRIORITY_SIMD_SVE = PRIORITY_SIMD + 1;
 
 /***********************************************************************
  * Typedefs
@@ -253,6 +347,48 @@ UHD_INLINE void xx_to_item32_sc8(const std::complex<T>* input,
     }
 }
 
+/***********************************************************************
+ * Quantize sc16 to items32 sc8 buffer
+ *  - The scale factor is relative to the sc16 full scale (32767)
+ *  - Rounds half away from zero and saturates, which is what the SIMD
+ *    quantizers do, so they can use this for their remainders
+ **********************************************************************/
+//! Returns the factor that scales sc16 values to sc8, as used by the quantizers
+UHD_INLINE float sc16_to_sc8_factor(const double scale_factor)
+{
+    return float(scale_factor / 32767.);
+}
+
+// Just below 0.5, so that values just below a tie don't round up
+static const float SC8_ROUND_HALF = 0.49999997f;
+
+UHD_INLINE uint8_t sc16_to_sc8_x1(const int16_t in, const float factor)
+{
+    const float scaled = float(in) * factor;
+    // Clamping first keeps the conversion to int in range
+    const float rounded = std::max(-129.f,
+        std::min(128.f, scaled + (scaled < 0 ? -SC8_ROUND_HALF : SC8_ROUND_HALF)));
+    return uint8_t(int8_t(std::max(-128, std::min(127, int(rounded)))));
+}
+
+template <xtox_t to_wire>
+UHD_INLINE void sc16_to_item32_sc8(const sc16_t* input,
+    item32_t* output,
+    const size_t nsamps,
+    const double scale_factor)
+{
+    const float factor = sc16_to_sc8_factor(scale_factor);
+    for (size_t i = 0; i < nsamps; i += 2) {
+        const sc16_t in1 = (i + 1 < nsamps) ? input[i + 1] : sc16_t(0);
+        const item32_t item =
+            (item32_t(sc16_to_sc8_x1(input[i].real(), factor)) << 24)
+            | (item32_t(sc16_to_sc8_x1(input[i].imag(), factor)) << 16)
+            | (item32_t(sc16_to_sc8_x1(in1.real(), factor)) << 8)
+            | (item32_t(sc16_to_sc8_x1(in1.imag(), factor)) << 0);
+        output[i / 2] = to_wire(item);
+    }
+}
+
 /***********************************************************************
  * Convert items32 sc8 buffer to xx
  **********************************************************************/
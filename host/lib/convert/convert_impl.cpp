@@ -12,7 +12,11 @@
 #include <uhd/utils/static.hpp>
 #include <stdint.h>
 #include <boost/format.hpp>
+#include <boost/functional/hash.hpp>
 #include <complex>
+#include <map>
+#include <mutex>
+#include <unordered_map>
 
 using namespace uhd;
 
@@ -48,12 +52,65 @@ std::string convert::id_type::to_string(void) const
 
 /***********************************************************************
  * Setup the table registry
+ *
+ * Every library and module registers its converters from static blocks when
+ * it is loaded, so registering has to be cheap: the table is hashed by ID,
+ * rather than searched, and the priorities of an ID are kept in order.
  **********************************************************************/
-typedef uhd::dict<convert::id_type,
-    uhd::dict<convert::priority_type, convert::function_type>>
+namespace {
+
+struct id_hash
+{
+    size_t operator()(const convert::id_type& id) const
+    {
+        size_t seed = 0;
+        boost::hash_combine(seed, id.input_format);
+        boost::hash_combine(seed, id.num_inputs);
+        boost::hash_combine(seed, id.output_format);
+        boost::hash_combine(seed, id.num_outputs);
+        return seed;
+    }
+};
+
+typedef std::unordered_map<convert::id_type,
+    std::map<convert::priority_type, convert::function_type>,
+    id_hash>
     fcn_table_type;
+
+} // namespace
+
 UHD_SINGLETON_FCN(fcn_table_type, get_table);
 
+/***********************************************************************
+ * Cache of resolved converters
+ *
+ * Registering a converter clears the cache, since it may change which
+ * converter has the best priority.
+ **********************************************************************/
+namespace {
+
+typedef std::pair<convert::id_type, convert::priority_type> cache_key_type;
+
+struct cache_key_hash
+{
+    size_t operator()(const cache_key_type& key) const
+    {
+        size_t seed = id_hash()(key.first);
+        boost::hash_combine(seed, key.second);
+        return seed;
+    }
+};
+
+struct fcn_cache_type
+{
+    std::mutex mutex;
+    std::unordered_map<cache_key_type, convert::function_type, cache_key_hash> fcns;
+};
+
+} // namespace
+
+UHD_SINGLETON_FCN(fcn_cache_type, get_cache);
+
 /***********************************************************************
  * The registry functions
  **********************************************************************/
@@ -61,6 +118,10 @@ void uhd::convert::register_converter(
     const id_type& id, const function_type& fcn, const priority_type prio)
 {
     get_table()[id][prio] = fcn;
+    {
+        std::lock_guard<std::mutex> lock(get_cache().mutex);
+        get_cache().fcns.clear();
+    }
 
     //----------------------------------------------------------------//
     // UHD_LOG_TRACE("CONVERT", boost::format("register_converter: %s prio: %s") %
@@ -71,30 +132,29 @@ void uhd::convert::register_converter(
 /***********************************************************************
  * The converter functions
  **********************************************************************/
-convert::function_type convert::get_converter(const id_type& id, const priority_type prio)
+static convert::function_type find_converter(
+    const convert::id_type& id, const convert::priority_type prio)
 {
-    if (not get_table().has_key(id))
+    const auto fcns = get_table().find(id);
+    if (fcns == get_table().end() or fcns->second.empty())
         throw uhd::key_error("Cannot find a conversion routine for " + id.to_pp_string());
 
     // find a matching priority
-    priority_type best_prio = -1;
-    for (priority_type prio_i : get_table()[id].keys()) {
-        if (prio_i == prio) {
-            //----------------------------------------------------------------//
-            UHD_LOGGER_DEBUG("CONVERT")
-                << "get_converter: For converter ID: " << id.to_pp_string()
-                << " Using prio: " << prio;
-            ;
-            //----------------------------------------------------------------//
-            return get_table()[id][prio];
-        }
-        best_prio = std::max(best_prio, prio_i);
+    if (prio != -1) {
+        const auto fcn = fcns->second.find(prio);
+        // wanted a specific prio, didnt find
+        if (fcn == fcns->second.end())
+            throw uhd::key_error(
+                "Cannot find a conversion routine [with prio] for " + id.to_pp_string());
+        //----------------------------------------------------------------//
+        UHD_LOGGER_DEBUG("CONVERT")
+            << "get_converter: For converter ID: " << id.to_pp_string()
+            << " Using prio: " << prio;
+        //----------------------------------------------------------------//
+        return fcn->second;
     }
 
-    // wanted a specific prio, didnt find
-    if (prio != -1)
-        throw uhd::key_error(
-            "Cannot find a conversion routine [with prio] for " + id.to_pp_string());
+    const convert::priority_type best_prio = fcns->second.rbegin()->first;
 
     //----------------------------------------------------------------//
     UHD_LOGGER_DEBUG("CONVERT")
@@ -103,7 +163,26 @@ convert::function_type convert::get_converter(const id_type& id, const priority_
     //----------------------------------------------------------------//
 
     // otherwise, return best prio
-    return get_table()[id][best_prio];
+    return fcns->second.rbegin()->second;
+}
+
+convert::function_type convert::get_converter(const id_type& id, const priority_type prio)
+{
+    const cache_key_type key(id, prio);
+    fcn_cache_type& cache = get_cache();
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        const auto it = cache.fcns.find(key);
+        if (it != cache.fcns.end()) {
+            return it->second;
+        }
+    }
+
+    // Failed lookups throw here, and are thus never cached
+    const function_type fcn = find_converter(id, prio);
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.fcns[key] = fcn;
+    return fcn;
 }
 
 /***********************************************************************
@@ -0,0 +1,87 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_iq_correction.hpp"
+#include <uhd/exception.hpp>
+
+using namespace uhd::convert;
+
+iq_correction_t iq_correction_t::from_iq_balance(const std::complex<double>& iq_balance,
+    const std::complex<double>& dc_offset,
+    const double gain)
+{
+    iq_correction_t correction;
+    correction.dc_offset    = dc_offset;
+    correction.matrix[0][0] = gain * (1.0 + iq_balance.real());
+    correction.matrix[0][1] = 0.0;
+    correction.matrix[1][0] = gain * iq_balance.imag();
+    correction.matrix[1][1] = gain;
+    return correction;
+}
+
+bool iq_correction_t::is_identity() const
+{
+    return dc_offset == std::complex<double>(0.0, 0.0) && matrix[0][0] == 1.0
+           && matrix[0][1] == 0.0 && matrix[1][0] == 0.0 && matrix[1][1] == 1.0;
+}
+
+id_type uhd::convert::get_iq_correcting_id(const id_type& id)
+{
+    id_type corr_id = id;
+    corr_id.output_format += "_iq_corr";
+    return corr_id;
+}
+
+iq_correcting_converter::sptr uhd::convert::make_iq_correcting_converter(
+    const id_type& id)
+{
+    auto converter = std::dynamic_pointer_cast<iq_correcting_converter>(
+        get_converter(get_iq_correcting_id(id))());
+    UHD_ASSERT_THROW(converter);
+    return converter;
+}
+
+/***********************************************************************
+ * Generic converters
+ **********************************************************************/
+template <sc16_wire_t wire>
+class convert_sc16_to_fc32_iq_corrected : public iq_correcting_converter_base
+{
+public:
+    kernel_type get_kernel(void)
+    {
+        return &kernel;
+    }
+
+    static void kernel(converter* self,
+        const input_type& inputs,
+        const output_type& outputs,
+        const size_t nsamps)
+    {
+        static_cast<convert_sc16_to_fc32_iq_corrected*>(self)
+            ->convert_sc16_to_fc32_iq_corrected::operator()(inputs, outputs, nsamps);
+    }
+
+    void operator()(
+        const input_type& inputs, const output_type& outputs, const size_t nsamps)
+    {
+        fc32_t* output = reinterpret_cast<fc32_t*>(outputs[0]);
+        sc16_to_fc32_iq_corrected<wire>(inputs[0], output, nsamps, coeffs);
+    }
+};
+
+UHD_STATIC_BLOCK(register_convert_iq_correction)
+{
+    register_iq_correcting_converter<
+        convert_sc16_to_fc32_iq_corrected<sc16_wire_t::ITEM32_LE>>(
+        "sc16_item32_le", PRIORITY_GENERAL);
+    register_iq_correcting_converter<
+        convert_sc16_to_fc32_iq_corrected<sc16_wire_t::ITEM32_BE>>(
+        "sc16_item32_be", PRIORITY_GENERAL);
+    register_iq_correcting_converter<
+        convert_sc16_to_fc32_iq_corrected<sc16_wire_t::CHDR>>(
+        "sc16_chdr", PRIORITY_GENERAL);
+}
@@ -0,0 +1,111 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <uhdlib/convert/iq_correction.hpp>
+
+/*!
+ * Coefficients that apply the scale factor and the correction in one step
+ *
+ * For a raw sample x of the wire format, the output is m * x - offset.
+ */
+struct iq_correction_coeffs_t
+{
+    float m[2][2];
+    float offset[2];
+};
+
+/*!
+ * Base class of the converters that apply corrections
+ *
+ * Combines the scale factor and the correction into the coefficients that the
+ * kernels use, whenever either of them changes.
+ */
+class iq_correcting_converter_base : public uhd::convert::iq_correcting_converter
+{
+public:
+    void set_scalar(const double scalar)
+    {
+        _scalar = scalar;
+        _update_coeffs();
+    }
+
+    void set_iq_correction(const uhd::convert::iq_correction_t& correction)
+    {
+        _correction = correction;
+        _update_coeffs();
+    }
+
+protected:
+    iq_correction_coeffs_t coeffs;
+
+private:
+    void _update_coeffs()
+    {
+        // m * (scalar * x - dc_offset) = (m * scalar) * x - m * dc_offset
+        const double dc[2] = {_correction.dc_offset.real(), _correction.dc_offset.imag()};
+        for (size_t row = 0; row < 2; row++) {
+            for (size_t col = 0; col < 2; col++) {
+                coeffs.m[row][col] = float(_correction.matrix[row][col] * _scalar);
+            }
+            coeffs.offset[row] = float(
+                _correction.matrix[row][0] * dc[0] + _correction.matrix[row][1] * dc[1]);
+        }
+    }
+
+    double _scalar = 1.0;
+    uhd::convert::iq_correction_t _correction;
+};
+
+//! Sample layouts of the sc16 wire formats
+enum class sc16_wire_t { ITEM32_LE, ITEM32_BE, CHDR };
+
+//! Reads sample \p i from a buffer of the sc16 wire format
+template <sc16_wire_t wire>
+UHD_INLINE sc16_t load_sc16_x1(const void* input, const size_t i)
+{
+    if (wire == sc16_wire_t::CHDR) {
+        return reinterpret_cast<const sc16_t*>(input)[i];
+    }
+    const item32_t raw  = reinterpret_cast<const item32_t*>(input)[i];
+    const item32_t item = (wire == sc16_wire_t::ITEM32_LE) ? uhd::wtohx(raw)
+                                                           : uhd::ntohx(raw);
+    return sc16_t(int16_t(item >> 16), int16_t(item >> 0));
+}
+
+//! Converts samples one at a time and applies the corrections
+template <sc16_wire_t wire>
+UHD_INLINE void sc16_to_fc32_iq_corrected(const void* input,
+    fc32_t* output,
+    const size_t nsamps,
+    const iq_correction_coeffs_t& c)
+{
+    for (size_t i = 0; i < nsamps; i++) {
+        const sc16_t in = load_sc16_x1<wire>(input, i);
+        const float re  = float(in.real());
+        const float im  = float(in.imag());
+        output[i]       = fc32_t(c.m[0][0] * re + c.m[0][1] * im - c.offset[0],
+            c.m[1][0] * re + c.m[1][1] * im - c.offset[1]);
+    }
+}
+
+//! Registers an IQ correcting converter for the sc16 wire format \p otw_format
+template <typename converter_type>
+void register_iq_correcting_converter(
+    const std::string& otw_format, const uhd::convert::priority_type prio)
+{
+    uhd::convert::id_type id;
+    id.input_format  = otw_format;
+    id.num_inputs    = 1;
+    id.output_format = "fc32";
+    id.num_outputs   = 1;
+    uhd::convert::register_converter(uhd::convert::get_iq_correcting_id(id),
+        []() { return uhd::convert::converter::sptr(new converter_type()); },
+        prio);
+}
@@ -0,0 +1,157 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <vector>
+
+using namespace uhd::convert;
+
+/***********************************************************************
+ * Multi-channel converters
+ *
+ * These convert one buffer per channel in a single call, and are registered
+ * for up to MAX_NUM_CHANS channels:
+ * - N inputs to N outputs converts each channel into its own output buffer.
+ * - N inputs to 1 output writes the samples of all channels into a single
+ *   buffer, interleaved by channel: ch0[0], ch1[0], ..., ch0[1], ch1[1], ...
+ *
+ * All channels share one scale factor.
+ **********************************************************************/
+static const size_t MAX_NUM_CHANS = 16;
+
+/*!
+ * Converts N channels into N buffers by running the best single-channel
+ * converter for these formats on each of them.
+ *
+ * This does not save any memory traffic over converting the channels one at a
+ * time, but the caller only needs to dispatch once per set of buffers.
+ */
+class convert_multi_chan : public converter
+{
+public:
+    convert_multi_chan(const id_type& single_chan_id, const size_t num_chans)
+        : _converter(get_converter(single_chan_id)())
+        , _kernel(_converter->get_kernel())
+        , _num_chans(num_chans)
+    {
+    }
+
+    void set_scalar(const double scalar)
+    {
+        _converter->set_scalar(scalar);
+    }
+
+    void operator()(
+        const input_type& inputs, const output_type& outputs, const size_t nsamps)
+    {
+        for (size_t i = 0; i < _num_chans; i++) {
+            _kernel(_converter.get(), inputs[i], outputs[i], nsamps);
+        }
+    }
+
+private:
+    const converter::sptr _converter;
+    const converter::kernel_type _kernel;
+    const size_t _num_chans;
+};
+
+/*!
+ * Converts N channels of sc16 into a single buffer with the channels
+ * interleaved, in one pass over the output.
+ */
+template <typename T>
+class convert_sc16_chdr_n_to_interleaved : public converter
+{
+public:
+    convert_sc16_chdr_n_to_interleaved(const size_t num_chans)
+        : _num_chans(num_chans), _inputs(num_chans), _scalar(0.0)
+    {
+    }
+
+    void set_scalar(const double scalar)
+    {
+        _scalar = scalar;
+    }
+
+    void operator()(
+        const input_type& inputs, const output_type& outputs, const size_t nsamps)
+    {
+        std::complex<T>* output = reinterpret_cast<std::complex<T>*>(outputs[0]);
+        const sc16_t** input    = _get_inputs(inputs);
+
+        for (size_t i = 0; i < nsamps; i++) {
+            for (size_t chan = 0; chan < _num_chans; chan++) {
+                *output++ = chdr_sc16_x1_to_xx<T>(input[chan][i], _scalar);
+            }
+        }
+    }
+
+private:
+    const sc16_t** _get_inputs(const input_type& inputs)
+    {
+        for (size_t chan = 0; chan < _num_chans; chan++) {
+            _inputs[chan] = reinterpret_cast<const sc16_t*>(inputs[chan]);
+        }
+        return _inputs.data();
+    }
+
+    const size_t _num_chans;
+    std::vector<const sc16_t*> _inputs;
+    double _scalar;
+};
+
+//! sc16 does not need scaling, so interleaving is a plain copy
+template <>
+void convert_sc16_chdr_n_to_interleaved<int16_t>::operator()(
+    const input_type& inputs, const output_type& outputs, const size_t nsamps)
+{
+    sc16_t* output       = reinterpret_cast<sc16_t*>(outputs[0]);
+    const sc16_t** input = _get_inputs(inputs);
+
+    for (size_t i = 0; i < nsamps; i++) {
+        for (size_t chan = 0; chan < _num_chans; chan++) {
+            *output++ = input[chan][i];
+        }
+    }
+}
+
+template <typename T>
+static void register_sc16_chdr_multi_chan(const std::string& cpu_format)
+{
+    id_type single_chan_id;
+    single_chan_id.input_format  = "sc16_chdr";
+    single_chan_id.num_inputs    = 1;
+    single_chan_id.output_format = cpu_format;
+    single_chan_id.num_outputs   = 1;
+
+    for (size_t num_chans = 2; num_chans <= MAX_NUM_CHANS; num_chans++) {
+        id_type id    = single_chan_id;
+        id.num_inputs = num_chans;
+
+        id.num_outputs = num_chans;
+        register_converter(id,
+            [single_chan_id, num_chans]() {
+                return converter::sptr(
+                    new convert_multi_chan(single_chan_id, num_chans));
+            },
+            PRIORITY_GENERAL);
+
+        id.num_outputs = 1;
+        register_converter(id,
+            [num_chans]() {
+                return converter::sptr(
+                    new convert_sc16_chdr_n_to_interleaved<T>(num_chans));
+            },
+            PRIORITY_GENERAL);
+    }
+}
+
+UHD_STATIC_BLOCK(register_convert_multi_chan)
+{
+    register_sc16_chdr_multi_chan<float>("fc32");
+    register_sc16_chdr_multi_chan<double>("fc64");
+    register_sc16_chdr_multi_chan<int16_t>("sc16");
+}
@@ -0,0 +1,45 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_sc4.hpp"
+
+using namespace uhd::convert;
+
+DECLARE_CONVERTER(fc32, 1, sc4_item32_be, 1, PRIORITY_GENERAL)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    pack_sc4<false>(input, outputs[0], nsamps, float(scale_factor));
+}
+
+DECLARE_CONVERTER(fc32, 1, sc4_item32_le, 1, PRIORITY_GENERAL)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    pack_sc4<true>(input, outputs[0], nsamps, float(scale_factor));
+}
+
+DECLARE_CONVERTER(fc32, 1, sc4_chdr, 1, PRIORITY_GENERAL)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    pack_sc4<false>(input, outputs[0], nsamps, float(scale_factor));
+}
+
+DECLARE_CONVERTER(sc16, 1, sc4_item32_be, 1, PRIORITY_GENERAL)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    pack_sc4<false>(input, outputs[0], nsamps, 0.f);
+}
+
+DECLARE_CONVERTER(sc16, 1, sc4_item32_le, 1, PRIORITY_GENERAL)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    pack_sc4<true>(input, outputs[0], nsamps, 0.f);
+}
+
+DECLARE_CONVERTER(sc16, 1, sc4_chdr, 1, PRIORITY_GENERAL)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    pack_sc4<false>(input, outputs[0], nsamps, 0.f);
+}
@@ -0,0 +1,94 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/utils/realtime.hpp>
+#include <uhd/utils/thread.hpp>
+#include <uhdlib/convert/convert_pool.hpp>
+#include <string>
+
+using namespace uhd::convert;
+
+namespace {
+
+//! How often a worker checks for work before it goes to sleep
+constexpr size_t WORKER_SPIN_COUNT = 20000;
+
+} // namespace
+
+convert_pool::convert_pool(const size_t num_threads, const std::vector<size_t>& cpus)
+{
+    for (size_t i = 1; i < num_threads; i++) {
+        _workers.emplace_back([this, i, cpus]() {
+            if (!cpus.empty()) {
+                uhd::set_thread_affinity({cpus[(i - 1) % cpus.size()]});
+            }
+            uhd::setup_realtime_thread(uhd::thread_role_t::CONVERT);
+            _worker(i);
+        });
+        uhd::set_thread_name(&_workers.back(), "convert_" + std::to_string(i));
+    }
+}
+
+convert_pool::~convert_pool()
+{
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _stop = true;
+        _generation++;
+    }
+    _cond.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+}
+
+void convert_pool::run(const task_t& task)
+{
+    if (_workers.empty()) {
+        task(0);
+        return;
+    }
+
+    _task = &task;
+    _pending.store(_workers.size(), std::memory_order_relaxed);
+    {
+        // Under the mutex, so a worker that is about to sleep sees the task
+        std::lock_guard<std::mutex> l(_mutex);
+        _generation.fetch_add(1, std::memory_order_release);
+    }
+    _cond.notify_all();
+
+    task(0);
+
+    while (_pending.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+}
+
+void convert_pool::_worker(const size_t index)
+{
+    uint64_t generation = 0;
+    while (true) {
+        size_t spins = 0;
+        while (_generation.load(std::memory_order_acquire) == generation) {
+            if (++spins < WORKER_SPIN_COUNT) {
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> l(_mutex);
+            _cond.wait(l, [this, generation]() {
+                return _generation.load(std::memory_order_relaxed) != generation;
+            });
+        }
+        generation = _generation.load(std::memory_order_acquire);
+
+        if (_stop) {
+            return;
+        }
+        (*_task)(index);
+        _pending.fetch_sub(1, std::memory_order_release);
+    }
+}
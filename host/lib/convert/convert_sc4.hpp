@@ -0,0 +1,116 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include "convert_common.hpp"
+#include <algorithm>
+
+/*
+ * sc4 packs a complex sample into one byte, with I in the upper nibble and Q
+ * in the lower nibble. An item32 holds four samples, with the first one in
+ * the most significant byte:
+ *  _ _ _ _ _ _ _ _
+ * |I0Q0|I1Q1|I2Q2|I3Q3|
+ * 31                0
+ *
+ * So sc4_item32_be stores the samples in order, and sc4_item32_le reverses
+ * the order of the four samples in each item32. sc4_chdr uses the same byte
+ * layout as sc4_item32_be.
+ *
+ * Like for sc12, converting sc16 keeps the 4 most significant bits. Floating
+ * point samples are scaled, truncated, and saturated.
+ *
+ * The converters may start in the middle of an item32, e.g., when a streamer
+ * converts part of a packet. The address of a sample within its item32 gives
+ * its position in there, because packets always start on an item32 boundary.
+ */
+
+/*!
+ * Returns the index of the byte that holds sample \p n, relative to the
+ * start of the item32 that holds sample 0
+ *
+ * \tparam swap true if the samples are in reverse order within an item32
+ */
+template <bool swap>
+UHD_INLINE size_t sc4_byte_index(const size_t n)
+{
+    return swap ? (n ^ 0x3) : n;
+}
+
+//! Returns the factor that scales the nibbles of sc4 in the upper bits of an
+//  int16 to floating point
+UHD_INLINE float sc4_unpack_factor(const double scale_factor)
+{
+    return float(scale_factor) / (1 << 12);
+}
+
+UHD_INLINE uint8_t sc4_pack_x1(const sc16_t& in, const float)
+{
+    return uint8_t(((in.real() >> 8) & 0xF0) | ((in.imag() >> 12) & 0x0F));
+}
+
+UHD_INLINE uint8_t sc4_pack_x1(const fc32_t& in, const float scalar)
+{
+    const int32_t i = int32_t(std::max(-8.f, std::min(7.f, in.real() * scalar)));
+    const int32_t q = int32_t(std::max(-8.f, std::min(7.f, in.imag() * scalar)));
+    return uint8_t(((i << 4) & 0xF0) | (q & 0x0F));
+}
+
+UHD_INLINE void sc4_unpack_x1(const uint8_t in, sc16_t& out, const float)
+{
+    out = sc16_t(int16_t((in & 0xF0) << 8), int16_t((in & 0x0F) << 12));
+}
+
+UHD_INLINE void sc4_unpack_x1(const uint8_t in, fc32_t& out, const float factor)
+{
+    sc16_t tmp;
+    sc4_unpack_x1(in, tmp, factor);
+    out = fc32_t(float(tmp.real()) * factor, float(tmp.imag()) * factor);
+}
+
+/*!
+ * Packs samples into a buffer of sc4, one sample at a time
+ *
+ * \param scalar the scale factor for floating point samples
+ */
+template <bool swap, typename type>
+UHD_INLINE void pack_sc4(const std::complex<type>* input,
+    void* output,
+    const size_t nsamps,
+    const float scalar)
+{
+    const size_t offset = size_t(output) & 0x3;
+    uint8_t* base       = reinterpret_cast<uint8_t*>(output) - offset;
+    for (size_t i = 0; i < nsamps; i++) {
+        base[sc4_byte_index<swap>(offset + i)] = sc4_pack_x1(input[i], scalar);
+    }
+}
+
+/*!
+ * Unpacks samples from a buffer of sc4, one sample at a time
+ *
+ * \param factor the scale factor for floating point samples, see
+ *        sc4_unpack_factor()
+ */
+template <bool swap, typename type>
+UHD_INLINE void unpack_sc4(const void* input,
+    std::complex<type>* output,
+    const size_t nsamps,
+    const float factor)
+{
+    const size_t offset = size_t(input) & 0x3;
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(input) - offset;
+    for (size_t i = 0; i < nsamps; i++) {
+        sc4_unpack_x1(base[sc4_byte_index<swap>(offset + i)], output[i], factor);
+    }
+}
+
+//! Returns the number of samples up to the next item32 boundary of \p buff
+UHD_INLINE size_t sc4_head_samps(const void* buff, const size_t nsamps)
+{
+    return std::min(nsamps, (4 - (size_t(buff) & 0x3)) & 0x3);
+}
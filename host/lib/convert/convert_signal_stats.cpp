@@ -0,0 +1,109 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_signal_stats.hpp"
+#include <uhd/exception.hpp>
+
+using namespace uhd::convert;
+
+id_type uhd::convert::get_signal_stats_id(const id_type& id)
+{
+    id_type stats_id = id;
+    stats_id.output_format += "_stats";
+    return stats_id;
+}
+
+signal_stats_converter::sptr uhd::convert::make_signal_stats_converter(
+    const id_type& id)
+{
+    auto converter = std::dynamic_pointer_cast<signal_stats_converter>(
+        get_converter(get_signal_stats_id(id))());
+    UHD_ASSERT_THROW(converter);
+    return converter;
+}
+
+/***********************************************************************
+ * Generic converters
+ **********************************************************************/
+template <sc16_wire_t wire>
+class convert_sc16_to_fc32_with_stats : public signal_stats_converter_base
+{
+public:
+    kernel_type get_kernel(void)
+    {
+        return &kernel;
+    }
+
+    static void kernel(converter* self,
+        const input_type& inputs,
+        const output_type& outputs,
+        const size_t nsamps)
+    {
+        static_cast<convert_sc16_to_fc32_with_stats*>(self)
+            ->convert_sc16_to_fc32_with_stats::operator()(inputs, outputs, nsamps);
+    }
+
+    void operator()(
+        const input_type& inputs, const output_type& outputs, const size_t nsamps)
+    {
+        const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+        fc32_t* output      = reinterpret_cast<fc32_t*>(outputs[0]);
+        const float scalar  = float(_scalar);
+        convert_blocks(nsamps, [&](const size_t i, const size_t n, block_stats_t& block) {
+            sc16_to_fc32_with_stats<wire>(input + i, output + i, n, scalar, block);
+        });
+    }
+};
+
+template <sc16_wire_t wire>
+class convert_fc32_to_sc16_with_stats : public signal_stats_converter_base
+{
+public:
+    kernel_type get_kernel(void)
+    {
+        return &kernel;
+    }
+
+    static void kernel(converter* self,
+        const input_type& inputs,
+        const output_type& outputs,
+        const size_t nsamps)
+    {
+        static_cast<convert_fc32_to_sc16_with_stats*>(self)
+            ->convert_fc32_to_sc16_with_stats::operator()(inputs, outputs, nsamps);
+    }
+
+    void operator()(
+        const input_type& inputs, const output_type& outputs, const size_t nsamps)
+    {
+        const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+        sc16_t* output      = reinterpret_cast<sc16_t*>(outputs[0]);
+        const float scalar  = float(_scalar);
+        convert_blocks(nsamps, [&](const size_t i, const size_t n, block_stats_t& block) {
+            fc32_to_sc16_with_stats<wire>(input + i, output + i, n, scalar, block);
+        });
+    }
+};
+
+UHD_STATIC_BLOCK(register_convert_signal_stats)
+{
+    register_signal_stats_converter<
+        convert_sc16_to_fc32_with_stats<sc16_wire_t::ITEM32_LE>>(
+        "sc16_item32_le", "fc32", PRIORITY_GENERAL);
+    register_signal_stats_converter<
+        convert_sc16_to_fc32_with_stats<sc16_wire_t::ITEM32_BE>>(
+        "sc16_item32_be", "fc32", PRIORITY_GENERAL);
+    register_signal_stats_converter<convert_sc16_to_fc32_with_stats<sc16_wire_t::CHDR>>(
+        "sc16_chdr", "fc32", PRIORITY_GENERAL);
+    register_signal_stats_converter<
+        convert_fc32_to_sc16_with_stats<sc16_wire_t::ITEM32_LE>>(
+        "fc32", "sc16_item32_le", PRIORITY_GENERAL);
+    register_signal_stats_converter<
+        convert_fc32_to_sc16_with_stats<sc16_wire_t::ITEM32_BE>>(
+        "fc32", "sc16_item32_be", PRIORITY_GENERAL);
+    register_signal_stats_converter<convert_fc32_to_sc16_with_stats<sc16_wire_t::CHDR>>(
+        "fc32", "sc16_chdr", PRIORITY_GENERAL);
+}
@@ -0,0 +1,169 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include "convert_iq_correction.hpp"
+#include <uhdlib/convert/signal_stats.hpp>
+#include <algorithm>
+
+//! The most samples of which the statistics are accumulated in single precision
+constexpr size_t STATS_BLOCK_SIZE = 4096;
+
+/*!
+ * Statistics of a block of samples, see STATS_BLOCK_SIZE
+ *
+ * These are accumulated in single precision, which is plenty for a block, and
+ * are added to the statistics of the converter at the end of the block.
+ */
+struct block_stats_t
+{
+    float sum_power      = 0.f;
+    float peak_power     = 0.f;
+    float sum_i          = 0.f;
+    float sum_q          = 0.f;
+    uint64_t num_clipped = 0;
+
+    UHD_INLINE void add(const float re, const float im)
+    {
+        const float power = re * re + im * im;
+        sum_power += power;
+        peak_power = std::max(peak_power, power);
+        sum_i += re;
+        sum_q += im;
+    }
+
+    UHD_INLINE void add_to(uhd::signal_stats_t& stats, const size_t nsamps) const
+    {
+        stats.num_samps += nsamps;
+        stats.sum_power += sum_power;
+        stats.peak_power = std::max(stats.peak_power, double(peak_power));
+        stats.sum += std::complex<double>(sum_i, sum_q);
+        stats.num_clipped += num_clipped;
+    }
+};
+
+//! Base class of the converters that collect signal statistics
+class signal_stats_converter_base : public uhd::convert::signal_stats_converter
+{
+public:
+    void set_scalar(const double scalar)
+    {
+        _scalar = scalar;
+    }
+
+    const uhd::signal_stats_t& get_signal_stats() const
+    {
+        return _stats;
+    }
+
+    void reset_signal_stats()
+    {
+        _stats = uhd::signal_stats_t();
+    }
+
+protected:
+    /*!
+     * Calls convert(offset, nsamps, block) for blocks of the samples, and adds
+     * the statistics of each block to the ones of the converter
+     */
+    template <typename convert_fn_t>
+    UHD_INLINE void convert_blocks(const size_t nsamps, convert_fn_t&& convert)
+    {
+        for (size_t offset = 0; offset < nsamps; offset += STATS_BLOCK_SIZE) {
+            const size_t block_samps = std::min(STATS_BLOCK_SIZE, nsamps - offset);
+            block_stats_t block;
+            convert(offset, block_samps, block);
+            block.add_to(_stats, block_samps);
+        }
+    }
+
+    double _scalar = 1.0;
+    uhd::signal_stats_t _stats;
+};
+
+//! Writes sample \p i to a buffer of the sc16 wire format
+template <sc16_wire_t wire>
+UHD_INLINE void store_sc16_x1(void* output, const size_t i, const sc16_t sample)
+{
+    if (wire == sc16_wire_t::CHDR) {
+        reinterpret_cast<sc16_t*>(output)[i] = sample;
+        return;
+    }
+    const item32_t item = (item32_t(uint16_t(sample.real())) << 16)
+                          | item32_t(uint16_t(sample.imag()));
+    reinterpret_cast<item32_t*>(output)[i] =
+        (wire == sc16_wire_t::ITEM32_LE) ? uhd::wtohx(item) : uhd::ntohx(item);
+}
+
+//! Converts samples one at a time and collects their statistics
+template <sc16_wire_t wire>
+UHD_INLINE void sc16_to_fc32_with_stats(const void* input,
+    fc32_t* output,
+    const size_t nsamps,
+    const float scalar,
+    block_stats_t& stats)
+{
+    for (size_t i = 0; i < nsamps; i++) {
+        const sc16_t in = load_sc16_x1<wire>(input, i);
+        stats.num_clipped += (in.real() == INT16_MAX || in.real() == INT16_MIN)
+                             + (in.imag() == INT16_MAX || in.imag() == INT16_MIN);
+        const float re = float(in.real()) * scalar;
+        const float im = float(in.imag()) * scalar;
+        stats.add(re, im);
+        output[i] = fc32_t(re, im);
+    }
+}
+
+//! Converts a scaled value to sc16, and counts it if it saturates
+UHD_INLINE int16_t saturate_s16(const float value, uint64_t& num_clipped)
+{
+    if (value > float(INT16_MAX)) {
+        num_clipped++;
+        return INT16_MAX;
+    }
+    if (value < float(INT16_MIN)) {
+        num_clipped++;
+        return INT16_MIN;
+    }
+    return int16_t(value);
+}
+
+//! Converts samples one at a time and collects their statistics
+template <sc16_wire_t wire>
+UHD_INLINE void fc32_to_sc16_with_stats(const fc32_t* input,
+    void* output,
+    const size_t nsamps,
+    const float scalar,
+    block_stats_t& stats)
+{
+    for (size_t i = 0; i < nsamps; i++) {
+        const float re = input[i].real();
+        const float im = input[i].imag();
+        stats.add(re, im);
+        store_sc16_x1<wire>(output,
+            i,
+            sc16_t(saturate_s16(re * scalar, stats.num_clipped),
+                saturate_s16(im * scalar, stats.num_clipped)));
+    }
+}
+
+//! Registers a converter that collects statistics, for \p in_format to
+// \p out_format
+template <typename converter_type>
+void register_signal_stats_converter(const std::string& in_format,
+    const std::string& out_format,
+    const uhd::convert::priority_type prio)
+{
+    uhd::convert::id_type id;
+    id.input_format  = in_format;
+    id.num_inputs    = 1;
+    id.output_format = out_format;
+    id.num_outputs   = 1;
+    uhd::convert::register_converter(uhd::convert::get_signal_stats_id(id),
+        []() { return uhd::convert::converter::sptr(new converter_type()); },
+        prio);
+}
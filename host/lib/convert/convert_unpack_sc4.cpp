@@ -0,0 +1,50 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_sc4.hpp"
+
+using namespace uhd::convert;
+
+DECLARE_CONVERTER(sc4_item32_be, 1, fc32, 1, PRIORITY_GENERAL)
+{
+    fc32_t* output = reinterpret_cast<fc32_t*>(outputs[0]);
+    unpack_sc4<false>(inputs[0], output, nsamps, sc4_unpack_factor(scale_factor));
+}
+
+DECLARE_CONVERTER(sc4_item32_le, 1, fc32, 1, PRIORITY_GENERAL)
+{
+    fc32_t* output = reinterpret_cast<fc32_t*>(outputs[0]);
+    unpack_sc4<true>(inputs[0], output, nsamps, sc4_unpack_factor(scale_factor));
+}
+
+DECLARE_CONVERTER(sc4_chdr, 1, fc32, 1, PRIORITY_GENERAL)
+{
+    fc32_t* output = reinterpret_cast<fc32_t*>(outputs[0]);
+    unpack_sc4<false>(inputs[0], output, nsamps, sc4_unpack_factor(scale_factor));
+}
+
+DECLARE_CONVERTER(sc4_item32_be, 1, sc16, 1, PRIORITY_GENERAL)
+{
+    sc16_t* output = reinterpret_cast<sc16_t*>(outputs[0]);
+    unpack_sc4<false>(inputs[0], output, nsamps, 0.f);
+}
+
+DECLARE_CONVERTER(sc4_item32_le, 1, sc16, 1, PRIORITY_GENERAL)
+{
+    sc16_t* output = reinterpret_cast<sc16_t*>(outputs[0]);
+    unpack_sc4<true>(inputs[0], output, nsamps, 0.f);
+}
+
+DECLARE_CONVERTER(sc4_chdr, 1, sc16, 1, PRIORITY_GENERAL)
+{
+    sc16_t* output = reinterpret_cast<sc16_t*>(outputs[0]);
+    unpack_sc4<false>(inputs[0], output, nsamps, 0.f);
+}
+
+UHD_STATIC_BLOCK(register_convert_unpack_sc4)
+{
+    uhd::convert::register_bytes_per_item("sc4", 1 /*byte*/);
+}
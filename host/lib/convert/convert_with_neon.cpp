@@ -6,6 +6,7 @@
 //
 
 #include "convert_common.hpp"
+#include "convert_sc4.hpp"
 #include <uhd/utils/byteswap.hpp>
 #include <arm_neon.h>
 
@@ -130,3 +131,202 @@ DECLARE_CONVERTER(sc16_item32_le, 1, sc16, 1, PRIORITY_SIMD)
 
     item32_sc16_to_xx<uhd::wtohx>(input + i, output + i, nsamps - i, scale_factor);
 }
+
+// Scales 4 values and rounds them half away from zero, like sc16_to_sc8_x1().
+// The conversion to integers saturates, so there is no need to clamp.
+UHD_INLINE int32x4_t quantize_sc8_4x(const int32x4_t in, const float32x4_t factor)
+{
+    const float32x4_t half   = vdupq_n_f32(SC8_ROUND_HALF);
+    const float32x4_t scaled = vmulq_f32(vcvtq_f32_s32(in), factor);
+    const float32x4_t rounded =
+        vaddq_f32(scaled, vbslq_f32(vcltq_f32(scaled, vdupq_n_f32(0.f)),
+                              vnegq_f32(half),
+                              half));
+    return vcvtq_s32_f32(rounded);
+}
+
+DECLARE_CONVERTER(sc16, 1, sc8_item32_le, 1, PRIORITY_SIMD)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const float32x4_t factor = vdupq_n_f32(sc16_to_sc8_factor(scale_factor));
+
+    size_t i = 0;
+    for (; i + 3 < nsamps; i += 4) {
+        const int16x8_t in = vld1q_s16(reinterpret_cast<const int16_t*>(&input[i]));
+        const int32x4_t lo = quantize_sc8_4x(vmovl_s16(vget_low_s16(in)), factor);
+        const int32x4_t hi = quantize_sc8_4x(vmovl_s16(vget_high_s16(in)), factor);
+        const int8x8_t out = vqmovn_s16(vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+        vst1_s8(reinterpret_cast<int8_t*>(&output[i / 2]), vrev32_s8(out));
+    }
+
+    sc16_to_item32_sc8<uhd::htowx>(input + i, output + i / 2, nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER(fc32, 1, sc8_item32_le, 1, PRIORITY_SIMD)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const float32x4_t scalar = vdupq_n_f32(float(scale_factor));
+
+    size_t i = 0;
+    for (; i + 3 < nsamps; i += 4) {
+        const float32x4_t in0 = vld1q_f32(reinterpret_cast<const float*>(&input[i]));
+        const float32x4_t in1 = vld1q_f32(reinterpret_cast<const float*>(&input[i + 2]));
+        const int32x4_t lo    = vcvtq_s32_f32(vmulq_f32(in0, scalar));
+        const int32x4_t hi    = vcvtq_s32_f32(vmulq_f32(in1, scalar));
+        const int8x8_t out = vqmovn_s16(vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+        vst1_s8(reinterpret_cast<int8_t*>(&output[i / 2]), vrev32_s8(out));
+    }
+
+    xx_to_item32_sc8<uhd::htowx>(input + i, output + i / 2, nsamps - i, scale_factor);
+}
+
+// Packs 8 samples into sc4, 4 bits each for I and Q
+UHD_INLINE uint8x8_t pack_sc4_8x(const sc16_t* input, const float32x4_t)
+{
+    const int16x8x2_t in = vld2q_s16(reinterpret_cast<const int16_t*>(input));
+    const uint16x8_t i = vandq_u16(
+        vshrq_n_u16(vreinterpretq_u16_s16(in.val[0]), 8), vdupq_n_u16(0xF0));
+    const uint16x8_t q = vshrq_n_u16(vreinterpretq_u16_s16(in.val[1]), 12);
+    return vmovn_u16(vorrq_u16(i, q));
+}
+
+UHD_INLINE uint8x8_t pack_sc4_8x(const fc32_t* input, const float32x4_t scalar)
+{
+    const float32x4_t min   = vdupq_n_f32(-8.f);
+    const float32x4_t max   = vdupq_n_f32(7.f);
+    const float32x4x2_t in0 = vld2q_f32(reinterpret_cast<const float*>(input));
+    const float32x4x2_t in1 = vld2q_f32(reinterpret_cast<const float*>(input + 4));
+    int16x8_t iq[2];
+    for (size_t k = 0; k < 2; k++) {
+        const int32x4_t lo =
+            vcvtq_s32_f32(vmaxq_f32(min, vminq_f32(max, vmulq_f32(in0.val[k], scalar))));
+        const int32x4_t hi =
+            vcvtq_s32_f32(vmaxq_f32(min, vminq_f32(max, vmulq_f32(in1.val[k], scalar))));
+        iq[k] = vcombine_s16(vmovn_s32(lo), vmovn_s32(hi));
+    }
+    const uint16x8_t i =
+        vandq_u16(vshlq_n_u16(vreinterpretq_u16_s16(iq[0]), 4), vdupq_n_u16(0xF0));
+    const uint16x8_t q = vandq_u16(vreinterpretq_u16_s16(iq[1]), vdupq_n_u16(0x0F));
+    return vmovn_u16(vorrq_u16(i, q));
+}
+
+template <bool swap, typename type>
+UHD_INLINE void neon_pack_sc4(const std::complex<type>* input,
+    void* output,
+    const size_t nsamps,
+    const double scale_factor)
+{
+    const float32x4_t scalar = vdupq_n_f32(float(scale_factor));
+
+    // pack the samples up to the next item32 boundary one by one
+    size_t i = sc4_head_samps(output, nsamps);
+    pack_sc4<swap>(input, output, i, float(scale_factor));
+
+    uint8_t* out = reinterpret_cast<uint8_t*>(output);
+    for (; i + 7 < nsamps; i += 8) {
+        const uint8x8_t tmp = pack_sc4_8x(input + i, scalar);
+        vst1_u8(out + i, swap ? vrev32_u8(tmp) : tmp);
+    }
+
+    pack_sc4<swap>(input + i, out + i, nsamps - i, float(scale_factor));
+}
+
+// Unpacks 8 samples of sc4 into the upper bits of int16 I and Q values
+UHD_INLINE int16x8x2_t unpack_sc4_8x(const uint8x8_t in)
+{
+    const uint16x8_t b = vmovl_u8(in);
+    int16x8x2_t out;
+    out.val[0] = vreinterpretq_s16_u16(vshlq_n_u16(vandq_u16(b, vdupq_n_u16(0xF0)), 8));
+    out.val[1] = vreinterpretq_s16_u16(vshlq_n_u16(b, 12));
+    return out;
+}
+
+UHD_INLINE void store_8x(const int16x8x2_t in, sc16_t* output, const float32x4_t)
+{
+    vst2q_s16(reinterpret_cast<int16_t*>(output), in);
+}
+
+UHD_INLINE void store_8x(const int16x8x2_t in, fc32_t* output, const float32x4_t factor)
+{
+    float32x4x2_t lo, hi;
+    for (size_t k = 0; k < 2; k++) {
+        lo.val[k] = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(in.val[k]))), factor);
+        hi.val[k] = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(in.val[k]))), factor);
+    }
+    vst2q_f32(reinterpret_cast<float*>(output), lo);
+    vst2q_f32(reinterpret_cast<float*>(output + 4), hi);
+}
+
+template <bool swap, typename type>
+UHD_INLINE void neon_unpack_sc4(const void* input,
+    std::complex<type>* output,
+    const size_t nsamps,
+    const double scale_factor)
+{
+    const float factor       = sc4_unpack_factor(scale_factor);
+    const float32x4_t scalar = vdupq_n_f32(factor);
+
+    // unpack the samples up to the next item32 boundary one by one
+    size_t i = sc4_head_samps(input, nsamps);
+    unpack_sc4<swap>(input, output, i, factor);
+
+    const uint8_t* in = reinterpret_cast<const uint8_t*>(input);
+    for (; i + 7 < nsamps; i += 8) {
+        const uint8x8_t tmp = vld1_u8(in + i);
+        store_8x(unpack_sc4_8x(swap ? vrev32_u8(tmp) : tmp), output + i, scalar);
+    }
+
+    unpack_sc4<swap>(in + i, output + i, nsamps - i, factor);
+}
+
+DECLARE_CONVERTER(fc32, 1, sc4_item32_le, 1, PRIORITY_SIMD)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    neon_pack_sc4<true>(input, outputs[0], nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(fc32, 1, sc4_chdr, 1, PRIORITY_SIMD)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    neon_pack_sc4<false>(input, outputs[0], nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(sc16, 1, sc4_item32_le, 1, PRIORITY_SIMD)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    neon_pack_sc4<true>(input, outputs[0], nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(sc16, 1, sc4_chdr, 1, PRIORITY_SIMD)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    neon_pack_sc4<false>(input, outputs[0], nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(sc4_item32_le, 1, fc32, 1, PRIORITY_SIMD)
+{
+    fc32_t* output = reinterpret_cast<fc32_t*>(outputs[0]);
+    neon_unpack_sc4<true>(inputs[0], output, nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(sc4_chdr, 1, fc32, 1, PRIORITY_SIMD)
+{
+    fc32_t* output = reinterpret_cast<fc32_t*>(outputs[0]);
+    neon_unpack_sc4<false>(inputs[0], output, nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(sc4_item32_le, 1, sc16, 1, PRIORITY_SIMD)
+{
+    sc16_t* output = reinterpret_cast<sc16_t*>(outputs[0]);
+    neon_unpack_sc4<true>(inputs[0], output, nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(sc4_chdr, 1, sc16, 1, PRIORITY_SIMD)
+{
+    sc16_t* output = reinterpret_cast<sc16_t*>(outputs[0]);
+    neon_unpack_sc4<false>(inputs[0], output, nsamps, scale_factor);
+}
@@ -7,13 +7,50 @@
 
 #include "convert_common.hpp"
 #include <uhd/utils/byteswap.hpp>
+#include <uhdlib/utils/memory_usage.hpp>
 #include <boost/math/special_functions/round.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 using namespace uhd::convert;
 
 static const size_t sc16_table_len = size_t(1 << 16);
 
+/*! Returns the lookup table of a converter for \p scalar
+ *
+ * Converters of the same type and with the same scalar (e.g., those of the
+ * channels of a streamer) share their table, so each table is only built and
+ * kept in memory once. \p fill builds a table of sc16_table_len entries.
+ */
+template <typename converter_type, typename type, typename fill_type>
+static std::shared_ptr<const std::vector<type>> get_shared_table(
+    const double scalar, const fill_type& fill)
+{
+    static std::mutex mutex;
+    static std::map<double, std::weak_ptr<const std::vector<type>>> tables;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<const std::vector<type>> table = tables[scalar].lock();
+    if (not table) {
+        std::shared_ptr<std::vector<type>> new_table(
+            new std::vector<type>(sc16_table_len), [](std::vector<type>* table) {
+                uhd::remove_memory_usage(
+                    uhd::MEMORY_USAGE_CONVERT, sizeof(type) * sc16_table_len);
+                delete table;
+            });
+        uhd::add_memory_usage(uhd::MEMORY_USAGE_CONVERT, sizeof(type) * sc16_table_len);
+        fill(*new_table);
+        table = new_table;
+        for (auto it = tables.begin(); it != tables.end();) {
+            it = it->second.expired() ? tables.erase(it) : std::next(it);
+        }
+        tables[scalar] = table;
+    }
+    return table;
+}
+
 typedef uint16_t (*tohost16_type)(uint16_t);
 
 /***********************************************************************
@@ -24,14 +61,16 @@ template <bool swap>
 class convert_sc16_1_to_sc8_item32_1 : public converter
 {
 public:
-    convert_sc16_1_to_sc8_item32_1(void) : _table(sc16_table_len) {}
-
     void set_scalar(const double scalar)
     {
-        for (size_t i = 0; i < sc16_table_len; i++) {
-            const int16_t val = uint16_t(i);
-            _table[i]         = int8_t(boost::math::iround(val * scalar / 32767.));
-        }
+        _shared_table = get_shared_table<convert_sc16_1_to_sc8_item32_1, uint8_t>(
+            scalar, [scalar](std::vector<uint8_t>& table) {
+                for (size_t i = 0; i < sc16_table_len; i++) {
+                    const int16_t val = uint16_t(i);
+                    table[i] = int8_t(boost::math::iround(val * scalar / 32767.));
+                }
+            });
+        _table = _shared_table->data();
     }
 
     void operator()(
@@ -66,7 +105,9 @@ public:
     }
 
 private:
-    std::vector<uint8_t> _table;
+    std::shared_ptr<const std::vector<uint8_t>> _shared_table;
+    //! The entries of the shared table, set by set_scalar()
+    const uint8_t* _table = nullptr;
 };
 
 /***********************************************************************
@@ -77,14 +118,16 @@ template <typename type, tohost16_type tohost, size_t re_shift, size_t im_shift>
 class convert_sc16_item32_1_to_fcxx_1 : public converter
 {
 public:
-    convert_sc16_item32_1_to_fcxx_1(void) : _table(sc16_table_len) {}
-
     void set_scalar(const double scalar)
     {
-        for (size_t i = 0; i < sc16_table_len; i++) {
-            const uint16_t val = tohost(uint16_t(i & 0xffff));
-            _table[i]          = type(int16_t(val) * scalar);
-        }
+        _shared_table = get_shared_table<convert_sc16_item32_1_to_fcxx_1, type>(
+            scalar, [scalar](std::vector<type>& table) {
+                for (size_t i = 0; i < sc16_table_len; i++) {
+                    const uint16_t val = tohost(uint16_t(i & 0xffff));
+                    table[i]           = type(int16_t(val) * scalar);
+                }
+            });
+        _table = _shared_table->data();
     }
 
     void operator()(
@@ -101,7 +144,9 @@ public:
     }
 
 private:
-    std::vector<type> _table;
+    std::shared_ptr<const std::vector<type>> _shared_table;
+    //! The entries of the shared table, set by set_scalar()
+    const type* _table = nullptr;
 };
 
 /***********************************************************************
@@ -112,8 +157,6 @@ template <typename type, tohost16_type tohost, size_t lo_shift, size_t hi_shift>
 class convert_sc8_item32_1_to_fcxx_1 : public converter
 {
 public:
-    convert_sc8_item32_1_to_fcxx_1(void) : _table(sc16_table_len) {}
-
     // special case for sc16 type, 32767 undoes float normalization
     static type conv(const int8_t& num, const double scalar)
     {
@@ -125,12 +168,17 @@ public:
 
     void set_scalar(const double scalar)
     {
-        for (size_t i = 0; i < sc16_table_len; i++) {
-            const uint16_t val = tohost(uint16_t(i & 0xffff));
-            const type real    = conv(int8_t(val >> 8), scalar);
-            const type imag    = conv(int8_t(val >> 0), scalar);
-            _table[i]          = std::complex<type>(real, imag);
-        }
+        _shared_table =
+            get_shared_table<convert_sc8_item32_1_to_fcxx_1, std::complex<type>>(
+                scalar, [scalar](std::vector<std::complex<type>>& table) {
+                    for (size_t i = 0; i < sc16_table_len; i++) {
+                        const uint16_t val = tohost(uint16_t(i & 0xffff));
+                        const type real    = conv(int8_t(val >> 8), scalar);
+                        const type imag    = conv(int8_t(val >> 0), scalar);
+                        table[i]           = std::complex<type>(real, imag);
+                    }
+                });
+        _table = _shared_table->data();
     }
 
     void operator()(
@@ -162,7 +210,9 @@ public:
     }
 
 private:
-    std::vector<std::complex<type>> _table;
+    std::shared_ptr<const std::vector<std::complex<type>>> _shared_table;
+    //! The entries of the shared table, set by set_scalar()
+    const std::complex<type>* _table = nullptr;
 };
 
 /***********************************************************************
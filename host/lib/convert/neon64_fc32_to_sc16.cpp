@@ -0,0 +1,93 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <arm_neon.h>
+
+using namespace uhd::convert;
+
+// sc16_item32_le keeps Q in the lower half of each item32, so the int16
+// values of a sample are swapped in memory
+UHD_INLINE int16x8_t sc16_swap_pairs(const int16x8_t in)
+{
+    return vrev32q_s16(in);
+}
+
+// sc16_item32_be keeps the int16 values in order, but byte swapped
+UHD_INLINE int16x8_t sc16_swap_bytes(const int16x8_t in)
+{
+    return vreinterpretq_s16_u8(vrev16q_u8(vreinterpretq_u8_s16(in)));
+}
+
+/*
+ * Convert 4 fc32 samples (8 floats) to interleaved sc16. The values are
+ * rounded to nearest, and the narrowing saturates them.
+ */
+UHD_INLINE int16x8_t fc32_x4_to_sc16(const fc32_t* input, const float32x4_t scalar)
+{
+    const float32x4_t tmplo = vld1q_f32(reinterpret_cast<const float*>(input + 0));
+    const float32x4_t tmphi = vld1q_f32(reinterpret_cast<const float*>(input + 2));
+
+    const int32x4_t tmpilo = vcvtnq_s32_f32(vmulq_f32(tmplo, scalar));
+    const int32x4_t tmpihi = vcvtnq_s32_f32(vmulq_f32(tmphi, scalar));
+
+    return vqmovn_high_s32(vqmovn_s32(tmpilo), tmpihi);
+}
+
+DECLARE_CONVERTER(fc32, 1, sc16_item32_le, 1, PRIORITY_SIMD)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const float32x4_t scalar = vdupq_n_f32(float(scale_factor));
+
+    size_t i = 0;
+    for (; i + 7 < nsamps; i += 8) {
+        int16_t* out = reinterpret_cast<int16_t*>(output + i);
+        vst1q_s16(out + 0, sc16_swap_pairs(fc32_x4_to_sc16(input + i + 0, scalar)));
+        vst1q_s16(out + 8, sc16_swap_pairs(fc32_x4_to_sc16(input + i + 4, scalar)));
+    }
+
+    // convert any remaining samples
+    xx_to_item32_sc16<uhd::htowx>(input + i, output + i, nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER(fc32, 1, sc16_item32_be, 1, PRIORITY_SIMD)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const float32x4_t scalar = vdupq_n_f32(float(scale_factor));
+
+    size_t i = 0;
+    for (; i + 7 < nsamps; i += 8) {
+        int16_t* out = reinterpret_cast<int16_t*>(output + i);
+        vst1q_s16(out + 0, sc16_swap_bytes(fc32_x4_to_sc16(input + i + 0, scalar)));
+        vst1q_s16(out + 8, sc16_swap_bytes(fc32_x4_to_sc16(input + i + 4, scalar)));
+    }
+
+    // convert any remaining samples
+    xx_to_item32_sc16<uhd::htonx>(input + i, output + i, nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER(fc32, 1, sc16_chdr, 1, PRIORITY_SIMD)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    sc16_t* output      = reinterpret_cast<sc16_t*>(outputs[0]);
+
+    const float32x4_t scalar = vdupq_n_f32(float(scale_factor));
+
+    size_t i = 0;
+    for (; i + 7 < nsamps; i += 8) {
+        int16_t* out = reinterpret_cast<int16_t*>(output + i);
+        vst1q_s16(out + 0, fc32_x4_to_sc16(input + i + 0, scalar));
+        vst1q_s16(out + 8, fc32_x4_to_sc16(input + i + 4, scalar));
+    }
+
+    // convert any remaining samples
+    xx_to_chdr_sc16(input + i, output + i, nsamps - i, scale_factor);
+}
@@ -0,0 +1,63 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <arm_neon.h>
+
+using namespace uhd::convert;
+
+/*
+ * Convert 8 fc32 samples (16 floats) to saturated sc8, in I0, Q0, I1, Q1, ...
+ * byte order. The values are rounded to nearest.
+ */
+UHD_INLINE int8x16_t fc32_x8_to_sc8(const fc32_t* input, const float32x4_t scalar)
+{
+    const float* in       = reinterpret_cast<const float*>(input);
+    const int32x4_t tmpi0 = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(in + 0), scalar));
+    const int32x4_t tmpi1 = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(in + 4), scalar));
+    const int32x4_t tmpi2 = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(in + 8), scalar));
+    const int32x4_t tmpi3 = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(in + 12), scalar));
+
+    const int16x8_t lo = vqmovn_high_s32(vqmovn_s32(tmpi0), tmpi1);
+    const int16x8_t hi = vqmovn_high_s32(vqmovn_s32(tmpi2), tmpi3);
+    return vqmovn_high_s16(vqmovn_s16(lo), hi);
+}
+
+DECLARE_CONVERTER(fc32, 1, sc8_item32_be, 1, PRIORITY_SIMD)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const float32x4_t scalar = vdupq_n_f32(float(scale_factor));
+
+    size_t i = 0;
+    for (size_t j = 0; i + 7 < nsamps; i += 8, j += 4) {
+        const int8x16_t tmpi = fc32_x8_to_sc8(input + i, scalar);
+        vst1q_s8(reinterpret_cast<int8_t*>(output + j), tmpi);
+    }
+
+    // convert remainder
+    xx_to_item32_sc8<uhd::htonx>(input + i, output + (i / 2), nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER(fc32, 1, sc8_item32_le, 1, PRIORITY_SIMD)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const float32x4_t scalar = vdupq_n_f32(float(scale_factor));
+
+    // Reversing the bytes of each item32 gives the item32_le order
+    size_t i = 0;
+    for (size_t j = 0; i + 7 < nsamps; i += 8, j += 4) {
+        const int8x16_t tmpi = vrev32q_s8(fc32_x8_to_sc8(input + i, scalar));
+        vst1q_s8(reinterpret_cast<int8_t*>(output + j), tmpi);
+    }
+
+    // convert remainder
+    xx_to_item32_sc8<uhd::htowx>(input + i, output + (i / 2), nsamps - i, scale_factor);
+}
@@ -0,0 +1,94 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <arm_neon.h>
+
+using namespace uhd::convert;
+
+// sc16_item32_le keeps Q in the lower half of each item32, so the int16
+// values of a sample are swapped in memory
+UHD_INLINE int16x8_t sc16_swap_pairs(const int16x8_t in)
+{
+    return vrev32q_s16(in);
+}
+
+// sc16_item32_be keeps the int16 values in order, but byte swapped
+UHD_INLINE int16x8_t sc16_swap_bytes(const int16x8_t in)
+{
+    return vreinterpretq_s16_u8(vrev16q_u8(vreinterpretq_u8_s16(in)));
+}
+
+/*
+ * Convert 4 interleaved sc16 samples to fc32, writing 8 floats to output
+ */
+UHD_INLINE void sc16_x4_to_fc32(
+    const int16x8_t in, fc32_t* output, const float32x4_t scalar)
+{
+    const int32x4_t tmpilo = vmovl_s16(vget_low_s16(in));
+    const int32x4_t tmpihi = vmovl_high_s16(in);
+
+    const float32x4_t tmplo = vmulq_f32(vcvtq_f32_s32(tmpilo), scalar);
+    const float32x4_t tmphi = vmulq_f32(vcvtq_f32_s32(tmpihi), scalar);
+
+    vst1q_f32(reinterpret_cast<float*>(output + 0), tmplo);
+    vst1q_f32(reinterpret_cast<float*>(output + 2), tmphi);
+}
+
+DECLARE_CONVERTER(sc16_item32_le, 1, fc32, 1, PRIORITY_SIMD)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    fc32_t* output        = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    const float32x4_t scalar = vdupq_n_f32(float(scale_factor));
+
+    size_t i = 0;
+    for (; i + 7 < nsamps; i += 8) {
+        const int16_t* in = reinterpret_cast<const int16_t*>(input + i);
+        sc16_x4_to_fc32(sc16_swap_pairs(vld1q_s16(in + 0)), output + i + 0, scalar);
+        sc16_x4_to_fc32(sc16_swap_pairs(vld1q_s16(in + 8)), output + i + 4, scalar);
+    }
+
+    // convert any remaining samples
+    item32_sc16_to_xx<uhd::htowx>(input + i, output + i, nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER(sc16_item32_be, 1, fc32, 1, PRIORITY_SIMD)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    fc32_t* output        = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    const float32x4_t scalar = vdupq_n_f32(float(scale_factor));
+
+    size_t i = 0;
+    for (; i + 7 < nsamps; i += 8) {
+        const int16_t* in = reinterpret_cast<const int16_t*>(input + i);
+        sc16_x4_to_fc32(sc16_swap_bytes(vld1q_s16(in + 0)), output + i + 0, scalar);
+        sc16_x4_to_fc32(sc16_swap_bytes(vld1q_s16(in + 8)), output + i + 4, scalar);
+    }
+
+    // convert any remaining samples
+    item32_sc16_to_xx<uhd::htonx>(input + i, output + i, nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER(sc16_chdr, 1, fc32, 1, PRIORITY_SIMD)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    fc32_t* output      = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    const float32x4_t scalar = vdupq_n_f32(float(scale_factor));
+
+    size_t i = 0;
+    for (; i + 7 < nsamps; i += 8) {
+        const int16_t* in = reinterpret_cast<const int16_t*>(input + i);
+        sc16_x4_to_fc32(vld1q_s16(in + 0), output + i + 0, scalar);
+        sc16_x4_to_fc32(vld1q_s16(in + 8), output + i + 4, scalar);
+    }
+
+    // convert any remaining samples
+    chdr_sc16_to_xx(input + i, output + i, nsamps - i, scale_factor);
+}
@@ -0,0 +1,85 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <arm_neon.h>
+
+using namespace uhd::convert;
+
+// Swap the 16-bit halves of each item32 (little-endian wire format)
+UHD_INLINE uint8x16_t sc16_swap_pairs(const uint8x16_t in)
+{
+    return vreinterpretq_u8_u16(vrev32q_u16(vreinterpretq_u16_u8(in)));
+}
+
+// Swap the bytes of each 16-bit value (big-endian wire format)
+UHD_INLINE uint8x16_t sc16_swap_bytes(const uint8x16_t in)
+{
+    return vrev16q_u8(in);
+}
+
+/*
+ * Swap 8 complex 16-bit integers at a time. Both swaps are their own inverse,
+ * so the same function serves both directions.
+ */
+template <uint8x16_t (*swap)(const uint8x16_t)>
+UHD_INLINE size_t swap_sc16_x8(const void* input, void* output, const size_t nsamps)
+{
+    const uint8_t* in = reinterpret_cast<const uint8_t*>(input);
+    uint8_t* out      = reinterpret_cast<uint8_t*>(output);
+
+    size_t i = 0;
+    for (; i + 7 < nsamps; i += 8, in += 32, out += 32) {
+        vst1q_u8(out + 0, swap(vld1q_u8(in + 0)));
+        vst1q_u8(out + 16, swap(vld1q_u8(in + 16)));
+    }
+    return i;
+}
+
+DECLARE_CONVERTER(sc16, 1, sc16_item32_le, 1, PRIORITY_SIMD)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const size_t i = swap_sc16_x8<sc16_swap_pairs>(input, output, nsamps);
+
+    // convert any remaining samples
+    xx_to_item32_sc16<uhd::htowx>(input + i, output + i, nsamps - i, 1.0);
+}
+
+DECLARE_CONVERTER(sc16, 1, sc16_item32_be, 1, PRIORITY_SIMD)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const size_t i = swap_sc16_x8<sc16_swap_bytes>(input, output, nsamps);
+
+    // convert any remaining samples
+    xx_to_item32_sc16<uhd::htonx>(input + i, output + i, nsamps - i, 1.0);
+}
+
+DECLARE_CONVERTER(sc16_item32_le, 1, sc16, 1, PRIORITY_SIMD)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    sc16_t* output        = reinterpret_cast<sc16_t*>(outputs[0]);
+
+    const size_t i = swap_sc16_x8<sc16_swap_pairs>(input, output, nsamps);
+
+    // convert any remaining samples
+    item32_sc16_to_xx<uhd::htowx>(input + i, output + i, nsamps - i, 1.0);
+}
+
+DECLARE_CONVERTER(sc16_item32_be, 1, sc16, 1, PRIORITY_SIMD)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    sc16_t* output        = reinterpret_cast<sc16_t*>(outputs[0]);
+
+    const size_t i = swap_sc16_x8<sc16_swap_bytes>(input, output, nsamps);
+
+    // convert any remaining samples
+    item32_sc16_to_xx<uhd::htonx>(input + i, output + i, nsamps - i, 1.0);
+}
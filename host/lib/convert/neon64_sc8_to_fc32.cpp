@@ -0,0 +1,78 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <arm_neon.h>
+
+using namespace uhd::convert;
+
+/*
+ * Convert 8 sc8 samples, given in I0, Q0, I1, Q1, ... byte order, to fc32,
+ * writing 16 floats to output
+ */
+UHD_INLINE void sc8_x8_to_fc32(
+    const int8x16_t in, fc32_t* output, const float32x4_t scalar)
+{
+    const int16x8_t lo = vmovl_s8(vget_low_s8(in));
+    const int16x8_t hi = vmovl_high_s8(in);
+
+    float* out = reinterpret_cast<float*>(output);
+    vst1q_f32(out + 0, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(lo))), scalar));
+    vst1q_f32(out + 4, vmulq_f32(vcvtq_f32_s32(vmovl_high_s16(lo)), scalar));
+    vst1q_f32(out + 8, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(hi))), scalar));
+    vst1q_f32(out + 12, vmulq_f32(vcvtq_f32_s32(vmovl_high_s16(hi)), scalar));
+}
+
+DECLARE_CONVERTER(sc8_item32_be, 1, fc32, 1, PRIORITY_SIMD)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(size_t(inputs[0]) & ~0x3);
+    fc32_t* output        = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    const float32x4_t scalar = vdupq_n_f32(float(scale_factor));
+
+    size_t i = 0, j = 0;
+    size_t num_samps = nsamps;
+
+    if ((size_t(inputs[0]) & 0x3) != 0) {
+        item32_sc8_to_xx<uhd::ntohx>(input++, output++, 1, scale_factor);
+        num_samps--;
+    }
+
+    for (; j + 7 < num_samps; j += 8, i += 4) {
+        const int8x16_t tmpi = vld1q_s8(reinterpret_cast<const int8_t*>(input + i));
+        sc8_x8_to_fc32(tmpi, output + j, scalar);
+    }
+
+    // convert remainder
+    item32_sc8_to_xx<uhd::ntohx>(input + i, output + j, num_samps - j, scale_factor);
+}
+
+DECLARE_CONVERTER(sc8_item32_le, 1, fc32, 1, PRIORITY_SIMD)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(size_t(inputs[0]) & ~0x3);
+    fc32_t* output        = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    const float32x4_t scalar = vdupq_n_f32(float(scale_factor));
+
+    size_t i = 0, j = 0;
+    size_t num_samps = nsamps;
+
+    if ((size_t(inputs[0]) & 0x3) != 0) {
+        item32_sc8_to_xx<uhd::wtohx>(input++, output++, 1, scale_factor);
+        num_samps--;
+    }
+
+    // Reversing the bytes of each item32 gives the I0, Q0, I1, Q1, ... order
+    for (; j + 7 < num_samps; j += 8, i += 4) {
+        const int8x16_t tmpi =
+            vrev32q_s8(vld1q_s8(reinterpret_cast<const int8_t*>(input + i)));
+        sc8_x8_to_fc32(tmpi, output + j, scalar);
+    }
+
+    // convert remainder
+    item32_sc8_to_xx<uhd::wtohx>(input + i, output + j, num_samps - j, scale_factor);
+}
@@ -0,0 +1,176 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_unpack_sc12.hpp"
+#include <arm_neon.h>
+
+using namespace uhd::convert;
+
+/*
+ * Table lookups that unpack one 3 x 32-bit block, see avx2_unpack_sc12.cpp
+ *
+ * Reading the three lines of a block MSB first gives a stream of eight 12-bit
+ * values I0, Q0, I1, Q1, I2, Q2, I3, Q3. The lookup gathers the two stream
+ * bytes that contain each value into eight 16-bit lanes, undoing the byte
+ * order of the lines on the way. Shifting the odd lanes up by 4 bits and
+ * masking then leaves all values high-bit aligned, just like the generic
+ * converter produces them.
+ */
+static const uint8_t SC12_LE_UNPACK_TABLE[16] = {
+    2, 3, 1, 2, 7, 0, 6, 7, 4, 5, 11, 4, 9, 10, 8, 9};
+static const uint8_t SC12_BE_UNPACK_TABLE[16] = {
+    1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10};
+
+/*
+ * Convert one 3 x 32-bit block (4 samples) into fc32.
+ *
+ * Blocks are only 12 bytes long, so the last line is loaded on its own to
+ * avoid touching memory past the end of the block.
+ */
+UHD_INLINE void convert_sc12_item32_3_to_fc32_4(const item32_sc12_3x* input,
+    fc32_t* output,
+    const uint8x16_t table,
+    const float32x4_t scalar)
+{
+    const uint8_t* in       = reinterpret_cast<const uint8_t*>(input);
+    const uint32x2_t line2  = vld1_lane_u32(&input->line2, vdup_n_u32(0), 0);
+    const uint8x16_t block  = vcombine_u8(vld1_u8(in), vreinterpret_u8_u32(line2));
+    const uint16x8_t values = vreinterpretq_u16_u8(vqtbl1q_u8(block, table));
+
+    // 0 for the even lanes, 4 for the odd ones
+    const int16x8_t shift = vreinterpretq_s16_u32(vdupq_n_u32(0x00040000));
+    const int16x8_t m0    = vreinterpretq_s16_u16(
+        vandq_u16(vshlq_u16(values, shift), vdupq_n_u16(0xfff0)));
+
+    const float32x4_t m1 = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(m0))), scalar);
+    const float32x4_t m2 = vmulq_f32(vcvtq_f32_s32(vmovl_high_s16(m0)), scalar);
+
+    vst1q_f32(reinterpret_cast<float*>(output + 0), m1);
+    vst1q_f32(reinterpret_cast<float*>(output + 2), m2);
+}
+
+template <tohost32_type tohost>
+struct convert_sc12_item32_1_to_fc32_1_neon64 : public converter
+{
+    convert_sc12_item32_1_to_fc32_1_neon64(void) : _scalar(0.0)
+    {
+        // NOP
+    }
+
+    void set_scalar(const double scalar)
+    {
+        const int unpack_growth = 16;
+        _scalar                 = scalar / unpack_growth;
+    }
+
+    void operator()(
+        const input_type& inputs, const output_type& outputs, const size_t nsamps)
+    {
+        const size_t head_samps = size_t(inputs[0]) & 0x3;
+        size_t rewind           = 0;
+        switch (head_samps) {
+            case 0:
+                break;
+            case 1:
+                rewind = 9;
+                break;
+            case 2:
+                rewind = 6;
+                break;
+            case 3:
+                rewind = 3;
+                break;
+        }
+
+        const item32_sc12_3x* input =
+            reinterpret_cast<const item32_sc12_3x*>(size_t(inputs[0]) - rewind);
+        fc32_t* output = reinterpret_cast<fc32_t*>(outputs[0]);
+
+        // helper variables
+        fc32_t dummy0, dummy1, dummy2;
+        size_t i = 0, o = 0;
+
+        // handle the head case
+        switch (head_samps) {
+            case 0:
+                break; // no head
+            case 1:
+                convert_sc12_item32_3_to_star_4<float, tohost>(
+                    input[i++], dummy0, dummy1, dummy2, output[0], _scalar);
+                break;
+            case 2:
+                convert_sc12_item32_3_to_star_4<float, tohost>(
+                    input[i++], dummy0, dummy1, output[0], output[1], _scalar);
+                break;
+            case 3:
+                convert_sc12_item32_3_to_star_4<float, tohost>(
+                    input[i++], dummy0, output[0], output[1], output[2], _scalar);
+                break;
+        }
+        o += head_samps;
+
+        // convert the body, one block at a time
+        const uint8x16_t table = vld1q_u8(tohost == uhd::wtohx<item32_t>
+                                              ? SC12_LE_UNPACK_TABLE
+                                              : SC12_BE_UNPACK_TABLE);
+        const float32x4_t scalar = vdupq_n_f32(float(_scalar));
+        while (o + 3 < nsamps) {
+            convert_sc12_item32_3_to_fc32_4(&input[i], &output[o], table, scalar);
+            i++;
+            o += 4;
+        }
+
+        // handle the tail case
+        const size_t tail_samps = nsamps - o;
+        switch (tail_samps) {
+            case 0:
+                break; // no tail
+            case 1:
+                convert_sc12_item32_3_to_star_4<float, tohost>(
+                    input[i], output[o + 0], dummy0, dummy1, dummy2, _scalar);
+                break;
+            case 2:
+                convert_sc12_item32_3_to_star_4<float, tohost>(
+                    input[i], output[o + 0], output[o + 1], dummy1, dummy2, _scalar);
+                break;
+            case 3:
+                convert_sc12_item32_3_to_star_4<float, tohost>(input[i],
+                    output[o + 0],
+                    output[o + 1],
+                    output[o + 2],
+                    dummy2,
+                    _scalar);
+                break;
+        }
+    }
+
+    double _scalar;
+};
+
+static converter::sptr make_convert_sc12_item32_le_1_to_fc32_1(void)
+{
+    return converter::sptr(new convert_sc12_item32_1_to_fc32_1_neon64<uhd::wtohx>());
+}
+
+static converter::sptr make_convert_sc12_item32_be_1_to_fc32_1(void)
+{
+    return converter::sptr(new convert_sc12_item32_1_to_fc32_1_neon64<uhd::ntohx>());
+}
+
+UHD_STATIC_BLOCK(register_neon64_unpack_sc12)
+{
+    uhd::convert::id_type id;
+    id.num_inputs    = 1;
+    id.num_outputs   = 1;
+    id.output_format = "fc32";
+
+    id.input_format = "sc12_item32_le";
+    uhd::convert::register_converter(
+        id, &make_convert_sc12_item32_le_1_to_fc32_1, PRIORITY_SIMD);
+    id.input_format = "sc12_item32_be";
+    uhd::convert::register_converter(
+        id, &make_convert_sc12_item32_be_1_to_fc32_1, PRIORITY_SIMD);
+}
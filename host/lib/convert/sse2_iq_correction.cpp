@@ -0,0 +1,110 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_iq_correction.hpp"
+#include <emmintrin.h>
+
+using namespace uhd::convert;
+
+/*!
+ * Loads 4 samples of the wire format, as int16 in (I0, Q0, I1, Q1, ...) order
+ */
+template <sc16_wire_t wire>
+UHD_INLINE __m128i load_sc16_x4(const void* input)
+{
+    __m128i tmpi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+    if (wire == sc16_wire_t::ITEM32_LE) {
+        // swap 16-bit pairs
+        tmpi = _mm_shufflelo_epi16(tmpi, _MM_SHUFFLE(2, 3, 0, 1));
+        tmpi = _mm_shufflehi_epi16(tmpi, _MM_SHUFFLE(2, 3, 0, 1));
+    } else if (wire == sc16_wire_t::ITEM32_BE) {
+        // byteswap 16 bit words
+        tmpi = _mm_or_si128(_mm_srli_epi16(tmpi, 8), _mm_slli_epi16(tmpi, 8));
+    }
+    return tmpi;
+}
+
+/*!
+ * Corrects 2 samples, as floats in (I0, Q0, I1, Q1) order
+ *
+ * With the swapped samples (Q0, I0, Q1, I1), the correction is one multiply
+ * add for each of the diagonal and the off-diagonal of the matrix.
+ */
+UHD_INLINE __m128 iq_correct_x2(
+    const __m128 in, const __m128 diag, const __m128 off_diag, const __m128 offset)
+{
+    const __m128 swapped = _mm_shuffle_ps(in, in, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_sub_ps(
+        _mm_add_ps(_mm_mul_ps(in, diag), _mm_mul_ps(swapped, off_diag)), offset);
+}
+
+template <sc16_wire_t wire>
+class sse2_sc16_to_fc32_iq_corrected : public iq_correcting_converter_base
+{
+public:
+    kernel_type get_kernel(void)
+    {
+        return &kernel;
+    }
+
+    static void kernel(converter* self,
+        const input_type& inputs,
+        const output_type& outputs,
+        const size_t nsamps)
+    {
+        static_cast<sse2_sc16_to_fc32_iq_corrected*>(self)
+            ->sse2_sc16_to_fc32_iq_corrected::operator()(inputs, outputs, nsamps);
+    }
+
+    void operator()(
+        const input_type& inputs, const output_type& outputs, const size_t nsamps)
+    {
+        const uint32_t* input = reinterpret_cast<const uint32_t*>(inputs[0]);
+        fc32_t* output        = reinterpret_cast<fc32_t*>(outputs[0]);
+
+        // The samples are converted in the upper 16 bits of each lane, which
+        // the coefficients account for
+        const float s         = 1.f / (1 << 16);
+        const float m00       = coeffs.m[0][0] * s;
+        const float m01       = coeffs.m[0][1] * s;
+        const float m10       = coeffs.m[1][0] * s;
+        const float m11       = coeffs.m[1][1] * s;
+        const __m128 diag     = _mm_setr_ps(m00, m11, m00, m11);
+        const __m128 off_diag = _mm_setr_ps(m01, m10, m01, m10);
+        const __m128 offset   = _mm_setr_ps(
+            coeffs.offset[0], coeffs.offset[1], coeffs.offset[0], coeffs.offset[1]);
+        const __m128i zeroi = _mm_setzero_si128();
+
+        size_t i = 0;
+        for (; i + 3 < nsamps; i += 4) {
+            const __m128i tmpi = load_sc16_x4<wire>(input + i);
+
+            /* value in upper 16 bits */
+            const __m128 tmplo = _mm_cvtepi32_ps(_mm_unpacklo_epi16(zeroi, tmpi));
+            const __m128 tmphi = _mm_cvtepi32_ps(_mm_unpackhi_epi16(zeroi, tmpi));
+
+            _mm_storeu_ps(reinterpret_cast<float*>(output + i + 0),
+                iq_correct_x2(tmplo, diag, off_diag, offset));
+            _mm_storeu_ps(reinterpret_cast<float*>(output + i + 2),
+                iq_correct_x2(tmphi, diag, off_diag, offset));
+        }
+
+        // convert any remaining samples
+        sc16_to_fc32_iq_corrected<wire>(input + i, output + i, nsamps - i, coeffs);
+    }
+};
+
+UHD_STATIC_BLOCK(register_sse2_iq_correction)
+{
+    register_iq_correcting_converter<
+        sse2_sc16_to_fc32_iq_corrected<sc16_wire_t::ITEM32_LE>>(
+        "sc16_item32_le", PRIORITY_SIMD);
+    register_iq_correcting_converter<
+        sse2_sc16_to_fc32_iq_corrected<sc16_wire_t::ITEM32_BE>>(
+        "sc16_item32_be", PRIORITY_SIMD);
+    register_iq_correcting_converter<sse2_sc16_to_fc32_iq_corrected<sc16_wire_t::CHDR>>(
+        "sc16_chdr", PRIORITY_SIMD);
+}
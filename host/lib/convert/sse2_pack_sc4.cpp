@@ -0,0 +1,109 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_sc4.hpp"
+#include <emmintrin.h>
+
+using namespace uhd::convert;
+
+// Packs 4 sc16 samples into the lowest byte of each 32-bit lane
+UHD_INLINE __m128i sc4_lanes_x4(const sc16_t* input, const __m128)
+{
+    // Each lane holds Q in the upper and I in the lower 16 bits
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+    return _mm_or_si128(_mm_and_si128(_mm_srli_epi32(in, 8), _mm_set1_epi32(0xF0)),
+        _mm_srli_epi32(in, 28));
+}
+
+// Packs 4 fc32 samples into the lowest byte of each 32-bit lane
+UHD_INLINE __m128i sc4_lanes_x4(const fc32_t* input, const __m128 scalar)
+{
+    const __m128 min = _mm_set1_ps(-8.f);
+    const __m128 max = _mm_set1_ps(7.f);
+    const __m128 in0 = _mm_loadu_ps(reinterpret_cast<const float*>(input + 0));
+    const __m128 in1 = _mm_loadu_ps(reinterpret_cast<const float*>(input + 2));
+    const __m128i tmpi0 =
+        _mm_cvttps_epi32(_mm_max_ps(min, _mm_min_ps(max, _mm_mul_ps(in0, scalar))));
+    const __m128i tmpi1 =
+        _mm_cvttps_epi32(_mm_max_ps(min, _mm_min_ps(max, _mm_mul_ps(in1, scalar))));
+    // Each lane holds Q in the upper and I in the lower 16 bits
+    const __m128i iq = _mm_packs_epi32(tmpi0, tmpi1);
+    return _mm_or_si128(_mm_and_si128(_mm_slli_epi32(iq, 4), _mm_set1_epi32(0xF0)),
+        _mm_and_si128(_mm_srli_epi32(iq, 16), _mm_set1_epi32(0x0F)));
+}
+
+// Packs 16 samples, reversing each group of 4 if swap is set
+template <bool swap, typename type>
+UHD_INLINE __m128i pack_sc4_x16(const std::complex<type>* input, const __m128 scalar)
+{
+    const int shuf = swap ? _MM_SHUFFLE(0, 1, 2, 3) : _MM_SHUFFLE(3, 2, 1, 0);
+    const __m128i tmpi0 = _mm_shuffle_epi32(sc4_lanes_x4(input + 0, scalar), shuf);
+    const __m128i tmpi1 = _mm_shuffle_epi32(sc4_lanes_x4(input + 4, scalar), shuf);
+    const __m128i tmpi2 = _mm_shuffle_epi32(sc4_lanes_x4(input + 8, scalar), shuf);
+    const __m128i tmpi3 = _mm_shuffle_epi32(sc4_lanes_x4(input + 12, scalar), shuf);
+
+    const __m128i lo = _mm_packs_epi32(tmpi0, tmpi1);
+    const __m128i hi = _mm_packs_epi32(tmpi2, tmpi3);
+    return _mm_packus_epi16(lo, hi);
+}
+
+template <bool swap, typename type>
+UHD_INLINE void sse2_pack_sc4(const std::complex<type>* input,
+    void* output,
+    const size_t nsamps,
+    const double scale_factor)
+{
+    const __m128 scalar = _mm_set_ps1(float(scale_factor));
+
+    // pack the samples up to the next item32 boundary one by one
+    size_t i = sc4_head_samps(output, nsamps);
+    pack_sc4<swap>(input, output, i, float(scale_factor));
+
+    uint8_t* out = reinterpret_cast<uint8_t*>(output);
+    for (; i + 15 < nsamps; i += 16) {
+        const __m128i tmpi = pack_sc4_x16<swap>(input + i, scalar);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), tmpi);
+    }
+
+    // convert remainder
+    pack_sc4<swap>(input + i, out + i, nsamps - i, float(scale_factor));
+}
+
+DECLARE_CONVERTER(fc32, 1, sc4_item32_be, 1, PRIORITY_SIMD)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    sse2_pack_sc4<false>(input, outputs[0], nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(fc32, 1, sc4_item32_le, 1, PRIORITY_SIMD)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    sse2_pack_sc4<true>(input, outputs[0], nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(fc32, 1, sc4_chdr, 1, PRIORITY_SIMD)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    sse2_pack_sc4<false>(input, outputs[0], nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(sc16, 1, sc4_item32_be, 1, PRIORITY_SIMD)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    sse2_pack_sc4<false>(input, outputs[0], nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(sc16, 1, sc4_item32_le, 1, PRIORITY_SIMD)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    sse2_pack_sc4<true>(input, outputs[0], nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(sc16, 1, sc4_chdr, 1, PRIORITY_SIMD)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    sse2_pack_sc4<false>(input, outputs[0], nsamps, scale_factor);
+}
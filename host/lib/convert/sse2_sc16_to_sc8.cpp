@@ -0,0 +1,87 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <emmintrin.h>
+
+using namespace uhd::convert;
+
+/*
+ * These replace the sc16 to sc8 lookup table, which takes 64 KiB of cache. The
+ * samples are scaled in floating point, and rounded half away from zero like
+ * the table. Unlike the table, out of range values saturate.
+ */
+
+// Scales 4 values and rounds them half away from zero
+UHD_INLINE __m128i quantize_sc8_4x(const __m128i in, const __m128 factor)
+{
+    const __m128 scaled = _mm_mul_ps(_mm_cvtepi32_ps(in), factor);
+    const __m128 half =
+        _mm_or_ps(_mm_and_ps(scaled, _mm_set1_ps(-0.f)), _mm_set1_ps(SC8_ROUND_HALF));
+    const __m128 rounded = _mm_max_ps(
+        _mm_set1_ps(-129.f), _mm_min_ps(_mm_set1_ps(128.f), _mm_add_ps(scaled, half)));
+    return _mm_cvttps_epi32(rounded);
+}
+
+// Converts 8 sc16 samples to saturated sc8
+template <const int shuf>
+UHD_INLINE __m128i sc16_x8_to_sc8(const sc16_t* input, const __m128 factor)
+{
+    const __m128i in0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 0));
+    const __m128i in1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 4));
+
+    // sign extend to 32 bits
+    __m128i tmpi0 = _mm_srai_epi32(_mm_unpacklo_epi16(in0, in0), 16);
+    __m128i tmpi1 = _mm_srai_epi32(_mm_unpackhi_epi16(in0, in0), 16);
+    __m128i tmpi2 = _mm_srai_epi32(_mm_unpacklo_epi16(in1, in1), 16);
+    __m128i tmpi3 = _mm_srai_epi32(_mm_unpackhi_epi16(in1, in1), 16);
+
+    tmpi0 = _mm_shuffle_epi32(quantize_sc8_4x(tmpi0, factor), shuf);
+    tmpi1 = _mm_shuffle_epi32(quantize_sc8_4x(tmpi1, factor), shuf);
+    tmpi2 = _mm_shuffle_epi32(quantize_sc8_4x(tmpi2, factor), shuf);
+    tmpi3 = _mm_shuffle_epi32(quantize_sc8_4x(tmpi3, factor), shuf);
+
+    const __m128i lo = _mm_packs_epi32(tmpi0, tmpi1);
+    const __m128i hi = _mm_packs_epi32(tmpi2, tmpi3);
+    return _mm_packs_epi16(lo, hi);
+}
+
+DECLARE_CONVERTER(sc16, 1, sc8_item32_be, 1, PRIORITY_SIMD)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const __m128 factor = _mm_set_ps1(sc16_to_sc8_factor(scale_factor));
+    const int shuf      = _MM_SHUFFLE(3, 2, 1, 0);
+
+    size_t i = 0;
+    for (size_t j = 0; i + 7 < nsamps; i += 8, j += 4) {
+        const __m128i tmpi = sc16_x8_to_sc8<shuf>(input + i, factor);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + j), tmpi);
+    }
+
+    // convert remainder
+    sc16_to_item32_sc8<uhd::htonx>(input + i, output + (i / 2), nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER(sc16, 1, sc8_item32_le, 1, PRIORITY_SIMD)
+{
+    const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    const __m128 factor = _mm_set_ps1(sc16_to_sc8_factor(scale_factor));
+    const int shuf      = _MM_SHUFFLE(0, 1, 2, 3);
+
+    size_t i = 0;
+    for (size_t j = 0; i + 7 < nsamps; i += 8, j += 4) {
+        const __m128i tmpi = sc16_x8_to_sc8<shuf>(input + i, factor);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + j), tmpi);
+    }
+
+    // convert remainder
+    sc16_to_item32_sc8<uhd::htowx>(input + i, output + (i / 2), nsamps - i, scale_factor);
+}
@@ -0,0 +1,237 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_signal_stats.hpp"
+#include <emmintrin.h>
+
+using namespace uhd::convert;
+
+/*!
+ * Swaps 4 samples between (I0, Q0, I1, Q1, ...) int16 order and the wire
+ * format, which is the same in both directions
+ */
+template <sc16_wire_t wire>
+UHD_INLINE __m128i swap_sc16_x4(__m128i tmpi)
+{
+    if (wire == sc16_wire_t::ITEM32_LE) {
+        // swap 16-bit pairs
+        tmpi = _mm_shufflelo_epi16(tmpi, _MM_SHUFFLE(2, 3, 0, 1));
+        tmpi = _mm_shufflehi_epi16(tmpi, _MM_SHUFFLE(2, 3, 0, 1));
+    } else if (wire == sc16_wire_t::ITEM32_BE) {
+        // byteswap 16 bit words
+        tmpi = _mm_or_si128(_mm_srli_epi16(tmpi, 8), _mm_slli_epi16(tmpi, 8));
+    }
+    return tmpi;
+}
+
+/*!
+ * Statistics of the samples in the lanes of SSE registers, with the floats in
+ * (I0, Q0, I1, Q1) order
+ */
+struct sse2_stats_t
+{
+    __m128 sum      = _mm_setzero_ps();
+    __m128 sum_sq   = _mm_setzero_ps();
+    __m128 peak     = _mm_setzero_ps();
+    __m128i clipped = _mm_setzero_si128();
+
+    //! Adds 2 samples
+    UHD_INLINE void add_x2(const __m128 in)
+    {
+        sum             = _mm_add_ps(sum, in);
+        const __m128 sq = _mm_mul_ps(in, in);
+        sum_sq          = _mm_add_ps(sum_sq, sq);
+        // The power of each sample, in both of its lanes
+        const __m128 power =
+            _mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 3, 0, 1)));
+        peak = _mm_max_ps(peak, power);
+    }
+
+    //! Adds the lanes to the statistics of a block
+    UHD_INLINE void add_to(block_stats_t& block) const
+    {
+        alignas(16) float f[4];
+        _mm_store_ps(f, sum);
+        block.sum_i += f[0] + f[2];
+        block.sum_q += f[1] + f[3];
+        _mm_store_ps(f, sum_sq);
+        block.sum_power += f[0] + f[1] + f[2] + f[3];
+        _mm_store_ps(f, peak);
+        block.peak_power = std::max({block.peak_power, f[0], f[2]});
+        alignas(16) int32_t n[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(n), clipped);
+        block.num_clipped += uint64_t(n[0]) + n[1] + n[2] + n[3];
+    }
+};
+
+template <sc16_wire_t wire>
+class sse2_sc16_to_fc32_with_stats : public signal_stats_converter_base
+{
+public:
+    kernel_type get_kernel(void)
+    {
+        return &kernel;
+    }
+
+    static void kernel(converter* self,
+        const input_type& inputs,
+        const output_type& outputs,
+        const size_t nsamps)
+    {
+        static_cast<sse2_sc16_to_fc32_with_stats*>(self)
+            ->sse2_sc16_to_fc32_with_stats::operator()(inputs, outputs, nsamps);
+    }
+
+    void operator()(
+        const input_type& inputs, const output_type& outputs, const size_t nsamps)
+    {
+        const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
+        fc32_t* output      = reinterpret_cast<fc32_t*>(outputs[0]);
+        const float scalar  = float(_scalar);
+        convert_blocks(nsamps, [&](const size_t i, const size_t n, block_stats_t& block) {
+            _convert(input + i, output + i, n, scalar, block);
+        });
+    }
+
+private:
+    static UHD_INLINE void _convert(const sc16_t* input,
+        fc32_t* output,
+        const size_t nsamps,
+        const float scalar,
+        block_stats_t& block)
+    {
+        // The samples are converted in the upper 16 bits of each lane, which
+        // the scale factor accounts for
+        const __m128 scale   = _mm_set_ps1(scalar / (1 << 16));
+        const __m128i zeroi  = _mm_setzero_si128();
+        const __m128i ones   = _mm_set1_epi16(1);
+        const __m128i max_16 = _mm_set1_epi16(INT16_MAX);
+        const __m128i min_16 = _mm_set1_epi16(INT16_MIN);
+        sse2_stats_t stats;
+
+        size_t i = 0;
+        for (; i + 3 < nsamps; i += 4) {
+            const __m128i tmpi = swap_sc16_x4<wire>(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)));
+
+            // Clipped values are -1 in their 16-bit lanes, which the
+            // multiply-add sums up in pairs
+            const __m128i clip = _mm_or_si128(
+                _mm_cmpeq_epi16(tmpi, max_16), _mm_cmpeq_epi16(tmpi, min_16));
+            stats.clipped = _mm_sub_epi32(stats.clipped, _mm_madd_epi16(clip, ones));
+
+            /* value in upper 16 bits */
+            const __m128 tmplo =
+                _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(zeroi, tmpi)), scale);
+            const __m128 tmphi =
+                _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(zeroi, tmpi)), scale);
+            stats.add_x2(tmplo);
+            stats.add_x2(tmphi);
+
+            _mm_storeu_ps(reinterpret_cast<float*>(output + i + 0), tmplo);
+            _mm_storeu_ps(reinterpret_cast<float*>(output + i + 2), tmphi);
+        }
+        stats.add_to(block);
+
+        // convert any remaining samples
+        sc16_to_fc32_with_stats<wire>(input + i, output + i, nsamps - i, scalar, block);
+    }
+};
+
+template <sc16_wire_t wire>
+class sse2_fc32_to_sc16_with_stats : public signal_stats_converter_base
+{
+public:
+    kernel_type get_kernel(void)
+    {
+        return &kernel;
+    }
+
+    static void kernel(converter* self,
+        const input_type& inputs,
+        const output_type& outputs,
+        const size_t nsamps)
+    {
+        static_cast<sse2_fc32_to_sc16_with_stats*>(self)
+            ->sse2_fc32_to_sc16_with_stats::operator()(inputs, outputs, nsamps);
+    }
+
+    void operator()(
+        const input_type& inputs, const output_type& outputs, const size_t nsamps)
+    {
+        const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+        sc16_t* output      = reinterpret_cast<sc16_t*>(outputs[0]);
+        const float scalar  = float(_scalar);
+        convert_blocks(nsamps, [&](const size_t i, const size_t n, block_stats_t& block) {
+            _convert(input + i, output + i, n, scalar, block);
+        });
+    }
+
+private:
+    //! Counts the scaled values that saturate, and clamps them
+    static UHD_INLINE __m128 _saturate(
+        const __m128 in, const __m128 max_16, const __m128 min_16, __m128i& clipped)
+    {
+        const __m128 sat = _mm_or_ps(_mm_cmpgt_ps(in, max_16), _mm_cmplt_ps(in, min_16));
+        // Saturated values are -1 in their lanes
+        clipped = _mm_sub_epi32(clipped, _mm_castps_si128(sat));
+        return _mm_min_ps(_mm_max_ps(in, min_16), max_16);
+    }
+
+    static UHD_INLINE void _convert(const fc32_t* input,
+        sc16_t* output,
+        const size_t nsamps,
+        const float scalar,
+        block_stats_t& block)
+    {
+        const __m128 scale  = _mm_set_ps1(scalar);
+        const __m128 max_16 = _mm_set_ps1(float(INT16_MAX));
+        const __m128 min_16 = _mm_set_ps1(float(INT16_MIN));
+        sse2_stats_t stats;
+
+        size_t i = 0;
+        for (; i + 3 < nsamps; i += 4) {
+            const __m128 tmplo = _mm_loadu_ps(reinterpret_cast<const float*>(input + i));
+            const __m128 tmphi =
+                _mm_loadu_ps(reinterpret_cast<const float*>(input + i + 2));
+            stats.add_x2(tmplo);
+            stats.add_x2(tmphi);
+
+            /* scale, saturate and convert */
+            const __m128i tmpilo = _mm_cvtps_epi32(
+                _saturate(_mm_mul_ps(tmplo, scale), max_16, min_16, stats.clipped));
+            const __m128i tmpihi = _mm_cvtps_epi32(
+                _saturate(_mm_mul_ps(tmphi, scale), max_16, min_16, stats.clipped));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                swap_sc16_x4<wire>(_mm_packs_epi32(tmpilo, tmpihi)));
+        }
+        stats.add_to(block);
+
+        // convert any remaining samples
+        fc32_to_sc16_with_stats<wire>(input + i, output + i, nsamps - i, scalar, block);
+    }
+};
+
+UHD_STATIC_BLOCK(register_sse2_signal_stats)
+{
+    register_signal_stats_converter<
+        sse2_sc16_to_fc32_with_stats<sc16_wire_t::ITEM32_LE>>(
+        "sc16_item32_le", "fc32", PRIORITY_SIMD);
+    register_signal_stats_converter<
+        sse2_sc16_to_fc32_with_stats<sc16_wire_t::ITEM32_BE>>(
+        "sc16_item32_be", "fc32", PRIORITY_SIMD);
+    register_signal_stats_converter<sse2_sc16_to_fc32_with_stats<sc16_wire_t::CHDR>>(
+        "sc16_chdr", "fc32", PRIORITY_SIMD);
+    register_signal_stats_converter<
+        sse2_fc32_to_sc16_with_stats<sc16_wire_t::ITEM32_LE>>(
+        "fc32", "sc16_item32_le", PRIORITY_SIMD);
+    register_signal_stats_converter<
+        sse2_fc32_to_sc16_with_stats<sc16_wire_t::ITEM32_BE>>(
+        "fc32", "sc16_item32_be", PRIORITY_SIMD);
+    register_signal_stats_converter<sse2_fc32_to_sc16_with_stats<sc16_wire_t::CHDR>>(
+        "fc32", "sc16_chdr", PRIORITY_SIMD);
+}
@@ -0,0 +1,115 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_sc4.hpp"
+#include <emmintrin.h>
+
+using namespace uhd::convert;
+
+/*
+ * Unpacks 16 sc4 samples to sc16, 4 samples per register
+ *
+ * Each byte is copied into the I and the Q half of a 32-bit lane. The nibble
+ * of I is already in the upper bits of its half, and a multiplication by 16
+ * moves the nibble of Q there.
+ */
+template <bool swap>
+UHD_INLINE void unpack_sc4_x16(const uint8_t* input, __m128i out[4])
+{
+    const int shuf     = swap ? _MM_SHUFFLE(0, 1, 2, 3) : _MM_SHUFFLE(3, 2, 1, 0);
+    const __m128i mul  = _mm_set1_epi32(0x00100001);
+    const __m128i mask = _mm_set1_epi16(int16_t(0xF000));
+
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+    const __m128i lo = _mm_unpacklo_epi8(in, in);
+    const __m128i hi = _mm_unpackhi_epi8(in, in);
+
+    out[0] = _mm_and_si128(_mm_mullo_epi16(_mm_unpacklo_epi16(lo, lo), mul), mask);
+    out[1] = _mm_and_si128(_mm_mullo_epi16(_mm_unpackhi_epi16(lo, lo), mul), mask);
+    out[2] = _mm_and_si128(_mm_mullo_epi16(_mm_unpacklo_epi16(hi, hi), mul), mask);
+    out[3] = _mm_and_si128(_mm_mullo_epi16(_mm_unpackhi_epi16(hi, hi), mul), mask);
+    for (size_t k = 0; k < 4; k++) {
+        out[k] = _mm_shuffle_epi32(out[k], shuf);
+    }
+}
+
+UHD_INLINE void store_x4(const __m128i in, sc16_t* output, const __m128)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output), in);
+}
+
+UHD_INLINE void store_x4(const __m128i in, fc32_t* output, const __m128 factor)
+{
+    // sign extend to 32 bits
+    const __m128i tmpi0 = _mm_srai_epi32(_mm_unpacklo_epi16(in, in), 16);
+    const __m128i tmpi1 = _mm_srai_epi32(_mm_unpackhi_epi16(in, in), 16);
+    _mm_storeu_ps(reinterpret_cast<float*>(output + 0),
+        _mm_mul_ps(_mm_cvtepi32_ps(tmpi0), factor));
+    _mm_storeu_ps(reinterpret_cast<float*>(output + 2),
+        _mm_mul_ps(_mm_cvtepi32_ps(tmpi1), factor));
+}
+
+template <bool swap, typename type>
+UHD_INLINE void sse2_unpack_sc4(const void* input,
+    std::complex<type>* output,
+    const size_t nsamps,
+    const double scale_factor)
+{
+    const float factor = sc4_unpack_factor(scale_factor);
+    const __m128 scalar = _mm_set_ps1(factor);
+
+    // unpack the samples up to the next item32 boundary one by one
+    size_t i = sc4_head_samps(input, nsamps);
+    unpack_sc4<swap>(input, output, i, factor);
+
+    const uint8_t* in = reinterpret_cast<const uint8_t*>(input);
+    for (; i + 15 < nsamps; i += 16) {
+        __m128i tmpi[4];
+        unpack_sc4_x16<swap>(in + i, tmpi);
+        for (size_t k = 0; k < 4; k++) {
+            store_x4(tmpi[k], output + i + 4 * k, scalar);
+        }
+    }
+
+    // convert remainder
+    unpack_sc4<swap>(in + i, output + i, nsamps - i, factor);
+}
+
+DECLARE_CONVERTER(sc4_item32_be, 1, fc32, 1, PRIORITY_SIMD)
+{
+    fc32_t* output = reinterpret_cast<fc32_t*>(outputs[0]);
+    sse2_unpack_sc4<false>(inputs[0], output, nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(sc4_item32_le, 1, fc32, 1, PRIORITY_SIMD)
+{
+    fc32_t* output = reinterpret_cast<fc32_t*>(outputs[0]);
+    sse2_unpack_sc4<true>(inputs[0], output, nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(sc4_chdr, 1, fc32, 1, PRIORITY_SIMD)
+{
+    fc32_t* output = reinterpret_cast<fc32_t*>(outputs[0]);
+    sse2_unpack_sc4<false>(inputs[0], output, nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(sc4_item32_be, 1, sc16, 1, PRIORITY_SIMD)
+{
+    sc16_t* output = reinterpret_cast<sc16_t*>(outputs[0]);
+    sse2_unpack_sc4<false>(inputs[0], output, nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(sc4_item32_le, 1, sc16, 1, PRIORITY_SIMD)
+{
+    sc16_t* output = reinterpret_cast<sc16_t*>(outputs[0]);
+    sse2_unpack_sc4<true>(inputs[0], output, nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(sc4_chdr, 1, sc16, 1, PRIORITY_SIMD)
+{
+    sc16_t* output = reinterpret_cast<sc16_t*>(outputs[0]);
+    sse2_unpack_sc4<false>(inputs[0], output, nsamps, scale_factor);
+}
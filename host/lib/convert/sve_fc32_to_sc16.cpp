@@ -0,0 +1,85 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <arm_sve.h>
+
+using namespace uhd::convert;
+
+/*
+ * The SVE kernels work for any vector length, see sve_sc16_to_fc32.cpp
+ */
+
+/*
+ * Scale values, and round them to nearest. They are saturated before the
+ * conversion, which leaves them in the range of int16.
+ */
+UHD_CONVERT_TARGET_SVE UHD_INLINE svint32_t quantize_s16(
+    const svbool_t pg, const svfloat32_t in, const float scalar)
+{
+    const svfloat32_t scaled = svmul_n_f32_x(pg, in, scalar);
+    const svfloat32_t clamped =
+        svmin_n_f32_x(pg, svmax_n_f32_x(pg, scaled, -32768.f), 32767.f);
+    return svcvt_s32_f32_x(pg, svrintn_f32_x(pg, clamped));
+}
+
+/*
+ * Convert fc32 samples to sc16, one per 32-bit lane. I goes into the upper
+ * half of the lanes for the item32 formats, and into the lower half for CHDR.
+ */
+template <bool i_in_upper_half>
+UHD_CONVERT_TARGET_SVE UHD_INLINE svint32_t fc32_to_sc16_items(
+    const svbool_t pg, const float* input, const float scalar)
+{
+    const svfloat32x2_t in = svld2_f32(pg, input);
+    const svint32_t re     = quantize_s16(pg, svget2_f32(in, 0), scalar);
+    const svint32_t im     = quantize_s16(pg, svget2_f32(in, 1), scalar);
+
+    const svint32_t upper = i_in_upper_half ? re : im;
+    const svint32_t lower = i_in_upper_half ? im : re;
+    return svorr_s32_x(
+        pg, svlsl_n_s32_x(pg, upper, 16), svand_n_s32_x(pg, lower, 0xffff));
+}
+
+DECLARE_CONVERTER_FOR_CPU(fc32, 1, sc16_item32_le, 1, PRIORITY_SIMD_SVE, SVE)
+{
+    const float* input = reinterpret_cast<const float*>(inputs[0]);
+    int32_t* output    = reinterpret_cast<int32_t*>(outputs[0]);
+
+    const float scalar = float(scale_factor);
+
+    for (size_t i = 0; i < nsamps; i += svcntw()) {
+        const svbool_t pg = svwhilelt_b32(uint64_t(i), uint64_t(nsamps));
+        svst1_s32(pg, output + i, fc32_to_sc16_items<true>(pg, input + 2 * i, scalar));
+    }
+}
+
+DECLARE_CONVERTER_FOR_CPU(fc32, 1, sc16_item32_be, 1, PRIORITY_SIMD_SVE, SVE)
+{
+    const float* input = reinterpret_cast<const float*>(inputs[0]);
+    int32_t* output    = reinterpret_cast<int32_t*>(outputs[0]);
+
+    const float scalar = float(scale_factor);
+
+    for (size_t i = 0; i < nsamps; i += svcntw()) {
+        const svbool_t pg     = svwhilelt_b32(uint64_t(i), uint64_t(nsamps));
+        const svint32_t items = fc32_to_sc16_items<true>(pg, input + 2 * i, scalar);
+        svst1_s32(pg, output + i, svrevb_s32_x(pg, items));
+    }
+}
+
+DECLARE_CONVERTER_FOR_CPU(fc32, 1, sc16_chdr, 1, PRIORITY_SIMD_SVE, SVE)
+{
+    const float* input = reinterpret_cast<const float*>(inputs[0]);
+    int32_t* output    = reinterpret_cast<int32_t*>(outputs[0]);
+
+    const float scalar = float(scale_factor);
+
+    for (size_t i = 0; i < nsamps; i += svcntw()) {
+        const svbool_t pg = svwhilelt_b32(uint64_t(i), uint64_t(nsamps));
+        svst1_s32(pg, output + i, fc32_to_sc16_items<false>(pg, input + 2 * i, scalar));
+    }
+}
@@ -0,0 +1,75 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <arm_sve.h>
+
+using namespace uhd::convert;
+
+/*
+ * The SVE kernels work for any vector length. Each iteration converts one
+ * item32 per 32-bit lane, and the predicate of the last iteration masks off
+ * the lanes past the end of the buffer, so there is no scalar tail.
+ */
+
+/*
+ * Convert sc16 samples, one per 32-bit lane, to fc32. I is in the upper half
+ * of the lanes for the item32 formats, and in the lower half for CHDR.
+ */
+template <bool i_in_upper_half>
+UHD_CONVERT_TARGET_SVE UHD_INLINE void sc16_items_to_fc32(
+    const svbool_t pg, const svint32_t items, float* output, const float scalar)
+{
+    const svint32_t upper = svasr_n_s32_x(pg, items, 16);
+    const svint32_t lower = svasr_n_s32_x(pg, svlsl_n_s32_x(pg, items, 16), 16);
+
+    const svfloat32_t re =
+        svmul_n_f32_x(pg, svcvt_f32_s32_x(pg, i_in_upper_half ? upper : lower), scalar);
+    const svfloat32_t im =
+        svmul_n_f32_x(pg, svcvt_f32_s32_x(pg, i_in_upper_half ? lower : upper), scalar);
+
+    svst2_f32(pg, output, svcreate2_f32(re, im));
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16_item32_le, 1, fc32, 1, PRIORITY_SIMD_SVE, SVE)
+{
+    const int32_t* input = reinterpret_cast<const int32_t*>(inputs[0]);
+    float* output        = reinterpret_cast<float*>(outputs[0]);
+
+    const float scalar = float(scale_factor);
+
+    for (size_t i = 0; i < nsamps; i += svcntw()) {
+        const svbool_t pg = svwhilelt_b32(uint64_t(i), uint64_t(nsamps));
+        sc16_items_to_fc32<true>(pg, svld1_s32(pg, input + i), output + 2 * i, scalar);
+    }
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16_item32_be, 1, fc32, 1, PRIORITY_SIMD_SVE, SVE)
+{
+    const int32_t* input = reinterpret_cast<const int32_t*>(inputs[0]);
+    float* output        = reinterpret_cast<float*>(outputs[0]);
+
+    const float scalar = float(scale_factor);
+
+    for (size_t i = 0; i < nsamps; i += svcntw()) {
+        const svbool_t pg     = svwhilelt_b32(uint64_t(i), uint64_t(nsamps));
+        const svint32_t items = svrevb_s32_x(pg, svld1_s32(pg, input + i));
+        sc16_items_to_fc32<true>(pg, items, output + 2 * i, scalar);
+    }
+}
+
+DECLARE_CONVERTER_FOR_CPU(sc16_chdr, 1, fc32, 1, PRIORITY_SIMD_SVE, SVE)
+{
+    const int32_t* input = reinterpret_cast<const int32_t*>(inputs[0]);
+    float* output        = reinterpret_cast<float*>(outputs[0]);
+
+    const float scalar = float(scale_factor);
+
+    for (size_t i = 0; i < nsamps; i += svcntw()) {
+        const svbool_t pg = svwhilelt_b32(uint64_t(i), uint64_t(nsamps));
+        sc16_items_to_fc32<false>(pg, svld1_s32(pg, input + i), output + 2 * i, scalar);
+    }
+}
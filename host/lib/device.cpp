@@ -11,6 +11,7 @@
 #include <uhd/utils/algorithm.hpp>
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/static.hpp>
+#include <uhdlib/utils/init_timeline.hpp>
 #include <uhdlib/utils/prefs.hpp>
 #include <boost/format.hpp>
 #include <boost/functional/hash.hpp>
@@ -111,21 +112,25 @@ device_addrs_t device::find(const device_addr_t& hint, device_filter_t filter)
 device::sptr device::make(const device_addr_t& hint, device_filter_t filter, size_t which)
 {
     boost::mutex::scoped_lock lock(_device_mutex);
+    init_timeline::scoped_span make_span("device::make");
 
     typedef std::tuple<device_addr_t, make_t> dev_addr_make_t;
     std::vector<dev_addr_make_t> dev_addr_makers;
 
-    for (const dev_fcn_reg_t& fcn : get_dev_fcn_regs()) {
-        try {
-            if (filter == ANY or std::get<2>(fcn) == filter) {
-                for (device_addr_t dev_addr : std::get<0>(fcn)(hint)) {
-                    // append the discovered address and its factory function
-                    dev_addr_makers.push_back(
-                        dev_addr_make_t(dev_addr, std::get<1>(fcn)));
+    {
+        init_timeline::scoped_span find_span("find");
+        for (const dev_fcn_reg_t& fcn : get_dev_fcn_regs()) {
+            try {
+                if (filter == ANY or std::get<2>(fcn) == filter) {
+                    for (device_addr_t dev_addr : std::get<0>(fcn)(hint)) {
+                        // append the discovered address and its factory function
+                        dev_addr_makers.push_back(
+                            dev_addr_make_t(dev_addr, std::get<1>(fcn)));
+                    }
                 }
+            } catch (const std::exception& e) {
+                UHD_LOGGER_ERROR("UHD") << "Device discovery error: " << e.what();
             }
-        } catch (const std::exception& e) {
-            UHD_LOGGER_ERROR("UHD") << "Device discovery error: " << e.what();
         }
     }
 
@@ -165,6 +170,7 @@ device::sptr device::make(const device_addr_t& hint, device_filter_t filter, siz
         // Add keys from the config files (note: the user-defined keys will
         // always be applied, see also get_usrp_args()
         // Then, create and register a new device.
+        init_timeline::scoped_span init_span("init " + dev_addr.get("type", "device"));
         device::sptr dev         = maker(prefs::get_usrp_args(dev_addr));
         hash_to_device[dev_hash] = dev;
         return dev;
@@ -15,8 +15,11 @@
 #include <boost/graph/topological_sort.hpp>
 #include <boost/thread.hpp>
 #include <boost/thread/mutex.hpp>
+#include <algorithm>
 #include <functional>
+#include <iterator>
 #include <memory>
+#include <vector>
 
 #ifdef UHD_EXPERT_LOGGING
 #    define EX_LOG(depth, str) _log(depth, str)
@@ -39,7 +42,6 @@ typedef boost::adjacency_list<boost::vecS, // Container used to represent the ed
     expert_graph_t;
 
 typedef std::map<std::string, expert_graph_t::vertex_descriptor> vertex_map_t;
-typedef std::list<expert_graph_t::vertex_descriptor> node_queue_t;
 
 typedef boost::graph_traits<expert_graph_t>::edge_iterator edge_iter;
 typedef boost::graph_traits<expert_graph_t>::vertex_iterator vertex_iter;
@@ -83,27 +85,25 @@ public:
         boost::lock_guard<boost::mutex> lock(_mutex);
         EX_LOG(0, str(boost::format("resolve_all(%s)") % (force ? "force" : "")));
         // Do a full resolve of the graph
-        _resolve_helper("", "", force);
+        _resolve_helper("", CONE_ALL, force);
     }
 
-    void resolve_from(const std::string&)
+    void resolve_from(const std::string& node_name)
     {
         boost::lock_guard<boost::recursive_mutex> resolve_lock(_resolve_mutex);
         boost::lock_guard<boost::mutex> lock(_mutex);
-        EX_LOG(0, "resolve_from (overridden to resolve_all)");
-        // Do a full resolve of the graph
-        // Not optimizing the traversal using node_name to reduce experts complexity
-        _resolve_helper("", "", false);
+        EX_LOG(0, str(boost::format("resolve_from(%s)") % node_name));
+        // Only resolve the nodes that depend on node_name
+        _resolve_helper(node_name, CONE_DOWNSTREAM, false);
     }
 
-    void resolve_to(const std::string&)
+    void resolve_to(const std::string& node_name)
     {
         boost::lock_guard<boost::recursive_mutex> resolve_lock(_resolve_mutex);
         boost::lock_guard<boost::mutex> lock(_mutex);
-        EX_LOG(0, "resolve_to (overridden to resolve_all)");
-        // Do a full resolve of the graph
-        // Not optimizing the traversal using node_name to reduce experts complexity
-        _resolve_helper("", "", false);
+        EX_LOG(0, str(boost::format("resolve_to(%s)") % node_name));
+        // Only resolve the nodes that node_name depends on
+        _resolve_helper(node_name, CONE_UPSTREAM, false);
     }
 
     dag_vertex_t& retrieve(const std::string& name) const
@@ -302,6 +302,7 @@ protected:
 
         try {
             // Add a vertex in this graph for the data node
+            _order_valid = false;
             expert_graph_t::vertex_descriptor gr_node =
                 boost::add_vertex(data_node, _expert_dag);
             EX_LOG(1, str(boost::format("added vertex %s") % data_node->get_name()));
@@ -351,6 +352,7 @@ protected:
 
         try {
             // Add a vertex in this graph for the worker node
+            _order_valid = false;
             expert_graph_t::vertex_descriptor gr_node =
                 boost::add_vertex(worker, _expert_dag);
             EX_LOG(1, str(boost::format("added vertex %s") % worker->get_name()));
@@ -423,6 +425,7 @@ protected:
 
         // Release all vertices and edges in the DAG
         _expert_dag.clear();
+        _order_valid = false;
 
         // Release all nodes in the map
         _worker_map.clear();
@@ -430,13 +433,27 @@ protected:
     }
 
 private:
-    void _resolve_helper(std::string start, std::string stop, bool force)
+    //! The part of the graph that a resolve covers
+    enum resolve_cone_t {
+        CONE_ALL, //!< All nodes
+        CONE_DOWNSTREAM, //!< The node and the nodes that depend on it
+        CONE_UPSTREAM //!< The node and the nodes it depends on
+    };
+
+    //! Sort the graph topologically, unless it hasn't changed since the last sort
+    //
+    // This ensures that for all dependencies, the dependant is always after all
+    // of its dependencies. The neighbours of every node are stored by their
+    // position in the order, so that resolves can walk parts of the graph
+    // without searching the edge lists.
+    void _update_order()
     {
-        // Sort the graph topologically. This ensures that for all dependencies, the
-        // dependant is always after all of its dependencies.
-        node_queue_t sorted_nodes;
+        if (_order_valid) {
+            return;
+        }
+        _sorted_nodes.clear();
         try {
-            boost::topological_sort(_expert_dag, std::front_inserter(sorted_nodes));
+            boost::topological_sort(_expert_dag, std::back_inserter(_sorted_nodes));
         } catch (boost::not_a_dag&) {
             std::vector<std::string> back_edges;
             cycle_det_visitor cdet_vis(back_edges);
@@ -452,60 +469,94 @@ private:
                     + edges);
             }
         }
-        if (sorted_nodes.empty())
+        std::reverse(_sorted_nodes.begin(), _sorted_nodes.end());
+
+        const size_t num_nodes = _sorted_nodes.size();
+        _topo_index.assign(boost::num_vertices(_expert_dag), 0);
+        for (size_t pos = 0; pos < num_nodes; pos++) {
+            _topo_index[_sorted_nodes[pos]] = pos;
+        }
+        _successors.assign(num_nodes, std::vector<size_t>());
+        _predecessors.assign(num_nodes, std::vector<size_t>());
+        for (std::pair<edge_iter, edge_iter> ei = boost::edges(_expert_dag);
+             ei.first != ei.second;
+             ++ei.first) {
+            const size_t src = _topo_index[boost::source(*(ei.first), _expert_dag)];
+            const size_t dst = _topo_index[boost::target(*(ei.first), _expert_dag)];
+            _successors[src].push_back(dst);
+            _predecessors[dst].push_back(src);
+        }
+        _order_valid = true;
+    }
+
+    void _resolve_helper(const std::string& node_name, resolve_cone_t cone, bool force)
+    {
+        _update_order();
+        if (_sorted_nodes.empty())
             return;
 
-        // Determine the start and stop node. If one is not explicitly specified then
-        // resolve everything
-        expert_graph_t::vertex_descriptor start_vertex = sorted_nodes.front();
-        expert_graph_t::vertex_descriptor stop_vertex  = sorted_nodes.back();
-        if (not start.empty())
-            start_vertex = _lookup_vertex(start);
-        if (not stop.empty())
-            stop_vertex = _lookup_vertex(stop);
-
-        // First Pass: Resolve all nodes if they are dirty, in a topological order
-        std::list<dag_vertex_t*> resolved_workers;
-        bool start_node_encountered = false;
-        for (node_queue_t::iterator node_iter = sorted_nodes.begin();
-             node_iter != sorted_nodes.end();
-             ++node_iter) {
-            // Determine if we are at or beyond the starting node
-            if (*node_iter == start_vertex)
-                start_node_encountered = true;
-
-            // Only resolve if the starting node has passed
-            if (start_node_encountered) {
-                dag_vertex_t& node = _get_vertex(*node_iter);
-                std::string node_val;
-                if (force or node.is_dirty()) {
-                    node.resolve();
-                    if (node.get_class() == CLASS_WORKER) {
-                        resolved_workers.push_back(&node);
+        // Determine the range of the topological order that the cone can cover.
+        // Downstream nodes come after node_name, upstream nodes before it.
+        size_t first_pos = 0;
+        size_t last_pos  = _sorted_nodes.size() - 1;
+        _in_cone.assign(_sorted_nodes.size(), cone == CONE_ALL);
+        if (cone != CONE_ALL) {
+            const size_t node_pos = _topo_index[_lookup_vertex(node_name)];
+            _in_cone[node_pos]    = true;
+            if (cone == CONE_DOWNSTREAM) {
+                first_pos = node_pos;
+            } else {
+                last_pos = node_pos;
+            }
+        }
+        // The upstream cone is marked ahead of time, walking the order backwards
+        if (cone == CONE_UPSTREAM) {
+            for (size_t pos = last_pos + 1; pos-- > 0;) {
+                if (_in_cone[pos]) {
+                    for (const size_t pred : _predecessors[pos]) {
+                        _in_cone[pred] = true;
                     }
-                    EX_LOG(1,
-                        str(boost::format("resolved node %s (%s) [%s]") % node.get_name()
-                            % (node.is_dirty() ? "dirty" : "clean") % node.to_string()));
-                } else {
-                    EX_LOG(1,
-                        str(boost::format("skipped node %s (%s) [%s]") % node.get_name()
-                            % (node.is_dirty() ? "dirty" : "clean") % node.to_string()));
                 }
             }
+        }
 
-            // Determine if we are beyond the stop node
-            if (*node_iter == stop_vertex)
-                break;
+        // First Pass: Resolve all nodes in the cone if they are dirty, in a
+        // topological order
+        std::vector<dag_vertex_t*> resolved_workers;
+        for (size_t pos = first_pos; pos <= last_pos; pos++) {
+            if (not _in_cone[pos]) {
+                continue;
+            }
+            dag_vertex_t& node = _get_vertex(_sorted_nodes[pos]);
+            if (force or node.is_dirty()) {
+                node.resolve();
+                if (node.get_class() == CLASS_WORKER) {
+                    resolved_workers.push_back(&node);
+                }
+                EX_LOG(1,
+                    str(boost::format("resolved node %s (%s) [%s]") % node.get_name()
+                        % (node.is_dirty() ? "dirty" : "clean") % node.to_string()));
+                // The downstream cone grows as we go. Clean nodes can't change
+                // the nodes that depend on them, so their dependants are only
+                // visited if something else makes them part of the cone.
+                if (cone == CONE_DOWNSTREAM) {
+                    for (const size_t succ : _successors[pos]) {
+                        _in_cone[succ] = true;
+                    }
+                }
+            } else {
+                EX_LOG(1,
+                    str(boost::format("skipped node %s (%s) [%s]") % node.get_name()
+                        % (node.is_dirty() ? "dirty" : "clean") % node.to_string()));
+            }
         }
 
         // Second Pass: Mark all the workers clean. The policy is that a worker will mark
         // all of its dependencies clean so after this step all data nodes that are not
         // consumed by a worker will remain dirty (as they should because no one has
         // consumed their value)
-        for (std::list<dag_vertex_t*>::iterator worker = resolved_workers.begin();
-             worker != resolved_workers.end();
-             ++worker) {
-            (*worker)->mark_clean();
+        for (dag_vertex_t* worker : resolved_workers) {
+            worker->mark_clean();
         }
     }
 
@@ -555,6 +606,14 @@ private:
         _datanode_map; // A map from vertex name to vertex descriptor for data nodes
     boost::mutex _mutex;
     boost::recursive_mutex _resolve_mutex;
+
+    // Topological order of the graph, see _update_order()
+    bool _order_valid = false;
+    std::vector<expert_graph_t::vertex_descriptor> _sorted_nodes;
+    std::vector<size_t> _topo_index; // Position of each vertex in _sorted_nodes
+    std::vector<std::vector<size_t>> _successors;
+    std::vector<std::vector<size_t>> _predecessors;
+    std::vector<bool> _in_cone; // Scratch space for _resolve_helper()
 };
 
 expert_container::sptr expert_container::make(const std::string& name)
@@ -11,9 +11,13 @@
 #include <uhd/utils/static.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/format.hpp>
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <map>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace fs = boost::filesystem;
 
@@ -67,6 +71,53 @@ bool uhd::image_loader::load(
     }
 }
 
+/*
+ * Loading several devices at once
+ */
+std::vector<bool> uhd::image_loader::load_all(
+    const std::vector<image_loader_args_t>& image_loader_args,
+    const size_t max_parallel)
+{
+    const size_t num_loads   = image_loader_args.size();
+    const size_t num_workers = (max_parallel == 0)
+                                   ? num_loads
+                                   : std::min(max_parallel, num_loads);
+
+    // Not a vector<bool>, as the workers write their results concurrently
+    std::vector<char> results(num_loads, 0);
+    std::vector<std::string> errors(num_loads);
+    std::atomic<size_t> next_load(0);
+    auto worker = [&]() {
+        for (size_t i = next_load++; i < num_loads; i = next_load++) {
+            try {
+                results[i] = load(image_loader_args[i]);
+            } catch (const std::exception& ex) {
+                errors[i] = ex.what();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < num_workers; i++) {
+        workers.emplace_back(worker);
+    }
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    std::string error_msg;
+    for (size_t i = 0; i < num_loads; i++) {
+        if (not errors[i].empty()) {
+            error_msg += str(boost::format("\n  %s: %s")
+                             % image_loader_args[i].args.to_string() % errors[i]);
+        }
+    }
+    if (not error_msg.empty()) {
+        throw uhd::runtime_error("Image loading failed for:" + error_msg);
+    }
+    return std::vector<bool>(results.begin(), results.end());
+}
+
 /*
  * Get recovery instructions for particular device
  */
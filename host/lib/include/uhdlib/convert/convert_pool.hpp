@@ -0,0 +1,78 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace uhd { namespace convert {
+
+/*!
+ * A small pool of threads that converts the parts of a packet in parallel
+ *
+ * A single channel at a very high rate can exceed what one core converts.
+ * run() splits the work into one task per thread of the pool, and the
+ * calling thread takes the first one, so a pool of N threads has N - 1
+ * workers. The workers spin for a while after each task, because the next
+ * packet usually follows within microseconds, and then sleep until there is
+ * work again.
+ */
+class UHD_API convert_pool : uhd::noncopyable
+{
+public:
+    //! Works on the part with the given index, 0 <= index < get_num_threads()
+    using task_t = std::function<void(const size_t index)>;
+
+    /*!
+     * \param num_threads The number of threads, including the calling thread
+     * \param cpus The CPUs to pin the workers to, in turn. When empty, the
+     *        workers are not pinned.
+     */
+    convert_pool(const size_t num_threads, const std::vector<size_t>& cpus = {});
+
+    ~convert_pool();
+
+    //! Returns the number of threads, including the thread that calls run()
+    size_t get_num_threads() const
+    {
+        return _workers.size() + 1;
+    }
+
+    /*!
+     * Runs task(index) for every index on a thread of its own, and returns
+     * when all are done. Index 0 runs on the calling thread.
+     *
+     * Only one thread may call run() at a time. The task must not throw.
+     */
+    void run(const task_t& task);
+
+private:
+    void _worker(const size_t index);
+
+    std::vector<std::thread> _workers;
+
+    //! Incremented for every call to run(), and to stop the workers
+    std::atomic<uint64_t> _generation{0};
+    //! The number of workers that are still working on the current task
+    std::atomic<size_t> _pending{0};
+    const task_t* _task = nullptr;
+    std::atomic<bool> _stop{false};
+
+    //! Guards the sleep of the workers
+    std::mutex _mutex;
+    std::condition_variable _cond;
+};
+
+}} // namespace uhd::convert
@@ -0,0 +1,79 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/convert.hpp>
+#include <complex>
+#include <memory>
+
+namespace uhd { namespace convert {
+
+/*!
+ * DC offset and IQ imbalance correction of complex samples
+ *
+ * A sample x, scaled to the output format of the converter, is corrected to
+ * matrix * (x - dc_offset), with I and Q as the components of the vectors.
+ * Gain corrections are part of the matrix.
+ */
+struct UHD_API iq_correction_t
+{
+    //! DC offset, in units of the output format (i.e., full scale is 1.0)
+    std::complex<double> dc_offset{0.0, 0.0};
+
+    //! Correction matrix, row-major: I' = m[0][0] I + m[0][1] Q, etc.
+    double matrix[2][2] = {{1.0, 0.0}, {0.0, 1.0}};
+
+    /*!
+     * Returns a correction that works like the frontend cores of the FPGA
+     *
+     * These subtract the DC offset, and then compute I' = I + re(iq_balance) I
+     * and Q' = Q + im(iq_balance) I. An iq_cal container returns coefficients
+     * in this form, for RX IQ imbalance.
+     *
+     * \param iq_balance the IQ balance coefficient
+     * \param dc_offset the DC offset, full scale is 1.0
+     * \param gain a gain applied on top of the correction
+     */
+    static iq_correction_t from_iq_balance(const std::complex<double>& iq_balance,
+        const std::complex<double>& dc_offset = {0.0, 0.0},
+        const double gain                     = 1.0);
+
+    //! Returns true if the correction leaves samples unchanged
+    bool is_identity() const;
+};
+
+/*!
+ * A converter that applies DC offset and IQ imbalance correction while it
+ * converts the samples
+ *
+ * This saves the second pass over memory that correcting the samples after
+ * conversion needs. These converters are registered for the IDs returned by
+ * get_iq_correcting_id(), and are available for sc16 over-the-wire formats to
+ * fc32.
+ */
+class UHD_API iq_correcting_converter : public converter
+{
+public:
+    using sptr = std::shared_ptr<iq_correcting_converter>;
+
+    //! Sets the correction, by default it is the identity
+    virtual void set_iq_correction(const iq_correction_t& correction) = 0;
+};
+
+//! Returns the registry ID of the converter that applies corrections for \p id
+UHD_API id_type get_iq_correcting_id(const id_type& id);
+
+/*!
+ * Returns a new converter that applies corrections
+ *
+ * \param id the ID of the converter without corrections
+ * \throws uhd::key_error if there is no such converter for \p id
+ */
+UHD_API iq_correcting_converter::sptr make_iq_correcting_converter(const id_type& id);
+
+}} // namespace uhd::convert
@@ -0,0 +1,49 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/convert.hpp>
+#include <uhd/stream.hpp>
+#include <memory>
+
+namespace uhd { namespace convert {
+
+/*!
+ * A converter that accumulates the statistics of the samples it converts
+ *
+ * This saves the second pass over memory that computing them after the
+ * conversion needs. These converters are registered for the IDs returned by
+ * get_signal_stats_id(), and are available from the sc16 over-the-wire
+ * formats to fc32, and from fc32 to the sc16 over-the-wire formats. The
+ * statistics are of the fc32 samples, i.e., after scaling for RX, and before
+ * scaling for TX.
+ */
+class UHD_API signal_stats_converter : public converter
+{
+public:
+    using sptr = std::shared_ptr<signal_stats_converter>;
+
+    //! Returns the statistics of the samples converted since the last reset
+    virtual const signal_stats_t& get_signal_stats() const = 0;
+
+    //! Starts over with the statistics
+    virtual void reset_signal_stats() = 0;
+};
+
+//! Returns the registry ID of the converter that collects statistics for \p id
+UHD_API id_type get_signal_stats_id(const id_type& id);
+
+/*!
+ * Returns a new converter that collects statistics
+ *
+ * \param id the ID of the converter without statistics
+ * \throws uhd::key_error if there is no such converter for \p id
+ */
+UHD_API signal_stats_converter::sptr make_signal_stats_converter(const id_type& id);
+
+}} // namespace uhd::convert
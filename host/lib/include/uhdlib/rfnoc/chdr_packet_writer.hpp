@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <uhd/config.hpp>
+#include <uhd/exception.hpp>
 #include <uhd/rfnoc/chdr_types.hpp>
 #include <uhd/rfnoc/constants.hpp>
 #include <uhd/types/endianness.hpp>
@@ -31,11 +33,24 @@ public:
     //! interface.
     typedef std::unique_ptr<chdr_packet_writer> uptr;
 
+    //! The fields of a packet that are needed to process it on the data path
+    struct packet_view_t
+    {
+        chdr_header header;
+        bool has_timestamp  = false;
+        uint64_t timestamp  = 0;
+        size_t payload_size = 0;
+        const void* payload = nullptr;
+    };
+
     virtual ~chdr_packet_writer() = 0;
 
     /*! Updates the underlying storage of this packet. This is a const method and is
      *  only useful for read-only (RX) access.
      *
+     * The header is read once here. If the header in the buffer is modified
+     * afterwards, refresh() must be called again.
+     *
      * \param pkt_buff Pointer to a buffer that contains the RX packet
      */
     virtual void refresh(const void* pkt_buff) const = 0;
@@ -49,6 +64,37 @@ public:
      */
     virtual void refresh(void* pkt_buff, chdr_header& header, uint64_t timestamp = 0) = 0;
 
+    /*! Updates the underlying storage of this packet and reads all fields that
+     *  are needed to process a data packet in a single pass.
+     *
+     * This is equivalent to calling refresh(), get_chdr_header(),
+     * get_timestamp(), get_payload_size() and get_payload_const_ptr(), but
+     * avoids the overhead of the individual calls, which dominates for small
+     * packets.
+     *
+     * \param pkt_buff Pointer to a buffer that contains the RX packet
+     * \return The fields of the packet
+     */
+    virtual packet_view_t parse(const void* pkt_buff) const = 0;
+
+    /*! Updates the underlying storage of this packet, and writes the header and
+     *  timestamp of a data packet with the given payload size to it.
+     *
+     * This is equivalent to calling refresh(), update_payload_size() and
+     * get_payload_ptr(), but writes the header only once.
+     *
+     * \param pkt_buff Pointer to a buffer that should be populated with the TX packet
+     * \param header The CHDR header to fill into the TX packet. Its length is
+     *        updated to match the payload size.
+     * \param timestamp The timestamp to fill into the TX packet (if requested)
+     * \param payload_size_bytes The payload size in bytes
+     * \return A pointer to the payload
+     */
+    virtual void* write_header(void* pkt_buff,
+        chdr_header& header,
+        uint64_t timestamp,
+        size_t payload_size_bytes) = 0;
+
     /*! Updates the CHDR header with the written payload size
      *
      * \param payload_size_bytes The payload size in bytes
@@ -323,4 +369,133 @@ private:
     const endianness_t _endianness;
 };
 
+//----------------------------------------------------
+// CHDR data packet layout
+//----------------------------------------------------
+
+/*! Reads and writes the headers of CHDR data packets, for a CHDR width and
+ *  link endianness that are fixed at compile time.
+ *
+ * This does the same as chdr_packet_writer::parse() and write_header() for
+ * data packets, but the calls are inlined, and the offsets of the timestamp
+ * and the payload are constants. For CHDR widths above 64 bits, the timestamp
+ * shares the first CHDR word with the header, so the payload of a packet
+ * without metadata starts at the second word, i.e., at a multiple of the CHDR
+ * width from the start of the frame buffer.
+ *
+ * Use visit_data_packet_layout() to pick the layout of a transport.
+ */
+template <size_t chdr_w, endianness_t endianness>
+class chdr_data_packet_layout
+{
+public:
+    using packet_view_t = chdr_packet_writer::packet_view_t;
+
+    //! The CHDR width in bytes
+    static constexpr size_t CHDR_W_BYTES = chdr_w / 8;
+
+    //! Returns the offset of the payload of a data packet in bytes
+    static constexpr size_t payload_offset(
+        const bool has_timestamp, const size_t num_mdata = 0)
+    {
+        // Only with 64-bit CHDR, the timestamp takes a word of its own
+        return ((chdr_w == 64 && has_timestamp ? 2 : 1) + num_mdata) * CHDR_W_BYTES;
+    }
+
+    //! Reads the header of a packet
+    static UHD_FORCE_INLINE chdr_header read_header(const void* pkt_buff)
+    {
+        return chdr_header(_to_host(static_cast<const uint64_t*>(pkt_buff)[0]));
+    }
+
+    //! Same as chdr_packet_writer::parse(), for a data packet
+    static UHD_FORCE_INLINE packet_view_t parse(const void* pkt_buff)
+    {
+        const uint64_t* words = static_cast<const uint64_t*>(pkt_buff);
+        packet_view_t view;
+        view.header        = chdr_header(_to_host(words[0]));
+        view.has_timestamp = view.header.get_pkt_type() == PKT_TYPE_DATA_WITH_TS;
+        if (view.has_timestamp) {
+            view.timestamp = _to_host(words[1]);
+        }
+        const size_t offset =
+            payload_offset(view.has_timestamp, view.header.get_num_mdata());
+        view.payload_size = view.header.get_length() - offset;
+        view.payload      = static_cast<const uint8_t*>(pkt_buff) + offset;
+        return view;
+    }
+
+    //! Same as chdr_packet_writer::write_header(), for a data packet
+    static UHD_FORCE_INLINE void* write_header(void* pkt_buff,
+        chdr_header& header,
+        const uint64_t timestamp,
+        const size_t payload_size_bytes)
+    {
+        uint64_t* words          = static_cast<uint64_t*>(pkt_buff);
+        const bool has_timestamp = header.get_pkt_type() == PKT_TYPE_DATA_WITH_TS;
+        const size_t offset      = payload_offset(has_timestamp, header.get_num_mdata());
+        header.set_length(offset + payload_size_bytes);
+        words[0] = _from_host(header);
+        if (has_timestamp) {
+            words[1] = _from_host(timestamp);
+        }
+        return static_cast<uint8_t*>(pkt_buff) + offset;
+    }
+
+private:
+    static UHD_FORCE_INLINE uint64_t _to_host(const uint64_t word)
+    {
+        return (endianness == ENDIANNESS_BIG) ? uhd::ntohx<uint64_t>(word)
+                                              : uhd::wtohx<uint64_t>(word);
+    }
+
+    static UHD_FORCE_INLINE uint64_t _from_host(const uint64_t word)
+    {
+        return (endianness == ENDIANNESS_BIG) ? uhd::htonx<uint64_t>(word)
+                                              : uhd::htowx<uint64_t>(word);
+    }
+};
+
+/*! Calls a function with the data packet layout for a CHDR width and link
+ *  endianness, and returns its result.
+ *
+ * The function is a generic lambda, which gets compiled once per layout, each
+ * time with the constants of that layout. This costs a switch per call, which
+ * always takes the same branch for a given transport.
+ *
+ * \param chdr_w The CHDR width
+ * \param endianness The link endianness
+ * \param fn The function, which takes a chdr_data_packet_layout by value
+ */
+template <typename fn_t>
+UHD_FORCE_INLINE auto visit_data_packet_layout(
+    const chdr_w_t chdr_w, const endianness_t endianness, fn_t&& fn)
+    -> decltype(fn(chdr_data_packet_layout<64, ENDIANNESS_BIG>()))
+{
+    if (endianness == ENDIANNESS_BIG) {
+        switch (chdr_w) {
+            case CHDR_W_64:
+                return fn(chdr_data_packet_layout<64, ENDIANNESS_BIG>());
+            case CHDR_W_128:
+                return fn(chdr_data_packet_layout<128, ENDIANNESS_BIG>());
+            case CHDR_W_256:
+                return fn(chdr_data_packet_layout<256, ENDIANNESS_BIG>());
+            case CHDR_W_512:
+                return fn(chdr_data_packet_layout<512, ENDIANNESS_BIG>());
+        }
+    } else {
+        switch (chdr_w) {
+            case CHDR_W_64:
+                return fn(chdr_data_packet_layout<64, ENDIANNESS_LITTLE>());
+            case CHDR_W_128:
+                return fn(chdr_data_packet_layout<128, ENDIANNESS_LITTLE>());
+            case CHDR_W_256:
+                return fn(chdr_data_packet_layout<256, ENDIANNESS_LITTLE>());
+            case CHDR_W_512:
+                return fn(chdr_data_packet_layout<512, ENDIANNESS_LITTLE>());
+        }
+    }
+    UHD_THROW_INVALID_CODE_PATH();
+}
+
 }}} // namespace uhd::rfnoc::chdr
@@ -14,6 +14,7 @@
 #include <uhdlib/rfnoc/rx_flow_ctrl_state.hpp>
 #include <uhdlib/transport/io_service.hpp>
 #include <uhdlib/transport/link_if.hpp>
+#include <uhdlib/utils/trace.hpp>
 #include <memory>
 
 namespace uhd { namespace rfnoc {
@@ -113,6 +114,8 @@ public:
         uint64_t tsf         = 0;
         size_t payload_bytes = 0;
         const void* payload  = nullptr;
+        //! Sequence number, used to reorder packets striped across transports
+        uint16_t seq_num = 0;
     };
 
     //! Flow control parameters
@@ -120,6 +123,8 @@ public:
     {
         stream_buff_params_t buff_capacity;
         stream_buff_params_t freq;
+        //! Whether freq adapts to the stream, see rx_flow_ctrl_state
+        bool adaptive_freq = false;
     };
 
     /*! Configure stream endpoint route and flow control
@@ -186,6 +191,27 @@ public:
         return _max_payload_size;
     }
 
+    /*! Returns the largest number of packets queued for the streamer at once
+     *
+     * \return the high-water mark, or 0 if the I/O service doesn't queue
+     *         packets (see recv_io_if::get_recv_queue_hwm())
+     */
+    size_t get_recv_queue_hwm() const
+    {
+        return _recv_io->get_recv_queue_hwm();
+    }
+
+    /*! Call a function whenever a data packet is queued for the streamer
+     *
+     * \param cb the callback, or an empty function to stop the notifications
+     * \return false if the I/O service can't notify, see
+     *         recv_io_if::set_ready_callback()
+     */
+    bool set_ready_callback(transport::recv_io_if::ready_callback_t cb)
+    {
+        return _recv_io->set_ready_callback(std::move(cb));
+    }
+
     /*!
      * Gets an RX frame buffer containing a recv packet
      *
@@ -201,11 +227,13 @@ public:
         buff_t::uptr buff = _recv_io->get_recv_buff(timeout_ms);
 
         if (!buff) {
+            UHD_TRACE(RX_TIMEOUT, timeout_ms);
             return std::make_tuple(typename buff_t::uptr(), packet_info_t(), false);
         }
 
         auto info      = _read_data_packet_info(buff);
         bool seq_error = _is_out_of_sequence(std::get<1>(info));
+        UHD_TRACE(RX_PACKET, std::get<1>(info), std::get<0>(info).payload_bytes);
 
         return std::make_tuple(std::move(buff), std::get<0>(info), seq_error);
     }
@@ -235,8 +263,7 @@ private:
         transport::recv_link_if* recv_link,
         transport::send_link_if* send_link)
     {
-        _recv_packet_cb->refresh(buff->data());
-        const auto header   = _recv_packet_cb->get_chdr_header();
+        const auto header   = _read_header(buff->data());
         const auto dst_epid = header.get_dst_epid();
 
         if (dst_epid != _epid) {
@@ -250,6 +277,7 @@ private:
         const auto packet_size_rounded = _round_pkt_size(header.get_length());
 
         if (type == chdr::PKT_TYPE_STRC) {
+            _recv_packet_cb->refresh(buff->data());
             chdr::strc_payload strc;
             strc.deserialize(_recv_packet_cb->get_payload_const_ptr_as<uint64_t>(),
                 _recv_packet_cb->get_payload_size() / sizeof(uint64_t),
@@ -307,8 +335,7 @@ private:
         transport::recv_link_if* recv_link,
         transport::send_link_if* send_link)
     {
-        _recv_packet_cb->refresh(buff->data());
-        const auto header        = _recv_packet_cb->get_chdr_header();
+        const auto header        = _read_header(buff->data());
         const size_t packet_size = _round_pkt_size(header.get_length());
         recv_link->release_recv_buff(std::move(buff));
         _fc_state.xfer_done(packet_size);
@@ -323,7 +350,9 @@ private:
     void _send_fc_response(transport::send_link_if* send_link)
     {
         if (_fc_state.fc_resp_due()) {
-            _fc_sender.send_strs(send_link, _fc_state.get_xfer_counts());
+            const auto counts = _fc_state.get_xfer_counts();
+            UHD_TRACE(FC_CREDIT_SENT, counts.bytes, counts.packets);
+            _fc_sender.send_strs(send_link, counts);
             _fc_state.fc_resp_sent();
         }
     }
@@ -352,18 +381,19 @@ private:
      */
     std::tuple<packet_info_t, uint16_t> _read_data_packet_info(buff_t::uptr& buff)
     {
-        const void* data = buff->data();
-        _recv_packet->refresh(data);
-        const auto header        = _recv_packet->get_chdr_header();
-        const auto optional_time = _recv_packet->get_timestamp();
+        const auto packet = chdr::visit_data_packet_layout(
+            _chdr_w, _endianness, [&buff](auto layout) {
+                return decltype(layout)::parse(buff->data());
+            });
 
         packet_info_t info;
-        info.eob           = header.get_eob();
-        info.eov           = header.get_eov();
-        info.has_tsf       = optional_time.is_initialized();
-        info.tsf           = optional_time ? *optional_time : 0;
-        info.payload_bytes = _recv_packet->get_payload_size();
-        info.payload       = _recv_packet->get_payload_const_ptr();
+        info.eob           = packet.header.get_eob();
+        info.eov           = packet.header.get_eov();
+        info.has_tsf       = packet.has_timestamp;
+        info.tsf           = packet.timestamp;
+        info.payload_bytes = packet.payload_size;
+        info.payload       = packet.payload;
+        info.seq_num       = packet.header.get_seq_num();
 
         const uint8_t* pkt_end =
             reinterpret_cast<uint8_t*>(buff->data()) + buff->packet_size();
@@ -375,7 +405,16 @@ private:
             throw uhd::value_error("Bad CHDR header or invalid packet length.");
         }
 
-        return std::make_tuple(info, header.get_seq_num());
+        return std::make_tuple(info, packet.header.get_seq_num());
+    }
+
+    //! Reads the CHDR header of a packet
+    UHD_FORCE_INLINE chdr::chdr_header _read_header(const void* pkt_buff) const
+    {
+        return chdr::visit_data_packet_layout(
+            _chdr_w, _endianness, [pkt_buff](auto layout) {
+                return decltype(layout)::read_header(pkt_buff);
+            });
     }
 
     inline size_t _round_pkt_size(const size_t pkt_size_bytes)
@@ -395,10 +434,7 @@ private:
     // Sequence number for data packets
     uint16_t _data_seq_num = 0;
 
-    // Packet for received data
-    chdr::chdr_packet_writer::uptr _recv_packet;
-
-    // Packet for received data used in callbacks
+    // Packet for received stream commands, used in callbacks
     chdr::chdr_packet_writer::uptr _recv_packet_cb;
 
     // Handles sending of strs flow control response packets
@@ -410,6 +446,10 @@ private:
     //! The CHDR width in bytes.
     size_t _chdr_w_bytes;
 
+    //! The CHDR width and link endianness, which select the packet layout
+    const chdr_w_t _chdr_w;
+    const endianness_t _endianness;
+
     // Disconnect callback
     disconnect_callback_t _disconnect;
 };
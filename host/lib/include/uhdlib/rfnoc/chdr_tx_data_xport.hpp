@@ -15,6 +15,7 @@
 #include <uhdlib/rfnoc/tx_flow_ctrl_state.hpp>
 #include <uhdlib/transport/io_service.hpp>
 #include <uhdlib/transport/link_if.hpp>
+#include <uhdlib/utils/trace.hpp>
 #include <memory>
 
 namespace uhd { namespace rfnoc {
@@ -136,6 +137,7 @@ public:
      * \param mdata_buff_fmt Datatype of SW buffer that holds the data metadata
      * \param fc_freq_ratio Ratio to use to configure the device fc frequency
      * \param fc_headroom_ratio Ratio to use to configure the device fc headroom
+     * \param max_capacity Largest window to use, if the device buffer is larger
      * \param disconnect Callback function to disconnect the links
      * \return Parameters for xport flow control
      */
@@ -149,6 +151,7 @@ public:
         const uhd::rfnoc::sw_buff_t mdata_buff_fmt,
         const double fc_freq_ratio,
         const double fc_headroom_ratio,
+        const stream_buff_params_t& max_capacity,
         disconnect_callback_t disconnect);
 
     /*! Constructor
@@ -199,6 +202,17 @@ public:
         }
     }
 
+    /*! Call a function whenever a TX frame buffer becomes available
+     *
+     * \param cb the callback, or an empty function to stop the notifications
+     * \return false if the I/O service can't notify, see
+     *         send_io_if::set_ready_callback()
+     */
+    bool set_ready_callback(transport::send_io_if::ready_callback_t cb)
+    {
+        return _send_io->set_ready_callback(std::move(cb));
+    }
+
     /*!
      * Configure a function to call to enqueue async msgs
      *
@@ -219,6 +233,18 @@ public:
         _send_io->release_send_buff(std::move(buff));
     }
 
+    /*!
+     * Sets the sequence number of the next data packet. This is used when the
+     * packets of a stream are striped across several transports, which then
+     * need to share one sequence.
+     *
+     * \param seq_num the sequence number to write into the next packet
+     */
+    void set_next_seq_num(const uint16_t seq_num)
+    {
+        _data_seq_num = seq_num;
+    }
+
     /*!
      * Writes header into frame buffer and returns payload pointer
      *
@@ -240,13 +266,30 @@ public:
 
         _send_header.set_eob(info.eob);
         _send_header.set_eov(info.eov);
+        UHD_TRACE(TX_PACKET, _data_seq_num, info.payload_bytes);
         _send_header.set_seq_num(_data_seq_num++);
 
-        _send_packet->refresh(buff->data(), _send_header, tsf);
-        _send_packet->update_payload_size(info.payload_bytes);
+        void* payload = chdr::visit_data_packet_layout(
+            _chdr_w, _endianness, [this, &buff, tsf, &info](auto layout) {
+                return decltype(layout)::write_header(
+                    buff->data(), _send_header, tsf, info.payload_bytes);
+            });
 
-        return std::make_pair(_send_packet->get_payload_ptr(),
-            _send_packet->get_chdr_header().get_length());
+        return std::make_pair(payload, _send_header.get_length());
+    }
+
+    /*!
+     * Returns the offset of the payload in a packet
+     *
+     * \param has_tsf Whether the packet includes a timestamp
+     * \return The offset of the payload from the start of the packet in bytes
+     */
+    size_t get_payload_offset(const bool has_tsf) const
+    {
+        return chdr::visit_data_packet_layout(
+            _chdr_w, _endianness, [has_tsf](auto layout) {
+                return decltype(layout)::payload_offset(has_tsf);
+            });
     }
 
 private:
@@ -279,6 +322,7 @@ private:
                 _recv_packet->get_payload_size() / sizeof(uint64_t),
                 _recv_packet->conv_to_host<uint64_t>());
 
+            UHD_TRACE(FC_CREDIT_RECEIVED, strs.xfer_count_bytes, strs.xfer_count_pkts);
             _fc_state.update_dest_recv_count(
                 {strs.xfer_count_bytes, static_cast<uint32_t>(strs.xfer_count_pkts)});
 
@@ -382,9 +426,6 @@ private:
     // Header to write into send packets
     chdr::chdr_header _send_header;
 
-    // Packet for send data
-    chdr::chdr_packet_writer::uptr _send_packet;
-
     // Packet to receive strs messages
     chdr::chdr_packet_writer::uptr _recv_packet;
 
@@ -400,6 +441,10 @@ private:
     //! The CHDR width in bytes.
     size_t _chdr_w_bytes;
 
+    //! The CHDR width and link endianness, which select the packet layout
+    const chdr_w_t _chdr_w;
+    const endianness_t _endianness;
+
     //! The size of the send frame
     size_t _frame_size;
 
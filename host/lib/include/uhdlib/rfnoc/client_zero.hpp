@@ -193,6 +193,25 @@ public:
      */
     block_config_info get_block_info(uint16_t portno);
 
+    //! Status of a block port, see get_all_port_status()
+    struct port_status_t
+    {
+        uint16_t portno;
+        uint32_t noc_id;
+        bool flush_active;
+        bool flush_done;
+    };
+
+    /*! Read the status of all block ports at once
+     *
+     * This reads the status registers of all ports in one pipelined pass,
+     * rather than a round trip per register like get_noc_id(),
+     * get_flush_active(), and get_flush_done().
+     *
+     * \return The status of every block port, in the order of the ports
+     */
+    std::vector<port_status_t> get_all_port_status();
+
     // TODO: handle callbacks?
 
 private:
@@ -19,6 +19,18 @@ namespace uhd { namespace rfnoc {
  * - All capabilities of register_iface
  * - A function to handle received packets
  * - A static factory class to create these endpoints
+ *
+ * The "default" policy (see set_policy()) accepts these arguments:
+ * - timeout: Timeout for transactions in seconds
+ * - block_writes: Send consecutive writes as block writes (default: 0)
+ * - buff_capacity: Use only this many 32-bit words of the command buffer of
+ *   the device. This can't exceed the capacity reported by the device.
+ * - max_held_cmds: When the command buffer is full (e.g., because timed
+ *   commands are waiting in it), hold up to this many writes on the host, and
+ *   send them in the background as soon as there is room. Writes then don't
+ *   block the caller, but errors sending them are only logged. Other
+ *   transactions wait until all held writes are sent. 0 (the default) disables
+ *   this.
  */
 class ctrlport_endpoint : public register_iface
 {
@@ -0,0 +1,45 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/rfnoc/radio_control.hpp>
+#include <uhd/types/time_spec.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace uhd { namespace rfnoc { namespace detail {
+
+//! A masked write of a GPIO attribute
+struct gpio_write_t
+{
+    std::string bank;
+    std::string attr;
+    uint32_t mask;
+    uint32_t value;
+};
+
+//! The GPIO writes of one command time
+struct gpio_write_group_t
+{
+    uhd::time_spec_t time;
+    //! At most one write per bank and attribute, in the order of the sequence
+    std::vector<gpio_write_t> writes;
+};
+
+/*! Sorts a GPIO sequence by time, and merges its entries per command time
+ *
+ * Entries with the same time keep their order, so when two of them change
+ * the same bit, the later one wins. Entries with an empty mask are dropped.
+ *
+ * \param sequence the entries, see radio_control::set_gpio_sequence()
+ * \return one group per distinct time, in increasing order of time
+ */
+std::vector<gpio_write_group_t> coalesce_gpio_sequence(
+    const std::vector<radio_control::gpio_sequence_entry_t>& sequence);
+
+}}} // namespace uhd::rfnoc::detail
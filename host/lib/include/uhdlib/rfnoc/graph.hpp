@@ -15,6 +15,7 @@
 #include <memory>
 #include <mutex>
 #include <tuple>
+#include <vector>
 
 namespace uhd { namespace rfnoc { namespace detail {
 
@@ -27,6 +28,8 @@ public:
     using node_ref_t = uhd::rfnoc::node_t*;
     //! Shorthand to existing graph_edge_t
     using graph_edge_t = uhd::rfnoc::graph_edge_t;
+    //! A connection: source node, destination node, and edge info
+    using connection_t = std::tuple<node_ref_t, node_ref_t, graph_edge_t>;
 
     /*! Add a connection to the graph
      *
@@ -39,6 +42,16 @@ public:
      */
     void connect(node_ref_t src_node, node_ref_t dst_node, graph_edge_t edge_info);
 
+    /*! Add several connections to the graph at once
+     *
+     * This is equivalent to calling connect() for every connection, except
+     * that the graph is only checked for cycles once, after all edges were
+     * added. If any of the connections fails, none of them are added.
+     *
+     * \param connections The connections to add
+     */
+    void connect(const std::vector<connection_t>& connections);
+
     /*! Remove a connection from the graph
      *
      * After this function returns, the nodes will be considered disconnected
@@ -224,10 +237,21 @@ private:
 
     /*! Returns nodes in topologically sorted order
      *
+     * The order is cached until the vertices or edges of the graph change.
      *
      * \throws uhd::runtime_error if the graph was not sortable
      */
-    vertex_list_t _get_topo_sorted_nodes();
+    const vertex_list_t& _get_topo_sorted_nodes();
+
+    /*! Add an edge, without checking the graph for cycles
+     *
+     * \returns false if the exact same edge already existed
+     * \throws uhd::rfnoc_error if one of the ports is already connected
+     */
+    bool _add_edge(node_ref_t src_node, node_ref_t dst_node, graph_edge_t edge_info);
+
+    //! Remove the edges of \p connections, which must all be in the graph
+    void _remove_edges(const std::vector<connection_t>& connections);
 
     /*! Add a node, but only if it's not already in the graph.
      *
@@ -260,8 +284,9 @@ private:
     /*! Forward all edge properties from this node (\p origin) to the
      * neighbouring ones
      *
+     * \returns The neighbouring nodes that properties were forwarded to
      */
-    void _forward_edge_props(rfnoc_graph_t::vertex_descriptor origin);
+    vertex_list_t _forward_edge_props(rfnoc_graph_t::vertex_descriptor origin);
 
     /*! Check that the edge properties on both sides of the edge are equal
      *
@@ -290,6 +315,12 @@ private:
     // efficient for lookups of vertices.
     node_map_t _node_map;
 
+    //! Cache for _get_topo_sorted_nodes()
+    vertex_list_t _topo_sorted_nodes;
+
+    //! True if _topo_sorted_nodes matches the current graph
+    bool _topo_sorted_nodes_valid{false};
+
     using action_tuple_t = std::tuple<node_ref_t, res_source_info, action_info::sptr>;
 
     //! FIFO for incoming actions
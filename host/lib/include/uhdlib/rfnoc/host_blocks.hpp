@@ -0,0 +1,245 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/rfnoc/fft_block_control.hpp>
+#include <uhd/rfnoc/keep_one_in_n_block_control.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uhd { namespace rfnoc {
+
+/*! Host implementation of an RFNoC processing block
+ *
+ * These classes compute the same output as the simple RFNoC blocks of the
+ * same name do in the FPGA, on packets of sc16 samples in host memory. This
+ * allows running a processing chain on the host, e.g., to prototype it
+ * offline before moving it to an FPGA image, or to fill in for a block that
+ * an FPGA image lacks.
+ *
+ * A host block consumes one packet on each of its input ports per call to
+ * process(), and produces at most one packet on each of its output ports, in
+ * the same way as the FPGA block processes CHDR packets. The arithmetic
+ * follows the fixed-point behavior of the FPGA (rounding, saturation or
+ * wrapping, scaling), but only the integer operations are bit-exact; the
+ * filters and the FFT compute in single precision.
+ *
+ * The inner loops work on plain arrays of 16- and 32-bit integers or floats,
+ * so the compiler vectorizes them for the SIMD instruction set of the target.
+ */
+class host_block
+{
+public:
+    using sptr     = std::shared_ptr<host_block>;
+    using sample_t = std::complex<int16_t>;
+    using packet_t = std::vector<sample_t>;
+
+    virtual ~host_block() = default;
+
+    /*! Create the host implementation of a block
+     *
+     * The block is configured like its block controller after construction.
+     * The arguments override the configuration, the keys being the names of
+     * the block controllers' properties, e.g., "n" and "mode" for KeepOneInN.
+     *
+     * \param block_name The name of the block, e.g., "KeepOneInN"
+     * \param args Configuration of the block
+     * \throws uhd::key_error if there is no host implementation of the block
+     */
+    static sptr make(const std::string& block_name,
+        const uhd::device_addr_t& args = uhd::device_addr_t());
+
+    //! Return the names of the blocks that have a host implementation
+    static std::vector<std::string> get_block_names();
+
+    //! Return the number of input ports
+    virtual size_t get_num_input_ports() const
+    {
+        return 1;
+    }
+
+    //! Return the number of output ports
+    virtual size_t get_num_output_ports() const
+    {
+        return 1;
+    }
+
+    /*! Process one packet on each input port
+     *
+     * \param in One packet per input port
+     * \param out Returns one packet per output port. Empty packets are
+     *            dropped, i.e., the FPGA block would not send them.
+     * \throws uhd::value_error if the number of packets does not match the
+     *         number of ports, or a packet can't be processed
+     */
+    virtual void process(
+        const std::vector<const packet_t*>& in, std::vector<packet_t>& out) = 0;
+
+    //! Clear the state of the block, as after a reset of the FPGA block
+    virtual void reset() {}
+
+protected:
+    //! Check the number of inputs, and size the outputs
+    void check_ports(
+        const std::vector<const packet_t*>& in, std::vector<packet_t>& out) const;
+};
+
+//! Host implementation of the Keep One in N block
+class host_keep_one_in_n : public host_block
+{
+public:
+    using mode_t = keep_one_in_n_block_control::mode;
+
+    //! Keep one in \p n samples, or packets in packet mode
+    void set_n(const size_t n);
+    void set_mode(const mode_t mode);
+    void process(const std::vector<const packet_t*>& in, std::vector<packet_t>& out);
+    void reset();
+
+private:
+    size_t _n     = 1;
+    mode_t _mode  = mode_t::SAMPLE_MODE;
+    size_t _count = 0;
+};
+
+//! Host implementation of the Moving Average block
+class host_moving_average : public host_block
+{
+public:
+    //! Set the number of samples to sum, which clears the history
+    void set_sum_len(const uint8_t sum_len);
+    void set_divisor(const uint32_t divisor);
+    void process(const std::vector<const packet_t*>& in, std::vector<packet_t>& out);
+    void reset();
+
+private:
+    size_t _sum_len   = 10;
+    uint32_t _divisor = 10;
+
+    // The last _sum_len input samples, as a ring buffer, and their sum
+    std::vector<sample_t> _history = std::vector<sample_t>(10);
+    size_t _pos                    = 0;
+    int32_t _sum_i                 = 0;
+    int32_t _sum_q                 = 0;
+};
+
+//! Host implementation of the Vector IIR block: y[n] = alpha*y[n-delay] + beta*x[n]
+class host_vector_iir : public host_block
+{
+public:
+    void set_alpha(const double alpha);
+    void set_beta(const double beta);
+    //! Set the feedback delay, in samples, which clears the history
+    void set_delay(const uint16_t delay);
+    void process(const std::vector<const packet_t*>& in, std::vector<packet_t>& out);
+    void reset();
+
+private:
+    float _alpha = 0.9f;
+    float _beta  = 0.9f;
+
+    // The last delay output samples, as a ring buffer, at full precision
+    std::vector<std::complex<float>> _feedback = std::vector<std::complex<float>>(1);
+    size_t _pos                                = 0;
+};
+
+//! Host implementation of the Window block
+class host_window : public host_block
+{
+public:
+    //! Set the window, with 15 fractional bits, e.g., 32767 for 1.0
+    void set_coefficients(const std::vector<int16_t>& coeffs);
+    void process(const std::vector<const packet_t*>& in, std::vector<packet_t>& out);
+    void reset();
+
+private:
+    std::vector<int16_t> _coeffs = std::vector<int16_t>(1, 32767);
+    size_t _pos                  = 0;
+};
+
+/*! Host implementation of the Log Power block
+ *
+ * The real part of each output sample is 1024 * log2(i^2 + q^2) of the input
+ * sample, the imaginary part is zero. The FPGA block packs these 16-bit values
+ * two to a 32-bit item instead.
+ */
+class host_logpwr : public host_block
+{
+public:
+    void process(const std::vector<const packet_t*>& in, std::vector<packet_t>& out);
+};
+
+/*! Host implementation of the FFT block
+ *
+ * Every input packet must contain exactly one FFT worth of samples. The
+ * scaling schedule is applied as one right shift per stage, like the Xilinx
+ * FFT core does it; the magnitude outputs appear in the real part of the
+ * output samples.
+ */
+class host_fft : public host_block
+{
+public:
+    host_fft();
+
+    //! Set the FFT length, which is coerced to a power of two
+    void set_length(const size_t length);
+    void set_direction(const fft_direction direction);
+    void set_magnitude(const fft_magnitude magnitude);
+    void set_shift_config(const fft_shift shift);
+    void set_scaling(const uint16_t scaling);
+    size_t get_length() const;
+    void process(const std::vector<const packet_t*>& in, std::vector<packet_t>& out);
+
+private:
+    void _update();
+
+    size_t _length              = 256;
+    fft_direction _direction    = fft_direction::FORWARD;
+    fft_magnitude _magnitude    = fft_magnitude::COMPLEX;
+    fft_shift _shift            = fft_shift::NORMAL;
+    uint16_t _scaling           = 1706;
+    float _scale                = 1.0f;
+    std::vector<size_t> _bitrev = {};
+    std::vector<std::complex<float>> _twiddles = {};
+    std::vector<std::complex<float>> _work     = {};
+};
+
+//! Host implementation of the Add/Sub block: outputs a+b and a-b, wrapping
+class host_addsub : public host_block
+{
+public:
+    size_t get_num_input_ports() const
+    {
+        return 2;
+    }
+    size_t get_num_output_ports() const
+    {
+        return 2;
+    }
+    void process(const std::vector<const packet_t*>& in, std::vector<packet_t>& out);
+};
+
+//! Host implementation of the Split Stream block, for a single stream
+class host_split_stream : public host_block
+{
+public:
+    void set_num_branches(const size_t num_branches);
+    size_t get_num_output_ports() const
+    {
+        return _num_branches;
+    }
+    void process(const std::vector<const packet_t*>& in, std::vector<packet_t>& out);
+
+private:
+    size_t _num_branches = 2;
+};
+
+}} // namespace uhd::rfnoc
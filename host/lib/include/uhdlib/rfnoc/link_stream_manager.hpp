@@ -7,6 +7,7 @@
 #pragma once
 
 #include <uhd/transport/adapter_id.hpp>
+#include <uhd/types/direction.hpp>
 #include <uhdlib/rfnoc/chdr_rx_data_xport.hpp>
 #include <uhdlib/rfnoc/client_zero.hpp>
 #include <uhdlib/rfnoc/ctrlport_endpoint.hpp>
@@ -50,6 +51,13 @@ public:
      */
     virtual uhd::transport::adapter_id_t get_adapter_id() const = 0;
 
+    /*! \brief Get the rate that the link of this instance can carry payload at
+     *
+     * \param dir The direction of the traffic
+     * \return The rate in bytes/sec, or 0 if it is unknown
+     */
+    virtual double get_link_rate(const uhd::direction_t dir) const = 0;
+
     /*! \brief Get all the endpoints reachable from this link
      *
      * \return A vector of addresses for all reachable endpoints
@@ -9,6 +9,7 @@
 #include <uhd/exception.hpp>
 #include <uhd/rfnoc/rfnoc_types.hpp>
 #include <uhd/transport/adapter_id.hpp>
+#include <uhd/types/direction.hpp>
 #include <uhd/types/endianness.hpp>
 #include <uhdlib/rfnoc/chdr_ctrl_xport.hpp>
 #include <uhdlib/rfnoc/chdr_rx_data_xport.hpp>
@@ -17,6 +18,7 @@
 #include <uhdlib/rfnoc/rfnoc_common.hpp>
 #include <uhdlib/usrp/common/io_service_mgr.hpp>
 #include <memory>
+#include <string>
 
 namespace uhd { namespace rfnoc {
 
@@ -79,10 +81,34 @@ public:
     virtual uhd::transport::adapter_id_t get_adapter_id(
         const device_id_t local_device_id) = 0;
 
+    /*! Return the rate that the link associated with \p local_device_id can
+     * carry CHDR payload at, in bytes/sec
+     *
+     * The graph uses this to spread the data streams over the links by the
+     * bandwidth they need. The default of 0 means that the rate is unknown.
+     */
+    virtual double get_link_rate(
+        const device_id_t /*local_device_id*/, const uhd::direction_t /*dir*/)
+    {
+        return 0.0;
+    }
+
     /*! Reset the device
      */
     virtual void reset_network() = 0;
 
+    /*! Return a key that identifies the RFNoC network topology of the device
+     *
+     * Two sessions that return the same key have the same topology, e.g.,
+     * because they connect to the same device with the same FPGA image. The
+     * topology discovered in the first session is then reused. An empty key
+     * means that the topology is discovered for each session.
+     */
+    virtual std::string get_topology_key()
+    {
+        return "";
+    }
+
     /*! Return a reference to a clock iface
      */
     virtual std::shared_ptr<clock_iface> get_clock_iface(
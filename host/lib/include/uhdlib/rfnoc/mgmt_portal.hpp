@@ -12,6 +12,7 @@
 #include <uhdlib/rfnoc/rfnoc_common.hpp>
 #include <memory>
 #include <set>
+#include <string>
 
 namespace uhd { namespace rfnoc { namespace mgmt {
 
@@ -200,9 +201,21 @@ public:
 
     //! Create an endpoint manager object
     //
+    // The topology discovered by the portal is cached for the lifetime of the
+    // process. A portal that is created with the same topology key reuses it,
+    // after probing the first node to check that it is still valid.
+    //
+    // \param xport The host stream endpoint's CTRL transport
+    // \param pkt_factory The factory for CHDR packets
+    // \param my_sep_addr The address of the host stream endpoint
+    // \param topology_key A key identifying the topology that is reachable from
+    // the transport (e.g., a device serial, FPGA image and link), or an empty
+    // string to always discover the topology
+    //
     static uptr make(chdr_ctrl_xport& xport,
         const chdr::chdr_packet_factory& pkt_factory,
-        sep_addr_t my_sep_addr);
+        sep_addr_t my_sep_addr,
+        const std::string& topology_key = "");
 };
 
 }}} // namespace uhd::rfnoc::mgmt
@@ -11,6 +11,7 @@
 #include <uhd/rfnoc/radio_control.hpp>
 #include <uhdlib/features/discoverable_feature_registry.hpp>
 #include <uhdlib/usrp/common/pwr_cal_mgr.hpp>
+#include <functional>
 #include <unordered_map>
 #include <mutex>
 
@@ -45,6 +46,13 @@ public:
      *************************************************************************/
     void issue_stream_cmd(const uhd::stream_cmd_t& stream_cmd, const size_t port);
 
+    std::future<void> issue_stream_cmd_async(
+        const uhd::stream_cmd_t& stream_cmd, const size_t port);
+
+    void issue_rx_scan(const std::vector<rx_scan_entry_t>& schedule,
+        const uhd::time_spec_t& settling_time,
+        const size_t chan);
+
     void enable_rx_timestamps(const bool enable, const size_t chan);
 
     /**************************************************************************
@@ -114,6 +122,16 @@ public:
     virtual meta_range_t get_rx_power_range(const size_t chan);
     virtual meta_range_t get_tx_power_range(const size_t chan);
 
+    /**************************************************************************
+     * Frequency Hopping
+     *************************************************************************/
+    virtual std::vector<double> set_tx_hop_table(
+        const std::vector<double>& freqs, const size_t chan);
+    virtual void tx_hop(const size_t index, const size_t chan);
+    virtual std::vector<double> set_rx_hop_table(
+        const std::vector<double>& freqs, const size_t chan);
+    virtual void rx_hop(const size_t index, const size_t chan);
+
     /**************************************************************************
      * LO Controls
      *************************************************************************/
@@ -167,6 +185,7 @@ public:
     virtual void set_gpio_attr(
         const std::string& bank, const std::string& attr, const uint32_t value);
     virtual uint32_t get_gpio_attr(const std::string& bank, const std::string& attr);
+    virtual void set_gpio_sequence(const std::vector<gpio_sequence_entry_t>& sequence);
 
     /**************************************************************************
      * Sensor API
@@ -307,6 +326,15 @@ protected:
         return _rate;
     }
 
+    /*! Tell the streamers downstream of RX channel \p chan about a change
+     *
+     * If a command time is set, this posts an RX tag action for that time, so
+     * that the streamers can tag the samples that follow the change. Drivers
+     * that don't update the RX frequency and gain with the set_rx_frequency()
+     * and set_rx_gain() of this class need to call this themselves.
+     */
+    void post_rx_tag(const uhd::rx_tag_t::tag_type_t type, const size_t chan);
+
     //! Properties for samp_rate (one per port)
     std::vector<property_t<double>> _samp_rate_in;
     //! Properties for samp_rate (one per port)
@@ -323,6 +351,13 @@ protected:
     std::vector<uhd::usrp::pwr_cal_mgr::sptr> _tx_pwr_mgr;
 
 private:
+    //! Writes all registers of a stream command but the command word itself
+    //
+    // Returns the command word, writing it to REG_RX_CMD starts the command.
+    uint32_t _prepare_stream_cmd(const uhd::stream_cmd_t& stream_cmd,
+        const size_t chan,
+        const uhd::time_spec_t& cmd_time = uhd::time_spec_t::ASAP);
+
     //! Validator for the async messages
     //
     // We only know about overruns, underruns, and late commands/packets.
@@ -339,6 +374,26 @@ private:
         const std::vector<uint32_t>& data,
         boost::optional<uint64_t> timestamp);
 
+    //! The register writes of one entry of a hop table
+    struct hop_t
+    {
+        std::vector<uint32_t> addrs;
+        std::vector<uint32_t> data;
+    };
+    using hop_table_t = std::vector<hop_t>;
+
+    //! Record the register writes of tuning to each of \p freqs with \p tune
+    //
+    // The actual frequencies are returned in \p actual_freqs.
+    hop_table_t make_hop_table(const std::vector<double>& freqs,
+        const std::function<double(double)>& tune,
+        std::vector<double>& actual_freqs);
+
+    //! Replay the register writes of one entry of a hop table
+    void hop(const std::unordered_map<size_t, hop_table_t>& tables,
+        const size_t index,
+        const size_t chan);
+
     //! FPGA compat number
     const uint32_t _fpga_compat;
 
@@ -369,6 +424,10 @@ private:
     std::unordered_map<size_t, double> _rx_bandwidth;
 
     std::vector<uhd::stream_cmd_t> _last_stream_cmd;
+
+    std::mutex _hop_mutex;
+    std::unordered_map<size_t, hop_table_t> _tx_hop_tables;
+    std::unordered_map<size_t, hop_table_t> _rx_hop_tables;
 };
 
 }} // namespace uhd::rfnoc
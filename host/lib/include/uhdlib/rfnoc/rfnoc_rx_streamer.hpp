@@ -10,7 +10,9 @@
 #include <uhdlib/rfnoc/chdr_rx_data_xport.hpp>
 #include <uhdlib/transport/rx_streamer_impl.hpp>
 #include <atomic>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace uhd { namespace rfnoc {
 
@@ -25,6 +27,9 @@ class rfnoc_rx_streamer : public node_t,
     using disconnect_fn_t = std::function<void(const std::string&)>;
 
 public:
+    //! Callback that takes over the transport of a channel, see set_xport_release_cb()
+    using xport_release_fn_t = std::function<void(size_t, chdr_rx_data_xport::uptr)>;
+
     /*! Constructor
      *
      * \param num_ports The number of ports
@@ -94,6 +99,45 @@ public:
      */
     void connect_channel(const size_t channel, chdr_rx_data_xport::uptr xport);
 
+    /*! Implementation of rx_streamer API method
+     *
+     * Adds the statistics of the transports to those of the streamer.
+     */
+    uhd::streamer_stats_t get_stats() const;
+
+    /*! Implementation of rx_streamer API method
+     *
+     * Needs an I/O service that queues packets for the streamer, see
+     * recv_io_if::set_ready_callback().
+     */
+    void set_recv_ready_callback(recv_ready_callback_t callback);
+
+    /*! Implementation of rx_streamer API method
+     *
+     * Receives from the ready callback, see set_recv_ready_callback().
+     * Overruns and late commands are reported from the thread that handles
+     * the RX event action.
+     */
+    void set_recv_packet_callback(recv_packet_callback_t callback, const bool raw);
+
+    /*! Hand the transports to a callback when the streamer is destroyed
+     *
+     * The callback runs before the disconnect callback, once for each
+     * connected channel, and receives the channel and its transport. This
+     * allows the graph to reuse the transports for another streamer.
+     *
+     * \param release_cb the callback
+     */
+    void set_xport_release_cb(xport_release_fn_t release_cb);
+
+    /*! Correct DC offset and IQ imbalance of a channel on the host
+     *
+     * For radios that cannot correct the samples in the FPGA. The correction
+     * is applied while converting the samples, see
+     * rx_streamer_impl::set_iq_correction().
+     */
+    using transport::rx_streamer_impl<chdr_rx_data_xport>::set_iq_correction;
+
 private:
     void _register_props(const size_t chan, const std::string& otw_format);
 
@@ -104,6 +148,11 @@ private:
 
     void _handle_overrun();
 
+    //! Pass all queued packets to the packet callback, from any thread
+    void _push_packets();
+    //! Receive and pass packets until there are none left, with _push_mutex held
+    void _push_queued_packets();
+
     // Properties
     std::vector<property_t<double>> _scaling_in;
     std::vector<property_t<double>> _samp_rate_in;
@@ -120,8 +169,31 @@ private:
     // Callback function to disconnect
     const disconnect_fn_t _disconnect_cb;
 
+    // Callback function that takes over the transports on destruction
+    xport_release_fn_t _xport_release_cb;
+
+    // Transports of each channel, owned by the base class
+    std::vector<chdr_rx_data_xport*> _xports;
+
+    // Whether to restart streaming right after an overrun, see the
+    // fast_overrun_recovery stream arg
+    const bool _fast_overrun_recovery;
+
     std::atomic<bool> _overrun_handling_mode{false};
     size_t _overrun_channel = 0;
+
+    // Packet callback, see set_recv_packet_callback(). Everything but the
+    // flags is protected by _push_mutex, which is held while pushing.
+    std::atomic<bool> _push_enabled{false};
+    //! Set when new packets or errors may need to be pushed
+    std::atomic<bool> _push_pending{false};
+    std::mutex _push_mutex;
+    recv_packet_callback_t _push_cb;
+    bool _push_raw = false;
+    //! Output buffers for converted samples
+    std::vector<std::vector<char>> _push_buffs;
+    std::vector<void*> _push_buff_ptrs;
+    std::vector<const void*> _push_out;
 };
 
 }} // namespace uhd::rfnoc
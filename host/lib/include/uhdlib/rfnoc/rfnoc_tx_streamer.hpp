@@ -6,11 +6,13 @@
 
 #pragma once
 
+#include <uhd/rfnoc/mb_controller.hpp>
 #include <uhd/rfnoc/node.hpp>
 #include <uhdlib/rfnoc/chdr_tx_data_xport.hpp>
 #include <uhdlib/rfnoc/tx_async_msg_queue.hpp>
 #include <uhdlib/transport/tx_streamer_impl.hpp>
 #include <string>
+#include <vector>
 
 namespace uhd { namespace rfnoc {
 
@@ -98,6 +100,36 @@ public:
      */
     bool recv_async_msg(uhd::async_metadata_t& async_metadata, double timeout);
 
+    /*! Deliver asynchronous messages of this tx stream to a callback
+     *
+     *  Implementation of tx_streamer API method.
+     *
+     * \param callback the callback, or an empty function to queue messages
+     */
+    void set_async_msg_callback(async_msg_callback_t callback);
+
+    /*! Implementation of tx_streamer API method
+     *
+     * Needs an I/O service that sends in a worker thread, see
+     * send_io_if::set_ready_callback().
+     */
+    void set_send_ready_callback(send_ready_callback_t callback);
+
+    //! Stream arg that enables dropping late bursts, see set_timekeeper()
+    static constexpr char LATE_DROP_MARGIN_KEY[] = "late_drop_margin";
+
+    /*! Use the time estimate of a timekeeper to drop late bursts
+     *
+     * If the stream args contain late_drop_margin, bursts that are later than
+     * that many seconds according to the time estimate of \p timekeeper are
+     * dropped before they are sent. For every dropped burst, the streamer
+     * posts an EVENT_CODE_TIME_ERROR message on each channel, the same as the
+     * device would. Without late_drop_margin, this does nothing.
+     *
+     * \param timekeeper the timekeeper of the device the streamer sends to
+     */
+    void set_timekeeper(mb_controller::timekeeper::sptr timekeeper);
+
 private:
     void _register_props(const size_t chan, const std::string& otw_format);
 
@@ -122,6 +154,9 @@ private:
 
     // Callback function to disconnect
     const disconnect_fn_t _disconnect_cb;
+
+    // Transports of each channel, owned by the base class
+    std::vector<chdr_tx_data_xport*> _xports;
 };
 
 }} // namespace uhd::rfnoc
@@ -8,6 +8,8 @@
 
 #include <uhd/utils/log.hpp>
 #include <uhdlib/rfnoc/rfnoc_common.hpp>
+#include <algorithm>
+#include <chrono>
 
 namespace uhd { namespace rfnoc {
 
@@ -46,6 +48,7 @@ public:
                 << std::endl;
 
             _recv_counts = counts;
+            _loss_seen   = true;
         }
     }
 
@@ -54,6 +57,12 @@ public:
     {
         _recv_counts.bytes += bytes;
         _recv_counts.packets++;
+        if (_adaptive) {
+            _max_unacked.bytes = std::max(
+                _max_unacked.bytes, _recv_counts.bytes - _last_fc_resp_counts.bytes);
+            _max_unacked.packets = std::max(_max_unacked.packets,
+                _recv_counts.packets - _last_fc_resp_counts.packets);
+        }
     }
 
     //! Update state when transfer is complete (buffer space freed)
@@ -78,6 +87,41 @@ public:
     void fc_resp_sent()
     {
         _last_fc_resp_counts = _xfer_counts;
+        if (_adaptive && ++_num_resps_since_adapt == ADAPT_INTERVAL) {
+            _adapt();
+        }
+    }
+
+    /*! Lets the flow control frequency adapt to the stream
+     *
+     * Every response returns credit to the sender, so the frequency trades
+     * the number of responses against the credit the sender holds: the
+     * capacity, minus the data it sent that was not acked yet. That data
+     * includes what the host still buffers, and the sender needs enough
+     * credit left to cover the consumption rate over a round trip, or it
+     * stalls. Every ADAPT_INTERVAL responses, the frequency is adjusted from
+     * the lowest credit that the sender held:
+     * - If it dropped below 1/4 of the capacity, or packets were lost, the
+     *   frequency is halved, so credit returns sooner.
+     * - If it stayed above 3/4 of the capacity, the frequency grows by 1/8,
+     *   which saves responses.
+     * The frequency stays between one packet (or byte) and 1/4 of the
+     * capacity. Limits that are disabled (set to the maximum) are kept.
+     *
+     * \param capacity The capacity of the receive buffer
+     */
+    void enable_adaptive_freq(const stream_buff_params_t& capacity)
+    {
+        _adaptive         = true;
+        _capacity         = capacity;
+        _last_adapt_time  = std::chrono::steady_clock::now();
+        _last_adapt_bytes = _xfer_counts.bytes;
+    }
+
+    //! Returns the number of times the adaptive frequency changed
+    size_t get_num_freq_changes() const
+    {
+        return _num_freq_changes;
     }
 
     //! Returns counts for completed transfers
@@ -99,6 +143,71 @@ public:
     }
 
 private:
+    //! Number of responses between adjustments of an adaptive frequency
+    static constexpr size_t ADAPT_INTERVAL = 16;
+
+    //! Adjusts one limit of the frequency, returns true if it changed
+    template <typename count_t>
+    static bool _adapt_freq(count_t& freq,
+        const count_t max_freq,
+        const count_t capacity,
+        const count_t max_unacked,
+        const bool loss_seen)
+    {
+        if (freq >= max_freq || capacity == 0) {
+            // Disabled limit
+            return false;
+        }
+        const count_t credit = capacity - std::min(max_unacked, capacity);
+        const count_t upper  = std::max<count_t>(capacity / 4, 1);
+        const count_t old    = freq;
+        if (loss_seen || credit < capacity / 4) {
+            freq = std::max<count_t>(freq / 2, 1);
+        } else if (credit > capacity - capacity / 4) {
+            freq = std::min<count_t>(freq + std::max<count_t>(freq / 8, 1), upper);
+        }
+        return freq != old;
+    }
+
+    void _adapt()
+    {
+        const bool bytes_changed = _adapt_freq<uint64_t>(_fc_freq.bytes,
+            MAX_FC_FREQ_BYTES,
+            _capacity.bytes,
+            _max_unacked.bytes,
+            _loss_seen);
+        const bool pkts_changed = _adapt_freq<uint32_t>(_fc_freq.packets,
+            MAX_FC_FREQ_PKTS,
+            _capacity.packets,
+            _max_unacked.packets,
+            _loss_seen);
+
+        if (bytes_changed || pkts_changed) {
+            _num_freq_changes++;
+            const auto now = std::chrono::steady_clock::now();
+            const double elapsed =
+                std::chrono::duration<double>(now - _last_adapt_time).count();
+            UHD_LOGGER_DEBUG("rx_flow_ctrl_state")
+                << "Adapted fc frequency to bytes=" << _fc_freq.bytes
+                << " packets=" << _fc_freq.packets
+                << " (lowest sender credit bytes="
+                << (_capacity.bytes - std::min(_max_unacked.bytes, _capacity.bytes))
+                << " packets="
+                << (_capacity.packets - std::min(_max_unacked.packets, _capacity.packets))
+                << ", loss=" << (_loss_seen ? "yes" : "no") << ", consumption rate="
+                << ((elapsed > 0) ? (_xfer_counts.bytes - _last_adapt_bytes) / elapsed
+                                        / 1e6
+                                  : 0.0)
+                << " MB/s) src_epid=" << _epids.first << " dst_epid=" << _epids.second;
+            _last_adapt_time  = now;
+            _last_adapt_bytes = _xfer_counts.bytes;
+        }
+
+        _num_resps_since_adapt = 0;
+        _max_unacked           = {0, 0};
+        _loss_seen             = false;
+    }
+
     // Counts for data received, including any data still in use
     stream_buff_params_t _recv_counts{0, 0};
 
@@ -113,6 +222,28 @@ private:
 
     // Endpoint ID for log messages
     const sep_id_pair_t _epids;
+
+    // Whether the frequency adapts to the stream
+    bool _adaptive = false;
+
+    // Capacity of the receive buffer, if the frequency adapts
+    stream_buff_params_t _capacity{0, 0};
+
+    // Most data that was received but not acked since the last adjustment
+    stream_buff_params_t _max_unacked{0, 0};
+
+    // Whether packets were lost since the last adjustment
+    bool _loss_seen = false;
+
+    // Number of responses since the last adjustment
+    size_t _num_resps_since_adapt = 0;
+
+    // Number of adjustments that changed the frequency
+    size_t _num_freq_changes = 0;
+
+    // Time and transfer count of the last change, to report the consumption rate
+    std::chrono::steady_clock::time_point _last_adapt_time;
+    uint64_t _last_adapt_bytes = 0;
 };
 
 }} // namespace uhd::rfnoc
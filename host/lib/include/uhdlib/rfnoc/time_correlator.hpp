@@ -0,0 +1,102 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/types/time_spec.hpp>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+namespace uhd { namespace rfnoc { namespace detail {
+
+/*! Tracks the relation between the host clock and a device time
+ *
+ * Every sample is a device time that was read between two readings of the
+ * host clock. The device time is assumed to belong to the middle of that
+ * interval, so the error of a sample is at most half of its round trip time.
+ * The correlator fits a line (offset and drift) through the latest samples,
+ * using only the samples with a round trip time close to the shortest one, so
+ * a few slow reads don't skew the estimate. With that, host times can be
+ * converted to device times and back without talking to the device.
+ *
+ * When a sample is far off the estimate, the device time was changed (e.g.,
+ * by setting the time at the next PPS), and the correlator starts over.
+ *
+ * The host clock is std::chrono::steady_clock, i.e., the same clock that UHD
+ * uses for timeouts. All methods are thread-safe.
+ */
+class time_correlator
+{
+public:
+    using clock_t = std::chrono::steady_clock;
+
+    //! Default number of samples the estimate is based on
+    static constexpr size_t DEFAULT_NUM_SAMPLES = 16;
+    /*! A sample that is off the estimate by more than this (plus half its
+     *  round trip time) means the device time was changed (in seconds)
+     */
+    static constexpr double MAX_ERROR = 1e-3;
+
+    time_correlator(const size_t num_samples = DEFAULT_NUM_SAMPLES);
+
+    /*! Add a sample
+     *
+     * \param before The host time right before the device time was read
+     * \param after The host time right after the device time was read
+     * \param device_time The device time that was read
+     */
+    void add_sample(const clock_t::time_point before,
+        const clock_t::time_point after,
+        const uhd::time_spec_t& device_time);
+
+    //! Drop all samples, e.g. because the device time is about to change
+    void reset();
+
+    //! Returns true if there is at least one sample to base an estimate on
+    bool is_valid() const;
+
+    /*! Estimate the device time at a given host time
+     *
+     * \throws uhd::runtime_error if there are no samples
+     */
+    uhd::time_spec_t to_device_time(const clock_t::time_point host_time) const;
+
+    /*! Estimate the host time at which the device reaches a given time
+     *
+     * \throws uhd::runtime_error if there are no samples
+     */
+    clock_t::time_point to_host_time(const uhd::time_spec_t& device_time) const;
+
+    /*! Return the rate at which the device time runs relative to the host
+     *  clock, minus one (e.g., 1e-6 if the device clock is 1 ppm fast)
+     */
+    double get_drift() const;
+
+private:
+    struct sample_t
+    {
+        clock_t::time_point host_time;
+        uhd::time_spec_t device_time;
+        clock_t::duration rtt;
+    };
+
+    void _assert_valid() const;
+    //! Fit the estimate through the current samples
+    void _fit();
+
+    const size_t _num_samples;
+    mutable std::mutex _mutex;
+    std::deque<sample_t> _samples;
+
+    // The estimate: device_time = _device_ref + (host_time - _host_ref) * _rate
+    clock_t::time_point _host_ref;
+    uhd::time_spec_t _device_ref{0.0};
+    double _rate = 1.0;
+};
+
+}}} // namespace uhd::rfnoc::detail
@@ -6,23 +6,48 @@
 
 #pragma once
 
+#include <uhd/stream.hpp>
 #include <uhd/types/metadata.hpp>
-#include <boost/lockfree/queue.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace uhd { namespace rfnoc {
 
 /*!
  *  Implements queue of async messages originating from the tx data transport
  *  and from the rfnoc graph.
+ *
+ *  The queue is a bounded lock-free ring. Any number of threads may enqueue
+ *  messages (the I/O thread of each transport, and the thread that handles
+ *  graph actions), without ever taking a lock or allocating memory. Messages
+ *  that arrive when the ring is full are dropped, and the drop is logged by
+ *  the next call to recv_async_msg().
+ *
+ *  A thread that waits for a message in recv_async_msg() sleeps on an eventfd
+ *  on Linux, which enqueue() only signals if there is a waiter. On other
+ *  platforms, it polls the ring.
+ *
+ *  Alternatively, a callback receives the messages in the context of the
+ *  thread that enqueues them, see set_callback().
  */
 class tx_async_msg_queue
 {
 public:
-    using sptr = std::shared_ptr<tx_async_msg_queue>;
+    using sptr       = std::shared_ptr<tx_async_msg_queue>;
+    using callback_t = uhd::tx_streamer::async_msg_callback_t;
 
-    //! Constructor
+    /*! Constructor
+     *
+     * \param capacity the number of messages that the queue holds, rounded up
+     *        to a power of two
+     */
     tx_async_msg_queue(size_t capacity);
 
+    ~tx_async_msg_queue();
+
     /*!
      *  Retrieve async message from queue
      *
@@ -35,12 +60,73 @@ public:
     /*!
      *  Push an async message onto the queue
      *
+     * If a callback is set, the message is passed to the callback instead.
+     *
      * \param async_metadata the metadata to be pushed
      */
     void enqueue(const async_metadata_t& async_metadata);
 
+    /*!
+     *  Deliver async messages to a callback instead of the queue
+     *
+     * The callback runs in the thread that enqueues the message, which is
+     * usually an I/O thread, so it must return quickly. Messages that are
+     * already in the queue stay there. This may be called while messages are
+     * enqueued.
+     *
+     * \param callback the callback, or an empty function to go back to
+     *        queueing messages
+     */
+    void set_callback(callback_t callback);
+
+    //! Returns the number of messages dropped because the queue was full
+    size_t get_num_dropped() const
+    {
+        return _num_dropped.load(std::memory_order_relaxed);
+    }
+
 private:
-    boost::lockfree::queue<async_metadata_t> _queue;
+    struct cell_t
+    {
+        std::atomic<size_t> seq;
+        async_metadata_t msg;
+    };
+
+    bool _push(const async_metadata_t& async_metadata);
+    bool _pop(async_metadata_t& async_metadata);
+
+    //! Whether there is a message to pop
+    bool _ready() const;
+
+    /*! Waits until there may be a message, for at most until \p end_time
+     *
+     * \return false if \p end_time has passed without waiting
+     */
+    bool _wait(const std::chrono::steady_clock::time_point& end_time);
+
+    // Ring of messages. The sequence number of each cell tells whether it is
+    // free for the producer at a given position, or holds the message for the
+    // consumer at that position.
+    std::unique_ptr<cell_t[]> _cells;
+    const size_t _mask;
+    std::atomic<size_t> _enqueue_pos{0};
+    std::atomic<size_t> _dequeue_pos{0};
+
+    // Number of messages dropped, and the count last logged
+    std::atomic<size_t> _num_dropped{0};
+    size_t _num_dropped_logged = 0;
+
+    // Number of threads waiting in recv_async_msg()
+    std::atomic<size_t> _num_waiters{0};
+
+    // eventfd that enqueue() signals when there are waiters, -1 if none
+    int _event_fd = -1;
+
+    // Current callback. Callbacks replaced by set_callback() are kept alive
+    // until destruction, since an enqueue() may still be running them.
+    std::atomic<callback_t*> _callback{nullptr};
+    std::vector<std::unique_ptr<callback_t>> _callbacks;
+    std::mutex _callbacks_mutex;
 };
 
 }} // namespace uhd::rfnoc
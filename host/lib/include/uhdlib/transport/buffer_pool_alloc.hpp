@@ -0,0 +1,96 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/transport/buffer_pool.hpp>
+#include <string>
+
+namespace uhd { namespace transport {
+
+//! Don't bind the buffer memory to any NUMA node
+static constexpr int BUFF_NUMA_NODE_NONE = -1;
+//! Bind the buffer memory to the NUMA node of the link's network interface
+static constexpr int BUFF_NUMA_NODE_AUTO = -2;
+
+/*!
+ * Describes how the memory of a link's frame buffers is allocated
+ */
+struct buff_alloc_params_t
+{
+    //! Size of the pages backing the buffers in bytes, or 0 for regular pages
+    size_t hugepage_size = 0;
+    //! NUMA node to bind the buffers to, or one of the BUFF_NUMA_NODE_* values
+    int numa_node = BUFF_NUMA_NODE_NONE;
+    //! Whether to fault in the pages of the buffers when they are allocated
+    bool prefault = false;
+};
+
+/*!
+ * Make a buffer pool for the frame buffers of a link.
+ *
+ * With the default parameters, this is the same as buffer_pool::make().
+ * Otherwise, the memory is mapped directly (on hugepages if requested), bound
+ * to the requested NUMA node, and prefaulted so no page faults occur while
+ * streaming. Setting only prefault does the same, on regular pages. Buffers then start at a page boundary and are padded to a
+ * multiple of the cache line size.
+ *
+ * Where hugepages or NUMA binding are not available, this logs a warning and
+ * falls back to regular memory.
+ *
+ * \param num_buffs the number of buffers to allocate
+ * \param buff_size the size of each buffer in bytes
+ * \param params how to allocate the memory. A numa_node of BUFF_NUMA_NODE_AUTO
+ *        must have been resolved by the caller.
+ * \return a new buffer pool
+ */
+buffer_pool::sptr make_buffer_pool(
+    const size_t num_buffs, const size_t buff_size, const buff_alloc_params_t& params);
+
+/*!
+ * Find the NUMA node of the network interface that has a given IP address.
+ *
+ * \param local_addr the IP address of the interface, as a dotted string
+ * \return the NUMA node, or BUFF_NUMA_NODE_NONE if it cannot be determined
+ */
+int get_numa_node_of_addr(const std::string& local_addr);
+
+/*!
+ * Find the name of the network interface that has a given IP address.
+ *
+ * \param local_addr the IP address of the interface, as a dotted string
+ * \return the interface name, or an empty string if there is no such interface
+ */
+std::string get_ifname_of_addr(const std::string& local_addr);
+
+/*!
+ * Find the NUMA node of a network interface.
+ *
+ * \param ifname the name of the interface
+ * \return the NUMA node, or BUFF_NUMA_NODE_NONE if it cannot be determined
+ */
+int get_numa_node_of_ifname(const std::string& ifname);
+
+/*!
+ * Parse the value of the buff_hugepages argument.
+ *
+ * \param value "2M" or "1G" (a trailing "B" is optional), or "0" or "none"
+ * \return the hugepage size in bytes, or 0 for regular pages
+ * \throws uhd::value_error if the value can't be parsed
+ */
+size_t parse_buff_hugepages(const std::string& value);
+
+/*!
+ * Parse the value of the buff_numa_node argument.
+ *
+ * \param value a node number, "auto", or "none"
+ * \return the node number or one of the BUFF_NUMA_NODE_* values
+ * \throws uhd::value_error if the value can't be parsed
+ */
+int parse_buff_numa_node(const std::string& value);
+
+}} // namespace uhd::transport
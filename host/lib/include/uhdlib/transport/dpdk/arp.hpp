@@ -8,6 +8,7 @@
 #include <uhdlib/transport/dpdk/common.hpp>
 #include <uhdlib/transport/dpdk/service_queue.hpp>
 #include <rte_arp.h>
+#include <rte_rwlock.h>
 
 namespace uhd { namespace transport { namespace dpdk {
 
@@ -24,4 +25,24 @@ struct arp_entry
     std::vector<wait_req*> reqs;
 };
 
+/*!
+ * ARP table of a port, in shared memory
+ *
+ * When several processes share a port, only the primary process receives ARP
+ * replies, because they arrive on DMA queue 0. Every process publishes the
+ * addresses it learns here, so secondary processes can look them up.
+ */
+struct shared_arp_table
+{
+    static constexpr size_t MAX_ENTRIES = 64;
+
+    rte_rwlock_t lock;
+    size_t num_entries;
+    struct
+    {
+        ipv4_addr ipv4;
+        struct ether_addr mac_addr;
+    } entries[MAX_ENTRIES];
+};
+
 }}} /* namespace uhd::transport::dpdk */
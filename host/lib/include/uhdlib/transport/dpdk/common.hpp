@@ -10,19 +10,23 @@
 #include <uhd/transport/frame_buff.hpp>
 #include <uhd/types/device_addr.hpp>
 #include <uhdlib/transport/adapter_info.hpp>
+#include <rte_eal.h>
 #include <rte_ethdev.h>
 #include <rte_ether.h>
 #include <rte_flow.h>
 #include <rte_mbuf.h>
 #include <rte_mempool.h>
+#include <rte_memzone.h>
 #include <rte_spinlock.h>
 #include <rte_version.h>
+#include <unistd.h>
 #include <unordered_map>
 #include <array>
 #include <atomic>
 #include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 
 /* NOTE: There are changes to all the network standard fields in 19.x */
 
@@ -34,11 +38,44 @@ class dpdk_io_service;
 namespace dpdk {
 
 struct arp_entry;
+struct shared_arp_table;
 
 using queue_id_t = uint16_t;
 using port_id_t  = uint16_t;
 using ipv4_addr  = uint32_t;
 
+/*!
+ * Whether this process attached to the NICs as a DPDK secondary process
+ *
+ * A secondary process shares the ports that a primary process configured. It
+ * only uses the DMA queues it was assigned, and must not reconfigure, start or
+ * stop the ports.
+ */
+inline bool is_secondary_process()
+{
+    return rte_eal_process_type() == RTE_PROC_SECONDARY;
+}
+
+/*!
+ * Make the name of a DPDK object (ring, hash table, ...) unique to this process
+ *
+ * DPDK objects are named in a namespace shared by all processes that use the
+ * same hugepage files. Secondary processes prefix the names with their process
+ * ID, so their objects don't clash with those of other processes.
+ *
+ * \param name the name of the object within this process
+ * \return the name to create the object with
+ */
+inline std::string unique_name(const std::string& name)
+{
+    if (!is_secondary_process()) {
+        return name;
+    }
+    char prefix[16];
+    snprintf(prefix, sizeof(prefix), "%x:", static_cast<unsigned int>(getpid()));
+    return prefix + name;
+}
+
 class dpdk_adapter_info : public adapter_info
 {
 public:
@@ -101,6 +138,18 @@ public:
         _data = (void*)((uint8_t*)_data + hdr_size);
     }
 
+    /*!
+     * Get the time at which the NIC received this packet. This requires RX
+     * timestamp offload to be enabled on the port (dpdk_rx_timestamp).
+     *
+     * \return the NIC's timestamp, in device-specific units, or 0 if the
+     *         packet was not timestamped
+     */
+    inline uint64_t get_rx_timestamp() const
+    {
+        return (_mbuf->ol_flags & PKT_RX_TIMESTAMP) ? _mbuf->timestamp : 0;
+    }
+
     //! Embedded list node's next ptr
     dpdk_frame_buff* next = nullptr;
     //! Embedded list node's prev ptr
@@ -119,6 +168,18 @@ private:
 constexpr size_t DPDK_MBUF_PRIV_SIZE =
     RTE_ALIGN(sizeof(struct dpdk_frame_buff), RTE_MBUF_PRIV_ALIGN);
 
+/*!
+ * Optional hardware offloads for a DPDK NIC port, which are off unless
+ * requested. IPv4 checksum offload is always required.
+ */
+struct port_offloads_t
+{
+    //! Have the NIC compute UDP checksums on TX and verify them on RX
+    bool udp_cksum = false;
+    //! Have the NIC timestamp received packets
+    bool rx_timestamp = false;
+};
+
 /*!
  * Class representing a DPDK NIC port
  *
@@ -144,7 +205,18 @@ public:
      * \param rx_pktbuf_pool A pointer to the port's RX packet buffer pool
      * \param tx_pktbuf_pool A pointer to the port's TX packet buffer pool
      * \param ipv4_address The IPv4 network address (w/ netmask)
+     * \param offloads The optional hardware offloads to enable. Those the NIC
+     *                 doesn't support are left disabled.
+     * \param first_queue The lowest DMA queue this process uses on the port.
+     *                    It selects the block of UDP ports that
+     *                    alloc_udp_port() picks from, so that processes
+     *                    sharing the port don't pick the same ones.
      * \return A unique_ptr to a dpdk_port object
+     *
+     * In a secondary process, the port was already configured and started by
+     * the primary process. The MTU, queue count and offloads are then read
+     * back from the port, and mtu, num_queues, num_desc and offloads are
+     * ignored.
      */
     static dpdk_port::uptr make(port_id_t port,
         size_t mtu,
@@ -152,7 +224,9 @@ public:
         uint16_t num_desc,
         struct rte_mempool* rx_pktbuf_pool,
         struct rte_mempool* tx_pktbuf_pool,
-        std::string ipv4_address);
+        std::string ipv4_address,
+        const port_offloads_t& offloads = port_offloads_t(),
+        queue_id_t first_queue          = 0);
 
     dpdk_port(port_id_t port,
         size_t mtu,
@@ -160,7 +234,9 @@ public:
         uint16_t num_desc,
         struct rte_mempool* rx_pktbuf_pool,
         struct rte_mempool* tx_pktbuf_pool,
-        std::string ipv4_address);
+        std::string ipv4_address,
+        const port_offloads_t& offloads = port_offloads_t(),
+        queue_id_t first_queue          = 0);
 
     ~dpdk_port();
 
@@ -219,6 +295,27 @@ public:
         return _num_queues;
     }
 
+    /*! Getter for the optional hardware offloads enabled on this port
+     * \return the offloads the NIC actually supports out of the requested ones
+     */
+    inline const port_offloads_t& get_offloads() const
+    {
+        return _offloads;
+    }
+
+    /*! Whether UDP flows can be steered to DMA queues other than queue 0
+     *
+     * This requires more than one DMA queue, and support in the NIC for
+     * rte_flow rules that match on the UDP destination port. Without it, all
+     * packets are received on queue 0.
+     *
+     * \return whether flow steering rules can be added to this port
+     */
+    inline bool can_steer_flows() const
+    {
+        return _can_steer_flows;
+    }
+
     /*! Getter for this port's RX packet buffer memory pool
      *
      * \return The RX packet buffer pool
@@ -255,7 +352,43 @@ public:
      */
     uint16_t alloc_udp_port(uint16_t udp_port);
 
+    /*!
+     * Queue a packet for transmission on a DMA queue
+     *
+     * Packets are handed to the NIC in bursts, once TX_BATCH_SIZE of them
+     * are queued or when flush_tx() is called. This saves a doorbell write
+     * per packet. Each DMA queue must only be used by a single lcore.
+     *
+     * \param queue_id the DMA queue to transmit on
+     * \param mbuf the packet to transmit
+     */
+    inline void queue_tx(queue_id_t queue_id, struct rte_mbuf* mbuf)
+    {
+        auto& batch = _tx_batches[queue_id];
+        if (batch.count == TX_BATCH_SIZE) {
+            flush_tx(queue_id);
+        }
+        batch.mbufs[batch.count++] = mbuf;
+    }
+
+    /*!
+     * Transmit all packets queued on a DMA queue by queue_tx()
+     *
+     * \param queue_id the DMA queue to flush
+     */
+    void flush_tx(queue_id_t queue_id);
+
+    //! Maximum number of packets queued by queue_tx() before they are sent
+    static constexpr uint16_t TX_BATCH_SIZE = 32;
+
 private:
+    //! Packets waiting for transmission on a DMA queue
+    struct tx_batch_t
+    {
+        std::array<struct rte_mbuf*, TX_BATCH_SIZE> mbufs;
+        uint16_t count = 0;
+    };
+
     friend uhd::transport::dpdk_io_service;
 
     /*!
@@ -263,9 +396,64 @@ private:
      */
     int _arp_reply(queue_id_t queue_id, struct arp_hdr* arp_req);
 
+    /*!
+     * Steer all packets for the given UDP port to a DMA queue
+     *
+     * \param udp_port the destination UDP port (in network order)
+     * \param queue_id the DMA queue to receive the packets on
+     * \return 0 on success, else a negative errno value
+     */
+    int _add_flow_rule(uint16_t udp_port, queue_id_t queue_id);
+
+    /*!
+     * Remove a rule that was added by _add_flow_rule()
+     *
+     * \param udp_port the destination UDP port (in network order)
+     */
+    void _remove_flow_rule(uint16_t udp_port);
+
+    /*!
+     * Create or validate an rte_flow rule matching IPv4/UDP packets for this
+     * port's address and the given UDP port, which sends them to a DMA queue
+     *
+     * \param udp_port the destination UDP port (in network order)
+     * \param queue_id the DMA queue to receive the packets on
+     * \param flow where to store the created rule, or nullptr to only
+     *             validate it
+     * \return 0 on success, else a negative errno value
+     */
+    int _make_flow_rule(uint16_t udp_port, queue_id_t queue_id, struct rte_flow** flow);
+
+    /*!
+     * Read back the configuration of a port that the primary process set up
+     *
+     * \param first_queue The lowest DMA queue used by this process
+     */
+    void _attach_secondary(queue_id_t first_queue);
+
+    /*!
+     * Store an address in the ARP table that is shared between processes
+     *
+     * \param ipv4 the IPv4 address (in network order)
+     * \param mac_addr the MAC address for ipv4
+     */
+    void _publish_arp(ipv4_addr ipv4, const struct ether_addr& mac_addr);
+
+    /*!
+     * Look up an address in the ARP table that is shared between processes
+     *
+     * \param ipv4 the IPv4 address (in network order)
+     * \param mac_addr where to store the MAC address for ipv4
+     * \return whether the address was found
+     */
+    bool _lookup_shared_arp(ipv4_addr ipv4, struct ether_addr& mac_addr);
+
     port_id_t _port;
     size_t _mtu;
     size_t _num_queues;
+    bool _can_steer_flows = false;
+    port_offloads_t _offloads;
+    std::vector<tx_batch_t> _tx_batches;
     struct rte_mempool* _rx_pktbuf_pool;
     struct rte_mempool* _tx_pktbuf_pool;
     struct ether_addr _mac_addr;
@@ -276,10 +464,17 @@ private:
     std::mutex _mutex;
     std::set<uint16_t> _udp_ports;
     uint16_t _next_udp_port = 0xffff;
+    std::unordered_map<uint16_t, struct rte_flow*> _flow_rules;
 
     // Structures protected by spin lock
     rte_spinlock_t _spinlock = RTE_SPINLOCK_INITIALIZER;
     std::unordered_map<ipv4_addr, struct arp_entry*> _arp_table;
+
+    // ARP table in shared memory, which has its own lock
+    const struct rte_memzone* _shared_arp_mz = nullptr;
+    struct shared_arp_table* _shared_arp     = nullptr;
+    // ARP requests waiting for another process to receive the reply
+    std::atomic<size_t> _num_shared_arp_reqs{0};
 };
 
 
@@ -356,8 +551,16 @@ public:
     bool is_init_done(void) const;
 
     /*! Return a reference to an IO service given a port ID
+     *
+     * When several lcores serve a port, each of them owns one of its DMA
+     * queues, and the UDP port selects which of them handles a flow. The same
+     * UDP port always yields the same I/O service.
+     *
+     * \param port_id NIC port ID
+     * \param udp_port the local UDP port of the flow (in network order)
      */
-    std::shared_ptr<uhd::transport::dpdk_io_service> get_io_service(const size_t port_id);
+    std::shared_ptr<uhd::transport::dpdk_io_service> get_io_service(
+        const size_t port_id, const uint16_t udp_port = 0);
 
 private:
     /*! Convert the args to DPDK's EAL args and Initialize the EAL
@@ -367,7 +570,8 @@ private:
     void _eal_init(const device_addr_t& eal_args);
 
     /*! Either allocate or return a pointer to the RX packet buffer pool for the
-     * given CPU socket
+     * given CPU socket. Secondary processes look up the pool of the primary
+     * process instead.
      *
      * \param cpu_socket The CPU socket ID
      * \param num_bufs Number of buffers to allocate to the pool
@@ -376,7 +580,8 @@ private:
     struct rte_mempool* _get_rx_pktbuf_pool(unsigned int cpu_socket, size_t num_bufs);
 
     /*! Either allocate or return a pointer to the TX packet buffer pool for the
-     * given CPU socket
+     * given CPU socket. Secondary processes look up the pool of the primary
+     * process instead.
      *
      * \param cpu_socket The CPU socket ID
      * \param num_bufs Number of buffers to allocate to the pool
@@ -388,15 +593,17 @@ private:
     int _num_mbufs;
     int _mbuf_cache_size;
     int _link_init_timeout;
+    size_t _client_spin_us;
     std::mutex _init_mutex;
     std::atomic<bool> _init_done;
     uhd::dict<uint32_t, port_id_t> _routes;
     std::unordered_map<port_id_t, dpdk_port::uptr> _ports;
     std::vector<struct rte_mempool*> _rx_pktbuf_pools;
     std::vector<struct rte_mempool*> _tx_pktbuf_pools;
-    // Store all the I/O services, and also store the corresponding port ID
-    std::map<std::shared_ptr<uhd::transport::dpdk_io_service>, std::vector<size_t>>
-        _io_srv_portid_map;
+    // Store the I/O services serving each port, indexed by their DMA queue
+    std::unordered_map<port_id_t,
+        std::vector<std::shared_ptr<uhd::transport::dpdk_io_service>>>
+        _port_io_srvs;
 };
 
 } // namespace dpdk
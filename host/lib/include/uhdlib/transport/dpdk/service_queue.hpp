@@ -7,6 +7,7 @@
 
 #include <uhd/exception.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhdlib/transport/dpdk/common.hpp>
 #include <condition_variable>
 #include <rte_malloc.h>
 #include <rte_ring.h>
@@ -124,7 +125,7 @@ public:
      */
     service_queue(size_t depth, unsigned int lcore_id)
     {
-        std::string name = std::string("servq") + std::to_string(lcore_id);
+        std::string name = unique_name("servq" + std::to_string(lcore_id));
         _waiter_ring     = rte_ring_create(
             name.c_str(), depth, rte_lcore_to_socket_id(lcore_id), RING_F_SC_DEQ);
         if (!_waiter_ring) {
@@ -89,6 +89,12 @@ inline void fill_udp_hdr(struct rte_mbuf* mbuf,
     tx_hdr->dgram_len   = rte_cpu_to_be_16(8 + payload_len);
     tx_hdr->dgram_cksum = 0;
     mbuf->l4_len        = sizeof(struct udp_hdr);
+
+    if (port->get_offloads().udp_cksum) {
+        // The NIC expects the pseudo-header checksum to be filled in
+        mbuf->ol_flags |= PKT_TX_UDP_CKSUM;
+        tx_hdr->dgram_cksum = rte_ipv4_phdr_cksum(ip_hdr, mbuf->ol_flags);
+    }
 }
 
 //! Return an IPv4 address (numeric, in network order) into a string
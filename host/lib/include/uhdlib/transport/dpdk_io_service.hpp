@@ -27,8 +27,22 @@ class dpdk_io_service : public virtual io_service,
 public:
     using sptr = std::shared_ptr<dpdk_io_service>;
 
-    static sptr make(
-        unsigned int lcore_id, std::vector<dpdk::dpdk_port*> ports, size_t servq_depth);
+    /*!
+     * Make an I/O service and launch its worker on the given lcore
+     *
+     * \param lcore_id the lcore to run the I/O worker on
+     * \param ports the NIC ports served by this I/O service
+     * \param queues the DMA queue this I/O service owns on each of the ports
+     * \param servq_depth the depth of the service queue for client requests
+     * \param client_spin_us if nonzero, clients poll their queues for up to
+     *                       this long before they block, in microseconds (see
+     *                       hybrid_wait)
+     */
+    static sptr make(unsigned int lcore_id,
+        std::vector<dpdk::dpdk_port*> ports,
+        std::vector<dpdk::queue_id_t> queues,
+        size_t servq_depth,
+        size_t client_spin_us = 0);
 
     ~dpdk_io_service();
 
@@ -65,8 +79,11 @@ private:
     friend class dpdk_recv_io;
     friend class dpdk_send_io;
 
-    dpdk_io_service(
-        unsigned int lcore_id, std::vector<dpdk::dpdk_port*> ports, size_t servq_depth);
+    dpdk_io_service(unsigned int lcore_id,
+        std::vector<dpdk::dpdk_port*> ports,
+        std::vector<dpdk::queue_id_t> queues,
+        size_t servq_depth,
+        size_t client_spin_us);
     dpdk_io_service(const dpdk_io_service&) = delete;
 
     /*!
@@ -172,6 +189,15 @@ private:
     int _process_arp(
         dpdk::dpdk_port* port, dpdk::queue_id_t queue_id, struct arp_hdr* arp_frame);
 
+    /*!
+     * Helper function for I/O thread of a secondary process to complete ARP
+     * requests, once the primary process received the replies
+     *
+     * The replies arrive on DMA queue 0, which is served by the primary
+     * process. It publishes the addresses in the port's shared ARP table.
+     */
+    void _poll_shared_arp();
+
     /*!
      * Helper function for I/O thread to process an IPv4 packet
      *
@@ -193,6 +219,14 @@ private:
     int _process_udp(
         dpdk::dpdk_port* port, struct rte_mbuf* mbuf, struct udp_hdr* pkt, bool bcast);
 
+    /*!
+     * Get the DMA queue this I/O service owns on a port
+     *
+     * \param port a DPDK NIC port served by this I/O service
+     * \return the ID of the queue for RX and TX on the port
+     */
+    dpdk::queue_id_t _get_queue_id(dpdk::dpdk_port* port) const;
+
     /*!
      * Helper function to get a unique client ID
      *
@@ -211,6 +245,8 @@ private:
     unsigned int _lcore_id;
     //! The NIC ports served by this dpdk_io_service
     std::vector<dpdk::dpdk_port*> _ports;
+    //! The DMA queue used on each of the ports, in the same order as _ports
+    std::vector<dpdk::queue_id_t> _queues;
     //! The set of TX queues associated with a given port
     std::unordered_map<dpdk::port_id_t, std::list<dpdk_send_io*>> _tx_queues;
     //! The list of recv_io for each port
@@ -219,8 +255,12 @@ private:
     struct rte_hash* _rx_table;
     //! Service queue for clients to make requests
     dpdk::service_queue _servq;
+    //! How long clients spin before they block
+    const size_t _client_spin_us;
     //! Retry list for waking clients
     dpdk_io_if* _retry_head = NULL;
+    //! Whether this is a DPDK secondary process, which can't receive ARP replies
+    const bool _is_secondary;
 
     //! Mutex to protect below data structures
     std::mutex _mutex;
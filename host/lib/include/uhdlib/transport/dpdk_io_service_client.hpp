@@ -9,6 +9,7 @@
 #include <uhdlib/transport/dpdk/service_queue.hpp>
 #include <uhdlib/transport/dpdk/udp.hpp>
 #include <uhdlib/transport/dpdk_io_service.hpp>
+#include <uhdlib/transport/hybrid_wait.hpp>
 #include <uhdlib/transport/udp_dpdk_link.hpp>
 #include <rte_ring.h>
 #include <chrono>
@@ -68,6 +69,7 @@ public:
         fc_callback_t fc_cb)
         : _dpdk_io_if(false, link, io_srv, recv_cb)
         , _servq(io_srv->_servq)
+        , _wait(io_srv->_client_spin_us)
         , _send_cb(send_cb)
         , _fc_cb(fc_cb)
     {
@@ -83,11 +85,15 @@ public:
         uint16_t id              = io_srv->_get_unique_client_id();
         char name[16];
         snprintf(name, sizeof(name), "tx%hu-%hu", nic_port, id);
-        _buffer_queue = rte_ring_create(
-            name, queue_size, rte_socket_id(), RING_F_SP_ENQ | RING_F_SC_DEQ);
+        _buffer_queue = rte_ring_create(dpdk::unique_name(name).c_str(),
+            queue_size,
+            rte_socket_id(),
+            RING_F_SP_ENQ | RING_F_SC_DEQ);
         snprintf(name, sizeof(name), "~tx%hu-%hu", nic_port, id);
-        _send_queue = rte_ring_create(
-            name, queue_size, rte_socket_id(), RING_F_SP_ENQ | RING_F_SC_DEQ);
+        _send_queue = rte_ring_create(dpdk::unique_name(name).c_str(),
+            queue_size,
+            rte_socket_id(),
+            RING_F_SP_ENQ | RING_F_SC_DEQ);
         UHD_LOG_TRACE("DPDK::SEND_IO", "dpdk_send_io() " << _buffer_queue->name);
 
         // Create the wait_request object that gets passed around
@@ -119,11 +125,38 @@ public:
     }
 
     frame_buff::uptr get_send_buff(int32_t timeout_ms)
+    {
+        return frame_buff::uptr(_wait.wait(
+            [this]() {
+                frame_buff* buff_ptr = nullptr;
+                rte_ring_dequeue(_buffer_queue, (void**)&buff_ptr);
+                return buff_ptr;
+            },
+            [this](const int32_t timeout) { return _wait_for_buff(timeout); },
+            timeout_ms));
+    }
+
+    void release_send_buff(frame_buff::uptr buff)
+    {
+        auto buff_ptr = (dpdk::dpdk_frame_buff*)buff.release();
+        assert(buff_ptr);
+        int status = rte_ring_enqueue(_send_queue, buff_ptr);
+        if (status != 0) {
+            assert(false);
+        }
+        // TODO: Should we retry if it failed?
+    }
+
+private:
+    friend class dpdk_io_service;
+
+    //! Waits for the I/O service to put a buffer into the queue
+    frame_buff* _wait_for_buff(int32_t timeout_ms)
     {
         frame_buff* buff_ptr;
         if (rte_ring_dequeue(_buffer_queue, (void**)&buff_ptr)) {
             if (!timeout_ms) {
-                return frame_buff::uptr();
+                return nullptr;
             }
             // Nothing in the queue. Try waiting if there is a timeout.
             auto timeout_point =
@@ -137,7 +170,7 @@ public:
             } else {
                 auto status = _waiter->cond.wait_until(lock, timeout_point, is_complete);
                 if (!status) {
-                    return frame_buff::uptr();
+                    return nullptr;
                 }
             }
             // Occasionally the conditional variable wait method returns but the
@@ -147,27 +180,14 @@ public:
             while (rte_ring_dequeue(_buffer_queue, (void**)&buff_ptr)) {
             }
         }
-        return frame_buff::uptr(buff_ptr);
+        return buff_ptr;
     }
 
-    void release_send_buff(frame_buff::uptr buff)
-    {
-        auto buff_ptr = (dpdk::dpdk_frame_buff*)buff.release();
-        assert(buff_ptr);
-        int status = rte_ring_enqueue(_send_queue, buff_ptr);
-        if (status != 0) {
-            assert(false);
-        }
-        // TODO: Should we retry if it failed?
-    }
-
-private:
-    friend class dpdk_io_service;
-
     dpdk_io_if _dpdk_io_if;
     size_t _num_frames_in_use = 0;
 
     dpdk::service_queue& _servq;
+    hybrid_wait _wait;
     dpdk::dpdk_ctx::sptr _ctx;
     struct rte_ring* _buffer_queue;
     struct rte_ring* _send_queue;
@@ -189,6 +209,7 @@ public:
         fc_callback_t fc_cb)
         : _dpdk_io_if(true, link, io_srv, recv_cb)
         , _servq(io_srv->_servq)
+        , _wait(io_srv->_client_spin_us)
         , _fc_cb(fc_cb) // Call on release
     {
         // Get reference to DPDK context, since this owns some DPDK memory
@@ -204,11 +225,15 @@ public:
             "DPDK::IO_SERVICE", "Creating recv client with queue size of " << queue_size);
         char name[16];
         snprintf(name, sizeof(name), "rx%hu-%hu", nic_port, id);
-        _recv_queue = rte_ring_create(
-            name, queue_size, rte_socket_id(), RING_F_SP_ENQ | RING_F_SC_DEQ);
+        _recv_queue = rte_ring_create(dpdk::unique_name(name).c_str(),
+            queue_size,
+            rte_socket_id(),
+            RING_F_SP_ENQ | RING_F_SC_DEQ);
         snprintf(name, sizeof(name), "~rx%hu-%hu", nic_port, id);
-        _release_queue = rte_ring_create(
-            name, queue_size, rte_socket_id(), RING_F_SP_ENQ | RING_F_SC_DEQ);
+        _release_queue = rte_ring_create(dpdk::unique_name(name).c_str(),
+            queue_size,
+            rte_socket_id(),
+            RING_F_SP_ENQ | RING_F_SC_DEQ);
         UHD_LOG_TRACE("DPDK::RECV_IO", "dpdk_recv_io() " << _recv_queue->name);
         // Create the wait_request object that gets passed around
         _waiter = dpdk::wait_req_alloc(dpdk::wait_type::WAIT_RX, (void*)&_dpdk_io_if);
@@ -231,11 +256,42 @@ public:
     }
 
     frame_buff::uptr get_recv_buff(int32_t timeout_ms)
+    {
+        return frame_buff::uptr(_wait.wait(
+            [this]() {
+                frame_buff* buff_ptr = nullptr;
+                rte_ring_dequeue(_recv_queue, (void**)&buff_ptr);
+                return buff_ptr;
+            },
+            [this](const int32_t timeout) { return _wait_for_buff(timeout); },
+            timeout_ms));
+    }
+
+    void release_recv_buff(frame_buff::uptr buff)
+    {
+        frame_buff* buff_ptr = buff.release();
+        int status           = rte_ring_enqueue(_release_queue, buff_ptr);
+        if (status != 0) {
+            assert(false);
+        }
+    }
+
+    bool set_ready_callback(ready_callback_t cb)
+    {
+        _ready_notifier.set(std::move(cb));
+        return true;
+    }
+
+private:
+    friend class dpdk_io_service;
+
+    //! Waits for the I/O service to put a buffer into the queue
+    frame_buff* _wait_for_buff(int32_t timeout_ms)
     {
         frame_buff* buff_ptr;
         if (rte_ring_dequeue(_recv_queue, (void**)&buff_ptr)) {
             if (!timeout_ms) {
-                return frame_buff::uptr();
+                return nullptr;
             }
             // Nothing in the queue. Try waiting if there is a timeout.
             auto timeout_point =
@@ -249,7 +305,7 @@ public:
             } else {
                 auto status = _waiter->cond.wait_until(lock, timeout_point, is_complete);
                 if (!status) {
-                    return frame_buff::uptr();
+                    return nullptr;
                 }
             }
             // Occasionally the conditional variable wait method returns but the
@@ -259,30 +315,21 @@ public:
             while (rte_ring_dequeue(_recv_queue, (void**)&buff_ptr)) {
             }
         }
-        return frame_buff::uptr(buff_ptr);
+        return buff_ptr;
     }
 
-    void release_recv_buff(frame_buff::uptr buff)
-    {
-        frame_buff* buff_ptr = buff.release();
-        int status           = rte_ring_enqueue(_release_queue, buff_ptr);
-        if (status != 0) {
-            assert(false);
-        }
-    }
-
-private:
-    friend class dpdk_io_service;
-
     dpdk_io_if _dpdk_io_if;
     size_t _num_frames_in_use = 0;
 
     dpdk::service_queue& _servq;
+    hybrid_wait _wait;
     dpdk::dpdk_ctx::sptr _ctx;
     struct rte_ring* _recv_queue;
     struct rte_ring* _release_queue;
     dpdk::wait_req* _waiter;
     fc_callback_t _fc_cb;
+    //! Called by the I/O service for every frame in _recv_queue
+    recv_ready_notifier _ready_notifier;
 };
 
 
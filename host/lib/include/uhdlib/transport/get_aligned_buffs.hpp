@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <uhd/config.hpp>
 #include <uhd/exception.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhdlib/transport/samps_to_ticks.hpp>
 #include <boost/dynamic_bitset.hpp>
 #include <boost/format.hpp>
 
@@ -22,9 +24,18 @@ constexpr size_t ALIGNMENT_FAILURE_THRESHOLD = 1000;
 
 /*!
  * Implementation of rx time alignment. This method reads packets from the
- * transports for each channel and discards any packets whose tsf does not
- * match those of other channels due to dropped packets. Packets that do not
- * have a tsf are not checked for alignment and never dropped.
+ * transports for each channel and aligns them to the latest tsf among them.
+ * Packets that start before that time, but contain a sample at it, are
+ * trimmed to start at that sample: the payload pointer in the packet info is
+ * moved past the leading samples, without copying anything. Packets that end
+ * before that time, e.g. due to dropped packets, are discarded. Packets that
+ * do not have a tsf are not checked for alignment and never dropped.
+ *
+ * Aligned packets can hold different numbers of samples after trimming. The
+ * caller consumes the smallest number, see rx_streamer_zero_copy.
+ *
+ * Only the active channels are aligned. The caller drains the transports of
+ * the others.
  */
 template <typename transport_t, bool ignore_seq_err = false>
 class get_aligned_buffs
@@ -38,12 +49,26 @@ public:
         BAD_PACKET
     };
 
+    /*!
+     * \param xports the transports of the channels
+     * \param frame_buffs the storage for buffers resulting from alignment
+     * \param infos the packet info of the buffers
+     * \param to_ticks the conversion of samples to ticks, used for trimming
+     * \param bytes_per_item the size of a sample, used for trimming
+     * \param active the channels to align
+     */
     get_aligned_buffs(std::vector<typename transport_t::uptr>& xports,
         std::vector<typename transport_t::buff_t::uptr>& frame_buffs,
-        std::vector<typename transport_t::packet_info_t>& infos)
+        std::vector<typename transport_t::packet_info_t>& infos,
+        const samps_to_ticks& to_ticks,
+        const size_t& bytes_per_item,
+        const boost::dynamic_bitset<>& active)
         : _xports(xports)
         , _frame_buffs(frame_buffs)
         , _infos(infos)
+        , _to_ticks(to_ticks)
+        , _bytes_per_item(bytes_per_item)
+        , _active(active)
         , _prev_tsf(_xports.size(), 0)
         , _channels_to_align(_xports.size())
     {
@@ -51,8 +76,12 @@ public:
 
     alignment_result_t operator()(const int32_t timeout_ms)
     {
+        if (_xports.size() == 1) {
+            return _get_single_buff(timeout_ms);
+        }
+
         // Clear state
-        _channels_to_align.set();
+        _channels_to_align = _active;
         bool time_valid   = false;
         uint64_t tsf      = 0;
         size_t iterations = 0;
@@ -109,18 +138,10 @@ public:
                         return ALIGNMENT_FAILURE;
                     }
 
-                    // Release buffers for channels aligned previously. Keep
-                    // buffers that don't have a tsf since we don't need to
-                    // align those.
-                    for (size_t i = 0; i < _xports.size(); i++) {
-                        if (!_channels_to_align.test(i) && _infos[i].has_tsf) {
-                            _xports[i]->release_recv_buff(std::move(_frame_buffs[i]));
-                            _frame_buffs[i] = nullptr;
-                        }
-                    }
-
-                    // Mark only this channel as aligned and save its tsf
-                    _channels_to_align.set();
+                    // Mark only this channel as aligned and save its tsf.
+                    // Channels aligned previously are checked again against
+                    // the new time, which trims or discards their packets.
+                    _channels_to_align = _active;
                     _channels_to_align.reset(chan);
                     time_valid = true;
                     tsf        = info.tsf;
@@ -131,8 +152,12 @@ public:
                     _channels_to_align.reset(chan);
                 }
 
-                // Otherwise, time is smaller than other channels, release the buffer
-                else {
+                // Otherwise, time is smaller than other channels. Trim the
+                // packet if it contains the sample at that time, otherwise
+                // release the buffer.
+                else if (_trim(info, tsf)) {
+                    _channels_to_align.reset(chan);
+                } else {
                     _xports[chan]->release_recv_buff(std::move(_frame_buffs[chan]));
                     _frame_buffs[chan] = nullptr;
                 }
@@ -154,6 +179,61 @@ public:
     }
 
 private:
+    /*!
+     * Moves the start of a packet to the sample at \p tsf, if the packet
+     * contains it.
+     *
+     * \return true if the packet was trimmed
+     */
+    bool _trim(typename transport_t::packet_info_t& info, const uint64_t tsf) const
+    {
+        uint64_t num_samps = 0;
+        if (_bytes_per_item == 0 || !_to_ticks.to_samps(tsf - info.tsf, num_samps)) {
+            return false;
+        }
+        const size_t num_bytes = num_samps * _bytes_per_item;
+        if (num_bytes >= info.payload_bytes) {
+            return false;
+        }
+        info.payload = static_cast<const uint8_t*>(info.payload) + num_bytes;
+        info.payload_bytes -= num_bytes;
+        info.tsf = tsf;
+        return true;
+    }
+
+    /*!
+     * With a single channel, there is nothing to align. This does the same as
+     * the generic implementation, but skips all the alignment bookkeeping.
+     */
+    UHD_FORCE_INLINE alignment_result_t _get_single_buff(const int32_t timeout_ms)
+    {
+        auto& frame_buff = _frame_buffs[0];
+        bool seq_error   = false;
+
+        if (!frame_buff) {
+            try {
+                std::tie(frame_buff, _infos[0], seq_error) =
+                    _xports[0]->get_recv_buff(timeout_ms);
+            } catch (const uhd::value_error& e) {
+                UHD_LOGGER_ERROR("STREAMER")
+                    << boost::format(
+                           "The receive transport caught a value exception.\n%s")
+                           % e.what();
+                return BAD_PACKET;
+            }
+        }
+
+        if (!frame_buff) {
+            return TIMEOUT;
+        }
+
+        if (seq_error && !ignore_seq_err) {
+            UHD_LOG_FASTPATH("D");
+            return SEQUENCE_ERROR;
+        }
+        return SUCCESS;
+    }
+
     // Transports for each channel
     std::vector<typename transport_t::uptr>& _xports;
 
@@ -163,6 +243,15 @@ private:
     // Packet info corresponding to aligned buffers
     std::vector<typename transport_t::packet_info_t>& _infos;
 
+    // Conversion of sample counts to ticks, for trimming packets
+    const samps_to_ticks& _to_ticks;
+
+    // Size of a sample on the device, for trimming packets
+    const size_t& _bytes_per_item;
+
+    // Channels to align
+    const boost::dynamic_bitset<>& _active;
+
     // Time of previous packet for each channel
     std::vector<uint64_t> _prev_tsf;
 
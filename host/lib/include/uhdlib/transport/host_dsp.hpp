@@ -0,0 +1,319 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/utils/math.hpp>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace uhd { namespace transport {
+
+//! Layout of sc16 samples on the wire, for the host DSP of the streamers
+enum class sc16_wire_format_t { CHDR, ITEM32_LE, ITEM32_BE };
+
+/*!
+ * Returns the layout of an otw format, e.g. "sc16_chdr"
+ *
+ * \throws uhd::value_error if the format isn't sc16
+ */
+inline sc16_wire_format_t get_sc16_wire_format(const std::string& otw_format)
+{
+    if (otw_format == "sc16_chdr") {
+        return sc16_wire_format_t::CHDR;
+    } else if (otw_format == "sc16_item32_le") {
+        return sc16_wire_format_t::ITEM32_LE;
+    } else if (otw_format == "sc16_item32_be") {
+        return sc16_wire_format_t::ITEM32_BE;
+    }
+    throw uhd::value_error("Host DSP is not supported for " + otw_format);
+}
+
+/*!
+ * Resampling by an arbitrary ratio with a polyphase filter bank
+ *
+ * This is the core of the host DSP of the streamers, see rx_host_dsp and
+ * tx_host_dsp. Input samples are appended to a short history, and output
+ * samples are computed from it as far as the history reaches.
+ *
+ * The history is kept as separate arrays of I and Q, and the taps of each
+ * phase are stored in the order of the samples they multiply, so every output
+ * sample is two contiguous dot products that the compiler vectorizes for the
+ * SIMD instruction set of the target (SSE, AVX, NEON).
+ *
+ * The low-pass filter is a windowed sinc with a group delay of half its
+ * length, in input samples, and its first outputs contain its settling.
+ */
+class polyphase_resampler
+{
+public:
+    //! Number of phases of the filter bank
+    static constexpr size_t NUM_PHASES = 64;
+
+    //! Number of taps per phase, per unit of the decimation ratio
+    static constexpr size_t TAPS_PER_PHASE = 16;
+
+    //! Largest decimation ratio, which bounds the length of the filter
+    static constexpr size_t MAX_DECIM = 256;
+
+    //! Constructor, for a ratio of 1
+    polyphase_resampler()
+    {
+        configure(1.0, 1.0);
+    }
+
+    /*!
+     * Designs the filter and resets the history
+     *
+     * \param step the number of input samples per output sample
+     * \param gain the gain of the filter, which also scales the samples
+     */
+    void configure(const double step, const double gain)
+    {
+        using uhd::math::PI;
+        _step              = step;
+        const double decim = std::max(1.0, _step);
+        // Without resampling, the filter is a single tap that only scales
+        _num_taps = (_step == 1.0) ? 1 : TAPS_PER_PHASE * size_t(std::ceil(decim));
+
+        // Windowed sinc, evaluated at the fractional delay of each phase. The
+        // passband is 90% of the lower of the two Nyquist rates.
+        const double cutoff = 0.45 / decim;
+        const double center = (double(_num_taps) - 1.0) / 2.0;
+        const double half   = double(_num_taps) / 2.0;
+        _taps.resize(NUM_PHASES * _num_taps);
+        std::vector<double> h(_num_taps);
+        for (size_t p = 0; p < NUM_PHASES; p++) {
+            float* taps = &_taps[p * _num_taps];
+            if (_num_taps == 1) {
+                taps[0] = float(gain);
+                continue;
+            }
+            double sum = 0.0;
+            for (size_t k = 0; k < _num_taps; k++) {
+                // Distance of sample k from the output time, in input samples
+                const double x =
+                    double(_num_taps - 1 - k) + double(p) / NUM_PHASES - center;
+                const double arg    = 2.0 * cutoff * x;
+                const double sinc   = (arg == 0.0) ? 1.0 : std::sin(PI * arg) / PI / arg;
+                const double window = 0.42 + 0.5 * std::cos(PI * x / half)
+                                      + 0.08 * std::cos(2.0 * PI * x / half);
+                h[k] = sinc * std::max(window, 0.0);
+                sum += h[k];
+            }
+            // The same gain at DC for every phase
+            for (size_t k = 0; k < _num_taps; k++) {
+                taps[k] = float(h[k] / sum * gain);
+            }
+        }
+        reset();
+    }
+
+    //! Clears the history, as at the start of a stream
+    void reset()
+    {
+        _hist_len = _num_taps - 1;
+        _hist_i.assign(_hist_len, 0.0f);
+        _hist_q.assign(_hist_len, 0.0f);
+        _next_out = double(_num_taps - 1);
+    }
+
+    //! Returns the number of input samples per output sample
+    double get_step() const
+    {
+        return _step;
+    }
+
+    //! Returns the number of taps of each phase of the filter
+    size_t get_num_taps() const
+    {
+        return _num_taps;
+    }
+
+    /*!
+     * Returns the offset of the newest input sample that goes into the next
+     * output, from the next input sample that will be appended. This is
+     * negative if the next output doesn't need any more input.
+     */
+    int64_t get_next_out_offset() const
+    {
+        return int64_t(_next_out) - int64_t(_hist_len);
+    }
+
+    //! Returns whether \p num_in more input samples produce an output sample
+    bool can_produce(const size_t num_in) const
+    {
+        return size_t(_next_out) < _hist_len + num_in;
+    }
+
+    /*!
+     * Returns how many of \p num_in input samples to append for \p max_out
+     * output samples. The count may include one more sample than needed.
+     */
+    size_t get_num_needed(const size_t num_in, const size_t max_out) const
+    {
+        if (max_out == 0) {
+            return 0;
+        }
+        const size_t end = size_t(_next_out + double(max_out - 1) * _step) + 2;
+        return (end > _hist_len) ? std::min(num_in, end - _hist_len) : 0;
+    }
+
+    /*!
+     * Makes room for \p num_in input samples at the end of the history, which
+     * the caller writes to \p in_i and \p in_q
+     */
+    void append(const size_t num_in, float*& in_i, float*& in_q)
+    {
+        if (_hist_i.size() < _hist_len + num_in) {
+            _hist_i.resize(_hist_len + num_in);
+            _hist_q.resize(_hist_len + num_in);
+        }
+        in_i = _hist_i.data() + _hist_len;
+        in_q = _hist_q.data() + _hist_len;
+        _hist_len += num_in;
+    }
+
+    /*!
+     * Computes output samples as far as the history reaches
+     *
+     * \param max_out the maximum number of output samples
+     * \param store called as store(n, sample) for each output sample n
+     * \return the number of output samples
+     */
+    template <typename store_t>
+    UHD_INLINE size_t produce(const size_t max_out, store_t store)
+    {
+        size_t num_out = 0;
+        while (num_out < max_out) {
+            const size_t newest = size_t(_next_out);
+            if (newest >= _hist_len) {
+                break;
+            }
+            const double frac  = _next_out - double(newest);
+            const size_t phase =
+                std::min(size_t(frac * NUM_PHASES + 0.5), NUM_PHASES - 1);
+            store(num_out++, _filter(phase, newest + 1 - _num_taps));
+            _next_out += _step;
+        }
+
+        // Drop the history that no future output needs. The decimating filter
+        // is longer than the step, so the future outputs never skip input.
+        const size_t drop = std::min(size_t(_next_out), _hist_len) + 1 - _num_taps;
+        _hist_len -= drop;
+        std::memmove(_hist_i.data(), _hist_i.data() + drop, _hist_len * sizeof(float));
+        std::memmove(_hist_q.data(), _hist_q.data() + drop, _hist_len * sizeof(float));
+        _next_out -= double(drop);
+
+        return num_out;
+    }
+
+private:
+    //! Computes one output sample from the history starting at \p start
+    UHD_FORCE_INLINE std::complex<float> _filter(
+        const size_t phase, const size_t start) const
+    {
+        const float* taps = &_taps[phase * _num_taps];
+        const float* in_i = _hist_i.data() + start;
+        const float* in_q = _hist_q.data() + start;
+
+        // Independent partial sums let the compiler vectorize the loop
+        constexpr size_t LANES = 8;
+        float acc_i[LANES]     = {};
+        float acc_q[LANES]     = {};
+        size_t k               = 0;
+        for (; k + LANES <= _num_taps; k += LANES) {
+            for (size_t l = 0; l < LANES; l++) {
+                acc_i[l] += taps[k + l] * in_i[k + l];
+                acc_q[l] += taps[k + l] * in_q[k + l];
+            }
+        }
+        for (; k < _num_taps; k++) {
+            acc_i[0] += taps[k] * in_i[k];
+            acc_q[0] += taps[k] * in_q[k];
+        }
+        float sum_i = 0.0f, sum_q = 0.0f;
+        for (size_t l = 0; l < LANES; l++) {
+            sum_i += acc_i[l];
+            sum_q += acc_q[l];
+        }
+        return std::complex<float>(sum_i, sum_q);
+    }
+
+    // Input samples per output sample, and the taps of all phases
+    double _step     = 1.0;
+    size_t _num_taps = 1;
+    std::vector<float> _taps;
+
+    // Input samples. The first _hist_len ones are valid.
+    std::vector<float> _hist_i;
+    std::vector<float> _hist_q;
+    size_t _hist_len = 0;
+
+    // Position of the next output sample in the history, in input samples
+    double _next_out = 0.0;
+};
+
+/*!
+ * Numerically controlled oscillator of the host DSP
+ *
+ * The oscillator runs in single precision for a block of samples, and each
+ * block starts from the phase kept in double precision, so the errors of the
+ * oscillator don't add up over time.
+ */
+class nco
+{
+public:
+    //! Configures the frequency, in radians per sample, and resets the phase
+    void set_step(const double step)
+    {
+        _step  = step;
+        _phase = 0.0;
+    }
+
+    //! Returns whether the oscillator shifts the frequency at all
+    bool enabled() const
+    {
+        return _step != 0.0;
+    }
+
+    //! Resets the phase, as at the start of a stream
+    void reset()
+    {
+        _phase = 0.0;
+    }
+
+    /*!
+     * Runs the oscillator for a block of samples
+     *
+     * \param num_samps the number of samples
+     * \param fn called as fn(n, osc) with the oscillator osc for each sample n
+     */
+    template <typename fn_t>
+    UHD_INLINE void run(const size_t num_samps, fn_t fn)
+    {
+        const std::complex<float> step(std::polar(1.0, _step));
+        std::complex<float> osc(std::polar(1.0, _phase));
+        for (size_t n = 0; n < num_samps; n++) {
+            fn(n, osc);
+            osc *= step;
+        }
+        _phase = std::fmod(_phase + _step * double(num_samps), 2.0 * uhd::math::PI);
+    }
+
+private:
+    double _step  = 0.0;
+    double _phase = 0.0;
+};
+
+}} // namespace uhd::transport
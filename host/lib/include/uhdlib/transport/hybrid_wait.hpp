@@ -0,0 +1,129 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+namespace uhd { namespace transport {
+
+/*!
+ * Wait strategy that spins before it blocks
+ *
+ * Polling for buffers keeps a core busy even when a stream is idle, and
+ * blocking adds the latency of a wakeup to every buffer. A hybrid wait checks
+ * for a buffer in a loop for up to a spin budget, and only blocks if none
+ * arrives by then.
+ *
+ * The spin budget follows the interval between buffers: it is twice the
+ * average interval, so a steady stream is served by spinning alone. If the
+ * average interval is longer than the largest budget, spinning would mostly
+ * time out anyway, so the budget drops to zero until buffers arrive faster
+ * again.
+ *
+ * A hybrid_wait object keeps the statistics of one client, and must not be
+ * shared between threads. With the largest budget set to zero, it only blocks.
+ */
+class hybrid_wait
+{
+public:
+    /*!
+     * \param max_spin_us the longest time to spin before blocking, in
+     *                    microseconds
+     */
+    hybrid_wait(const size_t max_spin_us = 0)
+        : _max_spin(std::chrono::microseconds(max_spin_us))
+        , _spin_budget(_max_spin)
+        , _avg_interval(_max_spin / 2)
+    {
+    }
+
+    //! Returns the time the next wait spins for before it blocks
+    std::chrono::nanoseconds get_spin_budget() const
+    {
+        return _spin_budget;
+    }
+
+    /*!
+     * Waits for a buffer, or any other result that converts to true
+     *
+     * \param try_get function that returns the result without waiting
+     * \param block_get function that waits for the result, taking the timeout
+     *                  in milliseconds
+     * \param timeout_ms timeout in milliseconds, negative to wait forever
+     * \return the result of try_get or block_get
+     */
+    template <typename try_fn_t, typename block_fn_t>
+    UHD_FORCE_INLINE auto wait(
+        try_fn_t&& try_get, block_fn_t&& block_get, const int32_t timeout_ms)
+        -> decltype(try_get())
+    {
+        using namespace std::chrono;
+
+        if (_max_spin.count() == 0) {
+            return block_get(timeout_ms);
+        }
+
+        auto result = try_get();
+        if (result || timeout_ms == 0) {
+            if (result) {
+                _record_arrival(steady_clock::now());
+            }
+            return result;
+        }
+
+        const auto start_time = steady_clock::now();
+        auto now              = start_time;
+        while (now - start_time < _spin_budget) {
+            result = try_get();
+            now    = steady_clock::now();
+            if (result) {
+                _record_arrival(now);
+                return result;
+            }
+        }
+
+        int32_t remaining_ms = timeout_ms;
+        if (timeout_ms > 0) {
+            const auto spun_ms = duration_cast<milliseconds>(now - start_time).count();
+            remaining_ms = std::max<int32_t>(0, timeout_ms - int32_t(spun_ms));
+        }
+        result = block_get(remaining_ms);
+        if (result) {
+            _record_arrival(steady_clock::now());
+        }
+        return result;
+    }
+
+private:
+    //! Updates the average interval between buffers, and the spin budget
+    UHD_FORCE_INLINE void _record_arrival(const std::chrono::steady_clock::time_point now)
+    {
+        using namespace std::chrono;
+
+        if (_last_arrival != steady_clock::time_point()) {
+            // Cap the interval, so that an idle period doesn't keep the
+            // average up for long after the stream resumed
+            const nanoseconds interval = std::min<nanoseconds>(now - _last_arrival,
+                2 * duration_cast<nanoseconds>(_max_spin));
+            _avg_interval += (interval - _avg_interval) / 8;
+            _spin_budget = (_avg_interval > _max_spin)
+                               ? nanoseconds(0)
+                               : std::min<nanoseconds>(2 * _avg_interval, _max_spin);
+        }
+        _last_arrival = now;
+    }
+
+    std::chrono::microseconds _max_spin;
+    std::chrono::nanoseconds _spin_budget;
+    std::chrono::nanoseconds _avg_interval;
+    std::chrono::steady_clock::time_point _last_arrival;
+};
+
+}} // namespace uhd::transport
@@ -26,9 +26,17 @@ class inline_io_service : public virtual io_service,
 {
 public:
     using sptr = std::shared_ptr<inline_io_service>;
-    static sptr make(void)
+
+    /*!
+     * Creates an inline I/O service
+     *
+     * \param max_spin_us If nonzero, clients poll their links for up to this
+     *                    long before they block in them, in microseconds (see
+     *                    hybrid_wait)
+     */
+    static sptr make(const size_t max_spin_us = 0)
     {
-        return sptr(new inline_io_service());
+        return sptr(new inline_io_service(max_spin_us));
     }
 
     ~inline_io_service();
@@ -58,7 +66,7 @@ private:
     friend class inline_recv_io;
     friend class inline_send_io;
 
-    inline_io_service()                         = default;
+    inline_io_service(const size_t max_spin_us) : _max_spin_us(max_spin_us) {}
     inline_io_service(const inline_io_service&) = delete;
 
     /*!
@@ -122,6 +130,9 @@ private:
     std::unordered_map<recv_link_if*, std::tuple<inline_recv_mux*, inline_recv_cb*>>
         _recv_tbl;
 
+    /* How long clients spin before blocking */
+    const size_t _max_spin_us;
+
     /* Shared ptr kept to avoid untimely release */
     std::list<send_link_if::sptr> _send_links;
     std::list<recv_link_if::sptr> _recv_links;
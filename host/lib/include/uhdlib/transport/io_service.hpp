@@ -37,8 +37,10 @@
 #pragma once
 
 #include <uhdlib/transport/link_if.hpp>
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
 
 namespace uhd { namespace transport {
 
@@ -119,6 +121,13 @@ public:
     using fc_callback_t =
         std::function<void(frame_buff::uptr, recv_link_if*, send_link_if*)>;
 
+    /*!
+     * Callback for an I/O service that queues a frame for the client, see
+     * recv_io_if::set_ready_callback(). It runs on the I/O thread, so it must
+     * not sleep.
+     */
+    using ready_callback_t = std::function<void()>;
+
     /* Transport client methods */
     /*!
      * Gets a receive buffer from the I/O service.
@@ -141,6 +150,34 @@ public:
      */
     virtual void release_recv_buff(frame_buff::uptr buff) = 0;
 
+    /*!
+     * Get the largest number of received frames that were queued for the
+     * client at once, by an I/O service that queues frames in a worker thread.
+     * This shows how close the client came to running out of frames.
+     *
+     * \return the high-water mark, or 0 if the I/O service doesn't queue frames
+     */
+    virtual size_t get_recv_queue_hwm() const
+    {
+        return 0;
+    }
+
+    /*!
+     * Ask the I/O service to call a function whenever it queues a received
+     * frame for this client, so that the client does not have to wait in
+     * get_recv_buff() to find out. This is only possible for I/O services
+     * that receive in a worker thread.
+     *
+     * Once this returns, the previous callback is not called any more.
+     *
+     * \param cb the callback, or an empty function to stop the notifications
+     * \return false if the I/O service can't notify the client
+     */
+    virtual bool set_ready_callback(ready_callback_t /*cb*/)
+    {
+        return false;
+    }
+
     /*!
      * Get number of send frames reserved by this I/O interface.
      *
@@ -169,6 +206,40 @@ protected:
     size_t _num_recv_frames;
 };
 
+/*!
+ * Holds the callback of recv_io_if::set_ready_callback() or
+ * send_io_if::set_ready_callback() for an I/O service
+ *
+ * notify() only costs an atomic load while no callback is set, so I/O threads
+ * can call it for every frame they queue.
+ */
+class recv_ready_notifier
+{
+public:
+    void set(recv_io_if::ready_callback_t cb)
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _cb = std::move(cb);
+        _enabled.store(bool(_cb), std::memory_order_release);
+    }
+
+    void notify()
+    {
+        if (!_enabled.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::lock_guard<std::mutex> l(_mutex);
+        if (_cb) {
+            _cb();
+        }
+    }
+
+private:
+    std::atomic<bool> _enabled{false};
+    std::mutex _mutex;
+    recv_io_if::ready_callback_t _cb;
+};
+
 /*!
  * Interface for a send transport to request/release buffers from a link. A
  * send transport is a transport with a primary purpose of sending data, and
@@ -209,6 +280,13 @@ public:
      */
     using fc_callback_t = std::function<bool(const size_t)>;
 
+    /*!
+     * Callback for an I/O service that makes a send frame available to the
+     * client, see send_io_if::set_ready_callback(). It runs on the I/O
+     * thread, so it must not sleep.
+     */
+    using ready_callback_t = std::function<void()>;
+
     /* Transport client methods */
     /*!
      * Get an empty send buffer from the link.
@@ -242,6 +320,22 @@ public:
      */
     virtual void release_send_buff(frame_buff::uptr buff) = 0;
 
+    /*!
+     * Ask the I/O service to call a function whenever it makes a send frame
+     * available to this client, i.e., when get_send_buff() would no longer
+     * time out. This is only possible for I/O services that send in a worker
+     * thread.
+     *
+     * Once this returns, the previous callback is not called any more.
+     *
+     * \param cb the callback, or an empty function to stop the notifications
+     * \return false if the I/O service can't notify the client
+     */
+    virtual bool set_ready_callback(ready_callback_t /*cb*/)
+    {
+        return false;
+    }
+
     /*!
      * Get number of send frames reserved by this I/O interface.
      *
@@ -0,0 +1,122 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace uhd { namespace transport {
+
+/*!
+ * Histogram of the latencies of one stage of the streaming path
+ *
+ * A stage may be recorded by more than one thread (e.g., by the links of
+ * several channels on different I/O service threads), so the counters are
+ * updated with read-modify-write operations. They are only touched while the
+ * latency probe is enabled.
+ */
+class latency_hist
+{
+public:
+    //! Records the latency of a packet
+    void add(const uint64_t latency_ns)
+    {
+        _count.fetch_add(1, std::memory_order_relaxed);
+        _total_ns.fetch_add(latency_ns, std::memory_order_relaxed);
+        uint64_t max_ns = _max_ns.load(std::memory_order_relaxed);
+        while (latency_ns > max_ns
+               && !_max_ns.compare_exchange_weak(
+                   max_ns, latency_ns, std::memory_order_relaxed)) {
+        }
+
+        size_t bucket = 0;
+        for (uint64_t latency_us = latency_ns / 1000; latency_us != 0;
+             latency_us >>= 1) {
+            bucket++;
+        }
+        _hist[std::min(bucket, NUM_BUCKETS - 1)].fetch_add(
+            1, std::memory_order_relaxed);
+    }
+
+    //! Returns the number of packets recorded so far
+    uint64_t get_count() const
+    {
+        return _count.load(std::memory_order_relaxed);
+    }
+
+    //! Returns the current value of the counters
+    uhd::streamer_stats_t::latency_stats_t get() const
+    {
+        uhd::streamer_stats_t::latency_stats_t stats;
+        stats.count    = _count.load(std::memory_order_relaxed);
+        stats.total_ns = _total_ns.load(std::memory_order_relaxed);
+        stats.max_ns   = _max_ns.load(std::memory_order_relaxed);
+        for (const auto& bucket : _hist) {
+            stats.hist.push_back(bucket.load(std::memory_order_relaxed));
+        }
+        return stats;
+    }
+
+private:
+    static constexpr size_t NUM_BUCKETS = uhd::streamer_stats_t::NUM_WAIT_TIME_BUCKETS;
+
+    std::atomic<uint64_t> _count{0};
+    std::atomic<uint64_t> _total_ns{0};
+    std::atomic<uint64_t> _max_ns{0};
+    std::atomic<uint64_t> _hist[NUM_BUCKETS] = {};
+};
+
+/*!
+ * Timestamps of the latency probe
+ *
+ * Links timestamp the frame buffers they receive only while at least one
+ * streamer has its latency probe enabled, so links pay for a relaxed load per
+ * packet when nobody is measuring. Timestamps are in nanoseconds of
+ * std::chrono::steady_clock, and 0 means a frame buffer was not timestamped.
+ */
+namespace latency_probe {
+
+//! Returns the number of streamers that have the latency probe enabled
+inline std::atomic<size_t>& get_num_users()
+{
+    static std::atomic<size_t> num_users{0};
+    return num_users;
+}
+
+//! Registers a streamer that enabled its latency probe
+inline void add_user()
+{
+    get_num_users().fetch_add(1, std::memory_order_relaxed);
+}
+
+//! Unregisters a streamer that disabled its latency probe
+inline void remove_user()
+{
+    get_num_users().fetch_sub(1, std::memory_order_relaxed);
+}
+
+//! Returns whether links should timestamp frame buffers
+UHD_FORCE_INLINE bool is_active()
+{
+    return get_num_users().load(std::memory_order_relaxed) != 0;
+}
+
+//! Returns the current time, as used for timestamps
+UHD_FORCE_INLINE uint64_t now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace latency_probe
+
+}} // namespace uhd::transport
@@ -6,7 +6,11 @@
 
 #pragma once
 
+#include <uhd/exception.hpp>
+#include <uhdlib/transport/latency_probe.hpp>
 #include <uhdlib/transport/link_if.hpp>
+#include <uhdlib/transport/pcap_tap.hpp>
+#include <uhdlib/transport/shared_frame_pool.hpp>
 #include <cassert>
 #include <vector>
 
@@ -40,6 +44,11 @@ public:
         _buffs.push_back(buff);
     }
 
+    size_t size() const
+    {
+        return _buffs.size();
+    }
+
 private:
     std::vector<frame_buff*> _buffs;
 };
@@ -105,16 +114,33 @@ public:
         assert(buff_ptr);
 
         if (buff_ptr->packet_size() != 0) {
+            if (_send_tap) {
+                _send_tap->capture(buff_ptr->data(), buff_ptr->packet_size());
+            }
+
             // Call the derived class for link-specific implementation
             auto* derived = static_cast<derived_t*>(this);
             derived->release_send_buff_derived(*buff_ptr);
+
+            // Record the time since send() for the latency probe
+            latency_hist* hist = buff_ptr->get_latency_hist();
+            if (hist) {
+                hist->add(latency_probe::now() - buff_ptr->get_timestamp());
+            }
         }
 
         // Reset buff and re-add to free pool
         buff_ptr->set_packet_size(0);
+        buff_ptr->set_latency_hist(nullptr);
         _free_send_buffs.push(buff_ptr);
     }
 
+    virtual bool set_send_pcap_tap(pcap_tap::sptr tap)
+    {
+        _send_tap = tap;
+        return true;
+    }
+
 protected:
     /*!
      * Add buffer pointer to free buffer pool.
@@ -133,6 +159,7 @@ private:
     size_t _send_frame_size;
     size_t _num_send_frames;
     detail::free_buff_pool _free_send_buffs;
+    pcap_tap::sptr _send_tap;
 };
 
 /*!
@@ -151,6 +178,13 @@ private:
  * frame_buff object it owns during initialization to add it to the free
  * buff pool.
  *
+ * Links whose frames are plain memory can let an I/O service attach a
+ * shared_frame_pool by implementing set_shared_frame_pool() with
+ * attach_shared_frame_pool(). get_recv_buff() then borrows frames from the
+ * pool when the free buffer pool is empty.
+ *
+ * Both base classes capture the frames into a pcap_tap, if one is set.
+ *
  * \param derived_t type of the derived class
  */
 template <typename derived_t>
@@ -174,9 +208,22 @@ public:
         return _recv_frame_size;
     }
 
+    virtual size_t get_num_shared_recv_frames() const
+    {
+        return _shared_pool ? _shared_pool->get_num_frames() : 0;
+    }
+
     virtual frame_buff::uptr get_recv_buff(int32_t timeout_ms)
     {
-        frame_buff* buff = _free_recv_buffs.pop();
+        frame_buff* buff;
+        if (_free_recv_buffs.size() > 0 || !_shared_pool) {
+            buff = _free_recv_buffs.pop();
+        } else if ((buff = _shared_pool->pop())) {
+            _num_shared_in_use++;
+        } else {
+            // All shared frames are borrowed by other links
+            return frame_buff::uptr();
+        }
 
         // Call the derived class for link specific implementation
         auto* derived = static_cast<derived_t*>(this);
@@ -184,10 +231,10 @@ public:
         size_t len = derived->get_recv_buff_derived(*buff, timeout_ms);
 
         if (len == 0) {
-            _free_recv_buffs.push(buff);
+            _push_free_buff(buff);
             return frame_buff::uptr();
         } else {
-            buff->set_packet_size(len);
+            complete_recv_buff(*buff, len);
             return frame_buff::uptr(buff);
         }
     }
@@ -204,7 +251,13 @@ public:
 
         // Reset buffer and re-add to free pool
         buff_ptr->set_packet_size(0);
-        _free_recv_buffs.push(buff_ptr);
+        _push_free_buff(buff_ptr);
+    }
+
+    virtual bool set_recv_pcap_tap(pcap_tap::sptr tap)
+    {
+        _recv_tap = tap;
+        return true;
     }
 
 protected:
@@ -221,10 +274,84 @@ protected:
         _free_recv_buffs.push(buff);
     }
 
+    /*!
+     * Remove a buffer from the free buffer pool.
+     *
+     * Derived classes which fill more than one frame buffer per call into the
+     * underlying link can use this to obtain buffers. Buffers which go unused
+     * must be returned with preload_free_buff().
+     *
+     * \return pointer to a free buffer
+     */
+    frame_buff* pop_free_buff()
+    {
+        return _free_recv_buffs.pop();
+    }
+
+    /*!
+     * Finish a frame buffer which was filled from the underlying link.
+     *
+     * Sets the packet size and the arrival timestamp, and hands the frame to
+     * the pcap tap, if any. Derived classes which fill buffers obtained with
+     * pop_free_buff() must call this for each received frame.
+     *
+     * \param buff the buffer that was filled
+     * \param len the number of bytes received into the buffer
+     */
+    void complete_recv_buff(frame_buff& buff, const size_t len)
+    {
+        buff.set_packet_size(len);
+        buff.set_timestamp(latency_probe::is_active() ? latency_probe::now() : 0);
+        if (_recv_tap) {
+            _recv_tap->capture(buff.data(), len);
+        }
+    }
+
+    /*!
+     * Return the number of buffers currently in the free buffer pool.
+     */
+    size_t get_num_free_buffs() const
+    {
+        return _free_recv_buffs.size();
+    }
+
+    /*!
+     * Attach or detach a shared frame pool
+     *
+     * Derived classes which support shared frames call this from
+     * set_shared_frame_pool(). Only get_recv_buff() of this class borrows
+     * frames from the pool, pop_free_buff() never does.
+     *
+     * \param pool the pool to borrow from, or nullptr to detach
+     * \return false if the frames of the pool are too small for this link
+     */
+    bool attach_shared_frame_pool(shared_frame_pool::sptr pool)
+    {
+        UHD_ASSERT_THROW(_num_shared_in_use == 0);
+        if (pool && pool->get_frame_size() < _recv_frame_size) {
+            return false;
+        }
+        _shared_pool = pool;
+        return true;
+    }
+
 private:
+    void _push_free_buff(frame_buff* buff)
+    {
+        if (_shared_pool && _shared_pool->owns(buff)) {
+            _shared_pool->push(buff);
+            _num_shared_in_use--;
+        } else {
+            _free_recv_buffs.push(buff);
+        }
+    }
+
     size_t _recv_frame_size;
     size_t _num_recv_frames;
     detail::free_buff_pool _free_recv_buffs;
+    shared_frame_pool::sptr _shared_pool;
+    size_t _num_shared_in_use = 0;
+    pcap_tap::sptr _recv_tap;
 };
 
 }} // namespace uhd::transport
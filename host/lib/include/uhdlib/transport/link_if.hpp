@@ -9,9 +9,13 @@
 #include <uhd/transport/adapter_id.hpp>
 #include <uhd/transport/frame_buff.hpp>
 #include <memory>
+#include <string>
 
 namespace uhd { namespace transport {
 
+class shared_frame_pool;
+class pcap_tap;
+
 /*!
  * Link interface for transmitting packets.
  */
@@ -65,6 +69,27 @@ public:
         return true;
     }
 
+    /*!
+     * Returns the name of the host network interface used by this link, or an
+     * empty string if it doesn't use one.
+     */
+    virtual std::string get_send_ifname() const
+    {
+        return std::string();
+    }
+
+    /*!
+     * Capture the frames this link sends into a tap, or stop capturing. Must
+     * be called before the link is used.
+     *
+     * \param tap the tap to capture into, or nullptr to stop capturing
+     * \return false if the link can't capture its frames
+     */
+    virtual bool set_send_pcap_tap(std::shared_ptr<pcap_tap> /*tap*/)
+    {
+        return false;
+    }
+
     send_link_if()                    = default;
     send_link_if(const send_link_if&) = delete;
     send_link_if& operator=(const send_link_if&) = delete;
@@ -119,6 +144,51 @@ public:
         return true;
     }
 
+    /*!
+     * Returns the name of the host network interface used by this link, or an
+     * empty string if it doesn't use one.
+     */
+    virtual std::string get_recv_ifname() const
+    {
+        return std::string();
+    }
+
+    /*!
+     * Let the link borrow frames from a pool when all of its own frames are
+     * in use, or stop it from doing so. The link must only be used from the
+     * thread that owns the pool.
+     *
+     * \param pool the pool to borrow from, or nullptr to detach the current
+     *             pool. All borrowed frames must have been released.
+     * \return false if the link can't use the pool, e.g., because its frames
+     *         are owned by the driver, or its frame size is too large
+     */
+    virtual bool set_shared_frame_pool(std::shared_ptr<shared_frame_pool> /*pool*/)
+    {
+        return false;
+    }
+
+    /*!
+     * Get the number of frames the link can borrow in addition to
+     * get_num_recv_frames(), or 0 if no pool is attached.
+     */
+    virtual size_t get_num_shared_recv_frames() const
+    {
+        return 0;
+    }
+
+    /*!
+     * Capture the frames this link receives into a tap, or stop capturing.
+     * Must be called before the link is used.
+     *
+     * \param tap the tap to capture into, or nullptr to stop capturing
+     * \return false if the link can't capture its frames
+     */
+    virtual bool set_recv_pcap_tap(std::shared_ptr<pcap_tap> /*tap*/)
+    {
+        return false;
+    }
+
     recv_link_if()                    = default;
     recv_link_if(const recv_link_if&) = delete;
     recv_link_if& operator=(const recv_link_if&) = delete;
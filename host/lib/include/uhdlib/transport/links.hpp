@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <uhdlib/transport/buffer_pool_alloc.hpp>
 #include <uhdlib/transport/io_service.hpp>
 #include <uhdlib/transport/link_if.hpp>
 #include <tuple>
@@ -33,6 +34,12 @@ struct link_params_t
     size_t num_send_frames = 0;
     size_t recv_buff_size  = 0;
     size_t send_buff_size  = 0;
+    //! Maximum number of frames a link may receive with a single call into
+    //  the OS. Links that don't support batched receives ignore this value.
+    size_t recv_batch_size = 1;
+    //! How to allocate the memory for the frame buffers. Links that don't
+    //  manage their own frame buffer memory ignore this value.
+    buff_alloc_params_t buff_alloc;
 };
 
 
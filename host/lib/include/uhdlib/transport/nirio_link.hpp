@@ -79,6 +79,9 @@ public:
      * \param addr a string representing the destination address
      * \param port a string representing the destination port
      * \param params Values for frame sizes, num frames, and buffer sizes
+     * \param hints Device args. Besides overriding the link params,
+     *              `recv_release_batch` sets the number of received frames to
+     *              return to the DMA engine at a time.
      * \param[out] recv_buff_size Returns the recv buffer size
      * \param[out] send_buff_size Returns the send buffer size
      */
@@ -133,7 +136,8 @@ private:
 
     nirio_link(uhd::niusrprio::niusrprio_session::sptr fpga_session,
         uint32_t instance,
-        const link_params_t& params);
+        const link_params_t& params,
+        const size_t recv_release_batch);
 
     /**************************************************************************
      * NI-RIO specific helpers
@@ -142,6 +146,13 @@ private:
 
     void _wait_until_stream_ready();
 
+    //! Returns the received frames that were released to the DMA engine
+    UHD_FORCE_INLINE void _grant_recv_elems()
+    {
+        _recv_fifo->release(_recv_elems_to_grant);
+        _recv_elems_to_grant = 0;
+    }
+
     /**************************************************************************
      * recv_link/send_link API
      *************************************************************************/
@@ -152,6 +163,11 @@ private:
         nirio_status status    = 0;
         size_t elems_acquired  = 0;
         size_t elems_remaining = 0;
+        // If the FIFO has to call into the driver to acquire more frames, give
+        // the DMA engine the space of the released frames first
+        if (_recv_elems_to_grant > 0 && _recv_fifo->get_num_claimed_elements() == 0) {
+            _grant_recv_elems();
+        }
         // This will modify the data pointer in buff if successful:
         fifo_data_t** data_ptr = static_cast<nirio_frame_buff&>(buff).get_fifo_ptr_ref();
         nirio_status_chain(_recv_fifo->acquire(*data_ptr,
@@ -172,7 +188,11 @@ private:
 
     UHD_FORCE_INLINE void release_recv_buff_derived(frame_buff& /*buff*/)
     {
-        _recv_fifo->release(_link_params.recv_frame_size / sizeof(fifo_data_t));
+        // Each grant is a call into the driver, so batch them
+        _recv_elems_to_grant += _link_params.recv_frame_size / sizeof(fifo_data_t);
+        if (_recv_elems_to_grant >= _recv_grant_threshold) {
+            _grant_recv_elems();
+        }
     }
 
     // Methods called by send_link_base
@@ -217,6 +237,11 @@ private:
 
     const link_params_t _link_params;
 
+    //! Number of received elements to collect before granting them to the DMA
+    const size_t _recv_grant_threshold;
+    //! Elements of released frames that were not yet granted to the DMA
+    size_t _recv_elems_to_grant = 0;
+
     std::vector<nirio_frame_buff> _recv_buffs;
     std::vector<nirio_frame_buff> _send_buffs;
 
@@ -23,7 +23,7 @@ class offload_io_service : public io_service
 public:
     enum client_type_t { RECV_ONLY, SEND_ONLY, BOTH_SEND_AND_RECV };
 
-    enum wait_mode_t { POLL, BLOCK };
+    enum wait_mode_t { POLL, BLOCK, HYBRID };
 
     /*!
      * Options for configuring offload I/O service
@@ -36,7 +36,27 @@ public:
         client_type_t client_type = BOTH_SEND_AND_RECV;
         //! The thread behavior when waiting for incoming packets If set to
         //! BLOCK, the client type must be set to either RECV_ONLY or SEND_ONLY.
+        //! HYBRID blocks after spinning for a while, in both the offload thread
+        //! and the clients, and has the same restriction as BLOCK.
         wait_mode_t wait_mode = POLL;
+        //! The longest time to spin before blocking if wait_mode is HYBRID, in
+        //! microseconds
+        size_t max_spin_us = 100;
+        //! Number of receive frames that the recv links attached to the I/O
+        //! service share. Links that support it borrow these when all of
+        //! their own frames are in use, so a recv client can hold up to its
+        //! reservation plus this many frames. The frames have the frame size
+        //! of the first recv link, and are only allocated once it's attached.
+        size_t num_shared_recv_frames = 0;
+        //! Number of offload threads if wait_mode is POLL. Clients that share
+        //! links are always served by the same thread, which keeps their
+        //! packets in order, but the threads periodically move links among
+        //! each other to balance the number of packets that each one handles.
+        //! Several threads cannot be combined with num_shared_recv_frames.
+        size_t num_poll_threads = 1;
+        //! The CPU affinity lists of the poll threads, by thread index. Threads
+        //! without an entry use cpu_affinity_list.
+        std::vector<std::vector<size_t>> thread_cpu_affinity_lists = {};
     };
 
     /*!
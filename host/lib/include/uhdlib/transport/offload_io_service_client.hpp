@@ -7,6 +7,8 @@
 #pragma once
 
 #include <uhd/transport/frame_buff.hpp>
+#include <uhdlib/transport/hybrid_wait.hpp>
+#include <atomic>
 #include <chrono>
 #include <thread>
 
@@ -56,8 +58,9 @@ public:
     offload_recv_io(typename io_service_t::sptr io_srv,
         size_t num_recv_frames,
         size_t num_send_frames,
-        typename io_service_t::client_port_t::sptr& port)
-        : _io_srv(io_srv), _port(port)
+        typename io_service_t::client_port_t::sptr& port,
+        const size_t max_spin_us = 0)
+        : _io_srv(io_srv), _port(port), _wait(max_spin_us)
     {
         _num_recv_frames = num_recv_frames;
         _num_send_frames = num_send_frames;
@@ -78,13 +81,21 @@ public:
             return detail::client_get_buff(
                 [this]() {
                     frame_buff* buff = _port->client_pop();
-                    _num_frames_in_use += buff ? 1 : 0;
+                    if (buff) {
+                        _num_frames_in_use++;
+                        _update_queue_hwm();
+                    }
                     return buff;
                 },
                 timeout_ms);
         } else {
-            frame_buff* buff = _port->client_pop(timeout_ms);
-            _num_frames_in_use += buff ? 1 : 0;
+            frame_buff* buff = _wait.wait([this]() { return _port->client_pop(); },
+                [this](const int32_t timeout) { return _port->client_pop(timeout); },
+                timeout_ms);
+            if (buff) {
+                _num_frames_in_use++;
+                _update_queue_hwm();
+            }
             return frame_buff::uptr(buff);
         }
     }
@@ -96,13 +107,36 @@ public:
         _num_frames_in_use--;
     }
 
+    size_t get_recv_queue_hwm() const
+    {
+        return _queue_hwm.load(std::memory_order_relaxed);
+    }
+
+    bool set_ready_callback(ready_callback_t cb)
+    {
+        _port->ready_notifier.set(std::move(cb));
+        return true;
+    }
+
 private:
     offload_recv_io()                       = delete;
     offload_recv_io(const offload_recv_io&) = delete;
 
+    // Called after popping a frame, so the frame counts as queued too
+    void _update_queue_hwm()
+    {
+        const size_t queued = _port->client_read_available() + 1;
+        // Only this thread writes the high-water mark
+        if (queued > _queue_hwm.load(std::memory_order_relaxed)) {
+            _queue_hwm.store(queued, std::memory_order_relaxed);
+        }
+    }
+
     typename io_service_t::sptr _io_srv;
     typename io_service_t::client_port_t::sptr _port;
+    hybrid_wait _wait;
     size_t _num_frames_in_use = 0;
+    std::atomic<size_t> _queue_hwm{0};
 };
 
 /*!
@@ -115,8 +149,9 @@ public:
     offload_send_io(typename io_service_t::sptr io_srv,
         size_t num_recv_frames,
         size_t num_send_frames,
-        typename io_service_t::client_port_t::sptr& port)
-        : _io_srv(io_srv), _port(port)
+        typename io_service_t::client_port_t::sptr& port,
+        const size_t max_spin_us = 0)
+        : _io_srv(io_srv), _port(port), _wait(max_spin_us)
     {
         _num_recv_frames = num_recv_frames;
         _num_send_frames = num_send_frames;
@@ -150,7 +185,9 @@ public:
                 },
                 timeout_ms);
         } else {
-            frame_buff* buff = _port->client_pop(timeout_ms);
+            frame_buff* buff = _wait.wait([this]() { return _port->client_pop(); },
+                [this](const int32_t timeout) { return _port->client_pop(timeout); },
+                timeout_ms);
             _num_frames_in_use += buff ? 1 : 0;
             return frame_buff::uptr(buff);
         }
@@ -163,12 +200,19 @@ public:
         _num_frames_in_use--;
     }
 
+    bool set_ready_callback(ready_callback_t cb)
+    {
+        _port->ready_notifier.set(std::move(cb));
+        return true;
+    }
+
 private:
     offload_send_io()                       = delete;
     offload_send_io(const offload_send_io&) = delete;
 
     typename io_service_t::sptr _io_srv;
     typename io_service_t::client_port_t::sptr _port;
+    hybrid_wait _wait;
     size_t _num_frames_in_use = 0;
 };
 
@@ -0,0 +1,239 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/types/direction.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <uhdlib/transport/links.hpp>
+#include <uhdlib/utils/spsc_queue.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace uhd { namespace transport {
+
+//! Link type of the captured frames, the RFNoC dissector decodes it as CHDR
+constexpr uint16_t PCAP_LINKTYPE_CHDR = 147; // LINKTYPE_USER0
+
+//! Bytes of each frame that are captured by default, enough for the header and
+// timestamp of every CHDR width
+constexpr size_t PCAP_DEFAULT_SNAPLEN = 64;
+
+//! Number of frames a tap can hold until the writer catches up, by default
+constexpr size_t PCAP_DEFAULT_NUM_RECORDS = 4096;
+
+/*!
+ * Capture point of one direction of a link
+ *
+ * The link calls capture() for every frame it sends or receives. The tap
+ * copies the first snaplen bytes of the frame, or the whole frame for every
+ * sample_every-th frame, into a preallocated record and hands it to the
+ * pcap_writer through a lock-free queue. The link never waits for the
+ * writer: when all records are in flight, the frame is not captured and
+ * counted as dropped instead.
+ *
+ * Only one thread may call capture(), i.e., a tap belongs to a single link and
+ * direction.
+ */
+class pcap_tap : uhd::noncopyable
+{
+public:
+    using sptr = std::shared_ptr<pcap_tap>;
+
+    /*!
+     * \param interface_id The pcapng interface of the captured frames
+     * \param dir The direction of the captured frames
+     * \param frame_size The largest frame the link sends or receives
+     * \param snaplen The number of bytes to capture of each frame
+     * \param sample_every Capture every sample_every-th frame in full, 0
+     *        captures no frame in full
+     * \param num_records The number of frames that can wait for the writer
+     */
+    pcap_tap(const uint32_t interface_id,
+        const uhd::direction_t dir,
+        const size_t frame_size,
+        const size_t snaplen,
+        const size_t sample_every,
+        const size_t num_records)
+        : _interface_id(interface_id)
+        , _dir(dir)
+        , _snaplen(std::min(snaplen, frame_size))
+        , _frame_size(sample_every == 0 ? _snaplen : frame_size)
+        , _sample_every(sample_every)
+        , _records(num_records)
+        , _data(num_records * _frame_size)
+        , _free(num_records)
+        , _filled(num_records)
+    {
+        for (size_t i = 0; i < num_records; i++) {
+            _records[i].data = _data.data() + i * _frame_size;
+            _free.push(&_records[i]);
+        }
+    }
+
+    /*!
+     * Captures a frame
+     *
+     * \param data The frame
+     * \param len The size of the frame in bytes
+     */
+    UHD_FORCE_INLINE void capture(const void* data, const size_t len)
+    {
+        record_t* record;
+        const bool sample = _sample_every != 0 && _num_frames++ % _sample_every == 0;
+        if (!_free.pop(record)) {
+            _num_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        const auto now = std::chrono::system_clock::now().time_since_epoch();
+        record->timestamp_ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+        record->orig_len = static_cast<uint32_t>(len);
+        record->cap_len =
+            static_cast<uint32_t>(std::min(len, sample ? _frame_size : _snaplen));
+        std::memcpy(record->data, data, record->cap_len);
+        _filled.push(record);
+    }
+
+    //! Returns the number of frames that were lost because the writer fell behind
+    uint64_t get_num_dropped() const
+    {
+        return _num_dropped.load(std::memory_order_relaxed);
+    }
+
+    uint32_t get_interface_id() const
+    {
+        return _interface_id;
+    }
+
+    uhd::direction_t get_direction() const
+    {
+        return _dir;
+    }
+
+    //! Returns the largest number of bytes the tap captures of a frame
+    size_t get_snaplen() const
+    {
+        return _frame_size;
+    }
+
+private:
+    friend class pcap_writer;
+
+    struct record_t
+    {
+        uint64_t timestamp_ns = 0;
+        uint32_t orig_len     = 0;
+        uint32_t cap_len      = 0;
+        uint8_t* data         = nullptr;
+    };
+
+    const uint32_t _interface_id;
+    const uhd::direction_t _dir;
+    const size_t _snaplen;
+    //! Size of each record
+    const size_t _frame_size;
+    const size_t _sample_every;
+    uint64_t _num_frames = 0;
+    std::atomic<uint64_t> _num_dropped{0};
+
+    std::vector<record_t> _records;
+    std::vector<uint8_t> _data;
+    //! Records the tap can fill, only the writer pushes
+    spsc_queue<record_t*> _free;
+    //! Records the writer must write, only the tap pushes
+    spsc_queue<record_t*> _filled;
+};
+
+/*!
+ * Writes the frames of one or more taps into a pcapng file
+ *
+ * Each tap is a separate interface of the file, so Wireshark shows which link
+ * a frame came from. A background thread drains the taps, links never touch
+ * the file.
+ */
+class UHD_API pcap_writer : uhd::noncopyable
+{
+public:
+    using sptr = std::shared_ptr<pcap_writer>;
+
+    /*!
+     * Creates the file and starts the writer thread
+     *
+     * \param path The path of the pcapng file, an existing file is overwritten
+     * \throws uhd::os_error if the file cannot be created
+     */
+    pcap_writer(const std::string& path);
+
+    //! Writes the frames that are left, and closes the file
+    ~pcap_writer();
+
+    /*!
+     * Adds a tap to capture frames into this file
+     *
+     * \param name The name of the interface in the file
+     * \param dir The direction of the frames
+     * \param frame_size The largest frame of the link
+     * \param snaplen The number of bytes to capture of each frame
+     * \param sample_every Capture every sample_every-th frame in full, or none
+     *        when 0
+     * \param num_records The number of frames that can wait for the writer
+     */
+    pcap_tap::sptr add_tap(const std::string& name,
+        const uhd::direction_t dir,
+        const size_t frame_size,
+        const size_t snaplen      = PCAP_DEFAULT_SNAPLEN,
+        const size_t sample_every = 0,
+        const size_t num_records  = PCAP_DEFAULT_NUM_RECORDS);
+
+    //! Writes all frames the taps captured so far
+    void flush();
+
+private:
+    void _run();
+    //! Writes the captured frames, returns the number of frames written
+    size_t _drain();
+    void _write_block(const uint32_t type, const std::vector<uint8_t>& body);
+
+    std::mutex _mutex;
+    std::ofstream _file;
+    std::vector<pcap_tap::sptr> _taps;
+    std::atomic<bool> _running{true};
+    std::thread _thread;
+};
+
+/*!
+ * Attaches a tap to each direction of a pair of links
+ *
+ * Links that can't capture their frames are logged and skipped.
+ *
+ * The device args that control the capture are:
+ * - pcap_snaplen: The number of bytes to capture of each frame
+ * - pcap_sample: Capture every pcap_sample-th frame in full
+ * - pcap_records: The number of frames each tap can hold
+ *
+ * \param writer The file to capture into
+ * \param links The links to capture
+ * \param name The name of the links in the file, the direction is appended
+ * \param args The device args
+ */
+UHD_API void attach_pcap_taps(pcap_writer& writer,
+    const both_links_t& links,
+    const std::string& name,
+    const uhd::device_addr_t& args);
+
+}} // namespace uhd::transport
@@ -0,0 +1,202 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/utils/byteswap.hpp>
+#include <uhd/utils/math.hpp>
+#include <uhdlib/transport/host_dsp.hpp>
+#include <complex>
+#include <cstdint>
+#include <string>
+
+namespace uhd { namespace transport {
+
+/*!
+ * Frequency shift and resampling of received samples on the host
+ *
+ * This is a DDC for rates that the radio cannot provide: samples in the sc16
+ * wire format are multiplied with a numerically controlled oscillator (NCO),
+ * filtered, and resampled by an arbitrary ratio with a polyphase filter bank,
+ * producing fc32 samples. The wire samples are read once, and converted,
+ * scaled and shifted in the same pass into a short history buffer, which the
+ * filter then reads while it is still in cache. See polyphase_resampler for
+ * the filter.
+ */
+class rx_host_dsp
+{
+public:
+    using wire_format_t = sc16_wire_format_t;
+
+    rx_host_dsp(const wire_format_t wire) : _wire(wire)
+    {
+        _update();
+    }
+
+    /*!
+     * Configures the rates
+     *
+     * \param input_rate the sample rate of the wire samples
+     * \param output_rate the sample rate of the output, which is the same as
+     *        the input rate for a frequency shift only
+     */
+    void set_rates(const double input_rate, const double output_rate)
+    {
+        if (input_rate <= 0.0 || output_rate <= 0.0) {
+            throw uhd::value_error("[rx_stream] Host DSP rates must be positive");
+        }
+        if (input_rate / output_rate > double(polyphase_resampler::MAX_DECIM)) {
+            throw uhd::value_error("[rx_stream] Host DSP can't decimate by more than "
+                                   + std::to_string(polyphase_resampler::MAX_DECIM));
+        }
+        _input_rate  = input_rate;
+        _output_rate = output_rate;
+        _update();
+    }
+
+    /*!
+     * Configures the frequency shift of the NCO
+     *
+     * A positive shift moves a tone at -f Hz to 0 Hz, like tuning the DSP of
+     * the radio to f Hz below its current frequency would, i.e. the samples
+     * are multiplied with exp(+j*2*pi*f*t).
+     */
+    void set_freq_shift(const double freq_shift)
+    {
+        _freq_shift = freq_shift;
+        _update();
+    }
+
+    //! Configures the scaling of the wire samples, e.g. 1/32767
+    void set_scale_factor(const double scale_factor)
+    {
+        _scale_factor = scale_factor;
+        _update();
+    }
+
+    //! Returns the ratio of the input rate to the output rate
+    double get_ratio() const
+    {
+        return _resampler.get_step();
+    }
+
+    /*!
+     * Clears the history and the phase of the NCO, as at the start of a stream.
+     * Changing any configuration also does this.
+     */
+    void reset()
+    {
+        _resampler.reset();
+        _nco.reset();
+    }
+
+    /*!
+     * Processes wire samples into output samples
+     *
+     * Only about as many input samples are consumed as are needed to produce
+     * \p max_out output samples, so the input can be passed again, after the
+     * consumed samples, to produce more output.
+     *
+     * The output sample that the filter computes from the input samples up to
+     * and including sample n, within the input of this call, has offset n. The
+     * offset of the first output can be negative when upsampling, if it lies
+     * before the consumed input.
+     *
+     * \param input the wire samples
+     * \param num_in the number of wire samples
+     * \param output the buffer for the output samples
+     * \param max_out the size of the output buffer, in samples
+     * \param num_consumed returns the number of wire samples consumed
+     * \param first_out_offset returns the offset of the first output sample
+     * \return the number of output samples
+     */
+    size_t process(const void* input,
+        const size_t num_in,
+        std::complex<float>* output,
+        const size_t max_out,
+        size_t& num_consumed,
+        int64_t& first_out_offset)
+    {
+        first_out_offset = _resampler.get_next_out_offset();
+        num_consumed     = _resampler.get_num_needed(num_in, max_out);
+        switch (_wire) {
+            case wire_format_t::CHDR:
+                _convert<wire_format_t::CHDR>(input, num_consumed);
+                break;
+            case wire_format_t::ITEM32_LE:
+                _convert<wire_format_t::ITEM32_LE>(input, num_consumed);
+                break;
+            case wire_format_t::ITEM32_BE:
+                _convert<wire_format_t::ITEM32_BE>(input, num_consumed);
+                break;
+        }
+        return _resampler.produce(
+            max_out, [output](const size_t n, const std::complex<float>& samp) {
+                output[n] = samp;
+            });
+    }
+
+private:
+    //! Designs the filter and resets the state
+    void _update()
+    {
+        _resampler.configure(_input_rate / _output_rate, _scale_factor);
+        _nco.set_step(2.0 * uhd::math::PI * _freq_shift / _input_rate);
+    }
+
+    //! Reads sample \p i of the input
+    template <wire_format_t wire>
+    UHD_FORCE_INLINE static void _load(
+        const void* input, const size_t i, float& re, float& im)
+    {
+        if (wire == wire_format_t::CHDR) {
+            const int16_t* in = reinterpret_cast<const int16_t*>(input) + 2 * i;
+            re                = float(in[0]);
+            im                = float(in[1]);
+            return;
+        }
+        const uint32_t raw  = reinterpret_cast<const uint32_t*>(input)[i];
+        const uint32_t item = (wire == wire_format_t::ITEM32_LE) ? uhd::wtohx(raw)
+                                                                 : uhd::ntohx(raw);
+        re = float(int16_t(item >> 16));
+        im = float(int16_t(item & 0xffff));
+    }
+
+    //! Appends \p num_in input samples to the history, shifted by the NCO
+    template <wire_format_t wire>
+    void _convert(const void* input, const size_t num_in)
+    {
+        float* out_i;
+        float* out_q;
+        _resampler.append(num_in, out_i, out_q);
+        if (!_nco.enabled()) {
+            for (size_t n = 0; n < num_in; n++) {
+                _load<wire>(input, n, out_i[n], out_q[n]);
+            }
+            return;
+        }
+        _nco.run(num_in, [=](const size_t n, const std::complex<float>& osc) {
+            float re, im;
+            _load<wire>(input, n, re, im);
+            out_i[n] = re * osc.real() - im * osc.imag();
+            out_q[n] = re * osc.imag() + im * osc.real();
+        });
+    }
+
+    const wire_format_t _wire;
+
+    double _input_rate   = 1.0;
+    double _output_rate  = 1.0;
+    double _freq_shift   = 0.0;
+    double _scale_factor = 1.0 / 32767.0;
+
+    polyphase_resampler _resampler;
+    nco _nco;
+};
+
+}} // namespace uhd::transport
@@ -12,8 +12,17 @@
 #include <uhd/stream.hpp>
 #include <uhd/types/endianness.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhdlib/convert/convert_pool.hpp>
+#include <uhdlib/convert/iq_correction.hpp>
+#include <uhdlib/convert/signal_stats.hpp>
+#include <uhdlib/transport/rx_host_dsp.hpp>
 #include <uhdlib/transport/rx_streamer_zero_copy.hpp>
+#include <uhdlib/transport/samps_to_ticks.hpp>
+#include <uhdlib/usrp/common/offload_thread_placement.hpp>
+#include <algorithm>
 #include <limits>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace uhd { namespace transport {
@@ -73,7 +82,26 @@ class rx_streamer_impl : public rx_streamer
 {
 public:
     //! Constructor
-    rx_streamer_impl(const size_t num_ports, const uhd::stream_args_t stream_args)
+    /*!
+     * The stream args host_rate and host_freq_shift enable resampling and
+     * frequency shifting on the host, see rx_host_dsp. host_rate is the sample
+     * rate of the output of recv(), and host_freq_shift the frequency in Hz
+     * that the NCO shifts the samples by. This is only supported for the sc16
+     * otw_format and the fc32 cpu_format, without interleaving. The
+     * timestamps, fragment offsets and end-of-vector positions of the metadata
+     * still count input samples, and recv_zero_copy() returns the samples as
+     * they come off the wire.
+     *
+     * \param num_ports the number of channels of the streamer
+     * \param stream_args the stream args
+     * \param otw_format_suffix appended to the otw_format to look up the
+     *        converters, e.g. "_item32_le" for devices that send VRT packets
+     * \throws uhd::value_error if the host DSP is requested for formats it
+     *         doesn't support
+     */
+    rx_streamer_impl(const size_t num_ports,
+        const uhd::stream_args_t stream_args,
+        const std::string& otw_format_suffix = "_chdr")
         : _zero_copy_streamer(num_ports), _in_buffs(num_ports)
     {
         if (stream_args.cpu_format.empty()) {
@@ -82,10 +110,20 @@ public:
         if (stream_args.otw_format.empty()) {
             throw uhd::value_error("[rx_stream] Must provide a otw_format!");
         }
-        _setup_converters(num_ports, stream_args);
+        _setup_converters(num_ports, stream_args, otw_format_suffix);
+        _setup_host_dsp(num_ports, stream_args);
+        _setup_convert_pool(stream_args);
+        if (stream_args.args.cast<bool>("signal_stats", false)) {
+            set_signal_stats_enabled(true);
+        }
         _zero_copy_streamer.set_samp_rate(_samp_rate);
         _zero_copy_streamer.set_bytes_per_item(_convert_info.bytes_per_otw_item);
 
+        _zero_copy_streamer.get_stats().set_enabled(
+            stream_args.args.cast<bool>("enable_stats", false));
+        _zero_copy_streamer.get_stats().set_latency_probe_enabled(
+            stream_args.args.cast<bool>("enable_latency_probe", false));
+
         if (stream_args.args.has_key("spp")) {
             _spp = stream_args.args.cast<size_t>("spp", _spp);
             _mtu = _spp * _convert_info.bytes_per_otw_item;
@@ -105,6 +143,12 @@ public:
         }
     }
 
+    //! Disconnect a channel from the streamer, and return its transport
+    virtual typename transport_t::uptr disconnect_channel(const size_t channel)
+    {
+        return _zero_copy_streamer.disconnect_channel(channel);
+    }
+
     //! Implementation of rx_streamer API method
     size_t get_num_channels() const
     {
@@ -117,6 +161,106 @@ public:
         return _spp;
     }
 
+    //! Implementation of rx_streamer API method
+    uhd::streamer_stats_t get_stats() const
+    {
+        return _zero_copy_streamer.get_stats().get();
+    }
+
+    //! Implementation of rx_streamer API method
+    void set_stats_enabled(const bool enable)
+    {
+        _zero_copy_streamer.get_stats().set_enabled(enable);
+    }
+
+    //! Implementation of rx_streamer API method
+    void set_latency_probe_enabled(const bool enable)
+    {
+        _zero_copy_streamer.get_stats().set_latency_probe_enabled(enable);
+    }
+
+    //! Implementation of rx_streamer API method
+    void set_signal_stats_enabled(const bool enable)
+    {
+        if (enable == _signal_stats_enabled) {
+            return;
+        }
+        if (enable) {
+            if (_convert_info.chans_per_out_buff > 1) {
+                throw uhd::not_implemented_error("[rx_stream] Signal statistics are "
+                                                 "not supported with interleaved output");
+            }
+            if (!_host_dsps.empty()) {
+                throw uhd::not_implemented_error(
+                    "[rx_stream] Signal statistics are not supported with the host DSP");
+            }
+            if (std::any_of(_iq_corrected.begin(), _iq_corrected.end(), [](bool c) {
+                    return c;
+                })) {
+                throw uhd::not_implemented_error("[rx_stream] Signal statistics are "
+                                                 "not supported with IQ correction");
+            }
+            try {
+                convert::make_signal_stats_converter(_convert_id);
+            } catch (const uhd::key_error&) {
+                throw uhd::not_implemented_error(
+                    "[rx_stream] Signal statistics are not supported for "
+                    + _convert_id.input_format + " -> " + _convert_id.output_format);
+            }
+        }
+
+        _signal_stats_enabled = enable;
+        for (size_t chan = 0; chan < _converters.size(); chan++) {
+            _converters[chan] = _make_converter(chan);
+            _update_pool_converters(chan);
+        }
+        _update_use_multi_chan_converter();
+    }
+
+    //! Implementation of rx_streamer API method
+    uhd::signal_stats_t get_signal_stats(const size_t chan, const bool reset = true)
+    {
+        if (!_signal_stats_enabled) {
+            throw uhd::not_implemented_error(
+                "[rx_stream] Signal statistics are not enabled");
+        }
+        // The workers of the convert pool each see a part of the samples
+        uhd::signal_stats_t stats;
+        auto collect = [&stats, reset](const bound_converter& conv) {
+            auto& converter =
+                static_cast<convert::signal_stats_converter&>(*conv.converter);
+            stats += converter.get_signal_stats();
+            if (reset) {
+                converter.reset_signal_stats();
+            }
+        };
+        collect(_converters.at(chan));
+        for (const auto& conv : _pool_converters[chan]) {
+            collect(conv);
+        }
+        return stats;
+    }
+
+    //! Implementation of rx_streamer API method
+    void set_channel_active(const size_t chan, const bool active)
+    {
+        _zero_copy_streamer.set_channel_active(chan, active, false, 0);
+    }
+
+    //! Implementation of rx_streamer API method
+    void set_channel_active(
+        const size_t chan, const bool active, const uhd::time_spec_t& time_spec)
+    {
+        _zero_copy_streamer.set_channel_active(
+            chan, active, true, uint64_t(time_spec.to_ticks(_tick_rate)));
+    }
+
+    //! Implementation of rx_streamer API method
+    bool is_channel_active(const size_t chan) const
+    {
+        return _zero_copy_streamer.is_channel_active(chan);
+    }
+
     /*! Get width of each over-the-wire item component. For complex items,
      *  returns the width of one component only (real or imaginary).
      */
@@ -132,6 +276,229 @@ public:
         const double timeout,
         const bool one_packet)
     {
+        const size_t num_samps =
+            _recv(buffs, nsamps_per_buff, metadata, timeout, one_packet);
+        _set_time_spec(metadata);
+        _zero_copy_streamer.get_stats().end_recv();
+        return num_samps;
+    }
+
+    /*!
+     * Receive the next packet of each channel without converting it.
+     *
+     * Instead of copying samples into user memory, this returns pointers to
+     * the payloads of the frame buffers, which hold samples in the
+     * over-the-wire format. If a previous call to recv() only consumed part of
+     * a packet, the pointers point at the remainder of that packet.
+     *
+     * The buffers remain owned by the link until release_recv_buffs() is
+     * called, which must happen before the next call to recv() or
+     * recv_zero_copy(). Holding on to buffers for a long time starves the link
+     * of frame buffers and causes overruns.
+     *
+     * \param buffs returns one payload pointer per channel
+     * \param metadata data to fill describing the buffers
+     * \param timeout the timeout in seconds to wait for a packet
+     * \return the number of samples in each buffer, or 0 on error
+     * \throws uhd::runtime_error if buffers from a previous call have not been
+     *         released
+     */
+    size_t recv_zero_copy(std::vector<const void*>& buffs,
+        uhd::rx_metadata_t& metadata,
+        const double timeout)
+    {
+        const size_t num_samps = _recv_zero_copy(buffs, metadata, timeout);
+        _set_time_spec(metadata);
+        _zero_copy_streamer.get_stats().end_recv();
+        return num_samps;
+    }
+
+    /*!
+     * Return the buffers of the last call to recv_zero_copy() to the link.
+     * Does nothing if no buffers are held.
+     */
+    void release_recv_buffs()
+    {
+        if (!_zero_copy_buffs_held) {
+            return;
+        }
+        for (size_t chan = 0; chan < get_num_channels(); chan++) {
+            _zero_copy_streamer.release_recv_buff(chan);
+        }
+        _zero_copy_buffs_held = false;
+    }
+
+protected:
+    //! Configures scaling factor for conversion
+    void set_scale_factor(const size_t chan, const double scale_factor)
+    {
+        _converters[chan].converter->set_scalar(scale_factor);
+        for (auto& conv : _pool_converters[chan]) {
+            conv.converter->set_scalar(scale_factor);
+        }
+        _scale_factors[chan] = scale_factor;
+        if (!_host_dsps.empty()) {
+            _host_dsps[chan].set_scale_factor(scale_factor);
+        }
+
+        if (!_multi_chan_converter.converter) {
+            return;
+        }
+
+        // The multi-channel converter has a single scale factor for all
+        // channels. If the output is interleaved, it is the only converter, so
+        // the channels have to share it.
+        if (_convert_info.chans_per_out_buff > 1 && !_scale_factors_match()) {
+            UHD_LOG_WARNING("STREAMER",
+                "Channels of an interleaved rx streamer have different scale "
+                "factors, using the scale factor of channel "
+                    << chan << " for all of them");
+        }
+        _multi_chan_converter.converter->set_scalar(scale_factor);
+        _update_use_multi_chan_converter();
+    }
+
+    /*!
+     * Configures the DC offset and IQ imbalance correction of a channel
+     *
+     * The correction is applied while converting the samples, which saves a
+     * second pass over them after recv(). This is for devices that cannot
+     * correct the samples in the FPGA. Passing the identity correction goes
+     * back to the regular converter.
+     *
+     * \throws uhd::not_implemented_error if there is no converter that applies
+     *         corrections for the formats of this streamer, or if the output
+     *         is interleaved or goes through the host DSP
+     */
+    void set_iq_correction(
+        const size_t chan, const uhd::convert::iq_correction_t& correction)
+    {
+        const bool enable = !correction.is_identity();
+        if (enable && _convert_info.chans_per_out_buff > 1) {
+            throw uhd::not_implemented_error(
+                "[rx_stream] IQ correction is not supported with interleaved output");
+        }
+        if (enable && !_host_dsps.empty()) {
+            throw uhd::not_implemented_error(
+                "[rx_stream] IQ correction is not supported with the host DSP");
+        }
+        if (enable && _signal_stats_enabled) {
+            throw uhd::not_implemented_error(
+                "[rx_stream] IQ correction is not supported with signal statistics");
+        }
+
+        bound_converter conv;
+        if (enable) {
+            auto converter = std::dynamic_pointer_cast<convert::iq_correcting_converter>(
+                _converters[chan].converter);
+            if (!converter) {
+                try {
+                    converter = convert::make_iq_correcting_converter(_convert_id);
+                } catch (const uhd::key_error&) {
+                    throw uhd::not_implemented_error(
+                        "[rx_stream] IQ correction is not supported for "
+                        + _convert_id.input_format + " -> "
+                        + _convert_id.output_format);
+                }
+            }
+            converter->set_iq_correction(correction);
+            conv.converter = converter;
+            conv.converter->set_scalar(_scale_factors[chan]);
+            conv.kernel = conv.converter->get_kernel();
+        }
+        _iq_corrected[chan]   = enable;
+        _iq_corrections[chan] = correction;
+        _converters[chan]     = enable ? conv : _make_converter(chan);
+        _update_pool_converters(chan);
+        _update_use_multi_chan_converter();
+    }
+
+    //! Returns the maximum payload size
+    size_t get_mtu() const
+    {
+        return _mtu;
+    }
+
+    //! Sets the MTU and calculates spp
+    void set_mtu(const size_t mtu)
+    {
+        _mtu = mtu;
+        _spp = _mtu / _convert_info.bytes_per_otw_item;
+    }
+
+    //! Configures sample rate for conversion of timestamp
+    void set_samp_rate(const double rate)
+    {
+        _samp_rate = rate;
+        _samps_to_ticks.set_samp_rate(rate);
+        _zero_copy_streamer.set_samp_rate(rate);
+        _update_host_dsp_rates();
+    }
+
+    //! Configures tick rate for conversion of timestamp
+    void set_tick_rate(const double rate)
+    {
+        _tick_rate = rate;
+        _samps_to_ticks.set_tick_rate(rate);
+        _zero_copy_streamer.set_tick_rate(rate);
+    }
+
+    //! Notifies the streamer that an overrun has occured
+    void set_stopped_due_to_overrun()
+    {
+        _zero_copy_streamer.set_stopped_due_to_overrun();
+    }
+
+    //! Notifies the streamer that an overrun has occured
+    void set_stopped_due_to_late_command()
+    {
+        _zero_copy_streamer.set_stopped_due_to_late_command();
+    }
+
+    //! Provides a callback to handle overruns
+    void set_overrun_handler(
+        typename rx_streamer_zero_copy<transport_t>::overrun_handler_t handler)
+    {
+        _zero_copy_streamer.set_overrun_handler(handler);
+    }
+
+    //! Tags the samples of a channel from the given time on, see rx_metadata_t::tags
+    void add_rx_tag(const size_t chan,
+        const uhd::rx_tag_t::tag_type_t type,
+        const uint64_t time_ticks)
+    {
+        _zero_copy_streamer.add_tag(chan, type, time_ticks);
+    }
+
+    //! Configures whether to report gaps in the timestamps as overruns
+    void set_report_gaps(const bool enable)
+    {
+        _zero_copy_streamer.set_report_gaps(enable);
+    }
+
+private:
+    /*!
+     * Converts the timestamp in ticks to the time_spec of the metadata
+     *
+     * The ticks are converted even if has_time_ticks is false, so time_spec
+     * always reflects the timestamp field of the packet.
+     */
+    UHD_FORCE_INLINE void _set_time_spec(uhd::rx_metadata_t& metadata) const
+    {
+        metadata.time_spec = time_spec_t::from_ticks(metadata.time_ticks, _tick_rate);
+    }
+
+    //! Receive samples, see recv()
+    UHD_FORCE_INLINE size_t _recv(const uhd::rx_streamer::buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        uhd::rx_metadata_t& metadata,
+        const double timeout,
+        const bool one_packet)
+    {
+        if (_zero_copy_buffs_held) {
+            throw uhd::runtime_error(
+                "[rx_stream] Zero-copy buffers must be released before receiving again");
+        }
         if (_error_metadata_cache.check(metadata)) {
             return 0;
         }
@@ -142,9 +509,12 @@ public:
 
         size_t total_samps_recv =
             _recv_one_packet(buffs, nsamps_per_buff, metadata, eov_positions, timeout_ms);
+        _record_packet(eov_positions, metadata, 0, total_samps_recv);
 
         if (one_packet or metadata.end_of_burst
-            or (eov_positions.data() and eov_positions.remaining() == 0)) {
+            or (eov_positions.data() and eov_positions.remaining() == 0)
+            or (eov_positions.tags() and eov_positions.tags_remaining() == 0)
+            or (eov_positions.packets() and eov_positions.packets_remaining() == 0)) {
             return total_samps_recv;
         }
 
@@ -164,7 +534,8 @@ public:
                 loop_metadata,
                 eov_positions,
                 timeout_ms,
-                total_samps_recv * _convert_info.bytes_per_cpu_item);
+                total_samps_recv * _convert_info.bytes_per_cpu_item
+                    * _convert_info.chans_per_out_buff);
 
             // If metadata had an error code set, store for next call and return
             if (loop_metadata.error_code != rx_metadata_t::ERROR_CODE_NONE) {
@@ -172,6 +543,7 @@ public:
                 break;
             }
 
+            _record_packet(eov_positions, loop_metadata, total_samps_recv, num_samps);
             total_samps_recv += num_samps;
 
             // Return immediately if end of burst
@@ -183,72 +555,133 @@ public:
             if (eov_positions.data() and eov_positions.remaining() == 0) {
                 break;
             }
+            // Return if the tag array has been exhausted
+            if (eov_positions.tags() and eov_positions.tags_remaining() == 0) {
+                break;
+            }
+            // Return if the packet record array has been exhausted
+            if (eov_positions.packets() and eov_positions.packets_remaining() == 0) {
+                break;
+            }
         }
 
         return total_samps_recv;
     }
 
-protected:
-    //! Configures scaling factor for conversion
-    void set_scale_factor(const size_t chan, const double scale_factor)
+    //! Writes the record of a received packet, if the caller asked for them
+    UHD_FORCE_INLINE void _record_packet(detail::eov_data_wrapper& eov_positions,
+        const uhd::rx_metadata_t& metadata,
+        const size_t offset,
+        const size_t num_samps)
     {
-        _converters[chan]->set_scalar(scale_factor);
+        if (!eov_positions.packets() or eov_positions.packets_remaining() == 0
+            or (num_samps == 0 and !metadata.end_of_burst)) {
+            return;
+        }
+        uhd::rx_packet_info_t packet;
+        packet.offset     = offset;
+        packet.num_samps  = num_samps;
+        packet.time_ticks = metadata.time_ticks;
+        packet.flags =
+            (metadata.has_time_ticks ? uhd::rx_packet_info_t::HAS_TIME_TICKS : 0)
+            | (metadata.start_of_burst ? uhd::rx_packet_info_t::START_OF_BURST : 0)
+            | (metadata.end_of_burst ? uhd::rx_packet_info_t::END_OF_BURST : 0)
+            | (metadata.more_fragments ? uhd::rx_packet_info_t::MORE_FRAGMENTS : 0);
+        eov_positions.push_back_packet(packet);
     }
 
-    //! Returns the maximum payload size
-    size_t get_mtu() const
+    //! Receive packets without converting them, see recv_zero_copy()
+    size_t _recv_zero_copy(std::vector<const void*>& buffs,
+        uhd::rx_metadata_t& metadata,
+        const double timeout)
     {
-        return _mtu;
-    }
+        if (_zero_copy_buffs_held) {
+            throw uhd::runtime_error(
+                "[rx_stream] Zero-copy buffers must be released before receiving again");
+        }
+        if (_error_metadata_cache.check(metadata)) {
+            return 0;
+        }
 
-    //! Sets the MTU and calculates spp
-    void set_mtu(const size_t mtu)
-    {
-        _mtu = mtu;
-        _spp = _mtu / _convert_info.bytes_per_otw_item;
-    }
+        const int32_t timeout_ms = static_cast<int32_t>(timeout * 1000);
 
-    //! Configures sample rate for conversion of timestamp
-    void set_samp_rate(const double rate)
-    {
-        _samp_rate = rate;
-        _zero_copy_streamer.set_samp_rate(rate);
-    }
+        detail::eov_data_wrapper eov_positions(metadata);
 
-    //! Configures tick rate for conversion of timestamp
-    void set_tick_rate(const double rate)
-    {
-        _zero_copy_streamer.set_tick_rate(rate);
-    }
+        if (_buff_samps_remaining == 0) {
+            _buff_samps_remaining = _zero_copy_streamer.get_recv_buffs(
+                _in_buffs, metadata, eov_positions, timeout_ms);
+            _fragment_offset_in_samps = 0;
+            _packet_time_ticks        = metadata.time_ticks;
+        } else {
+            metadata            = _last_fragment_metadata;
+            metadata.time_ticks = _packet_time_ticks
+                                  + _samps_to_ticks(_fragment_offset_in_samps);
+        }
 
-    //! Notifies the streamer that an overrun has occured
-    void set_stopped_due_to_overrun()
-    {
-        _zero_copy_streamer.set_stopped_due_to_overrun();
-    }
+        if (_buff_samps_remaining == 0) {
+            return 0;
+        }
 
-    //! Notifies the streamer that an overrun has occured
-    void set_stopped_due_to_late_command()
-    {
-        _zero_copy_streamer.set_stopped_due_to_late_command();
-    }
+        const size_t num_samps = _buff_samps_remaining;
+        buffs.assign(_in_buffs.begin(), _in_buffs.end());
+        metadata.more_fragments  = false;
+        metadata.fragment_offset = _fragment_offset_in_samps;
 
-    //! Provides a callback to handle overruns
-    void set_overrun_handler(
-        typename rx_streamer_zero_copy<transport_t>::overrun_handler_t handler)
-    {
-        _zero_copy_streamer.set_overrun_handler(handler);
+        _buff_samps_remaining = 0;
+        _zero_copy_buffs_held = true;
+        return num_samps;
     }
 
-private:
     //! Converter and associated item sizes
     struct convert_info
     {
         size_t bytes_per_otw_item;
         size_t bytes_per_cpu_item;
         size_t otw_item_bit_width;
+        // Number of channels in each of the buffers passed to recv(), which is
+        // more than one if the output is interleaved
+        size_t chans_per_out_buff;
+    };
+
+    //! A converter along with its kernel, see convert::converter::get_kernel()
+    struct bound_converter
+    {
+        uhd::convert::converter::sptr converter;
+        uhd::convert::converter::kernel_type kernel;
+    };
+
+    //! The samples of one channel that the convert pool works on
+    struct pool_job
+    {
+        const char* in_buff;
+        char* out_buff;
+        size_t chan;
+        size_t num_samps;
+        size_t samps_per_thread;
     };
 
+    bool _scale_factors_match() const
+    {
+        return std::all_of(_scale_factors.begin(),
+            _scale_factors.end(),
+            [this](double s) { return s == _scale_factors.front(); });
+    }
+
+    // Use the multi-channel converter only if it converts all channels like
+    // the per-channel converters would. An interleaved output always uses it.
+    // The convert pool splits up single channels, so it never uses it.
+    void _update_use_multi_chan_converter()
+    {
+        if (!_multi_chan_converter.converter || _convert_info.chans_per_out_buff > 1) {
+            return;
+        }
+        _use_multi_chan_converter =
+            !_convert_pool && !_signal_stats_enabled && _scale_factors_match()
+            && std::none_of(_iq_corrected.begin(), _iq_corrected.end(), [](bool c) {
+                   return c;
+               });
+    }
+
     //! Receive a single packet
     UHD_FORCE_INLINE size_t _recv_one_packet(const uhd::rx_streamer::buffs_type& buffs,
         const size_t nsamps_per_buff,
@@ -257,27 +690,44 @@ private:
         const int32_t timeout_ms,
         const size_t buffer_offset_bytes = 0)
     {
+        if (!_host_dsps.empty()) {
+            return _recv_one_packet_host_dsp(buffs,
+                nsamps_per_buff,
+                metadata,
+                eov_positions,
+                timeout_ms,
+                buffer_offset_bytes);
+        }
+
         if (_buff_samps_remaining == 0) {
             // Current set of buffers has expired, get the next one
             _buff_samps_remaining = _zero_copy_streamer.get_recv_buffs(
                 _in_buffs, metadata, eov_positions, timeout_ms);
             _fragment_offset_in_samps = 0;
+            _packet_time_ticks        = metadata.time_ticks;
         } else {
-            // There are samples still left in the current set of buffers
-            metadata = _last_fragment_metadata;
-            metadata.time_spec += time_spec_t::from_ticks(
-                _fragment_offset_in_samps - metadata.fragment_offset, _samp_rate);
+            // There are samples still left in the current set of buffers. Their
+            // timestamp is an offset from the one of the packet, which keeps it
+            // exact no matter how many fragments the packet is read in.
+            metadata            = _last_fragment_metadata;
+            metadata.time_ticks = _packet_time_ticks
+                                  + _samps_to_ticks(_fragment_offset_in_samps);
         }
 
         if (_buff_samps_remaining != 0) {
             const size_t num_samps = std::min(nsamps_per_buff, _buff_samps_remaining);
 
             // Convert samples to the streamer's output format
-            for (size_t i = 0; i < get_num_channels(); i++) {
-                char* b = reinterpret_cast<char*>(buffs[i]);
-                const uhd::rx_streamer::buffs_type out_buffs(b + buffer_offset_bytes);
-                _convert_to_out_buff(out_buffs, i, num_samps);
+            UHD_TRACE(CONVERT_BEGIN, num_samps);
+            streamer_stats& stats = _zero_copy_streamer.get_stats();
+            if (stats.enabled()) {
+                const auto start = streamer_stats::clock::now();
+                _convert_packet(buffs, buffer_offset_bytes, num_samps);
+                stats.add_convert_time(streamer_stats::clock::now() - start);
+            } else {
+                _convert_packet(buffs, buffer_offset_bytes, num_samps);
             }
+            UHD_TRACE(CONVERT_END);
 
             _buff_samps_remaining -= num_samps;
 
@@ -296,6 +746,101 @@ private:
         }
     }
 
+    /*!
+     * Receive samples through the host DSP
+     *
+     * A packet is consumed only as far as the output buffer needs, and
+     * packets that don't produce any output when decimating are skipped. The
+     * timestamp is the one of the newest input sample that went into the
+     * first output sample.
+     */
+    size_t _recv_one_packet_host_dsp(const uhd::rx_streamer::buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        uhd::rx_metadata_t& metadata,
+        detail::eov_data_wrapper& eov_positions,
+        const int32_t timeout_ms,
+        const size_t buffer_offset_bytes)
+    {
+        if (nsamps_per_buff == 0) {
+            return 0;
+        }
+
+        while (true) {
+            if (_buff_samps_remaining == 0) {
+                _buff_samps_remaining = _zero_copy_streamer.get_recv_buffs(
+                    _in_buffs, metadata, eov_positions, timeout_ms);
+                _fragment_offset_in_samps = 0;
+                _packet_time_ticks        = metadata.time_ticks;
+                if (_buff_samps_remaining == 0) {
+                    return 0;
+                }
+            } else {
+                metadata = _last_fragment_metadata;
+            }
+
+            size_t num_in            = 0;
+            size_t num_out           = 0;
+            int64_t first_out_offset = 0;
+            UHD_TRACE(CONVERT_BEGIN, _buff_samps_remaining);
+            streamer_stats& stats = _zero_copy_streamer.get_stats();
+            const auto start      = stats.enabled() ? streamer_stats::clock::now()
+                                                    : streamer_stats::clock::time_point();
+            for (size_t chan = 0; chan < _in_buffs.size(); chan++) {
+                char* out = reinterpret_cast<char*>(buffs[chan]) + buffer_offset_bytes;
+                num_out   = _host_dsps[chan].process(_in_buffs[chan],
+                    _buff_samps_remaining,
+                    reinterpret_cast<std::complex<float>*>(out),
+                    nsamps_per_buff,
+                    num_in,
+                    first_out_offset);
+                _in_buffs[chan] = reinterpret_cast<const char*>(_in_buffs[chan])
+                                  + num_in * _convert_info.bytes_per_otw_item;
+                if (_buff_samps_remaining == num_in) {
+                    _zero_copy_streamer.release_recv_buff(chan);
+                }
+            }
+            if (stats.enabled()) {
+                stats.add_convert_time(streamer_stats::clock::now() - start);
+            }
+            UHD_TRACE(CONVERT_END);
+
+            // The first output can belong to the last sample of the previous
+            // packet when upsampling
+            const int64_t offset = int64_t(_fragment_offset_in_samps) + first_out_offset;
+            metadata.time_ticks  = (offset >= 0)
+                                      ? _packet_time_ticks + _samps_to_ticks(offset)
+                                      : _packet_time_ticks - _samps_to_ticks(-offset);
+
+            _buff_samps_remaining -= num_in;
+            metadata.more_fragments  = _buff_samps_remaining != 0;
+            metadata.fragment_offset = _fragment_offset_in_samps;
+            if (metadata.more_fragments) {
+                _fragment_offset_in_samps += num_in;
+                _last_fragment_metadata = metadata;
+            }
+
+            if (num_out != 0 || metadata.end_of_burst) {
+                return num_out;
+            }
+        }
+    }
+
+    //! Convert samples for all channels into the streamer's output format
+    UHD_FORCE_INLINE void _convert_packet(const uhd::rx_streamer::buffs_type& buffs,
+        const size_t buffer_offset_bytes,
+        const size_t num_samps)
+    {
+        if (_use_multi_chan_converter) {
+            _convert_to_out_buffs(buffs, buffer_offset_bytes, num_samps);
+        } else {
+            for (size_t i = 0; i < _in_buffs.size(); i++) {
+                char* b = reinterpret_cast<char*>(buffs[i]);
+                const uhd::rx_streamer::buffs_type out_buffs(b + buffer_offset_bytes);
+                _convert_to_out_buff(out_buffs, i, num_samps);
+            }
+        }
+    }
+
     //! Convert samples for one channel into its buffer
     UHD_FORCE_INLINE void _convert_to_out_buff(
         const uhd::rx_streamer::buffs_type& out_buffs,
@@ -304,7 +849,12 @@ private:
     {
         const char* buffer_ptr = reinterpret_cast<const char*>(_in_buffs[chan]);
 
-        _converters[chan]->conv(buffer_ptr, out_buffs, num_samps);
+        if (_convert_pool && num_samps >= 2 * MIN_SAMPS_PER_CONVERT_THREAD) {
+            _convert_in_pool(out_buffs[0], chan, buffer_ptr, num_samps);
+        } else if (num_samps != 0) {
+            const bound_converter& conv = _converters[chan];
+            conv.kernel(conv.converter.get(), buffer_ptr, out_buffs, num_samps);
+        }
 
         // Advance the pointer for the source buffer
         _in_buffs[chan] = buffer_ptr + num_samps * _convert_info.bytes_per_otw_item;
@@ -314,14 +864,86 @@ private:
         }
     }
 
+    /*!
+     * Convert samples for one channel on all threads of the convert pool
+     *
+     * Every thread converts a contiguous part of the samples into the part of
+     * the buffer they belong to, so the output is the same as if a single
+     * thread had converted them.
+     */
+    void _convert_in_pool(void* out_buff,
+        const size_t chan,
+        const char* in_buff,
+        const size_t num_samps)
+    {
+        const size_t num_threads = _convert_pool->get_num_threads();
+        // Parts start at a multiple of CONVERT_THREAD_ALIGNMENT samples, which
+        // keeps the groups of packed formats like sc12 together
+        const size_t samps_per_thread = ((num_samps + num_threads - 1) / num_threads
+                                            + CONVERT_THREAD_ALIGNMENT - 1)
+                                        / CONVERT_THREAD_ALIGNMENT
+                                        * CONVERT_THREAD_ALIGNMENT;
+
+        _pool_job.in_buff          = in_buff;
+        _pool_job.out_buff         = reinterpret_cast<char*>(out_buff);
+        _pool_job.chan             = chan;
+        _pool_job.num_samps        = num_samps;
+        _pool_job.samps_per_thread = samps_per_thread;
+        _convert_pool->run(_pool_task);
+    }
+
+    //! Convert the part of the pool job that belongs to a thread of the pool
+    void _run_pool_job(const size_t index)
+    {
+        const pool_job& job = _pool_job;
+        const size_t first  = index * job.samps_per_thread;
+        if (first >= job.num_samps) {
+            return;
+        }
+        const size_t num_samps = std::min(job.samps_per_thread, job.num_samps - first);
+
+        const bound_converter& conv =
+            (index == 0) ? _converters[job.chan] : _pool_converters[job.chan][index - 1];
+        const uhd::rx_streamer::buffs_type out_buffs(
+            job.out_buff + first * _convert_info.bytes_per_cpu_item);
+        conv.kernel(conv.converter.get(),
+            job.in_buff + first * _convert_info.bytes_per_otw_item,
+            out_buffs,
+            num_samps);
+    }
+
+    //! Convert samples for all channels at once into their buffers
+    UHD_FORCE_INLINE void _convert_to_out_buffs(const uhd::rx_streamer::buffs_type& buffs,
+        const size_t buffer_offset_bytes,
+        const size_t num_samps)
+    {
+        for (size_t i = 0; i < _out_buffs.size(); i++) {
+            _out_buffs[i] = reinterpret_cast<char*>(buffs[i]) + buffer_offset_bytes;
+        }
+
+        const bound_converter& conv = _multi_chan_converter;
+        conv.kernel(conv.converter.get(), _in_buffs, _out_buffs, num_samps);
+
+        const size_t num_bytes = num_samps * _convert_info.bytes_per_otw_item;
+        for (size_t chan = 0; chan < _in_buffs.size(); chan++) {
+            _in_buffs[chan] = reinterpret_cast<const char*>(_in_buffs[chan]) + num_bytes;
+
+            if (_buff_samps_remaining == num_samps) {
+                _zero_copy_streamer.release_recv_buff(chan);
+            }
+        }
+    }
+
     //! Create converters and initialize _convert_info
-    void _setup_converters(const size_t num_ports, const uhd::stream_args_t stream_args)
+    void _setup_converters(const size_t num_ports,
+        const uhd::stream_args_t stream_args,
+        const std::string& otw_format_suffix)
     {
         // Note to code archaeologists: In the past, we had to also specify the
         // endianness here, but that is no longer necessary because we can make
         // the wire endianness match the host endianness.
         convert::id_type id;
-        id.input_format  = stream_args.otw_format + "_chdr";
+        id.input_format  = stream_args.otw_format + otw_format_suffix;
         id.num_inputs    = 1;
         id.output_format = stream_args.cpu_format;
         id.num_outputs   = 1;
@@ -343,19 +965,184 @@ private:
             info.otw_item_bit_width = info.bytes_per_otw_item * 8;
         }
 
+        // Channels can be converted with a single converter, either into one
+        // buffer per channel, or interleaved into a single buffer
+        const bool interleave = stream_args.args.cast<bool>("interleave", false);
+        info.chans_per_out_buff = interleave ? num_ports : 1;
+
+        if (num_ports > 1) {
+            convert::id_type multi_chan_id = id;
+            multi_chan_id.num_inputs       = num_ports;
+            multi_chan_id.num_outputs      = interleave ? 1 : num_ports;
+            try {
+                bound_converter conv;
+                conv.converter = convert::get_converter(multi_chan_id)();
+                conv.converter->set_scalar(1 / 32767.0);
+                conv.kernel               = conv.converter->get_kernel();
+                _multi_chan_converter     = conv;
+                _use_multi_chan_converter = true;
+                _out_buffs.resize(multi_chan_id.num_outputs);
+            } catch (const uhd::key_error&) {
+                if (interleave) {
+                    throw uhd::value_error(
+                        "[rx_stream] Interleaved output is not supported for "
+                        + id.input_format + " -> " + id.output_format);
+                }
+            }
+        }
+
         _convert_info = info;
+        _convert_id   = id;
+        _scale_factors.assign(num_ports, 1 / 32767.0);
+        _iq_corrected.assign(num_ports, false);
+        _iq_corrections.resize(num_ports);
+        _pool_converters.resize(num_ports);
+
+        for (size_t i = 0; i < num_ports; i++) {
+            bound_converter conv;
+            conv.converter = convert::get_converter(id)();
+            conv.converter->set_scalar(1 / 32767.0);
+            conv.kernel = conv.converter->get_kernel();
+            _converters.push_back(conv);
+        }
+    }
+
+    /*!
+     * Create the convert pool, if the stream args ask for it
+     *
+     * The convert_threads stream arg is the number of threads that convert
+     * each packet, including the thread that calls recv(). The workers are
+     * pinned to the CPUs in the convert_cpus stream arg (e.g., "4-7").
+     */
+    void _setup_convert_pool(const uhd::stream_args_t& stream_args)
+    {
+        const size_t num_threads = stream_args.args.cast<size_t>("convert_threads", 1);
+        if (num_threads <= 1) {
+            return;
+        }
+        if (_convert_info.chans_per_out_buff > 1 || !_host_dsps.empty()) {
+            throw uhd::value_error("[rx_stream] convert_threads is not supported with "
+                                   "interleaved output or the host DSP");
+        }
+
+        std::vector<size_t> cpus;
+        if (stream_args.args.has_key("convert_cpus")) {
+            cpus = uhd::usrp::parse_cpu_list(stream_args.args["convert_cpus"]);
+            if (cpus.empty()) {
+                throw uhd::value_error("[rx_stream] Invalid convert_cpus: "
+                                       + stream_args.args["convert_cpus"]);
+            }
+        }
+
+        _convert_pool.reset(new convert::convert_pool(num_threads, cpus));
+        _pool_task = [this](const size_t index) { _run_pool_job(index); };
+        for (size_t chan = 0; chan < _converters.size(); chan++) {
+            _update_pool_converters(chan);
+        }
+        _use_multi_chan_converter = false;
+        UHD_LOG_DEBUG("STREAMER", "Converting on " << num_threads << " threads");
+    }
+
+    //! Make a converter for a channel, with its IQ correction or statistics
+    bound_converter _make_converter(const size_t chan) const
+    {
+        bound_converter conv;
+        if (_iq_corrected[chan]) {
+            auto converter = convert::make_iq_correcting_converter(_convert_id);
+            converter->set_iq_correction(_iq_corrections[chan]);
+            conv.converter = converter;
+        } else if (_signal_stats_enabled) {
+            conv.converter = convert::make_signal_stats_converter(_convert_id);
+        } else {
+            conv.converter = convert::get_converter(_convert_id)();
+        }
+        conv.converter->set_scalar(_scale_factors[chan]);
+        conv.kernel = conv.converter->get_kernel();
+        return conv;
+    }
+
+    //! Give the workers of the convert pool converters like the one of a channel
+    void _update_pool_converters(const size_t chan)
+    {
+        if (!_convert_pool) {
+            return;
+        }
+        std::vector<bound_converter>& convs = _pool_converters[chan];
+        convs.clear();
+        for (size_t i = 1; i < _convert_pool->get_num_threads(); i++) {
+            convs.push_back(_make_converter(chan));
+        }
+    }
 
+    //! Create a host DSP for each channel, if the stream args ask for it
+    void _setup_host_dsp(const size_t num_ports, const uhd::stream_args_t& stream_args)
+    {
+        if (!stream_args.args.has_key("host_rate")
+            && !stream_args.args.has_key("host_freq_shift")) {
+            return;
+        }
+        if (_convert_id.output_format != "fc32") {
+            throw uhd::value_error(
+                "[rx_stream] Host DSP is not supported for " + _convert_id.output_format);
+        }
+        if (_convert_info.chans_per_out_buff > 1) {
+            throw uhd::value_error(
+                "[rx_stream] Host DSP is not supported with interleaved output");
+        }
+        const auto wire         = get_sc16_wire_format(_convert_id.input_format);
+        const double freq_shift = stream_args.args.cast<double>("host_freq_shift", 0.0);
+        _host_rate              = stream_args.args.cast<double>("host_rate", 0.0);
         for (size_t i = 0; i < num_ports; i++) {
-            _converters.push_back(convert::get_converter(id)());
-            _converters.back()->set_scalar(1 / 32767.0);
+            _host_dsps.emplace_back(wire);
+            _host_dsps.back().set_freq_shift(freq_shift);
+        }
+        // The rates are configured once the sample rate is known
+    }
+
+    void _update_host_dsp_rates()
+    {
+        // Without a host rate, the host DSP only shifts the frequency
+        const double output_rate = (_host_rate > 0.0) ? _host_rate : _samp_rate;
+        for (auto& dsp : _host_dsps) {
+            dsp.set_rates(_samp_rate, output_rate);
         }
     }
 
     // Converter and item sizes
     convert_info _convert_info;
 
-    // Converters
-    std::vector<uhd::convert::converter::sptr> _converters;
+    // Converters, with their kernels resolved up front so converting a packet
+    // does not go through virtual dispatch
+    std::vector<bound_converter> _converters;
+
+    // Converts all channels at once, if there is a converter for it
+    bound_converter _multi_chan_converter;
+    bool _use_multi_chan_converter = false;
+    std::vector<double> _scale_factors;
+
+    // Conversion of a single channel, and which channels use a converter that
+    // applies IQ corrections
+    convert::id_type _convert_id;
+    std::vector<bool> _iq_corrected;
+    std::vector<convert::iq_correction_t> _iq_corrections;
+
+    // Whether the converters of the channels collect signal statistics
+    bool _signal_stats_enabled = false;
+
+    // Threads that convert the packets of a channel in parallel, if enabled,
+    // with a converter per channel for every thread besides the caller of
+    // recv(), and the samples they work on
+    static constexpr size_t MIN_SAMPS_PER_CONVERT_THREAD = 256;
+    static constexpr size_t CONVERT_THREAD_ALIGNMENT     = 16;
+    std::unique_ptr<convert::convert_pool> _convert_pool;
+    std::vector<std::vector<bound_converter>> _pool_converters;
+    convert::convert_pool::task_t _pool_task;
+    pool_job _pool_job;
+
+    // Resampling and frequency shift on the host, one per channel if enabled,
+    // and the output rate of the resampling (0 if there is none)
+    std::vector<rx_host_dsp> _host_dsps;
+    double _host_rate = 0.0;
 
     // Implementation of frame buffer management and packet info
     rx_streamer_zero_copy<transport_t, ignore_seq_err> _zero_copy_streamer;
@@ -363,9 +1150,18 @@ private:
     // Container for buffer pointers used in recv method
     std::vector<const void*> _in_buffs;
 
+    // Container for buffer pointers passed to the multi-channel converter
+    std::vector<void*> _out_buffs;
+
     // Sample rate used to calculate metadata time_spec_t
     double _samp_rate = 1.0;
 
+    // Tick rate used to calculate metadata time_spec_t
+    double _tick_rate = 1.0;
+
+    // Conversion of fragment offsets to timestamps
+    samps_to_ticks _samps_to_ticks;
+
     // MTU, determined when xport is connected and modifiable by subclass
     size_t _mtu = std::numeric_limits<std::size_t>::max();
 
@@ -375,12 +1171,18 @@ private:
     // Num samps remaining in buffer currently held by zero copy streamer
     size_t _buff_samps_remaining = 0;
 
+    // Whether buffers handed out by recv_zero_copy() are waiting to be released
+    bool _zero_copy_buffs_held = false;
+
     // Metadata cache for error handling
     detail::rx_metadata_cache _error_metadata_cache;
 
     // Fragment (partially read packet) information
     size_t _fragment_offset_in_samps = 0;
     rx_metadata_t _last_fragment_metadata;
+
+    // Timestamp of the packet that is being read in fragments
+    uint64_t _packet_time_ticks = 0;
 };
 
 }} // namespace uhd::transport
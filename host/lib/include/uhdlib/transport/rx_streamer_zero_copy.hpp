@@ -11,14 +11,26 @@
 #include <uhd/types/metadata.hpp>
 #include <uhd/utils/log.hpp>
 #include <uhdlib/transport/get_aligned_buffs.hpp>
+#include <uhdlib/transport/samps_to_ticks.hpp>
+#include <uhdlib/transport/streamer_stats.hpp>
+#include <uhdlib/utils/trace.hpp>
+#include <boost/dynamic_bitset.hpp>
 #include <boost/format.hpp>
+#include <algorithm>
 #include <atomic>
+#include <limits>
+#include <mutex>
 #include <vector>
 
 namespace uhd { namespace transport {
 
 namespace detail {
 
+/*!
+ * Holds the arrays of a recv() call that return per-sample positions, the
+ * end-of-vector positions, the tags and the packet records, while the
+ * metadata is reset for each packet.
+ */
 class eov_data_wrapper
 {
 public:
@@ -29,6 +41,12 @@ public:
         , _remaining(metadata.eov_positions_size)
         , _write_pos(0)
         , _running_sample_count(0)
+        , _tags(metadata.tags)
+        , _tags_size(metadata.tags_size)
+        , _tags_count(0)
+        , _packets(metadata.packets)
+        , _packets_size(metadata.packets_size)
+        , _packets_count(0)
     {
     }
 
@@ -37,6 +55,12 @@ public:
         _metadata.eov_positions       = _data;
         _metadata.eov_positions_size  = _size;
         _metadata.eov_positions_count = _write_pos;
+        _metadata.tags                = _tags;
+        _metadata.tags_size           = _tags_size;
+        _metadata.tags_count          = _tags_count;
+        _metadata.packets             = _packets;
+        _metadata.packets_size        = _packets_size;
+        _metadata.packets_count       = _packets_count;
     }
 
     UHD_FORCE_INLINE size_t* data() const
@@ -66,6 +90,38 @@ public:
         return _running_sample_count;
     }
 
+    UHD_FORCE_INLINE uhd::rx_tag_t* tags() const
+    {
+        return _tags;
+    }
+
+    UHD_FORCE_INLINE size_t tags_remaining() const
+    {
+        return _tags_size - _tags_count;
+    }
+
+    UHD_FORCE_INLINE void push_back_tag(const uhd::rx_tag_t& tag)
+    {
+        assert(_tags && _tags_count < _tags_size);
+        _tags[_tags_count++] = tag;
+    }
+
+    UHD_FORCE_INLINE uhd::rx_packet_info_t* packets() const
+    {
+        return _packets;
+    }
+
+    UHD_FORCE_INLINE size_t packets_remaining() const
+    {
+        return _packets_size - _packets_count;
+    }
+
+    UHD_FORCE_INLINE void push_back_packet(const uhd::rx_packet_info_t& packet)
+    {
+        assert(_packets && _packets_count < _packets_size);
+        _packets[_packets_count++] = packet;
+    }
+
 private:
     uhd::rx_metadata_t& _metadata;
     size_t* _data;
@@ -73,6 +129,12 @@ private:
     size_t _remaining;
     size_t _write_pos;
     size_t _running_sample_count;
+    uhd::rx_tag_t* _tags;
+    size_t _tags_size;
+    size_t _tags_count;
+    uhd::rx_packet_info_t* _packets;
+    size_t _packets_size;
+    size_t _packets_count;
 };
 
 } // namespace detail
@@ -93,8 +155,14 @@ public:
         : _xports(num_ports)
         , _frame_buffs(num_ports)
         , _infos(num_ports)
-        , _get_aligned_buffs(_xports, _frame_buffs, _infos)
+        , _active(num_ports)
+        , _join_ticks(num_ports, std::numeric_limits<uint64_t>::max())
+        , _get_aligned_buffs(
+              _xports, _frame_buffs, _infos, _samps_to_ticks, _bytes_per_item, _active)
+        , _stats(num_ports)
+        , _requested_active(num_ports, true)
     {
+        _active.set();
     }
 
     ~rx_streamer_zero_copy()
@@ -122,6 +190,24 @@ public:
         _xports[port] = std::move(xport);
     }
 
+    /*!
+     * Disconnect a channel from the streamer, and return its transport. Any
+     * packet the streamer holds for the channel is released.
+     */
+    typename transport_t::uptr disconnect_channel(const size_t port)
+    {
+        if (port >= get_num_channels()) {
+            throw uhd::index_error(
+                "Port number indexes beyond the number of streamer ports");
+        }
+
+        if (_frame_buffs[port]) {
+            _xports[port]->release_recv_buff(std::move(_frame_buffs[port]));
+            _frame_buffs[port] = nullptr;
+        }
+        return std::move(_xports[port]);
+    }
+
     //! Returns number of channels handled by this streamer
     size_t get_num_channels() const
     {
@@ -131,13 +217,13 @@ public:
     //! Configures tick rate for conversion of timestamp
     void set_tick_rate(const double rate)
     {
-        _tick_rate = rate;
+        _samps_to_ticks.set_tick_rate(rate);
     }
 
     //! Configures sample rate for conversion of timestamp
     void set_samp_rate(const double rate)
     {
-        _samp_rate = rate;
+        _samps_to_ticks.set_samp_rate(rate);
     }
 
     //! Configures the size of each sample
@@ -164,9 +250,112 @@ public:
         _overrun_handler = handler;
     }
 
+    /*!
+     * Configures whether to report gaps in the timestamps of a burst as
+     * overruns. A gap is reported once, with ERROR_CODE_OVERFLOW and the number
+     * of lost samples, before the packets that follow it are returned.
+     */
+    void set_report_gaps(const bool enable)
+    {
+        _report_gaps  = enable;
+        _has_next_tsf = false;
+    }
+
+    /*!
+     * Adds a tag for the samples of a channel from the given time on
+     *
+     * This may be called from any thread, the tag is placed when recv()
+     * returns the samples of that time.
+     */
+    void add_tag(const size_t channel,
+        const uhd::rx_tag_t::tag_type_t type,
+        const uint64_t time_ticks)
+    {
+        std::lock_guard<std::mutex> l(_tags_mutex);
+        // Without timestamps, the tags are never placed, so keep only the
+        // newest ones
+        if (_pending_tags.size() >= MAX_PENDING_TAGS) {
+            _pending_tags.erase(_pending_tags.begin());
+        }
+        uhd::rx_tag_t tag;
+        tag.type       = type;
+        tag.channel    = channel;
+        tag.offset     = 0;
+        tag.time_ticks = time_ticks;
+        // Keep the tags in order of time
+        auto it = std::upper_bound(_pending_tags.begin(),
+            _pending_tags.end(),
+            tag,
+            [](const uhd::rx_tag_t& a, const uhd::rx_tag_t& b) {
+                return a.time_ticks < b.time_ticks;
+            });
+        _pending_tags.insert(it, tag);
+        _num_pending_tags.store(_pending_tags.size(), std::memory_order_release);
+    }
+
+    /*!
+     * Activates or deactivates a channel
+     *
+     * recv() returns zeros for an inactive channel, and drops the packets its
+     * transport receives. This may be called from any thread, recv() picks up
+     * the change on its next call. A change replaces the changes of the
+     * channel that haven't taken effect yet.
+     *
+     * \param chan the channel
+     * \param active whether recv() returns the samples of the channel
+     * \param timed true if the change takes effect at \p time_ticks, false if
+     *        it takes effect right away
+     * \param time_ticks the time of the first sample that the change applies to
+     * \throws uhd::runtime_error if this would deactivate all channels
+     */
+    void set_channel_active(const size_t chan,
+        const bool active,
+        const bool timed,
+        const uint64_t time_ticks)
+    {
+        if (chan >= get_num_channels()) {
+            throw uhd::index_error(
+                "Channel number indexes beyond the number of streamer channels");
+        }
+
+        std::lock_guard<std::mutex> l(_changes_mutex);
+        if (!active
+            && std::count(_requested_active.begin(), _requested_active.end(), true)
+                   == (_requested_active[chan] ? 1 : 0)) {
+            throw uhd::runtime_error(
+                "[rx_stream] Can't deactivate the last active channel");
+        }
+        _requested_active[chan] = active;
+        _pending_changes.push_back({chan, active, timed, time_ticks});
+        _num_pending_changes.store(_pending_changes.size(), std::memory_order_release);
+    }
+
+    //! Returns whether a channel is active, or is going to be
+    bool is_channel_active(const size_t chan) const
+    {
+        std::lock_guard<std::mutex> l(_changes_mutex);
+        return _requested_active.at(chan);
+    }
+
+    //! Returns the statistics counters of the streamer
+    streamer_stats& get_stats()
+    {
+        return _stats;
+    }
+
+    //! Returns the statistics counters of the streamer
+    const streamer_stats& get_stats() const
+    {
+        return _stats;
+    }
+
     /*!
      * Gets a set of time-aligned buffers, one per channel.
      *
+     * The timestamp is returned in metadata.time_ticks only. Converting it to
+     * metadata.time_spec is left to the caller, so it happens once per call to
+     * recv() rather than once per packet.
+     *
      * \param buffs returns a pointer to the buffer data
      * \param metadata returns the metadata corresponding to the buffer
      * \param timeout_ms timeout in milliseconds
@@ -195,8 +384,11 @@ public:
                         break;
 
                     case get_aligned_buffs_t::SEQUENCE_ERROR:
-                        std::tie(metadata.has_time_spec, metadata.time_spec) =
-                            _last_read_time_info.get_next_packet_time(_samp_rate);
+                        if (_stats.enabled()) {
+                            _stats.add_seq_error();
+                        }
+                        _last_read_time_info.get_next_packet_time(
+                            metadata, _samps_to_ticks);
                         metadata.out_of_sequence = true;
                         metadata.error_code      = rx_metadata_t::ERROR_CODE_OVERFLOW;
                         break;
@@ -208,6 +400,13 @@ public:
 
         metadata.reset();
 
+        if (_num_pending_changes.load(std::memory_order_acquire) != 0) {
+            _take_channel_changes();
+        }
+        if (!_all_active) {
+            _drain_inactive();
+        }
+
         // Try to get buffs with a 0 timeout first. This avoids needing to check
         // if radios are stopped due to overrun when packets are available.
         auto result = _get_aligned_buffs(0);
@@ -217,67 +416,143 @@ public:
                 // An overrun occurred and the user has read all the packets
                 // that were buffered prior to the overrun. Call the overrun
                 // handler and return overrun error.
-                _handle_overrun();
-                std::tie(metadata.has_time_spec, metadata.time_spec) =
-                    _last_read_time_info.get_next_packet_time(_samp_rate);
-                metadata.error_code     = rx_metadata_t::ERROR_CODE_OVERFLOW;
-                _stopped_due_to_overrun = false;
+                _report_overrun(metadata);
                 return 0;
             } else {
                 // Packets were not available with zero timeout, wait for them
                 // to arrive using the specified timeout.
-                result = _get_aligned_buffs(timeout_ms);
+                if (_stats.enabled()) {
+                    const auto start = streamer_stats::clock::now();
+                    result           = _get_aligned_buffs(timeout_ms);
+                    _stats.add_stall(streamer_stats::clock::now() - start);
+                } else {
+                    result = _get_aligned_buffs(timeout_ms);
+                }
                 if (_stopped_due_to_late_cmd) {
                     metadata.has_time_spec   = false;
                     metadata.error_code      = rx_metadata_t::ERROR_CODE_LATE_COMMAND;
                     _stopped_due_to_late_cmd = false;
                     return 0;
                 }
+                // The overrun may also have been flagged while waiting, e.g. by
+                // a transport that finds the overrun in the stream of packets
+                if (result == get_aligned_buffs_t::TIMEOUT && _stopped_due_to_overrun) {
+                    _report_overrun(metadata);
+                    return 0;
+                }
             }
         }
 
+        if (result == get_aligned_buffs_t::SUCCESS && !_scheduled_changes.empty()) {
+            result = _apply_due_changes(timeout_ms);
+        }
+
         if (result != get_aligned_buffs_t::SUCCESS) {
+            _has_next_tsf = false;
             set_metadata_for_error(result, metadata);
             return 0;
         }
 
+        if (_report_gaps && _check_gap(metadata)) {
+            return 0;
+        }
+
+        // The metadata comes from the first active channel
+        const auto& info_ref = _infos[_ref_chan];
+
+        // The aligned packets can hold different numbers of samples if the
+        // packets of the channels are offset in time. Return the samples that
+        // all of them have, release_recv_buff() keeps the rest.
+        size_t payload_bytes = info_ref.payload_bytes;
+        for (size_t i = 0; i < buffs.size(); i++) {
+            if (_active[i]) {
+                payload_bytes = std::min(payload_bytes, _infos[i].payload_bytes);
+            }
+        }
+
+        // Stop at the next change of the active channels, so it applies from
+        // the first sample of the next call
+        if (!_scheduled_changes.empty() && info_ref.has_tsf && _bytes_per_item) {
+            const uint64_t ticks = _scheduled_changes.front().time_ticks - info_ref.tsf;
+            uint64_t num_samps   = 0;
+            _samps_to_ticks.to_samps(ticks, num_samps);
+            if (_samps_to_ticks(num_samps) < ticks) {
+                num_samps++;
+            }
+            payload_bytes = std::min<size_t>(payload_bytes, num_samps * _bytes_per_item);
+        }
+
         // Get payload pointers for each buffer and aggregate eob. We set eob to
         // true if any channel has it set, since no more data will be received for
         // that channel. In most cases, all channels should have the same value.
         // We do the same for eov here, as it is expected that eov will be the
-        // same for all channels.
+        // same for all channels. Both only apply once the end of the packet is
+        // returned. Inactive channels return zeros.
         bool eob = false;
         bool eov = false;
+        if (!_all_active && _zeros.size() < payload_bytes) {
+            _zeros.resize(payload_bytes, 0);
+        }
         for (size_t i = 0; i < buffs.size(); i++) {
-            buffs[i] = _infos[i].payload;
-            eob |= _infos[i].eob;
-            eov |= _infos[i].eov;
+            if (!_active[i]) {
+                buffs[i] = _zeros.data();
+                continue;
+            }
+            buffs[i]           = _infos[i].payload;
+            const bool pkt_end = _infos[i].payload_bytes == payload_bytes;
+            eob |= pkt_end && _infos[i].eob;
+            eov |= pkt_end && _infos[i].eov;
         }
 
-        // Set the metadata from the buffer information at index zero
-        const auto& info_0 = _infos[0];
+        if (_stats.enabled()) {
+            for (size_t i = 0; i < buffs.size(); i++) {
+                if (_active[i]) {
+                    _stats.add_packet(i, payload_bytes);
+                }
+            }
+        }
+        if (_stats.latency_probe_enabled()) {
+            _stats.add_recv_packet(*_frame_buffs[_ref_chan]);
+            if (_all_active) {
+                _stats.add_arrival_skew(_frame_buffs);
+            }
+        }
 
-        metadata.has_time_spec  = info_0.has_tsf;
-        metadata.time_spec      = time_spec_t::from_ticks(info_0.tsf, _tick_rate);
+        metadata.has_time_spec  = info_ref.has_tsf;
+        metadata.has_time_ticks = info_ref.has_tsf;
+        metadata.time_ticks     = info_ref.tsf;
         metadata.start_of_burst = false;
         metadata.end_of_burst   = eob;
+        metadata.burst_index    = _num_bursts;
         metadata.error_code     = rx_metadata_t::ERROR_CODE_NONE;
+        if (eob) {
+            _num_bursts++;
+        }
 
         // If the caller wants eov indications via metadata, then check
-        // eov and set the metadata values appropriately. Note that only
-        // channel 0 is checked for eov--in most cases, it should be the
-        // same for all channels.
+        // eov and set the metadata values appropriately. In most cases, eov
+        // should be the same for all channels.
         if (eov_positions.data() && eov) {
             eov_positions.push_back(eov_positions.get_running_sample_count()
-                                    + info_0.payload_bytes / _bytes_per_item);
+                                    + payload_bytes / _bytes_per_item);
+        }
+
+        if (_num_pending_tags.load(std::memory_order_acquire) != 0 && info_ref.has_tsf) {
+            _place_tags(info_ref.tsf, payload_bytes / _bytes_per_item, eov_positions);
         }
 
         // Done with these packets, save timestamp info for next call
         _last_read_time_info.has_time_spec = metadata.has_time_spec;
-        _last_read_time_info.time_spec     = metadata.time_spec;
-        _last_read_time_info.num_samps     = info_0.payload_bytes / _bytes_per_item;
+        _last_read_time_info.time_ticks    = metadata.time_ticks;
+        _last_read_time_info.num_samps     = payload_bytes / _bytes_per_item;
         eov_positions.update_running_sample_count(_last_read_time_info.num_samps);
 
+        if (_report_gaps) {
+            // A new burst can start at any time
+            _has_next_tsf = info_ref.has_tsf && !eob;
+            _next_tsf = info_ref.tsf + _samps_to_ticks(_last_read_time_info.num_samps);
+        }
+
         return _last_read_time_info.num_samps;
     }
 
@@ -288,6 +563,21 @@ public:
      */
     void release_recv_buff(const size_t channel)
     {
+        if (!_active[channel]) {
+            return;
+        }
+
+        // Keep the rest of a packet that holds more samples than the other
+        // channels, for the next call to get_recv_buffs()
+        auto& info                  = _infos[channel];
+        const size_t consumed_bytes = _last_read_time_info.num_samps * _bytes_per_item;
+        if (info.payload_bytes > consumed_bytes) {
+            info.payload = static_cast<const uint8_t*>(info.payload) + consumed_bytes;
+            info.payload_bytes -= consumed_bytes;
+            info.tsf += _samps_to_ticks(_last_read_time_info.num_samps);
+            return;
+        }
+
         _xports[channel]->release_recv_buff(std::move(_frame_buffs[channel]));
         _frame_buffs[channel] = typename transport_t::buff_t::uptr();
     }
@@ -295,6 +585,221 @@ public:
 private:
     using get_aligned_buffs_t = get_aligned_buffs<transport_t, ignore_seq_err>;
 
+    //! A change of the active channels, see set_channel_active()
+    struct channel_change_t
+    {
+        size_t chan;
+        bool active;
+        bool timed;
+        uint64_t time_ticks;
+    };
+
+    // Join time of a channel that doesn't join
+    static constexpr uint64_t NO_JOIN = std::numeric_limits<uint64_t>::max();
+
+    /*!
+     * Checks whether samples are missing before the aligned packets, and sets
+     * the metadata to report an overrun if so. The packets are kept for the
+     * next call.
+     *
+     * \return true if there is a gap
+     */
+    bool _check_gap(rx_metadata_t& metadata)
+    {
+        const auto& info_ref = _infos[_ref_chan];
+        if (!_has_next_tsf || !info_ref.has_tsf || info_ref.tsf <= _next_tsf) {
+            return false;
+        }
+
+        UHD_TRACE(RX_OVERRUN);
+        uint64_t num_lost_samps = 0;
+        _samps_to_ticks.to_samps(info_ref.tsf - _next_tsf, num_lost_samps);
+        metadata.has_time_spec  = true;
+        metadata.has_time_ticks = true;
+        metadata.time_ticks     = _next_tsf;
+        metadata.num_lost_samps = num_lost_samps;
+        metadata.error_code     = rx_metadata_t::ERROR_CODE_OVERFLOW;
+        _has_next_tsf           = false;
+        return true;
+    }
+
+    /*!
+     * Moves the pending tags that took effect before the end of the samples
+     * about to be returned into the tag array of the recv() call. Tags that
+     * don't fit stay pending. Without a tag array, they are dropped.
+     */
+    void _place_tags(const uint64_t tsf,
+        const size_t num_samps,
+        detail::eov_data_wrapper& eov_positions)
+    {
+        const uint64_t end_tsf = tsf + _samps_to_ticks(num_samps);
+        std::lock_guard<std::mutex> l(_tags_mutex);
+        auto it = _pending_tags.begin();
+        for (; it != _pending_tags.end() && it->time_ticks < end_tsf; ++it) {
+            if (!eov_positions.tags()) {
+                continue;
+            }
+            if (eov_positions.tags_remaining() == 0) {
+                break;
+            }
+            uint64_t offset = 0;
+            if (it->time_ticks > tsf) {
+                // The first sample at or after the time of the tag
+                const uint64_t ticks = it->time_ticks - tsf;
+                _samps_to_ticks.to_samps(ticks, offset);
+                if (_samps_to_ticks(offset) < ticks) {
+                    offset++;
+                }
+            }
+            it->offset = eov_positions.get_running_sample_count() + offset;
+            eov_positions.push_back_tag(*it);
+        }
+        _pending_tags.erase(_pending_tags.begin(), it);
+        _num_pending_tags.store(_pending_tags.size(), std::memory_order_release);
+    }
+
+    //! Moves the changes requested by set_channel_active() to this thread
+    void _take_channel_changes()
+    {
+        std::vector<channel_change_t> changes;
+        {
+            std::lock_guard<std::mutex> l(_changes_mutex);
+            changes.swap(_pending_changes);
+            _num_pending_changes.store(0, std::memory_order_release);
+        }
+
+        for (const auto& change : changes) {
+            _scheduled_changes.erase(std::remove_if(_scheduled_changes.begin(),
+                                         _scheduled_changes.end(),
+                                         [&change](const channel_change_t& c) {
+                                             return c.chan == change.chan;
+                                         }),
+                _scheduled_changes.end());
+            _join_ticks[change.chan] = NO_JOIN;
+            if (!change.timed) {
+                _apply_channel_change(change);
+                continue;
+            }
+            // Keep the packet with the first samples of a channel that joins
+            if (change.active && !_active[change.chan]) {
+                _join_ticks[change.chan] = change.time_ticks;
+            }
+            auto it = std::upper_bound(_scheduled_changes.begin(),
+                _scheduled_changes.end(),
+                change,
+                [](const channel_change_t& a, const channel_change_t& b) {
+                    return a.time_ticks < b.time_ticks;
+                });
+            _scheduled_changes.insert(it, change);
+        }
+    }
+
+    /*!
+     * Applies the scheduled changes that are due at the time of the aligned
+     * packets. Channels that join are aligned with the others.
+     */
+    typename get_aligned_buffs_t::alignment_result_t _apply_due_changes(
+        const int32_t timeout_ms)
+    {
+        while (!_scheduled_changes.empty()) {
+            const auto& info_ref = _infos[_ref_chan];
+            const auto& next = _scheduled_changes.front();
+            if (info_ref.has_tsf && next.time_ticks > info_ref.tsf) {
+                break;
+            }
+            const channel_change_t change = next;
+            _scheduled_changes.erase(_scheduled_changes.begin());
+            if (_apply_channel_change(change)) {
+                const auto result = _get_aligned_buffs(timeout_ms);
+                if (result != get_aligned_buffs_t::SUCCESS) {
+                    return result;
+                }
+            }
+        }
+        return get_aligned_buffs_t::SUCCESS;
+    }
+
+    /*!
+     * Activates or deactivates a channel
+     *
+     * \return true if the channel joined, and needs to be aligned
+     */
+    bool _apply_channel_change(const channel_change_t& change)
+    {
+        const size_t chan = change.chan;
+        _join_ticks[chan] = NO_JOIN;
+        if (_active[chan] == change.active) {
+            return false;
+        }
+
+        if (change.active) {
+            _active.set(chan);
+        } else if (_active.count() == 1) {
+            // A timed change can still leave no channel active, if the
+            // channel that replaces this one joins later
+            UHD_LOG_WARNING("STREAMER",
+                "Not deactivating channel " << chan
+                                            << ", it is the last active channel");
+            std::lock_guard<std::mutex> l(_changes_mutex);
+            _requested_active[chan] = true;
+            return false;
+        } else {
+            _active.reset(chan);
+            if (_frame_buffs[chan]) {
+                _xports[chan]->release_recv_buff(std::move(_frame_buffs[chan]));
+                _frame_buffs[chan] = nullptr;
+            }
+        }
+        _ref_chan   = _active.find_first();
+        _all_active = _active.all();
+        return change.active;
+    }
+
+    /*!
+     * Drops the packets of the inactive channels. For a channel that joins at
+     * a given time, the first packet that holds samples at or after that time
+     * is kept for the alignment.
+     */
+    void _drain_inactive()
+    {
+        for (size_t chan = 0; chan < _xports.size(); chan++) {
+            if (_active[chan] || !_xports[chan] || _frame_buffs[chan]) {
+                continue;
+            }
+            auto& frame_buff = _frame_buffs[chan];
+            auto& info       = _infos[chan];
+            while (true) {
+                try {
+                    std::tie(frame_buff, info, std::ignore) =
+                        _xports[chan]->get_recv_buff(0);
+                } catch (const uhd::value_error&) {
+                    break;
+                }
+                if (!frame_buff) {
+                    break;
+                }
+                if (_join_ticks[chan] != NO_JOIN && info.has_tsf && _bytes_per_item
+                    && info.tsf + _samps_to_ticks(info.payload_bytes / _bytes_per_item)
+                           > _join_ticks[chan]) {
+                    break;
+                }
+                _xports[chan]->release_recv_buff(std::move(frame_buff));
+                frame_buff = nullptr;
+            }
+        }
+    }
+
+    //! Handles an overrun and sets the metadata to report it
+    void _report_overrun(rx_metadata_t& metadata)
+    {
+        UHD_TRACE(RX_OVERRUN);
+        _has_next_tsf = false;
+        _handle_overrun();
+        _last_read_time_info.get_next_packet_time(metadata, _samps_to_ticks);
+        metadata.error_code     = rx_metadata_t::ERROR_CODE_OVERFLOW;
+        _stopped_due_to_overrun = false;
+    }
+
     void _handle_overrun()
     {
         // Flush any remaining packets. This method is called after any channel
@@ -327,17 +832,19 @@ private:
     // used to create the metadata when there is a sequence error.
     struct last_read_time_info_t
     {
-        size_t num_samps   = 0;
-        bool has_time_spec = false;
-        time_spec_t time_spec;
+        size_t num_samps    = 0;
+        bool has_time_spec  = false;
+        uint64_t time_ticks = 0;
 
-        std::tuple<bool, time_spec_t> get_next_packet_time(double samp_rate)
+        //! Writes the time of the packet after the last one into the metadata
+        void get_next_packet_time(
+            rx_metadata_t& metadata, const samps_to_ticks& to_ticks) const
         {
+            metadata.has_time_spec  = has_time_spec;
+            metadata.has_time_ticks = has_time_spec;
+            metadata.time_ticks     = 0;
             if (has_time_spec) {
-                return std::make_tuple(
-                    true, time_spec + time_spec_t::from_ticks(num_samps, samp_rate));
-            } else {
-                return std::make_tuple(false, time_spec_t());
+                metadata.time_ticks = time_ticks + to_ticks(num_samps);
             }
         }
     };
@@ -352,11 +859,24 @@ private:
     // Packet info corresponding to the packets in flight
     std::vector<typename transport_t::packet_info_t> _infos;
 
-    // Rate used in conversion of timestamp to time_spec_t
-    double _tick_rate = 1.0;
+    // Channels that recv() returns the samples of. The first one provides the
+    // metadata.
+    boost::dynamic_bitset<> _active;
+    size_t _ref_chan = 0;
+    bool _all_active = true;
 
-    // Rate used in conversion of timestamp to time_spec_t
-    double _samp_rate = 1.0;
+    // Time from which an inactive channel joins, or NO_JOIN
+    std::vector<uint64_t> _join_ticks;
+
+    // Changes of the active channels that take effect at a time, in order of
+    // time
+    std::vector<channel_change_t> _scheduled_changes;
+
+    // Samples that recv() returns for the inactive channels
+    std::vector<uint8_t> _zeros;
+
+    // Conversion of sample counts to timestamps
+    samps_to_ticks _samps_to_ticks;
 
     // Size of a sample on the device
     size_t _bytes_per_item = 0;
@@ -367,6 +887,9 @@ private:
     // Information about the last data packet processed
     last_read_time_info_t _last_read_time_info;
 
+    // Statistics counters
+    streamer_stats _stats;
+
     // Total number of samples read, used in determining EOV positions
     size_t _total_num_samps = 0;
 
@@ -380,6 +903,30 @@ private:
 
     // Callback for overrun
     overrun_handler_t _overrun_handler;
+
+    // Whether to report gaps in the timestamps within a burst, and the
+    // timestamp that the next packet of the burst should have
+    bool _report_gaps  = false;
+    bool _has_next_tsf = false;
+    uint64_t _next_tsf = 0;
+
+    // Number of bursts received, for rx_metadata_t::burst_index
+    size_t _num_bursts = 0;
+
+    // Tags that recv() hasn't returned yet, in order of time. The count lets
+    // recv() skip the lock while there are none.
+    static constexpr size_t MAX_PENDING_TAGS = 1024;
+    std::mutex _tags_mutex;
+    std::vector<uhd::rx_tag_t> _pending_tags;
+    std::atomic<size_t> _num_pending_tags{0};
+
+    // Changes that recv() hasn't picked up yet, and the state of the channels
+    // that results from all the changes. The count lets recv() skip the lock
+    // while there are none.
+    mutable std::mutex _changes_mutex;
+    std::vector<channel_change_t> _pending_changes;
+    std::atomic<size_t> _num_pending_changes{0};
+    std::vector<bool> _requested_active;
 };
 
 }} // namespace uhd::transport
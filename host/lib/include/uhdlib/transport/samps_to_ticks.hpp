@@ -0,0 +1,85 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <cmath>
+#include <cstdint>
+
+namespace uhd { namespace transport {
+
+/*!
+ * Converts sample counts into ticks of the device clock
+ *
+ * Streamers use this to compute packet timestamps as an offset in ticks from
+ * the timestamp of the first packet, instead of adding up time_spec_t values
+ * packet by packet. The result of each conversion is exact when the tick rate
+ * is a multiple of the sample rate, which is the common case, and is rounded
+ * to the nearest tick otherwise. Either way, the error does not accumulate
+ * over the packets of a burst.
+ */
+class samps_to_ticks
+{
+public:
+    //! Configures the rate of the device clock
+    void set_tick_rate(const double rate)
+    {
+        _tick_rate = rate;
+        _update();
+    }
+
+    //! Configures the rate of the samples
+    void set_samp_rate(const double rate)
+    {
+        _samp_rate = rate;
+        _update();
+    }
+
+    //! Returns the number of ticks that \p num_samps samples span
+    UHD_FORCE_INLINE uint64_t operator()(const uint64_t num_samps) const
+    {
+        if (_ticks_per_samp_int) {
+            return num_samps * _ticks_per_samp_int;
+        }
+        return static_cast<uint64_t>(std::llround(num_samps * _ticks_per_samp));
+    }
+
+    /*!
+     * Converts ticks back into a number of samples
+     *
+     * \param ticks the number of ticks
+     * \param num_samps returns the number of samples that span \p ticks
+     * \return false if \p ticks isn't the span of a whole number of samples
+     */
+    UHD_FORCE_INLINE bool to_samps(const uint64_t ticks, uint64_t& num_samps) const
+    {
+        if (_ticks_per_samp_int) {
+            num_samps = ticks / _ticks_per_samp_int;
+            return ticks % _ticks_per_samp_int == 0;
+        }
+        num_samps = static_cast<uint64_t>(std::llround(ticks / _ticks_per_samp));
+        return (*this)(num_samps) == ticks;
+    }
+
+private:
+    void _update()
+    {
+        _ticks_per_samp = _tick_rate / _samp_rate;
+        const double rounded = std::round(_ticks_per_samp);
+        _ticks_per_samp_int =
+            (rounded >= 1.0 && rounded == _ticks_per_samp) ? uint64_t(rounded) : 0;
+    }
+
+    double _tick_rate = 1.0;
+    double _samp_rate = 1.0;
+
+    // Ratio of the rates, and the same as an integer if it is one (else 0)
+    double _ticks_per_samp       = 1.0;
+    uint64_t _ticks_per_samp_int = 1;
+};
+
+}} // namespace uhd::transport
@@ -0,0 +1,124 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/transport/buffer_pool.hpp>
+#include <uhd/transport/frame_buff.hpp>
+#include <cassert>
+#include <memory>
+#include <vector>
+
+namespace uhd { namespace transport {
+
+/*!
+ * Pool of receive frames that several links can borrow from
+ *
+ * An I/O service that services several links can hand the same pool to each
+ * of them. A link keeps using its own frames first, and only borrows frames
+ * from the pool when all of its own frames are in use. This way, each link
+ * can be created with the few frames it needs at a steady rate, while a
+ * burst on any one link can still be absorbed by the pool.
+ *
+ * The pool is not thread-safe. All links that share it must only be used
+ * from the thread of the I/O service that owns it.
+ */
+class shared_frame_pool
+{
+public:
+    using sptr = std::shared_ptr<shared_frame_pool>;
+
+    /*!
+     * Make a new pool
+     *
+     * \param num_frames the number of frames in the pool
+     * \param frame_size the size of each frame in bytes
+     */
+    static sptr make(const size_t num_frames, const size_t frame_size)
+    {
+        return sptr(new shared_frame_pool(num_frames, frame_size));
+    }
+
+    //! Get the size of each frame in bytes
+    size_t get_frame_size() const
+    {
+        return _frame_size;
+    }
+
+    //! Get the number of frames in the pool
+    size_t get_num_frames() const
+    {
+        return _buffs.size();
+    }
+
+    //! Get the number of frames that are not borrowed by any link
+    size_t get_num_free() const
+    {
+        return _free_buffs.size();
+    }
+
+    /*!
+     * Borrow a frame from the pool
+     *
+     * \return a free frame, or nullptr if all frames are borrowed
+     */
+    frame_buff* pop()
+    {
+        if (_free_buffs.empty()) {
+            return nullptr;
+        }
+        frame_buff* buff = _free_buffs.back();
+        _free_buffs.pop_back();
+        return buff;
+    }
+
+    /*!
+     * Return a frame to the pool
+     *
+     * \param buff a frame that was borrowed with pop()
+     */
+    void push(frame_buff* buff)
+    {
+        assert(owns(buff));
+        _free_buffs.push_back(buff);
+    }
+
+    //! Returns whether the frame belongs to this pool
+    bool owns(const frame_buff* buff) const
+    {
+        return !_buffs.empty() && buff >= &_buffs.front() && buff <= &_buffs.back();
+    }
+
+private:
+    class pool_frame_buff : public frame_buff
+    {
+    public:
+        pool_frame_buff(void* mem)
+        {
+            _data = mem;
+        }
+    };
+
+    shared_frame_pool(const size_t num_frames, const size_t frame_size)
+        : _frame_size(frame_size), _memory(buffer_pool::make(num_frames, frame_size))
+    {
+        _buffs.reserve(num_frames);
+        _free_buffs.reserve(num_frames);
+        for (size_t i = 0; i < num_frames; i++) {
+            _buffs.emplace_back(_memory->at(i));
+        }
+        for (auto& buff : _buffs) {
+            _free_buffs.push_back(&buff);
+        }
+    }
+
+    const size_t _frame_size;
+    buffer_pool::sptr _memory;
+    std::vector<pool_frame_buff> _buffs;
+    std::vector<frame_buff*> _free_buffs;
+};
+
+}} // namespace uhd::transport
@@ -0,0 +1,357 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhdlib/transport/adapter_info.hpp>
+#include <uhdlib/transport/link_base.hpp>
+#include <uhdlib/transport/links.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace uhd { namespace transport {
+
+/*! Shared memory frame_buff
+ *
+ * The frames live in the rings of the shared memory region, so these
+ * frame_buff objects only point at the frame they were handed out for.
+ */
+class shmem_frame_buff : public frame_buff
+{
+public:
+    void set_data(void* data)
+    {
+        _data = data;
+    }
+
+    //! Position of the frame in its ring, counting from the start of the link
+    uint64_t index = 0;
+};
+
+class shmem_adapter_info : public adapter_info
+{
+public:
+    shmem_adapter_info(const std::string& name) : _name(name) {}
+
+    ~shmem_adapter_info() {}
+
+    std::string to_string()
+    {
+        return std::string("SHMEM:") + _name;
+    }
+
+    bool operator==(const shmem_adapter_info& rhs) const
+    {
+        return (_name == rhs._name);
+    }
+
+private:
+    const std::string _name;
+};
+
+/*! Link object over a region of shared memory
+ *
+ * The region holds two single-producer, single-consumer rings of frames, one
+ * per direction. Frames are filled and read in place, so no data is copied
+ * between the two ends of the link, and no network stack is involved. The two
+ * ends may live in the same process (see make_pair()), e.g. to run a simulated
+ * CHDR endpoint for load testing the streamers, or in different processes
+ * that share the region's file descriptor.
+ *
+ * The region is backed by a memfd, so this link is only available on Linux.
+ * Waiting for frames is done by polling.
+ *
+ * \b Note: This link cannot release frame buffers out of order, which means it
+ *          can't be used with an IO service that does that.
+ */
+class shmem_link : public recv_link_base<shmem_link>, public send_link_base<shmem_link>
+{
+public:
+    using sptr = std::shared_ptr<shmem_link>;
+
+    ~shmem_link();
+
+    /*! Make a new shared memory region, and return the first end of a link
+     *  over it.
+     *
+     * The frame sizes and counts of the region are taken from params, from
+     * the point of view of this end. The other end is made with attach().
+     *
+     * \param name a name for the region, used for the adapter and the memfd
+     * \param params values for frame sizes and num frames
+     * \throws uhd::not_implemented_error on platforms without memfd
+     */
+    static sptr make(const std::string& name, const link_params_t& params);
+
+    /*! Attach to a region made by make(), and return the second end of the
+     *  link over it.
+     *
+     * Frames sent on one end are received on the other. The frame sizes and
+     * counts are those of the region.
+     *
+     * \param name a name for the region, used for the adapter
+     * \param fd the file descriptor of the region (see get_fd()). The link
+     *           uses a duplicate, so the caller keeps ownership of fd.
+     * \throws uhd::value_error if fd is not a shared memory link region
+     */
+    static sptr attach(const std::string& name, const int fd);
+
+    /*! Make both ends of a link over a new shared memory region
+     *
+     * \param name a name for the region, used for the adapter and the memfd
+     * \param params values for frame sizes and num frames of the first end
+     * \return the first and second end of the link
+     */
+    static std::pair<sptr, sptr> make_pair(
+        const std::string& name, const link_params_t& params);
+
+    /*! Return the file descriptor of the shared memory region, which can be
+     *  passed to another process so it can attach() to it.
+     */
+    int get_fd() const
+    {
+        return _fd;
+    }
+
+    /*!
+     * Get the physical adapter ID used for this link
+     */
+    adapter_id_t get_send_adapter_id() const
+    {
+        return _adapter_id;
+    }
+
+    /*!
+     * Get the physical adapter ID used for this link
+     */
+    adapter_id_t get_recv_adapter_id() const
+    {
+        return _adapter_id;
+    }
+
+    /*!
+     * Returns whether this link type supports releasing the frame buffers
+     * in an order different from that in which they were acquired.
+     */
+    bool supports_send_buff_out_of_order() const
+    {
+        return false;
+    }
+
+    /*!
+     * Returns whether this link type supports releasing the frame buffers
+     * in an order different from that in which they were acquired.
+     */
+    bool supports_recv_buff_out_of_order() const
+    {
+        return false;
+    }
+
+    /*!
+     * Release a send buffer. Each frame occupies a slot in the ring, so
+     * frames without data are handed to the other end too, which skips them.
+     */
+    void release_send_buff(frame_buff::uptr buff)
+    {
+        if (buff->packet_size() == 0) {
+            _publish_send_frame(static_cast<shmem_frame_buff&>(*buff), 0);
+        }
+        send_link_base_t::release_send_buff(std::move(buff));
+    }
+
+private:
+    using recv_link_base_t = recv_link_base<shmem_link>;
+    using send_link_base_t = send_link_base<shmem_link>;
+
+    // Friend declarations to allow base classes to call private methods
+    friend recv_link_base_t;
+    friend send_link_base_t;
+
+    /*! Control block of one direction of the link, shared by both ends
+     *
+     * The producer and the consumer each only write one of the counters,
+     * which are in separate cache lines.
+     */
+    struct ring_hdr_t
+    {
+        //! Number of frames the producer has handed to the consumer
+        alignas(64) std::atomic<uint64_t> head;
+        //! Number of frames the consumer has released
+        alignas(64) std::atomic<uint64_t> tail;
+        alignas(64) uint64_t num_frames;
+        //! Maximum number of bytes in a frame
+        uint64_t frame_size;
+        //! Number of bytes between the start of two frames
+        uint64_t frame_stride;
+        //! Offset of the frame sizes from the start of the region
+        uint64_t sizes_offset;
+        //! Offset of the first frame from the start of the region
+        uint64_t frames_offset;
+    };
+
+    //! Layout of the start of the shared memory region
+    struct region_hdr_t
+    {
+        uint64_t magic;
+        uint64_t size;
+        //! The ring from the first end to the second, and the one back
+        ring_hdr_t rings[2];
+    };
+
+    //! One end's view of a ring in the shared memory region
+    struct ring_t
+    {
+        ring_hdr_t* hdr       = nullptr;
+        uint32_t* sizes       = nullptr;
+        uint8_t* frames       = nullptr;
+        uint64_t num_frames   = 0;
+        uint64_t frame_stride = 0;
+
+        void* frame(const uint64_t index) const
+        {
+            return frames + (index % num_frames) * frame_stride;
+        }
+    };
+
+    /*!
+     * \param name a name for the region, used for the adapter
+     * \param fd the file descriptor of the region, owned by the link
+     * \param region the region, mapped by _map_region()
+     * \param side 0 for the first end of the link, 1 for the second
+     */
+    shmem_link(
+        const std::string& name, const int fd, region_hdr_t* region, const size_t side);
+
+    //! Map the region behind fd, and check that it holds a link
+    static region_hdr_t* _map_region(const int fd);
+
+    //! Get one end's view of a ring in a mapped region
+    static ring_t _get_ring(region_hdr_t* region, const size_t ring_idx);
+
+    /*! Wait for a condition until the timeout expires
+     *
+     * \param cond the condition to wait for
+     * \param timeout_ms the timeout in ms. 0 does not wait, and a negative
+     *                   value waits forever.
+     * \return whether the condition is true
+     */
+    template <typename cond_t>
+    static bool _wait_for(cond_t cond, const int32_t timeout_ms)
+    {
+        if (cond()) {
+            return true;
+        }
+        if (timeout_ms == 0) {
+            return false;
+        }
+        const auto timeout_point =
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        while (!cond()) {
+            if (timeout_ms > 0 && std::chrono::steady_clock::now() >= timeout_point) {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    UHD_FORCE_INLINE void _publish_send_frame(shmem_frame_buff& buff, const size_t len)
+    {
+        _send_ring.sizes[buff.index % _send_ring.num_frames] = uint32_t(len);
+        _send_ring.hdr->head.store(buff.index + 1, std::memory_order_release);
+    }
+
+    // Methods called by recv_link_base
+    UHD_FORCE_INLINE size_t get_recv_buff_derived(frame_buff& buff, int32_t timeout_ms)
+    {
+        while (true) {
+            const bool ready = _wait_for(
+                [this]() {
+                    return _recv_ring.hdr->head.load(std::memory_order_acquire)
+                           != _recv_next;
+                },
+                timeout_ms);
+            if (!ready) {
+                return 0;
+            }
+
+            const uint64_t index = _recv_next++;
+            const size_t len     = _recv_ring.sizes[index % _recv_ring.num_frames];
+            if (len == 0) {
+                // Skip frames without data. If no earlier frames are still
+                // held, the slot can be freed right away, otherwise it is freed
+                // along with the next frame.
+                if (_recv_released == index) {
+                    _recv_released = index + 1;
+                    _recv_ring.hdr->tail.store(_recv_released, std::memory_order_release);
+                }
+                continue;
+            }
+
+            auto& shmem_buff = static_cast<shmem_frame_buff&>(buff);
+            shmem_buff.set_data(_recv_ring.frame(index));
+            shmem_buff.index = index;
+            return len;
+        }
+    }
+
+    UHD_FORCE_INLINE void release_recv_buff_derived(frame_buff& buff)
+    {
+        // Frames are released in order, so this frees all earlier slots, too
+        _recv_released = static_cast<shmem_frame_buff&>(buff).index + 1;
+        _recv_ring.hdr->tail.store(_recv_released, std::memory_order_release);
+    }
+
+    // Methods called by send_link_base
+    UHD_FORCE_INLINE bool get_send_buff_derived(frame_buff& buff, int32_t timeout_ms)
+    {
+        const bool ready = _wait_for(
+            [this]() {
+                return _send_next - _send_ring.hdr->tail.load(std::memory_order_acquire)
+                       < _send_ring.num_frames;
+            },
+            timeout_ms);
+        if (!ready) {
+            return false;
+        }
+
+        auto& shmem_buff = static_cast<shmem_frame_buff&>(buff);
+        shmem_buff.set_data(_send_ring.frame(_send_next));
+        shmem_buff.index = _send_next++;
+        return true;
+    }
+
+    UHD_FORCE_INLINE void release_send_buff_derived(frame_buff& buff)
+    {
+        _publish_send_frame(static_cast<shmem_frame_buff&>(buff), buff.packet_size());
+    }
+
+    //! File descriptor and mapping of the shared memory region
+    int _fd;
+    region_hdr_t* _region;
+
+    ring_t _recv_ring;
+    ring_t _send_ring;
+    //! Index of the next frame to hand out on the recv ring
+    uint64_t _recv_next = 0;
+    //! Number of frames released on the recv ring
+    uint64_t _recv_released = 0;
+    //! Index of the next frame to hand out on the send ring
+    uint64_t _send_next = 0;
+
+    std::vector<shmem_frame_buff> _recv_buffs;
+    std::vector<shmem_frame_buff> _send_buffs;
+
+    adapter_id_t _adapter_id;
+};
+
+}} // namespace uhd::transport
@@ -0,0 +1,274 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/transport/frame_buff.hpp>
+#include <uhdlib/transport/latency_probe.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+namespace uhd { namespace transport {
+
+/*!
+ * Statistics counters for the hot path of a streamer
+ *
+ * Counters are only written by the thread that is streaming, so they are
+ * updated with relaxed loads and stores instead of read-modify-write
+ * operations. Other threads may read them at any time with get(), and toggle
+ * collection with set_enabled().
+ *
+ * The latency probe is toggled separately, with set_latency_probe_enabled().
+ */
+class streamer_stats
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    //! Stages measured by the latency probe, see uhd::streamer_stats_t::latency
+    enum latency_stage_t {
+        LINK_TO_STREAMER,
+        LINK_TO_RECV_RETURN,
+        SEND_TO_RELEASE,
+        SEND_TO_LINK,
+        NUM_LATENCY_STAGES
+    };
+
+    streamer_stats(const size_t num_chans)
+        : _num_chans(num_chans), _chans(new chan_counters[num_chans])
+    {
+    }
+
+    ~streamer_stats()
+    {
+        set_latency_probe_enabled(false);
+    }
+
+    //! Enables or disables collecting statistics
+    void set_enabled(const bool enable)
+    {
+        _enabled.store(enable, std::memory_order_relaxed);
+    }
+
+    //! Returns whether statistics are being collected
+    UHD_FORCE_INLINE bool enabled() const
+    {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    //! Counts a packet received or sent on a channel
+    UHD_FORCE_INLINE void add_packet(const size_t chan, const size_t payload_bytes)
+    {
+        _add(_chans[chan].packets, 1);
+        _add(_chans[chan].bytes, payload_bytes);
+    }
+
+    //! Counts a sequence error
+    UHD_FORCE_INLINE void add_seq_error()
+    {
+        _add(_seq_errors, 1);
+    }
+
+    //! Counts a wait for frame buffers that took the given time
+    UHD_FORCE_INLINE void add_stall(const clock::duration wait_time)
+    {
+        const uint64_t wait_ns = _to_ns(wait_time);
+        _add(_stalls, 1);
+        _add(_wait_time_ns, wait_ns);
+
+        size_t bucket = 0;
+        for (uint64_t wait_us = wait_ns / 1000; wait_us != 0; wait_us >>= 1) {
+            bucket++;
+        }
+        _add(_wait_time_hist[std::min(bucket, NUM_BUCKETS - 1)], 1);
+    }
+
+    //! Counts a TX burst that was dropped because it was late
+    UHD_FORCE_INLINE void add_late_burst()
+    {
+        _add(_late_bursts, 1);
+    }
+
+    //! Adds time spent converting samples
+    UHD_FORCE_INLINE void add_convert_time(const clock::duration convert_time)
+    {
+        _add(_convert_time_ns, _to_ns(convert_time));
+    }
+
+    //! Enables or disables the latency probe
+    void set_latency_probe_enabled(const bool enable)
+    {
+        if (_latency_enabled.exchange(enable) != enable) {
+            if (enable) {
+                latency_probe::add_user();
+            } else {
+                latency_probe::remove_user();
+            }
+        }
+    }
+
+    //! Returns whether the latency probe is enabled
+    UHD_FORCE_INLINE bool latency_probe_enabled() const
+    {
+        return _latency_enabled.load(std::memory_order_relaxed);
+    }
+
+    /*!
+     * Records that the streamer picked up a received packet. Call this only
+     * while the latency probe is enabled.
+     */
+    UHD_FORCE_INLINE void add_recv_packet(const frame_buff& buff)
+    {
+        const uint64_t link_time = buff.get_timestamp();
+        if (link_time == 0) {
+            return;
+        }
+        _latency[LINK_TO_STREAMER].add(latency_probe::now() - link_time);
+        if (_recv_link_time == 0) {
+            _recv_link_time = link_time;
+        }
+    }
+
+    /*!
+     * Records the arrival skew of a set of aligned packets, one per channel.
+     * Call this only while the latency probe is enabled.
+     */
+    template <typename buffs_t>
+    UHD_FORCE_INLINE void add_arrival_skew(const buffs_t& buffs)
+    {
+        if (_num_chans < 2) {
+            return;
+        }
+        uint64_t first_time = buffs[0]->get_timestamp();
+        for (size_t i = 1; i < _num_chans; i++) {
+            first_time = std::min(first_time, buffs[i]->get_timestamp());
+        }
+        if (first_time == 0) {
+            return;
+        }
+        for (size_t i = 0; i < _num_chans; i++) {
+            const uint64_t skew_ns = buffs[i]->get_timestamp() - first_time;
+            chan_counters& chan    = _chans[i];
+            _add(chan.skew_count, 1);
+            _add(chan.skew_total_ns, skew_ns);
+            if (skew_ns > chan.skew_max_ns.load(std::memory_order_relaxed)) {
+                chan.skew_max_ns.store(skew_ns, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /*!
+     * Records that recv() returns. This may be called whether or not the
+     * latency probe is enabled.
+     */
+    UHD_FORCE_INLINE void end_recv()
+    {
+        if (_recv_link_time != 0) {
+            _latency[LINK_TO_RECV_RETURN].add(latency_probe::now() - _recv_link_time);
+            _recv_link_time = 0;
+        }
+    }
+
+    //! Records that send() was entered
+    UHD_FORCE_INLINE void begin_send()
+    {
+        _send_time = latency_probe_enabled() ? latency_probe::now() : 0;
+    }
+
+    /*!
+     * Records that the streamer hands a packet to the transport, and marks the
+     * frame buffer so the link records when it transmits it
+     */
+    UHD_FORCE_INLINE void add_send_packet(frame_buff& buff)
+    {
+        if (_send_time != 0) {
+            _latency[SEND_TO_RELEASE].add(latency_probe::now() - _send_time);
+            buff.set_timestamp(_send_time);
+            buff.set_latency_hist(&_latency[SEND_TO_LINK]);
+        }
+    }
+
+    //! Returns the current value of all counters
+    uhd::streamer_stats_t get() const
+    {
+        uhd::streamer_stats_t stats;
+        stats.enabled = enabled();
+        for (size_t i = 0; i < _num_chans; i++) {
+            const chan_counters& counters = _chans[i];
+            uhd::streamer_stats_t::chan_stats_t chan;
+            chan.packets       = counters.packets.load(std::memory_order_relaxed);
+            chan.bytes         = counters.bytes.load(std::memory_order_relaxed);
+            chan.skew_count    = counters.skew_count.load(std::memory_order_relaxed);
+            chan.skew_total_ns = counters.skew_total_ns.load(std::memory_order_relaxed);
+            chan.skew_max_ns   = counters.skew_max_ns.load(std::memory_order_relaxed);
+            stats.chans.push_back(chan);
+        }
+        stats.seq_errors      = _seq_errors.load(std::memory_order_relaxed);
+        stats.stalls          = _stalls.load(std::memory_order_relaxed);
+        stats.wait_time_ns    = _wait_time_ns.load(std::memory_order_relaxed);
+        stats.convert_time_ns = _convert_time_ns.load(std::memory_order_relaxed);
+        stats.late_bursts     = _late_bursts.load(std::memory_order_relaxed);
+        for (const auto& bucket : _wait_time_hist) {
+            stats.wait_time_hist.push_back(bucket.load(std::memory_order_relaxed));
+        }
+        static const char* const latency_stage_names[NUM_LATENCY_STAGES] = {
+            "link_to_streamer", "link_to_recv_return", "send_to_release", "send_to_link"};
+        for (size_t i = 0; i < NUM_LATENCY_STAGES; i++) {
+            if (_latency[i].get_count() != 0) {
+                stats.latency[latency_stage_names[i]] = _latency[i].get();
+            }
+        }
+        return stats;
+    }
+
+private:
+    static constexpr size_t NUM_BUCKETS = uhd::streamer_stats_t::NUM_WAIT_TIME_BUCKETS;
+
+    struct chan_counters
+    {
+        std::atomic<uint64_t> packets{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> skew_count{0};
+        std::atomic<uint64_t> skew_total_ns{0};
+        std::atomic<uint64_t> skew_max_ns{0};
+    };
+
+    static UHD_FORCE_INLINE void _add(std::atomic<uint64_t>& counter, const uint64_t n)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + n,
+            std::memory_order_relaxed);
+    }
+
+    static UHD_FORCE_INLINE uint64_t _to_ns(const clock::duration duration)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    }
+
+    std::atomic<bool> _enabled{false};
+
+    const size_t _num_chans;
+    std::unique_ptr<chan_counters[]> _chans;
+
+    std::atomic<uint64_t> _seq_errors{0};
+    std::atomic<uint64_t> _stalls{0};
+    std::atomic<uint64_t> _wait_time_ns{0};
+    std::atomic<uint64_t> _convert_time_ns{0};
+    std::atomic<uint64_t> _late_bursts{0};
+    std::atomic<uint64_t> _wait_time_hist[NUM_BUCKETS] = {};
+
+    std::atomic<bool> _latency_enabled{false};
+    latency_hist _latency[NUM_LATENCY_STAGES];
+    // Link timestamp of the first packet used by the current call to recv()
+    uint64_t _recv_link_time = 0;
+    // Time at which the current call to send() was entered
+    uint64_t _send_time = 0;
+};
+
+}} // namespace uhd::transport
@@ -0,0 +1,288 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/exception.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace uhd { namespace transport {
+
+/*!
+ * Receive transport for a stream whose packets are striped round-robin across
+ * several links, e.g. to receive a wideband channel over both 10GbE ports of a
+ * device.
+ *
+ * Each link has its own transport (a lane), which handles the flow control of
+ * that link. This class merges the packets of the lanes back into a single
+ * stream in sequence number order, so it can be connected to a streamer in
+ * place of a single transport. Packet n of the stream is expected on lane
+ * n % num_lanes. A packet that is lost on one lane does not stall the others:
+ * the packets that follow it are still delivered in order, and the loss is
+ * reported as a sequence error.
+ *
+ * The lane transport must provide the sequence number of each packet in its
+ * packet_info_t (see chdr_rx_data_xport).
+ */
+template <typename transport_t>
+class striped_rx_xport
+{
+public:
+    using uptr          = std::unique_ptr<striped_rx_xport>;
+    using buff_t        = typename transport_t::buff_t;
+    using packet_info_t = typename transport_t::packet_info_t;
+
+    /*!
+     * \param lanes the transports of the links, in the order in which the
+     *              device stripes packets across them
+     * \throws uhd::value_error if no lanes are given
+     */
+    striped_rx_xport(std::vector<typename transport_t::uptr> lanes)
+        : _lanes(std::move(lanes)), _pending(_lanes.size())
+    {
+        if (_lanes.empty()) {
+            throw uhd::value_error("A striped transport needs at least one lane");
+        }
+    }
+
+    //! Returns the largest payload of a packet that fits on all lanes
+    size_t get_max_payload_size() const
+    {
+        size_t max_payload_size = _lanes[0]->get_max_payload_size();
+        for (const auto& lane : _lanes) {
+            max_payload_size = std::min(max_payload_size, lane->get_max_payload_size());
+        }
+        return max_payload_size;
+    }
+
+    //! Returns the number of lanes
+    size_t get_num_lanes() const
+    {
+        return _lanes.size();
+    }
+
+    /*!
+     * Gets the next RX frame buffer of the stream
+     *
+     * Only one buffer may be held at a time, which is how the streamers use
+     * their transports.
+     *
+     * \param timeout_ms timeout in milliseconds
+     * \return returns a tuple containing:
+     * - a frame_buff, or null if timeout occurs
+     * - info struct corresponding to the packet
+     * - whether packets were lost or out of sequence before this one
+     */
+    UHD_FORCE_INLINE std::tuple<typename buff_t::uptr, packet_info_t, bool>
+    get_recv_buff(const int32_t timeout_ms)
+    {
+        size_t num_checked = 0;
+        while (true) {
+            pending_t& pending = _pending[_next_lane];
+            if (!pending.buff) {
+                std::tie(pending.buff, pending.info, std::ignore) =
+                    _lanes[_next_lane]->get_recv_buff(timeout_ms);
+                if (!pending.buff) {
+                    return std::make_tuple(
+                        typename buff_t::uptr(), packet_info_t(), false);
+                }
+            }
+
+            // The lanes see every num_lanes'th packet, so their own sequence
+            // checks don't apply. A packet ahead of the expected one means
+            // the expected packet was lost on this lane, and the next one is
+            // due on the next lane.
+            const int16_t seq_diff = int16_t(pending.info.seq_num - _seq_num);
+            if (seq_diff > 0) {
+                _seq_error = true;
+                if (++num_checked < _lanes.size()) {
+                    _seq_num++;
+                    _next_lane = (_next_lane + 1) % _lanes.size();
+                    continue;
+                }
+                // All lanes are ahead, so the stream is out of sync. Resume
+                // from the oldest packet.
+                _next_lane = _get_oldest_pending_lane();
+            }
+
+            return _pop_pending(_next_lane, seq_diff != 0);
+        }
+    }
+
+    /*!
+     * Releases an RX frame buffer
+     *
+     * \param buff the frame buffer to release
+     */
+    UHD_FORCE_INLINE void release_recv_buff(typename buff_t::uptr buff)
+    {
+        _lanes[_held_lane]->release_recv_buff(std::move(buff));
+    }
+
+private:
+    //! A packet that was received ahead of its turn
+    struct pending_t
+    {
+        typename buff_t::uptr buff;
+        packet_info_t info;
+    };
+
+    //! Returns the pending packet of a lane, and moves on to the next lane
+    UHD_FORCE_INLINE std::tuple<typename buff_t::uptr, packet_info_t, bool>
+    _pop_pending(const size_t lane, const bool seq_error)
+    {
+        pending_t& pending = _pending[lane];
+        const bool error   = _seq_error || seq_error;
+        _seq_error         = false;
+        _seq_num           = pending.info.seq_num + 1;
+        _held_lane         = lane;
+        _next_lane         = (lane + 1) % _lanes.size();
+        return std::make_tuple(std::move(pending.buff), pending.info, error);
+    }
+
+    //! Returns the lane with the oldest pending packet, all lanes must have one
+    size_t _get_oldest_pending_lane() const
+    {
+        size_t oldest = 0;
+        for (size_t lane = 1; lane < _lanes.size(); lane++) {
+            const uint16_t seq_num = _pending[lane].info.seq_num;
+            if (int16_t(seq_num - _pending[oldest].info.seq_num) < 0) {
+                oldest = lane;
+            }
+        }
+        return oldest;
+    }
+
+    std::vector<typename transport_t::uptr> _lanes;
+    std::vector<pending_t> _pending;
+
+    //! Lane expected to carry the next packet
+    size_t _next_lane = 0;
+    //! Lane of the buffer held by the caller
+    size_t _held_lane = 0;
+    //! Expected sequence number of the next packet
+    uint16_t _seq_num = 0;
+    //! Whether packets were skipped since the last packet was returned
+    bool _seq_error = false;
+};
+
+/*!
+ * Transmit transport that stripes the packets of a stream round-robin across
+ * several links, the counterpart of striped_rx_xport.
+ *
+ * Each lane transport handles the flow control of its link. All lanes share
+ * one sequence, so the device can put the packets back in order. The lane
+ * transport must allow setting the sequence number of the next packet (see
+ * chdr_tx_data_xport).
+ */
+template <typename transport_t>
+class striped_tx_xport
+{
+public:
+    using uptr          = std::unique_ptr<striped_tx_xport>;
+    using buff_t        = typename transport_t::buff_t;
+    using packet_info_t = typename transport_t::packet_info_t;
+
+    /*!
+     * \param lanes the transports of the links, in the order in which to
+     *              stripe packets across them
+     * \throws uhd::value_error if no lanes are given
+     */
+    striped_tx_xport(std::vector<typename transport_t::uptr> lanes)
+        : _lanes(std::move(lanes))
+    {
+        if (_lanes.empty()) {
+            throw uhd::value_error("A striped transport needs at least one lane");
+        }
+    }
+
+    //! Returns the largest payload of a packet that fits on all lanes
+    size_t get_max_payload_size() const
+    {
+        size_t max_payload_size = _lanes[0]->get_max_payload_size();
+        for (const auto& lane : _lanes) {
+            max_payload_size = std::min(max_payload_size, lane->get_max_payload_size());
+        }
+        return max_payload_size;
+    }
+
+    //! Returns the number of lanes
+    size_t get_num_lanes() const
+    {
+        return _lanes.size();
+    }
+
+    //! Returns the lane transports, e.g. to configure their async messages
+    std::vector<typename transport_t::uptr>& get_lanes()
+    {
+        return _lanes;
+    }
+
+    /*!
+     * Gets a TX frame buffer from the lane whose turn it is. Only one buffer
+     * may be held at a time.
+     *
+     * \param timeout_ms timeout in milliseconds
+     * \return the frame buffer, or nullptr if timeout occurs
+     */
+    UHD_FORCE_INLINE typename buff_t::uptr get_send_buff(const int32_t timeout_ms)
+    {
+        return _lanes[_next_lane]->get_send_buff(timeout_ms);
+    }
+
+    /*!
+     * Sends a TX data packet, and moves on to the next lane
+     *
+     * \param buff the frame buffer containing the packet to send
+     */
+    UHD_FORCE_INLINE void release_send_buff(typename buff_t::uptr buff)
+    {
+        _lanes[_next_lane]->release_send_buff(std::move(buff));
+        _next_lane = (_next_lane + 1) % _lanes.size();
+    }
+
+    /*!
+     * Writes header into frame buffer and returns payload pointer
+     *
+     * \param buff Frame buffer to write header into
+     * \param info Information to include in the header
+     * \return A pointer to the payload data area and the packet size in bytes
+     */
+    UHD_FORCE_INLINE std::pair<void*, size_t> write_packet_header(
+        typename buff_t::uptr& buff, const packet_info_t& info)
+    {
+        auto& lane = _lanes[_next_lane];
+        lane->set_next_seq_num(_seq_num++);
+        return lane->write_packet_header(buff, info);
+    }
+
+    /*!
+     * Returns the offset of the payload in a packet
+     *
+     * \param has_tsf Whether the packet includes a timestamp
+     * \return The offset of the payload from the start of the packet in bytes
+     */
+    size_t get_payload_offset(const bool has_tsf) const
+    {
+        return _lanes[0]->get_payload_offset(has_tsf);
+    }
+
+private:
+    std::vector<typename transport_t::uptr> _lanes;
+
+    //! Lane that sends the next packet
+    size_t _next_lane = 0;
+    //! Sequence number of the next packet
+    uint16_t _seq_num = 0;
+};
+
+}} // namespace uhd::transport
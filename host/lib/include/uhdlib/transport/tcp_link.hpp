@@ -0,0 +1,234 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/transport/buffer_pool.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/types/endianness.hpp>
+#include <uhdlib/transport/adapter_info.hpp>
+#include <uhdlib/transport/link_base.hpp>
+#include <uhdlib/transport/links.hpp>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uhd { namespace transport {
+
+/*! TCP link frame_buff
+ *
+ * Receive frames point into the receive ring of the link, send frames into
+ * one of the send slots.
+ */
+class tcp_frame_buff : public frame_buff
+{
+public:
+    void set_data(void* data)
+    {
+        _data = data;
+    }
+
+    //! Marks a send frame that is currently not attached to a send slot
+    static constexpr uint64_t NO_SLOT = ~uint64_t(0);
+
+    /*! For receive frames, the number of the frame in the stream of received
+     *  frames. For send frames, the send slot, or NO_SLOT.
+     */
+    uint64_t index = NO_SLOT;
+};
+
+class tcp_adapter_info : public adapter_info
+{
+public:
+    tcp_adapter_info(const std::string& src_ip) : _src_ip(src_ip) {}
+
+    ~tcp_adapter_info() {}
+
+    std::string to_string()
+    {
+        return std::string("TCP:") + _src_ip;
+    }
+
+    bool operator==(const tcp_adapter_info& rhs) const
+    {
+        return (_src_ip == rhs._src_ip);
+    }
+
+private:
+    const std::string _src_ip;
+};
+
+/*! Link object that carries CHDR packets over a TCP connection
+ *
+ * TCP is a byte stream, so the link finds the packet boundaries from the
+ * length field of the CHDR headers. Received bytes go into a ring buffer
+ * that is mapped twice in a row into the address space, so reads may pull in
+ * as many packets as there is free space at once, and packets that wrap
+ * around the end of the ring are still contiguous in memory. Frames are
+ * handed out as pointers into the ring, and never copied.
+ *
+ * For sends, the link can use MSG_ZEROCOPY, so the kernel transmits straight
+ * from the send frames. A send frame is reused only after the kernel reports
+ * that it's done with it.
+ *
+ * Large socket buffers are requested before connecting, so the TCP window can
+ * cover the bandwidth-delay product of long links.
+ *
+ * This link is only available on Linux.
+ *
+ * \b Note: The receive ring is freed in order, so a frame that is held on to
+ *          holds back the reuse of the ring space behind it.
+ */
+class tcp_link : public recv_link_base<tcp_link>, public send_link_base<tcp_link>
+{
+public:
+    using sptr = std::shared_ptr<tcp_link>;
+
+    ~tcp_link();
+
+    /*!
+     * Make a new TCP link.
+     *
+     * \param addr a string representing the destination address
+     * \param port a string representing the destination port
+     * \param params Values for frame sizes, num frames, and buffer sizes
+     * \param endianness the endianness of the CHDR headers
+     * \param link_args Link arguments. The following keys are used:
+     *        - tcp_zerocopy: Send with MSG_ZEROCOPY. This saves a copy per
+     *          send frame, but only pays off for large frames.
+     */
+    static sptr make(const std::string& addr,
+        const std::string& port,
+        const link_params_t& params,
+        const uhd::endianness_t endianness = uhd::ENDIANNESS_LITTLE,
+        const uhd::device_addr_t& link_args = uhd::device_addr_t());
+
+    /*! Return the local port of the TCP connection. Port is in host byte order.
+     */
+    uint16_t get_local_port() const
+    {
+        return _local_port;
+    }
+
+    /*! Return true if sends use MSG_ZEROCOPY
+     */
+    bool get_zerocopy() const
+    {
+        return _zerocopy;
+    }
+
+    adapter_id_t get_send_adapter_id() const
+    {
+        return _adapter_id;
+    }
+
+    adapter_id_t get_recv_adapter_id() const
+    {
+        return _adapter_id;
+    }
+
+    std::string get_send_ifname() const
+    {
+        return _local_addr;
+    }
+
+    std::string get_recv_ifname() const
+    {
+        return _local_addr;
+    }
+
+private:
+    using recv_link_base_t = recv_link_base<tcp_link>;
+    using send_link_base_t = send_link_base<tcp_link>;
+
+    // Friend declarations to allow base classes to call private methods
+    friend recv_link_base_t;
+    friend send_link_base_t;
+
+    tcp_link(const std::string& addr,
+        const std::string& port,
+        const link_params_t& params,
+        const uhd::endianness_t endianness,
+        const uhd::device_addr_t& link_args);
+
+    // Methods called by recv_link_base
+    size_t get_recv_buff_derived(frame_buff& buff, int32_t timeout_ms);
+    void release_recv_buff_derived(frame_buff& buff);
+
+    // Methods called by send_link_base
+    bool get_send_buff_derived(frame_buff& buff, int32_t timeout_ms);
+    void release_send_buff_derived(frame_buff& buff);
+
+    /*! Return the length of the frame at the parse position, or 0 if its
+     *  header was not received yet
+     */
+    size_t _get_frame_len() const;
+    //! Read as much as fits into the ring. Returns false on timeout.
+    bool _fill_ring(const int32_t timeout_ms);
+    //! Map the receive ring
+    void _map_ring(const size_t size);
+    //! Move sends the kernel is done with back to the free slot list
+    void _reap_zerocopy_completions();
+
+    int _sock_fd = -1;
+    bool _zerocopy;
+    const bool _big_endian;
+    std::string _local_addr;
+    uint16_t _local_port = 0;
+
+    // Receive ring. All positions count bytes from the start of the stream.
+    uint8_t* _ring      = nullptr;
+    size_t _ring_size   = 0;
+    //! Start of the oldest frame that was not released yet
+    uint64_t _read_pos  = 0;
+    //! Start of the next frame to hand out
+    uint64_t _parse_pos = 0;
+    //! End of the received bytes
+    uint64_t _write_pos = 0;
+    /*! End positions of the frames that were handed out, and whether they
+     *  were released, indexed by frame number
+     */
+    std::vector<std::pair<uint64_t, bool>> _recv_frames;
+    uint64_t _next_recv_frame   = 0;
+    uint64_t _oldest_recv_frame = 0;
+
+    //! A send slot the kernel may still read from
+    struct zerocopy_slot_t
+    {
+        size_t slot;
+        //! Number of the first send call for this slot
+        uint64_t first_seq;
+        //! Number of send calls it took to send the frame
+        uint64_t num_seqs;
+        //! Number of send calls that were completed
+        size_t num_done = 0;
+
+        zerocopy_slot_t(
+            const size_t slot_, const uint64_t first_seq_, const uint64_t num_seqs_)
+            : slot(slot_), first_seq(first_seq_), num_seqs(num_seqs_)
+        {
+        }
+    };
+
+    // Send slots
+    buffer_pool::sptr _send_pool;
+    std::vector<size_t> _free_send_slots;
+    //! Outstanding zero-copy sends, in the order they were sent
+    std::deque<zerocopy_slot_t> _zerocopy_slots;
+    //! Number of successful zero-copy send calls
+    uint64_t _zerocopy_seq = 0;
+    //! Number of completed sends the kernel had to copy anyway
+    size_t _num_copied = 0;
+
+    std::vector<tcp_frame_buff> _recv_buffs;
+    std::vector<tcp_frame_buff> _send_buffs;
+
+    adapter_id_t _adapter_id;
+};
+
+}} // namespace uhd::transport
@@ -0,0 +1,242 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/utils/byteswap.hpp>
+#include <uhd/utils/math.hpp>
+#include <uhdlib/transport/host_dsp.hpp>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace uhd { namespace transport {
+
+/*!
+ * Resampling and frequency shift of transmitted samples on the host
+ *
+ * This is a DUC for rates that the radio cannot provide: fc32 samples are
+ * interpolated by an arbitrary ratio with a polyphase filter bank, multiplied
+ * with a numerically controlled oscillator (NCO), and quantized to the sc16
+ * wire format, straight into the frame buffers. The application hands the
+ * samples to send() at the lower rate, which reduces the memory traffic on
+ * its buffers by the interpolation ratio. See polyphase_resampler for the
+ * filter.
+ */
+class tx_host_dsp
+{
+public:
+    using wire_format_t = sc16_wire_format_t;
+
+    tx_host_dsp(const wire_format_t wire) : _wire(wire)
+    {
+        _update();
+    }
+
+    /*!
+     * Configures the rates
+     *
+     * \param input_rate the sample rate of the samples passed to send()
+     * \param output_rate the sample rate of the wire samples
+     */
+    void set_rates(const double input_rate, const double output_rate)
+    {
+        if (input_rate <= 0.0 || output_rate <= 0.0) {
+            throw uhd::value_error("[tx_stream] Host DSP rates must be positive");
+        }
+        if (input_rate / output_rate > double(polyphase_resampler::MAX_DECIM)) {
+            throw uhd::value_error("[tx_stream] Host DSP can't decimate by more than "
+                                   + std::to_string(polyphase_resampler::MAX_DECIM));
+        }
+        _input_rate  = input_rate;
+        _output_rate = output_rate;
+        _update();
+    }
+
+    /*!
+     * Configures the frequency shift of the NCO
+     *
+     * A positive shift moves 0 Hz to +f Hz, i.e. the interpolated samples are
+     * multiplied with exp(+j*2*pi*f*t).
+     */
+    void set_freq_shift(const double freq_shift)
+    {
+        _freq_shift = freq_shift;
+        _update();
+    }
+
+    //! Configures the scaling to the wire samples, e.g. 32767
+    void set_scale_factor(const double scale_factor)
+    {
+        _scale_factor = scale_factor;
+        _update();
+    }
+
+    //! Returns the ratio of the input rate to the output rate
+    double get_ratio() const
+    {
+        return _resampler.get_step();
+    }
+
+    /*!
+     * Returns the number of zeros to append to the input at the end of a
+     * burst, which flush the last input samples out of the filter
+     */
+    size_t get_num_flush_samps() const
+    {
+        return _resampler.get_num_taps() - 1;
+    }
+
+    /*!
+     * Clears the history and the phase of the NCO, as at the start of a burst.
+     * Changing any configuration also does this.
+     */
+    void reset()
+    {
+        _resampler.reset();
+        _nco.reset();
+    }
+
+    //! Returns whether \p num_in more input samples produce an output sample
+    bool can_produce(const size_t num_in) const
+    {
+        return _resampler.can_produce(num_in);
+    }
+
+    /*!
+     * Appends input samples to the history without producing any output, for
+     * input that isn't enough for an output sample, see can_produce()
+     */
+    void append(const std::complex<float>* input, const size_t num_in)
+    {
+        float* out_i;
+        float* out_q;
+        _resampler.append(num_in, out_i, out_q);
+        for (size_t n = 0; n < num_in; n++) {
+            out_i[n] = input[n].real();
+            out_q[n] = input[n].imag();
+        }
+    }
+
+    /*!
+     * Processes input samples into wire samples
+     *
+     * Only about as many input samples are consumed as are needed to produce
+     * \p max_out output samples, so the input can be passed again, after the
+     * consumed samples, to produce more output.
+     *
+     * \param input the input samples
+     * \param num_in the number of input samples
+     * \param output the buffer for the wire samples
+     * \param max_out the size of the output buffer, in samples
+     * \param num_consumed returns the number of input samples consumed
+     * \return the number of wire samples
+     */
+    size_t process(const std::complex<float>* input,
+        const size_t num_in,
+        void* output,
+        const size_t max_out,
+        size_t& num_consumed)
+    {
+        num_consumed = _resampler.get_num_needed(num_in, max_out);
+        append(input, num_consumed);
+
+        // The filter writes to a scratch buffer that stays in cache, which the
+        // NCO and the quantization read from
+        if (_scratch.size() < max_out) {
+            _scratch.resize(max_out);
+        }
+        std::complex<float>* scratch = _scratch.data();
+        const size_t num_out         = _resampler.produce(
+            max_out, [scratch](const size_t n, const std::complex<float>& samp) {
+                scratch[n] = samp;
+            });
+
+        switch (_wire) {
+            case wire_format_t::CHDR:
+                _convert<wire_format_t::CHDR>(output, num_out);
+                break;
+            case wire_format_t::ITEM32_LE:
+                _convert<wire_format_t::ITEM32_LE>(output, num_out);
+                break;
+            case wire_format_t::ITEM32_BE:
+                _convert<wire_format_t::ITEM32_BE>(output, num_out);
+                break;
+        }
+        return num_out;
+    }
+
+private:
+    //! Designs the filter and resets the state
+    void _update()
+    {
+        _resampler.configure(_input_rate / _output_rate, _scale_factor);
+        _nco.set_step(2.0 * uhd::math::PI * _freq_shift / _output_rate);
+    }
+
+    //! Rounds and saturates a scaled sample component to 16 bits
+    UHD_FORCE_INLINE static int16_t _quantize(const float x)
+    {
+        return int16_t(std::lrint(std::min(std::max(x, -32768.0f), 32767.0f)));
+    }
+
+    //! Writes sample \p i of the output
+    template <wire_format_t wire>
+    UHD_FORCE_INLINE static void _store(
+        void* output, const size_t i, const float re, const float im)
+    {
+        const int16_t out_re = _quantize(re);
+        const int16_t out_im = _quantize(im);
+        if (wire == wire_format_t::CHDR) {
+            int16_t* out = reinterpret_cast<int16_t*>(output) + 2 * i;
+            out[0]       = out_re;
+            out[1]       = out_im;
+            return;
+        }
+        const uint32_t item = (uint32_t(uint16_t(out_re)) << 16) | uint16_t(out_im);
+        reinterpret_cast<uint32_t*>(output)[i] =
+            (wire == wire_format_t::ITEM32_LE) ? uhd::htowx(item) : uhd::htonx(item);
+    }
+
+    //! Shifts the filtered samples by the NCO and writes them to \p output
+    template <wire_format_t wire>
+    void _convert(void* output, const size_t num_out)
+    {
+        const std::complex<float>* in = _scratch.data();
+        if (!_nco.enabled()) {
+            for (size_t n = 0; n < num_out; n++) {
+                _store<wire>(output, n, in[n].real(), in[n].imag());
+            }
+            return;
+        }
+        _nco.run(num_out, [=](const size_t n, const std::complex<float>& osc) {
+            _store<wire>(output,
+                n,
+                in[n].real() * osc.real() - in[n].imag() * osc.imag(),
+                in[n].real() * osc.imag() + in[n].imag() * osc.real());
+        });
+    }
+
+    const wire_format_t _wire;
+
+    double _input_rate   = 1.0;
+    double _output_rate  = 1.0;
+    double _freq_shift   = 0.0;
+    double _scale_factor = 32767.0;
+
+    polyphase_resampler _resampler;
+    nco _nco;
+
+    // Output of the filter for one call to process()
+    std::vector<std::complex<float>> _scratch;
+};
+
+}} // namespace uhd::transport
@@ -8,11 +8,23 @@
 
 #include <uhd/config.hpp>
 #include <uhd/convert.hpp>
+#include <uhd/exception.hpp>
 #include <uhd/stream.hpp>
 #include <uhd/types/metadata.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/realtime.hpp>
 #include <uhd/utils/tasks.hpp>
+#include <uhdlib/convert/signal_stats.hpp>
+#include <uhdlib/transport/samps_to_ticks.hpp>
+#include <uhdlib/transport/tx_host_dsp.hpp>
 #include <uhdlib/transport/tx_streamer_zero_copy.hpp>
+#include <uhdlib/utils/trace.hpp>
+#include <boost/optional.hpp>
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include <limits>
+#include <string>
 #include <vector>
 
 namespace uhd { namespace transport {
@@ -42,8 +54,10 @@ public:
         if (_cached_metadata) {
             // Only use cached time_spec if metadata does not have one
             if (!metadata.has_time_spec) {
-                metadata.has_time_spec = _metadata_cache.has_time_spec;
-                metadata.time_spec     = _metadata_cache.time_spec;
+                metadata.has_time_spec  = _metadata_cache.has_time_spec;
+                metadata.time_spec      = _metadata_cache.time_spec;
+                metadata.has_time_ticks = _metadata_cache.has_time_ticks;
+                metadata.time_ticks     = _metadata_cache.time_ticks;
             }
             metadata.start_of_burst = _metadata_cache.start_of_burst;
             metadata.end_of_burst   = _metadata_cache.end_of_burst;
@@ -103,14 +117,41 @@ template <typename transport_t>
 class tx_streamer_impl : public tx_streamer
 {
 public:
-    tx_streamer_impl(const size_t num_chans, const uhd::stream_args_t stream_args)
+    /*!
+     * The stream args host_rate and host_freq_shift enable resampling and
+     * frequency shifting on the host, see tx_host_dsp. host_rate is the sample
+     * rate of the samples passed to send(), and host_freq_shift the frequency
+     * in Hz that the NCO shifts the samples by. This is only supported for the
+     * fc32 cpu_format and the sc16 otw_format. Timestamps apply to the first
+     * sample at the device rate, the filter is flushed at the end of a burst,
+     * and get_send_buffs() takes samples in the wire format at the device rate.
+     *
+     * \param num_chans the number of channels of the streamer
+     * \param stream_args the stream args
+     * \param otw_format_suffix appended to the otw_format to look up the
+     *        converters, e.g. "_item32_le" for devices that send VRT packets
+     * \throws uhd::value_error if the host DSP is requested for formats it
+     *         doesn't support
+     */
+    tx_streamer_impl(const size_t num_chans,
+        const uhd::stream_args_t stream_args,
+        const std::string& otw_format_suffix = "_chdr")
         : _zero_copy_streamer(num_chans)
         , _zero_buffs(num_chans, &_zero)
         , _out_buffs(num_chans)
     {
-        _setup_converters(num_chans, stream_args);
+        _setup_converters(num_chans, stream_args, otw_format_suffix);
+        _setup_host_dsp(num_chans, stream_args, otw_format_suffix);
+        if (stream_args.args.cast<bool>("signal_stats", false)) {
+            set_signal_stats_enabled(true);
+        }
         _zero_copy_streamer.set_bytes_per_item(_convert_info.bytes_per_otw_item);
 
+        _zero_copy_streamer.get_stats().set_enabled(
+            stream_args.args.cast<bool>("enable_stats", false));
+        _zero_copy_streamer.get_stats().set_latency_probe_enabled(
+            stream_args.args.cast<bool>("enable_latency_probe", false));
+
         if (stream_args.args.has_key("spp")) {
             _spp = stream_args.args.cast<size_t>("spp", _spp);
             _mtu = _spp * _convert_info.bytes_per_otw_item;
@@ -137,6 +178,72 @@ public:
         return _spp;
     }
 
+    //! Implementation of tx_streamer API method
+    uhd::streamer_stats_t get_stats() const
+    {
+        return _zero_copy_streamer.get_stats().get();
+    }
+
+    //! Implementation of tx_streamer API method
+    void set_stats_enabled(const bool enable)
+    {
+        _zero_copy_streamer.get_stats().set_enabled(enable);
+    }
+
+    //! Implementation of tx_streamer API method
+    void set_latency_probe_enabled(const bool enable)
+    {
+        _zero_copy_streamer.get_stats().set_latency_probe_enabled(enable);
+    }
+
+    //! Implementation of tx_streamer API method
+    void set_signal_stats_enabled(const bool enable)
+    {
+        if (enable == _signal_stats_enabled) {
+            return;
+        }
+        if (enable && !_host_dsps.empty()) {
+            throw uhd::not_implemented_error(
+                "[tx_stream] Signal statistics are not supported with the host DSP");
+        }
+        std::vector<bound_converter> converters;
+        for (size_t chan = 0; chan < _converters.size(); chan++) {
+            bound_converter conv;
+            if (enable) {
+                try {
+                    conv.converter = convert::make_signal_stats_converter(_convert_id);
+                } catch (const uhd::key_error&) {
+                    throw uhd::not_implemented_error(
+                        "[tx_stream] Signal statistics are not supported for "
+                        + _convert_id.input_format + " -> " + _convert_id.output_format);
+                }
+            } else {
+                conv.converter = convert::get_converter(_convert_id)();
+            }
+            conv.converter->set_scalar(_scale_factors[chan]);
+            conv.kernel = conv.converter->get_kernel();
+            converters.push_back(conv);
+        }
+        _converters           = converters;
+        _signal_stats_enabled = enable;
+    }
+
+    //! Implementation of tx_streamer API method
+    uhd::signal_stats_t get_signal_stats(const size_t chan, const bool reset = true)
+    {
+        if (!_signal_stats_enabled) {
+            throw uhd::not_implemented_error(
+                "[tx_stream] Signal statistics are not enabled");
+        }
+        auto& converter = static_cast<convert::signal_stats_converter&>(
+            *_converters.at(chan).converter);
+        const uhd::signal_stats_t stats = converter.get_signal_stats();
+        if (reset) {
+            converter.reset_signal_stats();
+        }
+        return stats;
+    }
+
     /*! Get width of each over-the-wire item component. For complex items,
      *  returns the width of one component only (real or imaginary).
      */
@@ -150,6 +257,9 @@ public:
         const uhd::tx_metadata_t& metadata_,
         const double timeout)
     {
+        _check_can_send();
+        _zero_copy_streamer.get_stats().begin_send();
+
         uhd::tx_metadata_t metadata(metadata_);
 
         if (nsamps_per_buff == 0 && metadata.start_of_burst) {
@@ -159,10 +269,27 @@ public:
 
         _metadata_cache.check(metadata);
 
+        // Convert the time_spec once, the timestamps of the packets are
+        // offsets in ticks from it
+        if (metadata.has_time_spec && !metadata.has_time_ticks) {
+            metadata.time_ticks =
+                metadata.time_spec.to_ticks(_zero_copy_streamer.get_tick_rate());
+            metadata.has_time_ticks = true;
+        }
+        const uint64_t start_time_ticks = metadata.time_ticks;
+
         const bool eob_on_last_packet = metadata.end_of_burst;
 
         const int32_t timeout_ms = static_cast<int32_t>(timeout * 1000);
 
+        if (!_host_dsps.empty()) {
+            if (metadata.eov_positions) {
+                throw uhd::value_error(
+                    "[tx_stream] EOV positions are not supported with the host DSP");
+            }
+            return _send_host_dsp(buffs, nsamps_per_buff, metadata, timeout_ms);
+        }
+
         detail::tx_eov_data_wrapper eov_positions(metadata);
 
         // If there are EOVs specified in the metadata, it will be necessary
@@ -270,9 +397,8 @@ public:
 
                     // Setup timespec for the next fragment
                     if (metadata.has_time_spec) {
-                        metadata.time_spec =
-                            metadata.time_spec
-                            + time_spec_t::from_ticks(num_samps_sent, _samp_rate);
+                        metadata.time_ticks =
+                            start_time_ticks + _samps_to_ticks(total_nsamps_sent);
                     }
 
                     metadata.start_of_burst = false;
@@ -300,9 +426,8 @@ public:
             // trip around the do/while loop, update the timespec in the
             // metadata for the next fragment (if desired)
             if (nsamps_to_send_remaining > 0 and metadata.has_time_spec) {
-                metadata.time_spec =
-                    metadata.time_spec
-                    + time_spec_t::from_ticks(num_samps_sent, _samp_rate);
+                metadata.time_ticks =
+                    start_time_ticks + _samps_to_ticks(total_nsamps_sent);
             }
 
             last_eov_position = total_nsamps_sent;
@@ -312,7 +437,293 @@ public:
         return total_nsamps_sent;
     }
 
+    //! Implementation of tx_streamer API method
+    size_t send_bursts(
+        const std::vector<uhd::tx_streamer::burst_t>& bursts, const double timeout)
+    {
+        _check_can_send();
+        if (!_host_dsps.empty()) {
+            throw uhd::not_implemented_error(
+                "[tx_stream] send_bursts() is not supported with the host DSP");
+        }
+        for (const auto& burst : bursts) {
+            if (burst.nsamps == 0 || burst.buffs.size() != get_num_channels()) {
+                throw uhd::value_error("[tx_stream] A burst must have one buffer per "
+                                       "channel and at least one sample");
+            }
+        }
+        _zero_copy_streamer.get_stats().begin_send();
+
+        const int32_t timeout_ms = static_cast<int32_t>(timeout * 1000);
+        const double tick_rate   = _zero_copy_streamer.get_tick_rate();
+
+        // The packets of all bursts go out back to back. Only the fields of
+        // the metadata that end up in the packet headers are updated.
+        uhd::tx_metadata_t metadata;
+        metadata.has_time_spec  = true;
+        metadata.has_time_ticks = true;
+
+        for (size_t i = 0; i < bursts.size(); i++) {
+            const uhd::tx_streamer::burst_t& burst = bursts[i];
+            const uhd::tx_streamer::buffs_type buffs(burst.buffs);
+            const uint64_t start_time_ticks = burst.time_spec.to_ticks(tick_rate);
+
+            metadata.start_of_burst = true;
+            size_t nsamps_sent      = 0;
+            while (nsamps_sent < burst.nsamps) {
+                const size_t nsamps   = std::min(_spp, burst.nsamps - nsamps_sent);
+                metadata.time_ticks   = start_time_ticks + _samps_to_ticks(nsamps_sent);
+                metadata.end_of_burst = nsamps_sent + nsamps == burst.nsamps;
+
+                const size_t num_samps_sent = _send_one_packet(
+                    buffs, nsamps_sent, nsamps, metadata, false, timeout_ms);
+                if (num_samps_sent == 0) {
+                    return i;
+                }
+                nsamps_sent += nsamps;
+                metadata.start_of_burst = false;
+            }
+        }
+        return bursts.size();
+    }
+
+    //! Implementation of tx_streamer API method
+    size_t send_segments(const std::vector<uhd::tx_streamer::segments_type>& segments,
+        const uhd::tx_metadata_t& metadata_,
+        const double timeout)
+    {
+        _check_can_send();
+        if (!_host_dsps.empty()) {
+            throw uhd::not_implemented_error(
+                "[tx_stream] send_segments() is not supported with the host DSP");
+        }
+        if (metadata_.eov_positions) {
+            throw uhd::value_error(
+                "[tx_stream] EOV positions are not supported by send_segments()");
+        }
+        if (segments.size() != get_num_channels()) {
+            throw uhd::value_error("[tx_stream] send_segments() needs one list of "
+                                   "segments per channel");
+        }
+        std::vector<size_t> chan_nsamps(segments.size(), 0);
+        for (size_t chan = 0; chan < segments.size(); chan++) {
+            for (const auto& segment : segments[chan]) {
+                chan_nsamps[chan] += segment.nsamps;
+            }
+            if (chan_nsamps[chan] != chan_nsamps.front()) {
+                throw uhd::value_error("[tx_stream] All channels must have the same "
+                                       "number of samples");
+            }
+        }
+        const size_t nsamps_per_buff = chan_nsamps.front();
+        if (nsamps_per_buff == 0) {
+            return send(_zero_buffs, 0, metadata_, timeout);
+        }
+        _zero_copy_streamer.get_stats().begin_send();
+
+        uhd::tx_metadata_t metadata(metadata_);
+        _metadata_cache.check(metadata);
+        if (metadata.has_time_spec && !metadata.has_time_ticks) {
+            metadata.time_ticks =
+                metadata.time_spec.to_ticks(_zero_copy_streamer.get_tick_rate());
+            metadata.has_time_ticks = true;
+        }
+        const uint64_t start_time_ticks = metadata.time_ticks;
+        const bool eob_on_last_packet   = metadata.end_of_burst;
+        const int32_t timeout_ms        = static_cast<int32_t>(timeout * 1000);
+
+        _segment_cursors.assign(segments.size(), segment_cursor());
+        size_t nsamps_sent = 0;
+        while (nsamps_sent < nsamps_per_buff) {
+            const size_t nsamps = std::min(_spp, nsamps_per_buff - nsamps_sent);
+            if (metadata.has_time_spec) {
+                metadata.time_ticks = start_time_ticks + _samps_to_ticks(nsamps_sent);
+            }
+            metadata.end_of_burst =
+                eob_on_last_packet && nsamps_sent + nsamps == nsamps_per_buff;
+            if (_send_one_packet_segments(segments, nsamps, metadata, timeout_ms)
+                == 0) {
+                break;
+            }
+            nsamps_sent += nsamps;
+            metadata.start_of_burst = false;
+        }
+        return nsamps_sent;
+    }
+
+    //! Implementation of tx_streamer API method
+    void start_cyclic(const uhd::tx_streamer::buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        const uhd::tx_metadata_t& metadata)
+    {
+        _check_can_send();
+        if (!_host_dsps.empty()) {
+            throw uhd::not_implemented_error(
+                "[tx_stream] Cyclic transmission is not supported with the host DSP");
+        }
+        if (nsamps_per_buff == 0) {
+            throw uhd::value_error("[tx_stream] The cyclic waveform has no samples");
+        }
+        assert(buffs.size() == get_num_channels());
+
+        // Convert the waveform once, the packets are copied from it
+        _cyclic_payloads.resize(get_num_channels());
+        for (size_t i = 0; i < get_num_channels(); i++) {
+            _cyclic_payloads[i].resize(
+                nsamps_per_buff * _convert_info.bytes_per_otw_item);
+            const bound_converter& conv = _converters[i];
+            conv.kernel(conv.converter.get(),
+                buffs[i],
+                _cyclic_payloads[i].data(),
+                nsamps_per_buff);
+        }
+        _cyclic_nsamps     = nsamps_per_buff;
+        _cyclic_pos        = 0;
+        _cyclic_samps_sent = 0;
+
+        _cyclic_metadata                = uhd::tx_metadata_t();
+        _cyclic_metadata.start_of_burst = true;
+        if (metadata.has_time_spec) {
+            _cyclic_metadata.has_time_spec  = true;
+            _cyclic_metadata.has_time_ticks = true;
+            _cyclic_metadata.time_ticks =
+                metadata.has_time_ticks
+                    ? metadata.time_ticks
+                    : metadata.time_spec.to_ticks(_zero_copy_streamer.get_tick_rate());
+        }
+        _cyclic_start_ticks = _cyclic_metadata.time_ticks;
+
+        _cyclic_task = uhd::task::make([this]() { _send_cyclic_packet(); }, "tx_cyclic");
+    }
+
+    //! Implementation of tx_streamer API method
+    void stop_cyclic(const double timeout)
+    {
+        if (!_cyclic_task) {
+            return;
+        }
+        _cyclic_task.reset();
+
+        // End the burst with a packet of a single zero sample, like send()
+        // does without samples
+        _cyclic_metadata.end_of_burst = true;
+        if (_cyclic_metadata.has_time_spec) {
+            _cyclic_metadata.time_ticks =
+                _cyclic_start_ticks + _samps_to_ticks(_cyclic_samps_sent);
+        }
+        _send_one_packet(_zero_buffs,
+            0,
+            1,
+            _cyclic_metadata,
+            false,
+            static_cast<int32_t>(timeout * 1000));
+        _cyclic_payloads.clear();
+    }
+
+    /*!
+     * Get a frame buffer per channel to write samples into directly.
+     *
+     * This returns pointers to the payloads of the frame buffers, which can
+     * hold up to get_max_num_samps() samples in the over-the-wire format. The
+     * packets are sent by commit_send_buffs(), which writes the packet headers
+     * once the number of samples is known. Flow control is handled the same
+     * way as for send(), so this blocks until the device can accept a packet.
+     *
+     * \param buffs returns one payload pointer per channel
+     * \param metadata the metadata to send with the packets. The time spec
+     *        applies to the first sample in the buffers.
+     * \param timeout the timeout in seconds to wait for the buffers
+     * \return the number of samples each buffer can hold, or 0 on timeout
+     * \throws uhd::runtime_error if buffers from a previous call have not been
+     *         committed
+     */
+    size_t get_send_buffs(std::vector<void*>& buffs,
+        const uhd::tx_metadata_t& metadata,
+        const double timeout)
+    {
+        _check_can_send();
+
+        _zero_copy_metadata = metadata;
+        _metadata_cache.check(_zero_copy_metadata);
+
+        const int32_t timeout_ms = static_cast<int32_t>(timeout * 1000);
+        if (!_zero_copy_streamer.get_frame_buffs(timeout_ms)) {
+            return 0;
+        }
+
+        buffs.resize(get_num_channels());
+        _zero_copy_streamer.get_payload_ptrs(buffs, _zero_copy_metadata.has_time_spec);
+        _zero_copy_buffs_held = true;
+        return _spp;
+    }
+
+    /*!
+     * Send the buffers of the last call to get_send_buffs().
+     *
+     * \param nsamps_per_buff the number of samples written to each buffer
+     * \throws uhd::value_error if the number of samples is 0 or more than the
+     *         buffers can hold
+     * \throws uhd::runtime_error if there are no buffers to commit
+     */
+    void commit_send_buffs(const size_t nsamps_per_buff)
+    {
+        if (!_zero_copy_buffs_held) {
+            throw uhd::runtime_error("[tx_stream] No zero-copy buffers to commit");
+        }
+        if (nsamps_per_buff == 0 || nsamps_per_buff > _spp) {
+            throw uhd::value_error(
+                "[tx_stream] Invalid number of samples in zero-copy buffers");
+        }
+        _zero_copy_streamer.get_stats().begin_send();
+
+        _zero_copy_streamer.write_packet_headers(
+            _out_buffs, nsamps_per_buff, _zero_copy_metadata, false);
+        for (size_t i = 0; i < get_num_channels(); i++) {
+            _zero_copy_streamer.release_send_buff(i);
+        }
+        _zero_copy_buffs_held = false;
+    }
+
 protected:
+    //! Returns the current device time, or nothing if it's not known
+    using time_estimate_fn_t = std::function<boost::optional<uhd::time_spec_t>()>;
+    //! Called with the time of every burst that is dropped because it's late
+    using late_burst_fn_t = std::function<void(const uhd::time_spec_t&)>;
+
+    /*!
+     * Drop bursts that are late before they go out
+     *
+     * The device rejects a burst that starts after its time spec has passed,
+     * and drops its packets until the end of the burst. Dropping them on the
+     * host instead saves the link bandwidth and the flow control credit, so
+     * the streamer catches up sooner. The first packet of each burst is
+     * compared to the estimated device time. If its time spec is more than
+     * \p margin seconds in the past, that packet and the rest of the burst
+     * are counted as sent, but never reach the transport.
+     *
+     * This only applies to send() and send_bursts(). It is ignored with the
+     * host DSP, which needs to see all samples of a burst.
+     *
+     * \param get_time_estimate returns the estimated device time, without
+     *        accessing the device. An empty function disables the check.
+     * \param margin how late a burst may be before it is dropped, in seconds
+     * \param late_burst_cb called for every dropped burst
+     */
+    void set_late_burst_drop(time_estimate_fn_t get_time_estimate,
+        const double margin,
+        late_burst_fn_t late_burst_cb)
+    {
+        if (get_time_estimate && !_host_dsps.empty()) {
+            UHD_LOG_WARNING("STREAMER",
+                "Ignoring the late burst check of the TX streamer, it is not "
+                "supported with the host DSP");
+            return;
+        }
+        _get_time_estimate = std::move(get_time_estimate);
+        _late_margin       = uhd::time_spec_t(margin);
+        _late_burst_cb     = std::move(late_burst_cb);
+    }
+
     //! Returns the tick rate for conversion of timestamp
     double get_tick_rate() const
     {
@@ -330,23 +741,34 @@ protected:
     {
         _mtu = mtu;
         _spp = _mtu / _convert_info.bytes_per_otw_item;
+        // Fault in the gather buffer now, rather than in the first send()
+        if (uhd::get_realtime_config().prefault) {
+            _gather_buff.resize(_spp * _convert_info.bytes_per_cpu_item);
+        }
     }
 
     //! Configures scaling factor for conversion
     void set_scale_factor(const size_t chan, const double scale_factor)
     {
-        _converters[chan]->set_scalar(scale_factor);
+        _converters[chan].converter->set_scalar(scale_factor);
+        _scale_factors[chan] = scale_factor;
+        if (!_host_dsps.empty()) {
+            _host_dsps[chan].set_scale_factor(scale_factor);
+        }
     }
 
     //! Configures sample rate for conversion of timestamp
     void set_samp_rate(const double rate)
     {
         _samp_rate = rate;
+        _samps_to_ticks.set_samp_rate(rate);
+        _update_host_dsp_rates();
     }
 
     //! Configures tick rate for conversion of timestamp
     void set_tick_rate(const double rate)
     {
+        _samps_to_ticks.set_tick_rate(rate);
         _zero_copy_streamer.set_tick_rate(rate);
     }
 
@@ -359,6 +781,42 @@ private:
         size_t otw_item_bit_width;
     };
 
+    //! A converter along with its kernel, see convert::converter::get_kernel()
+    struct bound_converter
+    {
+        uhd::convert::converter::sptr converter;
+        uhd::convert::converter::kernel_type kernel;
+    };
+
+    /*!
+     * Returns true if the packet belongs to a burst that is dropped because
+     * it's late, see set_late_burst_drop()
+     */
+    bool _drop_late_packet(const tx_metadata_t& metadata)
+    {
+        const bool burst_start = !_in_burst || metadata.start_of_burst;
+        _in_burst              = !metadata.end_of_burst;
+        if (burst_start) {
+            _dropping_burst = false;
+            if (metadata.has_time_spec) {
+                const boost::optional<uhd::time_spec_t> now = _get_time_estimate();
+                const uhd::time_spec_t time =
+                    uhd::time_spec_t::from_ticks(metadata.time_ticks, get_tick_rate());
+                if (now && time + _late_margin < *now) {
+                    _dropping_burst = true;
+                    streamer_stats& stats = _zero_copy_streamer.get_stats();
+                    if (stats.enabled()) {
+                        stats.add_late_burst();
+                    }
+                    if (_late_burst_cb) {
+                        _late_burst_cb(time);
+                    }
+                }
+            }
+        }
+        return _dropping_burst;
+    }
+
     //! Convert samples for one channel and sends a packet
     size_t _send_one_packet(const uhd::tx_streamer::buffs_type& buffs,
         const size_t buffer_offset_in_samps,
@@ -369,6 +827,10 @@ private:
     {
         assert(buffs.size() == get_num_channels());
 
+        if (_get_time_estimate && _drop_late_packet(metadata)) {
+            return num_samples;
+        }
+
         if (!_zero_copy_streamer.get_send_buffs(
                 _out_buffs, num_samples, metadata, eov, timeout_ms)) {
             return 0;
@@ -376,18 +838,329 @@ private:
 
         size_t byte_offset = buffer_offset_in_samps * _convert_info.bytes_per_cpu_item;
 
+        streamer_stats& stats    = _zero_copy_streamer.get_stats();
+        const bool collect_stats = stats.enabled();
+        const auto start         = collect_stats ? streamer_stats::clock::now()
+                                         : streamer_stats::clock::time_point();
+        UHD_TRACE(CONVERT_BEGIN, num_samples);
+
         for (size_t i = 0; i < get_num_channels(); i++) {
             const void* input_ptr = static_cast<const uint8_t*>(buffs[i]) + byte_offset;
-            _converters[i]->conv(input_ptr, _out_buffs[i], num_samples);
+            if (num_samples != 0) {
+                const bound_converter& conv = _converters[i];
+                conv.kernel(conv.converter.get(), input_ptr, _out_buffs[i], num_samples);
+            }
+        }
+
+        if (collect_stats) {
+            stats.add_convert_time(streamer_stats::clock::now() - start);
+        }
+        UHD_TRACE(CONVERT_END);
+
+        for (size_t i = 0; i < get_num_channels(); i++) {
+            _zero_copy_streamer.release_send_buff(i);
+        }
+
+        return num_samples;
+    }
+
+    //! Throws if the buffers are in use by zero-copy or cyclic transmission
+    void _check_can_send() const
+    {
+        if (_zero_copy_buffs_held) {
+            throw uhd::runtime_error(
+                "[tx_stream] Zero-copy buffers must be committed before sending again");
+        }
+        if (_cyclic_task) {
+            throw uhd::runtime_error(
+                "[tx_stream] Cyclic transmission must be stopped before sending again");
+        }
+    }
+
+    //! Sends the next packet of the cyclic waveform, runs in the cyclic task
+    void _send_cyclic_packet()
+    {
+        const size_t nsamps = std::min(_spp, _cyclic_nsamps - _cyclic_pos);
+        if (_cyclic_metadata.has_time_spec) {
+            _cyclic_metadata.time_ticks =
+                _cyclic_start_ticks + _samps_to_ticks(_cyclic_samps_sent);
+        }
+        if (!_zero_copy_streamer.get_send_buffs(
+                _out_buffs, nsamps, _cyclic_metadata, false, CYCLIC_TIMEOUT_MS)) {
+            return;
+        }
+        const size_t offset = _cyclic_pos * _convert_info.bytes_per_otw_item;
+        for (size_t i = 0; i < get_num_channels(); i++) {
+            std::memcpy(_out_buffs[i],
+                _cyclic_payloads[i].data() + offset,
+                nsamps * _convert_info.bytes_per_otw_item);
+            _zero_copy_streamer.release_send_buff(i);
+        }
+        _cyclic_pos = (_cyclic_pos + nsamps) % _cyclic_nsamps;
+        _cyclic_samps_sent += nsamps;
+        _cyclic_metadata.start_of_burst = false;
+    }
+
+    //! Position in the segments of a channel, see send_segments()
+    struct segment_cursor
+    {
+        size_t index  = 0;
+        size_t offset = 0;
+    };
+
+    /*!
+     * Returns the next samples of a channel's segments, up to max_samps, which
+     * is less if the current segment ends first
+     */
+    const void* _next_segment_samps(const uhd::tx_streamer::segments_type& segments,
+        segment_cursor& cursor,
+        const size_t max_samps,
+        size_t& nsamps)
+    {
+        while (segments[cursor.index].nsamps == cursor.offset) {
+            cursor.index++;
+            cursor.offset = 0;
+        }
+        const uhd::tx_streamer::segment_t& segment = segments[cursor.index];
+        nsamps = std::min(max_samps, segment.nsamps - cursor.offset);
+        const void* samps = static_cast<const uint8_t*>(segment.buff)
+                            + cursor.offset * _convert_info.bytes_per_cpu_item;
+        cursor.offset += nsamps;
+        return samps;
+    }
+
+    /*!
+     * Converts samples of each channel's segments and sends a packet, see
+     * send_segments()
+     *
+     * The pieces of a packet that lie in different segments are converted one
+     * by one into the frame buffer. The converters pack the samples into 32-bit
+     * words, so once a piece doesn't end on a word boundary (e.g., an odd
+     * number of samples of sc8), the rest of the packet is gathered and
+     * converted in one go.
+     */
+    size_t _send_one_packet_segments(
+        const std::vector<uhd::tx_streamer::segments_type>& segments,
+        const size_t num_samples,
+        const tx_metadata_t& metadata,
+        const int32_t timeout_ms)
+    {
+        if (_get_time_estimate && _drop_late_packet(metadata)) {
+            for (size_t i = 0; i < get_num_channels(); i++) {
+                size_t remaining = num_samples;
+                while (remaining > 0) {
+                    size_t nsamps;
+                    _next_segment_samps(
+                        segments[i], _segment_cursors[i], remaining, nsamps);
+                    remaining -= nsamps;
+                }
+            }
+            return num_samples;
+        }
+
+        if (!_zero_copy_streamer.get_send_buffs(
+                _out_buffs, num_samples, metadata, false, timeout_ms)) {
+            return 0;
+        }
 
+        streamer_stats& stats    = _zero_copy_streamer.get_stats();
+        const bool collect_stats = stats.enabled();
+        const auto start         = collect_stats ? streamer_stats::clock::now()
+                                         : streamer_stats::clock::time_point();
+        UHD_TRACE(CONVERT_BEGIN, num_samples);
+
+        const size_t in_size  = _convert_info.bytes_per_cpu_item;
+        const size_t out_size = _convert_info.bytes_per_otw_item;
+        for (size_t i = 0; i < get_num_channels(); i++) {
+            const bound_converter& conv = _converters[i];
+            uint8_t* out                = static_cast<uint8_t*>(_out_buffs[i]);
+            size_t remaining            = num_samples;
+            while (remaining > 0) {
+                size_t nsamps;
+                const void* in = _next_segment_samps(
+                    segments[i], _segment_cursors[i], remaining, nsamps);
+                // Gather the rest of the packet if the piece ends within a word
+                if (nsamps != remaining && (nsamps * out_size) % sizeof(uint32_t) != 0) {
+                    _gather_buff.resize(_spp * in_size);
+                    std::memcpy(_gather_buff.data(), in, nsamps * in_size);
+                    size_t gathered = nsamps;
+                    while (gathered < remaining) {
+                        in = _next_segment_samps(segments[i],
+                            _segment_cursors[i],
+                            remaining - gathered,
+                            nsamps);
+                        std::memcpy(_gather_buff.data() + gathered * in_size,
+                            in,
+                            nsamps * in_size);
+                        gathered += nsamps;
+                    }
+                    in     = _gather_buff.data();
+                    nsamps = remaining;
+                }
+                conv.kernel(conv.converter.get(), in, out, nsamps);
+                out += nsamps * out_size;
+                remaining -= nsamps;
+            }
+        }
+
+        if (collect_stats) {
+            stats.add_convert_time(streamer_stats::clock::now() - start);
+        }
+        UHD_TRACE(CONVERT_END);
+
+        for (size_t i = 0; i < get_num_channels(); i++) {
             _zero_copy_streamer.release_send_buff(i);
         }
 
         return num_samples;
     }
 
+    /*!
+     * Send samples through the host DSP, see send()
+     *
+     * At the end of a burst, zeros flush the filter, and a packet with a
+     * single zero sample carries the end of burst.
+     */
+    size_t _send_host_dsp(const uhd::tx_streamer::buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        uhd::tx_metadata_t metadata,
+        const int32_t timeout_ms)
+    {
+        if (metadata.start_of_burst) {
+            for (auto& dsp : _host_dsps) {
+                dsp.reset();
+            }
+        }
+        const bool eob        = metadata.end_of_burst;
+        metadata.end_of_burst = false;
+
+        const uint64_t start_time_ticks = metadata.time_ticks;
+        size_t num_out_sent             = 0;
+        const size_t num_sent           = _send_host_dsp_samps(
+            buffs, nsamps_per_buff, metadata, start_time_ticks, num_out_sent, timeout_ms);
+        if (num_sent < nsamps_per_buff || !eob) {
+            return num_sent;
+        }
+
+        const size_t num_flush = _host_dsps.front().get_num_flush_samps();
+        _host_dsp_zeros.resize(num_flush);
+        const std::vector<const void*> zero_buffs(
+            get_num_channels(), _host_dsp_zeros.data());
+        const size_t num_flushed = _send_host_dsp_samps(
+            zero_buffs, num_flush, metadata, start_time_ticks, num_out_sent, timeout_ms);
+        if (num_flushed < num_flush) {
+            return num_sent;
+        }
+
+        metadata.end_of_burst = true;
+        _send_one_packet(_zero_buffs, 0, 1, metadata, false, timeout_ms);
+        return num_sent;
+    }
+
+    /*!
+     * Send packets through the host DSP as far as the input reaches, and keep
+     * the rest of the input in the history of the filter
+     *
+     * \return the number of input samples consumed
+     */
+    size_t _send_host_dsp_samps(const uhd::tx_streamer::buffs_type& buffs,
+        const size_t num_in,
+        uhd::tx_metadata_t& metadata,
+        const uint64_t start_time_ticks,
+        size_t& num_out_sent,
+        const int32_t timeout_ms)
+    {
+        size_t num_consumed = 0;
+        while (true) {
+            const size_t remaining = num_in - num_consumed;
+            if (!_host_dsps.front().can_produce(remaining)) {
+                for (size_t i = 0; i < get_num_channels(); i++) {
+                    _host_dsps[i].append(
+                        static_cast<const std::complex<float>*>(buffs[i]) + num_consumed,
+                        remaining);
+                }
+                return num_in;
+            }
+
+            if (!_zero_copy_streamer.get_frame_buffs(timeout_ms)) {
+                return num_consumed;
+            }
+            _zero_copy_streamer.get_payload_ptrs(_out_buffs, metadata.has_time_spec);
+
+            streamer_stats& stats    = _zero_copy_streamer.get_stats();
+            const bool collect_stats = stats.enabled();
+            const auto start         = collect_stats ? streamer_stats::clock::now()
+                                             : streamer_stats::clock::time_point();
+            UHD_TRACE(CONVERT_BEGIN, remaining);
+
+            size_t num_out     = 0;
+            size_t num_used_in = 0;
+            for (size_t i = 0; i < get_num_channels(); i++) {
+                num_out = _host_dsps[i].process(
+                    static_cast<const std::complex<float>*>(buffs[i]) + num_consumed,
+                    remaining,
+                    _out_buffs[i],
+                    _spp,
+                    num_used_in);
+            }
+
+            if (collect_stats) {
+                stats.add_convert_time(streamer_stats::clock::now() - start);
+            }
+            UHD_TRACE(CONVERT_END);
+
+            _zero_copy_streamer.write_packet_headers(
+                _out_buffs, num_out, metadata, false);
+            for (size_t i = 0; i < get_num_channels(); i++) {
+                _zero_copy_streamer.release_send_buff(i);
+            }
+
+            num_consumed += num_used_in;
+            num_out_sent += num_out;
+            metadata.start_of_burst = false;
+            if (metadata.has_time_spec) {
+                metadata.time_ticks = start_time_ticks + _samps_to_ticks(num_out_sent);
+            }
+        }
+    }
+
+    //! Create a host DSP for each channel, if the stream args ask for it
+    void _setup_host_dsp(const size_t num_chans,
+        const uhd::stream_args_t& stream_args,
+        const std::string& otw_format_suffix)
+    {
+        if (!stream_args.args.has_key("host_rate")
+            && !stream_args.args.has_key("host_freq_shift")) {
+            return;
+        }
+        if (stream_args.cpu_format != "fc32") {
+            throw uhd::value_error(
+                "[tx_stream] Host DSP is not supported for " + stream_args.cpu_format);
+        }
+        const auto wire =
+            get_sc16_wire_format(stream_args.otw_format + otw_format_suffix);
+        const double freq_shift = stream_args.args.cast<double>("host_freq_shift", 0.0);
+        _host_rate              = stream_args.args.cast<double>("host_rate", 0.0);
+        for (size_t i = 0; i < num_chans; i++) {
+            _host_dsps.emplace_back(wire);
+            _host_dsps.back().set_freq_shift(freq_shift);
+        }
+        // The rates are configured once the sample rate is known
+    }
+
+    void _update_host_dsp_rates()
+    {
+        // Without a host rate, the host DSP only shifts the frequency
+        const double input_rate = (_host_rate > 0.0) ? _host_rate : _samp_rate;
+        for (auto& dsp : _host_dsps) {
+            dsp.set_rates(input_rate, _samp_rate);
+        }
+    }
+
     //! Create converters and initialize _bytes_per_cpu_item
-    void _setup_converters(const size_t num_chans, const uhd::stream_args_t stream_args)
+    void _setup_converters(const size_t num_chans,
+        const uhd::stream_args_t stream_args,
+        const std::string& otw_format_suffix)
     {
         // Note to code archaeologists: In the past, we had to also specify the
         // endianness here, but that is no longer necessary because we can make
@@ -395,7 +1168,7 @@ private:
         convert::id_type id;
         id.input_format  = stream_args.cpu_format;
         id.num_inputs    = 1;
-        id.output_format = stream_args.otw_format + "_chdr";
+        id.output_format = stream_args.otw_format + otw_format_suffix;
         id.num_outputs   = 1;
 
         auto starts_with = [](const std::string& s, const std::string v) {
@@ -416,18 +1189,40 @@ private:
         }
 
         _convert_info = info;
+        _convert_id   = id;
+        _scale_factors.assign(num_chans, 32767.0);
 
         for (size_t i = 0; i < num_chans; i++) {
-            _converters.push_back(convert::get_converter(id)());
-            _converters.back()->set_scalar(32767.0);
+            bound_converter conv;
+            conv.converter = convert::get_converter(id)();
+            conv.converter->set_scalar(32767.0);
+            conv.kernel = conv.converter->get_kernel();
+            _converters.push_back(conv);
         }
     }
 
     // Converter item sizes
     convert_info _convert_info;
 
-    // Converters
-    std::vector<uhd::convert::converter::sptr> _converters;
+    // Converters, with their kernels resolved up front so converting a packet
+    // does not go through virtual dispatch
+    std::vector<bound_converter> _converters;
+
+    // Conversion of a single channel, the scale factors of the channels, and
+    // whether the converters collect signal statistics
+    convert::id_type _convert_id;
+    std::vector<double> _scale_factors;
+    bool _signal_stats_enabled = false;
+
+    // Resampling and frequency shift on the host, one per channel if enabled,
+    // the input rate of the resampling (0 if there is none), and zeros that
+    // flush the filters at the end of a burst
+    std::vector<tx_host_dsp> _host_dsps;
+    double _host_rate = 0.0;
+    std::vector<std::complex<float>> _host_dsp_zeros;
+
+    // Sample rate of the device
+    double _samp_rate = 1.0;
 
     // Manages frame buffers and packet info
     tx_streamer_zero_copy<transport_t> _zero_copy_streamer;
@@ -440,8 +1235,14 @@ private:
     // Container for buffer pointers used in send method
     std::vector<void*> _out_buffs;
 
-    // Sample rate used to calculate metadata time_spec_t
-    double _samp_rate = 1.0;
+    // The positions in the segments of each channel, and the buffer that
+    // gathers the samples of a packet that can't be converted piece by piece,
+    // see send_segments()
+    std::vector<segment_cursor> _segment_cursors;
+    std::vector<uint8_t> _gather_buff;
+
+    // Conversion of sample offsets to packet timestamps
+    samps_to_ticks _samps_to_ticks;
 
     // MTU, determined when xport is connected and modifiable by subclass
     size_t _mtu = std::numeric_limits<std::size_t>::max();
@@ -451,6 +1252,38 @@ private:
 
     // Metadata cache for send calls with no data
     detail::tx_metadata_cache _metadata_cache;
+
+    // Whether buffers handed out by get_send_buffs() are waiting to be committed
+    bool _zero_copy_buffs_held = false;
+
+    // Metadata for the buffers handed out by get_send_buffs()
+    uhd::tx_metadata_t _zero_copy_metadata;
+
+    // Dropping of late bursts, see set_late_burst_drop()
+    time_estimate_fn_t _get_time_estimate;
+    uhd::time_spec_t _late_margin{0.0};
+    late_burst_fn_t _late_burst_cb;
+    // Whether the last packet did not end a burst
+    bool _in_burst = false;
+    // Whether the packets of the current burst are dropped
+    bool _dropping_burst = false;
+
+    // How long the cyclic task waits for a send buffer, short enough for it
+    // to stop promptly
+    static constexpr int32_t CYCLIC_TIMEOUT_MS = 100;
+
+    // The waveform of start_cyclic() in the wire format, one per channel, the
+    // position of the next packet in it, and the burst that replays it
+    std::vector<std::vector<uint8_t>> _cyclic_payloads;
+    size_t _cyclic_nsamps        = 0;
+    size_t _cyclic_pos           = 0;
+    uint64_t _cyclic_samps_sent  = 0;
+    uint64_t _cyclic_start_ticks = 0;
+    uhd::tx_metadata_t _cyclic_metadata;
+
+    // Sends the packets of the cyclic transmission. This is the last member,
+    // so the task stops before anything it uses is destroyed.
+    uhd::task::sptr _cyclic_task;
 };
 
 }} // namespace uhd::transport
@@ -9,6 +9,7 @@
 #include <uhd/config.hpp>
 #include <uhd/stream.hpp>
 #include <uhd/types/metadata.hpp>
+#include <uhdlib/transport/streamer_stats.hpp>
 #include <vector>
 
 namespace uhd { namespace transport {
@@ -24,7 +25,7 @@ class tx_streamer_zero_copy
 public:
     //! Constructor
     tx_streamer_zero_copy(const size_t num_chans)
-        : _xports(num_chans), _frame_buffs(num_chans)
+        : _stats(num_chans), _xports(num_chans), _frame_buffs(num_chans)
     {
     }
 
@@ -62,6 +63,18 @@ public:
         _tick_rate = rate;
     }
 
+    //! Returns the statistics counters of the streamer
+    streamer_stats& get_stats()
+    {
+        return _stats;
+    }
+
+    //! Returns the statistics counters of the streamer
+    const streamer_stats& get_stats() const
+    {
+        return _stats;
+    }
+
     //! Configures the size of each sample
     void set_bytes_per_item(const size_t bpi)
     {
@@ -83,26 +96,88 @@ public:
         const tx_metadata_t& metadata,
         const bool eov,
         const int32_t timeout_ms)
+    {
+        if (!get_frame_buffs(timeout_ms)) {
+            return false;
+        }
+
+        write_packet_headers(buffs, nsamps_per_buff, metadata, eov);
+        return true;
+    }
+
+    /*!
+     * Gets a set of frame buffers, one per channel, without writing the packet
+     * headers. Headers are written later with write_packet_headers().
+     *
+     * \param timeout_ms timeout in milliseconds
+     * \return true if the operation was sucessful, false if timeout occurs
+     */
+    UHD_FORCE_INLINE bool get_frame_buffs(const int32_t timeout_ms)
     {
         // Try to get a buffer per channel
         for (; _next_buff_to_get < _xports.size(); _next_buff_to_get++) {
-            _frame_buffs[_next_buff_to_get].first =
-                _xports[_next_buff_to_get]->get_send_buff(timeout_ms);
+            auto& buff  = _frame_buffs[_next_buff_to_get].first;
+            auto& xport = _xports[_next_buff_to_get];
+
+            if (_stats.enabled()) {
+                // Try without waiting first, to tell whether the streamer stalls
+                buff = xport->get_send_buff(0);
+                if (!buff) {
+                    const auto start = streamer_stats::clock::now();
+                    buff             = xport->get_send_buff(timeout_ms);
+                    _stats.add_stall(streamer_stats::clock::now() - start);
+                }
+            } else {
+                buff = xport->get_send_buff(timeout_ms);
+            }
 
-            if (!_frame_buffs[_next_buff_to_get].first) {
+            if (!buff) {
                 return false;
             }
         }
 
         // Got all the buffers, start from index 0 next call
         _next_buff_to_get = 0;
+        return true;
+    }
+
+    /*!
+     * Returns pointers to the payloads of the frame buffers obtained by
+     * get_frame_buffs(), before the packet headers are written.
+     *
+     * \param buffs returns a pointer to the payload of each buffer
+     * \param has_tsf whether the packets will have a timestamp, which can
+     *        change the size of the header
+     */
+    UHD_FORCE_INLINE void get_payload_ptrs(std::vector<void*>& buffs, const bool has_tsf)
+    {
+        for (size_t i = 0; i < buffs.size(); i++) {
+            buffs[i] = static_cast<uint8_t*>(_frame_buffs[i].first->data())
+                       + _xports[i]->get_payload_offset(has_tsf);
+        }
+    }
 
+    /*!
+     * Writes the packet headers into the frame buffers obtained by
+     * get_frame_buffs().
+     *
+     * \param buffs returns a pointer to the buffer data
+     * \param nsamps_per_buff the number of samples in each buffer
+     * \param metadata the metadata to write to the packet header
+     * \param eov EOV flag to write to the packet header
+     */
+    UHD_FORCE_INLINE void write_packet_headers(std::vector<void*>& buffs,
+        const size_t nsamps_per_buff,
+        const tx_metadata_t& metadata,
+        const bool eov)
+    {
         // Store portions of metadata we care about
         typename transport_t::packet_info_t info;
         info.has_tsf = metadata.has_time_spec;
 
         if (metadata.has_time_spec) {
-            info.tsf = metadata.time_spec.to_ticks(_tick_rate);
+            info.tsf = metadata.has_time_ticks ? metadata.time_ticks
+                                               : metadata.time_spec.to_ticks(_tick_rate);
         }
 
         info.payload_bytes = nsamps_per_buff * _bytes_per_item;
@@ -115,7 +190,11 @@ public:
                 _xports[i]->write_packet_header(_frame_buffs[i].first, info);
         }
 
-        return true;
+        if (_stats.enabled()) {
+            for (size_t i = 0; i < buffs.size(); i++) {
+                _stats.add_packet(i, info.payload_bytes);
+            }
+        }
     }
 
     /*!
@@ -126,6 +205,9 @@ public:
     UHD_FORCE_INLINE void release_send_buff(const size_t channel)
     {
         _frame_buffs[channel].first->set_packet_size(_frame_buffs[channel].second);
+        if (_stats.latency_probe_enabled()) {
+            _stats.add_send_packet(*_frame_buffs[channel].first);
+        }
         _xports[channel]->release_send_buff(std::move(_frame_buffs[channel].first));
 
         _frame_buffs[channel].first  = nullptr;
@@ -133,6 +215,10 @@ public:
     }
 
 private:
+    // Statistics counters. These are declared first, so they outlive the
+    // transports, which may still hold frames marked by the latency probe.
+    streamer_stats _stats;
+
     // Transports for each channel
     std::vector<typename transport_t::uptr> _xports;
 
@@ -103,6 +103,49 @@ public:
         return _adapter_id;
     }
 
+    /*!
+     * Get the network interface that has the local address of this link
+     */
+    std::string get_send_ifname() const;
+
+    /*!
+     * Get the network interface that has the local address of this link
+     */
+    std::string get_recv_ifname() const;
+
+    /*!
+     * Get a receive buffer. When batched receives are enabled, frames are
+     * pulled from the socket several at a time and handed out one per call.
+     */
+    frame_buff::uptr get_recv_buff(int32_t timeout_ms)
+    {
+        if (_recv_batch_size <= 1) {
+            return recv_link_base_t::get_recv_buff(timeout_ms);
+        }
+
+        if (_batch_head == _batch_count) {
+            _fill_recv_batch(timeout_ms);
+            if (_batch_count == 0) {
+                return frame_buff::uptr();
+            }
+        }
+
+        return frame_buff::uptr(_batch_buffs[_batch_head++]);
+    }
+
+    /*!
+     * Borrow frames from a shared pool when all of the link's own frames are
+     * in use. Batched receives only use the link's own frames, so links with
+     * recv_batch > 1 don't take shared frames.
+     */
+    bool set_shared_frame_pool(std::shared_ptr<shared_frame_pool> pool)
+    {
+        if (pool && _recv_batch_size > 1) {
+            return false;
+        }
+        return recv_link_base_t::attach_shared_frame_pool(pool);
+    }
+
 private:
     using recv_link_base_t = recv_link_base<udp_boost_asio_link>;
     using send_link_base_t = send_link_base<udp_boost_asio_link>;
@@ -117,6 +160,11 @@ private:
     size_t resize_recv_socket_buffer(size_t num_bytes);
     size_t resize_send_socket_buffer(size_t num_bytes);
 
+    /*! Receive up to _recv_batch_size frames from the socket into buffers
+     *  taken from the free buffer pool
+     */
+    void _fill_recv_batch(int32_t timeout_ms);
+
     // Methods called by recv_link_base
     UHD_FORCE_INLINE size_t get_recv_buff_derived(frame_buff& buff, int32_t timeout_ms)
     {
@@ -146,6 +194,17 @@ private:
     std::vector<udp_boost_asio_frame_buff> _recv_buffs;
     std::vector<udp_boost_asio_frame_buff> _send_buffs;
 
+    // Batched receive state. Frames in _batch_buffs[_batch_head.._batch_count)
+    // have been received but not yet handed out by get_recv_buff().
+    size_t _recv_batch_size = 1;
+    size_t _batch_head      = 0;
+    size_t _batch_count     = 0;
+    std::vector<frame_buff*> _batch_buffs;
+#ifdef UHD_PLATFORM_LINUX
+    std::vector<struct mmsghdr> _batch_msgs;
+    std::vector<struct iovec> _batch_iovs;
+#endif
+
     boost::asio::io_service _io_service;
     std::shared_ptr<boost::asio::ip::udp::socket> _socket;
     int _sock_fd;
@@ -11,8 +11,10 @@
 #include <uhd/config.hpp>
 #include <uhd/exception.hpp>
 #include <uhd/rfnoc/constants.hpp>
+#include <uhd/transport/udp_simple.hpp>
 #include <uhd/types/device_addr.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhd/utils/realtime.hpp>
 #include <uhdlib/transport/links.hpp>
 #include <uhdlib/utils/narrow.hpp>
 #include <boost/asio.hpp>
@@ -32,6 +34,13 @@ constexpr size_t UDP_DEFAULT_FRAME_SIZE = 1472;
 // 20ms of data for 1GbE link (in bytes)
 constexpr size_t UDP_DEFAULT_BUFF_SIZE = 2500000;
 
+// With low_memory, the default number of frames per link
+constexpr size_t UDP_LOW_MEMORY_NUM_FRAMES = 8;
+
+// With low_memory, the default socket buffering in milliseconds of data at the
+// link rate
+constexpr double UDP_LOW_MEMORY_BUFF_MS = 2.0;
+
 
 #if defined(UHD_PLATFORM_MACOS) || defined(UHD_PLATFORM_BSD)
 // MacOS limits socket buffer size to 1 Mib
@@ -98,6 +107,65 @@ UHD_INLINE socket_sptr open_udp_socket(
     return socket;
 }
 
+/*!
+ * Set the don't-fragment bit on the packets that a socket sends
+ *
+ * Packets that exceed the MTU of the interface then fail to send, and routers
+ * drop packets that exceed the MTU of the path, instead of fragmenting them.
+ * On Linux, the path MTU the kernel may have cached is ignored, so the socket
+ * can probe it.
+ *
+ * \param sock_fd the open socket file descriptor
+ * \return false if the platform doesn't support this
+ */
+UHD_INLINE bool set_dont_fragment(int sock_fd)
+{
+#if defined(IP_MTU_DISCOVER) && defined(IP_PMTUDISC_PROBE)
+    const int value = IP_PMTUDISC_PROBE;
+    return ::setsockopt(sock_fd, IPPROTO_IP, IP_MTU_DISCOVER, &value, sizeof(value))
+           == 0;
+#elif defined(IP_DONTFRAG)
+    const int value = 1;
+    return ::setsockopt(sock_fd, IPPROTO_IP, IP_DONTFRAG, &value, sizeof(value)) == 0;
+#elif defined(IP_DONTFRAGMENT)
+    const DWORD value = 1;
+    return ::setsockopt(sock_fd,
+               IPPROTO_IP,
+               IP_DONTFRAGMENT,
+               reinterpret_cast<const char*>(&value),
+               sizeof(value))
+           == 0;
+#else
+    (void)sock_fd;
+    return false;
+#endif
+}
+
+/*!
+ * Make a broadcast UDP transport (see udp_simple::make_broadcast()) whose
+ * packets have the don't-fragment bit set, for probing the path MTU
+ *
+ * Sending a packet that exceeds the MTU of the interface throws a
+ * boost::system::system_error with boost::asio::error::message_size.
+ */
+udp_simple::sptr make_udp_simple_mtu_probe(
+    const std::string& addr, const std::string& port);
+
+/*!
+ * Return the local address that the host sends packets for \p addr from
+ *
+ * \param addr the address of the remote host
+ * \param port the UDP port on the remote host
+ * \throws uhd::exception or boost::system::system_error if \p addr can't be
+ *         resolved or reached
+ */
+UHD_INLINE std::string get_local_addr_to(const std::string& addr, const std::string& port)
+{
+    boost::asio::io_service io_service;
+    socket_sptr socket = open_udp_socket(addr, port, io_service);
+    return socket->local_endpoint().address().to_string();
+}
+
 UHD_INLINE size_t recv_udp_packet(
     int sock_fd, void* mem, size_t frame_size, int32_t timeout_ms)
 {
@@ -125,6 +193,46 @@ UHD_INLINE size_t recv_udp_packet(
     return 0; // timeout
 }
 
+#ifdef UHD_PLATFORM_LINUX
+/*!
+ * Receive multiple datagrams with a single system call.
+ *
+ * The caller must point the iovecs of each message header at the buffers to
+ * be filled. On return, the msg_len field of each filled message header holds
+ * the length of the datagram.
+ *
+ * \param sock_fd the open socket file descriptor
+ * \param msgs array of message headers describing the destination buffers
+ * \param num_msgs number of entries in msgs
+ * \param timeout_ms the timeout duration in milliseconds
+ * \return the number of datagrams received, or 0 on timeout
+ */
+UHD_INLINE size_t recv_udp_packets(
+    int sock_fd, struct mmsghdr* msgs, size_t num_msgs, int32_t timeout_ms)
+{
+    // Try a non-blocking receive first, and only wait when nothing is queued
+    int ret = ::recvmmsg(sock_fd, msgs, num_msgs, MSG_DONTWAIT, nullptr);
+    if (ret > 0) {
+        return ret;
+    }
+    if (ret < 0 and errno != EAGAIN and errno != EWOULDBLOCK) {
+        throw uhd::io_error(
+            str(boost::format("recvmmsg error on socket: %s") % strerror(errno)));
+    }
+
+    if (wait_for_recv_ready(sock_fd, timeout_ms)) {
+        ret = ::recvmmsg(sock_fd, msgs, num_msgs, MSG_DONTWAIT, nullptr);
+        if (ret < 0) {
+            throw uhd::io_error(
+                str(boost::format("recvmmsg error on socket: %s") % strerror(errno)));
+        }
+        return ret;
+    }
+
+    return 0; // timeout
+}
+#endif
+
 UHD_INLINE void send_udp_packet(int sock_fd, void* mem, size_t len)
 {
     // Retry logic because send may fail with ENOBUFS.
@@ -212,7 +320,13 @@ UHD_INLINE size_t resize_udp_socket_buffer_with_warning(
  * \param device_args device-level argument dictionary for overrides
  * \param link_args argument dictionary with stream-level overrides (come from
  *        stream params)
+ * \param link_rate the rate of the link in bytes per second, used to convert
+ *        recv_buff_ms into a number of frames. If 0, recv_buff_ms is ignored.
  * \return Parameters to apply
+ *
+ * If the device or link arguments set low_memory, the defaults shrink to a few
+ * frames and socket buffers of a few milliseconds of data at the link rate.
+ * Values that are given explicitly, including recv_buff_ms, still apply.
  */
 inline link_params_t calculate_udp_link_params(
     const uhd::transport::link_type_t link_type,
@@ -220,7 +334,8 @@ inline link_params_t calculate_udp_link_params(
     const size_t recv_mtu,
     const link_params_t& default_link_params,
     const uhd::device_addr_t& device_args,
-    const uhd::device_addr_t& link_args)
+    const uhd::device_addr_t& link_args,
+    const double link_rate = 0.0)
 {
     // Apply any device-level overrides to the default values first.
     // If the MTU is overridden, it will be capped to the value provided by
@@ -230,19 +345,45 @@ inline link_params_t calculate_udp_link_params(
     const size_t constrained_recv_mtu =
         std::min(recv_mtu, device_args.cast<size_t>("mtu", recv_mtu));
 
+    link_params_t defaults = default_link_params;
+    if (link_args.cast<bool>("low_memory", device_args.cast<bool>("low_memory", false))) {
+        defaults.num_send_frames =
+            std::min(defaults.num_send_frames, UDP_LOW_MEMORY_NUM_FRAMES);
+        defaults.num_recv_frames =
+            std::min(defaults.num_recv_frames, UDP_LOW_MEMORY_NUM_FRAMES);
+        if (link_rate > 0.0) {
+            const size_t buff_bytes =
+                static_cast<size_t>(link_rate * UDP_LOW_MEMORY_BUFF_MS / 1e3);
+            defaults.send_buff_size = std::min(defaults.send_buff_size, buff_bytes);
+            defaults.recv_buff_size = std::min(defaults.recv_buff_size, buff_bytes);
+        }
+    }
+
     link_params_t link_params;
     link_params.num_send_frames =
-        device_args.cast<size_t>("num_send_frames", default_link_params.num_send_frames);
+        device_args.cast<size_t>("num_send_frames", defaults.num_send_frames);
     link_params.num_recv_frames =
-        device_args.cast<size_t>("num_recv_frames", default_link_params.num_recv_frames);
+        device_args.cast<size_t>("num_recv_frames", defaults.num_recv_frames);
     link_params.send_frame_size =
-        device_args.cast<size_t>("send_frame_size", default_link_params.send_frame_size);
+        device_args.cast<size_t>("send_frame_size", defaults.send_frame_size);
     link_params.recv_frame_size =
-        device_args.cast<size_t>("recv_frame_size", default_link_params.recv_frame_size);
+        device_args.cast<size_t>("recv_frame_size", defaults.recv_frame_size);
     link_params.send_buff_size =
-        device_args.cast<size_t>("send_buff_size", default_link_params.send_buff_size);
+        device_args.cast<size_t>("send_buff_size", defaults.send_buff_size);
     link_params.recv_buff_size =
-        device_args.cast<size_t>("recv_buff_size", default_link_params.recv_buff_size);
+        device_args.cast<size_t>("recv_buff_size", defaults.recv_buff_size);
+    link_params.buff_alloc = defaults.buff_alloc;
+    if (device_args.has_key("buff_hugepages")) {
+        link_params.buff_alloc.hugepage_size =
+            parse_buff_hugepages(device_args["buff_hugepages"]);
+    }
+    if (device_args.has_key("buff_numa_node")) {
+        link_params.buff_alloc.numa_node =
+            parse_buff_numa_node(device_args["buff_numa_node"]);
+    }
+    if (uhd::get_realtime_config().prefault) {
+        link_params.buff_alloc.prefault = true;
+    }
 
     // Now apply stream-level overrides based on the link type.
     if (link_type == link_type_t::CTRL) {
@@ -266,6 +407,27 @@ inline link_params_t calculate_udp_link_params(
             link_args.cast<size_t>("num_recv_frames", link_params.num_recv_frames);
         link_params.recv_buff_size =
             link_args.cast<size_t>("recv_buff_size", link_params.recv_buff_size);
+        // Size the buffering on the host for a given time of data at the link
+        // rate, unless the sizes were given explicitly
+        const double recv_buff_ms = link_args.cast<double>(
+            "recv_buff_ms", device_args.cast<double>("recv_buff_ms", 0.0));
+        if (recv_buff_ms > 0.0 && link_rate > 0.0) {
+            const size_t buff_bytes = static_cast<size_t>(link_rate * recv_buff_ms / 1e3);
+            if (!link_args.has_key("num_recv_frames")
+                && !device_args.has_key("num_recv_frames")) {
+                link_params.num_recv_frames = std::max(link_params.num_recv_frames,
+                    (buff_bytes + link_params.recv_frame_size - 1)
+                        / link_params.recv_frame_size);
+            }
+            if (!link_args.has_key("recv_buff_size")
+                && !device_args.has_key("recv_buff_size")) {
+                link_params.recv_buff_size =
+                    std::max(link_params.recv_buff_size, buff_bytes);
+            }
+        }
+        // Batched receives are only used on RX data links
+        link_params.recv_batch_size = link_args.cast<size_t>("recv_batch",
+            device_args.cast<size_t>("recv_batch", defaults.recv_batch_size));
     }
 
 #if defined(UHD_PLATFORM_MACOS) || defined(UHD_PLATFORM_BSD)
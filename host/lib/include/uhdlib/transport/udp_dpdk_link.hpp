@@ -83,6 +83,19 @@ public:
         return _queue;
     }
 
+    /*!
+     * Set the DMA queue associated with this link
+     *
+     * A TX queue may only be used by one lcore, so this is set by the I/O
+     * service the link is attached to.
+     *
+     * \param queue the queue ID for this link's DMA queue
+     */
+    inline void set_queue_id(const dpdk::queue_id_t queue)
+    {
+        _queue = queue;
+    }
+
     /*!
      * Get the local UDP port used by this link
      *
@@ -257,7 +270,7 @@ private:
     adapter_id_t _adapter_id;
     //! The RX frame buff list head
     dpdk::dpdk_frame_buff* _recv_buff_head = nullptr;
-    // TODO: Implement ability to use multiple queues
+    //! The DMA queue used to transmit on this link
     dpdk::queue_id_t _queue = 0;
 };
 
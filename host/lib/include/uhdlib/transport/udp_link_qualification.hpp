@@ -0,0 +1,153 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhdlib/transport/links.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace uhd { namespace transport {
+
+//! Over how many milliseconds of data at the link rate the host should buffer
+constexpr double UDP_QUALIFY_BUFF_MS = 20.0;
+
+//! How many milliseconds of data at the link rate autotuned frames hold
+constexpr double UDP_AUTOTUNE_FRAMES_MS = 1.0;
+
+//! Size of the IPv4 and UDP headers, which don't count towards a frame
+constexpr size_t UDP_IPV4_HEADER_SIZE = 28;
+
+/*! Settings of the host that limit how fast a UDP link can receive
+ *
+ * Values that cannot be determined are 0 (or empty).
+ */
+struct udp_host_info_t
+{
+    //! The network interface of the link
+    std::string ifname;
+    //! The largest socket receive buffer the kernel grants (net.core.rmem_max)
+    size_t rmem_max = 0;
+    //! The MTU of the interface
+    size_t if_mtu = 0;
+    //! The configured and the largest RX ring size of the NIC, in descriptors
+    size_t rx_ring     = 0;
+    size_t rx_ring_max = 0;
+    //! The distinct CPU frequency governors of the online CPUs
+    std::vector<std::string> cpu_governors;
+
+    /*! Reads the settings of this machine
+     *
+     * \param ifname The network interface of the link
+     */
+    static udp_host_info_t read_system(const std::string& ifname);
+};
+
+//! The outcome of a check, or of the whole qualification
+enum class link_verdict_t {
+    //! The check could not run, this does not affect the verdict
+    UNKNOWN,
+    PASS,
+    //! Streaming at the full rate of the link may overflow
+    WARN,
+    //! Streaming at the full rate of the link will overflow
+    FAIL
+};
+
+//! Returns "unknown", "pass", "warn" or "fail"
+std::string to_string(const link_verdict_t verdict);
+
+//! The result of the link qualification
+struct udp_link_qualification_t
+{
+    struct check_t
+    {
+        //! Name of the check: rcvbuf, nic_ring, mtu or cpu_governor
+        std::string name;
+        link_verdict_t verdict;
+        //! What was found, and how to fix it
+        std::string detail;
+    };
+
+    std::vector<check_t> checks;
+
+    //! Returns the worst verdict of the checks
+    link_verdict_t get_verdict() const;
+
+    /*! Returns the verdicts in a machine-readable form, as key/value pairs,
+     *  e.g. "verdict=warn,rcvbuf=pass,nic_ring=warn,mtu=pass,cpu_governor=pass"
+     */
+    std::string to_string() const;
+};
+
+/*!
+ * Checks whether the host is set up to receive at the rate of a UDP link
+ *
+ * - rcvbuf: net.core.rmem_max must allow the socket buffer the link asks for.
+ *   Less than 1 ms of data at the link rate fails.
+ * - nic_ring: the RX ring of the NIC should be at its maximum size.
+ * - mtu: links of 10 Gbps and more should use jumbo frames, and the frames of
+ *   the link must fit the MTU of the interface.
+ * - cpu_governor: all CPUs should use the performance governor.
+ *
+ * \param host The settings of the host
+ * \param params The parameters of the link
+ * \param link_rate The rate of the link in bytes per second
+ */
+udp_link_qualification_t qualify_udp_link(
+    const udp_host_info_t& host, const link_params_t& params, const double link_rate);
+
+/*!
+ * Picks the RX frame size and count, and the socket buffer size of a UDP link
+ * for its rate
+ *
+ * The frames are capped to the MTU of the interface, there are enough of them
+ * to hold UDP_AUTOTUNE_FRAMES_MS of data, and the socket buffer holds
+ * UDP_QUALIFY_BUFF_MS of data. Values that the device or link args set
+ * explicitly are kept.
+ *
+ * \param host The settings of the host
+ * \param params The parameters of the link
+ * \param link_rate The rate of the link in bytes per second
+ * \param device_args The device args
+ * \param link_args The link (stream) args
+ * \return the tuned parameters
+ */
+link_params_t autotune_udp_link_params(const udp_host_info_t& host,
+    const link_params_t& params,
+    const double link_rate,
+    const uhd::device_addr_t& device_args,
+    const uhd::device_addr_t& link_args);
+
+/*!
+ * Runs the link qualification of an RX data link, if the qualify_link device
+ * or link arg asks for it
+ *
+ * With qualify_link=1, the verdict is logged, and the RX parameters are
+ * autotuned, see autotune_udp_link_params(). With qualify_link=strict, a link
+ * that fails the qualification also throws.
+ *
+ * \param addr The address of the device
+ * \param port The UDP port of the link
+ * \param params The parameters of the link
+ * \param link_rate The rate of the link in bytes per second
+ * \param device_args The device args
+ * \param link_args The link (stream) args
+ * \return the parameters to make the link with
+ * \throws uhd::runtime_error if the link fails the qualification, and
+ *         qualify_link is strict
+ */
+link_params_t qualify_udp_rx_link(const std::string& addr,
+    const std::string& port,
+    const link_params_t& params,
+    const double link_rate,
+    const uhd::device_addr_t& device_args,
+    const uhd::device_addr_t& link_args);
+
+}} // namespace uhd::transport
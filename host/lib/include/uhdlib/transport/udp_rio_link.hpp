@@ -0,0 +1,232 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhdlib/transport/adapter_info.hpp>
+#include <uhdlib/transport/link_base.hpp>
+#include <uhdlib/transport/links.hpp>
+#include <winsock2.h>
+#include <mswsock.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace uhd { namespace transport {
+
+/*!
+ * Frame buffer backed by a slot of the registered buffer of a RIO link.
+ *
+ * Receive completions don't necessarily arrive in the order the receives were
+ * posted, so a frame buffer is attached to whichever slot was filled.
+ */
+class udp_rio_frame_buff : public frame_buff
+{
+public:
+    //! Marks a frame buffer that is currently not attached to a slot
+    static constexpr ULONG NO_SLOT = ~ULONG(0);
+
+    udp_rio_frame_buff(uint8_t* area, const size_t slot_size)
+        : _area(area), _slot_size(slot_size)
+    {
+    }
+
+    //! Attach this frame buffer to a slot of the registered buffer
+    UHD_FORCE_INLINE void set_slot(const ULONG slot)
+    {
+        _slot = slot;
+        _data = _area + slot * _slot_size;
+    }
+
+    UHD_FORCE_INLINE ULONG get_slot() const
+    {
+        return _slot;
+    }
+
+    UHD_FORCE_INLINE void clear_slot()
+    {
+        _slot = NO_SLOT;
+        _data = nullptr;
+    }
+
+private:
+    uint8_t* _area;
+    size_t _slot_size;
+    ULONG _slot = NO_SLOT;
+};
+
+class udp_rio_adapter_info : public adapter_info
+{
+public:
+    udp_rio_adapter_info(const std::string& src_ip) : _src_ip(src_ip) {}
+
+    ~udp_rio_adapter_info() {}
+
+    std::string to_string()
+    {
+        return std::string("Ethernet(rio):") + _src_ip;
+    }
+
+    bool operator==(const udp_rio_adapter_info& rhs) const
+    {
+        return (_src_ip == rhs._src_ip);
+    }
+
+private:
+    // Use source IP addr
+    std::string _src_ip;
+};
+
+/*!
+ * A UDP link that uses the Winsock Registered I/O (RIO) extensions.
+ *
+ * All frames of the link live in a single buffer that is registered with the
+ * kernel once, when the link is created, instead of being locked for every
+ * single receive or send. Receives are posted for all receive frames up
+ * front, and the link polls its completion queues for finished requests, so
+ * there are no system calls on the fast path while data is flowing. Only when
+ * a completion queue stays empty does the link wait on its notification
+ * event, so an idle link does not burn a CPU core.
+ *
+ * Unlike the AF_XDP and DPDK links, the kernel keeps handling the network
+ * stack, so this link works with any NIC and does not need any extra setup.
+ */
+class udp_rio_link : public recv_link_base<udp_rio_link>,
+                     public send_link_base<udp_rio_link>
+{
+public:
+    using sptr = std::shared_ptr<udp_rio_link>;
+
+    ~udp_rio_link();
+
+    /*!
+     * Make a new RIO link.
+     *
+     * \param addr a string representing the destination address
+     * \param port a string representing the destination port
+     * \param params Values for frame sizes, num frames, and buffer sizes
+     * \param[out] recv_socket_buff_size Returns the recv socket buffer size
+     * \param[out] send_socket_buff_size Returns the send socket buffer size
+     */
+    static sptr make(const std::string& addr,
+        const std::string& port,
+        const link_params_t& params,
+        size_t& recv_socket_buff_size,
+        size_t& send_socket_buff_size);
+
+    /*! Return the local port of the UDP connection. Port is in host byte order.
+     */
+    uint16_t get_local_port() const
+    {
+        return ntohs(_local_addr.sin_port);
+    }
+
+    /*! Return the local IP address of the UDP connection as a dotted string.
+     */
+    std::string get_local_addr() const;
+
+    adapter_id_t get_send_adapter_id() const
+    {
+        return _adapter_id;
+    }
+
+    adapter_id_t get_recv_adapter_id() const
+    {
+        return _adapter_id;
+    }
+
+    std::string get_send_ifname() const
+    {
+        return get_local_addr();
+    }
+
+    std::string get_recv_ifname() const
+    {
+        return get_local_addr();
+    }
+
+private:
+    using recv_link_base_t = recv_link_base<udp_rio_link>;
+    using send_link_base_t = send_link_base<udp_rio_link>;
+
+    // Friend declarations to allow base classes to call private methods
+    friend recv_link_base_t;
+    friend send_link_base_t;
+
+    udp_rio_link(
+        const std::string& addr, const std::string& port, const link_params_t& params);
+
+    // Methods called by recv_link_base
+    size_t get_recv_buff_derived(frame_buff& buff, int32_t timeout_ms);
+    void release_recv_buff_derived(frame_buff& buff);
+
+    // Methods called by send_link_base
+    bool get_send_buff_derived(frame_buff& buff, int32_t timeout_ms);
+    void release_send_buff_derived(frame_buff& buff);
+
+    /*! Post a receive for slot. The request is only handed to the kernel by
+     *  the next call to _commit_recvs().
+     */
+    void _post_recv(const ULONG slot);
+    //! Hand all deferred receives to the kernel
+    void _commit_recvs();
+    /*! Move completed sends back to the free slot list, waiting up to
+     *  timeout_ms for one to complete if there are none
+     */
+    void _reap_send_completions(const int32_t timeout_ms);
+    /*! Dequeue completions from cq into results, waiting up to timeout_ms on
+     *  event if there are none
+     *
+     * \return the number of completions dequeued
+     */
+    ULONG _dequeue(RIO_CQ cq,
+        WSAEVENT event,
+        std::vector<RIORESULT>& results,
+        const int32_t timeout_ms);
+    void _cleanup();
+
+    RIO_EXTENSION_FUNCTION_TABLE _rio;
+    SOCKET _sock_fd = INVALID_SOCKET;
+    struct sockaddr_in _local_addr;
+
+    //! Memory for all frames. Receive slots come first, then send slots.
+    uint8_t* _area = nullptr;
+    size_t _slot_size;
+    RIO_BUFFERID _buffer_id = RIO_INVALID_BUFFERID;
+
+    RIO_CQ _recv_cq      = RIO_INVALID_CQ;
+    RIO_CQ _send_cq      = RIO_INVALID_CQ;
+    RIO_RQ _rq           = RIO_INVALID_RQ;
+    WSAEVENT _recv_event = WSA_INVALID_EVENT;
+    WSAEVENT _send_event = WSA_INVALID_EVENT;
+    //! The request queue must not be used by several threads at once
+    std::mutex _rq_mutex;
+
+    std::vector<udp_rio_frame_buff> _recv_buffs;
+    std::vector<udp_rio_frame_buff> _send_buffs;
+
+    // Receive completions in _recv_results[_recv_head.._recv_count) have been
+    // dequeued but not yet handed out by get_recv_buff_derived()
+    std::vector<RIORESULT> _recv_results;
+    ULONG _recv_head  = 0;
+    ULONG _recv_count = 0;
+    //! Set while there are deferred receives that were not yet committed
+    bool _recvs_pending = false;
+
+    std::vector<RIORESULT> _send_results;
+    //! Send slots that are not in flight
+    std::vector<ULONG> _free_send_slots;
+    //! Number of sends handed to the kernel but not yet completed
+    size_t _sends_outstanding = 0;
+
+    adapter_id_t _adapter_id;
+};
+
+}} // namespace uhd::transport
@@ -0,0 +1,249 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/exception.hpp>
+#include <uhdlib/transport/adapter_info.hpp>
+#include <uhdlib/transport/link_base.hpp>
+#include <uhdlib/transport/links.hpp>
+#include <linux/bpf.h>
+#include <net/ethernet.h>
+#include <netinet/in.h>
+#include <xdp/xsk.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uhd { namespace transport {
+
+//! Size of the Ethernet, IPv4 and UDP headers that precede the CHDR payload
+constexpr size_t XDP_HDR_SIZE_UDP_IPV4 = 14 + 20 + 8;
+
+//! Largest UDP payload that fits into a single UMEM frame
+constexpr size_t XDP_MAX_FRAME_SIZE =
+    XSK_UMEM__DEFAULT_FRAME_SIZE - XDP_PACKET_HEADROOM - XDP_HDR_SIZE_UDP_IPV4;
+
+/*!
+ * Frame buffer backed by a UMEM frame. The data pointer skips over the L2-L4
+ * headers, so the streamers see the UDP payload only.
+ */
+class udp_xdp_frame_buff : public frame_buff
+{
+public:
+    //! Marks a frame buffer that is currently not attached to a UMEM frame
+    static constexpr uint64_t NO_ADDR = ~uint64_t(0);
+
+    udp_xdp_frame_buff(uint8_t* umem_area) : _umem_area(umem_area) {}
+
+    //! Attach this frame buffer to the UMEM frame at addr
+    UHD_FORCE_INLINE void set_addr(const uint64_t addr)
+    {
+        _addr = addr;
+        _data = _umem_area + addr + XDP_HDR_SIZE_UDP_IPV4;
+    }
+
+    //! Return the UMEM address of the start of the Ethernet frame
+    UHD_FORCE_INLINE uint64_t get_addr() const
+    {
+        return _addr;
+    }
+
+    //! Return a pointer to the start of the Ethernet frame
+    UHD_FORCE_INLINE uint8_t* get_frame() const
+    {
+        return _umem_area + _addr;
+    }
+
+    UHD_FORCE_INLINE void clear_addr()
+    {
+        _addr = NO_ADDR;
+        _data = nullptr;
+    }
+
+private:
+    uint8_t* _umem_area;
+    uint64_t _addr = NO_ADDR;
+};
+
+class udp_xdp_adapter_info : public adapter_info
+{
+public:
+    udp_xdp_adapter_info(const std::string& ifname) : _ifname(ifname) {}
+
+    ~udp_xdp_adapter_info() {}
+
+    std::string to_string()
+    {
+        return std::string("Ethernet(xdp):") + _ifname;
+    }
+
+    bool operator==(const udp_xdp_adapter_info& rhs) const
+    {
+        return (_ifname == rhs._ifname);
+    }
+
+private:
+    std::string _ifname;
+};
+
+/*!
+ * A UDP link that bypasses the kernel network stack using AF_XDP sockets.
+ *
+ * Unlike DPDK, the NIC stays under control of the kernel driver. The link
+ * binds an XDP socket to one receive queue of the NIC and installs an ntuple
+ * rule to steer its UDP port to that queue, so all other traffic still takes
+ * the regular kernel path. Frame buffers point directly into the UMEM area
+ * shared with the NIC, so no copies are made between the NIC rings and the
+ * streamers.
+ *
+ * The link takes care of the Ethernet, IPv4 and UDP headers. The remote MAC
+ * address is taken from the kernel's neighbor table, which is populated by the
+ * control traffic that precedes streaming.
+ */
+class udp_xdp_link : public recv_link_base<udp_xdp_link>,
+                     public send_link_base<udp_xdp_link>
+{
+public:
+    using sptr = std::shared_ptr<udp_xdp_link>;
+
+    ~udp_xdp_link();
+
+    /*!
+     * Make a new AF_XDP link.
+     *
+     * \param addr a string representing the destination address
+     * \param port a string representing the destination port
+     * \param params Values for frame sizes and num frames. The buffer sizes
+     *        are not used, since there are no socket buffers involved.
+     * \param link_args Link arguments. The following keys are used:
+     *        - xdp_queue: The first NIC queue that may be used for AF_XDP
+     *          sockets (default: 1). Every link uses its own queue.
+     *        - xdp_zero_copy: Require driver zero-copy mode (default: try
+     *          zero-copy, and fall back to copy mode).
+     */
+    static sptr make(const std::string& addr,
+        const std::string& port,
+        const link_params_t& params,
+        const uhd::device_addr_t& link_args);
+
+    /*! Return the local UDP port of this link, in host byte order
+     */
+    uint16_t get_local_port() const
+    {
+        return ntohs(_local_port);
+    }
+
+    /*! Return the name of the network interface used by this link
+     */
+    std::string get_ifname() const
+    {
+        return _ifname;
+    }
+
+    /*! Return the NIC queue the XDP socket is bound to
+     */
+    uint32_t get_queue_id() const
+    {
+        return _queue_id;
+    }
+
+    adapter_id_t get_send_adapter_id() const
+    {
+        return _adapter_id;
+    }
+
+    adapter_id_t get_recv_adapter_id() const
+    {
+        return _adapter_id;
+    }
+
+    std::string get_send_ifname() const
+    {
+        return _ifname;
+    }
+
+    std::string get_recv_ifname() const
+    {
+        return _ifname;
+    }
+
+private:
+    using recv_link_base_t = recv_link_base<udp_xdp_link>;
+    using send_link_base_t = send_link_base<udp_xdp_link>;
+
+    // Friend declarations to allow base classes to call private methods
+    friend recv_link_base_t;
+    friend send_link_base_t;
+
+    udp_xdp_link(const std::string& addr,
+        const std::string& port,
+        const link_params_t& params,
+        const uhd::device_addr_t& link_args);
+
+    // Methods called by recv_link_base
+    size_t get_recv_buff_derived(frame_buff& buff, int32_t timeout_ms);
+    void release_recv_buff_derived(frame_buff& buff);
+
+    // Methods called by send_link_base
+    bool get_send_buff_derived(frame_buff& buff, int32_t timeout_ms);
+    void release_send_buff_derived(frame_buff& buff);
+
+    //! Check if the frame at addr is a UDP packet for this link
+    bool _is_for_us(const uint8_t* frame, const uint32_t len) const;
+    //! Fill in the Ethernet, IPv4 and UDP headers for a payload of len bytes
+    void _write_headers(uint8_t* frame, const size_t payload_len);
+    //! Move completed TX frames back to the free frame list
+    void _reap_tx_completions();
+    //! Kick the kernel to process the TX ring, if it asked for it
+    void _kick_tx();
+    //! Return a frame to the fill ring
+    void _refill(const uint64_t addr);
+
+    void _install_flow_rule();
+    void _remove_flow_rule();
+
+    //! Size of a single UMEM frame
+    size_t _umem_frame_size;
+    //! UMEM memory area, shared with the kernel
+    uint8_t* _umem_area = nullptr;
+    size_t _umem_size   = 0;
+
+    struct xsk_umem* _umem  = nullptr;
+    struct xsk_socket* _xsk = nullptr;
+    struct xsk_ring_prod _fill_ring;
+    struct xsk_ring_cons _comp_ring;
+    struct xsk_ring_cons _rx_ring;
+    struct xsk_ring_prod _tx_ring;
+    int _xsk_fd = -1;
+
+    std::vector<udp_xdp_frame_buff> _recv_buffs;
+    std::vector<udp_xdp_frame_buff> _send_buffs;
+    //! UMEM frames available for transmission
+    std::vector<uint64_t> _free_tx_addrs;
+    //! Number of TX frames submitted to the kernel but not yet completed
+    size_t _tx_outstanding = 0;
+
+    //! Kernel socket used to reserve the local UDP port
+    int _port_sock_fd = -1;
+    std::string _ifname;
+    uint32_t _queue_id = 0;
+    int _flow_rule_loc = -1;
+    uint16_t _ip_id    = 0;
+
+    // Addresses and ports, all in network order
+    struct ether_addr _local_mac;
+    struct ether_addr _remote_mac;
+    uint32_t _local_ipv4;
+    uint32_t _remote_ipv4;
+    uint16_t _local_port;
+    uint16_t _remote_port;
+
+    adapter_id_t _adapter_id;
+};
+
+}} // namespace uhd::transport
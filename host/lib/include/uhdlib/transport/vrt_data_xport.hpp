@@ -0,0 +1,359 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/transport/frame_buff.hpp>
+#include <uhd/transport/vrt_if_packet.hpp>
+#include <uhd/transport/zero_copy.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/utils/byteswap.hpp>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace uhd { namespace transport {
+
+/*!
+ * Pool of frame buffers that hold the managed buffers of a zero_copy_if
+ *
+ * This lets the streamers, which work with frame_buff objects, use the
+ * transports of devices that are not based on RFNoC. Frame buffers are only
+ * allocated when more are held at a time than ever before, so there are no
+ * allocations on the hot path.
+ */
+template <typename managed_buff_t>
+class managed_frame_buff_pool
+{
+public:
+    using managed_sptr = typename managed_buff_t::sptr;
+
+    //! Wraps a managed buffer into a frame buffer
+    UHD_FORCE_INLINE frame_buff::uptr get(managed_sptr managed_buff)
+    {
+        if (_free.empty()) {
+            _buffs.emplace_back(new buff_t());
+            _free.push_back(_buffs.back().get());
+        }
+        buff_t* buff = _free.back();
+        _free.pop_back();
+
+        buff->set(std::move(managed_buff));
+        return frame_buff::uptr(buff);
+    }
+
+    //! Returns the managed buffer held by a frame buffer, and frees the latter
+    UHD_FORCE_INLINE managed_sptr put(frame_buff::uptr buff)
+    {
+        buff_t* managed_frame  = static_cast<buff_t*>(buff.release());
+        managed_sptr underlying = managed_frame->release();
+        _free.push_back(managed_frame);
+        return underlying;
+    }
+
+private:
+    class buff_t : public frame_buff
+    {
+    public:
+        void set(managed_sptr buff)
+        {
+            _buff        = std::move(buff);
+            _data        = _buff->template cast<void*>();
+            _packet_size = _buff->size();
+        }
+
+        managed_sptr release()
+        {
+            _data        = nullptr;
+            _packet_size = 0;
+            managed_sptr buff;
+            buff.swap(_buff);
+            return buff;
+        }
+
+    private:
+        managed_sptr _buff;
+    };
+
+    std::vector<std::unique_ptr<buff_t>> _buffs;
+    std::vector<buff_t*> _free;
+};
+
+/*!
+ * Receive data transport for devices that send VRT or CHDR (RFNoC 3.0) data
+ * packets over a zero_copy_if, so they can use rx_streamer_impl.
+ *
+ * Inline messages, which the device sends instead of data when an error
+ * occurs, are passed to a message handler. The transport then returns as if
+ * it timed out, so the streamer handles the error before any data that
+ * follows it.
+ */
+class vrt_rx_data_xport
+{
+public:
+    using uptr   = std::unique_ptr<vrt_rx_data_xport>;
+    using buff_t = frame_buff;
+
+    //! Function to get a packet from the device, with a timeout in seconds
+    using get_buff_fn_t = std::function<managed_recv_buffer::sptr(const double)>;
+    //! Function to unpack the header of a packet
+    using unpack_fn_t = void (*)(const uint32_t*, vrt::if_packet_info_t&);
+    //! Function to handle the error code of an inline message
+    using msg_handler_t = std::function<void(const rx_metadata_t::error_code_t)>;
+
+    //! Values extracted from received RX data packets
+    struct packet_info_t
+    {
+        bool eob             = false;
+        bool eov             = false;
+        bool has_tsf         = false;
+        uint64_t tsf         = 0;
+        size_t payload_bytes = 0;
+        const void* payload  = nullptr;
+    };
+
+    /*!
+     * \param get_buff function to get a packet from the device
+     * \param unpack function to unpack the header of a packet
+     * \param max_payload_size the largest payload of a data packet, in bytes
+     * \param msg_handler function to handle inline messages
+     */
+    vrt_rx_data_xport(get_buff_fn_t get_buff,
+        unpack_fn_t unpack,
+        const size_t max_payload_size,
+        msg_handler_t msg_handler)
+        : _get_buff(get_buff)
+        , _unpack(unpack)
+        , _max_payload_size(max_payload_size)
+        , _msg_handler(msg_handler)
+    {
+    }
+
+    //! Returns the maximum payload size of a data packet, in bytes
+    size_t get_max_payload_size() const
+    {
+        return _max_payload_size;
+    }
+
+    /*!
+     * Gets an RX frame buffer containing a data packet
+     *
+     * \param timeout_ms timeout in milliseconds
+     * \return returns a tuple containing:
+     * - a frame_buff, or null if timeout occurs or an inline message arrived
+     * - info struct corresponding to the packet
+     * - whether the packet was out of sequence
+     * \throws uhd::value_error if the packet header is invalid
+     */
+    UHD_FORCE_INLINE std::tuple<frame_buff::uptr, packet_info_t, bool> get_recv_buff(
+        const int32_t timeout_ms)
+    {
+        managed_recv_buffer::sptr buff = _get_buff(timeout_ms / 1000.0);
+        if (!buff) {
+            return std::make_tuple(frame_buff::uptr(), packet_info_t(), false);
+        }
+
+        vrt::if_packet_info_t if_packet_info;
+        if_packet_info.num_packet_words32 = buff->size() / sizeof(uint32_t);
+        const uint32_t* vrt_hdr           = buff->cast<const uint32_t*>();
+        _unpack(vrt_hdr, if_packet_info);
+        const uint32_t* payload = vrt_hdr + if_packet_info.num_header_words32;
+
+        if (if_packet_info.packet_type != vrt::if_packet_info_t::PACKET_TYPE_DATA) {
+            // The context word may be in either endianness, so mirror the bytes
+            const uint32_t code = (payload[0] | uhd::byteswap(payload[0])) & 0xff;
+            if (_msg_handler) {
+                _msg_handler(rx_metadata_t::error_code_t(code));
+            }
+            return std::make_tuple(frame_buff::uptr(), packet_info_t(), false);
+        }
+
+        const size_t seq_mask =
+            (if_packet_info.link_type == vrt::if_packet_info_t::LINK_TYPE_NONE) ? 0xf
+                                                                                 : 0xfff;
+        const bool seq_error = if_packet_info.packet_count != _packet_count;
+        _packet_count        = (if_packet_info.packet_count + 1) & seq_mask;
+
+        packet_info_t info;
+        info.eob           = if_packet_info.eob;
+        info.has_tsf       = if_packet_info.has_tsf;
+        info.tsf           = if_packet_info.tsf;
+        info.payload_bytes = if_packet_info.num_payload_bytes;
+        info.payload       = payload;
+
+        return std::make_tuple(_buffs.get(std::move(buff)), info, seq_error);
+    }
+
+    /*!
+     * Releases an RX frame buffer
+     *
+     * \param buff the frame buffer to release
+     */
+    UHD_FORCE_INLINE void release_recv_buff(frame_buff::uptr buff)
+    {
+        _buffs.put(std::move(buff));
+    }
+
+private:
+    get_buff_fn_t _get_buff;
+    unpack_fn_t _unpack;
+    const size_t _max_payload_size;
+    msg_handler_t _msg_handler;
+
+    //! Expected sequence number of the next data packet
+    size_t _packet_count = 0;
+
+    managed_frame_buff_pool<managed_recv_buffer> _buffs;
+};
+
+/*!
+ * Transmit data transport for devices that receive VRT or CHDR (RFNoC 3.0)
+ * data packets over a zero_copy_if, so they can use tx_streamer_impl.
+ */
+class vrt_tx_data_xport
+{
+public:
+    using uptr   = std::unique_ptr<vrt_tx_data_xport>;
+    using buff_t = frame_buff;
+
+    //! Function to get a buffer to send, with a timeout in seconds
+    using get_buff_fn_t = std::function<managed_send_buffer::sptr(const double)>;
+    //! Function to pack the header of a packet
+    using pack_fn_t = void (*)(uint32_t*, vrt::if_packet_info_t&);
+
+    //! Values extracted from tx metadata to write to the packet header
+    struct packet_info_t
+    {
+        bool eob             = false;
+        bool eov             = false;
+        bool has_tsf         = false;
+        uint64_t tsf         = 0;
+        size_t payload_bytes = 0;
+    };
+
+    /*!
+     * \param get_buff function to get a buffer to send
+     * \param pack function to pack the header of a packet
+     * \param sid the stream ID to write into the packets
+     * \param max_payload_size the largest payload of a data packet, in bytes
+     */
+    vrt_tx_data_xport(get_buff_fn_t get_buff,
+        pack_fn_t pack,
+        const uint32_t sid,
+        const size_t max_payload_size)
+        : _get_buff(get_buff), _pack(pack), _max_payload_size(max_payload_size)
+    {
+        _if_packet_info.packet_type = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+        _if_packet_info.has_sid     = true;
+        _if_packet_info.sid         = sid;
+        _if_packet_info.has_cid     = false;
+        _if_packet_info.has_tsi     = false;
+        _if_packet_info.has_tlr     = false;
+        _if_packet_info.sob         = false;
+
+        // Pack an empty header with and without a timestamp to find out where
+        // the payload starts
+        uint32_t hdr[vrt::max_if_hdr_words32];
+        for (const bool has_tsf : {false, true}) {
+            vrt::if_packet_info_t if_packet_info = _if_packet_info;
+            if_packet_info.has_tsf               = has_tsf;
+            if_packet_info.tsf                   = 0;
+            if_packet_info.eob                   = false;
+            if_packet_info.num_payload_words32   = 0;
+            if_packet_info.num_payload_bytes     = 0;
+            if_packet_info.packet_count          = 0;
+            _pack(hdr, if_packet_info);
+            _payload_offset[has_tsf] =
+                if_packet_info.num_header_words32 * sizeof(uint32_t);
+        }
+    }
+
+    //! Returns the maximum payload size of a data packet, in bytes
+    size_t get_max_payload_size() const
+    {
+        return _max_payload_size;
+    }
+
+    /*!
+     * Gets a TX frame buffer
+     *
+     * \param timeout_ms timeout in milliseconds
+     * \return the frame buffer, or nullptr if timeout occurs
+     */
+    UHD_FORCE_INLINE frame_buff::uptr get_send_buff(const int32_t timeout_ms)
+    {
+        managed_send_buffer::sptr buff = _get_buff(timeout_ms / 1000.0);
+        if (!buff) {
+            return frame_buff::uptr();
+        }
+        return _buffs.get(std::move(buff));
+    }
+
+    /*!
+     * Sends a TX data packet
+     *
+     * \param buff the frame buffer containing the packet to send
+     */
+    UHD_FORCE_INLINE void release_send_buff(frame_buff::uptr buff)
+    {
+        const size_t packet_size            = buff->packet_size();
+        managed_send_buffer::sptr send_buff = _buffs.put(std::move(buff));
+        send_buff->commit(packet_size);
+    }
+
+    /*!
+     * Returns the offset of the payload from the start of the packet
+     *
+     * \param has_tsf whether the packet has a timestamp
+     */
+    UHD_FORCE_INLINE size_t get_payload_offset(const bool has_tsf) const
+    {
+        return _payload_offset[has_tsf];
+    }
+
+    /*!
+     * Writes header into frame buffer and returns payload pointer
+     *
+     * \param buff Frame buffer to write header into
+     * \param info Information to include in the header
+     * \return A pointer to the payload data area and the packet size in bytes
+     */
+    UHD_FORCE_INLINE std::pair<void*, size_t> write_packet_header(
+        frame_buff::uptr& buff, const packet_info_t& info)
+    {
+        uint32_t* packet_buff = static_cast<uint32_t*>(buff->data());
+
+        _if_packet_info.has_tsf             = info.has_tsf;
+        _if_packet_info.tsf                 = info.tsf;
+        _if_packet_info.eob                 = info.eob;
+        _if_packet_info.num_payload_bytes   = info.payload_bytes;
+        _if_packet_info.num_payload_words32 = (info.payload_bytes + 3) / sizeof(uint32_t);
+        _if_packet_info.packet_count        = _packet_count++;
+        _pack(packet_buff, _if_packet_info);
+
+        return std::make_pair(packet_buff + _if_packet_info.num_header_words32,
+            _if_packet_info.num_packet_words32 * sizeof(uint32_t));
+    }
+
+private:
+    get_buff_fn_t _get_buff;
+    pack_fn_t _pack;
+    const size_t _max_payload_size;
+
+    //! Header fields that are the same for all packets
+    vrt::if_packet_info_t _if_packet_info;
+    size_t _payload_offset[2];
+
+    //! Sequence number of the next data packet, wrapped by the packer
+    size_t _packet_count = 0;
+
+    managed_frame_buff_pool<managed_send_buffer> _buffs;
+};
+
+}} // namespace uhd::transport
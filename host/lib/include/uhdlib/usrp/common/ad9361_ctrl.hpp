@@ -111,6 +111,19 @@ public:
     //! tune the given frontend, return the exact value
     virtual double tune(const std::string& which, const double value) = 0;
 
+    /*! Precompute the synthesizer settings for a set of frequencies
+     *
+     * There is one hop set per direction, \p which only selects the direction.
+     * The frequencies are clipped to the RF frequency range.
+     *
+     * \return the exact values of the hop set entries
+     */
+    virtual std::vector<double> set_hop_set(
+        const std::string& which, const std::vector<double>& freqs) = 0;
+
+    //! tune the given frontend to an entry of its hop set, return the exact value
+    virtual double hop(const std::string& which, const size_t index) = 0;
+
     //! set the DC offset for I and Q manually
     void set_dc_offset(const std::string&, const std::complex<double>)
     {
@@ -19,6 +19,7 @@
 #include <boost/math/special_functions/round.hpp>
 #include <boost/thread.hpp>
 #include <functional>
+#include <set>
 #include <vector>
 
 class adf435x_iface
@@ -123,7 +124,19 @@ public:
     virtual double set_frequency(
         double target_freq, bool int_n_mode, bool flush = false) = 0;
 
+    /*! Write the registers that changed since the last commit()
+     *
+     * The first commit() writes all registers.
+     */
     virtual void commit(void) = 0;
+
+    /*! Make the next commit() write all registers
+     *
+     * Call this when the chip registers may no longer match what this object
+     * wrote, e.g., when the SPI transactions of another adf435x_iface went
+     * out to this chip, too.
+     */
+    virtual void invalidate_regs(void) = 0;
 };
 
 template <typename adf435x_regs_t>
@@ -136,6 +149,7 @@ public:
         , _fb_after_divider(false)
         , _reference_freq(0.0)
         , _N_min(-1)
+        , _rewrite_regs(true)
     {
     }
 
@@ -533,20 +547,39 @@ public:
 
     void commit()
     {
+        std::set<uint32_t> changed_regs;
+        if (!_rewrite_regs) {
+            changed_regs = _regs.template get_changed_addrs<uint32_t>();
+            if (changed_regs.empty()) {
+                return;
+            }
+        }
+
         // reset counters
         _regs.counter_reset = adf435x_regs_t::COUNTER_RESET_ENABLED;
         std::vector<uint32_t> regs;
         regs.push_back(_regs.get_reg(uint32_t(2)));
-        _write_fn(regs);
         _regs.counter_reset = adf435x_regs_t::COUNTER_RESET_DISABLED;
 
         // write the registers
         // correct power-up sequence to write registers (5, 4, 3, 2, 1, 0)
-        regs.clear();
+        // Register 2 must be written to release the counter reset, and register
+        // 0 to apply the double buffered fields and start the VCO band
+        // selection. The others are only written if they changed.
         for (int addr = 5; addr >= 0; addr--) {
-            regs.push_back(_regs.get_reg(uint32_t(addr)));
+            if (_rewrite_regs or addr == 2 or addr == 0
+                or changed_regs.count(uint32_t(addr))) {
+                regs.push_back(_regs.get_reg(uint32_t(addr)));
+            }
         }
         _write_fn(regs);
+        _regs.save_state();
+        _rewrite_regs = false;
+    }
+
+    void invalidate_regs()
+    {
+        _rewrite_regs = true;
     }
 
 protected:
@@ -559,6 +592,7 @@ protected:
     double _reference_freq;
     int _N_min;
     tuning_mode_t _tuning_mode;
+    bool _rewrite_regs;
 };
 
 template <>
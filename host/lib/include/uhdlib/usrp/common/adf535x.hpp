@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <functional>
 #include <iomanip>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -76,7 +77,20 @@ public:
 
     virtual uhd::meta_range_t get_charge_pump_current_range() = 0;
 
+    /*! Write the registers to the chip
+     *
+     * The first commit() writes all registers. After that, only the frequency
+     * update sequence is written, skipping registers that did not change.
+     */
     virtual void commit() = 0;
+
+    /*! Make the next commit() write all registers
+     *
+     * Call this when the chip registers may no longer match what this object
+     * wrote, e.g., when the SPI transactions of another adf535x_iface went
+     * out to this chip, too.
+     */
+    virtual void invalidate_regs() = 0;
 };
 
 using namespace uhd;
@@ -335,6 +349,12 @@ public:
     void commit() override
     {
         _commit();
+        _regs.save_state();
+    }
+
+    void invalidate_regs() override
+    {
+        _rewrite_regs = true;
     }
 
 protected:
@@ -342,6 +362,8 @@ protected:
     double _set_frequency(double, double, bool);
     uhd::meta_range_t _get_charge_pump_current_range();
     void _commit();
+    //! Returns the registers that changed, plus \p always_written if any did
+    std::set<uint32_t> _get_regs_to_update(const std::set<uint32_t>& always_written);
 
 private: // Members
     typedef std::vector<uint32_t> addr_vtr_t;
@@ -357,6 +379,19 @@ private: // Members
 };
 
 // ADF5355 Functions
+template <typename adf535x_regs_t>
+std::set<uint32_t> adf535x_impl<adf535x_regs_t>::_get_regs_to_update(
+    const std::set<uint32_t>& always_written)
+{
+    std::set<uint32_t> regs = _regs.template get_changed_addrs<uint32_t>();
+    // If nothing changed, the chip is already set up, and there's no need to
+    // run the sequence again
+    if (!regs.empty()) {
+        regs.insert(always_written.begin(), always_written.end());
+    }
+    return regs;
+}
+
 template <>
 inline uint8_t adf535x_impl<adf5355_regs_t>::_set_vco_band_div(double pfd_freq)
 {
@@ -484,18 +519,32 @@ inline void adf535x_impl<adf5355_regs_t>::_commit()
         _write_fn(addr_vtr_t(ONE_REG, _regs.get_reg(0)));
         _rewrite_regs = false;
     } else {
-        // Frequency update sequence from data sheet
-        _write_fn(addr_vtr_t(ONE_REG, _regs.get_reg(6)));
+        // Frequency update sequence from data sheet. The counter reset (R4) and
+        // the autocalibration (R0) always run, R6, R2 and R1 are only written
+        // if they changed.
+        const auto update = _get_regs_to_update({4, 0});
+        if (update.empty()) {
+            return;
+        }
+        addr_vtr_t regs;
+        if (update.count(6)) {
+            regs.push_back(_regs.get_reg(6));
+        }
         _regs.counter_reset = adf5355_regs_t::COUNTER_RESET_ENABLED;
-        _write_fn(addr_vtr_t(ONE_REG, _regs.get_reg(4)));
-        _write_fn(addr_vtr_t(ONE_REG, _regs.get_reg(2)));
-        _write_fn(addr_vtr_t(ONE_REG, _regs.get_reg(1)));
+        regs.push_back(_regs.get_reg(4));
+        if (update.count(2)) {
+            regs.push_back(_regs.get_reg(2));
+        }
+        if (update.count(1)) {
+            regs.push_back(_regs.get_reg(1));
+        }
         _regs.autocal_en = adf5355_regs_t::AUTOCAL_EN_DISABLED;
-        _write_fn(addr_vtr_t(ONE_REG, _regs.get_reg(0)));
+        regs.push_back(_regs.get_reg(0));
         _regs.counter_reset = adf5355_regs_t::COUNTER_RESET_DISABLED;
-        _write_fn(addr_vtr_t(ONE_REG, _regs.get_reg(4)));
+        regs.push_back(_regs.get_reg(4));
         _regs.autocal_en = adf5355_regs_t::AUTOCAL_EN_ENABLED;
-        _write_fn(addr_vtr_t(ONE_REG, _regs.get_reg(0)));
+        regs.push_back(_regs.get_reg(0));
+        _write_fn(regs);
     }
 }
 
@@ -628,11 +677,18 @@ inline void adf535x_impl<adf5356_regs_t>::_commit()
         _write_fn(addr_vtr_t(ONE_REG, _regs.get_reg(0)));
         _rewrite_regs = false;
     } else {
-        // Frequency update sequence from data sheet
-        _write_fn(addr_vtr_t(ONE_REG, _regs.get_reg(13)));
-        _write_fn(addr_vtr_t(ONE_REG, _regs.get_reg(6)));
-        _write_fn(addr_vtr_t(ONE_REG, _regs.get_reg(2)));
-        _write_fn(addr_vtr_t(ONE_REG, _regs.get_reg(1)));
-        _write_fn(addr_vtr_t(ONE_REG, _regs.get_reg(0)));
+        // Frequency update sequence from data sheet. R0 starts the
+        // autocalibration and is always written, the others only if they
+        // changed.
+        const auto update = _get_regs_to_update({0});
+        addr_vtr_t regs;
+        for (const uint32_t addr : {13, 6, 2, 1, 0}) {
+            if (update.count(addr)) {
+                regs.push_back(_regs.get_reg(addr));
+            }
+        }
+        if (!regs.empty()) {
+            _write_fn(regs);
+        }
     }
 }
@@ -9,6 +9,8 @@
 
 #include <uhd/config.hpp>
 #include <uhd/property_tree.hpp>
+#include <uhdlib/convert/iq_correction.hpp>
+#include <complex>
 #include <string>
 
 namespace uhd { namespace usrp {
@@ -73,5 +75,20 @@ void apply_rx_fe_corrections(property_tree::sptr sub_tree, // starts at mboards/
     const double rx_lo_freq // actual lo freq
 );
 
+/*! Return the RX IQ imbalance correction to apply on the host
+ *
+ * This is for radios that cannot correct the samples in the FPGA, and works
+ * like the FPGA would with the coefficient from the cal data. Pass the result
+ * to the streamer, see uhd::transport::rx_streamer_impl::set_iq_correction().
+ *
+ * \param db_serial Daughterboard serial
+ * \param rx_lo_freq The current LO frequency. Used to look up coefficients in the cal
+ *                   data set.
+ * \param dc_offset The DC offset to remove, full scale is 1.0
+ * \return The correction, which only removes \p dc_offset if there is no cal data
+ */
+uhd::convert::iq_correction_t get_rx_fe_iq_correction(const std::string& db_serial,
+    const double rx_lo_freq,
+    const std::complex<double>& dc_offset = {0.0, 0.0});
 
 }} // namespace uhd::usrp
@@ -0,0 +1,74 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/types/device_addr.hpp>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace uhd { namespace usrp {
+
+/*! Process-wide cache of recent device discovery results
+ *
+ * Discovery is slow: a broadcast waits for the discovery timeout on every
+ * interface, and USB devices may need to re-enumerate. Applications often
+ * call uhd::device::find() and then uhd::device::make() with the same hint,
+ * which runs the same discovery twice. The device finders therefore run their
+ * discovery through this cache, which keeps the results for a short time.
+ *
+ * Results are cached per finder and hint. Empty results are never cached, so
+ * a device that is still booting is found as soon as it responds. The time a
+ * result is kept can be set with the "find_cache_ttl" key of the hint (in
+ * seconds), a value of 0 bypasses the cache.
+ */
+class discovery_cache
+{
+public:
+    using find_fn_t = std::function<device_addrs_t(const device_addr_t&)>;
+    using clock_t   = std::chrono::steady_clock;
+
+    //! Hint key to override the time results are cached (in seconds)
+    static constexpr char TTL_KEY[] = "find_cache_ttl";
+    //! Default time results are cached (in seconds)
+    static constexpr double DEFAULT_TTL = 2.0;
+
+    //! Returns the cache shared by all device finders
+    static discovery_cache& get();
+
+    /*! Returns the cached results for a hint, or runs the discovery
+     *
+     * The cache is not locked while \p find_fn runs, so finders may call back
+     * into the cache, and concurrent discoveries don't serialize.
+     *
+     * \param finder The name of the device finder, e.g. "x300"
+     * \param hint The discovery hint
+     * \param find_fn The uncached discovery, called with \p hint if there are
+     *                no recent results
+     * \return the results of the discovery
+     */
+    device_addrs_t find(
+        const std::string& finder, const device_addr_t& hint, const find_fn_t& find_fn);
+
+    //! Drops all cached results
+    void clear();
+
+private:
+    struct entry_t
+    {
+        clock_t::time_point expiry;
+        device_addrs_t addrs;
+    };
+
+    std::mutex _mutex;
+    std::map<std::pair<std::string, std::string>, entry_t> _entries;
+};
+
+}} // namespace uhd::usrp
@@ -55,7 +55,7 @@ private:
         auto link = std::dynamic_pointer_cast<transport::udp_dpdk_link>(recv_link);
         port_id_t port_id = link->get_port()->get_port_id();
 
-        auto io_srv = _dpdk_ctx->get_io_service(port_id);
+        auto io_srv = _dpdk_ctx->get_io_service(port_id, link->get_local_port());
         UHD_ASSERT_THROW(io_srv);
         return io_srv;
     }
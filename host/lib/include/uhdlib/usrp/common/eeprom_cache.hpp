@@ -0,0 +1,65 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/types/byte_vector.hpp>
+#include <uhd/types/serial.hpp>
+#include <uhd/usrp/dboard_eeprom.hpp>
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <string>
+
+namespace uhd { namespace usrp { namespace eeprom_cache {
+
+/*! On-disk cache of EEPROM contents
+ *
+ * Some EEPROMs sit behind slow I2C buses, where every byte takes several
+ * register transactions, and are read every time a device is found or
+ * initialized. This cache keeps their contents on disk, so every process of
+ * a user can skip most of those reads.
+ *
+ * An entry is found by its key, which names the EEPROM (e.g., the serial of
+ * the motherboard and the I2C address of a daughterboard EEPROM). It's only
+ * used if its stamp matches: a few bytes the caller reads from the EEPROM
+ * itself, which change whenever the rest of the contents do, such as a
+ * serial and a checksum. That way, swapping or reprogramming a board by other
+ * means also invalidates its entry. Writers should still invalidate the entry
+ * of an EEPROM they change.
+ *
+ * The cache is stored in $XDG_CACHE_HOME/uhd/eeprom. Entries are written
+ * atomically, so concurrent processes see either the old or the new entry.
+ * Setting the environment variable UHD_EEPROM_CACHE_DISABLE disables the
+ * cache. Errors accessing it are never fatal, they're treated like a miss.
+ */
+
+//! Return the cached contents for \p key, if its stamp matches \p stamp
+boost::optional<byte_vector_t> get(const std::string& key, const byte_vector_t& stamp);
+
+//! Store the contents of an EEPROM
+void put(
+    const std::string& key, const byte_vector_t& stamp, const byte_vector_t& contents);
+
+//! Drop all entries with keys that start with \p key_prefix
+void invalidate(const std::string& key_prefix);
+
+/*! Load a daughterboard EEPROM from the cache if it's still valid
+ *
+ * This reads the magic byte, the serial, and the checksum of the EEPROM, and
+ * only reads the rest on a cache miss. The result matches
+ * dboard_eeprom_t::load().
+ *
+ * \param eeprom The EEPROM object to load into
+ * \param iface The I2C interface of the EEPROM
+ * \param addr The I2C address of the EEPROM
+ * \param key The cache key of the EEPROM
+ */
+void load_dboard_eeprom(dboard_eeprom_t& eeprom,
+    i2c_iface& iface,
+    const uint8_t addr,
+    const std::string& key);
+
+}}} // namespace uhd::usrp::eeprom_cache
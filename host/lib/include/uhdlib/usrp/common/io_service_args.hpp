@@ -21,13 +21,41 @@ namespace uhd { namespace usrp {
  *               to use an inline I/O service.
  * recv_offload_wait_mode: set to "poll" to use a polling strategy in the offload
  *                         thread, set to "block" to use a blocking strategy.
+ *                         Set to "hybrid" to spin for up to hybrid_spin_us
+ *                         before blocking, in the offload thread and the
+ *                         streamer. This also applies to the inline I/O
+ *                         service if recv_offload is false.
  * send_offload_wait_mode: set to "poll" to use a polling strategy in the offload
  *                         thread, set to "block" to use a blocking strategy.
+ *                         Set to "hybrid" to spin before blocking, as above.
+ * hybrid_spin_us: the longest time in microseconds to spin before blocking, if
+ *                 a wait mode is set to "hybrid". The time spent spinning
+ *                 adapts to the interval between packets. The default is 100.
  * num_poll_offload_threads: set to the total number of offload threads to use for
- *                           RX_DATA and TX_DATA in this rfnoc_graph. New connections
- *                           always go to the offload thread containing the fewest
- *                           connections, with lowest numbered thread as a second
- *                           criterion. The default is 1.
+ *                           RX_DATA and TX_DATA in this rfnoc_graph. The threads
+ *                           move links among each other at run time to balance
+ *                           the packet rates they handle, the packets of each
+ *                           link stay in order. With poll_shared_recv_frames,
+ *                           links are assigned statically instead: new
+ *                           connections go to the offload thread containing the
+ *                           fewest connections, with lowest numbered thread as a
+ *                           second criterion. The default is 1.
+ * poll_shared_recv_frames: the number of receive frames that each polling
+ *                          offload thread shares among its RX_DATA links. A
+ *                          link borrows from these when all of its own
+ *                          num_recv_frames are in use, so links can be given
+ *                          fewer frames of their own. Only UDP links without
+ *                          DPDK or recv_batch use shared frames. The value
+ *                          from the first connection to a thread applies.
+ *                          The default is 0.
+ * poll_offload_pool: set to "process" to share the polling offload threads with
+ *                    the links of all other rfnoc_graphs in the process that set
+ *                    it, too. This way, several devices can run their streams on
+ *                    a few threads. num_poll_offload_threads and
+ *                    poll_offload_thread_<N>_cpu then describe the threads of
+ *                    this process-wide pool, which are created with the args of
+ *                    the first connection that needs them. The default, "graph",
+ *                    gives each rfnoc_graph its own threads.
  * recv_offload_thread_<N>_cpu: an integer to specify cpu affinity of the offload
  *                              thread. N indicates the thread instance, starting
  *                              with 0 for each streamer and ending with the number
@@ -42,10 +70,20 @@ namespace uhd { namespace usrp {
  *                              thread. N indicates the thread instance, starting
  *                              with 0 and up to num_poll_offload_threads minus 1.
  *                              Only used if the I/O service is configured to poll.
+ * offload_thread_placement: set to "auto" to pin offload threads that have no
+ *                           cpu affinity arg to a core on the NUMA node of their
+ *                           NIC, away from the NIC's interrupts and the
+ *                           streamer threads (see offload_thread_placement).
+ *                           The default, "manual", only uses the cpu affinity
+ *                           args.
  */
 struct io_service_args_t
 {
-    enum wait_mode_t { POLL, BLOCK };
+    enum wait_mode_t { POLL, BLOCK, HYBRID };
+
+    enum placement_t { PLACEMENT_MANUAL, PLACEMENT_AUTO };
+
+    enum pool_t { POOL_GRAPH, POOL_PROCESS };
 
     //! Whether to offload streaming I/O to a worker thread
     bool recv_offload = false;
@@ -59,9 +97,18 @@ struct io_service_args_t
     //! Whether the offload thread should poll or block
     wait_mode_t send_offload_wait_mode = BLOCK;
 
+    //! Longest time to spin before blocking, if wait_mode is set to HYBRID
+    size_t hybrid_spin_us = 100;
+
     //! Number of polling threads to use, if wait_mode is set to POLL
     size_t num_poll_offload_threads = 1;
 
+    //! Number of receive frames each polling thread shares among its links
+    size_t poll_shared_recv_frames = 0;
+
+    //! Which connections share the polling offload threads
+    pool_t poll_offload_pool = POOL_GRAPH;
+
     //! CPU affinity of offload threads, if wait_mode is set to BLOCK
     std::map<size_t, size_t> recv_offload_thread_cpu;
 
@@ -70,6 +117,9 @@ struct io_service_args_t
 
     //! CPU affinity of offload threads, if wait_mode is set to POLL
     std::map<size_t, size_t> poll_offload_thread_cpu;
+
+    //! How to pick the CPUs of offload threads without an affinity arg
+    placement_t offload_thread_placement = PLACEMENT_MANUAL;
 };
 
 /*! Reads I/O service args from provided dictionary
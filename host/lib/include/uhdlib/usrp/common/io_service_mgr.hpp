@@ -32,7 +32,9 @@ namespace uhd { namespace usrp {
  * If polling I/O services are requested, the I/O service manager instantiates
  * the number of I/O services specified by the user through args. It chooses
  * which I/O service to connect a set of links to by selecting the I/O service
- * with the fewest number of connections.
+ * with the fewest number of connections. With poll_offload_pool=process, the
+ * polling I/O services are shared by the I/O service managers of all devices in
+ * the process instead, so the links of several devices share the same threads.
  *
  * If blocking I/O services are requested, the I/O service manager instantiates
  * one offload I/O service for each transport adapter used by a streamer. When
@@ -0,0 +1,125 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/types/device_addr.hpp>
+#include <uhdlib/rfnoc/rfnoc_common.hpp>
+#include <boost/optional.hpp>
+
+namespace uhd { namespace usrp {
+
+/*! Settings of the streaming path that follow from the latency_mode arg
+ *
+ * The latency_mode arg configures all stages of the streaming path at once. It
+ * can be a stream arg, or a device arg that applies to all streamers of the
+ * device. Its values are:
+ *
+ * default: leaves the streaming path as it is.
+ * ultra:   minimizes the turnaround through the host, at the expense of
+ *          throughput and CPU time:
+ *          - Packets of ULTRA_SPP samples, and ULTRA_NUM_FRAMES frames per
+ *            link, so few samples wait in a packet or in a queue.
+ *          - A flow control window of at most ULTRA_NUM_FRAMES packets per
+ *            transport, so the device can't queue up more than that.
+ *          - The host acks every RX packet, and the device reports TX flow
+ *            control status once per packet of the window.
+ *          - Inline I/O in hybrid wait mode: the streamer thread polls its
+ *            links itself, with no offload thread in between.
+ *          - The thread that creates the streamer, which runs its inline I/O,
+ *            gets real-time priority and stays on the CPU it runs on, or on
+ *            the CPU given by the streamer_thread_cpu arg.
+ *
+ * Args that the user sets, either as stream args or as device args, take
+ * precedence over the ones that a latency mode implies.
+ */
+struct latency_mode_args_t
+{
+    enum mode_t { DEFAULT, ULTRA };
+
+    mode_t mode = DEFAULT;
+
+    //! Fraction of the RX window after which the host sends flow control acks
+    double rx_fc_freq_ratio = 1.0 / 32;
+
+    //! Whether the host sends a flow control ack for every RX packet
+    bool rx_fc_ack_every_pkt = false;
+
+    //! Fraction of the TX window after which the device sends flow control status
+    double tx_fc_freq_ratio = 1.0 / 8;
+
+    //! Most packets in flight per transport, 0 for the full buffer
+    size_t max_fc_window_pkts = 0;
+
+    //! Whether the thread that creates a streamer is made real-time and pinned
+    bool realtime_thread = false;
+
+    //! CPU to pin the streamer thread to, instead of the one it runs on
+    boost::optional<size_t> streamer_thread_cpu;
+};
+
+//! Samples per packet in ultra latency mode
+constexpr size_t ULTRA_SPP = 64;
+
+//! Frames per link and packets per flow control window in ultra latency mode
+constexpr size_t ULTRA_NUM_FRAMES = 32;
+
+//! Fraction of the TX window after which the device sends status in ultra mode
+constexpr double ULTRA_TX_FC_FREQ_RATIO = 1.0 / ULTRA_NUM_FRAMES;
+
+/*! Reads the latency mode args from a dictionary
+ *
+ * \param args The stream args, after apply_latency_mode()
+ * \return The latency mode args
+ * \throws uhd::value_error if latency_mode has an unknown value
+ */
+latency_mode_args_t read_latency_mode_args(const device_addr_t& args);
+
+/*! Expands the latency_mode arg into the stream args that it implies
+ *
+ * Stream args and device args that are set are kept. The resolved
+ * configuration of the streaming path is logged, unless the latency mode is
+ * "default".
+ *
+ * \param stream_args The stream args provided when a streamer is created
+ * \param dev_args The device args provided when the graph is created
+ * \return The stream args, with latency_mode and the args it implies
+ */
+device_addr_t apply_latency_mode(
+    const device_addr_t& stream_args, const device_addr_t& dev_args);
+
+/*! Returns the largest flow control window that the latency mode allows
+ *
+ * \param args The latency mode args
+ * \param frame_size The size of the link frames, in bytes
+ * \return The largest window, or the largest one flow control supports
+ */
+rfnoc::stream_buff_params_t get_max_fc_capacity(
+    const latency_mode_args_t& args, const size_t frame_size);
+
+/*! Returns the frequency of RX flow control acks
+ *
+ * Flow control uses either bytes only or packets only.
+ *
+ * \param args The latency mode args
+ * \param capacity The RX flow control window
+ * \param packet_fc Whether flow control uses packets
+ * \return The flow control frequency
+ */
+rfnoc::stream_buff_params_t get_rx_fc_freq(const latency_mode_args_t& args,
+    const rfnoc::stream_buff_params_t& capacity,
+    const bool packet_fc);
+
+/*! Sets up the calling thread as a streamer thread of the latency mode
+ *
+ * Does nothing unless realtime_thread is set. Failures are logged, but not
+ * fatal.
+ *
+ * \param args The latency mode args
+ */
+void setup_latency_mode_thread(const latency_mode_args_t& args);
+
+}} // namespace uhd::usrp
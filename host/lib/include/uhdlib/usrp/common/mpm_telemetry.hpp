@@ -0,0 +1,74 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/types/sensors.hpp>
+#include <uhdlib/utils/rpc.hpp>
+#include <boost/optional.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace uhd { namespace usrp {
+
+//! A decoded MPM telemetry record
+struct mpm_telemetry_record_t
+{
+    //! Sequence number, counts up by one for every record MPM sends
+    uint32_t seq;
+    //! System time of the device when the values were read (ns since the epoch)
+    uint64_t timestamp_ns;
+    //! The sensor values, by the key that's used to read them via RPC
+    std::map<std::string, uhd::sensor_value_t> values;
+};
+
+/*! Unpack a telemetry record
+ *
+ * See mpm/python/usrp_mpm/telemetry.py for the record format.
+ *
+ * \throws uhd::value_error if the record is malformed
+ */
+mpm_telemetry_record_t unpack_mpm_telemetry_record(const uint8_t* data, const size_t len);
+
+/*! Receives the telemetry records of an MPM device
+ *
+ * MPM can push a telemetry record with motherboard sensor values to a UDP
+ * port at a fixed rate. This subscribes to those records, keeps the
+ * subscription alive, and caches the latest value of every sensor, so reading
+ * one doesn't take an RPC round trip.
+ *
+ * Values that haven't been updated for a few record periods are stale and are
+ * not handed out, so callers fall back to reading the sensor via RPC when the
+ * records stop coming in (e.g., because they're dropped by a firewall).
+ */
+class mpm_telemetry_receiver
+{
+public:
+    using sptr = std::shared_ptr<mpm_telemetry_receiver>;
+
+    //! Device arg key for the record rate (in Hz). Telemetry is off without it.
+    static constexpr char RATE_KEY[] = "telemetry_rate";
+
+    virtual ~mpm_telemetry_receiver() = default;
+
+    //! Returns the latest value of sensor \p key, or nothing if it's stale
+    virtual boost::optional<uhd::sensor_value_t> get_value(const std::string& key) = 0;
+
+    /*! Subscribe to the telemetry records of a device
+     *
+     * \param rpc The RPC client of the device
+     * \param mgmt_addr The management address of the device. Records that come
+     *                  from other addresses are ignored.
+     * \param rate The number of records per second
+     */
+    static sptr make(
+        uhd::rpc_client::sptr rpc, const std::string& mgmt_addr, const double rate);
+};
+
+}} // namespace uhd::usrp
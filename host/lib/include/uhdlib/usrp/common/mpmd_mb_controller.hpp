@@ -7,6 +7,7 @@
 #pragma once
 
 #include <uhd/rfnoc/mb_controller.hpp>
+#include <uhdlib/usrp/common/mpm_telemetry.hpp>
 #include <uhdlib/utils/rpc.hpp>
 #include <memory>
 
@@ -23,7 +24,15 @@ class mpmd_mb_controller : public mb_controller
 public:
     using sptr = std::shared_ptr<mpmd_mb_controller>;
 
-    mpmd_mb_controller(uhd::rpc_client::sptr rpcc, uhd::device_addr_t device_info);
+    /*!
+     * \param rpcc The RPC client of the device
+     * \param device_info The device info that MPM reports
+     * \param telemetry If given, sensor values that are in its records are
+     *                  read from there instead of via RPC
+     */
+    mpmd_mb_controller(uhd::rpc_client::sptr rpcc,
+        uhd::device_addr_t device_info,
+        uhd::usrp::mpm_telemetry_receiver::sptr telemetry = nullptr);
 
     //! Return reference to the RPC client
     uhd::rpc_client::sptr get_rpc_client()
@@ -83,6 +92,9 @@ public:
     void set_time_source_out(const bool enb);
     uhd::sensor_value_t get_sensor(const std::string& name);
     std::vector<std::string> get_sensor_names();
+    //! Reads all sensors that telemetry doesn't cover in a single RPC round trip
+    std::vector<uhd::sensor_value_t> get_sensors(const std::vector<std::string>& names);
+
     uhd::usrp::mboard_eeprom_t get_eeprom();
     std::vector<std::string> get_gpio_banks() const;
     std::vector<std::string> get_gpio_srcs(const std::string& bank) const;
@@ -98,6 +110,9 @@ private:
 
     uhd::device_addr_t _device_info;
 
+    //! Telemetry receiver, may be null
+    uhd::usrp::mpm_telemetry_receiver::sptr _telemetry;
+
     //! List of MB sensor names
     std::unordered_set<std::string> _sensor_names;
 
@@ -0,0 +1,95 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <boost/optional.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace uhd { namespace usrp {
+
+/*! CPU topology of the host, as far as placing threads is concerned
+ */
+struct cpu_topology_t
+{
+    //! The CPUs of each NUMA node
+    std::map<int, std::vector<size_t>> node_cpus;
+
+    //! The hyperthread siblings of each CPU, including the CPU itself
+    std::map<size_t, std::vector<size_t>> siblings;
+
+    /*! Reads the topology of this machine
+     *
+     * \return the topology, which is empty if it cannot be determined
+     */
+    static cpu_topology_t read_system();
+};
+
+/*! Placement policy for the offload threads of I/O services
+ *
+ * Places each offload thread on a CPU of the NUMA node of the NIC it serves.
+ * Among the CPUs of that node, it avoids, in this order:
+ * - CPUs that already run an offload thread placed by this policy
+ * - CPUs that the streamer threads run on, and their hyperthread siblings
+ * - Hyperthread siblings of CPUs that run an offload thread
+ * - CPUs that handle the interrupts of the NIC
+ *
+ * If the NUMA node of the NIC is unknown, all CPUs are considered.
+ */
+class offload_thread_placement
+{
+public:
+    offload_thread_placement(const cpu_topology_t& topology);
+
+    /*! Picks a CPU for a new offload thread
+     *
+     * \param numa_node The NUMA node of the NIC, or a negative value if it is
+     *                  unknown
+     * \param irq_cpus The CPUs that handle interrupts of the NIC
+     * \param streamer_cpus The CPUs that the streamer threads run on. Empty if
+     *                      the streamer threads may run on any CPU.
+     * \return the CPU to pin the thread to, or boost::none if the topology of
+     *         the host is unknown
+     */
+    boost::optional<size_t> pick_cpu(const int numa_node,
+        const std::vector<size_t>& irq_cpus,
+        const std::vector<size_t>& streamer_cpus);
+
+    /*! Releases a CPU returned by pick_cpu() once its thread exits
+     */
+    void release_cpu(const size_t cpu);
+
+private:
+    cpu_topology_t _topology;
+
+    //! Number of offload threads placed on each CPU
+    std::map<size_t, size_t> _num_threads;
+};
+
+/*! Parses a CPU list in the format used by the Linux kernel, e.g. "0-3,8"
+ *
+ * \return the CPUs in the list, in ascending order
+ */
+UHD_API std::vector<size_t> parse_cpu_list(const std::string& cpu_list);
+
+/*! Returns the CPUs that handle the interrupts of a network interface
+ *
+ * \param ifname The name of the network interface
+ * \return the CPUs, empty if they cannot be determined
+ */
+std::vector<size_t> get_irq_cpus_of_ifname(const std::string& ifname);
+
+/*! Returns the CPUs that the calling thread may run on
+ *
+ * \return the CPUs, empty if the thread may run on any CPU or the affinity
+ *         cannot be determined
+ */
+std::vector<size_t> get_current_thread_cpus();
+
+}} // namespace uhd::usrp
@@ -0,0 +1,74 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace uhd { namespace usrp {
+
+/*! Process-wide cache of the path MTUs between the host and devices
+ *
+ * Probing the path MTU sends a series of echo packets, and every packet that
+ * is too large costs a timeout. Applications that make the same device over
+ * and over would probe the same path every time. The results are therefore
+ * cached per local interface and device address, for as long as the path is
+ * unlikely to change.
+ */
+class path_mtu_cache
+{
+public:
+    using probe_fn_t = std::function<size_t()>;
+    using clock_t    = std::chrono::steady_clock;
+
+    //! Device arg to override the time results are cached (in seconds)
+    static constexpr char TTL_KEY[] = "mtu_cache_ttl";
+    //! Default time results are cached (in seconds)
+    static constexpr double DEFAULT_TTL = 300.0;
+
+    //! Returns the cache shared by all devices
+    static path_mtu_cache& get();
+
+    /*! Returns the cached path MTU, or probes it
+     *
+     * The cache is not locked while \p probe_fn runs, so paths to several
+     * devices can be probed at the same time.
+     *
+     * \param ifname The local network interface of the path
+     * \param addr The address of the device
+     * \param probe_fn Probes the path, and returns the largest frame that
+     *                 makes it through. Exceptions are passed on, and nothing
+     *                 is cached then.
+     * \param ttl The time to keep the result, in seconds. A value of 0
+     *            bypasses the cache.
+     * \return the path MTU
+     */
+    size_t get_mtu(const std::string& ifname,
+        const std::string& addr,
+        const probe_fn_t& probe_fn,
+        const double ttl = DEFAULT_TTL);
+
+    //! Drops all cached results
+    void clear();
+
+private:
+    struct entry_t
+    {
+        clock_t::time_point expiry;
+        size_t mtu;
+    };
+
+    std::mutex _mutex;
+    std::map<std::pair<std::string, std::string>, entry_t> _entries;
+};
+
+}} // namespace uhd::usrp
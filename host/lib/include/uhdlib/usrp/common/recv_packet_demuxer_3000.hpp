@@ -12,15 +12,28 @@
 #include <uhd/types/time_spec.hpp>
 #include <uhd/utils/byteswap.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhdlib/utils/spsc_queue.hpp>
 #include <stdint.h>
-#include <boost/thread.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
-#include <map>
+#include <limits>
 #include <memory>
-#include <queue>
+#include <mutex>
 
 namespace uhd { namespace usrp {
 
+/*! Demultiplexes the packets of a shared transport by their SID
+ *
+ * Every SID has its own lock-free SPSC queue. The transport itself is read by
+ * whichever caller of get_recv_buff() wins it: that caller is the producer of
+ * all queues until it has its own packet (or times out), and hands the packets
+ * of the other SIDs to their queues. Everybody else waits on their queue, so
+ * neither side takes a lock while streaming.
+ *
+ * Each SID must only be received from one thread at a time.
+ */
 struct recv_packet_demuxer_3000 : std::enable_shared_from_this<recv_packet_demuxer_3000>
 {
     typedef std::shared_ptr<recv_packet_demuxer_3000> sptr;
@@ -36,75 +49,182 @@ struct recv_packet_demuxer_3000 : std::enable_shared_from_this<recv_packet_demux
     transport::managed_recv_buffer::sptr get_recv_buff(
         const uint32_t sid, const double timeout)
     {
-        const auto exit_time = std::chrono::high_resolution_clock::now()
-                               + std::chrono::microseconds(int64_t(timeout * 1e6));
+        using clock = std::chrono::steady_clock;
+        const auto exit_time =
+            clock::now() + std::chrono::microseconds(int64_t(timeout * 1e6));
+        sid_queue_t& queue = _get_queue(sid);
         transport::managed_recv_buffer::sptr buff;
-        buff = _internal_get_recv_buff(sid, timeout);
-        while (not buff) // loop until timeout
-        {
-            const auto delta = exit_time - std::chrono::high_resolution_clock::now();
-            const double new_timeout =
-                std::chrono::duration_cast<std::chrono::duration<double>>(delta).count();
-            if (new_timeout < 0.0) {
-                break;
+        while (true) {
+            // An empty buffer only wakes us up to try to read the transport
+            while (queue.buffs.pop(buff)) {
+                if (buff) {
+                    return buff;
+                }
+            }
+
+            const auto remaining = exit_time - clock::now();
+            if (_try_claim_xport()) {
+                buff = _recv_from_xport(sid, exit_time);
+                _release_xport();
+                if (buff) {
+                    return buff;
+                }
+            } else if (remaining > clock::duration::zero()) {
+                // Wait for the reader to pass us a packet, or to release the
+                // transport. If it was released before we said that we're
+                // waiting, nobody would wake us up, so check again.
+                queue.waiting.store(true);
+                if (_xport_claimed.load()) {
+                    const int64_t remaining_ms =
+                        std::chrono::duration_cast<std::chrono::microseconds>(remaining)
+                            .count()
+                            / 1000
+                        + 1;
+                    const int32_t timeout_ms = int32_t(std::min<int64_t>(
+                        remaining_ms, std::numeric_limits<int32_t>::max()));
+                    if (queue.buffs.pop(buff, timeout_ms) && buff) {
+                        queue.waiting.store(false);
+                        return buff;
+                    }
+                }
+                queue.waiting.store(false);
+                continue;
+            }
+            if (clock::now() >= exit_time) {
+                return buff;
             }
-            buff = _internal_get_recv_buff(sid, new_timeout);
         }
-        return buff;
     }
 
-    transport::managed_recv_buffer::sptr _internal_get_recv_buff(
-        const uint32_t sid, const double timeout)
+    //! Drop all packets queued for a SID
+    void realloc_sid(const uint32_t sid)
     {
+        sid_queue_t& queue = _get_queue(sid);
         transport::managed_recv_buffer::sptr buff;
+        while (queue.buffs.pop(buff)) {
+        }
+    }
 
-        //----------------------------------------------------------
-        //-- Check the queue to see if we already have a buffer
-        //----------------------------------------------------------
+    transport::zero_copy_if::sptr make_proxy(const uint32_t sid);
+
+private:
+    //! The most SIDs that one transport carries
+    static constexpr size_t MAX_SIDS = 16;
+
+    struct sid_queue_t
+    {
+        sid_queue_t(const uint32_t sid_, const size_t capacity)
+            : sid(sid_), buffs(capacity)
         {
-            boost::mutex::scoped_lock l(mutex);
-            queue_type_t& queue = _queues[sid];
-            if (not queue.empty()) {
-                buff = queue.front();
-                queue.front().reset();
-                queue.pop();
-                return buff;
+        }
+
+        const uint32_t sid;
+        spsc_queue<transport::managed_recv_buffer::sptr> buffs;
+        //! Set while the receiver of this SID waits for the transport reader
+        std::atomic<bool> waiting{false};
+    };
+
+    //! Find the queue of a SID. Returns nullptr if the SID has no queue.
+    sid_queue_t* _find_queue(const uint32_t sid)
+    {
+        const size_t num_queues = _num_queues.load(std::memory_order_acquire);
+        for (size_t i = 0; i < num_queues; i++) {
+            if (_queues[i]->sid == sid) {
+                return _queues[i].get();
             }
         }
-        {
-            buff = _xport->get_recv_buff(timeout);
-            if (buff) {
-                const uint32_t new_sid = uhd::wtohx(buff->cast<const uint32_t*>()[1]);
-                if (new_sid != sid) {
-                    boost::mutex::scoped_lock l(mutex);
-                    if (_queues.count(new_sid) == 0)
-                        UHD_LOGGER_ERROR("STREAMER")
-                            << "recv packet demuxer unexpected sid 0x" << std::hex
-                            << new_sid << std::dec;
-                    else
-                        _queues[new_sid].push(buff);
-                    buff.reset();
+        return nullptr;
+    }
+
+    //! Find the queue of a SID, and create it if it doesn't exist yet
+    sid_queue_t& _get_queue(const uint32_t sid)
+    {
+        if (sid_queue_t* queue = _find_queue(sid)) {
+            return *queue;
+        }
+        std::lock_guard<std::mutex> l(_queues_mutex);
+        if (sid_queue_t* queue = _find_queue(sid)) {
+            return *queue;
+        }
+        const size_t num_queues = _num_queues.load(std::memory_order_relaxed);
+        if (num_queues == MAX_SIDS) {
+            throw uhd::runtime_error("recv packet demuxer: Too many SIDs");
+        }
+        // Every frame of the transport can be in a queue, plus one wake-up
+        _queues[num_queues].reset(
+            new sid_queue_t(sid, _xport->get_num_recv_frames() + 1));
+        _num_queues.store(num_queues + 1, std::memory_order_release);
+        return *_queues[num_queues];
+    }
+
+    bool _try_claim_xport()
+    {
+        bool claimed = false;
+        return _xport_claimed.compare_exchange_strong(claimed, true);
+    }
+
+    //! Release the transport, and wake up the receivers that wait for it
+    void _release_xport()
+    {
+        while (true) {
+            bool any_waiting = false;
+            const size_t num_queues = _num_queues.load(std::memory_order_acquire);
+            for (size_t i = 0; i < num_queues; i++) {
+                if (_queues[i]->waiting.exchange(false)) {
+                    // We're still the producer of all queues here
+                    _queues[i]->buffs.push(transport::managed_recv_buffer::sptr());
                 }
             }
+            _xport_claimed.store(false);
+            // A receiver that started waiting just now relies on us to wake it
+            for (size_t i = 0; i < num_queues; i++) {
+                any_waiting = any_waiting || _queues[i]->waiting.load();
+            }
+            if (!any_waiting || !_try_claim_xport()) {
+                return;
+            }
         }
-        return buff;
     }
 
-    void realloc_sid(const uint32_t sid)
+    /*! Read the transport until a packet for sid arrives (transport claimed)
+     *
+     * Once the time is up, this still takes the packets that are ready.
+     */
+    template <typename time_point_type>
+    transport::managed_recv_buffer::sptr _recv_from_xport(
+        const uint32_t sid, const time_point_type& exit_time)
     {
-        boost::mutex::scoped_lock l(mutex);
-        while (not _queues[sid].empty()) // allocated and clears if already allocated
-        {
-            _queues[sid].pop();
+        using clock = std::chrono::steady_clock;
+        while (true) {
+            const double timeout =
+                std::chrono::duration<double>(exit_time - clock::now()).count();
+            transport::managed_recv_buffer::sptr buff =
+                _xport->get_recv_buff(std::max(timeout, 0.0));
+            if (!buff) {
+                return buff;
+            }
+            const uint32_t new_sid = uhd::wtohx(buff->cast<const uint32_t*>()[1]);
+            if (new_sid == sid) {
+                return buff;
+            }
+            sid_queue_t* queue = _find_queue(new_sid);
+            if (!queue) {
+                UHD_LOGGER_ERROR("STREAMER") << "recv packet demuxer unexpected sid 0x"
+                                             << std::hex << new_sid << std::dec;
+            } else if (!queue->buffs.push(buff)) {
+                UHD_LOGGER_ERROR("STREAMER")
+                    << "recv packet demuxer dropped a packet for sid 0x" << std::hex
+                    << new_sid << std::dec;
+            }
         }
     }
 
-    transport::zero_copy_if::sptr make_proxy(const uint32_t sid);
-
-    typedef std::queue<transport::managed_recv_buffer::sptr> queue_type_t;
-    std::map<uint32_t, queue_type_t> _queues;
     transport::zero_copy_if::sptr _xport;
-    boost::mutex mutex;
+    std::array<std::unique_ptr<sid_queue_t>, MAX_SIDS> _queues;
+    std::atomic<size_t> _num_queues{0};
+    std::mutex _queues_mutex;
+    //! True while a caller of get_recv_buff() reads the transport
+    std::atomic<bool> _xport_claimed{false};
 };
 
 struct recv_packet_demuxer_proxy_3000 : transport::zero_copy_if
@@ -19,12 +19,23 @@ public:
     using sptr        = std::shared_ptr<dma_fifo_core_3000>;
     using poke32_fn_t = std::function<void(uint32_t, uint32_t)>;
     using peek32_fn_t = std::function<uint32_t(uint32_t)>;
+    using peek64_fn_t = std::function<uint64_t(uint32_t)>;
 
     virtual ~dma_fifo_core_3000(void) = 0;
 
-    //! Create a DMA FIFO controller for a specific channel
-    static sptr make(
-        poke32_fn_t&& poke_fn, peek32_fn_t&& peek_fn, const size_t fifo_index);
+    /*! Create a DMA FIFO controller for a specific channel
+     *
+     * \param poke_fn Register write function
+     * \param peek_fn Register read function
+     * \param fifo_index The channel of the FIFO
+     * \param peek64_fn Optional function to read a 64-bit register in a single
+     *                  transaction. Without it, 64-bit registers are read with
+     *                  two calls to \p peek_fn.
+     */
+    static sptr make(poke32_fn_t&& poke_fn,
+        peek32_fn_t&& peek_fn,
+        const size_t fifo_index,
+        peek64_fn_t&& peek64_fn = peek64_fn_t());
 
     /**************************************************************************
      * API
@@ -34,6 +45,9 @@ public:
     //! Return the fullness of the FIFO in bytes
     virtual uint64_t get_fifo_fullness() = 0;
 
+    //! Return the size of the FIFO in bytes
+    virtual uint64_t get_fifo_size() const = 0;
+
     //! Get the transfer timeout value for the transfer in memory interface
     // clock cycles
     virtual uint16_t get_fifo_timeout() = 0;
@@ -13,6 +13,7 @@
 #include <uhd/utils/noncopyable.hpp>
 #include <functional>
 #include <memory>
+#include <vector>
 
 class spi_core_3000 : uhd::noncopyable, public uhd::spi_iface
 {
@@ -35,4 +36,21 @@ public:
 
     //! Set the spi clock divider to something usable
     virtual void set_divider(const double div) = 0;
+
+    /*! Write several words to the same slave
+     *
+     * This is the same as calling write_spi() for every word, but the core is
+     * only locked and configured once, and the data words are written back to
+     * back. Like write_spi(), the writes use the timing of the register
+     * interface, e.g., the current command time.
+     *
+     * \param which_slave the slave device number
+     * \param config spi config args
+     * \param data the words to write, in order
+     * \param num_bits how many bits in every word
+     */
+    virtual void write_spi_batch(int which_slave,
+        const uhd::spi_config_t& config,
+        const std::vector<uint32_t>& data,
+        size_t num_bits) = 0;
 };
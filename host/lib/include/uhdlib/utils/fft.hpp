@@ -0,0 +1,99 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/math.hpp>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace uhd {
+
+/*! An in-place complex FFT for the host DSP stages
+ *
+ * The length must be a power of two. The bit reversal and the twiddles are
+ * computed once, so a plan can transform any number of blocks. The transform
+ * isn't scaled, so a forward and an inverse transform multiply by the length.
+ * execute() doesn't change the plan, so several threads may share one.
+ */
+class fft_plan
+{
+public:
+    /*!
+     * \param length The number of points, a power of two
+     * \param inverse Compute the inverse transform (positive exponent)
+     * \throws uhd::value_error if the length isn't a power of two
+     */
+    fft_plan(const size_t length, const bool inverse = false) : _length(length)
+    {
+        if (length == 0 || (length & (length - 1)) != 0) {
+            throw uhd::value_error(
+                "FFT length must be a power of two, got " + std::to_string(length));
+        }
+        size_t log2_len = 0;
+        while ((size_t(1) << log2_len) < length) {
+            log2_len++;
+        }
+        for (size_t i = 0; i < length; i++) {
+            size_t rev = 0;
+            for (size_t bit = 0; bit < log2_len; bit++) {
+                rev |= ((i >> bit) & 1) << (log2_len - 1 - bit);
+            }
+            if (i < rev) {
+                _swaps.emplace_back(i, rev);
+            }
+        }
+        const double sign = inverse ? 1.0 : -1.0;
+        _twiddles.resize(length / 2);
+        for (size_t k = 0; k < length / 2; k++) {
+            const double phase = sign * 2.0 * uhd::math::PI * double(k) / double(length);
+            _twiddles[k] =
+                std::complex<float>(float(std::cos(phase)), float(std::sin(phase)));
+        }
+    }
+
+    //! Return the number of points
+    size_t size() const
+    {
+        return _length;
+    }
+
+    //! Transform \p data, which holds size() samples, in place
+    void execute(std::complex<float>* data) const
+    {
+        for (const auto& swap : _swaps) {
+            std::swap(data[swap.first], data[swap.second]);
+        }
+        // Iterative radix-2 decimation in time
+        for (size_t size = 2; size <= _length; size *= 2) {
+            const size_t half = size / 2;
+            const size_t step = _length / size;
+            for (size_t start = 0; start < _length; start += size) {
+                std::complex<float>* lo = data + start;
+                std::complex<float>* hi = data + start + half;
+                for (size_t k = 0; k < half; k++) {
+                    const std::complex<float>& w = _twiddles[k * step];
+                    const float re = hi[k].real() * w.real() - hi[k].imag() * w.imag();
+                    const float im = hi[k].real() * w.imag() + hi[k].imag() * w.real();
+                    hi[k] = std::complex<float>(lo[k].real() - re, lo[k].imag() - im);
+                    lo[k] = std::complex<float>(lo[k].real() + re, lo[k].imag() + im);
+                }
+            }
+        }
+    }
+
+private:
+    const size_t _length;
+    std::vector<std::pair<size_t, size_t>> _swaps;
+    std::vector<std::complex<float>> _twiddles;
+};
+
+} // namespace uhd
@@ -0,0 +1,86 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <cstdint>
+#include <string>
+
+/*! Timeline of the phases of device initialization
+ *
+ * Creating a device runs through many phases (claiming, RPC setup, topology
+ * discovery, block and daughterboard initialization, ...), some of them on
+ * several threads at once. To see where the time goes, each phase opens a
+ * span, which records when the phase started and ended. Spans nest: a span is
+ * the child of the innermost open span of its thread, or of an explicitly
+ * given parent if it runs on another thread. The latter are parallel phases.
+ *
+ * When the outermost span of a timeline ends (e.g., multi_usrp::make()), the
+ * tree of spans and their durations is logged at debug level. The
+ * UHD_INIT_TIMELINE environment variable controls the output further:
+ *
+ * - "log": The tree is logged at info level instead.
+ * - Any other value: The path of a file that all timelines are written to, in
+ *   the Chrome trace event format. It can be opened with Perfetto
+ *   (https://ui.perfetto.dev) or chrome://tracing. The file is rewritten after
+ *   every timeline.
+ *
+ * Spans are meant for phases that take milliseconds or more. Opening one
+ * takes a lock, so it must not be used on the streaming path (see
+ * uhdlib/utils/trace.hpp for that).
+ */
+namespace uhd { namespace init_timeline {
+
+//! Identifies a span, to pass it on to the threads that run its subphases
+using span_id_t = uint64_t;
+
+//! No span (e.g., the parent of an outermost span)
+constexpr span_id_t NO_SPAN = 0;
+
+//! Returns the innermost open span of the calling thread, or NO_SPAN
+UHD_API span_id_t get_current_span();
+
+/*! A phase of the initialization, which lasts until the object is destroyed
+ *
+ * Spans must end in the reverse order they were opened on a thread, which
+ * holds when they are scoped objects.
+ */
+class UHD_API scoped_span
+{
+public:
+    //! Opens a span within the innermost open span of the calling thread
+    scoped_span(const std::string& name);
+
+    /*! Opens a span that runs in parallel to its parent's thread
+     *
+     * \param name The name of the phase
+     * \param parent The span that started the thread, see get_current_span().
+     *        With NO_SPAN, this is the same as scoped_span(name).
+     */
+    scoped_span(const std::string& name, const span_id_t parent);
+
+    ~scoped_span();
+
+    scoped_span(const scoped_span&) = delete;
+    scoped_span& operator=(const scoped_span&) = delete;
+
+private:
+    span_id_t _id;
+    span_id_t _prev_span;
+};
+
+/*! Writes all recorded timelines in the Chrome trace event format
+ *
+ * \param path The path of the file
+ * \throws uhd::os_error if the file can't be written
+ */
+UHD_API void dump(const std::string& path);
+
+//! Drops all recorded timelines. Don't call while spans are open.
+UHD_API void clear();
+
+}} // namespace uhd::init_timeline
@@ -0,0 +1,29 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/utils/memory_usage.hpp>
+#include <cstddef>
+#include <string>
+
+namespace uhd {
+
+//! Subsystem name for the frame buffers of links
+static constexpr char MEMORY_USAGE_TRANSPORT[] = "transport";
+//! Subsystem name for the lookup tables of converters
+static constexpr char MEMORY_USAGE_CONVERT[] = "convert";
+
+/*! Account for memory that \p subsystem allocated
+ *
+ * Call this for large, long-lived allocations only, it takes a lock.
+ */
+UHD_API void add_memory_usage(const std::string& subsystem, const size_t bytes);
+
+//! Account for memory that \p subsystem freed
+UHD_API void remove_memory_usage(const std::string& subsystem, const size_t bytes);
+
+} // namespace uhd
@@ -38,6 +38,14 @@ boost::filesystem::path get_xdg_data_home();
 // configuration file can be stored.
 boost::filesystem::path get_xdg_config_home();
 
+//! Return a path to XDG_CACHE_HOME
+//
+// https://specifications.freedesktop.org/basedir-spec/basedir-spec-latest.html
+//
+// Even on non-Linux systems, this should return a place for data that can be
+// recreated at any time, such as the EEPROM cache.
+boost::filesystem::path get_xdg_cache_home();
+
 //! Return a path to ~/.uhd
 boost::filesystem::path get_legacy_config_home();
 
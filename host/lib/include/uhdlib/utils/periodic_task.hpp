@@ -0,0 +1,36 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/utils/tasks.hpp>
+#include <chrono>
+#include <string>
+
+namespace uhd {
+
+/*! Create a task that calls a function once every \p period
+ *
+ * Unlike uhd::task::make(), the task doesn't keep a thread to itself: a single
+ * timer thread waits for the next periodic task that is due, and runs it on a
+ * thread of the task worker pool. Use this instead of a task that sleeps
+ * between calls, e.g., to renew a device claim. Destroying the task never
+ * waits for the period to end, only for a call that is in progress.
+ *
+ * The first call happens right away. If a call takes longer than the period,
+ * the next one follows right away, but missed calls are not made up for. If
+ * the function throws, the error is logged and the task stops calling it.
+ *
+ * \param task_fcn the function to call
+ * \param period the time from the start of one call to the start of the next
+ * \param name the name of the worker thread while it runs the function
+ * \return a new task object
+ */
+task::sptr make_periodic_task(const task::task_fcn_type& task_fcn,
+    const std::chrono::milliseconds period,
+    const std::string& name = "");
+
+} // namespace uhd
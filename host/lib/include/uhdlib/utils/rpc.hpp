@@ -12,7 +12,14 @@
 #include <rpc/client.h>
 #include <rpc/rpc_error.h>
 #include <boost/format.hpp>
+#include <chrono>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace {
 
@@ -40,6 +47,112 @@ bool await_rpc_connected_state(
 
 namespace uhd {
 
+class rpc_client;
+
+/*! A list of RPC calls that are executed in a single round trip
+ *
+ * Create a batch with rpc_client::make_batch(), add calls to it, and run them
+ * with rpc_client::request_batch(). The server executes the calls in the
+ * order they were added.
+ */
+class rpc_batch
+{
+public:
+    /*! Add a call to the batch
+     *
+     * \param func_name The function name that is called via RPC
+     * \param args All these arguments are passed to the RPC call
+     * \return the index of the result of this call in the rpc_batch_result
+     */
+    template <typename... Args>
+    size_t add(std::string const& func_name, Args&&... args)
+    {
+        auto call_obj = std::make_tuple(func_name, std::make_tuple(args...));
+        RPCLIB_MSGPACK::sbuffer buffer;
+        RPCLIB_MSGPACK::pack(buffer, call_obj);
+        _calls.push_back(std::make_shared<RPCLIB_MSGPACK::object_handle>(
+            RPCLIB_MSGPACK::unpack(buffer.data(), buffer.size())));
+        _func_names.push_back(func_name);
+        // For servers that don't support batches
+        _single_calls.push_back([func_name, args...](::rpc::client& client) {
+            return client.call(func_name, args...);
+        });
+        return _calls.size() - 1;
+    }
+
+    /*! Like add(), also provides the token of the client that made the batch
+     */
+    template <typename... Args>
+    size_t add_with_token(std::string const& func_name, Args&&... args)
+    {
+        return add(func_name, _token, std::forward<Args>(args)...);
+    }
+
+    //! Return the number of calls in this batch
+    size_t size() const
+    {
+        return _calls.size();
+    }
+
+private:
+    friend class rpc_client;
+
+    rpc_batch(const std::string& token) : _token(token) {}
+
+    const std::string _token;
+    //! The calls as [func_name, [args...]] objects
+    std::vector<std::shared_ptr<RPCLIB_MSGPACK::object_handle>> _calls;
+    std::vector<std::string> _func_names;
+    std::vector<std::function<RPCLIB_MSGPACK::object_handle(::rpc::client&)>>
+        _single_calls;
+};
+
+/*! The results of the calls of an rpc_batch
+ *
+ * A failing call does not affect the other calls of the batch. Its error is
+ * reported when its result is read.
+ */
+class rpc_batch_result
+{
+public:
+    /*! Return the result of a call
+     *
+     * \param idx The index of the call, as returned by rpc_batch::add()
+     * \throws uhd::runtime_error if the call failed, or its result can't be
+     *         converted to \p return_type
+     */
+    template <typename return_type>
+    return_type get(const size_t idx) const
+    {
+        if (!_errors.at(idx).empty()) {
+            throw uhd::runtime_error(
+                str(boost::format("Error during RPC call to `%s'. Error message: %s")
+                    % _func_names.at(idx) % _errors.at(idx)));
+        }
+        try {
+            return _results.at(idx).template as<return_type>();
+        } catch (const std::bad_cast& ex) {
+            throw uhd::runtime_error(
+                str(boost::format("Error during RPC call to `%s'. Error message: %s")
+                    % _func_names.at(idx) % ex.what()));
+        }
+    }
+
+    //! Return true if the call with index \p idx succeeded
+    bool ok(const size_t idx) const
+    {
+        return _errors.at(idx).empty();
+    }
+
+private:
+    friend class rpc_client;
+
+    //! Keeps the memory of _results alive
+    std::vector<std::shared_ptr<RPCLIB_MSGPACK::object_handle>> _handles;
+    std::vector<RPCLIB_MSGPACK::object> _results;
+    std::vector<std::string> _errors;
+    std::vector<std::string> _func_names;
+};
 
 /*! Abstraction for RPC client
  *
@@ -260,6 +373,107 @@ public:
         notify(timeout_ms, func_name, _token, std::forward<Args>(args)...);
     };
 
+    /*! Perform an RPC request without waiting for the response.
+     *
+     * Thread safe (locked). Use this to issue independent calls, which are
+     * then in flight at the same time. The returned future waits for the
+     * response with the default timeout of this client. It must not outlive
+     * the client.
+     *
+     * \param func_name The function name that is called via RPC
+     * \param args All these arguments are passed to the RPC call
+     * \return a future for the result. Its get() throws uhd::runtime_error in
+     *         case of failure
+     */
+    template <typename return_type, typename... Args>
+    std::future<return_type> request_async(std::string const& func_name, Args&&... args)
+    {
+        std::shared_ptr<std::future<RPCLIB_MSGPACK::object_handle>> response;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            response = std::make_shared<std::future<RPCLIB_MSGPACK::object_handle>>(
+                _client->async_call(func_name, std::forward<Args>(args)...));
+        }
+        const auto timeout = std::chrono::milliseconds(_default_timeout_ms);
+        return std::async(std::launch::deferred,
+            [this, response, func_name, timeout]() -> return_type {
+                if (response->wait_for(timeout) == std::future_status::timeout) {
+                    throw uhd::runtime_error(str(
+                        boost::format("Timeout during RPC call to `%s'.") % func_name));
+                }
+                try {
+                    return response->get().template as<return_type>();
+                } catch (const ::rpc::rpc_error& ex) {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    const std::string error = _get_last_error_safe();
+                    if (not error.empty()) {
+                        UHD_LOG_ERROR("RPC", error);
+                    }
+                    throw uhd::runtime_error(str(
+                        boost::format("Error during RPC call to `%s'. Error message: %s")
+                        % func_name % (error.empty() ? ex.what() : error)));
+                } catch (const std::bad_cast& ex) {
+                    throw uhd::runtime_error(str(
+                        boost::format("Error during RPC call to `%s'. Error message: %s")
+                        % func_name % ex.what()));
+                }
+            });
+    };
+
+    /*! Like request_async(), also provides a token.
+     */
+    template <typename return_type, typename... Args>
+    std::future<return_type> request_async_with_token(
+        std::string const& func_name, Args&&... args)
+    {
+        return request_async<return_type>(
+            func_name, _token, std::forward<Args>(args)...);
+    };
+
+    /*! Create an empty batch of calls for this client
+     */
+    rpc_batch make_batch() const
+    {
+        return rpc_batch(_token);
+    }
+
+    /*! Perform all the RPC calls of a batch in a single round trip.
+     *
+     * Thread safe (locked). This function blocks until it receives the
+     * responses to all calls. If the server doesn't support batches (see
+     * set_batch_support()), the calls are performed one by one instead.
+     *
+     * \param timeout_ms is time limit for the whole batch.
+     * \param batch The calls to perform
+     *
+     * \throws uhd::runtime_error if the batch as a whole fails. Errors of
+     *         individual calls are thrown by rpc_batch_result::get().
+     */
+    rpc_batch_result request_batch(uint64_t timeout_ms, const rpc_batch& batch)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto holder = rpcc_timeout_holder(_client, timeout_ms, _default_timeout_ms);
+        return _request_batch(batch);
+    }
+
+    /*! Like request_batch(), but with the default timeout of this client.
+     */
+    rpc_batch_result request_batch(const rpc_batch& batch)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _request_batch(batch);
+    }
+
+    /*! Set whether the server supports batches
+     *
+     * Batches are performed by the server's `multi_call` method, which older
+     * servers don't have. By default, batches are performed call by call.
+     */
+    void set_batch_support(const bool batch_support)
+    {
+        _batch_support = batch_support;
+    }
+
     /*! Sets the token value. This is used by the `_with_token` methods.
      */
     void set_token(const std::string& token)
@@ -315,6 +529,70 @@ private:
         return "";
     }
 
+    /*! Perform the calls of a batch. Not thread-safe, meant to be called
+     * from request_batch().
+     */
+    rpc_batch_result _request_batch(const rpc_batch& batch)
+    {
+        using object_ptr = std::shared_ptr<RPCLIB_MSGPACK::object_handle>;
+        rpc_batch_result result;
+        result._func_names = batch._func_names;
+        if (!_batch_support) {
+            for (size_t i = 0; i < batch.size(); i++) {
+                try {
+                    auto response =
+                        std::make_shared<RPCLIB_MSGPACK::object_handle>(
+                            batch._single_calls[i](*_client));
+                    result._results.push_back(response->get());
+                    result._errors.push_back("");
+                    result._handles.push_back(response);
+                } catch (const ::rpc::rpc_error& ex) {
+                    const std::string error = _get_last_error_safe();
+                    result._results.push_back(RPCLIB_MSGPACK::object());
+                    result._errors.push_back(error.empty() ? ex.what() : error);
+                }
+            }
+            return result;
+        }
+
+        std::vector<RPCLIB_MSGPACK::object> calls;
+        for (const auto& call : batch._calls) {
+            calls.push_back(call->get());
+        }
+        try {
+            object_ptr response = std::make_shared<RPCLIB_MSGPACK::object_handle>(
+                _client->call("multi_call", calls));
+            // Each response is an [error, result] pair
+            const auto responses =
+                response->get()
+                    .as<std::vector<std::tuple<std::string, RPCLIB_MSGPACK::object>>>();
+            if (responses.size() != batch.size()) {
+                throw uhd::runtime_error(
+                    "Error during RPC call to `multi_call'. Invalid number of results.");
+            }
+            for (const auto& call_response : responses) {
+                result._errors.push_back(std::get<0>(call_response));
+                result._results.push_back(std::get<1>(call_response));
+            }
+            result._handles.push_back(response);
+        } catch (const ::rpc::rpc_error& ex) {
+            const std::string error = _get_last_error_safe();
+            if (not error.empty()) {
+                UHD_LOG_ERROR("RPC", error);
+            }
+            throw uhd::runtime_error(
+                str(boost::format("Error during RPC call to `multi_call'. Error "
+                                  "message: %s")
+                    % (error.empty() ? ex.what() : error)));
+        } catch (const std::bad_cast& ex) {
+            throw uhd::runtime_error(
+                str(boost::format(
+                        "Error during RPC call to `multi_call'. Error message: %s")
+                    % ex.what()));
+        }
+        return result;
+    }
+
     //! Reference the actual RPC client
     std::shared_ptr<rpc::client> _client;
     //! If set, this is the command that will retrieve an error
@@ -322,6 +600,8 @@ private:
     uint64_t _default_timeout_ms;
     std::string _token;
     std::mutex _mutex;
+    //! If true, the server supports performing batches in one call
+    bool _batch_support = false;
 };
 
 } /* namespace uhd */
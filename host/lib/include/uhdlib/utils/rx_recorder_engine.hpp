@@ -0,0 +1,150 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/stream.hpp>
+#include <uhd/types/time_spec.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uhd {
+
+/*! Receives samples into blocks of memory, and writes them to files
+ *
+ * This is the part that uhd::rx_recorder and uhd::sigmf_recorder have in
+ * common. recv() is called on a thread of its own, which only fills blocks.
+ * The blocks are written by one thread per file. The file formats are up to
+ * the caller, which is told about every block through a callback.
+ */
+class rx_recorder_engine : uhd::noncopyable
+{
+public:
+    using uptr = std::unique_ptr<rx_recorder_engine>;
+
+    //! How the blocks are laid out in the files
+    enum class layout_t {
+        /*! Block N goes to file N % (number of files), the channels one after
+         *  the other. A block is ended on every overrun and end of burst, so it
+         *  holds contiguous samples, and padded to its full size.
+         */
+        STRIPED,
+        /*! One file per channel, holding the samples of that channel back to
+         *  back. Overruns don't end a block, and the files hold exactly the
+         *  samples that were received.
+         */
+        PER_CHANNEL
+    };
+
+    /*! Encodes a block before it is written, e.g. to compress it
+     *
+     * Called on the writer threads with the block, its number of samples per
+     * channel, and a buffer of config_t::max_encoded_size bytes. Returns the
+     * number of bytes written to the buffer.
+     */
+    using block_encoder_t =
+        std::function<size_t(const char* block, const size_t num_samps, char* out)>;
+
+    struct config_t
+    {
+        layout_t layout = layout_t::STRIPED;
+        //! Bytes per channel per block, a multiple of ALIGNMENT
+        size_t chan_size = 1024 * 1024;
+        size_t num_blocks = 32;
+        //! Write with O_DIRECT, where available
+        bool direct_io = true;
+        /*! Encodes the blocks (STRIPED layout only). The encoded blocks are
+         *  padded to ALIGNMENT, and written back to back.
+         */
+        block_encoder_t encoder;
+        //! The largest block the encoder writes, in bytes
+        size_t max_encoded_size = 0;
+    };
+
+    //! Contiguous samples within a block
+    struct segment_t
+    {
+        //! Number of the first sample since the start of the recording
+        uint64_t first_samp;
+        uhd::time_spec_t time_spec;
+        bool has_time_spec;
+        //! Samples were lost right before the first sample
+        bool overflow;
+        bool start_of_burst;
+    };
+
+    struct block_info_t
+    {
+        uint64_t block_num;
+        //! File the block was written to (STRIPED layout only)
+        size_t file_num;
+        //! Offset of the block in the file (STRIPED layout only)
+        uint64_t offset;
+        /*! Bytes of the block in the file, without the padding of an encoded
+         *  block (STRIPED layout only)
+         */
+        uint64_t stored_size;
+        //! Number of the first sample since the start of the recording
+        uint64_t first_samp;
+        //! Samples per channel
+        uint64_t num_samps;
+        /*! The segments of the block. The first one starts with the block, the
+         *  others start after an overrun or at a start of burst.
+         */
+        std::vector<segment_t> segments;
+    };
+
+    /*! Called for every block, in order, after it was queued for writing
+     *
+     * The callback runs on one of the writer threads, or in stop(), but never
+     * on the receive thread, and never concurrently.
+     */
+    using block_callback_t = std::function<void(const block_info_t&)>;
+
+    //! Alignment of the block sizes and file offsets, as needed by O_DIRECT
+    static constexpr size_t ALIGNMENT = 4096;
+
+    virtual ~rx_recorder_engine() = default;
+
+    //! Start receiving and writing. Can only be called once.
+    virtual void start() = 0;
+
+    /*! Stop receiving, and wait until all blocks were written
+     *
+     * \throws uhd::os_error if writing a file failed
+     * \throws uhd::io_error if the streamer reported an error
+     */
+    virtual void stop() = 0;
+
+    virtual bool is_running() const = 0;
+
+    //! Samples per channel received so far
+    virtual uint64_t get_num_samps_recorded() const = 0;
+
+    virtual size_t get_num_overflows() const = 0;
+
+    /*!
+     * \param rx_stream The streamer to receive from
+     * \param item_size Bytes per sample of the CPU format of the streamer
+     * \param paths The files to write. For the PER_CHANNEL layout, there must
+     *              be one per channel.
+     * \param config Layout and buffering
+     * \param block_callback Called for every block
+     * \throws uhd::value_error if the arguments are invalid
+     * \throws uhd::os_error if a file can't be opened
+     */
+    static uptr make(rx_streamer::sptr rx_stream,
+        const size_t item_size,
+        const std::vector<std::string>& paths,
+        const config_t& config,
+        block_callback_t block_callback);
+};
+
+} // namespace uhd
@@ -0,0 +1,190 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <uhd/exception.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace uhd {
+
+/*!
+ * A fixed-size, lock-free, single-producer single-consumer queue.
+ *
+ * The read and write indices live on separate cache lines, and each side keeps
+ * a private copy of the other side's index, so in steady state producer and
+ * consumer only touch each other's cache line when the cached copy says the
+ * queue is full (or empty).
+ *
+ * Non-blocking push() and pop() never take a lock. Consumers may additionally
+ * block with pop(item, timeout_ms): the consumer announces itself in a waiter
+ * flag before going to sleep on a condition variable, and the producer only
+ * takes the mutex to notify when it sees that flag set. Producers therefore
+ * pay a single relaxed load per push as long as nobody is sleeping.
+ */
+template <typename T>
+class spsc_queue
+{
+public:
+    /*!
+     * \param capacity The maximum number of items the queue can hold
+     */
+    spsc_queue(const size_t capacity)
+        : _buffer(new T[capacity]), _capacity(capacity)
+    {
+        UHD_ASSERT_THROW(capacity > 0);
+    }
+
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    /*! Push an item into the queue (producer only)
+     *
+     * \return false if the queue is full
+     */
+    UHD_FORCE_INLINE bool push(const T& item)
+    {
+        const size_t write_index = _write_index.load(std::memory_order_relaxed);
+        if (write_index - _cached_read_index == _capacity) {
+            _cached_read_index = _read_index.load(std::memory_order_acquire);
+            if (write_index - _cached_read_index == _capacity) {
+                return false;
+            }
+        }
+        _buffer[write_index % _capacity] = item;
+        _write_index.store(write_index + 1, std::memory_order_release);
+
+        // Pairs with the fence in _wait_for_item(): either the consumer sees
+        // the new item before it goes to sleep, or we see its waiter flag.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_consumer_waiting.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(_wait_mutex);
+            _wait_cv.notify_one();
+        }
+        return true;
+    }
+
+    /*! Copy the oldest item without removing it (consumer only)
+     *
+     * \return false if the queue is empty
+     */
+    UHD_FORCE_INLINE bool peek(T& item)
+    {
+        const size_t read_index = _read_index.load(std::memory_order_relaxed);
+        if (!_readable(read_index)) {
+            return false;
+        }
+        item = _buffer[read_index % _capacity];
+        return true;
+    }
+
+    /*! Remove the oldest item from the queue (consumer only)
+     *
+     * \return false if the queue is empty
+     */
+    UHD_FORCE_INLINE bool pop(T& item)
+    {
+        const size_t read_index = _read_index.load(std::memory_order_relaxed);
+        if (!_readable(read_index)) {
+            return false;
+        }
+        // Moving out of the slot drops its reference, if T holds one
+        item = std::move(_buffer[read_index % _capacity]);
+        _read_index.store(read_index + 1, std::memory_order_release);
+        return true;
+    }
+
+    /*! Remove the oldest item, waiting for one if the queue is empty
+     * (consumer only)
+     *
+     * \param item The item removed from the queue
+     * \param timeout_ms Time to wait for an item, in milliseconds
+     * \return false if no item arrived before the timeout expired
+     */
+    bool pop(T& item, const int32_t timeout_ms)
+    {
+        if (pop(item)) {
+            return true;
+        }
+        if (!_wait_for_item(timeout_ms)) {
+            return false;
+        }
+        return pop(item);
+    }
+
+    /*! Return the number of items in the queue
+     *
+     * This is exact when called by the consumer. The producer may see a stale
+     * count that is larger than the actual one.
+     */
+    size_t read_available() const
+    {
+        return _write_index.load(std::memory_order_acquire)
+               - _read_index.load(std::memory_order_acquire);
+    }
+
+    //! Return the maximum number of items the queue can hold
+    size_t capacity() const
+    {
+        return _capacity;
+    }
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    UHD_FORCE_INLINE bool _readable(const size_t read_index)
+    {
+        if (read_index == _cached_write_index) {
+            _cached_write_index = _write_index.load(std::memory_order_acquire);
+            if (read_index == _cached_write_index) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool _wait_for_item(const int32_t timeout_ms)
+    {
+        const size_t read_index = _read_index.load(std::memory_order_relaxed);
+        std::unique_lock<std::mutex> lock(_wait_mutex);
+        _consumer_waiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const bool ready = _wait_cv.wait_for(lock,
+            std::chrono::milliseconds(timeout_ms),
+            [this, read_index]() { return _readable(read_index); });
+        _consumer_waiting.store(false, std::memory_order_relaxed);
+        return ready;
+    }
+
+    // Storage, written by the producer and read by the consumer
+    const std::unique_ptr<T[]> _buffer;
+    const size_t _capacity;
+    char _pad0[CACHE_LINE_SIZE];
+
+    // Producer-owned state. Indices increase monotonically and are reduced
+    // modulo the capacity on access, so that all slots can be used.
+    std::atomic<size_t> _write_index{0};
+    size_t _cached_read_index = 0;
+    char _pad1[CACHE_LINE_SIZE];
+
+    // Consumer-owned state
+    std::atomic<size_t> _read_index{0};
+    size_t _cached_write_index = 0;
+    char _pad2[CACHE_LINE_SIZE];
+
+    // Only written when the consumer blocks
+    std::atomic<bool> _consumer_waiting{false};
+    std::mutex _wait_mutex;
+    std::condition_variable _wait_cv;
+};
+
+} // namespace uhd
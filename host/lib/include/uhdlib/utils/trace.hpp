@@ -0,0 +1,113 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/config.hpp>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/*! Trace recorder for streaming events
+ *
+ * When investigating overruns and underruns, the interesting part is what
+ * happened in the few microseconds around the event. The trace recorder keeps
+ * the most recent streaming events (packets, conversions, flow control
+ * updates, timeouts) of every thread in memory, and writes them to a file in
+ * the Chrome trace event format, which can be opened with Perfetto
+ * (https://ui.perfetto.dev) or chrome://tracing.
+ *
+ * Every thread records into its own ring, so recording an event never locks
+ * nor allocates memory. Once a ring is full, the oldest events are
+ * overwritten. When tracing is disabled, which is the default, recording an
+ * event costs a relaxed atomic load.
+ *
+ * Tracing is enabled by setting the UHD_TRACE_FILE environment variable to the
+ * path of the trace file, which is then written when the application exits.
+ * It can also be controlled with set_enabled() and dump().
+ *
+ * The functions are exported so that the streamer and transport headers, which
+ * record events, can also be used outside of the library (e.g., in tests).
+ */
+namespace uhd { namespace trace {
+
+//! Traced events
+enum class event_t : uint8_t {
+    //! RX transport got a data packet (args: sequence number, payload bytes)
+    RX_PACKET,
+    //! RX transport get_recv_buff() timed out (args: timeout in ms)
+    RX_TIMEOUT,
+    //! RX streamer reported an overrun
+    RX_OVERRUN,
+    //! TX transport wrote a data packet (args: sequence number, payload bytes)
+    TX_PACKET,
+    //! RX transport sent a flow control status (args: bytes, packets)
+    FC_CREDIT_SENT,
+    //! TX transport received a flow control status (args: bytes, packets)
+    FC_CREDIT_RECEIVED,
+    //! Streamer started converting samples (args: number of samples)
+    CONVERT_BEGIN,
+    //! Streamer finished converting samples
+    CONVERT_END,
+    //! An async message was queued (args: event code)
+    ASYNC_MSG,
+    //! I/O service got a buffer from a recv link (args: packet size)
+    IO_SRV_RECV,
+    //! I/O service dropped a packet without a receiver
+    IO_SRV_DROP,
+    //! Offload I/O service handed a buffer to a client (args: frames in use)
+    OFFLOAD_PUSH,
+    //! Number of events, must be last
+    NUM_EVENTS
+};
+
+namespace detail {
+extern UHD_API std::atomic<bool> trace_enabled;
+} // namespace detail
+
+//! Returns true if events are being recorded
+inline bool is_enabled()
+{
+    return detail::trace_enabled.load(std::memory_order_relaxed);
+}
+
+//! Start or stop recording events. Recorded events are kept.
+UHD_API void set_enabled(const bool enable);
+
+/*! Record an event for the calling thread
+ *
+ * Use the UHD_TRACE() macro instead, which skips the call when tracing is
+ * disabled.
+ */
+UHD_API void record(
+    const event_t event, const uint64_t arg0 = 0, const uint64_t arg1 = 0);
+
+/*! Write the recorded events in the Chrome trace event format
+ *
+ * This may be called while other threads are recording events. Events that
+ * are overwritten while they are written out are skipped.
+ */
+UHD_API void dump(std::ostream& out);
+
+/*! Write the recorded events to a file, see dump(std::ostream&)
+ *
+ * \throws uhd::os_error if the file can't be written
+ */
+UHD_API void dump(const std::string& path);
+
+//! Drop all recorded events. Don't call while events are being recorded.
+UHD_API void clear();
+
+}} // namespace uhd::trace
+
+//! Record a trace event, if tracing is enabled. See uhd::trace::event_t.
+#define UHD_TRACE(event, ...)                                                  \
+    do {                                                                       \
+        if (uhd::trace::is_enabled()) {                                        \
+            uhd::trace::record(uhd::trace::event_t::event, ##__VA_ARGS__);     \
+        }                                                                      \
+    } while (0)
@@ -8,10 +8,18 @@
 
 #include <uhd/property_tree.hpp>
 #include <uhd/types/dict.hpp>
-#include <boost/thread/mutex.hpp>
+#include <uhd/utils/log.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <condition_variable>
+#include <exception>
 #include <iostream>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <typeindex>
+#include <unordered_map>
 
 using namespace uhd;
 
@@ -66,6 +74,172 @@ fs_path uhd::operator/(const fs_path& lhs, size_t rhs)
     return lhs / rhs_str;
 }
 
+/***********************************************************************
+ * Deferred sets implementation
+ **********************************************************************/
+property_set_queue::~property_set_queue(void)
+{
+    /* NOP */
+}
+
+class property_set_queue_impl : public property_set_queue
+{
+public:
+    bool defer(const void* prop, const std::function<void(void)>& apply)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_active || _owner != std::this_thread::get_id()) {
+            return false;
+        }
+        auto it = _index.find(prop);
+        if (_committing) {
+            // Sets from subscribers and coercers during the commit apply right
+            // away, and replace a set that's still queued
+            if (it != _index.end()) {
+                _queue.erase(it->second);
+                _index.erase(it);
+            }
+            return false;
+        }
+        if (it == _index.end()) {
+            _index[prop] = _queue.insert(_queue.end(), {prop, apply});
+        }
+        return true;
+    }
+
+    void apply(const void* prop)
+    {
+        std::function<void(void)> apply;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_active || _owner != std::this_thread::get_id()) {
+                return;
+            }
+            auto it = _index.find(prop);
+            if (it == _index.end()) {
+                return;
+            }
+            apply = std::move(it->second->second);
+            _queue.erase(it->second);
+            _index.erase(it);
+        }
+        apply();
+    }
+
+    void cancel(const void* prop)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _index.find(prop);
+        if (it != _index.end()) {
+            _queue.erase(it->second);
+            _index.erase(it);
+        }
+    }
+
+    void begin(void)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        const auto this_thread = std::this_thread::get_id();
+        if (_active && _owner == this_thread) {
+            _depth++;
+            return;
+        }
+        _cond.wait(lock, [this]() { return !_active; });
+        _owner  = this_thread;
+        _depth  = 1;
+        _active = true;
+    }
+
+    void commit(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            UHD_ASSERT_THROW(
+                _active && _owner == std::this_thread::get_id() && _depth > 0);
+            _depth--;
+            if (_depth > 0 || _committing) {
+                return;
+            }
+            _committing = true;
+        }
+
+        std::exception_ptr error;
+        try {
+            while (_apply_next()) {
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queue.clear();
+            _index.clear();
+            _committing = false;
+            _active     = false;
+        }
+        _cond.notify_all();
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    //! Applies the first queued set, returns false if there was none
+    bool _apply_next(void)
+    {
+        std::function<void(void)> apply;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_queue.empty()) {
+                return false;
+            }
+            apply = std::move(_queue.front().second);
+            _index.erase(_queue.front().first);
+            _queue.pop_front();
+        }
+        apply();
+        return true;
+    }
+
+    using queue_type = std::list<std::pair<const void*, std::function<void(void)>>>;
+
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    std::thread::id _owner;
+    size_t _depth    = 0;
+    bool _committing = false;
+    //! Queued sets, in the order the properties were first set
+    queue_type _queue;
+    std::unordered_map<const void*, queue_type::iterator> _index;
+};
+
+property_tree::transaction::transaction(property_tree& tree)
+    : _queue(tree._get_set_queue()), _open(true)
+{
+    _queue->begin();
+}
+
+property_tree::transaction::~transaction(void)
+{
+    if (_open) {
+        try {
+            commit();
+        } catch (const std::exception& ex) {
+            UHD_LOG_ERROR("PROPTREE", "Error committing a transaction: " << ex.what());
+        } catch (...) {
+            UHD_LOG_ERROR("PROPTREE", "Unknown error committing a transaction");
+        }
+    }
+}
+
+void property_tree::transaction::commit(void)
+{
+    UHD_ASSERT_THROW(_open);
+    _open = false;
+    _queue->commit();
+}
+
 /***********************************************************************
  * Property tree implementation
  **********************************************************************/
@@ -80,7 +254,7 @@ public:
     sptr subtree(const fs_path& path_) const
     {
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+        boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
 
         property_tree_impl* subtree = new property_tree_impl(path);
         subtree->_guts              = this->_guts; // copy the guts sptr
@@ -90,7 +264,7 @@ public:
     void remove(const fs_path& path_)
     {
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+        boost::unique_lock<boost::shared_mutex> lock(_guts->mutex);
 
         node_type* parent = NULL;
         node_type* node   = &_guts->root;
@@ -108,7 +282,7 @@ public:
     bool exists(const fs_path& path_) const
     {
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+        boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
 
         node_type* node = &_guts->root;
         for (const std::string& name : path_tokenizer(path)) {
@@ -122,7 +296,7 @@ public:
     std::vector<std::string> list(const fs_path& path_) const
     {
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+        boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
 
         node_type* node = &_guts->root;
         for (const std::string& name : path_tokenizer(path)) {
@@ -137,7 +311,7 @@ public:
     std::shared_ptr<void> _pop(const fs_path& path_)
     {
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+        boost::unique_lock<boost::shared_mutex> lock(_guts->mutex);
 
         node_type* parent = NULL;
         node_type* node   = &_guts->root;
@@ -162,7 +336,7 @@ public:
         std::type_index prop_type)
     {
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+        boost::unique_lock<boost::shared_mutex> lock(_guts->mutex);
 
         node_type* node = &_guts->root;
         for (const std::string& name : path_tokenizer(path)) {
@@ -180,7 +354,7 @@ public:
     std::shared_ptr<void>& _access(const fs_path& path_) const
     {
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+        boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
 
         node_type* node = &_guts->root;
         for (const std::string& name : path_tokenizer(path)) {
@@ -193,11 +367,11 @@ public:
         return node->prop;
     }
 
-    std::shared_ptr<void>& _access_with_type_check(
+    std::shared_ptr<void> _access_with_type_check(
         const fs_path& path_, std::type_index expected_prop_type) const
     {
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+        boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
 
         node_type* node = &_guts->root;
         for (const std::string& name : path_tokenizer(path)) {
@@ -213,6 +387,11 @@ public:
         return node->prop;
     }
 
+    property_set_queue::sptr _get_set_queue(void) const
+    {
+        return _guts->set_queue;
+    }
+
 private:
     void throw_path_not_found(const fs_path& path) const
     {
@@ -226,11 +405,14 @@ private:
         std::size_t prop_type_hash;
     };
 
-    // tree guts which may be referenced in a subtree
+    // tree guts which may be referenced in a subtree. Lookups only need a
+    // shared lock, so they don't contend with each other, only with changes
+    // to the structure of the tree.
     struct tree_guts_type
     {
         node_type root;
-        boost::mutex mutex;
+        boost::shared_mutex mutex;
+        property_set_queue::sptr set_queue = std::make_shared<property_set_queue_impl>();
     };
 
     // members, the tree and root prefix
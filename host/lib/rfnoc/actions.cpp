@@ -70,6 +70,28 @@ rx_event_action_info::sptr rx_event_action_info::make(
     return std::make_shared<rx_event_action_info_make_shared>(error_code);
 }
 
+/*** RX Tag Action Info *****************************************************/
+rx_tag_action_info::rx_tag_action_info(
+    const uhd::rx_tag_t::tag_type_t type_, const uint64_t tsf_)
+    : action_info(ACTION_KEY_RX_TAG), type(type_), tsf(tsf_)
+{
+    // nop
+}
+
+rx_tag_action_info::sptr rx_tag_action_info::make(
+    const uhd::rx_tag_t::tag_type_t type, const uint64_t tsf)
+{
+    struct rx_tag_action_info_make_shared : public rx_tag_action_info
+    {
+        rx_tag_action_info_make_shared(
+            const uhd::rx_tag_t::tag_type_t type, const uint64_t tsf)
+            : rx_tag_action_info(type, tsf)
+        {
+        }
+    };
+    return std::make_shared<rx_tag_action_info_make_shared>(type, tsf);
+}
+
 /*** TX Metadata Action Info *************************************************/
 tx_event_action_info::tx_event_action_info(
     uhd::async_metadata_t::event_code_t event_code_,
@@ -31,26 +31,50 @@ public:
     {
         assert(pkt_buff);
         _pkt_buff = const_cast<uint64_t*>(reinterpret_cast<const uint64_t*>(pkt_buff));
-        _mdata_offset = _compute_mdata_offset(get_chdr_header());
+        _header   = chdr_header(u64_to_host(_pkt_buff[0]));
+        _mdata_offset = _compute_mdata_offset(_header);
     }
 
     virtual void refresh(void* pkt_buff, chdr_header& header, uint64_t timestamp = 0)
     {
         assert(pkt_buff);
-        _pkt_buff    = reinterpret_cast<uint64_t*>(pkt_buff);
-        _pkt_buff[0] = u64_from_host(header);
-        if (_has_timestamp(header)) {
-            _pkt_buff[1] = u64_from_host(timestamp);
+        _pkt_buff = reinterpret_cast<uint64_t*>(pkt_buff);
+        _header   = header;
+        _write_header(timestamp);
+    }
+
+    virtual packet_view_t parse(const void* pkt_buff) const
+    {
+        chdr_packet_impl::refresh(pkt_buff);
+        packet_view_t view;
+        view.header        = _header;
+        view.has_timestamp = _has_timestamp(_header);
+        if (view.has_timestamp) {
+            view.timestamp = u64_to_host(_pkt_buff[1]);
         }
-        _mdata_offset = _compute_mdata_offset(get_chdr_header());
+        view.payload_size = _get_payload_size();
+        view.payload      = _get_payload_ptr();
+        return view;
+    }
+
+    virtual void* write_header(void* pkt_buff,
+        chdr_header& header,
+        uint64_t timestamp,
+        size_t payload_size_bytes)
+    {
+        assert(pkt_buff);
+        _pkt_buff     = reinterpret_cast<uint64_t*>(pkt_buff);
+        _mdata_offset = _compute_mdata_offset(header);
+        header.set_length(_get_payload_offset(header) + payload_size_bytes);
+        _header = header;
+        _write_header(timestamp);
+        return _get_payload_ptr();
     }
 
     virtual void update_payload_size(size_t payload_size_bytes)
     {
-        chdr_header header = get_chdr_header();
-        header.set_length(((_mdata_offset + header.get_num_mdata()) * chdr_w_bytes)
-                          + payload_size_bytes);
-        _pkt_buff[0] = u64_from_host(header);
+        _header.set_length(_get_payload_offset(_header) + payload_size_bytes);
+        _pkt_buff[0] = u64_from_host(_header);
     }
 
     virtual endianness_t get_byte_order() const
@@ -66,12 +90,12 @@ public:
     virtual chdr_header get_chdr_header() const
     {
         assert(_pkt_buff);
-        return std::move(chdr_header(u64_to_host(_pkt_buff[0])));
+        return _header;
     }
 
     virtual boost::optional<uint64_t> get_timestamp() const
     {
-        if (_has_timestamp(get_chdr_header())) {
+        if (_has_timestamp(_header)) {
             // In a unit64_t buffer, the timestamp is always immediately after the header
             // regardless of chdr_w.
             return u64_to_host(_pkt_buff[1]);
@@ -82,7 +106,7 @@ public:
 
     virtual size_t get_mdata_size() const
     {
-        return get_chdr_header().get_num_mdata() * chdr_w_bytes;
+        return _header.get_num_mdata() * chdr_w_bytes;
     }
 
     virtual const void* get_mdata_const_ptr() const
@@ -98,8 +122,7 @@ public:
 
     virtual size_t get_payload_size() const
     {
-        return get_chdr_header().get_length() - get_mdata_size()
-               - (chdr_w_bytes * _mdata_offset);
+        return _get_payload_size();
     }
 
     virtual const void* get_payload_const_ptr() const
@@ -110,9 +133,7 @@ public:
 
     virtual void* get_payload_ptr()
     {
-        return reinterpret_cast<void*>(
-            _pkt_buff
-            + (chdr_w_stride * (_mdata_offset + get_chdr_header().get_num_mdata())));
+        return _get_payload_ptr();
     }
 
     virtual size_t calculate_payload_offset(
@@ -124,6 +145,32 @@ public:
     }
 
 private:
+    //! Write the cached header (and the timestamp, if it has one) to the buffer
+    inline void _write_header(uint64_t timestamp)
+    {
+        _pkt_buff[0] = u64_from_host(_header);
+        if (_has_timestamp(_header)) {
+            _pkt_buff[1] = u64_from_host(timestamp);
+        }
+        _mdata_offset = _compute_mdata_offset(_header);
+    }
+
+    inline size_t _get_payload_offset(const chdr_header& header) const
+    {
+        return (_mdata_offset + header.get_num_mdata()) * chdr_w_bytes;
+    }
+
+    inline size_t _get_payload_size() const
+    {
+        return _header.get_length() - _get_payload_offset(_header);
+    }
+
+    inline void* _get_payload_ptr() const
+    {
+        return reinterpret_cast<void*>(
+            _pkt_buff + (chdr_w_stride * (_mdata_offset + _header.get_num_mdata())));
+    }
+
     inline bool _has_timestamp(const chdr_header& header) const
     {
         return (header.get_pkt_type() == PKT_TYPE_DATA_WITH_TS);
@@ -157,6 +204,7 @@ private:
     // Packet state
     const size_t _mtu_bytes      = 0;
     mutable uint64_t* _pkt_buff  = nullptr;
+    mutable chdr_header _header;
     mutable size_t _mdata_offset = 0;
 };
 
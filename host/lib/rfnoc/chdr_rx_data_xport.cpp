@@ -42,19 +42,23 @@ chdr_rx_data_xport::chdr_rx_data_xport(uhd::transport::io_service::sptr io_srv,
     , _fc_sender(pkt_factory, epids)
     , _epid(epids.second)
     , _chdr_w_bytes(chdr_w_to_bits(pkt_factory.get_chdr_w()) / 8)
+    , _chdr_w(pkt_factory.get_chdr_w())
+    , _endianness(pkt_factory.get_endianness())
     , _disconnect(disconnect)
 {
     UHD_LOG_TRACE("XPORT::RX_DATA_XPORT",
         "Creating rx xport with local epid=" << epids.second
                                              << ", remote epid=" << epids.first);
 
-    _recv_packet    = pkt_factory.make_generic();
     _recv_packet_cb = pkt_factory.make_generic();
     _fc_sender.set_capacity(fc_params.buff_capacity);
+    if (fc_params.adaptive_freq) {
+        _fc_state.enable_adaptive_freq(fc_params.buff_capacity);
+    }
 
     // Calculate max payload size
-    const size_t pyld_offset =
-        _recv_packet->calculate_payload_offset(chdr::PKT_TYPE_DATA_WITH_TS);
+    const size_t pyld_offset = _recv_packet_cb->calculate_payload_offset(
+        chdr::PKT_TYPE_DATA_WITH_TS);
     _max_payload_size = recv_link->get_recv_frame_size() - pyld_offset;
 
     // Make data transport
@@ -82,7 +86,8 @@ chdr_rx_data_xport::chdr_rx_data_xport(uhd::transport::io_service::sptr io_srv,
             << "capacity bytes=" << fc_params.buff_capacity.bytes
             << ", packets=" << fc_params.buff_capacity.packets << std::endl
             << "fc frequency bytes=" << fc_params.freq.bytes
-            << ", packets=" << fc_params.freq.packets);
+            << ", packets=" << fc_params.freq.packets
+            << (fc_params.adaptive_freq ? " (adaptive)" : ""));
 }
 
 chdr_rx_data_xport::~chdr_rx_data_xport()
@@ -90,6 +95,15 @@ chdr_rx_data_xport::~chdr_rx_data_xport()
     // Release recv_io before allowing members needed by callbacks be destroyed
     _recv_io.reset();
 
+    if (_fc_state.get_num_freq_changes() != 0) {
+        const auto fc_freq = _fc_state.get_fc_freq();
+        UHD_LOG_DEBUG("XPORT::RX_DATA_XPORT",
+            "Adaptive fc frequency changed " << _fc_state.get_num_freq_changes()
+                                             << " times, ended at bytes="
+                                             << fc_freq.bytes
+                                             << ", packets=" << fc_freq.packets);
+    }
+
     // Disconnect the links
     _disconnect();
 }
@@ -10,6 +10,7 @@
 #include <uhdlib/rfnoc/rfnoc_common.hpp>
 #include <uhdlib/transport/io_service.hpp>
 #include <uhdlib/transport/link_if.hpp>
+#include <algorithm>
 
 using namespace uhd;
 using namespace uhd::rfnoc;
@@ -37,6 +38,8 @@ chdr_tx_data_xport::chdr_tx_data_xport(uhd::transport::io_service::sptr io_srv,
     , _fc_sender(pkt_factory, epids)
     , _epid(epids.first)
     , _chdr_w_bytes(chdr_w_to_bits(pkt_factory.get_chdr_w()) / 8)
+    , _chdr_w(pkt_factory.get_chdr_w())
+    , _endianness(pkt_factory.get_endianness())
     , _frame_size(send_link->get_send_frame_size())
     , _disconnect(disconnect)
 {
@@ -45,12 +48,10 @@ chdr_tx_data_xport::chdr_tx_data_xport(uhd::transport::io_service::sptr io_srv,
                                              << ", remote epid=" << epids.second);
 
     _send_header.set_dst_epid(epids.second);
-    _send_packet = pkt_factory.make_generic();
     _recv_packet = pkt_factory.make_generic();
 
     // Calculate max payload size
-    const size_t pyld_offset =
-        _send_packet->calculate_payload_offset(chdr::PKT_TYPE_DATA_WITH_TS);
+    const size_t pyld_offset = get_payload_offset(true);
     _max_payload_size = send_link->get_send_frame_size() - pyld_offset;
 
     // Now create the send I/O we will use for data
@@ -99,7 +100,8 @@ static chdr_tx_data_xport::fc_params_t configure_flow_ctrl(io_service::sptr io_s
     const chdr::chdr_packet_factory& pkt_factory,
     const sep_id_pair_t epids,
     const double fc_freq_ratio,
-    const double fc_headroom_ratio)
+    const double fc_headroom_ratio,
+    const stream_buff_params_t& max_capacity)
 {
     chdr::chdr_strc_packet::uptr strc_packet   = pkt_factory.make_strc();
     chdr::chdr_packet_writer::uptr recv_packet = pkt_factory.make_generic();
@@ -197,6 +199,11 @@ static chdr_tx_data_xport::fc_params_t configure_flow_ctrl(io_service::sptr io_s
     UHD_LOG_TRACE("XPORT::TX_DATA_XPORT",
         "Received strs initializing buffer capacity to " << capacity.bytes << " bytes");
 
+    // Only use part of the buffer if asked to, the fc frequency then follows
+    // from the smaller window
+    capacity.bytes   = std::min(capacity.bytes, max_capacity.bytes);
+    capacity.packets = std::min(capacity.packets, max_capacity.packets);
+
     // Calculate the requested fc_freq parameters
     stream_buff_params_t fc_freq = {
         static_cast<uint64_t>(std::ceil(double(capacity.bytes) * fc_freq_ratio)),
@@ -231,6 +238,7 @@ chdr_tx_data_xport::fc_params_t chdr_tx_data_xport::configure_sep(io_service::sp
     const sw_buff_t mdata_buff_fmt,
     const double fc_freq_ratio,
     const double fc_headroom_ratio,
+    const stream_buff_params_t& max_capacity,
     disconnect_callback_t disconnect)
 {
     const sep_id_t remote_epid = epids.second;
@@ -259,5 +267,6 @@ chdr_tx_data_xport::fc_params_t chdr_tx_data_xport::configure_sep(io_service::sp
         pkt_factory,
         epids,
         fc_freq_ratio,
-        fc_headroom_ratio);
+        fc_headroom_ratio,
+        max_capacity);
 }
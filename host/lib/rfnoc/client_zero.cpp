@@ -216,6 +216,34 @@ client_zero::block_config_info client_zero::get_block_info(uint16_t portno)
         uhd::narrow_cast<uint8_t>((data_reg_val & 0x000000FC) >> 2)};
 }
 
+std::vector<client_zero::port_status_t> client_zero::get_all_port_status()
+{
+    const uint16_t first_block_port = 1 + get_num_stream_endpoints();
+    const uint16_t end_block_port   = first_block_port + get_num_blocks();
+
+    // The NOC ID is the second register of every port, the flush status flags
+    // are in the third
+    std::vector<uint32_t> addrs;
+    addrs.reserve(2 * get_num_blocks());
+    for (uint16_t portno = first_block_port; portno < end_block_port; ++portno) {
+        addrs.push_back(_get_port_base_addr(portno) + 4);
+        addrs.push_back(_get_port_base_addr(portno) + 8);
+    }
+    const std::vector<uint32_t> values = regs().multi_peek32(addrs);
+
+    std::vector<port_status_t> status;
+    status.reserve(get_num_blocks());
+    for (uint16_t portno = first_block_port; portno < end_block_port; ++portno) {
+        const size_t i              = 2 * (portno - first_block_port);
+        const uint32_t flush_status = values.at(i + 1);
+        status.push_back({portno,
+            values.at(i),
+            bool(flush_status & 1),
+            bool(flush_status & (1 << 1))});
+    }
+    return status;
+}
+
 uint32_t client_zero::_get_port_base_addr(uint16_t portno)
 {
     return REGS_PER_PORT * portno * 4;
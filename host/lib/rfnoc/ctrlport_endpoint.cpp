@@ -9,12 +9,17 @@
 #include <uhd/utils/log.hpp>
 #include <uhdlib/rfnoc/chdr_packet_writer.hpp>
 #include <uhdlib/rfnoc/ctrlport_endpoint.hpp>
+#include <algorithm>
 #include <condition_variable>
 #include <boost/format.hpp>
 #include <deque>
+#include <exception>
+#include <future>
+#include <map>
 #include <mutex>
 #include <numeric>
 #include <queue>
+#include <thread>
 
 
 using namespace uhd;
@@ -33,6 +38,15 @@ constexpr double DEFAULT_TIMEOUT = 1.0;
 constexpr double MASSIVE_TIMEOUT = 10.0;
 //! Default value for whether ACKs are always required
 constexpr bool DEFAULT_FORCE_ACKS = false;
+//! Default value for whether the remote endpoint supports block writes
+constexpr bool DEFAULT_BLOCK_WRITES = false;
+//! Max number of data words in a control packet
+constexpr size_t MAX_DATA_WORDS = 15;
+//! Default max number of writes held on the host (0 disables holding writes)
+constexpr size_t DEFAULT_MAX_HELD_CMDS = 0;
+//! Max number of reads multi_peek32() keeps in flight. This must be well below the
+// number of sequence numbers, so responses can be matched up with their requests.
+constexpr size_t MAX_PIPELINED_PEEKS = 32;
 } // namespace
 
 ctrlport_endpoint::~ctrlport_endpoint() = default;
@@ -50,6 +64,7 @@ public:
         : _handle_send(send_fcn)
         , _my_epid(my_epid)
         , _local_port(local_port)
+        , _max_buff_capacity(buff_capacity)
         , _buff_capacity(buff_capacity)
         , _max_outstanding_async_msgs(max_outstanding_async_msgs)
         , _client_clk(client_clk)
@@ -57,13 +72,33 @@ public:
     {
     }
 
-    virtual ~ctrlport_endpoint_impl() = default;
+    virtual ~ctrlport_endpoint_impl()
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _stop_scheduler = true;
+        }
+        _held_cond.notify_all();
+        _buff_free_cond.notify_all();
+        if (_scheduler_thread.joinable()) {
+            _scheduler_thread.join();
+        }
+    }
 
     virtual void poke32(uint32_t addr,
         uint32_t data,
         uhd::time_spec_t timestamp = uhd::time_spec_t::ASAP,
         bool ack                   = false)
     {
+        if (!ack && !_policy.force_acks && add_to_batch({{addr, data, timestamp}})) {
+            return;
+        }
+        flush_batch();
+        if (!ack && !_policy.force_acks
+            && hold_write(OP_WRITE, addr, {data}, timestamp)) {
+            return;
+        }
+
         // Compute transaction expiration time
         auto timeout_time = start_timeout(_policy.timeout);
         // Send request
@@ -83,12 +118,12 @@ public:
         if (addrs.size() != data.size()) {
             throw uhd::value_error("addrs and data vectors must be of the same length");
         }
+        std::vector<pending_write_t> writes;
         for (size_t i = 0; i < data.size(); i++) {
-            poke32(addrs[i],
-                data[i],
-                (i == 0) ? timestamp : uhd::time_spec_t::ASAP,
-                (i == data.size() - 1) ? ack : false);
+            writes.push_back(
+                {addrs[i], data[i], (i == 0) ? timestamp : uhd::time_spec_t::ASAP});
         }
+        send_writes(writes, ack);
     }
 
     virtual void block_poke32(uint32_t first_addr,
@@ -96,29 +131,20 @@ public:
         uhd::time_spec_t timestamp = uhd::time_spec_t::ASAP,
         bool ack                   = false)
     {
+        std::vector<pending_write_t> writes;
         for (size_t i = 0; i < data.size(); i++) {
-            poke32(first_addr + (i * sizeof(uint32_t)),
+            writes.push_back({static_cast<uint32_t>(first_addr + (i * sizeof(uint32_t))),
                 data[i],
-                (i == 0) ? timestamp : uhd::time_spec_t::ASAP,
-                (i == data.size() - 1) ? ack : false);
+                (i == 0) ? timestamp : uhd::time_spec_t::ASAP});
         }
-
-        /* TODO: Uncomment when the atomic block poke is implemented in the FPGA
-        // Compute transaction expiration time
-        auto timeout_time = start_timeout(_policy.timeout);
-        // Send request
-        auto request = send_request_packet(
-            OP_BLOCK_WRITE, first_addr, data, timestamp, timeout_time);
-        // Optionally wait for an ACK
-        if (ack || _policy.force_acks) {
-            wait_for_ack(request, timeout_time);
-        }
-        */
+        send_writes(writes, ack);
     }
 
     virtual uint32_t peek32(
         uint32_t addr, uhd::time_spec_t timestamp = uhd::time_spec_t::ASAP)
     {
+        flush_batch();
+
         // Compute transaction expiration time, use MASSIVE_TIMEOUT if a timed
         // command is in the queue
         auto timeout_time =
@@ -136,12 +162,12 @@ public:
         size_t length,
         uhd::time_spec_t timestamp = uhd::time_spec_t::ASAP)
     {
-        std::vector<uint32_t> values;
+        std::vector<uint32_t> addrs;
+        addrs.reserve(length);
         for (size_t i = 0; i < length; i++) {
-            values.push_back(peek32(first_addr + (i * sizeof(uint32_t)),
-                (i == 0) ? timestamp : uhd::time_spec_t::ASAP));
+            addrs.push_back(first_addr + (i * sizeof(uint32_t)));
         }
-        return values;
+        return multi_peek32(addrs, timestamp);
 
         /* TODO: Uncomment when the atomic block peek is implemented in the FPGA
         // Compute transaction expiration time, use MASSIVE_TIMEOUT if a timed
@@ -161,6 +187,89 @@ public:
         */
     }
 
+    virtual std::vector<uint32_t> multi_peek32(const std::vector<uint32_t>& addrs,
+        uhd::time_spec_t timestamp = uhd::time_spec_t::ASAP)
+    {
+        if (addrs.size() == 1) {
+            return {peek32(addrs[0], timestamp)};
+        }
+        // Keep several reads in flight instead of waiting for every response
+        // before sending the next request. The responses come back in order.
+        const double timeout =
+            (timestamp != uhd::time_spec_t::ASAP || check_timed_in_queue())
+                ? MASSIVE_TIMEOUT
+                : _policy.timeout;
+        std::vector<uint32_t> values;
+        values.reserve(addrs.size());
+        std::deque<std::future<uint32_t>> pending;
+        auto wait_for_oldest = [&]() {
+            if (pending.front().wait_until(start_timeout(timeout))
+                != std::future_status::ready) {
+                throw uhd::op_timeout("Control operation timed out waiting for ACK");
+            }
+            values.push_back(pending.front().get());
+            pending.pop_front();
+        };
+        for (size_t i = 0; i < addrs.size(); i++) {
+            pending.push_back(
+                peek32_async(addrs[i], (i == 0) ? timestamp : uhd::time_spec_t::ASAP));
+            if (pending.size() >= MAX_PIPELINED_PEEKS) {
+                wait_for_oldest();
+            }
+        }
+        while (!pending.empty()) {
+            wait_for_oldest();
+        }
+        return values;
+    }
+
+    virtual std::future<void> poke32_async(
+        uint32_t addr, uint32_t data, uhd::time_spec_t timestamp = uhd::time_spec_t::ASAP)
+    {
+        flush_batch();
+
+        auto result = std::make_shared<std::promise<void>>();
+        send_request_packet(OP_WRITE,
+            addr,
+            {data},
+            timestamp,
+            start_timeout(_policy.timeout),
+            [result](const ctrl_payload*, std::exception_ptr error) {
+                if (error) {
+                    result->set_exception(error);
+                } else {
+                    result->set_value();
+                }
+            });
+        return result->get_future();
+    }
+
+    virtual std::future<uint32_t> peek32_async(
+        uint32_t addr, uhd::time_spec_t timestamp = uhd::time_spec_t::ASAP)
+    {
+        flush_batch();
+
+        // Compute transaction expiration time, use MASSIVE_TIMEOUT if a timed
+        // command is in the queue
+        auto timeout_time =
+            start_timeout(check_timed_in_queue() ? MASSIVE_TIMEOUT : _policy.timeout);
+
+        auto result = std::make_shared<std::promise<uint32_t>>();
+        send_request_packet(OP_READ,
+            addr,
+            {uint32_t(0)},
+            timestamp,
+            timeout_time,
+            [result](const ctrl_payload* response, std::exception_ptr error) {
+                if (error) {
+                    result->set_exception(error);
+                } else {
+                    result->set_value(response->data_vtr[0]);
+                }
+            });
+        return result->get_future();
+    }
+
     virtual void poll32(uint32_t addr,
         uint32_t data,
         uint32_t mask,
@@ -190,6 +299,8 @@ public:
 
     virtual void sleep(uhd::time_spec_t duration, bool ack = false)
     {
+        flush_batch();
+
         // Compute transaction expiration time, use MASSIVE_TIMEOUT if a timed
         // command is in the queue
         auto timeout_time =
@@ -207,6 +318,26 @@ public:
         }
     }
 
+    virtual void begin_batch()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _batch_depth++;
+    }
+
+    virtual void end_batch()
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_batch_depth == 0) {
+                throw uhd::runtime_error("end_batch() called without begin_batch()");
+            }
+            if (--_batch_depth > 0) {
+                return;
+            }
+        }
+        flush_batch();
+    }
+
     virtual void register_async_msg_validator(async_msg_validator_t callback_f)
     {
         std::unique_lock<std::mutex> lock(_mutex);
@@ -223,8 +354,19 @@ public:
     {
         std::unique_lock<std::mutex> lock(_mutex);
         if (name == "default") {
-            _policy.timeout    = args.cast<double>("timeout", DEFAULT_TIMEOUT);
-            _policy.force_acks = DEFAULT_FORCE_ACKS;
+            _policy.timeout      = args.cast<double>("timeout", DEFAULT_TIMEOUT);
+            _policy.force_acks   = DEFAULT_FORCE_ACKS;
+            _policy.block_writes = args.cast<bool>("block_writes", DEFAULT_BLOCK_WRITES);
+            _policy.max_held_cmds =
+                args.cast<size_t>("max_held_cmds", DEFAULT_MAX_HELD_CMDS);
+            // The command buffer may be configured smaller than reported by
+            // the device, e.g., to leave room for other software, but not larger
+            _buff_capacity =
+                std::min(args.cast<size_t>("buff_capacity", _max_buff_capacity),
+                    _max_buff_capacity);
+            if (_policy.max_held_cmds > 0 && !_scheduler_thread.joinable()) {
+                _scheduler_thread = std::thread([this]() { run_scheduler(); });
+            }
         } else {
             // TODO: Uncomment when custom policies are implemented
             throw uhd::not_implemented_error("Policy implemented in the FPGA");
@@ -240,27 +382,32 @@ public:
                 response_status_t resp_status = RESP_VALID;
                 // Grant flow control credits
                 _buff_occupied -= get_payload_size(_req_queue.front());
-                _buff_free_cond.notify_one();
+                _buff_free_cond.notify_all();
                 if (get_payload_size(_req_queue.front()) != get_payload_size(rx_ctrl)) {
                     resp_status = RESP_SIZEERR;
                 }
                 // Pop the request from the queue
                 _req_queue.pop_front();
-                // Push the response into the response queue
-                _resp_queue.push(std::make_tuple(rx_ctrl, resp_status));
-                _resp_ready_cond.notify_one();
+                // Complete an asynchronous request, or push the response into
+                // the response queue
+                if (!complete_async_request(rx_ctrl, resp_status)) {
+                    _resp_queue.push(std::make_tuple(rx_ctrl, resp_status));
+                    _resp_ready_cond.notify_one();
+                }
             };
             // Function to process a response with sequence errors
             auto process_incorrect_response = [this]() {
                 std::unique_lock<std::mutex> lock(_mutex);
                 // Grant flow control credits
                 _buff_occupied -= get_payload_size(_req_queue.front());
-                _buff_free_cond.notify_one();
+                _buff_free_cond.notify_all();
                 // Push a fabricated response into the response queue
                 ctrl_payload resp(_req_queue.front());
                 resp.is_ack = true;
-                _resp_queue.push(std::make_tuple(resp, RESP_DROPPED));
-                _resp_ready_cond.notify_one();
+                if (!complete_async_request(resp, RESP_DROPPED)) {
+                    _resp_queue.push(std::make_tuple(resp, RESP_DROPPED));
+                    _resp_ready_cond.notify_one();
+                }
                 // Pop the request from the queue
                 _req_queue.pop_front();
             };
@@ -350,12 +497,50 @@ public:
     }
 
 private:
+    //! The software status (different from the transaction status) of the response
+    enum response_status_t { RESP_VALID, RESP_DROPPED, RESP_RTERR, RESP_SIZEERR };
+    //! Function to call when an asynchronous request completes. It receives
+    // either the response, or an exception if the transaction failed.
+    using async_completion_fn_t =
+        std::function<void(const ctrl_payload* response, std::exception_ptr error)>;
+    //! A register write that is waiting to be sent
+    struct pending_write_t
+    {
+        uint32_t addr;
+        uint32_t data;
+        uhd::time_spec_t timestamp;
+    };
+    //! A write that is held on the host until there is room for it in the
+    // command buffer
+    struct held_write_t
+    {
+        ctrl_opcode_t op_code;
+        uint32_t addr;
+        std::vector<uint32_t> data;
+        uhd::time_spec_t timestamp;
+    };
+    //! An asynchronous request that is waiting for its response
+    struct async_request_t
+    {
+        ctrl_payload request;
+        steady_clock::time_point timeout_time;
+        async_completion_fn_t on_completion;
+    };
+
     //! Returns the length of the control payload in 32-bit words
     inline static size_t get_payload_size(const ctrl_payload& payload)
     {
         return 2 + (payload.timestamp.is_initialized() ? 2 : 0) + payload.data_vtr.size();
     }
 
+    //! Returns whether a payload of the given size fits into the downstream buffer
+    // Room for the responses to async messages is always kept free.
+    bool buff_has_room(const size_t pyld_size) const
+    {
+        return (_buff_occupied + pyld_size)
+               <= (_buff_capacity - (ASYNC_MESSAGE_SIZE * _max_outstanding_async_msgs));
+    }
+
     //! Marks the start of a timeout for an operation and returns the expiration time
     inline const steady_clock::time_point start_timeout(double duration)
     {
@@ -374,11 +559,16 @@ private:
     }
 
     //! Sends a request control packet to a remote device
+    //
+    // If a completion function is given, the request is asynchronous: The
+    // function is called from handle_recv() with the response once it
+    // arrives, or with an exception if the transaction fails or times out.
     const ctrl_payload send_request_packet(ctrl_opcode_t op_code,
         uint32_t address,
         const std::vector<uint32_t>& data_vtr,
         const uhd::time_spec_t& time_spec,
-        const steady_clock::time_point& timeout_time)
+        const steady_clock::time_point& timeout_time,
+        const async_completion_fn_t& on_completion = async_completion_fn_t())
     {
         if (!_client_clk.is_running()) {
             throw uhd::system_error("Ctrlport client clock is not running");
@@ -409,15 +599,24 @@ private:
 
         std::unique_lock<std::mutex> lock(_mutex);
 
+        // Requests must not overtake the writes held by the scheduler
+        const bool is_scheduler =
+            std::this_thread::get_id() == _scheduler_thread.get_id();
+        if (!is_scheduler && !_held_writes.empty()) {
+            if (not _held_cond.wait_until(lock,
+                    start_timeout(MASSIVE_TIMEOUT),
+                    [this]() { return _held_writes.empty(); })) {
+                throw uhd::op_timeout(
+                    "Control operation timed out waiting for held writes to be sent");
+            }
+        }
+
         // Perform flow control
         // If there is no room in the downstream buffer, then wait until the timeout
         size_t pyld_size   = get_payload_size(tx_ctrl);
-        auto buff_not_full = [this, pyld_size]() -> bool {
-            // Allocate room in the queue for one async response packet
+        auto buff_not_full = [this, pyld_size, is_scheduler]() -> bool {
             // If we can fit the current request in the queue then we can proceed
-            return (_buff_occupied + pyld_size)
-                   <= (_buff_capacity
-                       - (ASYNC_MESSAGE_SIZE * _max_outstanding_async_msgs));
+            return buff_has_room(pyld_size) || (is_scheduler && _stop_scheduler);
         };
         if (!buff_not_full()) {
             // If we're sending a timed command or if we have a timed command in the
@@ -428,10 +627,28 @@ private:
                 throw uhd::op_timeout(
                     "Control operation timed out waiting for space in command buffer");
             }
+            if (is_scheduler && _stop_scheduler) {
+                throw uhd::runtime_error("Control endpoint is shutting down");
+            }
         }
         _buff_occupied += pyld_size;
         _req_queue.push_back(tx_ctrl);
 
+        // Register asynchronous requests before sending, the response may
+        // arrive before this function returns
+        expire_async_requests();
+        auto async_req = _async_reqs.find(tx_ctrl.seq_num);
+        if (async_req != _async_reqs.end()) {
+            // Sequence numbers wrapped around while a request was still
+            // waiting for its response
+            fail_async_request(async_req->second,
+                uhd::op_seqerr("Response for a control transaction was dropped"));
+            _async_reqs.erase(async_req);
+        }
+        if (on_completion) {
+            _async_reqs[tx_ctrl.seq_num] = {tx_ctrl, timeout_time, on_completion};
+        }
+
         // Send the payload as soon as there is room in the buffer
         _handle_send(tx_ctrl, _policy.timeout);
         _tx_seq_num = (_tx_seq_num + 1) % 64;
@@ -459,26 +676,8 @@ private:
             _resp_queue.pop();
             // Check if this is the response meant for the request
             // Filter by op_code, address and seq_num
-            if (rx_ctrl.seq_num == request.seq_num && rx_ctrl.op_code == request.op_code
-                && rx_ctrl.address == request.address) {
-                // Validate transaction status
-                if (rx_ctrl.status == CMD_CMDERR) {
-                    throw uhd::op_failed("Control operation returned a failing status");
-                } else if (rx_ctrl.status == CMD_TSERR) {
-                    throw uhd::op_timerr("Control operation returned a timestamp error");
-                }
-                // Check data vector size
-                if (rx_ctrl.data_vtr.size() == 0) {
-                    throw uhd::op_failed(
-                        "Control operation returned a malformed response");
-                }
-                // Validate response status
-                if (resp_status == RESP_DROPPED) {
-                    throw uhd::op_seqerr(
-                        "Response for a control transaction was dropped");
-                } else if (resp_status == RESP_RTERR) {
-                    throw uhd::op_timerr("Control operation encountered a routing error");
-                }
+            if (is_response_for(rx_ctrl, request)) {
+                check_response(rx_ctrl, resp_status);
                 return rx_ctrl;
             } else {
                 // This response does not belong to the request we passed in. Move on.
@@ -487,24 +686,258 @@ private:
         }
     }
 
+    //! Holds back writes while a batch is active
+    //
+    // Returns false if there is no batch, and the writes must be sent now.
+    bool add_to_batch(const std::vector<pending_write_t>& writes)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_batch_depth == 0) {
+            return false;
+        }
+        _batch.insert(_batch.end(), writes.begin(), writes.end());
+        return true;
+    }
+
+    //! Sends the writes held back so far, so they go out before any other request
+    void flush_batch()
+    {
+        std::vector<pending_write_t> writes;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            writes.swap(_batch);
+        }
+        if (!writes.empty()) {
+            send_coalesced_writes(writes, false);
+        }
+    }
+
+    //! Sends a sequence of writes, or adds them to the current batch
+    void send_writes(const std::vector<pending_write_t>& writes, const bool ack)
+    {
+        if (!ack && !_policy.force_acks && add_to_batch(writes)) {
+            return;
+        }
+        flush_batch();
+        send_coalesced_writes(writes, ack);
+    }
+
+    //! Sends a sequence of writes with as few control packets as possible
+    //
+    // If the remote endpoint supports block writes, runs of writes to
+    // consecutive addresses go out as a single block write. A write at the
+    // same time as the previous one does not need its own timestamp, because
+    // the endpoint executes commands in order. If requested, this waits for
+    // the ACK of the last packet.
+    void send_coalesced_writes(const std::vector<pending_write_t>& writes, const bool ack)
+    {
+        uhd::time_spec_t last_timestamp = uhd::time_spec_t::ASAP;
+        for (size_t i = 0; i < writes.size();) {
+            const pending_write_t& first = writes[i];
+
+            std::vector<uint32_t> data = {first.data};
+            if (_policy.block_writes) {
+                while (i + data.size() < writes.size() && data.size() < MAX_DATA_WORDS
+                       && writes[i + data.size()].addr
+                              == first.addr + data.size() * sizeof(uint32_t)
+                       && (writes[i + data.size()].timestamp == uhd::time_spec_t::ASAP
+                           || writes[i + data.size()].timestamp == first.timestamp)) {
+                    data.push_back(writes[i + data.size()].data);
+                }
+            }
+            i += data.size();
+
+            const uhd::time_spec_t timestamp =
+                (first.timestamp == last_timestamp) ? uhd::time_spec_t::ASAP
+                                                    : first.timestamp;
+            if (first.timestamp != uhd::time_spec_t::ASAP) {
+                last_timestamp = first.timestamp;
+            }
+
+            const ctrl_opcode_t op_code = data.size() == 1 ? OP_WRITE : OP_BLOCK_WRITE;
+            const bool need_ack = (ack && i == writes.size()) || _policy.force_acks;
+            if (!need_ack && hold_write(op_code, first.addr, data, timestamp)) {
+                continue;
+            }
+            auto timeout_time = start_timeout(_policy.timeout);
+            auto request =
+                send_request_packet(op_code, first.addr, data, timestamp, timeout_time);
+            if (need_ack) {
+                wait_for_ack(request, timeout_time);
+            }
+        }
+    }
+
+    //! Hands a write over to the scheduler if it can't be sent without blocking
+    //
+    // The write is held if the downstream buffer is full (usually because
+    // timed commands are waiting in it), or if other writes are already held.
+    // The scheduler sends held writes in order as soon as there is room for
+    // them. Only if the limit of held writes is reached does this block.
+    //
+    // Returns false if holding writes is disabled, or the write can be sent
+    // right away.
+    bool hold_write(const ctrl_opcode_t op_code,
+        const uint32_t addr,
+        const std::vector<uint32_t>& data,
+        const uhd::time_spec_t& timestamp)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_policy.max_held_cmds == 0) {
+            return false;
+        }
+        const size_t pyld_size =
+            2 + (timestamp != uhd::time_spec_t::ASAP ? 2 : 0) + data.size();
+        if (_held_writes.empty() && buff_has_room(pyld_size)) {
+            return false;
+        }
+        if (not _held_cond.wait_until(lock, start_timeout(MASSIVE_TIMEOUT), [this]() {
+                return _held_writes.size() < _policy.max_held_cmds;
+            })) {
+            throw uhd::op_timeout("Control operation timed out waiting for space in the "
+                                  "host command queue");
+        }
+        _held_writes.push_back({op_code, addr, data, timestamp});
+        _held_cond.notify_all();
+        return true;
+    }
+
+    //! Sends the held writes, see hold_write()
+    void run_scheduler()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            _held_cond.wait(
+                lock, [this]() { return _stop_scheduler || !_held_writes.empty(); });
+            if (_stop_scheduler) {
+                if (!_held_writes.empty()) {
+                    UHD_LOG_WARNING("CTRLEP",
+                        "Dropping " << _held_writes.size()
+                                    << " held control writes on shutdown");
+                }
+                return;
+            }
+            // Leave the write in the queue while it's sent, so no other
+            // request can overtake it
+            const held_write_t write = _held_writes.front();
+            lock.unlock();
+            try {
+                send_request_packet(write.op_code,
+                    write.addr,
+                    write.data,
+                    write.timestamp,
+                    start_timeout(MASSIVE_TIMEOUT));
+            } catch (const std::exception& ex) {
+                UHD_LOG_ERROR(
+                    "CTRLEP", "Failed to send held control write: " << ex.what());
+            }
+            lock.lock();
+            _held_writes.pop_front();
+            _held_cond.notify_all();
+        }
+    }
+
+    //! Returns whether a response belongs to a request
+    // Filter by op_code, address and seq_num
+    inline static bool is_response_for(
+        const ctrl_payload& response, const ctrl_payload& request)
+    {
+        return response.seq_num == request.seq_num
+               && response.op_code == request.op_code
+               && response.address == request.address;
+    }
+
+    //! Throws an exception if the response indicates a failed transaction
+    static void check_response(
+        const ctrl_payload& rx_ctrl, const response_status_t resp_status)
+    {
+        // Validate transaction status
+        if (rx_ctrl.status == CMD_CMDERR) {
+            throw uhd::op_failed("Control operation returned a failing status");
+        } else if (rx_ctrl.status == CMD_TSERR) {
+            throw uhd::op_timerr("Control operation returned a timestamp error");
+        }
+        // Check data vector size
+        if (rx_ctrl.data_vtr.size() == 0) {
+            throw uhd::op_failed("Control operation returned a malformed response");
+        }
+        // Validate response status
+        if (resp_status == RESP_DROPPED) {
+            throw uhd::op_seqerr("Response for a control transaction was dropped");
+        } else if (resp_status == RESP_RTERR) {
+            throw uhd::op_timerr("Control operation encountered a routing error");
+        }
+    }
+
+    //! Completes the asynchronous request a response belongs to, if there is one
+    //
+    // Must be called with _mutex held. Returns false if the response does not
+    // belong to an asynchronous request.
+    bool complete_async_request(
+        const ctrl_payload& rx_ctrl, const response_status_t resp_status)
+    {
+        auto it = _async_reqs.find(rx_ctrl.seq_num);
+        if (it == _async_reqs.end() || !is_response_for(rx_ctrl, it->second.request)) {
+            return false;
+        }
+        const async_completion_fn_t on_completion = std::move(it->second.on_completion);
+        _async_reqs.erase(it);
+
+        try {
+            check_response(rx_ctrl, resp_status);
+        } catch (...) {
+            on_completion(nullptr, std::current_exception());
+            return true;
+        }
+        on_completion(&rx_ctrl, nullptr);
+        return true;
+    }
+
+    //! Completes an asynchronous request with an exception
+    template <typename exception_t>
+    static void fail_async_request(
+        const async_request_t& async_req, const exception_t& error)
+    {
+        async_req.on_completion(nullptr, std::make_exception_ptr(error));
+    }
+
+    //! Fails all asynchronous requests that have not been answered in time
+    //
+    // Must be called with _mutex held.
+    void expire_async_requests()
+    {
+        const auto now = steady_clock::now();
+        for (auto it = _async_reqs.begin(); it != _async_reqs.end();) {
+            if (it->second.timeout_time < now) {
+                fail_async_request(it->second,
+                    uhd::op_timeout("Control operation timed out waiting for ACK"));
+                it = _async_reqs.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
 
     //! The parameters associated with the policy that governs this object
     struct policy_args
     {
-        double timeout  = DEFAULT_TIMEOUT;
-        bool force_acks = DEFAULT_FORCE_ACKS;
+        double timeout    = DEFAULT_TIMEOUT;
+        bool force_acks   = DEFAULT_FORCE_ACKS;
+        bool block_writes = DEFAULT_BLOCK_WRITES;
+        //! Max number of writes to hold on the host when the command buffer is
+        // full, see hold_write()
+        size_t max_held_cmds = DEFAULT_MAX_HELD_CMDS;
     };
-    //! The software status (different from the transaction status) of the response
-    enum response_status_t { RESP_VALID, RESP_DROPPED, RESP_RTERR, RESP_SIZEERR };
-
     //! Function to call to send a control packet
     const send_fn_t _handle_send;
     //! The endpoint ID of this software endpoint
     const sep_id_t _my_epid;
     //! The local port number on the control crossbar for this ctrlport endpoint
     const uint16_t _local_port;
+    //! The downstream buffer capacity in 32-bit words, as reported by the device
+    const size_t _max_buff_capacity;
     //! The downstream buffer capacity in 32-bit words (used for flow control)
-    const size_t _buff_capacity;
+    size_t _buff_capacity;
     //! The max number of outstanding async messages that a block can have at any time
     const size_t _max_outstanding_async_msgs;
     //! The clock that drives the ctrlport endpoint
@@ -528,12 +961,26 @@ private:
     std::condition_variable _buff_free_cond;
     //! A queue that holds all outstanding requests
     std::deque<ctrl_payload> _req_queue;
+    //! The nesting depth of begin_batch() calls
+    size_t _batch_depth = 0;
+    //! The writes held back by the current batch
+    std::vector<pending_write_t> _batch;
+    //! Asynchronous requests waiting for their response, by sequence number
+    std::map<uint8_t, async_request_t> _async_reqs;
     //! A queue that holds all outstanding responses and their status
     std::queue<std::tuple<ctrl_payload, response_status_t>> _resp_queue;
     //! A condition variable that hold the "response is available" condition
     std::condition_variable _resp_ready_cond;
+    //! Writes waiting for room in the downstream buffer, see hold_write()
+    std::deque<held_write_t> _held_writes;
+    //! A condition variable for changes to _held_writes
+    std::condition_variable _held_cond;
+    //! Set when the scheduler thread must exit
+    bool _stop_scheduler = false;
     //! A mutex to protect all state in this class
     std::mutex _mutex;
+    //! Sends the held writes. Only runs if holding writes is enabled.
+    std::thread _scheduler_thread;
 };
 
 ctrlport_endpoint::sptr ctrlport_endpoint::make(const send_fn_t& handle_send,
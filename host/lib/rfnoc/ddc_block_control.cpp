@@ -114,7 +114,7 @@ public:
             set_command_time(time.get(), chan);
         }
         // This will trigger property propagation:
-        set_property<double>("freq", freq, chan);
+        get_property_handle(&_freq.at(chan)).set(freq);
         set_command_time(prev_cmd_time, chan);
         return get_freq(chan);
     }
@@ -139,7 +139,7 @@ public:
 
     void set_input_rate(const double rate, const size_t chan)
     {
-        set_property<double>("samp_rate", rate, {res_source_info::INPUT_EDGE, chan});
+        get_property_handle(&_samp_rate_in.at(chan)).set(rate);
     }
 
     double get_output_rate(const size_t chan) const
@@ -167,12 +167,12 @@ public:
     {
         if (_samp_rate_in.at(chan).is_valid()) {
             const int coerced_decim = coerce_decim(get_input_rate(chan) / rate);
-            set_property<int>("decim", coerced_decim, chan);
+            get_property_handle(&_decim.at(chan)).set(coerced_decim);
         } else {
             RFNOC_LOG_DEBUG("Property samp_rate@"
                             << chan << " is not valid, attempting to set output rate "
                             << (rate / 1e6) << " Msps via the edge property.");
-            set_property<double>("samp_rate", rate, {res_source_info::OUTPUT_EDGE, chan});
+            get_property_handle(&_samp_rate_out.at(chan)).set(rate);
         }
         return _samp_rate_out.at(chan).get();
     }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "../utils/async_python.hpp"
 #include "block_controller_factory_python.hpp"
 #include <uhd/rfnoc/ddc_block_control.hpp>
 
@@ -20,13 +21,16 @@ void export_ddc_block_control(py::module& m)
             &ddc_block_control::set_freq,
             py::arg("freq"),
             py::arg("chan"),
-            py::arg("time") = boost::optional<uhd::time_spec_t>())
-        .def("get_freq", &ddc_block_control::get_freq)
-        .def("get_frequency_range", &ddc_block_control::get_frequency_range)
-        .def("get_input_rate", &ddc_block_control::get_input_rate)
-        .def("set_input_rate", &ddc_block_control::set_input_rate)
-        .def("get_output_rate", &ddc_block_control::get_output_rate)
-        .def("get_output_rates", &ddc_block_control::get_output_rates)
-        .def("set_output_rate", &ddc_block_control::set_output_rate)
-        .def("issue_stream_cmd", &ddc_block_control::issue_stream_cmd);
+            py::arg("time") = boost::optional<uhd::time_spec_t>(),
+            release_gil())
+        .def("get_freq", &ddc_block_control::get_freq, release_gil())
+        .def("get_frequency_range",
+            &ddc_block_control::get_frequency_range,
+            release_gil())
+        .def("get_input_rate", &ddc_block_control::get_input_rate, release_gil())
+        .def("set_input_rate", &ddc_block_control::set_input_rate, release_gil())
+        .def("get_output_rate", &ddc_block_control::get_output_rate, release_gil())
+        .def("get_output_rates", &ddc_block_control::get_output_rates, release_gil())
+        .def("set_output_rate", &ddc_block_control::set_output_rate, release_gil())
+        .def("issue_stream_cmd", &ddc_block_control::issue_stream_cmd, release_gil());
 }
@@ -41,7 +41,10 @@ public:
                 },
                 [this, i](
                     const uint32_t addr) { return regs().peek32(addr + i * REG_OFFSET); },
-                i));
+                i,
+                [this, i](const uint32_t addr) {
+                    return regs().peek64(addr + i * REG_OFFSET);
+                }));
             RFNOC_LOG_DEBUG("Initialized FIFO core " << i << ".");
             if (_fifo_cores.back()->has_bist()) {
                 RFNOC_LOG_DEBUG("Running BIST...");
@@ -56,6 +59,18 @@ public:
         }
     }
 
+    uint64_t get_fifo_size(const size_t chan) const
+    {
+        UHD_ASSERT_THROW(chan < _fifo_cores.size());
+        return _fifo_cores.at(chan)->get_fifo_size();
+    }
+
+    uint64_t get_fifo_fullness(const size_t chan)
+    {
+        UHD_ASSERT_THROW(chan < _fifo_cores.size());
+        return _fifo_cores.at(chan)->get_fifo_fullness();
+    }
+
     uint32_t get_packet_count(const size_t chan)
     {
         UHD_ASSERT_THROW(chan < _fifo_cores.size());
@@ -0,0 +1,32 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include "../utils/async_python.hpp"
+#include "block_controller_factory_python.hpp"
+#include <uhd/rfnoc/dmafifo_block_control.hpp>
+
+using namespace uhd::rfnoc;
+
+void export_dmafifo_block_control(py::module& m)
+{
+    py::class_<dmafifo_block_control, noc_block_base, dmafifo_block_control::sptr>(
+        m, "dmafifo_block_control")
+        .def(py::init(&block_controller_factory<dmafifo_block_control>::make_from))
+        .def("get_fifo_size",
+            &dmafifo_block_control::get_fifo_size,
+            py::arg("chan") = 0,
+            release_gil())
+        .def("get_fifo_fullness",
+            &dmafifo_block_control::get_fifo_fullness,
+            py::arg("chan") = 0,
+            release_gil())
+        .def("get_packet_count",
+            &dmafifo_block_control::get_packet_count,
+            py::arg("chan") = 0,
+            release_gil());
+}
@@ -111,7 +111,7 @@ public:
             set_command_time(time.get(), chan);
         }
         // This will trigger property propagation:
-        set_property<double>("freq", freq, chan);
+        get_property_handle(&_freq.at(chan)).set(freq);
         set_command_time(prev_cmd_time, chan);
         return get_freq(chan);
     }
@@ -141,7 +141,7 @@ public:
 
     void set_output_rate(const double rate, const size_t chan)
     {
-        set_property<double>("samp_rate", rate, {res_source_info::OUTPUT_EDGE, chan});
+        get_property_handle(&_samp_rate_out.at(chan)).set(rate);
     }
 
     uhd::meta_range_t get_input_rates(const size_t chan) const
@@ -164,13 +164,13 @@ public:
     {
         if (_samp_rate_out.at(chan).is_valid()) {
             const int coerced_interp = coerce_interp(get_output_rate(chan) / rate);
-            set_property<int>("interp", coerced_interp, chan);
+            get_property_handle(&_interp.at(chan)).set(coerced_interp);
         } else {
             RFNOC_LOG_DEBUG(
                 "Property samp_rate@"
                 << chan
                 << " is not valid, attempting to set input rate via the edge property.");
-            set_property<double>("samp_rate", rate, {res_source_info::INPUT_EDGE, chan});
+            get_property_handle(&_samp_rate_in.at(chan)).set(rate);
         }
         return _samp_rate_in.at(chan).get();
     }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "../utils/async_python.hpp"
 #include "block_controller_factory_python.hpp"
 #include <uhd/rfnoc/duc_block_control.hpp>
 
@@ -20,12 +21,15 @@ void export_duc_block_control(py::module& m)
             &duc_block_control::set_freq,
             py::arg("freq"),
             py::arg("chan"),
-            py::arg("time") = boost::optional<uhd::time_spec_t>())
-        .def("get_freq", &duc_block_control::get_freq)
-        .def("get_frequency_range", &duc_block_control::get_frequency_range)
-        .def("get_input_rate", &duc_block_control::get_input_rate)
-        .def("get_output_rate", &duc_block_control::get_output_rate)
-        .def("set_output_rate", &duc_block_control::set_output_rate)
-        .def("get_input_rates", &duc_block_control::get_input_rates)
-        .def("set_input_rate", &duc_block_control::set_input_rate);
+            py::arg("time") = boost::optional<uhd::time_spec_t>(),
+            release_gil())
+        .def("get_freq", &duc_block_control::get_freq, release_gil())
+        .def("get_frequency_range",
+            &duc_block_control::get_frequency_range,
+            release_gil())
+        .def("get_input_rate", &duc_block_control::get_input_rate, release_gil())
+        .def("get_output_rate", &duc_block_control::get_output_rate, release_gil())
+        .def("set_output_rate", &duc_block_control::set_output_rate, release_gil())
+        .def("get_input_rates", &duc_block_control::get_input_rates, release_gil())
+        .def("set_input_rate", &duc_block_control::set_input_rate, release_gil());
 }
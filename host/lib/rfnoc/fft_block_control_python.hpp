@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "../utils/async_python.hpp"
 #include "block_controller_factory_python.hpp"
 #include <uhd/rfnoc/fft_block_control.hpp>
 
@@ -33,14 +34,14 @@ void export_fft_block_control(py::module& m)
     py::class_<fft_block_control, noc_block_base, fft_block_control::sptr>(
         m, "fft_block_control")
         .def(py::init(&block_controller_factory<fft_block_control>::make_from))
-        .def("set_direction", &fft_block_control::set_direction)
-        .def("get_direction", &fft_block_control::get_direction)
-        .def("set_magnitude", &fft_block_control::set_magnitude)
-        .def("get_magnitude", &fft_block_control::get_magnitude)
-        .def("set_shift_config", &fft_block_control::set_shift_config)
-        .def("get_shift_config", &fft_block_control::get_shift_config)
-        .def("set_scaling", &fft_block_control::set_scaling)
-        .def("get_scaling", &fft_block_control::get_scaling)
-        .def("set_length", &fft_block_control::set_length)
-        .def("get_length", &fft_block_control::get_length);
+        .def("set_direction", &fft_block_control::set_direction, release_gil())
+        .def("get_direction", &fft_block_control::get_direction, release_gil())
+        .def("set_magnitude", &fft_block_control::set_magnitude, release_gil())
+        .def("get_magnitude", &fft_block_control::get_magnitude, release_gil())
+        .def("set_shift_config", &fft_block_control::set_shift_config, release_gil())
+        .def("get_shift_config", &fft_block_control::get_shift_config, release_gil())
+        .def("set_scaling", &fft_block_control::set_scaling, release_gil())
+        .def("get_scaling", &fft_block_control::get_scaling, release_gil())
+        .def("set_length", &fft_block_control::set_length, release_gil())
+        .def("get_length", &fft_block_control::get_length, release_gil());
 }
@@ -16,12 +16,19 @@ const uint32_t fir_filter_block_control::REG_FIR_MAX_NUM_COEFFS_ADDR  = 0;
 const uint32_t fir_filter_block_control::REG_FIR_LOAD_COEFF_ADDR      = 4;
 const uint32_t fir_filter_block_control::REG_FIR_LOAD_COEFF_LAST_ADDR = 8;
 
+namespace {
+
+//! Number of coefficient banks stored by the block controller
+constexpr size_t NUM_COEFF_BANKS = 8;
+
+} // namespace
+
 class fir_filter_block_control_impl : public fir_filter_block_control
 {
 public:
     RFNOC_BLOCK_CONSTRUCTOR(fir_filter_block_control)
     , _max_num_coeffs(this->regs().peek32(REG_FIR_MAX_NUM_COEFFS_ADDR)),
-        _coeffs(_max_num_coeffs, int16_t(0))
+        _banks(NUM_COEFF_BANKS, std::vector<int16_t>(_max_num_coeffs, int16_t(0)))
     {
         // register edge properties
         register_property(&_prop_type_in);
@@ -35,9 +42,11 @@ public:
             _prop_type_out.set(IO_TYPE_SC16);
         });
 
-        // initialize hardware with an impulse response
-        _coeffs[0] = std::numeric_limits<int16_t>::max();
-        _program_coefficients();
+        // initialize all banks, and the hardware, with an impulse response
+        for (auto& bank : _banks) {
+            bank[0] = std::numeric_limits<int16_t>::max();
+        }
+        _program_coefficients(uhd::time_spec_t::ASAP);
     }
 
     size_t get_max_num_coefficients() const
@@ -47,6 +56,22 @@ public:
 
     void set_coefficients(const std::vector<int16_t>& coeffs)
     {
+        set_bank_coefficients(_bank, coeffs);
+    }
+
+    std::vector<int16_t> get_coefficients() const
+    {
+        return _banks.at(_bank);
+    }
+
+    size_t get_num_coefficient_banks() const
+    {
+        return _banks.size();
+    }
+
+    void set_bank_coefficients(const size_t bank, const std::vector<int16_t>& coeffs)
+    {
+        _assert_bank(bank);
         if (coeffs.size() > _max_num_coeffs) {
             std::string error_msg =
                 "Too many filter coefficients specified (max " +
@@ -55,38 +80,73 @@ public:
         }
 
         // save the new coefficients...
-        _coeffs = coeffs;
+        _banks[bank] = coeffs;
         // ...and expand it to the number supported by the hardware,
         // padding with zeroes
-        _coeffs.resize(_max_num_coeffs, 0);
-        _program_coefficients();
+        _banks[bank].resize(_max_num_coeffs, 0);
+        if (bank == _bank) {
+            _program_coefficients(uhd::time_spec_t::ASAP);
+        }
     }
 
-    std::vector<int16_t> get_coefficients() const
+    std::vector<int16_t> get_bank_coefficients(const size_t bank) const
+    {
+        _assert_bank(bank);
+        return _banks[bank];
+    }
+
+    void select_coefficient_bank(const size_t bank, const uhd::time_spec_t& time)
+    {
+        _assert_bank(bank);
+        _bank = bank;
+        _program_coefficients(time);
+    }
+
+    size_t get_coefficient_bank() const
     {
-        return _coeffs;
+        return _bank;
     }
 
 private:
-    void _program_coefficients()
+    void _assert_bank(const size_t bank) const
     {
+        if (bank >= _banks.size()) {
+            throw uhd::value_error("Invalid coefficient bank " + std::to_string(bank)
+                                   + " (max " + std::to_string(_banks.size() - 1)
+                                   + ")");
+        }
+    }
+
+    //! Writes the coefficients of the selected bank to the hardware
+    //
+    // The filter only switches to the new coefficients with the write to
+    // REG_FIR_LOAD_COEFF_LAST_ADDR, so only that write is timed. All writes go
+    // out as one batch, without waiting for each other.
+    void _program_coefficients(const uhd::time_spec_t& time)
+    {
+        const std::vector<int16_t>& coeffs = _banks[_bank];
+        batch_scope batch(*this);
+
         // Write coefficients [0..num_coeffs-2]..
         std::vector<uint32_t> coeffs_addr(_max_num_coeffs - 1, REG_FIR_LOAD_COEFF_ADDR);
         std::vector<uint32_t> coeffs_minus_last(_max_num_coeffs - 1);
-        std::transform(_coeffs.begin(), _coeffs.end() - 1, coeffs_minus_last.begin(),
+        std::transform(coeffs.begin(), coeffs.end() - 1, coeffs_minus_last.begin(),
                 [this](int16_t value) -> uint32_t { return static_cast<uint32_t>(value); });
 
         this->regs().multi_poke32(coeffs_addr, coeffs_minus_last);
         // ...and the final coefficients (num_coeffs-1)
         this->regs().poke32(
-            REG_FIR_LOAD_COEFF_LAST_ADDR, _coeffs.at(_max_num_coeffs - 1));
+            REG_FIR_LOAD_COEFF_LAST_ADDR, coeffs.at(_max_num_coeffs - 1), time);
     }
 
     //! Number of coefficients supported by the FIR filter
     const size_t _max_num_coeffs;
 
-    //! Current FIR filter coefficients
-    std::vector<int16_t> _coeffs;
+    //! FIR filter coefficients of each bank
+    std::vector<std::vector<int16_t>> _banks;
+
+    //! Index of the selected coefficient bank
+    size_t _bank = 0;
 
     /**************************************************************************
      * Attributes
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "../utils/async_python.hpp"
 #include "block_controller_factory_python.hpp"
 #include <uhd/rfnoc/fir_filter_block_control.hpp>
 
@@ -17,7 +18,12 @@ void export_fir_filter_block_control(py::module& m)
         m, "fir_filter_block_control")
         .def(py::init(&block_controller_factory<fir_filter_block_control>::make_from))
         .def("get_max_num_coefficients",
-            &fir_filter_block_control::get_max_num_coefficients)
-        .def("set_coefficients", &fir_filter_block_control::set_coefficients)
-        .def("get_coefficients", &fir_filter_block_control::get_coefficients);
+            &fir_filter_block_control::get_max_num_coefficients,
+            release_gil())
+        .def("set_coefficients",
+            &fir_filter_block_control::set_coefficients,
+            release_gil())
+        .def("get_coefficients",
+            &fir_filter_block_control::get_coefficients,
+            release_gil());
 }
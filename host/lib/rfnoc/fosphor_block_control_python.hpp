@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "../utils/async_python.hpp"
 #include "block_controller_factory_python.hpp"
 #include <uhd/rfnoc/fosphor_block_control.hpp>
 
@@ -29,38 +30,85 @@ void export_fosphor_block_control(py::module& m)
     py::class_<fosphor_block_control, noc_block_base, fosphor_block_control::sptr>(
         m, "fosphor_block_control")
         .def(py::init(&block_controller_factory<fosphor_block_control>::make_from))
-        .def("set_enable_histogram", &fosphor_block_control::set_enable_histogram)
-        .def("get_enable_histogram", &fosphor_block_control::get_enable_histogram)
-        .def("set_enable_waterfall", &fosphor_block_control::set_enable_waterfall)
-        .def("get_enable_waterfall", &fosphor_block_control::get_enable_waterfall)
-        .def("clear_history", &fosphor_block_control::clear_history)
-        .def("set_enable_dither", &fosphor_block_control::set_enable_dither)
-        .def("get_enable_dither", &fosphor_block_control::get_enable_dither)
-        .def("set_enable_noise", &fosphor_block_control::set_enable_noise)
-        .def("get_enable_noise", &fosphor_block_control::get_enable_noise)
-        .def("set_histogram_decimation", &fosphor_block_control::set_histogram_decimation)
-        .def("get_histogram_decimation", &fosphor_block_control::get_histogram_decimation)
-        .def("set_histogram_offset", &fosphor_block_control::set_histogram_offset)
-        .def("get_histogram_offset", &fosphor_block_control::get_histogram_offset)
-        .def("set_histogram_scale", &fosphor_block_control::set_histogram_scale)
-        .def("get_histogram_scale", &fosphor_block_control::get_histogram_scale)
-        .def("set_histogram_rise_rate", &fosphor_block_control::set_histogram_rise_rate)
-        .def("get_histogram_rise_rate", &fosphor_block_control::get_histogram_rise_rate)
-        .def("set_histogram_decay_rate", &fosphor_block_control::set_histogram_decay_rate)
-        .def("get_histogram_decay_rate", &fosphor_block_control::get_histogram_decay_rate)
-        .def("set_spectrum_alpha", &fosphor_block_control::set_spectrum_alpha)
-        .def("get_spectrum_alpha", &fosphor_block_control::get_spectrum_alpha)
+        .def("set_enable_histogram",
+            &fosphor_block_control::set_enable_histogram,
+            release_gil())
+        .def("get_enable_histogram",
+            &fosphor_block_control::get_enable_histogram,
+            release_gil())
+        .def("set_enable_waterfall",
+            &fosphor_block_control::set_enable_waterfall,
+            release_gil())
+        .def("get_enable_waterfall",
+            &fosphor_block_control::get_enable_waterfall,
+            release_gil())
+        .def("clear_history", &fosphor_block_control::clear_history, release_gil())
+        .def("set_enable_dither",
+            &fosphor_block_control::set_enable_dither,
+            release_gil())
+        .def("get_enable_dither",
+            &fosphor_block_control::get_enable_dither,
+            release_gil())
+        .def("set_enable_noise", &fosphor_block_control::set_enable_noise, release_gil())
+        .def("get_enable_noise", &fosphor_block_control::get_enable_noise, release_gil())
+        .def("set_histogram_decimation",
+            &fosphor_block_control::set_histogram_decimation,
+            release_gil())
+        .def("get_histogram_decimation",
+            &fosphor_block_control::get_histogram_decimation,
+            release_gil())
+        .def("set_histogram_offset",
+            &fosphor_block_control::set_histogram_offset,
+            release_gil())
+        .def("get_histogram_offset",
+            &fosphor_block_control::get_histogram_offset,
+            release_gil())
+        .def("set_histogram_scale",
+            &fosphor_block_control::set_histogram_scale,
+            release_gil())
+        .def("get_histogram_scale",
+            &fosphor_block_control::get_histogram_scale,
+            release_gil())
+        .def("set_histogram_rise_rate",
+            &fosphor_block_control::set_histogram_rise_rate,
+            release_gil())
+        .def("get_histogram_rise_rate",
+            &fosphor_block_control::get_histogram_rise_rate,
+            release_gil())
+        .def("set_histogram_decay_rate",
+            &fosphor_block_control::set_histogram_decay_rate,
+            release_gil())
+        .def("get_histogram_decay_rate",
+            &fosphor_block_control::get_histogram_decay_rate,
+            release_gil())
+        .def("set_spectrum_alpha",
+            &fosphor_block_control::set_spectrum_alpha,
+            release_gil())
+        .def("get_spectrum_alpha",
+            &fosphor_block_control::get_spectrum_alpha,
+            release_gil())
         .def("set_spectrum_max_hold_decay",
-            &fosphor_block_control::set_spectrum_max_hold_decay)
+            &fosphor_block_control::set_spectrum_max_hold_decay,
+            release_gil())
         .def("get_spectrum_max_hold_decay",
-            &fosphor_block_control::get_spectrum_max_hold_decay)
+            &fosphor_block_control::get_spectrum_max_hold_decay,
+            release_gil())
         .def("set_waterfall_predivision",
-            &fosphor_block_control::set_waterfall_predivision)
+            &fosphor_block_control::set_waterfall_predivision,
+            release_gil())
         .def("get_waterfall_predivision",
-            &fosphor_block_control::get_waterfall_predivision)
-        .def("set_waterfall_mode", &fosphor_block_control::set_waterfall_mode)
-        .def("get_waterfall_mode", &fosphor_block_control::get_waterfall_mode)
-        .def("set_waterfall_decimation", &fosphor_block_control::set_waterfall_decimation)
-        .def(
-            "get_waterfall_decimation", &fosphor_block_control::get_waterfall_decimation);
+            &fosphor_block_control::get_waterfall_predivision,
+            release_gil())
+        .def("set_waterfall_mode",
+            &fosphor_block_control::set_waterfall_mode,
+            release_gil())
+        .def("get_waterfall_mode",
+            &fosphor_block_control::get_waterfall_mode,
+            release_gil())
+        .def("set_waterfall_decimation",
+            &fosphor_block_control::set_waterfall_decimation,
+            release_gil())
+        .def("get_waterfall_decimation",
+            &fosphor_block_control::get_waterfall_decimation,
+            release_gil());
 }
@@ -0,0 +1,46 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/rfnoc/gpio_sequence.hpp>
+#include <algorithm>
+
+using namespace uhd::rfnoc;
+using namespace uhd::rfnoc::detail;
+
+std::vector<gpio_write_group_t> uhd::rfnoc::detail::coalesce_gpio_sequence(
+    const std::vector<radio_control::gpio_sequence_entry_t>& sequence)
+{
+    std::vector<radio_control::gpio_sequence_entry_t> entries(sequence);
+    std::stable_sort(entries.begin(),
+        entries.end(),
+        [](const radio_control::gpio_sequence_entry_t& lhs,
+            const radio_control::gpio_sequence_entry_t& rhs) {
+            return lhs.time < rhs.time;
+        });
+
+    std::vector<gpio_write_group_t> groups;
+    for (const auto& entry : entries) {
+        if (entry.mask == 0) {
+            continue;
+        }
+        if (groups.empty() || groups.back().time != entry.time) {
+            groups.push_back({entry.time, {}});
+        }
+        auto& writes = groups.back().writes;
+        auto write   = std::find_if(
+            writes.begin(), writes.end(), [&entry](const gpio_write_t& write) {
+                return write.bank == entry.bank && write.attr == entry.attr;
+            });
+        if (write == writes.end()) {
+            writes.push_back(
+                {entry.bank, entry.attr, entry.mask, entry.value & entry.mask});
+        } else {
+            write->value = (write->value & ~entry.mask) | (entry.value & entry.mask);
+            write->mask |= entry.mask;
+        }
+    }
+    return groups;
+}
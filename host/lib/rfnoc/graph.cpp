@@ -11,6 +11,7 @@
 #include <boost/graph/filtered_graph.hpp>
 #include <boost/graph/topological_sort.hpp>
 #include <limits>
+#include <set>
 #include <utility>
 
 using namespace uhd::rfnoc;
@@ -69,108 +70,43 @@ private:
  *****************************************************************************/
 void graph_t::connect(node_ref_t src_node, node_ref_t dst_node, graph_edge_t edge_info)
 {
-    node_accessor_t node_accessor{};
-    UHD_LOG_TRACE(LOG_ID,
-        "Connecting block " << src_node->get_unique_id() << ":" << edge_info.src_port
-                            << " -> " << dst_node->get_unique_id() << ":"
-                            << edge_info.dst_port);
-
-    // Correctly populate edge_info
-    edge_info.src_blockid = src_node->get_unique_id();
-    edge_info.dst_blockid = dst_node->get_unique_id();
-
-    // Add nodes to graph, if not already in there:
-    _add_node(src_node);
-    _add_node(dst_node);
-    // Find vertex descriptors
-    auto src_vertex_desc = _node_map.at(src_node);
-    auto dst_vertex_desc = _node_map.at(dst_node);
-
-    // Set resolver callbacks:
-    node_accessor.set_resolve_all_callback(src_node, [this, src_vertex_desc]() {
-        this->resolve_all_properties(resolve_context::NODE_PROP, src_vertex_desc);
-    });
-    node_accessor.set_resolve_all_callback(dst_node, [this, dst_vertex_desc]() {
-        this->resolve_all_properties(resolve_context::NODE_PROP, dst_vertex_desc);
-    });
-    // Set post action callbacks:
-    node_accessor.set_post_action_callback(
-        src_node, [this, src_node](const res_source_info& src, action_info::sptr action) {
-            this->enqueue_action(src_node, src, action);
-        });
-    node_accessor.set_post_action_callback(
-        dst_node, [this, dst_node](const res_source_info& src, action_info::sptr action) {
-            this->enqueue_action(dst_node, src, action);
-        });
-
-    // Check if edge exists
-    auto out_edge_range = boost::out_edges(src_vertex_desc, _graph);
-    for (auto edge_it = out_edge_range.first; edge_it != out_edge_range.second;
-         ++edge_it) {
-        auto existing_edge_info = boost::get(edge_property_t(), _graph, *edge_it);
-
-        // if exact edge exists, do nothing and return
-        if (existing_edge_info == edge_info) {
-            UHD_LOG_INFO(LOG_ID,
-                "Ignoring repeated call to connect "
-                    << edge_info.src_blockid << ":" << edge_info.src_port << " -> "
-                    << edge_info.dst_blockid << ":" << edge_info.dst_port);
-            return;
-        }
+    connect({connection_t{src_node, dst_node, edge_info}});
+}
 
-        // if there is already an edge for the source block and port
-        if (existing_edge_info.src_port == edge_info.src_port
-            && existing_edge_info.src_blockid == edge_info.src_blockid) {
-            // if same destination block and port
-            if (existing_edge_info.dst_port == edge_info.dst_port
-                && existing_edge_info.dst_blockid == edge_info.dst_blockid) {
-                // attempt to modify edge properties - throw an error
-                UHD_LOG_ERROR(LOG_ID,
-                    "Caught attempt to modify properties of edge "
-                        << existing_edge_info.src_blockid << ":"
-                        << existing_edge_info.src_port << " -> "
-                        << existing_edge_info.dst_blockid << ":"
-                        << existing_edge_info.dst_port);
-                throw uhd::rfnoc_error("Caught attempt to modify properties of edge!");
-            } else {
-                // Attempt to reconnect already connected source block and port
-                UHD_LOG_ERROR(LOG_ID,
-                    "Attempting to reconnect output port "
-                        << existing_edge_info.src_blockid << ":"
-                        << existing_edge_info.src_port);
-                throw uhd::rfnoc_error("Attempting to reconnect output port!");
+void graph_t::connect(const std::vector<connection_t>& connections)
+{
+    std::vector<connection_t> added;
+    try {
+        for (const auto& connection : connections) {
+            if (_add_edge(std::get<0>(connection),
+                    std::get<1>(connection),
+                    std::get<2>(connection))) {
+                added.push_back(connection);
             }
         }
+    } catch (const uhd::rfnoc_error&) {
+        _remove_edges(added);
+        throw;
     }
-    auto in_edge_range = boost::in_edges(dst_vertex_desc, _graph);
-    for (auto edge_it = in_edge_range.first; edge_it != in_edge_range.second; ++edge_it) {
-        auto existing_edge_info = boost::get(edge_property_t(), _graph, *edge_it);
-        if (edge_info.dst_blockid == existing_edge_info.dst_blockid
-            && edge_info.dst_port == existing_edge_info.dst_port) {
-            UHD_LOG_ERROR(LOG_ID,
-                "Attempting to reconnect input port " << existing_edge_info.dst_blockid
-                                                      << ":"
-                                                      << existing_edge_info.dst_port);
-            throw uhd::rfnoc_error("Attempting to reconnect input port!");
-        }
+    if (added.empty()) {
+        return;
     }
 
-    // Create edge
-    auto edge_descriptor =
-        boost::add_edge(src_vertex_desc, dst_vertex_desc, edge_info, _graph);
-    UHD_ASSERT_THROW(edge_descriptor.second);
-
-    // Now make sure we didn't add an unintended cycle
+    // Now make sure we didn't add an unintended cycle. This only needs to
+    // happen once, no matter how many edges were added.
     try {
         _get_topo_sorted_nodes();
     } catch (const uhd::rfnoc_error&) {
-        UHD_LOG_ERROR(LOG_ID,
-            "Adding edge " << src_node->get_unique_id() << ":" << edge_info.src_port
-                           << " -> " << dst_node->get_unique_id() << ":"
-                           << edge_info.dst_port
-                           << " without disabling property_propagation_active will lead "
-                              "to unresolvable graph!");
-        boost::remove_edge(edge_descriptor.first, _graph);
+        for (const auto& connection : added) {
+            UHD_LOG_ERROR(LOG_ID,
+                "Adding edge "
+                    << print_edge(std::get<0>(connection),
+                           std::get<1>(connection),
+                           std::get<2>(connection))
+                    << " without disabling property_propagation_active will lead "
+                       "to unresolvable graph!");
+        }
+        _remove_edges(added);
         throw uhd::rfnoc_error(
             "Adding edge without disabling property_propagation_active will lead "
             "to unresolvable graph!");
@@ -195,6 +131,7 @@ void graph_t::disconnect(node_ref_t src_node, node_ref_t dst_node, graph_edge_t
             return (edge_info == boost::get(edge_property_t(), this->_graph, edge_desc));
         },
         _graph);
+    _topo_sorted_nodes_valid = false;
 
     if (boost::degree(src_vertex_desc, _graph) == 0) {
         _remove_node(src_node);
@@ -296,12 +233,21 @@ void graph_t::resolve_all_properties(
         }
     }
 
+    // If the property resolution was triggered by a node updating one of its
+    // properties, only nodes that have received new edge property values since
+    // can become dirty. We keep track of them so we don't have to search the
+    // entire graph for dirty nodes after every step, and only resolve those.
+    const bool incremental = context == resolve_context::NODE_PROP;
+    std::set<rfnoc_graph_t::vertex_descriptor> pending_nodes(
+        initial_dirty_nodes.cbegin(), initial_dirty_nodes.cend());
+    pending_nodes.insert(initial_node);
+
     // Now get all nodes in topologically sorted order, and the appropriate
     // iterators.
-    auto topo_sorted_nodes = _get_topo_sorted_nodes();
-    auto node_it           = topo_sorted_nodes.begin();
-    auto begin_it          = topo_sorted_nodes.begin();
-    auto end_it            = topo_sorted_nodes.end();
+    const auto& topo_sorted_nodes = _get_topo_sorted_nodes();
+    auto node_it                  = topo_sorted_nodes.begin();
+    auto begin_it                 = topo_sorted_nodes.begin();
+    auto end_it                   = topo_sorted_nodes.end();
     while (*node_it != initial_node) {
         // We know *node_it must be == initial_node at some point, because
         // otherwise, initial_dirty_nodes would have been empty
@@ -310,6 +256,7 @@ void graph_t::resolve_all_properties(
 
     // Start iterating over nodes
     bool forward_dir   = true;
+    bool first_node    = true;
     int num_iterations = 0;
     // If all edge properties were known at the beginning, a single iteration
     // would suffice. However, usually during the first time the property
@@ -321,29 +268,38 @@ void graph_t::resolve_all_properties(
     constexpr int MAX_NUM_ITERATIONS = 2;
     while (true) {
         node_ref_t current_node = boost::get(vertex_property_t(), _graph, *node_it);
-        UHD_LOG_TRACE(
-            LOG_ID, "Now resolving next node: " << current_node->get_unique_id());
-
-        // On current node, call local resolution. This may cause other
-        // properties to become dirty.
-        try {
-            node_accessor.resolve_props(current_node);
-        } catch (const uhd::resolve_error& ex) {
-            UHD_LOG_ERROR(LOG_ID, current_node->get_unique_id() + ": " + ex.what());
-            throw;
-        }
+        // Other than the initial node, which may have been asked to resolve
+        // properties that depend on ALWAYS_DIRTY, nodes without dirty
+        // properties have nothing to resolve or forward
+        const bool is_pending = pending_nodes.erase(*node_it) > 0;
+        if (!incremental || first_node
+            || (is_pending && !get_dirty_props(current_node).empty())) {
+            UHD_LOG_TRACE(
+                LOG_ID, "Now resolving next node: " << current_node->get_unique_id());
+
+            // On current node, call local resolution. This may cause other
+            // properties to become dirty.
+            try {
+                node_accessor.resolve_props(current_node);
+            } catch (const uhd::resolve_error& ex) {
+                UHD_LOG_ERROR(LOG_ID, current_node->get_unique_id() + ": " + ex.what());
+                throw;
+            }
 
-        //  Forward all edge props in all directions from current node. We make
-        //  sure to skip properties if the edge is flagged as
-        //  !property_propagation_active
-        _forward_edge_props(*node_it);
+            //  Forward all edge props in all directions from current node. We
+            //  make sure to skip properties if the edge is flagged as
+            //  !property_propagation_active
+            const auto neighbours = _forward_edge_props(*node_it);
+            pending_nodes.insert(neighbours.cbegin(), neighbours.cend());
 
-        // Now mark all properties on this node as clean
-        node_accessor.clean_props(current_node);
+            // Now mark all properties on this node as clean
+            node_accessor.clean_props(current_node);
+        }
+        first_node = false;
 
         // If the property resolution was triggered by a node updating one of
         // its properties, we can stop anytime there are no more dirty nodes.
-        if (context == resolve_context::NODE_PROP && _find_dirty_nodes().empty()) {
+        if (incremental && pending_nodes.empty()) {
             UHD_LOG_TRACE(LOG_ID,
                 "Terminating graph resolution early during iteration " << num_iterations);
             break;
@@ -509,6 +465,118 @@ void graph_t::enqueue_action(
 /******************************************************************************
  * Private methods
  *****************************************************************************/
+bool graph_t::_add_edge(node_ref_t src_node, node_ref_t dst_node, graph_edge_t edge_info)
+{
+    node_accessor_t node_accessor{};
+    UHD_LOG_TRACE(LOG_ID,
+        "Connecting block " << src_node->get_unique_id() << ":" << edge_info.src_port
+                            << " -> " << dst_node->get_unique_id() << ":"
+                            << edge_info.dst_port);
+
+    // Correctly populate edge_info
+    edge_info.src_blockid = src_node->get_unique_id();
+    edge_info.dst_blockid = dst_node->get_unique_id();
+
+    // Add nodes to graph, if not already in there:
+    _add_node(src_node);
+    _add_node(dst_node);
+    // Find vertex descriptors
+    auto src_vertex_desc = _node_map.at(src_node);
+    auto dst_vertex_desc = _node_map.at(dst_node);
+
+    // Set resolver callbacks:
+    node_accessor.set_resolve_all_callback(src_node, [this, src_vertex_desc]() {
+        this->resolve_all_properties(resolve_context::NODE_PROP, src_vertex_desc);
+    });
+    node_accessor.set_resolve_all_callback(dst_node, [this, dst_vertex_desc]() {
+        this->resolve_all_properties(resolve_context::NODE_PROP, dst_vertex_desc);
+    });
+    // Set post action callbacks:
+    node_accessor.set_post_action_callback(
+        src_node, [this, src_node](const res_source_info& src, action_info::sptr action) {
+            this->enqueue_action(src_node, src, action);
+        });
+    node_accessor.set_post_action_callback(
+        dst_node, [this, dst_node](const res_source_info& src, action_info::sptr action) {
+            this->enqueue_action(dst_node, src, action);
+        });
+
+    // Check if edge exists
+    auto out_edge_range = boost::out_edges(src_vertex_desc, _graph);
+    for (auto edge_it = out_edge_range.first; edge_it != out_edge_range.second;
+         ++edge_it) {
+        auto existing_edge_info = boost::get(edge_property_t(), _graph, *edge_it);
+
+        // if exact edge exists, do nothing and return
+        if (existing_edge_info == edge_info) {
+            UHD_LOG_INFO(LOG_ID,
+                "Ignoring repeated call to connect "
+                    << edge_info.src_blockid << ":" << edge_info.src_port << " -> "
+                    << edge_info.dst_blockid << ":" << edge_info.dst_port);
+            return false;
+        }
+
+        // if there is already an edge for the source block and port
+        if (existing_edge_info.src_port == edge_info.src_port
+            && existing_edge_info.src_blockid == edge_info.src_blockid) {
+            // if same destination block and port
+            if (existing_edge_info.dst_port == edge_info.dst_port
+                && existing_edge_info.dst_blockid == edge_info.dst_blockid) {
+                // attempt to modify edge properties - throw an error
+                UHD_LOG_ERROR(LOG_ID,
+                    "Caught attempt to modify properties of edge "
+                        << existing_edge_info.src_blockid << ":"
+                        << existing_edge_info.src_port << " -> "
+                        << existing_edge_info.dst_blockid << ":"
+                        << existing_edge_info.dst_port);
+                throw uhd::rfnoc_error("Caught attempt to modify properties of edge!");
+            } else {
+                // Attempt to reconnect already connected source block and port
+                UHD_LOG_ERROR(LOG_ID,
+                    "Attempting to reconnect output port "
+                        << existing_edge_info.src_blockid << ":"
+                        << existing_edge_info.src_port);
+                throw uhd::rfnoc_error("Attempting to reconnect output port!");
+            }
+        }
+    }
+    auto in_edge_range = boost::in_edges(dst_vertex_desc, _graph);
+    for (auto edge_it = in_edge_range.first; edge_it != in_edge_range.second; ++edge_it) {
+        auto existing_edge_info = boost::get(edge_property_t(), _graph, *edge_it);
+        if (edge_info.dst_blockid == existing_edge_info.dst_blockid
+            && edge_info.dst_port == existing_edge_info.dst_port) {
+            UHD_LOG_ERROR(LOG_ID,
+                "Attempting to reconnect input port " << existing_edge_info.dst_blockid
+                                                      << ":"
+                                                      << existing_edge_info.dst_port);
+            throw uhd::rfnoc_error("Attempting to reconnect input port!");
+        }
+    }
+
+    // Create edge
+    auto edge_descriptor =
+        boost::add_edge(src_vertex_desc, dst_vertex_desc, edge_info, _graph);
+    UHD_ASSERT_THROW(edge_descriptor.second);
+    _topo_sorted_nodes_valid = false;
+    return true;
+}
+
+void graph_t::_remove_edges(const std::vector<connection_t>& connections)
+{
+    for (const auto& connection : connections) {
+        graph_edge_t edge_info = std::get<2>(connection);
+        edge_info.src_blockid  = std::get<0>(connection)->get_unique_id();
+        edge_info.dst_blockid  = std::get<1>(connection)->get_unique_id();
+        boost::remove_out_edge_if(_node_map.at(std::get<0>(connection)),
+            [this, edge_info](rfnoc_graph_t::edge_descriptor edge_desc) {
+                return edge_info
+                       == boost::get(edge_property_t(), this->_graph, edge_desc);
+            },
+            _graph);
+    }
+    _topo_sorted_nodes_valid = false;
+}
+
 graph_t::vertex_list_t graph_t::_find_dirty_nodes()
 {
     // Create a view on the graph that doesn't include the back-edges
@@ -520,8 +588,12 @@ graph_t::vertex_list_t graph_t::_find_dirty_nodes()
     return vertex_list_t(v_iterators.first, v_iterators.second);
 }
 
-graph_t::vertex_list_t graph_t::_get_topo_sorted_nodes()
+const graph_t::vertex_list_t& graph_t::_get_topo_sorted_nodes()
 {
+    if (_topo_sorted_nodes_valid) {
+        return _topo_sorted_nodes;
+    }
+
     // Create a view on the graph that doesn't include the back-edges
     ForwardEdgePredicate edge_filter(_graph);
     boost::filtered_graph<rfnoc_graph_t, ForwardEdgePredicate> fg(_graph, edge_filter);
@@ -533,7 +605,9 @@ graph_t::vertex_list_t graph_t::_get_topo_sorted_nodes()
     } catch (boost::not_a_dag&) {
         throw uhd::rfnoc_error("Cannot resolve graph because it has at least one cycle!");
     }
-    return sorted_nodes;
+    _topo_sorted_nodes       = std::move(sorted_nodes);
+    _topo_sorted_nodes_valid = true;
+    return _topo_sorted_nodes;
 }
 
 void graph_t::_add_node(node_ref_t new_node)
@@ -543,6 +617,7 @@ void graph_t::_add_node(node_ref_t new_node)
     }
 
     _node_map.emplace(new_node, boost::add_vertex(new_node, _graph));
+    _topo_sorted_nodes_valid = false;
 }
 
 void graph_t::_remove_node(node_ref_t node)
@@ -556,6 +631,7 @@ void graph_t::_remove_node(node_ref_t node)
         // Remove the vertex
         boost::remove_vertex(vertex_desc, _graph);
         _node_map.erase(node);
+        _topo_sorted_nodes_valid = false;
 
         // Removing the vertex changes the vertex descriptors,
         // so update the node map
@@ -569,7 +645,8 @@ void graph_t::_remove_node(node_ref_t node)
 }
 
 
-void graph_t::_forward_edge_props(graph_t::rfnoc_graph_t::vertex_descriptor origin)
+graph_t::vertex_list_t graph_t::_forward_edge_props(
+    graph_t::rfnoc_graph_t::vertex_descriptor origin)
 {
     node_accessor_t node_accessor{};
     node_ref_t origin_node = boost::get(vertex_property_t(), _graph, origin);
@@ -582,6 +659,7 @@ void graph_t::_forward_edge_props(graph_t::rfnoc_graph_t::vertex_descriptor orig
         "Forwarding up to " << edge_props.size() << " edge properties from node "
                             << origin_node->get_unique_id());
 
+    vertex_list_t neighbours;
     for (auto prop : edge_props) {
         auto neighbour_node_info = _find_neighbour(origin, prop->get_src_info());
         if (neighbour_node_info.first != nullptr
@@ -592,8 +670,10 @@ void graph_t::_forward_edge_props(graph_t::rfnoc_graph_t::vertex_descriptor orig
                                               : neighbour_node_info.second.dst_port;
             node_accessor.forward_edge_property(
                 neighbour_node_info.first, neighbour_port, prop);
+            neighbours.push_back(_node_map.at(neighbour_node_info.first));
         }
     }
+    return neighbours;
 }
 
 bool graph_t::_assert_edge_props_consistent(rfnoc_graph_t::edge_descriptor edge)
@@ -0,0 +1,117 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/rfnoc/graph_snapshot.hpp>
+#include <sstream>
+
+using namespace uhd::rfnoc;
+
+namespace {
+
+//! The first line of every snapshot, with the version of the format
+const std::string SNAPSHOT_HEADER = "uhd_graph_snapshot 1";
+
+const std::string EDGE_KEY = "edge";
+const std::string PROP_KEY = "prop";
+
+std::string edge_type_to_string(const graph_edge_t::edge_t edge_type)
+{
+    switch (edge_type) {
+        case graph_edge_t::STATIC:
+            return "static";
+        case graph_edge_t::DYNAMIC:
+            return "dynamic";
+        default:
+            throw uhd::value_error(
+                "Graph snapshots can only hold connections between blocks!");
+    }
+}
+
+graph_edge_t::edge_t edge_type_from_string(const std::string& edge_type)
+{
+    if (edge_type == "static") {
+        return graph_edge_t::STATIC;
+    }
+    if (edge_type == "dynamic") {
+        return graph_edge_t::DYNAMIC;
+    }
+    throw uhd::value_error("Invalid edge type in graph snapshot: " + edge_type);
+}
+
+} // namespace
+
+std::string graph_snapshot_t::to_string() const
+{
+    std::ostringstream out;
+    out << SNAPSHOT_HEADER << "\n";
+    for (const auto& edge : edges) {
+        out << EDGE_KEY << " " << edge.src_blockid << " " << edge.src_port << " "
+            << edge.dst_blockid << " " << edge.dst_port << " "
+            << edge_type_to_string(edge.edge) << " "
+            << (edge.property_propagation_active ? 1 : 0) << "\n";
+    }
+    for (const auto& prop : properties) {
+        if (prop.value.find('\n') != std::string::npos) {
+            throw uhd::value_error("Cannot store the value of property " + prop.prop_id
+                                   + " on block " + prop.block_id
+                                   + " in a graph snapshot: It has a line break.");
+        }
+        // The value goes last, so it may contain spaces
+        out << PROP_KEY << " " << prop.block_id << " " << prop.prop_id << " "
+            << prop.instance << " " << prop.value << "\n";
+    }
+    return out.str();
+}
+
+graph_snapshot_t graph_snapshot_t::from_string(const std::string& snapshot)
+{
+    std::istringstream in(snapshot);
+    std::string line;
+    if (!std::getline(in, line) || line != SNAPSHOT_HEADER) {
+        throw uhd::value_error("Not a graph snapshot, or an unsupported version!");
+    }
+
+    graph_snapshot_t result;
+    size_t line_no = 1;
+    while (std::getline(in, line)) {
+        line_no++;
+        if (line.empty()) {
+            continue;
+        }
+        const std::string err_msg =
+            "Invalid graph snapshot, line " + std::to_string(line_no) + ": " + line;
+        std::istringstream fields(line);
+        std::string key;
+        fields >> key;
+        if (key == EDGE_KEY) {
+            graph_edge_t edge;
+            std::string edge_type;
+            int ppa = 0;
+            fields >> edge.src_blockid >> edge.src_port >> edge.dst_blockid
+                >> edge.dst_port >> edge_type >> ppa;
+            if (fields.fail() || !(fields >> std::ws).eof()) {
+                throw uhd::value_error(err_msg);
+            }
+            edge.edge                        = edge_type_from_string(edge_type);
+            edge.property_propagation_active = (ppa != 0);
+            result.edges.push_back(edge);
+        } else if (key == PROP_KEY) {
+            property_value_t prop;
+            fields >> prop.block_id >> prop.prop_id >> prop.instance;
+            if (fields.fail()) {
+                throw uhd::value_error(err_msg);
+            }
+            // Skip the one space in front of the value
+            fields.get();
+            std::getline(fields, prop.value);
+            result.properties.push_back(prop);
+        } else {
+            throw uhd::value_error(err_msg);
+        }
+    }
+    return result;
+}
@@ -33,9 +33,13 @@ public:
             _link_mgrs.emplace(lnk.first,
                 std::move(link_stream_manager::make(
                     pkt_factory, *lnk.second, epid_alloc, lnk.first)));
-            auto adapter = _link_mgrs.at(lnk.first)->get_adapter_id();
+            const auto& link_mgr = _link_mgrs.at(lnk.first);
+            auto adapter         = link_mgr->get_adapter_id();
             if (_alloc_map.count(adapter) == 0) {
-                _alloc_map[adapter] = allocation_info{0, 0};
+                allocation_info alloc;
+                alloc.rx_capacity   = link_mgr->get_link_rate(uhd::RX_DIRECTION);
+                alloc.tx_capacity   = link_mgr->get_link_rate(uhd::TX_DIRECTION);
+                _alloc_map[adapter] = alloc;
             }
         }
         for (const auto& mgr_pair : _link_mgrs) {
@@ -192,12 +196,17 @@ public:
         const device_addr_t& xport_args,
         const std::string& streamer_id)
     {
-        device_id_t dev = _check_dst_and_find_src(
-            src_addr, adapter, uhd::transport::link_type_t::RX_DATA);
+        const double bandwidth = _get_stream_bandwidth(pyld_buff_fmt, xport_args);
+        device_id_t dev        = _check_dst_and_find_src(
+            src_addr, adapter, uhd::transport::link_type_t::RX_DATA, bandwidth);
         uhd::transport::adapter_id_t chosen = _link_mgrs.at(dev)->get_adapter_id();
-        auto allocs                         = _alloc_map.at(chosen);
+        auto& allocs                        = _alloc_map.at(chosen);
         allocs.rx++;
-        _alloc_map[chosen] = allocs;
+        allocs.rx_load += bandwidth;
+        UHD_LOGGER_DEBUG("RFNOC::GRAPH")
+            << "Streaming from " << src_addr.first << ":" << src_addr.second
+            << " to the host on adapter " << chosen << ": "
+            << _format_load(bandwidth, allocs.rx_load, allocs.rx_capacity);
         return _link_mgrs.at(dev)->create_device_to_host_data_stream(
             src_addr, pyld_buff_fmt, mdata_buff_fmt, xport_args, streamer_id);
     }
@@ -210,12 +219,17 @@ public:
         const device_addr_t& xport_args,
         const std::string& streamer_id)
     {
-        device_id_t dev = _check_dst_and_find_src(
-            dst_addr, adapter, uhd::transport::link_type_t::TX_DATA);
+        const double bandwidth = _get_stream_bandwidth(pyld_buff_fmt, xport_args);
+        device_id_t dev        = _check_dst_and_find_src(
+            dst_addr, adapter, uhd::transport::link_type_t::TX_DATA, bandwidth);
         uhd::transport::adapter_id_t chosen = _link_mgrs.at(dev)->get_adapter_id();
-        auto allocs                         = _alloc_map.at(chosen);
+        auto& allocs                        = _alloc_map.at(chosen);
         allocs.tx++;
-        _alloc_map[chosen] = allocs;
+        allocs.tx_load += bandwidth;
+        UHD_LOGGER_DEBUG("RFNOC::GRAPH")
+            << "Streaming from the host to " << dst_addr.first << ":" << dst_addr.second
+            << " on adapter " << chosen << ": "
+            << _format_load(bandwidth, allocs.tx_load, allocs.tx_capacity);
         return _link_mgrs.at(dev)->create_host_to_device_data_stream(
             dst_addr, pyld_buff_fmt, mdata_buff_fmt, xport_args, streamer_id);
     }
@@ -239,15 +253,90 @@ public:
     }
 
 private:
+    // Data used for heuristic to determine which link to use
+    struct allocation_info
+    {
+        //! The number of streams
+        size_t rx = 0;
+        size_t tx = 0;
+        //! The sum of the bandwidths of the streams, in bytes/sec
+        double rx_load = 0.0;
+        double tx_load = 0.0;
+        //! The payload rate of the link, in bytes/sec, or 0 if unknown
+        double rx_capacity = 0.0;
+        double tx_capacity = 0.0;
+    };
+
+    /*! Return the bandwidth a data stream needs on the link, in bytes/sec
+     *
+     * This is the sample rate hint of the stream args, times the size of a
+     * complex item of the payload buffer format. Without a hint, the
+     * bandwidth is unknown and 0.
+     */
+    static double _get_stream_bandwidth(
+        const sw_buff_t pyld_buff_fmt, const device_addr_t& xport_args)
+    {
+        const double samp_rate = xport_args.cast<double>("samp_rate", 0.0);
+        return samp_rate * 2 * (size_t(8) >> pyld_buff_fmt);
+    }
+
+    /*! Return the share of the link that its streams would use, with an
+     * additional stream of \p bandwidth
+     *
+     * Links of unknown capacity all count as unused, so that they are only
+     * balanced by the number of streams.
+     */
+    static double _get_utilization(
+        const double load, const double capacity, const double bandwidth)
+    {
+        return capacity > 0.0 ? (load + bandwidth) / capacity : 0.0;
+    }
+
+    static std::string _format_load(
+        const double bandwidth, const double load, const double capacity)
+    {
+        if (capacity <= 0.0) {
+            return str(boost::format("%.1f MB/s, link capacity unknown")
+                       % (bandwidth / 1e6));
+        }
+        return str(boost::format("%.1f MB/s, link load %.1f of %.1f MB/s (%.0f%%)")
+                   % (bandwidth / 1e6) % (load / 1e6) % (capacity / 1e6)
+                   % (100.0 * load / capacity));
+    }
+
+    /*! Returns true if a new stream is better placed on the link of
+     * \p candidate than on the link of \p current
+     *
+     * The link that would be least utilized with the new stream wins. Links of
+     * equal utilization, e.g. if the bandwidth of the streams is unknown, are
+     * compared by the number of streams.
+     */
+    static bool _is_less_loaded(const allocation_info& candidate,
+        const allocation_info& current,
+        const uhd::direction_t dir,
+        const double bandwidth)
+    {
+        const bool is_rx = dir == uhd::RX_DIRECTION;
+        const double candidate_util =
+            is_rx ? _get_utilization(candidate.rx_load, candidate.rx_capacity, bandwidth)
+                  : _get_utilization(candidate.tx_load, candidate.tx_capacity, bandwidth);
+        const double current_util =
+            is_rx ? _get_utilization(current.rx_load, current.rx_capacity, bandwidth)
+                  : _get_utilization(current.tx_load, current.tx_capacity, bandwidth);
+        if (candidate_util != current_util) {
+            return candidate_util < current_util;
+        }
+        return is_rx ? candidate.rx < current.rx : candidate.tx < current.tx;
+    }
+
     device_id_t _check_dst_and_find_src(sep_addr_t dst_addr,
         uhd::transport::adapter_id_t adapter,
-        uhd::transport::link_type_t link_type) const
+        uhd::transport::link_type_t link_type,
+        const double bandwidth = 0.0) const
     {
         if (_src_map.count(dst_addr) > 0) {
             const auto& src_devs = _src_map.at(dst_addr);
             if (adapter == uhd::transport::NULL_ADAPTER_ID) {
-                // TODO: Maybe we can come up with a better heuristic for when the user
-                // gives no preference
                 auto dev       = src_devs[0];
                 auto dev_alloc = _alloc_map.at(_link_mgrs.at(dev)->get_adapter_id());
                 for (auto candidate : src_devs) {
@@ -255,13 +344,19 @@ private:
                         _alloc_map.at(_link_mgrs.at(candidate)->get_adapter_id());
                     switch (link_type) {
                         case uhd::transport::link_type_t::TX_DATA:
-                            if (candidate_alloc.tx < dev_alloc.tx) {
+                            if (_is_less_loaded(candidate_alloc,
+                                    dev_alloc,
+                                    uhd::TX_DIRECTION,
+                                    bandwidth)) {
                                 dev       = candidate;
                                 dev_alloc = candidate_alloc;
                             }
                             break;
                         case uhd::transport::link_type_t::RX_DATA:
-                            if (candidate_alloc.rx < dev_alloc.rx) {
+                            if (_is_less_loaded(candidate_alloc,
+                                    dev_alloc,
+                                    uhd::RX_DIRECTION,
+                                    bandwidth)) {
                                 dev       = candidate;
                                 dev_alloc = candidate_alloc;
                             }
@@ -295,13 +390,6 @@ private:
     // A map of addresses that can be taken to reach a particular destination
     std::map<sep_addr_t, std::vector<device_id_t>> _src_map;
 
-    // Data used for heuristic to determine which link to use
-    struct allocation_info
-    {
-        size_t rx;
-        size_t tx;
-    };
-
     // A map of allocations for each host transport adapter
     std::map<uhd::transport::adapter_id_t, allocation_info> _alloc_map;
 };
@@ -0,0 +1,512 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/math.hpp>
+#include <uhdlib/rfnoc/host_blocks.hpp>
+#include <algorithm>
+#include <cmath>
+
+using namespace uhd::rfnoc;
+
+namespace {
+
+//! Saturates a value to 16 bits
+template <typename T>
+inline int16_t clip16(const T value)
+{
+    return int16_t(std::min<T>(std::max<T>(value, T(-32768)), T(32767)));
+}
+
+//! Rounds to the nearest integer, with halves rounded up, and saturates
+inline int16_t round_clip16(const float value)
+{
+    return clip16<float>(std::floor(value + 0.5f));
+}
+
+//! Divides and rounds to the nearest integer, with halves rounded up
+inline int64_t round_div(const int64_t num, const int64_t den)
+{
+    const int64_t n = 2 * num + den;
+    const int64_t d = 2 * den;
+    // Division that rounds toward negative infinity
+    return n / d - ((n % d != 0) && ((n < 0) != (d < 0)));
+}
+
+//! Returns the largest power of 2 that isn't larger than \p value
+size_t floor_pow2(const size_t value)
+{
+    size_t result = 1;
+    while (result * 2 <= value) {
+        result *= 2;
+    }
+    return result;
+}
+
+} // namespace
+
+/******************************************************************************
+ * host_block
+ *****************************************************************************/
+host_block::sptr host_block::make(
+    const std::string& block_name, const uhd::device_addr_t& args)
+{
+    if (block_name == "KeepOneInN") {
+        auto block = std::make_shared<host_keep_one_in_n>();
+        block->set_n(args.cast<size_t>("n", 1));
+        block->set_mode(static_cast<host_keep_one_in_n::mode_t>(args.cast<int>(
+            "mode", static_cast<int>(host_keep_one_in_n::mode_t::SAMPLE_MODE))));
+        return block;
+    }
+    if (block_name == "MovingAverage") {
+        auto block = std::make_shared<host_moving_average>();
+        block->set_sum_len(uint8_t(args.cast<int>("sum_len", 10)));
+        block->set_divisor(args.cast<uint32_t>("divisor", 10));
+        return block;
+    }
+    if (block_name == "VectorIIR") {
+        auto block = std::make_shared<host_vector_iir>();
+        block->set_alpha(args.cast<double>("alpha", 0.9));
+        block->set_beta(args.cast<double>("beta", 0.9));
+        block->set_delay(uint16_t(args.cast<int>("delay", 1)));
+        return block;
+    }
+    if (block_name == "Window") {
+        return std::make_shared<host_window>();
+    }
+    if (block_name == "LogPwr") {
+        return std::make_shared<host_logpwr>();
+    }
+    if (block_name == "FFT") {
+        auto block = std::make_shared<host_fft>();
+        block->set_length(args.cast<size_t>("length", 256));
+        block->set_direction(static_cast<fft_direction>(
+            args.cast<int>("direction", static_cast<int>(fft_direction::FORWARD))));
+        block->set_magnitude(static_cast<fft_magnitude>(
+            args.cast<int>("magnitude", static_cast<int>(fft_magnitude::COMPLEX))));
+        block->set_shift_config(static_cast<fft_shift>(
+            args.cast<int>("shift_config", static_cast<int>(fft_shift::NORMAL))));
+        block->set_scaling(uint16_t(args.cast<int>("fft_scaling", 1706)));
+        return block;
+    }
+    if (block_name == "AddSub") {
+        return std::make_shared<host_addsub>();
+    }
+    if (block_name == "SplitStream") {
+        auto block = std::make_shared<host_split_stream>();
+        block->set_num_branches(args.cast<size_t>("num_branches", 2));
+        return block;
+    }
+    throw uhd::key_error("No host implementation of block " + block_name);
+}
+
+std::vector<std::string> host_block::get_block_names()
+{
+    return {"AddSub",
+        "FFT",
+        "KeepOneInN",
+        "LogPwr",
+        "MovingAverage",
+        "SplitStream",
+        "VectorIIR",
+        "Window"};
+}
+
+void host_block::check_ports(
+    const std::vector<const packet_t*>& in, std::vector<packet_t>& out) const
+{
+    if (in.size() != get_num_input_ports()) {
+        throw uhd::value_error("Host block expects "
+                               + std::to_string(get_num_input_ports())
+                               + " input packets, got " + std::to_string(in.size()));
+    }
+    out.resize(get_num_output_ports());
+}
+
+/******************************************************************************
+ * host_keep_one_in_n
+ *****************************************************************************/
+void host_keep_one_in_n::set_n(const size_t n)
+{
+    if (n == 0) {
+        throw uhd::value_error("Keep one in N: N must be at least 1");
+    }
+    _n = n;
+    reset();
+}
+
+void host_keep_one_in_n::set_mode(const mode_t mode)
+{
+    _mode = mode;
+    reset();
+}
+
+void host_keep_one_in_n::process(
+    const std::vector<const packet_t*>& in, std::vector<packet_t>& out)
+{
+    check_ports(in, out);
+    const packet_t& input = *in[0];
+    packet_t& output      = out[0];
+    if (_mode == mode_t::PACKET_MODE) {
+        if (_count == 0) {
+            output = input;
+        } else {
+            output.clear();
+        }
+        _count = (_count + 1) % _n;
+        return;
+    }
+    // The first kept sample of this packet, then every n-th one
+    const size_t first = (_n - _count) % _n;
+    output.clear();
+    for (size_t i = first; i < input.size(); i += _n) {
+        output.push_back(input[i]);
+    }
+    _count = (_count + input.size()) % _n;
+}
+
+void host_keep_one_in_n::reset()
+{
+    _count = 0;
+}
+
+/******************************************************************************
+ * host_moving_average
+ *****************************************************************************/
+void host_moving_average::set_sum_len(const uint8_t sum_len)
+{
+    if (sum_len == 0) {
+        throw uhd::value_error("Moving average: sum_len must be at least 1");
+    }
+    _sum_len = sum_len;
+    reset();
+}
+
+void host_moving_average::set_divisor(const uint32_t divisor)
+{
+    if (divisor == 0 || divisor >= (1 << 24)) {
+        throw uhd::value_error("Moving average: divisor must be in [1, 2^24)");
+    }
+    _divisor = divisor;
+}
+
+void host_moving_average::process(
+    const std::vector<const packet_t*>& in, std::vector<packet_t>& out)
+{
+    check_ports(in, out);
+    const packet_t& input = *in[0];
+    packet_t& output      = out[0];
+    output.resize(input.size());
+    for (size_t i = 0; i < input.size(); i++) {
+        _sum_i += int32_t(input[i].real()) - int32_t(_history[_pos].real());
+        _sum_q += int32_t(input[i].imag()) - int32_t(_history[_pos].imag());
+        _history[_pos] = input[i];
+        _pos           = (_pos + 1 == _sum_len) ? 0 : _pos + 1;
+        output[i]      = sample_t(clip16(round_div(_sum_i, _divisor)),
+            clip16(round_div(_sum_q, _divisor)));
+    }
+}
+
+void host_moving_average::reset()
+{
+    _history.assign(_sum_len, sample_t(0, 0));
+    _pos   = 0;
+    _sum_i = 0;
+    _sum_q = 0;
+}
+
+/******************************************************************************
+ * host_vector_iir
+ *****************************************************************************/
+void host_vector_iir::set_alpha(const double alpha)
+{
+    if (alpha < 0.0 || alpha > 1.0) {
+        throw uhd::value_error("Vector IIR: alpha must be in [0.0, 1.0]");
+    }
+    _alpha = float(alpha);
+}
+
+void host_vector_iir::set_beta(const double beta)
+{
+    if (beta < 0.0 || beta > 1.0) {
+        throw uhd::value_error("Vector IIR: beta must be in [0.0, 1.0]");
+    }
+    _beta = float(beta);
+}
+
+void host_vector_iir::set_delay(const uint16_t delay)
+{
+    if (delay == 0) {
+        throw uhd::value_error("Vector IIR: delay must be at least 1");
+    }
+    _feedback.resize(delay);
+    reset();
+}
+
+void host_vector_iir::process(
+    const std::vector<const packet_t*>& in, std::vector<packet_t>& out)
+{
+    check_ports(in, out);
+    const packet_t& input = *in[0];
+    packet_t& output      = out[0];
+    output.resize(input.size());
+    // Within a run of up to delay samples, the outputs only depend on the
+    // previous run, so this loop has no dependencies and vectorizes
+    const size_t delay = _feedback.size();
+    for (size_t i = 0; i < input.size();) {
+        const size_t num = std::min(delay - _pos, input.size() - i);
+        std::complex<float>* fb = &_feedback[_pos];
+        for (size_t k = 0; k < num; k++) {
+            const float re = _alpha * fb[k].real() + _beta * float(input[i + k].real());
+            const float im = _alpha * fb[k].imag() + _beta * float(input[i + k].imag());
+            fb[k]          = std::complex<float>(re, im);
+            output[i + k]  = sample_t(round_clip16(re), round_clip16(im));
+        }
+        i += num;
+        _pos = (_pos + num == delay) ? 0 : _pos + num;
+    }
+}
+
+void host_vector_iir::reset()
+{
+    std::fill(_feedback.begin(), _feedback.end(), std::complex<float>(0.0f, 0.0f));
+    _pos = 0;
+}
+
+/******************************************************************************
+ * host_window
+ *****************************************************************************/
+void host_window::set_coefficients(const std::vector<int16_t>& coeffs)
+{
+    if (coeffs.empty()) {
+        throw uhd::value_error("Window: at least one coefficient is required");
+    }
+    _coeffs = coeffs;
+    reset();
+}
+
+void host_window::process(
+    const std::vector<const packet_t*>& in, std::vector<packet_t>& out)
+{
+    check_ports(in, out);
+    const packet_t& input = *in[0];
+    packet_t& output      = out[0];
+    output.resize(input.size());
+    // The window continues across packets, and restarts after its length
+    for (size_t i = 0; i < input.size();) {
+        const size_t num     = std::min(_coeffs.size() - _pos, input.size() - i);
+        const int16_t* coeff = &_coeffs[_pos];
+        for (size_t k = 0; k < num; k++) {
+            // 15 fractional bits, truncated like the multiplier in the FPGA
+            const int32_t re = (int32_t(input[i + k].real()) * coeff[k]) >> 15;
+            const int32_t im = (int32_t(input[i + k].imag()) * coeff[k]) >> 15;
+            output[i + k]    = sample_t(clip16(re), clip16(im));
+        }
+        i += num;
+        _pos = (_pos + num == _coeffs.size()) ? 0 : _pos + num;
+    }
+}
+
+void host_window::reset()
+{
+    _pos = 0;
+}
+
+/******************************************************************************
+ * host_logpwr
+ *****************************************************************************/
+void host_logpwr::process(
+    const std::vector<const packet_t*>& in, std::vector<packet_t>& out)
+{
+    check_ports(in, out);
+    const packet_t& input = *in[0];
+    packet_t& output      = out[0];
+    output.resize(input.size());
+    for (size_t i = 0; i < input.size(); i++) {
+        const int64_t re  = input[i].real();
+        const int64_t im  = input[i].imag();
+        const int64_t pwr = re * re + im * im;
+        const float log_pwr =
+            (pwr == 0) ? 0.0f : 1024.0f * std::log2(static_cast<float>(pwr));
+        output[i] = sample_t(round_clip16(log_pwr), 0);
+    }
+}
+
+/******************************************************************************
+ * host_fft
+ *****************************************************************************/
+host_fft::host_fft()
+{
+    _update();
+}
+
+void host_fft::set_length(const size_t length)
+{
+    if (length < 2) {
+        throw uhd::value_error("FFT: length must be at least 2");
+    }
+    _length = floor_pow2(length);
+    _update();
+}
+
+void host_fft::set_direction(const fft_direction direction)
+{
+    _direction = direction;
+    _update();
+}
+
+void host_fft::set_magnitude(const fft_magnitude magnitude)
+{
+    _magnitude = magnitude;
+}
+
+void host_fft::set_shift_config(const fft_shift shift)
+{
+    _shift = shift;
+}
+
+void host_fft::set_scaling(const uint16_t scaling)
+{
+    _scaling = scaling;
+    _update();
+}
+
+size_t host_fft::get_length() const
+{
+    return _length;
+}
+
+void host_fft::_update()
+{
+    size_t log2_len = 0;
+    while ((size_t(1) << log2_len) < _length) {
+        log2_len++;
+    }
+    // The schedule has two bits per radix-4 stage, starting with the first
+    // stage in the LSBs, and each gives the right shift of that stage
+    size_t shift = 0;
+    for (size_t stage = 0; stage < (log2_len + 1) / 2; stage++) {
+        shift += (_scaling >> (2 * stage)) & 0x3;
+    }
+    _scale = std::ldexp(1.0f, -int(shift));
+
+    _bitrev.resize(_length);
+    for (size_t i = 0; i < _length; i++) {
+        size_t rev = 0;
+        for (size_t bit = 0; bit < log2_len; bit++) {
+            rev |= ((i >> bit) & 1) << (log2_len - 1 - bit);
+        }
+        _bitrev[i] = rev;
+    }
+    const double sign = (_direction == fft_direction::FORWARD) ? -1.0 : 1.0;
+    _twiddles.resize(_length / 2);
+    for (size_t k = 0; k < _length / 2; k++) {
+        const double phase = sign * 2.0 * uhd::math::PI * double(k) / double(_length);
+        _twiddles[k] =
+            std::complex<float>(float(std::cos(phase)), float(std::sin(phase)));
+    }
+    _work.resize(_length);
+}
+
+void host_fft::process(
+    const std::vector<const packet_t*>& in, std::vector<packet_t>& out)
+{
+    check_ports(in, out);
+    const packet_t& input = *in[0];
+    packet_t& output      = out[0];
+    if (input.size() != _length) {
+        throw uhd::value_error("FFT: packet has " + std::to_string(input.size())
+                               + " samples, expected " + std::to_string(_length));
+    }
+
+    // Iterative radix-2 decimation in time
+    for (size_t i = 0; i < _length; i++) {
+        _work[_bitrev[i]] =
+            std::complex<float>(float(input[i].real()), float(input[i].imag()));
+    }
+    for (size_t size = 2; size <= _length; size *= 2) {
+        const size_t half = size / 2;
+        const size_t step = _length / size;
+        for (size_t start = 0; start < _length; start += size) {
+            std::complex<float>* lo = &_work[start];
+            std::complex<float>* hi = &_work[start + half];
+            for (size_t k = 0; k < half; k++) {
+                const std::complex<float>& w = _twiddles[k * step];
+                const float re = hi[k].real() * w.real() - hi[k].imag() * w.imag();
+                const float im = hi[k].real() * w.imag() + hi[k].imag() * w.real();
+                hi[k] = std::complex<float>(lo[k].real() - re, lo[k].imag() - im);
+                lo[k] = std::complex<float>(lo[k].real() + re, lo[k].imag() + im);
+            }
+        }
+    }
+
+    // Bin k goes to position k ^ mask, like in the FFT shift of the FPGA
+    const size_t mask = (_shift == fft_shift::NATURAL)
+                            ? 0
+                            : (_shift == fft_shift::REVERSE) ? _length / 2 - 1
+                                                             : _length / 2;
+    output.resize(_length);
+    for (size_t k = 0; k < _length; k++) {
+        const std::complex<float> bin = _work[k] * _scale;
+        sample_t& result              = output[k ^ mask];
+        switch (_magnitude) {
+            case fft_magnitude::COMPLEX:
+                result = sample_t(round_clip16(bin.real()), round_clip16(bin.imag()));
+                break;
+            case fft_magnitude::MAGNITUDE:
+                result = sample_t(round_clip16(std::abs(bin)), 0);
+                break;
+            case fft_magnitude::MAGNITUDE_SQUARED:
+                result = sample_t(round_clip16(std::norm(bin) / 32768.0f), 0);
+                break;
+        }
+    }
+}
+
+/******************************************************************************
+ * host_addsub
+ *****************************************************************************/
+void host_addsub::process(
+    const std::vector<const packet_t*>& in, std::vector<packet_t>& out)
+{
+    check_ports(in, out);
+    const packet_t& a = *in[0];
+    const packet_t& b = *in[1];
+    if (a.size() != b.size()) {
+        throw uhd::value_error("Add/Sub: input packets must have the same length");
+    }
+    out[0].resize(a.size());
+    out[1].resize(a.size());
+    // The sums wrap around, like the 16-bit adders in the FPGA
+    const int16_t* in_a = reinterpret_cast<const int16_t*>(a.data());
+    const int16_t* in_b = reinterpret_cast<const int16_t*>(b.data());
+    int16_t* sum        = reinterpret_cast<int16_t*>(out[0].data());
+    int16_t* diff       = reinterpret_cast<int16_t*>(out[1].data());
+    for (size_t i = 0; i < 2 * a.size(); i++) {
+        sum[i]  = int16_t(uint16_t(in_a[i]) + uint16_t(in_b[i]));
+        diff[i] = int16_t(uint16_t(in_a[i]) - uint16_t(in_b[i]));
+    }
+}
+
+/******************************************************************************
+ * host_split_stream
+ *****************************************************************************/
+void host_split_stream::set_num_branches(const size_t num_branches)
+{
+    if (num_branches == 0) {
+        throw uhd::value_error("Split stream: at least one branch is required");
+    }
+    _num_branches = num_branches;
+}
+
+void host_split_stream::process(
+    const std::vector<const packet_t*>& in, std::vector<packet_t>& out)
+{
+    check_ports(in, out);
+    for (auto& branch : out) {
+        branch = *in[0];
+    }
+}
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "../utils/async_python.hpp"
 #include "block_controller_factory_python.hpp"
 #include <uhd/rfnoc/keep_one_in_n_block_control.hpp>
 
@@ -17,15 +18,19 @@ void export_keep_one_in_n_block_control(py::module& m)
         noc_block_base,
         keep_one_in_n_block_control::sptr>(m, "keep_one_in_n_block_control")
         .def(py::init(&block_controller_factory<keep_one_in_n_block_control>::make_from))
-        .def("get_max_n", &keep_one_in_n_block_control::get_max_n)
+        .def("get_max_n", &keep_one_in_n_block_control::get_max_n, release_gil())
         .def("get_n", &keep_one_in_n_block_control::get_n,
-            py::arg("chan") = 0)
+            py::arg("chan") = 0,
+            release_gil())
         .def("set_n", &keep_one_in_n_block_control::set_n,
             py::arg("n"),
-            py::arg("chan") = 0)
+            py::arg("chan") = 0,
+            release_gil())
         .def("get_mode", &keep_one_in_n_block_control::get_mode,
-            py::arg("chan") = 0)
+            py::arg("chan") = 0,
+            release_gil())
         .def("set_mode", &keep_one_in_n_block_control::set_mode,
             py::arg("mode"),
-            py::arg("chan") = 0);
+            py::arg("chan") = 0,
+            release_gil());
 }
@@ -10,6 +10,8 @@
 #include <uhdlib/rfnoc/link_stream_manager.hpp>
 #include <uhdlib/rfnoc/mgmt_portal.hpp>
 #include <boost/format.hpp>
+#include <algorithm>
+#include <iterator>
 
 using namespace uhd;
 using namespace uhd::rfnoc;
@@ -40,7 +42,8 @@ public:
     {
         // Sanity check if we can access our device ID from this motherboard
         const auto& mb_devs = _mb_iface.get_local_device_ids();
-        if (std::find(mb_devs.begin(), mb_devs.end(), _my_device_id) == mb_devs.end()) {
+        const auto my_dev   = std::find(mb_devs.begin(), mb_devs.end(), _my_device_id);
+        if (my_dev == mb_devs.end()) {
             throw uhd::rfnoc_error("The device bound to this link manager cannot be "
                                    "accessed from this motherboard");
         }
@@ -67,9 +70,17 @@ public:
 
         _my_adapter_id = _mb_iface.get_adapter_id(_my_device_id);
 
-        // Create management portal using one of the child transports
-        _mgmt_portal = mgmt_portal::make(
-            *_ctrl_xport, _pkt_factory, sep_addr_t(_my_device_id, SEP_INST_MGMT_CTRL));
+        // Create management portal using one of the child transports. Each link
+        // reaches the device on a different port, so it has its own topology.
+        std::string topology_key = _mb_iface.get_topology_key();
+        if (!topology_key.empty()) {
+            topology_key +=
+                "/link" + std::to_string(std::distance(mb_devs.begin(), my_dev));
+        }
+        _mgmt_portal = mgmt_portal::make(*_ctrl_xport,
+            _pkt_factory,
+            sep_addr_t(_my_device_id, SEP_INST_MGMT_CTRL),
+            topology_key);
     }
 
     virtual ~link_stream_manager_impl()
@@ -89,6 +100,11 @@ public:
         return _my_adapter_id;
     }
 
+    virtual double get_link_rate(const uhd::direction_t dir) const
+    {
+        return _mb_iface.get_link_rate(_my_device_id, dir);
+    }
+
     virtual const std::set<sep_addr_t>& get_reachable_endpoints() const
     {
         return _mgmt_portal->get_reachable_endpoints();
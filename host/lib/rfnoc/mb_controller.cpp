@@ -8,6 +8,9 @@
 #include <uhd/rfnoc/mb_controller.hpp>
 #include <uhd/utils/algorithm.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhdlib/rfnoc/time_correlator.hpp>
+#include <uhdlib/utils/periodic_task.hpp>
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <thread>
@@ -113,13 +116,41 @@ bool mb_controller::synchronize(std::vector<mb_controller::sptr>& mb_controllers
  * Timekeeper API
  *****************************************************************************/
 mb_controller::timekeeper::timekeeper()
+    : _time_correlator(std::make_shared<detail::time_correlator>())
 {
     // nop
 }
 
 uhd::time_spec_t mb_controller::timekeeper::get_time_now()
 {
-    return time_spec_t::from_ticks(get_ticks_now(), _tick_rate);
+    // Reading the time is also a sample for the correlator, and the clock
+    // reads are cheap compared to the round trip to the device
+    const auto before = std::chrono::steady_clock::now();
+    const auto time   = time_spec_t::from_ticks(get_ticks_now(), _tick_rate);
+    _time_correlator->add_sample(before, std::chrono::steady_clock::now(), time);
+    return time;
+}
+
+uhd::time_spec_t mb_controller::timekeeper::get_time_estimate()
+{
+    return _time_correlator->to_device_time(std::chrono::steady_clock::now());
+}
+
+uhd::time_spec_t mb_controller::timekeeper::get_time_estimate(
+    const std::chrono::steady_clock::time_point host_time)
+{
+    return _time_correlator->to_device_time(host_time);
+}
+
+std::chrono::steady_clock::time_point mb_controller::timekeeper::get_host_time(
+    const uhd::time_spec_t& device_time)
+{
+    return _time_correlator->to_host_time(device_time);
+}
+
+bool mb_controller::timekeeper::has_time_estimate() const
+{
+    return _time_correlator->is_valid();
 }
 
 uhd::time_spec_t mb_controller::timekeeper::get_time_last_pps()
@@ -129,11 +160,15 @@ uhd::time_spec_t mb_controller::timekeeper::get_time_last_pps()
 
 void mb_controller::timekeeper::set_time_now(const uhd::time_spec_t& time)
 {
+    _time_correlator->reset();
     set_ticks_now(time.to_ticks(_tick_rate));
 }
 
 void mb_controller::timekeeper::set_time_next_pps(const uhd::time_spec_t& time)
 {
+    // Reads before the PPS edge still return the old time. The correlator
+    // starts over again when it sees the jump.
+    _time_correlator->reset();
     set_ticks_next_pps(time.to_ticks(_tick_rate));
 }
 
@@ -143,6 +178,7 @@ void mb_controller::timekeeper::set_tick_rate(const double tick_rate)
         return;
     }
     _tick_rate = tick_rate;
+    _time_correlator->reset();
 
     // The period is the inverse of the tick rate, normalized by nanoseconds,
     // and represented as Q32 (e.g., period == 1ns means period_ns == 1<<32)
@@ -166,11 +202,55 @@ mb_controller::timekeeper::sptr mb_controller::get_timekeeper(const size_t tk_id
     return _timekeepers.at(tk_idx);
 }
 
+void mb_controller::set_time_correlation_interval(
+    const size_t tk_idx, const double interval)
+{
+    if (interval < 0.0) {
+        throw uhd::value_error("Time correlation interval must not be negative!");
+    }
+    // The task must not keep the timekeeper alive, it may outlive the
+    // motherboard it belongs to otherwise
+    std::weak_ptr<timekeeper> tk_wptr = get_timekeeper(tk_idx);
+    _time_correlation_tasks.erase(tk_idx);
+    if (interval == 0.0) {
+        return;
+    }
+    const auto period = std::max(std::chrono::milliseconds(1),
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::duration<double>(interval)));
+    _time_correlation_tasks.emplace(tk_idx,
+        uhd::make_periodic_task(
+            [tk_wptr]() {
+                if (auto tk = tk_wptr.lock()) {
+                    // A failed read is no reason to stop, the next one may
+                    // work again
+                    try {
+                        tk->get_time_now();
+                    } catch (const uhd::exception& ex) {
+                        UHD_LOG_DEBUG(
+                            "MB_CTRL", "Failed to read the device time: " << ex.what());
+                    }
+                }
+            },
+            period,
+            "uhd_time_corr"));
+}
+
 void mb_controller::register_timekeeper(const size_t idx, timekeeper::sptr tk)
 {
     _timekeepers.emplace(idx, std::move(tk));
 }
 
+std::vector<uhd::sensor_value_t> mb_controller::get_sensors(
+    const std::vector<std::string>& names)
+{
+    std::vector<uhd::sensor_value_t> sensors;
+    for (const auto& name : names) {
+        sensors.push_back(get_sensor(name));
+    }
+    return sensors;
+}
+
 std::vector<std::string> mb_controller::get_gpio_banks() const
 {
     return {};
@@ -10,8 +10,10 @@
 #include <uhdlib/rfnoc/chdr_ctrl_xport.hpp>
 #include <uhdlib/rfnoc/chdr_packet_writer.hpp>
 #include <uhdlib/rfnoc/mgmt_portal.hpp>
+#include <uhdlib/utils/init_timeline.hpp>
 #include <unordered_set>
 #include <boost/format.hpp>
+#include <algorithm>
 #include <cmath>
 #include <mutex>
 #include <queue>
@@ -167,6 +169,30 @@ std::string to_string(const node_addr_t& node_addr)
     }
 }
 
+//! A topology discovered by a management portal
+struct cached_topology_t
+{
+    //! The software endpoint that ran the discovery
+    node_id_t local_node;
+    //! The device ID of all discovered nodes
+    device_id_t remote_device_id;
+    //! The discovered nodes, and how to reach them
+    std::map<node_id_t, node_addr_t> node_addr_map;
+};
+
+//! The topologies discovered in this process, indexed by topology key
+struct topology_cache_t
+{
+    std::mutex mutex;
+    std::map<std::string, cached_topology_t> topologies;
+};
+
+topology_cache_t& get_topology_cache()
+{
+    static topology_cache_t cache;
+    return cache;
+}
+
 // Empty dtor for stream_manager
 mgmt_portal::~mgmt_portal() {}
 
@@ -178,7 +204,8 @@ class mgmt_portal_impl : public mgmt_portal
 public:
     mgmt_portal_impl(chdr_ctrl_xport& xport,
         const chdr::chdr_packet_factory& pkt_factory,
-        sep_addr_t my_sep_addr)
+        sep_addr_t my_sep_addr,
+        const std::string& topology_key)
         : _protover(pkt_factory.get_protover())
         , _chdr_w(pkt_factory.get_chdr_w())
         , _endianness(pkt_factory.get_endianness())
@@ -188,7 +215,14 @@ public:
         , _recv_pkt(std::move(pkt_factory.make_mgmt()))
     {
         std::lock_guard<std::recursive_mutex> lock(_mutex);
-        _discover_topology(xport);
+        init_timeline::scoped_span span("mgmt_portal " + _my_node_id.to_string());
+        if (topology_key.empty() || !_restore_topology(xport, topology_key)) {
+            init_timeline::scoped_span discover_span("topology discovery");
+            _discover_topology(xport);
+            if (!topology_key.empty()) {
+                _store_topology(topology_key);
+            }
+        }
         UHD_LOG_DEBUG("RFNOC::MGMT",
             "The following endpoints are reachable from " << _my_node_id.to_string());
         for (const auto& ep : _discovered_ep_set) {
@@ -646,7 +680,6 @@ private: // Functions
         // traversal of the dataflow graph. The queue consists of a previously discovered
         // node and the next destination to take from that node.
         std::queue<std::pair<node_id_t, next_dest_t>> pending_paths;
-        auto my_epid = xport.get_epid();
 
         // Add ourselves to the the pending queue to kick off the search
         UHD_LOG_DEBUG("RFNOC::MGMT",
@@ -670,26 +703,10 @@ private: // Functions
             next_addr.push_back(next_path);
             is_first_path = false;
 
-            // Build a management transaction to first get to our destination so that we
-            // can ask it to identify itself
-            mgmt_payload route_xact;
-            route_xact.set_header(my_epid, _protover, _chdr_w);
-            _traverse_to_node(route_xact, next_addr);
-
-            // Discover downstream node (we ask the node to identify itself)
-            mgmt_payload disc_req_xact(route_xact);
-            // Push a node discovery hop
-            mgmt_hop_t disc_hop;
-            disc_hop.add_op(mgmt_op_t(mgmt_op_t::MGMT_OP_INFO_REQ));
-            disc_hop.add_op(mgmt_op_t(mgmt_op_t::MGMT_OP_RETURN));
-            disc_req_xact.add_hop(disc_hop);
-
             node_id_t new_node;
             try {
-                // Send the discovery transaction
-                const mgmt_payload disc_resp_xact =
-                    _send_recv_mgmt_transaction(xport, disc_req_xact);
-                new_node = _pop_node_discovery_hop(disc_resp_xact);
+                // Discover downstream node (we ask the node to identify itself)
+                new_node = _request_node_info(xport, next_addr);
             } catch (uhd::io_error& io_err) {
                 // We received an IO error. This could happen if we have a legitimate
                 // error or if there is no node to discover downstream. We can't tell for
@@ -728,11 +745,7 @@ private: // Functions
                 _node_addr_map[new_node] = next_addr;
 
                 // Initialize the node (first time config)
-                mgmt_payload init_req_xact(route_xact);
-                _push_node_init_hop(init_req_xact, new_node, my_epid);
-                const mgmt_payload init_resp_xact =
-                    _send_recv_mgmt_transaction(xport, init_req_xact);
-                UHD_LOG_DEBUG("RFNOC::MGMT", "Initialized node " << new_node.to_string());
+                _init_node(xport, next_addr, new_node);
 
                 // If the new node is a stream endpoint then we are done traversing this
                 // path. If not, then check all ports downstream of the new node and add
@@ -783,6 +796,161 @@ private: // Functions
         }
     }
 
+    // Ask the node at the specified address to identify itself
+    node_id_t _request_node_info(chdr_ctrl_xport& xport, const node_addr_t& node_addr)
+    {
+        // Build a management transaction to first get to the node
+        mgmt_payload disc_req_xact;
+        disc_req_xact.set_header(xport.get_epid(), _protover, _chdr_w);
+        _traverse_to_node(disc_req_xact, node_addr);
+        // Push a node discovery hop
+        mgmt_hop_t disc_hop;
+        disc_hop.add_op(mgmt_op_t(mgmt_op_t::MGMT_OP_INFO_REQ));
+        disc_hop.add_op(mgmt_op_t(mgmt_op_t::MGMT_OP_RETURN));
+        disc_req_xact.add_hop(disc_hop);
+        // Send the discovery transaction
+        const mgmt_payload disc_resp_xact =
+            _send_recv_mgmt_transaction(xport, disc_req_xact);
+        return _pop_node_discovery_hop(disc_resp_xact);
+    }
+
+    // Initialize the specified node, which is at the specified address
+    void _init_node(
+        chdr_ctrl_xport& xport, const node_addr_t& node_addr, const node_id_t& node)
+    {
+        mgmt_payload init_req_xact;
+        init_req_xact.set_header(xport.get_epid(), _protover, _chdr_w);
+        _traverse_to_node(init_req_xact, node_addr);
+        _push_node_init_hop(init_req_xact, node, xport.get_epid());
+        _send_recv_mgmt_transaction(xport, init_req_xact);
+        UHD_LOG_DEBUG("RFNOC::MGMT", "Initialized node " << node.to_string());
+    }
+
+    // Save the discovered topology to the topology cache
+    //
+    // The device IDs of the nodes are assigned anew for each session, so the
+    // cache only holds topologies in which all nodes belong to a single
+    // device, for which the IDs can be mapped to those of the next session.
+    void _store_topology(const std::string& topology_key)
+    {
+        cached_topology_t topology;
+        topology.local_node       = _my_node_id;
+        topology.remote_device_id = NULL_DEVICE_ID;
+        for (const auto& node : _node_addr_map) {
+            if (node.second.size() == 1) {
+                topology.remote_device_id = node.first.device_id;
+            }
+        }
+        for (const auto& node : _node_addr_map) {
+            if (node.first.device_id != topology.remote_device_id) {
+                UHD_LOG_DEBUG("RFNOC::MGMT",
+                    "Not caching the topology from " << _my_node_id.to_string()
+                                                     << ", it spans several devices");
+                return;
+            }
+        }
+        topology.node_addr_map = _node_addr_map;
+
+        topology_cache_t& cache = get_topology_cache();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        cache.topologies[topology_key] = std::move(topology);
+    }
+
+    // Restore the topology from the topology cache
+    //
+    // A single probe of the first node checks that the device still matches
+    // the cached topology, then all nodes get initialized without discovering
+    // what's downstream of them. Returns false if there is no cached topology,
+    // or if the device doesn't match it anymore.
+    bool _restore_topology(chdr_ctrl_xport& xport, const std::string& topology_key)
+    {
+        cached_topology_t topology;
+        topology_cache_t& cache = get_topology_cache();
+        {
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            if (cache.topologies.count(topology_key) == 0) {
+                return false;
+            }
+            topology = cache.topologies.at(topology_key);
+        }
+        UHD_LOG_DEBUG("RFNOC::MGMT",
+            "Restoring cached topology from " << _my_node_id.to_string());
+
+        // Probe the node that is attached to this endpoint
+        const node_addr_t first_addr{std::make_pair(_my_node_id, next_dest_t(-1))};
+        node_id_t first_node;
+        try {
+            first_node = _request_node_info(xport, first_addr);
+        } catch (uhd::io_error&) {
+            return _forget_topology(topology_key);
+        }
+        const auto cached_first = std::find_if(topology.node_addr_map.begin(),
+            topology.node_addr_map.end(),
+            [](const std::pair<node_id_t, node_addr_t>& node) {
+                return node.second.size() == 1;
+            });
+        if (cached_first == topology.node_addr_map.end()
+            || cached_first->first.type != first_node.type
+            || cached_first->first.inst != first_node.inst
+            || cached_first->first.extended_info != first_node.extended_info) {
+            return _forget_topology(topology_key);
+        }
+
+        // Map the device IDs of the cached topology to the current ones
+        auto map_node = [&](node_id_t node) {
+            if (node == topology.local_node) {
+                return _my_node_id;
+            }
+            node.device_id = first_node.device_id;
+            return node;
+        };
+        std::vector<std::pair<node_id_t, node_addr_t>> nodes;
+        for (const auto& node : topology.node_addr_map) {
+            node_addr_t node_addr;
+            for (const auto& hop : node.second) {
+                node_addr.push_back(std::make_pair(map_node(hop.first), hop.second));
+            }
+            nodes.push_back(std::make_pair(map_node(node.first), node_addr));
+        }
+        // Initialize the nodes closest to us first, since the routes to the
+        // other nodes go through them
+        std::stable_sort(nodes.begin(),
+            nodes.end(),
+            [](const std::pair<node_id_t, node_addr_t>& lhs,
+                const std::pair<node_id_t, node_addr_t>& rhs) {
+                return lhs.second.size() < rhs.second.size();
+            });
+
+        try {
+            for (const auto& node : nodes) {
+                _node_addr_map[node.first] = node.second;
+                if (node.first.type == NODE_TYPE_STRM_EP) {
+                    _discovered_ep_set.insert(
+                        sep_addr_t(node.first.device_id, node.first.inst));
+                } else {
+                    _init_node(xport, node.second, node.first);
+                }
+            }
+        } catch (uhd::io_error&) {
+            _node_addr_map.clear();
+            _discovered_ep_set.clear();
+            return _forget_topology(topology_key);
+        }
+        return true;
+    }
+
+    // Remove a topology that doesn't match the device from the cache
+    bool _forget_topology(const std::string& topology_key)
+    {
+        UHD_LOG_DEBUG("RFNOC::MGMT",
+            "The cached topology from " << _my_node_id.to_string()
+                                        << " does not match the device anymore");
+        topology_cache_t& cache = get_topology_cache();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        cache.topologies.erase(topology_key);
+        return false;
+    }
+
     // Add hops to the management transaction to reach the specified node
     void _traverse_to_node(mgmt_payload& transaction, const node_addr_t& node_addr)
     {
@@ -1094,9 +1262,11 @@ private: // Members
 
 mgmt_portal::uptr mgmt_portal::make(chdr_ctrl_xport& xport,
     const chdr::chdr_packet_factory& pkt_factory,
-    sep_addr_t my_sep_addr)
+    sep_addr_t my_sep_addr,
+    const std::string& topology_key)
 {
-    return std::make_unique<mgmt_portal_impl>(xport, pkt_factory, my_sep_addr);
+    return std::make_unique<mgmt_portal_impl>(
+        xport, pkt_factory, my_sep_addr, topology_key);
 }
 
 }}} // namespace uhd::rfnoc::mgmt
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "../utils/async_python.hpp"
 #include "block_controller_factory_python.hpp"
 #include <uhd/rfnoc/moving_average_block_control.hpp>
 
@@ -17,8 +18,8 @@ void export_moving_average_block_control(py::module& m)
         noc_block_base,
         moving_average_block_control::sptr>(m, "moving_average_block_control")
         .def(py::init(&block_controller_factory<moving_average_block_control>::make_from))
-        .def("set_sum_len", &moving_average_block_control::set_sum_len)
-        .def("get_sum_len", &moving_average_block_control::get_sum_len)
-        .def("set_divisor", &moving_average_block_control::set_divisor)
-        .def("get_divisor", &moving_average_block_control::get_divisor);
+        .def("set_sum_len", &moving_average_block_control::set_sum_len, release_gil())
+        .def("get_sum_len", &moving_average_block_control::get_sum_len, release_gil())
+        .def("set_divisor", &moving_average_block_control::set_divisor, release_gil())
+        .def("get_divisor", &moving_average_block_control::get_divisor, release_gil());
 }
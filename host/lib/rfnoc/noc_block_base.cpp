@@ -8,6 +8,7 @@
 #include <uhd/rfnoc/defaults.hpp>
 #include <uhd/rfnoc/noc_block_base.hpp>
 #include <uhd/rfnoc/register_iface.hpp>
+#include <uhd/utils/log.hpp>
 #include <uhdlib/rfnoc/clock_iface.hpp>
 
 using namespace uhd::rfnoc;
@@ -139,6 +140,22 @@ noc_block_base::~noc_block_base()
     }
 }
 
+noc_block_base::batch_scope::batch_scope(noc_block_base& block)
+    : _regs(block.regs()), _unique_id(block.get_unique_id())
+{
+    _regs.begin_batch();
+}
+
+noc_block_base::batch_scope::~batch_scope()
+{
+    try {
+        _regs.end_batch();
+    } catch (const std::exception& ex) {
+        UHD_LOG_ERROR(
+            _unique_id, "Failed to send batched register writes: " << ex.what());
+    }
+}
+
 void noc_block_base::set_num_input_ports(const size_t num_ports)
 {
     if (num_ports > get_num_input_ports()) {
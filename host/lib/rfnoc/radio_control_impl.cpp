@@ -9,6 +9,8 @@
 #include <uhd/rfnoc/multichan_register_iface.hpp>
 #include <uhd/rfnoc/register_iface.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhd/utils/scope_exit.hpp>
+#include <uhdlib/rfnoc/gpio_sequence.hpp>
 #include <uhdlib/rfnoc/radio_control_impl.hpp>
 #include <uhdlib/utils/compat_check.hpp>
 #include <map>
@@ -312,6 +314,7 @@ void radio_control_impl::set_tx_tune_args(const uhd::device_addr_t&, const size_
 
 double radio_control_impl::set_rx_frequency(const double freq, const size_t chan)
 {
+    post_rx_tag(uhd::rx_tag_t::TAG_FREQ, chan);
     std::lock_guard<std::mutex> l(_cache_mutex);
     return _rx_freq[chan] = freq;
 }
@@ -388,6 +391,7 @@ double radio_control_impl::set_tx_gain(
 
 double radio_control_impl::set_rx_gain(const double gain, const size_t chan)
 {
+    post_rx_tag(uhd::rx_tag_t::TAG_GAIN, chan);
     std::lock_guard<std::mutex> l(_cache_mutex);
     _rx_gain[chan] = gain;
     return gain;
@@ -512,6 +516,85 @@ std::vector<std::string> radio_control_impl::get_rx_antennas(const size_t chan)
     return {_rx_antenna.at(chan)};
 }
 
+/******************************************************************************
+ * Frequency Hopping
+ *****************************************************************************/
+std::vector<double> radio_control_impl::set_tx_hop_table(
+    const std::vector<double>& freqs, const size_t chan)
+{
+    std::vector<double> actual_freqs;
+    hop_table_t table = make_hop_table(
+        freqs,
+        [this, chan](const double freq) { return set_tx_frequency(freq, chan); },
+        actual_freqs);
+    std::lock_guard<std::mutex> l(_hop_mutex);
+    _tx_hop_tables[chan] = std::move(table);
+    return actual_freqs;
+}
+
+void radio_control_impl::tx_hop(const size_t index, const size_t chan)
+{
+    hop(_tx_hop_tables, index, chan);
+}
+
+std::vector<double> radio_control_impl::set_rx_hop_table(
+    const std::vector<double>& freqs, const size_t chan)
+{
+    std::vector<double> actual_freqs;
+    hop_table_t table = make_hop_table(
+        freqs,
+        [this, chan](const double freq) { return set_rx_frequency(freq, chan); },
+        actual_freqs);
+    std::lock_guard<std::mutex> l(_hop_mutex);
+    _rx_hop_tables[chan] = std::move(table);
+    return actual_freqs;
+}
+
+void radio_control_impl::rx_hop(const size_t index, const size_t chan)
+{
+    hop(_rx_hop_tables, index, chan);
+    post_rx_tag(uhd::rx_tag_t::TAG_FREQ, chan);
+}
+
+radio_control_impl::hop_table_t radio_control_impl::make_hop_table(
+    const std::vector<double>& freqs,
+    const std::function<double(double)>& tune,
+    std::vector<double>& actual_freqs)
+{
+    hop_table_t table;
+    if (freqs.empty()) {
+        return table;
+    }
+
+    // Start from the state that the hop to the first entry will find
+    tune(freqs.back());
+    for (const double freq : freqs) {
+        const auto writes =
+            record_reg_writes([&]() { actual_freqs.push_back(tune(freq)); });
+        hop_t entry;
+        for (const auto& write : writes) {
+            entry.addrs.push_back(write.first);
+            entry.data.push_back(write.second);
+        }
+        table.push_back(std::move(entry));
+    }
+    return table;
+}
+
+void radio_control_impl::hop(const std::unordered_map<size_t, hop_table_t>& tables,
+    const size_t index,
+    const size_t chan)
+{
+    std::lock_guard<std::mutex> l(_hop_mutex);
+    const auto table = tables.find(chan);
+    if (table == tables.end() || index >= table->second.size()) {
+        throw uhd::index_error(get_unique_id() + ": Channel " + std::to_string(chan)
+                               + " has no hop table entry " + std::to_string(index));
+    }
+    const hop_t& entry = table->second[index];
+    regs().multi_poke32(entry.addrs, entry.data, get_command_time(chan));
+}
+
 double radio_control_impl::get_tx_frequency(const size_t chan)
 {
     std::lock_guard<std::mutex> l(_cache_mutex);
@@ -827,6 +910,29 @@ uint32_t radio_control_impl::get_gpio_attr(const std::string&, const std::string
     throw uhd::not_implemented_error("get_gpio_attr() not implemented on this radio!");
 }
 
+void radio_control_impl::set_gpio_sequence(
+    const std::vector<gpio_sequence_entry_t>& sequence)
+{
+    const auto groups = detail::coalesce_gpio_sequence(sequence);
+    if (groups.empty()) {
+        return;
+    }
+    // The GPIO registers of all radios are timed with the command time of the
+    // first channel
+    const uhd::time_spec_t cmd_time = get_command_time(0);
+    auto restore_cmd_time           = uhd::utils::scope_exit::make(
+        [this, cmd_time]() { set_command_time(cmd_time, 0); });
+
+    for (const auto& group : groups) {
+        set_command_time(group.time, 0);
+        batch_scope batch(*this);
+        for (const auto& write : group.writes) {
+            const uint32_t value = get_gpio_attr(write.bank, write.attr);
+            set_gpio_attr(write.bank, write.attr, (value & ~write.mask) | write.value);
+        }
+    }
+}
+
 /**************************************************************************
  * Sensor API
  *************************************************************************/
@@ -872,6 +978,97 @@ void radio_control_impl::issue_stream_cmd(
     // std::lock_guard<std::mutex> lock(_mutex);
     RFNOC_LOG_TRACE("radio_control_impl::issue_stream_cmd(chan="
                     << chan << ", mode=" << char(stream_cmd.stream_mode) << ")");
+    const uint32_t cmd_word = _prepare_stream_cmd(stream_cmd, chan);
+    _radio_reg_iface.poke32(regmap::REG_RX_CMD, cmd_word, chan);
+}
+
+std::future<void> radio_control_impl::issue_stream_cmd_async(
+    const uhd::stream_cmd_t& stream_cmd, const size_t chan)
+{
+    RFNOC_LOG_TRACE("radio_control_impl::issue_stream_cmd_async(chan="
+                    << chan << ", mode=" << char(stream_cmd.stream_mode) << ")");
+    const uint32_t cmd_word = _prepare_stream_cmd(stream_cmd, chan);
+    // Control transactions complete in order, so the ACK of the command word
+    // also confirms the registers written before it
+    return _radio_reg_iface.poke32_async(regmap::REG_RX_CMD, cmd_word, chan);
+}
+
+void radio_control_impl::issue_rx_scan(const std::vector<rx_scan_entry_t>& schedule,
+    const uhd::time_spec_t& settling_time,
+    const size_t chan)
+{
+    // Check the whole schedule before anything is sent
+    size_t num_hops = 0;
+    {
+        std::lock_guard<std::mutex> l(_hop_mutex);
+        const auto table = _rx_hop_tables.find(chan);
+        if (table != _rx_hop_tables.end()) {
+            num_hops = table->second.size();
+        }
+    }
+    for (size_t i = 0; i < schedule.size(); i++) {
+        if (schedule[i].hop_index != NO_HOP && schedule[i].hop_index >= num_hops) {
+            throw uhd::index_error(get_unique_id() + ": Channel " + std::to_string(chan)
+                                   + " has no hop table entry "
+                                   + std::to_string(schedule[i].hop_index));
+        }
+        if (schedule[i].num_samps == 0) {
+            throw uhd::value_error(get_unique_id() + ": Scan entry " + std::to_string(i)
+                                   + " has no samples");
+        }
+        if (i > 0 && schedule[i].time <= schedule[i - 1].time) {
+            throw uhd::value_error(get_unique_id()
+                                   + ": The times of a scan schedule must increase");
+        }
+    }
+
+    const uhd::time_spec_t cmd_time = get_command_time(chan);
+    auto restore_cmd_time           = uhd::utils::scope_exit::make(
+        [this, cmd_time, chan]() { set_command_time(cmd_time, chan); });
+
+    for (const auto& entry : schedule) {
+        // The hop and the stream command of an entry wait in the command queue
+        // until settling_time before its burst, and then go out back to back
+        const uhd::time_spec_t write_time = entry.time - settling_time;
+        set_command_time(write_time, chan);
+        if (entry.hop_index != NO_HOP) {
+            rx_hop(entry.hop_index, chan);
+        }
+        uhd::stream_cmd_t stream_cmd(uhd::stream_cmd_t::STREAM_MODE_NUM_SAMPS_AND_DONE);
+        stream_cmd.num_samps    = entry.num_samps;
+        stream_cmd.stream_now   = false;
+        stream_cmd.time_spec    = entry.time;
+        const uint32_t cmd_word = _prepare_stream_cmd(stream_cmd, chan, write_time);
+        _radio_reg_iface.poke32(regmap::REG_RX_CMD, cmd_word, chan, write_time);
+    }
+}
+
+void radio_control_impl::enable_rx_timestamps(const bool enable, const size_t chan)
+{
+    _radio_reg_iface.poke32(regmap::REG_RX_HAS_TIME, enable ? 0x1 : 0x0, chan);
+}
+
+/******************************************************************************
+ * Protected methods
+ *****************************************************************************/
+void radio_control_impl::post_rx_tag(
+    const uhd::rx_tag_t::tag_type_t type, const size_t chan)
+{
+    const uhd::time_spec_t cmd_time = get_command_time(chan);
+    if (cmd_time == uhd::time_spec_t::ASAP || chan >= get_num_output_ports()) {
+        return;
+    }
+    post_action({res_source_info::OUTPUT_EDGE, chan},
+        rx_tag_action_info::make(type, cmd_time.to_ticks(get_tick_rate())));
+}
+
+/******************************************************************************
+ * Private methods
+ *****************************************************************************/
+uint32_t radio_control_impl::_prepare_stream_cmd(const uhd::stream_cmd_t& stream_cmd,
+    const size_t chan,
+    const uhd::time_spec_t& cmd_time)
+{
     _last_stream_cmd[chan] = stream_cmd;
 
     // calculate the command word
@@ -908,27 +1105,25 @@ void radio_control_impl::issue_stream_cmd(
                 "requested fewer samples.");
             throw uhd::value_error("Requested too many samples in a single burst.");
         }
-        _radio_reg_iface.poke32(
-            regmap::REG_RX_CMD_NUM_WORDS_HI, uint32_t(num_words >> 32), chan);
-        _radio_reg_iface.poke32(
-            regmap::REG_RX_CMD_NUM_WORDS_LO, uint32_t(num_words & 0xFFFFFFFF), chan);
+        _radio_reg_iface.poke32(regmap::REG_RX_CMD_NUM_WORDS_HI,
+            uint32_t(num_words >> 32),
+            chan,
+            cmd_time);
+        _radio_reg_iface.poke32(regmap::REG_RX_CMD_NUM_WORDS_LO,
+            uint32_t(num_words & 0xFFFFFFFF),
+            chan,
+            cmd_time);
     }
     if (!stream_cmd.stream_now) {
         const uint64_t ticks = stream_cmd.time_spec.to_ticks(get_tick_rate());
-        _radio_reg_iface.poke32(regmap::REG_RX_CMD_TIME_HI, uint32_t(ticks >> 32), chan);
-        _radio_reg_iface.poke32(regmap::REG_RX_CMD_TIME_LO, uint32_t(ticks >> 0), chan);
+        _radio_reg_iface.poke32(
+            regmap::REG_RX_CMD_TIME_HI, uint32_t(ticks >> 32), chan, cmd_time);
+        _radio_reg_iface.poke32(
+            regmap::REG_RX_CMD_TIME_LO, uint32_t(ticks >> 0), chan, cmd_time);
     }
-    _radio_reg_iface.poke32(regmap::REG_RX_CMD, cmd_word, chan);
+    return cmd_word;
 }
 
-void radio_control_impl::enable_rx_timestamps(const bool enable, const size_t chan)
-{
-    _radio_reg_iface.poke32(regmap::REG_RX_HAS_TIME, enable ? 0x1 : 0x0, chan);
-}
-
-/******************************************************************************
- * Private methods
- *****************************************************************************/
 bool radio_control_impl::async_message_validator(
     uint32_t addr, const std::vector<uint32_t>& data)
 {
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "../utils/async_python.hpp"
 #include "block_controller_factory_python.hpp"
 #include <uhd/rfnoc/radio_control.hpp>
 
@@ -16,159 +17,257 @@ void export_radio_control(py::module& m)
     // Re-import ALL_CHANS here to avoid linker errors
     const auto ALL_CHANS = radio_control::ALL_CHANS;
 
+    py::class_<radio_control::gpio_sequence_entry_t>(m, "gpio_sequence_entry")
+        .def(py::init([](const uhd::time_spec_t& time,
+                          const std::string& bank,
+                          const uint32_t mask,
+                          const uint32_t value,
+                          const std::string& attr) {
+            return radio_control::gpio_sequence_entry_t{time, bank, mask, value, attr};
+        }),
+            py::arg("time"),
+            py::arg("bank"),
+            py::arg("mask"),
+            py::arg("value"),
+            py::arg("attr") = "OUT")
+        .def_readwrite("time", &radio_control::gpio_sequence_entry_t::time)
+        .def_readwrite("bank", &radio_control::gpio_sequence_entry_t::bank)
+        .def_readwrite("mask", &radio_control::gpio_sequence_entry_t::mask)
+        .def_readwrite("value", &radio_control::gpio_sequence_entry_t::value)
+        .def_readwrite("attr", &radio_control::gpio_sequence_entry_t::attr);
+
+    const auto NO_HOP = radio_control::NO_HOP;
+
+    py::class_<radio_control::rx_scan_entry_t>(m, "rx_scan_entry")
+        .def(py::init([](const uhd::time_spec_t& time,
+                          const size_t num_samps,
+                          const size_t hop_index) {
+            return radio_control::rx_scan_entry_t{time, num_samps, hop_index};
+        }),
+            py::arg("time"),
+            py::arg("num_samps"),
+            py::arg("hop_index") = NO_HOP)
+        .def_readwrite("time", &radio_control::rx_scan_entry_t::time)
+        .def_readwrite("num_samps", &radio_control::rx_scan_entry_t::num_samps)
+        .def_readwrite("hop_index", &radio_control::rx_scan_entry_t::hop_index);
+
     py::class_<radio_control, noc_block_base, radio_control::sptr>(m, "radio_control")
         .def(py::init(&block_controller_factory<radio_control>::make_from))
-        .def("set_rate", &radio_control::set_rate)
-        .def("get_rate", &radio_control::get_rate)
-        .def("get_rate_range", &radio_control::get_rate_range)
-        .def("get_tx_antenna", &radio_control::get_tx_antenna)
-        .def("get_tx_antennas", &radio_control::get_tx_antennas)
-        .def("set_tx_antenna", &radio_control::set_tx_antenna)
-        .def("get_rx_antenna", &radio_control::get_rx_antenna)
-        .def("get_rx_antennas", &radio_control::get_rx_antennas)
-        .def("set_rx_antenna", &radio_control::set_rx_antenna)
-        .def("get_tx_frequency", &radio_control::get_tx_frequency)
-        .def("set_tx_frequency", &radio_control::set_tx_frequency)
-        .def("set_tx_tune_args", &radio_control::set_tx_tune_args)
-        .def("get_tx_frequency_range", &radio_control::get_tx_frequency_range)
-        .def("get_rx_frequency", &radio_control::get_rx_frequency)
-        .def("set_rx_frequency", &radio_control::set_rx_frequency)
-        .def("set_rx_tune_args", &radio_control::set_rx_tune_args)
-        .def("get_rx_frequency_range", &radio_control::get_rx_frequency_range)
-        .def("get_tx_gain_names", &radio_control::get_tx_gain_names)
+        .def("set_rate", &radio_control::set_rate, release_gil())
+        .def("get_rate", &radio_control::get_rate, release_gil())
+        .def("get_rate_range", &radio_control::get_rate_range, release_gil())
+        .def("get_tx_antenna", &radio_control::get_tx_antenna, release_gil())
+        .def("get_tx_antennas", &radio_control::get_tx_antennas, release_gil())
+        .def("set_tx_antenna", &radio_control::set_tx_antenna, release_gil())
+        .def("get_rx_antenna", &radio_control::get_rx_antenna, release_gil())
+        .def("get_rx_antennas", &radio_control::get_rx_antennas, release_gil())
+        .def("set_rx_antenna", &radio_control::set_rx_antenna, release_gil())
+        .def("get_tx_frequency", &radio_control::get_tx_frequency, release_gil())
+        .def("set_tx_frequency", &radio_control::set_tx_frequency, release_gil())
+        .def("set_tx_tune_args", &radio_control::set_tx_tune_args, release_gil())
+        .def("get_tx_frequency_range",
+            &radio_control::get_tx_frequency_range,
+            release_gil())
+        .def("get_rx_frequency", &radio_control::get_rx_frequency, release_gil())
+        .def("set_rx_frequency", &radio_control::set_rx_frequency, release_gil())
+        .def("set_rx_tune_args", &radio_control::set_rx_tune_args, release_gil())
+        .def("get_rx_frequency_range",
+            &radio_control::get_rx_frequency_range,
+            release_gil())
+        .def("set_tx_hop_table", &radio_control::set_tx_hop_table, release_gil())
+        .def("tx_hop", &radio_control::tx_hop, release_gil())
+        .def("set_rx_hop_table", &radio_control::set_rx_hop_table, release_gil())
+        .def("rx_hop", &radio_control::rx_hop, release_gil())
+        .def("get_tx_gain_names", &radio_control::get_tx_gain_names, release_gil())
         .def("get_tx_gain_range",
             py::overload_cast<const size_t>(
                 &radio_control::get_tx_gain_range, py::const_),
-            py::arg("chan"))
+            py::arg("chan"),
+            release_gil())
         .def("get_tx_gain_range",
             py::overload_cast<const std::string&, const size_t>(
                 &radio_control::get_tx_gain_range, py::const_),
             py::arg("name"),
-            py::arg("chan"))
+            py::arg("chan"),
+            release_gil())
         .def("get_tx_gain",
             py::overload_cast<const size_t>(&radio_control::get_tx_gain),
-            py::arg("chan"))
+            py::arg("chan"),
+            release_gil())
         .def("get_tx_gain",
             py::overload_cast<const std::string&, const size_t>(
                 &radio_control::get_tx_gain),
             py::arg("name"),
-            py::arg("chan"))
+            py::arg("chan"),
+            release_gil())
         .def("set_tx_gain",
             py::overload_cast<const double, const size_t>(&radio_control::set_tx_gain),
             py::arg("gain"),
-            py::arg("chan"))
+            py::arg("chan"),
+            release_gil())
         .def("set_tx_gain",
             py::overload_cast<const double, const std::string&, const size_t>(
                 &radio_control::set_tx_gain),
             py::arg("gain"),
             py::arg("name"),
-            py::arg("chan"))
-        .def("has_tx_power_reference", &radio_control::has_tx_power_reference)
-        .def("set_tx_power_reference", &radio_control::set_tx_power_reference)
-        .def("get_tx_power_reference", &radio_control::get_tx_power_reference)
+            py::arg("chan"),
+            release_gil())
+        .def("has_tx_power_reference",
+            &radio_control::has_tx_power_reference,
+            release_gil())
+        .def("set_tx_power_reference",
+            &radio_control::set_tx_power_reference,
+            release_gil())
+        .def("get_tx_power_reference",
+            &radio_control::get_tx_power_reference,
+            release_gil())
         .def("get_tx_power_ref_keys",
             &radio_control::get_tx_power_ref_keys,
-            py::arg("chan") = 0)
-        .def("get_rx_gain_names", &radio_control::get_rx_gain_names)
+            py::arg("chan") = 0,
+            release_gil())
+        .def("get_rx_gain_names", &radio_control::get_rx_gain_names, release_gil())
         .def("get_rx_gain_range",
             py::overload_cast<const size_t>(
                 &radio_control::get_rx_gain_range, py::const_),
-            py::arg("chan"))
+            py::arg("chan"),
+            release_gil())
         .def("get_rx_gain_range",
             py::overload_cast<const std::string&, const size_t>(
                 &radio_control::get_rx_gain_range, py::const_),
             py::arg("name"),
-            py::arg("chan"))
+            py::arg("chan"),
+            release_gil())
         .def("get_rx_gain",
             py::overload_cast<const size_t>(&radio_control::get_rx_gain),
-            py::arg("chan"))
+            py::arg("chan"),
+            release_gil())
         .def("get_rx_gain",
             py::overload_cast<const std::string&, const size_t>(
                 &radio_control::get_rx_gain),
             py::arg("name"),
-            py::arg("chan"))
+            py::arg("chan"),
+            release_gil())
         .def("set_rx_gain",
             py::overload_cast<const double, const size_t>(&radio_control::set_rx_gain),
             py::arg("gain"),
-            py::arg("chan"))
+            py::arg("chan"),
+            release_gil())
         .def("set_rx_gain",
             py::overload_cast<const double, const std::string&, const size_t>(
                 &radio_control::set_rx_gain),
             py::arg("gain"),
             py::arg("name"),
-            py::arg("chan"))
-        .def("set_rx_agc", &radio_control::set_rx_agc)
-        .def("has_rx_power_reference", &radio_control::has_rx_power_reference)
-        .def("set_rx_power_reference", &radio_control::set_rx_power_reference)
-        .def("get_rx_power_reference", &radio_control::get_rx_power_reference)
+            py::arg("chan"),
+            release_gil())
+        .def("set_rx_agc", &radio_control::set_rx_agc, release_gil())
+        .def("has_rx_power_reference",
+            &radio_control::has_rx_power_reference,
+            release_gil())
+        .def("set_rx_power_reference",
+            &radio_control::set_rx_power_reference,
+            release_gil())
+        .def("get_rx_power_reference",
+            &radio_control::get_rx_power_reference,
+            release_gil())
         .def("get_rx_power_ref_keys",
             &radio_control::get_rx_power_ref_keys,
-            py::arg("chan") = 0)
-        .def("get_tx_gain_profile_names", &radio_control::get_tx_gain_profile_names)
-        .def("get_rx_gain_profile_names", &radio_control::get_rx_gain_profile_names)
-        .def("set_tx_gain_profile", &radio_control::set_tx_gain_profile)
-        .def("set_rx_gain_profile", &radio_control::set_rx_gain_profile)
-        .def("get_tx_gain_profile", &radio_control::get_tx_gain_profile)
-        .def("get_rx_gain_profile", &radio_control::get_rx_gain_profile)
-        .def("get_tx_bandwidth_range", &radio_control::get_tx_bandwidth_range)
-        .def("get_tx_bandwidth", &radio_control::get_tx_bandwidth)
-        .def("set_tx_bandwidth", &radio_control::set_tx_bandwidth)
-        .def("get_rx_bandwidth_range", &radio_control::get_rx_bandwidth_range)
-        .def("get_rx_bandwidth", &radio_control::get_rx_bandwidth)
-        .def("set_rx_bandwidth", &radio_control::set_rx_bandwidth)
-        .def("get_rx_lo_names", &radio_control::get_rx_lo_names)
-        .def("get_rx_lo_sources", &radio_control::get_rx_lo_sources)
-        .def("get_rx_lo_freq_range", &radio_control::get_rx_lo_freq_range)
-        .def("set_rx_lo_source", &radio_control::set_rx_lo_source)
-        .def("get_rx_lo_source", &radio_control::get_rx_lo_source)
-        .def("set_rx_lo_export_enabled", &radio_control::set_rx_lo_export_enabled)
-        .def("get_rx_lo_export_enabled", &radio_control::get_rx_lo_export_enabled)
-        .def("set_rx_lo_freq", &radio_control::set_rx_lo_freq)
-        .def("get_rx_lo_freq", &radio_control::get_rx_lo_freq)
-        .def("get_tx_lo_names", &radio_control::get_tx_lo_names)
-        .def("get_tx_lo_sources", &radio_control::get_tx_lo_sources)
-        .def("get_tx_lo_freq_range", &radio_control::get_tx_lo_freq_range)
-        .def("set_tx_lo_source", &radio_control::set_tx_lo_source)
-        .def("get_tx_lo_source", &radio_control::get_tx_lo_source)
-        .def("set_tx_lo_export_enabled", &radio_control::set_tx_lo_export_enabled)
-        .def("get_tx_lo_export_enabled", &radio_control::get_tx_lo_export_enabled)
-        .def("set_tx_lo_freq", &radio_control::set_tx_lo_freq)
-        .def("get_tx_lo_freq", &radio_control::get_tx_lo_freq)
-        .def("set_tx_dc_offset", &radio_control::set_tx_dc_offset)
-        .def("get_tx_dc_offset_range", &radio_control::get_tx_dc_offset_range)
-        .def("set_tx_iq_balance", &radio_control::set_tx_iq_balance)
+            py::arg("chan") = 0,
+            release_gil())
+        .def("get_tx_gain_profile_names",
+            &radio_control::get_tx_gain_profile_names,
+            release_gil())
+        .def("get_rx_gain_profile_names",
+            &radio_control::get_rx_gain_profile_names,
+            release_gil())
+        .def("set_tx_gain_profile", &radio_control::set_tx_gain_profile, release_gil())
+        .def("set_rx_gain_profile", &radio_control::set_rx_gain_profile, release_gil())
+        .def("get_tx_gain_profile", &radio_control::get_tx_gain_profile, release_gil())
+        .def("get_rx_gain_profile", &radio_control::get_rx_gain_profile, release_gil())
+        .def("get_tx_bandwidth_range",
+            &radio_control::get_tx_bandwidth_range,
+            release_gil())
+        .def("get_tx_bandwidth", &radio_control::get_tx_bandwidth, release_gil())
+        .def("set_tx_bandwidth", &radio_control::set_tx_bandwidth, release_gil())
+        .def("get_rx_bandwidth_range",
+            &radio_control::get_rx_bandwidth_range,
+            release_gil())
+        .def("get_rx_bandwidth", &radio_control::get_rx_bandwidth, release_gil())
+        .def("set_rx_bandwidth", &radio_control::set_rx_bandwidth, release_gil())
+        .def("get_rx_lo_names", &radio_control::get_rx_lo_names, release_gil())
+        .def("get_rx_lo_sources", &radio_control::get_rx_lo_sources, release_gil())
+        .def("get_rx_lo_freq_range", &radio_control::get_rx_lo_freq_range, release_gil())
+        .def("set_rx_lo_source", &radio_control::set_rx_lo_source, release_gil())
+        .def("get_rx_lo_source", &radio_control::get_rx_lo_source, release_gil())
+        .def("set_rx_lo_export_enabled",
+            &radio_control::set_rx_lo_export_enabled,
+            release_gil())
+        .def("get_rx_lo_export_enabled",
+            &radio_control::get_rx_lo_export_enabled,
+            release_gil())
+        .def("set_rx_lo_freq", &radio_control::set_rx_lo_freq, release_gil())
+        .def("get_rx_lo_freq", &radio_control::get_rx_lo_freq, release_gil())
+        .def("get_tx_lo_names", &radio_control::get_tx_lo_names, release_gil())
+        .def("get_tx_lo_sources", &radio_control::get_tx_lo_sources, release_gil())
+        .def("get_tx_lo_freq_range", &radio_control::get_tx_lo_freq_range, release_gil())
+        .def("set_tx_lo_source", &radio_control::set_tx_lo_source, release_gil())
+        .def("get_tx_lo_source", &radio_control::get_tx_lo_source, release_gil())
+        .def("set_tx_lo_export_enabled",
+            &radio_control::set_tx_lo_export_enabled,
+            release_gil())
+        .def("get_tx_lo_export_enabled",
+            &radio_control::get_tx_lo_export_enabled,
+            release_gil())
+        .def("set_tx_lo_freq", &radio_control::set_tx_lo_freq, release_gil())
+        .def("get_tx_lo_freq", &radio_control::get_tx_lo_freq, release_gil())
+        .def("set_tx_dc_offset", &radio_control::set_tx_dc_offset, release_gil())
+        .def("get_tx_dc_offset_range",
+            &radio_control::get_tx_dc_offset_range,
+            release_gil())
+        .def("set_tx_iq_balance", &radio_control::set_tx_iq_balance, release_gil())
         .def("set_rx_dc_offset",
             py::overload_cast<const bool, size_t>(&radio_control::set_rx_dc_offset),
             py::arg("enb"),
-            py::arg("chan") = ALL_CHANS)
+            py::arg("chan") = ALL_CHANS,
+            release_gil())
         .def("set_rx_dc_offset",
             py::overload_cast<const std::complex<double>&, size_t>(
                 &radio_control::set_rx_dc_offset),
             py::arg("offset"),
-            py::arg("chan"))
-        .def("get_rx_dc_offset_range", &radio_control::get_rx_dc_offset_range)
+            py::arg("chan"),
+            release_gil())
+        .def("get_rx_dc_offset_range",
+            &radio_control::get_rx_dc_offset_range,
+            release_gil())
         .def("set_rx_iq_balance",
             py::overload_cast<const bool, size_t>(&radio_control::set_rx_iq_balance),
             py::arg("enb"),
-            py::arg("chan"))
+            py::arg("chan"),
+            release_gil())
         .def("set_rx_iq_balance",
             py::overload_cast<const std::complex<double>&, size_t>(
                 &radio_control::set_rx_iq_balance),
             py::arg("correction"),
-            py::arg("chan"))
-        .def("get_gpio_banks", &radio_control::get_gpio_banks)
-        .def("set_gpio_attr", &radio_control::set_gpio_attr)
-        .def("get_gpio_attr", &radio_control::get_gpio_attr)
-        .def("get_rx_sensor_names", &radio_control::get_rx_sensor_names)
-        .def("get_rx_sensor", &radio_control::get_rx_sensor)
-        .def("get_tx_sensor_names", &radio_control::get_tx_sensor_names)
-        .def("get_tx_sensor", &radio_control::get_tx_sensor)
-        .def("issue_stream_cmd", &radio_control::issue_stream_cmd)
-        .def("enable_rx_timestamps", &radio_control::enable_rx_timestamps)
-        .def("get_slot_name", &radio_control::get_slot_name)
-        .def("get_chan_from_dboard_fe", &radio_control::get_chan_from_dboard_fe)
-        .def("get_dboard_fe_from_chan", &radio_control::get_dboard_fe_from_chan)
-        .def("get_fe_name", &radio_control::get_fe_name)
-        .def("set_db_eeprom", &radio_control::set_db_eeprom)
-        .def("get_db_eeprom", &radio_control::get_db_eeprom);
+            py::arg("chan"),
+            release_gil())
+        .def("get_gpio_banks", &radio_control::get_gpio_banks, release_gil())
+        .def("set_gpio_attr", &radio_control::set_gpio_attr, release_gil())
+        .def("get_gpio_attr", &radio_control::get_gpio_attr, release_gil())
+        .def("set_gpio_sequence", &radio_control::set_gpio_sequence, release_gil())
+        .def("get_rx_sensor_names", &radio_control::get_rx_sensor_names, release_gil())
+        .def("get_rx_sensor", &radio_control::get_rx_sensor, release_gil())
+        .def("get_tx_sensor_names", &radio_control::get_tx_sensor_names, release_gil())
+        .def("get_tx_sensor", &radio_control::get_tx_sensor, release_gil())
+        .def("issue_stream_cmd", &radio_control::issue_stream_cmd, release_gil())
+        .def("issue_rx_scan", &radio_control::issue_rx_scan, release_gil())
+        .def("enable_rx_timestamps", &radio_control::enable_rx_timestamps, release_gil())
+        .def("get_slot_name", &radio_control::get_slot_name, release_gil())
+        .def("get_chan_from_dboard_fe",
+            &radio_control::get_chan_from_dboard_fe,
+            release_gil())
+        .def("get_dboard_fe_from_chan",
+            &radio_control::get_dboard_fe_from_chan,
+            release_gil())
+        .def("get_fe_name", &radio_control::get_fe_name, release_gil())
+        .def("set_db_eeprom", &radio_control::set_db_eeprom, release_gil())
+        .def("get_db_eeprom", &radio_control::get_db_eeprom, release_gil());
 }
@@ -6,6 +6,9 @@
 
 #include <uhd/rfnoc/register_iface_holder.hpp>
 #include <uhd/utils/log.hpp>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 using namespace uhd::rfnoc;
 
@@ -49,6 +52,12 @@ public:
         return {};
     }
 
+    std::vector<uint32_t> multi_peek32(const std::vector<uint32_t>&, uhd::time_spec_t)
+    {
+        UHD_LOG_ERROR("REGS", "Attempting to use invalidated register interface!");
+        return {};
+    }
+
     void poll32(uint32_t, uint32_t, uint32_t, uhd::time_spec_t, uhd::time_spec_t, bool)
     {
         UHD_LOG_ERROR("REGS", "Attempting to use invalidated register interface!");
@@ -87,11 +96,433 @@ public:
     }
 }; // class invalid_register_iface
 
+/*! Write-through shadow register cache
+ *
+ * This forwards all transactions to another register_iface, and keeps a copy
+ * of the values of all non-volatile registers that were written. Untimed reads
+ * of these registers return the copy instead of accessing the device.
+ */
+class uhd::rfnoc::shadow_register_iface : public register_iface
+{
+public:
+    using addr_set_t = std::unordered_set<uint32_t>;
+
+    shadow_register_iface(
+        register_iface::sptr regs, const addr_set_t& volatile_addrs = {})
+        : _regs(std::move(regs)), _volatile_addrs(volatile_addrs)
+    {
+    }
+
+    ~shadow_register_iface() = default;
+
+    void poke32(uint32_t addr, uint32_t data, uhd::time_spec_t time, bool ack)
+    {
+        try {
+            _regs->poke32(addr, data, time, ack);
+        } catch (...) {
+            forget({addr});
+            throw;
+        }
+        store(addr, {data});
+    }
+
+    void multi_poke32(const std::vector<uint32_t> addrs,
+        const std::vector<uint32_t> data,
+        uhd::time_spec_t time,
+        bool ack)
+    {
+        try {
+            _regs->multi_poke32(addrs, data, time, ack);
+        } catch (...) {
+            forget(addrs);
+            throw;
+        }
+        std::lock_guard<std::mutex> l(_mutex);
+        for (size_t i = 0; i < addrs.size(); i++) {
+            _store(addrs[i], data[i]);
+        }
+    }
+
+    void block_poke32(uint32_t first_addr,
+        const std::vector<uint32_t> data,
+        uhd::time_spec_t time,
+        bool ack)
+    {
+        try {
+            _regs->block_poke32(first_addr, data, time, ack);
+        } catch (...) {
+            forget(get_addrs(first_addr, data.size()));
+            throw;
+        }
+        store(first_addr, data);
+    }
+
+    uint32_t peek32(uint32_t addr, uhd::time_spec_t time)
+    {
+        std::vector<uint32_t> data;
+        if (time == uhd::time_spec_t::ASAP && lookup(addr, 1, data)) {
+            return data[0];
+        }
+        return _regs->peek32(addr, time);
+    }
+
+    std::vector<uint32_t> block_peek32(
+        uint32_t first_addr, size_t length, uhd::time_spec_t time)
+    {
+        std::vector<uint32_t> data;
+        if (time == uhd::time_spec_t::ASAP && lookup(first_addr, length, data)) {
+            return data;
+        }
+        return _regs->block_peek32(first_addr, length, time);
+    }
+
+    std::vector<uint32_t> multi_peek32(
+        const std::vector<uint32_t>& addrs, uhd::time_spec_t time)
+    {
+        if (time == uhd::time_spec_t::ASAP) {
+            std::vector<uint32_t> data;
+            std::vector<uint32_t> values;
+            values.reserve(addrs.size());
+            for (const uint32_t addr : addrs) {
+                if (!lookup(addr, 1, data)) {
+                    return _regs->multi_peek32(addrs, time);
+                }
+                values.push_back(data[0]);
+            }
+            return values;
+        }
+        return _regs->multi_peek32(addrs, time);
+    }
+
+    std::future<void> poke32_async(uint32_t addr, uint32_t data, uhd::time_spec_t time)
+    {
+        auto result = _regs->poke32_async(addr, data, time);
+        store(addr, {data});
+        return result;
+    }
+
+    std::future<uint32_t> peek32_async(uint32_t addr, uhd::time_spec_t time)
+    {
+        std::vector<uint32_t> data;
+        if (time == uhd::time_spec_t::ASAP && lookup(addr, 1, data)) {
+            std::promise<uint32_t> result;
+            result.set_value(data[0]);
+            return result.get_future();
+        }
+        return _regs->peek32_async(addr, time);
+    }
+
+    void poll32(uint32_t addr,
+        uint32_t data,
+        uint32_t mask,
+        uhd::time_spec_t timeout,
+        uhd::time_spec_t time,
+        bool ack)
+    {
+        _regs->poll32(addr, data, mask, timeout, time, ack);
+    }
+
+    void sleep(uhd::time_spec_t duration, bool ack)
+    {
+        _regs->sleep(duration, ack);
+    }
+
+    void begin_batch()
+    {
+        _regs->begin_batch();
+    }
+
+    void end_batch()
+    {
+        _regs->end_batch();
+    }
+
+    void register_async_msg_validator(async_msg_validator_t callback_f)
+    {
+        _regs->register_async_msg_validator(callback_f);
+    }
+
+    void register_async_msg_handler(async_msg_callback_t callback_f)
+    {
+        _regs->register_async_msg_handler(callback_f);
+    }
+
+    void set_policy(const std::string& name, const uhd::device_addr_t& args)
+    {
+        _regs->set_policy(name, args);
+    }
+
+    uint16_t get_src_epid() const
+    {
+        return _regs->get_src_epid();
+    }
+
+    uint16_t get_port_num() const
+    {
+        return _regs->get_port_num();
+    }
+
+    void set_volatile(const uint32_t addr)
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _volatile_addrs.insert(addr);
+        _shadow_regs.erase(addr);
+    }
+
+    void invalidate()
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _shadow_regs.clear();
+    }
+
+    addr_set_t get_volatile_addrs()
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _volatile_addrs;
+    }
+
+private:
+    static std::vector<uint32_t> get_addrs(const uint32_t first_addr, const size_t length)
+    {
+        std::vector<uint32_t> addrs(length);
+        for (size_t i = 0; i < length; i++) {
+            addrs[i] = first_addr + i * sizeof(uint32_t);
+        }
+        return addrs;
+    }
+
+    void _store(const uint32_t addr, const uint32_t data)
+    {
+        if (_volatile_addrs.count(addr) == 0) {
+            _shadow_regs[addr] = data;
+        }
+    }
+
+    //! Store the values of consecutive registers
+    void store(const uint32_t first_addr, const std::vector<uint32_t>& data)
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        for (size_t i = 0; i < data.size(); i++) {
+            _store(first_addr + i * sizeof(uint32_t), data[i]);
+        }
+    }
+
+    //! Forget the values of registers, because writing them may have failed
+    void forget(const std::vector<uint32_t>& addrs)
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        for (const uint32_t addr : addrs) {
+            _shadow_regs.erase(addr);
+        }
+    }
+
+    //! Look up the values of consecutive registers
+    //
+    // Returns false if any of them is not in the cache.
+    bool lookup(
+        const uint32_t first_addr, const size_t length, std::vector<uint32_t>& data)
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        data.resize(length);
+        for (size_t i = 0; i < length; i++) {
+            auto it = _shadow_regs.find(first_addr + i * sizeof(uint32_t));
+            if (it == _shadow_regs.end()) {
+                return false;
+            }
+            data[i] = it->second;
+        }
+        return true;
+    }
+
+    const register_iface::sptr _regs;
+    std::mutex _mutex;
+    addr_set_t _volatile_addrs;
+    std::unordered_map<uint32_t, uint32_t> _shadow_regs;
+}; // class shadow_register_iface
+
+/*! Register interface that records all writes, see
+ * register_iface_holder::record_reg_writes()
+ */
+class recording_register_iface : public register_iface
+{
+public:
+    using reg_writes_t = std::vector<std::pair<uint32_t, uint32_t>>;
+
+    recording_register_iface(register_iface::sptr regs) : _regs(std::move(regs)) {}
+
+    ~recording_register_iface() = default;
+
+    void poke32(uint32_t addr, uint32_t data, uhd::time_spec_t time, bool ack)
+    {
+        _regs->poke32(addr, data, time, ack);
+        _writes.emplace_back(addr, data);
+    }
+
+    void multi_poke32(const std::vector<uint32_t> addrs,
+        const std::vector<uint32_t> data,
+        uhd::time_spec_t time,
+        bool ack)
+    {
+        _regs->multi_poke32(addrs, data, time, ack);
+        for (size_t i = 0; i < addrs.size(); i++) {
+            _writes.emplace_back(addrs[i], data[i]);
+        }
+    }
+
+    void block_poke32(uint32_t first_addr,
+        const std::vector<uint32_t> data,
+        uhd::time_spec_t time,
+        bool ack)
+    {
+        _regs->block_poke32(first_addr, data, time, ack);
+        for (size_t i = 0; i < data.size(); i++) {
+            _writes.emplace_back(first_addr + i * sizeof(uint32_t), data[i]);
+        }
+    }
+
+    uint32_t peek32(uint32_t addr, uhd::time_spec_t time)
+    {
+        return _regs->peek32(addr, time);
+    }
+
+    std::vector<uint32_t> block_peek32(
+        uint32_t first_addr, size_t length, uhd::time_spec_t time)
+    {
+        return _regs->block_peek32(first_addr, length, time);
+    }
+
+    std::vector<uint32_t> multi_peek32(
+        const std::vector<uint32_t>& addrs, uhd::time_spec_t time)
+    {
+        return _regs->multi_peek32(addrs, time);
+    }
+
+    std::future<void> poke32_async(uint32_t addr, uint32_t data, uhd::time_spec_t time)
+    {
+        auto result = _regs->poke32_async(addr, data, time);
+        _writes.emplace_back(addr, data);
+        return result;
+    }
+
+    std::future<uint32_t> peek32_async(uint32_t addr, uhd::time_spec_t time)
+    {
+        return _regs->peek32_async(addr, time);
+    }
+
+    void poll32(uint32_t addr,
+        uint32_t data,
+        uint32_t mask,
+        uhd::time_spec_t timeout,
+        uhd::time_spec_t time,
+        bool ack)
+    {
+        _regs->poll32(addr, data, mask, timeout, time, ack);
+    }
+
+    void sleep(uhd::time_spec_t duration, bool ack)
+    {
+        _regs->sleep(duration, ack);
+    }
+
+    void begin_batch()
+    {
+        _regs->begin_batch();
+    }
+
+    void end_batch()
+    {
+        _regs->end_batch();
+    }
+
+    void register_async_msg_validator(async_msg_validator_t callback_f)
+    {
+        _regs->register_async_msg_validator(callback_f);
+    }
+
+    void register_async_msg_handler(async_msg_callback_t callback_f)
+    {
+        _regs->register_async_msg_handler(callback_f);
+    }
+
+    void set_policy(const std::string& name, const uhd::device_addr_t& args)
+    {
+        _regs->set_policy(name, args);
+    }
+
+    uint16_t get_src_epid() const
+    {
+        return _regs->get_src_epid();
+    }
+
+    uint16_t get_port_num() const
+    {
+        return _regs->get_port_num();
+    }
+
+    reg_writes_t get_writes() const
+    {
+        return _writes;
+    }
+
+private:
+    const register_iface::sptr _regs;
+    reg_writes_t _writes;
+}; // class recording_register_iface
+
+void register_iface_holder::enable_shadow_regs(
+    const std::vector<uint32_t>& volatile_addrs)
+{
+    if (!_shadow) {
+        _shadow = std::make_shared<shadow_register_iface>(_reg);
+        _reg    = _shadow;
+    }
+    for (const uint32_t addr : volatile_addrs) {
+        _shadow->set_volatile(addr);
+    }
+}
+
+void register_iface_holder::set_volatile_reg(const uint32_t addr)
+{
+    if (_shadow) {
+        _shadow->set_volatile(addr);
+    }
+}
+
+void register_iface_holder::invalidate_shadow_regs()
+{
+    if (_shadow) {
+        _shadow->invalidate();
+    }
+}
+
 void register_iface_holder::update_reg_iface(register_iface::sptr new_iface)
 {
-    if (new_iface) {
-        _reg = new_iface;
-    } else {
+    if (!new_iface) {
+        // The device is gone, so there is nothing left to cache
+        _shadow.reset();
         _reg = std::make_shared<invalid_register_iface>();
+    } else if (_shadow) {
+        // The registers behind the new interface may not match our copy
+        _shadow = std::make_shared<shadow_register_iface>(
+            new_iface, _shadow->get_volatile_addrs());
+        _reg = _shadow;
+    } else {
+        _reg = new_iface;
+    }
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> register_iface_holder::record_reg_writes(
+    const std::function<void()>& fn)
+{
+    register_iface::sptr regs = _reg;
+    auto recorder             = std::make_shared<recording_register_iface>(regs);
+    _reg                      = recorder;
+    try {
+        fn();
+    } catch (...) {
+        _reg = regs;
+        throw;
     }
+    _reg = regs;
+    return recorder->get_writes();
 }
@@ -11,16 +11,33 @@
 #include <uhd/rfnoc/noc_block_make_args.hpp>
 #include <uhd/rfnoc/node.hpp>
 #include <uhd/rfnoc_graph.hpp>
+#include <uhd/utils/realtime.hpp>
 #include <uhdlib/rfnoc/block_container.hpp>
 #include <uhdlib/rfnoc/factory.hpp>
 #include <uhdlib/rfnoc/graph.hpp>
 #include <uhdlib/rfnoc/graph_stream_manager.hpp>
+#include <uhdlib/rfnoc/node_accessor.hpp>
+#include <uhdlib/rfnoc/prop_accessor.hpp>
 #include <uhdlib/rfnoc/rfnoc_device.hpp>
 #include <uhdlib/rfnoc/rfnoc_rx_streamer.hpp>
 #include <uhdlib/rfnoc/rfnoc_tx_streamer.hpp>
 #include <uhdlib/usrp/common/io_service_mgr.hpp>
+#include <uhdlib/usrp/common/latency_mode.hpp>
+#include <uhdlib/utils/init_timeline.hpp>
 #include <uhdlib/utils/narrow.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <future>
+#include <iomanip>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <tuple>
 
 using namespace uhd;
 using namespace uhd::rfnoc;
@@ -28,6 +45,12 @@ using namespace uhd::rfnoc;
 namespace {
 const std::string LOG_ID("RFNOC::GRAPH");
 
+//! Device arg for the max. number of threads used to initialize block controllers
+const std::string BLOCK_INIT_THREADS_KEY("block_init_threads");
+
+//! Time between reads of the device time for TX streamers that drop late bursts (s)
+constexpr double LATE_DROP_CORRELATION_INTERVAL = 0.1;
+
 //! Which blocks are actually stored at a given port on the crossbar
 struct block_xbar_info
 {
@@ -49,8 +72,21 @@ struct streamer_info_t
 {
     detail::graph_t::node_ref_t node;
     std::map<size_t, connection_info_t> connections;
+    //! Keys of the transports to cache when the streamer is destroyed, by port
+    std::map<size_t, std::string> xport_keys;
+};
+
+//! A block controller that is ready to be constructed
+struct pending_block_t
+{
+    block_id_t block_id;
+    registry::factory_t factory_fn;
+    noc_block_base::make_args_ptr make_args;
 };
 
+//! Blocks that must be constructed one after another, in this order
+using block_init_group_t = std::vector<pending_block_t>;
+
 //! Information about a route (used for physical connect/disconnect)
 struct route_info_t
 {
@@ -58,6 +94,26 @@ struct route_info_t
     graph_edge_t src_static_edge;
     graph_edge_t dst_static_edge;
 };
+
+/*! Stores the value of \p prop in \p value, if it is of type data_t
+ *
+ * \return false if \p prop has a different type
+ */
+template <typename data_t>
+bool prop_to_str(property_base_t* prop, std::string& value)
+{
+    auto typed_prop = dynamic_cast<property_t<data_t>*>(prop);
+    if (!typed_prop) {
+        return false;
+    }
+    auto prop_access =
+        prop_accessor_t{}.get_scoped_prop_access(*prop, property_base_t::RO);
+    std::ostringstream value_stream;
+    value_stream << std::setprecision(std::numeric_limits<double>::max_digits10)
+                 << typed_prop->get();
+    value = value_stream.str();
+    return true;
+}
 } // namespace
 
 class rfnoc_graph_impl : public rfnoc_graph
@@ -69,11 +125,19 @@ public:
     rfnoc_graph_impl(
         detail::rfnoc_device::sptr dev, const uhd::device_addr_t& dev_addr) try
         : _device(dev),
+          _dev_addr(dev_addr),
           _tree(_device->get_tree()),
           _num_mboards(_tree->list("/mboards").size()),
           _block_registry(std::make_unique<detail::block_container_t>()),
           _graph(std::make_unique<uhd::rfnoc::detail::graph_t>()) {
+        init_timeline::scoped_span graph_span("rfnoc_graph");
         _mb_controllers.reserve(_num_mboards);
+        // Lock memory before the links allocate their frame buffers, so the
+        // rt_* device args also apply to them
+        const uhd::realtime_config_t rt_config = uhd::parse_realtime_args(dev_addr);
+        if (rt_config.is_enabled()) {
+            uhd::setup_realtime_process(rt_config);
+        }
         // Now initialize all subsystems:
         _init_io_srv_mgr(dev_addr); // Global I/O Service Manager
         _init_mb_controllers();
@@ -82,15 +146,23 @@ public:
             // If anything fails here, we immediately deinit all the other
             // blocks to avoid any more fallout, then safely bring down the
             // device.
+            std::vector<block_init_group_t> block_init_groups;
             for (size_t mb_idx = 0; mb_idx < _num_mboards; ++mb_idx) {
-                _init_blocks(mb_idx, dev_addr);
+                _init_blocks(mb_idx, dev_addr, block_init_groups);
             }
+            _make_blocks(block_init_groups,
+                dev_addr.cast<size_t>(BLOCK_INIT_THREADS_KEY,
+                    std::max<size_t>(1, std::thread::hardware_concurrency())));
             UHD_LOG_TRACE(LOG_ID, "Initializing properties on all blocks...");
-            _block_registry->init_props();
+            {
+                init_timeline::scoped_span span("init block properties");
+                _block_registry->init_props();
+            }
             _init_sep_map();
             _init_static_connections();
             _init_mbc();
             // Start with time set to zero, but don't complain if sync fails
+            init_timeline::scoped_span span("synchronize devices");
             rfnoc_graph_impl::synchronize_devices(uhd::time_spec_t(0.0), true);
         } catch (...) {
             _block_registry->shutdown();
@@ -307,6 +379,15 @@ public:
 
         rfnoc_streamer->connect_channel(strm_port, std::move(xport));
 
+        // Late bursts are found from the time estimate of the device, so keep
+        // that up to date
+        if (rfnoc_streamer->get_stream_args().args.has_key(
+                rfnoc_tx_streamer::LATE_DROP_MARGIN_KEY)) {
+            auto mbc = get_mb_controller(dst_blk.get_device_no());
+            mbc->set_time_correlation_interval(0, LATE_DROP_CORRELATION_INTERVAL);
+            rfnoc_streamer->set_timekeeper(mbc->get_timekeeper(0));
+        }
+
         // If this worked, then also connect the streamer in the BGL graph
         auto dst = get_block(dst_blk);
         graph_edge_t edge_info(strm_port, dst_port, graph_edge_t::TX_STREAM, true);
@@ -359,14 +440,37 @@ public:
             bits_to_sw_buff(rfnoc_streamer->get_otw_item_comp_bit_width());
         const sw_buff_t mdata_fmt = BUFF_U64;
 
-        auto xport = _gsm->create_device_to_host_data_stream(sep_addr,
-            pyld_fmt,
-            mdata_fmt,
-            adapter_id,
-            rfnoc_streamer->get_stream_args().args,
-            rfnoc_streamer->get_unique_id());
+        const uhd::device_addr_t& stream_args = rfnoc_streamer->get_stream_args().args;
+
+        // Reuse the transport of a previous streamer on the same SEP if allowed
+        const bool reuse_xport = stream_args.cast<bool>("reuse_xport", false);
+        const std::string xport_key =
+            reuse_xport ? _get_rx_xport_key(sep_addr, pyld_fmt, adapter_id, stream_args)
+                        : std::string();
+
+        chdr_rx_data_xport::uptr xport =
+            reuse_xport ? _take_cached_rx_xport(xport_key) : nullptr;
+        if (!xport) {
+            xport = _gsm->create_device_to_host_data_stream(sep_addr,
+                pyld_fmt,
+                mdata_fmt,
+                adapter_id,
+                stream_args,
+                rfnoc_streamer->get_unique_id());
+        }
 
         rfnoc_streamer->connect_channel(strm_port, std::move(xport));
+        if (reuse_xport) {
+            std::weak_ptr<rfnoc_graph_impl> weak_graph =
+                std::static_pointer_cast<rfnoc_graph_impl>(shared_from_this());
+            rfnoc_streamer->set_xport_release_cb(
+                [weak_graph, streamer_id = rfnoc_streamer->get_unique_id()](
+                    size_t port, chdr_rx_data_xport::uptr released) {
+                    if (auto graph = weak_graph.lock()) {
+                        graph->_cache_rx_xport(streamer_id, port, std::move(released));
+                    }
+                });
+        }
 
         // If this worked, then also connect the streamer in the BGL graph
         auto src = get_block(src_blk);
@@ -376,6 +480,10 @@ public:
         _rx_streamers[rfnoc_streamer->get_unique_id()].node = rfnoc_streamer.get();
         _rx_streamers[rfnoc_streamer->get_unique_id()].connections[strm_port] = {
             src.get(), rfnoc_streamer.get(), edge_info};
+        if (reuse_xport) {
+            _rx_streamers[rfnoc_streamer->get_unique_id()].xport_keys[strm_port] =
+                xport_key;
+        }
     }
 
     void disconnect(const std::string& streamer_id)
@@ -435,16 +543,18 @@ public:
         const size_t num_ports, const uhd::stream_args_t& args)
     {
         auto this_graph = shared_from_this();
-        return std::make_shared<rfnoc_rx_streamer>(
-            num_ports, args, [this_graph](const std::string& id) { this_graph->disconnect(id); });
+        return std::make_shared<rfnoc_rx_streamer>(num_ports,
+            _apply_latency_mode(args),
+            [this_graph](const std::string& id) { this_graph->disconnect(id); });
     }
 
     uhd::tx_streamer::sptr create_tx_streamer(
         const size_t num_ports, const uhd::stream_args_t& args)
     {
         auto this_graph = shared_from_this();
-        return std::make_shared<rfnoc_tx_streamer>(
-            num_ports, args, [this_graph](const std::string& id) { this_graph->disconnect(id); });
+        return std::make_shared<rfnoc_tx_streamer>(num_ports,
+            _apply_latency_mode(args),
+            [this_graph](const std::string& id) { this_graph->disconnect(id); });
     }
 
     size_t get_num_mboards() const
@@ -476,6 +586,27 @@ public:
         return result;
     }
 
+    std::vector<block_status_t> get_block_status(const size_t mb_index = 0)
+    {
+        if (_client_zeros.count(mb_index) == 0) {
+            throw uhd::index_error(
+                std::string("Could not get block status for motherboard index ")
+                + std::to_string(mb_index));
+        }
+        std::vector<block_status_t> status;
+        for (const auto& port_status :
+            _client_zeros.at(mb_index)->get_all_port_status()) {
+            block_status_t block_status;
+            block_status.block_id =
+                _port_block_map.at({mb_index, size_t(port_status.portno)});
+            block_status.noc_id       = port_status.noc_id;
+            block_status.flush_active = port_status.flush_active;
+            block_status.flush_done   = port_status.flush_done;
+            status.push_back(block_status);
+        }
+        return status;
+    }
+
     uhd::property_tree::sptr get_tree(void) const
     {
         return _tree;
@@ -568,12 +699,139 @@ public:
         _graph->release();
     }
 
+    graph_snapshot_t export_snapshot()
+    {
+        graph_snapshot_t snapshot;
+        std::set<std::string> block_ids;
+        for (const auto& edge : _graph->enumerate_edges()) {
+            if ((edge.edge != graph_edge_t::STATIC && edge.edge != graph_edge_t::DYNAMIC)
+                || !has_block(edge.src_blockid) || !has_block(edge.dst_blockid)) {
+                continue;
+            }
+            snapshot.edges.push_back(edge);
+            block_ids.insert(edge.src_blockid);
+            block_ids.insert(edge.dst_blockid);
+        }
+        // Sort the edges, so the same graph always gives the same snapshot
+        std::sort(snapshot.edges.begin(),
+            snapshot.edges.end(),
+            [](const graph_edge_t& lhs, const graph_edge_t& rhs) {
+                return std::tie(lhs.src_blockid, lhs.src_port)
+                       < std::tie(rhs.src_blockid, rhs.src_port);
+            });
+
+        node_accessor_t node_accessor{};
+        for (const auto& block_id : block_ids) {
+            auto block = get_block(block_id);
+            auto props =
+                node_accessor.filter_props(block.get(), [](property_base_t* prop) {
+                    return prop->get_src_info().type == res_source_info::USER
+                           && prop->is_valid();
+                });
+            std::vector<graph_snapshot_t::property_value_t> prop_values;
+            for (auto prop : props) {
+                graph_snapshot_t::property_value_t prop_value;
+                if (!prop_to_str<bool>(prop, prop_value.value)
+                    && !prop_to_str<int>(prop, prop_value.value)
+                    && !prop_to_str<double>(prop, prop_value.value)
+                    && !prop_to_str<std::string>(prop, prop_value.value)) {
+                    UHD_LOG_TRACE(LOG_ID,
+                        "Not exporting property " << prop->get_id() << " of block "
+                                                  << block_id
+                                                  << ": Unsupported type");
+                    continue;
+                }
+                prop_value.block_id = block_id;
+                prop_value.prop_id  = prop->get_id();
+                prop_value.instance = prop->get_src_info().instance;
+                prop_values.push_back(prop_value);
+            }
+            std::sort(prop_values.begin(),
+                prop_values.end(),
+                [](const graph_snapshot_t::property_value_t& lhs,
+                    const graph_snapshot_t::property_value_t& rhs) {
+                    return std::tie(lhs.prop_id, lhs.instance)
+                           < std::tie(rhs.prop_id, rhs.instance);
+                });
+            snapshot.properties.insert(
+                snapshot.properties.end(), prop_values.begin(), prop_values.end());
+        }
+        return snapshot;
+    }
+
+    void import_snapshot(const graph_snapshot_t& snapshot)
+    {
+        // Validate everything first, so a bad snapshot leaves the graph alone
+        std::vector<detail::graph_t::connection_t> connections;
+        for (const auto& edge : snapshot.edges) {
+            for (const auto& block_id : {edge.src_blockid, edge.dst_blockid}) {
+                if (!has_block(block_id)) {
+                    throw uhd::lookup_error(
+                        "Cannot import graph snapshot, no such block: " + block_id);
+                }
+            }
+            const auto route_info = _get_route_info(
+                edge.src_blockid, edge.src_port, edge.dst_blockid, edge.dst_port);
+            if (route_info.edge_type != edge.edge) {
+                throw uhd::routing_error("Cannot import graph snapshot, connection "
+                                         + edge.to_string()
+                                         + " does not match the device");
+            }
+            connections.emplace_back(get_block(edge.src_blockid).get(),
+                get_block(edge.dst_blockid).get(),
+                edge);
+        }
+        // Block ID -> properties to set on that block
+        std::map<std::string, uhd::device_addr_t> block_props;
+        for (const auto& prop : snapshot.properties) {
+            if (!has_block(prop.block_id)) {
+                throw uhd::lookup_error(
+                    "Cannot import graph snapshot, no such block: " + prop.block_id);
+            }
+            const auto prop_ids = get_block(prop.block_id)->get_property_ids();
+            if (std::find(prop_ids.cbegin(), prop_ids.cend(), prop.prop_id)
+                == prop_ids.cend()) {
+                throw uhd::lookup_error("Cannot import graph snapshot, block "
+                                        + prop.block_id + " has no property "
+                                        + prop.prop_id);
+            }
+            block_props[prop.block_id][prop.prop_id + ":"
+                                       + std::to_string(prop.instance)] = prop.value;
+        }
+
+        // While the graph is released, setting properties only resolves them
+        // on their own block. Everything else is resolved once, on commit.
+        _graph->release();
+        try {
+            for (const auto& edge : snapshot.edges) {
+                if (edge.edge == graph_edge_t::DYNAMIC) {
+                    _physical_connect(
+                        edge.src_blockid, edge.src_port, edge.dst_blockid, edge.dst_port);
+                }
+            }
+            _graph->connect(connections);
+            for (const auto& props : block_props) {
+                get_block(props.first)->set_properties(props.second);
+            }
+        } catch (...) {
+            // Don't leave the graph released, but report the original error
+            try {
+                _graph->commit();
+            } catch (const uhd::exception& ex) {
+                UHD_LOG_ERROR(LOG_ID, "Failed to commit graph: " << ex.what());
+            }
+            throw;
+        }
+        _graph->commit();
+    }
+
 private:
     /**************************************************************************
      * Device Setup
      *************************************************************************/
     void _init_io_srv_mgr(const uhd::device_addr_t& dev_addr)
     {
+        init_timeline::scoped_span span("I/O service manager");
         _io_srv_mgr = usrp::io_service_mgr::make(dev_addr);
         for (size_t mb_idx = 0; mb_idx < _num_mboards; mb_idx++) {
             _device->get_mb_iface(mb_idx).set_io_srv_mgr(_io_srv_mgr);
@@ -590,6 +848,7 @@ private:
 
     void _init_gsm()
     {
+        init_timeline::scoped_span span("graph stream manager");
         UHD_LOG_TRACE(LOG_ID, "Initializing GSM...");
         auto e2s = [](uhd::endianness_t endianness) {
             return endianness == uhd::ENDIANNESS_BIG ? "BIG" : "LITTLE";
@@ -650,9 +909,20 @@ private:
         // FIXME
     }
 
-    // Initialize client zero and all block controllers for motherboard mb_idx
-    void _init_blocks(const size_t mb_idx, const uhd::device_addr_t& dev_addr)
+    /*! Initialize client zero and prepare all block controllers for
+     * motherboard mb_idx
+     *
+     * The block controllers are not constructed here, but added to
+     * \p block_init_groups so _make_blocks() can construct them. Blocks with
+     * access to the motherboard controller go into a single group, because they
+     * share it. All other blocks get a group of their own.
+     */
+    void _init_blocks(const size_t mb_idx,
+        const uhd::device_addr_t& dev_addr,
+        std::vector<block_init_group_t>& block_init_groups)
     {
+        init_timeline::scoped_span span(
+            "find blocks of mboard " + std::to_string(mb_idx));
         UHD_LOG_TRACE(LOG_ID, "Initializing blocks for MB " << mb_idx << "...");
         // Setup the interfaces for this mboard and get some configuration info
         mb_iface& mb = _device->get_mb_iface(mb_idx);
@@ -681,8 +951,9 @@ private:
 
         // Make a map to count the number of each block we have
         std::unordered_map<std::string, uint16_t> block_count_map;
+        block_init_group_t mb_access_blocks;
 
-        // Iterate through and register each of the blocks in this mboard
+        // Iterate through and prepare each of the blocks in this mboard
         for (size_t portno = 0; portno < num_blocks; ++portno) {
             const auto noc_id       = mb_cz->get_noc_id(portno + first_block_port);
             const auto device_type  = mb_cz->get_device_type();
@@ -727,23 +998,89 @@ private:
             _tree->create<uint32_t>(block_path / "noc_id").set(noc_id);
             make_args_uptr->tree = _tree->subtree(block_path);
             make_args_uptr->args = dev_addr; // TODO filter the device args
-            try {
-                _block_registry->register_block(
-                    block_factory_info.factory_fn(std::move(make_args_uptr)));
-            } catch (...) {
-                UHD_LOG_ERROR(
-                    LOG_ID, "Error during initialization of block " << block_id << "!");
-                throw;
+            pending_block_t pending_block{
+                block_id, block_factory_info.factory_fn, std::move(make_args_uptr)};
+            if (block_factory_info.mb_access) {
+                mb_access_blocks.push_back(std::move(pending_block));
+            } else {
+                block_init_groups.emplace_back();
+                block_init_groups.back().push_back(std::move(pending_block));
             }
             _xbar_block_config[block_id.to_string()] = {
                 portno, noc_id, block_id.get_block_count()};
 
             _port_block_map.insert({{mb_idx, portno + first_block_port}, block_id});
         }
+        if (!mb_access_blocks.empty()) {
+            block_init_groups.push_back(std::move(mb_access_blocks));
+        }
+    }
+
+    /*! Construct and register the block controllers prepared by _init_blocks()
+     *
+     * Block controllers run their initialization register traffic in their
+     * constructors, so this is where most of the time is spent while bringing
+     * up a device. The groups don't depend on each other, and are therefore
+     * constructed concurrently on up to \p num_threads threads.
+     *
+     * If a block fails to initialize, no more groups are started, and the first
+     * exception is rethrown once all threads are done.
+     */
+    void _make_blocks(
+        std::vector<block_init_group_t>& block_init_groups, const size_t num_threads)
+    {
+        init_timeline::scoped_span span("make blocks");
+        const init_timeline::span_id_t make_span = init_timeline::get_current_span();
+        std::atomic<size_t> next_group{0};
+        std::atomic<bool> failed{false};
+        auto make_groups = [&]() {
+            for (size_t group_idx = next_group++;
+                 group_idx < block_init_groups.size() && !failed;
+                 group_idx = next_group++) {
+                for (auto& pending_block : block_init_groups[group_idx]) {
+                    init_timeline::scoped_span block_span(
+                        pending_block.block_id.to_string(), make_span);
+                    try {
+                        _block_registry->register_block(pending_block.factory_fn(
+                            std::move(pending_block.make_args)));
+                    } catch (...) {
+                        UHD_LOG_ERROR(LOG_ID,
+                            "Error during initialization of block "
+                                << pending_block.block_id << "!");
+                        failed = true;
+                        throw;
+                    }
+                }
+            }
+        };
+
+        const size_t num_workers =
+            std::max<size_t>(1, std::min(num_threads, block_init_groups.size()));
+        UHD_LOG_TRACE(LOG_ID,
+            "Initializing " << block_init_groups.size() << " groups of blocks on "
+                            << num_workers << " threads...");
+        std::vector<std::future<void>> workers;
+        for (size_t i = 0; i < num_workers; i++) {
+            workers.emplace_back(std::async(std::launch::async, make_groups));
+        }
+        std::exception_ptr first_error;
+        for (auto& worker : workers) {
+            try {
+                worker.get();
+            } catch (...) {
+                if (!first_error) {
+                    first_error = std::current_exception();
+                }
+            }
+        }
+        if (first_error) {
+            std::rethrow_exception(first_error);
+        }
     }
 
     void _init_sep_map()
     {
+        init_timeline::scoped_span span("stream endpoint map");
         for (size_t mb_idx = 0; mb_idx < _num_mboards; ++mb_idx) {
             auto remote_device_id = _device->get_mb_iface(mb_idx).get_remote_device_id();
             auto& cz              = _client_zeros.at(mb_idx);
@@ -759,6 +1096,7 @@ private:
 
     void _init_static_connections()
     {
+        init_timeline::scoped_span span("static connections");
         UHD_LOG_TRACE(LOG_ID, "Identifying static connections...");
         for (auto& kv_cz : _client_zeros) {
             auto& adjacency_list = kv_cz.second->get_adjacency_list();
@@ -785,6 +1123,7 @@ private:
     //! Initialize the motherboard controllers, if they require it
     void _init_mbc()
     {
+        init_timeline::scoped_span span("init mb controllers");
         for (size_t i = 0; i < _mb_controllers.size(); ++i) {
             UHD_LOG_TRACE(LOG_ID, "Calling MBC init for motherboard " << i);
             _mb_controllers.at(i)->init();
@@ -794,6 +1133,14 @@ private:
     /**************************************************************************
      * Helpers
      *************************************************************************/
+    //! Returns \p args with the stream args the latency mode implies
+    uhd::stream_args_t _apply_latency_mode(const uhd::stream_args_t& args) const
+    {
+        uhd::stream_args_t latency_args = args;
+        latency_args.args = uhd::usrp::apply_latency_mode(args.args, _dev_addr);
+        return latency_args;
+    }
+
     /*! Internal connection helper
      *
      * Make the connections in the _graph, and set up property propagation
@@ -913,6 +1260,67 @@ private:
         return route_info.edge_type;
     }
 
+    /*! Returns the key under which an RX transport is cached
+     *
+     * Transports can only be reused for the same SEP, with the same format,
+     * on the same adapter, and with the same stream args.
+     */
+    static std::string _get_rx_xport_key(const sep_addr_t& sep_addr,
+        const sw_buff_t pyld_fmt,
+        const uhd::transport::adapter_id_t adapter_id,
+        const uhd::device_addr_t& stream_args)
+    {
+        return std::to_string(sep_addr.first) + "/" + std::to_string(sep_addr.second)
+               + ":" + std::to_string(pyld_fmt) + ":" + std::to_string(adapter_id)
+               + ":" + stream_args.to_string();
+    }
+
+    /*! Takes a cached RX transport, and drops any stale packets it holds
+     *
+     * \return the transport, or nullptr if none is cached under \p key
+     */
+    chdr_rx_data_xport::uptr _take_cached_rx_xport(const std::string& key)
+    {
+        chdr_rx_data_xport::uptr xport;
+        {
+            std::lock_guard<std::mutex> lock(_rx_xport_cache_mutex);
+            auto it = _rx_xport_cache.find(key);
+            if (it == _rx_xport_cache.end()) {
+                return nullptr;
+            }
+            xport = std::move(it->second);
+            _rx_xport_cache.erase(it);
+        }
+        UHD_LOG_TRACE(LOG_ID, "Reusing cached RX transport for " << key);
+
+        while (true) {
+            auto buff = std::get<0>(xport->get_recv_buff(0));
+            if (!buff) {
+                break;
+            }
+            xport->release_recv_buff(std::move(buff));
+        }
+        return xport;
+    }
+
+    /*! Caches the RX transport of a streamer that is destroyed
+     *
+     * This is called by the streamer before it disconnects from the graph.
+     */
+    void _cache_rx_xport(const std::string& streamer_id,
+        const size_t port,
+        chdr_rx_data_xport::uptr xport)
+    {
+        if (!_rx_streamers.count(streamer_id)
+            || !_rx_streamers.at(streamer_id).xport_keys.count(port)) {
+            return;
+        }
+        const std::string& key = _rx_streamers.at(streamer_id).xport_keys.at(port);
+        UHD_LOG_TRACE(LOG_ID, "Caching RX transport for " << key);
+        std::lock_guard<std::mutex> lock(_rx_xport_cache_mutex);
+        _rx_xport_cache.emplace(key, std::move(xport));
+    }
+
     /*! Internal physical disconnection helper
      *
      * Disconnects the physical device
@@ -985,6 +1393,9 @@ private:
     //! Reference to the underlying device implementation
     detail::rfnoc_device::sptr _device;
 
+    //! Device args, for the ones that apply to all streamers
+    const uhd::device_addr_t _dev_addr;
+
     //! Reference to the property tree
     uhd::property_tree::sptr _tree;
 
@@ -1042,6 +1453,12 @@ private:
 
     //! Map from RX streamer ID to streamer info
     std::map<std::string, streamer_info_t> _rx_streamers;
+
+    //! RX transports of destroyed streamers, kept for the next streamer that
+    // connects to the same SEP (see the reuse_xport stream arg). Declared
+    // last, so they are destroyed before anything they depend on.
+    std::multimap<std::string, chdr_rx_data_xport::uptr> _rx_xport_cache;
+    std::mutex _rx_xport_cache_mutex;
 }; /* class rfnoc_graph_impl */
 
 
@@ -1082,6 +1499,7 @@ rfnoc_graph::sptr make_rfnoc_graph(
 // device. This is used by multi_usrp_rfnoc, for example.
 rfnoc_graph::sptr rfnoc_graph::make(const uhd::device_addr_t& device_addr)
 {
+    init_timeline::scoped_span span("rfnoc_graph::make");
     auto dev =
         std::dynamic_pointer_cast<detail::rfnoc_device>(uhd::device::make(device_addr));
     if (!dev) {
@@ -8,7 +8,9 @@
 #define INCLUDED_UHD_RFNOC_PYTHON_HPP
 
 #include "../stream_python.hpp"
+#include "../utils/async_python.hpp"
 #include <uhd/rfnoc/block_id.hpp>
+#include <uhd/rfnoc/block_status.hpp>
 #include <uhd/rfnoc/graph_edge.hpp>
 #include <uhd/rfnoc/mb_controller.hpp>
 #include <uhd/rfnoc/noc_block_base.hpp>
@@ -134,6 +136,13 @@ void export_rfnoc(py::module& m)
         .def("__str__", &graph_edge_t::to_string)
         .def("to_string", &graph_edge_t::to_string);
 
+    py::class_<block_status_t>(m, "block_status")
+        .def(py::init<>())
+        .def_readwrite("block_id", &block_status_t::block_id)
+        .def_readwrite("noc_id", &block_status_t::noc_id)
+        .def_readwrite("flush_active", &block_status_t::flush_active)
+        .def_readwrite("flush_done", &block_status_t::flush_done);
+
     py::enum_<res_source_info::source_t>(m, "source")
         .value("user", res_source_info::USER)
         .value("input_edge", res_source_info::INPUT_EDGE)
@@ -160,26 +169,30 @@ void export_rfnoc(py::module& m)
         .def(py::self == py::self);
 
     py::class_<rfnoc_graph, rfnoc_graph::sptr>(m, "rfnoc_graph")
-        .def(py::init(&rfnoc_graph::make))
+        .def(py::init(&rfnoc_graph::make), release_gil())
 
         // General RFNoC Graph methods
         // TODO: Templated methods??
         .def("find_blocks",
             [](rfnoc_graph::sptr& self, const std::string& block_id_hint) {
                 return self->find_blocks(block_id_hint);
-            })
+            },
+            release_gil())
         .def("has_block",
             [](rfnoc_graph::sptr& self, const block_id_t& block_id) {
                 return self->has_block(block_id);
-            })
+            },
+            release_gil())
         .def("get_block",
             [](rfnoc_graph::sptr& self, const block_id_t& block_id) {
                 return self->get_block(block_id);
-            })
-        .def("is_connectable", &rfnoc_graph::is_connectable)
+            },
+            release_gil())
+        .def("is_connectable", &rfnoc_graph::is_connectable, release_gil())
         .def("connect",
             py::overload_cast<const block_id_t&, size_t, const block_id_t&, size_t, bool>(
-                &rfnoc_graph::connect))
+                &rfnoc_graph::connect),
+            release_gil())
         .def("connect",
             py::overload_cast<uhd::tx_streamer::sptr,
                 size_t,
@@ -190,7 +203,8 @@ void export_rfnoc(py::module& m)
             py::arg("strm_port"),
             py::arg("dst_blk"),
             py::arg("dst_blk"),
-            py::arg("adapter_id") = uhd::transport::NULL_ADAPTER_ID)
+            py::arg("adapter_id") = uhd::transport::NULL_ADAPTER_ID,
+            release_gil())
         .def("connect",
             py::overload_cast<const block_id_t&,
                 size_t,
@@ -201,91 +215,120 @@ void export_rfnoc(py::module& m)
             py::arg("src_blk"),
             py::arg("streamer"),
             py::arg("strm_port"),
-            py::arg("adapter_id") = uhd::transport::NULL_ADAPTER_ID)
+            py::arg("adapter_id") = uhd::transport::NULL_ADAPTER_ID,
+            release_gil())
         .def("disconnect",
             py::overload_cast<const block_id_t&, size_t, const block_id_t&, size_t>(
-                &rfnoc_graph::disconnect))
-        .def(
-            "disconnect", py::overload_cast<const std::string&>(&rfnoc_graph::disconnect))
+                &rfnoc_graph::disconnect),
+            release_gil())
+        .def("disconnect",
+            py::overload_cast<const std::string&>(&rfnoc_graph::disconnect),
+            release_gil())
         .def("disconnect",
-            py::overload_cast<const std::string&, size_t>(&rfnoc_graph::disconnect))
-        .def("enumerate_adapters_from_src", &rfnoc_graph::enumerate_adapters_from_src)
-        .def("enumerate_adapters_to_dst", &rfnoc_graph::enumerate_adapters_to_dst)
-        .def("enumerate_static_connections", &rfnoc_graph::enumerate_static_connections)
-        .def("enumerate_active_connections", &rfnoc_graph::enumerate_active_connections)
-        .def("commit", &rfnoc_graph::commit)
-        .def("release", &rfnoc_graph::release)
-        .def("create_rx_streamer", &rfnoc_graph::create_rx_streamer)
-        .def("create_tx_streamer", &rfnoc_graph::create_tx_streamer)
-        .def("get_num_mboards", &rfnoc_graph::get_num_mboards)
-        .def(
-            "get_mb_controller", &rfnoc_graph::get_mb_controller, py::arg("mb_index") = 0)
-        .def("synchronize_devices", &rfnoc_graph::synchronize_devices)
-        .def("get_tree", &rfnoc_graph::get_tree);
+            py::overload_cast<const std::string&, size_t>(&rfnoc_graph::disconnect),
+            release_gil())
+        .def("enumerate_adapters_from_src",
+            &rfnoc_graph::enumerate_adapters_from_src,
+            release_gil())
+        .def("enumerate_adapters_to_dst",
+            &rfnoc_graph::enumerate_adapters_to_dst,
+            release_gil())
+        .def("enumerate_static_connections",
+            &rfnoc_graph::enumerate_static_connections,
+            release_gil())
+        .def("enumerate_active_connections",
+            &rfnoc_graph::enumerate_active_connections,
+            release_gil())
+        .def("commit", &rfnoc_graph::commit, release_gil())
+        .def("release", &rfnoc_graph::release, release_gil())
+        .def("create_rx_streamer", &rfnoc_graph::create_rx_streamer, release_gil())
+        .def("create_tx_streamer", &rfnoc_graph::create_tx_streamer, release_gil())
+        .def("get_num_mboards", &rfnoc_graph::get_num_mboards, release_gil())
+        .def("get_mb_controller",
+            &rfnoc_graph::get_mb_controller,
+            py::arg("mb_index") = 0,
+            release_gil())
+        .def("synchronize_devices", &rfnoc_graph::synchronize_devices, release_gil())
+        .def("get_block_status",
+            &rfnoc_graph::get_block_status,
+            py::arg("mb_index") = 0,
+            release_gil())
+        .def("get_tree", &rfnoc_graph::get_tree, release_gil());
 
     py::class_<mb_controller, mb_controller::sptr>(m, "mb_controller")
-        .def("get_num_timekeepers", &mb_controller::get_num_timekeepers)
-        .def("get_timekeeper", &mb_controller::get_timekeeper)
-        .def("init", &mb_controller::init)
-        .def("get_mboard_name", &mb_controller::get_mboard_name)
-        .def("set_time_source", &mb_controller::set_time_source)
-        .def("get_time_source", &mb_controller::get_time_source)
-        .def("get_time_sources", &mb_controller::get_time_sources)
-        .def("set_clock_source", &mb_controller::set_clock_source)
-        .def("get_clock_source", &mb_controller::get_clock_source)
-        .def("get_clock_sources", &mb_controller::get_clock_sources)
+        .def("get_num_timekeepers", &mb_controller::get_num_timekeepers, release_gil())
+        .def("get_timekeeper", &mb_controller::get_timekeeper, release_gil())
+        .def("set_time_correlation_interval",
+            &mb_controller::set_time_correlation_interval,
+            release_gil())
+        .def("init", &mb_controller::init, release_gil())
+        .def("get_mboard_name", &mb_controller::get_mboard_name, release_gil())
+        .def("set_time_source", &mb_controller::set_time_source, release_gil())
+        .def("get_time_source", &mb_controller::get_time_source, release_gil())
+        .def("get_time_sources", &mb_controller::get_time_sources, release_gil())
+        .def("set_clock_source", &mb_controller::set_clock_source, release_gil())
+        .def("get_clock_source", &mb_controller::get_clock_source, release_gil())
+        .def("get_clock_sources", &mb_controller::get_clock_sources, release_gil())
         .def("set_sync_source",
             py::overload_cast<const std::string&, const std::string&>(
-                &mb_controller::set_sync_source))
+                &mb_controller::set_sync_source),
+            release_gil())
         .def("set_sync_source",
-            py::overload_cast<const uhd::device_addr_t&>(&mb_controller::set_sync_source))
-        .def("get_sync_source", &mb_controller::get_sync_source)
-        .def("get_sync_sources", &mb_controller::get_sync_sources)
-        .def("set_clock_source_out", &mb_controller::set_clock_source_out)
-        .def("set_time_source_out", &mb_controller::set_time_source_out)
-        .def("get_sensor", &mb_controller::get_sensor)
-        .def("get_sensor_names", &mb_controller::get_sensor_names)
-        .def("get_eeprom", &mb_controller::get_eeprom)
-        .def("synchronize", &mb_controller::synchronize)
-        .def("get_gpio_banks", &mb_controller::get_gpio_banks)
-        .def("get_gpio_srcs", &mb_controller::get_gpio_srcs)
-        .def("get_gpio_src", &mb_controller::get_gpio_src)
-        .def("set_gpio_src", &mb_controller::set_gpio_src);
+            py::overload_cast<const uhd::device_addr_t&>(&mb_controller::set_sync_source),
+            release_gil())
+        .def("get_sync_source", &mb_controller::get_sync_source, release_gil())
+        .def("get_sync_sources", &mb_controller::get_sync_sources, release_gil())
+        .def("set_clock_source_out", &mb_controller::set_clock_source_out, release_gil())
+        .def("set_time_source_out", &mb_controller::set_time_source_out, release_gil())
+        .def("get_sensor", &mb_controller::get_sensor, release_gil())
+        .def("get_sensor_names", &mb_controller::get_sensor_names, release_gil())
+        .def("get_eeprom", &mb_controller::get_eeprom, release_gil())
+        .def("synchronize", &mb_controller::synchronize, release_gil())
+        .def("get_gpio_banks", &mb_controller::get_gpio_banks, release_gil())
+        .def("get_gpio_srcs", &mb_controller::get_gpio_srcs, release_gil())
+        .def("get_gpio_src", &mb_controller::get_gpio_src, release_gil())
+        .def("set_gpio_src", &mb_controller::set_gpio_src, release_gil());
 
     py::class_<timekeeper, PyTimekeeper, timekeeper::sptr>(m, "timekeeper")
         // Methods
-        // FIXME? .def(py::init<>())
-        .def("get_time_now", &timekeeper::get_time_now)
-        .def("get_ticks_now", &timekeeper::get_ticks_now)
-        .def("get_time_last_pps", &timekeeper::get_time_last_pps)
-        .def("get_ticks_last_pps", &timekeeper::get_ticks_last_pps)
-        .def("set_time_now", &timekeeper::set_time_now)
-        .def("set_ticks_now", &timekeeper::set_ticks_now)
-        .def("set_time_next_pps", &timekeeper::set_time_next_pps)
-        .def("set_ticks_next_pps", &timekeeper::set_ticks_next_pps)
-        .def("get_tick_rate", &timekeeper::get_tick_rate);
+        // FIXME? .def(py::init<>(), release_gil())
+        .def("get_time_now", &timekeeper::get_time_now, release_gil())
+        .def("get_ticks_now", &timekeeper::get_ticks_now, release_gil())
+        .def("get_time_last_pps", &timekeeper::get_time_last_pps, release_gil())
+        .def("get_ticks_last_pps", &timekeeper::get_ticks_last_pps, release_gil())
+        .def("set_time_now", &timekeeper::set_time_now, release_gil())
+        .def("set_ticks_now", &timekeeper::set_ticks_now, release_gil())
+        .def("set_time_next_pps", &timekeeper::set_time_next_pps, release_gil())
+        .def("set_ticks_next_pps", &timekeeper::set_ticks_next_pps, release_gil())
+        .def("get_tick_rate", &timekeeper::get_tick_rate, release_gil())
+        .def("get_time_estimate",
+            py::overload_cast<>(&timekeeper::get_time_estimate),
+            release_gil())
+        .def("has_time_estimate", &timekeeper::has_time_estimate, release_gil());
 
     py::class_<noc_block_base, noc_block_base::sptr>(m, "noc_block_base")
-        .def("get_unique_id", &noc_block_base::get_unique_id)
-        .def("get_num_input_ports", &noc_block_base::get_num_input_ports)
-        .def("get_num_output_ports", &noc_block_base::get_num_output_ports)
-        .def("get_noc_id", &noc_block_base::get_noc_id)
-        .def("get_block_id", &noc_block_base::get_block_id)
-        .def("get_tick_rate", &noc_block_base::get_tick_rate)
-        .def("get_mtu", &noc_block_base::get_mtu)
-        .def("get_block_args", &noc_block_base::get_block_args)
+        .def("get_unique_id", &noc_block_base::get_unique_id, release_gil())
+        .def("get_num_input_ports", &noc_block_base::get_num_input_ports, release_gil())
+        .def("get_num_output_ports", &noc_block_base::get_num_output_ports, release_gil())
+        .def("get_noc_id", &noc_block_base::get_noc_id, release_gil())
+        .def("get_block_id", &noc_block_base::get_block_id, release_gil())
+        .def("get_tick_rate", &noc_block_base::get_tick_rate, release_gil())
+        .def("get_mtu", &noc_block_base::get_mtu, release_gil())
+        .def("get_block_args", &noc_block_base::get_block_args, release_gil())
         .def("get_tree",
             [](noc_block_base::sptr& self) {
                 // Force the non-const `get_tree`
                 uhd::property_tree::sptr tree = self->get_tree();
                 return tree;
-            })
+            },
+            release_gil())
         .def("poke32",
             [](noc_block_base::sptr& self, uint32_t addr, uint32_t data) {
                 self->regs().poke32(addr, data);
             },
             py::arg("addr"),
-            py::arg("data"))
+            py::arg("data"),
+            release_gil())
         .def("poke32",
             [](noc_block_base::sptr& self,
                 uint32_t addr,
@@ -295,13 +338,15 @@ void export_rfnoc(py::module& m)
             py::arg("addr"),
             py::arg("data"),
             py::arg("time"),
-            py::arg("ack") = false)
+            py::arg("ack") = false,
+            release_gil())
         .def("poke64",
             [](noc_block_base::sptr& self, uint32_t addr, uint64_t data) {
                 self->regs().poke64(addr, data);
             },
             py::arg("addr"),
-            py::arg("data"))
+            py::arg("data"),
+            release_gil())
         .def("poke64",
             [](noc_block_base::sptr& self,
                 uint32_t addr,
@@ -311,13 +356,15 @@ void export_rfnoc(py::module& m)
             py::arg("addr"),
             py::arg("data"),
             py::arg("time"),
-            py::arg("ack") = false)
+            py::arg("ack") = false,
+            release_gil())
         .def("multi_poke32",
             [](noc_block_base::sptr& self,
                 std::vector<uint32_t> addr,
                 std::vector<uint32_t> data) { self->regs().multi_poke32(addr, data); },
             py::arg("addr"),
-            py::arg("data"))
+            py::arg("data"),
+            release_gil())
         .def("multi_poke32",
             [](noc_block_base::sptr& self,
                 std::vector<uint32_t> addr,
@@ -327,7 +374,8 @@ void export_rfnoc(py::module& m)
             py::arg("addr"),
             py::arg("data"),
             py::arg("time"),
-            py::arg("ack") = false)
+            py::arg("ack") = false,
+            release_gil())
         .def("block_poke32",
             [](noc_block_base::sptr& self,
                 uint32_t first_addr,
@@ -335,7 +383,8 @@ void export_rfnoc(py::module& m)
                 self->regs().block_poke32(first_addr, data);
             },
             py::arg("first_addr"),
-            py::arg("data"))
+            py::arg("data"),
+            release_gil())
         .def("block_poke32",
             [](noc_block_base::sptr& self,
                 uint32_t first_addr,
@@ -347,35 +396,41 @@ void export_rfnoc(py::module& m)
             py::arg("first_addr"),
             py::arg("data"),
             py::arg("time"),
-            py::arg("ack") = false)
+            py::arg("ack") = false,
+            release_gil())
         .def("peek32",
             [](noc_block_base::sptr& self, uint32_t addr) {
                 return self->regs().peek32(addr);
             },
-            py::arg("addr"))
+            py::arg("addr"),
+            release_gil())
         .def("peek32",
             [](noc_block_base::sptr& self, uint32_t addr, uhd::time_spec_t time) {
                 return self->regs().peek32(addr, time);
             },
             py::arg("addr"),
-            py::arg("time"))
+            py::arg("time"),
+            release_gil())
         .def("peek64",
             [](noc_block_base::sptr& self, uint32_t addr) {
                 return self->regs().peek64(addr);
             },
-            py::arg("addr"))
+            py::arg("addr"),
+            release_gil())
         .def("peek64",
             [](noc_block_base::sptr& self, uint32_t addr, uhd::time_spec_t time) {
                 return self->regs().peek64(addr, time);
             },
             py::arg("addr"),
-            py::arg("time"))
+            py::arg("time"),
+            release_gil())
         .def("block_peek32",
             [](noc_block_base::sptr& self, uint32_t first_addr, size_t length) {
                 return self->regs().block_peek32(first_addr, length);
             },
             py::arg("first_addr"),
-            py::arg("length"))
+            py::arg("length"),
+            release_gil())
         .def("block_peek32",
             [](noc_block_base::sptr& self,
                 uint32_t first_addr,
@@ -385,7 +440,41 @@ void export_rfnoc(py::module& m)
             },
             py::arg("first_addr"),
             py::arg("length"),
-            py::arg("time"))
+            py::arg("time"),
+            release_gil())
+        .def("multi_peek32",
+            [](noc_block_base::sptr& self, const std::vector<uint32_t>& addrs) {
+                return self->regs().multi_peek32(addrs);
+            },
+            py::arg("addrs"),
+            release_gil())
+        .def("multi_peek32",
+            [](noc_block_base::sptr& self,
+                const std::vector<uint32_t>& addrs,
+                uhd::time_spec_t time) { return self->regs().multi_peek32(addrs, time); },
+            py::arg("addrs"),
+            py::arg("time"),
+            release_gil())
+        // The async transactions are pipelined: Many of them can be in flight
+        // at the same time
+        .def("poke32_async",
+            [](noc_block_base::sptr& self,
+                uint32_t addr,
+                uint32_t data,
+                uhd::time_spec_t time) {
+                return py_future<void>(self->regs().poke32_async(addr, data, time));
+            },
+            py::arg("addr"),
+            py::arg("data"),
+            py::arg("time") = uhd::time_spec_t::ASAP,
+            release_gil())
+        .def("peek32_async",
+            [](noc_block_base::sptr& self, uint32_t addr, uhd::time_spec_t time) {
+                return py_future<uint32_t>(self->regs().peek32_async(addr, time));
+            },
+            py::arg("addr"),
+            py::arg("time") = uhd::time_spec_t::ASAP,
+            release_gil())
         .def("poll32",
             [](noc_block_base::sptr& self,
                 uint32_t addr,
@@ -397,7 +486,8 @@ void export_rfnoc(py::module& m)
             py::arg("addr"),
             py::arg("data"),
             py::arg("mask"),
-            py::arg("timeout"))
+            py::arg("timeout"),
+            release_gil())
         .def("poll32",
             [](noc_block_base::sptr& self,
                 uint32_t addr,
@@ -413,18 +503,20 @@ void export_rfnoc(py::module& m)
             py::arg("mask"),
             py::arg("timeout"),
             py::arg("time"),
-            py::arg("ack") = false)
+            py::arg("ack") = false,
+            release_gil())
         .def("__repr__",
             [](noc_block_base::sptr& self) {
                 return "<NocBlock for block ID '" + self->get_unique_id() + "'>";
             })
         // node_t superclass methods--not worth having a separate Py class
         // for them
-        .def("get_property_ids", &node_t::get_property_ids)
+        .def("get_property_ids", &node_t::get_property_ids, release_gil())
         .def("set_properties",
             &node_t::set_properties,
             py::arg("props"),
-            py::arg("instance") = 0);
+            py::arg("instance") = 0,
+            release_gil());
 }
 
 #endif /* INCLUDED_UHD_RFNOC_PYTHON_HPP */
@@ -4,9 +4,13 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include <uhd/convert.hpp>
 #include <uhd/rfnoc/defaults.hpp>
+#include <uhd/utils/realtime.hpp>
+#include <uhd/utils/safe_call.hpp>
 #include <uhdlib/rfnoc/node_accessor.hpp>
 #include <uhdlib/rfnoc/rfnoc_rx_streamer.hpp>
+#include <uhdlib/usrp/common/latency_mode.hpp>
 #include <atomic>
 #include <thread>
 
@@ -25,8 +29,18 @@ rfnoc_rx_streamer::rfnoc_rx_streamer(const size_t num_chans,
     , _unique_id(STREAMER_ID + "#" + std::to_string(streamer_inst_ctr++))
     , _stream_args(stream_args)
     , _disconnect_cb(disconnect_cb)
+    , _xports(num_chans, nullptr)
+    , _fast_overrun_recovery(
+          stream_args.args.cast<bool>("fast_overrun_recovery", false))
 {
     set_overrun_handler([this]() { this->_handle_overrun(); });
+    set_report_gaps(_fast_overrun_recovery);
+
+    // Inline I/O runs in the thread that calls recv(), which usually is the one
+    // that creates the streamer
+    uhd::usrp::setup_latency_mode_thread(
+        uhd::usrp::read_latency_mode_args(stream_args.args));
+    uhd::setup_realtime_thread(uhd::thread_role_t::STREAMER);
 
     // No block to which to forward properties or actions
     set_prop_forwarding_policy(forwarding_policy_t::DROP);
@@ -42,6 +56,16 @@ rfnoc_rx_streamer::rfnoc_rx_streamer(const size_t num_chans,
             }
             _handle_rx_event_action(src, rx_event_action);
         });
+    register_action_handler(ACTION_KEY_RX_TAG,
+        [this](const res_source_info& src, action_info::sptr action) {
+            rx_tag_action_info::sptr rx_tag_action =
+                std::dynamic_pointer_cast<rx_tag_action_info>(action);
+            if (!rx_tag_action) {
+                RFNOC_LOG_WARNING("Received invalid RX tag action!");
+                return;
+            }
+            add_rx_tag(src.instance, rx_tag_action->type, rx_tag_action->tsf);
+        });
     register_action_handler(ACTION_KEY_STREAM_CMD,
         [this](const res_source_info& src, action_info::sptr action) {
             stream_cmd_action_info::sptr stream_cmd_action =
@@ -94,6 +118,18 @@ rfnoc_rx_streamer::rfnoc_rx_streamer(const size_t num_chans,
 
 rfnoc_rx_streamer::~rfnoc_rx_streamer()
 {
+    // The transports may be reused, and must not call back into this streamer
+    _push_enabled = false;
+    UHD_SAFE_CALL(set_recv_ready_callback({});)
+    if (_xport_release_cb) {
+        for (size_t chan = 0; chan < _xports.size(); chan++) {
+            if (!_xports[chan]) {
+                continue;
+            }
+            _xports[chan] = nullptr;
+            _xport_release_cb(chan, disconnect_channel(chan));
+        }
+    }
     if (_disconnect_cb) {
         _disconnect_cb(_unique_id);
     }
@@ -167,9 +203,138 @@ void rfnoc_rx_streamer::connect_channel(
     const size_t mtu = xport->get_max_payload_size();
     set_property<size_t>(PROP_KEY_MTU, mtu, {res_source_info::INPUT_EDGE, channel});
 
+    _xports[channel] = xport.get();
     rx_streamer_impl<chdr_rx_data_xport>::connect_channel(channel, std::move(xport));
 }
 
+void rfnoc_rx_streamer::set_xport_release_cb(xport_release_fn_t release_cb)
+{
+    _xport_release_cb = std::move(release_cb);
+}
+
+uhd::streamer_stats_t rfnoc_rx_streamer::get_stats() const
+{
+    uhd::streamer_stats_t stats = rx_streamer_impl<chdr_rx_data_xport>::get_stats();
+    for (size_t i = 0; i < _xports.size() && i < stats.chans.size(); i++) {
+        if (_xports[i]) {
+            stats.chans[i].recv_queue_hwm = _xports[i]->get_recv_queue_hwm();
+        }
+    }
+    return stats;
+}
+
+void rfnoc_rx_streamer::set_recv_ready_callback(recv_ready_callback_t callback)
+{
+    if (!callback) {
+        for (auto xport : _xports) {
+            if (xport) {
+                xport->set_ready_callback({});
+            }
+        }
+        return;
+    }
+    for (size_t chan = 0; chan < _xports.size(); chan++) {
+        if (_xports[chan] && !_xports[chan]->set_ready_callback(callback)) {
+            // Don't leave the channels that did accept it half set up
+            for (size_t i = 0; i < chan; i++) {
+                if (_xports[i]) {
+                    _xports[i]->set_ready_callback({});
+                }
+            }
+            throw uhd::not_implemented_error(
+                "This rx streamer can only notify about received packets if they "
+                "are received by an I/O thread (see the recv_offload stream arg)");
+        }
+    }
+}
+
+void rfnoc_rx_streamer::set_recv_packet_callback(
+    recv_packet_callback_t callback, const bool raw)
+{
+    // Stop pushing first, so the state can be changed without racing the
+    // I/O threads
+    _push_enabled = false;
+    set_recv_ready_callback({});
+    std::lock_guard<std::mutex> l(_push_mutex);
+    _push_cb = std::move(callback);
+    if (!_push_cb) {
+        return;
+    }
+
+    _push_raw = raw;
+    if (!raw) {
+        const bool interleave = _stream_args.args.cast<bool>("interleave", false);
+        const size_t num_buffs = interleave ? 1 : get_num_channels();
+        const size_t buff_size =
+            get_max_num_samps() * convert::get_bytes_per_item(_stream_args.cpu_format)
+            * (interleave ? get_num_channels() : 1);
+        _push_buffs.assign(num_buffs, std::vector<char>(buff_size));
+        _push_buff_ptrs.clear();
+        _push_out.clear();
+        for (auto& buff : _push_buffs) {
+            _push_buff_ptrs.push_back(buff.data());
+            _push_out.push_back(buff.data());
+        }
+    }
+
+    try {
+        set_recv_ready_callback([this]() { _push_packets(); });
+    } catch (...) {
+        _push_cb = nullptr;
+        throw;
+    }
+    _push_enabled = true;
+}
+
+void rfnoc_rx_streamer::_push_packets()
+{
+    _push_pending = true;
+    do {
+        std::unique_lock<std::mutex> l(_push_mutex, std::try_to_lock);
+        if (!l.owns_lock()) {
+            // Whoever holds the lock sees the pending flag, and pushes for us
+            return;
+        }
+        while (_push_pending.exchange(false)) {
+            if (_push_cb) {
+                _push_queued_packets();
+            }
+        }
+        // A notification that came in after the last check, but before the
+        // unlock, could not take the lock either
+    } while (_push_pending);
+}
+
+void rfnoc_rx_streamer::_push_queued_packets()
+{
+    // This runs on a thread that UHD owns (usually an I/O thread), so nothing
+    // may escape from here
+    try {
+        const size_t max_samps = get_max_num_samps();
+        while (true) {
+            rx_metadata_t md;
+            const size_t nsamps =
+                _push_raw ? recv_zero_copy(_push_out, md, 0.0)
+                          : recv(_push_buff_ptrs, max_samps, md, 0.0, true);
+            if (md.error_code == rx_metadata_t::ERROR_CODE_TIMEOUT) {
+                return;
+            }
+            try {
+                _push_cb(_push_out, nsamps, md);
+            } catch (const std::exception& ex) {
+                RFNOC_LOG_ERROR("Exception in the RX packet callback: " << ex.what());
+            } catch (...) {
+                RFNOC_LOG_ERROR("Unknown exception in the RX packet callback");
+            }
+            if (_push_raw) {
+                release_recv_buffs();
+            }
+        }
+    } catch (const std::exception& ex) {
+        RFNOC_LOG_ERROR("Failed to receive for the RX packet callback: " << ex.what());
+    }
+}
+
 void rfnoc_rx_streamer::_register_props(const size_t chan, const std::string& otw_format)
 {
     // Create actual properties and store them
@@ -248,14 +413,29 @@ void rfnoc_rx_streamer::_handle_rx_event_action(
             // flag before setting the stopped due to overrun status below to
             // avoid a potential race condition with the overrun handler.
             _overrun_handling_mode = false;
+        } else if (_fast_overrun_recovery) {
+            // Restart right away. The data buffered prior to the overrun stays
+            // where it is, and the streamer reports the gap in the timestamps
+            // when the user reaches it.
+            RFNOC_LOG_TRACE("Restarting without waiting for the streamer to drain");
+            _handle_overrun();
+            return;
         }
         // Tell the streamer to flag an overrun to the user after the data that
         // was buffered prior to the overrun is read.
         set_stopped_due_to_overrun();
+        // No more packets will come in to trigger the callback, so it needs
+        // to be pushed from here
+        if (_push_enabled) {
+            _push_packets();
+        }
     } else if (rx_event_action->error_code
                == uhd::rx_metadata_t::ERROR_CODE_LATE_COMMAND) {
         RFNOC_LOG_DEBUG("Received late command message on port " << src.instance);
         set_stopped_due_to_late_command();
+        if (_push_enabled) {
+            _push_packets();
+        }
     }
 }
 
@@ -4,9 +4,14 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include <uhd/exception.hpp>
 #include <uhd/rfnoc/defaults.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/realtime.hpp>
+#include <uhd/utils/safe_call.hpp>
 #include <uhdlib/rfnoc/node_accessor.hpp>
 #include <uhdlib/rfnoc/rfnoc_tx_streamer.hpp>
+#include <uhdlib/usrp/common/latency_mode.hpp>
 #include <atomic>
 
 using namespace uhd;
@@ -16,6 +21,8 @@ const std::string STREAMER_ID = "TxStreamer";
 static std::atomic<uint64_t> streamer_inst_ctr;
 static constexpr size_t ASYNC_MSG_QUEUE_SIZE = 1000;
 
+constexpr char rfnoc_tx_streamer::LATE_DROP_MARGIN_KEY[];
+
 rfnoc_tx_streamer::rfnoc_tx_streamer(const size_t num_chans,
     const uhd::stream_args_t stream_args,
     disconnect_fn_t disconnect_cb)
@@ -23,9 +30,16 @@ rfnoc_tx_streamer::rfnoc_tx_streamer(const size_t num_chans,
     , _unique_id(STREAMER_ID + "#" + std::to_string(streamer_inst_ctr++))
     , _stream_args(stream_args)
     , _disconnect_cb(disconnect_cb)
+    , _xports(num_chans, nullptr)
 {
     _async_msg_queue = std::make_shared<tx_async_msg_queue>(ASYNC_MSG_QUEUE_SIZE);
 
+    // Inline I/O runs in the thread that calls send(), which usually is the one
+    // that creates the streamer
+    uhd::usrp::setup_latency_mode_thread(
+        uhd::usrp::read_latency_mode_args(stream_args.args));
+    uhd::setup_realtime_thread(uhd::thread_role_t::STREAMER);
+
     // No block to which to forward properties or actions
     set_prop_forwarding_policy(forwarding_policy_t::DROP);
     set_action_forwarding_policy(forwarding_policy_t::DROP);
@@ -82,6 +96,8 @@ rfnoc_tx_streamer::rfnoc_tx_streamer(const size_t num_chans,
 
 rfnoc_tx_streamer::~rfnoc_tx_streamer()
 {
+    UHD_SAFE_CALL(stop_cyclic(0.1);)
+    UHD_SAFE_CALL(set_send_ready_callback({});)
     if (_disconnect_cb) {
         _disconnect_cb(_unique_id);
     }
@@ -143,6 +159,7 @@ void rfnoc_tx_streamer::connect_channel(
             this->_async_msg_queue->enqueue(md);
         });
 
+    _xports[channel] = xport.get();
     tx_streamer_impl<chdr_tx_data_xport>::connect_channel(channel, std::move(xport));
 }
 
@@ -153,6 +170,70 @@ bool rfnoc_tx_streamer::recv_async_msg(
     return _async_msg_queue->recv_async_msg(async_metadata, timeout_ms);
 }
 
+void rfnoc_tx_streamer::set_async_msg_callback(async_msg_callback_t callback)
+{
+    _async_msg_queue->set_callback(std::move(callback));
+}
+
+void rfnoc_tx_streamer::set_send_ready_callback(send_ready_callback_t callback)
+{
+    if (!callback) {
+        for (auto xport : _xports) {
+            if (xport) {
+                xport->set_ready_callback({});
+            }
+        }
+        return;
+    }
+    for (size_t chan = 0; chan < _xports.size(); chan++) {
+        if (_xports[chan] && !_xports[chan]->set_ready_callback(callback)) {
+            for (size_t i = 0; i < chan; i++) {
+                if (_xports[i]) {
+                    _xports[i]->set_ready_callback({});
+                }
+            }
+            throw uhd::not_implemented_error(
+                "This tx streamer can only notify about free send buffers if the "
+                "packets are sent by an I/O thread (see the send_offload stream arg)");
+        }
+    }
+}
+
+void rfnoc_tx_streamer::set_timekeeper(mb_controller::timekeeper::sptr timekeeper)
+{
+    if (!_stream_args.args.has_key(LATE_DROP_MARGIN_KEY)) {
+        return;
+    }
+    const double margin = _stream_args.args.cast<double>(LATE_DROP_MARGIN_KEY, 0.0);
+    // The streamer may outlive the graph, and with it the timekeeper
+    std::weak_ptr<mb_controller::timekeeper> tk_wptr = timekeeper;
+    set_late_burst_drop(
+        [tk_wptr]() -> boost::optional<uhd::time_spec_t> {
+            auto tk = tk_wptr.lock();
+            if (!tk || !tk->has_time_estimate()) {
+                return boost::none;
+            }
+            try {
+                return tk->get_time_estimate();
+            } catch (const uhd::runtime_error&) {
+                // The time was set in the meantime
+                return boost::none;
+            }
+        },
+        margin,
+        [this](const uhd::time_spec_t& time) {
+            UHD_LOG_FASTPATH("L");
+            for (size_t chan = 0; chan < get_num_channels(); chan++) {
+                async_metadata_t md;
+                md.channel       = chan;
+                md.event_code    = async_metadata_t::EVENT_CODE_TIME_ERROR;
+                md.has_time_spec = true;
+                md.time_spec     = time;
+                _async_msg_queue->enqueue(md);
+            }
+        });
+}
+
 void rfnoc_tx_streamer::_register_props(const size_t chan, const std::string& otw_format)
 {
     // Create actual properties and store them
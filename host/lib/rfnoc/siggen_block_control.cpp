@@ -12,6 +12,7 @@
 #include <uhd/rfnoc/registry.hpp>
 #include <uhd/rfnoc/siggen_block_control.hpp>
 #include <uhd/utils/math.hpp>
+#include <uhd/utils/scope_exit.hpp>
 #include <uhdlib/utils/narrow.hpp>
 #include <limits>
 #include <string>
@@ -45,6 +46,87 @@ const T clamp(const double v)
     constexpr T max_t = std::numeric_limits<T>::max();
     return (v < min_t) ? min_t : (v > max_t) ? max_t : T(v);
 }
+
+// The CORDIC IP scales the value written to the Cartesian coordinate register
+// (i.e., the phasor that is rotated to generate the sinusoid) by this value, so
+// we pre-scale the input value before writing. See the comment in the
+// rfnoc_block_siggen_regs.vh header file for the derivation of this value.
+constexpr double CORDIC_SCALE_VALUE = 1.164435344782938;
+
+void check_waveform(const int waveform_val)
+{
+    const int low_limit  = static_cast<int>(siggen_waveform::CONSTANT);
+    const int high_limit = static_cast<int>(siggen_waveform::NOISE);
+    if (waveform_val < low_limit || waveform_val > high_limit) {
+        throw uhd::value_error("Waveform value must be in [" + std::to_string(low_limit)
+                               + ", " + std::to_string(high_limit) + "]");
+    }
+}
+
+void check_amplitude(const double amplitude)
+{
+    if (amplitude < 0.0 || amplitude > 1.0) {
+        throw uhd::value_error("Amplitude value must be in [0.0, 1.0]");
+    }
+}
+
+void check_constant_i(const double constant_i)
+{
+    if (constant_i < -1.0 || constant_i > 1.0) {
+        throw uhd::value_error("Constant real value must be in [-1.0, 1.0]");
+    }
+}
+
+void check_constant_q(const double constant_q)
+{
+    if (constant_q < -1.0 || constant_q > 1.0) {
+        throw uhd::value_error("Constant imaginary value must be in [-1.0, 1.0]");
+    }
+}
+
+void check_phase_inc(const double phase_inc)
+{
+    if (phase_inc < (-uhd::math::PI) || phase_inc > (uhd::math::PI)) {
+        throw uhd::value_error("Phase increment value must be in [-pi, pi]");
+    }
+}
+
+uint32_t get_gain_reg_value(const double gain)
+{
+    const int16_t gain_fp = clamp<int16_t>(gain * 32768.0);
+    return uint32_t(gain_fp);
+}
+
+uint32_t get_constant_reg_value(const std::complex<double> constant)
+{
+    const int16_t constant_i_fp = clamp<int16_t>(constant.real() * 32768.0);
+    const int16_t constant_q_fp = clamp<int16_t>(constant.imag() * 32768.0);
+    return (uint32_t(constant_i_fp) << 16) | (uint32_t(constant_q_fp) & 0xffff);
+}
+
+uint32_t get_phase_inc_reg_value(const double phase_inc)
+{
+    const int16_t phase_inc_scaled_rads_fp =
+        clamp<int16_t>((phase_inc / uhd::math::PI) * 8192.0);
+    return phase_inc_scaled_rads_fp & 0xffff;
+}
+
+uint32_t get_cartesian_reg_value(const double amplitude)
+{
+    // The rotator that rotates the phasor to generate the sinusoidal
+    // data has an initial phase offset which is impossible to predict.
+    // Thus, the Cartesian parameter is largely immaterial, as long as
+    // the phasor's amplitude matchines with the client has specified.
+    // For simplicity, the Cartesian parameter is chosen to have a real
+    // (X) component of 0.0 and an imaginary (Y) component of the desired
+    // amplitude.
+    const int16_t cartesian_i_fp = clamp<int16_t>(amplitude * 32767.0);
+
+    // Bits 31:16 represent the imaginary component (the pre-scaled
+    // fixed point amplitude), while bits 15:0 represents the real
+    // component (which are zeroed).
+    return (uint32_t(cartesian_i_fp) << 16);
+}
 } // namespace
 
 class siggen_block_control_impl : public siggen_block_control
@@ -118,6 +200,51 @@ public:
         return _prop_spp.at(port).get();
     }
 
+    void set_config(const siggen_config_t& config, const size_t port)
+    {
+        // Check everything first, so an invalid setting doesn't leave the
+        // port with only some of the settings changed
+        check_waveform(static_cast<int>(config.waveform));
+        check_amplitude(config.amplitude);
+        check_constant_i(config.constant.real());
+        check_constant_q(config.constant.imag());
+        check_phase_inc(config.phase_inc);
+
+        {
+            // Update the properties, but hold back the register writes
+            _hold_regs   = true;
+            auto release = uhd::utils::scope_exit::make([this]() { _hold_regs = false; });
+            set_property<int>(
+                PROP_KEY_WAVEFORM, static_cast<int>(config.waveform), port);
+            set_property<double>(PROP_KEY_AMPLITUDE, config.amplitude, port);
+            set_property<double>(PROP_KEY_CONSTANT_I, config.constant.real(), port);
+            set_property<double>(PROP_KEY_CONSTANT_Q, config.constant.imag(), port);
+            set_property<double>(PROP_KEY_SINE_PHASE_INC, config.phase_inc, port);
+        }
+
+        // The waveform, gain, constant, phase increment and Cartesian
+        // registers are consecutive, so they are written in one block write
+        const siggen_waveform waveform = get_waveform(port);
+        const double amplitude         = get_amplitude(port);
+        _siggen_reg_iface.block_poke32(REG_WAVEFORM_OFFSET,
+            {static_cast<uint32_t>(waveform),
+                get_gain_reg_value(waveform == siggen_waveform::NOISE ? amplitude : 1.0),
+                get_constant_reg_value(get_constant(port)),
+                get_phase_inc_reg_value(get_sine_phase_increment(port)),
+                get_cartesian_reg_value(amplitude / CORDIC_SCALE_VALUE)},
+            port);
+    }
+
+    siggen_config_t get_config(const size_t port) const
+    {
+        siggen_config_t config;
+        config.waveform  = get_waveform(port);
+        config.amplitude = get_amplitude(port);
+        config.constant  = get_constant(port);
+        config.phase_inc = get_sine_phase_increment(port);
+        return config;
+    }
+
     /**************************************************************************
      * Initialization
      *************************************************************************/
@@ -165,30 +292,20 @@ private:
             register_property(&_prop_waveform.back());
             register_property(&_prop_amplitude.back());
             register_property(&_prop_constant_i.back(), [this, port]() {
-                const double constant_i = _prop_constant_i.at(port).get();
-                if (constant_i < -1.0 || constant_i > 1.0) {
-                    throw uhd::value_error("Constant real value must be in [-1.0, 1.0]");
-                }
+                check_constant_i(_prop_constant_i.at(port).get());
                 _set_constant_register(port);
             });
             register_property(&_prop_constant_q.back(), [this, port]() {
-                const double constant_q = _prop_constant_q.at(port).get();
-                if (constant_q < -1.0 || constant_q > 1.0) {
-                    throw uhd::value_error(
-                        "Constant imaginary value must be in [-1.0, 1.0]");
-                }
+                check_constant_q(_prop_constant_q.at(port).get());
                 _set_constant_register(port);
             });
             register_property(&_prop_phase_inc.back(), [this, port]() {
                 const double phase_inc = _prop_phase_inc.at(port).get();
-                if (phase_inc < (-uhd::math::PI) || phase_inc > (uhd::math::PI)) {
-                    throw uhd::value_error(
-                        "Phase increment value must be in [-pi, pi]");
+                check_phase_inc(phase_inc);
+                if (!_hold_regs) {
+                    _siggen_reg_iface.poke32(
+                        REG_PHASE_INC_OFFSET, get_phase_inc_reg_value(phase_inc), port);
                 }
-                const int16_t phase_inc_scaled_rads_fp =
-                    clamp<int16_t>((phase_inc / uhd::math::PI) * 8192.0);
-                _siggen_reg_iface.poke32(
-                    REG_PHASE_INC_OFFSET, phase_inc_scaled_rads_fp & 0xffff, port);
             });
             register_property(&_prop_spp.back(), [this, port]() {
                 const uint32_t spp = _prop_spp.at(port).get();
@@ -204,16 +321,18 @@ private:
                     // If either are out of range, throw an exception and
                     // do not set any registers.
                     const int waveform_val = _prop_waveform.at(port).get();
-                    const int low_limit    = static_cast<int>(siggen_waveform::CONSTANT);
-                    const int high_limit   = static_cast<int>(siggen_waveform::NOISE);
-                    if (waveform_val < low_limit || waveform_val > high_limit) {
-                        throw uhd::value_error("Waveform value must be in ["
-                                               + std::to_string(low_limit) + ", "
-                                               + std::to_string(high_limit) + "]");
-                    }
+                    check_waveform(waveform_val);
                     const double amplitude = _prop_amplitude.at(port).get();
-                    if (amplitude < 0.0 || amplitude > 1.0) {
-                        throw uhd::value_error("Amplitude value must be in [0.0, 1.0]");
+                    check_amplitude(amplitude);
+
+                    // The amplitude is fixed at 1 in constant mode.
+                    siggen_waveform waveform = static_cast<siggen_waveform>(waveform_val);
+                    if (waveform == siggen_waveform::CONSTANT) {
+                        _prop_amplitude.at(port).set(1.0);
+                    }
+                    // set_config() writes all registers at once
+                    if (_hold_regs) {
+                        return;
                     }
 
                     // Set the waveform register appropriately.
@@ -221,28 +340,16 @@ private:
 
                     // Now set the other registers based on the waveform and
                     // the desired amplitude.
-                    siggen_waveform waveform = static_cast<siggen_waveform>(waveform_val);
                     switch (waveform) {
                         case siggen_waveform::CONSTANT:
-                            // The amplitude is fixed at 1 in constant mode.
-                            _prop_amplitude.at(port).set(1.0);
                             _set_gain_register(1.0, port);
                             break;
-                        case siggen_waveform::SINE_WAVE: {
+                        case siggen_waveform::SINE_WAVE:
                             // Set the phasor to the appropriate amplitude value and
                             // fix the gain to 1.
-
-                            // The CORDIC IP scales the value written to the Cartesian
-                            // coordinate register (i.e., the phasor that is rotated to
-                            // generate the sinusoid) by this value, so we pre-scale the
-                            // input value before writing. See the comment in the
-                            // rfnoc_block_siggen_regs.vh header file for the derivation
-                            // of this value.
-                            constexpr double cordic_scale_value = 1.164435344782938;
-                            _set_cartesian_register(amplitude / cordic_scale_value, port);
+                            _set_cartesian_register(amplitude / CORDIC_SCALE_VALUE, port);
                             _set_gain_register(1.0, port);
                             break;
-                        }
                         case siggen_waveform::NOISE:
                             // Use the gain register to set the gain of the random noise
                             // signal.
@@ -286,38 +393,22 @@ private:
 
     void _set_constant_register(const size_t port)
     {
-        const int16_t constant_i_fp =
-            clamp<int16_t>(_prop_constant_i.at(port).get() * 32768.0);
-        const int16_t constant_q_fp =
-            clamp<int16_t>(_prop_constant_q.at(port).get() * 32768.0);
-        const uint32_t constant_reg_value = (uint32_t(constant_i_fp) << 16)
-                                      | (uint32_t(constant_q_fp) & 0xffff);
-
-        _siggen_reg_iface.poke32(REG_CONSTANT_OFFSET, constant_reg_value, port);
+        if (_hold_regs) {
+            return;
+        }
+        _siggen_reg_iface.poke32(
+            REG_CONSTANT_OFFSET, get_constant_reg_value(get_constant(port)), port);
     }
 
     void _set_gain_register(const double gain, const size_t port)
     {
-        const int16_t gain_fp = clamp<int16_t>(gain * 32768.0);
-        _siggen_reg_iface.poke32(REG_GAIN_OFFSET, gain_fp, port);
+        _siggen_reg_iface.poke32(REG_GAIN_OFFSET, get_gain_reg_value(gain), port);
     }
 
     void _set_cartesian_register(const double amplitude, const size_t port)
     {
-        // The rotator that rotates the phasor to generate the sinusoidal
-        // data has an initial phase offset which is impossible to predict.
-        // Thus, the Cartesian parameter is largely immaterial, as long as
-        // the phasor's amplitude matchines with the client has specified.
-        // For simplicity, the Cartesian parameter is chosen to have a real
-        // (X) component of 0.0 and an imaginary (Y) component of the desired
-        // amplitude.
-        const int16_t cartesian_i_fp = clamp<int16_t>(amplitude * 32767.0);
-
-        // Bits 31:16 represent the imaginary component (the pre-scaled
-        // fixed point amplitude), while bits 15:0 represents the real
-        // component (which are zeroed).
-        const uint32_t cartesian_reg_value = (uint32_t(cartesian_i_fp) << 16);
-        _siggen_reg_iface.poke32(REG_CARTESIAN_OFFSET, cartesian_reg_value, port);
+        _siggen_reg_iface.poke32(
+            REG_CARTESIAN_OFFSET, get_cartesian_reg_value(amplitude), port);
     }
 
     /**************************************************************************
@@ -332,6 +423,10 @@ private:
     std::vector<property_t<int>> _prop_spp;
     std::vector<property_t<std::string>> _prop_type_out;
 
+    //! Set while set_config() updates the properties, which then don't write
+    // their registers
+    bool _hold_regs = false;
+
     /**************************************************************************
      * Register interface
      *************************************************************************/
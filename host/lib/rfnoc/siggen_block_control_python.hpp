@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "../utils/async_python.hpp"
 #include "block_controller_factory_python.hpp"
 #include <uhd/rfnoc/siggen_block_control.hpp>
 
@@ -22,17 +23,27 @@ void export_siggen_block_control(py::module& m)
     py::class_<siggen_block_control, noc_block_base, siggen_block_control::sptr>(
         m, "siggen_block_control")
         .def(py::init(&block_controller_factory<siggen_block_control>::make_from))
-        .def("set_enable", &siggen_block_control::set_enable)
-        .def("get_enable", &siggen_block_control::get_enable)
-        .def("set_waveform", &siggen_block_control::set_waveform)
-        .def("get_waveform", &siggen_block_control::get_waveform)
-        .def("set_amplitude", &siggen_block_control::set_amplitude)
-        .def("get_amplitude", &siggen_block_control::get_amplitude)
-        .def("set_constant", &siggen_block_control::set_constant)
-        .def("get_constant", &siggen_block_control::get_constant)
-        .def("set_sine_phase_increment", &siggen_block_control::set_sine_phase_increment)
-        .def("get_sine_phase_increment", &siggen_block_control::get_sine_phase_increment)
-        .def("set_sine_frequency", &siggen_block_control::set_sine_frequency)
-        .def("set_samples_per_packet", &siggen_block_control::set_samples_per_packet)
-        .def("get_samples_per_packet", &siggen_block_control::get_samples_per_packet);
+        .def("set_enable", &siggen_block_control::set_enable, release_gil())
+        .def("get_enable", &siggen_block_control::get_enable, release_gil())
+        .def("set_waveform", &siggen_block_control::set_waveform, release_gil())
+        .def("get_waveform", &siggen_block_control::get_waveform, release_gil())
+        .def("set_amplitude", &siggen_block_control::set_amplitude, release_gil())
+        .def("get_amplitude", &siggen_block_control::get_amplitude, release_gil())
+        .def("set_constant", &siggen_block_control::set_constant, release_gil())
+        .def("get_constant", &siggen_block_control::get_constant, release_gil())
+        .def("set_sine_phase_increment",
+            &siggen_block_control::set_sine_phase_increment,
+            release_gil())
+        .def("get_sine_phase_increment",
+            &siggen_block_control::get_sine_phase_increment,
+            release_gil())
+        .def("set_sine_frequency",
+            &siggen_block_control::set_sine_frequency,
+            release_gil())
+        .def("set_samples_per_packet",
+            &siggen_block_control::set_samples_per_packet,
+            release_gil())
+        .def("get_samples_per_packet",
+            &siggen_block_control::get_samples_per_packet,
+            release_gil());
 }
@@ -9,6 +9,8 @@
 #include <uhd/rfnoc/property.hpp>
 #include <uhd/rfnoc/registry.hpp>
 #include <uhd/rfnoc/switchboard_block_control.hpp>
+#include <set>
+#include <string>
 
 using namespace uhd::rfnoc;
 
@@ -27,6 +29,8 @@ public:
     RFNOC_BLOCK_CONSTRUCTOR(switchboard_block_control),
         _num_input_ports(get_num_input_ports()),
         _num_output_ports(get_num_output_ports()),
+        _input_select_reg(_num_output_ports, 0),
+        _output_select_reg(_num_input_ports, 0),
         _switchboard_reg_iface(*this, 0, REG_BLOCK_SIZE)
     {
         UHD_ASSERT_THROW(_num_input_ports > 0 && _num_output_ports > 0);
@@ -44,10 +48,60 @@ public:
     {
         set_property<int>(PROP_KEY_INPUT_SELECT, static_cast<int>(input), output);
         set_property<int>(PROP_KEY_OUTPUT_SELECT, static_cast<int>(output), input);
+        // If select_route() switched away from the properties, setting them to
+        // the same values again doesn't write the registers
+        _write_link(input, output);
 
         _update_forwarding_map();
     }
 
+    size_t add_route(const route_t& route)
+    {
+        std::set<size_t> outputs;
+        for (const auto& link : route) {
+            if (link.first >= _num_input_ports || link.second >= _num_output_ports) {
+                throw uhd::value_error("Invalid switchboard route: Cannot connect input "
+                                       + std::to_string(link.first) + " to output "
+                                       + std::to_string(link.second)
+                                       + ", index out of bounds");
+            }
+            if (!outputs.insert(link.second).second) {
+                throw uhd::value_error(
+                    "Invalid switchboard route: More than one input connects to output "
+                    + std::to_string(link.second));
+            }
+        }
+        _routes.push_back(route);
+        return _routes.size() - 1;
+    }
+
+    void select_route(const size_t route)
+    {
+        if (route >= _routes.size()) {
+            throw uhd::value_error(
+                "Invalid switchboard route index: " + std::to_string(route));
+        }
+        {
+            batch_scope batch(*this);
+            for (const auto& link : _routes[route]) {
+                _write_link(link.first, link.second);
+            }
+        }
+        _update_forwarding_map();
+    }
+
+    route_t get_route() const
+    {
+        route_t route;
+        for (size_t input_port = 0; input_port < _num_input_ports; input_port++) {
+            const size_t output_port = _output_select_reg.at(input_port);
+            if (_input_select_reg.at(output_port) == input_port) {
+                route.insert({input_port, output_port});
+            }
+        }
+        return route;
+    }
+
 private:
     const size_t _num_input_ports;
     const size_t _num_output_ports;
@@ -69,6 +123,7 @@ private:
                     throw uhd::value_error("Index out of bounds");
                 _switchboard_reg_iface.poke32(
                     REG_MUX_SELECT_ADDR, select_val, output_port);
+                _input_select_reg.at(output_port) = select_val;
             });
         }
 
@@ -84,10 +139,26 @@ private:
                     throw uhd::value_error("Index out of bounds");
                 _switchboard_reg_iface.poke32(
                     REG_DEMUX_SELECT_ADDR, select_val, input_port);
+                _output_select_reg.at(input_port) = select_val;
             });
         }
     }
 
+    //! Writes the select registers of a connection, if they differ
+    void _write_link(const size_t input_port, const size_t output_port)
+    {
+        if (_output_select_reg.at(input_port) != output_port) {
+            _switchboard_reg_iface.poke32(
+                REG_DEMUX_SELECT_ADDR, static_cast<uint32_t>(output_port), input_port);
+            _output_select_reg.at(input_port) = output_port;
+        }
+        if (_input_select_reg.at(output_port) != input_port) {
+            _switchboard_reg_iface.poke32(
+                REG_MUX_SELECT_ADDR, static_cast<uint32_t>(input_port), output_port);
+            _input_select_reg.at(output_port) = input_port;
+        }
+    }
+
     void _update_forwarding_map()
     {
         node_t::forwarding_map_t prop_fwd_map;
@@ -96,9 +167,11 @@ private:
         // Property propagation scheme:
         //   Connected inputs and outputs will propagate to each other.
         //   Unconnected inputs and outputs do not propagate.
+        // The select registers are used instead of the properties, because
+        // select_route() doesn't update those.
         for (size_t input_port = 0; input_port < _num_input_ports; input_port++) {
-            size_t linked_output_port = _output_select.at(input_port).get();
-            size_t linked_input_port  = _input_select.at(linked_output_port).get();
+            size_t linked_output_port = _output_select_reg.at(input_port);
+            size_t linked_input_port  = _input_select_reg.at(linked_output_port);
             if (linked_input_port == input_port) {
                 prop_fwd_map.insert({{res_source_info::INPUT_EDGE, linked_input_port},
                     {{res_source_info::OUTPUT_EDGE, linked_output_port}}});
@@ -120,6 +193,13 @@ private:
     std::vector<property_t<int>> _input_select;
     std::vector<property_t<int>> _output_select;
 
+    //! The values written to the select registers, by output and input port
+    std::vector<size_t> _input_select_reg;
+    std::vector<size_t> _output_select_reg;
+
+    //! The routes added with add_route()
+    std::vector<route_t> _routes;
+
     /**************************************************************************
      * Register Interface
      *************************************************************************/
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "../utils/async_python.hpp"
 #include "block_controller_factory_python.hpp"
 #include <uhd/rfnoc/switchboard_block_control.hpp>
 
@@ -17,5 +18,8 @@ void export_switchboard_block_control(py::module& m)
         noc_block_base,
         switchboard_block_control::sptr>(m, "switchboard_block_control")
         .def(py::init(&block_controller_factory<switchboard_block_control>::make_from))
-        .def("connect", &switchboard_block_control::connect);
+        .def("connect", &switchboard_block_control::connect, release_gil())
+        .def("add_route", &switchboard_block_control::add_route, release_gil())
+        .def("select_route", &switchboard_block_control::select_route, release_gil())
+        .def("get_route", &switchboard_block_control::get_route, release_gil());
 }
@@ -0,0 +1,148 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhdlib/rfnoc/time_correlator.hpp>
+#include <algorithm>
+#include <cmath>
+
+using namespace uhd::rfnoc::detail;
+
+constexpr size_t time_correlator::DEFAULT_NUM_SAMPLES;
+constexpr double time_correlator::MAX_ERROR;
+
+namespace {
+
+//! The samples need to span at least this much host time to estimate the drift
+constexpr double MIN_DRIFT_SPAN = 0.01;
+
+double to_secs(const time_correlator::clock_t::duration duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
+
+} // namespace
+
+time_correlator::time_correlator(const size_t num_samples)
+    : _num_samples(std::max<size_t>(num_samples, 1))
+{
+}
+
+void time_correlator::add_sample(const clock_t::time_point before,
+    const clock_t::time_point after,
+    const uhd::time_spec_t& device_time)
+{
+    const clock_t::duration rtt = std::max(after - before, clock_t::duration::zero());
+    const clock_t::time_point host_time = before + rtt / 2;
+
+    std::lock_guard<std::mutex> l(_mutex);
+    if (!_samples.empty()) {
+        const uhd::time_spec_t expected =
+            _device_ref + uhd::time_spec_t(to_secs(host_time - _host_ref) * _rate);
+        if (std::abs((device_time - expected).get_real_secs())
+            > MAX_ERROR + to_secs(rtt) / 2) {
+            UHD_LOG_DEBUG("TIME_CORR",
+                "Device time is off by "
+                    << (device_time - expected).get_real_secs()
+                    << " s, starting over with the time correlation");
+            _samples.clear();
+        }
+    }
+    _samples.push_back(sample_t{host_time, device_time, rtt});
+    if (_samples.size() > _num_samples) {
+        _samples.pop_front();
+    }
+    _fit();
+}
+
+void time_correlator::reset()
+{
+    std::lock_guard<std::mutex> l(_mutex);
+    _samples.clear();
+    _rate = 1.0;
+}
+
+bool time_correlator::is_valid() const
+{
+    std::lock_guard<std::mutex> l(_mutex);
+    return !_samples.empty();
+}
+
+uhd::time_spec_t time_correlator::to_device_time(
+    const clock_t::time_point host_time) const
+{
+    std::lock_guard<std::mutex> l(_mutex);
+    _assert_valid();
+    return _device_ref + uhd::time_spec_t(to_secs(host_time - _host_ref) * _rate);
+}
+
+time_correlator::clock_t::time_point time_correlator::to_host_time(
+    const uhd::time_spec_t& device_time) const
+{
+    std::lock_guard<std::mutex> l(_mutex);
+    _assert_valid();
+    return _host_ref
+           + std::chrono::duration_cast<clock_t::duration>(std::chrono::duration<double>(
+               (device_time - _device_ref).get_real_secs() / _rate));
+}
+
+double time_correlator::get_drift() const
+{
+    std::lock_guard<std::mutex> l(_mutex);
+    return _rate - 1.0;
+}
+
+void time_correlator::_assert_valid() const
+{
+    if (_samples.empty()) {
+        throw uhd::runtime_error("No time correlation samples available!");
+    }
+}
+
+void time_correlator::_fit()
+{
+    // Samples that took much longer to read than the fastest one only make
+    // the estimate worse
+    clock_t::duration min_rtt = _samples.front().rtt;
+    for (const auto& sample : _samples) {
+        min_rtt = std::min(min_rtt, sample.rtt);
+    }
+    const clock_t::duration max_rtt = 2 * min_rtt;
+
+    // Everything is relative to the latest good sample, so the doubles only
+    // need to hold the span of the samples
+    auto ref = std::find_if(_samples.rbegin(), _samples.rend(), [max_rtt](const auto& s) {
+        return s.rtt <= max_rtt;
+    });
+    const clock_t::time_point host_ref   = ref->host_time;
+    const uhd::time_spec_t device_ref    = ref->device_time;
+    double sum_x = 0.0, sum_y = 0.0, sum_xx = 0.0, sum_xy = 0.0;
+    double min_x = 0.0;
+    size_t n     = 0;
+    for (const auto& sample : _samples) {
+        if (sample.rtt > max_rtt) {
+            continue;
+        }
+        const double x = to_secs(sample.host_time - host_ref);
+        const double y = (sample.device_time - device_ref).get_real_secs();
+        sum_x += x;
+        sum_y += y;
+        sum_xx += x * x;
+        sum_xy += x * y;
+        min_x = std::min(min_x, x);
+        n++;
+    }
+    const double mean_x = sum_x / n;
+    const double mean_y = sum_y / n;
+    // Without enough of a time span, the drift can't be told apart from the
+    // jitter of the samples, so we keep the previous estimate
+    if (-min_x >= MIN_DRIFT_SPAN) {
+        _rate = (sum_xy - n * mean_x * mean_y) / (sum_xx - n * mean_x * mean_x);
+    }
+    _host_ref   = host_ref;
+    _device_ref = device_ref + uhd::time_spec_t(mean_y - _rate * mean_x);
+}
@@ -4,46 +4,214 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include <uhd/utils/log.hpp>
 #include <uhdlib/rfnoc/tx_async_msg_queue.hpp>
+#include <uhdlib/utils/trace.hpp>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <thread>
+#ifdef __linux__
+#    include <poll.h>
+#    include <sys/eventfd.h>
+#    include <unistd.h>
+#    include <cerrno>
+#endif
 
 using namespace uhd;
 using namespace uhd::rfnoc;
 
-tx_async_msg_queue::tx_async_msg_queue(size_t capacity) : _queue(capacity) {}
+namespace {
+
+size_t round_up_to_pow2(const size_t capacity)
+{
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    return size;
+}
+
+} // namespace
+
+tx_async_msg_queue::tx_async_msg_queue(size_t capacity)
+    : _cells(new cell_t[round_up_to_pow2(capacity)])
+    , _mask(round_up_to_pow2(capacity) - 1)
+{
+    for (size_t i = 0; i <= _mask; i++) {
+        _cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+#ifdef __linux__
+    _event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_event_fd < 0) {
+        UHD_LOG_WARNING("TX_ASYNC_MSG",
+            "Could not create an eventfd (" << std::strerror(errno)
+                                            << "), polling for async messages");
+    }
+#endif
+}
+
+tx_async_msg_queue::~tx_async_msg_queue()
+{
+#ifdef __linux__
+    if (_event_fd >= 0) {
+        close(_event_fd);
+    }
+#endif
+}
 
 bool tx_async_msg_queue::recv_async_msg(
     uhd::async_metadata_t& async_metadata, int32_t timeout_ms)
 {
     using namespace std::chrono;
 
-    if (timeout_ms == 0.0) {
-        return _queue.pop(async_metadata);
+    const size_t num_dropped = _num_dropped.load(std::memory_order_relaxed);
+    if (num_dropped != _num_dropped_logged) {
+        UHD_LOG_WARNING("TX_ASYNC_MSG",
+            "The async message queue is full, dropped "
+                << (num_dropped - _num_dropped_logged) << " messages");
+        _num_dropped_logged = num_dropped;
+    }
+
+    if (timeout_ms == 0) {
+        return _pop(async_metadata);
     }
 
     const auto end_time = steady_clock::now() + milliseconds(timeout_ms);
 
+    // Check once more after the timeout expires, like a poll with no timeout
     bool last_check = false;
 
     while (true) {
-        if (_queue.pop(async_metadata)) {
+        if (_pop(async_metadata)) {
             return true;
         }
+        if (last_check) {
+            return false;
+        }
+        last_check = !_wait(end_time);
+    }
+}
+
+void tx_async_msg_queue::enqueue(const async_metadata_t& async_metadata)
+{
+    UHD_TRACE(ASYNC_MSG, async_metadata.event_code);
+
+    callback_t* callback = _callback.load(std::memory_order_acquire);
+    if (callback) {
+        (*callback)(async_metadata);
+        return;
+    }
+
+    if (!_push(async_metadata)) {
+        _num_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
 
-        if (steady_clock::now() > end_time) {
-            if (last_check) {
-                return false;
-            } else {
-                last_check = true;
+#ifdef __linux__
+    // Pairs with the increment of _num_waiters in _wait(): either the waiter
+    // sees the message, or this sees the waiter
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_event_fd >= 0 && _num_waiters.load(std::memory_order_relaxed) > 0) {
+        const uint64_t one = 1;
+        // The write can only fail if the counter overflows, and then the
+        // waiter gets woken up anyway
+        UHD_UNUSED(const ssize_t ret) = write(_event_fd, &one, sizeof(one));
+    }
+#endif
+}
+
+void tx_async_msg_queue::set_callback(callback_t callback)
+{
+    std::lock_guard<std::mutex> lock(_callbacks_mutex);
+    if (!callback) {
+        _callback.store(nullptr, std::memory_order_release);
+        return;
+    }
+    _callbacks.emplace_back(new callback_t(std::move(callback)));
+    _callback.store(_callbacks.back().get(), std::memory_order_release);
+}
+
+bool tx_async_msg_queue::_push(const async_metadata_t& async_metadata)
+{
+    size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+    while (true) {
+        cell_t& cell       = _cells[pos & _mask];
+        const size_t seq   = cell.seq.load(std::memory_order_acquire);
+        const intptr_t dif = intptr_t(seq) - intptr_t(pos);
+        if (dif == 0) {
+            if (_enqueue_pos.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed)) {
+                cell.msg = async_metadata;
+                cell.seq.store(pos + 1, std::memory_order_release);
+                return true;
             }
+        } else if (dif < 0) {
+            // The cell still holds the message from one lap ago
+            return false;
+        } else {
+            pos = _enqueue_pos.load(std::memory_order_relaxed);
         }
+    }
+}
 
-        std::this_thread::sleep_for(std::chrono::microseconds(100));
+bool tx_async_msg_queue::_pop(async_metadata_t& async_metadata)
+{
+    size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+    while (true) {
+        cell_t& cell       = _cells[pos & _mask];
+        const size_t seq   = cell.seq.load(std::memory_order_acquire);
+        const intptr_t dif = intptr_t(seq) - intptr_t(pos + 1);
+        if (dif == 0) {
+            if (_dequeue_pos.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed)) {
+                async_metadata = cell.msg;
+                cell.seq.store(pos + _mask + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (dif < 0) {
+            // Empty
+            return false;
+        } else {
+            pos = _dequeue_pos.load(std::memory_order_relaxed);
+        }
     }
 }
 
-void tx_async_msg_queue::enqueue(const async_metadata_t& async_metadata)
+bool tx_async_msg_queue::_ready() const
 {
-    _queue.push(async_metadata);
+    const size_t pos = _dequeue_pos.load(std::memory_order_acquire);
+    return _cells[pos & _mask].seq.load(std::memory_order_acquire) == pos + 1;
+}
+
+bool tx_async_msg_queue::_wait(const std::chrono::steady_clock::time_point& end_time)
+{
+    using namespace std::chrono;
+
+    const auto now = steady_clock::now();
+    if (now > end_time) {
+        return false;
+    }
+
+#ifdef __linux__
+    if (_event_fd >= 0) {
+        _num_waiters.fetch_add(1, std::memory_order_relaxed);
+        // Pairs with the fence in enqueue()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!_ready()) {
+            // Round up, so the wait doesn't end just before the timeout
+            const auto remaining =
+                duration_cast<milliseconds>(end_time - now) + milliseconds(1);
+            pollfd pfd = {_event_fd, POLLIN, 0};
+            poll(&pfd, 1, static_cast<int>(remaining.count()));
+            uint64_t count;
+            UHD_UNUSED(const ssize_t ret) = read(_event_fd, &count, sizeof(count));
+        }
+        _num_waiters.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+#endif
+
+    std::this_thread::sleep_for(microseconds(100));
+    return true;
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "../utils/async_python.hpp"
 #include "block_controller_factory_python.hpp"
 #include <uhd/rfnoc/vector_iir_block_control.hpp>
 
@@ -16,11 +17,11 @@ void export_vector_iir_block_control(py::module& m)
     py::class_<vector_iir_block_control, noc_block_base, vector_iir_block_control::sptr>(
         m, "vector_iir_block_control")
         .def(py::init(&block_controller_factory<vector_iir_block_control>::make_from))
-        .def("set_alpha", &vector_iir_block_control::set_alpha)
-        .def("get_alpha", &vector_iir_block_control::get_alpha)
-        .def("set_beta", &vector_iir_block_control::set_beta)
-        .def("get_beta", &vector_iir_block_control::get_beta)
-        .def("set_delay", &vector_iir_block_control::set_delay)
-        .def("get_delay", &vector_iir_block_control::get_delay)
-        .def("get_max_delay", &vector_iir_block_control::get_max_delay);
+        .def("set_alpha", &vector_iir_block_control::set_alpha, release_gil())
+        .def("get_alpha", &vector_iir_block_control::get_alpha, release_gil())
+        .def("set_beta", &vector_iir_block_control::set_beta, release_gil())
+        .def("get_beta", &vector_iir_block_control::get_beta, release_gil())
+        .def("set_delay", &vector_iir_block_control::set_delay, release_gil())
+        .def("get_delay", &vector_iir_block_control::get_delay, release_gil())
+        .def("get_max_delay", &vector_iir_block_control::get_max_delay, release_gil());
 }
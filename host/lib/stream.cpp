@@ -5,16 +5,226 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include <uhd/exception.hpp>
 #include <uhd/stream.hpp>
+#include <algorithm>
 
 using namespace uhd;
 
+constexpr size_t streamer_stats_t::NUM_WAIT_TIME_BUCKETS;
+
+double signal_stats_t::get_mean_power() const
+{
+    return num_samps == 0 ? 0.0 : sum_power / double(num_samps);
+}
+
+std::complex<double> signal_stats_t::get_dc_offset() const
+{
+    return num_samps == 0 ? std::complex<double>(0.0, 0.0) : sum / double(num_samps);
+}
+
+signal_stats_t& signal_stats_t::operator+=(const signal_stats_t& other)
+{
+    num_samps += other.num_samps;
+    sum_power += other.sum_power;
+    peak_power = std::max(peak_power, other.peak_power);
+    sum += other.sum;
+    num_clipped += other.num_clipped;
+    return *this;
+}
+
 rx_streamer::~rx_streamer(void)
 {
     // empty
 }
 
+streamer_stats_t rx_streamer::get_stats(void) const
+{
+    throw uhd::not_implemented_error("This rx streamer does not provide statistics");
+}
+
+void rx_streamer::set_stats_enabled(const bool)
+{
+    throw uhd::not_implemented_error("This rx streamer does not provide statistics");
+}
+
+void rx_streamer::set_latency_probe_enabled(const bool)
+{
+    throw uhd::not_implemented_error("This rx streamer does not provide statistics");
+}
+
+void rx_streamer::set_signal_stats_enabled(const bool)
+{
+    throw uhd::not_implemented_error("This rx streamer has no signal statistics");
+}
+
+signal_stats_t rx_streamer::get_signal_stats(const size_t, const bool)
+{
+    throw uhd::not_implemented_error("This rx streamer has no signal statistics");
+}
+
+void rx_streamer::set_channel_active(const size_t, const bool)
+{
+    throw uhd::not_implemented_error("This rx streamer can't switch channels");
+}
+
+void rx_streamer::set_channel_active(const size_t, const bool, const time_spec_t&)
+{
+    throw uhd::not_implemented_error("This rx streamer can't switch channels");
+}
+
+bool rx_streamer::is_channel_active(const size_t) const
+{
+    return true;
+}
+
+void rx_streamer::set_recv_ready_callback(recv_ready_callback_t)
+{
+    throw uhd::not_implemented_error(
+        "This rx streamer does not notify about received packets");
+}
+
+void rx_streamer::set_recv_packet_callback(recv_packet_callback_t, const bool)
+{
+    throw uhd::not_implemented_error("This rx streamer can't pass packets to a callback");
+}
+
 tx_streamer::~tx_streamer(void)
 {
     // empty
 }
+
+streamer_stats_t tx_streamer::get_stats(void) const
+{
+    throw uhd::not_implemented_error("This tx streamer does not provide statistics");
+}
+
+void tx_streamer::set_stats_enabled(const bool)
+{
+    throw uhd::not_implemented_error("This tx streamer does not provide statistics");
+}
+
+void tx_streamer::set_latency_probe_enabled(const bool)
+{
+    throw uhd::not_implemented_error("This tx streamer does not provide statistics");
+}
+
+void tx_streamer::set_signal_stats_enabled(const bool)
+{
+    throw uhd::not_implemented_error("This tx streamer has no signal statistics");
+}
+
+signal_stats_t tx_streamer::get_signal_stats(const size_t, const bool)
+{
+    throw uhd::not_implemented_error("This tx streamer has no signal statistics");
+}
+
+void tx_streamer::set_async_msg_callback(async_msg_callback_t)
+{
+    throw uhd::not_implemented_error(
+        "This tx streamer does not deliver async messages to a callback");
+}
+
+void tx_streamer::set_send_ready_callback(send_ready_callback_t)
+{
+    throw uhd::not_implemented_error(
+        "This tx streamer does not notify about free send buffers");
+}
+
+void tx_streamer::start_cyclic(const buffs_type&, const size_t, const tx_metadata_t&)
+{
+    throw uhd::not_implemented_error("This tx streamer has no cyclic transmission");
+}
+
+void tx_streamer::stop_cyclic(const double)
+{
+    // Nothing to stop without cyclic transmission
+}
+
+size_t tx_streamer::recv_async_msgs(std::vector<async_metadata_t>& msgs,
+    const size_t max_num_msgs,
+    const double timeout)
+{
+    size_t num_msgs = 0;
+    async_metadata_t async_metadata;
+    while (num_msgs < max_num_msgs
+           && recv_async_msg(async_metadata, num_msgs == 0 ? timeout : 0.0)) {
+        msgs.push_back(async_metadata);
+        num_msgs++;
+    }
+    return num_msgs;
+}
+
+size_t tx_streamer::send_bursts(const std::vector<burst_t>& bursts, const double timeout)
+{
+    for (const auto& burst : bursts) {
+        if (burst.nsamps == 0 || burst.buffs.size() != get_num_channels()) {
+            throw uhd::value_error("[tx_stream] A burst must have one buffer per "
+                                   "channel and at least one sample");
+        }
+    }
+
+    for (size_t i = 0; i < bursts.size(); i++) {
+        tx_metadata_t metadata;
+        metadata.has_time_spec  = true;
+        metadata.time_spec      = bursts[i].time_spec;
+        metadata.start_of_burst = true;
+        metadata.end_of_burst   = true;
+        if (send(bursts[i].buffs, bursts[i].nsamps, metadata, timeout)
+            != bursts[i].nsamps) {
+            return i;
+        }
+    }
+    return bursts.size();
+}
+
+size_t tx_streamer::send_segments(const std::vector<segments_type>& segments,
+    const tx_metadata_t& metadata_,
+    const double timeout)
+{
+    if (segments.size() != get_num_channels()) {
+        throw uhd::value_error("[tx_stream] send_segments() needs one list of "
+                               "segments per channel");
+    }
+    // Without converting across the segment boundaries, each segment is a
+    // call to send(), so the segments of all channels must line up
+    for (const auto& chan_segments : segments) {
+        if (chan_segments.size() != segments.front().size()) {
+            throw uhd::not_implemented_error(
+                "[tx_stream] The segments of all channels must have the same lengths");
+        }
+        for (size_t i = 0; i < chan_segments.size(); i++) {
+            if (chan_segments[i].nsamps != segments.front()[i].nsamps) {
+                throw uhd::not_implemented_error("[tx_stream] The segments of all "
+                                                 "channels must have the same lengths");
+            }
+        }
+    }
+
+    std::vector<const void*> buffs(segments.size(), nullptr);
+    const size_t num_segments = segments.front().size();
+    if (num_segments == 0) {
+        return send(buffs, 0, metadata_, timeout);
+    }
+
+    // Only the first segment is timed, the others follow it within the burst
+    tx_metadata_t metadata(metadata_);
+    const bool eob     = metadata.end_of_burst;
+    size_t nsamps_sent = 0;
+    for (size_t i = 0; i < num_segments; i++) {
+        for (size_t chan = 0; chan < segments.size(); chan++) {
+            buffs[chan] = segments[chan][i].buff;
+        }
+        const size_t nsamps   = segments.front()[i].nsamps;
+        metadata.end_of_burst = eob && i == num_segments - 1;
+        const size_t sent     = send(buffs, nsamps, metadata, timeout);
+        nsamps_sent += sent;
+        if (sent != nsamps) {
+            break;
+        }
+        metadata.start_of_burst = false;
+        metadata.has_time_spec  = false;
+        metadata.has_time_ticks = false;
+    }
+    return nsamps_sent;
+}
@@ -10,7 +10,18 @@
 
 #include <uhd/stream.hpp>
 #include <uhd/types/metadata.hpp>
+#include <uhd/utils/rx_recorder.hpp>
+#include <uhd/utils/sigmf_recorder.hpp>
+#include <uhd/utils/tx_player.hpp>
+#include <pybind11/stl.h>
 #include <boost/format.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 static size_t wrap_recv(uhd::rx_streamer* rx_stream,
     py::object& np_array,
@@ -125,6 +136,487 @@ static size_t wrap_send(uhd::tx_streamer* tx_stream,
     return result;
 }
 
+/*! The channels of a NumPy array, for streaming directly into or out of it
+ *
+ * For RX, the array must be C-contiguous, aligned and writeable. Otherwise
+ * NumPy would hand out a copy, and the received samples would never show up
+ * in the caller's array. For TX, such a copy is made if needed.
+ * Construct while holding the GIL.
+ */
+class np_array_channels
+{
+public:
+    np_array_channels(py::object& np_array, const size_t channels, const bool is_rx)
+        : _array_obj(PyArray_FROM_OF(
+            np_array.ptr(), is_rx ? NPY_ARRAY_CARRAY : NPY_ARRAY_IN_ARRAY))
+    {
+        if (!_array_obj) {
+            throw py::error_already_set();
+        }
+        PyArrayObject* array_type_obj = reinterpret_cast<PyArrayObject*>(_array_obj);
+        if (is_rx && _array_obj != np_array.ptr()) {
+            Py_DECREF(_array_obj);
+            throw uhd::value_error("The data array must be a C-contiguous, aligned and "
+                                   "writeable NumPy array");
+        }
+
+        const size_t dims       = PyArray_NDIM(array_type_obj);
+        const npy_intp* shape   = PyArray_SHAPE(array_type_obj);
+        const npy_intp* strides = PyArray_STRIDES(array_type_obj);
+        if (((channels > 1) && (dims != 2)) or ((size_t)shape[0] < channels)) {
+            Py_DECREF(_array_obj);
+            size_t input_channels = (dims != 2) ? 1 : shape[0];
+            throw uhd::runtime_error(str(
+                boost::format("Number of %s channels (%d) does not match the dimensions "
+                              "of the data array (%d)")
+                % (is_rx ? "RX" : "TX") % channels % input_channels));
+        }
+
+        char* data = PyArray_BYTES(array_type_obj);
+        for (size_t i = 0; i < channels; ++i) {
+            _channel_storage.push_back(data + i * strides[0]);
+        }
+        _nsamps    = (dims > 1) ? (size_t)shape[1] : PyArray_SIZE(array_type_obj);
+        _item_size = PyArray_ITEMSIZE(array_type_obj);
+    }
+
+    ~np_array_channels()
+    {
+        Py_DECREF(_array_obj);
+    }
+
+    //! Number of samples per channel
+    size_t size() const
+    {
+        return _nsamps;
+    }
+
+    //! Pointers to the sample at \p offset of every channel
+    std::vector<void*> at(const size_t offset) const
+    {
+        std::vector<void*> ptrs;
+        for (char* channel : _channel_storage) {
+            ptrs.push_back(channel + offset * _item_size);
+        }
+        return ptrs;
+    }
+
+private:
+    PyObject* _array_obj;
+    std::vector<char*> _channel_storage;
+    size_t _nsamps;
+    size_t _item_size;
+};
+
+/*! Receive into a NumPy array until it is full
+ *
+ * Unlike recv(), this loops in C++ without the GIL until all samples have
+ * been received, so the samples are written straight into the array. Overruns
+ * are reported through the metadata of the last recv() call, but don't stop
+ * the capture (the samples that were lost are not part of the array). The
+ * capture stops early on a timeout, any other error, or an end of burst.
+ *
+ * \return the number of samples received per channel
+ */
+static size_t wrap_recv_num_samps(uhd::rx_streamer* rx_stream,
+    py::object& np_array,
+    uhd::rx_metadata_t& metadata,
+    const double timeout = 0.1,
+    const size_t offset  = 0)
+{
+    const np_array_channels array(np_array, rx_stream->get_num_channels(), true);
+    if (offset > array.size()) {
+        throw uhd::value_error("Offset exceeds the size of the data array");
+    }
+
+    py::gil_scoped_release release;
+    size_t num_recvd   = offset;
+    bool overflow_seen = false;
+    while (num_recvd < array.size()) {
+        num_recvd += rx_stream->recv(
+            array.at(num_recvd), array.size() - num_recvd, metadata, timeout);
+        if (metadata.error_code == uhd::rx_metadata_t::ERROR_CODE_OVERFLOW) {
+            overflow_seen = true;
+            continue;
+        }
+        if (metadata.error_code != uhd::rx_metadata_t::ERROR_CODE_NONE
+            || metadata.end_of_burst) {
+            break;
+        }
+    }
+    if (overflow_seen && metadata.error_code == uhd::rx_metadata_t::ERROR_CODE_NONE) {
+        metadata.error_code = uhd::rx_metadata_t::ERROR_CODE_OVERFLOW;
+    }
+    return num_recvd - offset;
+}
+
+/*! Send all samples of a NumPy array
+ *
+ * Unlike send(), this loops in C++ without the GIL until all samples have
+ * been sent. The start of burst flag and time spec of \p metadata apply to the
+ * first sample, the end of burst flag to the last one.
+ *
+ * \return the number of samples sent per channel, which is less than the size
+ *         of the array on a timeout
+ */
+static size_t wrap_send_num_samps(uhd::tx_streamer* tx_stream,
+    py::object& np_array,
+    const uhd::tx_metadata_t& metadata,
+    const double timeout = 0.1)
+{
+    const np_array_channels array(np_array, tx_stream->get_num_channels(), false);
+
+    py::gil_scoped_release release;
+    uhd::tx_metadata_t md = metadata;
+    size_t num_sent       = 0;
+    while (num_sent < array.size()) {
+        const size_t result = tx_stream->send(
+            array.at(num_sent), array.size() - num_sent, md, timeout);
+        if (result == 0) {
+            break;
+        }
+        num_sent += result;
+        md.start_of_burst = false;
+        md.has_time_spec  = false;
+    }
+    return num_sent;
+}
+
+/*! Shared state of an rx_block_ring and the blocks it handed out
+ *
+ * Slots are owned either by the free list, by the receive thread, by the queue
+ * of ready blocks, or by an rx_block. The receive thread never touches the GIL.
+ */
+struct rx_block_ring_state
+{
+    struct slot_t
+    {
+        std::vector<char> data;
+        uhd::time_spec_t time_spec;
+        bool has_time_spec = false;
+        bool overflow      = false;
+        size_t num_samps   = 0;
+    };
+
+    std::mutex mutex;
+    std::condition_variable ready_cond;
+    std::vector<slot_t> slots;
+    std::vector<size_t> free_slots;
+    std::deque<size_t> ready_slots;
+    std::string error;
+    bool running = false;
+
+    void release(const size_t idx)
+    {
+        std::lock_guard<std::mutex> l(mutex);
+        free_slots.push_back(idx);
+    }
+};
+
+/*! A block of samples received by an rx_block_ring
+ *
+ * The samples are exposed through the buffer protocol, one row per channel,
+ * so numpy.asarray(block) gives a view of them without a copy. The memory goes
+ * back to the ring once the block and all views of it have been collected.
+ */
+class rx_block
+{
+public:
+    rx_block(std::shared_ptr<rx_block_ring_state> state,
+        const size_t idx,
+        const size_t num_channels,
+        const size_t row_size,
+        const std::string& format,
+        const size_t item_size,
+        const size_t items_per_samp)
+        : _state(state)
+        , _idx(idx)
+        , _num_channels(num_channels)
+        , _row_size(row_size)
+        , _format(format)
+        , _item_size(item_size)
+        , _items_per_samp(items_per_samp)
+    {
+    }
+
+    ~rx_block()
+    {
+        _state->release(_idx);
+    }
+
+    const rx_block_ring_state::slot_t& slot() const
+    {
+        return _state->slots[_idx];
+    }
+
+    py::buffer_info get_buffer_info()
+    {
+        auto& block = _state->slots[_idx];
+        return py::buffer_info(block.data.data(),
+            _item_size,
+            _format,
+            2,
+            {_num_channels, block.num_samps * _items_per_samp},
+            {_row_size, _item_size});
+    }
+
+private:
+    std::shared_ptr<rx_block_ring_state> _state;
+    const size_t _idx;
+    const size_t _num_channels;
+    const size_t _row_size;
+    const std::string _format;
+    const size_t _item_size;
+    const size_t _items_per_samp;
+};
+
+/*! Receive blocks of samples in a C++ thread
+ *
+ * The receive thread loops over recv() without the GIL, filling a fixed
+ * number of blocks of \p block_size samples per channel. Python takes the
+ * filled blocks one by one with get_block() or by iterating over the ring, so
+ * the GIL is only needed once per block. When Python falls behind and all
+ * blocks are in use, the received samples are dropped, and the next block has
+ * its overflow flag set.
+ *
+ * The streamer must be started (issue_stream_cmd()) separately.
+ */
+class rx_block_ring
+{
+public:
+    //! Timeout of every recv() call, bounds the time stop() takes
+    static constexpr double RECV_TIMEOUT = 0.1;
+
+    rx_block_ring(uhd::rx_streamer::sptr rx_stream,
+        const size_t block_size,
+        const size_t num_blocks,
+        const std::string& cpu_format)
+        : _rx_stream(rx_stream)
+        , _block_size(block_size)
+        , _num_channels(rx_stream->get_num_channels())
+        , _state(std::make_shared<rx_block_ring_state>())
+    {
+        if (block_size == 0 || num_blocks == 0) {
+            throw uhd::value_error("rx_block_ring: Block size and number of blocks "
+                                   "must be non-zero");
+        }
+        // Formats as used by the Python buffer protocol
+        if (cpu_format == "fc64") {
+            _format = "Zd";
+            _item_size = 16;
+        } else if (cpu_format == "fc32") {
+            _format = "Zf";
+            _item_size = 8;
+        } else if (cpu_format == "sc16") {
+            _format = "h";
+            _item_size = 2;
+            _items_per_samp = 2;
+        } else if (cpu_format == "sc8") {
+            _format = "b";
+            _item_size = 1;
+            _items_per_samp = 2;
+        } else {
+            throw uhd::value_error("rx_block_ring: Unsupported CPU format " + cpu_format);
+        }
+        _row_size = _block_size * _item_size * _items_per_samp;
+
+        // The last slot is where samples go when no other one is free, it's
+        // never handed out
+        _state->slots.resize(num_blocks + 1);
+        for (size_t i = 0; i < _state->slots.size(); i++) {
+            _state->slots[i].data.resize(_row_size * _num_channels);
+        }
+        for (size_t i = 0; i < num_blocks; i++) {
+            _state->free_slots.push_back(i);
+        }
+    }
+
+    ~rx_block_ring()
+    {
+        stop();
+    }
+
+    //! Start the receive thread
+    void start()
+    {
+        if (is_running()) {
+            return;
+        }
+        // The thread may have stopped on an error
+        stop();
+        std::lock_guard<std::mutex> l(_state->mutex);
+        _state->error.clear();
+        _state->running = true;
+        _stop           = false;
+        _thread         = std::thread([this]() { _recv_loop(); });
+    }
+
+    //! Stop the receive thread, the blocks that were received can still be read
+    void stop()
+    {
+        _stop = true;
+        if (_thread.joinable()) {
+            _thread.join();
+        }
+    }
+
+    bool is_running() const
+    {
+        std::lock_guard<std::mutex> l(_state->mutex);
+        return _state->running;
+    }
+
+    /*! Wait for the next block of samples
+     *
+     * \param timeout Timeout in seconds, negative to wait until the ring is
+     *                stopped
+     * \return the block, or None on a timeout or when the ring was stopped and
+     *         all blocks have been read
+     * \throws uhd::runtime_error if the receive thread stopped on an error
+     */
+    std::shared_ptr<rx_block> get_block(const double timeout)
+    {
+        const auto deadline =
+            std::chrono::steady_clock::now()
+            + std::chrono::microseconds(static_cast<int64_t>(timeout * 1e6));
+        size_t idx   = 0;
+        bool running = true;
+        while (true) {
+            // Wait in short steps, so Ctrl-C isn't blocked forever
+            const bool got_block = [&]() {
+                py::gil_scoped_release release;
+                std::unique_lock<std::mutex> l(_state->mutex);
+                auto wait_until = std::chrono::steady_clock::now()
+                                  + std::chrono::milliseconds(100);
+                if (timeout >= 0) {
+                    wait_until = std::min(wait_until, deadline);
+                }
+                _state->ready_cond.wait_until(l, wait_until, [this]() {
+                    return !_state->ready_slots.empty() || !_state->running;
+                });
+                running = _state->running;
+                if (_state->ready_slots.empty()) {
+                    return false;
+                }
+                idx = _state->ready_slots.front();
+                _state->ready_slots.pop_front();
+                return true;
+            }();
+            if (got_block) {
+                return std::make_shared<rx_block>(_state,
+                    idx,
+                    _num_channels,
+                    _row_size,
+                    _format,
+                    _item_size,
+                    _items_per_samp);
+            }
+            if (!running) {
+                std::lock_guard<std::mutex> l(_state->mutex);
+                if (!_state->error.empty()) {
+                    throw uhd::runtime_error(_state->error);
+                }
+                return nullptr;
+            }
+            if (PyErr_CheckSignals() != 0) {
+                throw py::error_already_set();
+            }
+            if (timeout >= 0 && std::chrono::steady_clock::now() >= deadline) {
+                return nullptr;
+            }
+        }
+    }
+
+    //! Number of blocks that were dropped because all blocks were in use
+    size_t get_num_dropped() const
+    {
+        return _num_dropped;
+    }
+
+    size_t get_block_size() const
+    {
+        return _block_size;
+    }
+
+private:
+    void _recv_loop()
+    {
+        const size_t scratch_idx = _state->slots.size() - 1;
+        bool gap                 = false;
+        uhd::rx_metadata_t md;
+        while (!_stop) {
+            size_t idx = scratch_idx;
+            {
+                std::lock_guard<std::mutex> l(_state->mutex);
+                if (!_state->free_slots.empty()) {
+                    idx = _state->free_slots.back();
+                    _state->free_slots.pop_back();
+                }
+            }
+            auto& slot         = _state->slots[idx];
+            slot.overflow      = gap;
+            slot.has_time_spec = false;
+            slot.num_samps     = 0;
+            std::vector<void*> ptrs(_num_channels);
+            while (slot.num_samps < _block_size && !_stop) {
+                for (size_t i = 0; i < _num_channels; i++) {
+                    ptrs[i] = slot.data.data() + i * _row_size
+                              + slot.num_samps * _item_size * _items_per_samp;
+                }
+                const size_t num_recvd = _rx_stream->recv(
+                    ptrs, _block_size - slot.num_samps, md, RECV_TIMEOUT, false);
+                if (md.error_code == uhd::rx_metadata_t::ERROR_CODE_OVERFLOW) {
+                    slot.overflow = true;
+                    continue;
+                }
+                if (md.error_code == uhd::rx_metadata_t::ERROR_CODE_TIMEOUT) {
+                    continue;
+                }
+                if (md.error_code != uhd::rx_metadata_t::ERROR_CODE_NONE) {
+                    std::lock_guard<std::mutex> l(_state->mutex);
+                    _state->error = "rx_block_ring: " + md.strerror();
+                    _stop         = true;
+                    break;
+                }
+                if (num_recvd > 0 && slot.num_samps == 0) {
+                    slot.has_time_spec = md.has_time_spec;
+                    slot.time_spec     = md.time_spec;
+                }
+                slot.num_samps += num_recvd;
+            }
+
+            if (idx == scratch_idx) {
+                _num_dropped++;
+                gap = true;
+                continue;
+            }
+            gap = false;
+            std::lock_guard<std::mutex> l(_state->mutex);
+            if (slot.num_samps == 0) {
+                _state->free_slots.push_back(idx);
+            } else {
+                _state->ready_slots.push_back(idx);
+                _state->ready_cond.notify_one();
+            }
+        }
+        std::lock_guard<std::mutex> l(_state->mutex);
+        _state->running = false;
+        _state->ready_cond.notify_all();
+    }
+
+    uhd::rx_streamer::sptr _rx_stream;
+    const size_t _block_size;
+    const size_t _num_channels;
+    std::string _format;
+    size_t _item_size      = 0;
+    size_t _items_per_samp = 1;
+    size_t _row_size       = 0;
+    std::shared_ptr<rx_block_ring_state> _state;
+    std::atomic<bool> _stop{true};
+    std::atomic<size_t> _num_dropped{0};
+    std::thread _thread;
+};
+
 static bool wrap_recv_async_msg(uhd::tx_streamer* tx_stream,
     uhd::async_metadata_t& async_metadata,
     double timeout = 0.1)
@@ -155,6 +647,12 @@ void export_stream(py::module& m)
             py::arg("np_array"),
             py::arg("metadata"),
             py::arg("timeout") = 0.1)
+        .def("recv_num_samps",
+            &wrap_recv_num_samps,
+            py::arg("np_array"),
+            py::arg("metadata"),
+            py::arg("timeout") = 0.1,
+            py::arg("offset")  = 0)
         .def("get_num_channels", &uhd::rx_streamer::get_num_channels)
         .def("get_max_num_samps", &uhd::rx_streamer::get_max_num_samps)
         .def("issue_stream_cmd", &uhd::rx_streamer::issue_stream_cmd);
@@ -166,12 +664,115 @@ void export_stream(py::module& m)
             py::arg("np_array"),
             py::arg("metadata"),
             py::arg("timeout") = 0.1)
+        .def("send_num_samps",
+            &wrap_send_num_samps,
+            py::arg("np_array"),
+            py::arg("metadata"),
+            py::arg("timeout") = 0.1)
         .def("get_num_channels", &tx_streamer::get_num_channels)
         .def("get_max_num_samps", &tx_streamer::get_max_num_samps)
         .def("recv_async_msg",
             &wrap_recv_async_msg,
             py::arg("async_metadata"),
             py::arg("timeout") = 0.1);
+
+    py::class_<rx_block, std::shared_ptr<rx_block>>(
+        m, "rx_block", py::buffer_protocol(), "A block received by an rx_block_ring")
+        .def_buffer(&rx_block::get_buffer_info)
+        .def_property_readonly(
+            "num_samps", [](const rx_block& self) { return self.slot().num_samps; })
+        .def_property_readonly(
+            "overflow", [](const rx_block& self) { return self.slot().overflow; })
+        .def_property_readonly("has_time_spec",
+            [](const rx_block& self) { return self.slot().has_time_spec; })
+        .def_property_readonly(
+            "time_spec", [](const rx_block& self) { return self.slot().time_spec; });
+
+    py::class_<rx_block_ring>(m, "rx_block_ring")
+        .def(py::init<rx_streamer::sptr, size_t, size_t, const std::string&>(),
+            py::arg("rx_streamer"),
+            py::arg("block_size"),
+            py::arg("num_blocks") = 8,
+            py::arg("cpu_format") = "fc32")
+        .def("start", &rx_block_ring::start)
+        .def("stop", &rx_block_ring::stop, py::call_guard<py::gil_scoped_release>())
+        .def("is_running", &rx_block_ring::is_running)
+        .def("get_block", &rx_block_ring::get_block, py::arg("timeout") = 0.1)
+        .def_property_readonly("num_dropped", &rx_block_ring::get_num_dropped)
+        .def_property_readonly("block_size", &rx_block_ring::get_block_size)
+        .def("__iter__", [](rx_block_ring& self) -> rx_block_ring& { return self; })
+        .def("__next__", [](rx_block_ring& self) {
+            auto block = self.get_block(-1.0);
+            if (!block) {
+                throw py::stop_iteration();
+            }
+            return block;
+        });
+
+    py::class_<uhd::rx_recorder, uhd::rx_recorder::sptr>(
+        m, "rx_recorder", "See: uhd::rx_recorder")
+        .def(py::init(&uhd::rx_recorder::make),
+            py::arg("rx_streamer"),
+            py::arg("cpu_format"),
+            py::arg("paths"),
+            py::arg("args") = uhd::device_addr_t())
+        .def("start", &uhd::rx_recorder::start)
+        .def("stop",
+            &uhd::rx_recorder::stop,
+            py::call_guard<py::gil_scoped_release>())
+        .def("is_running", &uhd::rx_recorder::is_running)
+        .def("get_num_samps_recorded", &uhd::rx_recorder::get_num_samps_recorded)
+        .def("get_num_overflows", &uhd::rx_recorder::get_num_overflows);
+
+    py::class_<uhd::sigmf_recorder, uhd::sigmf_recorder::sptr>(
+        m, "sigmf_recorder", "See: uhd::sigmf_recorder")
+        .def(py::init(&uhd::sigmf_recorder::make),
+            py::arg("rx_streamer"),
+            py::arg("cpu_format"),
+            py::arg("paths"),
+            py::arg("rate"),
+            py::arg("args") = uhd::device_addr_t())
+        .def("start", &uhd::sigmf_recorder::start)
+        .def("stop",
+            &uhd::sigmf_recorder::stop,
+            py::call_guard<py::gil_scoped_release>())
+        .def("is_running", &uhd::sigmf_recorder::is_running)
+        .def("get_num_samps_recorded", &uhd::sigmf_recorder::get_num_samps_recorded)
+        .def("get_num_overflows", &uhd::sigmf_recorder::get_num_overflows)
+        .def("set_frequency",
+            py::overload_cast<const double, const size_t>(
+                &uhd::sigmf_recorder::set_frequency),
+            py::arg("freq"),
+            py::arg("chan") = 0)
+        .def("set_frequency",
+            py::overload_cast<const double, const uhd::time_spec_t&, const size_t>(
+                &uhd::sigmf_recorder::set_frequency),
+            py::arg("freq"),
+            py::arg("time"),
+            py::arg("chan") = 0)
+        .def_static("find_sample",
+            &uhd::sigmf_recorder::find_sample,
+            py::arg("index_path"),
+            py::arg("time"));
+
+    py::class_<uhd::tx_player, uhd::tx_player::sptr>(
+        m, "tx_player", "See: uhd::tx_player")
+        .def(py::init(&uhd::tx_player::make),
+            py::arg("tx_streamer"),
+            py::arg("cpu_format"),
+            py::arg("paths"),
+            py::arg("args") = uhd::device_addr_t())
+        .def("start", py::overload_cast<>(&uhd::tx_player::start))
+        .def("start",
+            py::overload_cast<const uhd::time_spec_t&>(&uhd::tx_player::start),
+            py::arg("time"))
+        .def("stop", &uhd::tx_player::stop, py::call_guard<py::gil_scoped_release>())
+        .def("wait_done",
+            &uhd::tx_player::wait_done,
+            py::arg("timeout"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("get_num_samps_sent", &uhd::tx_player::get_num_samps_sent)
+        .def("get_num_stalls", &uhd::tx_player::get_num_stalls);
 }
 
 #endif /* INCLUDED_UHD_STREAM_PYTHON_HPP */
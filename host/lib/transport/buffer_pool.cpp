@@ -7,6 +7,7 @@
 
 #include <uhd/transport/buffer_pool.hpp>
 #include <uhd/transport/zero_copy.hpp>
+#include <uhdlib/utils/memory_usage.hpp>
 #include <boost/shared_array.hpp>
 #include <vector>
 
@@ -29,10 +30,17 @@ buffer_pool::~buffer_pool(void)
 class buffer_pool_impl : public buffer_pool
 {
 public:
-    buffer_pool_impl(const std::vector<ptr_type>& ptrs, boost::shared_array<char> mem)
-        : _ptrs(ptrs), _mem(mem)
+    buffer_pool_impl(const std::vector<ptr_type>& ptrs,
+        boost::shared_array<char> mem,
+        const size_t mem_size)
+        : _ptrs(ptrs), _mem(mem), _mem_size(mem_size)
     {
-        /* NOP */
+        uhd::add_memory_usage(uhd::MEMORY_USAGE_TRANSPORT, _mem_size);
+    }
+
+    ~buffer_pool_impl(void)
+    {
+        uhd::remove_memory_usage(uhd::MEMORY_USAGE_TRANSPORT, _mem_size);
     }
 
     ptr_type at(const size_t index) const
@@ -48,6 +56,7 @@ public:
 private:
     std::vector<ptr_type> _ptrs;
     boost::shared_array<char> _mem;
+    const size_t _mem_size;
 };
 
 /***********************************************************************
@@ -60,7 +69,8 @@ buffer_pool::sptr buffer_pool::make(
     // 2) pad the overall memory size for room after alignment
     // 3) allocate the memory in one block of sufficient size
     const size_t padded_buff_size = pad_to_boundary(buff_size, alignment);
-    boost::shared_array<char> mem(new char[padded_buff_size * num_buffs + alignment - 1]);
+    const size_t mem_size         = padded_buff_size * num_buffs + alignment - 1;
+    boost::shared_array<char> mem(new char[mem_size]);
 
     // Fill a vector with boundary-aligned points in the memory
     const size_t mem_start = pad_to_boundary(size_t(mem.get()), alignment);
@@ -72,5 +82,5 @@ buffer_pool::sptr buffer_pool::make(
     // Create a new buffer pool implementation with:
     // - the pre-computed pointers, and
     // - the reference to allocated memory.
-    return sptr(new buffer_pool_impl(ptrs, mem));
+    return sptr(new buffer_pool_impl(ptrs, mem, mem_size));
 }
@@ -0,0 +1,279 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/realtime.hpp>
+#include <uhdlib/transport/buffer_pool_alloc.hpp>
+#include <uhdlib/utils/memory_usage.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#ifdef UHD_PLATFORM_LINUX
+#    include <arpa/inet.h>
+#    include <ifaddrs.h>
+#    include <linux/mempolicy.h>
+#    include <sys/mman.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#    ifndef MAP_HUGE_SHIFT
+#        define MAP_HUGE_SHIFT 26
+#    endif
+#endif
+
+using namespace uhd::transport;
+
+namespace {
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+constexpr size_t HUGEPAGE_SIZE_2M = size_t(2) << 20;
+constexpr size_t HUGEPAGE_SIZE_1G = size_t(1) << 30;
+
+//! pad the byte count to a multiple of alignment
+size_t pad_to_boundary(const size_t bytes, const size_t alignment)
+{
+    return bytes + (alignment - bytes) % alignment;
+}
+
+} // namespace
+
+#ifdef UHD_PLATFORM_LINUX
+/***********************************************************************
+ * Buffer pool backed by directly mapped memory
+ **********************************************************************/
+class mmap_buffer_pool : public buffer_pool
+{
+public:
+    mmap_buffer_pool(const size_t num_buffs,
+        const size_t buff_size,
+        const buff_alloc_params_t& params)
+    {
+        const size_t padded_buff_size = pad_to_boundary(buff_size, CACHE_LINE_SIZE);
+        const size_t page_size        = size_t(::sysconf(_SC_PAGESIZE));
+        _mem_size = pad_to_boundary(padded_buff_size * num_buffs, page_size);
+
+        if (params.hugepage_size != 0) {
+            _mem = _map_hugepages(params.hugepage_size);
+        }
+        if (_mem == nullptr) {
+            _mem = ::mmap(nullptr,
+                _mem_size,
+                PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS,
+                -1,
+                0);
+            if (_mem == MAP_FAILED) {
+                _mem = nullptr;
+                throw uhd::os_error(std::string("Failed to allocate frame buffers: ")
+                                    + std::strerror(errno));
+            }
+        }
+
+        if (params.numa_node >= 0) {
+            _bind_to_numa_node(params.numa_node);
+        }
+
+        // Fault all pages in now, so that they are placed according to the
+        // policy and don't cause page faults while streaming
+        std::memset(_mem, 0, _mem_size);
+
+        const size_t mem_start = size_t(_mem);
+        for (size_t i = 0; i < num_buffs; i++) {
+            _ptrs.push_back(ptr_type(mem_start + padded_buff_size * i));
+        }
+        uhd::add_memory_usage(uhd::MEMORY_USAGE_TRANSPORT, _mem_size);
+    }
+
+    ~mmap_buffer_pool(void)
+    {
+        uhd::remove_memory_usage(uhd::MEMORY_USAGE_TRANSPORT, _mem_size);
+        ::munmap(_mem, _mem_size);
+    }
+
+    ptr_type at(const size_t index) const
+    {
+        return _ptrs.at(index);
+    }
+
+    size_t size(void) const
+    {
+        return _ptrs.size();
+    }
+
+private:
+    void* _map_hugepages(const size_t hugepage_size)
+    {
+        const int page_flag = hugepage_size == HUGEPAGE_SIZE_1G ? (30 << MAP_HUGE_SHIFT)
+                                                                : (21 << MAP_HUGE_SHIFT);
+        const size_t mem_size = pad_to_boundary(_mem_size, hugepage_size);
+        void* mem             = ::mmap(nullptr,
+            mem_size,
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | page_flag,
+            -1,
+            0);
+        if (mem == MAP_FAILED) {
+            UHD_LOG_WARNING("BUFFER_POOL",
+                "Failed to allocate " << mem_size << " bytes of frame buffers on "
+                                      << (hugepage_size >> 20) << " MB hugepages ("
+                                      << std::strerror(errno)
+                                      << "), using regular pages instead. Check that "
+                                         "enough hugepages are reserved.");
+            return nullptr;
+        }
+        _mem_size = mem_size;
+        return mem;
+    }
+
+    void _bind_to_numa_node(const int numa_node)
+    {
+        const size_t bits_per_mask = 8 * sizeof(unsigned long);
+        std::vector<unsigned long> node_mask(numa_node / bits_per_mask + 1, 0);
+        node_mask[numa_node / bits_per_mask] = 1UL << (numa_node % bits_per_mask);
+
+        if (::syscall(SYS_mbind,
+                _mem,
+                _mem_size,
+                MPOL_BIND,
+                node_mask.data(),
+                node_mask.size() * bits_per_mask,
+                0)
+            != 0) {
+            UHD_LOG_WARNING("BUFFER_POOL",
+                "Failed to bind frame buffers to NUMA node " << numa_node << " ("
+                                                              << std::strerror(errno)
+                                                              << ")");
+        }
+    }
+
+    std::vector<ptr_type> _ptrs;
+    void* _mem       = nullptr;
+    size_t _mem_size = 0;
+};
+#endif
+
+/***********************************************************************
+ * Allocation functions
+ **********************************************************************/
+buffer_pool::sptr uhd::transport::make_buffer_pool(
+    const size_t num_buffs, const size_t buff_size, const buff_alloc_params_t& params)
+{
+    UHD_ASSERT_THROW(params.numa_node != BUFF_NUMA_NODE_AUTO);
+    if (params.hugepage_size == 0 and params.numa_node == BUFF_NUMA_NODE_NONE
+        and not params.prefault) {
+        return buffer_pool::make(num_buffs, buff_size);
+    }
+
+#ifdef UHD_PLATFORM_LINUX
+    return std::make_shared<mmap_buffer_pool>(num_buffs, buff_size, params);
+#else
+    if (params.hugepage_size != 0 or params.numa_node != BUFF_NUMA_NODE_NONE) {
+        UHD_LOG_WARNING("BUFFER_POOL",
+            "Hugepages and NUMA binding of frame buffers are not supported on this "
+            "platform, ignoring.");
+    }
+    auto pool = buffer_pool::make(num_buffs, buff_size, CACHE_LINE_SIZE);
+    if (params.prefault) {
+        for (size_t i = 0; i < pool->size(); i++) {
+            uhd::prefault_memory(pool->at(i), buff_size);
+        }
+    }
+    return pool;
+#endif
+}
+
+int uhd::transport::get_numa_node_of_addr(const std::string& local_addr)
+{
+    return get_numa_node_of_ifname(get_ifname_of_addr(local_addr));
+}
+
+std::string uhd::transport::get_ifname_of_addr(const std::string& local_addr)
+{
+#ifdef UHD_PLATFORM_LINUX
+    struct ifaddrs* ifap = nullptr;
+    if (::getifaddrs(&ifap) != 0) {
+        return std::string();
+    }
+
+    std::string iface;
+    for (struct ifaddrs* ifa = ifap; ifa != nullptr; ifa = ifa->ifa_next) {
+        if (ifa->ifa_addr == nullptr or ifa->ifa_addr->sa_family != AF_INET) {
+            continue;
+        }
+        char addr[INET_ADDRSTRLEN];
+        const auto* sin = reinterpret_cast<const struct sockaddr_in*>(ifa->ifa_addr);
+        if (::inet_ntop(AF_INET, &sin->sin_addr, addr, sizeof(addr)) != nullptr
+            and local_addr == addr) {
+            iface = ifa->ifa_name;
+            break;
+        }
+    }
+    ::freeifaddrs(ifap);
+    return iface;
+#else
+    (void)local_addr;
+    return std::string();
+#endif
+}
+
+int uhd::transport::get_numa_node_of_ifname(const std::string& ifname)
+{
+#ifdef UHD_PLATFORM_LINUX
+    // Virtual interfaces have no device, and the kernel reports -1 for
+    // devices on machines without NUMA
+    int numa_node = BUFF_NUMA_NODE_NONE;
+    std::ifstream numa_file("/sys/class/net/" + ifname + "/device/numa_node");
+    if (ifname.empty() or not(numa_file >> numa_node) or numa_node < 0) {
+        return BUFF_NUMA_NODE_NONE;
+    }
+    return numa_node;
+#else
+    (void)ifname;
+    return BUFF_NUMA_NODE_NONE;
+#endif
+}
+
+size_t uhd::transport::parse_buff_hugepages(const std::string& value)
+{
+    std::string size = boost::algorithm::to_upper_copy(value);
+    if (boost::algorithm::ends_with(size, "B")) {
+        size.pop_back();
+    }
+    if (size.empty() or size == "0" or size == "NONE") {
+        return 0;
+    }
+    if (size == "2M") {
+        return HUGEPAGE_SIZE_2M;
+    }
+    if (size == "1G") {
+        return HUGEPAGE_SIZE_1G;
+    }
+    throw uhd::value_error(
+        "Invalid value for buff_hugepages: " + value + " (expected 2M, 1G or none)");
+}
+
+int uhd::transport::parse_buff_numa_node(const std::string& value)
+{
+    const std::string node = boost::algorithm::to_lower_copy(value);
+    if (node.empty() or node == "none") {
+        return BUFF_NUMA_NODE_NONE;
+    }
+    if (node == "auto") {
+        return BUFF_NUMA_NODE_AUTO;
+    }
+    try {
+        const int numa_node = boost::lexical_cast<int>(node);
+        if (numa_node >= 0) {
+            return numa_node;
+        }
+    } catch (const boost::bad_lexical_cast&) {
+    }
+    throw uhd::value_error("Invalid value for buff_numa_node: " + value
+                           + " (expected a node number, auto or none)");
+}
@@ -68,6 +68,13 @@ static const uint32_t occ_table[] = {0, 2, 1, 3};
 const uint32_t VRLP = ('V' << 24) | ('R' << 16) | ('L' << 8) | ('P' << 0);
 const uint32_t VEND = ('V' << 24) | ('E' << 16) | ('N' << 8) | ('D' << 0);
 
+//The header bits that select the layout of a packet: SID, CID, trailer, SOB,
+//TSI and TSF. A regular data packet has a SID, maybe a TSF, and nothing else,
+//so its fields are always at the same offsets.
+static const uint32_t FAST_PATH_MASK    = 0x1ef00000;
+static const uint32_t FAST_PATH_SID     = (0x1 << 28);
+static const uint32_t FAST_PATH_SID_TSF = (0x1 << 28) | (0x1 << 20);
+
 UHD_INLINE static uint32_t chdr_to_vrt(const uint32_t chdr, if_packet_info_t &info)
 {
     const uint32_t bytes = chdr & 0xffff;
@@ -96,6 +103,62 @@ UHD_INLINE static uint32_t vrt_to_chdr(const uint32_t vrt, const if_packet_info_
 ########################################################################
 <%def name="gen_code(XE_MACRO, suffix)">
 ########################################################################
+/***********************************************************************
+ * fast path of packing and unpacking a regular data packet:
+ * the fields are at fixed offsets, so nothing is left to look up
+ **********************************************************************/
+template <bool has_tsf>
+UHD_INLINE void __if_hdr_pack_fast_${suffix}(
+    uint32_t *packet_buff,
+    if_packet_info_t &if_packet_info,
+    uint32_t &vrt_hdr_word32
+){
+    const size_t num_header_words = has_tsf ? 4 : 2;
+    packet_buff[1] = ${XE_MACRO}(if_packet_info.sid);
+    if (has_tsf) {
+        packet_buff[2] = ${XE_MACRO}(uint32_t(if_packet_info.tsf >> 32));
+        packet_buff[3] = ${XE_MACRO}(uint32_t(if_packet_info.tsf >> 0));
+    }
+    if_packet_info.num_header_words32 = num_header_words;
+    if_packet_info.num_packet_words32 = num_header_words + if_packet_info.num_payload_words32;
+
+    vrt_hdr_word32 = uint32_t(0
+        | (if_packet_info.packet_type << 29)
+        | (has_tsf ? FAST_PATH_SID_TSF : FAST_PATH_SID)
+        | (if_packet_info.eob ? (0x1 << 24) : 0)
+        | ((if_packet_info.packet_count & 0xf) << 16)
+        | (if_packet_info.num_packet_words32 & 0xffff)
+    );
+}
+
+template <bool has_tsf>
+UHD_INLINE void __if_hdr_unpack_fast_${suffix}(
+    const uint32_t *packet_buff,
+    if_packet_info_t &if_packet_info,
+    const uint32_t vrt_hdr_word32
+){
+    const size_t packet_words32 = vrt_hdr_word32 & 0xffff;
+    const size_t num_header_words = has_tsf ? 4 : 2;
+    if (packet_words32 < num_header_words)
+        throw uhd::value_error("bad vrt header or invalid packet length");
+
+    if_packet_info.has_sid = true;
+    if_packet_info.sid = ${XE_MACRO}(packet_buff[1]);
+    if_packet_info.has_cid = false;
+    if_packet_info.has_tsi = false;
+    if_packet_info.has_tsf = has_tsf;
+    if (has_tsf) {
+        if_packet_info.tsf = uint64_t(${XE_MACRO}(packet_buff[2])) << 32;
+        if_packet_info.tsf |= ${XE_MACRO}(packet_buff[3]);
+    }
+    if_packet_info.eob = (vrt_hdr_word32 & (0x1 << 24)) != 0;
+    if_packet_info.sob = false;
+    if_packet_info.has_tlr = false;
+    if_packet_info.num_header_words32 = num_header_words;
+    if_packet_info.num_payload_words32 = packet_words32 - num_header_words;
+    if_packet_info.num_payload_bytes = if_packet_info.num_payload_words32*sizeof(uint32_t);
+}
+
 /***********************************************************************
  * internal impl of packing VRT IF header only
  **********************************************************************/
@@ -106,6 +169,17 @@ UHD_INLINE void __if_hdr_pack_${suffix}(
 ){
     uint32_t vrt_hdr_flags = 0;
 
+    if (if_packet_info.has_sid and not if_packet_info.has_cid
+        and not if_packet_info.has_tsi and not if_packet_info.has_tlr
+        and not if_packet_info.sob){
+        if (if_packet_info.has_tsf) {
+            __if_hdr_pack_fast_${suffix}<true>(packet_buff, if_packet_info, vrt_hdr_word32);
+        } else {
+            __if_hdr_pack_fast_${suffix}<false>(packet_buff, if_packet_info, vrt_hdr_word32);
+        }
+        return;
+    }
+
     pred_type pred = 0;
     if (if_packet_info.has_sid) pred |= ${hex(sid_p)};
     if (if_packet_info.has_cid) pred |= ${hex(cid_p)};
@@ -183,6 +257,17 @@ UHD_INLINE void __if_hdr_unpack_${suffix}(
     if_packet_info.packet_type = if_packet_info_t::packet_type_t(vrt_hdr_word32 >> 29);
     if_packet_info.packet_count = (vrt_hdr_word32 >> 16) & 0xf;
 
+    switch(vrt_hdr_word32 & FAST_PATH_MASK){
+    case FAST_PATH_SID_TSF:
+        __if_hdr_unpack_fast_${suffix}<true>(packet_buff, if_packet_info, vrt_hdr_word32);
+        return;
+    case FAST_PATH_SID:
+        __if_hdr_unpack_fast_${suffix}<false>(packet_buff, if_packet_info, vrt_hdr_word32);
+        return;
+    default:
+        break;
+    }
+
     const pred_type pred = pred_unpack_table[pred_table_index(vrt_hdr_word32)];
 
     size_t empty_bytes = 0;
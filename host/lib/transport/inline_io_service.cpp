@@ -7,7 +7,9 @@
 #include <uhd/config.hpp>
 #include <uhd/exception.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhdlib/transport/hybrid_wait.hpp>
 #include <uhdlib/transport/inline_io_service.hpp>
+#include <uhdlib/utils/trace.hpp>
 #include <boost/circular_buffer.hpp>
 #include <cassert>
 
@@ -63,10 +65,11 @@ public:
     {
         UHD_ASSERT_THROW(_queues.count(cb) == 0);
         /* Always create queue of max size, since we don't know when there are
-         * virtual channels (which share frames)
+         * virtual channels (which share frames). The link may also hold frames
+         * borrowed from a shared frame pool.
          */
-        auto queue =
-            new boost::circular_buffer<frame_buff*>(_link->get_num_recv_frames());
+        auto queue = new boost::circular_buffer<frame_buff*>(
+            _link->get_num_recv_frames() + _link->get_num_shared_recv_frames());
         _queues[cb] = queue;
         _callbacks.push_back(cb);
     }
@@ -116,6 +119,7 @@ public:
             frame_buff::uptr buff = recv_link->get_recv_buff(timeout_ms);
             /* Process buffer */
             if (buff) {
+                UHD_TRACE(IO_SRV_RECV, buff->packet_size());
                 bool rcvr_found = false;
                 for (auto& rcvr : _callbacks) {
                     if (rcvr->callback(buff, recv_link)) {
@@ -135,6 +139,7 @@ public:
                     }
                 }
                 if (not rcvr_found) {
+                    UHD_TRACE(IO_SRV_DROP);
                     UHD_LOG_DEBUG("IO_SRV", "Dropping packet with no receiver");
                     recv_link->release_recv_buff(std::move(buff));
                 }
@@ -150,6 +155,7 @@ public:
             frame_buff::uptr buff = recv_link->get_recv_buff(timeout_ms);
             /* Process buffer */
             if (buff) {
+                UHD_TRACE(IO_SRV_RECV, buff->packet_size());
                 bool rcvr_found = false;
                 for (auto& rcvr : _callbacks) {
                     if (rcvr->callback(buff, recv_link)) {
@@ -170,6 +176,7 @@ public:
                     }
                 }
                 if (not rcvr_found) {
+                    UHD_TRACE(IO_SRV_DROP);
                     UHD_LOG_DEBUG("IO_SRV", "Dropping packet with no receiver");
                     recv_link->release_recv_buff(std::move(buff));
                 }
@@ -202,6 +209,7 @@ public:
         , _data_link(data_link)
         , _fc_link(fc_link)
         , _fc_cb(fc_cb)
+        , _wait(io_srv->_max_spin_us)
     {
         _num_recv_frames = num_recv_frames;
         _num_send_frames = num_send_frames;
@@ -217,7 +225,12 @@ public:
 
     frame_buff::uptr get_recv_buff(int32_t timeout_ms)
     {
-        auto buff = _io_srv->recv(this, _data_link.get(), timeout_ms);
+        auto buff = _wait.wait(
+            [this]() { return _io_srv->recv(this, _data_link.get(), 0); },
+            [this](const int32_t timeout) {
+                return _io_srv->recv(this, _data_link.get(), timeout);
+            },
+            timeout_ms);
         if (buff) {
             _num_frames_in_use++;
             assert(_num_frames_in_use <= _num_recv_frames);
@@ -236,6 +249,7 @@ private:
     recv_link_if::sptr _data_link;
     send_link_if::sptr _fc_link;
     fc_callback_t _fc_cb;
+    hybrid_wait _wait;
     size_t _num_frames_in_use = 0;
 };
 
@@ -258,6 +272,8 @@ public:
         , _send_cb(send_cb)
         , _recv_link(recv_link)
         , _fc_cb(fc_cb)
+        , _fc_wait(io_srv->_max_spin_us)
+        , _buff_wait(io_srv->_max_spin_us)
     {
         _num_recv_frames = num_recv_frames;
         _num_send_frames = num_send_frames;
@@ -280,8 +296,12 @@ public:
         }
 
         while (!_fc_cb(num_bytes)) {
-            const bool updated =
-                _io_srv->recv_flow_ctrl(this, _recv_link.get(), timeout_ms);
+            const bool updated = _fc_wait.wait(
+                [this]() { return _io_srv->recv_flow_ctrl(this, _recv_link.get(), 0); },
+                [this](const int32_t timeout) {
+                    return _io_srv->recv_flow_ctrl(this, _recv_link.get(), timeout);
+                },
+                timeout_ms);
 
             if (!updated) {
                 return false;
@@ -292,7 +312,10 @@ public:
 
     frame_buff::uptr get_send_buff(int32_t timeout_ms)
     {
-        frame_buff::uptr buff = _send_link->get_send_buff(timeout_ms);
+        frame_buff::uptr buff = _buff_wait.wait(
+            [this]() { return _send_link->get_send_buff(0); },
+            [this](const int32_t timeout) { return _send_link->get_send_buff(timeout); },
+            timeout_ms);
         if (buff) {
             _num_frames_in_use++;
             assert(_num_frames_in_use <= _num_send_frames);
@@ -315,6 +338,8 @@ private:
     recv_link_if::sptr _recv_link;
     recv_callback_t _recv_cb;
     fc_callback_t _fc_cb;
+    hybrid_wait _fc_wait;
+    hybrid_wait _buff_wait;
     size_t _num_frames_in_use = 0;
 };
 
@@ -423,7 +448,7 @@ void inline_io_service::disconnect_sender(send_link_if* /*link*/)
 void inline_io_service::connect_receiver(
     recv_link_if* link, inline_recv_cb* cb, size_t num_frames)
 {
-    size_t capacity = link->get_num_recv_frames();
+    size_t capacity = link->get_num_recv_frames() + link->get_num_shared_recv_frames();
     UHD_ASSERT_THROW(num_frames <= capacity);
 
     inline_recv_mux* mux;
@@ -477,12 +502,14 @@ frame_buff::uptr inline_io_service::recv(
         frame_buff::uptr buff = recv_link->get_recv_buff(timeout_ms);
         /* Process buffer */
         if (buff) {
+            UHD_TRACE(IO_SRV_RECV, buff->packet_size());
             if (rcvr->callback(buff, recv_link)) {
                 if (buff) {
                     return frame_buff::uptr(std::move(buff));
                 }
                 /* Retry receive if got buffer but it got consumed */
             } else {
+                UHD_TRACE(IO_SRV_DROP);
                 UHD_LOG_DEBUG("IO_SRV", "Dropping packet with no receiver");
                 recv_link->release_recv_buff(std::move(buff));
             }
@@ -510,10 +537,12 @@ bool inline_io_service::recv_flow_ctrl(
         frame_buff::uptr buff = recv_link->get_recv_buff(timeout_ms);
         /* Process buffer */
         if (buff) {
+            UHD_TRACE(IO_SRV_RECV, buff->packet_size());
             if (rcvr->callback(buff, recv_link)) {
                 assert(!buff);
                 return true;
             } else {
+                UHD_TRACE(IO_SRV_DROP);
                 UHD_LOG_DEBUG("IO_SRV", "Dropping packet with no receiver");
                 recv_link->release_recv_buff(std::move(buff));
             }
@@ -16,6 +16,9 @@
 #include <boost/format.hpp>
 #include <boost/thread/condition_variable.hpp>
 #include <boost/thread/mutex.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <list>
 #include <memory>
@@ -30,6 +33,69 @@ static const size_t DEFAULT_XFER_SIZE = 32 * 512; // bytes
 class libusb_zero_copy_mb;
 typedef std::shared_ptr<bounded_buffer<libusb_zero_copy_mb*>> mb_queue_sptr;
 
+/*!
+ * Statistics about the transfers of one endpoint
+ *
+ * Completions are only counted on the libusb event thread, and starvation
+ * only by the thread getting buffers, so every counter has a single writer
+ * and is updated with relaxed loads and stores.
+ */
+class libusb_xfer_stats
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    //! Counts a transfer that was in flight for the given time
+    void add_xfer(const clock::duration latency)
+    {
+        const uint64_t latency_ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count();
+        _add(_xfers, 1);
+        _add(_latency_ns, latency_ns);
+
+        size_t bucket = 0;
+        for (uint64_t latency_us = latency_ns / 1000; latency_us != 0; latency_us >>= 1) {
+            bucket++;
+        }
+        _add(_latency_hist[std::min(bucket, NUM_BUCKETS - 1)], 1);
+    }
+
+    //! Counts a time all transfers had completed before they were handed out
+    void add_starved()
+    {
+        _add(_starved, 1);
+    }
+
+    //! Returns the current value of all counters
+    usb_zero_copy::xfer_stats_t get(const size_t num_frames) const
+    {
+        usb_zero_copy::xfer_stats_t stats;
+        stats.num_frames = num_frames;
+        stats.xfers      = _xfers.load(std::memory_order_relaxed);
+        stats.latency_ns = _latency_ns.load(std::memory_order_relaxed);
+        stats.starved    = _starved.load(std::memory_order_relaxed);
+        for (const auto& bucket : _latency_hist) {
+            stats.latency_hist.push_back(bucket.load(std::memory_order_relaxed));
+        }
+        return stats;
+    }
+
+private:
+    static constexpr size_t NUM_BUCKETS =
+        usb_zero_copy::xfer_stats_t::NUM_LATENCY_BUCKETS;
+
+    static void _add(std::atomic<uint64_t>& counter, const uint64_t n)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + n,
+            std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> _xfers{0};
+    std::atomic<uint64_t> _latency_ns{0};
+    std::atomic<uint64_t> _starved{0};
+    std::atomic<uint64_t> _latency_hist[NUM_BUCKETS] = {};
+};
+
 /*!
  * The libusb docs state that status and actual length can only be read in the callback.
  * Therefore, this struct is intended to store data seen from the callback function.
@@ -52,6 +118,10 @@ struct lut_result_t
     boost::mutex mut;
     boost::condition_variable usb_transfer_complete;
 
+    //! When the transfer was last submitted, and where to count its completion
+    libusb_xfer_stats::clock::time_point submit_time;
+    libusb_xfer_stats* stats = nullptr;
+
 #ifdef UHD_TXRX_DEBUG_PRINTS
     // These are fore debugging
     long start_time;
@@ -93,6 +163,9 @@ static void LIBUSB_CALL libusb_async_cb(libusb_transfer* lut)
     r->status        = lut->status;
     r->actual_length = lut->actual_length;
     r->completed     = 1;
+    if (r->stats != nullptr && r->status == LIBUSB_TRANSFER_COMPLETED) {
+        r->stats->add_xfer(libusb_xfer_stats::clock::now() - r->submit_time);
+    }
     r->usb_transfer_complete.notify_one(); // wake up thread waiting in
                                            // wait_for_completion() member function below
 #ifdef UHD_TXRX_DEBUG_PRINTS
@@ -141,7 +214,8 @@ public:
         result.buff_num   = num();
         result.is_recv    = _is_recv;
 #endif
-        int ret = libusb_submit_transfer(_lut);
+        result.submit_time = libusb_xfer_stats::clock::now();
+        int ret            = libusb_submit_transfer(_lut);
         if (ret != LIBUSB_SUCCESS)
             throw uhd::usb_error(ret,
                 str(boost::format("usb %s submit failed: %s") % _name
@@ -190,6 +264,13 @@ public:
         return (result.completed > 0);
     }
 
+    //! Check whether the transfer has completed, without waiting for it
+    UHD_INLINE bool is_completed(void)
+    {
+        boost::lock_guard<boost::mutex> lock(result.mut);
+        return result.completed > 0;
+    }
+
 private:
     std::function<void(libusb_zero_copy_mb*)> _release_cb;
     const bool _is_recv;
@@ -214,23 +295,25 @@ public:
         const int interface,
         const unsigned char endpoint,
         const size_t num_frames,
-        const size_t frame_size)
+        const size_t frame_size,
+        const size_t max_frames)
         : _handle(handle)
-        , _num_frames(num_frames)
+        , _endpoint(endpoint)
+        , _is_recv((endpoint & 0x80) != 0)
+        , _name(str(boost::format("%s%d") % ((_is_recv) ? "rx" : "tx")
+                    % int(endpoint & 0x7f)))
+        , _num_frames(0)
+        , _max_frames(std::max(num_frames, max_frames))
         , _frame_size(frame_size)
-        , _buffer_pool(buffer_pool::make(_num_frames, _frame_size))
-        , _enqueued(_num_frames)
-        , _released(_num_frames)
+        , _enqueued(num_frames)
+        , _released(num_frames)
         , _status(STATUS_RUNNING)
     {
-        const bool is_recv = (endpoint & 0x80) != 0;
-        const std::string name =
-            str(boost::format("%s%d") % ((is_recv) ? "rx" : "tx") % int(endpoint & 0x7f));
         _handle->claim_interface(interface);
 
         // flush the buffers out of the recv endpoint
         // limit the flushing to at most one second
-        if (is_recv)
+        if (_is_recv)
             for (size_t i = 0; i < 100; i++) {
                 unsigned char buff[512];
                 int transfered   = 0;
@@ -246,35 +329,12 @@ public:
             }
 
         // allocate libusb transfer structs and managed buffers
-        for (size_t i = 0; i < get_num_frames(); i++) {
-            libusb_transfer* lut = libusb_alloc_transfer(0);
-            UHD_ASSERT_THROW(lut != NULL);
-
-            _mb_pool.push_back(std::make_shared<libusb_zero_copy_mb>(lut,
-                this->get_frame_size(),
-                std::bind(&libusb_zero_copy_single::enqueue_buffer,
-                    this,
-                    std::placeholders::_1),
-                is_recv,
-                name));
-
-            libusb_fill_bulk_transfer(lut, // transfer
-                _handle->get(), // dev_handle
-                endpoint, // endpoint
-                static_cast<unsigned char*>(_buffer_pool->at(i)), // buffer
-                int(this->get_frame_size()), // length
-                libusb_transfer_cb_fn(&libusb_async_cb), // callback
-                static_cast<void*>(&_mb_pool.back()->result), // user_data
-                0 // timeout (ms)
-            );
-
-            _all_luts.push_back(lut);
-        }
+        alloc_xfers(num_frames);
 
         // initial release for all buffers
         for (size_t i = 0; i < get_num_frames(); i++) {
             libusb_zero_copy_mb& mb = *(_mb_pool[i]);
-            if (is_recv)
+            if (_is_recv)
                 mb.release();
             else {
                 mb.result.completed = 1;
@@ -325,8 +385,17 @@ public:
         buff = front->get_new<buffer_type>(timeout);
         queue_lock.lock();
 
-        if (buff)
+        if (buff) {
             _enqueued.pop_front();
+            // Receive transfers complete in order, so if the last one in flight
+            // has completed, there is nowhere for the device to put more data
+            if (_is_recv and (_enqueued.empty() or _enqueued.back()->is_completed())) {
+                _stats.add_starved();
+                if (_num_frames < _max_frames) {
+                    add_xfer_in_flight();
+                }
+            }
+        }
         this->submit_what_we_can();
         return buff;
     }
@@ -340,13 +409,25 @@ public:
         return _frame_size;
     }
 
+    usb_zero_copy::xfer_stats_t get_stats(void) const
+    {
+        return _stats.get(_num_frames);
+    }
+
 private:
     libusb::device_handle::sptr _handle;
-    const size_t _num_frames, _frame_size;
+    const unsigned char _endpoint;
+    const bool _is_recv;
+    const std::string _name;
+    //! Number of transfers allocated so far, and up to how many may be added
+    std::atomic<size_t> _num_frames;
+    const size_t _max_frames;
+    const size_t _frame_size;
 
     //! Storage for transfer related objects
-    buffer_pool::sptr _buffer_pool;
+    std::vector<buffer_pool::sptr> _buffer_pools;
     std::vector<std::shared_ptr<libusb_zero_copy_mb>> _mb_pool;
+    libusb_xfer_stats _stats;
 
     boost::mutex _queue_mutex;
     boost::condition_variable _buff_ready_cond;
@@ -357,6 +438,52 @@ private:
 
     enum { STATUS_RUNNING, STATUS_ERROR } _status;
 
+    //! Allocate transfer structs, buffers and managed buffers for more transfers
+    void alloc_xfers(const size_t num_xfers)
+    {
+        buffer_pool::sptr pool = buffer_pool::make(num_xfers, _frame_size);
+        _buffer_pools.push_back(pool);
+        for (size_t i = 0; i < num_xfers; i++) {
+            libusb_transfer* lut = libusb_alloc_transfer(0);
+            UHD_ASSERT_THROW(lut != NULL);
+
+            _mb_pool.push_back(std::make_shared<libusb_zero_copy_mb>(lut,
+                this->get_frame_size(),
+                std::bind(&libusb_zero_copy_single::enqueue_buffer,
+                    this,
+                    std::placeholders::_1),
+                _is_recv,
+                _name));
+            _mb_pool.back()->result.stats = &_stats;
+
+            libusb_fill_bulk_transfer(lut, // transfer
+                _handle->get(), // dev_handle
+                _endpoint, // endpoint
+                static_cast<unsigned char*>(pool->at(i)), // buffer
+                int(this->get_frame_size()), // length
+                libusb_transfer_cb_fn(&libusb_async_cb), // callback
+                static_cast<void*>(&_mb_pool.back()->result), // user_data
+                0 // timeout (ms)
+            );
+
+            _all_luts.push_back(lut);
+        }
+        _num_frames += num_xfers;
+    }
+
+    //! Add a receive transfer and submit it. Call with the queue mutex held.
+    void add_xfer_in_flight(void)
+    {
+        const size_t num_frames = _num_frames + 1;
+        _enqueued.set_capacity(num_frames);
+        _released.set_capacity(num_frames);
+        alloc_xfers(1);
+        _released.push_back(_mb_pool.back().get());
+        UHD_LOGGER_DEBUG("USB") << "Receive transfers on " << _name
+                                << " ran dry, submitting " << num_frames
+                                << " transfers from now on";
+    }
+
     void enqueue_buffer(libusb_zero_copy_mb* mb)
     {
         boost::mutex::scoped_lock l(_queue_mutex);
@@ -397,16 +524,22 @@ struct libusb_zero_copy_impl : usb_zero_copy
         const unsigned char send_endpoint,
         const device_addr_t& hints)
     {
+        const size_t num_recv_frames =
+            size_t(hints.cast<double>("num_recv_frames", DEFAULT_NUM_XFERS));
         _recv_impl.reset(new libusb_zero_copy_single(handle,
             recv_interface,
             (recv_endpoint & 0x7f) | 0x80,
-            size_t(hints.cast<double>("num_recv_frames", DEFAULT_NUM_XFERS)),
-            size_t(hints.cast<double>("recv_frame_size", DEFAULT_XFER_SIZE))));
+            num_recv_frames,
+            size_t(hints.cast<double>("recv_frame_size", DEFAULT_XFER_SIZE)),
+            size_t(hints.cast<double>("max_recv_frames", double(num_recv_frames)))));
+        const size_t num_send_frames =
+            size_t(hints.cast<double>("num_send_frames", DEFAULT_NUM_XFERS));
         _send_impl.reset(new libusb_zero_copy_single(handle,
             send_interface,
             (send_endpoint & 0x7f) | 0x00,
-            size_t(hints.cast<double>("num_send_frames", DEFAULT_NUM_XFERS)),
-            size_t(hints.cast<double>("send_frame_size", DEFAULT_XFER_SIZE))));
+            num_send_frames,
+            size_t(hints.cast<double>("send_frame_size", DEFAULT_XFER_SIZE)),
+            num_send_frames));
     }
 
     virtual ~libusb_zero_copy_impl(void);
@@ -441,6 +574,15 @@ struct libusb_zero_copy_impl : usb_zero_copy
         return _send_impl->get_frame_size();
     }
 
+    xfer_stats_t get_recv_xfer_stats(void) const
+    {
+        return _recv_impl->get_stats();
+    }
+    xfer_stats_t get_send_xfer_stats(void) const
+    {
+        return _send_impl->get_stats();
+    }
+
     std::shared_ptr<libusb_zero_copy_single> _recv_impl, _send_impl;
     boost::mutex _recv_mutex, _send_mutex;
 };
@@ -458,6 +600,8 @@ usb_zero_copy::~usb_zero_copy(void)
     /* NOP */
 }
 
+constexpr size_t usb_zero_copy::xfer_stats_t::NUM_LATENCY_BUCKETS;
+
 /***********************************************************************
  * USB zero_copy make functions
  **********************************************************************/
@@ -11,13 +11,20 @@
 #include <uhd/utils/safe_call.hpp>
 #include <boost/thread.hpp>
 #include <boost/thread/locks.hpp>
+#include <algorithm>
+#include <atomic>
 #include <functional>
-#include <map>
 #include <memory>
+#include <thread>
 
 using namespace uhd;
 using namespace uhd::transport;
 
+namespace {
+//! Time between checks whether a stream whose queue is full was removed
+constexpr double PUSH_TIMEOUT = 0.01;
+} // namespace
+
 class muxed_zero_copy_if_impl
     : public muxed_zero_copy_if,
       public std::enable_shared_from_this<muxed_zero_copy_if_impl>
@@ -31,6 +38,8 @@ public:
         : _base_xport(base_xport)
         , _classify(classify_fn)
         , _max_num_streams(max_streams)
+        , _num_slots(_get_num_slots(max_streams))
+        , _slots(new stream_slot[_num_slots])
         , _num_dropped_frames(0)
     {
         // Create the receive thread to poll the underlying transport
@@ -50,28 +59,26 @@ public:
             // there are no timed blocks on the underlying.
             _recv_thread.join();
             // Flush base transport
-            while (_base_xport->get_recv_buff(0.0001)) /*NOP*/;
-            // Release child streams
-            // Note that this will not delete or flush the child streams
-            // until the owners of the streams have released the respective
-            // shared pointers. This ensures that packets are not dropped.
-            _streams.clear(););
+            while (_base_xport->get_recv_buff(0.0001)) /*NOP*/;);
+        // Note that the child streams are not deleted or flushed here. Every
+        // stream holds a reference to this transport, so by the time we get
+        // here, all streams have been destroyed by their owners.
     }
 
     virtual zero_copy_if::sptr make_stream(const uint32_t stream_num)
     {
         boost::lock_guard<boost::mutex> lock(_mutex);
-        if (_streams.size() >= _max_num_streams) {
+        stream_slot* slot = _find_slot(stream_num);
+        if (slot->stream.load() == nullptr && _num_streams >= _max_num_streams) {
             throw uhd::runtime_error("muxed_zero_copy_if: stream capacity exceeded. "
                                      "cannot create more streams.");
         }
-        // Only allocate a portion of the base transport's frames to each stream
-        // to prevent all streams from attempting to use all the frames.
+        // Every stream may queue up all of the base transport's frames.
         stream_impl::sptr stream = std::make_shared<stream_impl>(this->shared_from_this(),
             stream_num,
             _base_xport->get_num_send_frames(),
             _base_xport->get_num_recv_frames());
-        _streams[stream_num]     = stream;
+        _set_slot(slot, stream_num, stream.get());
         return stream;
     }
 
@@ -83,35 +90,119 @@ public:
     void remove_stream(const uint32_t stream_num)
     {
         boost::lock_guard<boost::mutex> lock(_mutex);
-        _streams.erase(stream_num);
+        stream_slot* slot = _lookup(stream_num);
+        if (slot) {
+            _set_slot(slot, stream_num, nullptr);
+        }
     }
 
 private:
+    class stream_impl;
+
     /*
-     * @class stream_mrb is used to copy the data and release the original
-     * managed receive buffer back to the base transport.
+     * Entry of the stream lookup table. The table is only written to while
+     * holding _mutex, but the receive thread reads it without locking.
+     *
+     * The key of a slot never goes back to EMPTY_KEY, so the probe sequence
+     * of a stream is never cut short by the removal of another stream. A
+     * slot whose stream was removed can be taken by any new stream.
      */
-    class stream_mrb : public managed_recv_buffer
+    struct stream_slot
     {
-    public:
-        stream_mrb(size_t size) : _buff(new char[size]) {}
+        static constexpr uint64_t EMPTY_KEY = ~uint64_t(0);
+        std::atomic<uint64_t> key{EMPTY_KEY};
+        std::atomic<stream_impl*> stream{nullptr};
+    };
 
-        ~stream_mrb()
-        {
-            delete[] _buff;
+    static size_t _get_num_slots(const size_t max_streams)
+    {
+        // Keep the table at most half full, so the probe sequences stay short
+        size_t num_slots = 1;
+        while (num_slots < 2 * std::max<size_t>(max_streams, 1)) {
+            num_slots <<= 1;
         }
+        return num_slots;
+    }
 
-        void release() {}
+    UHD_INLINE size_t _get_first_slot(const uint32_t stream_num) const
+    {
+        return (stream_num * 0x9E3779B1u) & (_num_slots - 1);
+    }
 
-        UHD_INLINE sptr get_new(char* buff, size_t len)
-        {
-            memcpy(_buff, buff, len);
-            return make(this, _buff, len);
+    /*!
+     * Return the slot of the given stream, or nullptr if it has none. This
+     * is what the receive thread uses, and does not need _mutex.
+     */
+    UHD_INLINE stream_slot* _lookup(const uint32_t stream_num) const
+    {
+        size_t idx = _get_first_slot(stream_num);
+        for (size_t i = 0; i < _num_slots; i++) {
+            const uint64_t key = _slots[idx].key.load(std::memory_order_acquire);
+            if (key == stream_num) {
+                return &_slots[idx];
+            }
+            if (key == stream_slot::EMPTY_KEY) {
+                return nullptr;
+            }
+            idx = (idx + 1) & (_num_slots - 1);
         }
+        return nullptr;
+    }
 
-    private:
-        char* _buff;
-    };
+    /*!
+     * Return the slot to use for the given stream: The slot that already has
+     * its key, or else the first slot of its probe sequence that is unused.
+     * Must be called with _mutex held.
+     */
+    stream_slot* _find_slot(const uint32_t stream_num)
+    {
+        stream_slot* slot = _lookup(stream_num);
+        if (slot) {
+            return slot;
+        }
+        size_t idx = _get_first_slot(stream_num);
+        for (size_t i = 0; i < _num_slots; i++) {
+            slot = &_slots[idx];
+            if (slot->stream.load() == nullptr) {
+                return slot;
+            }
+            idx = (idx + 1) & (_num_slots - 1);
+        }
+        // Can't happen, there are more slots than streams
+        UHD_THROW_INVALID_CODE_PATH();
+    }
+
+    /*!
+     * Make the slot point to a new stream (or to none). When a stream is
+     * replaced, wait for the receive thread to stop using it. Must be called
+     * with _mutex held.
+     */
+    void _set_slot(stream_slot* slot, const uint32_t stream_num, stream_impl* stream)
+    {
+        if (slot->key.load() != stream_num) {
+            slot->key.store(stream_num, std::memory_order_release);
+        }
+        stream_impl* old_stream = slot->stream.exchange(stream);
+        if (old_stream) {
+            _num_streams--;
+        }
+        if (stream) {
+            _num_streams++;
+        }
+        while (old_stream && _stream_in_use.load() == old_stream) {
+            std::this_thread::yield();
+        }
+    }
+
+    //! Remove a stream from its slot, unless another stream has taken it
+    void _remove_stream(const uint32_t stream_num, stream_impl* stream)
+    {
+        boost::lock_guard<boost::mutex> lock(_mutex);
+        stream_slot* slot = _lookup(stream_num);
+        if (slot && slot->stream.load() == stream) {
+            _set_slot(slot, stream_num, nullptr);
+        }
+    }
 
     class stream_impl : public zero_copy_if
     {
@@ -130,19 +221,14 @@ private:
             , _num_recv_frames(num_recv_frames)
             , _recv_frame_size(_muxed_xport->base_xport()->get_recv_frame_size())
             , _buff_queue(num_recv_frames)
-            , _buffers(num_recv_frames)
-            , _buffer_index(0)
         {
-            for (size_t i = 0; i < num_recv_frames; i++) {
-                _buffers[i] = std::make_shared<stream_mrb>(_recv_frame_size);
-            }
         }
 
         ~stream_impl(void)
         {
             // First remove the stream from muxed transport
             // so no more frames are pushed in
-            _muxed_xport->remove_stream(_stream_num);
+            _muxed_xport->_remove_stream(_stream_num, this);
             // Flush the transport
             managed_recv_buffer::sptr buff;
             while (_buff_queue.pop_with_haste(buff)) {
@@ -170,11 +256,22 @@ private:
             }
         }
 
-        void push_recv_buff(managed_recv_buffer::sptr buff)
+        /*!
+         * Queue a frame of the base transport. The frame is handed to the
+         * consumer as-is, and goes back to the base transport when the
+         * consumer releases it.
+         *
+         * \return true if the frame was queued, or false if the stream was
+         *         removed while waiting for space in the queue
+         */
+        bool push_recv_buff(managed_recv_buffer::sptr& buff, const stream_slot* slot)
         {
-            _buff_queue.push_with_wait(
-                _buffers.at(_buffer_index++)->get_new(buff->cast<char*>(), buff->size()));
-            _buffer_index %= _buffers.size();
+            while (!_buff_queue.push_with_timed_wait(buff, PUSH_TIMEOUT)) {
+                if (slot->stream.load() != this) {
+                    return false;
+                }
+            }
+            return true;
         }
 
         size_t get_num_send_frames(void) const
@@ -200,8 +297,6 @@ private:
         const size_t _num_recv_frames;
         const size_t _recv_frame_size;
         bounded_buffer<managed_recv_buffer::sptr> _buff_queue;
-        std::vector<std::shared_ptr<stream_mrb>> _buffers;
-        size_t _buffer_index;
     };
 
     inline zero_copy_if::sptr& base_xport()
@@ -249,28 +344,27 @@ private:
     {
         managed_recv_buffer::sptr buff = _base_xport->get_recv_buff(0.0);
         if (buff) {
-            stream_impl::sptr stream;
+            const stream_slot* slot = nullptr;
             try {
                 const uint32_t stream_num =
                     _classify(buff->cast<void*>(), _base_xport->get_recv_frame_size());
-                {
-                    // Hold the stream mutex long enough to pull a bounded buffer
-                    // and lock it (increment its ref count).
-                    boost::lock_guard<boost::mutex> lock(_mutex);
-                    stream_map_t::iterator str_iter = _streams.find(stream_num);
-                    if (str_iter != _streams.end()) {
-                        stream = (*str_iter).second.lock();
-                    }
-                }
+                slot = _lookup(stream_num);
             } catch (std::exception&) {
                 // If _classify throws we simply drop the frame
             }
-            // Once a bounded buffer is acquired, we can rely on its
-            // thread safety to serialize with the consumer.
-            if (stream.get()) {
-                stream->push_recv_buff(buff);
-            } else {
-                boost::lock_guard<boost::mutex> lock(_mutex);
+            // Announce which stream we're about to use before checking that it
+            // is still registered, so it can't be destroyed under our feet.
+            // The bounded buffer serializes with the consumer.
+            stream_impl* stream = slot ? slot->stream.load() : nullptr;
+            bool queued         = false;
+            if (stream) {
+                _stream_in_use.store(stream);
+                if (slot->stream.load() == stream) {
+                    queued = stream->push_recv_buff(buff, slot);
+                }
+                _stream_in_use.store(nullptr);
+            }
+            if (!queued) {
                 _num_dropped_frames++;
             }
             // We processed a packet, and there could be more coming
@@ -283,14 +377,18 @@ private:
         }
     }
 
-    typedef std::map<uint32_t, stream_impl::wptr> stream_map_t;
-
     zero_copy_if::sptr _base_xport;
     stream_classifier_fn _classify;
-    stream_map_t _streams;
     const size_t _max_num_streams;
-    size_t _num_dropped_frames;
+    //! Stream lookup table, a power of two in size
+    const size_t _num_slots;
+    std::unique_ptr<stream_slot[]> _slots;
+    size_t _num_streams = 0;
+    //! The stream the receive thread is pushing a frame to, if any
+    std::atomic<stream_impl*> _stream_in_use{nullptr};
+    std::atomic<size_t> _num_dropped_frames;
     boost::thread _recv_thread;
+    //! Serializes changes to the stream lookup table
     boost::mutex _mutex;
 };
 
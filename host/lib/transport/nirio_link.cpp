@@ -9,6 +9,7 @@
 #include <uhdlib/transport/adapter.hpp>
 #include <uhdlib/transport/links.hpp>
 #include <uhdlib/transport/nirio_link.hpp>
+#include <algorithm>
 #include <chrono>
 
 // X300 regs
@@ -40,6 +41,9 @@ size_t get_page_size()
 #endif
 const size_t page_size = get_page_size();
 
+//! Default number of received frames to release to the DMA engine at a time
+constexpr size_t DEFAULT_RECV_RELEASE_BATCH = 16;
+
 } // namespace
 
 #define PROXY _fpga_session->get_kernel_proxy()
@@ -49,12 +53,15 @@ const size_t page_size = get_page_size();
  *****************************************************************************/
 nirio_link::nirio_link(uhd::niusrprio::niusrprio_session::sptr fpga_session,
     uint32_t instance,
-    const link_params_t& params)
+    const link_params_t& params,
+    const size_t recv_release_batch)
     : recv_link_base_t(params.num_recv_frames, params.recv_frame_size)
     , send_link_base_t(params.num_send_frames, params.send_frame_size)
     , _fpga_session(fpga_session)
     , _fifo_instance(instance)
     , _link_params(params)
+    , _recv_grant_threshold(
+          recv_release_batch * params.recv_frame_size / sizeof(fifo_data_t))
 {
     UHD_LOG_TRACE("NIRIO", "Creating PCIe transport for channel " << instance);
     UHD_LOGGER_TRACE("NIRIO")
@@ -159,7 +166,7 @@ nirio_link::~nirio_link()
     PROXY->poke(PCIE_TX_DMA_REG(DMA_CTRL_STATUS_REG, _fifo_instance), DMA_CTRL_DISABLED);
     PROXY->poke(PCIE_RX_DMA_REG(DMA_CTRL_STATUS_REG, _fifo_instance), DMA_CTRL_DISABLED);
 
-    UHD_SAFE_CALL(_flush_rx_buff();)
+    UHD_SAFE_CALL(_grant_recv_elems(); _flush_rx_buff();)
 
     // Stop DMA channels. Stop is called in the fifo dtor but
     // it doesn't hurt to do it here.
@@ -297,7 +304,19 @@ nirio_link::sptr nirio_link::make(uhd::niusrprio::niusrprio_session::sptr fpga_s
     recv_buff_size = link_params.num_recv_frames * link_params.recv_frame_size;
     send_buff_size = link_params.num_send_frames * link_params.send_frame_size;
 
-    return nirio_link::sptr(new nirio_link(fpga_session, instance, link_params));
+    // Releasing received frames in batches saves calls into the driver, but the
+    // DMA engine can't use their space in the meantime. Keep most of the buffer
+    // available to it.
+    const size_t recv_release_batch = std::max<size_t>(1,
+        std::min<size_t>(link_params.num_recv_frames / 4,
+            size_t(hints.cast<double>(
+                "recv_release_batch", double(DEFAULT_RECV_RELEASE_BATCH)))));
+    UHD_LOG_TRACE("NIRIO",
+        "Releasing received frames to the DMA engine in batches of "
+            << recv_release_batch);
+
+    return nirio_link::sptr(
+        new nirio_link(fpga_session, instance, link_params, recv_release_batch));
 }
 
 
@@ -6,18 +6,25 @@
 
 #include <uhd/config.hpp>
 #include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/realtime.hpp>
 #include <uhd/utils/thread.hpp>
 #include <uhdlib/transport/frame_reservation_mgr.hpp>
+#include <uhdlib/transport/hybrid_wait.hpp>
 #include <uhdlib/transport/offload_io_service.hpp>
 #include <uhdlib/transport/offload_io_service_client.hpp>
-#include <uhdlib/utils/semaphore.hpp>
+#include <uhdlib/transport/shared_frame_pool.hpp>
+#include <uhdlib/utils/spsc_queue.hpp>
+#include <uhdlib/utils/trace.hpp>
 #include <condition_variable>
 #include <boost/lockfree/queue.hpp>
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <functional>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <thread>
 
 namespace uhd { namespace transport {
@@ -26,74 +33,11 @@ namespace {
 
 constexpr int32_t blocking_timeout_ms = 10;
 
-// Fixed-size queue that supports blocking semantics
-template <typename queue_item_t>
-class offload_thread_queue
-{
-public:
-    offload_thread_queue(size_t size) : _buffer(new queue_item_t[size]), _capacity(size)
-    {
-    }
-
-    ~offload_thread_queue()
-    {
-        delete[] _buffer;
-    }
-
-    void push(const queue_item_t& item)
-    {
-        _buffer[_write_index++] = item;
-        _write_index %= _capacity;
-        _item_sem.notify();
-    }
-
-    bool peek(queue_item_t& item)
-    {
-        if (_item_sem.count()) {
-            item = _buffer[_read_index];
-            return true;
-        } else {
-            return false;
-        }
-    }
-
-    bool pop(queue_item_t& item)
-    {
-        if (_item_sem.try_wait()) {
-            item = _buffer[_read_index++];
-            _read_index %= _capacity;
-            return true;
-        } else {
-            return false;
-        }
-    }
-
-    bool pop(queue_item_t& item, int32_t timeout_ms)
-    {
-        if (_item_sem.wait_for(timeout_ms)) {
-            item = _buffer[_read_index++];
-            _read_index %= _capacity;
-            return true;
-        } else {
-            return false;
-        }
-    }
-
-    size_t read_available()
-    {
-        return _item_sem.count();
-    }
-
-private:
-    queue_item_t* _buffer;
-    const size_t _capacity;
-
-    size_t _read_index  = 0;
-    size_t _write_index = 0;
-
-    // Semaphore gating number of items available to read
-    semaphore _item_sem;
-};
+// How often the poll threads are balanced, if there are several of them
+constexpr auto rebalance_interval = std::chrono::milliseconds(100);
+// The fraction by which moving a link group must lower the load of the busiest
+// poll thread. This keeps groups from moving back and forth on small changes.
+constexpr double rebalance_min_gain = 0.1;
 
 // Object that implements the communication between client and offload thread
 struct client_port_impl_t
@@ -132,9 +76,13 @@ public:
     void client_push(frame_buff* buff)
     {
         to_offload_thread_t queue_element{buff, false};
-        _to_offload_thread.push(queue_element);
+        const bool pushed = _to_offload_thread.push(queue_element);
+        UHD_ASSERT_THROW(pushed);
     }
 
+    // Notifies clients of frames pushed by the offload thread
+    recv_ready_notifier ready_notifier;
+
     void client_wait_until_connected()
     {
         std::unique_lock<std::mutex> lock(_connect_cv_mutex);
@@ -144,7 +92,8 @@ public:
     void client_disconnect()
     {
         to_offload_thread_t queue_element{nullptr, true};
-        _to_offload_thread.push(queue_element);
+        const bool pushed = _to_offload_thread.push(queue_element);
+        UHD_ASSERT_THROW(pushed);
 
         // Need to wait for the disconnect to occur before returning, since the
         // caller (the xport object) has callbacks installed in the inline I/O
@@ -159,7 +108,9 @@ public:
     void offload_thread_push(frame_buff* buff)
     {
         from_offload_thread_t queue_element{buff};
-        _from_offload_thread.push(queue_element);
+        const bool pushed = _from_offload_thread.push(queue_element);
+        UHD_ASSERT_THROW(pushed);
+        ready_notifier.notify();
     }
 
     std::tuple<frame_buff*, bool> offload_thread_peek()
@@ -214,7 +165,7 @@ private:
         frame_buff* buff = nullptr;
     };
 
-    using from_offload_thread_queue_t = offload_thread_queue<from_offload_thread_t>;
+    using from_offload_thread_queue_t = spsc_queue<from_offload_thread_t>;
 
     // Queue for frame buffers and disconnect requests to offload thread. Disconnect
     // requests must be inline with incoming buffers to avoid any race conditions
@@ -225,9 +176,10 @@ private:
         bool disconnect  = false;
     };
 
-    using to_offload_thread_queue_t = offload_thread_queue<to_offload_thread_t>;
+    using to_offload_thread_queue_t = spsc_queue<to_offload_thread_t>;
 
-    // Queues to carry frame buffers in both directions
+    // Queues to carry frame buffers in both directions. Neither can overflow,
+    // since the number of frames in flight is bounded by the reservation.
     from_offload_thread_queue_t _from_offload_thread;
     to_offload_thread_queue_t _to_offload_thread;
 
@@ -247,6 +199,14 @@ private:
 // Requests to create new clients are handled using a separate mpsc queue. Client
 // requests to disconnect are sent in the same spsc queue as the buffers so that
 // they are processed only after all buffer release requestss have been processed.
+//
+// In POLL mode, several offload threads can share the work. Clients that share
+// links form a link group, which is always served by one thread at a time, so
+// the packets of each link stay in order. The first thread executes the client
+// requests, and periodically moves a group from the busiest thread to the
+// idlest one, based on the number of frames each group passed. Each thread
+// holds its own mutex while it serves its groups, so the first thread takes
+// the mutexes of all threads to change the groups.
 class offload_io_service_impl
     : public offload_io_service,
       public std::enable_shared_from_this<offload_io_service_impl>
@@ -300,7 +260,11 @@ private:
         client_port_t::sptr port;
         recv_io_if::sptr inline_io;
         size_t num_frames_in_use = 0;
+        //! The reservation, plus the frames the link may borrow from the
+        //! shared frame pool
+        size_t max_frames_in_use = 0;
         frame_reservation_t frames_reserved;
+        hybrid_wait wait;
     };
     struct send_client_info_t
     {
@@ -308,39 +272,102 @@ private:
         send_io_if::sptr inline_io;
         size_t num_frames_in_use = 0;
         frame_reservation_t frames_reserved;
+        hybrid_wait wait;
+    };
+
+    struct offload_thread_t;
+
+    // Clients that share links, along with those links
+    struct link_group_t
+    {
+        //! The links of the group, by the address of the link object
+        std::vector<const void*> links;
+        std::list<recv_client_info_t> recv_clients;
+        std::list<send_client_info_t> send_clients;
+        //! The number of frames the clients passed, in total and during the
+        //! last rebalance interval. Only accessed with the thread mutex held.
+        uint64_t num_frames      = 0;
+        uint64_t last_num_frames = 0;
+        uint64_t load            = 0;
+        offload_thread_t* thread = nullptr;
     };
 
+    struct offload_thread_t
+    {
+        size_t index = 0;
+        std::vector<size_t> cpu_affinity_list;
+        std::unique_ptr<std::thread> thread;
+        //! Held by the thread while it serves its groups
+        std::mutex mutex;
+        std::vector<link_group_t*> groups;
+    };
+
+    using thread_locks_t = std::vector<std::unique_lock<std::mutex>>;
+
     void _queue_client_req(std::function<void()> fn);
+    void _attach_shared_frame_pool(recv_link_if::sptr link);
     void _get_recv_buff(recv_client_info_t& info, int32_t timeout_ms);
     void _get_send_buff(send_client_info_t& info);
+    bool _wait_for_dest_ready(
+        send_client_info_t& info, frame_buff* buff, int32_t timeout_ms);
     void _release_recv_buff(recv_client_info_t& info, frame_buff* buff);
     void _release_send_buff(send_client_info_t& info, frame_buff* buff);
     void _disconnect_recv_client(recv_client_info_t& info);
     void _disconnect_send_client(send_client_info_t& info);
 
+    template <typename link_t>
+    static const void* _get_link_key(const std::shared_ptr<link_t>& link)
+    {
+        // Links that are both send and recv links must have a single key
+        return link ? dynamic_cast<const void*>(link.get()) : nullptr;
+    }
+    link_group_t& _get_link_group(const std::vector<const void*>& links);
+    void _remove_unused_link_groups();
+    offload_thread_t* _get_idlest_thread() const;
+    thread_locks_t _lock_all_threads();
+    void _exec_client_req(client_req_t& client_req);
+    void _rebalance();
+
     template <bool allow_recv, bool allow_send>
-    void _do_work_polling();
+    void _do_work_polling(offload_thread_t& thread);
 
     template <bool allow_recv, bool allow_send>
-    void _do_work_blocking();
+    size_t _poll_link_group(link_group_t& group);
+
+    template <bool allow_recv, bool allow_send>
+    void _do_work_blocking(offload_thread_t& thread);
+
+    //! Returns how long clients spin before they block
+    size_t _get_max_spin_us() const
+    {
+        return _offload_thread_params.wait_mode == HYBRID
+                   ? _offload_thread_params.max_spin_us
+                   : 0;
+    }
 
     // The I/O service that executes within the offload thread
     io_service::sptr _io_srv;
 
-    // Offload thread, its stop flag, and thread-related parameters
-    std::unique_ptr<std::thread> _offload_thread;
+    // Offload threads, their stop flag, and thread-related parameters
+    std::vector<std::unique_ptr<offload_thread_t>> _offload_threads;
     std::atomic<bool> _stop_offload_thread{false};
     offload_io_service::params_t _offload_thread_params;
 
-    // Lists of clients and their respective queues
-    std::list<recv_client_info_t> _recv_clients;
-    std::list<send_client_info_t> _send_clients;
+    // The link groups, with the clients and their respective queues. The list
+    // is only changed with the mutexes of all threads held.
+    std::list<link_group_t> _link_groups;
+
+    // The links attached to the I/O service
+    std::vector<const void*> _attached_links;
 
     // Queue for connect and disconnect client requests
     client_req_queue_t _client_connect_queue;
 
     // Keep track of frame reservations
     frame_reservation_mgr _reservation_mgr;
+
+    // Receive frames shared by the recv links, only used by the offload thread
+    shared_frame_pool::sptr _shared_pool;
 };
 
 //
@@ -361,30 +388,55 @@ offload_io_service_impl::offload_io_service_impl(
     , _offload_thread_params(params)
     , _client_connect_queue(10) // arbitrary initial size
 {
-    if (params.wait_mode == BLOCK && params.client_type == BOTH_SEND_AND_RECV) {
+    if ((params.wait_mode == BLOCK || params.wait_mode == HYBRID)
+        && params.client_type == BOTH_SEND_AND_RECV) {
         throw uhd::value_error(
             "An I/O service configured to block should only service either "
             "send or recv clients to prevent one client type from starving "
             "the other");
     }
 
-    std::function<void()> thread_fn;
+    if (params.num_poll_threads == 0) {
+        throw uhd::value_error("An I/O service needs at least one offload thread");
+    }
+    if (params.num_poll_threads > 1 && params.wait_mode != POLL) {
+        throw uhd::value_error(
+            "Only an I/O service configured to poll can have several offload threads");
+    }
+    if (params.num_poll_threads > 1 && params.num_shared_recv_frames > 0) {
+        // The shared frame pool can only be used by a single thread
+        throw uhd::value_error("An I/O service with several offload threads cannot "
+                               "share receive frames among its links");
+    }
 
-    if (params.wait_mode == BLOCK) {
+    std::function<void(offload_thread_t&)> thread_fn;
+
+    if (params.wait_mode == BLOCK || params.wait_mode == HYBRID) {
+        // The hybrid mode only differs in how the clients wait
         if (params.client_type == RECV_ONLY) {
-            thread_fn = [this]() { _do_work_blocking<true, false>(); };
+            thread_fn = [this](offload_thread_t& t) {
+                _do_work_blocking<true, false>(t);
+            };
         } else if (params.client_type == SEND_ONLY) {
-            thread_fn = [this]() { _do_work_blocking<false, true>(); };
+            thread_fn = [this](offload_thread_t& t) {
+                _do_work_blocking<false, true>(t);
+            };
         } else {
             UHD_THROW_INVALID_CODE_PATH();
         }
     } else if (params.wait_mode == POLL) {
         if (params.client_type == RECV_ONLY) {
-            thread_fn = [this]() { _do_work_polling<true, false>(); };
+            thread_fn = [this](offload_thread_t& t) {
+                _do_work_polling<true, false>(t);
+            };
         } else if (params.client_type == SEND_ONLY) {
-            thread_fn = [this]() { _do_work_polling<false, true>(); };
+            thread_fn = [this](offload_thread_t& t) {
+                _do_work_polling<false, true>(t);
+            };
         } else if (params.client_type == BOTH_SEND_AND_RECV) {
-            thread_fn = [this]() { _do_work_polling<true, true>(); };
+            thread_fn = [this](offload_thread_t& t) {
+                _do_work_polling<true, true>(t);
+            };
         } else {
             UHD_THROW_INVALID_CODE_PATH();
         }
@@ -392,19 +444,38 @@ offload_io_service_impl::offload_io_service_impl(
         UHD_THROW_INVALID_CODE_PATH();
     }
 
-    _offload_thread = std::make_unique<std::thread>(thread_fn);
+    // Create all threads before starting them, the first one accesses the others
+    for (size_t i = 0; i < params.num_poll_threads; i++) {
+        auto offload_thread   = std::make_unique<offload_thread_t>();
+        offload_thread->index = i;
+        offload_thread->cpu_affinity_list =
+            i < params.thread_cpu_affinity_lists.size()
+                ? params.thread_cpu_affinity_lists[i]
+                : params.cpu_affinity_list;
+        _offload_threads.push_back(std::move(offload_thread));
+    }
+    for (auto& offload_thread : _offload_threads) {
+        offload_thread->thread = std::make_unique<std::thread>(
+            [thread_fn, &t = *offload_thread]() { thread_fn(t); });
+    }
 }
 
 offload_io_service_impl::~offload_io_service_impl()
 {
     _stop_offload_thread = true;
 
-    if (_offload_thread) {
-        _offload_thread->join();
+    for (auto& offload_thread : _offload_threads) {
+        if (offload_thread->thread) {
+            offload_thread->thread->join();
+        }
     }
 
-    assert(_recv_clients.empty());
-    assert(_send_clients.empty());
+#ifndef NDEBUG
+    for (const auto& group : _link_groups) {
+        assert(group.recv_clients.empty());
+        assert(group.send_clients.empty());
+    }
+#endif
 }
 
 void offload_io_service_impl::attach_recv_link(recv_link_if::sptr link)
@@ -412,7 +483,10 @@ void offload_io_service_impl::attach_recv_link(recv_link_if::sptr link)
     // Create a request to attach link in the offload thread
     auto req_fn = [this, link]() {
         _reservation_mgr.register_link(link);
+        _attach_shared_frame_pool(link);
         _io_srv->attach_recv_link(link);
+        _attached_links.push_back(_get_link_key(link));
+        _get_link_group({_get_link_key(link)});
     };
 
     _queue_client_req(req_fn);
@@ -424,6 +498,8 @@ void offload_io_service_impl::attach_send_link(send_link_if::sptr link)
     auto req_fn = [this, link]() {
         _reservation_mgr.register_link(link);
         _io_srv->attach_send_link(link);
+        _attached_links.push_back(_get_link_key(link));
+        _get_link_group({_get_link_key(link)});
     };
 
     client_req_t queue_element;
@@ -440,6 +516,14 @@ void offload_io_service_impl::detach_recv_link(recv_link_if::sptr link)
     auto req_fn = [this, link]() {
         _reservation_mgr.unregister_link(link);
         _io_srv->detach_recv_link(link);
+        if (link->get_num_shared_recv_frames() > 0) {
+            link->set_shared_frame_pool(nullptr);
+        }
+        auto it = std::find(
+            _attached_links.begin(), _attached_links.end(), _get_link_key(link));
+        if (it != _attached_links.end()) {
+            _attached_links.erase(it);
+        }
     };
 
     _queue_client_req(req_fn);
@@ -451,6 +535,11 @@ void offload_io_service_impl::detach_send_link(send_link_if::sptr link)
     auto req_fn = [this, link]() {
         _reservation_mgr.unregister_link(link);
         _io_srv->detach_send_link(link);
+        auto it = std::find(
+            _attached_links.begin(), _attached_links.end(), _get_link_key(link));
+        if (it != _attached_links.end()) {
+            _attached_links.erase(it);
+        }
     };
 
     _queue_client_req(req_fn);
@@ -463,13 +552,15 @@ recv_io_if::sptr offload_io_service_impl::make_recv_client(recv_link_if::sptr re
     size_t num_send_frames,
     recv_io_if::fc_callback_t fc_cb)
 {
-    UHD_ASSERT_THROW(_offload_thread);
+    UHD_ASSERT_THROW(!_offload_threads.empty());
 
     if (_offload_thread_params.client_type == SEND_ONLY) {
         throw uhd::runtime_error("Recv client not supported by this I/O service");
     }
 
-    auto port = std::make_shared<client_port_t>(num_recv_frames);
+    // Leave room for the frames the link may borrow from the shared pool
+    auto port = std::make_shared<client_port_t>(
+        num_recv_frames + _offload_thread_params.num_shared_recv_frames);
 
     // Create a request to create a new receiver in the offload thread
     auto req_fn =
@@ -478,15 +569,21 @@ recv_io_if::sptr offload_io_service_impl::make_recv_client(recv_link_if::sptr re
                 recv_link, num_recv_frames, fc_link, num_send_frames};
             _reservation_mgr.reserve_frames(frames);
 
+            // Only the client's own frames are reserved from the link
+            const size_t max_recv_frames =
+                num_recv_frames + recv_link->get_num_shared_recv_frames();
             auto inline_recv_io = _io_srv->make_recv_client(
-                recv_link, num_recv_frames, cb, fc_link, num_send_frames, fc_cb);
+                recv_link, max_recv_frames, cb, fc_link, num_send_frames, fc_cb);
 
             recv_client_info_t client_info;
-            client_info.inline_io       = inline_recv_io;
-            client_info.port            = port;
-            client_info.frames_reserved = frames;
+            client_info.inline_io         = inline_recv_io;
+            client_info.port              = port;
+            client_info.max_frames_in_use = max_recv_frames;
+            client_info.frames_reserved   = frames;
+            client_info.wait              = hybrid_wait(_get_max_spin_us());
 
-            _recv_clients.push_back(client_info);
+            _get_link_group({_get_link_key(recv_link), _get_link_key(fc_link)})
+                .recv_clients.push_back(client_info);
 
             // Notify that the connection is created
             port->offload_thread_set_connected(true);
@@ -501,7 +598,11 @@ recv_io_if::sptr offload_io_service_impl::make_recv_client(recv_link_if::sptr re
             shared_from_this(), num_recv_frames, num_send_frames, port);
     } else {
         return std::make_shared<offload_recv_io<offload_io_service_impl, false>>(
-            shared_from_this(), num_recv_frames, num_send_frames, port);
+            shared_from_this(),
+            num_recv_frames,
+            num_send_frames,
+            port,
+            _get_max_spin_us());
     }
 }
 
@@ -513,7 +614,7 @@ send_io_if::sptr offload_io_service_impl::make_send_client(send_link_if::sptr se
     recv_callback_t recv_cb,
     send_io_if::fc_callback_t fc_cb)
 {
-    UHD_ASSERT_THROW(_offload_thread);
+    UHD_ASSERT_THROW(!_offload_threads.empty());
 
     if (_offload_thread_params.client_type == RECV_ONLY) {
         throw uhd::runtime_error("Send client not supported by this I/O service");
@@ -547,8 +648,10 @@ send_io_if::sptr offload_io_service_impl::make_send_client(send_link_if::sptr se
         client_info.inline_io       = inline_send_io;
         client_info.port            = port;
         client_info.frames_reserved = frames;
+        client_info.wait            = hybrid_wait(_get_max_spin_us());
 
-        _send_clients.push_back(client_info);
+        _get_link_group({_get_link_key(send_link), _get_link_key(recv_link)})
+            .send_clients.push_back(client_info);
 
         // Notify that the connection is created
         port->offload_thread_set_connected(true);
@@ -568,7 +671,11 @@ send_io_if::sptr offload_io_service_impl::make_send_client(send_link_if::sptr se
             shared_from_this(), num_recv_frames, num_send_frames, port);
     } else {
         return std::make_shared<offload_send_io<offload_io_service_impl, false>>(
-            shared_from_this(), num_recv_frames, num_send_frames, port);
+            shared_from_this(),
+            num_recv_frames,
+            num_send_frames,
+            port,
+            _get_max_spin_us());
     }
 }
 
@@ -582,13 +689,36 @@ void offload_io_service_impl::_queue_client_req(std::function<void()> fn)
     }
 }
 
+// Let a recv link borrow from the shared frame pool, creating the pool for the
+// first link
+void offload_io_service_impl::_attach_shared_frame_pool(recv_link_if::sptr link)
+{
+    if (_offload_thread_params.num_shared_recv_frames == 0) {
+        return;
+    }
+    if (!_shared_pool) {
+        _shared_pool = shared_frame_pool::make(
+            _offload_thread_params.num_shared_recv_frames, link->get_recv_frame_size());
+    }
+    if (!link->set_shared_frame_pool(_shared_pool)) {
+        UHD_LOG_DEBUG("IO_SRV", "Recv link does not use the shared frame pool");
+    }
+}
+
 // Get a single receive buffer if available and update client info
 void offload_io_service_impl::_get_recv_buff(recv_client_info_t& info, int32_t timeout_ms)
 {
-    if (info.num_frames_in_use < info.frames_reserved.num_recv_frames) {
-        if (frame_buff::uptr buff = info.inline_io->get_recv_buff(timeout_ms)) {
+    if (info.num_frames_in_use < info.max_frames_in_use) {
+        frame_buff::uptr buff = info.wait.wait(
+            [&info]() { return info.inline_io->get_recv_buff(0); },
+            [&info](const int32_t timeout) {
+                return info.inline_io->get_recv_buff(timeout);
+            },
+            timeout_ms);
+        if (buff) {
             info.port->offload_thread_push(buff.release());
             info.num_frames_in_use++;
+            UHD_TRACE(OFFLOAD_PUSH, info.num_frames_in_use);
         }
     }
 }
@@ -604,6 +734,21 @@ void offload_io_service_impl::_get_send_buff(send_client_info_t& info)
     }
 }
 
+// Wait until the destination of a send buffer can accept it
+bool offload_io_service_impl::_wait_for_dest_ready(
+    send_client_info_t& info, frame_buff* buff, int32_t timeout_ms)
+{
+    const size_t num_bytes = buff->packet_size();
+    return info.wait.wait(
+        [&info, num_bytes]() {
+            return info.inline_io->wait_for_dest_ready(num_bytes, 0);
+        },
+        [&info, num_bytes](const int32_t timeout) {
+            return info.inline_io->wait_for_dest_ready(num_bytes, timeout);
+        },
+        timeout_ms);
+}
+
 // Release a single recv buffer and update client info
 void offload_io_service_impl::_release_recv_buff(
     recv_client_info_t& info, frame_buff* buff)
@@ -651,135 +796,340 @@ void offload_io_service_impl::_disconnect_send_client(send_client_info_t& info)
     info.port->offload_thread_set_connected(false);
 }
 
-template <bool allow_recv, bool allow_send>
-void offload_io_service_impl::_do_work_polling()
+// Find the group of a client or link. If the links are in several groups, the
+// groups are merged. Must be called with the mutexes of all threads held.
+offload_io_service_impl::link_group_t& offload_io_service_impl::_get_link_group(
+    const std::vector<const void*>& links)
 {
-    uhd::set_thread_affinity(_offload_thread_params.cpu_affinity_list);
+    auto has_link = [&links](const link_group_t& group) {
+        for (const void* link : links) {
+            if (link
+                && std::find(group.links.begin(), group.links.end(), link)
+                       != group.links.end()) {
+                return true;
+            }
+        }
+        return false;
+    };
 
-    client_req_t client_req;
+    auto group_it = std::find_if(_link_groups.begin(), _link_groups.end(), has_link);
+    if (group_it == _link_groups.end()) {
+        _link_groups.emplace_back();
+        group_it         = std::prev(_link_groups.end());
+        group_it->thread = _get_idlest_thread();
+        group_it->thread->groups.push_back(&*group_it);
+    }
+    link_group_t& group = *group_it;
 
-    while (!_stop_offload_thread) {
-        if (allow_recv) {
-            // Get recv buffers
-            for (auto& recv_info : _recv_clients) {
-                _get_recv_buff(recv_info, 0);
-            }
+    // Merge the other groups that share a link into this one
+    for (auto it = std::next(group_it); it != _link_groups.end();) {
+        if (!has_link(*it)) {
+            ++it;
+            continue;
+        }
+        group.links.insert(group.links.end(), it->links.begin(), it->links.end());
+        group.recv_clients.splice(group.recv_clients.end(), it->recv_clients);
+        group.send_clients.splice(group.send_clients.end(), it->send_clients);
+        auto& old_groups = it->thread->groups;
+        old_groups.erase(std::find(old_groups.begin(), old_groups.end(), &*it));
+        it = _link_groups.erase(it);
+    }
 
-            // Release recv buffers
-            for (auto it = _recv_clients.begin(); it != _recv_clients.end();) {
-                frame_buff* buff;
-                bool disconnect;
-                std::tie(buff, disconnect) = it->port->offload_thread_pop();
-                if (buff) {
-                    _release_recv_buff(*it, buff);
-                } else if (disconnect) {
-                    _disconnect_recv_client(*it);
-                    it = _recv_clients.erase(it); // increments it
-                    continue;
-                }
-                ++it;
-            }
+    for (const void* link : links) {
+        if (link
+            && std::find(group.links.begin(), group.links.end(), link)
+                   == group.links.end()) {
+            group.links.push_back(link);
+        }
+    }
+    return group;
+}
+
+// Remove the groups that have neither clients nor attached links. Must be
+// called with the mutexes of all threads held.
+void offload_io_service_impl::_remove_unused_link_groups()
+{
+    for (auto it = _link_groups.begin(); it != _link_groups.end();) {
+        if (!it->recv_clients.empty() || !it->send_clients.empty()) {
+            ++it;
+            continue;
+        }
+        // Without clients, a group only needs to remember the attached links
+        auto& links = it->links;
+        links.erase(std::remove_if(links.begin(),
+                        links.end(),
+                        [this](const void* link) {
+                            return std::find(_attached_links.begin(),
+                                       _attached_links.end(),
+                                       link)
+                                   == _attached_links.end();
+                        }),
+            links.end());
+        if (!links.empty()) {
+            ++it;
+            continue;
+        }
+        auto& groups = it->thread->groups;
+        groups.erase(std::find(groups.begin(), groups.end(), &*it));
+        it = _link_groups.erase(it);
+    }
+}
+
+// Returns the thread with the lowest load, or with the fewest groups if there
+// are several of them
+offload_io_service_impl::offload_thread_t*
+offload_io_service_impl::_get_idlest_thread() const
+{
+    offload_thread_t* idlest = nullptr;
+    uint64_t idlest_load     = 0;
+    for (const auto& offload_thread : _offload_threads) {
+        uint64_t load = 0;
+        for (const link_group_t* group : offload_thread->groups) {
+            load += group->load;
+        }
+        if (!idlest || load < idlest_load
+            || (load == idlest_load
+                && offload_thread->groups.size() < idlest->groups.size())) {
+            idlest      = offload_thread.get();
+            idlest_load = load;
+        }
+    }
+    return idlest;
+}
+
+// Lock the mutexes of all threads, always in the same order
+offload_io_service_impl::thread_locks_t offload_io_service_impl::_lock_all_threads()
+{
+    thread_locks_t locks;
+    for (auto& offload_thread : _offload_threads) {
+        locks.emplace_back(offload_thread->mutex);
+    }
+    return locks;
+}
+
+void offload_io_service_impl::_exec_client_req(client_req_t& client_req)
+{
+    auto locks = _lock_all_threads();
+    (*client_req.req)();
+    delete client_req.req;
+    _remove_unused_link_groups();
+}
+
+// Move the group that lowers the load of the busiest thread the most to the
+// idlest thread. The load of a group is the number of frames it passed since
+// the last call.
+void offload_io_service_impl::_rebalance()
+{
+    auto locks = _lock_all_threads();
+
+    std::vector<uint64_t> thread_loads(_offload_threads.size(), 0);
+    for (auto& group : _link_groups) {
+        group.load            = group.num_frames - group.last_num_frames;
+        group.last_num_frames = group.num_frames;
+        thread_loads[group.thread->index] += group.load;
+    }
+    const size_t busiest = std::distance(thread_loads.begin(),
+        std::max_element(thread_loads.begin(), thread_loads.end()));
+    const size_t idlest  = std::distance(thread_loads.begin(),
+        std::min_element(thread_loads.begin(), thread_loads.end()));
+    const uint64_t max_load = thread_loads[busiest];
+
+    link_group_t* best_group = nullptr;
+    uint64_t best_max_load   = max_load;
+    for (link_group_t* group : _offload_threads[busiest]->groups) {
+        const uint64_t new_max_load =
+            std::max(max_load - group->load, thread_loads[idlest] + group->load);
+        if (new_max_load < best_max_load) {
+            best_group    = group;
+            best_max_load = new_max_load;
+        }
+    }
+    if (!best_group || best_max_load > max_load * (1.0 - rebalance_min_gain)) {
+        return;
+    }
+
+    UHD_LOG_TRACE("IO_SRV",
+        "Moving a link group from offload thread " << busiest << " to " << idlest);
+    auto& groups = _offload_threads[busiest]->groups;
+    groups.erase(std::find(groups.begin(), groups.end(), best_group));
+    _offload_threads[idlest]->groups.push_back(best_group);
+    best_group->thread = _offload_threads[idlest].get();
+}
+
+// Serve the clients of a group once, and return how many frames they passed
+template <bool allow_recv, bool allow_send>
+size_t offload_io_service_impl::_poll_link_group(link_group_t& group)
+{
+    size_t num_frames = 0;
+
+    if (allow_recv) {
+        // Get recv buffers
+        for (auto& recv_info : group.recv_clients) {
+            const size_t num_frames_in_use = recv_info.num_frames_in_use;
+            _get_recv_buff(recv_info, 0);
+            num_frames += recv_info.num_frames_in_use - num_frames_in_use;
         }
 
-        if (allow_send) {
-            // Get send buffers
-            for (auto& send_info : _send_clients) {
-                _get_send_buff(send_info);
+        // Release recv buffers
+        for (auto it = group.recv_clients.begin(); it != group.recv_clients.end();) {
+            frame_buff* buff;
+            bool disconnect;
+            std::tie(buff, disconnect) = it->port->offload_thread_pop();
+            if (buff) {
+                _release_recv_buff(*it, buff);
+            } else if (disconnect) {
+                _disconnect_recv_client(*it);
+                it = group.recv_clients.erase(it); // increments it
+                continue;
             }
+            ++it;
+        }
+    }
 
-            // Release send buffers
-            for (auto it = _send_clients.begin(); it != _send_clients.end();) {
-                frame_buff* buff;
-                bool disconnect;
-                std::tie(buff, disconnect) = it->port->offload_thread_peek();
-                if (buff) {
-                    if (it->inline_io->wait_for_dest_ready(buff->packet_size(), 0)) {
-                        _release_send_buff(*it, buff);
-                        it->port->offload_thread_pop();
-                    }
-                } else if (disconnect) {
+    if (allow_send) {
+        // Get send buffers
+        for (auto& send_info : group.send_clients) {
+            _get_send_buff(send_info);
+        }
+
+        // Release send buffers
+        for (auto it = group.send_clients.begin(); it != group.send_clients.end();) {
+            frame_buff* buff;
+            bool disconnect;
+            std::tie(buff, disconnect) = it->port->offload_thread_peek();
+            if (buff) {
+                if (it->inline_io->wait_for_dest_ready(buff->packet_size(), 0)) {
+                    _release_send_buff(*it, buff);
                     it->port->offload_thread_pop();
-                    _disconnect_send_client(*it);
-                    it = _send_clients.erase(it); // increments it
-                    continue;
+                    num_frames++;
                 }
-                ++it;
+            } else if (disconnect) {
+                it->port->offload_thread_pop();
+                _disconnect_send_client(*it);
+                it = group.send_clients.erase(it); // increments it
+                continue;
             }
+            ++it;
+        }
+    }
+
+    return num_frames;
+}
+
+template <bool allow_recv, bool allow_send>
+void offload_io_service_impl::_do_work_polling(offload_thread_t& thread)
+{
+    uhd::set_thread_affinity(thread.cpu_affinity_list);
+    uhd::setup_realtime_thread(uhd::thread_role_t::IO);
+
+    // The first thread executes the client requests and balances the threads
+    const bool is_first_thread = (thread.index == 0);
+    const bool balance         = (_offload_threads.size() > 1);
+    auto next_rebalance = std::chrono::steady_clock::now() + rebalance_interval;
+
+    client_req_t client_req;
+
+    while (!_stop_offload_thread) {
+        {
+            // With a single thread, nobody else accesses the groups
+            std::unique_lock<std::mutex> lock(thread.mutex, std::defer_lock);
+            if (balance) {
+                lock.lock();
+            }
+            for (link_group_t* group : thread.groups) {
+                group->num_frames += _poll_link_group<allow_recv, allow_send>(*group);
+            }
+        }
+
+        if (!is_first_thread) {
+            continue;
         }
 
         // Execute one client connect command per main loop iteration
         if (_client_connect_queue.pop(client_req)) {
-            (*client_req.req)();
-            delete client_req.req;
+            _exec_client_req(client_req);
+        }
+
+        if (balance && std::chrono::steady_clock::now() >= next_rebalance) {
+            _rebalance();
+            next_rebalance += rebalance_interval;
         }
     }
 }
 
 template <bool allow_recv, bool allow_send>
-void offload_io_service_impl::_do_work_blocking()
+void offload_io_service_impl::_do_work_blocking(offload_thread_t& thread)
 {
-    uhd::set_thread_affinity(_offload_thread_params.cpu_affinity_list);
+    uhd::set_thread_affinity(thread.cpu_affinity_list);
+    uhd::setup_realtime_thread(uhd::thread_role_t::IO);
 
     client_req_t client_req;
 
+    // There is only one thread in this mode, so it needs no lock to serve the
+    // groups
     while (!_stop_offload_thread) {
-        if (allow_recv) {
-            // Get recv buffers
-            for (auto& recv_info : _recv_clients) {
-                _get_recv_buff(recv_info, blocking_timeout_ms);
-            }
-
-            // Release recv buffers
-            for (auto it = _recv_clients.begin(); it != _recv_clients.end();) {
-                frame_buff* buff;
-                bool disconnect;
-
-                if (it->num_frames_in_use == it->frames_reserved.num_recv_frames) {
-                    // If all buffers are in use, block to avoid excessive CPU usage
-                    std::tie(buff, disconnect) =
-                        it->port->offload_thread_pop(blocking_timeout_ms);
-                } else {
-                    // Otherwise, just check current status
-                    std::tie(buff, disconnect) = it->port->offload_thread_pop();
+        for (link_group_t* group : thread.groups) {
+            auto& recv_clients = group->recv_clients;
+            auto& send_clients = group->send_clients;
+
+            if (allow_recv) {
+                // Get recv buffers
+                for (auto& recv_info : recv_clients) {
+                    _get_recv_buff(recv_info, blocking_timeout_ms);
                 }
 
-                if (buff) {
-                    _release_recv_buff(*it, buff);
-                } else if (disconnect) {
-                    _disconnect_recv_client(*it);
-                    it = _recv_clients.erase(it); // increments it
-                    continue;
+                // Release recv buffers
+                for (auto it = recv_clients.begin(); it != recv_clients.end();) {
+                    frame_buff* buff;
+                    bool disconnect;
+
+                    if (it->num_frames_in_use == it->max_frames_in_use) {
+                        // If all buffers are in use, block to avoid excessive CPU
+                        // usage
+                        std::tie(buff, disconnect) =
+                            it->port->offload_thread_pop(blocking_timeout_ms);
+                    } else {
+                        // Otherwise, just check current status
+                        std::tie(buff, disconnect) = it->port->offload_thread_pop();
+                    }
+
+                    if (buff) {
+                        _release_recv_buff(*it, buff);
+                    } else if (disconnect) {
+                        _disconnect_recv_client(*it);
+                        it = recv_clients.erase(it); // increments it
+                        continue;
+                    }
+                    ++it;
                 }
-                ++it;
             }
-        }
 
-        if (allow_send) {
-            // Get send buffers
-            for (auto& send_info : _send_clients) {
-                _get_send_buff(send_info);
-            }
+            if (allow_send) {
+                // Get send buffers
+                for (auto& send_info : send_clients) {
+                    _get_send_buff(send_info);
+                }
 
-            // Release send buffers
-            for (auto it = _send_clients.begin(); it != _send_clients.end();) {
-                if (it->num_frames_in_use > 0) {
-                    frame_buff* buff;
-                    bool disconnect;
-                    std::tie(buff, disconnect) = it->port->offload_thread_peek();
-                    if (buff) {
-                        if (it->inline_io->wait_for_dest_ready(
-                                buff->packet_size(), blocking_timeout_ms)) {
-                            _release_send_buff(*it, buff);
+                // Release send buffers
+                for (auto it = send_clients.begin(); it != send_clients.end();) {
+                    if (it->num_frames_in_use > 0) {
+                        frame_buff* buff;
+                        bool disconnect;
+                        std::tie(buff, disconnect) = it->port->offload_thread_peek();
+                        if (buff) {
+                            if (_wait_for_dest_ready(*it, buff, blocking_timeout_ms)) {
+                                _release_send_buff(*it, buff);
+                                it->port->offload_thread_pop();
+                            }
+                        } else if (disconnect) {
                             it->port->offload_thread_pop();
+                            _disconnect_send_client(*it);
+                            it = send_clients.erase(it); // increments it
+                            continue;
                         }
-                    } else if (disconnect) {
-                        it->port->offload_thread_pop();
-                        _disconnect_send_client(*it);
-                        it = _send_clients.erase(it); // increments it
-                        continue;
                     }
+                    ++it;
                 }
-                ++it;
             }
         }
 
@@ -788,8 +1138,7 @@ void offload_io_service_impl::_do_work_blocking()
         // service these requests. Need to configure all clients up-front,
         // before starting the offload thread to avoid this.
         if (_client_connect_queue.pop(client_req)) {
-            (*client_req.req)();
-            delete client_req.req;
+            _exec_client_req(client_req);
         }
     }
 }
@@ -0,0 +1,203 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/thread.hpp>
+#include <uhdlib/transport/pcap_tap.hpp>
+
+using namespace uhd::transport;
+
+namespace {
+
+//! How long the writer sleeps when the taps are empty
+constexpr auto DRAIN_INTERVAL = std::chrono::milliseconds(10);
+
+constexpr uint32_t PCAPNG_SHB          = 0x0A0D0D0A;
+constexpr uint32_t PCAPNG_IDB          = 0x00000001;
+constexpr uint32_t PCAPNG_EPB          = 0x00000006;
+constexpr uint32_t PCAPNG_BYTE_ORDER   = 0x1A2B3C4D;
+constexpr uint16_t PCAPNG_OPT_END      = 0;
+constexpr uint16_t PCAPNG_OPT_IF_NAME  = 2;
+constexpr uint16_t PCAPNG_OPT_TSRESOL  = 9;
+constexpr uint16_t PCAPNG_OPT_EPB_FLAG = 2;
+//! Direction bits of the EPB flags
+constexpr uint32_t PCAPNG_INBOUND  = 1;
+constexpr uint32_t PCAPNG_OUTBOUND = 2;
+
+template <typename T>
+void append(std::vector<uint8_t>& body, const T value)
+{
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    body.insert(body.end(), bytes, bytes + sizeof(value));
+}
+
+//! Appends data, padded to 32 bits
+void append_padded(std::vector<uint8_t>& body, const uint8_t* data, const size_t len)
+{
+    body.insert(body.end(), data, data + len);
+    body.resize(body.size() + (4 - len % 4) % 4, 0);
+}
+
+void append_option(
+    std::vector<uint8_t>& body, const uint16_t code, const void* data, const size_t len)
+{
+    append<uint16_t>(body, code);
+    append<uint16_t>(body, static_cast<uint16_t>(len));
+    append_padded(body, static_cast<const uint8_t*>(data), len);
+}
+
+} // namespace
+
+pcap_writer::pcap_writer(const std::string& path)
+    : _file(path, std::ios::binary | std::ios::trunc)
+{
+    if (!_file) {
+        throw uhd::os_error("Cannot create the capture file " + path);
+    }
+    std::vector<uint8_t> shb;
+    append<uint32_t>(shb, PCAPNG_BYTE_ORDER);
+    append<uint16_t>(shb, 1); // Major version
+    append<uint16_t>(shb, 0); // Minor version
+    append<int64_t>(shb, -1); // Unknown section length
+    _write_block(PCAPNG_SHB, shb);
+
+    _thread = std::thread([this]() { _run(); });
+    uhd::set_thread_name(&_thread, "pcap_writer");
+}
+
+pcap_writer::~pcap_writer()
+{
+    _running = false;
+    _thread.join();
+    flush();
+    for (const auto& tap : _taps) {
+        if (tap->get_num_dropped() != 0) {
+            UHD_LOG_WARNING("PCAP",
+                "Interface " << tap->get_interface_id() << " of the capture lost "
+                             << tap->get_num_dropped() << " frames");
+        }
+    }
+}
+
+pcap_tap::sptr pcap_writer::add_tap(const std::string& name,
+    const uhd::direction_t dir,
+    const size_t frame_size,
+    const size_t snaplen,
+    const size_t sample_every,
+    const size_t num_records)
+{
+    std::lock_guard<std::mutex> l(_mutex);
+    auto tap = std::make_shared<pcap_tap>(static_cast<uint32_t>(_taps.size()),
+        dir,
+        frame_size,
+        snaplen,
+        sample_every,
+        num_records);
+
+    std::vector<uint8_t> idb;
+    append<uint16_t>(idb, PCAP_LINKTYPE_CHDR);
+    append<uint16_t>(idb, 0); // Reserved
+    append<uint32_t>(idb, static_cast<uint32_t>(tap->get_snaplen()));
+    append_option(idb, PCAPNG_OPT_IF_NAME, name.data(), name.size());
+    const uint8_t tsresol = 9; // Nanoseconds
+    append_option(idb, PCAPNG_OPT_TSRESOL, &tsresol, sizeof(tsresol));
+    append_option(idb, PCAPNG_OPT_END, nullptr, 0);
+    _write_block(PCAPNG_IDB, idb);
+
+    _taps.push_back(tap);
+    return tap;
+}
+
+void pcap_writer::flush()
+{
+    std::lock_guard<std::mutex> l(_mutex);
+    _drain();
+    _file.flush();
+}
+
+void pcap_writer::_run()
+{
+    while (_running) {
+        size_t num_written;
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            num_written = _drain();
+        }
+        if (num_written == 0) {
+            std::this_thread::sleep_for(DRAIN_INTERVAL);
+        }
+    }
+}
+
+size_t pcap_writer::_drain()
+{
+    size_t num_written = 0;
+    std::vector<uint8_t> epb;
+    for (const auto& tap : _taps) {
+        pcap_tap::record_t* record;
+        const uint32_t flags = tap->get_direction() == uhd::RX_DIRECTION
+                                   ? PCAPNG_INBOUND
+                                   : PCAPNG_OUTBOUND;
+        while (tap->_filled.pop(record)) {
+            epb.clear();
+            append<uint32_t>(epb, tap->get_interface_id());
+            append<uint32_t>(epb, static_cast<uint32_t>(record->timestamp_ns >> 32));
+            append<uint32_t>(epb, static_cast<uint32_t>(record->timestamp_ns));
+            append<uint32_t>(epb, record->cap_len);
+            append<uint32_t>(epb, record->orig_len);
+            append_padded(epb, record->data, record->cap_len);
+            append_option(epb, PCAPNG_OPT_EPB_FLAG, &flags, sizeof(flags));
+            append_option(epb, PCAPNG_OPT_END, nullptr, 0);
+            tap->_free.push(record);
+            _write_block(PCAPNG_EPB, epb);
+            num_written++;
+        }
+    }
+    return num_written;
+}
+
+void pcap_writer::_write_block(const uint32_t type, const std::vector<uint8_t>& body)
+{
+    // Type, and the length at the start and the end of the block
+    const uint32_t len = static_cast<uint32_t>(body.size() + 3 * sizeof(uint32_t));
+    _file.write(reinterpret_cast<const char*>(&type), sizeof(type));
+    _file.write(reinterpret_cast<const char*>(&len), sizeof(len));
+    _file.write(reinterpret_cast<const char*>(body.data()), body.size());
+    _file.write(reinterpret_cast<const char*>(&len), sizeof(len));
+}
+
+void uhd::transport::attach_pcap_taps(pcap_writer& writer,
+    const both_links_t& links,
+    const std::string& name,
+    const uhd::device_addr_t& args)
+{
+    const size_t snaplen = args.cast<size_t>("pcap_snaplen", PCAP_DEFAULT_SNAPLEN);
+    const size_t sample_every = args.cast<size_t>("pcap_sample", 0);
+    const size_t num_records =
+        args.cast<size_t>("pcap_records", PCAP_DEFAULT_NUM_RECORDS);
+
+    send_link_if::sptr send_link = std::get<0>(links);
+    recv_link_if::sptr recv_link = std::get<2>(links);
+    if (send_link
+        && !send_link->set_send_pcap_tap(writer.add_tap(name + " tx",
+            uhd::TX_DIRECTION,
+            send_link->get_send_frame_size(),
+            snaplen,
+            sample_every,
+            num_records))) {
+        UHD_LOG_WARNING("PCAP", "The link " << name << " can't capture sent frames");
+    }
+    if (recv_link
+        && !recv_link->set_recv_pcap_tap(writer.add_tap(name + " rx",
+            uhd::RX_DIRECTION,
+            recv_link->get_recv_frame_size(),
+            snaplen,
+            sample_every,
+            num_records))) {
+        UHD_LOG_WARNING("PCAP", "The link " << name << " can't capture received frames");
+    }
+}
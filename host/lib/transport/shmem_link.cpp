@@ -0,0 +1,217 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhdlib/transport/adapter.hpp>
+#include <uhdlib/transport/shmem_link.hpp>
+#include <cstring>
+#include <new>
+
+#ifdef UHD_PLATFORM_LINUX
+#    include <fcntl.h>
+#    include <linux/memfd.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+using namespace uhd::transport;
+
+namespace {
+
+constexpr uint64_t SHMEM_LINK_MAGIC = 0x55484453484d4c31; // "UHDSHML1"
+constexpr size_t CACHE_LINE_SIZE    = 64;
+
+//! pad the byte count to a multiple of alignment
+size_t pad_to_boundary(const size_t bytes, const size_t alignment)
+{
+    return bytes + (alignment - bytes) % alignment;
+}
+
+} // namespace
+
+shmem_link::shmem_link(
+    const std::string& name, const int fd, region_hdr_t* region, const size_t side)
+    : recv_link_base_t(
+        region->rings[1 - side].num_frames, region->rings[1 - side].frame_size)
+    , send_link_base_t(region->rings[side].num_frames, region->rings[side].frame_size)
+    , _fd(fd)
+    , _region(region)
+    , _recv_ring(_get_ring(region, 1 - side))
+    , _send_ring(_get_ring(region, side))
+{
+    // Pick up where the previous user of this end left off
+    _recv_next     = _recv_ring.hdr->tail.load(std::memory_order_acquire);
+    _recv_released = _recv_next;
+    _send_next     = _send_ring.hdr->head.load(std::memory_order_acquire);
+
+    _recv_buffs.resize(get_num_recv_frames());
+    _send_buffs.resize(get_num_send_frames());
+    for (auto& buff : _recv_buffs) {
+        recv_link_base_t::preload_free_buff(&buff);
+    }
+    for (auto& buff : _send_buffs) {
+        send_link_base_t::preload_free_buff(&buff);
+    }
+
+    auto info   = shmem_adapter_info(name);
+    auto& ctx   = adapter_ctx::get();
+    _adapter_id = ctx.register_adapter(info);
+
+    UHD_LOGGER_TRACE("SHMEM") << "Created shared memory link " << name << " (end "
+                              << side << ") with " << get_num_recv_frames()
+                              << " recv frames of " << get_recv_frame_size()
+                              << " bytes and " << get_num_send_frames()
+                              << " send frames of " << get_send_frame_size() << " bytes";
+}
+
+shmem_link::~shmem_link()
+{
+#ifdef UHD_PLATFORM_LINUX
+    ::munmap(_region, _region->size);
+    ::close(_fd);
+#endif
+}
+
+shmem_link::sptr shmem_link::make(const std::string& name, const link_params_t& params)
+{
+    UHD_ASSERT_THROW(params.num_recv_frames > 0 && params.num_send_frames > 0);
+    UHD_ASSERT_THROW(params.recv_frame_size > 0 && params.send_frame_size > 0);
+#ifdef UHD_PLATFORM_LINUX
+    const int fd =
+        int(::syscall(SYS_memfd_create, ("uhd-shmem-" + name).c_str(), MFD_CLOEXEC));
+    if (fd < 0) {
+        throw uhd::os_error(std::string("Failed to create shared memory region: ")
+                            + std::strerror(errno));
+    }
+
+    // Lay out the region: the header, the frame sizes of both rings, and then
+    // the frames of each ring, starting on a page boundary
+    const size_t page_size     = size_t(::sysconf(_SC_PAGESIZE));
+    const size_t num_frames[2] = {params.num_send_frames, params.num_recv_frames};
+    const size_t frame_size[2] = {params.send_frame_size, params.recv_frame_size};
+    size_t sizes_offset[2], frames_offset[2];
+    size_t offset = pad_to_boundary(sizeof(region_hdr_t), CACHE_LINE_SIZE);
+    for (size_t i = 0; i < 2; i++) {
+        sizes_offset[i] = offset;
+        offset          = pad_to_boundary(
+            offset + num_frames[i] * sizeof(uint32_t), CACHE_LINE_SIZE);
+    }
+    for (size_t i = 0; i < 2; i++) {
+        frames_offset[i] = pad_to_boundary(offset, page_size);
+        offset           = frames_offset[i]
+                 + num_frames[i] * pad_to_boundary(frame_size[i], CACHE_LINE_SIZE);
+    }
+    const size_t region_size = pad_to_boundary(offset, page_size);
+
+    void* mem = MAP_FAILED;
+    if (::ftruncate(fd, off_t(region_size)) == 0) {
+        mem = ::mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (mem == MAP_FAILED) {
+        const std::string err = std::strerror(errno);
+        ::close(fd);
+        throw uhd::os_error("Failed to map shared memory region: " + err);
+    }
+
+    region_hdr_t* region = new (mem) region_hdr_t();
+    region->size         = region_size;
+    for (size_t i = 0; i < 2; i++) {
+        ring_hdr_t& ring   = region->rings[i];
+        ring.num_frames    = num_frames[i];
+        ring.frame_size    = frame_size[i];
+        ring.frame_stride  = pad_to_boundary(frame_size[i], CACHE_LINE_SIZE);
+        ring.sizes_offset  = sizes_offset[i];
+        ring.frames_offset = frames_offset[i];
+        ring.head.store(0);
+        ring.tail.store(0);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    region->magic = SHMEM_LINK_MAGIC;
+    ::munmap(mem, region_size);
+
+    try {
+        return sptr(new shmem_link(name, fd, _map_region(fd), 0));
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+#else
+    (void)name;
+    throw uhd::not_implemented_error("Shared memory links are only supported on Linux");
+#endif
+}
+
+shmem_link::sptr shmem_link::attach(const std::string& name, const int fd)
+{
+#ifdef UHD_PLATFORM_LINUX
+    const int link_fd = ::fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if (link_fd < 0) {
+        throw uhd::os_error(std::string("Failed to duplicate shared memory region fd: ")
+                            + std::strerror(errno));
+    }
+    try {
+        return sptr(new shmem_link(name, link_fd, _map_region(link_fd), 1));
+    } catch (...) {
+        ::close(link_fd);
+        throw;
+    }
+#else
+    (void)name;
+    (void)fd;
+    throw uhd::not_implemented_error("Shared memory links are only supported on Linux");
+#endif
+}
+
+std::pair<shmem_link::sptr, shmem_link::sptr> shmem_link::make_pair(
+    const std::string& name, const link_params_t& params)
+{
+    auto first  = make(name, params);
+    auto second = attach(name, first->get_fd());
+    return std::make_pair(first, second);
+}
+
+shmem_link::region_hdr_t* shmem_link::_map_region(const int fd)
+{
+#ifdef UHD_PLATFORM_LINUX
+    struct stat fd_stat;
+    if (::fstat(fd, &fd_stat) != 0 || size_t(fd_stat.st_size) < sizeof(region_hdr_t)) {
+        throw uhd::value_error("File descriptor is not a shared memory link region");
+    }
+    const size_t region_size = size_t(fd_stat.st_size);
+    void* mem = ::mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mem == MAP_FAILED) {
+        throw uhd::os_error(std::string("Failed to map shared memory region: ")
+                            + std::strerror(errno));
+    }
+
+    auto region = static_cast<region_hdr_t*>(mem);
+    if (region->magic != SHMEM_LINK_MAGIC || region->size != region_size) {
+        ::munmap(mem, region_size);
+        throw uhd::value_error("File descriptor is not a shared memory link region");
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return region;
+#else
+    (void)fd;
+    throw uhd::not_implemented_error("Shared memory links are only supported on Linux");
+#endif
+}
+
+shmem_link::ring_t shmem_link::_get_ring(region_hdr_t* region, const size_t ring_idx)
+{
+    uint8_t* base        = reinterpret_cast<uint8_t*>(region);
+    ring_hdr_t& ring_hdr = region->rings[ring_idx];
+    ring_t ring;
+    ring.hdr          = &ring_hdr;
+    ring.sizes        = reinterpret_cast<uint32_t*>(base + ring_hdr.sizes_offset);
+    ring.frames       = base + ring_hdr.frames_offset;
+    ring.num_frames   = ring_hdr.num_frames;
+    ring.frame_stride = ring_hdr.frame_stride;
+    return ring;
+}
@@ -0,0 +1,482 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/rfnoc/chdr_types.hpp>
+#include <uhd/utils/byteswap.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhdlib/transport/adapter.hpp>
+#include <uhdlib/transport/tcp_link.hpp>
+#include <uhdlib/transport/udp_common.hpp>
+#include <boost/asio.hpp>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#ifdef UHD_PLATFORM_LINUX
+#    include <arpa/inet.h>
+#    include <fcntl.h>
+#    include <linux/errqueue.h>
+#    include <linux/memfd.h>
+#    include <netinet/in.h>
+#    include <netinet/tcp.h>
+#    include <poll.h>
+#    include <sys/mman.h>
+#    include <sys/socket.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+using namespace uhd::transport;
+
+#ifdef UHD_PLATFORM_LINUX
+
+namespace asio = boost::asio;
+
+namespace {
+
+//! Size of the part of the CHDR header that holds the packet length
+constexpr size_t CHDR_HDR_SIZE = sizeof(uint64_t);
+
+//! Stop using MSG_ZEROCOPY after this many sends the kernel had to copy anyway
+constexpr size_t MAX_NUM_COPIED = 16;
+
+//! pad the byte count to a multiple of alignment
+size_t pad_to_boundary(const size_t bytes, const size_t alignment)
+{
+    return bytes + (alignment - bytes) % alignment;
+}
+
+std::string errno_str()
+{
+    return std::strerror(errno);
+}
+
+} // namespace
+
+tcp_link::tcp_link(const std::string& addr,
+    const std::string& port,
+    const link_params_t& params,
+    const uhd::endianness_t endianness,
+    const uhd::device_addr_t& link_args)
+    : recv_link_base_t(params.num_recv_frames, params.recv_frame_size)
+    , send_link_base_t(params.num_send_frames, params.send_frame_size)
+    , _zerocopy(link_args.has_key("tcp_zerocopy"))
+    , _big_endian(endianness == uhd::ENDIANNESS_BIG)
+    , _recv_frames(params.num_recv_frames)
+{
+    UHD_LOGGER_TRACE("TCP") << boost::format("Creating TCP link to %s:%s") % addr
+                                   % port;
+
+    asio::io_service io_service;
+    asio::ip::tcp::resolver resolver(io_service);
+    asio::ip::tcp::resolver::query query(asio::ip::tcp::v4(), addr, port);
+    const asio::ip::tcp::endpoint remote_endpoint = *resolver.resolve(query);
+
+    _sock_fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (_sock_fd < 0) {
+        throw uhd::os_error("TCP: Could not create socket: " + errno_str());
+    }
+
+    try {
+        // The window scale is fixed when the connection is set up, so the
+        // buffers need to be large before connecting
+        const int recv_buff_size = static_cast<int>(params.recv_buff_size);
+        const int send_buff_size = static_cast<int>(params.send_buff_size);
+        if (recv_buff_size > 0) {
+            ::setsockopt(_sock_fd,
+                SOL_SOCKET,
+                SO_RCVBUF,
+                &recv_buff_size,
+                sizeof(recv_buff_size));
+        }
+        if (send_buff_size > 0) {
+            ::setsockopt(_sock_fd,
+                SOL_SOCKET,
+                SO_SNDBUF,
+                &send_buff_size,
+                sizeof(send_buff_size));
+        }
+        // packets go out ASAP
+        const int one = 1;
+        ::setsockopt(_sock_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        if (_zerocopy) {
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+            if (::setsockopt(_sock_fd, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one))
+                != 0) {
+                UHD_LOG_WARNING("TCP",
+                    "Cannot enable zero-copy sends (" << errno_str()
+                                                      << "), using regular sends");
+                _zerocopy = false;
+            }
+#else
+            UHD_LOG_WARNING(
+                "TCP", "Zero-copy sends are not supported, using regular sends");
+            _zerocopy = false;
+#endif
+        }
+
+        if (::connect(_sock_fd, remote_endpoint.data(), remote_endpoint.size()) != 0) {
+            throw uhd::os_error(
+                str(boost::format("TCP: Could not connect to %s:%s: %s") % addr % port
+                    % errno_str()));
+        }
+        struct sockaddr_in local_sa;
+        socklen_t local_sa_len = sizeof(local_sa);
+        if (::getsockname(
+                _sock_fd, reinterpret_cast<struct sockaddr*>(&local_sa), &local_sa_len)
+            == 0) {
+            char addr_str[INET_ADDRSTRLEN];
+            if (::inet_ntop(AF_INET, &local_sa.sin_addr, addr_str, sizeof(addr_str))) {
+                _local_addr = addr_str;
+            }
+            _local_port = ntohs(local_sa.sin_port);
+        }
+
+        // With at most all but one frame handed out, this leaves room for a
+        // partial frame and at least one more full frame
+        const size_t page_size = size_t(::sysconf(_SC_PAGESIZE));
+        _map_ring(pad_to_boundary(
+            (params.num_recv_frames + 1) * params.recv_frame_size, page_size));
+    } catch (...) {
+        ::close(_sock_fd);
+        throw;
+    }
+
+    _send_pool = buffer_pool::make(params.num_send_frames, params.send_frame_size);
+    _recv_buffs.resize(params.num_recv_frames);
+    _send_buffs.resize(params.num_send_frames);
+    for (size_t i = 0; i < params.num_send_frames; i++) {
+        _free_send_slots.push_back(i);
+    }
+    for (auto& buff : _recv_buffs) {
+        recv_link_base_t::preload_free_buff(&buff);
+    }
+    for (auto& buff : _send_buffs) {
+        send_link_base_t::preload_free_buff(&buff);
+    }
+
+    auto info   = tcp_adapter_info(_local_addr);
+    auto& ctx   = adapter_ctx::get();
+    _adapter_id = ctx.register_adapter(info);
+
+    UHD_LOGGER_DEBUG("TCP") << boost::format("Created TCP link to %s:%s (local port "
+                                             "%d, %d byte receive ring%s)")
+                                   % addr % port % _local_port % _ring_size
+                                   % (_zerocopy ? ", zero-copy sends" : "");
+}
+
+tcp_link::~tcp_link()
+{
+    ::munmap(_ring, 2 * _ring_size);
+    ::close(_sock_fd);
+}
+
+tcp_link::sptr tcp_link::make(const std::string& addr,
+    const std::string& port,
+    const link_params_t& params,
+    const uhd::endianness_t endianness,
+    const uhd::device_addr_t& link_args)
+{
+    UHD_ASSERT_THROW(params.num_recv_frames != 0);
+    UHD_ASSERT_THROW(params.num_send_frames != 0);
+    UHD_ASSERT_THROW(params.recv_frame_size >= CHDR_HDR_SIZE);
+    UHD_ASSERT_THROW(params.send_frame_size != 0);
+
+    return sptr(new tcp_link(addr, port, params, endianness, link_args));
+}
+
+void tcp_link::_map_ring(const size_t size)
+{
+    const int fd = int(::syscall(SYS_memfd_create, "uhd-tcp-ring", MFD_CLOEXEC));
+    if (fd < 0) {
+        throw uhd::os_error("TCP: Could not create receive ring: " + errno_str());
+    }
+    if (::ftruncate(fd, off_t(size)) != 0) {
+        const std::string err = errno_str();
+        ::close(fd);
+        throw uhd::os_error("TCP: Could not create receive ring: " + err);
+    }
+    // Reserve twice the size, then map the same memory into both halves
+    void* area =
+        ::mmap(nullptr, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (area == MAP_FAILED) {
+        const std::string err = errno_str();
+        ::close(fd);
+        throw uhd::os_error("TCP: Could not map receive ring: " + err);
+    }
+    uint8_t* ring = static_cast<uint8_t*>(area);
+    for (size_t i = 0; i < 2; i++) {
+        if (::mmap(ring + i * size,
+                size,
+                PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_FIXED,
+                fd,
+                0)
+            == MAP_FAILED) {
+            const std::string err = errno_str();
+            ::munmap(area, 2 * size);
+            ::close(fd);
+            throw uhd::os_error("TCP: Could not map receive ring: " + err);
+        }
+    }
+    // The mappings keep the memory alive
+    ::close(fd);
+    _ring      = ring;
+    _ring_size = size;
+}
+
+/******************************************************************************
+ * Receive path
+ *****************************************************************************/
+size_t tcp_link::get_recv_buff_derived(frame_buff& buff, int32_t timeout_ms)
+{
+    auto& tcp_buff      = static_cast<tcp_frame_buff&>(buff);
+    const auto deadline = std::chrono::steady_clock::now()
+                          + std::chrono::milliseconds(std::max(timeout_ms, 0));
+
+    while (true) {
+        const size_t frame_len = _get_frame_len();
+        if (frame_len != 0 && _write_pos - _parse_pos >= frame_len) {
+            tcp_buff.set_data(_ring + (_parse_pos % _ring_size));
+            tcp_buff.index = _next_recv_frame;
+            _parse_pos += frame_len;
+            _recv_frames[_next_recv_frame % _recv_frames.size()] =
+                std::make_pair(_parse_pos, false);
+            _next_recv_frame++;
+            return frame_len;
+        }
+
+        int32_t wait_ms = timeout_ms;
+        if (timeout_ms > 0) {
+            wait_ms = int32_t(std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now())
+                                  .count());
+            wait_ms = std::max(wait_ms, int32_t(0));
+        }
+        if (!_fill_ring(wait_ms)) {
+            return 0; // timeout
+        }
+    }
+}
+
+void tcp_link::release_recv_buff_derived(frame_buff& buff)
+{
+    auto& tcp_buff = static_cast<tcp_frame_buff&>(buff);
+    _recv_frames[tcp_buff.index % _recv_frames.size()].second = true;
+    // Frames may be released out of order, but the ring can only be freed up
+    // to the oldest frame that is still in use
+    while (_oldest_recv_frame != _next_recv_frame) {
+        const auto& frame = _recv_frames[_oldest_recv_frame % _recv_frames.size()];
+        if (!frame.second) {
+            break;
+        }
+        _read_pos = frame.first;
+        _oldest_recv_frame++;
+    }
+    tcp_buff.set_data(nullptr);
+}
+
+size_t tcp_link::_get_frame_len() const
+{
+    if (_write_pos - _parse_pos < CHDR_HDR_SIZE) {
+        return 0;
+    }
+    uint64_t flat_hdr;
+    std::memcpy(&flat_hdr, _ring + (_parse_pos % _ring_size), sizeof(flat_hdr));
+    flat_hdr = _big_endian ? uhd::ntohx(flat_hdr) : uhd::wtohx(flat_hdr);
+    const size_t frame_len = uhd::rfnoc::chdr::chdr_header(flat_hdr).get_length();
+    // There's no way to find the next packet boundary if this one is bogus
+    if (frame_len < CHDR_HDR_SIZE || frame_len > get_recv_frame_size()) {
+        throw uhd::io_error(
+            str(boost::format("TCP: Received a CHDR packet with invalid length %d")
+                % frame_len));
+    }
+    return frame_len;
+}
+
+bool tcp_link::_fill_ring(const int32_t timeout_ms)
+{
+    // The ring is mapped twice, so the free space is always contiguous
+    const size_t free_space = _ring_size - size_t(_write_pos - _read_pos);
+    UHD_ASSERT_THROW(free_space != 0);
+    uint8_t* dst = _ring + (_write_pos % _ring_size);
+
+    ssize_t ret = ::recv(_sock_fd, dst, free_space, MSG_DONTWAIT);
+    if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+        if (timeout_ms == 0 || !wait_for_recv_ready(_sock_fd, timeout_ms)) {
+            return false;
+        }
+        ret = ::recv(_sock_fd, dst, free_space, MSG_DONTWAIT);
+        if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            return false;
+        }
+    }
+    if (ret < 0) {
+        throw uhd::io_error("TCP: recv() failed: " + errno_str());
+    }
+    if (ret == 0) {
+        throw uhd::io_error("TCP: Connection closed by the remote end");
+    }
+    _write_pos += size_t(ret);
+    return true;
+}
+
+/******************************************************************************
+ * Send path
+ *****************************************************************************/
+bool tcp_link::get_send_buff_derived(frame_buff& buff, int32_t timeout_ms)
+{
+    auto& tcp_buff = static_cast<tcp_frame_buff&>(buff);
+    // Buffers that were released without being sent still own their slot
+    if (tcp_buff.index != tcp_frame_buff::NO_SLOT) {
+        return true;
+    }
+
+    if (_free_send_slots.empty()) {
+        // Only zero-copy sends keep slots busy after they were released
+        _reap_zerocopy_completions();
+        if (_free_send_slots.empty() && timeout_ms != 0) {
+            // The error queue holding the completions signals POLLERR
+            struct pollfd pfd;
+            pfd.fd     = _sock_fd;
+            pfd.events = 0;
+            ::poll(&pfd, 1, timeout_ms);
+            _reap_zerocopy_completions();
+        }
+        if (_free_send_slots.empty()) {
+            return false;
+        }
+    }
+
+    tcp_buff.index = _free_send_slots.back();
+    _free_send_slots.pop_back();
+    tcp_buff.set_data(_send_pool->at(tcp_buff.index));
+    return true;
+}
+
+void tcp_link::release_send_buff_derived(frame_buff& buff)
+{
+    auto& tcp_buff          = static_cast<tcp_frame_buff&>(buff);
+    const size_t slot       = size_t(tcp_buff.index);
+    const uint8_t* data     = static_cast<const uint8_t*>(buff.data());
+    const size_t len        = buff.packet_size();
+    const bool zerocopy     = _zerocopy;
+    const uint64_t first_zc = _zerocopy_seq;
+#ifdef MSG_ZEROCOPY
+    const int flags = MSG_NOSIGNAL | (zerocopy ? MSG_ZEROCOPY : 0);
+#else
+    const int flags = MSG_NOSIGNAL;
+#endif
+
+    size_t sent = 0;
+    while (sent < len) {
+        const ssize_t ret = ::send(_sock_fd, data + sent, len - sent, flags);
+        if (ret > 0) {
+            sent += size_t(ret);
+            // Every successful zero-copy send call gets its own completion
+            if (zerocopy) {
+                _zerocopy_seq++;
+            }
+            continue;
+        }
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret < 0 && (errno == ENOBUFS || errno == EAGAIN)) {
+            // Zero-copy sends fail with ENOBUFS when too many of them are
+            // outstanding
+            _reap_zerocopy_completions();
+            struct pollfd pfd;
+            pfd.fd     = _sock_fd;
+            pfd.events = POLLOUT;
+            ::poll(&pfd, 1, 1);
+            continue;
+        }
+        throw uhd::io_error("TCP: send() failed: " + errno_str());
+    }
+
+    if (zerocopy) {
+        _zerocopy_slots.emplace_back(slot, first_zc, _zerocopy_seq - first_zc);
+    } else {
+        _free_send_slots.push_back(slot);
+    }
+    tcp_buff.index = tcp_frame_buff::NO_SLOT;
+    tcp_buff.set_data(nullptr);
+}
+
+void tcp_link::_reap_zerocopy_completions()
+{
+#ifdef MSG_ZEROCOPY
+    while (!_zerocopy_slots.empty()) {
+        char control[CMSG_SPACE(sizeof(struct sock_extended_err)) + 64];
+        struct msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_control    = control;
+        msg.msg_controllen = sizeof(control);
+        if (::recvmsg(_sock_fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+            return;
+        }
+        for (struct cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+            if (!(cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR)) {
+                continue;
+            }
+            const auto* serr =
+                reinterpret_cast<const struct sock_extended_err*>(CMSG_DATA(cm));
+            if (serr->ee_errno != 0 || serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+                continue;
+            }
+            // The kernel reports ranges of 32-bit send call numbers. Extend
+            // them relative to the oldest outstanding send.
+            const uint64_t base = _zerocopy_slots.front().first_seq;
+            const uint64_t lo   = base + uint32_t(serr->ee_info - uint32_t(base));
+            const uint64_t hi   = base + uint32_t(serr->ee_data - uint32_t(base));
+            if (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) {
+                _num_copied += size_t(hi - lo + 1);
+            }
+            // Completions are usually in order, but don't have to be
+            for (auto& zc_slot : _zerocopy_slots) {
+                const uint64_t first = std::max(zc_slot.first_seq, lo);
+                const uint64_t last =
+                    std::min(zc_slot.first_seq + zc_slot.num_seqs - 1, hi);
+                if (first <= last) {
+                    zc_slot.num_done += size_t(last - first + 1);
+                }
+            }
+        }
+        for (auto it = _zerocopy_slots.begin(); it != _zerocopy_slots.end();) {
+            if (it->num_done >= it->num_seqs) {
+                _free_send_slots.push_back(it->slot);
+                it = _zerocopy_slots.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    if (_zerocopy && _num_copied >= MAX_NUM_COPIED) {
+        // E.g., on loopback, or if the NIC can't do scatter-gather. Copying
+        // up front is cheaper then.
+        UHD_LOG_DEBUG("TCP",
+            "The kernel copies zero-copy sends on this connection, using regular "
+            "sends instead");
+        _zerocopy = false;
+    }
+#endif
+}
+
+#else // UHD_PLATFORM_LINUX
+
+tcp_link::sptr tcp_link::make(const std::string&,
+    const std::string&,
+    const link_params_t&,
+    const uhd::endianness_t,
+    const uhd::device_addr_t&)
+{
+    throw uhd::not_implemented_error("TCP links are only supported on Linux");
+}
+
+#endif // UHD_PLATFORM_LINUX
@@ -8,6 +8,8 @@
 #include <uhdlib/transport/adapter.hpp>
 #include <uhdlib/transport/udp_boost_asio_link.hpp>
 #include <boost/format.hpp>
+#include <algorithm>
+#include <cstring>
 
 using namespace uhd::transport;
 
@@ -17,9 +19,23 @@ udp_boost_asio_link::udp_boost_asio_link(
     const std::string& addr, const std::string& port, const link_params_t& params)
     : recv_link_base_t(params.num_recv_frames, params.recv_frame_size)
     , send_link_base_t(params.num_send_frames, params.send_frame_size)
-    , _recv_memory_pool(buffer_pool::make(params.num_recv_frames, params.recv_frame_size))
-    , _send_memory_pool(buffer_pool::make(params.num_send_frames, params.send_frame_size))
 {
+    // create, open, and connect the socket
+    _socket  = open_udp_socket(addr, port, _io_service);
+    _sock_fd = _socket->native_handle();
+
+    // The socket needs to be connected to find the NUMA node of the interface
+    buff_alloc_params_t buff_alloc = params.buff_alloc;
+    if (buff_alloc.numa_node == BUFF_NUMA_NODE_AUTO) {
+        buff_alloc.numa_node = get_numa_node_of_addr(get_local_addr());
+        UHD_LOGGER_DEBUG("UDP") << "Using NUMA node " << buff_alloc.numa_node
+                                << " for frame buffers of link to " << addr;
+    }
+    _recv_memory_pool =
+        make_buffer_pool(params.num_recv_frames, params.recv_frame_size, buff_alloc);
+    _send_memory_pool =
+        make_buffer_pool(params.num_send_frames, params.send_frame_size, buff_alloc);
+
     for (size_t i = 0; i < params.num_recv_frames; i++) {
         _recv_buffs.push_back(udp_boost_asio_frame_buff(_recv_memory_pool->at(i)));
     }
@@ -36,9 +52,27 @@ udp_boost_asio_link::udp_boost_asio_link(
         send_link_base_t::preload_free_buff(&buff);
     }
 
-    // create, open, and connect the socket
-    _socket  = open_udp_socket(addr, port, _io_service);
-    _sock_fd = _socket->native_handle();
+    if (params.recv_batch_size > 1) {
+#ifdef UHD_PLATFORM_LINUX
+        // We can never hold more frames than the link owns
+        _recv_batch_size = std::min(params.recv_batch_size, params.num_recv_frames);
+        _batch_buffs.resize(_recv_batch_size, nullptr);
+        _batch_iovs.resize(_recv_batch_size);
+        _batch_msgs.resize(_recv_batch_size);
+        for (size_t i = 0; i < _recv_batch_size; i++) {
+            std::memset(&_batch_msgs[i], 0, sizeof(struct mmsghdr));
+            _batch_iovs[i].iov_len             = get_recv_frame_size();
+            _batch_msgs[i].msg_hdr.msg_iov    = &_batch_iovs[i];
+            _batch_msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        UHD_LOGGER_TRACE("UDP") << "Using batched receives of up to "
+                                << _recv_batch_size << " frames";
+#else
+        UHD_LOG_WARNING("UDP",
+            "Batched receives (recv_batch) are not supported on this platform, "
+            "ignoring.");
+#endif
+    }
 
     auto info   = udp_boost_asio_adapter_info(*_socket);
     auto& ctx   = adapter_ctx::get();
@@ -59,6 +93,54 @@ std::string udp_boost_asio_link::get_local_addr() const
     return _socket->local_endpoint().address().to_string();
 }
 
+std::string udp_boost_asio_link::get_send_ifname() const
+{
+    return get_ifname_of_addr(get_local_addr());
+}
+
+std::string udp_boost_asio_link::get_recv_ifname() const
+{
+    return get_ifname_of_addr(get_local_addr());
+}
+
+void udp_boost_asio_link::_fill_recv_batch(int32_t timeout_ms)
+{
+    _batch_head  = 0;
+    _batch_count = 0;
+#ifdef UHD_PLATFORM_LINUX
+    // Take as many free buffers as we can, but at least one (the base class
+    // asserts that a free buffer is available, like the unbatched path does)
+    const size_t num_buffs =
+        std::max<size_t>(1, std::min(_recv_batch_size, recv_link_base_t::get_num_free_buffs()));
+    for (size_t i = 0; i < num_buffs; i++) {
+        _batch_buffs[i]         = recv_link_base_t::pop_free_buff();
+        _batch_iovs[i].iov_base = _batch_buffs[i]->data();
+    }
+
+    size_t num_recvd = 0;
+    try {
+        num_recvd =
+            recv_udp_packets(_sock_fd, _batch_msgs.data(), num_buffs, timeout_ms);
+    } catch (...) {
+        for (size_t i = 0; i < num_buffs; i++) {
+            recv_link_base_t::preload_free_buff(_batch_buffs[i]);
+        }
+        throw;
+    }
+
+    for (size_t i = 0; i < num_recvd; i++) {
+        recv_link_base_t::complete_recv_buff(*_batch_buffs[i], _batch_msgs[i].msg_len);
+    }
+    // Return whatever we didn't fill to the pool
+    for (size_t i = num_recvd; i < num_buffs; i++) {
+        recv_link_base_t::preload_free_buff(_batch_buffs[i]);
+    }
+    _batch_count = num_recvd;
+#else
+    (void)timeout_ms;
+#endif
+}
+
 size_t udp_boost_asio_link::resize_recv_socket_buffer(size_t num_bytes)
 {
     return resize_udp_socket_buffer<asio::socket_base::receive_buffer_size>(
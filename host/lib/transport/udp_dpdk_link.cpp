@@ -9,6 +9,7 @@
 #include <uhd/utils/static.hpp>
 #include <uhdlib/transport/adapter.hpp>
 #include <uhdlib/transport/dpdk/udp.hpp>
+#include <uhdlib/transport/latency_probe.hpp>
 #include <uhdlib/transport/udp_dpdk_link.hpp>
 #include <arpa/inet.h>
 #include <memory>
@@ -109,6 +110,7 @@ void udp_dpdk_link::enqueue_recv_mbuf(struct rte_mbuf* mbuf)
     buff->header_jump(
         sizeof(struct ether_hdr) + sizeof(struct ipv4_hdr) + sizeof(struct udp_hdr));
     buff->set_packet_size(packet_size);
+    buff->set_timestamp(latency_probe::is_active() ? latency_probe::now() : 0);
     // Add the dpdk_frame_buff to the list
     if (_recv_buff_head) {
         buff->prev                  = _recv_buff_head->prev;
@@ -180,16 +182,17 @@ void udp_dpdk_link::release_send_buff(frame_buff::uptr buff)
             _local_port,
             _remote_port,
             buff_ptr->packet_size());
-        // Prepare the packet buffer and send it out
+        // Prepare the packet buffer and queue it for sending. The I/O service
+        // flushes the queue once per pass of its poll loop.
         int status = rte_eth_tx_prepare(_port->get_port_id(), _queue, &mbuf, 1);
         if (status != 1) {
             throw uhd::runtime_error("DPDK: Failed to prepare TX buffer for send");
         }
-        status = rte_eth_tx_burst(_port->get_port_id(), _queue, &mbuf, 1);
-        while (status != 1) {
-            status = rte_eth_tx_burst(_port->get_port_id(), _queue, &mbuf, 1);
-            // FIXME: Should we make available retrying?
-            // throw uhd::runtime_error("DPDK: Failed to send TX buffer");
+        _port->queue_tx(_queue, mbuf);
+        // Record the time since send() for the latency probe
+        latency_hist* hist = buff_ptr->get_latency_hist();
+        if (hist) {
+            hist->add(latency_probe::now() - buff_ptr->get_timestamp());
         }
     } else {
         // Release the buffer if there is nothing in it
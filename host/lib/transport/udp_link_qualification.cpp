@@ -0,0 +1,310 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhdlib/transport/buffer_pool_alloc.hpp>
+#include <uhdlib/transport/udp_common.hpp>
+#include <uhdlib/transport/udp_link_qualification.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#ifdef UHD_PLATFORM_LINUX
+#    include <linux/ethtool.h>
+#    include <linux/sockios.h>
+#    include <net/if.h>
+#    include <sys/ioctl.h>
+#    include <sys/socket.h>
+#    include <unistd.h>
+#endif
+
+using namespace uhd::transport;
+
+namespace {
+
+//! Link rate from which on jumbo frames are expected (10 Gbps)
+constexpr double JUMBO_FRAME_LINK_RATE = 1.25e9;
+//! Smallest MTU that counts as jumbo frames
+constexpr size_t JUMBO_FRAME_MIN_MTU = 8000;
+//! Socket buffers below this many milliseconds of data fail the qualification
+constexpr double MIN_BUFF_MS = 1.0;
+
+//! Reads the first line of a file, returns an empty string if that fails
+std::string read_line(const std::string& path)
+{
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return boost::algorithm::trim_copy(line);
+}
+
+//! Reads a number from a file, returns 0 if that fails
+size_t read_size(const std::string& path)
+{
+    try {
+        return boost::lexical_cast<size_t>(read_line(path));
+    } catch (const boost::bad_lexical_cast&) {
+        return 0;
+    }
+}
+
+//! Returns true if the device or link args set \p key
+bool is_explicit(const std::string& key,
+    const uhd::device_addr_t& device_args,
+    const uhd::device_addr_t& link_args)
+{
+    return device_args.has_key(key) || link_args.has_key(key);
+}
+
+} // namespace
+
+udp_host_info_t udp_host_info_t::read_system(const std::string& ifname)
+{
+    udp_host_info_t host;
+    host.ifname = ifname;
+#ifdef UHD_PLATFORM_LINUX
+    host.rmem_max = read_size("/proc/sys/net/core/rmem_max");
+    if (!ifname.empty()) {
+        host.if_mtu = read_size("/sys/class/net/" + ifname + "/mtu");
+
+        const int sock_fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+        if (sock_fd >= 0) {
+            struct ethtool_ringparam ring;
+            std::memset(&ring, 0, sizeof(ring));
+            ring.cmd = ETHTOOL_GRINGPARAM;
+            struct ifreq ifr;
+            std::memset(&ifr, 0, sizeof(ifr));
+            std::strncpy(ifr.ifr_name, ifname.c_str(), IFNAMSIZ - 1);
+            ifr.ifr_data = reinterpret_cast<char*>(&ring);
+            if (::ioctl(sock_fd, SIOCETHTOOL, &ifr) == 0) {
+                host.rx_ring     = ring.rx_pending;
+                host.rx_ring_max = ring.rx_max_pending;
+            }
+            ::close(sock_fd);
+        }
+    }
+
+    namespace fs = boost::filesystem;
+    const fs::path cpu_dir("/sys/devices/system/cpu");
+    boost::system::error_code ec;
+    std::set<std::string> governors;
+    for (fs::directory_iterator it(cpu_dir, ec), end; !ec && it != end;
+         it.increment(ec)) {
+        const std::string name = it->path().filename().string();
+        if (name.size() <= 3 || name.compare(0, 3, "cpu") != 0
+            || !std::all_of(name.begin() + 3, name.end(), ::isdigit)) {
+            continue;
+        }
+        const std::string governor =
+            read_line((it->path() / "cpufreq" / "scaling_governor").string());
+        if (!governor.empty()) {
+            governors.insert(governor);
+        }
+    }
+    host.cpu_governors.assign(governors.begin(), governors.end());
+#endif
+    return host;
+}
+
+std::string uhd::transport::to_string(const link_verdict_t verdict)
+{
+    switch (verdict) {
+        case link_verdict_t::PASS:
+            return "pass";
+        case link_verdict_t::WARN:
+            return "warn";
+        case link_verdict_t::FAIL:
+            return "fail";
+        default:
+            return "unknown";
+    }
+}
+
+link_verdict_t udp_link_qualification_t::get_verdict() const
+{
+    link_verdict_t verdict = link_verdict_t::PASS;
+    for (const auto& check : checks) {
+        verdict = std::max(verdict, check.verdict);
+    }
+    return verdict;
+}
+
+std::string udp_link_qualification_t::to_string() const
+{
+    std::string result = "verdict=" + uhd::transport::to_string(get_verdict());
+    for (const auto& check : checks) {
+        result += "," + check.name + "=" + uhd::transport::to_string(check.verdict);
+    }
+    return result;
+}
+
+udp_link_qualification_t uhd::transport::qualify_udp_link(
+    const udp_host_info_t& host, const link_params_t& params, const double link_rate)
+{
+    udp_link_qualification_t result;
+    const std::string ifname = host.ifname.empty() ? "<iface>" : host.ifname;
+
+    {
+        udp_link_qualification_t::check_t check{"rcvbuf", link_verdict_t::UNKNOWN, ""};
+        const size_t min_size = static_cast<size_t>(link_rate * MIN_BUFF_MS / 1e3);
+        if (host.rmem_max != 0) {
+            std::ostringstream detail;
+            detail << "net.core.rmem_max is " << host.rmem_max
+                   << " bytes, the link asks for " << params.recv_buff_size;
+            if (host.rmem_max < params.recv_buff_size) {
+                check.verdict = (host.rmem_max < min_size) ? link_verdict_t::FAIL
+                                                           : link_verdict_t::WARN;
+                detail << ". Please run: sudo sysctl -w net.core.rmem_max="
+                       << params.recv_buff_size;
+            } else {
+                check.verdict = link_verdict_t::PASS;
+            }
+            check.detail = detail.str();
+        }
+        result.checks.push_back(check);
+    }
+
+    {
+        udp_link_qualification_t::check_t check{
+            "nic_ring", link_verdict_t::UNKNOWN, ""};
+        if (host.rx_ring_max != 0) {
+            std::ostringstream detail;
+            detail << "The RX ring of " << ifname << " has " << host.rx_ring << " of "
+                   << host.rx_ring_max << " descriptors";
+            if (host.rx_ring < host.rx_ring_max) {
+                check.verdict = link_verdict_t::WARN;
+                detail << ". Please run: sudo ethtool -G " << ifname << " rx "
+                       << host.rx_ring_max;
+            } else {
+                check.verdict = link_verdict_t::PASS;
+            }
+            check.detail = detail.str();
+        }
+        result.checks.push_back(check);
+    }
+
+    {
+        udp_link_qualification_t::check_t check{"mtu", link_verdict_t::UNKNOWN, ""};
+        if (host.if_mtu != 0) {
+            std::ostringstream detail;
+            detail << "The MTU of " << ifname << " is " << host.if_mtu;
+            if (host.if_mtu < UDP_IPV4_HEADER_SIZE
+                || params.recv_frame_size > host.if_mtu - UDP_IPV4_HEADER_SIZE
+                || (link_rate >= JUMBO_FRAME_LINK_RATE
+                       && host.if_mtu < JUMBO_FRAME_MIN_MTU)) {
+                check.verdict = link_verdict_t::WARN;
+                detail << ", the link uses frames of " << params.recv_frame_size
+                       << " bytes. Please enable jumbo frames: sudo ip link set "
+                       << ifname << " mtu 9000";
+            } else {
+                check.verdict = link_verdict_t::PASS;
+            }
+            check.detail = detail.str();
+        }
+        result.checks.push_back(check);
+    }
+
+    {
+        udp_link_qualification_t::check_t check{
+            "cpu_governor", link_verdict_t::UNKNOWN, ""};
+        if (!host.cpu_governors.empty()) {
+            const bool performance = host.cpu_governors.size() == 1
+                                     && host.cpu_governors.front() == "performance";
+            check.verdict = performance ? link_verdict_t::PASS : link_verdict_t::WARN;
+            check.detail  = "CPU frequency governors: "
+                           + boost::algorithm::join(host.cpu_governors, ", ");
+            if (!performance) {
+                check.detail +=
+                    ". Please run: sudo cpupower frequency-set -g performance";
+            }
+        }
+        result.checks.push_back(check);
+    }
+
+    return result;
+}
+
+link_params_t uhd::transport::autotune_udp_link_params(const udp_host_info_t& host,
+    const link_params_t& params,
+    const double link_rate,
+    const uhd::device_addr_t& device_args,
+    const uhd::device_addr_t& link_args)
+{
+    link_params_t tuned = params;
+    if (host.if_mtu > UDP_IPV4_HEADER_SIZE
+        && !is_explicit("recv_frame_size", device_args, link_args)) {
+        tuned.recv_frame_size =
+            std::min(tuned.recv_frame_size, host.if_mtu - UDP_IPV4_HEADER_SIZE);
+    }
+    if (link_rate <= 0.0 || tuned.recv_frame_size == 0) {
+        return tuned;
+    }
+    if (!is_explicit("num_recv_frames", device_args, link_args)) {
+        const size_t num_frames = static_cast<size_t>(
+            std::ceil(link_rate * UDP_AUTOTUNE_FRAMES_MS / 1e3 / tuned.recv_frame_size));
+        tuned.num_recv_frames = std::max(tuned.num_recv_frames, num_frames);
+    }
+    if (!is_explicit("recv_buff_size", device_args, link_args)) {
+        tuned.recv_buff_size = std::max(tuned.recv_buff_size,
+            static_cast<size_t>(link_rate * UDP_QUALIFY_BUFF_MS / 1e3));
+    }
+    return tuned;
+}
+
+link_params_t uhd::transport::qualify_udp_rx_link(const std::string& addr,
+    const std::string& port,
+    const link_params_t& params,
+    const double link_rate,
+    const uhd::device_addr_t& device_args,
+    const uhd::device_addr_t& link_args)
+{
+    const std::string mode =
+        link_args.get("qualify_link", device_args.get("qualify_link", "0"));
+    if (mode == "0") {
+        return params;
+    }
+
+    std::string ifname;
+    try {
+        ifname = get_ifname_of_addr(get_local_addr_to(addr, port));
+    } catch (const std::exception& ex) {
+        UHD_LOG_WARNING(
+            "UDP", "Cannot find the interface of " << addr << ": " << ex.what());
+    }
+
+    const udp_host_info_t host = udp_host_info_t::read_system(ifname);
+    const link_params_t tuned =
+        autotune_udp_link_params(host, params, link_rate, device_args, link_args);
+    const udp_link_qualification_t qualification =
+        qualify_udp_link(host, tuned, link_rate);
+
+    UHD_LOG_INFO("UDP",
+        "Link qualification of " << (ifname.empty() ? addr : ifname) << ": "
+                                 << qualification.to_string());
+    UHD_LOG_INFO("UDP",
+        "Autotuned RX link to " << addr << ": recv_frame_size=" << tuned.recv_frame_size
+                                << ", num_recv_frames=" << tuned.num_recv_frames
+                                << ", recv_buff_size=" << tuned.recv_buff_size);
+    for (const auto& check : qualification.checks) {
+        if (check.verdict == link_verdict_t::WARN
+            || check.verdict == link_verdict_t::FAIL) {
+            UHD_LOG_WARNING("UDP", check.name << ": " << check.detail);
+        }
+    }
+
+    if (mode == "strict" && qualification.get_verdict() == link_verdict_t::FAIL) {
+        throw uhd::runtime_error("The host failed the qualification of the link to "
+                                 + addr + ": " + qualification.to_string());
+    }
+    return tuned;
+}
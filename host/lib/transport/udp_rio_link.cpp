@@ -0,0 +1,395 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/utils/log.hpp>
+#include <uhdlib/transport/adapter.hpp>
+#include <uhdlib/transport/udp_rio_link.hpp>
+#include <ws2tcpip.h>
+#include <boost/asio.hpp>
+#include <boost/format.hpp>
+#include <algorithm>
+
+using namespace uhd::transport;
+
+namespace asio = boost::asio;
+
+namespace {
+
+//! Slots are padded to a multiple of a cache line
+constexpr size_t RIO_SLOT_ALIGN = 64;
+
+std::string wsa_error_str(const std::string& what)
+{
+    return str(boost::format("RIO: %s failed with error %d") % what % WSAGetLastError());
+}
+
+} // namespace
+
+udp_rio_link::udp_rio_link(
+    const std::string& addr, const std::string& port, const link_params_t& params)
+    : recv_link_base_t(params.num_recv_frames, params.recv_frame_size)
+    , send_link_base_t(params.num_send_frames, params.send_frame_size)
+    , _slot_size(((std::max(params.recv_frame_size, params.send_frame_size)
+                      + RIO_SLOT_ALIGN - 1)
+                     / RIO_SLOT_ALIGN)
+                 * RIO_SLOT_ALIGN)
+{
+    // Resolve the address. This also takes care of initializing Winsock.
+    asio::io_service io_service;
+    asio::ip::udp::resolver resolver(io_service);
+    asio::ip::udp::resolver::query query(asio::ip::udp::v4(), addr, port);
+    const asio::ip::udp::endpoint remote_endpoint = *resolver.resolve(query);
+
+    _sock_fd = WSASocket(
+        AF_INET, SOCK_DGRAM, IPPROTO_UDP, NULL, 0, WSA_FLAG_REGISTERED_IO);
+    if (_sock_fd == INVALID_SOCKET) {
+        throw uhd::os_error(wsa_error_str("WSASocket()"));
+    }
+
+    try {
+        GUID rio_id  = WSAID_MULTIPLE_RIO;
+        DWORD nbytes = 0;
+        if (WSAIoctl(_sock_fd,
+                SIO_GET_MULTIPLE_EXTENSION_FUNCTION_POINTER,
+                &rio_id,
+                sizeof(rio_id),
+                &_rio,
+                sizeof(_rio),
+                &nbytes,
+                NULL,
+                NULL)
+            != 0) {
+            throw uhd::os_error(wsa_error_str("Loading the RIO function table"));
+        }
+
+        // Datagrams that arrive while no receive is posted are held in the
+        // socket buffer, so it is still worth making it large
+        const int recv_buff_size = static_cast<int>(params.recv_buff_size);
+        const int send_buff_size = static_cast<int>(params.send_buff_size);
+        if (recv_buff_size > 0) {
+            setsockopt(_sock_fd,
+                SOL_SOCKET,
+                SO_RCVBUF,
+                reinterpret_cast<const char*>(&recv_buff_size),
+                sizeof(recv_buff_size));
+        }
+        if (send_buff_size > 0) {
+            setsockopt(_sock_fd,
+                SOL_SOCKET,
+                SO_SNDBUF,
+                reinterpret_cast<const char*>(&send_buff_size),
+                sizeof(send_buff_size));
+        }
+
+        if (connect(_sock_fd, remote_endpoint.data(), sizeof(struct sockaddr_in))
+            != 0) {
+            throw uhd::os_error(wsa_error_str("connect()"));
+        }
+        int local_addr_len = sizeof(_local_addr);
+        if (getsockname(_sock_fd,
+                reinterpret_cast<struct sockaddr*>(&_local_addr),
+                &local_addr_len)
+            != 0) {
+            throw uhd::os_error(wsa_error_str("getsockname()"));
+        }
+
+        // Register the memory for all frames in one go
+        const size_t num_slots = params.num_recv_frames + params.num_send_frames;
+        const size_t area_size = num_slots * _slot_size;
+        _area                  = static_cast<uint8_t*>(
+            VirtualAlloc(NULL, area_size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+        if (_area == nullptr) {
+            throw uhd::os_error(
+                str(boost::format("RIO: Could not allocate %d bytes of frame memory")
+                    % area_size));
+        }
+        _buffer_id = _rio.RIORegisterBuffer(
+            reinterpret_cast<PCHAR>(_area), static_cast<DWORD>(area_size));
+        if (_buffer_id == RIO_INVALID_BUFFERID) {
+            throw uhd::os_error(wsa_error_str("RIORegisterBuffer()"));
+        }
+
+        // The completion queues are polled, the events are only used to wait
+        // while they are empty
+        _recv_event = WSACreateEvent();
+        _send_event = WSACreateEvent();
+        if (_recv_event == WSA_INVALID_EVENT or _send_event == WSA_INVALID_EVENT) {
+            throw uhd::os_error(wsa_error_str("WSACreateEvent()"));
+        }
+        RIO_NOTIFICATION_COMPLETION recv_notify;
+        recv_notify.Type              = RIO_EVENT_COMPLETION;
+        recv_notify.Event.EventHandle = _recv_event;
+        recv_notify.Event.NotifyReset = TRUE;
+        RIO_NOTIFICATION_COMPLETION send_notify = recv_notify;
+        send_notify.Event.EventHandle           = _send_event;
+
+        _recv_cq = _rio.RIOCreateCompletionQueue(
+            static_cast<DWORD>(params.num_recv_frames), &recv_notify);
+        _send_cq = _rio.RIOCreateCompletionQueue(
+            static_cast<DWORD>(params.num_send_frames), &send_notify);
+        if (_recv_cq == RIO_INVALID_CQ or _send_cq == RIO_INVALID_CQ) {
+            throw uhd::os_error(wsa_error_str("RIOCreateCompletionQueue()"));
+        }
+        _rq = _rio.RIOCreateRequestQueue(_sock_fd,
+            static_cast<ULONG>(params.num_recv_frames),
+            1,
+            static_cast<ULONG>(params.num_send_frames),
+            1,
+            _recv_cq,
+            _send_cq,
+            NULL);
+        if (_rq == RIO_INVALID_RQ) {
+            throw uhd::os_error(wsa_error_str("RIOCreateRequestQueue()"));
+        }
+    } catch (...) {
+        _cleanup();
+        throw;
+    }
+
+    _recv_results.resize(params.num_recv_frames);
+    _send_results.resize(params.num_send_frames);
+
+    // Post receives for all receive frames
+    for (size_t i = 0; i < params.num_recv_frames; i++) {
+        _recv_buffs.push_back(udp_rio_frame_buff(_area, _slot_size));
+        _post_recv(static_cast<ULONG>(i));
+    }
+    _commit_recvs();
+    for (size_t i = 0; i < params.num_send_frames; i++) {
+        _send_buffs.push_back(udp_rio_frame_buff(_area, _slot_size));
+        _free_send_slots.push_back(static_cast<ULONG>(params.num_recv_frames + i));
+    }
+    for (auto& buff : _recv_buffs) {
+        recv_link_base_t::preload_free_buff(&buff);
+    }
+    for (auto& buff : _send_buffs) {
+        send_link_base_t::preload_free_buff(&buff);
+    }
+
+    auto info   = udp_rio_adapter_info(get_local_addr());
+    auto& ctx   = adapter_ctx::get();
+    _adapter_id = ctx.register_adapter(info);
+
+    UHD_LOGGER_DEBUG("RIO") << boost::format("Created RIO link to %s:%s (local %s:%d)")
+                                   % addr % port % get_local_addr() % get_local_port();
+}
+
+udp_rio_link::~udp_rio_link()
+{
+    _cleanup();
+}
+
+void udp_rio_link::_cleanup()
+{
+    // Closing the socket cancels all outstanding requests and frees the
+    // request queue
+    if (_sock_fd != INVALID_SOCKET) {
+        closesocket(_sock_fd);
+    }
+    if (_recv_cq != RIO_INVALID_CQ) {
+        _rio.RIOCloseCompletionQueue(_recv_cq);
+    }
+    if (_send_cq != RIO_INVALID_CQ) {
+        _rio.RIOCloseCompletionQueue(_send_cq);
+    }
+    if (_recv_event != WSA_INVALID_EVENT) {
+        WSACloseEvent(_recv_event);
+    }
+    if (_send_event != WSA_INVALID_EVENT) {
+        WSACloseEvent(_send_event);
+    }
+    if (_buffer_id != RIO_INVALID_BUFFERID) {
+        _rio.RIODeregisterBuffer(_buffer_id);
+    }
+    if (_area) {
+        VirtualFree(_area, 0, MEM_RELEASE);
+    }
+}
+
+udp_rio_link::sptr udp_rio_link::make(const std::string& addr,
+    const std::string& port,
+    const link_params_t& params,
+    size_t& recv_socket_buff_size,
+    size_t& send_socket_buff_size)
+{
+    UHD_ASSERT_THROW(params.num_recv_frames != 0);
+    UHD_ASSERT_THROW(params.num_send_frames != 0);
+    UHD_ASSERT_THROW(params.recv_frame_size != 0);
+    UHD_ASSERT_THROW(params.send_frame_size != 0);
+
+    udp_rio_link::sptr link(new udp_rio_link(addr, port, params));
+
+    int buff_size    = 0;
+    int buff_opt_len = sizeof(buff_size);
+    getsockopt(link->_sock_fd,
+        SOL_SOCKET,
+        SO_RCVBUF,
+        reinterpret_cast<char*>(&buff_size),
+        &buff_opt_len);
+    recv_socket_buff_size = static_cast<size_t>(buff_size);
+    buff_opt_len          = sizeof(buff_size);
+    getsockopt(link->_sock_fd,
+        SOL_SOCKET,
+        SO_SNDBUF,
+        reinterpret_cast<char*>(&buff_size),
+        &buff_opt_len);
+    send_socket_buff_size = static_cast<size_t>(buff_size);
+
+    return link;
+}
+
+std::string udp_rio_link::get_local_addr() const
+{
+    char addr_str[INET_ADDRSTRLEN];
+    if (inet_ntop(AF_INET, &_local_addr.sin_addr, addr_str, sizeof(addr_str)) == NULL) {
+        return "";
+    }
+    return std::string(addr_str);
+}
+
+ULONG udp_rio_link::_dequeue(RIO_CQ cq,
+    WSAEVENT event,
+    std::vector<RIORESULT>& results,
+    const int32_t timeout_ms)
+{
+    ULONG num_results =
+        _rio.RIODequeueCompletion(cq, results.data(), static_cast<ULONG>(results.size()));
+    if (num_results == 0 and timeout_ms != 0) {
+        // Arm the notification. If completions arrived in the meantime, the
+        // event is set right away.
+        _rio.RIONotify(cq);
+        WaitForSingleObject(event, (timeout_ms < 0) ? INFINITE : DWORD(timeout_ms));
+        num_results = _rio.RIODequeueCompletion(
+            cq, results.data(), static_cast<ULONG>(results.size()));
+    }
+    if (num_results == RIO_CORRUPT_CQ) {
+        throw uhd::io_error("RIO: Completion queue is corrupt");
+    }
+    return num_results;
+}
+
+/******************************************************************************
+ * Receive path
+ *****************************************************************************/
+size_t udp_rio_link::get_recv_buff_derived(frame_buff& buff, int32_t timeout_ms)
+{
+    auto& rio_buff = static_cast<udp_rio_frame_buff&>(buff);
+    // Receives for released frames are deferred, so they can be handed to
+    // the kernel in one go
+    _commit_recvs();
+
+    while (true) {
+        if (_recv_head == _recv_count) {
+            _recv_head  = 0;
+            _recv_count = _dequeue(_recv_cq, _recv_event, _recv_results, timeout_ms);
+            if (_recv_count == 0) {
+                return 0; // timeout
+            }
+        }
+        const RIORESULT& result = _recv_results[_recv_head++];
+        const ULONG slot        = static_cast<ULONG>(result.RequestContext);
+        if (result.Status != 0 or result.BytesTransferred == 0) {
+            // E.g., an ICMP port unreachable message from an earlier send.
+            // Drop it and reuse the frame.
+            UHD_LOG_TRACE("RIO", "Dropping receive with status " << result.Status);
+            _post_recv(slot);
+            _commit_recvs();
+            continue;
+        }
+        rio_buff.set_slot(slot);
+        return result.BytesTransferred;
+    }
+}
+
+void udp_rio_link::release_recv_buff_derived(frame_buff& buff)
+{
+    auto& rio_buff = static_cast<udp_rio_frame_buff&>(buff);
+    _post_recv(rio_buff.get_slot());
+    rio_buff.clear_slot();
+}
+
+void udp_rio_link::_post_recv(const ULONG slot)
+{
+    RIO_BUF rio_buf;
+    rio_buf.BufferId = _buffer_id;
+    rio_buf.Offset   = static_cast<ULONG>(slot * _slot_size);
+    rio_buf.Length   = static_cast<ULONG>(get_recv_frame_size());
+    std::lock_guard<std::mutex> lock(_rq_mutex);
+    // The request queue has room for all receive frames, so this only fails
+    // if the socket is broken
+    if (!_rio.RIOReceive(
+            _rq, &rio_buf, 1, RIO_MSG_DEFER, reinterpret_cast<PVOID>(ULONG_PTR(slot)))) {
+        throw uhd::io_error(wsa_error_str("RIOReceive()"));
+    }
+    _recvs_pending = true;
+}
+
+void udp_rio_link::_commit_recvs()
+{
+    if (!_recvs_pending) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_rq_mutex);
+    if (!_rio.RIOReceive(_rq, NULL, 0, RIO_MSG_COMMIT_ONLY, NULL)) {
+        throw uhd::io_error(wsa_error_str("RIOReceive()"));
+    }
+    _recvs_pending = false;
+}
+
+/******************************************************************************
+ * Send path
+ *****************************************************************************/
+bool udp_rio_link::get_send_buff_derived(frame_buff& buff, int32_t timeout_ms)
+{
+    auto& rio_buff = static_cast<udp_rio_frame_buff&>(buff);
+    // Buffers that were released without being sent still own their slot
+    if (rio_buff.get_slot() != udp_rio_frame_buff::NO_SLOT) {
+        return true;
+    }
+
+    if (_free_send_slots.empty()) {
+        _reap_send_completions(timeout_ms);
+        if (_free_send_slots.empty()) {
+            return false;
+        }
+    }
+
+    rio_buff.set_slot(_free_send_slots.back());
+    _free_send_slots.pop_back();
+    return true;
+}
+
+void udp_rio_link::release_send_buff_derived(frame_buff& buff)
+{
+    auto& rio_buff   = static_cast<udp_rio_frame_buff&>(buff);
+    const ULONG slot = rio_buff.get_slot();
+    RIO_BUF rio_buf;
+    rio_buf.BufferId = _buffer_id;
+    rio_buf.Offset   = static_cast<ULONG>(slot * _slot_size);
+    rio_buf.Length   = static_cast<ULONG>(buff.packet_size());
+    {
+        std::lock_guard<std::mutex> lock(_rq_mutex);
+        // The request queue has room for all send frames
+        if (!_rio.RIOSend(
+                _rq, &rio_buf, 1, 0, reinterpret_cast<PVOID>(ULONG_PTR(slot)))) {
+            throw uhd::io_error(wsa_error_str("RIOSend()"));
+        }
+    }
+    _sends_outstanding++;
+    rio_buff.clear_slot();
+}
+
+void udp_rio_link::_reap_send_completions(const int32_t timeout_ms)
+{
+    if (_sends_outstanding == 0) {
+        return;
+    }
+    const ULONG num_done = _dequeue(_send_cq, _send_event, _send_results, timeout_ms);
+    for (ULONG i = 0; i < num_done; i++) {
+        _free_send_slots.push_back(static_cast<ULONG>(_send_results[i].RequestContext));
+    }
+    _sends_outstanding -= num_done;
+}
@@ -19,8 +19,11 @@ namespace asio = boost::asio;
 class udp_simple_impl : public udp_simple
 {
 public:
-    udp_simple_impl(
-        const std::string& addr, const std::string& port, bool bcast, bool connect)
+    udp_simple_impl(const std::string& addr,
+        const std::string& port,
+        bool bcast,
+        bool connect,
+        bool dont_fragment = false)
         : _connected(connect)
     {
         UHD_LOGGER_TRACE("UDP")
@@ -39,6 +42,11 @@ public:
         // allow broadcasting
         _socket->set_option(asio::socket_base::broadcast(bcast));
 
+        if (dont_fragment && !set_dont_fragment(_socket->native_handle())) {
+            UHD_LOGGER_DEBUG("UDP")
+                << "Cannot set the don't-fragment bit on this platform";
+        }
+
         // connect the socket
         if (connect)
             _socket->connect(_send_endpoint);
@@ -98,6 +106,12 @@ udp_simple::sptr udp_simple::make_broadcast(
     return sptr(new udp_simple_impl(addr, port, true, false /* bcast, no connect */));
 }
 
+udp_simple::sptr uhd::transport::make_udp_simple_mtu_probe(
+    const std::string& addr, const std::string& port)
+{
+    return udp_simple::sptr(new udp_simple_impl(addr, port, true, false, true));
+}
+
 /***********************************************************************
  * Simple UART over UDP
  **********************************************************************/
@@ -0,0 +1,586 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/utils/log.hpp>
+#include <uhdlib/transport/adapter.hpp>
+#include <uhdlib/transport/udp_common.hpp>
+#include <uhdlib/transport/udp_xdp_link.hpp>
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <linux/ethtool.h>
+#include <linux/if_xdp.h>
+#include <linux/sockios.h>
+#include <net/if.h>
+#include <netinet/ip.h>
+#include <netinet/udp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <boost/format.hpp>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+using namespace uhd::transport;
+
+namespace {
+
+constexpr uint32_t DEFAULT_XDP_QUEUE = 1;
+
+//! Round up to the next power of two, as required for the XDP ring sizes
+uint32_t next_pow2(const size_t n)
+{
+    uint32_t ret = 1;
+    while (ret < n) {
+        ret <<= 1;
+    }
+    return ret;
+}
+
+//! Book-keeping of which NIC queues are bound to an XDP socket by this process
+class xdp_queue_registry
+{
+public:
+    static xdp_queue_registry& get()
+    {
+        static xdp_queue_registry registry;
+        return registry;
+    }
+
+    //! Reserve the lowest queue that is not in use, starting at first_queue
+    uint32_t alloc(const std::string& ifname, const uint32_t first_queue)
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        uint32_t queue = first_queue;
+        while (_used.count(std::make_pair(ifname, queue))) {
+            queue++;
+        }
+        _used.insert(std::make_pair(ifname, queue));
+        return queue;
+    }
+
+    void free(const std::string& ifname, const uint32_t queue)
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _used.erase(std::make_pair(ifname, queue));
+    }
+
+private:
+    std::mutex _mutex;
+    std::set<std::pair<std::string, uint32_t>> _used;
+};
+
+//! Find the name of the interface that has the IPv4 address ipv4 (network order)
+std::string get_ifname_for_ipv4(const uint32_t ipv4)
+{
+    struct ifaddrs* ifap = nullptr;
+    if (getifaddrs(&ifap) != 0) {
+        throw uhd::os_error(std::string("XDP: getifaddrs() failed: ") + strerror(errno));
+    }
+    std::string ifname;
+    for (struct ifaddrs* ifa = ifap; ifa != nullptr; ifa = ifa->ifa_next) {
+        if (ifa->ifa_addr == nullptr or ifa->ifa_addr->sa_family != AF_INET) {
+            continue;
+        }
+        const auto* sin = reinterpret_cast<const struct sockaddr_in*>(ifa->ifa_addr);
+        if (sin->sin_addr.s_addr == ipv4) {
+            ifname = ifa->ifa_name;
+            break;
+        }
+    }
+    freeifaddrs(ifap);
+    return ifname;
+}
+
+//! Look up the MAC address of the IPv4 address ip in the kernel's ARP table
+bool lookup_arp_entry(
+    const std::string& ip, const std::string& ifname, struct ether_addr& mac)
+{
+    std::ifstream arp_table("/proc/net/arp");
+    std::string line;
+    // Skip the header line
+    std::getline(arp_table, line);
+    while (std::getline(arp_table, line)) {
+        // Format: IP address, HW type, Flags, HW address, Mask, Device
+        std::istringstream iss(line);
+        std::string entry_ip, hw_type, flags, hw_addr, mask, dev;
+        iss >> entry_ip >> hw_type >> flags >> hw_addr >> mask >> dev;
+        // A flags value of 0x0 means the entry is incomplete
+        if (entry_ip != ip or dev != ifname or flags == "0x0") {
+            continue;
+        }
+        unsigned int octets[6];
+        if (std::sscanf(hw_addr.c_str(),
+                "%x:%x:%x:%x:%x:%x",
+                &octets[0],
+                &octets[1],
+                &octets[2],
+                &octets[3],
+                &octets[4],
+                &octets[5])
+            != 6) {
+            continue;
+        }
+        for (size_t i = 0; i < 6; i++) {
+            mac.ether_addr_octet[i] = static_cast<uint8_t>(octets[i]);
+        }
+        return true;
+    }
+    return false;
+}
+
+//! Standard one's complement checksum over the IPv4 header
+uint16_t ipv4_hdr_checksum(const struct iphdr* hdr)
+{
+    const uint16_t* words = reinterpret_cast<const uint16_t*>(hdr);
+    uint32_t sum          = 0;
+    for (size_t i = 0; i < sizeof(struct iphdr) / 2; i++) {
+        sum += words[i];
+    }
+    while (sum >> 16) {
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+    return static_cast<uint16_t>(~sum);
+}
+
+} // namespace
+
+udp_xdp_link::udp_xdp_link(const std::string& addr,
+    const std::string& port,
+    const link_params_t& params,
+    const uhd::device_addr_t& link_args)
+    : recv_link_base_t(params.num_recv_frames, params.recv_frame_size)
+    , send_link_base_t(params.num_send_frames, params.send_frame_size)
+    , _umem_frame_size(XSK_UMEM__DEFAULT_FRAME_SIZE)
+{
+    if (inet_pton(AF_INET, addr.c_str(), &_remote_ipv4) != 1) {
+        throw uhd::value_error(std::string("XDP: Invalid destination address ") + addr);
+    }
+    _remote_port = htons(static_cast<uint16_t>(std::stoul(port)));
+
+    // Use a connected kernel socket to find the local address and to reserve
+    // a local UDP port, so nobody else on this host can claim it
+    _port_sock_fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (_port_sock_fd < 0) {
+        throw uhd::os_error(std::string("XDP: socket() failed: ") + strerror(errno));
+    }
+    struct sockaddr_in remote_sa;
+    std::memset(&remote_sa, 0, sizeof(remote_sa));
+    remote_sa.sin_family      = AF_INET;
+    remote_sa.sin_addr.s_addr = _remote_ipv4;
+    remote_sa.sin_port        = _remote_port;
+    struct sockaddr_in local_sa;
+    socklen_t local_sa_len = sizeof(local_sa);
+    if (::connect(_port_sock_fd,
+            reinterpret_cast<struct sockaddr*>(&remote_sa),
+            sizeof(remote_sa))
+            != 0
+        or ::getsockname(_port_sock_fd,
+               reinterpret_cast<struct sockaddr*>(&local_sa),
+               &local_sa_len)
+               != 0) {
+        const std::string err = strerror(errno);
+        ::close(_port_sock_fd);
+        throw uhd::os_error("XDP: Could not find a route to " + addr + ": " + err);
+    }
+    _local_ipv4 = local_sa.sin_addr.s_addr;
+    _local_port = local_sa.sin_port;
+
+    try {
+        _ifname = get_ifname_for_ipv4(_local_ipv4);
+        if (_ifname.empty()) {
+            throw uhd::runtime_error(
+                "XDP: Could not find the network interface with a route to " + addr);
+        }
+
+        // Get our own MAC address
+        struct ifreq ifr;
+        std::memset(&ifr, 0, sizeof(ifr));
+        std::strncpy(ifr.ifr_name, _ifname.c_str(), IFNAMSIZ - 1);
+        if (::ioctl(_port_sock_fd, SIOCGIFHWADDR, &ifr) != 0) {
+            throw uhd::os_error(
+                "XDP: Could not read MAC address of " + _ifname + ": " + strerror(errno));
+        }
+        std::memcpy(_local_mac.ether_addr_octet, ifr.ifr_hwaddr.sa_data, ETH_ALEN);
+
+        // The device has been talking to us through the kernel before any
+        // data links are created, so its MAC address should be known.
+        if (!lookup_arp_entry(addr, _ifname, _remote_mac)) {
+            throw uhd::runtime_error("XDP: No ARP entry for " + addr + " on "
+                                     + _ifname
+                                     + ". Make sure the device is reachable "
+                                       "(e.g., by pinging it) and try again.");
+        }
+
+        // Validate params. We only support single-buffer XDP frames.
+        if (params.recv_frame_size > XDP_MAX_FRAME_SIZE
+            or params.send_frame_size > XDP_MAX_FRAME_SIZE) {
+            throw uhd::value_error(
+                str(boost::format("XDP: Frame sizes are limited to %d bytes. Set "
+                                  "recv_frame_size and send_frame_size accordingly.")
+                    % XDP_MAX_FRAME_SIZE));
+        }
+
+        // Allocate UMEM. Receive frames come first, then send frames.
+        const size_t num_frames = params.num_recv_frames + params.num_send_frames;
+        _umem_size              = num_frames * _umem_frame_size;
+        void* area              = ::mmap(nullptr,
+            _umem_size,
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS,
+            -1,
+            0);
+        if (area == MAP_FAILED) {
+            throw uhd::os_error(
+                std::string("XDP: Could not allocate UMEM: ") + strerror(errno));
+        }
+        _umem_area = static_cast<uint8_t*>(area);
+
+        struct xsk_umem_config umem_cfg;
+        std::memset(&umem_cfg, 0, sizeof(umem_cfg));
+        umem_cfg.fill_size      = next_pow2(params.num_recv_frames);
+        umem_cfg.comp_size      = next_pow2(params.num_send_frames);
+        umem_cfg.frame_size     = _umem_frame_size;
+        umem_cfg.frame_headroom = 0;
+        int ret                 = xsk_umem__create(
+            &_umem, _umem_area, _umem_size, &_fill_ring, &_comp_ring, &umem_cfg);
+        if (ret != 0) {
+            throw uhd::os_error(
+                std::string("XDP: Could not create UMEM: ") + strerror(-ret));
+        }
+
+        // Bind the socket to a queue that no other link of ours is using
+        const uint32_t first_queue =
+            link_args.cast<uint32_t>("xdp_queue", DEFAULT_XDP_QUEUE);
+        _queue_id = xdp_queue_registry::get().alloc(_ifname, first_queue);
+
+        struct xsk_socket_config xsk_cfg;
+        std::memset(&xsk_cfg, 0, sizeof(xsk_cfg));
+        xsk_cfg.rx_size    = next_pow2(params.num_recv_frames);
+        xsk_cfg.tx_size    = next_pow2(params.num_send_frames);
+        xsk_cfg.bind_flags = XDP_USE_NEED_WAKEUP;
+        if (link_args.has_key("xdp_zero_copy")) {
+            xsk_cfg.bind_flags |= XDP_ZEROCOPY;
+        }
+        ret = xsk_socket__create(
+            &_xsk, _ifname.c_str(), _queue_id, _umem, &_rx_ring, &_tx_ring, &xsk_cfg);
+        if (ret != 0) {
+            xdp_queue_registry::get().free(_ifname, _queue_id);
+            throw uhd::os_error(str(
+                boost::format("XDP: Could not bind AF_XDP socket to %s queue %d: %s")
+                % _ifname % _queue_id % strerror(-ret)));
+        }
+        _xsk_fd = xsk_socket__fd(_xsk);
+    } catch (...) {
+        if (_umem) {
+            xsk_umem__delete(_umem);
+        }
+        if (_umem_area) {
+            ::munmap(_umem_area, _umem_size);
+        }
+        ::close(_port_sock_fd);
+        throw;
+    }
+
+    // Hand all receive frames to the kernel
+    for (size_t i = 0; i < params.num_recv_frames; i++) {
+        _recv_buffs.push_back(udp_xdp_frame_buff(_umem_area));
+        _refill(i * _umem_frame_size);
+    }
+    for (size_t i = 0; i < params.num_send_frames; i++) {
+        _send_buffs.push_back(udp_xdp_frame_buff(_umem_area));
+        _free_tx_addrs.push_back((params.num_recv_frames + i) * _umem_frame_size);
+    }
+    for (auto& buff : _recv_buffs) {
+        recv_link_base_t::preload_free_buff(&buff);
+    }
+    for (auto& buff : _send_buffs) {
+        send_link_base_t::preload_free_buff(&buff);
+    }
+
+    _install_flow_rule();
+
+    auto info   = udp_xdp_adapter_info(_ifname);
+    auto& ctx   = adapter_ctx::get();
+    _adapter_id = ctx.register_adapter(info);
+
+    UHD_LOGGER_DEBUG("XDP") << boost::format(
+                                   "Created AF_XDP link to %s:%s on %s queue %d "
+                                   "(local port %d)")
+                                   % addr % port % _ifname % _queue_id
+                                   % get_local_port();
+}
+
+udp_xdp_link::~udp_xdp_link()
+{
+    _remove_flow_rule();
+    xsk_socket__delete(_xsk);
+    xsk_umem__delete(_umem);
+    ::munmap(_umem_area, _umem_size);
+    ::close(_port_sock_fd);
+    xdp_queue_registry::get().free(_ifname, _queue_id);
+}
+
+udp_xdp_link::sptr udp_xdp_link::make(const std::string& addr,
+    const std::string& port,
+    const link_params_t& params,
+    const uhd::device_addr_t& link_args)
+{
+    UHD_ASSERT_THROW(params.num_recv_frames != 0);
+    UHD_ASSERT_THROW(params.num_send_frames != 0);
+    UHD_ASSERT_THROW(params.recv_frame_size != 0);
+    UHD_ASSERT_THROW(params.send_frame_size != 0);
+
+    return sptr(new udp_xdp_link(addr, port, params, link_args));
+}
+
+/******************************************************************************
+ * Receive path
+ *****************************************************************************/
+size_t udp_xdp_link::get_recv_buff_derived(frame_buff& buff, int32_t timeout_ms)
+{
+    auto& xdp_buff = static_cast<udp_xdp_frame_buff&>(buff);
+    bool waited    = false;
+
+    while (true) {
+        uint32_t idx = 0;
+        if (xsk_ring_cons__peek(&_rx_ring, 1, &idx) == 1) {
+            const struct xdp_desc* desc = xsk_ring_cons__rx_desc(&_rx_ring, idx);
+            const uint64_t addr         = desc->addr;
+            const uint32_t len          = desc->len;
+            xsk_ring_cons__release(&_rx_ring, 1);
+
+            if (!_is_for_us(_umem_area + addr, len)) {
+                // Not ours (e.g., a stray broadcast on our queue), drop it
+                _refill(addr);
+                continue;
+            }
+            xdp_buff.set_addr(addr);
+            return len - XDP_HDR_SIZE_UDP_IPV4;
+        }
+
+        if (waited) {
+            return 0; // timeout
+        }
+        // The kernel only fills the RX ring from the fill ring when prodded
+        // to do so, if it asked for it
+        if (xsk_ring_prod__needs_wakeup(&_fill_ring)) {
+            ::recvfrom(_xsk_fd, nullptr, 0, MSG_DONTWAIT, nullptr, nullptr);
+        }
+        if (timeout_ms != 0) {
+            struct pollfd pfd;
+            pfd.fd     = _xsk_fd;
+            pfd.events = POLLIN;
+            ::poll(&pfd, 1, timeout_ms);
+        }
+        waited = true;
+    }
+}
+
+void udp_xdp_link::release_recv_buff_derived(frame_buff& buff)
+{
+    auto& xdp_buff = static_cast<udp_xdp_frame_buff&>(buff);
+    _refill(xdp_buff.get_addr());
+    xdp_buff.clear_addr();
+}
+
+bool udp_xdp_link::_is_for_us(const uint8_t* frame, const uint32_t len) const
+{
+    if (len < XDP_HDR_SIZE_UDP_IPV4) {
+        return false;
+    }
+    const auto* eth = reinterpret_cast<const struct ether_header*>(frame);
+    if (eth->ether_type != htons(ETHERTYPE_IP)) {
+        return false;
+    }
+    const auto* ip = reinterpret_cast<const struct iphdr*>(frame + 14);
+    // We don't support IP options, so the payload offset is fixed
+    if (ip->ihl != 5 or ip->protocol != IPPROTO_UDP or ip->daddr != _local_ipv4) {
+        return false;
+    }
+    const auto* udp = reinterpret_cast<const struct udphdr*>(frame + 14 + 20);
+    return udp->dest == _local_port;
+}
+
+void udp_xdp_link::_refill(const uint64_t addr)
+{
+    uint32_t idx = 0;
+    // The fill ring is at least as large as the number of receive frames, so
+    // there is always space
+    const uint32_t reserved = xsk_ring_prod__reserve(&_fill_ring, 1, &idx);
+    UHD_ASSERT_THROW(reserved == 1);
+    // Align to the start of the frame; the kernel adds the headroom
+    *xsk_ring_prod__fill_addr(&_fill_ring, idx) = addr - (addr % _umem_frame_size);
+    xsk_ring_prod__submit(&_fill_ring, 1);
+}
+
+/******************************************************************************
+ * Send path
+ *****************************************************************************/
+bool udp_xdp_link::get_send_buff_derived(frame_buff& buff, int32_t timeout_ms)
+{
+    auto& xdp_buff = static_cast<udp_xdp_frame_buff&>(buff);
+    // Buffers that were released without being sent still own their frame
+    if (xdp_buff.get_addr() != udp_xdp_frame_buff::NO_ADDR) {
+        return true;
+    }
+
+    _reap_tx_completions();
+    if (_free_tx_addrs.empty()) {
+        _kick_tx();
+        if (timeout_ms != 0) {
+            struct pollfd pfd;
+            pfd.fd     = _xsk_fd;
+            pfd.events = POLLOUT;
+            ::poll(&pfd, 1, timeout_ms);
+        }
+        _reap_tx_completions();
+        if (_free_tx_addrs.empty()) {
+            return false;
+        }
+    }
+
+    xdp_buff.set_addr(_free_tx_addrs.back());
+    _free_tx_addrs.pop_back();
+    return true;
+}
+
+void udp_xdp_link::release_send_buff_derived(frame_buff& buff)
+{
+    auto& xdp_buff = static_cast<udp_xdp_frame_buff&>(buff);
+    const size_t payload_len = buff.packet_size();
+    _write_headers(xdp_buff.get_frame(), payload_len);
+
+    uint32_t idx = 0;
+    // The TX ring is at least as large as the number of send frames
+    const uint32_t reserved = xsk_ring_prod__reserve(&_tx_ring, 1, &idx);
+    UHD_ASSERT_THROW(reserved == 1);
+    struct xdp_desc* desc = xsk_ring_prod__tx_desc(&_tx_ring, idx);
+    desc->addr            = xdp_buff.get_addr();
+    desc->len             = static_cast<uint32_t>(payload_len + XDP_HDR_SIZE_UDP_IPV4);
+    xsk_ring_prod__submit(&_tx_ring, 1);
+    _tx_outstanding++;
+    xdp_buff.clear_addr();
+
+    _kick_tx();
+}
+
+void udp_xdp_link::_write_headers(uint8_t* frame, const size_t payload_len)
+{
+    auto* eth = reinterpret_cast<struct ether_header*>(frame);
+    std::memcpy(eth->ether_dhost, _remote_mac.ether_addr_octet, ETH_ALEN);
+    std::memcpy(eth->ether_shost, _local_mac.ether_addr_octet, ETH_ALEN);
+    eth->ether_type = htons(ETHERTYPE_IP);
+
+    auto* ip     = reinterpret_cast<struct iphdr*>(frame + 14);
+    ip->version  = 4;
+    ip->ihl      = 5;
+    ip->tos      = 0;
+    ip->tot_len  = htons(static_cast<uint16_t>(20 + 8 + payload_len));
+    ip->id       = htons(_ip_id++);
+    ip->frag_off = htons(IP_DF);
+    ip->ttl      = 64;
+    ip->protocol = IPPROTO_UDP;
+    ip->check    = 0;
+    ip->saddr    = _local_ipv4;
+    ip->daddr    = _remote_ipv4;
+    ip->check    = ipv4_hdr_checksum(ip);
+
+    auto* udp   = reinterpret_cast<struct udphdr*>(frame + 14 + 20);
+    udp->source = _local_port;
+    udp->dest   = _remote_port;
+    udp->len    = htons(static_cast<uint16_t>(8 + payload_len));
+    // The UDP checksum is optional for IPv4
+    udp->check = 0;
+}
+
+void udp_xdp_link::_reap_tx_completions()
+{
+    if (_tx_outstanding == 0) {
+        return;
+    }
+    uint32_t idx          = 0;
+    const uint32_t nb_done = xsk_ring_cons__peek(&_comp_ring, static_cast<uint32_t>(_tx_outstanding), &idx);
+    for (uint32_t i = 0; i < nb_done; i++) {
+        _free_tx_addrs.push_back(*xsk_ring_cons__comp_addr(&_comp_ring, idx + i));
+    }
+    xsk_ring_cons__release(&_comp_ring, nb_done);
+    _tx_outstanding -= nb_done;
+}
+
+void udp_xdp_link::_kick_tx()
+{
+    if (!xsk_ring_prod__needs_wakeup(&_tx_ring)) {
+        return;
+    }
+    const ssize_t ret = ::sendto(_xsk_fd, nullptr, 0, MSG_DONTWAIT, nullptr, 0);
+    // These errors only mean the kernel is busy, and will pick up our frames
+    // later
+    if (ret < 0 and errno != ENOBUFS and errno != EAGAIN and errno != EBUSY
+        and errno != ENETDOWN) {
+        throw uhd::io_error(
+            std::string("XDP: send error on AF_XDP socket: ") + strerror(errno));
+    }
+}
+
+/******************************************************************************
+ * NIC flow steering
+ *****************************************************************************/
+void udp_xdp_link::_install_flow_rule()
+{
+    struct ethtool_rxnfc nfc;
+    std::memset(&nfc, 0, sizeof(nfc));
+    nfc.cmd                          = ETHTOOL_SRXCLSRLINS;
+    nfc.fs.flow_type                 = UDP_V4_FLOW;
+    nfc.fs.h_u.udp_ip4_spec.ip4dst   = _local_ipv4;
+    nfc.fs.m_u.udp_ip4_spec.ip4dst   = 0xFFFFFFFF;
+    nfc.fs.h_u.udp_ip4_spec.pdst     = _local_port;
+    nfc.fs.m_u.udp_ip4_spec.pdst     = 0xFFFF;
+    nfc.fs.ring_cookie               = _queue_id;
+    nfc.fs.location                  = RX_CLS_LOC_ANY;
+
+    struct ifreq ifr;
+    std::memset(&ifr, 0, sizeof(ifr));
+    std::strncpy(ifr.ifr_name, _ifname.c_str(), IFNAMSIZ - 1);
+    ifr.ifr_data = reinterpret_cast<char*>(&nfc);
+    if (::ioctl(_port_sock_fd, SIOCETHTOOL, &ifr) != 0) {
+        UHD_LOG_WARNING("XDP",
+            boost::format("Could not install ntuple rule on %s (%s). Make sure "
+                          "UDP traffic to port %d is steered to queue %d, e.g. with "
+                          "`ethtool -N %s flow-type udp4 dst-port %d action %d`.")
+                % _ifname % strerror(errno) % get_local_port() % _queue_id % _ifname
+                % get_local_port() % _queue_id);
+        return;
+    }
+    _flow_rule_loc = static_cast<int>(nfc.fs.location);
+}
+
+void udp_xdp_link::_remove_flow_rule()
+{
+    if (_flow_rule_loc < 0) {
+        return;
+    }
+    struct ethtool_rxnfc nfc;
+    std::memset(&nfc, 0, sizeof(nfc));
+    nfc.cmd         = ETHTOOL_SRXCLSRLDEL;
+    nfc.fs.location = static_cast<uint32_t>(_flow_rule_loc);
+
+    struct ifreq ifr;
+    std::memset(&ifr, 0, sizeof(ifr));
+    std::strncpy(ifr.ifr_name, _ifname.c_str(), IFNAMSIZ - 1);
+    ifr.ifr_data = reinterpret_cast<char*>(&nfc);
+    if (::ioctl(_port_sock_fd, SIOCETHTOOL, &ifr) != 0) {
+        UHD_LOG_WARNING("XDP",
+            "Could not remove ntuple rule " << _flow_rule_loc << " from " << _ifname
+                                            << ": " << strerror(errno));
+    }
+    _flow_rule_loc = -1;
+}
@@ -10,9 +10,12 @@
 #include <uhdlib/transport/dpdk/common.hpp>
 #include <uhdlib/transport/dpdk/udp.hpp>
 #include <uhdlib/transport/dpdk_io_service.hpp>
+#include <uhdlib/utils/narrow.hpp>
 #include <uhdlib/utils/prefs.hpp>
 #include <arpa/inet.h>
+#include <algorithm>
 #include <rte_arp.h>
+#include <rte_rwlock.h>
 #include <boost/algorithm/string.hpp>
 
 namespace uhd { namespace transport { namespace dpdk {
@@ -26,6 +29,10 @@ constexpr size_t DPDK_HEADERS_SIZE           = 14 + 20 + 8; // Ethernet + IPv4 +
 constexpr uint16_t DPDK_DEFAULT_RING_SIZE    = 512;
 constexpr int DEFAULT_DPDK_LINK_INIT_TIMEOUT = 1000;
 constexpr int LINK_STATUS_INTERVAL           = 250;
+// Each process sharing a port allocates UDP ports from its own block, selected
+// by the first DMA queue it uses
+constexpr uint16_t UDP_PORTS_PER_QUEUE = 1024;
+constexpr uint16_t MAX_UDP_PORT_BLOCKS = 60;
 
 inline char* eal_add_opt(
     std::vector<const char*>& argv, size_t n, char* dst, const char* opt, const char* arg)
@@ -53,6 +60,58 @@ inline void separate_ipv4_addr(
     int netbits = std::atoi(result[1].c_str());
     netmask     = htonl(0xffffffff << (32 - netbits));
 }
+
+//! Split a list of lcores like "1/2/3", one per DMA queue of a NIC
+inline std::vector<size_t> separate_lcore_list(
+    const std::string& lcores, const std::string& what = "lcore")
+{
+    std::vector<std::string> result;
+    boost::algorithm::split(result,
+        lcores,
+        [](const char& in) { return in == '/'; },
+        boost::token_compress_on);
+    std::vector<size_t> lcore_ids;
+    for (const auto& lcore : result) {
+        const size_t lcore_id = std::stoul(lcore);
+        if (uhd::has(lcore_ids, lcore_id)) {
+            throw uhd::value_error(
+                "DPDK: " + what + " " + lcore + " is listed more than once for a NIC");
+        }
+        lcore_ids.push_back(lcore_id);
+    }
+    return lcore_ids;
+}
+
+/*! Get the DMA queues that the lcores of a NIC serve, one per lcore
+ *
+ * By default, the lcores serve queues 0, 1, 2 and so on. dpdk_queues assigns
+ * other queues, which is how processes sharing a NIC split its queues.
+ */
+inline std::vector<size_t> get_queue_list(const device_addr_t& conf)
+{
+    const size_t num_lcores = separate_lcore_list(conf["dpdk_lcore"]).size();
+    if (!conf.has_key("dpdk_queues")) {
+        std::vector<size_t> queues(num_lcores);
+        for (size_t i = 0; i < num_lcores; i++) {
+            queues[i] = i;
+        }
+        return queues;
+    }
+    const auto queues = separate_lcore_list(conf["dpdk_queues"], "DMA queue");
+    if (queues.size() != num_lcores) {
+        throw uhd::value_error("DPDK: dpdk_queues must list one DMA queue per lcore in "
+                               "dpdk_lcore");
+    }
+    // Queue 0 receives everything that isn't steered elsewhere, like ARP
+    // replies, so the primary process must serve it
+    if (is_secondary_process() && uhd::has(queues, size_t(0))) {
+        throw uhd::value_error("DPDK: DMA queue 0 is reserved for the primary process");
+    }
+    if (!is_secondary_process() && !uhd::has(queues, size_t(0))) {
+        throw uhd::value_error("DPDK: The primary process must serve DMA queue 0");
+    }
+    return queues;
+}
 } // namespace
 
 dpdk_port::uptr dpdk_port::make(port_id_t port,
@@ -61,10 +120,19 @@ dpdk_port::uptr dpdk_port::make(port_id_t port,
     uint16_t num_desc,
     struct rte_mempool* rx_pktbuf_pool,
     struct rte_mempool* tx_pktbuf_pool,
-    std::string ipv4_address)
+    std::string ipv4_address,
+    const port_offloads_t& offloads,
+    queue_id_t first_queue)
 {
-    return std::make_unique<dpdk_port>(
-        port, mtu, num_queues, num_desc, rx_pktbuf_pool, tx_pktbuf_pool, ipv4_address);
+    return std::make_unique<dpdk_port>(port,
+        mtu,
+        num_queues,
+        num_desc,
+        rx_pktbuf_pool,
+        tx_pktbuf_pool,
+        ipv4_address,
+        offloads,
+        first_queue);
 }
 
 dpdk_port::dpdk_port(port_id_t port,
@@ -73,14 +141,28 @@ dpdk_port::dpdk_port(port_id_t port,
     uint16_t num_desc,
     struct rte_mempool* rx_pktbuf_pool,
     struct rte_mempool* tx_pktbuf_pool,
-    std::string ipv4_address)
+    std::string ipv4_address,
+    const port_offloads_t& offloads,
+    queue_id_t first_queue)
     : _port(port)
     , _mtu(mtu)
     , _num_queues(num_queues)
+    , _offloads(offloads)
     , _rx_pktbuf_pool(rx_pktbuf_pool)
     , _tx_pktbuf_pool(tx_pktbuf_pool)
 {
-    /* Set MTU and IPv4 address */
+    separate_ipv4_addr(ipv4_address, _ipv4, _netmask);
+
+    /* Processes sharing the port allocate their UDP ports from different
+     * blocks, because the flow rules for them are port-wide */
+    _next_udp_port = 0xffff - (first_queue % MAX_UDP_PORT_BLOCKS) * UDP_PORTS_PER_QUEUE;
+
+    if (is_secondary_process()) {
+        _attach_secondary(first_queue);
+        return;
+    }
+
+    /* Set MTU */
     int retval;
 
     retval = rte_eth_dev_set_mtu(_port, _mtu);
@@ -94,8 +176,6 @@ dpdk_port::dpdk_port(port_id_t port,
         _mtu = actual_mtu;
     }
 
-    separate_ipv4_addr(ipv4_address, _ipv4, _netmask);
-
     /* Set hardware offloads */
     struct rte_eth_dev_info dev_info;
     rte_eth_dev_info_get(_port, &dev_info);
@@ -112,6 +192,28 @@ dpdk_port::dpdk_port(port_id_t port,
         throw uhd::runtime_error("DPDK: Missing required TX offloads");
     }
 
+    /* Add the optional offloads the NIC supports */
+    if (_offloads.udp_cksum) {
+        if ((dev_info.rx_offload_capa & DEV_RX_OFFLOAD_UDP_CKSUM)
+            && (dev_info.tx_offload_capa & DEV_TX_OFFLOAD_UDP_CKSUM)) {
+            rx_offloads |= DEV_RX_OFFLOAD_UDP_CKSUM;
+            tx_offloads |= DEV_TX_OFFLOAD_UDP_CKSUM;
+        } else {
+            UHD_LOGGER_WARNING("DPDK")
+                << boost::format("%d: UDP checksum offload not supported") % _port;
+            _offloads.udp_cksum = false;
+        }
+    }
+    if (_offloads.rx_timestamp) {
+        if (dev_info.rx_offload_capa & DEV_RX_OFFLOAD_TIMESTAMP) {
+            rx_offloads |= DEV_RX_OFFLOAD_TIMESTAMP;
+        } else {
+            UHD_LOGGER_WARNING("DPDK")
+                << boost::format("%d: RX timestamp offload not supported") % _port;
+            _offloads.rx_timestamp = false;
+        }
+    }
+
     // Check number of available queues
     if (dev_info.max_rx_queues < num_queues || dev_info.max_tx_queues < num_queues) {
         _num_queues = std::min(dev_info.max_rx_queues, dev_info.max_tx_queues);
@@ -166,6 +268,8 @@ dpdk_port::dpdk_port(port_id_t port,
         throw uhd::runtime_error("DPDK: Failed to configure the DMA queues");
     }
 
+    _tx_batches.resize(_num_queues);
+
     /* Set up the RX and TX DMA queues (May not be generally supported after
      * eth_dev_start) */
     unsigned int cpu_socket = rte_eth_dev_socket_id(_port);
@@ -179,7 +283,7 @@ dpdk_port::dpdk_port(port_id_t port,
         }
 
         struct rte_eth_txconf txconf = dev_info.default_txconf;
-        txconf.offloads              = DEV_TX_OFFLOAD_IPV4_CKSUM;
+        txconf.offloads              = tx_offloads;
         retval = rte_eth_tx_queue_setup(_port, i, tx_desc, cpu_socket, &txconf);
         if (retval < 0) {
             UHD_LOGGER_ERROR("DPDK")
@@ -188,8 +292,6 @@ dpdk_port::dpdk_port(port_id_t port,
         }
     }
 
-    /* TODO: Enable multiple queues (only support 1 right now) */
-
     /* Start the Ethernet device */
     retval = rte_eth_dev_start(_port);
     if (retval < 0) {
@@ -198,15 +300,108 @@ dpdk_port::dpdk_port(port_id_t port,
         throw uhd::runtime_error("DPDK: Failure to start device");
     }
 
+    /* Packets are only received on other queues than queue 0 if the NIC can
+     * steer them there by UDP port. The RX tables are per I/O service, so
+     * spreading them with RSS instead would deliver packets to an I/O service
+     * that doesn't know the flow. */
+    if (_num_queues > 1) {
+        _can_steer_flows = _make_flow_rule(rte_cpu_to_be_16(1), 1, nullptr) == 0;
+        if (!_can_steer_flows) {
+            UHD_LOGGER_WARNING("DPDK")
+                << boost::format("Port %d: Cannot steer UDP flows to DMA queues, only "
+                                 "using queue 0")
+                       % _port;
+        }
+    }
+
+    /* Set up the ARP table for secondary processes */
+    char mz_name[RTE_MEMZONE_NAMESIZE];
+    snprintf(mz_name, sizeof(mz_name), "uhd_arp_%hu", _port);
+    _shared_arp_mz = rte_memzone_reserve(
+        mz_name, sizeof(struct shared_arp_table), rte_eth_dev_socket_id(_port), 0);
+    if (_shared_arp_mz) {
+        _shared_arp              = (struct shared_arp_table*)_shared_arp_mz->addr;
+        _shared_arp->num_entries = 0;
+        rte_rwlock_init(&_shared_arp->lock);
+    } else {
+        UHD_LOGGER_WARNING("DPDK")
+            << boost::format("Port %d: Could not allocate shared ARP table, secondary "
+                             "processes won't resolve addresses")
+                   % _port;
+    }
+
     /* Grab and display the port MAC address. */
     rte_eth_macaddr_get(_port, &_mac_addr);
     UHD_LOGGER_TRACE("DPDK") << "Port " << _port
                              << " MAC: " << eth_addr_to_string(_mac_addr);
 }
 
+void dpdk_port::_attach_secondary(queue_id_t first_queue)
+{
+    /* The primary process owns the port's configuration */
+    uint16_t actual_mtu;
+    rte_eth_dev_get_mtu(_port, &actual_mtu);
+    _mtu = actual_mtu;
+
+    const struct rte_eth_dev_data* dev_data = rte_eth_devices[_port].data;
+    _num_queues = std::min(dev_data->nb_rx_queues, dev_data->nb_tx_queues);
+    if (first_queue == 0 || first_queue >= _num_queues) {
+        UHD_LOGGER_ERROR("DPDK")
+            << boost::format("Port %d: Secondary process can't use DMA queue %d, the "
+                             "primary process owns queue 0 and configured %d queues")
+                   % _port % first_queue % _num_queues;
+        throw uhd::value_error("DPDK: Invalid DMA queue for secondary process");
+    }
+    _offloads.udp_cksum = (dev_data->dev_conf.rxmode.offloads & DEV_RX_OFFLOAD_UDP_CKSUM)
+                          != 0;
+    _offloads.rx_timestamp =
+        (dev_data->dev_conf.rxmode.offloads & DEV_RX_OFFLOAD_TIMESTAMP) != 0;
+    _tx_batches.resize(_num_queues);
+
+    /* Secondary processes only receive on their own queues, which is only
+     * possible if the NIC steers flows to them */
+    _can_steer_flows = _make_flow_rule(rte_cpu_to_be_16(1), first_queue, nullptr) == 0;
+    if (!_can_steer_flows) {
+        UHD_LOGGER_ERROR("DPDK")
+            << boost::format("Port %d: Cannot steer UDP flows to DMA queues from a "
+                             "secondary process")
+                   % _port;
+        throw uhd::runtime_error("DPDK: Secondary process requires flow steering");
+    }
+
+    char mz_name[RTE_MEMZONE_NAMESIZE];
+    snprintf(mz_name, sizeof(mz_name), "uhd_arp_%hu", _port);
+    _shared_arp_mz = rte_memzone_lookup(mz_name);
+    if (!_shared_arp_mz) {
+        UHD_LOGGER_ERROR("DPDK")
+            << boost::format("Port %d: No shared ARP table, is the port served by a "
+                             "UHD primary process?")
+                   % _port;
+        throw uhd::runtime_error("DPDK: Could not find shared ARP table");
+    }
+    _shared_arp = (struct shared_arp_table*)_shared_arp_mz->addr;
+
+    rte_eth_macaddr_get(_port, &_mac_addr);
+    UHD_LOGGER_TRACE("DPDK") << "Port " << _port << " MAC: "
+                             << eth_addr_to_string(_mac_addr) << " (secondary)";
+}
+
 dpdk_port::~dpdk_port()
 {
-    rte_eth_dev_stop(_port);
+    // Only remove our own rules, other processes may be using the port
+    for (auto& rule : _flow_rules) {
+        struct rte_flow_error error;
+        rte_flow_destroy(_port, rule.second, &error);
+    }
+    for (auto& batch : _tx_batches) {
+        for (uint16_t i = 0; i < batch.count; i++) {
+            rte_pktmbuf_free(batch.mbufs[i]);
+        }
+    }
+    if (!is_secondary_process()) {
+        rte_eth_dev_stop(_port);
+        rte_memzone_free(_shared_arp_mz);
+    }
     rte_spinlock_lock(&_spinlock);
     for (auto kv : _arp_table) {
         for (auto req : kv.second->reqs) {
@@ -251,6 +446,18 @@ uint16_t dpdk_port::alloc_udp_port(uint16_t udp_port)
     return rte_cpu_to_be_16(port_selected);
 }
 
+void dpdk_port::flush_tx(queue_id_t queue_id)
+{
+    auto& batch   = _tx_batches[queue_id];
+    uint16_t sent = 0;
+    // Like sending a single packet, keep trying until the descriptor ring
+    // has room for all of them
+    while (sent < batch.count) {
+        sent += rte_eth_tx_burst(_port, queue_id, &batch.mbufs[sent], batch.count - sent);
+    }
+    batch.count = 0;
+}
+
 int dpdk_port::_arp_reply(queue_id_t queue_id, struct arp_hdr* arp_req)
 {
     struct rte_mbuf* mbuf;
@@ -283,11 +490,125 @@ int dpdk_port::_arp_reply(queue_id_t queue_id, struct arp_hdr* arp_req)
     mbuf->pkt_len  = 42;
     mbuf->data_len = 42;
 
-    if (rte_eth_tx_burst(_port, queue_id, &mbuf, 1) != 1) {
+    queue_tx(queue_id, mbuf);
+    return 0;
+}
+
+void dpdk_port::_publish_arp(ipv4_addr ipv4, const struct ether_addr& mac_addr)
+{
+    if (!_shared_arp) {
+        return;
+    }
+    rte_rwlock_write_lock(&_shared_arp->lock);
+    size_t i = 0;
+    while (i < _shared_arp->num_entries && _shared_arp->entries[i].ipv4 != ipv4) {
+        i++;
+    }
+    if (i == _shared_arp->num_entries) {
+        if (i == shared_arp_table::MAX_ENTRIES) {
+            rte_rwlock_write_unlock(&_shared_arp->lock);
+            UHD_LOG_WARNING("DPDK", "Shared ARP table is full");
+            return;
+        }
+        _shared_arp->entries[i].ipv4 = ipv4;
+        _shared_arp->num_entries++;
+    }
+    ether_addr_copy(&mac_addr, &_shared_arp->entries[i].mac_addr);
+    rte_rwlock_write_unlock(&_shared_arp->lock);
+}
+
+bool dpdk_port::_lookup_shared_arp(ipv4_addr ipv4, struct ether_addr& mac_addr)
+{
+    if (!_shared_arp) {
+        return false;
+    }
+    bool found = false;
+    rte_rwlock_read_lock(&_shared_arp->lock);
+    for (size_t i = 0; i < _shared_arp->num_entries; i++) {
+        if (_shared_arp->entries[i].ipv4 == ipv4) {
+            ether_addr_copy(&_shared_arp->entries[i].mac_addr, &mac_addr);
+            found = true;
+            break;
+        }
+    }
+    rte_rwlock_read_unlock(&_shared_arp->lock);
+    return found;
+}
+
+int dpdk_port::_add_flow_rule(uint16_t udp_port, queue_id_t queue_id)
+{
+    struct rte_flow* flow;
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_flow_rules.count(udp_port)) {
+        return -EADDRINUSE;
+    }
+    int status = _make_flow_rule(udp_port, queue_id, &flow);
+    if (status) {
+        return status;
+    }
+    _flow_rules[udp_port] = flow;
+    return 0;
+}
+
+void dpdk_port::_remove_flow_rule(uint16_t udp_port)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_flow_rules.count(udp_port) == 0) {
+        return;
+    }
+    struct rte_flow_error error;
+    if (rte_flow_destroy(_port, _flow_rules.at(udp_port), &error)) {
         UHD_LOGGER_WARNING("DPDK")
-            << boost::format("%s: TX descriptor ring is full") % __func__;
-        rte_pktmbuf_free(mbuf);
-        return -EAGAIN;
+            << boost::format("Port %d: Could not remove flow rule for UDP port %d: %s")
+                   % _port % rte_be_to_cpu_16(udp_port)
+                   % (error.message ? error.message : "unknown error");
+    }
+    _flow_rules.erase(udp_port);
+}
+
+int dpdk_port::_make_flow_rule(
+    uint16_t udp_port, queue_id_t queue_id, struct rte_flow** flow)
+{
+    struct rte_flow_attr attr = {};
+    attr.ingress              = 1;
+
+    struct rte_flow_item_ipv4 ipv4_spec = {};
+    struct rte_flow_item_ipv4 ipv4_mask = {};
+    ipv4_spec.hdr.dst_addr              = _ipv4;
+    ipv4_mask.hdr.dst_addr              = 0xffffffff;
+    struct rte_flow_item_udp udp_spec   = {};
+    struct rte_flow_item_udp udp_mask   = {};
+    udp_spec.hdr.dst_port               = udp_port;
+    udp_mask.hdr.dst_port               = 0xffff;
+
+    struct rte_flow_item pattern[4] = {};
+    pattern[0].type                 = RTE_FLOW_ITEM_TYPE_ETH;
+    pattern[1].type                 = RTE_FLOW_ITEM_TYPE_IPV4;
+    pattern[1].spec                 = &ipv4_spec;
+    pattern[1].mask                 = &ipv4_mask;
+    pattern[2].type                 = RTE_FLOW_ITEM_TYPE_UDP;
+    pattern[2].spec                 = &udp_spec;
+    pattern[2].mask                 = &udp_mask;
+    pattern[3].type                 = RTE_FLOW_ITEM_TYPE_END;
+
+    struct rte_flow_action_queue queue = {};
+    queue.index                        = queue_id;
+    struct rte_flow_action actions[2]  = {};
+    actions[0].type                    = RTE_FLOW_ACTION_TYPE_QUEUE;
+    actions[0].conf                    = &queue;
+    actions[1].type                    = RTE_FLOW_ACTION_TYPE_END;
+
+    struct rte_flow_error error;
+    if (!flow) {
+        return rte_flow_validate(_port, &attr, pattern, actions, &error);
+    }
+    *flow = rte_flow_create(_port, &attr, pattern, actions, &error);
+    if (!*flow) {
+        UHD_LOGGER_ERROR("DPDK")
+            << boost::format("Port %d: Could not steer UDP port %d to queue %d: %s")
+                   % _port % rte_be_to_cpu_16(udp_port) % queue_id
+                   % (error.message ? error.message : "unknown error");
+        return -rte_errno;
     }
     return 0;
 }
@@ -311,15 +632,17 @@ dpdk_ctx::~dpdk_ctx(void)
     std::lock_guard<std::mutex> lock(global_ctx_mutex);
     global_ctx = nullptr;
     // Destroy the io service
-    _io_srv_portid_map.clear();
+    _port_io_srvs.clear();
     // Destroy and stop all the ports
     _ports.clear();
-    // Free mempools
-    for (auto& pool : _rx_pktbuf_pools) {
-        rte_mempool_free(pool);
-    }
-    for (auto& pool : _tx_pktbuf_pools) {
-        rte_mempool_free(pool);
+    // Free mempools, unless they belong to the primary process
+    if (!is_secondary_process()) {
+        for (auto& pool : _rx_pktbuf_pools) {
+            rte_mempool_free(pool);
+        }
+        for (auto& pool : _tx_pktbuf_pools) {
+            rte_mempool_free(pool);
+        }
     }
     // Free EAL resources
     rte_eal_cleanup();
@@ -357,6 +680,8 @@ void dpdk_ctx::_eal_init(const device_addr_t& eal_args)
             opt = eal_add_opt(argv, end - opt, opt, "--file-prefix", val.c_str());
         } else if (key == "dpdk_driver") {
             opt = eal_add_opt(argv, end - opt, opt, "-d", val.c_str());
+        } else if (key == "dpdk_proc_type") {
+            opt = eal_add_opt(argv, end - opt, opt, "--proc-type", val.c_str());
         }
         /* TODO: Change where log goes?
            int rte_openlog_stream( FILE * f)
@@ -371,6 +696,9 @@ void dpdk_ctx::_eal_init(const device_addr_t& eal_args)
         UHD_LOG_ERROR("DPDK", "Error with EAL initialization");
         throw uhd::runtime_error("Error with EAL initialization");
     }
+    if (is_secondary_process()) {
+        UHD_LOG_INFO("DPDK", "Attached to the NICs as a secondary process");
+    }
 
     /* Create pktbuf pool entries, but only allocate on use  */
     int socket_count = rte_socket_count();
@@ -409,6 +737,8 @@ void dpdk_ctx::init(const device_addr_t& user_args)
         _link_init_timeout =
             dpdk_args.cast<int>("dpdk_link_timeout", DEFAULT_DPDK_LINK_INIT_TIMEOUT);
 
+        _client_spin_us = dpdk_args.cast<size_t>("dpdk_client_spin_us", 0);
+
         /* Get device info for all the NIC ports */
         int num_dpdk_ports = rte_eth_dev_count_avail();
         if (num_dpdk_ports == 0) {
@@ -439,8 +769,16 @@ void dpdk_ctx::init(const device_addr_t& user_args)
             }
             /* Now combine user args with conf file */
             auto conf = uhd::prefs::get_dpdk_nic_args(nic);
-            // TODO: Enable the use of multiple DMA queues
-            conf["dpdk_num_queues"] = "1";
+            // Every lcore serving this NIC gets its own pair of DMA queues.
+            // The primary process may set up more queues than it uses
+            // (dpdk_num_queues), so that secondary processes can share the NIC.
+            if (conf.has_key("dpdk_lcore")) {
+                const auto queues = get_queue_list(conf);
+                const size_t num_queues =
+                    std::max(conf.cast<size_t>("dpdk_num_queues", 0),
+                        *std::max_element(queues.begin(), queues.end()) + 1);
+                conf["dpdk_num_queues"] = std::to_string(num_queues);
+            }
 
             /* Update config, and remove ports that aren't fully configured */
             if (conf.has_key("dpdk_ipv4")) {
@@ -452,16 +790,18 @@ void dpdk_ctx::init(const device_addr_t& user_args)
             }
         }
 
-        std::map<size_t, std::vector<size_t>> lcore_to_port_id_map;
+        // For each lcore, the port IDs it serves and the DMA queue on each
+        std::map<size_t, std::vector<std::pair<port_id_t, queue_id_t>>>
+            lcore_to_port_queue_map;
+        // For each port, the DMA queues it is served on
+        std::map<port_id_t, std::vector<size_t>> port_queue_ids;
         RTE_ETH_FOREACH_DEV(i)
         {
             auto& conf = nics.at(i);
             if (conf.has_key("dpdk_ipv4")) {
                 UHD_ASSERT_THROW(conf.has_key("dpdk_lcore"));
-                const size_t lcore_id = conf.cast<size_t>("dpdk_lcore", 0);
-                if (!lcore_to_port_id_map.count(lcore_id)) {
-                    lcore_to_port_id_map.insert({lcore_id, {}});
-                }
+                const auto lcore_ids = separate_lcore_list(conf["dpdk_lcore"]);
+                const auto queue_ids = get_queue_list(conf);
 
                 // Allocating enough buffers for all DMA queues for each CPU socket
                 // - This is a bit inefficient for larger systems, since NICs may not
@@ -469,6 +809,9 @@ void dpdk_ctx::init(const device_addr_t& user_args)
                 auto cpu_socket = rte_eth_dev_socket_id(i);
                 auto rx_pool = _get_rx_pktbuf_pool(cpu_socket, _num_mbufs * queue_count);
                 auto tx_pool = _get_tx_pktbuf_pool(cpu_socket, _num_mbufs * queue_count);
+                port_offloads_t offloads;
+                offloads.udp_cksum    = conf.cast<bool>("dpdk_udp_cksum", false);
+                offloads.rx_timestamp = conf.cast<bool>("dpdk_rx_timestamp", false);
                 UHD_LOG_TRACE("DPDK",
                     "Initializing NIC(" << i << "):" << std::endl
                                         << conf.to_pp_string());
@@ -478,10 +821,34 @@ void dpdk_ctx::init(const device_addr_t& user_args)
                     conf.cast<uint16_t>("dpdk_num_desc", DPDK_DEFAULT_RING_SIZE),
                     rx_pool,
                     tx_pool,
-                    conf["dpdk_ipv4"]);
+                    conf["dpdk_ipv4"],
+                    offloads,
+                    uhd::narrow_cast<queue_id_t>(
+                        *std::min_element(queue_ids.begin(), queue_ids.end())));
+
+                // Additional lcores are only useful if the port can steer
+                // flows to their queues
+                const size_t num_queues = _ports[i]->can_steer_flows()
+                                              ? _ports[i]->get_queue_count()
+                                              : 1;
+                size_t num_lcores = 0;
+                while (num_lcores < lcore_ids.size()
+                       && queue_ids[num_lcores] < num_queues) {
+                    num_lcores++;
+                }
+                if (num_lcores < lcore_ids.size()) {
+                    UHD_LOG_WARNING("DPDK",
+                        "Port " << i << ": Only using the first " << num_lcores
+                                << " of the lcores " << conf["dpdk_lcore"]);
+                }
 
-                // Remember all port IDs that map to an lcore
-                lcore_to_port_id_map.at(lcore_id).push_back(i);
+                // Remember all port IDs and queues that map to an lcore
+                for (size_t idx = 0; idx < num_lcores; idx++) {
+                    lcore_to_port_queue_map[lcore_ids[idx]].push_back(
+                        {i, uhd::narrow_cast<queue_id_t>(queue_ids[idx])});
+                    port_queue_ids[i].push_back(queue_ids[idx]);
+                }
+                _port_io_srvs[i].resize(num_lcores);
             }
         }
 
@@ -515,21 +882,30 @@ void dpdk_ctx::init(const device_addr_t& user_args)
         _init_done = true;
 
         // Links are up, now create one IO service per lcore
-        for (auto& lcore_portids_pair : lcore_to_port_id_map) {
-            const size_t lcore_id = lcore_portids_pair.first;
+        for (auto& lcore_port_queues_pair : lcore_to_port_queue_map) {
+            const size_t lcore_id = lcore_port_queues_pair.first;
             std::vector<dpdk_port*> dpdk_ports;
-            dpdk_ports.reserve(lcore_portids_pair.second.size());
-            for (const size_t port_id : lcore_portids_pair.second) {
-                dpdk_ports.push_back(get_port(port_id));
+            std::vector<queue_id_t> queues;
+            dpdk_ports.reserve(lcore_port_queues_pair.second.size());
+            queues.reserve(lcore_port_queues_pair.second.size());
+            for (const auto& port_queue : lcore_port_queues_pair.second) {
+                dpdk_ports.push_back(get_port(port_queue.first));
+                queues.push_back(port_queue.second);
             }
             const size_t servq_depth = 32; // FIXME
             UHD_LOG_TRACE("DPDK",
                 "Creating I/O service for lcore "
                     << lcore_id << ", servicing " << dpdk_ports.size()
                     << " ports, service queue depth " << servq_depth);
-            _io_srv_portid_map.insert(
-                {uhd::transport::dpdk_io_service::make(lcore_id, dpdk_ports, servq_depth),
-                    lcore_portids_pair.second});
+            auto io_srv = uhd::transport::dpdk_io_service::make(
+                lcore_id, dpdk_ports, queues, servq_depth, _client_spin_us);
+            for (const auto& port_queue : lcore_port_queues_pair.second) {
+                const auto& queue_ids = port_queue_ids.at(port_queue.first);
+                const size_t idx =
+                    std::find(queue_ids.begin(), queue_ids.end(), port_queue.second)
+                    - queue_ids.begin();
+                _port_io_srvs.at(port_queue.first).at(idx) = io_srv;
+            }
         }
     }
 }
@@ -601,12 +977,13 @@ bool dpdk_ctx::is_init_done(void) const
     return _init_done.load();
 }
 
-uhd::transport::dpdk_io_service::sptr dpdk_ctx::get_io_service(const size_t port_id)
+uhd::transport::dpdk_io_service::sptr dpdk_ctx::get_io_service(
+    const size_t port_id, const uint16_t udp_port)
 {
-    for (auto& io_srv_portid_pair : _io_srv_portid_map) {
-        if (uhd::has(io_srv_portid_pair.second, port_id)) {
-            return io_srv_portid_pair.first;
-        }
+    if (_port_io_srvs.count(port_id)) {
+        // Spread the flows over the port's queues, one I/O service per queue
+        const auto& io_srvs = _port_io_srvs.at(port_id);
+        return io_srvs.at(rte_be_to_cpu_16(udp_port) % io_srvs.size());
     }
 
     std::string err_msg = std::string("Cannot look up I/O service for port ID: ")
@@ -622,6 +999,15 @@ struct rte_mempool* dpdk_ctx::_get_rx_pktbuf_pool(
         const int mbuf_size = _mtu + RTE_PKTMBUF_HEADROOM;
         char name[32];
         snprintf(name, sizeof(name), "rx_mbuf_pool_%u", cpu_socket);
+        if (is_secondary_process()) {
+            // The RX queues were set up with the primary process's pool
+            _rx_pktbuf_pools[cpu_socket] = rte_mempool_lookup(name);
+            if (!_rx_pktbuf_pools.at(cpu_socket)) {
+                UHD_LOG_ERROR("DPDK", "Could not find the primary's RX pktbuf pool");
+                throw uhd::runtime_error("DPDK: Could not find RX pktbuf pool");
+            }
+            return _rx_pktbuf_pools.at(cpu_socket);
+        }
         _rx_pktbuf_pools[cpu_socket] = rte_pktmbuf_pool_create(name,
             num_bufs,
             _mbuf_cache_size,
@@ -643,6 +1029,14 @@ struct rte_mempool* dpdk_ctx::_get_tx_pktbuf_pool(
         const int mbuf_size = _mtu + RTE_PKTMBUF_HEADROOM;
         char name[32];
         snprintf(name, sizeof(name), "tx_mbuf_pool_%u", cpu_socket);
+        if (is_secondary_process()) {
+            _tx_pktbuf_pools[cpu_socket] = rte_mempool_lookup(name);
+            if (!_tx_pktbuf_pools.at(cpu_socket)) {
+                UHD_LOG_ERROR("DPDK", "Could not find the primary's TX pktbuf pool");
+                throw uhd::runtime_error("DPDK: Could not find TX pktbuf pool");
+            }
+            return _tx_pktbuf_pools.at(cpu_socket);
+        }
         _tx_pktbuf_pools[cpu_socket] = rte_pktmbuf_pool_create(
             name, num_bufs, _mbuf_cache_size, 0, mbuf_size, SOCKET_ID_ANY);
         if (!_tx_pktbuf_pools.at(cpu_socket)) {
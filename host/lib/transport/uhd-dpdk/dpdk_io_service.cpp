@@ -5,6 +5,7 @@
 //
 
 #include <uhd/utils/log.hpp>
+#include <uhd/utils/realtime.hpp>
 #include <uhd/utils/thread.hpp>
 #include <uhdlib/transport/dpdk/arp.hpp>
 #include <uhdlib/transport/dpdk/udp.hpp>
@@ -49,17 +50,26 @@
 
 using namespace uhd::transport;
 
-dpdk_io_service::dpdk_io_service(
-    unsigned int lcore_id, std::vector<dpdk::dpdk_port*> ports, size_t servq_depth)
+dpdk_io_service::dpdk_io_service(unsigned int lcore_id,
+    std::vector<dpdk::dpdk_port*> ports,
+    std::vector<dpdk::queue_id_t> queues,
+    size_t servq_depth,
+    size_t client_spin_us)
     : _ctx(dpdk::dpdk_ctx::get())
     , _lcore_id(lcore_id)
     , _ports(ports)
+    , _queues(queues)
     , _servq(servq_depth, lcore_id)
+    , _client_spin_us(client_spin_us)
+    , _is_secondary(dpdk::is_secondary_process())
 {
     UHD_LOG_TRACE("DPDK::IO_SERVICE", "Launching I/O service for lcore " << lcore_id);
-    for (auto port : _ports) {
+    UHD_ASSERT_THROW(_ports.size() == _queues.size());
+    for (size_t i = 0; i < _ports.size(); i++) {
+        auto port = _ports[i];
         UHD_LOG_TRACE("DPDK::IO_SERVICE",
-            "lcore_id " << lcore_id << ": Adding port index " << port->get_port_id());
+            "lcore_id " << lcore_id << ": Adding port index " << port->get_port_id()
+                        << ", queue " << _queues[i]);
         _tx_queues[port->get_port_id()]      = std::list<dpdk_send_io*>();
         _recv_xport_map[port->get_port_id()] = std::list<dpdk_recv_io*>();
     }
@@ -69,10 +79,14 @@ dpdk_io_service::dpdk_io_service(
     }
 }
 
-dpdk_io_service::sptr dpdk_io_service::make(
-    unsigned int lcore_id, std::vector<dpdk::dpdk_port*> ports, size_t servq_depth)
+dpdk_io_service::sptr dpdk_io_service::make(unsigned int lcore_id,
+    std::vector<dpdk::dpdk_port*> ports,
+    std::vector<dpdk::queue_id_t> queues,
+    size_t servq_depth,
+    size_t client_spin_us)
 {
-    return dpdk_io_service::sptr(new dpdk_io_service(lcore_id, ports, servq_depth));
+    return dpdk_io_service::sptr(
+        new dpdk_io_service(lcore_id, ports, queues, servq_depth, client_spin_us));
 }
 
 dpdk_io_service::~dpdk_io_service()
@@ -272,9 +286,11 @@ int dpdk_io_service::_io_worker(void* arg)
         "I/O service thread '" << name << "' started on lcore " << lcore_id);
 
     uhd::set_thread_priority_safe();
+    uhd::setup_realtime_thread(uhd::thread_role_t::IO);
 
     snprintf(name, sizeof(name), "rx-tbl_%hu", (uint16_t)lcore_id);
-    struct rte_hash_parameters hash_params = {.name = name,
+    const std::string table_name           = dpdk::unique_name(name);
+    struct rte_hash_parameters hash_params = {.name = table_name.c_str(),
         .entries                                    = MAX_FLOWS,
         .reserved                                   = 0,
         .key_len                                    = sizeof(struct dpdk::ipv4_5tuple),
@@ -290,8 +306,8 @@ int dpdk_io_service::_io_worker(void* arg)
     int status = 0;
     while (!status) {
         /* For each port, attempt to receive packets and process */
-        for (auto port : srv->_ports) {
-            srv->_rx_burst(port, 0);
+        for (size_t i = 0; i < srv->_ports.size(); i++) {
+            srv->_rx_burst(srv->_ports[i], srv->_queues[i]);
         }
         /* For each port's TX queues, do TX */
         for (auto port : srv->_ports) {
@@ -317,9 +333,18 @@ int dpdk_io_service::_io_worker(void* arg)
             }
         }
         /* Check for open()/close()/term() requests and service 1 at a time
-         * Leave this last so we immediately terminate if requested
          */
         status = srv->_service_requests();
+        /* In secondary processes, check for ARP replies the primary got */
+        if (srv->_is_secondary) {
+            srv->_poll_shared_arp();
+        }
+        /* For each port's TX queue, send out everything queued in this pass
+         * Leave this last so nothing is left behind if we terminate
+         */
+        for (size_t i = 0; i < srv->_ports.size(); i++) {
+            srv->_ports[i]->flush_tx(srv->_queues[i]);
+        }
     }
 
     return status;
@@ -385,12 +410,14 @@ void dpdk_io_service::_service_flow_open(dpdk::wait_req* req)
 {
     auto flow_req_data = (struct dpdk_flow_data*)req->data;
     assert(flow_req_data);
+    auto port           = flow_req_data->link->get_port();
+    const auto queue_id = _get_queue_id(port);
     if (flow_req_data->is_recv) {
-        // If RX, add to RX table. Currently, nothing to do for TX.
+        // If RX, add to RX table
         struct dpdk::ipv4_5tuple ht_key = {.flow_type = dpdk::flow_type::FLOW_TYPE_UDP,
             .src_ip                                   = 0,
-            .dst_ip   = flow_req_data->link->get_port()->get_ipv4(),
-            .src_port = 0,
+            .dst_ip                                   = port->get_ipv4(),
+            .src_port                                 = 0,
             .dst_port = flow_req_data->link->get_local_port()};
         // Check the UDP port isn't in use
         if (rte_hash_lookup(_rx_table, &ht_key) > 0) {
@@ -400,16 +427,30 @@ void dpdk_io_service::_service_flow_open(dpdk::wait_req* req)
                 ;
             return;
         }
+        // Packets go to queue 0 by default, so other queues need a rule
+        if (queue_id != 0) {
+            const int status = port->_add_flow_rule(ht_key.dst_port, queue_id);
+            if (status) {
+                req->retval = status;
+                while (_servq.complete(req) == -ENOBUFS)
+                    ;
+                return;
+            }
+        }
         // Add xport list for this UDP port
         auto rx_entry = new std::list<dpdk_io_if*>();
         if (rte_hash_add_key_data(_rx_table, &ht_key, rx_entry)) {
             UHD_LOG_ERROR("DPDK::IO_SERVICE", "Could not add new RX list to table");
             delete rx_entry;
+            port->_remove_flow_rule(ht_key.dst_port);
             req->retval = -ENOMEM;
             while (_servq.complete(req) == -ENOBUFS)
                 ;
             return;
         }
+    } else {
+        // If TX, the link must only transmit on this I/O service's queue
+        flow_req_data->link->set_queue_id(queue_id);
     }
     while (_servq.complete(req) == -ENOBUFS)
         ;
@@ -420,7 +461,7 @@ void dpdk_io_service::_service_flow_close(dpdk::wait_req* req)
     auto flow_req_data = (struct dpdk_flow_data*)req->data;
     assert(flow_req_data);
     if (flow_req_data->is_recv) {
-        // If RX, remove from RX table. Currently, nothing to do for TX.
+        // If RX, remove from RX table and steering rules. Nothing to do for TX.
         struct dpdk::ipv4_5tuple ht_key = {.flow_type = dpdk::flow_type::FLOW_TYPE_UDP,
             .src_ip                                   = 0,
             .dst_ip   = flow_req_data->link->get_port()->get_ipv4(),
@@ -432,6 +473,7 @@ void dpdk_io_service::_service_flow_close(dpdk::wait_req* req)
             UHD_ASSERT_THROW(xport_list->empty());
             delete xport_list;
             rte_hash_del_key(_rx_table, &ht_key);
+            flow_req_data->link->get_port()->_remove_flow_rule(ht_key.dst_port);
             while (_servq.complete(req) == -ENOBUFS)
                 ;
             return;
@@ -588,24 +630,26 @@ int dpdk_io_service::_service_arp_request(dpdk::wait_req* req)
             goto arp_end;
         }
         entry = new (entry) dpdk::arp_entry();
-        entry->reqs.push_back(req);
         port->_arp_table[dst_addr] = entry;
-        status                     = -EAGAIN;
-        UHD_LOG_TRACE("DPDK::IO_SERVICE", "Address not in table. Sending ARP request.");
-        _send_arp_request(port, 0, arp_req_data->tpa);
-    } else {
-        entry = port->_arp_table.at(dst_addr);
-        if (is_zero_ether_addr(&entry->mac_addr)) {
-            UHD_LOG_TRACE("DPDK::IO_SERVICE",
-                "ARP: Address in table, but not populated yet. Resending ARP request.");
-            port->_arp_table.at(dst_addr)->reqs.push_back(req);
-            status = -EAGAIN;
-            _send_arp_request(port, 0, arp_req_data->tpa);
-        } else {
-            UHD_LOG_TRACE("DPDK::IO_SERVICE", "ARP: Address in table.");
-            ether_addr_copy(&entry->mac_addr, &arp_req_data->tha);
-            status = 0;
+    }
+    entry = port->_arp_table.at(dst_addr);
+    // In a secondary process, the primary may have resolved the address
+    if (is_zero_ether_addr(&entry->mac_addr) && _is_secondary) {
+        port->_lookup_shared_arp(dst_addr, entry->mac_addr);
+    }
+    if (is_zero_ether_addr(&entry->mac_addr)) {
+        UHD_LOG_TRACE("DPDK::IO_SERVICE",
+            "ARP: Address not in table or not populated yet. Sending ARP request.");
+        entry->reqs.push_back(req);
+        if (_is_secondary) {
+            port->_num_shared_arp_reqs++;
         }
+        status = -EAGAIN;
+        _send_arp_request(port, _get_queue_id(port), arp_req_data->tpa);
+    } else {
+        UHD_LOG_TRACE("DPDK::IO_SERVICE", "ARP: Address in table.");
+        ether_addr_copy(&entry->mac_addr, &arp_req_data->tha);
+        status = 0;
     }
 arp_end:
     rte_spinlock_unlock(&port->_spinlock);
@@ -646,11 +690,7 @@ int dpdk_io_service::_send_arp_request(
     mbuf->pkt_len  = 42;
     mbuf->data_len = 42;
 
-    if (rte_eth_tx_burst(port->get_port_id(), queue, &mbuf, 1) != 1) {
-        UHD_LOG_WARNING("DPDK::IO_SERVICE", "ARP request not sent: Descriptor ring full");
-        rte_pktmbuf_free(mbuf);
-        return -EAGAIN;
-    }
+    port->queue_tx(queue, mbuf);
     return 0;
 }
 
@@ -678,8 +718,15 @@ int dpdk_io_service::_rx_burst(dpdk::dpdk_port* port, dpdk::queue_id_t queue)
             case ETHER_TYPE_IPv4:
                 if ((ol_flags & PKT_RX_IP_CKSUM_MASK) == PKT_RX_IP_CKSUM_BAD) {
                     UHD_LOG_WARNING("DPDK::IO_SERVICE", "RX packet has bad IP cksum");
+                    rte_pktmbuf_free(bufs[buf]);
                 } else if ((ol_flags & PKT_RX_IP_CKSUM_MASK) == PKT_RX_IP_CKSUM_NONE) {
                     UHD_LOG_WARNING("DPDK::IO_SERVICE", "RX packet missing IP cksum");
+                    rte_pktmbuf_free(bufs[buf]);
+                } else if (port->get_offloads().udp_cksum
+                           && (ol_flags & PKT_RX_L4_CKSUM_MASK)
+                                  == PKT_RX_L4_CKSUM_BAD) {
+                    UHD_LOG_WARNING("DPDK::IO_SERVICE", "RX packet has bad UDP cksum");
+                    rte_pktmbuf_free(bufs[buf]);
                 } else {
                     _process_ipv4(port, bufs[buf], (struct ipv4_hdr*)l2_data);
                 }
@@ -720,9 +767,14 @@ int dpdk_io_service::_process_arp(
             while (_servq.complete(req) == -ENOBUFS)
                 ;
         }
+        if (_is_secondary) {
+            port->_num_shared_arp_reqs -= entry->reqs.size();
+        }
         entry->reqs.clear();
     }
     rte_spinlock_unlock(&port->_spinlock);
+    /* Let other processes sharing the port know the address */
+    port->_publish_arp(dest_ip, dest_addr);
 
     /* Respond if this was an ARP request */
     if (arp_frame->arp_op == rte_cpu_to_be_16(ARP_OP_REQUEST)
@@ -734,6 +786,32 @@ int dpdk_io_service::_process_arp(
     return 0;
 }
 
+void dpdk_io_service::_poll_shared_arp()
+{
+    for (auto port : _ports) {
+        if (port->_num_shared_arp_reqs == 0) {
+            continue;
+        }
+        rte_spinlock_lock(&port->_spinlock);
+        for (auto& ip_entry : port->_arp_table) {
+            struct dpdk::arp_entry* entry = ip_entry.second;
+            if (entry->reqs.empty()
+                || !port->_lookup_shared_arp(ip_entry.first, entry->mac_addr)) {
+                continue;
+            }
+            for (auto req : entry->reqs) {
+                auto arp_data = (struct dpdk::arp_request*)req->data;
+                ether_addr_copy(&entry->mac_addr, &arp_data->tha);
+                while (_servq.complete(req) == -ENOBUFS)
+                    ;
+            }
+            port->_num_shared_arp_reqs -= entry->reqs.size();
+            entry->reqs.clear();
+        }
+        rte_spinlock_unlock(&port->_spinlock);
+    }
+}
+
 int dpdk_io_service::_process_ipv4(
     dpdk::dpdk_port* port, struct rte_mbuf* mbuf, struct ipv4_hdr* pkt)
 {
@@ -793,6 +871,7 @@ int dpdk_io_service::_process_udp(
                     recv_io->_num_frames_in_use++;
                     assert(recv_io->_num_frames_in_use <= recv_io->_num_recv_frames);
                     _wake_client(client_if);
+                    recv_io->_ready_notifier.notify();
                 }
             }
             break;
@@ -814,9 +893,10 @@ int dpdk_io_service::_tx_burst(dpdk::dpdk_port* port)
     auto& queues          = _tx_queues.at(port->get_port_id());
 
     for (auto& send_io : queues) {
-        unsigned int num_tx   = rte_ring_count(send_io->_send_queue);
-        num_tx                = (num_tx < TX_BURST_SIZE) ? num_tx : TX_BURST_SIZE;
-        bool replaced_buffers = false;
+        unsigned int num_tx = rte_ring_count(send_io->_send_queue);
+        num_tx              = (num_tx < TX_BURST_SIZE) ? num_tx : TX_BURST_SIZE;
+        dpdk::dpdk_frame_buff* new_buffs[TX_BURST_SIZE];
+        unsigned int num_new_buffs = 0;
         for (unsigned int i = 0; i < num_tx; i++) {
             size_t frame_size = send_io->_dpdk_io_if.link->get_send_frame_size();
             if (send_io->_fc_cb && !send_io->_fc_cb(frame_size)) {
@@ -836,15 +916,21 @@ int dpdk_io_service::_tx_burst(dpdk::dpdk_port* port)
                 UHD_LOG_ERROR("DPDK::IO_SERVICE",
                     "TX mempool out of memory. Please increase dpdk_num_mbufs.");
                 send_io->_num_frames_in_use--;
-            } else if (rte_ring_enqueue(send_io->_buffer_queue, buff_ptr)) {
-                rte_pktmbuf_free(buff_ptr->get_pktmbuf());
-                send_io->_num_frames_in_use--;
             } else {
-                replaced_buffers = true;
+                new_buffs[num_new_buffs++] = buff_ptr;
             }
         }
-        if (replaced_buffers) {
-            _wake_client(&send_io->_dpdk_io_if);
+        // Hand all the replacement buffers to the client at once
+        if (num_new_buffs) {
+            if (rte_ring_enqueue_bulk(
+                    send_io->_buffer_queue, (void**)new_buffs, num_new_buffs, NULL)) {
+                _wake_client(&send_io->_dpdk_io_if);
+            } else {
+                for (unsigned int i = 0; i < num_new_buffs; i++) {
+                    rte_pktmbuf_free(new_buffs[i]->get_pktmbuf());
+                }
+                send_io->_num_frames_in_use -= num_new_buffs;
+            }
         }
         total_tx += num_tx;
     }
@@ -858,16 +944,11 @@ int dpdk_io_service::_rx_release(dpdk::dpdk_port* port)
     auto& queues            = _recv_xport_map.at(port->get_port_id());
 
     for (auto& recv_io : queues) {
-        unsigned int num_buf = rte_ring_count(recv_io->_release_queue);
-        num_buf              = (num_buf < RX_BURST_SIZE) ? num_buf : RX_BURST_SIZE;
+        dpdk::dpdk_frame_buff* buffs[RX_BURST_SIZE];
+        const unsigned int num_buf = rte_ring_dequeue_burst(
+            recv_io->_release_queue, (void**)buffs, RX_BURST_SIZE, NULL);
         for (unsigned int i = 0; i < num_buf; i++) {
-            dpdk::dpdk_frame_buff* buff_ptr;
-            int status = rte_ring_dequeue(recv_io->_release_queue, (void**)&buff_ptr);
-            if (status) {
-                UHD_LOG_ERROR("DPDK::IO_SERVICE", "RX Q Count doesn't match actual");
-                break;
-            }
-            recv_io->_fc_cb(frame_buff::uptr(buff_ptr),
+            recv_io->_fc_cb(frame_buff::uptr(buffs[i]),
                 recv_io->_dpdk_io_if.link,
                 recv_io->_dpdk_io_if.link);
             recv_io->_num_frames_in_use--;
@@ -878,6 +959,16 @@ int dpdk_io_service::_rx_release(dpdk::dpdk_port* port)
     return total_bufs;
 }
 
+dpdk::queue_id_t dpdk_io_service::_get_queue_id(dpdk::dpdk_port* port) const
+{
+    for (size_t i = 0; i < _ports.size(); i++) {
+        if (_ports[i] == port) {
+            return _queues[i];
+        }
+    }
+    throw uhd::lookup_error("DPDK::IO_SERVICE: Port is not served by this I/O service");
+}
+
 uint16_t dpdk_io_service::_get_unique_client_id()
 {
     std::lock_guard<std::mutex> lock(_mutex);
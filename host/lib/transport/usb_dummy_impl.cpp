@@ -28,6 +28,8 @@ usb_zero_copy::~usb_zero_copy(void)
     /* NOP */
 }
 
+constexpr size_t usb_zero_copy::xfer_stats_t::NUM_LATENCY_BUCKETS;
+
 std::vector<usb_device_handle::sptr> usb_device_handle::get_device_list(
     uint16_t, uint16_t)
 {
@@ -66,11 +66,15 @@ void export_metadata(py::module& m)
         // Properties
         .def_readonly("has_time_spec", &rx_metadata_t::has_time_spec)
         .def_readonly("time_spec", &rx_metadata_t::time_spec)
+        .def_readonly("has_time_ticks", &rx_metadata_t::has_time_ticks)
+        .def_readonly("time_ticks", &rx_metadata_t::time_ticks)
         .def_readonly("more_fragments", &rx_metadata_t::more_fragments)
         .def_readonly("start_of_burst", &rx_metadata_t::start_of_burst)
         .def_readonly("end_of_burst", &rx_metadata_t::end_of_burst)
         .def_readonly("error_code", &rx_metadata_t::error_code)
-        .def_readonly("out_of_sequence", &rx_metadata_t::out_of_sequence);
+        .def_readonly("out_of_sequence", &rx_metadata_t::out_of_sequence)
+        .def_readonly("num_lost_samps", &rx_metadata_t::num_lost_samps)
+        .def_readonly("burst_index", &rx_metadata_t::burst_index);
 
     py::class_<tx_metadata_t>(m, "tx_metadata")
         .def(py::init<>())
@@ -78,6 +82,8 @@ void export_metadata(py::module& m)
         // Properties
         .def_readwrite("has_time_spec", &tx_metadata_t::has_time_spec)
         .def_readwrite("time_spec", &tx_metadata_t::time_spec)
+        .def_readwrite("has_time_ticks", &tx_metadata_t::has_time_ticks)
+        .def_readwrite("time_ticks", &tx_metadata_t::time_ticks)
         .def_readwrite("start_of_burst", &tx_metadata_t::start_of_burst)
         .def_readwrite("end_of_burst", &tx_metadata_t::end_of_burst);
 
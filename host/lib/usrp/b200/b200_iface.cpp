@@ -16,6 +16,7 @@
 #include <boost/format.hpp>
 #include <boost/functional/hash.hpp>
 #include <boost/lexical_cast.hpp>
+#include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <fstream>
@@ -74,46 +75,51 @@ const static int VREQ_MAX_SIZE      = VREQ_MAX_SIZE_USB3;
 
 typedef uint32_t hash_type;
 
+//! How often to poll the FX3 state while it loads the FPGA
+constexpr auto FX3_STATE_POLL_INTERVAL = std::chrono::milliseconds(1);
+
 
 /***********************************************************************
  * Helper Functions
  **********************************************************************/
 /*!
- * Create a file hash
- * The hash will be used to identify the loaded fpga image
- * \param filename file used to generate hash value
- * \return hash value in a uint32_t type
+ * Read a whole file into memory
+ * \param filename file to read
+ * \return the contents of the file
  */
-static hash_type generate_hash(const char* filename)
+static std::vector<char> read_file(const char* filename)
 {
-    if (filename == NULL)
-        return hash_type(0);
-
-    std::ifstream file(filename);
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
     if (not file) {
         throw uhd::io_error(std::string("cannot open input file ") + filename);
     }
 
-    hash_type hash = 0;
-
-    char ch;
-    long long count = 0;
-    while (file.get(ch)) {
-        count++;
-        // hash algorithm derived from boost hash_combine
-        // http://www.boost.org/doc/libs/1_35_0/doc/html/boost/hash_combine_id241013.html
-        hash ^= ch + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-    }
-
-    if (count == 0) {
+    std::vector<char> contents(
+        static_cast<size_t>(boost::filesystem::file_size(filename)));
+    file.read(contents.data(), contents.size());
+    if (contents.empty()) {
         throw uhd::io_error(std::string("empty input file ") + filename);
     }
-
-    if (not file.eof()) {
+    if (size_t(file.gcount()) != contents.size()) {
         throw uhd::io_error(std::string("file error ") + filename);
     }
+    return contents;
+}
 
-    file.close();
+/*!
+ * Create a file hash
+ * The hash will be used to identify the loaded fpga image
+ * \param contents file contents used to generate hash value
+ * \return hash value in a uint32_t type
+ */
+static hash_type generate_hash(const std::vector<char>& contents)
+{
+    hash_type hash = 0;
+    for (const char ch : contents) {
+        // hash algorithm derived from boost hash_combine
+        // http://www.boost.org/doc/libs/1_35_0/doc/html/boost/hash_combine_id241013.html
+        hash ^= ch + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
     return hash_type(hash);
 }
 
@@ -238,10 +244,8 @@ public:
         // TODO
         // usrp_set_firmware_hash(hash); //set hash before reset
 
-        /* Success! Let the system settle. */
-        // TODO: Replace this with a polling loop in the FX3, or find out
-        // what the actual, correct timeout value is.
-        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+        // Success! The FX3 now re-enumerates with the new firmware, which
+        // b200_find() waits for.
     }
 
     void reset_fx3(void)
@@ -482,16 +486,36 @@ public:
         return static_cast<size_t>(filesize);
     }
 
+    /*! Poll the FX3 state until it is \p state
+     *
+     * \return the last state, which is \p state unless there was an error or
+     *         the timeout expired
+     */
+    uint8_t _wait_for_fx3_state(
+        const uint8_t state, const std::chrono::milliseconds timeout)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (true) {
+            const uint8_t fx3_state = get_fx3_status();
+            if ((fx3_state == state) || (std::chrono::steady_clock::now() >= deadline)
+                || (fx3_state == FX3_STATE_ERROR) || (fx3_state == FX3_STATE_UNDEFINED)) {
+                return fx3_state;
+            }
+            std::this_thread::sleep_for(FX3_STATE_POLL_INTERVAL);
+        }
+    }
+
     uint32_t load_fpga(const std::string filestring, bool force)
     {
         uint8_t fx3_state = 0;
-        uint32_t wait_count;
         int ret           = 0;
         int bytes_to_xfer = 0;
 
         const char* filename = filestring.c_str();
 
-        hash_type hash = generate_hash(filename);
+        // Read the image once, to hash it and then to send it
+        const std::vector<char> image = read_file(filename);
+        hash_type hash                = generate_hash(image);
         hash_type loaded_hash;
         usrp_get_fpga_hash(loaded_hash);
         if (hash == loaded_hash and !force)
@@ -519,14 +543,7 @@ public:
                     % transfer_size % nread)
                     .str());
 
-        const size_t file_size = _get_file_size(filename);
-
-        std::ifstream file;
-        file.open(filename, std::ios::in | std::ios::binary);
-
-        if (!file.good()) {
-            throw uhd::io_error("load_fpga: cannot open FPGA input file.");
-        }
+        const size_t file_size = image.size();
 
         // Zero the hash, in case we abort programming another image and revert to the
         // previously programmed image
@@ -547,19 +564,11 @@ public:
                     % bytes_to_xfer % ret)
                     .str());
 
-        wait_count = 0;
-        do {
-            fx3_state = get_fx3_status();
-
-            if ((wait_count >= 500) || (fx3_state == FX3_STATE_ERROR)
-                || (fx3_state == FX3_STATE_UNDEFINED)) {
-                return fx3_state;
-            }
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-
-            wait_count++;
-        } while (fx3_state != FX3_STATE_FPGA_READY);
+        fx3_state =
+            _wait_for_fx3_state(FX3_STATE_FPGA_READY, std::chrono::milliseconds(5000));
+        if (fx3_state != FX3_STATE_FPGA_READY) {
+            return fx3_state;
+        }
 
         if (load_img_msg) {
             UHD_LOGGER_INFO("B200") << "Loading FPGA image: " << filestring << "...";
@@ -579,32 +588,25 @@ public:
                     % bytes_to_xfer % ret)
                     .str());
 
-        wait_count = 0;
-        do {
-            fx3_state = get_fx3_status();
-
-            if ((wait_count >= 1000) || (fx3_state == FX3_STATE_ERROR)
-                || (fx3_state == FX3_STATE_UNDEFINED)) {
-                return fx3_state;
-            }
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-
-            wait_count++;
-        } while (fx3_state != FX3_STATE_CONFIGURING_FPGA);
+        fx3_state = _wait_for_fx3_state(
+            FX3_STATE_CONFIGURING_FPGA, std::chrono::milliseconds(10000));
+        if (fx3_state != FX3_STATE_CONFIGURING_FPGA) {
+            return fx3_state;
+        }
 
         size_t bytes_sent = 0;
-        while (!file.eof()) {
-            file.read((char*)out_buff, transfer_size);
-            const std::streamsize n = file.gcount();
-            if (n == 0)
-                continue;
+        while (bytes_sent < file_size) {
+            const uint16_t transfer_count =
+                uint16_t(std::min(file_size - bytes_sent, size_t(transfer_size)));
 
-            uint16_t transfer_count = uint16_t(n);
-
-            /* Send the data to the device. */
-            int nwritten = fx3_control_write(
-                B200_VREQ_FPGA_DATA, 0, 0, out_buff, transfer_count, 5000);
+            /* Send the data to the device. Control requests go out one at a
+             * time, so the image is sent straight from memory. */
+            int nwritten = fx3_control_write(B200_VREQ_FPGA_DATA,
+                0,
+                0,
+                (unsigned char*)(image.data() + bytes_sent),
+                transfer_count,
+                5000);
             if (nwritten < 0)
                 throw uhd::io_error(
                     (boost::format("load_fpga: cannot write bitstream to FX3 (%d: %s)")
@@ -618,38 +620,27 @@ public:
                         .str());
 
             const size_t LOG_GRANULARITY = 10; // %. Keep this an integer divisor of 100.
-            if (load_img_msg) {
-                if (bytes_sent == 0)
-                    UHD_LOGGER_DEBUG("B200") << "FPGA load:   0%" << std::flush;
-                const size_t percent_before =
-                    size_t((bytes_sent * 100) / file_size)
-                    - (size_t((bytes_sent * 100) / file_size) % LOG_GRANULARITY);
-                bytes_sent += transfer_count;
-                const size_t percent_after =
-                    size_t((bytes_sent * 100) / file_size)
-                    - (size_t((bytes_sent * 100) / file_size) % LOG_GRANULARITY);
-                if (percent_before != percent_after) {
-                    UHD_LOGGER_DEBUG("B200")
-                        << "FPGA load: " << std::setw(3) << percent_after << "%";
-                }
+            const size_t percent_before =
+                size_t((bytes_sent * 100) / file_size)
+                - (size_t((bytes_sent * 100) / file_size) % LOG_GRANULARITY);
+            if (load_img_msg and bytes_sent == 0) {
+                UHD_LOGGER_DEBUG("B200") << "FPGA load:   0%" << std::flush;
             }
-        }
-
-        file.close();
-
-        wait_count = 0;
-        do {
-            fx3_state = get_fx3_status();
-
-            if ((wait_count >= 500) || (fx3_state == FX3_STATE_ERROR)
-                || (fx3_state == FX3_STATE_UNDEFINED)) {
-                return fx3_state;
+            bytes_sent += transfer_count;
+            const size_t percent_after =
+                size_t((bytes_sent * 100) / file_size)
+                - (size_t((bytes_sent * 100) / file_size) % LOG_GRANULARITY);
+            if (load_img_msg and percent_before != percent_after) {
+                UHD_LOGGER_DEBUG("B200")
+                    << "FPGA load: " << std::setw(3) << percent_after << "%";
             }
+        }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-
-            wait_count++;
-        } while (fx3_state != FX3_STATE_RUNNING);
+        fx3_state =
+            _wait_for_fx3_state(FX3_STATE_RUNNING, std::chrono::milliseconds(5000));
+        if (fx3_state != FX3_STATE_RUNNING) {
+            return fx3_state;
+        }
 
         usrp_set_fpga_hash(hash);
 
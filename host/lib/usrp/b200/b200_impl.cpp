@@ -18,6 +18,7 @@
 #include <uhd/utils/paths.hpp>
 #include <uhd/utils/safe_call.hpp>
 #include <uhd/utils/static.hpp>
+#include <uhdlib/usrp/common/discovery_cache.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/format.hpp>
 #include <boost/functional/hash.hpp>
@@ -28,6 +29,7 @@
 #include <ctime>
 #include <functional>
 #include <memory>
+#include <thread>
 
 using namespace uhd;
 using namespace uhd::usrp;
@@ -35,7 +37,9 @@ using namespace uhd::usrp::gpio_atr;
 using namespace uhd::transport;
 
 namespace {
-constexpr int64_t REENUMERATION_TIMEOUT_MS = 3000;
+constexpr int64_t REENUMERATION_TIMEOUT_MS = 4000;
+//! How often to look for devices that are re-enumerating
+constexpr int64_t REENUMERATION_POLL_MS = 10;
 }
 
 // B200 + B210:
@@ -171,7 +175,7 @@ std::vector<usb_device_handle::sptr> get_b200_device_handles(const device_addr_t
     return usb_device_handle::get_device_list(vid_pid_pair_list);
 }
 
-static device_addrs_t b200_find(const device_addr_t& hint)
+static device_addrs_t b200_find_uncached(const device_addr_t& hint)
 {
     device_addrs_t b200_addrs;
 
@@ -228,16 +232,24 @@ static device_addrs_t b200_find(const device_addr_t& hint)
 
     const auto timeout_time = std::chrono::steady_clock::now()
                               + std::chrono::milliseconds(REENUMERATION_TIMEOUT_MS);
-    // search for the device until found or timeout
-    while (std::chrono::steady_clock::now() < timeout_time and b200_addrs.empty()
-           and found != 0) {
+    // Search until all devices are back with their firmware, or until the
+    // timeout. Devices that just got their firmware disappear for a moment and
+    // then re-enumerate, so there's no telling how long this takes.
+    while (found != 0) {
+        b200_addrs.clear();
+        size_t num_ready = 0;
         for (usb_device_handle::sptr handle : get_b200_device_handles(hint)) {
+            // Still on its way out, or not back yet
+            if (!handle->firmware_loaded()) {
+                continue;
+            }
             usb_control::sptr control;
             try {
                 control = usb_control::make(handle, 0);
             } catch (const uhd::exception&) {
                 continue;
             } // ignore claimed
+            num_ready++;
 
             b200_iface::sptr iface          = b200_iface::make(control);
             const mboard_eeprom_t mb_eeprom = b200_impl::get_mb_eeprom(iface);
@@ -261,11 +273,20 @@ static device_addrs_t b200_find(const device_addr_t& hint)
                 b200_addrs.push_back(new_addr);
             }
         }
+        if (num_ready >= found or std::chrono::steady_clock::now() >= timeout_time) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(REENUMERATION_POLL_MS));
     }
 
     return b200_addrs;
 }
 
+static device_addrs_t b200_find(const device_addr_t& hint)
+{
+    return usrp::discovery_cache::get().find("b200", hint, &b200_find_uncached);
+}
+
 /***********************************************************************
  * Make
  **********************************************************************/
@@ -594,6 +615,9 @@ b200_impl::b200_impl(
 
     data_xport_args["recv_frame_size"] = std::to_string(recv_frame_size);
     data_xport_args["num_recv_frames"] = device_addr.get("num_recv_frames", "16");
+    if (device_addr.has_key("max_recv_frames")) {
+        data_xport_args["max_recv_frames"] = device_addr["max_recv_frames"];
+    }
     data_xport_args["send_frame_size"] = device_addr.get(
         "send_frame_size", std::to_string(B200_USB_DATA_DEFAULT_FRAME_SIZE));
     data_xport_args["num_send_frames"] = device_addr.get("num_send_frames", "16");
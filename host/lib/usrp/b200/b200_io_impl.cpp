@@ -5,11 +5,12 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
-#include "../../transport/super_recv_packet_handler.hpp"
-#include "../../transport/super_send_packet_handler.hpp"
 #include "b200_impl.hpp"
 #include "b200_regs.hpp"
 #include <uhd/utils/math.hpp>
+#include <uhdlib/transport/rx_streamer_impl.hpp>
+#include <uhdlib/transport/tx_streamer_impl.hpp>
+#include <uhdlib/transport/vrt_data_xport.hpp>
 #include <uhdlib/usrp/common/async_packet_handler.hpp>
 #include <uhdlib/usrp/common/validate_subdev_spec.hpp>
 #include <functional>
@@ -20,6 +21,114 @@ using namespace uhd;
 using namespace uhd::usrp;
 using namespace uhd::transport;
 
+/***********************************************************************
+ * Streamers
+ **********************************************************************/
+//! Wire format of the samples, used to pick the converters
+static const std::string B200_OTW_FORMAT_SUFFIX = "_item32_le";
+
+class b200_rx_streamer : public rx_streamer_impl<vrt_rx_data_xport>
+{
+public:
+    using issue_stream_cmd_fn_t = std::function<void(const stream_cmd_t&)>;
+
+    b200_rx_streamer(const size_t num_chans, const uhd::stream_args_t& stream_args)
+        : rx_streamer_impl<vrt_rx_data_xport>(
+            num_chans, stream_args, B200_OTW_FORMAT_SUFFIX)
+        , _issue_stream_cmd(num_chans)
+    {
+    }
+
+    //! Sets the function that sends stream commands to the radio of a channel
+    void set_issue_stream_cmd(const size_t chan, issue_stream_cmd_fn_t issue_stream_cmd)
+    {
+        _issue_stream_cmd.at(chan) = issue_stream_cmd;
+    }
+
+    void issue_stream_cmd(const stream_cmd_t& stream_cmd)
+    {
+        if (get_num_channels() > 1 and stream_cmd.stream_now
+            and stream_cmd.stream_mode != stream_cmd_t::STREAM_MODE_STOP_CONTINUOUS) {
+            throw uhd::runtime_error(
+                "Invalid recv stream command - stream now on multiple channels in a "
+                "single streamer will fail to time align.");
+        }
+
+        for (const auto& issue_stream_cmd : _issue_stream_cmd) {
+            if (issue_stream_cmd) {
+                issue_stream_cmd(stream_cmd);
+            }
+        }
+    }
+
+    //! Sets the scale factor of all channels
+    void set_scale_factor(const double scale_factor)
+    {
+        for (size_t chan = 0; chan < get_num_channels(); chan++) {
+            rx_streamer_impl<vrt_rx_data_xport>::set_scale_factor(chan, scale_factor);
+        }
+    }
+
+    //! Handles the error code of an inline message from the radio
+    void handle_inline_msg(const rx_metadata_t::error_code_t error_code)
+    {
+        switch (error_code) {
+            case rx_metadata_t::ERROR_CODE_OVERFLOW:
+                UHD_LOG_FASTPATH("O");
+                set_stopped_due_to_overrun();
+                break;
+            case rx_metadata_t::ERROR_CODE_LATE_COMMAND:
+                UHD_LOG_FASTPATH("L");
+                set_stopped_due_to_late_command();
+                break;
+            default:
+                UHD_LOGGER_DEBUG("B200")
+                    << "Ignoring RX inline message with error code " << error_code;
+        }
+    }
+
+    using rx_streamer_impl<vrt_rx_data_xport>::set_overrun_handler;
+    using rx_streamer_impl<vrt_rx_data_xport>::set_samp_rate;
+    using rx_streamer_impl<vrt_rx_data_xport>::set_tick_rate;
+
+private:
+    std::vector<issue_stream_cmd_fn_t> _issue_stream_cmd;
+};
+
+class b200_tx_streamer : public tx_streamer_impl<vrt_tx_data_xport>
+{
+public:
+    using async_receiver_fn_t = std::function<bool(async_metadata_t&, double)>;
+
+    b200_tx_streamer(const size_t num_chans,
+        const uhd::stream_args_t& stream_args,
+        async_receiver_fn_t async_receiver)
+        : tx_streamer_impl<vrt_tx_data_xport>(
+            num_chans, stream_args, B200_OTW_FORMAT_SUFFIX)
+        , _async_receiver(async_receiver)
+    {
+    }
+
+    bool recv_async_msg(async_metadata_t& async_metadata, double timeout)
+    {
+        return _async_receiver(async_metadata, timeout);
+    }
+
+    //! Sets the scale factor of all channels
+    void set_scale_factor(const double scale_factor)
+    {
+        for (size_t chan = 0; chan < get_num_channels(); chan++) {
+            tx_streamer_impl<vrt_tx_data_xport>::set_scale_factor(chan, scale_factor);
+        }
+    }
+
+    using tx_streamer_impl<vrt_tx_data_xport>::set_samp_rate;
+    using tx_streamer_impl<vrt_tx_data_xport>::set_tick_rate;
+
+private:
+    async_receiver_fn_t _async_receiver;
+};
+
 /***********************************************************************
  * update streamer rates
  **********************************************************************/
@@ -37,15 +146,15 @@ size_t b200_impl::max_chan_count(const std::string& direction /* = "" */)
     for (radio_perifs_t& perif : _radio_perifs) {
         if ((direction == "RX" or direction.empty())
             and not perif.rx_streamer.expired()) {
-            std::shared_ptr<sph::recv_packet_streamer> rx_streamer =
-                std::dynamic_pointer_cast<sph::recv_packet_streamer>(
+            std::shared_ptr<b200_rx_streamer> rx_streamer =
+                std::dynamic_pointer_cast<b200_rx_streamer>(
                     perif.rx_streamer.lock());
             max_count = std::max(max_count, rx_streamer->get_num_channels());
         }
         if ((direction == "TX" or direction.empty())
             and not perif.tx_streamer.expired()) {
-            std::shared_ptr<sph::send_packet_streamer> tx_streamer =
-                std::dynamic_pointer_cast<sph::send_packet_streamer>(
+            std::shared_ptr<b200_tx_streamer> tx_streamer =
+                std::dynamic_pointer_cast<b200_tx_streamer>(
                     perif.tx_streamer.lock());
             max_count = std::max(max_count, tx_streamer->get_num_channels());
         }
@@ -142,16 +251,16 @@ void b200_impl::update_tick_rate(const double new_tick_rate)
     check_tick_rate_with_current_streamers(new_tick_rate);
 
     for (radio_perifs_t& perif : _radio_perifs) {
-        std::shared_ptr<sph::recv_packet_streamer> my_streamer =
-            std::dynamic_pointer_cast<sph::recv_packet_streamer>(
+        std::shared_ptr<b200_rx_streamer> my_streamer =
+            std::dynamic_pointer_cast<b200_rx_streamer>(
                 perif.rx_streamer.lock());
         if (my_streamer)
             my_streamer->set_tick_rate(new_tick_rate);
         perif.framer->set_tick_rate(new_tick_rate);
     }
     for (radio_perifs_t& perif : _radio_perifs) {
-        std::shared_ptr<sph::send_packet_streamer> my_streamer =
-            std::dynamic_pointer_cast<sph::send_packet_streamer>(
+        std::shared_ptr<b200_tx_streamer> my_streamer =
+            std::dynamic_pointer_cast<b200_tx_streamer>(
                 perif.tx_streamer.lock());
         if (my_streamer)
             my_streamer->set_tick_rate(new_tick_rate);
@@ -204,8 +313,8 @@ double b200_impl::coerce_rx_samp_rate(
 
 void b200_impl::update_rx_samp_rate(const size_t dspno, const double rate)
 {
-    std::shared_ptr<sph::recv_packet_streamer> my_streamer =
-        std::dynamic_pointer_cast<sph::recv_packet_streamer>(
+    std::shared_ptr<b200_rx_streamer> my_streamer =
+        std::dynamic_pointer_cast<b200_rx_streamer>(
             _radio_perifs[dspno].rx_streamer.lock());
     if (not my_streamer)
         return;
@@ -231,8 +340,8 @@ double b200_impl::coerce_tx_samp_rate(
 
 void b200_impl::update_tx_samp_rate(const size_t dspno, const double rate)
 {
-    std::shared_ptr<sph::send_packet_streamer> my_streamer =
-        std::dynamic_pointer_cast<sph::send_packet_streamer>(
+    std::shared_ptr<b200_tx_streamer> my_streamer =
+        std::dynamic_pointer_cast<b200_tx_streamer>(
             _radio_perifs[dspno].tx_streamer.lock());
     if (not my_streamer)
         return;
@@ -405,7 +514,20 @@ rx_streamer::sptr b200_impl::get_rx_stream(const uhd::stream_args_t& args_)
     }
     check_streamer_args(args, this->get_tick_rate(), "RX");
 
-    std::shared_ptr<sph::recv_packet_streamer> my_streamer;
+    // calculate packet size
+    static const size_t hdr_size =
+        0
+        + vrt::max_if_hdr_words32 * sizeof(uint32_t)
+        //+ sizeof(vrt::if_packet_info_t().tlr) //no longer using trailer
+        - sizeof(vrt::if_packet_info_t().cid) // no class id ever used
+        - sizeof(vrt::if_packet_info_t().tsi) // no int time ever used
+        ;
+    const size_t bpp = _data_transport->get_recv_frame_size() - hdr_size;
+    const size_t bpi = convert::get_bytes_per_item(args.otw_format);
+    // FPGA FIFO maximum for framing at full rate
+    const size_t max_payload_size = std::min<size_t>(4092 * bpi, bpp);
+
+    auto my_streamer = std::make_shared<b200_rx_streamer>(args.channels.size(), args);
     for (size_t stream_i = 0; stream_i < args.channels.size(); stream_i++) {
         const size_t radio_index =
             _tree->access<std::vector<size_t>>("/mboards/0/rx_chan_dsp_mapping")
@@ -422,49 +544,31 @@ rx_streamer::sptr b200_impl::get_rx_stream(const uhd::stream_args_t& args_)
             perif.ctrl->poke32(TOREG(SR_RX_FMT), 3);
         const uint32_t sid = radio_index ? B200_RX_DATA1_SID : B200_RX_DATA0_SID;
 
-        // calculate packet size
-        static const size_t hdr_size =
-            0
-            + vrt::max_if_hdr_words32 * sizeof(uint32_t)
-            //+ sizeof(vrt::if_packet_info_t().tlr) //no longer using trailer
-            - sizeof(vrt::if_packet_info_t().cid) // no class id ever used
-            - sizeof(vrt::if_packet_info_t().tsi) // no int time ever used
-            ;
-        const size_t bpp = _data_transport->get_recv_frame_size() - hdr_size;
-        const size_t bpi = convert::get_bytes_per_item(args.otw_format);
-        size_t spp       = unsigned(args.args.cast<double>("spp", bpp / bpi));
-        spp = std::min<size_t>(4092, spp); // FPGA FIFO maximum for framing at full rate
-
-        // make the new streamer given the samples per packet
-        if (not my_streamer)
-            my_streamer = std::make_shared<sph::recv_packet_streamer>(spp);
-        my_streamer->resize(args.channels.size());
-
-        // init some streamer stuff
-        my_streamer->set_vrt_unpacker(&b200_if_hdr_unpack_le);
-
-        // set the converter
-        uhd::convert::id_type id;
-        id.input_format  = args.otw_format + "_item32_le";
-        id.num_inputs    = 1;
-        id.output_format = args.cpu_format;
-        id.num_outputs   = 1;
-        my_streamer->set_converter(id);
+        // The streamer owns the transport, so the message handler can't
+        // outlive it
+        b200_rx_streamer* streamer_ptr = my_streamer.get();
+        vrt_rx_data_xport::uptr xport(new vrt_rx_data_xport(
+            std::bind(&recv_packet_demuxer_3000::get_recv_buff,
+                _demux,
+                sid,
+                std::placeholders::_1),
+            &b200_if_hdr_unpack_le,
+            max_payload_size,
+            [streamer_ptr](const rx_metadata_t::error_code_t error_code) {
+                streamer_ptr->handle_inline_msg(error_code);
+            }));
+        my_streamer->connect_channel(stream_i, std::move(xport));
 
         perif.framer->clear();
-        perif.framer->set_nsamps_per_packet(spp);
+        perif.framer->set_nsamps_per_packet(my_streamer->get_max_num_samps());
         perif.framer->set_sid(sid);
         perif.framer->setup(args);
         perif.ddc->setup(args);
         _demux->realloc_sid(sid);
-        my_streamer->set_xport_chan_get_buff(stream_i,
-            std::bind(&recv_packet_demuxer_3000::get_recv_buff,
-                _demux,
-                sid,
-                std::placeholders::_1),
-            true /*flush*/);
-        my_streamer->set_overflow_handler(
-            stream_i, std::bind(&b200_impl::handle_overflow, this, radio_index));
+        if (stream_i == 0) {
+            my_streamer->set_overrun_handler(
+                std::bind(&b200_impl::handle_overflow, this, radio_index));
+        }
         my_streamer->set_issue_stream_cmd(stream_i,
             std::bind(&rx_vita_core_3000::issue_stream_command,
                 perif.framer,
@@ -485,8 +589,8 @@ rx_streamer::sptr b200_impl::get_rx_stream(const uhd::stream_args_t& args_)
 
 void b200_impl::handle_overflow(const size_t radio_index)
 {
-    std::shared_ptr<sph::recv_packet_streamer> my_streamer =
-        std::dynamic_pointer_cast<sph::recv_packet_streamer>(
+    std::shared_ptr<b200_rx_streamer> my_streamer =
+        std::dynamic_pointer_cast<b200_rx_streamer>(
             _radio_perifs[radio_index].rx_streamer.lock());
     if (my_streamer->get_num_channels() == 2) // MIMO time
     {
@@ -532,7 +636,22 @@ tx_streamer::sptr b200_impl::get_tx_stream(const uhd::stream_args_t& args_)
     }
     check_streamer_args(args, this->get_tick_rate(), "TX");
 
-    std::shared_ptr<sph::send_packet_streamer> my_streamer;
+    // calculate packet size
+    static const size_t hdr_size =
+        0
+        + vrt::max_if_hdr_words32 * sizeof(uint32_t)
+        //+ sizeof(vrt::if_packet_info_t().tlr) //forced to have trailer
+        - sizeof(vrt::if_packet_info_t().cid) // no class id ever used
+        - sizeof(vrt::if_packet_info_t().tsi) // no int time ever used
+        ;
+    const size_t bpp = _data_transport->get_send_frame_size() - hdr_size;
+
+    auto my_streamer = std::make_shared<b200_tx_streamer>(args.channels.size(),
+        args,
+        std::bind(&async_md_type::pop_with_timed_wait,
+            _async_task_data->async_md,
+            std::placeholders::_1,
+            std::placeholders::_2));
     for (size_t stream_i = 0; stream_i < args.channels.size(); stream_i++) {
         const size_t radio_index =
             _tree->access<std::vector<size_t>>("/mboards/0/tx_chan_dsp_mapping")
@@ -548,48 +667,18 @@ tx_streamer::sptr b200_impl::get_tx_stream(const uhd::stream_args_t& args_)
         if (args.otw_format == "sc8")
             perif.ctrl->poke32(TOREG(SR_TX_FMT), 3);
 
-        // calculate packet size
-        static const size_t hdr_size =
-            0
-            + vrt::max_if_hdr_words32 * sizeof(uint32_t)
-            //+ sizeof(vrt::if_packet_info_t().tlr) //forced to have trailer
-            - sizeof(vrt::if_packet_info_t().cid) // no class id ever used
-            - sizeof(vrt::if_packet_info_t().tsi) // no int time ever used
-            ;
-        static const size_t bpp = _data_transport->get_send_frame_size() - hdr_size;
-        const size_t spp        = bpp / convert::get_bytes_per_item(args.otw_format);
-
-        // make the new streamer given the samples per packet
-        if (not my_streamer)
-            my_streamer = std::make_shared<sph::send_packet_streamer>(spp);
-        my_streamer->resize(args.channels.size());
-
-        // init some streamer stuff
-        my_streamer->set_vrt_packer(&b200_if_hdr_pack_le);
-
-        // set the converter
-        uhd::convert::id_type id;
-        id.input_format  = args.cpu_format;
-        id.num_inputs    = 1;
-        id.output_format = args.otw_format + "_item32_le";
-        id.num_outputs   = 1;
-        my_streamer->set_converter(id);
-
         perif.deframer->clear();
         perif.deframer->setup(args);
         perif.duc->setup(args);
 
-        my_streamer->set_xport_chan_get_buff(stream_i,
+        // TODO not implemented trailer support yet
+        vrt_tx_data_xport::uptr xport(new vrt_tx_data_xport(
             std::bind(
-                &zero_copy_if::get_send_buff, _data_transport, std::placeholders::_1));
-        my_streamer->set_async_receiver(std::bind(&async_md_type::pop_with_timed_wait,
-            _async_task_data->async_md,
-            std::placeholders::_1,
-            std::placeholders::_2));
-        my_streamer->set_xport_chan_sid(
-            stream_i, true, radio_index ? B200_TX_DATA1_SID : B200_TX_DATA0_SID);
-        my_streamer->set_enable_trailer(false); // TODO not implemented trailer support
-                                                // yet
+                &zero_copy_if::get_send_buff, _data_transport, std::placeholders::_1),
+            &b200_if_hdr_pack_le,
+            radio_index ? B200_TX_DATA1_SID : B200_TX_DATA0_SID,
+            bpp));
+        my_streamer->connect_channel(stream_i, std::move(xport));
         perif.tx_streamer = my_streamer; // store weak pointer
 
         // sets all tick and samp rates on this streamer
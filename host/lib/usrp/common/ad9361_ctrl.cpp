@@ -178,6 +178,29 @@ public:
         return return_val;
     }
 
+    std::vector<double> set_hop_set(
+        const std::string& which, const std::vector<double>& freqs)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        const meta_range_t freq_range = ad9361_ctrl::get_rf_freq_range();
+        std::vector<double> clipped_freqs;
+        for (const double freq : freqs) {
+            clipped_freqs.push_back(freq_range.clip(freq));
+        }
+
+        ad9361_device_t::direction_t direction = _get_direction_from_antenna(which);
+        return _device.set_hop_set(direction, clipped_freqs);
+    }
+
+    double hop(const std::string& which, const size_t index)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        ad9361_device_t::direction_t direction = _get_direction_from_antenna(which);
+        return _device.hop(direction, index);
+    }
+
     //! get the current frequency for the given frontend
     double get_freq(const std::string& which)
     {
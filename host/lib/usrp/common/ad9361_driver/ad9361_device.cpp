@@ -84,6 +84,8 @@ const double ad9361_device_t::AD9361_MAX_GAIN         = 89.75;
 const double ad9361_device_t::AD9361_MIN_CLOCK_RATE   = 220e3;
 const double ad9361_device_t::AD9361_MAX_CLOCK_RATE   = 61.44e6;
 const double ad9361_device_t::AD9361_CAL_VALID_WINDOW = 100e6;
+// Temperature change in degrees C that invalidates the analog filter calibrations
+const double ad9361_device_t::AD9361_CAL_VALID_TEMP_WINDOW = 10.0;
 // Max bandwdith is due to filter rolloff in analog filter stage
 const double ad9361_device_t::AD9361_MIN_BW = 200e3;
 const double ad9361_device_t::AD9361_MAX_BW = 56e6;
@@ -279,10 +281,14 @@ void ad9361_device_t::_calibrate_lock_bbpll()
 
 /* Calibrate the synthesizer charge pumps.
  *
- * Technically, this calibration only needs to be done once, at device
- * initialization. */
+ * This calibration only needs to be done once, at device initialization, so
+ * it is skipped on any later calls. */
 void ad9361_device_t::_calibrate_synth_charge_pumps()
 {
+    if (_synth_charge_pumps_calibrated) {
+        return;
+    }
+
     /* If this function ever gets called, and the ENSM isn't already in the
      * ALERT state, then something has gone horribly wrong. */
     if ((_io_iface->peek8(0x017) & 0x0F) != 5) {
@@ -314,6 +320,8 @@ void ad9361_device_t::_calibrate_synth_charge_pumps()
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
     _io_iface->poke8(0x27d, 0x00);
+
+    _synth_charge_pumps_calibrated = true;
 }
 
 /* Calibrate the analog BB RX filter.
@@ -1135,21 +1143,8 @@ void ad9361_device_t::_setup_gain_control(bool agc)
  * This setup depends on a fixed look-up table, which is stored in an
  * included header file. The table is indexed based on the passed VCO rate.
  */
-void ad9361_device_t::_setup_synth(direction_t direction, double vcorate)
+void ad9361_device_t::_setup_synth(direction_t direction, int vcoindex)
 {
-    /* The vcorates in the vco_index array represent lower boundaries for
-     * rates. Once we find a match, we use that index to look-up the rest of
-     * the register values in the LUT. */
-    int vcoindex = 0;
-    for (size_t i = 0; i < 53; i++) {
-        vcoindex = i;
-        if (vcorate > vco_index[i]) {
-            break;
-        }
-    }
-    if (vcoindex > 53)
-        throw uhd::runtime_error("[ad9361_device_t] vcoindex > 53");
-
     /* Parse the values out of the LUT based on our calculated index... */
     uint8_t vco_output_level = synth_cal_lut[vcoindex][0];
     uint8_t vco_varactor     = synth_cal_lut[vcoindex][1];
@@ -1288,11 +1283,12 @@ void ad9361_device_t::_reprogram_gains()
     set_gain(TX, CHAIN_2, _tx2_gain);
 }
 
-/* This is the internal tune function, not available for a host call.
+/* Calculate the synthesizer settings for an RX or TX frequency.
  *
- * Calculate the VCO settings for the requested frquency, and then either
- * tune the RX or TX VCO. */
-double ad9361_device_t::_tune_helper(direction_t direction, const double value)
+ * This doesn't touch the hardware, so the settings of a hop set can be
+ * calculated ahead of time. */
+ad9361_device_t::synth_config_t ad9361_device_t::_calc_synth(
+    direction_t direction, const double value)
 {
     /* The RFPLL runs from 6 GHz - 12 GHz */
     const double fref   = 80e6;
@@ -1313,97 +1309,150 @@ double ad9361_device_t::_tune_helper(direction_t direction, const double value)
     if (i == 7)
         throw uhd::runtime_error("[ad9361_device_t] RFVCO can't find valid VCO rate!");
 
-    int nint  = static_cast<int>(vcorate / fref);
-    int nfrac = static_cast<int>(((vcorate / fref) - nint) * modulus);
+    synth_config_t synth;
+    synth.req_freq = value;
+    synth.vcodiv   = i & 0x0F;
+    synth.nint     = static_cast<int>(vcorate / fref);
+    synth.nfrac    = static_cast<int>(((vcorate / fref) - synth.nint) * modulus);
 
-    double actual_vcorate = fref * (nint + (double)(nfrac) / modulus);
-    double actual_lo      = actual_vcorate / vcodiv;
+    double actual_vcorate = fref * (synth.nint + (double)(synth.nfrac) / modulus);
+    synth.actual_lo       = actual_vcorate / vcodiv;
 
-    if (direction == RX) {
-        _req_rx_freq = value;
+    /* The vcorates in the vco_index array represent lower boundaries for
+     * rates. Once we find a match, we use that index to look-up the rest of
+     * the register values in the LUT. */
+    for (size_t j = 0; j < 53; j++) {
+        synth.vcoindex = j;
+        if (actual_vcorate > vco_index[j]) {
+            break;
+        }
+    }
+    if (synth.vcoindex > 53)
+        throw uhd::runtime_error("[ad9361_device_t] vcoindex > 53");
 
-        /* Set band-specific settings. */
+    /* Set band-specific settings. */
+    if (direction == RX) {
         if (value < _client_params->get_band_edge(AD9361_RX_BAND0)) {
-            _regs.inputsel = (_regs.inputsel & 0xC0) | 0x30; // Port C, balanced
+            synth.inputsel = 0x30; // Port C, balanced
         } else if ((value >= _client_params->get_band_edge(AD9361_RX_BAND0))
                    && (value < _client_params->get_band_edge(AD9361_RX_BAND1))) {
-            _regs.inputsel = (_regs.inputsel & 0xC0) | 0x0C; // Port B, balanced
+            synth.inputsel = 0x0C; // Port B, balanced
         } else if ((value >= _client_params->get_band_edge(AD9361_RX_BAND1))
                    && (value <= 6e9)) {
-            _regs.inputsel = (_regs.inputsel & 0xC0) | 0x03; // Port A, balanced
+            synth.inputsel = 0x03; // Port A, balanced
         } else {
             throw uhd::runtime_error(
-                "[ad9361_device_t] [_tune_helper] INVALID_CODE_PATH");
+                "[ad9361_device_t] [_calc_synth] INVALID_CODE_PATH");
         }
-
-        _io_iface->poke8(0x004, _regs.inputsel);
-
-        /* Store vcodiv setting. */
-        _regs.vcodivs = (_regs.vcodivs & 0xF0) | (i & 0x0F);
-
-        /* Setup the synthesizer. */
-        _setup_synth(RX, actual_vcorate);
-
-        /* Tune!!!! */
-        _io_iface->poke8(0x233, nfrac & 0xFF);
-        _io_iface->poke8(0x234, (nfrac >> 8) & 0xFF);
-        _io_iface->poke8(0x235, (nfrac >> 16) & 0xFF);
-        _io_iface->poke8(0x232, (nint >> 8) & 0xFF);
-        _io_iface->poke8(0x231, nint & 0xFF);
-        _io_iface->poke8(0x005, _regs.vcodivs);
-
-        /* Lock the PLL! */
-        std::this_thread::sleep_for(std::chrono::milliseconds(2));
-        if ((_io_iface->peek8(0x247) & 0x02) == 0) {
-            throw uhd::runtime_error("[ad9361_device_t] RX PLL NOT LOCKED");
-        }
-
-        _rx_freq = actual_lo;
-
-        return actual_lo;
-
     } else {
-        _req_tx_freq = value;
-
-        /* Set band-specific settings. */
         if (value < _client_params->get_band_edge(AD9361_TX_BAND0)) {
-            _regs.inputsel = _regs.inputsel | 0x40;
+            synth.inputsel = 0x40;
         } else if ((value >= _client_params->get_band_edge(AD9361_TX_BAND0))
                    && (value <= 6e9)) {
-            _regs.inputsel = _regs.inputsel & 0xBF;
+            synth.inputsel = 0x00;
         } else {
             throw uhd::runtime_error(
-                "[ad9361_device_t] [_tune_helper] INVALID_CODE_PATH");
+                "[ad9361_device_t] [_calc_synth] INVALID_CODE_PATH");
         }
+    }
 
-        _io_iface->poke8(0x004, _regs.inputsel);
+    return synth;
+}
 
-        /* Store vcodiv setting. */
-        _regs.vcodivs = (_regs.vcodivs & 0x0F) | ((i & 0x0F) << 4);
+/* Program the RX or TX synthesizer, and wait for it to lock.
+ *
+ * Only the registers that differ from the last programmed settings are
+ * written, with the exception of the integer word LSB, which is always
+ * written. The register soft-copies are invalid after a failed tune, so the
+ * next tune writes everything again. */
+void ad9361_device_t::_program_synth(
+    direction_t direction, const synth_config_t& synth, bool poll_lock)
+{
+    synth_config_t& current   = (direction == RX) ? _rx_synth : _tx_synth;
+    const synth_config_t last = current;
+    current                   = synth_config_t();
+    const bool write_all      = (last.vcoindex < 0);
+    /* The TX synthesizer registers are the RX ones, offset by 0x40 */
+    const uint16_t offset = (direction == RX) ? 0x000 : 0x040;
+
+    uint8_t inputsel, vcodivs;
+    if (direction == RX) {
+        _req_rx_freq = synth.req_freq;
+        inputsel     = (_regs.inputsel & 0xC0) | synth.inputsel;
+        vcodivs      = (_regs.vcodivs & 0xF0) | synth.vcodiv;
+    } else {
+        _req_tx_freq = synth.req_freq;
+        inputsel     = (_regs.inputsel & 0xBF) | synth.inputsel;
+        vcodivs      = (_regs.vcodivs & 0x0F) | (synth.vcodiv << 4);
+    }
 
-        /* Setup the synthesizer. */
-        _setup_synth(TX, actual_vcorate);
+    if (write_all || inputsel != _regs.inputsel) {
+        _regs.inputsel = inputsel;
+        _io_iface->poke8(0x004, _regs.inputsel);
+    }
 
-        /* Tune it, homey. */
-        _io_iface->poke8(0x273, nfrac & 0xFF);
-        _io_iface->poke8(0x274, (nfrac >> 8) & 0xFF);
-        _io_iface->poke8(0x275, (nfrac >> 16) & 0xFF);
-        _io_iface->poke8(0x272, (nint >> 8) & 0xFF);
-        _io_iface->poke8(0x271, nint & 0xFF);
-        _io_iface->poke8(0x005, _regs.vcodivs);
+    /* Setup the synthesizer. */
+    if (write_all || synth.vcoindex != last.vcoindex) {
+        _setup_synth(direction, synth.vcoindex);
+    }
 
-        /* Lock the PLL! */
-        std::this_thread::sleep_for(std::chrono::milliseconds(2));
-        if ((_io_iface->peek8(0x287) & 0x02) == 0) {
-            throw uhd::runtime_error("[ad9361_device_t] TX PLL NOT LOCKED");
+    /* Tune!!!! */
+    for (int i = 0; i < 3; i++) {
+        const uint8_t nfrac_byte = (synth.nfrac >> (8 * i)) & 0xFF;
+        if (write_all || nfrac_byte != ((last.nfrac >> (8 * i)) & 0xFF)) {
+            _io_iface->poke8(0x233 + offset + i, nfrac_byte);
         }
+    }
+    if (write_all || ((synth.nint >> 8) & 0xFF) != ((last.nint >> 8) & 0xFF)) {
+        _io_iface->poke8(0x232 + offset, (synth.nint >> 8) & 0xFF);
+    }
+    _io_iface->poke8(0x231 + offset, synth.nint & 0xFF);
+    if (write_all || vcodivs != _regs.vcodivs) {
+        _regs.vcodivs = vcodivs;
+        _io_iface->poke8(0x005, _regs.vcodivs);
+    }
 
-        _tx_freq = actual_lo;
+    /* Lock the PLL! */
+    const uint16_t lock_reg = 0x247 + offset;
+    bool locked             = false;
+    if (poll_lock) {
+        const auto timeout =
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(2);
+        do {
+            locked = (_io_iface->peek8(lock_reg) & 0x02) != 0;
+        } while (!locked && std::chrono::steady_clock::now() < timeout);
+        if (!locked) {
+            locked = (_io_iface->peek8(lock_reg) & 0x02) != 0;
+        }
+    } else {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        locked = (_io_iface->peek8(lock_reg) & 0x02) != 0;
+    }
+    if (!locked) {
+        throw uhd::runtime_error((direction == RX)
+                                     ? "[ad9361_device_t] RX PLL NOT LOCKED"
+                                     : "[ad9361_device_t] TX PLL NOT LOCKED");
+    }
 
-        return actual_lo;
+    current = synth;
+    if (direction == RX) {
+        _rx_freq = synth.actual_lo;
+    } else {
+        _tx_freq = synth.actual_lo;
     }
 }
 
+/* This is the internal tune function, not available for a host call.
+ *
+ * Calculate the VCO settings for the requested frquency, and then either
+ * tune the RX or TX VCO. */
+double ad9361_device_t::_tune_helper(direction_t direction, const double value)
+{
+    const synth_config_t synth = _calc_synth(direction, value);
+    _program_synth(direction, synth, false);
+    return synth.actual_lo;
+}
+
 /* Configure the various clock / sample rates in the RX and TX chains.
  *
  * Functionally, this function configures AD9361's RX and TX rates. For
@@ -1560,6 +1609,11 @@ void ad9361_device_t::initialize()
 {
     std::lock_guard<std::recursive_mutex> lock(_mutex);
 
+    /* The chip gets reset, so no previous calibration is valid. */
+    _synth_charge_pumps_calibrated = false;
+    _rx_filter_cal                 = filter_cal_t();
+    _tx_filter_cal                 = filter_cal_t();
+
     /* Initialize shadow registers. */
     _regs.vcodivs        = 0x00;
     _regs.inputsel       = 0x30;
@@ -1750,6 +1804,9 @@ void ad9361_device_t::initialize()
 
     _calibrate_synth_charge_pumps();
 
+    /* Write all of the synthesizer registers on these tunes. */
+    _rx_synth = synth_config_t();
+    _tx_synth = synth_config_t();
     _tune_helper(RX, _rx_freq);
     _tune_helper(TX, _tx_freq);
 
@@ -1892,6 +1949,9 @@ double ad9361_device_t::set_clock_rate(const double req_rate)
 
     _calibrate_synth_charge_pumps();
 
+    /* Write all of the synthesizer registers on these tunes. */
+    _rx_synth = synth_config_t();
+    _tx_synth = synth_config_t();
     _tune_helper(RX, _rx_freq);
     _tune_helper(TX, _tx_freq);
 
@@ -1900,6 +1960,9 @@ double ad9361_device_t::set_clock_rate(const double req_rate)
     _setup_gain_control(false);
     _reprogram_gains();
 
+    /* The rates were reprogrammed, so always run the filter calibrations. */
+    _rx_filter_cal = filter_cal_t();
+    _tx_filter_cal = filter_cal_t();
     set_bw_filter(RX, _baseband_bw);
     set_bw_filter(TX, _baseband_bw);
 
@@ -2096,22 +2159,72 @@ void ad9361_device_t::set_timing_mode(const ad9361_device_t::timing_mode_t timin
 double ad9361_device_t::tune(direction_t direction, const double value)
 {
     std::lock_guard<std::recursive_mutex> lock(_mutex);
-    double last_cal_freq;
 
+    /* A request for the current LO frequency itself is redundant, too, so the
+     * frequency returned by hop() can be tuned to without a re-tune. */
     if (direction == RX) {
-        if (freq_is_nearly_equal(value, _req_rx_freq)) {
+        if (freq_is_nearly_equal(value, _req_rx_freq) || value == _rx_freq) {
             return _rx_freq;
         }
-        last_cal_freq = _last_rx_cal_freq;
     } else if (direction == TX) {
-        if (freq_is_nearly_equal(value, _req_tx_freq)) {
+        if (freq_is_nearly_equal(value, _req_tx_freq) || value == _tx_freq) {
             return _tx_freq;
         }
-        last_cal_freq = _last_tx_cal_freq;
     } else {
         throw uhd::runtime_error("[ad9361_device_t] [tune] INVALID_CODE_PATH");
     }
 
+    return _tune(direction, _calc_synth(direction, value), false);
+}
+
+std::vector<double> ad9361_device_t::set_hop_set(
+    direction_t direction, const std::vector<double>& freqs)
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+    std::vector<synth_config_t> hop_set;
+    std::vector<double> actual_freqs;
+    for (const double freq : freqs) {
+        hop_set.push_back(_calc_synth(direction, freq));
+        actual_freqs.push_back(hop_set.back().actual_lo);
+    }
+
+    if (direction == RX) {
+        _rx_hop_set = std::move(hop_set);
+    } else {
+        _tx_hop_set = std::move(hop_set);
+    }
+    return actual_freqs;
+}
+
+double ad9361_device_t::hop(direction_t direction, const size_t index)
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+    const std::vector<synth_config_t>& hop_set =
+        (direction == RX) ? _rx_hop_set : _tx_hop_set;
+    if (index >= hop_set.size()) {
+        throw uhd::index_error(
+            str(boost::format("[ad9361_device_t] [hop] Invalid hop set index %d")
+                % index));
+    }
+    const synth_config_t& synth = hop_set[index];
+
+    if (freq_is_nearly_equal(
+            synth.req_freq, (direction == RX) ? _req_rx_freq : _req_tx_freq)) {
+        return get_freq(direction);
+    }
+
+    return _tune(direction, synth, true);
+}
+
+/* Tune the RX or TX VCO, and run any appropriate calibrations. */
+double ad9361_device_t::_tune(
+    direction_t direction, const synth_config_t& synth, bool is_hop)
+{
+    const double last_cal_freq =
+        (direction == RX) ? _last_rx_cal_freq : _last_tx_cal_freq;
+
     /* If we aren't already in the ALERT state, we will need to return to
      * the FDD state after tuning. */
     int not_in_alert = 0;
@@ -2122,15 +2235,20 @@ double ad9361_device_t::tune(direction_t direction, const double value)
     }
 
     /* Tune the RF VCO! */
-    double tune_freq = _tune_helper(direction, value);
+    _program_synth(direction, synth, is_hop);
+    const double tune_freq = synth.actual_lo;
 
     /* Run any necessary calibrations / setups */
+    const uint8_t last_gain_table = _curr_gain_table;
     if (direction == RX) {
         _program_gain_table();
     }
 
-    /* Update the gain settings. */
-    _reprogram_gains();
+    /* Update the gain settings. The gain indices only change their meaning
+     * along with the gain table, so a hop can skip this otherwise. */
+    if (!is_hop || _curr_gain_table != last_gain_table) {
+        _reprogram_gains();
+    }
 
     /*
      * Only run the following calibrations if we are more than 100MHz away
@@ -2510,6 +2628,24 @@ double ad9361_device_t::set_bw_filter(direction_t direction, const double rf_bw)
     // differ. Together they should create the requested bb bw. Select rf_bw if it is
     // between AD9361_MIN_BW & AD9361_MAX_BW.
     const double clipped_bw = std::min(std::max(rf_bw, AD9361_MIN_BW), AD9361_MAX_BW);
+
+    /* The calibrated filters are still in place if nothing they depend on
+     * changed since they were last calibrated. */
+    filter_cal_t& last_cal  = (direction == RX) ? _rx_filter_cal : _tx_filter_cal;
+    const filter_cal_t cal  = _get_filter_cal_conditions(direction, clipped_bw);
+    const bool cal_is_valid = cal.valid && last_cal.valid && cal.rf_bw == last_cal.rf_bw
+                              && cal.bbpll_freq == last_cal.bbpll_freq
+                              && cal.baseband_bw == last_cal.baseband_bw
+                              && cal.chains == last_cal.chains
+                              && std::abs(cal.temperature - last_cal.temperature)
+                                     <= AD9361_CAL_VALID_TEMP_WINDOW;
+    if (cal_is_valid) {
+        UHD_LOG_TRACE("AD936X",
+            "[ad9361_device_t::set_bw_filter] Skipping recalibration, rf_bw=" << rf_bw);
+        return clipped_bw;
+    }
+    last_cal.valid = false;
+
     if (direction == RX) {
         _rx_bb_lp_bw  = _calibrate_baseband_rx_analog_filter(clipped_bw); // returns bb bw
         _rx_tia_lp_bw = _calibrate_rx_TIAs(clipped_bw);
@@ -2519,10 +2655,32 @@ double ad9361_device_t::set_bw_filter(direction_t direction, const double rf_bw)
         _tx_sec_lp_bw = _calibrate_secondary_tx_filter(clipped_bw);
         _tx_analog_bw = clipped_bw;
     }
+    last_cal = cal;
 
     return (clipped_bw);
 }
 
+/* Collect the conditions that the analog filter calibrations depend on.
+ *
+ * The result is not valid if the temperature can't be read, which means the
+ * filters are always recalibrated then. */
+ad9361_device_t::filter_cal_t ad9361_device_t::_get_filter_cal_conditions(
+    direction_t direction, const double rf_bw)
+{
+    filter_cal_t cal;
+    cal.rf_bw       = rf_bw;
+    cal.bbpll_freq  = _bbpll_freq;
+    cal.baseband_bw = _baseband_bw;
+    cal.chains      = ((direction == RX) ? _regs.rxfilt : _regs.txfilt) & 0xC0;
+    try {
+        cal.temperature = _get_temperature(0.0);
+        cal.valid       = true;
+    } catch (const uhd::runtime_error&) {
+        cal.valid = false;
+    }
+    return cal;
+}
+
 void ad9361_device_t::_set_fir_taps(
     direction_t direction, chain_t chain, const std::vector<int16_t>& taps)
 {
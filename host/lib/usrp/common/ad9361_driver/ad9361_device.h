@@ -196,6 +196,22 @@ public:
      * After tuning, it runs any appropriate calibrations. */
     double tune(direction_t direction, const double value);
 
+    /* Precompute the synthesizer settings for a set of RX or TX frequencies.
+     *
+     * The set replaces any previous hop set of the same direction. Hopping to
+     * one of its entries with hop() skips the synthesizer calculations, and
+     * only writes the synthesizer registers that differ from the current
+     * settings. Returns the actual LO frequencies of the entries. */
+    std::vector<double> set_hop_set(
+        direction_t direction, const std::vector<double>& freqs);
+
+    /* Tune the RX or TX frequency to an entry of the hop set.
+     *
+     * Unlike tune(), this polls for the PLL to lock instead of waiting for a
+     * fixed time, and only updates the gains when the RX gain table changes.
+     * The calibrations run when the same tune() would run them. */
+    double hop(direction_t direction, const size_t index);
+
     /* Get the current RX or TX frequency. */
     double get_freq(direction_t direction);
 
@@ -254,6 +270,7 @@ public:
     static const double AD9361_MAX_CLOCK_RATE;
     static const double AD9361_MIN_CLOCK_RATE;
     static const double AD9361_CAL_VALID_WINDOW;
+    static const double AD9361_CAL_VALID_TEMP_WINDOW;
     static const double AD9361_MIN_BW;
     static const double AD9361_MAX_BW;
     static const double DEFAULT_RX_FREQ;
@@ -281,11 +298,17 @@ private:    //Methods
     void _program_mixer_gm_subtable();
     void _program_gain_table();
     void _setup_gain_control(bool use_agc);
-    void _setup_synth(direction_t direction, double vcorate);
+    void _setup_synth(direction_t direction, int vcoindex);
     double _tune_bbvco(const double rate);
     void _reprogram_gains();
     double _tune_helper(direction_t direction, const double value);
+    struct synth_config_t;
+    synth_config_t _calc_synth(direction_t direction, const double value);
+    void _program_synth(direction_t direction, const synth_config_t& synth, bool poll_lock);
+    double _tune(direction_t direction, const synth_config_t& synth, bool is_hop);
     double _setup_rates(const double rate);
+    struct filter_cal_t;
+    filter_cal_t _get_filter_cal_conditions(direction_t direction, const double rf_bw);
     double _get_temperature(const double cal_offset, const double timeout = 0.1);
     void _configure_bb_dc_tracking();
     void _configure_rx_iq_tracking();
@@ -320,6 +343,36 @@ private:    //Members
         uint8_t bbftune_mode;
     };
 
+    //! The settings of the RX or TX synthesizer for one frequency
+    struct synth_config_t
+    {
+        synth_config_t():
+            req_freq(0.0), actual_lo(0.0), inputsel(0), vcodiv(0),
+            vcoindex(-1), nint(0), nfrac(0) {}
+        double req_freq;
+        double actual_lo;
+        //! The band-specific bits of the input select register
+        uint8_t inputsel;
+        uint8_t vcodiv;
+        //! The index into the synthesizer LUT, or -1 if unknown
+        int vcoindex;
+        int nint;
+        int nfrac;
+    };
+
+    //! The conditions under which the analog filters of one direction were
+    //  calibrated. A calibration stays valid while these don't change.
+    struct filter_cal_t
+    {
+        double rf_bw       = 0.0;
+        double bbpll_freq  = 0.0;
+        double baseband_bw = 0.0;
+        //! The chain enable bits of the filter config register
+        uint8_t chains     = 0;
+        double temperature = 0.0;
+        bool valid         = false;
+    };
+
     //Interfaces
     ad9361_params::sptr _client_params;
     ad9361_io::sptr     _io_iface;
@@ -346,10 +399,16 @@ private:    //Members
     bool                _rx1_agc_enable, _rx2_agc_enable;
     //Register soft-copies
     chip_regs_t         _regs;
+    synth_config_t      _rx_synth, _tx_synth;
+    //Precomputed synthesizer settings for hop()
+    std::vector<synth_config_t> _rx_hop_set, _tx_hop_set;
     //Synchronization
     std::recursive_mutex  _mutex;
     bool _use_dc_offset_tracking;
     bool _use_iq_balance_tracking;
+    //Calibration state
+    bool _synth_charge_pumps_calibrated = false;
+    filter_cal_t _rx_filter_cal, _tx_filter_cal;
 
     // Filter API
     using filter_tuple = std::tuple<
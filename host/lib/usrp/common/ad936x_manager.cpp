@@ -256,6 +256,17 @@ public:
             .set_coercer([this, key](const double freq) {
                 return this->_codec_ctrl->tune(key, freq);
             });
+        subtree->create<std::vector<double>>("hop_set/freqs")
+            .set_coercer([this, key](const std::vector<double>& freqs) {
+                return this->_codec_ctrl->set_hop_set(key, freqs);
+            });
+        // A hop goes through freq/value with the exact LO frequency, which
+        // doesn't tune again, but updates everything that depends on it
+        property<double>* freq_prop = &subtree->access<double>("freq/value");
+        subtree->create<size_t>("hop_set/index")
+            .add_coerced_subscriber([this, key, freq_prop](const size_t index) {
+                freq_prop->set(this->_codec_ctrl->hop(key, index));
+            });
 
         // Frontend corrections
         if (dir == RX_DIRECTION) {
@@ -77,19 +77,20 @@ bool load_legacy_fe_corrections(const std::string& cal_key,
     return true;
 }
 
-void apply_fe_corrections(uhd::property_tree::sptr sub_tree,
-    const std::string& db_serial,
-    const uhd::fs_path& fe_path,
-    const std::string& file_prefix,
-    const double lo_freq)
+/*! Returns the cal data for \p file_prefix and \p db_serial
+ *
+ * Loads the data on first use. Returns nullptr if there is none.
+ */
+iq_cal::sptr get_fe_cal(const std::string& file_prefix, const std::string& db_serial)
 {
     const auto cal_key = file_prefix + ":" + db_serial;
     // Check if we need to load cal data
     if (!fe_cal_cache.count(cal_key)) {
         if (database::has_cal_data(file_prefix, db_serial)) {
             try {
-                const auto cal_data = database::read_cal_data(file_prefix, db_serial);
-                fe_cal_cache.insert({cal_key, container::make<iq_cal>(cal_data)});
+                const auto cal_view = database::map_cal_data(file_prefix, db_serial);
+                fe_cal_cache.insert({cal_key,
+                    container::make<iq_cal>(cal_view->data(), cal_view->size())});
                 UHD_LOG_DEBUG("CAL",
                     "Loaded calibration data for " << file_prefix
                                                    << " serial=" << db_serial);
@@ -115,15 +116,24 @@ void apply_fe_corrections(uhd::property_tree::sptr sub_tree,
                                                  << " serial=" << db_serial);
         }
     }
+    return fe_cal_cache.at(cal_key);
+}
+
+void apply_fe_corrections(uhd::property_tree::sptr sub_tree,
+    const std::string& db_serial,
+    const uhd::fs_path& fe_path,
+    const std::string& file_prefix,
+    const double lo_freq)
+{
+    const auto fe_cal = get_fe_cal(file_prefix, db_serial);
 
     // Check if valid data even exists
-    if (fe_cal_cache.at(cal_key) == nullptr) {
+    if (fe_cal == nullptr) {
         return;
     }
 
     // OK we have cal data: Now apply it
-    sub_tree->access<std::complex<double>>(fe_path).set(
-        fe_cal_cache.at(cal_key)->get_cal_coeff(lo_freq));
+    sub_tree->access<std::complex<double>>(fe_path).set(fe_cal->get_cal_coeff(lo_freq));
 }
 
 } // namespace
@@ -166,6 +176,27 @@ void uhd::usrp::apply_rx_fe_corrections(property_tree::sptr sub_tree,
     }
 }
 
+uhd::convert::iq_correction_t uhd::usrp::get_rx_fe_iq_correction(
+    const std::string& db_serial,
+    const double lo_freq,
+    const std::complex<double>& dc_offset)
+{
+    std::lock_guard<std::mutex> l(corrections_mutex);
+    try {
+        const auto fe_cal = get_fe_cal("rx_iq", db_serial);
+        if (fe_cal) {
+            return uhd::convert::iq_correction_t::from_iq_balance(
+                fe_cal->get_cal_coeff(lo_freq), dc_offset);
+        }
+    } catch (const std::exception& e) {
+        UHD_LOGGER_ERROR("CAL") << "Failure in get_rx_fe_iq_correction: " << e.what();
+    }
+
+    uhd::convert::iq_correction_t correction;
+    correction.dc_offset = dc_offset;
+    return correction;
+}
+
 /******************************************************************************
  * Gen-2 versions
  *****************************************************************************/
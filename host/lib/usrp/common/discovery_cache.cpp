@@ -0,0 +1,69 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/utils/log.hpp>
+#include <uhdlib/usrp/common/discovery_cache.hpp>
+#include <iterator>
+
+using namespace uhd;
+using namespace uhd::usrp;
+
+constexpr char discovery_cache::TTL_KEY[];
+constexpr double discovery_cache::DEFAULT_TTL;
+
+discovery_cache& discovery_cache::get()
+{
+    static discovery_cache cache;
+    return cache;
+}
+
+device_addrs_t discovery_cache::find(
+    const std::string& finder, const device_addr_t& hint, const find_fn_t& find_fn)
+{
+    const double ttl = hint.cast<double>(TTL_KEY, DEFAULT_TTL);
+    if (ttl <= 0.0) {
+        return find_fn(hint);
+    }
+    const auto max_age = std::chrono::duration_cast<clock_t::duration>(
+        std::chrono::duration<double>(ttl));
+    const auto key = std::make_pair(finder, hint.to_string());
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto entry = _entries.find(key);
+        if (entry != _entries.end()) {
+            if (clock_t::now() <= entry->second.expiry) {
+                UHD_LOG_TRACE("FIND",
+                    "Using cached " << finder
+                                    << " discovery results for hint: " << key.second);
+                return entry->second.addrs;
+            }
+            _entries.erase(entry);
+        }
+    }
+
+    // Expire the results relative to the start of the discovery, any change to
+    // the devices after that may be missing from them
+    const auto expiry          = clock_t::now() + max_age;
+    const device_addrs_t addrs = find_fn(hint);
+    if (addrs.empty()) {
+        return addrs;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto now = clock_t::now();
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        it = (it->second.expiry < now) ? _entries.erase(it) : std::next(it);
+    }
+    _entries[key] = entry_t{expiry, addrs};
+    return addrs;
+}
+
+void discovery_cache::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+}
@@ -0,0 +1,166 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhdlib/usrp/common/eeprom_cache.hpp>
+#include <uhdlib/utils/paths.hpp>
+#include <boost/filesystem.hpp>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+using namespace uhd;
+using namespace uhd::usrp;
+namespace fs = boost::filesystem;
+
+namespace {
+
+constexpr char LOG_ID[]      = "EEPROM";
+constexpr char DISABLE_ENV[] = "UHD_EEPROM_CACHE_DISABLE";
+//! First word of every entry. Bump the version if the format changes.
+constexpr char ENTRY_MAGIC[] = "uhd-eeprom-cache-v1";
+//! Limit for the contents of an entry, so a corrupt file can't eat all memory
+constexpr size_t MAX_CONTENTS_LEN = 64 * 1024;
+
+bool is_enabled()
+{
+    return std::getenv(DISABLE_ENV) == nullptr;
+}
+
+fs::path get_cache_dir()
+{
+    return uhd::get_xdg_cache_home() / "uhd" / "eeprom";
+}
+
+//! Turn a key into a file name, any characters that don't belong in one become '_'
+std::string get_file_name(const std::string& key)
+{
+    std::string name = key;
+    for (char& c : name) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '.') {
+            c = '_';
+        }
+    }
+    return name;
+}
+
+std::string to_hex(const byte_vector_t& bytes)
+{
+    static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+    std::string hex;
+    hex.reserve(bytes.size() * 2 + 1);
+    for (const uint8_t byte : bytes) {
+        hex.push_back(HEX_DIGITS[byte >> 4]);
+        hex.push_back(HEX_DIGITS[byte & 0xF]);
+    }
+    // An empty vector still needs a token, so the line can be split into words
+    return hex.empty() ? "-" : hex;
+}
+
+boost::optional<byte_vector_t> from_hex(const std::string& hex)
+{
+    if (hex == "-") {
+        return byte_vector_t();
+    }
+    if (hex.size() % 2 || hex.size() > 2 * MAX_CONTENTS_LEN) {
+        return boost::none;
+    }
+    byte_vector_t bytes;
+    bytes.reserve(hex.size() / 2);
+    for (size_t i = 0; i < hex.size(); i += 2) {
+        if (!std::isxdigit(static_cast<unsigned char>(hex[i]))
+            || !std::isxdigit(static_cast<unsigned char>(hex[i + 1]))) {
+            return boost::none;
+        }
+        bytes.push_back(uint8_t(std::stoul(hex.substr(i, 2), nullptr, 16)));
+    }
+    return bytes;
+}
+
+} // namespace
+
+boost::optional<byte_vector_t> eeprom_cache::get(
+    const std::string& key, const byte_vector_t& stamp)
+{
+    if (!is_enabled()) {
+        return boost::none;
+    }
+    try {
+        const std::string name = get_file_name(key);
+        std::ifstream file((get_cache_dir() / name).string());
+        std::string magic, cached_name, cached_stamp, contents;
+        if (!(file >> magic >> cached_name >> cached_stamp >> contents)
+            || magic != ENTRY_MAGIC || cached_name != name
+            || cached_stamp != to_hex(stamp)) {
+            return boost::none;
+        }
+        auto bytes = from_hex(contents);
+        if (bytes) {
+            UHD_LOG_TRACE(LOG_ID, "Using cached EEPROM contents for " << key);
+        }
+        return bytes;
+    } catch (const std::exception& ex) {
+        UHD_LOG_DEBUG(
+            LOG_ID, "Can't read EEPROM cache entry " << key << ": " << ex.what());
+    }
+    return boost::none;
+}
+
+void eeprom_cache::put(
+    const std::string& key, const byte_vector_t& stamp, const byte_vector_t& contents)
+{
+    if (!is_enabled() || contents.size() > MAX_CONTENTS_LEN) {
+        return;
+    }
+    try {
+        const fs::path dir = get_cache_dir();
+        fs::create_directories(dir);
+        const std::string name = get_file_name(key);
+        const fs::path path    = dir / name;
+        // Write to a file of our own first, and then move it into place, so that
+        // other processes never see a partial entry
+        const fs::path tmp_path =
+            path.string() + "." + std::to_string(std::random_device()()) + ".tmp";
+        {
+            std::ofstream file(tmp_path.string(), std::ios::trunc);
+            file << ENTRY_MAGIC << " " << name << " " << to_hex(stamp) << " "
+                 << to_hex(contents) << "\n";
+            file.close();
+            if (!file) {
+                boost::system::error_code ec;
+                fs::remove(tmp_path, ec);
+                throw uhd::io_error("Failed to write " + tmp_path.string());
+            }
+        }
+        fs::rename(tmp_path, path);
+    } catch (const std::exception& ex) {
+        UHD_LOG_DEBUG(
+            LOG_ID, "Can't write EEPROM cache entry " << key << ": " << ex.what());
+    }
+}
+
+void eeprom_cache::invalidate(const std::string& key_prefix)
+{
+    try {
+        const fs::path dir = get_cache_dir();
+        if (!fs::is_directory(dir)) {
+            return;
+        }
+        const std::string prefix = get_file_name(key_prefix);
+        for (fs::directory_iterator it(dir); it != fs::directory_iterator(); ++it) {
+            if (it->path().filename().string().compare(0, prefix.size(), prefix) == 0) {
+                fs::remove(it->path());
+            }
+        }
+    } catch (const std::exception& ex) {
+        UHD_LOG_WARNING(LOG_ID,
+            "Can't invalidate EEPROM cache entries " << key_prefix << ": " << ex.what());
+    }
+}
@@ -18,10 +18,16 @@ static const char* send_offload_str             = "send_offload";
 static const char* recv_offload_wait_mode_str   = "recv_offload_wait_mode";
 static const char* send_offload_wait_mode_str   = "send_offload_wait_mode";
 static const char* num_poll_offload_threads_str = "num_poll_offload_threads";
+static const char* hybrid_spin_us_str           = "hybrid_spin_us";
+static const char* poll_shared_recv_frames_str  = "poll_shared_recv_frames";
+static const char* offload_thread_placement_str = "offload_thread_placement";
+static const char* poll_offload_pool_str        = "poll_offload_pool";
 
-static const std::regex recv_offload_thread_cpu_expr("^recv_offload_thread_(\\d+)_cpu");
-static const std::regex send_offload_thread_cpu_expr("^send_offload_thread_(\\d+)_cpu");
-static const std::regex poll_offload_thread_cpu_expr("^poll_offload_thread_(\\d+)_cpu");
+//! Matches {recv,send,poll}_offload_thread_<N>_cpu
+static const std::regex offload_thread_cpu_expr(
+    "^(recv|send|poll)_offload_thread_(\\d+)_cpu", std::regex::optimize);
+//! Every key that offload_thread_cpu_expr matches contains this
+static const char* offload_thread_cpu_substr = "_offload_thread_";
 
 namespace uhd { namespace usrp {
 
@@ -42,7 +48,9 @@ io_service_args_t::wait_mode_t get_wait_mode_arg(const device_addr_t& args,
 {
     constrained_device_args_t::enum_arg<io_service_args_t::wait_mode_t> arg(key,
         def,
-        {{"poll", io_service_args_t::POLL}, {"block", io_service_args_t::BLOCK}});
+        {{"poll", io_service_args_t::POLL},
+            {"block", io_service_args_t::BLOCK},
+            {"hybrid", io_service_args_t::HYBRID}});
 
     if (args.has_key(key)) {
         arg.parse(args[key]);
@@ -50,6 +58,46 @@ io_service_args_t::wait_mode_t get_wait_mode_arg(const device_addr_t& args,
     return arg.get();
 }
 
+io_service_args_t::placement_t get_placement_arg(const device_addr_t& args,
+    const std::string& key,
+    const io_service_args_t::placement_t def)
+{
+    constrained_device_args_t::enum_arg<io_service_args_t::placement_t> arg(key,
+        def,
+        {{"manual", io_service_args_t::PLACEMENT_MANUAL},
+            {"auto", io_service_args_t::PLACEMENT_AUTO}});
+
+    if (args.has_key(key)) {
+        arg.parse(args[key]);
+    }
+    return arg.get();
+}
+
+io_service_args_t::pool_t get_pool_arg(const device_addr_t& args,
+    const std::string& key,
+    const io_service_args_t::pool_t def)
+{
+    constrained_device_args_t::enum_arg<io_service_args_t::pool_t> arg(key,
+        def,
+        {{"graph", io_service_args_t::POOL_GRAPH},
+            {"process", io_service_args_t::POOL_PROCESS}});
+
+    if (args.has_key(key)) {
+        arg.parse(args[key]);
+    }
+    return arg.get();
+}
+
+/*! Returns true if \p key is a thread CPU affinity key, and if so, which
+ *  offload type ("recv", "send", or "poll") and thread it's for
+ */
+bool match_thread_cpu_key(const std::string& key, std::smatch& match)
+{
+    // Most keys are something else entirely, skip the regex for those
+    return key.find(offload_thread_cpu_substr) != std::string::npos
+           && std::regex_match(key, match, offload_thread_cpu_expr);
+}
+
 }; // namespace
 
 io_service_args_t read_io_service_args(
@@ -68,6 +116,9 @@ io_service_args_t read_io_service_args(
     io_srv_args.send_offload_wait_mode = get_wait_mode_arg(
         args, send_offload_wait_mode_str, defaults.send_offload_wait_mode);
 
+    io_srv_args.hybrid_spin_us =
+        args.cast<size_t>(hybrid_spin_us_str, defaults.hybrid_spin_us);
+
     io_srv_args.num_poll_offload_threads = args.cast<size_t>(
         num_poll_offload_threads_str, defaults.num_poll_offload_threads);
     if (io_srv_args.num_poll_offload_threads == 0) {
@@ -77,23 +128,33 @@ io_service_args_t read_io_service_args(
         io_srv_args.num_poll_offload_threads = 1;
     }
 
-    auto read_thread_args = [&args](
-                                const std::regex& expr, std::map<size_t, size_t>& dest) {
-        auto keys = args.keys();
-        for (const auto& key : keys) {
-            std::smatch match;
-            if (std::regex_match(key, match, expr)) {
-                UHD_ASSERT_THROW(match.size() == 2); // first match is the entire key
-                const size_t thread = std::stoul(match.str(1));
-                const size_t cpu    = args.cast<size_t>(key, 0);
-                dest[thread]        = cpu;
-            }
+    io_srv_args.poll_shared_recv_frames = args.cast<size_t>(
+        poll_shared_recv_frames_str, defaults.poll_shared_recv_frames);
+
+    io_srv_args.poll_offload_pool =
+        get_pool_arg(args, poll_offload_pool_str, defaults.poll_offload_pool);
+
+    // Read the thread CPU affinities of all offload types in one pass
+    for (const auto& key : args.keys()) {
+        std::smatch match;
+        if (!match_thread_cpu_key(key, match)) {
+            continue;
         }
-    };
+        UHD_ASSERT_THROW(match.size() == 3); // first match is the entire key
+        const std::string type = match.str(1);
+        const size_t thread    = std::stoul(match.str(2));
+        const size_t cpu       = args.cast<size_t>(key, 0);
+        if (type == "recv") {
+            io_srv_args.recv_offload_thread_cpu[thread] = cpu;
+        } else if (type == "send") {
+            io_srv_args.send_offload_thread_cpu[thread] = cpu;
+        } else {
+            io_srv_args.poll_offload_thread_cpu[thread] = cpu;
+        }
+    }
 
-    read_thread_args(recv_offload_thread_cpu_expr, io_srv_args.recv_offload_thread_cpu);
-    read_thread_args(send_offload_thread_cpu_expr, io_srv_args.send_offload_thread_cpu);
-    read_thread_args(poll_offload_thread_cpu_expr, io_srv_args.poll_offload_thread_cpu);
+    io_srv_args.offload_thread_placement = get_placement_arg(
+        args, offload_thread_placement_str, defaults.offload_thread_placement);
 
     return io_srv_args;
 }
@@ -118,22 +179,17 @@ device_addr_t merge_io_service_dev_args(
     merge_args(dev_args, args, recv_offload_wait_mode_str);
     merge_args(dev_args, args, send_offload_wait_mode_str);
     merge_args(dev_args, args, num_poll_offload_threads_str);
-
-    auto merge_thread_args = [&merge_args](const device_addr_t& dev_args,
-                                 device_addr_t& stream_args,
-                                 const std::regex& expr) {
-        auto keys = dev_args.keys();
-        for (const auto& key : keys) {
-            std::smatch match;
-            if (std::regex_match(key, match, expr)) {
-                merge_args(dev_args, stream_args, key);
-            }
+    merge_args(dev_args, args, hybrid_spin_us_str);
+    merge_args(dev_args, args, poll_shared_recv_frames_str);
+    merge_args(dev_args, args, offload_thread_placement_str);
+    merge_args(dev_args, args, poll_offload_pool_str);
+
+    for (const auto& key : dev_args.keys()) {
+        std::smatch match;
+        if (match_thread_cpu_key(key, match)) {
+            merge_args(dev_args, args, key);
         }
-    };
-
-    merge_thread_args(dev_args, args, recv_offload_thread_cpu_expr);
-    merge_thread_args(dev_args, args, send_offload_thread_cpu_expr);
-    merge_thread_args(dev_args, args, poll_offload_thread_cpu_expr);
+    }
 
     return args;
 }
@@ -14,8 +14,13 @@
 #    include <uhdlib/usrp/common/dpdk_io_service_mgr.hpp>
 #endif
 #include <uhdlib/usrp/common/io_service_mgr.hpp>
+#include <uhdlib/usrp/common/offload_thread_placement.hpp>
 #include <uhdlib/usrp/constrained_device_args.hpp>
+#include <boost/optional.hpp>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <vector>
 
 using namespace uhd;
@@ -25,6 +30,69 @@ static const std::string LOG_ID = "IO_SRV";
 
 namespace uhd { namespace usrp {
 
+namespace {
+
+// Offload threads are placed across all devices, so the placement is shared
+std::mutex placement_mutex;
+
+offload_thread_placement& get_placement()
+{
+    static offload_thread_placement placement(cpu_topology_t::read_system());
+    return placement;
+}
+
+std::string cpu_list_to_string(const std::vector<size_t>& cpus)
+{
+    if (cpus.empty()) {
+        return "any";
+    }
+    std::ostringstream ss;
+    for (size_t i = 0; i < cpus.size(); i++) {
+        ss << (i ? "," : "") << cpus[i];
+    }
+    return ss.str();
+}
+
+/* Picks a CPU for a new offload thread that serves a link on the given network
+ * interface, and logs the reasons for the choice.
+ */
+boost::optional<size_t> place_offload_thread(const std::string& ifname)
+{
+    const int numa_node              = get_numa_node_of_ifname(ifname);
+    const std::vector<size_t> irqs   = get_irq_cpus_of_ifname(ifname);
+    const std::vector<size_t> stream = get_current_thread_cpus();
+
+    boost::optional<size_t> cpu;
+    {
+        std::lock_guard<std::mutex> lock(placement_mutex);
+        cpu = get_placement().pick_cpu(numa_node, irqs, stream);
+    }
+
+    if (cpu) {
+        UHD_LOG_INFO(LOG_ID,
+            "Placing offload thread on CPU "
+                << *cpu << " (interface: " << (ifname.empty() ? "none" : ifname)
+                << ", NUMA node: "
+                << (numa_node < 0 ? std::string("unknown") : std::to_string(numa_node))
+                << ", IRQ CPUs: " << cpu_list_to_string(irqs)
+                << ", streamer CPUs: " << cpu_list_to_string(stream) << ")");
+    } else {
+        UHD_LOG_WARNING(
+            LOG_ID, "CPU topology unknown, not placing offload thread automatically");
+    }
+    return cpu;
+}
+
+void release_offload_thread_cpu(const boost::optional<size_t>& cpu)
+{
+    if (cpu) {
+        std::lock_guard<std::mutex> lock(placement_mutex);
+        get_placement().release_cpu(*cpu);
+    }
+}
+
+} // namespace
+
 /* This file defines an I/O service manager implementation, io_service_mgr_impl.
  * Its implementation is divided into three other classes, inline_io_service_mgr,
  * blocking_io_service_mgr, and polling_io_service_mgr. The io_service_mgr_impl
@@ -40,8 +108,9 @@ namespace uhd { namespace usrp {
 class inline_io_service_mgr
 {
 public:
-    io_service::sptr connect_links(
-        recv_link_if::sptr recv_link, send_link_if::sptr send_link);
+    io_service::sptr connect_links(recv_link_if::sptr recv_link,
+        send_link_if::sptr send_link,
+        const size_t max_spin_us);
 
     void disconnect_links(recv_link_if::sptr recv_link, send_link_if::sptr send_link);
 
@@ -56,8 +125,9 @@ private:
     std::map<link_pair_t, link_info_t> _link_info_map;
 };
 
-io_service::sptr inline_io_service_mgr::connect_links(
-    recv_link_if::sptr recv_link, send_link_if::sptr send_link)
+io_service::sptr inline_io_service_mgr::connect_links(recv_link_if::sptr recv_link,
+    send_link_if::sptr send_link,
+    const size_t max_spin_us)
 {
     // Check if links are already connected
     const link_pair_t links{recv_link, send_link};
@@ -70,7 +140,7 @@ io_service::sptr inline_io_service_mgr::connect_links(
     }
 
     // Links are not muxed, create a new inline I/O service
-    auto io_srv = inline_io_service::make();
+    auto io_srv = inline_io_service::make(max_spin_us);
 
     if (recv_link) {
         io_srv->attach_recv_link(recv_link);
@@ -105,10 +175,11 @@ void inline_io_service_mgr::disconnect_links(
 
 /* Blocking I/O service manager
  *
- * I/O service manager for offload I/O services configured to block. This
- * manager creates one offload I/O service for each transport adapter used by
- * a streamer. If there are multiple streamers, this manager creates a separate
- * set of I/O services for each streamer.
+ * I/O service manager for offload I/O services configured to block, or to spin
+ * before they block (hybrid wait mode). This manager creates one offload I/O
+ * service for each transport adapter used by a streamer. If there are multiple
+ * streamers, this manager creates a separate set of I/O services for each
+ * streamer.
  */
 class blocking_io_service_mgr
 {
@@ -132,12 +203,15 @@ private:
         adapter_id_t adapter_id;
         io_service::sptr io_srv;
         size_t connection_count;
+        boost::optional<size_t> placed_cpu;
     };
     using streamer_map_key_t = std::pair<std::string, adapter_id_t>;
 
     io_service::sptr _create_new_io_service(const io_service_args_t& args,
         const link_type_t link_type,
-        const size_t thread_index);
+        const size_t thread_index,
+        const std::string& ifname,
+        boost::optional<size_t>& placed_cpu);
 
     // Map of links to streamer, so we can look up an I/O service from links
     using link_pair_t = std::pair<recv_link_if::sptr, send_link_if::sptr>;
@@ -183,8 +257,13 @@ io_service::sptr blocking_io_service_mgr::connect_links(recv_link_if::sptr recv_
 
     if (it == info_vtr.end()) {
         const size_t new_thread_index = info_vtr.size();
-        io_srv = _create_new_io_service(args, link_type, new_thread_index);
-        info_vtr.push_back({adapter_id, io_srv, 1 /*connection_count*/});
+        const std::string ifname      = (link_type == link_type_t::RX_DATA)
+                                       ? recv_link->get_recv_ifname()
+                                       : send_link->get_send_ifname();
+        boost::optional<size_t> placed_cpu;
+        io_srv = _create_new_io_service(
+            args, link_type, new_thread_index, ifname, placed_cpu);
+        info_vtr.push_back({adapter_id, io_srv, 1 /*connection_count*/, placed_cpu});
     } else {
         it->connection_count++;
         io_srv = it->io_srv;
@@ -226,6 +305,8 @@ void blocking_io_service_mgr::disconnect_links(
     it->connection_count--;
     if (it->connection_count == 0) {
         it->io_srv.reset();
+        release_offload_thread_cpu(it->placed_cpu);
+        it->placed_cpu = boost::none;
     }
 
     // If all I/O services in the streamers are disconnected, clean up all its info
@@ -243,10 +324,21 @@ void blocking_io_service_mgr::disconnect_links(
 }
 
 io_service::sptr blocking_io_service_mgr::_create_new_io_service(
-    const io_service_args_t& args, const link_type_t link_type, const size_t thread_index)
+    const io_service_args_t& args,
+    const link_type_t link_type,
+    const size_t thread_index,
+    const std::string& ifname,
+    boost::optional<size_t>& placed_cpu)
 {
+    const auto wait_mode = (link_type == link_type_t::RX_DATA)
+                               ? args.recv_offload_wait_mode
+                               : args.send_offload_wait_mode;
+
     offload_io_service::params_t params;
-    params.wait_mode   = offload_io_service::BLOCK;
+    params.wait_mode   = (wait_mode == io_service_args_t::HYBRID)
+                             ? offload_io_service::HYBRID
+                             : offload_io_service::BLOCK;
+    params.max_spin_us = args.hybrid_spin_us;
     params.client_type = (link_type == link_type_t::RX_DATA)
                              ? offload_io_service::RECV_ONLY
                              : offload_io_service::SEND_ONLY;
@@ -260,6 +352,10 @@ io_service::sptr blocking_io_service_mgr::_create_new_io_service(
         const size_t cpu         = cpu_map.at(thread_index);
         params.cpu_affinity_list = {cpu};
         cpu_affinity_str         = ", cpu affinity: " + std::to_string(cpu);
+    } else if (args.offload_thread_placement == io_service_args_t::PLACEMENT_AUTO
+               && (placed_cpu = place_offload_thread(ifname))) {
+        params.cpu_affinity_list = {*placed_cpu};
+        cpu_affinity_str         = ", cpu affinity: " + std::to_string(*placed_cpu);
     } else {
         cpu_affinity_str = ", cpu affinity: none";
     }
@@ -267,18 +363,28 @@ io_service::sptr blocking_io_service_mgr::_create_new_io_service(
     std::string link_type_str = (link_type == link_type_t::RX_DATA) ? "RX data"
                                                                     : "TX data";
 
+    const std::string wait_mode_str =
+        (params.wait_mode == offload_io_service::HYBRID) ? "hybrid" : "blocking";
+
     UHD_LOG_INFO(LOG_ID,
-        "Creating new blocking I/O service for " << link_type_str << cpu_affinity_str);
+        "Creating new " << wait_mode_str << " I/O service for " << link_type_str
+                        << cpu_affinity_str);
 
     return offload_io_service::make(inline_io_service::make(), params);
 }
 
 /* Polling I/O service manager
  *
- * I/O service manager for offload I/O services configured to poll. Creates the
- * number of I/O services specified by the user in stream_args, and distributes
- * links among them. New connections always go to the offload thread containing
- * the fewest connections, with lowest numbered thread as a second criterion.
+ * I/O service manager for offload I/O services configured to poll. By default,
+ * all links go to a single offload I/O service with the number of poll threads
+ * specified by the user in stream_args. The service moves links among its
+ * threads at run time to balance their load.
+ *
+ * Poll threads cannot share a pool of receive frames, so when
+ * poll_shared_recv_frames is set, the manager instead creates one I/O service
+ * per thread, and distributes links among them statically. New connections go
+ * to the offload thread containing the fewest connections, with lowest
+ * numbered thread as a second criterion.
  */
 class polling_io_service_mgr
 {
@@ -298,10 +404,14 @@ private:
     struct io_srv_info_t
     {
         size_t connection_count;
+        std::vector<size_t> placed_cpus;
     };
 
-    io_service::sptr _create_new_io_service(
-        const io_service_args_t& args, const size_t thread_index);
+    io_service::sptr _create_new_io_service(const io_service_args_t& args,
+        const size_t thread_index,
+        const size_t num_threads,
+        const std::string& ifname,
+        std::vector<size_t>& placed_cpus);
 
     // Map of links to I/O service
     using link_pair_t = std::pair<recv_link_if::sptr, send_link_if::sptr>;
@@ -325,15 +435,23 @@ io_service::sptr polling_io_service_mgr::connect_links(recv_link_if::sptr recv_l
         return it->second.io_srv;
     }
 
-    // Links are not muxed. If there are fewer offload threads than requested in
-    // the args, create a new service and add the links to it. Otherwise, add it
-    // to the service that has the fewest connections.
+    // Links are not muxed. If there are fewer I/O services than needed for the
+    // offload threads requested in the args, create a new service and add the
+    // links to it. Otherwise, add them to the service that has the fewest
+    // connections. A service with all threads is needed unless the threads
+    // share receive frames.
+    const bool shared_frames  = args.poll_shared_recv_frames != 0;
+    const size_t num_services = shared_frames ? args.num_poll_offload_threads : 1;
     io_service::sptr io_srv;
-    if (_io_srv_info_map.size() < args.num_poll_offload_threads) {
+    if (_io_srv_info_map.size() < num_services) {
         const size_t thread_index = _io_srv_info_map.size();
-        io_srv                    = _create_new_io_service(args, thread_index);
-        _link_info_map[links]     = {io_srv, 1 /*mux_ref_count*/};
-        _io_srv_info_map[io_srv]  = {1 /*connection_count*/};
+        const size_t num_threads  = shared_frames ? 1 : args.num_poll_offload_threads;
+        const std::string ifname  = recv_link ? recv_link->get_recv_ifname()
+                                             : send_link->get_send_ifname();
+        std::vector<size_t> placed_cpus;
+        io_srv = _create_new_io_service(
+            args, thread_index, num_threads, ifname, placed_cpus);
+        _io_srv_info_map[io_srv] = {1 /*connection_count*/, placed_cpus};
     } else {
         using map_pair_t = std::pair<io_service::sptr, io_srv_info_t>;
         auto cmp         = [](const map_pair_t& left, const map_pair_t& right) {
@@ -345,6 +463,7 @@ io_service::sptr polling_io_service_mgr::connect_links(recv_link_if::sptr recv_l
         io_srv = it->first;
         _io_srv_info_map[io_srv].connection_count++;
     }
+    _link_info_map[links] = {io_srv, 1 /*mux_ref_count*/};
 
     if (recv_link) {
         io_srv->attach_recv_link(recv_link);
@@ -372,35 +491,106 @@ void polling_io_service_mgr::disconnect_links(
         if (send_link) {
             io_srv->detach_send_link(send_link);
         }
-
         _link_info_map.erase(it);
+    }
+
+    // Release the I/O service once it serves no more links
+    auto& io_srv_info = _io_srv_info_map.at(io_srv);
+    io_srv_info.connection_count--;
+    if (io_srv_info.connection_count == 0) {
+        for (const size_t cpu : io_srv_info.placed_cpus) {
+            release_offload_thread_cpu(cpu);
+        }
         _io_srv_info_map.erase(io_srv);
     }
 }
 
 io_service::sptr polling_io_service_mgr::_create_new_io_service(
-    const io_service_args_t& args, const size_t thread_index)
+    const io_service_args_t& args,
+    const size_t thread_index,
+    const size_t num_threads,
+    const std::string& ifname,
+    std::vector<size_t>& placed_cpus)
 {
     offload_io_service::params_t params;
-    params.client_type = offload_io_service::BOTH_SEND_AND_RECV;
-    params.wait_mode   = offload_io_service::POLL;
+    params.client_type            = offload_io_service::BOTH_SEND_AND_RECV;
+    params.wait_mode              = offload_io_service::POLL;
+    params.num_shared_recv_frames = args.poll_shared_recv_frames;
+    params.num_poll_threads       = num_threads;
 
     const auto& cpu_map = args.poll_offload_thread_cpu;
 
+    // The new service uses threads thread_index to thread_index + num_threads - 1
     std::string cpu_affinity_str;
-    if (cpu_map.count(thread_index) != 0) {
-        const size_t cpu         = cpu_map.at(thread_index);
-        params.cpu_affinity_list = {cpu};
-        cpu_affinity_str         = ", cpu affinity: " + std::to_string(cpu);
-    } else {
-        cpu_affinity_str = ", cpu affinity: none";
+    for (size_t i = thread_index; i < thread_index + num_threads; i++) {
+        std::vector<size_t> cpu_affinity_list;
+        boost::optional<size_t> placed_cpu;
+        if (cpu_map.count(i) != 0) {
+            cpu_affinity_list = {cpu_map.at(i)};
+        } else if (args.offload_thread_placement == io_service_args_t::PLACEMENT_AUTO
+                   && (placed_cpu = place_offload_thread(ifname))) {
+            cpu_affinity_list = {*placed_cpu};
+            placed_cpus.push_back(*placed_cpu);
+        }
+        params.thread_cpu_affinity_lists.push_back(cpu_affinity_list);
+        cpu_affinity_str += (i == thread_index ? "" : ", ")
+                            + cpu_list_to_string(cpu_affinity_list);
     }
 
-    UHD_LOG_INFO(LOG_ID, "Creating new polling I/O service" << cpu_affinity_str);
+    UHD_LOG_INFO(LOG_ID,
+        "Creating new polling I/O service, threads: "
+            << num_threads << ", cpu affinity: " << cpu_affinity_str);
 
     return offload_io_service::make(inline_io_service::make(), params);
 }
 
+/* Process-wide polling I/O service pool
+ *
+ * Polling I/O service manager that is shared by all I/O service managers in the
+ * process, for links that are connected with poll_offload_pool=process. This
+ * way, the links of several devices (each with its own rfnoc_graph and I/O
+ * service manager) share the same poll threads. The pool lives as long as any
+ * of the managers that use it.
+ */
+class polling_io_service_pool
+{
+public:
+    using sptr = std::shared_ptr<polling_io_service_pool>;
+
+    //! Returns the pool, creating it if no manager holds it
+    static sptr get()
+    {
+        static std::mutex instance_mutex;
+        static std::weak_ptr<polling_io_service_pool> instance;
+        std::lock_guard<std::mutex> lock(instance_mutex);
+        sptr pool = instance.lock();
+        if (!pool) {
+            pool     = std::make_shared<polling_io_service_pool>();
+            instance = pool;
+        }
+        return pool;
+    }
+
+    io_service::sptr connect_links(recv_link_if::sptr recv_link,
+        send_link_if::sptr send_link,
+        const io_service_args_t& args)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _polling_io_srv_mgr.connect_links(recv_link, send_link, args);
+    }
+
+    void disconnect_links(recv_link_if::sptr recv_link, send_link_if::sptr send_link)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _polling_io_srv_mgr.disconnect_links(recv_link, send_link);
+    }
+
+private:
+    // Managers of different devices connect their links from different threads
+    std::mutex _mutex;
+    polling_io_service_mgr _polling_io_srv_mgr;
+};
+
 /* Main I/O service manager implementation class
  *
  * Composite I/O service manager that dispatches requests to other managers,
@@ -421,7 +611,12 @@ public:
     void disconnect_links(recv_link_if::sptr recv_link, send_link_if::sptr send_link);
 
 private:
-    enum io_service_type_t { INLINE_IO_SRV, BLOCKING_IO_SRV, POLLING_IO_SRV };
+    enum io_service_type_t {
+        INLINE_IO_SRV,
+        BLOCKING_IO_SRV,
+        POLLING_IO_SRV,
+        POOLED_POLLING_IO_SRV
+    };
     struct xport_args_t
     {
         bool offload                              = false;
@@ -443,6 +638,9 @@ private:
     blocking_io_service_mgr _blocking_io_srv_mgr;
     polling_io_service_mgr _polling_io_srv_mgr;
 
+    //! The process-wide pool, once a link was connected to it
+    polling_io_service_pool::sptr _polling_io_srv_pool;
+
     // Map of links to I/O service
     std::map<link_pair_t, link_info_t> _link_info_map;
 };
@@ -492,6 +690,7 @@ io_service::sptr io_service_mgr_impl::connect_links(recv_link_if::sptr recv_link
 
     io_service::sptr io_srv;
     io_service_type_t io_srv_type;
+    size_t inline_spin_us = 0;
 
     if (it != _link_info_map.end()) {
         io_srv      = it->second.io_srv;
@@ -510,12 +709,18 @@ io_service::sptr io_service_mgr_impl::connect_links(recv_link_if::sptr recv_link
 
             if (offload) {
                 if (wait_mode == io_service_args_t::POLL) {
-                    io_srv_type = POLLING_IO_SRV;
+                    io_srv_type =
+                        (args.poll_offload_pool == io_service_args_t::POOL_PROCESS)
+                            ? POOLED_POLLING_IO_SRV
+                            : POLLING_IO_SRV;
                 } else {
                     io_srv_type = BLOCKING_IO_SRV;
                 }
             } else {
                 io_srv_type = INLINE_IO_SRV;
+                if (wait_mode == io_service_args_t::HYBRID) {
+                    inline_spin_us = args.hybrid_spin_us;
+                }
             }
         }
     }
@@ -532,7 +737,8 @@ io_service::sptr io_service_mgr_impl::connect_links(recv_link_if::sptr recv_link
 
     switch (io_srv_type) {
         case INLINE_IO_SRV:
-            io_srv = _inline_io_srv_mgr.connect_links(recv_link, send_link);
+            io_srv =
+                _inline_io_srv_mgr.connect_links(recv_link, send_link, inline_spin_us);
             break;
         case BLOCKING_IO_SRV:
             io_srv = _blocking_io_srv_mgr.connect_links(
@@ -541,6 +747,12 @@ io_service::sptr io_service_mgr_impl::connect_links(recv_link_if::sptr recv_link
         case POLLING_IO_SRV:
             io_srv = _polling_io_srv_mgr.connect_links(recv_link, send_link, args);
             break;
+        case POOLED_POLLING_IO_SRV:
+            if (!_polling_io_srv_pool) {
+                _polling_io_srv_pool = polling_io_service_pool::get();
+            }
+            io_srv = _polling_io_srv_pool->connect_links(recv_link, send_link, args);
+            break;
         default:
             UHD_THROW_INVALID_CODE_PATH();
     }
@@ -566,6 +778,9 @@ void io_service_mgr_impl::disconnect_links(
         case POLLING_IO_SRV:
             _polling_io_srv_mgr.disconnect_links(recv_link, send_link);
             break;
+        case POOLED_POLLING_IO_SRV:
+            _polling_io_srv_pool->disconnect_links(recv_link, send_link);
+            break;
         default:
             UHD_THROW_INVALID_CODE_PATH();
     }
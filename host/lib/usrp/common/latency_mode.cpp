@@ -0,0 +1,167 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/thread.hpp>
+#include <uhdlib/usrp/common/latency_mode.hpp>
+#include <uhdlib/usrp/constrained_device_args.hpp>
+#include <cmath>
+#include <sstream>
+#include <vector>
+#ifdef __linux__
+#    include <sched.h>
+#endif
+
+static const std::string LOG_ID = "LATENCY_MODE";
+
+static const char* latency_mode_str        = "latency_mode";
+static const char* streamer_thread_cpu_str = "streamer_thread_cpu";
+
+namespace uhd { namespace usrp {
+
+namespace {
+
+//! Stream args that the ultra latency mode implies, in the order they are logged
+std::vector<std::pair<std::string, std::string>> get_ultra_args()
+{
+    return {{"spp", std::to_string(ULTRA_SPP)},
+        {"num_recv_frames", std::to_string(ULTRA_NUM_FRAMES)},
+        {"num_send_frames", std::to_string(ULTRA_NUM_FRAMES)},
+        {"recv_offload", "0"},
+        {"send_offload", "0"},
+        {"recv_offload_wait_mode", "hybrid"},
+        {"send_offload_wait_mode", "hybrid"}};
+}
+
+latency_mode_args_t::mode_t get_mode_arg(const device_addr_t& args)
+{
+    constrained_device_args_t::enum_arg<latency_mode_args_t::mode_t> arg(
+        latency_mode_str,
+        latency_mode_args_t::DEFAULT,
+        {{"default", latency_mode_args_t::DEFAULT},
+            {"ultra", latency_mode_args_t::ULTRA}});
+
+    if (args.has_key(latency_mode_str)) {
+        arg.parse(args[latency_mode_str]);
+    }
+    return arg.get();
+}
+
+} // namespace
+
+latency_mode_args_t read_latency_mode_args(const device_addr_t& args)
+{
+    latency_mode_args_t latency_args;
+    latency_args.mode = get_mode_arg(args);
+    if (latency_args.mode == latency_mode_args_t::ULTRA) {
+        latency_args.rx_fc_ack_every_pkt = true;
+        latency_args.tx_fc_freq_ratio    = ULTRA_TX_FC_FREQ_RATIO;
+        latency_args.max_fc_window_pkts  = ULTRA_NUM_FRAMES;
+        latency_args.realtime_thread     = true;
+    }
+    if (args.has_key(streamer_thread_cpu_str)) {
+        latency_args.streamer_thread_cpu = args.cast<size_t>(streamer_thread_cpu_str, 0);
+    }
+    return latency_args;
+}
+
+device_addr_t apply_latency_mode(
+    const device_addr_t& stream_args, const device_addr_t& dev_args)
+{
+    device_addr_t args = stream_args;
+    if (!args.has_key(latency_mode_str) && dev_args.has_key(latency_mode_str)) {
+        args[latency_mode_str] = dev_args[latency_mode_str];
+    }
+    if (!args.has_key(streamer_thread_cpu_str)
+        && dev_args.has_key(streamer_thread_cpu_str)) {
+        args[streamer_thread_cpu_str] = dev_args[streamer_thread_cpu_str];
+    }
+
+    const latency_mode_args_t latency_args = read_latency_mode_args(args);
+    if (latency_args.mode == latency_mode_args_t::DEFAULT) {
+        return args;
+    }
+
+    std::ostringstream resolved;
+    for (const auto& implied_arg : get_ultra_args()) {
+        const std::string& key = implied_arg.first;
+        if (args.has_key(key)) {
+            resolved << key << "=" << args[key] << " (stream arg), ";
+        } else if (dev_args.has_key(key)) {
+            // Keep the device arg, the links and the I/O service manager read
+            // it themselves
+            resolved << key << "=" << dev_args[key] << " (device arg), ";
+        } else {
+            args[key] = implied_arg.second;
+            resolved << key << "=" << args[key] << ", ";
+        }
+    }
+    resolved << "fc_window_pkts=" << latency_args.max_fc_window_pkts
+             << ", rx_fc_ack=every packet"
+             << ", tx_fc_freq_ratio=" << latency_args.tx_fc_freq_ratio
+             << ", streamer_thread=realtime";
+    UHD_LOG_INFO(LOG_ID,
+        "Using latency_mode=" << args[latency_mode_str] << ": " << resolved.str());
+    return args;
+}
+
+rfnoc::stream_buff_params_t get_max_fc_capacity(
+    const latency_mode_args_t& args, const size_t frame_size)
+{
+    if (args.max_fc_window_pkts == 0) {
+        return {rfnoc::MAX_FC_CAPACITY_BYTES, rfnoc::MAX_FC_CAPACITY_PKTS};
+    }
+    return {args.max_fc_window_pkts * frame_size,
+        static_cast<uint32_t>(args.max_fc_window_pkts)};
+}
+
+rfnoc::stream_buff_params_t get_rx_fc_freq(const latency_mode_args_t& args,
+    const rfnoc::stream_buff_params_t& capacity,
+    const bool packet_fc)
+{
+    // An ack is due as soon as the count since the last one reaches the
+    // frequency, so a frequency of 1 acks every packet
+    if (packet_fc) {
+        return {rfnoc::MAX_FC_FREQ_BYTES,
+            args.rx_fc_ack_every_pkt ? 1
+                                     : static_cast<uint32_t>(std::ceil(
+                                         capacity.packets * args.rx_fc_freq_ratio))};
+    }
+    return {args.rx_fc_ack_every_pkt
+                ? 1
+                : static_cast<uint64_t>(
+                    std::ceil(double(capacity.bytes) * args.rx_fc_freq_ratio)),
+        rfnoc::MAX_FC_FREQ_PKTS};
+}
+
+void setup_latency_mode_thread(const latency_mode_args_t& args)
+{
+    if (!args.realtime_thread) {
+        return;
+    }
+    // Both calls log their own failures
+    uhd::set_thread_priority_safe(1.0, true);
+
+    boost::optional<size_t> cpu = args.streamer_thread_cpu;
+#ifdef __linux__
+    if (!cpu) {
+        const int current_cpu = sched_getcpu();
+        if (current_cpu >= 0) {
+            cpu = static_cast<size_t>(current_cpu);
+        }
+    }
+#endif
+    if (!cpu) {
+        UHD_LOG_WARNING(LOG_ID,
+            "Could not find the CPU of the streamer thread, not pinning it. Set "
+            "streamer_thread_cpu to pin it.");
+        return;
+    }
+    UHD_LOG_INFO(LOG_ID, "Pinning the streamer thread to CPU " << *cpu);
+    uhd::set_thread_affinity({*cpu});
+}
+
+}} // namespace uhd::usrp
@@ -9,6 +9,9 @@
 #include <uhdlib/utils/narrow.hpp>
 #include <chrono>
 #include <iomanip>
+#include <map>
+#include <mutex>
+#include <tuple>
 
 using namespace uhd;
 
@@ -69,6 +72,8 @@ constexpr std::array<std::array<int, NUM_CHDIV_STAGES>, NUM_DIVIDERS> LMX2592_CH
       { 3, 8, 8 } }
 };
 
+constexpr size_t MAX_CACHED_PLL_CONFIGS = 4096;
+
 constexpr int SPI_ADDR_SHIFT = 16;
 constexpr int SPI_ADDR_MASK = 0x7f;
 constexpr int SPI_READ_FLAG = 1 << 23;
@@ -108,6 +113,68 @@ inline bool offset_abs_less_than_compare(const offset_t a, const offset_t b)
     return std::abs(a.first) < std::abs(b.first);
 }
 
+//! Divider and fractional settings that produce one output frequency
+struct pll_config_t
+{
+    int output_divider_index;
+    bool osc_doubler;
+    uint16_t pll_r_pre;
+    uint8_t mult;
+    uint8_t pll_r;
+    bool n_pre_divide_by_4;
+    uint16_t pll_n;
+    uint32_t fnum;
+    uint32_t fden;
+    uint32_t mash_seed;
+    double actual_freq;
+};
+
+/*! Cache of PLL configurations
+ *
+ * Calculating a configuration (in particular with spur dodging) takes longer
+ * than programming it. The result only depends on the requested frequency,
+ * the spur dodging settings, the reference frequency and the MASH order, so
+ * the cache is shared by all LMX2592s. Channels that are tuned alike, e.g.,
+ * when they share an LO, then only calculate the configuration once.
+ */
+class pll_config_cache
+{
+public:
+    //! (frequency, spur dodging threshold, reference frequency, MASH order)
+    using key_t = std::tuple<double, double, double, int>;
+
+    bool find(const key_t& key, pll_config_t& config)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const auto it = _configs.find(key);
+        if (it == _configs.end()) {
+            return false;
+        }
+        config = it->second;
+        return true;
+    }
+
+    void insert(const key_t& key, const pll_config_t& config)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        // Don't let long sweeps grow the cache without bounds
+        if (_configs.size() >= MAX_CACHED_PLL_CONFIGS) {
+            _configs.clear();
+        }
+        _configs[key] = config;
+    }
+
+private:
+    std::mutex _mutex;
+    std::map<key_t, pll_config_t> _configs;
+};
+
+pll_config_cache& get_pll_config_cache()
+{
+    static pll_config_cache cache;
+    return cache;
+}
+
 } // namespace
 
 class lmx2592_impl : public lmx2592_iface
@@ -172,112 +239,42 @@ public:
             throw runtime_error("Requested frequency is out of the supported range");
         }
 
-        // Find the largest possible divider
-        auto output_divider_index = 0;
-        for (auto limit : LMX2592_CHDIV_MIN_FREQ) {
-            // The second harmonic level is very bad when using the div-by-3
-            // Skip and let the div-by-4 cover the range
-            if (LMX2592_CHDIV_DIVIDERS[output_divider_index] == 3) {
-                output_divider_index++;
-                continue;
-            }
-            if (target_freq < limit) {
-                output_divider_index++;
-            } else {
-                break;
-            }
+        // Without spur dodging, the threshold doesn't matter
+        const pll_config_cache::key_t key{target_freq,
+            spur_dodging ? spur_dodging_threshold : -1.0,
+            _ref_freq,
+            static_cast<int>(_regs.mash_order)};
+        pll_config_t config;
+        if (!get_pll_config_cache().find(key, config)) {
+            config = _calc_pll_config(target_freq, spur_dodging, spur_dodging_threshold);
+            get_pll_config_cache().insert(key, config);
         }
-        const auto output_divider = LMX2592_CHDIV_DIVIDERS[output_divider_index];
-        _set_chdiv_values(output_divider_index);
-
-        // Setup input signal path and PLL loop
-        const int vco_multiplier = target_freq > LMX2592_MAX_VCO_FREQ ? 2 : 1;
-
-        const auto target_vco_freq = target_freq * output_divider;
-        const auto core_vco_freq   = target_vco_freq / vco_multiplier;
-
-        double input_freq = _ref_freq;
-
-        // Input Doubler stage
-        if (input_freq <= LMX2592_MAX_DOUBLER_INPUT_FREQ) {
-            _regs.osc_doubler = 1;
-            input_freq *= 2;
-        } else {
-            _regs.osc_doubler = 0;
-        }
-
-        // Pre-R divider
-        _regs.pll_r_pre =
-            narrow_cast<uint16_t>(std::ceil(input_freq / LMX2592_MAX_MULT_INPUT_FREQ));
-        input_freq /= _regs.pll_r_pre;
-
-        // Multiplier
-        _regs.mult =
-            narrow_cast<uint8_t>(std::floor(LMX2592_MAX_MULT_OUT_FREQ / input_freq));
-        input_freq *= _regs.mult;
-
-        // Post R divider
-        _regs.pll_r =
-            narrow_cast<uint8_t>(std::ceil(input_freq / LMX2592_MAX_POSTR_DIV_OUT_FREQ));
-
-        // Default to divide by 2, will be increased later if N exceeds its limit
-        int prescaler   = 2;
-        _regs.pll_n_pre = lmx2592_regs_t::pll_n_pre_t::PLL_N_PRE_DIVIDE_BY_2;
-
-        const int min_n_divider = LMX2592_MIN_N_DIV[_regs.mash_order];
-        double pfd_freq         = input_freq / _regs.pll_r;
-        while (pfd_freq * (prescaler * min_n_divider) / vco_multiplier > core_vco_freq) {
-            _regs.pll_r++;
-            pfd_freq = input_freq / _regs.pll_r;
-        }
-
-        // Calculate N and frac
-        const auto N_dot_F = target_vco_freq / (pfd_freq * prescaler);
-        auto N             = static_cast<uint16_t>(std::floor(N_dot_F));
-        if (N > MAX_N_DIVIDER) {
-            _regs.pll_n_pre = lmx2592_regs_t::pll_n_pre_t::PLL_N_PRE_DIVIDE_BY_4;
-            N /= 2;
-        }
-        const auto frac = N_dot_F - N;
-
-        // Increase VCO step size to threshold to avoid primary fractional spurs
-        const double min_vco_step_size = spur_dodging ? spur_dodging_threshold : 1;
-        // Calculate Fden
-        const auto initial_fden =
-            static_cast<uint32_t>(std::floor(pfd_freq * prescaler / min_vco_step_size));
-        const auto fden = (spur_dodging) ? _find_fden(initial_fden) : initial_fden;
-        // Calculate Fnum
-        const auto initial_fnum = static_cast<uint32_t>(std::round(frac * fden));
-        const auto fnum         = (spur_dodging) ? _find_fnum(N,
-                                               initial_fnum,
-                                               fden,
-                                               prescaler,
-                                               pfd_freq,
-                                               output_divider,
-                                               spur_dodging_threshold)
-                                         : initial_fnum;
-
-        // Calculate mash_seed
-        // if spur_dodging is true, mash_seed is the first odd value less than fden
-        // else mash_seed is int(fden / 2);
-        const uint32_t mash_seed = (spur_dodging) ? _find_mash_seed(fden)
-                                                  : static_cast<uint32_t>(fden / 2);
-
-        // Calculate actual Fcore_vco, Fvco, F_lo frequencies
-        const auto actual_fvco = pfd_freq * prescaler * (N + double(fnum) / double(fden));
-        const auto actual_fcore_vco = actual_fvco / vco_multiplier;
-        const auto actual_f_lo      = actual_fcore_vco * vco_multiplier / output_divider;
 
         // Write to registers
-        _regs.pll_n         = N;
-        _regs.pll_num_lsb   = narrow_cast<uint16_t>(fnum);
-        _regs.pll_num_msb   = narrow_cast<uint16_t>(fnum >> 16);
-        _regs.pll_den_lsb   = narrow_cast<uint16_t>(fden);
-        _regs.pll_den_msb   = narrow_cast<uint16_t>(fden >> 16);
-        _regs.mash_seed_lsb = narrow_cast<uint16_t>(mash_seed);
-        _regs.mash_seed_msb = narrow_cast<uint16_t>(mash_seed >> 16);
+        _set_chdiv_values(config.output_divider_index);
+        _regs.osc_doubler   = config.osc_doubler ? 1 : 0;
+        _regs.pll_r_pre     = config.pll_r_pre;
+        _regs.mult          = config.mult;
+        _regs.pll_r         = config.pll_r;
+        _regs.pll_n_pre     = config.n_pre_divide_by_4
+                                  ? lmx2592_regs_t::pll_n_pre_t::PLL_N_PRE_DIVIDE_BY_4
+                                  : lmx2592_regs_t::pll_n_pre_t::PLL_N_PRE_DIVIDE_BY_2;
+        _regs.pll_n         = config.pll_n;
+        _regs.pll_num_lsb   = narrow_cast<uint16_t>(config.fnum);
+        _regs.pll_num_msb   = narrow_cast<uint16_t>(config.fnum >> 16);
+        _regs.pll_den_lsb   = narrow_cast<uint16_t>(config.fden);
+        _regs.pll_den_msb   = narrow_cast<uint16_t>(config.fden >> 16);
+        _regs.mash_seed_lsb = narrow_cast<uint16_t>(config.mash_seed);
+        _regs.mash_seed_msb = narrow_cast<uint16_t>(config.mash_seed >> 16);
+
+        // If the synthesizer is already programmed this way, it's also still
+        // calibrated for it, and there's nothing to write
+        if (!_rewrite_regs && _regs.get_changed_addrs<size_t>().empty()) {
+            UHD_LOGGER_TRACE("LMX2592") << "Already tuned to " << config.actual_freq;
+            return config.actual_freq;
+        }
 
-        UHD_LOGGER_TRACE("LMX2592") << "Tuned to " << actual_f_lo;
+        UHD_LOGGER_TRACE("LMX2592") << "Tuned to " << config.actual_freq;
 
         // Toggle fcal field to start calibration
         _regs.fcal_enable = 0;
@@ -286,7 +283,7 @@ public:
         _regs.fcal_enable = 1;
         commit();
 
-        return actual_f_lo;
+        return config.actual_freq;
     }
 
     void set_mash_order(const mash_order_t mash_order) override
@@ -428,6 +425,114 @@ private: // Members
     bool _rewrite_regs;
     double _ref_freq;
 
+    //! Calculates the PLL configuration for \p target_freq
+    pll_config_t _calc_pll_config(const double target_freq,
+        const bool spur_dodging,
+        const double spur_dodging_threshold)
+    {
+        pll_config_t config;
+
+        // Find the largest possible divider
+        auto output_divider_index = 0;
+        for (auto limit : LMX2592_CHDIV_MIN_FREQ) {
+            // The second harmonic level is very bad when using the div-by-3
+            // Skip and let the div-by-4 cover the range
+            if (LMX2592_CHDIV_DIVIDERS[output_divider_index] == 3) {
+                output_divider_index++;
+                continue;
+            }
+            if (target_freq < limit) {
+                output_divider_index++;
+            } else {
+                break;
+            }
+        }
+        const auto output_divider   = LMX2592_CHDIV_DIVIDERS[output_divider_index];
+        config.output_divider_index = output_divider_index;
+
+        // Setup input signal path and PLL loop
+        const int vco_multiplier = target_freq > LMX2592_MAX_VCO_FREQ ? 2 : 1;
+
+        const auto target_vco_freq = target_freq * output_divider;
+        const auto core_vco_freq   = target_vco_freq / vco_multiplier;
+
+        double input_freq = _ref_freq;
+
+        // Input Doubler stage
+        config.osc_doubler = input_freq <= LMX2592_MAX_DOUBLER_INPUT_FREQ;
+        if (config.osc_doubler) {
+            input_freq *= 2;
+        }
+
+        // Pre-R divider
+        config.pll_r_pre =
+            narrow_cast<uint16_t>(std::ceil(input_freq / LMX2592_MAX_MULT_INPUT_FREQ));
+        input_freq /= config.pll_r_pre;
+
+        // Multiplier
+        config.mult =
+            narrow_cast<uint8_t>(std::floor(LMX2592_MAX_MULT_OUT_FREQ / input_freq));
+        input_freq *= config.mult;
+
+        // Post R divider
+        config.pll_r =
+            narrow_cast<uint8_t>(std::ceil(input_freq / LMX2592_MAX_POSTR_DIV_OUT_FREQ));
+
+        // Default to divide by 2, will be increased later if N exceeds its limit
+        int prescaler            = 2;
+        config.n_pre_divide_by_4 = false;
+
+        const int min_n_divider = LMX2592_MIN_N_DIV[_regs.mash_order];
+        double pfd_freq         = input_freq / config.pll_r;
+        while (pfd_freq * (prescaler * min_n_divider) / vco_multiplier > core_vco_freq) {
+            config.pll_r++;
+            pfd_freq = input_freq / config.pll_r;
+        }
+
+        // Calculate N and frac
+        const auto N_dot_F = target_vco_freq / (pfd_freq * prescaler);
+        auto N             = static_cast<uint16_t>(std::floor(N_dot_F));
+        if (N > MAX_N_DIVIDER) {
+            config.n_pre_divide_by_4 = true;
+            N /= 2;
+        }
+        const auto frac = N_dot_F - N;
+
+        // Increase VCO step size to threshold to avoid primary fractional spurs
+        const double min_vco_step_size = spur_dodging ? spur_dodging_threshold : 1;
+        // Calculate Fden
+        const auto initial_fden =
+            static_cast<uint32_t>(std::floor(pfd_freq * prescaler / min_vco_step_size));
+        const auto fden = (spur_dodging) ? _find_fden(initial_fden) : initial_fden;
+        // Calculate Fnum
+        const auto initial_fnum = static_cast<uint32_t>(std::round(frac * fden));
+        const auto fnum         = (spur_dodging) ? _find_fnum(N,
+                                               initial_fnum,
+                                               fden,
+                                               prescaler,
+                                               pfd_freq,
+                                               output_divider,
+                                               spur_dodging_threshold)
+                                         : initial_fnum;
+
+        // Calculate mash_seed
+        // if spur_dodging is true, mash_seed is the first odd value less than fden
+        // else mash_seed is int(fden / 2);
+        const uint32_t mash_seed = (spur_dodging) ? _find_mash_seed(fden)
+                                                  : static_cast<uint32_t>(fden / 2);
+
+        // Calculate actual Fcore_vco, Fvco, F_lo frequencies
+        const auto actual_fvco = pfd_freq * prescaler * (N + double(fnum) / double(fden));
+        const auto actual_fcore_vco = actual_fvco / vco_multiplier;
+
+        config.pll_n       = N;
+        config.fnum        = fnum;
+        config.fden        = fden;
+        config.mash_seed   = mash_seed;
+        config.actual_freq = actual_fcore_vco * vco_multiplier / output_divider;
+        return config;
+    }
+
     void _set_chdiv_values(const int output_divider_index)
     {
         // Configure divide segments and mux
@@ -0,0 +1,262 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/byteswap.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/safe_call.hpp>
+#include <uhd/utils/thread.hpp>
+#include <uhdlib/transport/udp_common.hpp>
+#include <uhdlib/usrp/common/mpm_telemetry.hpp>
+#include <boost/asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace uhd;
+using namespace uhd::usrp;
+namespace asio = boost::asio;
+
+constexpr char mpm_telemetry_receiver::RATE_KEY[];
+
+namespace {
+
+constexpr char RECORD_MAGIC[]     = {'M', 'P', 'M', 'T'};
+constexpr uint8_t RECORD_VERSION  = 1;
+constexpr size_t HEADER_LEN       = 20;
+constexpr size_t ENTRY_HEADER_LEN = 4;
+constexpr size_t VALUE_LEN        = 8;
+//! Largest possible UDP payload
+constexpr size_t MAX_RECORD_LEN = 65507;
+
+//! How often the receive thread checks whether it should stop (ms)
+constexpr int32_t POLL_INTERVAL_MS = 100;
+//! Time between retries when subscribing fails (s)
+constexpr double RESUBSCRIBE_INTERVAL = 10.0;
+//! Subscriptions are renewed after this fraction of the lease time
+constexpr double LEASE_RENEWAL_FRACTION = 1.0 / 3;
+//! Values are stale when they haven't been updated for this many record periods
+constexpr double MAX_AGE_PERIODS = 3.0;
+//! Timeout for the unsubscribe call on shutdown (ms)
+constexpr uint64_t UNSUBSCRIBE_TIMEOUT_MS = 1000;
+
+template <typename T>
+T read_le(const uint8_t* data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return uhd::wtohx(value);
+}
+
+/*! MPM telemetry receiver
+ *
+ * A thread receives the records, and renews the subscription in between.
+ */
+class mpm_telemetry_receiver_impl : public mpm_telemetry_receiver
+{
+public:
+    using clock_t = std::chrono::steady_clock;
+
+    mpm_telemetry_receiver_impl(
+        uhd::rpc_client::sptr rpc, const std::string& mgmt_addr, const double rate)
+        : _rpc(rpc), _rate(rate), _socket(_io_service)
+    {
+        if (rate <= 0.0) {
+            throw uhd::value_error("Telemetry rate must be positive!");
+        }
+        _max_age = std::chrono::duration_cast<clock_t::duration>(
+            std::chrono::duration<double>(MAX_AGE_PERIODS / rate));
+
+        asio::ip::udp::resolver resolver(_io_service);
+        asio::ip::udp::resolver::query query(asio::ip::udp::v4(), mgmt_addr, "0");
+        _mgmt_addr = resolver.resolve(query)->endpoint().address();
+
+        _socket.open(asio::ip::udp::v4());
+        _socket.bind(asio::ip::udp::endpoint(asio::ip::udp::v4(), 0));
+        _port = _socket.local_endpoint().port();
+
+        _next_subscribe = clock_t::now() + _subscribe();
+        _recv_thread    = std::thread([this]() { _run(); });
+        uhd::set_thread_name(&_recv_thread, "mpm_telemetry");
+    }
+
+    ~mpm_telemetry_receiver_impl()
+    {
+        _running = false;
+        _recv_thread.join();
+        UHD_SAFE_CALL(
+            _rpc->notify(UNSUBSCRIBE_TIMEOUT_MS, "unsubscribe_telemetry", _port);)
+    }
+
+    boost::optional<uhd::sensor_value_t> get_value(const std::string& key)
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        auto entry = _values.find(key);
+        if (entry == _values.end() || clock_t::now() - entry->second.time > _max_age) {
+            return boost::none;
+        }
+        return entry->second.value;
+    }
+
+private:
+    struct entry_t
+    {
+        uhd::sensor_value_t value;
+        clock_t::time_point time;
+    };
+
+    //! Subscribe, or renew the subscription. Returns the time until the next renewal.
+    clock_t::duration _subscribe()
+    {
+        double renewal_interval = RESUBSCRIBE_INTERVAL;
+        try {
+            const double lease_time =
+                _rpc->request<double>("subscribe_telemetry", _port, _rate);
+            renewal_interval = lease_time * LEASE_RENEWAL_FRACTION;
+        } catch (const uhd::exception& ex) {
+            UHD_LOG_WARNING(
+                "MPMD", "Failed to subscribe to device telemetry: " << ex.what());
+        }
+        return std::chrono::duration_cast<clock_t::duration>(
+            std::chrono::duration<double>(renewal_interval));
+    }
+
+    void _run()
+    {
+        std::vector<uint8_t> buff(MAX_RECORD_LEN);
+        while (_running) {
+            if (clock_t::now() >= _next_subscribe) {
+                _next_subscribe = clock_t::now() + _subscribe();
+            }
+            if (!uhd::transport::wait_for_recv_ready(
+                    _socket.native_handle(), POLL_INTERVAL_MS)) {
+                continue;
+            }
+            asio::ip::udp::endpoint sender;
+            boost::system::error_code ec;
+            const size_t len = _socket.receive_from(asio::buffer(buff), sender, 0, ec);
+            if (ec || sender.address() != _mgmt_addr) {
+                continue;
+            }
+            try {
+                _update(unpack_mpm_telemetry_record(buff.data(), len));
+            } catch (const uhd::value_error& ex) {
+                UHD_LOG_DEBUG("MPMD", "Dropping telemetry record: " << ex.what());
+            }
+        }
+    }
+
+    void _update(const mpm_telemetry_record_t& record)
+    {
+        // UDP may reorder records, don't let an old one overwrite newer values
+        if (_have_seq && int32_t(record.seq - _last_seq) <= 0) {
+            return;
+        }
+        _have_seq = true;
+        _last_seq = record.seq;
+        const auto now = clock_t::now();
+        std::lock_guard<std::mutex> l(_mutex);
+        for (const auto& value : record.values) {
+            auto entry = _values.find(value.first);
+            if (entry == _values.end()) {
+                _values.emplace(value.first, entry_t{value.second, now});
+            } else {
+                entry->second = entry_t{value.second, now};
+            }
+        }
+    }
+
+    uhd::rpc_client::sptr _rpc;
+    const double _rate;
+    clock_t::duration _max_age;
+
+    asio::io_service _io_service;
+    asio::ip::udp::socket _socket;
+    asio::ip::address _mgmt_addr;
+    uint16_t _port;
+
+    std::atomic<bool> _running{true};
+    std::thread _recv_thread;
+    clock_t::time_point _next_subscribe;
+    bool _have_seq     = false;
+    uint32_t _last_seq = 0;
+
+    std::mutex _mutex;
+    std::map<std::string, entry_t> _values;
+};
+
+} // namespace
+
+mpm_telemetry_record_t uhd::usrp::unpack_mpm_telemetry_record(
+    const uint8_t* data, const size_t len)
+{
+    if (len < HEADER_LEN
+        || std::memcmp(data, RECORD_MAGIC, sizeof(RECORD_MAGIC)) != 0) {
+        throw uhd::value_error("Not a telemetry record");
+    }
+    if (data[4] != RECORD_VERSION) {
+        throw uhd::value_error(
+            "Unsupported telemetry record version: " + std::to_string(data[4]));
+    }
+    mpm_telemetry_record_t record;
+    const uint16_t num_entries = read_le<uint16_t>(data + 6);
+    record.seq                 = read_le<uint32_t>(data + 8);
+    record.timestamp_ns        = read_le<uint64_t>(data + 12);
+
+    size_t offset = HEADER_LEN;
+    for (size_t i = 0; i < num_entries; i++) {
+        if (offset + ENTRY_HEADER_LEN > len) {
+            throw uhd::value_error("Truncated telemetry record");
+        }
+        const char type       = static_cast<char>(data[offset]);
+        const size_t key_len  = data[offset + 1];
+        const size_t name_len = data[offset + 2];
+        const size_t unit_len = data[offset + 3];
+        offset += ENTRY_HEADER_LEN;
+        if (offset + key_len + name_len + unit_len + VALUE_LEN > len) {
+            throw uhd::value_error("Truncated telemetry record");
+        }
+        const char* strs = reinterpret_cast<const char*>(data + offset);
+        const std::string key(strs, key_len);
+        uhd::sensor_value_t::sensor_map_t sensor;
+        sensor["name"] = std::string(strs + key_len, name_len);
+        sensor["unit"] = std::string(strs + key_len + name_len, unit_len);
+        offset += key_len + name_len + unit_len;
+        const uint64_t raw_value = read_le<uint64_t>(data + offset);
+        offset += VALUE_LEN;
+        switch (type) {
+            case uhd::sensor_value_t::BOOLEAN:
+                sensor["type"]  = "BOOLEAN";
+                sensor["value"] = raw_value ? "true" : "false";
+                break;
+            case uhd::sensor_value_t::INTEGER:
+                sensor["type"]  = "INTEGER";
+                sensor["value"] = std::to_string(static_cast<int64_t>(raw_value));
+                break;
+            case uhd::sensor_value_t::REALNUM: {
+                double value;
+                std::memcpy(&value, &raw_value, sizeof(value));
+                sensor["type"]  = "REALNUM";
+                sensor["value"] = std::to_string(value);
+                break;
+            }
+            default:
+                throw uhd::value_error(
+                    std::string("Invalid telemetry value type: ") + type);
+        }
+        record.values.emplace(key, uhd::sensor_value_t(sensor));
+    }
+    return record;
+}
+
+mpm_telemetry_receiver::sptr mpm_telemetry_receiver::make(
+    uhd::rpc_client::sptr rpc, const std::string& mgmt_addr, const double rate)
+{
+    return std::make_shared<mpm_telemetry_receiver_impl>(rpc, mgmt_addr, rate);
+}
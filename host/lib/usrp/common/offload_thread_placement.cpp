@@ -0,0 +1,208 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/config.hpp>
+#include <uhdlib/usrp/common/offload_thread_placement.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <fstream>
+#include <set>
+
+#ifdef UHD_PLATFORM_LINUX
+#    include <pthread.h>
+#    include <sched.h>
+#    include <unistd.h>
+#endif
+
+namespace uhd { namespace usrp {
+
+namespace {
+
+//! Reads the first line of a file, returns an empty string if that fails
+std::string read_line(const std::string& path)
+{
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+bool contains(const std::vector<size_t>& cpus, const size_t cpu)
+{
+    return std::find(cpus.begin(), cpus.end(), cpu) != cpus.end();
+}
+
+} // namespace
+
+std::vector<size_t> parse_cpu_list(const std::string& cpu_list)
+{
+    std::set<size_t> cpus;
+    std::vector<std::string> ranges;
+    const std::string trimmed = boost::algorithm::trim_copy(cpu_list);
+    boost::algorithm::split(ranges, trimmed, boost::is_any_of(","));
+    for (const auto& range : ranges) {
+        if (range.empty()) {
+            continue;
+        }
+        std::vector<std::string> bounds;
+        boost::algorithm::split(bounds, range, boost::is_any_of("-"));
+        try {
+            const size_t first = boost::lexical_cast<size_t>(bounds.front());
+            const size_t last  = boost::lexical_cast<size_t>(bounds.back());
+            for (size_t cpu = first; cpu <= last; cpu++) {
+                cpus.insert(cpu);
+            }
+        } catch (const boost::bad_lexical_cast&) {
+            return std::vector<size_t>();
+        }
+    }
+    return std::vector<size_t>(cpus.begin(), cpus.end());
+}
+
+cpu_topology_t cpu_topology_t::read_system()
+{
+    cpu_topology_t topology;
+#ifdef UHD_PLATFORM_LINUX
+    const std::string node_dir = "/sys/devices/system/node/";
+    for (const size_t node : parse_cpu_list(read_line(node_dir + "online"))) {
+        const auto cpus = parse_cpu_list(
+            read_line(node_dir + "node" + std::to_string(node) + "/cpulist"));
+        if (!cpus.empty()) {
+            topology.node_cpus[int(node)] = cpus;
+        }
+    }
+    // Kernels without NUMA support have no node directory
+    if (topology.node_cpus.empty()) {
+        const auto cpus = parse_cpu_list(read_line("/sys/devices/system/cpu/online"));
+        if (!cpus.empty()) {
+            topology.node_cpus[0] = cpus;
+        }
+    }
+
+    for (const auto& node : topology.node_cpus) {
+        for (const size_t cpu : node.second) {
+            auto siblings = parse_cpu_list(read_line("/sys/devices/system/cpu/cpu"
+                                                     + std::to_string(cpu)
+                                                     + "/topology/thread_siblings_list"));
+            if (!contains(siblings, cpu)) {
+                siblings.push_back(cpu);
+            }
+            topology.siblings[cpu] = siblings;
+        }
+    }
+#endif
+    return topology;
+}
+
+std::vector<size_t> get_irq_cpus_of_ifname(const std::string& ifname)
+{
+    std::set<size_t> cpus;
+#ifdef UHD_PLATFORM_LINUX
+    namespace fs = boost::filesystem;
+    const fs::path irq_dir("/sys/class/net/" + ifname + "/device/msi_irqs");
+    boost::system::error_code ec;
+    if (ifname.empty() || !fs::is_directory(irq_dir, ec)) {
+        return std::vector<size_t>();
+    }
+    for (fs::directory_iterator it(irq_dir, ec), end; !ec && it != end;
+         it.increment(ec)) {
+        const std::string irq = it->path().filename().string();
+        for (const size_t cpu :
+            parse_cpu_list(read_line("/proc/irq/" + irq + "/smp_affinity_list"))) {
+            cpus.insert(cpu);
+        }
+    }
+#else
+    (void)ifname;
+#endif
+    return std::vector<size_t>(cpus.begin(), cpus.end());
+}
+
+std::vector<size_t> get_current_thread_cpus()
+{
+    std::vector<size_t> cpus;
+#ifdef UHD_PLATFORM_LINUX
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) != 0) {
+        return cpus;
+    }
+    // A thread that may run on any CPU doesn't restrict the placement
+    const long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (num_cpus > 0 && CPU_COUNT(&cpu_set) >= num_cpus) {
+        return cpus;
+    }
+    for (size_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &cpu_set)) {
+            cpus.push_back(cpu);
+        }
+    }
+#endif
+    return cpus;
+}
+
+offload_thread_placement::offload_thread_placement(const cpu_topology_t& topology)
+    : _topology(topology)
+{
+}
+
+boost::optional<size_t> offload_thread_placement::pick_cpu(const int numa_node,
+    const std::vector<size_t>& irq_cpus,
+    const std::vector<size_t>& streamer_cpus)
+{
+    std::vector<size_t> candidates;
+    if (_topology.node_cpus.count(numa_node)) {
+        candidates = _topology.node_cpus.at(numa_node);
+    } else {
+        for (const auto& node : _topology.node_cpus) {
+            candidates.insert(candidates.end(), node.second.begin(), node.second.end());
+        }
+    }
+    if (candidates.empty()) {
+        return boost::none;
+    }
+
+    auto get_siblings = [this](const size_t cpu) {
+        return _topology.siblings.count(cpu) ? _topology.siblings.at(cpu)
+                                             : std::vector<size_t>{cpu};
+    };
+    auto get_num_threads = [this](const size_t cpu) {
+        return _num_threads.count(cpu) ? _num_threads.at(cpu) : 0;
+    };
+
+    // Score the candidates by what they share, the weights follow the order
+    // of priority in the class description
+    boost::optional<size_t> best_cpu;
+    size_t best_score = 0;
+    for (const size_t cpu : candidates) {
+        bool shares_core_with_streamer = false;
+        bool shares_core_with_offload  = false;
+        for (const size_t sibling : get_siblings(cpu)) {
+            shares_core_with_streamer |= contains(streamer_cpus, sibling);
+            shares_core_with_offload |= (sibling != cpu && get_num_threads(sibling) > 0);
+        }
+        const size_t score = 8 * get_num_threads(cpu) + 4 * shares_core_with_streamer
+                             + 2 * shares_core_with_offload + contains(irq_cpus, cpu);
+        if (!best_cpu || score < best_score) {
+            best_cpu   = cpu;
+            best_score = score;
+        }
+    }
+
+    _num_threads[*best_cpu]++;
+    return best_cpu;
+}
+
+void offload_thread_placement::release_cpu(const size_t cpu)
+{
+    if (_num_threads.count(cpu) && --_num_threads.at(cpu) == 0) {
+        _num_threads.erase(cpu);
+    }
+}
+
+}} // namespace uhd::usrp
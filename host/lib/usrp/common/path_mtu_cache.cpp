@@ -0,0 +1,64 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/utils/log.hpp>
+#include <uhdlib/usrp/common/path_mtu_cache.hpp>
+#include <iterator>
+
+using namespace uhd::usrp;
+
+constexpr char path_mtu_cache::TTL_KEY[];
+constexpr double path_mtu_cache::DEFAULT_TTL;
+
+path_mtu_cache& path_mtu_cache::get()
+{
+    static path_mtu_cache cache;
+    return cache;
+}
+
+size_t path_mtu_cache::get_mtu(const std::string& ifname,
+    const std::string& addr,
+    const probe_fn_t& probe_fn,
+    const double ttl)
+{
+    if (ttl <= 0.0) {
+        return probe_fn();
+    }
+    const auto max_age = std::chrono::duration_cast<clock_t::duration>(
+        std::chrono::duration<double>(ttl));
+    const auto key = std::make_pair(ifname, addr);
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto entry = _entries.find(key);
+        if (entry != _entries.end()) {
+            if (clock_t::now() <= entry->second.expiry) {
+                UHD_LOG_TRACE("MTU",
+                    "Using cached path MTU " << entry->second.mtu << " for " << addr
+                                             << " on " << ifname);
+                return entry->second.mtu;
+            }
+            _entries.erase(entry);
+        }
+    }
+
+    const auto expiry = clock_t::now() + max_age;
+    const size_t mtu  = probe_fn();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto now = clock_t::now();
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        it = (it->second.expiry < now) ? _entries.erase(it) : std::next(it);
+    }
+    _entries[key] = entry_t{expiry, mtu};
+    return mtu;
+}
+
+void path_mtu_cache::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+}
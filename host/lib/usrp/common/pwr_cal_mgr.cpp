@@ -205,8 +205,9 @@ public:
         bool cal_data_found = false;
         if (cal::database::has_cal_data(key, _serial)) {
             try {
-                cal_data = cal::container::make<cal::pwr_cal>(
-                    cal::database::read_cal_data(key, _serial));
+                const auto cal_view = cal::database::map_cal_data(key, _serial);
+                cal_data            = cal::container::make<cal::pwr_cal>(
+                    cal_view->data(), cal_view->size());
                 cal_data_found = true;
             } catch (const uhd::exception& ex) {
                 UHD_LOG_WARNING(_log_id, "Error loading cal data: " << ex.what());
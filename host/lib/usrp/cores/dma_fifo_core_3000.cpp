@@ -61,21 +61,25 @@ public:
     /**************************************************************************
      * Structors
      *************************************************************************/
-    dma_fifo_core_3000_impl(
-        poke32_fn_t&& poke_fn, peek32_fn_t&& peek_fn, const size_t fifo_index)
+    dma_fifo_core_3000_impl(poke32_fn_t&& poke_fn,
+        peek32_fn_t&& peek_fn,
+        const size_t fifo_index,
+        peek64_fn_t&& peek64_fn)
         : _fifo_index(fifo_index)
         , poke32(std::move(poke_fn))
         , peek32(std::move(peek_fn))
+        , _peek64(std::move(peek64_fn))
         , _has_bist(unpack_fifo_info(peek32(REG_FIFO_INFO)))
         , _mem_size(peek32(REG_FIFO_MEM_SIZE))
         , _bist_clk_rate(_has_bist ? peek32(REG_BIST_CLK_RATE) : 0.0)
+        , _fifo_size(get_addr_mask() + 1)
     {
         UHD_LOG_DEBUG("DMA FIFO",
             "Initializing FIFO core "
                 << _fifo_index << ": RAM Word Width: " << _mem_size.word_size << " bits, "
                 << "address width: " << _mem_size.addr_size
                 << " bits, base address: " << this->get_addr_base()
-                << ", FIFO size: " << (uint64_t(get_addr_mask()) + 1) / 1024 / 1024
+                << ", FIFO size: " << _fifo_size / 1024 / 1024
                 << " MiB, has BIST: " << (_has_bist ? "Yes" : "No")
                 << ", BIST clock rate: " << (_bist_clk_rate / 1e6)
                 << " MHz, Initial FIFO fullness: "
@@ -106,6 +110,11 @@ public:
         return peek64(REG_FIFO_FULLNESS);
     }
 
+    uint64_t get_fifo_size() const
+    {
+        return _fifo_size;
+    }
+
     uint16_t get_fifo_timeout()
     {
         return peek32(REG_FIFO_TIMEOUT) & 0xFFF;
@@ -114,7 +123,7 @@ public:
     void set_fifo_timeout(const uint16_t timeout_cycles)
     {
         UHD_ASSERT_THROW(timeout_cycles <= 0xFFF);
-        poke32(timeout_cycles, REG_FIFO_TIMEOUT);
+        poke32(REG_FIFO_TIMEOUT, timeout_cycles);
     }
 
     uint64_t get_addr_base()
@@ -129,7 +138,8 @@ public:
 
     void set_addr_mask(uint64_t addr_mask)
     {
-        return poke64(REG_FIFO_ADDR_MASK, addr_mask);
+        poke64(REG_FIFO_ADDR_MASK, addr_mask);
+        _fifo_size = addr_mask + 1;
     }
 
     void set_addr_base(const uint64_t base_addr)
@@ -272,10 +282,16 @@ private:
     const size_t _fifo_index;
     poke32_fn_t poke32;
     peek32_fn_t peek32;
+    //! Single-transaction 64-bit read, may be empty
+    peek64_fn_t _peek64;
 
-    //! Convenience function to do two consecutive peek32's
+    //! Read a 64-bit register, in one transaction if possible, or else with two
+    // consecutive peek32's
     uint64_t peek64(const uint32_t addr)
     {
+        if (_peek64) {
+            return _peek64(addr);
+        }
         const uint32_t lo = peek32(addr);
         const uint32_t hi = peek32(addr + 4);
         return static_cast<uint64_t>(lo) | (static_cast<uint64_t>(hi) << 32);
@@ -309,14 +325,19 @@ private:
 
     //! Clock rate of the BIST circuitry in Hz
     const double _bist_clk_rate;
+
+    //! Size of the FIFO in bytes
+    uint64_t _fifo_size;
 };
 
 //
 // Factory
 //
-dma_fifo_core_3000::sptr dma_fifo_core_3000::make(
-    poke32_fn_t&& poke_fn, peek32_fn_t&& peek_fn, const size_t fifo_index)
+dma_fifo_core_3000::sptr dma_fifo_core_3000::make(poke32_fn_t&& poke_fn,
+    peek32_fn_t&& peek_fn,
+    const size_t fifo_index,
+    peek64_fn_t&& peek64_fn)
 {
     return std::make_shared<dma_fifo_core_3000_impl>(
-        std::move(poke_fn), std::move(peek_fn), fifo_index);
+        std::move(poke_fn), std::move(peek_fn), fifo_index, std::move(peek64_fn));
 }
@@ -49,7 +49,40 @@ public:
         bool readback)
     {
         std::lock_guard<std::mutex> lock(_mutex);
+        _load_config(which_slave, config, num_bits);
 
+        // send data word (must be in upper bits)
+        _poke32(_spi_data_addr, data << (32 - num_bits));
+
+        // conditional readback
+        if (readback) {
+            return _peek32(_readback_addr);
+        }
+
+        return 0;
+    }
+
+    void write_spi_batch(int which_slave,
+        const spi_config_t& config,
+        const std::vector<uint32_t>& data,
+        size_t num_bits)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _load_config(which_slave, config, num_bits);
+        for (const uint32_t word : data) {
+            _poke32(_spi_data_addr, word << (32 - num_bits));
+        }
+    }
+
+    void set_divider(const double div)
+    {
+        _div = size_t((div / 2) - 0.5);
+    }
+
+private:
+    //! Writes the divider and control word, unless they're already loaded
+    void _load_config(int which_slave, const spi_config_t& config, size_t num_bits)
+    {
         // load SPI divider
         size_t spi_divider = _div;
         if (config.use_custom_divider) {
@@ -78,27 +111,8 @@ public:
             _poke32(_spi_ctrl_addr, ctrl_word);
             _ctrl_word_cache = ctrl_word;
         }
-
-        // load data word (must be in upper bits)
-        const uint32_t data_out = data << (32 - num_bits);
-
-        // send data word
-        _poke32(_spi_data_addr, data_out);
-
-        // conditional readback
-        if (readback) {
-            return _peek32(_readback_addr);
-        }
-
-        return 0;
     }
 
-    void set_divider(const double div)
-    {
-        _div = size_t((div / 2) - 0.5);
-    }
-
-private:
     poke32_fn_t _poke32;
     peek32_fn_t _peek32;
     const size_t _spi_div_addr;
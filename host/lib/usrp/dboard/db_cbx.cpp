@@ -40,9 +40,7 @@ sbx_xcvr::cbx::~cbx(void)
 void sbx_xcvr::cbx::write_lo_regs(
     dboard_iface::unit_t unit, const std::vector<uint32_t>& regs)
 {
-    for (uint32_t reg : regs) {
-        self_base->get_iface()->write_spi(unit, spi_config_t::EDGE_RISE, reg, 32);
-    }
+    self_base->get_iface()->write_spi_batch(unit, spi_config_t::EDGE_RISE, regs, 32);
 }
 
 
@@ -38,11 +38,14 @@ using namespace uhd::experts;
 class twinrx_rcvr_fe : public rx_dboard_base
 {
 public:
-    twinrx_rcvr_fe(
-        ctor_args_t args, expert_container::sptr expert, twinrx_ctrl::sptr ctrl)
+    twinrx_rcvr_fe(ctor_args_t args,
+        expert_container::sptr expert,
+        twinrx_ctrl::sptr ctrl,
+        twinrx_tune_plan_cache::sptr tune_plans)
         : rx_dboard_base(args)
         , _expert(expert)
         , _ctrl(ctrl)
+        , _tune_plans(tune_plans)
         , _ch_name(dboard_ctor_args_t::cast(args).sd_name)
     {
         //---------------------------------------------------------
@@ -199,6 +202,15 @@ public:
         expert_factory::add_prop_node<std::string>(
             _expert, get_rx_subtree(), "id", prepend_ch("id", _ch_name), "twinrx");
 
+        // Tune plans for frequencies that will be hopped to. Precomputing them
+        // takes the frequency planning out of the time between two retunes.
+        get_rx_subtree()
+            ->create<std::vector<double>>("tune_plan/freqs")
+            .add_coerced_subscriber([this](const std::vector<double>& freqs) {
+                _tune_plans->precompute(
+                    freqs, get_rx_subtree()->access<double>("if_freq/value").get());
+            });
+
         // Readback
         get_rx_subtree()
             ->create<sensor_value_t>("sensors/lo_locked")
@@ -262,6 +274,7 @@ public:
 private:
     expert_container::sptr _expert;
     twinrx_ctrl::sptr _ctrl;
+    twinrx_tune_plan_cache::sptr _tune_plans;
     const std::string _ch_name;
 };
 
@@ -284,7 +297,8 @@ public:
         twinrx_cpld_regmap::sptr cpld_regs = std::make_shared<twinrx_cpld_regmap>();
         cpld_regs->initialize(*gpio_iface, false);
         _ctrl   = twinrx_ctrl::make(_db_iface, gpio_iface, cpld_regs, get_rx_id());
-        _expert = expert_factory::create_container("twinrx_expert");
+        _expert     = expert_factory::create_container("twinrx_expert");
+        _tune_plans = std::make_shared<twinrx_tune_plan_cache>();
     }
 
     virtual ~twinrx_rcvr(void) {}
@@ -299,6 +313,11 @@ public:
         return _ctrl;
     }
 
+    inline twinrx_tune_plan_cache::sptr get_tune_plans()
+    {
+        return _tune_plans;
+    }
+
     virtual void initialize()
     {
         //---------------------------------------------------------
@@ -323,7 +342,7 @@ public:
         // Channel (front-end) specific
         for (const std::string& fe : _fe_names) {
             expert_factory::add_worker_node<twinrx_freq_path_expert>(
-                _expert, _expert->node_retriever(), fe);
+                _expert, _expert->node_retriever(), fe, _tune_plans);
             expert_factory::add_worker_node<twinrx_freq_coercion_expert>(
                 _expert, _expert->node_retriever(), fe);
             expert_factory::add_worker_node<twinrx_chan_gain_expert>(
@@ -363,8 +382,10 @@ public:
         const dboard_ctor_args_t& db_args = dboard_ctor_args_t::cast(args);
         sptr container = std::dynamic_pointer_cast<twinrx_rcvr>(db_args.rx_container);
         if (container) {
-            dboard_base::sptr fe = dboard_base::sptr(
-                new twinrx_rcvr_fe(args, container->get_expert(), container->get_ctrl()));
+            dboard_base::sptr fe = dboard_base::sptr(new twinrx_rcvr_fe(args,
+                container->get_expert(),
+                container->get_ctrl(),
+                container->get_tune_plans()));
             container->add_twinrx_fe(db_args.sd_name);
             return fe;
         } else {
@@ -385,6 +406,7 @@ private:
     twinrx_ctrl::sptr _ctrl;
     std::vector<std::string> _fe_names;
     expert_container::sptr _expert;
+    twinrx_tune_plan_cache::sptr _tune_plans;
 };
 
 /*!
@@ -604,8 +604,8 @@ private:
     {
         boost::mutex::scoped_lock lock(_spi_mutex);
         ROUTE_SPI(_iface, dest);
-        for (uint32_t value : values)
-            WRITE_SPI(_iface, value);
+        _iface->write_spi_batch(
+            dboard_iface::UNIT_TX, spi_config_t::EDGE_RISE, values, 32);
     }
 
     void set_cpld_field(ubx_cpld_field_id_t id, uint32_t value)
@@ -133,6 +133,10 @@ void wbx_base::set_rx_enabled(bool enb)
     this->get_iface()->set_gpio_out(dboard_iface::UNIT_RX,
         (enb) ? RX_POWER_UP : RX_POWER_DOWN,
         RX_POWER_UP | RX_POWER_DOWN);
+    // The LO may have been powered down, so write all of its registers again
+    if (enb and db_actual) {
+        db_actual->_rxlo->invalidate_regs();
+    }
 }
 
 /***********************************************************************
@@ -164,7 +168,5 @@ sensor_value_t wbx_base::get_locked(dboard_iface::unit_t unit)
 void wbx_base::wbx_versionx::write_lo_regs(
     dboard_iface::unit_t unit, const std::vector<uint32_t>& regs)
 {
-    for (uint32_t reg : regs) {
-        self_base->get_iface()->write_spi(unit, spi_config_t::EDGE_RISE, reg, 32);
-    }
+    self_base->get_iface()->write_spi_batch(unit, spi_config_t::EDGE_RISE, regs, 32);
 }
@@ -182,6 +182,10 @@ void wbx_base::wbx_version3::set_tx_enabled(bool enb)
     self_base->get_iface()->set_gpio_out(dboard_iface::UNIT_TX,
         (enb) ? TX_POWER_UP | ADF435X_CE : TX_POWER_DOWN,
         TX_POWER_UP | TX_POWER_DOWN | 0);
+    // The LO may have been powered down, so write all of its registers again
+    if (enb) {
+        _txlo->invalidate_regs();
+    }
 }
 
 
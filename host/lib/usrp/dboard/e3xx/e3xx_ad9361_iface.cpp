@@ -61,6 +61,19 @@ public:
             E3XX_TUNE_TIMEOUT, this->_rpc_prefix + "catalina_tune", which, value);
     }
 
+    std::vector<double> set_hop_set(
+        const std::string& which, const std::vector<double>& freqs)
+    {
+        return _rpcc->request_with_token<std::vector<double>>(
+            this->_rpc_prefix + "set_hop_set", which, freqs);
+    }
+
+    double hop(const std::string& which, const size_t index)
+    {
+        return _rpcc->request_with_token<double>(
+            E3XX_TUNE_TIMEOUT, this->_rpc_prefix + "hop", which, index);
+    }
+
     void set_dc_offset_auto(const std::string& which, const bool on)
     {
         _rpcc->request_with_token<void>(
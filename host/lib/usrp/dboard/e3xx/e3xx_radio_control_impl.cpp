@@ -244,6 +244,50 @@ double e3xx_radio_control_impl::set_rx_frequency(const double freq, const size_t
     return coerced_freq;
 }
 
+std::vector<double> e3xx_radio_control_impl::set_tx_hop_table(
+    const std::vector<double>& freqs, const size_t chan)
+{
+    std::lock_guard<std::mutex> l(_set_lock);
+    std::vector<double> clipped_freqs;
+    for (const double freq : freqs) {
+        clipped_freqs.push_back(uhd::clip(freq, AD9361_TX_MIN_FREQ, AD9361_TX_MAX_FREQ));
+    }
+    return _ad9361->set_hop_set(
+        get_which_ad9361_chain(TX_DIRECTION, chan, _fe_swap), clipped_freqs);
+}
+
+void e3xx_radio_control_impl::tx_hop(const size_t index, const size_t chan)
+{
+    std::lock_guard<std::mutex> l(_set_lock);
+    const double coerced_freq =
+        _ad9361->hop(get_which_ad9361_chain(TX_DIRECTION, chan, _fe_swap), index);
+    radio_control_impl::set_tx_frequency(coerced_freq, chan);
+    // Front-end switching
+    _set_atr_bits(chan);
+}
+
+std::vector<double> e3xx_radio_control_impl::set_rx_hop_table(
+    const std::vector<double>& freqs, const size_t chan)
+{
+    std::lock_guard<std::mutex> l(_set_lock);
+    std::vector<double> clipped_freqs;
+    for (const double freq : freqs) {
+        clipped_freqs.push_back(uhd::clip(freq, AD9361_RX_MIN_FREQ, AD9361_RX_MAX_FREQ));
+    }
+    return _ad9361->set_hop_set(
+        get_which_ad9361_chain(RX_DIRECTION, chan, _fe_swap), clipped_freqs);
+}
+
+void e3xx_radio_control_impl::rx_hop(const size_t index, const size_t chan)
+{
+    std::lock_guard<std::mutex> l(_set_lock);
+    const double coerced_freq =
+        _ad9361->hop(get_which_ad9361_chain(RX_DIRECTION, chan, _fe_swap), index);
+    radio_control_impl::set_rx_frequency(coerced_freq, chan);
+    // Front-end switching
+    _set_atr_bits(chan);
+}
+
 void e3xx_radio_control_impl::set_rx_agc(const bool enb, const size_t chan)
 {
     std::lock_guard<std::mutex> l(_set_lock);
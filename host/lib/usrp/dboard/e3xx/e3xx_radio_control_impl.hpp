@@ -98,6 +98,20 @@ public:
     double set_tx_bandwidth(const double bandwidth, const size_t chan);
     double set_rx_bandwidth(const double bandwidth, const size_t chan);
 
+    /*! Hop tables are AD9361 hop sets
+     *
+     * The AD9361 precomputes the synthesizer settings of every entry, and hops
+     * tune the LO directly, so hops may visit the entries in any order, and
+     * they do update the frequency. The LO and thus the hop set is shared by
+     * both channels of a direction. Hops are not timed.
+     */
+    std::vector<double> set_tx_hop_table(
+        const std::vector<double>& freqs, const size_t chan);
+    void tx_hop(const size_t index, const size_t chan);
+    std::vector<double> set_rx_hop_table(
+        const std::vector<double>& freqs, const size_t chan);
+    void rx_hop(const size_t index, const size_t chan);
+
     // Getters
     std::vector<std::string> get_tx_antennas(const size_t chan) const;
     std::vector<std::string> get_rx_antennas(const size_t chan) const;
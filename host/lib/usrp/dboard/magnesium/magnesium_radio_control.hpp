@@ -22,6 +22,7 @@
 #include <uhdlib/usrp/common/adf435x.hpp>
 #include <uhdlib/usrp/common/mpmd_mb_controller.hpp>
 #include <uhdlib/usrp/cores/gpio_atr_3000.hpp>
+#include <uhdlib/usrp/cores/spi_core_3000.hpp>
 #include <iostream>
 #include <mutex>
 
@@ -292,7 +293,7 @@ private:
     uhd::rpc_client::sptr _rpcc;
 
     //! Reference to the SPI core
-    uhd::spi_iface::sptr _spi;
+    spi_core_3000::sptr _spi;
 
     //! Reference to wb_iface compat adapters (one per channel)
     std::vector<uhd::timed_wb_iface::sptr> _wb_ifaces;
@@ -103,16 +103,12 @@ void magnesium_radio_control_impl::_init_peripherals()
     RFNOC_LOG_TRACE("Initializing TX LO...");
     _tx_lo = adf435x_iface::make_adf4351([this](
                                              const std::vector<uint32_t> transactions) {
-        for (const uint32_t transaction : transactions) {
-            this->_spi->write_spi(SEN_TX_LO, spi_config_t::EDGE_RISE, transaction, 32);
-        }
+        this->_spi->write_spi_batch(SEN_TX_LO, spi_config_t::EDGE_RISE, transactions, 32);
     });
     RFNOC_LOG_TRACE("Initializing RX LO...");
     _rx_lo = adf435x_iface::make_adf4351([this](
                                              const std::vector<uint32_t> transactions) {
-        for (const uint32_t transaction : transactions) {
-            this->_spi->write_spi(SEN_RX_LO, spi_config_t::EDGE_RISE, transaction, 32);
-        }
+        this->_spi->write_spi_batch(SEN_RX_LO, spi_config_t::EDGE_RISE, transactions, 32);
     });
 
     _gpio.clear(); // Following the as-if rule, this can get optimized out
@@ -726,9 +726,7 @@ private: // Functions
 
     void _write_lo_spi(dboard_iface::unit_t unit, const std::vector<uint32_t>& regs)
     {
-        for (uint32_t reg : regs) {
-            _db_iface->write_spi(unit, _spi_config, reg, 32);
-        }
+        _db_iface->write_spi_batch(unit, _spi_config, regs, 32);
     }
 
     void _commit()
@@ -773,8 +771,13 @@ private: // Functions
         if (simultaneous_commit_lo1) {
             _config_lo_route(LO1, BOTH);
             // Only commit one of the channels. The route LO_CONFIG_BOTH
-            // will ensure that the LEs for both channels are enabled
+            // will ensure that the LEs for both channels are enabled. Write all
+            // registers, because the channel 2 synthesizer may hold different
+            // values in the ones that did not change for channel 1.
+            _lo1_iface[size_t(CH1)]->invalidate_regs();
             _lo1_iface[size_t(CH1)]->commit();
+            // The channel 2 synthesizer now holds what channel 1 wrote
+            _lo1_iface[size_t(CH2)]->invalidate_regs();
             _lo1_freq[size_t(CH1)].mark_clean();
             _lo1_freq[size_t(CH2)].mark_clean();
             _lo1_enable[size_t(CH1)].mark_clean();
@@ -805,8 +808,13 @@ private: // Functions
         if (simultaneous_commit_lo2) {
             _config_lo_route(LO2, BOTH);
             // Only commit one of the channels. The route LO_CONFIG_BOTH
-            // will ensure that the LEs for both channels are enabled
+            // will ensure that the LEs for both channels are enabled. Write all
+            // registers, because the channel 2 synthesizer may hold different
+            // values in the ones that did not change for channel 1.
+            _lo2_iface[size_t(CH1)]->invalidate_regs();
             _lo2_iface[size_t(CH1)]->commit();
+            // The channel 2 synthesizer now holds what channel 1 wrote
+            _lo2_iface[size_t(CH2)]->invalidate_regs();
             _lo2_freq[size_t(CH1)].mark_clean();
             _lo2_freq[size_t(CH2)].mark_clean();
             _lo2_enable[size_t(CH1)].mark_clean();
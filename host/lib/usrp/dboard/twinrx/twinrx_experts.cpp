@@ -31,10 +31,35 @@ void twinrx_scheduling_expert::resolve()
 }
 
 /*!---------------------------------------------------------
- * twinrx_freq_path_expert::resolve
+ * twinrx_tune_plan_cache
  * ---------------------------------------------------------
  */
-void twinrx_freq_path_expert::resolve()
+twinrx_tune_plan_t twinrx_tune_plan_cache::get(double rf_freq, double if_freq)
+{
+    // Don't let long sweeps grow the cache without bounds
+    static const size_t MAX_CACHED_PLANS = 4096;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto key = std::make_pair(rf_freq, if_freq);
+    const auto it  = _plans.find(key);
+    if (it != _plans.end()) {
+        return it->second;
+    }
+    if (_plans.size() >= MAX_CACHED_PLANS) {
+        _plans.clear();
+    }
+    return _plans[key] = _compute(rf_freq, if_freq);
+}
+
+void twinrx_tune_plan_cache::precompute(
+    const std::vector<double>& rf_freqs, double if_freq)
+{
+    for (const double rf_freq : rf_freqs) {
+        get(rf_freq, if_freq);
+    }
+}
+
+twinrx_tune_plan_t twinrx_tune_plan_cache::_compute(double rf_freq_d, double if_freq_d)
 {
     // Lowband/highband switch point
     static const double LB_HB_THRESHOLD_FREQ    = 1.8e9;
@@ -57,67 +82,99 @@ void twinrx_freq_path_expert::resolve()
     static const double LB_PREAMP_PRESEL_THRESHOLD_FREQ = 0.8e9;
 
     // Misc
-    static const double INST_BANDWIDTH           = 80e6;
-    static const double MANUAL_LO_HYSTERESIS_PPM = 1.0;
+    static const double INST_BANDWIDTH = 80e6;
 
     static const freq_range_t FREQ_RANGE(10e6, 6e9);
-    rf_freq_abs_t rf_freq(FREQ_RANGE.clip(_rf_freq_d));
+    rf_freq_abs_t rf_freq(FREQ_RANGE.clip(rf_freq_d));
+
+    twinrx_tune_plan_t plan;
+    plan.lb_presel = twinrx_ctrl::PRESEL_PATH1;
+    plan.hb_presel = twinrx_ctrl::PRESEL_PATH1;
 
     // Choose low-band vs high-band depending on frequency
-    _signal_path = (rf_freq > LB_HB_THRESHOLD_FREQ) ? twinrx_ctrl::PATH_HIGHBAND
-                                                    : twinrx_ctrl::PATH_LOWBAND;
-    if (_signal_path == twinrx_ctrl::PATH_LOWBAND) {
+    plan.signal_path = (rf_freq > LB_HB_THRESHOLD_FREQ) ? twinrx_ctrl::PATH_HIGHBAND
+                                                        : twinrx_ctrl::PATH_LOWBAND;
+    if (plan.signal_path == twinrx_ctrl::PATH_LOWBAND) {
         // Choose low-band preselector filter
         if (rf_freq < LB_FILT1_THRESHOLD_FREQ) {
-            _lb_presel = twinrx_ctrl::PRESEL_PATH1;
+            plan.lb_presel = twinrx_ctrl::PRESEL_PATH1;
         } else if (rf_freq < LB_FILT2_THRESHOLD_FREQ) {
-            _lb_presel = twinrx_ctrl::PRESEL_PATH2;
+            plan.lb_presel = twinrx_ctrl::PRESEL_PATH2;
         } else if (rf_freq < LB_FILT3_THRESHOLD_FREQ) {
-            _lb_presel = twinrx_ctrl::PRESEL_PATH3;
+            plan.lb_presel = twinrx_ctrl::PRESEL_PATH3;
         } else if (rf_freq < LB_FILT4_THRESHOLD_FREQ) {
-            _lb_presel = twinrx_ctrl::PRESEL_PATH4;
+            plan.lb_presel = twinrx_ctrl::PRESEL_PATH4;
         } else {
-            _lb_presel = twinrx_ctrl::PRESEL_PATH4;
+            plan.lb_presel = twinrx_ctrl::PRESEL_PATH4;
         }
-    } else if (_signal_path == twinrx_ctrl::PATH_HIGHBAND) {
+    } else if (plan.signal_path == twinrx_ctrl::PATH_HIGHBAND) {
         // Choose high-band preselector filter
         if (rf_freq < HB_FILT1_THRESHOLD_FREQ) {
-            _hb_presel = twinrx_ctrl::PRESEL_PATH1;
+            plan.hb_presel = twinrx_ctrl::PRESEL_PATH1;
         } else if (rf_freq < HB_FILT2_THRESHOLD_FREQ) {
-            _hb_presel = twinrx_ctrl::PRESEL_PATH2;
+            plan.hb_presel = twinrx_ctrl::PRESEL_PATH2;
         } else if (rf_freq < HB_FILT3_THRESHOLD_FREQ) {
-            _hb_presel = twinrx_ctrl::PRESEL_PATH3;
+            plan.hb_presel = twinrx_ctrl::PRESEL_PATH3;
         } else if (rf_freq < HB_FILT4_THRESHOLD_FREQ) {
-            _hb_presel = twinrx_ctrl::PRESEL_PATH4;
+            plan.hb_presel = twinrx_ctrl::PRESEL_PATH4;
         } else {
-            _hb_presel = twinrx_ctrl::PRESEL_PATH4;
+            plan.hb_presel = twinrx_ctrl::PRESEL_PATH4;
         }
     } else {
         UHD_THROW_INVALID_CODE_PATH();
     }
 
     // Choose low-band preamp preselector
-    _lb_preamp_presel = (rf_freq > LB_PREAMP_PRESEL_THRESHOLD_FREQ);
+    plan.lb_preamp_presel = (rf_freq > LB_PREAMP_PRESEL_THRESHOLD_FREQ);
 
     // Choose LO frequencies
-    const double target_if1_freq = (_signal_path == twinrx_ctrl::PATH_HIGHBAND)
+    plan.target_if1_freq         = (plan.signal_path == twinrx_ctrl::PATH_HIGHBAND)
                                        ? HB_TARGET_IF1_FREQ
                                        : LB_TARGET_IF1_FREQ;
-    const double target_if2_freq = _if_freq_d;
+    const double target_if2_freq = if_freq_d;
 
     // LO1
-    double lo1_freq_ideal = 0.0, lo2_freq_ideal = 0.0;
     if (rf_freq <= FIXED_LO1_THRESHOLD_FREQ) {
         // LO1 Freq static
-        lo1_freq_ideal = target_if1_freq + FIXED_LO1_THRESHOLD_FREQ;
+        plan.lo1_freq = plan.target_if1_freq + FIXED_LO1_THRESHOLD_FREQ;
     } else if (rf_freq <= INJ_SIDE_THRESHOLD_FREQ) {
         // High-side LO1 Injection
-        lo1_freq_ideal = rf_freq.get() + target_if1_freq;
+        plan.lo1_freq = rf_freq.get() + plan.target_if1_freq;
     } else {
         // Low-side LO1 Injection
-        lo1_freq_ideal = rf_freq.get() - target_if1_freq;
+        plan.lo1_freq = rf_freq.get() - plan.target_if1_freq;
+    }
+
+    // LO2
+    lo_inj_side_t lo2_inj_side_ideal = _compute_lo2_inj_side(
+        plan.lo1_freq, plan.target_if1_freq, target_if2_freq, INST_BANDWIDTH);
+    if (lo2_inj_side_ideal == INJ_HIGH_SIDE) {
+        plan.lo2_freq = plan.target_if1_freq + target_if2_freq;
+    } else {
+        plan.lo2_freq = plan.target_if1_freq - target_if2_freq;
     }
+    return plan;
+}
 
+/*!---------------------------------------------------------
+ * twinrx_freq_path_expert::resolve
+ * ---------------------------------------------------------
+ */
+void twinrx_freq_path_expert::resolve()
+{
+    static const double MANUAL_LO_HYSTERESIS_PPM = 1.0;
+
+    const twinrx_tune_plan_t plan = _tune_plans->get(_rf_freq_d, _if_freq_d);
+
+    _signal_path = plan.signal_path;
+    if (plan.signal_path == twinrx_ctrl::PATH_LOWBAND) {
+        _lb_presel = plan.lb_presel;
+    } else {
+        _hb_presel = plan.hb_presel;
+    }
+    _lb_preamp_presel = plan.lb_preamp_presel;
+
+    // LO1
     if (_lo1_freq_d.get_author() == experts::AUTHOR_USER) {
         if (_lo1_freq_d.is_dirty()) { // Are we here because the LO frequency was set?
             // The user explicitly requested to set the LO freq so don't touch it!
@@ -125,25 +182,17 @@ void twinrx_freq_path_expert::resolve()
             // Something else changed which may cause the LO frequency to update.
             // Only commit if the frequency is stale. If the user's value is stale
             // reset the author to expert.
-            if (rf_freq_ppm_t(lo1_freq_ideal, MANUAL_LO_HYSTERESIS_PPM)
+            if (rf_freq_ppm_t(plan.lo1_freq, MANUAL_LO_HYSTERESIS_PPM)
                 != _lo1_freq_d.get()) {
-                _lo1_freq_d = lo1_freq_ideal; // Reset author
+                _lo1_freq_d = plan.lo1_freq; // Reset author
             }
         }
     } else {
         // The LO frequency was never set by the user. Let the expert take care of it
-        _lo1_freq_d = lo1_freq_ideal; // Reset author
+        _lo1_freq_d = plan.lo1_freq; // Reset author
     }
 
     // LO2
-    lo_inj_side_t lo2_inj_side_ideal = _compute_lo2_inj_side(
-        lo1_freq_ideal, target_if1_freq, target_if2_freq, INST_BANDWIDTH);
-    if (lo2_inj_side_ideal == INJ_HIGH_SIDE) {
-        lo2_freq_ideal = target_if1_freq + target_if2_freq;
-    } else {
-        lo2_freq_ideal = target_if1_freq - target_if2_freq;
-    }
-
     if (_lo2_freq_d.get_author() == experts::AUTHOR_USER) {
         if (_lo2_freq_d.is_dirty()) { // Are we here because the LO frequency was set?
             // The user explicitly requested to set the LO freq so don't touch it!
@@ -151,22 +200,24 @@ void twinrx_freq_path_expert::resolve()
             // Something else changed which may cause the LO frequency to update.
             // Only commit if the frequency is stale. If the user's value is stale
             // reset the author to expert.
-            if (rf_freq_ppm_t(lo2_freq_ideal, MANUAL_LO_HYSTERESIS_PPM)
+            if (rf_freq_ppm_t(plan.lo2_freq, MANUAL_LO_HYSTERESIS_PPM)
                 != _lo2_freq_d.get()) {
-                _lo2_freq_d = lo2_freq_ideal; // Reset author
+                _lo2_freq_d = plan.lo2_freq; // Reset author
             }
         }
     } else {
         // The LO frequency was never set by the user. Let the expert take care of it
-        _lo2_freq_d = lo2_freq_ideal; // Reset author
+        _lo2_freq_d = plan.lo2_freq; // Reset author
     }
 
     // Determine injection side using the final LO frequency
-    _lo1_inj_side = (_lo1_freq_d > rf_freq.get()) ? INJ_HIGH_SIDE : INJ_LOW_SIDE;
-    _lo2_inj_side = (_lo2_freq_d > target_if1_freq) ? INJ_HIGH_SIDE : INJ_LOW_SIDE;
+    static const freq_range_t FREQ_RANGE(10e6, 6e9);
+    const double rf_freq = FREQ_RANGE.clip(_rf_freq_d);
+    _lo1_inj_side        = (_lo1_freq_d > rf_freq) ? INJ_HIGH_SIDE : INJ_LOW_SIDE;
+    _lo2_inj_side = (_lo2_freq_d > plan.target_if1_freq) ? INJ_HIGH_SIDE : INJ_LOW_SIDE;
 }
 
-lo_inj_side_t twinrx_freq_path_expert::_compute_lo2_inj_side(
+lo_inj_side_t twinrx_tune_plan_cache::_compute_lo2_inj_side(
     double lo1_freq, double if1_freq, double if2_freq, double bandwidth)
 {
     static const int MAX_SPUR_ORDER = 5;
@@ -186,7 +237,7 @@ lo_inj_side_t twinrx_freq_path_expert::_compute_lo2_inj_side(
     return INJ_HIGH_SIDE;
 }
 
-bool twinrx_freq_path_expert::_has_mixer_spurs(
+bool twinrx_tune_plan_cache::_has_mixer_spurs(
     double lo1_freq, double lo2_freq, double if2_freq, double bandwidth, int spur_order)
 {
     // Iterate through all N-th order harmomic combinations
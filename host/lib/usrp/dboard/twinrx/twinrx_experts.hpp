@@ -11,6 +11,11 @@
 #include "twinrx_ctrl.hpp"
 #include <uhd/utils/math.hpp>
 #include <uhdlib/experts/expert_nodes.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 namespace uhd { namespace usrp { namespace dboard { namespace twinrx {
 
@@ -53,6 +58,61 @@ static const std::string lo_stage_str(lo_stage_t stage, bool lower = false)
     return prefix + ((stage == STAGE_LO1) ? "1" : "2");
 }
 
+/*!---------------------------------------------------------
+ * twinrx_tune_plan_t
+ *
+ * The frequency dependent settings of a channel: The band,
+ * preselector paths and the ideal LO frequencies. They only
+ * depend on the RF and IF frequency, so they can be worked
+ * out ahead of time, e.g., for all frequencies of a hop
+ * sequence.
+ * ---------------------------------------------------------
+ */
+struct twinrx_tune_plan_t
+{
+    twinrx_ctrl::signal_path_t signal_path;
+    twinrx_ctrl::preselector_path_t lb_presel;
+    twinrx_ctrl::preselector_path_t hb_presel;
+    bool lb_preamp_presel;
+    double target_if1_freq;
+    double lo1_freq;
+    double lo2_freq;
+};
+
+/*!---------------------------------------------------------
+ * twinrx_tune_plan_cache
+ *
+ * Stores the tune plans of the frequencies that were used
+ * or precomputed, so that tuning back to one of them skips
+ * the band and mixer spur search. One instance is shared
+ * by both channels of a TwinRX.
+ * ---------------------------------------------------------
+ */
+class twinrx_tune_plan_cache
+{
+public:
+    typedef std::shared_ptr<twinrx_tune_plan_cache> sptr;
+
+    //! Return the plan for these frequencies, computing it if it's not cached
+    twinrx_tune_plan_t get(double rf_freq, double if_freq);
+
+    //! Compute and cache the plans for all of \p rf_freqs at one IF frequency
+    void precompute(const std::vector<double>& rf_freqs, double if_freq);
+
+private:
+    static twinrx_tune_plan_t _compute(double rf_freq, double if_freq);
+    static lo_inj_side_t _compute_lo2_inj_side(
+        double lo1_freq, double if1_freq, double if2_freq, double bandwidth);
+    static bool _has_mixer_spurs(double lo1_freq,
+        double lo2_freq,
+        double if2_freq,
+        double bandwidth,
+        int spur_order);
+
+    std::mutex _mutex;
+    std::map<std::pair<double, double>, twinrx_tune_plan_t> _plans;
+};
+
 
 /*!---------------------------------------------------------
  * twinrx_scheduling_expert
@@ -100,8 +160,11 @@ private:
 class twinrx_freq_path_expert : public experts::worker_node_t
 {
 public:
-    twinrx_freq_path_expert(const experts::node_retriever_t& db, std::string ch)
+    twinrx_freq_path_expert(const experts::node_retriever_t& db,
+        std::string ch,
+        twinrx_tune_plan_cache::sptr tune_plans)
         : experts::worker_node_t(prepend_ch("twinrx_freq_path_expert", ch))
+        , _tune_plans(tune_plans)
         , _rf_freq_d(db, prepend_ch("freq/desired", ch))
         , _if_freq_d(db, prepend_ch("if_freq/desired", ch))
         , _signal_path(db, prepend_ch("ch/signal_path", ch))
@@ -127,14 +190,8 @@ public:
 
 private:
     virtual void resolve();
-    static lo_inj_side_t _compute_lo2_inj_side(
-        double lo1_freq, double if1_freq, double if2_freq, double bandwidth);
-    static bool _has_mixer_spurs(double lo1_freq,
-        double lo2_freq,
-        double if2_freq,
-        double bandwidth,
-        int spur_order);
 
+    twinrx_tune_plan_cache::sptr _tune_plans;
     // Inputs
     experts::data_reader_t<double> _rf_freq_d;
     experts::data_reader_t<double> _if_freq_d;
@@ -9,6 +9,7 @@
 #include <uhd/types/byte_vector.hpp>
 #include <uhd/usrp/dboard_eeprom.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhdlib/usrp/common/eeprom_cache.hpp>
 #include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
 #include <algorithm>
@@ -62,44 +63,57 @@ static uint8_t checksum(const byte_vector_t& bytes)
     return uint8_t(sum);
 }
 
-dboard_eeprom_t::dboard_eeprom_t(void)
-{
-    id     = dboard_id_t::none();
-    serial = "";
-}
-
-void dboard_eeprom_t::load(i2c_iface& iface, uint8_t addr)
+//! Parse the common portion of the EEPROM, returns false if it's not valid
+static bool parse(dboard_eeprom_t& eeprom, const byte_vector_t& bytes)
 {
-    byte_vector_t bytes = iface.read_eeprom(addr, 0, DB_EEPROM_CLEN);
-
-    std::ostringstream ss;
-
     try {
         UHD_ASSERT_THROW(bytes.size() >= DB_EEPROM_CLEN);
         UHD_ASSERT_THROW(bytes[DB_EEPROM_MAGIC] == DB_EEPROM_MAGIC_VALUE);
         UHD_ASSERT_THROW(bytes[DB_EEPROM_CHKSUM] == checksum(bytes));
 
         // parse the ids
-        id = dboard_id_t::from_uint16(0 | (uint16_t(bytes[DB_EEPROM_ID_LSB]) << 0)
-                                      | (uint16_t(bytes[DB_EEPROM_ID_MSB]) << 8));
+        eeprom.id =
+            dboard_id_t::from_uint16(0 | (uint16_t(bytes[DB_EEPROM_ID_LSB]) << 0)
+                                     | (uint16_t(bytes[DB_EEPROM_ID_MSB]) << 8));
 
         // parse the serial
-        serial = bytes_to_string(byte_vector_t(&bytes.at(DB_EEPROM_SERIAL),
+        eeprom.serial = bytes_to_string(byte_vector_t(&bytes.at(DB_EEPROM_SERIAL),
             &bytes.at(DB_EEPROM_SERIAL + DB_EEPROM_SERIAL_LEN)));
 
         // parse the revision
         const uint16_t rev_num = 0 | (uint16_t(bytes[DB_EEPROM_REV_LSB]) << 0)
                                  | (uint16_t(bytes[DB_EEPROM_REV_MSB]) << 8);
         if (rev_num != 0 and rev_num != 0xffff) {
-            revision = std::to_string(rev_num);
+            eeprom.revision = std::to_string(rev_num);
         }
+        return true;
 
     } catch (const uhd::assertion_error&) {
-        id     = dboard_id_t::none();
-        serial = "";
+        eeprom.id     = dboard_id_t::none();
+        eeprom.serial = "";
+        return false;
     }
 }
 
+//! The bytes that identify the contents of the EEPROM: the serial and the checksum
+static byte_vector_t get_stamp(const byte_vector_t& serial, const uint8_t chksum)
+{
+    byte_vector_t stamp = serial;
+    stamp.push_back(chksum);
+    return stamp;
+}
+
+dboard_eeprom_t::dboard_eeprom_t(void)
+{
+    id     = dboard_id_t::none();
+    serial = "";
+}
+
+void dboard_eeprom_t::load(i2c_iface& iface, uint8_t addr)
+{
+    parse(*this, iface.read_eeprom(addr, 0, DB_EEPROM_CLEN));
+}
+
 void dboard_eeprom_t::store(i2c_iface& iface, uint8_t addr) const
 {
     byte_vector_t bytes(DB_EEPROM_CLEN, 0); // defaults to all zeros
@@ -125,3 +139,36 @@ void dboard_eeprom_t::store(i2c_iface& iface, uint8_t addr) const
 
     iface.write_eeprom(addr, 0, bytes);
 }
+
+void uhd::usrp::eeprom_cache::load_dboard_eeprom(
+    dboard_eeprom_t& eeprom, i2c_iface& iface, const uint8_t addr, const std::string& key)
+{
+    // Empty slots don't answer, or don't have the magic byte. Either way, there's
+    // no need to read more than that.
+    const byte_vector_t magic = iface.read_eeprom(addr, DB_EEPROM_MAGIC, 1);
+    if (magic.empty() or magic[0] != DB_EEPROM_MAGIC_VALUE) {
+        eeprom = dboard_eeprom_t();
+        return;
+    }
+
+    const byte_vector_t chksum = iface.read_eeprom(addr, DB_EEPROM_CHKSUM, 1);
+    const byte_vector_t serial =
+        iface.read_eeprom(addr, DB_EEPROM_SERIAL, DB_EEPROM_SERIAL_LEN);
+    if (chksum.size() == 1 and serial.size() == DB_EEPROM_SERIAL_LEN) {
+        const auto cached = get(key, get_stamp(serial, chksum[0]));
+        if (cached and parse(eeprom, *cached)) {
+            return;
+        }
+    }
+
+    const byte_vector_t bytes = iface.read_eeprom(addr, 0, DB_EEPROM_CLEN);
+    if (parse(eeprom, bytes)) {
+        // Stamp the entry with what was read along with the contents, in case the
+        // EEPROM changed in between
+        put(key,
+            get_stamp(byte_vector_t(&bytes.at(DB_EEPROM_SERIAL),
+                          &bytes.at(DB_EEPROM_SERIAL + DB_EEPROM_SERIAL_LEN)),
+                bytes[DB_EEPROM_CHKSUM]),
+            bytes);
+    }
+}
@@ -21,3 +21,13 @@ void dboard_iface::sleep(const boost::chrono::nanoseconds& time)
         std::this_thread::sleep_for(std::chrono::microseconds(time.count()));
     }
 }
+
+void dboard_iface::write_spi_batch(unit_t unit,
+    const spi_config_t& config,
+    const std::vector<uint32_t>& data,
+    size_t num_bits)
+{
+    for (const uint32_t word : data) {
+        write_spi(unit, config, word, num_bits);
+    }
+}
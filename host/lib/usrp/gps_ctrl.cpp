@@ -16,6 +16,7 @@
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
 #include <boost/tokenizer.hpp>
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <regex>
@@ -34,6 +35,8 @@ constexpr int GPS_SERVO_FRESHNESS       = 1000;
 constexpr int GPS_LOCK_FRESHNESS        = 2500;
 constexpr int GPS_TIMEOUT_DELAY_MS      = 200;
 constexpr int GPSDO_COMMAND_DELAY_MS    = 200;
+//! The longest time to hold the cache while waiting for the UART
+constexpr int GPS_CACHE_WAIT_MS = 100;
 } // namespace
 
 /*!
@@ -61,6 +64,7 @@ private:
         boost::system_time now       = boost::get_system_time();
         boost::system_time exit_time = now + milliseconds(timeout);
         boost::posix_time::time_duration age;
+        bool wait_for_uart = false;
 
         if (wait_for_next) {
             boost::lock_guard<boost::mutex> lock(cache_mutex);
@@ -73,8 +77,14 @@ private:
             try {
                 boost::lock_guard<boost::mutex> lock(cache_mutex);
 
-                // update cache if older than a millisecond
-                if (now - _last_cache_update > milliseconds(1)) {
+                // update cache if older than a millisecond. After the first
+                // pass, only new messages can help, so wait for the UART to
+                // deliver them instead of polling it.
+                if (wait_for_uart) {
+                    const int remaining_ms =
+                        std::max<int64_t>(0, (exit_time - now).total_milliseconds());
+                    update_cache(std::min(remaining_ms, GPS_CACHE_WAIT_MS) / 1000.);
+                } else if (now - _last_cache_update > milliseconds(1)) {
                     update_cache();
                 }
 
@@ -96,8 +106,8 @@ private:
                 break;
             }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-            now = boost::get_system_time();
+            wait_for_uart = true;
+            now           = boost::get_system_time();
         }
 
         if (sentence.empty()) {
@@ -128,7 +138,11 @@ private:
         return (string_crc == calculated_crc);
     }
 
-    void update_cache()
+    /*! Read all GPSDO messages that are available into the cache
+     *
+     * \param timeout the time in seconds to wait for the first message
+     */
+    void update_cache(const double timeout = 0)
     {
         if (not gps_detected()) {
             return;
@@ -141,7 +155,7 @@ private:
 
         // Get all GPSDO messages available
         // Creating a map here because we only want the latest of each message type
-        for (std::string msg = _recv(0); not msg.empty(); msg = _recv(0)) {
+        for (std::string msg = _recv(timeout); not msg.empty(); msg = _recv(0)) {
             // Strip any end of line characters
             erase_all(msg, "\r");
             erase_all(msg, "\n");
@@ -12,10 +12,12 @@
 #include <uhd/transport/if_addrs.hpp>
 #include <uhd/transport/udp_simple.hpp>
 #include <uhd/types/device_addr.hpp>
+#include <uhdlib/usrp/common/discovery_cache.hpp>
 #include <uhdlib/utils/prefs.hpp>
 #include <uhdlib/utils/serial_number.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/asio.hpp>
+#include <atomic>
 #include <future>
 #ifdef HAVE_DPDK
 #    include <uhdlib/transport/dpdk/common.hpp>
@@ -27,6 +29,8 @@ using namespace uhd::mpmd;
 namespace {
 //! How long we wait for discovery responses (in seconds)
 constexpr double MPMD_FIND_TIMEOUT               = 0.5;
+//! How often an ongoing discovery checks if it can stop early (in seconds)
+constexpr double MPMD_FIND_POLL_INTERVAL         = 0.05;
 constexpr char MPMD_CHDR_REACHABILITY_KEY[]      = "reachable";
 constexpr char MPMD_CHDR_REACHABILITY_NEGATIVE[] = "No";
 //! The preamble for any response on the discovery port. Can be used to
@@ -39,10 +43,33 @@ device_addr_t flag_dev_as_unreachable(const device_addr_t& device_args)
     flagged_device_args[MPMD_CHDR_REACHABILITY_KEY] = MPMD_CHDR_REACHABILITY_NEGATIVE;
     return flagged_device_args;
 }
+
+//! Returns true if \p addr is the broadcast address of any interface
+bool is_bcast_addr(const std::string& addr)
+{
+    if (addr == boost::asio::ip::address_v4::broadcast().to_string()) {
+        return true;
+    }
+    for (const auto& if_addr : transport::get_if_addrs()) {
+        if (if_addr.bcast == addr) {
+            return true;
+        }
+    }
+    return false;
+}
 } // namespace
 
-device_addrs_t mpmd_find_with_addr(
-    const std::string& mgmt_addr, const device_addr_t& hint_)
+/*! Find MPM devices that respond to a discovery request sent to \p mgmt_addr
+ *
+ * The discovery waits until no device has responded for MPMD_FIND_TIMEOUT.
+ * It stops early when \p done is set, and sets \p done itself after the first
+ * match if \p stop_on_match is true. This lets concurrent discoveries stop as
+ * soon as the one device they're looking for has responded.
+ */
+device_addrs_t mpmd_find_with_addr(const std::string& mgmt_addr,
+    const device_addr_t& hint_,
+    const bool stop_on_match,
+    std::atomic<bool>& done)
 {
     UHD_ASSERT_THROW(not mgmt_addr.empty());
     const std::string mpm_discovery_port = hint_.get(
@@ -54,14 +81,20 @@ device_addrs_t mpmd_find_with_addr(
         transport::udp_simple::make_broadcast(mgmt_addr, mpm_discovery_port);
     comm->send(boost::asio::buffer(
         mpmd_impl::MPM_DISCOVERY_CMD.c_str(), mpmd_impl::MPM_DISCOVERY_CMD.size()));
-    while (true) {
+    double idle_time = 0.0;
+    while (not done) {
         const size_t MAX_MTU = 8000;
         char buff[MAX_MTU]   = {};
         const size_t nbytes =
-            comm->recv(boost::asio::buffer(buff, MAX_MTU), MPMD_FIND_TIMEOUT);
+            comm->recv(boost::asio::buffer(buff, MAX_MTU), MPMD_FIND_POLL_INTERVAL);
         if (nbytes == 0) {
-            break;
+            idle_time += MPMD_FIND_POLL_INTERVAL;
+            if (idle_time >= MPMD_FIND_TIMEOUT) {
+                break;
+            }
+            continue;
         }
+        idle_time = 0.0;
         const char* reply        = (const char*)buff;
         std::string reply_string = std::string(reply);
         std::vector<std::string> result;
@@ -123,6 +156,10 @@ device_addrs_t mpmd_find_with_addr(
             UHD_LOG_TRACE(
                 "MPMD FIND", "Found device that matches hints: " << new_addr.to_string());
             addrs.push_back(new_addr);
+            if (stop_on_match) {
+                UHD_LOG_TRACE("MPMD FIND", "Found the requested device, stopping.");
+                done = true;
+            }
         } else {
             UHD_LOG_DEBUG(
                 "MPMD FIND", "Found device, but does not match hint: " << recv_addr);
@@ -145,7 +182,12 @@ device_addrs_t mpmd_find_with_addrs(const device_addrs_t& hints)
         }
         const std::string mgmt_addr =
             hint.get(MGMT_ADDR_KEY, hint.get(xport::FIRST_ADDR_KEY, ""));
-        device_addrs_t reply_addrs = mpmd_find_with_addr(mgmt_addr, hint);
+        // A unicast address names a single device, so we can stop after its
+        // response. For a broadcast address, we need to see all responses to
+        // tell if the hint is ambiguous.
+        std::atomic<bool> done{false};
+        device_addrs_t reply_addrs =
+            mpmd_find_with_addr(mgmt_addr, hint, not is_bcast_addr(mgmt_addr), done);
         if (reply_addrs.size() > 1) {
             UHD_LOG_ERROR("MPMD",
                 "Could not resolve device hint \"" << hint.to_string()
@@ -171,10 +213,16 @@ device_addrs_t mpmd_find_with_bcast(const device_addr_t& hint)
     device_addrs_t addrs;
     UHD_LOG_TRACE(
         "MPMD FIND", "Broadcasting on all available interfaces to find MPM devices.");
+    // If the hint names a device by its serial, all tasks can stop as soon as
+    // that device has responded on any interface
+    const bool stop_on_match = hint.has_key("serial");
+    std::atomic<bool> done{false};
     std::vector<std::future<device_addrs_t>> task_list;
     for (const auto& if_addr : transport::get_if_addrs()) {
-        task_list.emplace_back(std::async(std::launch::async,
-            [if_addr, hint]() { return mpmd_find_with_addr(if_addr.bcast, hint); }));
+        task_list.emplace_back(
+            std::async(std::launch::async, [if_addr, hint, stop_on_match, &done]() {
+                return mpmd_find_with_addr(if_addr.bcast, hint, stop_on_match, done);
+            }));
     }
     for (auto& task : task_list) {
         auto reply_addrs = task.get();
@@ -198,6 +246,9 @@ device_addrs_t mpmd_find_with_bcast(const device_addr_t& hint)
  * In this case, we do a broadcast ping to see if any devices respond. After
  * that, we do the same matching.
  *
+ * In both cases, the discovery returns as soon as the device is found if the
+ * hint names a unique device (by its serial, or a unicast address). The
+ * discovery results are kept in the discovery_cache for a short time.
  */
 device_addrs_t mpmd_find(const device_addr_t& hint_)
 {
@@ -239,14 +290,20 @@ device_addrs_t mpmd_find(const device_addr_t& hint_)
         // Note: We don't try and connect to the devices in this mode, because
         // we only get here if the user specified addresses, and we assume she
         // knows what she's doing.
-        return mpmd_find_with_addrs(hints);
+        return usrp::discovery_cache::get().find(
+            "mpmd", hint_, [hints](const device_addr_t&) {
+                return mpmd_find_with_addrs(hints);
+            });
     }
 
     // Scenario 2): User gave us no address, and we need to broadcast
     if (hints.empty()) {
         hints.resize(1);
     }
-    const auto bcast_mpm_devs = mpmd_find_with_bcast(hints[0]);
+    // Only the broadcast results are cached, the reachability of the devices
+    // below is checked every time
+    const auto bcast_mpm_devs =
+        usrp::discovery_cache::get().find("mpmd", hints[0], mpmd_find_with_bcast);
     UHD_LOG_TRACE(
         "MPMD FIND", "Found " << bcast_mpm_devs.size() << " device via broadcast.");
     const bool find_all = hint_.has_key(mpmd_impl::MPM_FINDALL_KEY);
@@ -18,6 +18,9 @@
 #include <boost/filesystem/convenience.hpp>
 #include <fstream>
 #include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <streambuf>
 #include <string>
@@ -26,37 +29,57 @@ using namespace uhd;
 
 namespace uhd { namespace /*anon*/ {
 const size_t MD5LEN = 32; // Length of a MD5 hash in chars
+//! The number of image files that are kept in memory
+const size_t MAX_CACHED_IMAGE_FILES = 8;
+
+//! The contents of an image file, and its hash
+struct image_file_t
+{
+    std::shared_ptr<const std::vector<uint8_t>> data;
+    // Empty if there is no hash file
+    std::string md5;
+    std::time_t last_write_time;
+    uintmax_t size;
+};
 
 /*
- * Helper function to generate a component_file_t using the input ID and path to file.
+ * Helper function to read an image file and its hash file.
+ *
+ * When several devices are loaded at the same time, they all load the same
+ * files. The files are only read once, and then kept in memory for as long as
+ * they don't change on disk.
  */
-uhd::usrp::component_file_t generate_component(
-    const std::string& id, const std::string& filepath)
+image_file_t read_image_file(const std::string& filepath)
 {
-    uhd::usrp::component_file_t component_file;
-    // Add an ID to the metadata
-    component_file.metadata["id"] = id;
-    UHD_LOG_TRACE(
-        "MPMD IMAGE LOADER", "Component ID added to the component dictionary: " << id);
-    // Add the filename to the metadata
-    // Remove the path to the filename
-    component_file.metadata["filename"] =
-        boost::filesystem::path(filepath).filename().string();
-    UHD_LOG_TRACE("MPMD IMAGE LOADER",
-        "Component filename added to the component dictionary: " << filepath);
-    // Add the hash, if a hash file exists
+    static std::mutex cache_mutex;
+    static std::map<std::string, image_file_t> cache;
+
+    if (not boost::filesystem::exists(filepath)) {
+        const std::string err_msg("Component file does not exist: " + filepath);
+        throw uhd::runtime_error(err_msg);
+    }
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    const std::time_t last_write_time = boost::filesystem::last_write_time(filepath);
+    const uintmax_t size              = boost::filesystem::file_size(filepath);
+    const auto cached                 = cache.find(filepath);
+    if (cached != cache.end() && cached->second.last_write_time == last_write_time
+        && cached->second.size == size) {
+        UHD_LOG_TRACE("MPMD IMAGE LOADER", "Using the cached contents of " << filepath);
+        return cached->second;
+    }
+
+    image_file_t image_file;
+    image_file.last_write_time = last_write_time;
+    image_file.size            = size;
+    // Read the hash, if a hash file exists
     const std::string component_hash_filepath = filepath + ".md5";
     std::ifstream component_hash_ifstream(
         component_hash_filepath.c_str(), std::ios::binary);
-    std::string component_hash;
     if (component_hash_ifstream.is_open()) {
         // TODO: Verify that the hash read is valid, ie only contains 0-9a-f.
-        component_hash.resize(MD5LEN);
-        component_hash_ifstream.read(&component_hash[0], MD5LEN);
+        image_file.md5.resize(MD5LEN);
+        component_hash_ifstream.read(&image_file.md5[0], MD5LEN);
         component_hash_ifstream.close();
-        component_file.metadata["md5"] = component_hash;
-        UHD_LOG_TRACE("MPMD IMAGE LOADER",
-            "Added component file hash to the component dictionary.");
     } else {
         // If there is no hash file, don't worry about it too much
         UHD_LOG_DEBUG("MPMD IMAGE LOADER",
@@ -65,10 +88,11 @@ uhd::usrp::component_file_t generate_component(
 
     // Read the component file image into a structure suitable to sent as a binary string
     // to MPM
-    std::vector<uint8_t> data;
+    auto data = std::make_shared<std::vector<uint8_t>>();
     std::ifstream component_ifstream(filepath.c_str(), std::ios::binary);
     if (component_ifstream.is_open()) {
-        data.insert(data.begin(),
+        data->reserve(size);
+        data->insert(data->begin(),
             std::istreambuf_iterator<char>(component_ifstream),
             std::istreambuf_iterator<char>());
         component_ifstream.close();
@@ -76,7 +100,40 @@ uhd::usrp::component_file_t generate_component(
         const std::string err_msg("Component file does not exist: " + filepath);
         throw uhd::runtime_error(err_msg);
     }
-    component_file.data = data;
+    image_file.data = data;
+
+    if (cache.size() >= MAX_CACHED_IMAGE_FILES) {
+        cache.clear();
+    }
+    cache[filepath] = image_file;
+    return image_file;
+}
+
+/*
+ * Helper function to generate a component_file_t using the input ID and path to file.
+ */
+uhd::usrp::component_file_t generate_component(
+    const std::string& id, const std::string& filepath)
+{
+    uhd::usrp::component_file_t component_file;
+    // Add an ID to the metadata
+    component_file.metadata["id"] = id;
+    UHD_LOG_TRACE(
+        "MPMD IMAGE LOADER", "Component ID added to the component dictionary: " << id);
+    // Add the filename to the metadata
+    // Remove the path to the filename
+    component_file.metadata["filename"] =
+        boost::filesystem::path(filepath).filename().string();
+    UHD_LOG_TRACE("MPMD IMAGE LOADER",
+        "Component filename added to the component dictionary: " << filepath);
+    const image_file_t image_file = read_image_file(filepath);
+    // Add the hash, if a hash file exists
+    if (not image_file.md5.empty()) {
+        component_file.metadata["md5"] = image_file.md5;
+        UHD_LOG_TRACE("MPMD IMAGE LOADER",
+            "Added component file hash to the component dictionary.");
+    }
+    component_file.data = *image_file.data;
     return component_file;
 }
 
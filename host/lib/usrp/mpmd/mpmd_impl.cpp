@@ -9,11 +9,14 @@
 #include <uhd/types/component_file.hpp>
 #include <uhd/utils/static.hpp>
 #include <uhd/utils/tasks.hpp>
+#include <uhdlib/utils/init_timeline.hpp>
 #include <uhdlib/utils/prefs.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/thread.hpp>
+#include <atomic>
 #include <chrono>
 #include <future>
+#include <iomanip>
 #include <memory>
 #include <mutex>
 #include <random>
@@ -31,7 +34,7 @@ namespace {
 //! Most pessimistic time for a CHDR query to go to device and back
 const double MPMD_CHDR_MAX_RTT = 0.02;
 //! MPM Compatibility number {MAJOR, MINOR}
-const std::vector<size_t> MPM_COMPAT_NUM = {3, 0};
+const std::vector<size_t> MPM_COMPAT_NUM = {3, 1};
 
 /*************************************************************************
  * Helper functions
@@ -170,15 +173,52 @@ mpmd_impl::mpmd_impl(const device_addr_t& device_args)
     // they need to be correctly indexed.
     for (size_t mb_i = 0; mb_i < num_mboards; ++mb_i) {
         UHD_LOG_DEBUG("MPMD", "Claiming mboard " << mb_i);
+        init_timeline::scoped_span span("claim mboard " + std::to_string(mb_i));
         _mb.push_back(claim_and_make(mb_args[mb_i]));
     }
 
     if (not skip_init) {
-        // Run the actual device initialization. This can run in parallel.
-        for (size_t mb_i = 0; mb_i < num_mboards; ++mb_i) {
+        // Run the actual device initialization. MPM initializes the
+        // daughterboards of a device in parallel, and this is where most of
+        // the time goes (e.g., AD9371 init cals), so the devices are
+        // initialized in parallel, too.
+        std::atomic<size_t> num_initialized{0};
+        const init_timeline::span_id_t parent_span = init_timeline::get_current_span();
+        auto init_mb = [this, &num_initialized, num_mboards, parent_span](
+                           const size_t mb_i) {
+            init_timeline::scoped_span span(
+                "init mboard " + std::to_string(mb_i), parent_span);
+            const auto start_time = std::chrono::steady_clock::now();
             // Note: This is the only place we do compat number checks. They're
             // effectively disabled for skip_init=1
             setup_mb(_mb[mb_i].get(), mb_i);
+            const std::chrono::duration<double> init_time =
+                std::chrono::steady_clock::now() - start_time;
+            UHD_LOG_INFO("MPMD",
+                "Initialized mboard " << mb_i << " (" << ++num_initialized << "/"
+                                      << num_mboards << " done) in " << std::fixed
+                                      << std::setprecision(1) << init_time.count()
+                                      << " s");
+        };
+        if (serialize_init || num_mboards == 1) {
+            for (size_t mb_i = 0; mb_i < num_mboards; ++mb_i) {
+                init_mb(mb_i);
+            }
+        } else {
+            std::vector<std::future<void>> init_futures;
+            for (size_t mb_i = 0; mb_i < num_mboards; ++mb_i) {
+                init_futures.push_back(std::async(std::launch::async, init_mb, mb_i));
+            }
+            // Rethrows the first failure, after all of them are done
+            for (auto& init_future : init_futures) {
+                init_future.wait();
+            }
+            for (auto& init_future : init_futures) {
+                init_future.get();
+            }
+        }
+        for (size_t mb_i = 0; mb_i < num_mboards; ++mb_i) {
+            register_mb_controller(mb_i, _mb[mb_i]->mb_ctrl);
         }
     } else {
         UHD_LOG_DEBUG("MPMD", "Claimed device, but skipped init.");
@@ -191,6 +231,8 @@ mpmd_impl::mpmd_impl(const device_addr_t& device_args)
     // concurrent accesses. Would shave of milliseconds per device -- probably
     // not worth it.
     for (size_t mb_i = 0; mb_i < mb_args.size(); ++mb_i) {
+        init_timeline::scoped_span span(
+            "property tree of mboard " + std::to_string(mb_i));
         init_property_tree(_tree, fs_path("/mboards") / mb_i, _mb[mb_i].get());
     }
 
@@ -237,11 +279,12 @@ void mpmd_impl::setup_mb(mpmd_mboard_impl* mb, const size_t mb_index)
         MPM_COMPAT_NUM,
         mb->rpc->request<std::vector<size_t>>("get_mpm_compat_num"),
         "Please update the version of MPM on your USRP device.");
+    // MPM 3.1 added multi_call()
+    mb->rpc->set_batch_support(true);
 
     UHD_LOG_DEBUG("MPMD", "Initializing mboard " << mb_index);
     mb->init();
     UHD_ASSERT_THROW(mb->mb_ctrl);
-    register_mb_controller(mb_index, mb->mb_ctrl);
 }
 
 /*****************************************************************************
@@ -239,12 +239,12 @@ private:
 
     /*! Initialize a single motherboard
      *
-     * This is where mpmd_mboard_impl::init() is called.
-     * Also assigns the local crossbar addresses.
+     * This is where mpmd_mboard_impl::init() is called. It may run
+     * concurrently for several motherboards, so it doesn't touch any state of
+     * this class; the motherboard controller is registered separately.
      *
      * \param mb Reference to the mboard class
      * \param mb_index Index number of the mboard that's being initialized
-     * \param device_args Device args
      *
      */
     void setup_mb(mpmd_mboard_impl* mb, const size_t mb_index);
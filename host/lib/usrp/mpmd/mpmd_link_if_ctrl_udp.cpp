@@ -13,14 +13,23 @@
 #include <uhd/transport/udp_simple.hpp>
 #include <uhd/transport/udp_zero_copy.hpp>
 #include <uhdlib/rfnoc/rfnoc_common.hpp>
+#include <uhdlib/transport/buffer_pool_alloc.hpp>
 #include <uhdlib/transport/udp_boost_asio_link.hpp>
 #include <uhdlib/transport/udp_common.hpp>
+#include <uhdlib/transport/udp_link_qualification.hpp>
+#include <uhdlib/usrp/common/path_mtu_cache.hpp>
 #include <uhdlib/utils/narrow.hpp>
 #include <string>
 #ifdef HAVE_DPDK
 #    include <uhdlib/transport/dpdk_simple.hpp>
 #    include <uhdlib/transport/udp_dpdk_link.hpp>
 #endif
+#ifdef HAVE_AF_XDP
+#    include <uhdlib/transport/udp_xdp_link.hpp>
+#endif
+#ifdef HAVE_RIO
+#    include <uhdlib/transport/udp_rio_link.hpp>
+#endif
 
 using namespace uhd;
 using namespace uhd::transport;
@@ -41,6 +50,9 @@ const double MPMD_BUFFER_DEPTH = 20.0e-3; // s
 //! For MTU discovery, the time we wait for a packet before calling it
 // oversized (seconds).
 const double MPMD_MTU_DISCOVERY_TIMEOUT = 0.02;
+//! For MTU discovery, how often a frame size is sent before calling it
+// oversized, so a single lost packet doesn't shrink the MTU
+const size_t MPMD_MTU_DISCOVERY_ATTEMPTS = 2;
 
 // TODO: move these to appropriate header file for all other devices
 const size_t MAX_RATE_1GIGE  = 1e9 / 8; // byte/s
@@ -130,6 +142,10 @@ std::vector<std::string> get_addrs_from_mb_args(const uhd::device_addr_t& mb_arg
  * packets and see if they come back until we converged on the path MTU.
  * The end result must lie between \p min_frame_size and \p max_frame_size.
  *
+ * The packets have the don't-fragment bit set in both directions (MPM sets
+ * it on the echoes), so a frame size only passes if it makes it through the
+ * path unfragmented both ways.
+ *
  * \param address IP address
  * \param port UDP port (yeah it's a string!)
  * \param min_frame_size Minimum frame size, initialize algorithm to start
@@ -152,7 +168,7 @@ size_t discover_mtu(const std::string& address,
     using udp_simple_factory_t = std::function<uhd::transport::udp_simple::sptr(
         const std::string&, const std::string&)>;
 
-    udp_simple_factory_t udp_make_broadcast = udp_simple::make_broadcast;
+    udp_simple_factory_t udp_make_broadcast = make_udp_simple_mtu_probe;
     if (use_dpdk) {
 #ifdef HAVE_DPDK
         udp_make_broadcast = [](const std::string& addr, const std::string& port) {
@@ -200,9 +216,19 @@ size_t discover_mtu(const std::string& address,
         std::sprintf(
             &send_buf[echo_prefix_offset], ";%04lu,%04lu", seq_no++, test_frame_size);
         UHD_LOG_TRACE("MPMD", "Testing frame size " << test_frame_size);
-        udp->send(boost::asio::buffer(&send_buf[0], test_frame_size));
-
-        const size_t len = udp->recv(boost::asio::buffer(recv_buf), echo_timeout);
+        size_t len = 0;
+        try {
+            for (size_t attempt = 0; attempt < MPMD_MTU_DISCOVERY_ATTEMPTS && len == 0;
+                 attempt++) {
+                udp->send(boost::asio::buffer(&send_buf[0], test_frame_size));
+                len = udp->recv(boost::asio::buffer(recv_buf), echo_timeout);
+            }
+        } catch (const boost::system::system_error& ex) {
+            // The frame exceeds the MTU of the local interface
+            if (ex.code() != boost::asio::error::message_size) {
+                throw;
+            }
+        }
         if (len == 0) {
             // Nothing received, so this is probably too big
             max_frame_size = test_frame_size - 4;
@@ -223,6 +249,22 @@ size_t discover_mtu(const std::string& address,
     return min_frame_size;
 }
 
+/*! Return the name of the local interface that a device is reached through
+ *
+ * Returns the local address if the interface can't be found, and an empty
+ * string if the device can't be reached.
+ */
+std::string get_local_ifname_to(const std::string& address, const std::string& port)
+{
+    try {
+        const std::string local_addr = get_local_addr_to(address, port);
+        const std::string ifname     = get_ifname_of_addr(local_addr);
+        return ifname.empty() ? local_addr : ifname;
+    } catch (const std::exception&) {
+        return std::string();
+    }
+}
+
 } // namespace
 
 
@@ -241,14 +283,29 @@ mpmd_link_if_ctrl_udp::mpmd_link_if_ctrl_udp(const uhd::device_addr_t& mb_args,
         mb_args.has_key("use_dpdk"); // FIXME use constrained_device_args
     const std::string mpm_discovery_port = _mb_args.get(
         mpmd_impl::MPM_DISCOVERY_PORT_KEY, std::to_string(mpmd_impl::MPM_DISCOVERY_PORT));
-    auto discover_mtu_for_ip = [mpm_discovery_port, use_dpdk](
+    // The path MTU is cached per local interface and device, so making the
+    // same device again doesn't probe it again
+    const double mtu_cache_ttl = _mb_args.cast<double>(
+        uhd::usrp::path_mtu_cache::TTL_KEY, uhd::usrp::path_mtu_cache::DEFAULT_TTL);
+    auto discover_mtu_for_ip = [mpm_discovery_port, use_dpdk, mtu_cache_ttl](
                                    const std::string& ip_addr) {
-        return discover_mtu(ip_addr,
-            mpm_discovery_port,
-            IP_PROTOCOL_MIN_MTU_SIZE - IP_PROTOCOL_UDP_PLUS_IP_HEADER,
-            MPMD_10GE_DATA_FRAME_MAX_SIZE,
-            MPMD_MTU_DISCOVERY_TIMEOUT,
-            use_dpdk);
+        auto probe = [&]() {
+            return discover_mtu(ip_addr,
+                mpm_discovery_port,
+                IP_PROTOCOL_MIN_MTU_SIZE - IP_PROTOCOL_UDP_PLUS_IP_HEADER,
+                MPMD_10GE_DATA_FRAME_MAX_SIZE,
+                MPMD_MTU_DISCOVERY_TIMEOUT,
+                use_dpdk);
+        };
+        const std::string ifname = use_dpdk
+                                       ? std::string("dpdk")
+                                       : get_local_ifname_to(ip_addr, mpm_discovery_port);
+        // Without a local interface, the path can't be told apart from others
+        if (ifname.empty()) {
+            return probe();
+        }
+        return uhd::usrp::path_mtu_cache::get().get_mtu(
+            ifname, ip_addr, probe, mtu_cache_ttl);
     };
 
     const std::vector<std::string> requested_addrs(
@@ -287,6 +344,15 @@ uhd::transport::both_links_t mpmd_link_if_ctrl_udp::get_link(const size_t link_i
 
     const size_t link_rate = get_link_rate(link_idx);
     const bool use_dpdk = _mb_args.has_key("use_dpdk");  // FIXME use constrained device args
+    // AF_XDP sockets are only used for data links, everything else keeps
+    // going through the kernel
+    const bool use_xdp = _mb_args.has_key("use_xdp")
+                         and (link_type == link_type_t::TX_DATA
+                              or link_type == link_type_t::RX_DATA);
+    // Same for Registered I/O sockets on Windows
+    const bool use_rio = _mb_args.has_key("use_rio")
+                         and (link_type == link_type_t::TX_DATA
+                              or link_type == link_type_t::RX_DATA);
     link_params_t default_link_params;
     default_link_params.num_send_frames = MPMD_ETH_NUM_FRAMES;
     default_link_params.num_recv_frames = MPMD_ETH_NUM_FRAMES;
@@ -309,13 +375,25 @@ uhd::transport::both_links_t mpmd_link_if_ctrl_udp::get_link(const size_t link_i
             default_link_params.recv_frame_size;
     }
 #endif
+#ifdef HAVE_AF_XDP
+    if (use_xdp) {
+        default_link_params.send_frame_size =
+            std::min(default_link_params.send_frame_size, XDP_MAX_FRAME_SIZE);
+        default_link_params.recv_frame_size =
+            std::min(default_link_params.recv_frame_size, XDP_MAX_FRAME_SIZE);
+        // There are no socket buffers, all buffering happens in the UMEM
+        default_link_params.num_recv_frames = default_link_params.recv_buff_size
+                                              / default_link_params.recv_frame_size;
+    }
+#endif
 
     link_params_t link_params = calculate_udp_link_params(link_type,
         get_mtu(uhd::TX_DIRECTION),
         get_mtu(uhd::RX_DIRECTION),
         default_link_params,
         _mb_args,
-        link_args);
+        link_args,
+        link_rate);
 
     // Enforce a minimum bound of the number of receive and send frames.
     link_params.num_send_frames =
@@ -336,6 +414,42 @@ uhd::transport::both_links_t mpmd_link_if_ctrl_udp::get_link(const size_t link_i
         UHD_LOG_WARNING("MPMD", "Cannot create DPDK transport, falling back to UDP");
 #endif
     }
+    if (use_xdp) {
+#ifdef HAVE_AF_XDP
+        auto link =
+            uhd::transport::udp_xdp_link::make(ip_addr, udp_port, link_params, _mb_args);
+        return std::make_tuple(link,
+            link_params.send_buff_size,
+            link,
+            link_params.recv_buff_size,
+            true,
+            true);
+#else
+        UHD_LOG_WARNING(
+            "MPMD", "Cannot create AF_XDP transport, falling back to UDP");
+#endif
+    }
+    if (use_rio) {
+#ifdef HAVE_RIO
+        auto link = uhd::transport::udp_rio_link::make(ip_addr,
+            udp_port,
+            link_params,
+            link_params.recv_buff_size,
+            link_params.send_buff_size);
+        return std::make_tuple(link,
+            link_params.send_buff_size,
+            link,
+            link_params.recv_buff_size,
+            true,
+            false);
+#else
+        UHD_LOG_WARNING("MPMD", "Cannot create RIO transport, falling back to UDP");
+#endif
+    }
+    if (link_type == link_type_t::RX_DATA) {
+        link_params = qualify_udp_rx_link(
+            ip_addr, udp_port, link_params, link_rate, _mb_args, link_args);
+    }
     auto link = uhd::transport::udp_boost_asio_link::make(ip_addr,
         udp_port,
         link_params,
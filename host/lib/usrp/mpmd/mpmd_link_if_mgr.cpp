@@ -9,6 +9,15 @@
 #include "mpmd_impl.hpp"
 #include "mpmd_link_if_ctrl_base.hpp"
 #include "mpmd_link_if_ctrl_udp.hpp"
+#include <uhdlib/transport/pcap_tap.hpp>
+
+namespace {
+
+//! The headers of a packet on a UDP link: Ethernet (with FCS), IPv4, UDP, and a
+// CHDR header with a timestamp
+constexpr size_t UDP_PKT_OVERHEAD = 18 + 20 + 8 + 16;
+
+} // namespace
 
 uhd::dict<std::string, std::string> uhd::mpmd::xport::filter_args(
     const uhd::device_addr_t& args, const std::string& prefix)
@@ -28,7 +37,15 @@ using namespace uhd::mpmd::xport;
 class mpmd_link_if_mgr_impl : public mpmd_link_if_mgr
 {
 public:
-    mpmd_link_if_mgr_impl(const uhd::device_addr_t& mb_args) : _mb_args(mb_args) {}
+    mpmd_link_if_mgr_impl(const uhd::device_addr_t& mb_args) : _mb_args(mb_args)
+    {
+        if (_mb_args.has_key("pcap_file")) {
+            UHD_LOG_INFO(
+                "MPMD::XPORT", "Capturing all links to " << _mb_args["pcap_file"]);
+            _pcap_writer =
+                std::make_shared<uhd::transport::pcap_writer>(_mb_args["pcap_file"]);
+        }
+    }
 
     /**************************************************************************
      * API (see mpmd_link_if_mgr.hpp)
@@ -68,8 +85,15 @@ public:
     {
         const size_t link_if_ctrl_idx = _link_link_if_ctrl_map.at(link_idx).first;
         const size_t xport_link_idx   = _link_link_if_ctrl_map.at(link_idx).second;
-        return _link_if_ctrls.at(link_if_ctrl_idx)
-            ->get_link(xport_link_idx, link_type, link_args);
+        auto links = _link_if_ctrls.at(link_if_ctrl_idx)
+                         ->get_link(xport_link_idx, link_type, link_args);
+        if (_pcap_writer) {
+            uhd::transport::attach_pcap_taps(*_pcap_writer,
+                links,
+                "link" + std::to_string(link_idx) + " " + to_string(link_type),
+                _mb_args);
+        }
+        return links;
     }
 
     size_t get_mtu(const size_t link_idx, const uhd::direction_t dir) const
@@ -77,6 +101,19 @@ public:
         return _link_if_ctrls.at(_link_link_if_ctrl_map.at(link_idx).first)->get_mtu(dir);
     }
 
+    double get_link_rate(const size_t link_idx, const uhd::direction_t dir) const
+    {
+        const auto& link_if_ctrl =
+            _link_if_ctrls.at(_link_link_if_ctrl_map.at(link_idx).first);
+        const double link_rate =
+            link_if_ctrl->get_link_rate(_link_link_if_ctrl_map.at(link_idx).second);
+        const size_t mtu = link_if_ctrl->get_mtu(dir);
+        if (mtu <= UDP_PKT_OVERHEAD) {
+            return 0.0;
+        }
+        return link_rate * (mtu - UDP_PKT_OVERHEAD) / mtu;
+    }
+
     const uhd::rfnoc::chdr::chdr_packet_factory& get_packet_factory(
         const size_t link_idx) const
     {
@@ -88,6 +125,20 @@ private:
     /**************************************************************************
      * Private methods / helpers
      *************************************************************************/
+    static std::string to_string(const uhd::transport::link_type_t link_type)
+    {
+        switch (link_type) {
+            case uhd::transport::link_type_t::CTRL:
+                return "ctrl";
+            case uhd::transport::link_type_t::ASYNC_MSG:
+                return "async_msg";
+            case uhd::transport::link_type_t::TX_DATA:
+                return "tx_data";
+            default:
+                return "rx_data";
+        }
+    }
+
     mpmd_link_if_ctrl_base::uptr make_link_if_ctrl(const std::string& link_type,
         const xport_info_list_t& xport_info,
         const uhd::rfnoc::chdr_w_t chdr_w)
@@ -114,6 +165,9 @@ private:
 
     //! Motherboard args, can contain things like 'recv_buff_size'
     const uhd::device_addr_t _mb_args;
+
+    //! Writes the capture of the links, if the pcap_file arg is set
+    uhd::transport::pcap_writer::sptr _pcap_writer;
 };
 
 mpmd_link_if_mgr::uptr mpmd_link_if_mgr::make(const uhd::device_addr_t& mb_args)
@@ -144,6 +144,19 @@ public:
      */
     virtual size_t get_mtu(const size_t link_idx, const uhd::direction_t dir) const = 0;
 
+    /*! Return the rate of a link that is left for the CHDR payload
+     *
+     * This is the rate of the underlying link, reduced by the Ethernet, IP,
+     * UDP, and CHDR headers of a packet of the size of the MTU.
+     *
+     * \param link_idx The number of the link. link_idx < get_num_links()
+     *                 must hold true.
+     * \param dir The direction of the traffic
+     * \return the payload rate in bytes/sec
+     */
+    virtual double get_link_rate(
+        const size_t link_idx, const uhd::direction_t dir) const = 0;
+
     /*! Get packet factory from associated link_mgr
      *
      * \param link_idx The number of the link to use. link_idx < get_num_links()
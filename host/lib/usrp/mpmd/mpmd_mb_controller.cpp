@@ -14,26 +14,37 @@ namespace {
 constexpr size_t MPMD_DEFAULT_LONG_TIMEOUT = 30000; // ms
 } // namespace
 
-mpmd_mb_controller::mpmd_mb_controller(
-    uhd::rpc_client::sptr rpcc, uhd::device_addr_t device_info)
-    : _rpc(rpcc), _device_info(device_info)
+mpmd_mb_controller::mpmd_mb_controller(uhd::rpc_client::sptr rpcc,
+    uhd::device_addr_t device_info,
+    uhd::usrp::mpm_telemetry_receiver::sptr telemetry)
+    : _rpc(rpcc), _device_info(device_info), _telemetry(telemetry)
 {
-    const size_t num_tks = _rpc->request_with_token<size_t>("get_num_timekeepers");
+    auto batch               = _rpc->make_batch();
+    const size_t tks_idx     = batch.add_with_token("get_num_timekeepers");
+    const size_t sensors_idx = batch.add_with_token("get_mb_sensors");
+    const size_t banks_idx   = batch.add_with_token("get_gpio_banks");
+    const auto results       = _rpc->request_batch(batch);
+
+    const size_t num_tks = results.get<size_t>(tks_idx);
     for (size_t tk_idx = 0; tk_idx < num_tks; tk_idx++) {
         register_timekeeper(tk_idx, std::make_shared<mpmd_timekeeper>(tk_idx, _rpc));
     }
 
     // Enumerate sensors
-    auto sensor_list =
-        _rpc->request_with_token<std::vector<std::string>>("get_mb_sensors");
+    auto sensor_list = results.get<std::vector<std::string>>(sensors_idx);
     UHD_LOG_DEBUG("MPMD", "Found " << sensor_list.size() << " motherboard sensors.");
     _sensor_names.insert(sensor_list.cbegin(), sensor_list.cend());
 
     // Enumerate GPIO banks that are under mb_controller control
-    _gpio_banks = _rpc->request_with_token<std::vector<std::string>>("get_gpio_banks");
+    _gpio_banks     = results.get<std::vector<std::string>>(banks_idx);
+    auto srcs_batch = _rpc->make_batch();
     for (const auto& bank : _gpio_banks) {
-        _gpio_srcs.insert({bank,
-            _rpc->request_with_token<std::vector<std::string>>("get_gpio_srcs", bank)});
+        srcs_batch.add_with_token("get_gpio_srcs", bank);
+    }
+    const auto srcs_results = _rpc->request_batch(srcs_batch);
+    for (size_t i = 0; i < _gpio_banks.size(); i++) {
+        _gpio_srcs.insert(
+            {_gpio_banks[i], srcs_results.get<std::vector<std::string>>(i)});
     }
 }
 
@@ -164,10 +175,48 @@ sensor_value_t mpmd_mb_controller::get_sensor(const std::string& name)
     if (!_sensor_names.count(name)) {
         throw uhd::key_error(std::string("Invalid motherboard sensor name: ") + name);
     }
+    if (_telemetry) {
+        if (auto value = _telemetry->get_value(name)) {
+            return *value;
+        }
+    }
     return sensor_value_t(
         _rpc->request_with_token<sensor_value_t::sensor_map_t>("get_mb_sensor", name));
 }
 
+std::vector<sensor_value_t> mpmd_mb_controller::get_sensors(
+    const std::vector<std::string>& names)
+{
+    std::vector<boost::optional<sensor_value_t>> values(names.size());
+    // Maps batch results to the index of their sensor in names
+    std::vector<std::pair<size_t, size_t>> batch_idxs;
+    auto batch = _rpc->make_batch();
+    for (size_t i = 0; i < names.size(); i++) {
+        if (!_sensor_names.count(names[i])) {
+            throw uhd::key_error(
+                std::string("Invalid motherboard sensor name: ") + names[i]);
+        }
+        if (_telemetry) {
+            values[i] = _telemetry->get_value(names[i]);
+        }
+        if (!values[i]) {
+            batch_idxs.push_back({batch.add_with_token("get_mb_sensor", names[i]), i});
+        }
+    }
+    if (!batch_idxs.empty()) {
+        const auto results = _rpc->request_batch(batch);
+        for (const auto& batch_idx : batch_idxs) {
+            values[batch_idx.second] = sensor_value_t(
+                results.get<sensor_value_t::sensor_map_t>(batch_idx.first));
+        }
+    }
+    std::vector<sensor_value_t> sensors;
+    for (const auto& value : values) {
+        sensors.push_back(*value);
+    }
+    return sensors;
+}
+
 std::vector<std::string> mpmd_mb_controller::get_sensor_names()
 {
     std::vector<std::string> sensor_names(_sensor_names.cbegin(), _sensor_names.cend());
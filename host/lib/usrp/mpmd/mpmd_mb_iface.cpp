@@ -10,6 +10,7 @@
 #include <uhd/exception.hpp>
 #include <uhd/utils/log.hpp>
 #include <uhdlib/rfnoc/device_id.hpp>
+#include <uhdlib/usrp/common/latency_mode.hpp>
 
 using namespace uhd::rfnoc;
 using namespace uhd::mpmd;
@@ -24,10 +25,15 @@ static uhd::usrp::io_service_args_t get_default_io_srv_args()
     return args;
 }
 
-mpmd_mboard_impl::mpmd_mb_iface::mpmd_mb_iface(
-    const uhd::device_addr_t& mb_args, uhd::rpc_client::sptr rpc)
+mpmd_mboard_impl::mpmd_mb_iface::mpmd_mb_iface(const uhd::device_addr_t& mb_args,
+    uhd::rpc_client::sptr rpc,
+    const uhd::device_addr_t& device_info)
     : _mb_args(mb_args), _rpc(rpc), _link_if_mgr(xport::mpmd_link_if_mgr::make(mb_args))
 {
+    if (device_info.has_key("serial") && device_info.has_key("fpga_version_hash")) {
+        _topology_key = device_info["serial"] + "/" + device_info.get("fpga", "") + "/"
+                        + device_info["fpga_version_hash"];
+    }
     _remote_device_id = allocate_device_id();
     UHD_LOG_TRACE("MPMD::MB_IFACE", "Assigning device_id " << _remote_device_id);
     _rpc->notify_with_token("set_device_id", _remote_device_id);
@@ -137,11 +143,22 @@ uhd::transport::adapter_id_t mpmd_mboard_impl::mpmd_mb_iface::get_adapter_id(
     return _adapter_map.at(local_device_id);
 }
 
+double mpmd_mboard_impl::mpmd_mb_iface::get_link_rate(
+    const uhd::rfnoc::device_id_t local_device_id, const uhd::direction_t dir)
+{
+    return _link_if_mgr->get_link_rate(_local_device_id_map.at(local_device_id), dir);
+}
+
 void mpmd_mboard_impl::mpmd_mb_iface::reset_network()
 {
     // FIXME
 }
 
+std::string mpmd_mboard_impl::mpmd_mb_iface::get_topology_key()
+{
+    return _topology_key;
+}
+
 uhd::rfnoc::clock_iface::sptr mpmd_mboard_impl::mpmd_mb_iface::get_clock_iface(
     const std::string& clock_name)
 {
@@ -220,21 +237,20 @@ mpmd_mboard_impl::mpmd_mb_iface::make_rx_data_transport(
     /* Associate local device ID with the adapter */
     _adapter_map[local_sep_addr.first] = send_link->get_send_adapter_id();
 
-    const uhd::rfnoc::stream_buff_params_t recv_capacity = {recv_buff_size,
-        packet_fc ? static_cast<uint32_t>(recv_link->get_num_recv_frames())
-                  : uhd::rfnoc::MAX_FC_CAPACITY_PKTS};
+    const uhd::usrp::latency_mode_args_t latency_args =
+        uhd::usrp::read_latency_mode_args(xport_args);
+    const uhd::rfnoc::stream_buff_params_t max_capacity =
+        uhd::usrp::get_max_fc_capacity(latency_args, recv_link->get_recv_frame_size());
 
-    const double ratio = 1.0 / 32;
+    const uhd::rfnoc::stream_buff_params_t recv_capacity = {
+        std::min<uint64_t>(recv_buff_size, max_capacity.bytes),
+        packet_fc ? std::min(static_cast<uint32_t>(recv_link->get_num_recv_frames()),
+                        max_capacity.packets)
+                  : uhd::rfnoc::MAX_FC_CAPACITY_PKTS};
 
     // Configure flow control frequency to use either bytes only or packets only
-    uhd::rfnoc::stream_buff_params_t fc_freq;
-    if (packet_fc) {
-        fc_freq = {uhd::rfnoc::MAX_FC_FREQ_BYTES,
-            static_cast<uint32_t>(std::ceil(recv_link->get_num_recv_frames() * ratio))};
-    } else {
-        fc_freq = {static_cast<uint64_t>(std::ceil(double(recv_buff_size) * ratio)),
-            uhd::rfnoc::MAX_FC_FREQ_PKTS};
-    }
+    const uhd::rfnoc::stream_buff_params_t fc_freq =
+        uhd::usrp::get_rx_fc_freq(latency_args, recv_capacity, packet_fc);
 
     stream_buff_params_t fc_headroom = {0, 0};
 
@@ -259,6 +275,7 @@ mpmd_mboard_impl::mpmd_mb_iface::make_rx_data_transport(
         [io_srv_mgr, recv_link, send_link]() {
             io_srv_mgr->disconnect_links(recv_link, send_link);
         });
+    fc_params.adaptive_freq = xport_args.cast<bool>("adaptive_fc", false);
 
     cfg_io_srv.reset();
 
@@ -314,8 +331,12 @@ mpmd_mboard_impl::mpmd_mb_iface::make_tx_data_transport(
     _adapter_map[local_sep_addr.first] = send_link->get_send_adapter_id();
 
     // TODO: configure this based on the transport type
-    const double fc_freq_ratio     = 1.0 / 8;
+    const uhd::usrp::latency_mode_args_t latency_args =
+        uhd::usrp::read_latency_mode_args(xport_args);
+    const double fc_freq_ratio     = latency_args.tx_fc_freq_ratio;
     const double fc_headroom_ratio = 0;
+    const uhd::rfnoc::stream_buff_params_t max_capacity =
+        uhd::usrp::get_max_fc_capacity(latency_args, send_link->get_send_frame_size());
 
     auto cfg_io_srv = get_io_srv_mgr()->connect_links(
         recv_link, send_link, transport::link_type_t::CTRL);
@@ -332,6 +353,7 @@ mpmd_mboard_impl::mpmd_mb_iface::make_tx_data_transport(
         mdata_buff_fmt,
         fc_freq_ratio,
         fc_headroom_ratio,
+        max_capacity,
         [io_srv_mgr, recv_link, send_link]() {
             io_srv_mgr->disconnect_links(recv_link, send_link);
         });
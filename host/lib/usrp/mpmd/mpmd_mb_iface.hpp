@@ -21,7 +21,9 @@ class mpmd_mboard_impl::mpmd_mb_iface : public uhd::rfnoc::mb_iface
 public:
     using uptr               = std::unique_ptr<mpmd_mb_iface>;
     using clock_iface_list_t = std::vector<std::map<std::string, std::string>>;
-    mpmd_mb_iface(const uhd::device_addr_t& mb_args, uhd::rpc_client::sptr rpc);
+    mpmd_mb_iface(const uhd::device_addr_t& mb_args,
+        uhd::rpc_client::sptr rpc,
+        const uhd::device_addr_t& device_info);
     ~mpmd_mb_iface() = default;
 
     /*** mpmd_mb_iface API calls *****************************************/
@@ -36,7 +38,10 @@ public:
     std::vector<uhd::rfnoc::device_id_t> get_local_device_ids();
     uhd::transport::adapter_id_t get_adapter_id(
         const uhd::rfnoc::device_id_t local_device_id);
+    double get_link_rate(
+        const uhd::rfnoc::device_id_t local_device_id, const uhd::direction_t dir);
     void reset_network();
+    std::string get_topology_key();
     uhd::rfnoc::clock_iface::sptr get_clock_iface(const std::string& clock_name);
     uhd::rfnoc::chdr_ctrl_xport::sptr make_ctrl_transport(
         uhd::rfnoc::device_id_t local_device_id, const uhd::rfnoc::sep_id_t& local_epid);
@@ -60,6 +65,8 @@ public:
 private:
     uhd::device_addr_t _mb_args;
     uhd::rpc_client::sptr _rpc;
+    //! Device serial and FPGA image, or empty if either is unknown
+    std::string _topology_key;
     xport::mpmd_link_if_mgr::uptr _link_if_mgr;
     uhd::rfnoc::device_id_t _remote_device_id;
     std::map<uhd::rfnoc::device_id_t, size_t> _local_device_id_map;
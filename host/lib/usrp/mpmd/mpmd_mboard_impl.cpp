@@ -10,8 +10,12 @@
 #include <uhd/transport/udp_simple.hpp>
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/safe_call.hpp>
+#include <uhdlib/utils/init_timeline.hpp>
+#include <uhdlib/utils/periodic_task.hpp>
 #include <chrono>
+#include <iomanip>
 #include <memory>
+#include <sstream>
 #include <thread>
 
 namespace {
@@ -26,6 +30,10 @@ const std::string MPMD_DEFAULT_SESSION_ID = "UHD";
 const std::string MPMD_MEAS_LATENCY_KEY = "measure_rpc_latency";
 //! Duration of a latency measurement test
 constexpr size_t MPMD_MEAS_LATENCY_DURATION = 1000;
+//! Key to reuse the device state of the previous session if it matches
+const std::string MPMD_WARM_RECONNECT_KEY = "warm_reconnect";
+//! Key under which the session hash is passed to MPM's init()
+const std::string MPMD_SESSION_HASH_KEY = "session_hash";
 
 using log_buf_t = std::vector<std::map<std::string, std::string>>;
 
@@ -62,9 +70,46 @@ bool is_pingable(const std::string& ip_addr, const std::string& udp_port)
     return true;
 }
 
+/*! Hash the configuration of an MPM session
+ *
+ * The hash covers the init() args, the FPGA image, and the daughterboards. If
+ * two sessions have the same hash, the device state left by the first one is
+ * valid for the second one. This uses FNV-1a over a canonical string, so the
+ * hash is the same for any host that connects with the same configuration.
+ */
+std::string get_session_hash(const std::map<std::string, std::string>& init_args,
+    const uhd::device_addr_t& device_info,
+    const std::vector<uhd::device_addr_t>& dboard_info)
+{
+    std::string config;
+    for (const auto& arg : init_args) {
+        config += arg.first + "=" + arg.second + ";";
+    }
+    for (const std::string key : {"fpga", "fpga_version", "fpga_version_hash"}) {
+        config += key + "=" + device_info.get(key, "") + ";";
+    }
+    for (const auto& db_info : dboard_info) {
+        config += "db=" + db_info.get("pid", "") + "/" + db_info.get("serial", "") + ";";
+    }
+
+    uint64_t hash = 0xcbf29ce484222325;
+    for (const char c : config) {
+        hash = (hash ^ uint8_t(c)) * 0x100000001b3;
+    }
+    std::ostringstream hash_str;
+    hash_str << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return hash_str.str();
+}
+
 /*! Call init() on an MPM device.
+ *
+ * With warm_reconnect, this passes the session hash to MPM, which then skips
+ * the initialization if the previous session had the same hash.
  */
-void init_device(uhd::rpc_client::sptr rpc, const uhd::device_addr_t mb_args)
+void init_device(uhd::rpc_client::sptr rpc,
+    const uhd::device_addr_t mb_args,
+    const uhd::device_addr_t& device_info,
+    const std::vector<uhd::device_addr_t>& dboard_info)
 {
     auto init_status = rpc->request_with_token<std::vector<std::string>>(
         MPMD_DEFAULT_INIT_TIMEOUT, "get_init_status");
@@ -81,6 +126,13 @@ void init_device(uhd::rpc_client::sptr rpc, const uhd::device_addr_t mb_args)
             mpm_device_args[key] = mb_args[key];
         }
     }
+    if (mb_args.has_key(MPMD_WARM_RECONNECT_KEY)) {
+        mpm_device_args[MPMD_SESSION_HASH_KEY] =
+            get_session_hash(mpm_device_args, device_info, dboard_info);
+        UHD_LOG_DEBUG("MPMD",
+            "Requesting warm reconnect with session hash "
+                << mpm_device_args[MPMD_SESSION_HASH_KEY]);
+    }
     if (not rpc->request_with_token<bool>(
             MPMD_DEFAULT_INIT_TIMEOUT, "init", mpm_device_args)) {
         throw uhd::runtime_error("Failed to initialize device.");
@@ -166,6 +218,23 @@ uhd::rpc_client::sptr make_mpm_rpc_client(const std::string& rpc_server_addr,
         uhd::mpmd::mpmd_impl::MPM_RPC_GET_LAST_ERROR_CMD);
 }
 
+/*! Return a telemetry receiver if the mb args ask for one, or a null pointer
+ *
+ * The receiver gets its own RPC client, so renewing the subscription never has
+ * to wait for other RPC calls, like a long init().
+ */
+uhd::usrp::mpm_telemetry_receiver::sptr make_telemetry_receiver(
+    const std::string& rpc_server_addr, const uhd::device_addr_t& mb_args)
+{
+    using uhd::usrp::mpm_telemetry_receiver;
+    if (!mb_args.has_key(mpm_telemetry_receiver::RATE_KEY)) {
+        return nullptr;
+    }
+    return mpm_telemetry_receiver::make(make_mpm_rpc_client(rpc_server_addr, mb_args),
+        rpc_server_addr,
+        mb_args.cast<double>(mpm_telemetry_receiver::RATE_KEY, 0.0));
+}
+
 } // namespace
 
 using namespace uhd;
@@ -280,7 +349,11 @@ mpmd_mboard_impl::mpmd_mboard_impl(
                              << rpc_server_addr
                              << " mboard args: " << mb_args.to_string();
 
-    _claimer_task = claim_device_and_make_task();
+    init_timeline::scoped_span span("mpmd_mboard_impl");
+    {
+        init_timeline::scoped_span claim_span("claim");
+        _claimer_task = claim_device_and_make_task();
+    }
     if (mb_args_.has_key(MPMD_MEAS_LATENCY_KEY)) {
         measure_rpc_latency(rpc, MPMD_MEAS_LATENCY_DURATION);
     }
@@ -307,8 +380,10 @@ mpmd_mboard_impl::mpmd_mboard_impl(
 
     if (!mb_args.has_key("skip_init")) {
         // Initialize mb_iface and mb_controller
-        mb_iface = std::make_unique<mpmd_mb_iface>(mb_args, rpc);
-        mb_ctrl  = std::make_shared<rfnoc::mpmd_mb_controller>(rpc, device_info);
+        init_timeline::scoped_span iface_span("mb_iface and mb_controller");
+        mb_iface = std::make_unique<mpmd_mb_iface>(mb_args, rpc, device_info);
+        mb_ctrl  = std::make_shared<rfnoc::mpmd_mb_controller>(
+            rpc, device_info, make_telemetry_receiver(rpc_server_addr, mb_args));
     } // Note -- when skip_init is used, these are not initialized, and trying
       // to use them will result in a null pointer dereference exception!
 }
@@ -328,7 +403,12 @@ mpmd_mboard_impl::~mpmd_mboard_impl()
  ****************************************************************************/
 void mpmd_mboard_impl::init()
 {
-    init_device(rpc, mb_args);
+    {
+        // MPM initializes the motherboard and the daughterboards here
+        init_timeline::scoped_span span("init device and dboards (MPM)");
+        init_device(rpc, mb_args, device_info, dboard_info);
+    }
+    init_timeline::scoped_span span("mb_iface init");
     mb_iface->init();
 }
 
@@ -387,9 +467,8 @@ uhd::task::sptr mpmd_mboard_impl::claim_device_and_make_task()
             UHD_LOG_WARNING("MPMD", "Could not read back log queue!");
         }
     }
-    return uhd::task::make(
+    return uhd::make_periodic_task(
         [this] {
-            auto now = std::chrono::steady_clock::now();
             if (not this->claim()) {
                 throw uhd::value_error("mpmd device reclaiming loop failed!");
             } else {
@@ -399,9 +478,8 @@ uhd::task::sptr mpmd_mboard_impl::claim_device_and_make_task()
                     UHD_LOG_WARNING("MPMD", "Could not read back log queue!");
                 }
             }
-            std::this_thread::sleep_until(
-                now + std::chrono::milliseconds(MPMD_RECLAIM_INTERVAL_MS));
         },
+        std::chrono::milliseconds(MPMD_RECLAIM_INTERVAL_MS),
         "mpmd_claimer_task");
 }
 
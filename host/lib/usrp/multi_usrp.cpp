@@ -18,9 +18,11 @@
 #include <uhd/utils/gain_group.hpp>
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/math.hpp>
+#include <uhd/utils/scope_exit.hpp>
 #include <uhd/utils/soft_register.hpp>
 #include <uhdlib/rfnoc/rfnoc_device.hpp>
 #include <uhdlib/usrp/gpio_defs.hpp>
+#include <uhdlib/utils/init_timeline.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/assign/list_of.hpp>
 #include <boost/format.hpp>
@@ -29,7 +31,9 @@
 #include <chrono>
 #include <cmath>
 #include <functional>
+#include <future>
 #include <memory>
+#include <set>
 #include <thread>
 
 namespace uhd { namespace rfnoc {
@@ -402,6 +406,18 @@ public:
     multi_usrp_impl(device::sptr dev) : _dev(dev)
     {
         _tree = _dev->get_tree();
+        // The time is read often, so we only look up its properties once
+        const size_t num_mboards = _tree->exists("/mboards") ? get_num_mboards() : 0;
+        for (size_t mboard = 0; mboard < num_mboards; mboard++) {
+            const fs_path time_path = fs_path("/mboards") / mboard / "time";
+            if (!_tree->exists(time_path / "now") || !_tree->exists(time_path / "pps")) {
+                _time_now_props.clear();
+                _time_pps_props.clear();
+                break;
+            }
+            _time_now_props.push_back(_tree->get_handle<time_spec_t>(time_path / "now"));
+            _time_pps_props.push_back(_tree->get_handle<time_spec_t>(time_path / "pps"));
+        }
     }
 
     device::sptr get_device(void)
@@ -577,11 +593,17 @@ public:
 
     time_spec_t get_time_now(size_t mboard = 0)
     {
+        if (mboard < _time_now_props.size()) {
+            return _time_now_props[mboard]->get();
+        }
         return _tree->access<time_spec_t>(mb_root(mboard) / "time/now").get();
     }
 
     time_spec_t get_time_last_pps(size_t mboard = 0)
     {
+        if (mboard < _time_pps_props.size()) {
+            return _time_pps_props[mboard]->get();
+        }
         return _tree->access<time_spec_t>(mb_root(mboard) / "time/pps").get();
     }
 
@@ -602,43 +624,39 @@ public:
             _tree->access<time_spec_t>(mb_root(mboard) / "time/pps").set(time_spec);
             return;
         }
-        for (size_t m = 0; m < get_num_mboards(); m++) {
-            set_time_next_pps(time_spec, m);
-        }
+        // Each motherboard has its own control path, so the commands can all
+        // go out at once. That way, they all make it before the same PPS edge,
+        // however many motherboards there are.
+        for_each_mboard([&](const size_t m) { set_time_next_pps(time_spec, m); });
     }
 
     void set_time_unknown_pps(const time_spec_t& time_spec)
     {
         UHD_LOGGER_INFO("MULTI_USRP") << "    1) catch time transition at pps edge";
-        auto end_time =
-            std::chrono::steady_clock::now() + std::chrono::milliseconds(1100);
-        time_spec_t time_start_last_pps = get_time_last_pps();
-        while (time_start_last_pps == get_time_last_pps()) {
-            if (std::chrono::steady_clock::now() > end_time) {
-                throw uhd::runtime_error("Board 0 may not be getting a PPS signal!\n"
-                                         "No PPS detected within the time interval.\n"
-                                         "See the application notes for your device.\n");
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        }
+        const time_spec_t edge_last_pps =
+            wait_for_pps(get_time_last_pps(), std::chrono::milliseconds(1100));
 
         UHD_LOGGER_INFO("MULTI_USRP") << "    2) set times next pps (synchronously)";
         set_time_next_pps(time_spec, ALL_MBOARDS);
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-
-        // verify that the time registers are read to be within a few RTT
+        // Rather than waiting out a whole second, wait for the edge that
+        // latches the new time
+        wait_for_pps(edge_last_pps, std::chrono::milliseconds(1100));
+
+        // Read back the time of that edge from all boards at once. Unlike the
+        // current time, it's the same on all boards if they caught the same
+        // edge, no matter how long the reads take.
+        std::vector<time_spec_t> last_pps(get_num_mboards());
+        for_each_mboard([&](const size_t m) { last_pps[m] = get_time_last_pps(m); });
         for (size_t m = 1; m < get_num_mboards(); m++) {
-            time_spec_t time_0 = this->get_time_now(0);
-            time_spec_t time_i = this->get_time_now(m);
-            if (time_i < time_0
-                or (time_i - time_0)
-                       > time_spec_t(0.01)) { // 10 ms: greater than RTT but not too big
+            // 1 us: less than a PPS period, but more than a tick
+            if (std::abs((last_pps[m] - last_pps[0]).get_real_secs()) > 1e-6) {
                 UHD_LOGGER_WARNING("MULTI_USRP")
                     << boost::format(
                            "Detected time deviation between board %d and board 0.\n"
-                           "Board 0 time is %f seconds.\n"
-                           "Board %d time is %f seconds.\n")
-                           % m % time_0.get_real_secs() % m % time_i.get_real_secs();
+                           "Board 0 time at the last PPS is %f seconds.\n"
+                           "Board %d time at the last PPS is %f seconds.\n")
+                           % m % last_pps[0].get_real_secs() % m
+                           % last_pps[m].get_real_secs();
             }
         }
     }
@@ -1080,6 +1098,34 @@ public:
         return result;
     }
 
+    std::vector<tune_result_t> set_rx_freqs(const tune_request_t& tune_request,
+        const std::vector<size_t>& chans,
+        const time_spec_t& cmd_time)
+    {
+        std::set<size_t> mboards;
+        for (const size_t chan : chans) {
+            mboards.insert(rx_chan_to_mcp(chan).mboard);
+        }
+        const bool timed = cmd_time != time_spec_t(0.0);
+        if (timed) {
+            for (const size_t mboard : mboards) {
+                set_command_time(cmd_time, mboard);
+            }
+        }
+        auto clear_time = uhd::utils::scope_exit::make([this, timed, &mboards]() {
+            if (timed) {
+                for (const size_t mboard : mboards) {
+                    clear_command_time(mboard);
+                }
+            }
+        });
+        std::vector<tune_result_t> results;
+        for (const size_t chan : chans) {
+            results.push_back(set_rx_freq(tune_request, chan));
+        }
+        return results;
+    }
+
     double get_rx_freq(size_t chan)
     {
         return derive_freq_from_xx_subdev_and_dsp(RX_SIGN,
@@ -1100,6 +1146,26 @@ public:
         return _tree->access<meta_range_t>(rx_rf_fe_root(chan) / "freq" / "range").get();
     }
 
+    std::vector<double> set_rx_hop_table(const std::vector<double>& freqs, size_t chan)
+    {
+        if (!_tree->exists(rx_rf_fe_root(chan) / "hop_set")) {
+            throw uhd::not_implemented_error(
+                "set_rx_hop_table() is not supported on this device");
+        }
+        return _tree
+            ->access<std::vector<double>>(rx_rf_fe_root(chan) / "hop_set" / "freqs")
+            .set(freqs)
+            .get();
+    }
+
+    void rx_hop(size_t index, size_t chan)
+    {
+        if (!_tree->exists(rx_rf_fe_root(chan) / "hop_set")) {
+            throw uhd::not_implemented_error("rx_hop() is not supported on this device");
+        }
+        _tree->access<size_t>(rx_rf_fe_root(chan) / "hop_set" / "index").set(index);
+    }
+
     /**************************************************************************
      * LO controls
      *************************************************************************/
@@ -2080,6 +2146,34 @@ public:
         return result;
     }
 
+    std::vector<tune_result_t> set_tx_freqs(const tune_request_t& tune_request,
+        const std::vector<size_t>& chans,
+        const time_spec_t& cmd_time)
+    {
+        std::set<size_t> mboards;
+        for (const size_t chan : chans) {
+            mboards.insert(tx_chan_to_mcp(chan).mboard);
+        }
+        const bool timed = cmd_time != time_spec_t(0.0);
+        if (timed) {
+            for (const size_t mboard : mboards) {
+                set_command_time(cmd_time, mboard);
+            }
+        }
+        auto clear_time = uhd::utils::scope_exit::make([this, timed, &mboards]() {
+            if (timed) {
+                for (const size_t mboard : mboards) {
+                    clear_command_time(mboard);
+                }
+            }
+        });
+        std::vector<tune_result_t> results;
+        for (const size_t chan : chans) {
+            results.push_back(set_tx_freq(tune_request, chan));
+        }
+        return results;
+    }
+
     double get_tx_freq(size_t chan)
     {
         return derive_freq_from_xx_subdev_and_dsp(TX_SIGN,
@@ -2100,6 +2194,26 @@ public:
         return _tree->access<meta_range_t>(tx_rf_fe_root(chan) / "freq" / "range").get();
     }
 
+    std::vector<double> set_tx_hop_table(const std::vector<double>& freqs, size_t chan)
+    {
+        if (!_tree->exists(tx_rf_fe_root(chan) / "hop_set")) {
+            throw uhd::not_implemented_error(
+                "set_tx_hop_table() is not supported on this device");
+        }
+        return _tree
+            ->access<std::vector<double>>(tx_rf_fe_root(chan) / "hop_set" / "freqs")
+            .set(freqs)
+            .get();
+    }
+
+    void tx_hop(size_t index, size_t chan)
+    {
+        if (!_tree->exists(tx_rf_fe_root(chan) / "hop_set")) {
+            throw uhd::not_implemented_error("tx_hop() is not supported on this device");
+        }
+        _tree->access<size_t>(tx_rf_fe_root(chan) / "hop_set" / "index").set(index);
+    }
+
     void set_tx_gain(double gain, const std::string& name, size_t chan)
     {
         try {
@@ -2567,9 +2681,63 @@ private:
     device::sptr _dev;
     property_tree::sptr _tree;
 
+    //! Handles to the time/now and time/pps properties of all motherboards
+    std::vector<std::shared_ptr<property<time_spec_t>>> _time_now_props;
+    std::vector<std::shared_ptr<property<time_spec_t>>> _time_pps_props;
+
     //! Container for spp values set in set_rx_spp()
     std::unordered_map<size_t, size_t> _rx_spp;
 
+    /*! Run \p fn for every motherboard, with the motherboard index
+     *
+     * Each motherboard gets a thread of its own, so the calls don't wait for
+     * each other's control transactions.
+     */
+    template <typename mboard_fn_t>
+    void for_each_mboard(mboard_fn_t&& fn)
+    {
+        const size_t num_mboards = get_num_mboards();
+        if (num_mboards <= 1) {
+            for (size_t m = 0; m < num_mboards; m++) {
+                fn(m);
+            }
+            return;
+        }
+        std::vector<std::future<void>> mboard_futures;
+        for (size_t m = 0; m < num_mboards; m++) {
+            mboard_futures.push_back(std::async(std::launch::async, std::ref(fn), m));
+        }
+        // Rethrows the first failure, after all of them are done
+        for (auto& mboard_future : mboard_futures) {
+            mboard_future.wait();
+        }
+        for (auto& mboard_future : mboard_futures) {
+            mboard_future.get();
+        }
+    }
+
+    /*! Wait for the time of the last PPS on board 0 to change from \p last_pps
+     *
+     * \return the time of the new PPS edge
+     * \throws uhd::runtime_error if there's no edge within \p timeout
+     */
+    time_spec_t wait_for_pps(
+        const time_spec_t& last_pps, const std::chrono::milliseconds timeout)
+    {
+        const auto end_time      = std::chrono::steady_clock::now() + timeout;
+        time_spec_t new_last_pps = get_time_last_pps();
+        while (new_last_pps == last_pps) {
+            if (std::chrono::steady_clock::now() > end_time) {
+                throw uhd::runtime_error("Board 0 may not be getting a PPS signal!\n"
+                                         "No PPS detected within the time interval.\n"
+                                         "See the application notes for your device.\n");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            new_last_pps = get_time_last_pps();
+        }
+        return new_last_pps;
+    }
+
     struct mboard_chan_pair
     {
         size_t mboard, chan;
@@ -2853,6 +3021,7 @@ multi_usrp::sptr multi_usrp::make(const device_addr_t& dev_addr)
 {
     UHD_LOGGER_TRACE("MULTI_USRP")
         << "multi_usrp::make with args " << dev_addr.to_pp_string();
+    init_timeline::scoped_span span("multi_usrp::make");
 
     device::sptr dev = device::make(dev_addr, device::USRP);
 
@@ -14,6 +14,7 @@
 #include <uhd/types/device_addr.hpp>
 #include <uhd/usrp/multi_usrp.hpp>
 #include <uhd/utils/graph_utils.hpp>
+#include <uhd/utils/scope_exit.hpp>
 #include <uhdlib/rfnoc/rfnoc_device.hpp>
 #include <uhdlib/rfnoc/rfnoc_rx_streamer.hpp>
 #include <uhdlib/rfnoc/rfnoc_tx_streamer.hpp>
@@ -23,9 +24,14 @@
 #include <boost/format.hpp>
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <future>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <thread>
+#include <tuple>
 #include <vector>
 
 using namespace std::chrono_literals;
@@ -59,6 +65,8 @@ constexpr char DEFAULT_OTW_FORMAT[] = "sc16";
 constexpr double RX_SIGN            = +1.0;
 constexpr double TX_SIGN            = -1.0;
 constexpr char LOG_ID[]             = "MULTI_USRP";
+//! How long to wait for the radios to receive a stream command for all channels
+constexpr auto STREAM_CMD_ACK_TIMEOUT = 1s;
 
 //! A faux container for a UHD device
 //
@@ -167,6 +175,8 @@ public:
         ddc_block_control::sptr ddc; // can be nullptr
         size_t block_chan;
         std::vector<graph_edge_t> edge_list;
+        //! The spp property of the radio channel
+        property_handle<int> spp;
     };
 
     struct tx_chan_t
@@ -284,6 +294,7 @@ public:
 
         // Connect the chains
         _connect_rx_chains(args.channels);
+        _set_samp_rate_hint(args, _rx_rates);
 
         // Create the streamer
         // The disconnect callback must disconnect the entire chain because the radio
@@ -359,6 +370,7 @@ public:
 
         // Connect the chains
         _connect_tx_chains(args.channels);
+        _set_samp_rate_hint(args, _tx_rates);
 
         // Create a streamer
         // The disconnect callback must disconnect the entire chain because the radio
@@ -739,40 +751,44 @@ public:
 
     void set_time_next_pps(const time_spec_t& time_spec, size_t mboard = ALL_MBOARDS)
     {
-        MUX_MB_API_CALL(set_time_next_pps, time_spec);
+        if (mboard == ALL_MBOARDS) {
+            // Each device has its own control path, so the commands can all
+            // go out at once. That way, they all make it before the same PPS
+            // edge, however many devices there are.
+            _for_each_mboard([&](const size_t m) {
+                _get_mbc(m)->get_timekeeper(0)->set_time_next_pps(time_spec);
+            });
+            return;
+        }
         _get_mbc(mboard)->get_timekeeper(0)->set_time_next_pps(time_spec);
     }
 
     void set_time_unknown_pps(const time_spec_t& time_spec)
     {
         UHD_LOGGER_INFO("MULTI_USRP") << "    1) catch time transition at pps edge";
-        auto end_time                   = std::chrono::steady_clock::now() + 1100ms;
-        time_spec_t time_start_last_pps = get_time_last_pps();
-        while (time_start_last_pps == get_time_last_pps()) {
-            if (std::chrono::steady_clock::now() > end_time) {
-                throw uhd::runtime_error("Board 0 may not be getting a PPS signal!\n"
-                                         "No PPS detected within the time interval.\n"
-                                         "See the application notes for your device.\n");
-            }
-            std::this_thread::sleep_for(1ms);
-        }
+        const time_spec_t edge_last_pps = _wait_for_pps(get_time_last_pps(), 1100ms);
 
         UHD_LOGGER_INFO("MULTI_USRP") << "    2) set times next pps (synchronously)";
         set_time_next_pps(time_spec, ALL_MBOARDS);
-        std::this_thread::sleep_for(1s);
-
-        // verify that the time registers are read to be within a few RTT
+        // Rather than waiting out a whole second, wait for the edge that
+        // latches the new time
+        _wait_for_pps(edge_last_pps, 1100ms);
+
+        // Read back the time of that edge from all boards at once. Unlike the
+        // current time, it's the same on all boards if they caught the same
+        // edge, no matter how long the reads take.
+        std::vector<time_spec_t> last_pps(get_num_mboards());
+        _for_each_mboard([&](const size_t m) { last_pps[m] = get_time_last_pps(m); });
         for (size_t m = 1; m < get_num_mboards(); m++) {
-            time_spec_t time_0 = this->get_time_now(0);
-            time_spec_t time_i = this->get_time_now(m);
-            // 10 ms: greater than RTT but not too big
-            if (time_i < time_0 or (time_i - time_0) > time_spec_t(0.01)) {
+            // 1 us: less than a PPS period, but more than a tick
+            if (std::abs((last_pps[m] - last_pps[0]).get_real_secs()) > 1e-6) {
                 UHD_LOGGER_WARNING("MULTI_USRP")
                     << boost::format(
                            "Detected time deviation between board %d and board 0.\n"
-                           "Board 0 time is %f seconds.\n"
-                           "Board %d time is %f seconds.\n")
-                           % m % time_0.get_real_secs() % m % time_i.get_real_secs();
+                           "Board 0 time at the last PPS is %f seconds.\n"
+                           "Board %d time at the last PPS is %f seconds.\n")
+                           % m % last_pps[0].get_real_secs() % m
+                           % last_pps[m].get_real_secs();
             }
         }
     }
@@ -846,6 +862,10 @@ public:
 
     void issue_stream_cmd(const stream_cmd_t& stream_cmd, size_t chan = ALL_CHANS)
     {
+        if (chan == ALL_CHANS && get_rx_num_channels() > 1) {
+            _issue_stream_cmd_all_chans(stream_cmd);
+            return;
+        }
         MUX_RX_API_CALL(issue_stream_cmd, stream_cmd);
         auto& rx_chain = _get_rx_chan(chan);
         if (rx_chain.ddc) {
@@ -855,6 +875,54 @@ public:
         }
     }
 
+    /*! Issue a stream command to all RX channels at once
+     *
+     * Issuing the command to one channel after another takes a full control
+     * transaction per channel, so a timed start of many channels needs a long
+     * lead time. Instead, this sends the commands of all channels straight to
+     * the radios, and only then waits for all of them to arrive.
+     */
+    void _issue_stream_cmd_all_chans(const stream_cmd_t& stream_cmd)
+    {
+        const bool is_finite =
+            stream_cmd.stream_mode == stream_cmd_t::STREAM_MODE_NUM_SAMPS_AND_DONE
+            || stream_cmd.stream_mode == stream_cmd_t::STREAM_MODE_NUM_SAMPS_AND_MORE;
+        std::vector<std::future<void>> acks;
+        std::set<size_t> mboards;
+        for (size_t chan = 0; chan < get_rx_num_channels(); chan++) {
+            auto& rx_chain         = _get_rx_chan(chan);
+            stream_cmd_t radio_cmd = stream_cmd;
+            // The DDC would scale the number of samples to the radio rate
+            if (rx_chain.ddc && is_finite) {
+                radio_cmd.num_samps *=
+                    rx_chain.ddc->get_property<int>("decim", rx_chain.block_chan);
+            }
+            acks.push_back(
+                rx_chain.radio->issue_stream_cmd_async(radio_cmd, rx_chain.block_chan));
+            mboards.insert(rx_chain.radio->get_block_id().get_device_no());
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + STREAM_CMD_ACK_TIMEOUT;
+        for (auto& ack : acks) {
+            if (ack.wait_until(deadline) != std::future_status::ready) {
+                throw uhd::op_timeout(
+                    "Timed out waiting for the radios to receive the stream command");
+            }
+            ack.get();
+        }
+
+        if (!stream_cmd.stream_now) {
+            for (const size_t mboard : mboards) {
+                if (get_time_now(mboard) > stream_cmd.time_spec) {
+                    UHD_LOG_WARNING(LOG_ID,
+                        "The stream command reached the radios of motherboard "
+                            << mboard
+                            << " after its start time, increase the lead time.");
+                }
+            }
+        }
+    }
+
     void set_time_source(const std::string& source, const size_t mboard = ALL_MBOARDS)
     {
         MUX_MB_API_CALL(set_time_source, source);
@@ -957,13 +1025,32 @@ public:
         return *_get_rx_chan(chan).radio;
     }
 
+    /*! Return the static block chain of a radio channel
+     *
+     * The static connections are fixed by the FPGA image, and connecting or
+     * disconnecting blocks never changes them, so the chains only need to be
+     * looked up once. This keeps changing the subdev spec from walking the
+     * graph for every channel again.
+     */
+    const std::vector<graph_edge_t>& _get_block_chain(
+        const block_id_t& radio_id, const size_t block_chan, const bool source_chain)
+    {
+        const auto key = std::make_tuple(radio_id.to_string(), block_chan, source_chain);
+        auto chain_it  = _block_chains.find(key);
+        if (chain_it == _block_chains.end()) {
+            auto chain = get_block_chain(_graph, radio_id, block_chan, source_chain);
+            chain_it   = _block_chains.emplace(key, std::move(chain)).first;
+        }
+        return chain_it->second;
+    }
+
     /*******************************************************************
      * RX methods
      ******************************************************************/
     rx_chan_t _generate_rx_radio_chan(block_id_t radio_id, size_t block_chan)
     {
         auto radio_blk          = _graph->get_block<uhd::rfnoc::radio_control>(radio_id);
-        auto radio_source_chain = get_block_chain(_graph, radio_id, block_chan, true);
+        auto radio_source_chain = _get_block_chain(radio_id, block_chan, true);
 
         // Find out if we have a DDC in the radio block chain
         auto ddc_port_def = [this, radio_source_chain, radio_id, block_chan]() {
@@ -999,8 +1086,11 @@ public:
         }();
 
         // Create the RX chan
-        return rx_chan_t(
-            {radio_blk, std::get<0>(ddc_port_def), block_chan, radio_source_chain});
+        return rx_chan_t({radio_blk,
+            std::get<0>(ddc_port_def),
+            block_chan,
+            radio_source_chain,
+            radio_blk->get_property_handle<int>(PROP_KEY_SPP, block_chan)});
     }
 
     std::vector<rx_chan_t> _generate_mboard_rx_chans(
@@ -1153,9 +1243,7 @@ public:
     {
         std::lock_guard<std::recursive_mutex> l(_graph_mutex);
         MUX_RX_API_CALL(set_rx_spp, spp);
-        auto rx_chain = _get_rx_chan(chan);
-        rx_chain.radio->set_property<int>(
-            "spp", narrow_cast<int>(spp), rx_chain.block_chan);
+        _get_rx_chan(chan).spp.set(narrow_cast<int>(spp));
     }
 
     double get_rx_rate(size_t chan = 0)
@@ -1181,51 +1269,34 @@ public:
     tune_result_t set_rx_freq(const tune_request_t& tune_request, size_t chan = 0)
     {
         std::lock_guard<std::recursive_mutex> l(_graph_mutex);
+        return _set_rx_freq(tune_request, _get_rx_chan(chan));
+    }
 
-        // TODO: Add external LO warning
-
-        auto rx_chain = _get_rx_chan(chan);
-
-        rx_chain.radio->set_rx_tune_args(tune_request.args, rx_chain.block_chan);
-        //------------------------------------------------------------------
-        //-- calculate the tunable frequency ranges of the system
-        //------------------------------------------------------------------
-        freq_range_t tune_range =
-            (rx_chain.ddc)
-                ? make_overall_tune_range(
-                      rx_chain.radio->get_rx_frequency_range(rx_chain.block_chan),
-                      rx_chain.ddc->get_frequency_range(rx_chain.block_chan),
-                      rx_chain.radio->get_rx_bandwidth(rx_chain.block_chan))
-                : rx_chain.radio->get_rx_frequency_range(rx_chain.block_chan);
-
-        freq_range_t rf_range =
-            rx_chain.radio->get_rx_frequency_range(rx_chain.block_chan);
-        freq_range_t dsp_range =
-            (rx_chain.ddc) ? rx_chain.ddc->get_frequency_range(rx_chain.block_chan)
-                           : meta_range_t(0, 0);
-        // Create lambdas to feed to tune_xx_subdev_and_dsp()
-        // Note: If there is no DDC present, register empty lambdas for the DSP functions
-        auto set_rf_freq = [rx_chain](double freq) {
-            rx_chain.radio->set_rx_frequency(freq, rx_chain.block_chan);
-        };
-        auto get_rf_freq = [rx_chain](void) {
-            return rx_chain.radio->get_rx_frequency(rx_chain.block_chan);
-        };
-        auto set_dsp_freq = [rx_chain](double freq) {
-            (rx_chain.ddc) ? rx_chain.ddc->set_freq(freq, rx_chain.block_chan) : 0;
-        };
-        auto get_dsp_freq = [rx_chain](void) {
-            return (rx_chain.ddc) ? rx_chain.ddc->get_freq(rx_chain.block_chan) : 0.0;
-        };
-        return tune_xx_subdev_and_dsp(RX_SIGN,
-            tune_range,
-            rf_range,
-            dsp_range,
-            set_rf_freq,
-            get_rf_freq,
-            set_dsp_freq,
-            get_dsp_freq,
-            tune_request);
+    std::vector<tune_result_t> set_rx_freqs(const tune_request_t& tune_request,
+        const std::vector<size_t>& chans,
+        const time_spec_t& cmd_time = time_spec_t(0.0))
+    {
+        std::lock_guard<std::recursive_mutex> l(_graph_mutex);
+        std::vector<rx_chan_t> rx_chains;
+        for (const size_t chan : chans) {
+            rx_chains.push_back(_get_rx_chan(chan));
+        }
+        return _tune_chains(rx_chains, [&](const rx_chan_t& rx_chain) {
+            if (cmd_time == time_spec_t(0.0)) {
+                return _set_rx_freq(tune_request, rx_chain);
+            }
+            rx_chain.radio->set_command_time(cmd_time, rx_chain.block_chan);
+            if (rx_chain.ddc) {
+                rx_chain.ddc->set_command_time(cmd_time, rx_chain.block_chan);
+            }
+            auto clear_time = uhd::utils::scope_exit::make([&rx_chain]() {
+                rx_chain.radio->clear_command_time(rx_chain.block_chan);
+                if (rx_chain.ddc) {
+                    rx_chain.ddc->clear_command_time(rx_chain.block_chan);
+                }
+            });
+            return _set_rx_freq(tune_request, rx_chain);
+        });
     }
 
     double get_rx_freq(size_t chan = 0)
@@ -1260,6 +1331,20 @@ public:
         return rx_chain.radio->get_rx_frequency_range(rx_chain.block_chan);
     }
 
+    std::vector<double> set_rx_hop_table(
+        const std::vector<double>& freqs, size_t chan = 0)
+    {
+        std::lock_guard<std::recursive_mutex> l(_graph_mutex);
+        auto rx_chain = _get_rx_chan(chan);
+        return rx_chain.radio->set_rx_hop_table(freqs, rx_chain.block_chan);
+    }
+
+    void rx_hop(size_t index, size_t chan = 0)
+    {
+        auto rx_chain = _get_rx_chan(chan);
+        rx_chain.radio->rx_hop(index, rx_chain.block_chan);
+    }
+
     /**************************************************************************
      * LO controls
      *************************************************************************/
@@ -1588,7 +1673,7 @@ public:
     {
         auto radio_blk = _graph->get_block<uhd::rfnoc::radio_control>(radio_id);
         // Now on to the DUC chain
-        auto radio_sink_chain = get_block_chain(_graph, radio_id, block_chan, false);
+        auto radio_sink_chain = _get_block_chain(radio_id, block_chan, false);
 
         // Find out if we have a DUC in the radio block chain
         auto duc_port_def = [this, radio_sink_chain, radio_id, block_chan]() {
@@ -1800,48 +1885,34 @@ public:
     tune_result_t set_tx_freq(const tune_request_t& tune_request, size_t chan = 0)
     {
         std::lock_guard<std::recursive_mutex> l(_graph_mutex);
-        auto tx_chain = _get_tx_chan(chan);
-
-        tx_chain.radio->set_tx_tune_args(tune_request.args, tx_chain.block_chan);
-        //------------------------------------------------------------------
-        //-- calculate the tunable frequency ranges of the system
-        //------------------------------------------------------------------
-        freq_range_t tune_range =
-            (tx_chain.duc)
-                ? make_overall_tune_range(
-                      tx_chain.radio->get_tx_frequency_range(tx_chain.block_chan),
-                      tx_chain.duc->get_frequency_range(tx_chain.block_chan),
-                      tx_chain.radio->get_tx_bandwidth(tx_chain.block_chan))
-                : tx_chain.radio->get_tx_frequency_range(tx_chain.block_chan);
+        return _set_tx_freq(tune_request, _get_tx_chan(chan));
+    }
 
-        freq_range_t rf_range =
-            tx_chain.radio->get_tx_frequency_range(tx_chain.block_chan);
-        freq_range_t dsp_range =
-            (tx_chain.duc) ? tx_chain.duc->get_frequency_range(tx_chain.block_chan)
-                           : meta_range_t(0, 0);
-        // Create lambdas to feed to tune_xx_subdev_and_dsp()
-        // Note: If there is no DDC present, register empty lambdas for the DSP functions
-        auto set_rf_freq = [tx_chain](double freq) {
-            tx_chain.radio->set_tx_frequency(freq, tx_chain.block_chan);
-        };
-        auto get_rf_freq = [tx_chain](void) {
-            return tx_chain.radio->get_tx_frequency(tx_chain.block_chan);
-        };
-        auto set_dsp_freq = [tx_chain](double freq) {
-            (tx_chain.duc) ? tx_chain.duc->set_freq(freq, tx_chain.block_chan) : 0;
-        };
-        auto get_dsp_freq = [tx_chain](void) {
-            return (tx_chain.duc) ? tx_chain.duc->get_freq(tx_chain.block_chan) : 0.0;
-        };
-        return tune_xx_subdev_and_dsp(TX_SIGN,
-            tune_range,
-            rf_range,
-            dsp_range,
-            set_rf_freq,
-            get_rf_freq,
-            set_dsp_freq,
-            get_dsp_freq,
-            tune_request);
+    std::vector<tune_result_t> set_tx_freqs(const tune_request_t& tune_request,
+        const std::vector<size_t>& chans,
+        const time_spec_t& cmd_time = time_spec_t(0.0))
+    {
+        std::lock_guard<std::recursive_mutex> l(_graph_mutex);
+        std::vector<tx_chan_t> tx_chains;
+        for (const size_t chan : chans) {
+            tx_chains.push_back(_get_tx_chan(chan));
+        }
+        return _tune_chains(tx_chains, [&](const tx_chan_t& tx_chain) {
+            if (cmd_time == time_spec_t(0.0)) {
+                return _set_tx_freq(tune_request, tx_chain);
+            }
+            tx_chain.radio->set_command_time(cmd_time, tx_chain.block_chan);
+            if (tx_chain.duc) {
+                tx_chain.duc->set_command_time(cmd_time, tx_chain.block_chan);
+            }
+            auto clear_time = uhd::utils::scope_exit::make([&tx_chain]() {
+                tx_chain.radio->clear_command_time(tx_chain.block_chan);
+                if (tx_chain.duc) {
+                    tx_chain.duc->clear_command_time(tx_chain.block_chan);
+                }
+            });
+            return _set_tx_freq(tune_request, tx_chain);
+        });
     }
 
     double get_tx_freq(size_t chan = 0)
@@ -1872,6 +1943,20 @@ public:
         return tx_chain.radio->get_tx_frequency_range(tx_chain.block_chan);
     }
 
+    std::vector<double> set_tx_hop_table(
+        const std::vector<double>& freqs, size_t chan = 0)
+    {
+        std::lock_guard<std::recursive_mutex> l(_graph_mutex);
+        auto tx_chain = _get_tx_chan(chan);
+        return tx_chain.radio->set_tx_hop_table(freqs, tx_chain.block_chan);
+    }
+
+    void tx_hop(size_t index, size_t chan = 0)
+    {
+        auto tx_chain = _get_tx_chan(chan);
+        tx_chain.radio->tx_hop(index, tx_chain.block_chan);
+    }
+
     void set_tx_gain(double gain, const std::string& name, size_t chan = 0)
     {
         MUX_TX_API_CALL(set_tx_gain, gain, name);
@@ -2441,6 +2526,193 @@ private:
         return _tx_chans.at(chan);
     }
 
+    //! Tune an RX chain. The caller must hold the graph mutex.
+    tune_result_t _set_rx_freq(
+        const tune_request_t& tune_request, const rx_chan_t& rx_chain)
+    {
+        // TODO: Add external LO warning
+
+        rx_chain.radio->set_rx_tune_args(tune_request.args, rx_chain.block_chan);
+        //------------------------------------------------------------------
+        //-- calculate the tunable frequency ranges of the system
+        //------------------------------------------------------------------
+        freq_range_t tune_range =
+            (rx_chain.ddc)
+                ? make_overall_tune_range(
+                      rx_chain.radio->get_rx_frequency_range(rx_chain.block_chan),
+                      rx_chain.ddc->get_frequency_range(rx_chain.block_chan),
+                      rx_chain.radio->get_rx_bandwidth(rx_chain.block_chan))
+                : rx_chain.radio->get_rx_frequency_range(rx_chain.block_chan);
+
+        freq_range_t rf_range =
+            rx_chain.radio->get_rx_frequency_range(rx_chain.block_chan);
+        freq_range_t dsp_range =
+            (rx_chain.ddc) ? rx_chain.ddc->get_frequency_range(rx_chain.block_chan)
+                           : meta_range_t(0, 0);
+        // Create lambdas to feed to tune_xx_subdev_and_dsp()
+        // Note: If there is no DDC present, register empty lambdas for the DSP functions
+        auto set_rf_freq = [rx_chain](double freq) {
+            rx_chain.radio->set_rx_frequency(freq, rx_chain.block_chan);
+        };
+        auto get_rf_freq = [rx_chain](void) {
+            return rx_chain.radio->get_rx_frequency(rx_chain.block_chan);
+        };
+        auto set_dsp_freq = [rx_chain](double freq) {
+            (rx_chain.ddc) ? rx_chain.ddc->set_freq(freq, rx_chain.block_chan) : 0;
+        };
+        auto get_dsp_freq = [rx_chain](void) {
+            return (rx_chain.ddc) ? rx_chain.ddc->get_freq(rx_chain.block_chan) : 0.0;
+        };
+        return tune_xx_subdev_and_dsp(RX_SIGN,
+            tune_range,
+            rf_range,
+            dsp_range,
+            set_rf_freq,
+            get_rf_freq,
+            set_dsp_freq,
+            get_dsp_freq,
+            tune_request);
+    }
+
+    //! Tune a TX chain. The caller must hold the graph mutex.
+    tune_result_t _set_tx_freq(
+        const tune_request_t& tune_request, const tx_chan_t& tx_chain)
+    {
+        tx_chain.radio->set_tx_tune_args(tune_request.args, tx_chain.block_chan);
+        //------------------------------------------------------------------
+        //-- calculate the tunable frequency ranges of the system
+        //------------------------------------------------------------------
+        freq_range_t tune_range =
+            (tx_chain.duc)
+                ? make_overall_tune_range(
+                      tx_chain.radio->get_tx_frequency_range(tx_chain.block_chan),
+                      tx_chain.duc->get_frequency_range(tx_chain.block_chan),
+                      tx_chain.radio->get_tx_bandwidth(tx_chain.block_chan))
+                : tx_chain.radio->get_tx_frequency_range(tx_chain.block_chan);
+
+        freq_range_t rf_range =
+            tx_chain.radio->get_tx_frequency_range(tx_chain.block_chan);
+        freq_range_t dsp_range =
+            (tx_chain.duc) ? tx_chain.duc->get_frequency_range(tx_chain.block_chan)
+                           : meta_range_t(0, 0);
+        // Create lambdas to feed to tune_xx_subdev_and_dsp()
+        // Note: If there is no DDC present, register empty lambdas for the DSP functions
+        auto set_rf_freq = [tx_chain](double freq) {
+            tx_chain.radio->set_tx_frequency(freq, tx_chain.block_chan);
+        };
+        auto get_rf_freq = [tx_chain](void) {
+            return tx_chain.radio->get_tx_frequency(tx_chain.block_chan);
+        };
+        auto set_dsp_freq = [tx_chain](double freq) {
+            (tx_chain.duc) ? tx_chain.duc->set_freq(freq, tx_chain.block_chan) : 0;
+        };
+        auto get_dsp_freq = [tx_chain](void) {
+            return (tx_chain.duc) ? tx_chain.duc->get_freq(tx_chain.block_chan) : 0.0;
+        };
+        return tune_xx_subdev_and_dsp(TX_SIGN,
+            tune_range,
+            rf_range,
+            dsp_range,
+            set_rf_freq,
+            get_rf_freq,
+            set_dsp_freq,
+            get_dsp_freq,
+            tune_request);
+    }
+
+    /*! Run \p tune on every chain of \p chains
+     *
+     * The chains of each device are tuned in a thread of their own, so tunes
+     * on different devices don't wait for each other's control transactions.
+     *
+     * \return the tune results, in the order of \p chains
+     */
+    template <typename chan_t, typename tune_fn_t>
+    std::vector<tune_result_t> _tune_chains(
+        const std::vector<chan_t>& chains, tune_fn_t&& tune)
+    {
+        // Device number -> indexes into chains
+        std::map<size_t, std::vector<size_t>> device_chains;
+        for (size_t i = 0; i < chains.size(); i++) {
+            device_chains[chains[i].radio->get_block_id().get_device_no()].push_back(i);
+        }
+        std::vector<tune_result_t> results(chains.size());
+        auto tune_device = [&](const std::vector<size_t>& indexes) {
+            for (const size_t i : indexes) {
+                results[i] = tune(chains[i]);
+            }
+        };
+        if (device_chains.size() <= 1) {
+            for (const auto& device : device_chains) {
+                tune_device(device.second);
+            }
+            return results;
+        }
+        std::vector<std::future<void>> tune_futures;
+        for (const auto& device : device_chains) {
+            tune_futures.push_back(
+                std::async(std::launch::async, tune_device, std::cref(device.second)));
+        }
+        // Rethrows the first failure, after all of them are done
+        for (auto& tune_future : tune_futures) {
+            tune_future.wait();
+        }
+        for (auto& tune_future : tune_futures) {
+            tune_future.get();
+        }
+        return results;
+    }
+
+    /*! Run \p fn for every motherboard, with the motherboard index
+     *
+     * Each motherboard gets a thread of its own, so the calls don't wait for
+     * each other's control transactions.
+     */
+    template <typename mboard_fn_t>
+    void _for_each_mboard(mboard_fn_t&& fn)
+    {
+        const size_t num_mboards = get_num_mboards();
+        if (num_mboards <= 1) {
+            for (size_t m = 0; m < num_mboards; m++) {
+                fn(m);
+            }
+            return;
+        }
+        std::vector<std::future<void>> mboard_futures;
+        for (size_t m = 0; m < num_mboards; m++) {
+            mboard_futures.push_back(std::async(std::launch::async, std::ref(fn), m));
+        }
+        // Rethrows the first failure, after all of them are done
+        for (auto& mboard_future : mboard_futures) {
+            mboard_future.wait();
+        }
+        for (auto& mboard_future : mboard_futures) {
+            mboard_future.get();
+        }
+    }
+
+    /*! Wait for the time of the last PPS on board 0 to change from \p last_pps
+     *
+     * \return the time of the new PPS edge
+     * \throws uhd::runtime_error if there's no edge within \p timeout
+     */
+    time_spec_t _wait_for_pps(
+        const time_spec_t& last_pps, const std::chrono::milliseconds timeout)
+    {
+        const auto end_time      = std::chrono::steady_clock::now() + timeout;
+        time_spec_t new_last_pps = get_time_last_pps();
+        while (new_last_pps == last_pps) {
+            if (std::chrono::steady_clock::now() > end_time) {
+                throw uhd::runtime_error("Board 0 may not be getting a PPS signal!\n"
+                                         "No PPS detected within the time interval.\n"
+                                         "See the application notes for your device.\n");
+            }
+            std::this_thread::sleep_for(1ms);
+            new_last_pps = get_time_last_pps();
+        }
+        return new_last_pps;
+    }
+
     void _connect_rx_chain(size_t chan)
     {
         auto rx_chan = _rx_chans.at(chan);
@@ -2525,6 +2797,29 @@ private:
         }
     }
 
+    /*! Tell the graph the sample rate of a new streamer
+     *
+     * The graph uses the samp_rate stream arg to put the streamer on the link
+     * with the most bandwidth left. It's the highest rate of the channels,
+     * unless the user set it.
+     */
+    static void _set_samp_rate_hint(
+        stream_args_t& args, const std::unordered_map<size_t, double>& rates)
+    {
+        if (args.args.has_key("samp_rate")) {
+            return;
+        }
+        double rate = 0.0;
+        for (const size_t chan : args.channels) {
+            if (rates.count(chan)) {
+                rate = std::max(rate, rates.at(chan));
+            }
+        }
+        if (rate > 0.0) {
+            args.args["samp_rate"] = std::to_string(rate);
+        }
+    }
+
     /**************************************************************************
      * Private Attributes
      *************************************************************************/
@@ -2538,6 +2833,9 @@ private:
     std::unordered_map<size_t, rx_chan_t> _rx_chans;
     //! Mapping between channel number and the RFNoC blocks in that TX chain
     std::unordered_map<size_t, tx_chan_t> _tx_chans;
+    //! Static block chains by (radio block, port, source chain), see _get_block_chain()
+    std::map<std::tuple<std::string, size_t, bool>, std::vector<graph_edge_t>>
+        _block_chains;
     //! Cache the requested RX rates
     std::unordered_map<size_t, double> _rx_rates;
     //! Cache the requested TX rates
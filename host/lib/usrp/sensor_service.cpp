@@ -0,0 +1,289 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/rfnoc/mb_controller.hpp>
+#include <uhd/usrp/sensor_service.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/thread.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace uhd;
+using namespace uhd::usrp;
+
+sensor_service::~sensor_service(void)
+{
+    /* NOP */
+}
+
+namespace {
+
+constexpr char LOG_ID[] = "SENSORS";
+
+std::string type_to_string(const sensor_service::sensor_type_t type)
+{
+    switch (type) {
+        case sensor_service::MBOARD:
+            return "mboard";
+        case sensor_service::RX:
+            return "RX";
+        case sensor_service::TX:
+            return "TX";
+    }
+    return "";
+}
+
+} // namespace
+
+class sensor_service_impl : public sensor_service
+{
+public:
+    sensor_service_impl(multi_usrp::sptr usrp) : _usrp(usrp)
+    {
+        _poll_thread = std::thread([this]() { poll_loop(); });
+        uhd::set_thread_name(&_poll_thread, "uhd_sensors");
+    }
+
+    ~sensor_service_impl()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _cond.notify_one();
+        _poll_thread.join();
+    }
+
+    subscription_id_t subscribe(const sensor_type_t type,
+        const std::string& name,
+        const double rate,
+        const size_t idx)
+    {
+        if (!(rate > 0.0)) {
+            throw uhd::value_error("sensor_service: Rate must be positive!");
+        }
+        const sensor_key_t key{type, name, idx};
+        std::lock_guard<std::mutex> lock(_mutex);
+        const subscription_id_t id = _next_id++;
+        _subscriptions.insert({id, subscription_t{key, rate}});
+        if (!_sensors.count(key)) {
+            // Read new sensors right away
+            _sensors[key].next_read = clock_type::now();
+        }
+        update_period(key);
+        _cond.notify_one();
+        return id;
+    }
+
+    void unsubscribe(const subscription_id_t id)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto subscription = _subscriptions.find(id);
+        if (subscription == _subscriptions.end()) {
+            throw uhd::key_error(
+                "sensor_service: Invalid subscription ID " + std::to_string(id));
+        }
+        const sensor_key_t key = subscription->second.key;
+        _subscriptions.erase(subscription);
+        update_period(key);
+    }
+
+    boost::optional<sensor_reading_t> get_reading(
+        const sensor_type_t type, const std::string& name, const size_t idx)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto sensor = _sensors.find(sensor_key_t{type, name, idx});
+        if (sensor == _sensors.end()) {
+            return boost::none;
+        }
+        return sensor->second.reading;
+    }
+
+private:
+    using sensor_key_t = std::tuple<sensor_type_t, std::string, size_t>;
+
+    struct subscription_t
+    {
+        sensor_key_t key;
+        double rate;
+    };
+
+    struct sensor_state_t
+    {
+        clock_type::duration period;
+        clock_type::time_point next_read;
+        boost::optional<sensor_reading_t> reading;
+    };
+
+    /*! Set the period of a sensor from its fastest subscription, or stop
+     *  polling it if there are none left. Call with _mutex held.
+     */
+    void update_period(const sensor_key_t& key)
+    {
+        double max_rate = 0.0;
+        for (const auto& subscription : _subscriptions) {
+            if (subscription.second.key == key) {
+                max_rate = std::max(max_rate, subscription.second.rate);
+            }
+        }
+        if (max_rate == 0.0) {
+            _sensors.erase(key);
+            return;
+        }
+        _sensors.at(key).period = std::chrono::duration_cast<clock_type::duration>(
+            std::chrono::duration<double>(1.0 / max_rate));
+    }
+
+    void poll_loop()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (!_stop) {
+            const auto now = clock_type::now();
+            std::vector<sensor_key_t> due_sensors;
+            auto next_wakeup = clock_type::time_point::max();
+            for (auto& sensor : _sensors) {
+                if (sensor.second.next_read <= now) {
+                    due_sensors.push_back(sensor.first);
+                    // Don't try to catch up on missed reads
+                    sensor.second.next_read =
+                        std::max(sensor.second.next_read + sensor.second.period,
+                            now + sensor.second.period / 2);
+                }
+                next_wakeup = std::min(next_wakeup, sensor.second.next_read);
+            }
+            if (due_sensors.empty()) {
+                if (next_wakeup == clock_type::time_point::max()) {
+                    _cond.wait(lock);
+                } else {
+                    _cond.wait_until(lock, next_wakeup);
+                }
+                continue;
+            }
+
+            // Don't block readers while talking to the device
+            lock.unlock();
+            const auto readings = read_sensors(due_sensors);
+            lock.lock();
+            for (const auto& reading : readings) {
+                // The sensor may have been unsubscribed in the meantime
+                auto sensor = _sensors.find(reading.first);
+                if (sensor != _sensors.end()) {
+                    sensor->second.reading = reading.second;
+                }
+            }
+        }
+    }
+
+    /*! Read a list of sensors
+     *
+     * Motherboard sensors are read one motherboard at a time. Sensors that
+     * can't be read are logged and skipped.
+     */
+    std::vector<std::pair<sensor_key_t, sensor_reading_t>> read_sensors(
+        const std::vector<sensor_key_t>& keys)
+    {
+        std::vector<std::pair<sensor_key_t, sensor_reading_t>> readings;
+        std::map<size_t, std::vector<std::string>> mboard_sensors;
+        for (const auto& key : keys) {
+            if (std::get<0>(key) == MBOARD) {
+                mboard_sensors[std::get<2>(key)].push_back(std::get<1>(key));
+                continue;
+            }
+            try {
+                const sensor_value_t value =
+                    (std::get<0>(key) == RX)
+                        ? _usrp->get_rx_sensor(std::get<1>(key), std::get<2>(key))
+                        : _usrp->get_tx_sensor(std::get<1>(key), std::get<2>(key));
+                readings.push_back({key, sensor_reading_t{value, clock_type::now()}});
+            } catch (const uhd::exception& ex) {
+                log_read_error(key, ex);
+            }
+        }
+
+        for (const auto& mboard : mboard_sensors) {
+            const size_t mb_idx = mboard.first;
+            const auto& names   = mboard.second;
+            try {
+                const auto values = read_mboard_sensors(mb_idx, names);
+                const auto now    = clock_type::now();
+                for (size_t i = 0; i < names.size(); i++) {
+                    readings.push_back(
+                        {sensor_key_t{MBOARD, names[i], mb_idx}, {values.at(i), now}});
+                }
+            } catch (const uhd::exception&) {
+                // Find out which sensor failed by reading them one by one
+                for (const auto& name : names) {
+                    const sensor_key_t key{MBOARD, name, mb_idx};
+                    try {
+                        readings.push_back(
+                            {key, {_usrp->get_mboard_sensor(name, mb_idx),
+                                         clock_type::now()}});
+                    } catch (const uhd::exception& ex) {
+                        log_read_error(key, ex);
+                    }
+                }
+            }
+        }
+        return readings;
+    }
+
+    std::vector<sensor_value_t> read_mboard_sensors(
+        const size_t mb_idx, const std::vector<std::string>& names)
+    {
+        if (_has_mb_controller) {
+            try {
+                return _usrp->get_mb_controller(mb_idx).get_sensors(names);
+            } catch (const uhd::not_implemented_error&) {
+                // Not an RFNoC device
+                _has_mb_controller = false;
+            }
+        }
+        std::vector<sensor_value_t> values;
+        for (const auto& name : names) {
+            values.push_back(_usrp->get_mboard_sensor(name, mb_idx));
+        }
+        return values;
+    }
+
+    //! Log a failed read, but only once per sensor
+    void log_read_error(const sensor_key_t& key, const uhd::exception& ex)
+    {
+        if (_failed_sensors.insert(key).second) {
+            UHD_LOG_WARNING(LOG_ID,
+                "Failed to read " << type_to_string(std::get<0>(key)) << " sensor `"
+                                  << std::get<1>(key) << "' (" << std::get<2>(key)
+                                  << "): " << ex.what());
+        }
+    }
+
+    multi_usrp::sptr _usrp;
+
+    //! Protects all members below, except for those used by the poll thread only
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    bool _stop                 = false;
+    subscription_id_t _next_id = 0;
+    std::map<subscription_id_t, subscription_t> _subscriptions;
+    std::map<sensor_key_t, sensor_state_t> _sensors;
+
+    // Only used by the poll thread
+    bool _has_mb_controller = true;
+    std::set<sensor_key_t> _failed_sensors;
+
+    std::thread _poll_thread;
+};
+
+sensor_service::sptr sensor_service::make(multi_usrp::sptr usrp)
+{
+    return std::make_shared<sensor_service_impl>(usrp);
+}
@@ -16,6 +16,7 @@
 #include <uhd/utils/platform.hpp>
 #include <uhd/utils/safe_call.hpp>
 #include <uhd/utils/tasks.hpp>
+#include <uhdlib/utils/periodic_task.hpp>
 #include <boost/asio.hpp> //used for htonl and ntohl
 #include <boost/assign/list_of.hpp>
 #include <boost/filesystem.hpp>
@@ -35,6 +36,8 @@ namespace fs = boost::filesystem;
 
 static const double CTRL_RECV_TIMEOUT = 1.0;
 static const size_t CTRL_RECV_RETRIES = 3;
+//! How often to renew the lock of the device
+static const std::chrono::milliseconds RELOCK_PERIOD(1500);
 
 // custom timeout error for retry logic to catch/retry
 struct timeout_error : uhd::runtime_error
@@ -89,7 +92,8 @@ public:
     {
         if (lock) {
             this->pokefw(U2_FW_REG_LOCK_GPID, get_process_hash());
-            _lock_task = task::make(std::bind(&usrp2_iface_impl::lock_task, this));
+            _lock_task = make_periodic_task(
+                std::bind(&usrp2_iface_impl::lock_task, this), RELOCK_PERIOD);
         } else {
             _lock_task.reset(); // shutdown the task
             this->pokefw(U2_FW_REG_LOCK_TIME, 0); // unlock
@@ -123,8 +127,6 @@ public:
     {
         // re-lock in task
         this->pokefw(U2_FW_REG_LOCK_TIME, this->get_curr_time());
-        // sleep for a bit
-        std::this_thread::sleep_for(std::chrono::milliseconds(1500));
     }
 
     uint32_t get_curr_time(void)
@@ -58,6 +58,8 @@ struct uhd_tx_streamer
 {
     size_t usrp_index;
     uhd::tx_streamer::sptr streamer;
+    //! Saves a virtual call per send
+    size_t num_channels;
     std::string last_error;
 };
 
@@ -65,6 +67,8 @@ struct uhd_rx_streamer
 {
     size_t usrp_index;
     uhd::rx_streamer::sptr streamer;
+    //! Saves a virtual call per recv
+    size_t num_channels;
     std::string last_error;
 };
 
@@ -125,6 +129,42 @@ uhd_error uhd_rx_streamer_recv(uhd_rx_streamer_handle h,
             buffs_cpp, samps_per_buff, (*md)->rx_metadata_cpp, timeout, one_packet);)
 }
 
+uhd_error uhd_rx_streamer_recv_fast(uhd_rx_streamer_handle h,
+    void** buffs,
+    size_t samps_per_buff,
+    uhd_rx_metadata_handle* md,
+    double timeout,
+    bool one_packet,
+    size_t* items_recvd)
+{
+    UHD_SAFE_C_SAVE_ERROR_FAST(
+        h, const uhd::rx_streamer::buffs_type buffs_cpp(buffs, h->num_channels);
+        *items_recvd = h->streamer->recv(
+            buffs_cpp, samps_per_buff, (*md)->rx_metadata_cpp, timeout, one_packet);)
+}
+
+uhd_error uhd_rx_streamer_recv_batch(uhd_rx_streamer_handle h,
+    void*** buffs,
+    size_t num_batches,
+    size_t samps_per_buff,
+    uhd_rx_metadata_handle* md,
+    double timeout,
+    size_t* items_recvd,
+    size_t* num_batches_recvd)
+{
+    UHD_SAFE_C_SAVE_ERROR_FAST(
+        h, *num_batches_recvd = 0; for (size_t i = 0; i < num_batches; i++) {
+            const uhd::rx_streamer::buffs_type buffs_cpp(buffs[i], h->num_channels);
+            uhd::rx_metadata_t& md_cpp = md[i]->rx_metadata_cpp;
+            items_recvd[i] =
+                h->streamer->recv(buffs_cpp, samps_per_buff, md_cpp, timeout, false);
+            if (md_cpp.error_code != uhd::rx_metadata_t::ERROR_CODE_NONE) {
+                break;
+            }
+            (*num_batches_recvd)++;
+        })
+}
+
 uhd_error uhd_rx_streamer_issue_stream_cmd(
     uhd_rx_streamer_handle h, const uhd_stream_cmd_t* stream_cmd)
 {
@@ -135,8 +175,10 @@ uhd_error uhd_rx_streamer_issue_stream_cmd(
 uhd_error uhd_rx_streamer_last_error(
     uhd_rx_streamer_handle h, char* error_out, size_t strbuffer_len)
 {
-    UHD_SAFE_C(memset(error_out, '\0', strbuffer_len);
-               strncpy(error_out, h->last_error.c_str(), strbuffer_len);)
+    // The fast streaming calls leave the error empty on success
+    UHD_SAFE_C(memset(error_out, '\0', strbuffer_len); strncpy(error_out,
+                   h->last_error.empty() ? "None" : h->last_error.c_str(),
+                   strbuffer_len);)
 }
 
 /****************************************************************************
@@ -180,6 +222,40 @@ uhd_error uhd_tx_streamer_send(uhd_tx_streamer_handle h,
             buffs_cpp, samps_per_buff, (*md)->tx_metadata_cpp, timeout);)
 }
 
+uhd_error uhd_tx_streamer_send_fast(uhd_tx_streamer_handle h,
+    const void** buffs,
+    size_t samps_per_buff,
+    uhd_tx_metadata_handle* md,
+    double timeout,
+    size_t* items_sent)
+{
+    UHD_SAFE_C_SAVE_ERROR_FAST(
+        h, const uhd::tx_streamer::buffs_type buffs_cpp(buffs, h->num_channels);
+        *items_sent = h->streamer->send(
+            buffs_cpp, samps_per_buff, (*md)->tx_metadata_cpp, timeout);)
+}
+
+uhd_error uhd_tx_streamer_send_batch(uhd_tx_streamer_handle h,
+    const void*** buffs,
+    size_t num_batches,
+    size_t samps_per_buff,
+    uhd_tx_metadata_handle* md,
+    double timeout,
+    size_t* items_sent,
+    size_t* num_batches_sent)
+{
+    UHD_SAFE_C_SAVE_ERROR_FAST(
+        h, *num_batches_sent = 0; for (size_t i = 0; i < num_batches; i++) {
+            const uhd::tx_streamer::buffs_type buffs_cpp(buffs[i], h->num_channels);
+            items_sent[i] = h->streamer->send(
+                buffs_cpp, samps_per_buff, md[i]->tx_metadata_cpp, timeout);
+            if (items_sent[i] < samps_per_buff) {
+                break;
+            }
+            (*num_batches_sent)++;
+        })
+}
+
 uhd_error uhd_tx_streamer_recv_async_msg(uhd_tx_streamer_handle h,
     uhd_async_metadata_handle* md,
     const double timeout,
@@ -192,8 +268,10 @@ uhd_error uhd_tx_streamer_recv_async_msg(uhd_tx_streamer_handle h,
 uhd_error uhd_tx_streamer_last_error(
     uhd_tx_streamer_handle h, char* error_out, size_t strbuffer_len)
 {
-    UHD_SAFE_C(memset(error_out, '\0', strbuffer_len);
-               strncpy(error_out, h->last_error.c_str(), strbuffer_len);)
+    // The fast streaming calls leave the error empty on success
+    UHD_SAFE_C(memset(error_out, '\0', strbuffer_len); strncpy(error_out,
+                   h->last_error.empty() ? "None" : h->last_error.c_str(),
+                   strbuffer_len);)
 }
 
 /****************************************************************************
@@ -266,8 +344,9 @@ uhd_error uhd_usrp_get_rx_stream(
         }
 
         usrp_ptr& usrp  = get_usrp_ptrs()[h_u->usrp_index];
-        h_s->streamer   = usrp.ptr->get_rx_stream(stream_args_c_to_cpp(stream_args));
-        h_s->usrp_index = h_u->usrp_index;)
+        h_s->streamer     = usrp.ptr->get_rx_stream(stream_args_c_to_cpp(stream_args));
+        h_s->num_channels = h_s->streamer->get_num_channels();
+        h_s->usrp_index   = h_u->usrp_index;)
 }
 
 static boost::mutex _usrp_get_tx_stream_mutex;
@@ -283,8 +362,9 @@ uhd_error uhd_usrp_get_tx_stream(
         }
 
         usrp_ptr& usrp  = get_usrp_ptrs()[h_u->usrp_index];
-        h_s->streamer   = usrp.ptr->get_tx_stream(stream_args_c_to_cpp(stream_args));
-        h_s->usrp_index = h_u->usrp_index;)
+        h_s->streamer     = usrp.ptr->get_tx_stream(stream_args_c_to_cpp(stream_args));
+        h_s->num_channels = h_s->streamer->get_num_channels();
+        h_s->usrp_index   = h_u->usrp_index;)
 }
 
 /****************************************************************************
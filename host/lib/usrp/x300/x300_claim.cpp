@@ -17,12 +17,6 @@ using namespace uhd::usrp::x300;
  * claimer logic
  **********************************************************************/
 
-void uhd::usrp::x300::claimer_loop(wb_iface::sptr iface)
-{
-    claim(iface);
-    std::this_thread::sleep_for(std::chrono::seconds(1));
-}
-
 claim_status_t uhd::usrp::x300::claim_status(wb_iface::sptr iface)
 {
     claim_status_t claim_status = CLAIMED_BY_OTHER; // Default to most restrictive
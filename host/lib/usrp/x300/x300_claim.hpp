@@ -15,7 +15,6 @@ namespace uhd { namespace usrp { namespace x300 {
 enum claim_status_t { UNCLAIMED, CLAIMED_BY_US, CLAIMED_BY_OTHER };
 
 claim_status_t claim_status(uhd::wb_iface::sptr iface);
-void claimer_loop(uhd::wb_iface::sptr iface);
 void claim(uhd::wb_iface::sptr iface);
 bool try_to_claim(uhd::wb_iface::sptr iface, long timeout = 2000);
 void release(uhd::wb_iface::sptr iface);
@@ -75,6 +75,11 @@ public:
     void write_spi(
         unit_t unit, const uhd::spi_config_t& config, uint32_t data, size_t num_bits);
 
+    void write_spi_batch(unit_t unit,
+        const uhd::spi_config_t& config,
+        const std::vector<uint32_t>& data,
+        size_t num_bits);
+
     uint32_t read_write_spi(
         unit_t unit, const uhd::spi_config_t& config, uint32_t data, size_t num_bits);
     void set_fe_connection(
@@ -94,6 +99,7 @@ private:
     uhd::dict<unit_t, double> _clock_rates;
     uhd::dict<std::string, rx_frontend_core_3000::sptr> _rx_fes;
     void _write_aux_dac(unit_t);
+    int _get_spi_slave(unit_t);
 };
 
 
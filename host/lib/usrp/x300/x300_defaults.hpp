@@ -55,6 +55,11 @@ static constexpr double THREAD_BUFFER_TIMEOUT       = 0.1; // Time in seconds
 
 static constexpr double DEFAULT_EXT_ADC_SELF_TEST_DURATION = 30.0;
 
+//! Number of firmware control transactions that may be in flight over Ethernet
+static constexpr size_t DEFAULT_FW_CTRL_WINDOW = 16;
+//! The firmware's ingress FIFO holds about 100 transactions, stay well below that
+static constexpr size_t MAX_FW_CTRL_WINDOW = 32;
+
 }}} /* namespace uhd::usrp::x300 */
 
 #endif /* INCLUDED_X300_DEFAULTS_HPP */
@@ -37,10 +37,13 @@ public:
         , _blank_eeprom("blank_eeprom", false)
         , _enable_tx_dual_eth("enable_tx_dual_eth", false)
         , _use_dpdk("use_dpdk", false)
+        , _use_xdp("use_xdp", false)
+        , _use_rio("use_rio", false)
         , _fpga_option("fpga", "")
         , _download_fpga("download-fpga", false)
         , _recv_frame_size("recv_frame_size", DATA_FRAME_MAX_SIZE)
         , _send_frame_size("send_frame_size", DATA_FRAME_MAX_SIZE)
+        , _fw_ctrl_window("fw_ctrl_window", DEFAULT_FW_CTRL_WINDOW)
     {
         // nop
     }
@@ -125,6 +128,14 @@ public:
     {
         return _use_dpdk.get();
     }
+    bool get_use_xdp() const
+    {
+        return _use_xdp.get();
+    }
+    bool get_use_rio() const
+    {
+        return _use_rio.get();
+    }
     std::string get_fpga_option() const
     {
         return _fpga_option.get();
@@ -141,6 +152,10 @@ public:
     {
         return _send_frame_size.get();
     }
+    size_t get_fw_ctrl_window() const
+    {
+        return _fw_ctrl_window.get();
+    }
     device_addr_t get_orig_args() const
     {
         return _orig_args;
@@ -181,7 +196,10 @@ public:
                + (_enable_tx_dual_eth.get() ? (_enable_tx_dual_eth.to_string() + ", ")
                                             : "")
                + (_fpga_option.get().empty() ? "" : _fpga_option.to_string() + ", ")
-               + (_download_fpga.get() ? _download_fpga.to_string() + ", " : "");
+               + (_download_fpga.get() ? _download_fpga.to_string() + ", " : "")
+               + (_fw_ctrl_window.get() != DEFAULT_FW_CTRL_WINDOW
+                         ? _fw_ctrl_window.to_string() + ", "
+                         : "");
     }
 
 private:
@@ -258,16 +276,34 @@ private:
 #else
             UHD_LOG_WARNING(
                 "DPDK", "Detected use_dpdk argument, but DPDK support not built in.");
+#endif
+        }
+        if (dev_args.has_key("use_xdp")) {
+#ifdef HAVE_AF_XDP
+            _use_xdp.set(true);
+#else
+            UHD_LOG_WARNING(
+                "X300", "Detected use_xdp argument, but AF_XDP support not built in.");
+#endif
+        }
+        if (dev_args.has_key("use_rio")) {
+#ifdef HAVE_RIO
+            _use_rio.set(true);
+#else
+            UHD_LOG_WARNING(
+                "X300", "Detected use_rio argument, but RIO support not built in.");
 #endif
         }
         PARSE_DEFAULT(_recv_frame_size)
         PARSE_DEFAULT(_send_frame_size)
+        PARSE_DEFAULT(_fw_ctrl_window)
 
         // Sanity check params
         _enforce_range(_master_clock_rate, MIN_TICK_RATE, MAX_TICK_RATE);
         _enforce_discrete(_system_ref_rate, EXTERNAL_FREQ_OPTIONS);
         _enforce_discrete(_clock_source, CLOCK_SOURCE_OPTIONS);
         _enforce_discrete(_time_source, TIME_SOURCE_OPTIONS);
+        _enforce_range(_fw_ctrl_window, size_t(1), MAX_FW_CTRL_WINDOW);
         // TODO: If _fw_file is set, make sure it's actually a file
     }
 
@@ -290,10 +326,13 @@ private:
     constrained_device_args_t::bool_arg _blank_eeprom;
     constrained_device_args_t::bool_arg _enable_tx_dual_eth;
     constrained_device_args_t::bool_arg _use_dpdk;
+    constrained_device_args_t::bool_arg _use_xdp;
+    constrained_device_args_t::bool_arg _use_rio;
     constrained_device_args_t::str_arg<true> _fpga_option;
     constrained_device_args_t::bool_arg _download_fpga;
     constrained_device_args_t::num_arg<size_t> _recv_frame_size;
     constrained_device_args_t::num_arg<size_t> _send_frame_size;
+    constrained_device_args_t::num_arg<size_t> _fw_ctrl_window;
 
     device_addr_t _orig_args;
 };
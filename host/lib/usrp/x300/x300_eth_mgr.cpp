@@ -24,16 +24,24 @@
 #include <uhdlib/rfnoc/rfnoc_common.hpp>
 #include <uhdlib/transport/udp_boost_asio_link.hpp>
 #include <uhdlib/transport/udp_common.hpp>
+#include <uhdlib/transport/udp_link_qualification.hpp>
 #include <uhdlib/usrp/cores/i2c_core_100_wb32.hpp>
 #ifdef HAVE_DPDK
 #    include <uhdlib/transport/dpdk_simple.hpp>
 #    include <uhdlib/transport/udp_dpdk_link.hpp>
 #endif
+#ifdef HAVE_AF_XDP
+#    include <uhdlib/transport/udp_xdp_link.hpp>
+#endif
+#ifdef HAVE_RIO
+#    include <uhdlib/transport/udp_rio_link.hpp>
+#endif
 #include <boost/asio.hpp>
 #include <string>
 
-uhd::wb_iface::sptr x300_make_ctrl_iface_enet(
-    uhd::transport::udp_simple::sptr udp, bool enable_errors = true);
+uhd::wb_iface::sptr x300_make_ctrl_iface_enet(uhd::transport::udp_simple::sptr udp,
+    bool enable_errors  = true,
+    const size_t window = 1);
 
 using namespace uhd;
 using namespace uhd::usrp;
@@ -257,13 +265,28 @@ both_links_t eth_manager::get_links(link_type_t link_type,
             default_link_params.recv_frame_size;
     }
 #endif
+#ifdef HAVE_AF_XDP
+    // AF_XDP sockets are only used for data links
+    const bool use_xdp = _args.get_use_xdp()
+                         and (link_type == link_type_t::TX_DATA
+                              or link_type == link_type_t::RX_DATA);
+    if (use_xdp) {
+        default_link_params.send_frame_size =
+            std::min(default_link_params.send_frame_size, XDP_MAX_FRAME_SIZE);
+        default_link_params.recv_frame_size =
+            std::min(default_link_params.recv_frame_size, XDP_MAX_FRAME_SIZE);
+        default_link_params.num_recv_frames = default_link_params.recv_buff_size
+                                              / default_link_params.recv_frame_size;
+    }
+#endif
 
     link_params_t link_params = calculate_udp_link_params(link_type,
         get_mtu(uhd::TX_DIRECTION),
         get_mtu(uhd::RX_DIRECTION),
         default_link_params,
         _args.get_orig_args(),
-        link_args);
+        link_args,
+        conn.link_rate);
 
     // Enforce a minimum bound of the number of receive and send frames.
     link_params.num_send_frames =
@@ -285,6 +308,45 @@ both_links_t eth_manager::get_links(link_type_t link_type,
         UHD_LOG_WARNING("X300", "Cannot create DPDK transport, falling back to UDP");
 #endif
     }
+#ifdef HAVE_AF_XDP
+    if (use_xdp) {
+        auto link = uhd::transport::udp_xdp_link::make(conn.addr,
+            BOOST_STRINGIZE(X300_VITA_UDP_PORT),
+            link_params,
+            _args.get_orig_args());
+        return std::make_tuple(link,
+            link_params.send_buff_size,
+            link,
+            link_params.recv_buff_size,
+            true,
+            true);
+    }
+#endif
+#ifdef HAVE_RIO
+    // RIO sockets are only used for data links
+    if (_args.get_use_rio()
+        and (link_type == link_type_t::TX_DATA or link_type == link_type_t::RX_DATA)) {
+        auto link = uhd::transport::udp_rio_link::make(conn.addr,
+            BOOST_STRINGIZE(X300_VITA_UDP_PORT),
+            link_params,
+            link_params.recv_buff_size,
+            link_params.send_buff_size);
+        return std::make_tuple(link,
+            link_params.send_buff_size,
+            link,
+            link_params.recv_buff_size,
+            true,
+            false);
+    }
+#endif
+    if (link_type == link_type_t::RX_DATA) {
+        link_params = qualify_udp_rx_link(conn.addr,
+            BOOST_STRINGIZE(X300_VITA_UDP_PORT),
+            link_params,
+            conn.link_rate,
+            _args.get_orig_args(),
+            link_args);
+    }
     auto link = uhd::transport::udp_boost_asio_link::make(conn.addr,
         BOOST_STRINGIZE(X300_VITA_UDP_PORT),
         link_params,
@@ -299,8 +361,10 @@ both_links_t eth_manager::get_links(link_type_t link_type,
  *****************************************************************************/
 wb_iface::sptr eth_manager::get_ctrl_iface()
 {
-    return x300_make_ctrl_iface_enet(_x300_make_udp_connected(
-        get_pri_eth().addr, BOOST_STRINGIZE(X300_FW_COMMS_UDP_PORT)));
+    return x300_make_ctrl_iface_enet(_x300_make_udp_connected(get_pri_eth().addr,
+                                         BOOST_STRINGIZE(X300_FW_COMMS_UDP_PORT)),
+        true,
+        _args.get_fw_ctrl_window());
 }
 
 // - Populates _max_frame_sizes
@@ -14,10 +14,13 @@
 #include <uhd/types/wb_iface.hpp>
 #include <uhd/utils/byteswap.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhd/utils/safe_call.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/format.hpp>
 #include <boost/thread/mutex.hpp>
+#include <algorithm>
 #include <chrono>
+#include <deque>
 #include <thread>
 
 using namespace uhd;
@@ -92,11 +95,27 @@ protected:
 //-----------------------------------------------------
 // Ethernet impl
 //-----------------------------------------------------
+/*!
+ * Sends each transaction to the firmware as its own UDP packet.
+ *
+ * Up to \p window transactions may be in flight at once. A poke returns as soon
+ * as its request is sent, unless the window is full; a peek (or a flush) waits
+ * for all requests that are in flight. The firmware runs the transactions in
+ * the order they arrive, so a peek always sees the effect of earlier pokes.
+ * Failed pokes are reported by the next call that waits for replies.
+ *
+ * With a window of 1, every transaction waits for its own reply.
+ */
 class x300_ctrl_iface_enet : public x300_ctrl_iface
 {
 public:
-    x300_ctrl_iface_enet(uhd::transport::udp_simple::sptr udp, bool enable_errors = true)
-        : x300_ctrl_iface(enable_errors), udp(udp), seq(0)
+    x300_ctrl_iface_enet(uhd::transport::udp_simple::sptr udp,
+        bool enable_errors  = true,
+        const size_t window = 1)
+        : x300_ctrl_iface(enable_errors)
+        , udp(udp)
+        , seq(0)
+        , _window(std::max<size_t>(window, 1))
     {
         try {
             this->peek32(0);
@@ -104,76 +123,35 @@ public:
         }
     }
 
+    ~x300_ctrl_iface_enet()
+    {
+        // Make sure the last pokes made it
+        UHD_SAFE_CALL(boost::mutex::scoped_lock lock(reg_access); _drain();)
+    }
+
 protected:
     virtual void __poke32(const wb_addr_type addr, const uint32_t data)
     {
-        // load request struct
-        x300_fw_comms_t request = x300_fw_comms_t();
-        request.flags =
-            uhd::htonx<uint32_t>(X300_FW_COMMS_FLAGS_ACK | X300_FW_COMMS_FLAGS_POKE32);
-        request.sequence = uhd::htonx<uint32_t>(seq++);
-        request.addr     = uhd::htonx(addr);
-        request.data     = uhd::htonx(data);
-
-        // send request
-        __flush();
-        udp->send(boost::asio::buffer(&request, sizeof(request)));
-
-        // recv reply
-        x300_fw_comms_t reply = x300_fw_comms_t();
-        const size_t nbytes = udp->recv(boost::asio::buffer(&reply, sizeof(reply)), 1.0);
-        if (nbytes == 0)
-            throw uhd::io_error("x300 fw poke32 - reply timed out");
-
-        // sanity checks
-        const size_t flags = uhd::ntohx<uint32_t>(reply.flags);
-        UHD_ASSERT_THROW(nbytes == sizeof(reply));
-        UHD_ASSERT_THROW(not(flags & X300_FW_COMMS_FLAGS_ERROR));
-        UHD_ASSERT_THROW(flags & X300_FW_COMMS_FLAGS_POKE32);
-        UHD_ASSERT_THROW(flags & X300_FW_COMMS_FLAGS_ACK);
-        UHD_ASSERT_THROW(reply.sequence == request.sequence);
-        UHD_ASSERT_THROW(reply.addr == request.addr);
-        UHD_ASSERT_THROW(reply.data == request.data);
+        while (_in_flight.size() >= _window) {
+            _wait_for_reply();
+        }
+        _send_request(X300_FW_COMMS_FLAGS_POKE32, addr, data);
+        if (_window == 1) {
+            _drain();
+        }
     }
 
     virtual uint32_t __peek32(const wb_addr_type addr)
     {
-        // load request struct
-        x300_fw_comms_t request = x300_fw_comms_t();
-        request.flags =
-            uhd::htonx<uint32_t>(X300_FW_COMMS_FLAGS_ACK | X300_FW_COMMS_FLAGS_PEEK32);
-        request.sequence = uhd::htonx<uint32_t>(seq++);
-        request.addr     = uhd::htonx(addr);
-        request.data     = 0;
-
-        // send request
-        __flush();
-        udp->send(boost::asio::buffer(&request, sizeof(request)));
-
-        // recv reply
-        x300_fw_comms_t reply = x300_fw_comms_t();
-        const size_t nbytes = udp->recv(boost::asio::buffer(&reply, sizeof(reply)), 1.0);
-        if (nbytes == 0)
-            throw uhd::io_error("x300 fw peek32 - reply timed out");
-
-        // sanity checks
-        const size_t flags = uhd::ntohx<uint32_t>(reply.flags);
-        UHD_ASSERT_THROW(nbytes == sizeof(reply));
-        UHD_ASSERT_THROW(not(flags & X300_FW_COMMS_FLAGS_ERROR));
-        UHD_ASSERT_THROW(flags & X300_FW_COMMS_FLAGS_PEEK32);
-        UHD_ASSERT_THROW(flags & X300_FW_COMMS_FLAGS_ACK);
-        UHD_ASSERT_THROW(reply.sequence == request.sequence);
-        UHD_ASSERT_THROW(reply.addr == request.addr);
-
-        // return result!
-        return uhd::ntohx<uint32_t>(reply.data);
+        _send_request(X300_FW_COMMS_FLAGS_PEEK32, addr, 0);
+        _drain();
+        return _peek_data;
     }
 
     virtual void __flush(void)
     {
-        char buff[X300_FW_COMMS_MTU] = {};
-        while (udp->recv(boost::asio::buffer(buff), 0.0)) {
-        } // flush
+        _drain();
+        _flush_socket();
     }
 
     virtual std::string __loc_info(void)
@@ -182,8 +160,128 @@ protected:
     }
 
 private:
+    //! A request that was sent, but not acknowledged yet
+    struct request_t
+    {
+        x300_fw_comms_t request;
+        bool acked;
+        uint32_t data;
+    };
+
+    //! Discard replies that arrive after their request timed out
+    void _flush_socket(void)
+    {
+        char buff[X300_FW_COMMS_MTU] = {};
+        while (udp->recv(boost::asio::buffer(buff), 0.0)) {
+        } // flush
+    }
+
+    void _send_request(
+        const uint32_t op_flag, const wb_addr_type addr, const uint32_t data)
+    {
+        // Stale replies can only be told apart by their sequence number, so
+        // only flush when no reply is pending
+        if (_in_flight.empty()) {
+            _flush_socket();
+        }
+        request_t entry        = request_t();
+        entry.request.flags    = uhd::htonx<uint32_t>(X300_FW_COMMS_FLAGS_ACK | op_flag);
+        entry.request.sequence = uhd::htonx<uint32_t>(seq++);
+        entry.request.addr     = uhd::htonx(addr);
+        entry.request.data     = uhd::htonx(data);
+        _in_flight.push_back(entry);
+        udp->send(boost::asio::buffer(&entry.request, sizeof(entry.request)));
+    }
+
+    //! Wait until all requests in flight are acknowledged
+    void _drain(void)
+    {
+        while (not _in_flight.empty()) {
+            _wait_for_reply();
+        }
+    }
+
+    /*! Receive one reply, and retire the requests at the front of the window
+     *  that are acknowledged.
+     *
+     * If no reply comes in for a while, all unacknowledged requests are sent
+     * again. After num_retries attempts, the requests are dropped and this
+     * throws a uhd::io_error.
+     */
+    void _wait_for_reply(void)
+    {
+        x300_fw_comms_t reply = x300_fw_comms_t();
+        const size_t nbytes = udp->recv(boost::asio::buffer(&reply, sizeof(reply)), 1.0);
+        if (nbytes == 0) {
+            const bool is_peek = uhd::ntohx<uint32_t>(_in_flight.front().request.flags)
+                                 & X300_FW_COMMS_FLAGS_PEEK32;
+            const std::string error_msg =
+                str(boost::format("x300 fw %s - reply timed out")
+                    % (is_peek ? "peek32" : "poke32"));
+            if (++_num_timeouts >= num_retries) {
+                _num_timeouts = 0;
+                _in_flight.clear();
+                throw uhd::io_error(error_msg);
+            }
+            if (errors) {
+                UHD_LOGGER_ERROR("X300")
+                    << str(boost::format("%s: x300 fw communication failure #%u\n%s")
+                           % __loc_info() % _num_timeouts % error_msg);
+            }
+            for (const auto& entry : _in_flight) {
+                if (not entry.acked) {
+                    udp->send(boost::asio::buffer(&entry.request, sizeof(entry.request)));
+                }
+            }
+            return;
+        }
+        _num_timeouts = 0;
+
+        auto entry = std::find_if(
+            _in_flight.begin(), _in_flight.end(), [&reply](const request_t& entry) {
+                return entry.request.sequence == reply.sequence;
+            });
+        // Late replies to requests that were sent again end up here
+        if (entry == _in_flight.end() or entry->acked) {
+            return;
+        }
+        try {
+            const x300_fw_comms_t& request = entry->request;
+            const size_t flags             = uhd::ntohx<uint32_t>(reply.flags);
+            const size_t op_flags =
+                uhd::ntohx<uint32_t>(request.flags)
+                & (X300_FW_COMMS_FLAGS_POKE32 | X300_FW_COMMS_FLAGS_PEEK32);
+            UHD_ASSERT_THROW(nbytes == sizeof(reply));
+            UHD_ASSERT_THROW(not(flags & X300_FW_COMMS_FLAGS_ERROR));
+            UHD_ASSERT_THROW(flags & op_flags);
+            UHD_ASSERT_THROW(flags & X300_FW_COMMS_FLAGS_ACK);
+            UHD_ASSERT_THROW(reply.addr == request.addr);
+            if (op_flags & X300_FW_COMMS_FLAGS_POKE32) {
+                UHD_ASSERT_THROW(reply.data == request.data);
+            }
+        } catch (...) {
+            _in_flight.clear();
+            throw;
+        }
+        entry->acked = true;
+        entry->data  = uhd::ntohx<uint32_t>(reply.data);
+
+        while (not _in_flight.empty() and _in_flight.front().acked) {
+            _peek_data = _in_flight.front().data;
+            _in_flight.pop_front();
+        }
+    }
+
     uhd::transport::udp_simple::sptr udp;
-    size_t seq;
+    uint32_t seq;
+    //! Maximum number of requests in flight
+    const size_t _window;
+    //! Requests in flight, in the order they were sent
+    std::deque<request_t> _in_flight;
+    //! Data of the last request that was retired. After a drain, that's the peek.
+    uint32_t _peek_data = 0;
+    //! Number of timeouts in a row while waiting for replies
+    size_t _num_timeouts = 0;
 };
 
 
@@ -309,10 +407,11 @@ private:
     static const uint32_t INIT_TIMEOUT_IN_MS = 5000;
 };
 
-wb_iface::sptr x300_make_ctrl_iface_enet(
-    uhd::transport::udp_simple::sptr udp, bool enable_errors = true)
+wb_iface::sptr x300_make_ctrl_iface_enet(uhd::transport::udp_simple::sptr udp,
+    bool enable_errors  = true,
+    const size_t window = 1)
 {
-    return wb_iface::sptr(new x300_ctrl_iface_enet(udp, enable_errors));
+    return wb_iface::sptr(new x300_ctrl_iface_enet(udp, enable_errors, window));
 }
 
 wb_iface::sptr x300_make_ctrl_iface_pcie(
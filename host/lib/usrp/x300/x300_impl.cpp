@@ -23,6 +23,9 @@
 #include <uhd/utils/safe_call.hpp>
 #include <uhd/utils/static.hpp>
 #include <uhdlib/rfnoc/device_id.hpp>
+#include <uhdlib/usrp/common/discovery_cache.hpp>
+#include <uhdlib/utils/init_timeline.hpp>
+#include <uhdlib/utils/periodic_task.hpp>
 #include <chrono>
 #include <fstream>
 #include <thread>
@@ -53,7 +56,7 @@ const uhd::rfnoc::chdr::chdr_packet_factory x300_impl::_pkt_factory(
 /***********************************************************************
  * Discovery over the udp and pcie transport
  **********************************************************************/
-device_addrs_t x300_find(const device_addr_t& hint_)
+static device_addrs_t x300_find_uncached(const device_addr_t& hint_)
 {
     // handle the multi-device discovery
     device_addrs_t hints = separate_device_addr(hint_);
@@ -145,10 +148,16 @@ device_addrs_t x300_find(const device_addr_t& hint_)
     return addrs;
 }
 
+device_addrs_t x300_find(const device_addr_t& hint_)
+{
+    return usrp::discovery_cache::get().find("x300", hint_, &x300_find_uncached);
+}
+
 /***********************************************************************
  * Daughterboard detection before initialization in software
  **********************************************************************/
-static std::vector<dboard_id_t> get_dboard_ids(uhd::i2c_iface& zpu_i2c)
+static std::vector<dboard_id_t> get_dboard_ids(
+    uhd::i2c_iface& zpu_i2c, const std::string& mb_serial)
 {
     std::vector<dboard_id_t> dboard_ids;
     // Read dboard ids from the EEPROM
@@ -162,7 +171,7 @@ static std::vector<dboard_id_t> get_dboard_ids(uhd::i2c_iface& zpu_i2c)
             const size_t addr = eeprom_addr + db_offset;
             // Load EEPROM
             std::unordered_map<size_t, usrp::dboard_eeprom_t> db_eeproms;
-            db_eeproms[addr].load(zpu_i2c, BASE_ADDR | addr);
+            load_db_eeprom(db_eeproms[addr], zpu_i2c, BASE_ADDR | addr, mb_serial);
             uint16_t dboard_id = db_eeproms[addr].id.to_uint16();
             dboard_ids.push_back(static_cast<dboard_id_t>(dboard_id));
         }
@@ -212,6 +221,7 @@ static void x300_load_fw(wb_iface::sptr fw_reg_ctrl, const std::string& file_nam
 x300_impl::x300_impl(const uhd::device_addr_t& dev_addr) : rfnoc_device()
 {
     UHD_LOGGER_INFO("X300") << "X300 initialization sequence...";
+    init_timeline::scoped_span span("x300_impl");
 
     const device_addrs_t device_args = separate_device_addr(dev_addr);
     _mb.resize(device_args.size());
@@ -219,6 +229,7 @@ x300_impl::x300_impl(const uhd::device_addr_t& dev_addr) : rfnoc_device()
     // Serialize the initialization process
     if (dev_addr.has_key("serialize_init") or device_args.size() == 1) {
         for (size_t i = 0; i < device_args.size(); i++) {
+            init_timeline::scoped_span mb_span("setup mboard " + std::to_string(i));
             this->setup_mb(i, device_args[i]);
         }
         return;
@@ -228,12 +239,15 @@ x300_impl::x300_impl(const uhd::device_addr_t& dev_addr) : rfnoc_device()
     // Initialize groups of USRPs in parallel
     size_t total_usrps = device_args.size();
     size_t num_usrps   = 0;
+    const init_timeline::span_id_t parent_span = init_timeline::get_current_span();
     while (num_usrps < total_usrps) {
         size_t init_usrps = std::min(total_usrps - num_usrps, x300::MAX_INIT_THREADS);
         boost::thread_group setup_threads;
         for (size_t i = 0; i < init_usrps; i++) {
             const size_t index = num_usrps + i;
-            setup_threads.create_thread([this, index, device_args]() {
+            setup_threads.create_thread([this, index, device_args, parent_span]() {
+                init_timeline::scoped_span mb_span(
+                    "setup mboard " + std::to_string(index), parent_span);
                 this->setup_mb(index, device_args[index]);
             });
         }
@@ -261,10 +275,13 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t& dev_addr)
         "X300", "Motherboard " << mb_i << " has remote device ID: " << mb.device_id);
 
     UHD_LOGGER_DEBUG("X300") << "Setting up basic communication...";
-    if (mb.xport_path == xport_path_t::NIRIO) {
-        mb.conn_mgr = std::make_shared<pcie_manager>(mb.args, _tree, mb_path);
-    } else {
-        mb.conn_mgr = std::make_shared<eth_manager>(mb.args, _tree, mb_path);
+    {
+        init_timeline::scoped_span conn_span("connection manager");
+        if (mb.xport_path == xport_path_t::NIRIO) {
+            mb.conn_mgr = std::make_shared<pcie_manager>(mb.args, _tree, mb_path);
+        } else {
+            mb.conn_mgr = std::make_shared<eth_manager>(mb.args, _tree, mb_path);
+        }
     }
     mb.zpu_ctrl = mb.conn_mgr->get_ctrl_iface();
 
@@ -272,8 +289,8 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t& dev_addr)
     if (not try_to_claim(mb.zpu_ctrl)) {
         throw uhd::runtime_error("Failed to claim device");
     }
-    mb.claimer_task =
-        uhd::task::make([&mb]() { claimer_loop(mb.zpu_ctrl); }, "x300_claimer");
+    mb.claimer_task = uhd::make_periodic_task(
+        [&mb]() { claim(mb.zpu_ctrl); }, std::chrono::seconds(1), "x300_claimer");
 
     // extract the FW path for the X300
     // and live load fw over ethernet link
@@ -369,7 +386,7 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t& dev_addr)
     // require a clock rate of no more than the max pfd frequency to maintain phase
     // synchronization. If there is no UBX, the default daughterboard clock rate is half
     // of the master clock rate for X300.
-    const double x300_dboard_clock_rate = [this, dev_addr, mb]() -> double {
+    const double x300_dboard_clock_rate = [this, dev_addr, mb, mb_eeprom]() -> double {
         // Do not override use-specified dboard clock rates
         if (dev_addr.has_key("dboard_clock_rate")) {
             return mb.args.get_dboard_clock_rate();
@@ -377,7 +394,8 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t& dev_addr)
         const double mcr         = mb.args.get_master_clock_rate();
         double dboard_clock_rate = mb.args.get_dboard_clock_rate();
         // Check for UBX daughterboards
-        std::vector<dboard_id_t> dboard_ids = get_dboard_ids(*mb.zpu_i2c);
+        std::vector<dboard_id_t> dboard_ids =
+            get_dboard_ids(*mb.zpu_i2c, mb_eeprom.get("serial", ""));
         for (dboard_id_t dboard_id : dboard_ids) {
             if (std::find(
                     dboard::ubx::ubx_ids.begin(), dboard::ubx::ubx_ids.end(), dboard_id)
@@ -407,8 +425,17 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t& dev_addr)
     ////////////////////////////////////////////////////////////////////
     // Now we have all the peripherals, create the MB controller. It will also
     // initialize the clock source, and the time source.
-    auto mb_ctrl = std::make_shared<x300_mb_controller>(
-        mb.hw_rev, product_name, mb.zpu_i2c, mb.zpu_ctrl, mb.clock, mb_eeprom, mb.args);
+    std::shared_ptr<x300_mb_controller> mb_ctrl;
+    {
+        init_timeline::scoped_span ctrl_span("mb controller");
+        mb_ctrl = std::make_shared<x300_mb_controller>(mb.hw_rev,
+            product_name,
+            mb.zpu_i2c,
+            mb.zpu_ctrl,
+            mb.clock,
+            mb_eeprom,
+            mb.args);
+    }
 
     register_mb_controller(mb_i, mb_ctrl);
     // Clock should be up now!
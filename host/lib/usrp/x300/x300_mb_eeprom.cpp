@@ -7,11 +7,19 @@
 #include "x300_mb_eeprom.hpp"
 #include <uhd/types/serial.hpp>
 #include <uhd/usrp/mboard_eeprom.hpp>
+#include <uhdlib/usrp/common/eeprom_cache.hpp>
 #include <uhdlib/utils/eeprom_utils.hpp>
+#include <boost/format.hpp>
 
 namespace {
 const uint8_t X300_EEPROM_ADDR = 0x50;
 
+std::string get_db_cache_key(const std::string& mb_serial, const int addr)
+{
+    const std::string prefix = "x300-" + mb_serial + "-";
+    return addr < 0 ? prefix : prefix + str(boost::format("db%02x") % addr);
+}
+
 struct x300_eeprom_map
 {
     // identifying numbers
@@ -188,10 +196,16 @@ void uhd::usrp::x300::set_mb_eeprom(
     }
 
     // store the serial
-    if (mb_eeprom.has_key("serial"))
+    if (mb_eeprom.has_key("serial")) {
+        // The cached daughterboard EEPROMs are keyed by the serial
+        if (curr_eeprom.has_key("serial")
+            and curr_eeprom["serial"] != mb_eeprom["serial"]) {
+            invalidate_db_eeprom(curr_eeprom["serial"]);
+        }
         iface->write_eeprom(X300_EEPROM_ADDR,
             offsetof(x300_eeprom_map, serial),
             string_to_bytes(mb_eeprom["serial"], SERIAL_LEN));
+    }
 
     // store the name
     if (mb_eeprom.has_key("name"))
@@ -199,3 +213,23 @@ void uhd::usrp::x300::set_mb_eeprom(
             offsetof(x300_eeprom_map, name),
             string_to_bytes(mb_eeprom["name"], NAME_MAX_LEN));
 }
+
+void uhd::usrp::x300::load_db_eeprom(dboard_eeprom_t& db_eeprom,
+    i2c_iface& i2c,
+    const uint8_t addr,
+    const std::string& mb_serial)
+{
+    if (mb_serial.empty()) {
+        db_eeprom.load(i2c, addr);
+        return;
+    }
+    eeprom_cache::load_dboard_eeprom(
+        db_eeprom, i2c, addr, get_db_cache_key(mb_serial, addr));
+}
+
+void uhd::usrp::x300::invalidate_db_eeprom(const std::string& mb_serial, const int addr)
+{
+    if (!mb_serial.empty()) {
+        eeprom_cache::invalidate(get_db_cache_key(mb_serial, addr));
+    }
+}
@@ -8,7 +8,9 @@
 #define INCLUDED_X300_EEPROM_HPP
 
 #include <uhd/types/serial.hpp>
+#include <uhd/usrp/dboard_eeprom.hpp>
 #include <uhd/usrp/mboard_eeprom.hpp>
+#include <string>
 
 namespace uhd { namespace usrp { namespace x300 {
 
@@ -19,6 +21,19 @@ uhd::usrp::mboard_eeprom_t get_mb_eeprom(uhd::i2c_iface::sptr i2c);
 void set_mb_eeprom(
     uhd::i2c_iface::sptr iface, const uhd::usrp::mboard_eeprom_t& mb_eeprom);
 
+/*! Load a daughterboard EEPROM through the EEPROM cache
+ *
+ * The cache entries are keyed by the motherboard serial and the EEPROM address.
+ * Without a serial, the EEPROM is read straight from the chip.
+ */
+void load_db_eeprom(uhd::usrp::dboard_eeprom_t& db_eeprom,
+    uhd::i2c_iface& i2c,
+    const uint8_t addr,
+    const std::string& mb_serial);
+
+//! Drop the cached daughterboard EEPROMs of a motherboard, or of one EEPROM on it
+void invalidate_db_eeprom(const std::string& mb_serial, const int addr = -1);
+
 }}} // namespace uhd::usrp::x300
 
 #endif /* INCLUDED_X300_EEPROM_HPP */
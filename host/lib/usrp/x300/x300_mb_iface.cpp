@@ -6,6 +6,7 @@
 
 #include "x300_impl.hpp"
 #include <uhdlib/rfnoc/device_id.hpp>
+#include <uhdlib/usrp/common/latency_mode.hpp>
 
 using namespace uhd::rfnoc;
 using uhd::transport::link_type_t;
@@ -153,21 +154,20 @@ uhd::rfnoc::chdr_rx_data_xport::uptr x300_impl::x300_mb_iface::make_rx_data_tran
     /* Associate local device ID with the adapter */
     _adapter_map[local_sep_addr.first] = send_link->get_send_adapter_id();
 
-    const uhd::rfnoc::stream_buff_params_t recv_capacity = {recv_buff_size,
-        packet_fc ? static_cast<uint32_t>(recv_link->get_num_recv_frames())
-                  : uhd::rfnoc::MAX_FC_CAPACITY_PKTS};
+    const uhd::usrp::latency_mode_args_t latency_args =
+        uhd::usrp::read_latency_mode_args(xport_args);
+    const uhd::rfnoc::stream_buff_params_t max_capacity =
+        uhd::usrp::get_max_fc_capacity(latency_args, recv_link->get_recv_frame_size());
 
-    const double ratio = 1.0 / 32;
+    const uhd::rfnoc::stream_buff_params_t recv_capacity = {
+        std::min<uint64_t>(recv_buff_size, max_capacity.bytes),
+        packet_fc ? std::min(static_cast<uint32_t>(recv_link->get_num_recv_frames()),
+                        max_capacity.packets)
+                  : uhd::rfnoc::MAX_FC_CAPACITY_PKTS};
 
     // Configure flow control frequency to use either bytes only or packets only
-    uhd::rfnoc::stream_buff_params_t fc_freq;
-    if (packet_fc) {
-        fc_freq = {uhd::rfnoc::MAX_FC_FREQ_BYTES,
-            static_cast<uint32_t>(std::ceil(recv_link->get_num_recv_frames() * ratio))};
-    } else {
-        fc_freq = {static_cast<uint64_t>(std::ceil(double(recv_buff_size) * ratio)),
-            uhd::rfnoc::MAX_FC_FREQ_PKTS};
-    }
+    const uhd::rfnoc::stream_buff_params_t fc_freq =
+        uhd::usrp::get_rx_fc_freq(latency_args, recv_capacity, packet_fc);
 
     uhd::rfnoc::stream_buff_params_t fc_headroom = {0, 0};
 
@@ -191,6 +191,7 @@ uhd::rfnoc::chdr_rx_data_xport::uptr x300_impl::x300_mb_iface::make_rx_data_tran
         [io_srv_mgr, recv_link, send_link]() {
             io_srv_mgr->disconnect_links(recv_link, send_link);
         });
+    fc_params.adaptive_freq = xport_args.cast<bool>("adaptive_fc", false);
 
     cfg_io_srv.reset();
 
@@ -246,8 +247,12 @@ uhd::rfnoc::chdr_tx_data_xport::uptr x300_impl::x300_mb_iface::make_tx_data_tran
     _adapter_map[local_sep_addr.first] = send_link->get_send_adapter_id();
 
     // TODO: configure this based on the transport type
-    const double fc_freq_ratio     = 1.0 / 8;
+    const uhd::usrp::latency_mode_args_t latency_args =
+        uhd::usrp::read_latency_mode_args(xport_args);
+    const double fc_freq_ratio     = latency_args.tx_fc_freq_ratio;
     const double fc_headroom_ratio = 0;
+    const uhd::rfnoc::stream_buff_params_t max_capacity =
+        uhd::usrp::get_max_fc_capacity(latency_args, send_link->get_send_frame_size());
 
     auto cfg_io_srv =
         get_io_srv_mgr()->connect_links(recv_link, send_link, link_type_t::CTRL);
@@ -264,6 +269,7 @@ uhd::rfnoc::chdr_tx_data_xport::uptr x300_impl::x300_mb_iface::make_tx_data_tran
         mdata_buff_fmt,
         fc_freq_ratio,
         fc_headroom_ratio,
+        max_capacity,
         [io_srv_mgr, recv_link, send_link]() {
             io_srv_mgr->disconnect_links(recv_link, send_link);
         });
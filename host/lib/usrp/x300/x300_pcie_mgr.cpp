@@ -49,6 +49,10 @@ constexpr size_t PCIE_TX_DATA_NUM_FRAMES = 4096;
 constexpr size_t PCIE_MSG_FRAME_SIZE     = 256; // bytes
 constexpr size_t PCIE_MSG_NUM_FRAMES     = 64;
 constexpr size_t PCIE_MAX_CHANNELS       = 6;
+// The DMA engine moves 64-bit words, and its packet gate has room for two 8 kiB
+// packets, so that is the largest frame a stream can use.
+constexpr size_t PCIE_DMA_WORD_SIZE       = 8; // bytes
+constexpr size_t PCIE_MAX_DATA_FRAME_SIZE = 8192; // bytes
 // constexpr size_t MAX_RATE_PCIE               = 800000000; // bytes/s
 
 
@@ -85,6 +89,24 @@ link_params_t get_default_link_params(const link_type_t link_type)
     return link_params;
 }
 
+//! Throw if the frame size that the stream args \p key set is not supported
+// by the DMA engine
+void assert_dma_frame_size(const device_addr_t& link_args, const std::string& key)
+{
+    if (!link_args.has_key(key)) {
+        return;
+    }
+    const size_t frame_size = size_t(link_args.cast<double>(key, 0.0));
+    if (frame_size == 0 || frame_size > PCIE_MAX_DATA_FRAME_SIZE
+        || frame_size % PCIE_DMA_WORD_SIZE != 0) {
+        throw uhd::value_error(std::string("[X300] Invalid PCIe ") + key + " "
+                               + std::to_string(frame_size) + ": Must be a multiple of "
+                               + std::to_string(PCIE_DMA_WORD_SIZE)
+                               + " bytes, and at most "
+                               + std::to_string(PCIE_MAX_DATA_FRAME_SIZE) + " bytes");
+    }
+}
+
 } // namespace
 
 uhd::wb_iface::sptr x300_make_ctrl_iface_pcie(
@@ -311,15 +333,16 @@ uint32_t pcie_manager::allocate_pcie_dma_chan(
     constexpr uint32_t CTRL_CHANNEL       = 0;
     constexpr uint32_t FIRST_DATA_CHANNEL = 1;
 
-    std::lock_guard<std::mutex> l(_dma_chan_mutex);
     uint32_t dma_chan = CTRL_CHANNEL;
     if (link_type == link_type_t::CTRL) {
         if (_dma_chan_pool.count(CTRL_CHANNEL)) {
             throw uhd::runtime_error("[X300] Cannot reallocate PCIe control channel!");
         }
     } else {
+        // The channels of streams that were torn down are free again
         dma_chan = FIRST_DATA_CHANNEL;
-        while (_dma_chan_pool.count(dma_chan)) {
+        while (_dma_chan_pool.count(dma_chan)
+               && !_dma_chan_pool.at(dma_chan).link.expired()) {
             dma_chan++;
         }
         if (dma_chan >= PCIE_MAX_CHANNELS) {
@@ -328,7 +351,7 @@ uint32_t pcie_manager::allocate_pcie_dma_chan(
         }
     }
 
-    _dma_chan_pool[dma_chan] = remote_epid;
+    _dma_chan_pool[dma_chan] = dma_chan_t{remote_epid, {}};
     UHD_LOG_DEBUG("X300",
         "Assigning DMA channel " << dma_chan << " to remote EPID " << remote_epid);
     return dma_chan;
@@ -347,6 +370,11 @@ both_links_t pcie_manager::get_links(link_type_t link_type,
             + ", no such device associated with this motherboard!");
     }
 
+    assert_dma_frame_size(link_args, "recv_frame_size");
+    assert_dma_frame_size(link_args, "send_frame_size");
+
+    // The channel stays allocated for as long as its link exists
+    std::lock_guard<std::mutex> l(_dma_chan_mutex);
     const uint32_t dma_channel_num = allocate_pcie_dma_chan(remote_epid, link_type);
     // Note: The nirio_link object's factory has a lot of code for sanity
     // checking the link params, and merging the link_args with the default
@@ -355,8 +383,19 @@ both_links_t pcie_manager::get_links(link_type_t link_type,
 
     // PCIe: Lossless, and little endian
     size_t recv_buff_size, send_buff_size;
-    auto link =
-        nirio_link::make(_rio_fpga_interface, dma_channel_num, link_params, link_args, recv_buff_size, send_buff_size);
+    nirio_link::sptr link;
+    try {
+        link = nirio_link::make(_rio_fpga_interface,
+            dma_channel_num,
+            link_params,
+            link_args,
+            recv_buff_size,
+            send_buff_size);
+    } catch (...) {
+        _dma_chan_pool.erase(dma_channel_num);
+        throw;
+    }
+    _dma_chan_pool.at(dma_channel_num).link = link;
 
     return std::make_tuple(
         link, send_buff_size, link, recv_buff_size, false /*not lossy*/, false);
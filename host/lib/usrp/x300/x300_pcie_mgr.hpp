@@ -16,6 +16,8 @@
 #include <uhd/types/direction.hpp>
 #include <uhdlib/rfnoc/rfnoc_common.hpp>
 #include <uhdlib/transport/links.hpp>
+#include <uhdlib/transport/nirio_link.hpp>
+#include <memory>
 #include <mutex>
 
 namespace uhd { namespace usrp { namespace x300 {
@@ -67,6 +69,7 @@ private:
     /*! Allocate or return a previously allocated PCIe channel pair
      *
      * Note the SID is always the transmit SID (i.e. from host to device).
+     * The caller must hold _dma_chan_mutex.
      */
     uint32_t allocate_pcie_dma_chan(const uhd::rfnoc::sep_id_t& remote_epid,
         const uhd::transport::link_type_t link_type);
@@ -77,8 +80,15 @@ private:
     uhd::niusrprio::niusrprio_session::sptr _rio_fpga_interface;
     uhd::rfnoc::device_id_t _local_device_id;
 
-    //! Maps Remote DMA channel -> EPID
-    std::unordered_map<uint32_t, uhd::rfnoc::sep_id_t> _dma_chan_pool;
+    struct dma_chan_t
+    {
+        uhd::rfnoc::sep_id_t remote_epid;
+        //! The link that uses the channel. The channel is free once it expires.
+        std::weak_ptr<uhd::transport::nirio_link> link;
+    };
+
+    //! Maps Remote DMA channel -> EPID and link
+    std::unordered_map<uint32_t, dma_chan_t> _dma_chan_pool;
 
     //! Locks access to the map
     std::mutex _dma_chan_mutex;
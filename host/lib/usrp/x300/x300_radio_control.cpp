@@ -10,6 +10,7 @@
 #include "x300_dboard_iface.hpp"
 #include "x300_device_args.hpp"
 #include "x300_mb_controller.hpp"
+#include "x300_mb_eeprom.hpp"
 #include "x300_radio_mbc_iface.hpp"
 #include "x300_regs.hpp"
 #include <uhd/rfnoc/registry.hpp>
@@ -28,6 +29,7 @@
 #include <uhdlib/usrp/cores/rx_frontend_core_3000.hpp>
 #include <uhdlib/usrp/cores/spi_core_3000.hpp>
 #include <uhdlib/usrp/cores/tx_frontend_core_200.hpp>
+#include <uhdlib/utils/init_timeline.hpp>
 #include <boost/algorithm/string.hpp>
 #include <algorithm>
 #include <chrono>
@@ -169,7 +171,10 @@ public:
             set_gpio_attr("FP0", usrp::gpio_atr::gpio_attr_map.at(attr.first), 0);
         }
         // DB Initialization
-        _init_db(); // This does not init the dboards themselves!
+        {
+            init_timeline::scoped_span db_span("dboard manager");
+            _init_db(); // This does not init the dboards themselves!
+        }
 
         // LEDs are technically valid for both RX and TX, but let's put them
         // here
@@ -206,16 +211,17 @@ public:
         }
 
         // Dboards
-        _init_dboards();
+        {
+            init_timeline::scoped_span db_span("init dboards");
+            _init_dboards();
+        }
 
         // Properties
         for (auto& samp_rate_prop : _samp_rate_in) {
-            set_property(
-                samp_rate_prop.get_id(), get_rate(), samp_rate_prop.get_src_info());
+            get_property_handle(&samp_rate_prop).set(get_rate());
         }
         for (auto& samp_rate_prop : _samp_rate_out) {
-            set_property(
-                samp_rate_prop.get_id(), get_rate(), samp_rate_prop.get_src_info());
+            get_property_handle(&samp_rate_prop).set(get_rate());
         }
     } /* ctor */
 
@@ -333,6 +339,7 @@ public:
     {
         RFNOC_LOG_TRACE(
             "set_rx_frequency(freq=" << (freq / 1e6) << " MHz, chan=" << chan << ")");
+        post_rx_tag(uhd::rx_tag_t::TAG_FREQ, chan);
         return get_tree()
             ->access<double>(get_db_path("rx", chan) / "freq" / "value")
             .set(freq)
@@ -1472,10 +1479,12 @@ private:
         const size_t DB_OFFSET = (_radio_type == PRIMARY) ? 0x0 : 0x2;
         auto zpu_i2c           = _x300_mb_control->get_zpu_i2c();
         auto clock             = _x300_mb_control->get_clock_ctrl();
+        _mb_serial             = _x300_mb_control->get_eeprom().get("serial", "");
         for (size_t i = 0; i < EEPROM_ADDRS.size(); i++) {
             const size_t addr = EEPROM_ADDRS[i] + DB_OFFSET;
             // Load EEPROM
-            _db_eeproms[addr].load(*zpu_i2c, BASE_ADDR | addr);
+            x300::load_db_eeprom(
+                _db_eeproms[addr], *zpu_i2c, BASE_ADDR | addr, _mb_serial);
             // Use the RFNoC implementation for Basic/LF dboards
             uint16_t dboard_pid = _db_eeproms[addr].id.to_uint16();
             switch (dboard_pid) {
@@ -1748,6 +1757,7 @@ private:
         const size_t addr,
         const uhd::usrp::dboard_eeprom_t& db_eeprom)
     {
+        x300::invalidate_db_eeprom(_mb_serial, int(addr));
         db_eeprom.store(*i2c, addr);
         _db_eeproms[addr] = db_eeprom;
     }
@@ -1977,6 +1987,8 @@ private:
 
     //! Cache of EEPROM info (one per channel)
     std::unordered_map<size_t, usrp::dboard_eeprom_t> _db_eeproms;
+    //! Motherboard serial, the daughterboard EEPROM cache entries are keyed by it
+    std::string _mb_serial;
     //! Reference to DB manager
     usrp::dboard_manager::sptr _db_manager;
     //! Reference to DB iface
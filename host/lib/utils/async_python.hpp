@@ -0,0 +1,107 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#pragma once
+
+#include <uhd/types/sensors.hpp>
+#include <uhd/types/tune_result.hpp>
+#include <pybind11/pybind11.h>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <utility>
+
+namespace py = pybind11;
+
+/*! Releases the GIL for the duration of a bound C++ call
+ *
+ * Use this for every call that can block on the device (register transactions,
+ * RPC calls, tuning, ...), so that other Python threads keep running meanwhile:
+ * \code{.cpp}
+ * .def("set_rx_freq", &multi_usrp::set_rx_freq, release_gil())
+ * \endcode
+ * The arguments are converted before, and the return value after the GIL is
+ * released, so this is safe for any call that doesn't call back into Python.
+ */
+using release_gil = py::call_guard<py::gil_scoped_release>;
+
+/*! A std::future for Python, which waits for its result without the GIL
+ *
+ * This is what the async variants of the control calls return. Like
+ * concurrent.futures.Future, result() returns the value of the call or raises
+ * its exception.
+ */
+template <typename T>
+class py_future
+{
+public:
+    py_future(std::future<T>&& future) : _future(future.share()) {}
+
+    //! Returns true if the call has completed
+    bool done() const
+    {
+        return _future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    /*! Waits for the call to complete and returns its result
+     *
+     * \param timeout The time to wait in seconds. A negative value waits for
+     *        as long as it takes.
+     * \throws TimeoutError (in Python) if the call didn't complete in time
+     */
+    T result(const double timeout)
+    {
+        bool ready = true;
+        {
+            py::gil_scoped_release release;
+            if (timeout < 0) {
+                _future.wait();
+            } else {
+                ready = _future.wait_for(std::chrono::duration<double>(timeout))
+                        == std::future_status::ready;
+            }
+        }
+        if (!ready) {
+            PyErr_SetString(PyExc_TimeoutError, "Timeout waiting for a UHD call");
+            throw py::error_already_set();
+        }
+        return _future.get();
+    }
+
+private:
+    std::shared_future<T> _future;
+};
+
+/*! Runs a blocking call on its own thread, and returns a future for its result
+ *
+ * This is for calls that can't be pipelined (e.g., tuning, which takes several
+ * dependent transactions). The callable must hold on to the objects it uses,
+ * e.g., by capturing their shared pointers.
+ */
+template <typename callable_t>
+auto make_py_future(callable_t&& call) -> py_future<decltype(call())>
+{
+    return py_future<decltype(call())>(
+        std::async(std::launch::async, std::forward<callable_t>(call)));
+}
+
+template <typename T>
+void export_py_future(py::module& m, const char* name)
+{
+    py::class_<py_future<T>>(m, name)
+        .def("done", &py_future<T>::done)
+        .def("result", &py_future<T>::result, py::arg("timeout") = -1.0);
+}
+
+//! Exports the futures that the async variants of the control calls return
+inline void export_futures(py::module& m)
+{
+    export_py_future<void>(m, "future_void");
+    export_py_future<uint32_t>(m, "future_uint32");
+    export_py_future<double>(m, "future_double");
+    export_py_future<uhd::tune_result_t>(m, "future_tune_result");
+    export_py_future<uhd::sensor_value_t>(m, "future_sensor_value");
+}
@@ -0,0 +1,264 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/convert.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/utils/async_streamer.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/safe_call.hpp>
+#include <boost/optional.hpp>
+#include <mutex>
+
+using namespace uhd;
+
+async_rx_streamer::~async_rx_streamer() = default;
+async_tx_streamer::~async_tx_streamer() = default;
+
+namespace {
+
+//! Run a handler through the post function, if there is one
+void run_handler(const async_post_fn_t& post, std::function<void()> handler)
+{
+    if (post) {
+        post(std::move(handler));
+    } else {
+        handler();
+    }
+}
+
+class async_rx_streamer_impl : public async_rx_streamer
+{
+public:
+    async_rx_streamer_impl(rx_streamer::sptr rx_stream, async_post_fn_t post)
+        : _rx_stream(rx_stream), _post(std::move(post))
+    {
+        _rx_stream->set_recv_ready_callback([this]() { _try_recv(); });
+    }
+
+    ~async_rx_streamer_impl()
+    {
+        // Once this returns, no more notifications come in
+        UHD_SAFE_CALL(_rx_stream->set_recv_ready_callback({});)
+    }
+
+    rx_streamer::sptr get_rx_stream() const
+    {
+        return _rx_stream;
+    }
+
+    void async_recv(const rx_streamer::buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        rx_metadata_t& metadata,
+        recv_handler_t handler,
+        const bool one_packet)
+    {
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            if (_op) {
+                throw uhd::runtime_error("async_rx_streamer: A receive is pending");
+            }
+            recv_op_t op{std::vector<void*>(buffs.size()),
+                nsamps_per_buff,
+                &metadata,
+                std::move(handler),
+                one_packet};
+            for (size_t i = 0; i < buffs.size(); i++) {
+                op.buffs[i] = buffs[i];
+            }
+            _op = std::move(op);
+        }
+        // The samples may already be there
+        _try_recv();
+    }
+
+    bool cancel()
+    {
+        std::unique_lock<std::mutex> l(_mutex);
+        if (!_op) {
+            return false;
+        }
+        recv_op_t op = std::move(*_op);
+        _op.reset();
+        l.unlock();
+        op.metadata->reset();
+        op.metadata->error_code = rx_metadata_t::ERROR_CODE_TIMEOUT;
+        run_handler(_post, [handler = std::move(op.handler)]() { handler(0); });
+        return true;
+    }
+
+private:
+    struct recv_op_t
+    {
+        std::vector<void*> buffs;
+        size_t nsamps_per_buff;
+        rx_metadata_t* metadata;
+        recv_handler_t handler;
+        bool one_packet;
+    };
+
+    //! Complete the pending receive if there's data. Runs on any thread.
+    void _try_recv()
+    {
+        std::unique_lock<std::mutex> l(_mutex);
+        if (!_op) {
+            return;
+        }
+        size_t num_samps = 0;
+        try {
+            num_samps = _rx_stream->recv(
+                _op->buffs, _op->nsamps_per_buff, *_op->metadata, 0.0, _op->one_packet);
+        } catch (const uhd::exception& ex) {
+            // This usually runs on an I/O thread, which must not see this
+            UHD_LOG_ERROR("ASYNC_RX", "Failed to receive: " << ex.what());
+            return;
+        }
+        if (_op->metadata->error_code == rx_metadata_t::ERROR_CODE_TIMEOUT) {
+            return;
+        }
+        recv_op_t op = std::move(*_op);
+        _op.reset();
+        l.unlock();
+        run_handler(_post,
+            [handler = std::move(op.handler), num_samps]() { handler(num_samps); });
+    }
+
+    rx_streamer::sptr _rx_stream;
+    const async_post_fn_t _post;
+    std::mutex _mutex;
+    boost::optional<recv_op_t> _op;
+};
+
+class async_tx_streamer_impl : public async_tx_streamer
+{
+public:
+    async_tx_streamer_impl(
+        tx_streamer::sptr tx_stream, const std::string& cpu_format, async_post_fn_t post)
+        : _tx_stream(tx_stream)
+        , _bytes_per_item(convert::get_bytes_per_item(cpu_format))
+        , _post(std::move(post))
+    {
+        _tx_stream->set_send_ready_callback([this]() { _try_send(); });
+    }
+
+    ~async_tx_streamer_impl()
+    {
+        UHD_SAFE_CALL(_tx_stream->set_send_ready_callback({});)
+    }
+
+    tx_streamer::sptr get_tx_stream() const
+    {
+        return _tx_stream;
+    }
+
+    void async_send(const tx_streamer::buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        const tx_metadata_t& metadata,
+        send_handler_t handler)
+    {
+        if (nsamps_per_buff == 0) {
+            throw uhd::value_error("async_tx_streamer: Can't send 0 samples");
+        }
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            if (_op) {
+                throw uhd::runtime_error("async_tx_streamer: A send is pending");
+            }
+            send_op_t op{std::vector<const void*>(buffs.size()),
+                nsamps_per_buff,
+                0,
+                metadata,
+                std::move(handler)};
+            for (size_t i = 0; i < buffs.size(); i++) {
+                op.buffs[i] = buffs[i];
+            }
+            _op = std::move(op);
+        }
+        // There may be free buffers already
+        _try_send();
+    }
+
+    bool cancel()
+    {
+        std::unique_lock<std::mutex> l(_mutex);
+        if (!_op) {
+            return false;
+        }
+        send_op_t op = std::move(*_op);
+        _op.reset();
+        l.unlock();
+        run_handler(_post, [handler = std::move(op.handler), sent = op.num_sent]() {
+            handler(sent);
+        });
+        return true;
+    }
+
+private:
+    struct send_op_t
+    {
+        std::vector<const void*> buffs;
+        size_t nsamps_per_buff;
+        size_t num_sent;
+        tx_metadata_t metadata;
+        send_handler_t handler;
+    };
+
+    //! Send as much of the pending send as possible. Runs on any thread.
+    void _try_send()
+    {
+        std::unique_lock<std::mutex> l(_mutex);
+        if (!_op) {
+            return;
+        }
+        size_t num_sent = 0;
+        try {
+            num_sent = _tx_stream->send(
+                _op->buffs, _op->nsamps_per_buff - _op->num_sent, _op->metadata, 0.0);
+        } catch (const uhd::exception& ex) {
+            UHD_LOG_ERROR("ASYNC_TX", "Failed to send: " << ex.what());
+            return;
+        }
+        if (num_sent == 0) {
+            return;
+        }
+        _op->num_sent += num_sent;
+        if (_op->num_sent < _op->nsamps_per_buff) {
+            // The rest continues the burst
+            for (auto& buff : _op->buffs) {
+                buff = static_cast<const char*>(buff) + num_sent * _bytes_per_item;
+            }
+            _op->metadata.start_of_burst = false;
+            _op->metadata.has_time_spec  = false;
+            return;
+        }
+        send_op_t op = std::move(*_op);
+        _op.reset();
+        l.unlock();
+        run_handler(_post, [handler = std::move(op.handler), sent = op.num_sent]() {
+            handler(sent);
+        });
+    }
+
+    tx_streamer::sptr _tx_stream;
+    const size_t _bytes_per_item;
+    const async_post_fn_t _post;
+    std::mutex _mutex;
+    boost::optional<send_op_t> _op;
+};
+
+} // namespace
+
+async_rx_streamer::sptr async_rx_streamer::make(
+    rx_streamer::sptr rx_stream, async_post_fn_t post)
+{
+    return std::make_shared<async_rx_streamer_impl>(rx_stream, std::move(post));
+}
+
+async_tx_streamer::sptr async_tx_streamer::make(
+    tx_streamer::sptr tx_stream, const std::string& cpu_format, async_post_fn_t post)
+{
+    return std::make_shared<async_tx_streamer_impl>(
+        tx_stream, cpu_format, std::move(post));
+}
@@ -7,6 +7,8 @@
 #include <uhd/utils/chdr/chdr_packet.hpp>
 #include <uhdlib/rfnoc/chdr_packet_writer.hpp>
 #include <boost/format.hpp>
+#include <cstring>
+#include <limits>
 
 namespace chdr_rfnoc = uhd::rfnoc::chdr;
 namespace chdr_util  = uhd::utils::chdr;
@@ -166,3 +168,64 @@ const std::string chdr_util::chdr_packet::to_string() const
     return str(boost::format("chdr_packet{chdr_w:%u}\n%s")
                % uhd::rfnoc::chdr_w_to_bits(_chdr_w) % _header.to_string());
 }
+
+std::vector<chdr_util::chdr_packet_info_t> chdr_util::parse_packets(
+    uhd::rfnoc::chdr_w_t chdr_w,
+    const void* data,
+    const size_t size,
+    endianness_t endianness)
+{
+    const size_t chdr_w_bytes = uhd::rfnoc::chdr_w_to_bits(chdr_w) / 8;
+    chdr_rfnoc::chdr_packet_factory factory(chdr_w, endianness);
+    chdr_rfnoc::chdr_packet_writer::uptr packet_writer =
+        factory.make_generic(std::numeric_limits<size_t>::max());
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    std::vector<chdr_packet_info_t> packets;
+    size_t offset = 0;
+    while (offset < size) {
+        if (size - offset < chdr_w_bytes) {
+            throw uhd::value_error(
+                str(boost::format("Truncated CHDR header at offset %u") % offset));
+        }
+        uint64_t header_word;
+        std::memcpy(&header_word, bytes + offset, sizeof(header_word));
+        const chdr_rfnoc::chdr_header header(u64_to_host(endianness, header_word));
+        // With CHDR_W = 64 bits, the timestamp takes up a word of its own
+        const size_t min_length =
+            (header.get_pkt_type() == chdr_rfnoc::PKT_TYPE_DATA_WITH_TS
+                && chdr_w == uhd::rfnoc::CHDR_W_64)
+                ? 2 * chdr_w_bytes
+                : chdr_w_bytes;
+        const size_t length = header.get_length();
+        if (length < min_length || length > size - offset) {
+            throw uhd::value_error(str(
+                boost::format("Invalid length %u of the CHDR packet at offset %u")
+                % length % offset));
+        }
+
+        const auto view = packet_writer->parse(bytes + offset);
+        chdr_packet_info_t info;
+        info.offset         = offset;
+        info.payload_offset = static_cast<const uint8_t*>(view.payload) - bytes;
+        info.timestamp      = view.timestamp;
+        info.payload_size   = static_cast<uint32_t>(view.payload_size);
+        info.length         = header.get_length();
+        info.seq_num        = header.get_seq_num();
+        info.dst_epid       = header.get_dst_epid();
+        info.vc             = header.get_vc();
+        info.pkt_type       = static_cast<uint8_t>(header.get_pkt_type());
+        info.num_mdata      = header.get_num_mdata();
+        info.eob            = header.get_eob();
+        info.eov            = header.get_eov();
+        info.has_timestamp  = view.has_timestamp;
+        if (info.payload_offset + info.payload_size > offset + length) {
+            throw uhd::value_error(str(
+                boost::format("Invalid length %u of the CHDR packet at offset %u")
+                % length % offset));
+        }
+        packets.push_back(info);
+        offset += length;
+    }
+    return packets;
+}
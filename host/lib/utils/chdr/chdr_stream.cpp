@@ -0,0 +1,793 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/chdr/chdr_stream.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/thread.hpp>
+#include <uhdlib/rfnoc/chdr_packet_writer.hpp>
+#include <uhdlib/transport/udp_common.hpp>
+#include <boost/asio.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace chdr_rfnoc = uhd::rfnoc::chdr;
+namespace chdr_util  = uhd::utils::chdr;
+namespace asio       = boost::asio;
+using asio::ip::udp;
+using namespace uhd;
+
+namespace {
+
+constexpr auto LOG_ID = "CHDR_STREAM";
+
+//! Largest STRS packet, of any CHDR width
+constexpr size_t MAX_STRS_PACKET_SIZE = 128;
+//! Largest value of the length field of the CHDR header
+constexpr size_t MAX_PACKET_SIZE = std::numeric_limits<uint16_t>::max();
+//! How long the receive thread waits for a packet before it checks for shutdown
+constexpr int32_t RECV_POLL_MS = 100;
+//! How long the send thread sleeps when no stream has a packet to send
+constexpr auto SEND_IDLE_TIMEOUT = std::chrono::milliseconds(100);
+//! Packets recv() can fall behind by, before they are dropped
+constexpr size_t MAX_RECV_QUEUE_SIZE = 1024;
+//! Socket buffers, large enough for a few milliseconds at 10 Gbps
+constexpr size_t SOCKET_BUFF_SIZE = 8 * 1024 * 1024;
+
+uint64_t u64_to_host(const uhd::endianness_t endianness, const uint64_t word)
+{
+    return (endianness == ENDIANNESS_BIG) ? uhd::ntohx<uint64_t>(word)
+                                          : uhd::wtohx<uint64_t>(word);
+}
+
+/*! Reads the header of a packet, and checks its length
+ *
+ * \throws uhd::value_error if the packet is truncated
+ */
+chdr_rfnoc::chdr_header read_header(const uhd::endianness_t endianness,
+    const size_t chdr_w_bytes,
+    const void* pkt,
+    const size_t len)
+{
+    if (len < chdr_w_bytes) {
+        throw uhd::value_error("Truncated CHDR header");
+    }
+    uint64_t word;
+    std::memcpy(&word, pkt, sizeof(word));
+    const chdr_rfnoc::chdr_header header(u64_to_host(endianness, word));
+    if (header.get_length() < chdr_w_bytes || header.get_length() > len) {
+        throw uhd::value_error(
+            "Invalid CHDR packet length " + std::to_string(header.get_length()));
+    }
+    return header;
+}
+
+/******************************************************************************
+ * Source
+ *****************************************************************************/
+class chdr_stream_source_impl : public chdr_util::chdr_stream_source
+{
+public:
+    chdr_stream_source_impl(const uhd::rfnoc::chdr_w_t chdr_w,
+        const uhd::endianness_t endianness,
+        const uint16_t src_epid,
+        const uint16_t dst_epid,
+        const chdr_util::chdr_stream_counts_t& fc_freq)
+        : _src_epid(src_epid)
+        , _dst_epid(dst_epid)
+        , _fc_freq(fc_freq)
+        , _factory(chdr_w, endianness)
+        , _data_pkt(_factory.make_generic())
+        , _strc_pkt(_factory.make_strc())
+        , _payload_offset(
+              _data_pkt->calculate_payload_offset(chdr_rfnoc::PKT_TYPE_DATA_WITH_TS))
+    {
+    }
+
+    size_t write_strc_init(void* buff, const size_t max_size) override
+    {
+        if (max_size < chdr_rfnoc::strc_payload::MAX_PACKET_SIZE) {
+            throw uhd::value_error("The buffer is too small for an STRC packet");
+        }
+        chdr_rfnoc::chdr_header header;
+        header.set_dst_epid(_dst_epid);
+        chdr_rfnoc::strc_payload strc;
+        strc.src_epid  = _src_epid;
+        strc.op_code   = chdr_rfnoc::STRC_INIT;
+        strc.num_bytes = _fc_freq.bytes;
+        strc.num_pkts  = _fc_freq.packets;
+        _strc_pkt->refresh(buff, header, strc);
+        _fc_ready = false;
+        return header.get_length();
+    }
+
+    void handle_strs(const chdr_rfnoc::strs_payload& strs) override
+    {
+        if (!_fc_ready) {
+            // The answer to the STRC INIT, the destination resets its counts
+            _capacity = {strs.capacity_bytes, strs.capacity_pkts};
+            _sent     = {};
+            _consumed = {};
+            _fc_ready = true;
+            return;
+        }
+        // The transfer counts only grow, don't let a late status undo a newer one
+        _consumed.bytes   = std::max(_consumed.bytes, strs.xfer_count_bytes);
+        _consumed.packets = std::max(_consumed.packets, strs.xfer_count_pkts);
+    }
+
+    void start(const size_t spp,
+        const size_t bytes_per_sample,
+        const uint64_t num_samples,
+        const uint64_t timestamp) override
+    {
+        if (spp == 0 || bytes_per_sample == 0) {
+            throw uhd::value_error("A stream needs at least one sample per packet");
+        }
+        if (_payload_offset + spp * bytes_per_sample > MAX_PACKET_SIZE) {
+            throw uhd::value_error(
+                "The packets of " + std::to_string(spp) + " samples are too large");
+        }
+        _spp              = spp;
+        _bytes_per_sample = bytes_per_sample;
+        _num_samples      = num_samples;
+        _timestamp        = timestamp;
+        _samples_sent     = 0;
+        _stop             = false;
+        _streaming        = true;
+    }
+
+    void stop() override
+    {
+        _stop = true;
+    }
+
+    size_t write_next(void* buff, const size_t max_size) override
+    {
+        if (!_streaming || !_fc_ready) {
+            return 0;
+        }
+        size_t num_samps = _spp;
+        bool eob         = _stop;
+        if (_num_samples != 0 && _num_samples - _samples_sent <= _spp) {
+            num_samps = static_cast<size_t>(_num_samples - _samples_sent);
+            eob       = true;
+        }
+        const size_t payload_size = num_samps * _bytes_per_sample;
+        const size_t pkt_size     = _payload_offset + payload_size;
+        if (pkt_size > max_size) {
+            throw uhd::value_error("The buffer is too small for a packet of "
+                                   + std::to_string(pkt_size) + " bytes");
+        }
+        if (_capacity.bytes != 0
+            && _sent.bytes - _consumed.bytes + pkt_size > _capacity.bytes) {
+            return 0;
+        }
+        if (_capacity.packets != 0
+            && _sent.packets - _consumed.packets + 1 > _capacity.packets) {
+            return 0;
+        }
+
+        chdr_rfnoc::chdr_header header;
+        header.set_pkt_type(chdr_rfnoc::PKT_TYPE_DATA_WITH_TS);
+        header.set_seq_num(_seq_num++);
+        header.set_dst_epid(_dst_epid);
+        header.set_eob(eob);
+        void* payload = _data_pkt->write_header(
+            buff, header, _timestamp + _samples_sent, payload_size);
+        std::memset(payload, 0, payload_size);
+
+        _samples_sent += num_samps;
+        _sent.bytes += header.get_length();
+        _sent.packets++;
+        if (eob) {
+            _streaming = false;
+        }
+        return header.get_length();
+    }
+
+    bool is_streaming() const override
+    {
+        return _streaming;
+    }
+
+    uint64_t get_num_samples_sent() const override
+    {
+        return _samples_sent;
+    }
+
+    chdr_util::chdr_stream_counts_t get_counts() const override
+    {
+        return _sent;
+    }
+
+private:
+    const uint16_t _src_epid;
+    const uint16_t _dst_epid;
+    const chdr_util::chdr_stream_counts_t _fc_freq;
+    chdr_rfnoc::chdr_packet_factory _factory;
+    chdr_rfnoc::chdr_packet_writer::uptr _data_pkt;
+    chdr_rfnoc::chdr_strc_packet::uptr _strc_pkt;
+    const size_t _payload_offset;
+
+    //! Flow control state, the capacity is 0 if the destination didn't limit it
+    bool _fc_ready = false;
+    chdr_util::chdr_stream_counts_t _capacity;
+    chdr_util::chdr_stream_counts_t _sent;
+    chdr_util::chdr_stream_counts_t _consumed;
+
+    //! Burst state
+    bool _streaming          = false;
+    bool _stop               = false;
+    size_t _spp              = 0;
+    size_t _bytes_per_sample = 0;
+    uint64_t _num_samples    = 0;
+    uint64_t _timestamp      = 0;
+    uint64_t _samples_sent   = 0;
+    uint16_t _seq_num        = 0;
+};
+
+/******************************************************************************
+ * Sink
+ *****************************************************************************/
+class chdr_stream_sink_impl : public chdr_util::chdr_stream_sink
+{
+public:
+    chdr_stream_sink_impl(const uhd::rfnoc::chdr_w_t chdr_w,
+        const uhd::endianness_t endianness,
+        const uint16_t epid,
+        const chdr_util::chdr_stream_counts_t& capacity)
+        : _endianness(endianness)
+        , _chdr_w_bytes(uhd::rfnoc::chdr_w_to_bits(chdr_w) / 8)
+        , _epid(epid)
+        , _capacity(capacity)
+        , _factory(chdr_w, endianness)
+        , _strc_pkt(_factory.make_strc())
+        , _strs_pkt(_factory.make_strs())
+    {
+    }
+
+    size_t handle_packet(const void* pkt,
+        const size_t len,
+        void* resp,
+        const size_t resp_max_size) override
+    {
+        const auto header = read_header(_endianness, _chdr_w_bytes, pkt, len);
+        switch (header.get_pkt_type()) {
+            case chdr_rfnoc::PKT_TYPE_STRC: {
+                _strc_pkt->refresh(pkt);
+                const chdr_rfnoc::strc_payload strc = _strc_pkt->get_payload();
+                if (strc.op_code == chdr_rfnoc::STRC_INIT) {
+                    _fc_freq      = {strc.num_bytes, strc.num_pkts};
+                    _dst_epid     = strc.src_epid;
+                    _xfer         = {};
+                    _reported     = {};
+                    _expected_seq = boost::none;
+                    _status       = chdr_rfnoc::STRS_OKAY;
+                } else if (strc.op_code == chdr_rfnoc::STRC_RESYNC) {
+                    _xfer = {strc.num_bytes, strc.num_pkts};
+                }
+                // Every stream command is answered with a status
+                return _write_strs(resp, resp_max_size);
+            }
+            case chdr_rfnoc::PKT_TYPE_DATA_NO_TS:
+            case chdr_rfnoc::PKT_TYPE_DATA_WITH_TS: {
+                if (_expected_seq && header.get_seq_num() != _expected_seq.get()) {
+                    _num_seq_errors++;
+                    _status = chdr_rfnoc::STRS_SEQERR;
+                }
+                _expected_seq = static_cast<uint16_t>(header.get_seq_num() + 1);
+                _xfer.bytes += header.get_length();
+                _xfer.packets++;
+                if (header.get_eob()) {
+                    _num_bursts++;
+                }
+                const chdr_util::chdr_stream_counts_t unreported = {
+                    _xfer.bytes - _reported.bytes, _xfer.packets - _reported.packets};
+                const bool fc_due =
+                    (_fc_freq.bytes != 0 && unreported.bytes >= _fc_freq.bytes)
+                    || (_fc_freq.packets != 0 && unreported.packets >= _fc_freq.packets);
+                return fc_due ? _write_strs(resp, resp_max_size) : 0;
+            }
+            default:
+                return 0;
+        }
+    }
+
+    chdr_util::chdr_stream_counts_t get_counts() const override
+    {
+        return _xfer;
+    }
+
+    uint64_t get_num_seq_errors() const override
+    {
+        return _num_seq_errors;
+    }
+
+    uint64_t get_num_bursts() const override
+    {
+        return _num_bursts;
+    }
+
+private:
+    size_t _write_strs(void* resp, const size_t resp_max_size)
+    {
+        if (resp_max_size < MAX_STRS_PACKET_SIZE) {
+            throw uhd::value_error("The buffer is too small for an STRS packet");
+        }
+        chdr_rfnoc::chdr_header header;
+        header.set_seq_num(_strs_seq_num++);
+        header.set_dst_epid(_dst_epid);
+        chdr_rfnoc::strs_payload strs;
+        strs.src_epid         = _epid;
+        strs.status           = _status;
+        strs.capacity_bytes   = _capacity.bytes;
+        strs.capacity_pkts    = static_cast<uint32_t>(_capacity.packets);
+        strs.xfer_count_bytes = _xfer.bytes;
+        strs.xfer_count_pkts  = _xfer.packets;
+        _strs_pkt->refresh(resp, header, strs);
+        _reported = _xfer;
+        _status   = chdr_rfnoc::STRS_OKAY;
+        return header.get_length();
+    }
+
+    const uhd::endianness_t _endianness;
+    const size_t _chdr_w_bytes;
+    const uint16_t _epid;
+    const chdr_util::chdr_stream_counts_t _capacity;
+    chdr_rfnoc::chdr_packet_factory _factory;
+    chdr_rfnoc::chdr_strc_packet::uptr _strc_pkt;
+    chdr_rfnoc::chdr_strs_packet::uptr _strs_pkt;
+
+    //! The EPID of the source, from its STRC INIT
+    uint16_t _dst_epid = 0;
+    chdr_util::chdr_stream_counts_t _fc_freq;
+    chdr_util::chdr_stream_counts_t _xfer;
+    //! The transfer count of the last status
+    chdr_util::chdr_stream_counts_t _reported;
+    chdr_rfnoc::strs_status_t _status = chdr_rfnoc::STRS_OKAY;
+    boost::optional<uint16_t> _expected_seq;
+    uint16_t _strs_seq_num   = 0;
+    uint64_t _num_seq_errors = 0;
+    uint64_t _num_bursts     = 0;
+};
+
+/******************************************************************************
+ * Engine
+ *****************************************************************************/
+class chdr_stream_engine_impl : public chdr_util::chdr_stream_engine
+{
+public:
+    chdr_stream_engine_impl(const uhd::rfnoc::chdr_w_t chdr_w,
+        const uhd::endianness_t endianness,
+        const std::string& addr,
+        const uint16_t port,
+        const size_t frame_size)
+        : _chdr_w(chdr_w)
+        , _endianness(endianness)
+        , _chdr_w_bytes(uhd::rfnoc::chdr_w_to_bits(chdr_w) / 8)
+        , _frame_size(frame_size)
+        , _socket(std::make_shared<udp::socket>(_io_service))
+        , _strs_pkt(chdr_rfnoc::chdr_packet_factory(chdr_w, endianness).make_strs())
+    {
+        try {
+            _socket->open(udp::v4());
+            _socket->bind(udp::endpoint(asio::ip::address::from_string(addr), port));
+        } catch (const boost::system::system_error& ex) {
+            throw uhd::io_error("Cannot bind the CHDR socket to " + addr + ":"
+                                + std::to_string(port) + ": " + ex.what());
+        }
+        transport::resize_udp_socket_buffer<asio::socket_base::receive_buffer_size>(
+            _socket, SOCKET_BUFF_SIZE);
+        transport::resize_udp_socket_buffer<asio::socket_base::send_buffer_size>(
+            _socket, SOCKET_BUFF_SIZE);
+
+        _recv_thread = std::thread([this]() { _recv_loop(); });
+        uhd::set_thread_name(&_recv_thread, "chdr_recv");
+        _send_thread = std::thread([this]() { _send_loop(); });
+        uhd::set_thread_name(&_send_thread, "chdr_send");
+    }
+
+    ~chdr_stream_engine_impl() override
+    {
+        _running = false;
+        {
+            // Take the locks, so no thread misses the notification
+            std::lock_guard<std::mutex> l(_mutex);
+            std::lock_guard<std::mutex> rl(_recv_mutex);
+        }
+        _send_cond.notify_all();
+        _recv_cond.notify_all();
+        _recv_thread.join();
+        _send_thread.join();
+    }
+
+    boost::optional<chdr_util::chdr_datagram_t> recv(const double timeout) override
+    {
+        std::unique_lock<std::mutex> l(_recv_mutex);
+        _recv_cond.wait_for(l, std::chrono::duration<double>(timeout), [this]() {
+            return !_recv_queue.empty() || !_running;
+        });
+        if (_recv_queue.empty()) {
+            return boost::none;
+        }
+        chdr_util::chdr_datagram_t datagram = std::move(_recv_queue.front());
+        _recv_queue.pop_front();
+        return datagram;
+    }
+
+    void send(const void* data,
+        const size_t len,
+        const std::string& addr,
+        const uint16_t port) override
+    {
+        _send_to(data, len, _make_endpoint(addr, port));
+    }
+
+    void add_source(const uint16_t src_epid,
+        const uint16_t dst_epid,
+        const std::string& addr,
+        const uint16_t port,
+        const chdr_util::chdr_stream_counts_t& fc_freq) override
+    {
+        auto stream    = std::make_shared<source_stream_t>();
+        stream->source = chdr_util::chdr_stream_source::make(
+            _chdr_w, _endianness, src_epid, dst_epid, fc_freq);
+        stream->dst = _make_endpoint(addr, port);
+        stream->buff.resize(_frame_size);
+        std::vector<uint8_t> strc(chdr_rfnoc::strc_payload::MAX_PACKET_SIZE);
+        const size_t len = stream->source->write_strc_init(strc.data(), strc.size());
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            _sources[src_epid] = stream;
+        }
+        UHD_LOG_DEBUG(LOG_ID,
+            "Added output stream EPID " << src_epid << " -> EPID " << dst_epid << " ("
+                                        << stream->dst << ")");
+        _send_to(strc.data(), len, stream->dst);
+    }
+
+    void start_source(const uint16_t src_epid,
+        const size_t spp,
+        const size_t bytes_per_sample,
+        const uint64_t num_samples,
+        const double rate,
+        const uint64_t timestamp) override
+    {
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            auto& stream = _get_source(src_epid);
+            stream.source->start(spp, bytes_per_sample, num_samples, timestamp);
+            stream.rate       = rate;
+            stream.start_time = std::chrono::steady_clock::now();
+        }
+        _send_cond.notify_one();
+    }
+
+    void stop_source(const uint16_t src_epid) override
+    {
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            auto stream_it = _sources.find(src_epid);
+            if (stream_it == _sources.end()) {
+                return;
+            }
+            stream_it->second->source->stop();
+        }
+        _send_cond.notify_one();
+    }
+
+    void remove_source(const uint16_t src_epid) override
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _sources.erase(src_epid);
+    }
+
+    void add_sink(
+        const uint16_t epid, const chdr_util::chdr_stream_counts_t& capacity) override
+    {
+        auto sink =
+            chdr_util::chdr_stream_sink::make(_chdr_w, _endianness, epid, capacity);
+        std::lock_guard<std::mutex> l(_mutex);
+        _sinks[epid] = sink;
+        UHD_LOG_DEBUG(LOG_ID, "Added input stream EPID " << epid);
+    }
+
+    void remove_sink(const uint16_t epid) override
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _sinks.erase(epid);
+    }
+
+    chdr_util::chdr_stream_counts_t get_source_counts(const uint16_t src_epid) override
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _get_source(src_epid).source->get_counts();
+    }
+
+    chdr_util::chdr_stream_counts_t get_sink_counts(const uint16_t epid) override
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _get_sink(epid).get_counts();
+    }
+
+    uint64_t get_sink_seq_errors(const uint16_t epid) override
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _get_sink(epid).get_num_seq_errors();
+    }
+
+private:
+    struct source_stream_t
+    {
+        chdr_util::chdr_stream_source::sptr source;
+        udp::endpoint dst;
+        //! Only the send thread touches the buffer
+        std::vector<uint8_t> buff;
+        double rate = 0.0;
+        std::chrono::steady_clock::time_point start_time;
+    };
+
+    udp::endpoint _make_endpoint(const std::string& addr, const uint16_t port)
+    {
+        boost::system::error_code ec;
+        const auto ip_addr = asio::ip::address::from_string(addr, ec);
+        if (ec) {
+            throw uhd::value_error("Invalid IP address " + addr);
+        }
+        return udp::endpoint(ip_addr, port);
+    }
+
+    //! Must be called with _mutex held
+    source_stream_t& _get_source(const uint16_t src_epid)
+    {
+        auto stream_it = _sources.find(src_epid);
+        if (stream_it == _sources.end()) {
+            throw uhd::key_error(
+                "No output stream with EPID " + std::to_string(src_epid));
+        }
+        return *stream_it->second;
+    }
+
+    //! Must be called with _mutex held
+    chdr_util::chdr_stream_sink& _get_sink(const uint16_t epid)
+    {
+        auto sink_it = _sinks.find(epid);
+        if (sink_it == _sinks.end()) {
+            throw uhd::key_error("No input stream with EPID " + std::to_string(epid));
+        }
+        return *sink_it->second;
+    }
+
+    void _send_to(const void* data, const size_t len, const udp::endpoint& dst)
+    {
+        std::lock_guard<std::mutex> l(_socket_mutex);
+        while (true) {
+            boost::system::error_code ec;
+            _socket->send_to(asio::buffer(data, len), dst, 0, ec);
+            if (ec == asio::error::no_buffer_space) {
+                std::this_thread::sleep_for(std::chrono::microseconds(1));
+                continue;
+            }
+            if (ec) {
+                UHD_LOG_WARNING(LOG_ID, "Cannot send to " << dst << ": " << ec.message());
+            }
+            return;
+        }
+    }
+
+    void _recv_loop()
+    {
+        std::vector<uint8_t> buff(_frame_size);
+        std::vector<uint8_t> resp(MAX_STRS_PACKET_SIZE);
+        udp::endpoint sender;
+        while (_running) {
+            if (!transport::wait_for_recv_ready(_socket->native_handle(), RECV_POLL_MS)) {
+                continue;
+            }
+            boost::system::error_code ec;
+            const size_t len =
+                _socket->receive_from(asio::buffer(buff), sender, 0, ec);
+            if (ec) {
+                UHD_LOG_WARNING(LOG_ID, "Receive error: " << ec.message());
+                continue;
+            }
+            try {
+                if (_handle_data_path(buff.data(), len, sender, resp)) {
+                    continue;
+                }
+            } catch (const uhd::exception& ex) {
+                UHD_LOG_WARNING(
+                    LOG_ID, "Dropping a packet from " << sender << ": " << ex.what());
+                continue;
+            }
+
+            std::lock_guard<std::mutex> l(_recv_mutex);
+            if (_recv_queue.size() >= MAX_RECV_QUEUE_SIZE) {
+                UHD_LOG_WARNING(LOG_ID, "Receive queue is full, dropping a packet");
+                continue;
+            }
+            chdr_util::chdr_datagram_t datagram;
+            datagram.data.assign(buff.begin(), buff.begin() + len);
+            datagram.addr = sender.address().to_string();
+            datagram.port = sender.port();
+            _recv_queue.push_back(std::move(datagram));
+            _recv_cond.notify_one();
+        }
+    }
+
+    /*! Passes a packet to its sink or source
+     *
+     * \return false if the packet isn't part of a stream
+     */
+    bool _handle_data_path(const uint8_t* pkt,
+        const size_t len,
+        const udp::endpoint& sender,
+        std::vector<uint8_t>& resp)
+    {
+        const auto header = read_header(_endianness, _chdr_w_bytes, pkt, len);
+        const auto type   = header.get_pkt_type();
+        std::lock_guard<std::mutex> l(_mutex);
+        if (type == chdr_rfnoc::PKT_TYPE_STRS) {
+            auto stream_it = _sources.find(header.get_dst_epid());
+            if (stream_it == _sources.end()) {
+                return false;
+            }
+            _strs_pkt->refresh(pkt);
+            stream_it->second->source->handle_strs(_strs_pkt->get_payload());
+            _send_cond.notify_one();
+            return true;
+        }
+        if (type == chdr_rfnoc::PKT_TYPE_STRC || type == chdr_rfnoc::PKT_TYPE_DATA_NO_TS
+            || type == chdr_rfnoc::PKT_TYPE_DATA_WITH_TS) {
+            auto sink_it = _sinks.find(header.get_dst_epid());
+            if (sink_it == _sinks.end()) {
+                return false;
+            }
+            const size_t resp_len =
+                sink_it->second->handle_packet(pkt, len, resp.data(), resp.size());
+            if (resp_len != 0) {
+                _send_to(resp.data(), resp_len, sender);
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void _send_loop()
+    {
+        using clock = std::chrono::steady_clock;
+        std::vector<std::pair<std::shared_ptr<source_stream_t>, size_t>> packets;
+        std::unique_lock<std::mutex> l(_mutex);
+        while (_running) {
+            // Write one packet of every stream that is due, then send them
+            // without the lock, so the receive thread can process the flow
+            // control in the meantime
+            const auto now = clock::now();
+            auto next_due  = now + SEND_IDLE_TIMEOUT;
+            packets.clear();
+            for (auto& kv : _sources) {
+                auto& stream = kv.second;
+                if (!stream->source->is_streaming()) {
+                    continue;
+                }
+                if (stream->rate > 0.0) {
+                    const auto due = stream->start_time
+                                     + std::chrono::duration_cast<clock::duration>(
+                                         std::chrono::duration<double>(
+                                             stream->source->get_num_samples_sent()
+                                             / stream->rate));
+                    if (due > now) {
+                        next_due = std::min(next_due, due);
+                        continue;
+                    }
+                }
+                try {
+                    const size_t len = stream->source->write_next(
+                        stream->buff.data(), stream->buff.size());
+                    if (len != 0) {
+                        packets.emplace_back(stream, len);
+                    }
+                } catch (const uhd::value_error& ex) {
+                    UHD_LOG_ERROR(LOG_ID, "Stopping output stream: " << ex.what());
+                    stream->source->stop();
+                }
+            }
+            if (packets.empty()) {
+                // Streams that wait for flow control are woken up by their STRS
+                _send_cond.wait_until(l, next_due);
+                continue;
+            }
+            l.unlock();
+            for (const auto& packet : packets) {
+                _send_to(packet.first->buff.data(), packet.second, packet.first->dst);
+            }
+            l.lock();
+        }
+    }
+
+    const uhd::rfnoc::chdr_w_t _chdr_w;
+    const uhd::endianness_t _endianness;
+    const size_t _chdr_w_bytes;
+    const size_t _frame_size;
+
+    asio::io_service _io_service;
+    transport::socket_sptr _socket;
+    //! Serializes the sends of all threads
+    std::mutex _socket_mutex;
+
+    //! Protects the streams
+    std::mutex _mutex;
+    std::map<uint16_t, std::shared_ptr<source_stream_t>> _sources;
+    std::map<uint16_t, chdr_util::chdr_stream_sink::sptr> _sinks;
+    chdr_rfnoc::chdr_strs_packet::uptr _strs_pkt;
+    std::condition_variable _send_cond;
+
+    //! Packets for recv()
+    std::mutex _recv_mutex;
+    std::deque<chdr_util::chdr_datagram_t> _recv_queue;
+    std::condition_variable _recv_cond;
+
+    std::atomic<bool> _running{true};
+    std::thread _recv_thread;
+    std::thread _send_thread;
+};
+
+} // namespace
+
+chdr_util::chdr_stream_source::~chdr_stream_source()
+{
+    /* NOP */
+}
+
+chdr_util::chdr_stream_source::sptr chdr_util::chdr_stream_source::make(
+    const uhd::rfnoc::chdr_w_t chdr_w,
+    const uhd::endianness_t endianness,
+    const uint16_t src_epid,
+    const uint16_t dst_epid,
+    const chdr_stream_counts_t& fc_freq)
+{
+    return std::make_shared<chdr_stream_source_impl>(
+        chdr_w, endianness, src_epid, dst_epid, fc_freq);
+}
+
+chdr_util::chdr_stream_sink::~chdr_stream_sink()
+{
+    /* NOP */
+}
+
+chdr_util::chdr_stream_sink::sptr chdr_util::chdr_stream_sink::make(
+    const uhd::rfnoc::chdr_w_t chdr_w,
+    const uhd::endianness_t endianness,
+    const uint16_t epid,
+    const chdr_stream_counts_t& capacity)
+{
+    return std::make_shared<chdr_stream_sink_impl>(chdr_w, endianness, epid, capacity);
+}
+
+chdr_util::chdr_stream_engine::~chdr_stream_engine()
+{
+    /* NOP */
+}
+
+chdr_util::chdr_stream_engine::sptr chdr_util::chdr_stream_engine::make(
+    const uhd::rfnoc::chdr_w_t chdr_w,
+    const uhd::endianness_t endianness,
+    const std::string& addr,
+    const uint16_t port,
+    const size_t frame_size)
+{
+    return std::make_shared<chdr_stream_engine_impl>(
+        chdr_w, endianness, addr, port, frame_size);
+}
@@ -11,15 +11,18 @@
 #include <uhd/utils/gain_group.hpp>
 #include <uhd/utils/log.hpp>
 #include <algorithm>
+#include <cmath>
 #include <functional>
+#include <map>
+#include <mutex>
 #include <vector>
 
 using namespace uhd;
 
 static bool compare_by_step_size(
-    const size_t& rhs, const size_t& lhs, std::vector<gain_fcns_t>& fcns)
+    const size_t& rhs, const size_t& lhs, const std::vector<gain_range_t>& ranges)
 {
-    return fcns.at(rhs).get_range().step() > fcns.at(lhs).get_range().step();
+    return ranges.at(rhs).step() > ranges.at(lhs).step();
 }
 
 /*!
@@ -104,10 +107,127 @@ public:
         if (all_fcns.size() == 0)
             return; // nothing to set!
 
+        std::vector<gain_range_t> ranges;
+        for (const gain_fcns_t& fcns : all_fcns) {
+            ranges.push_back(fcns.get_range());
+        }
+        const std::vector<double> gain_bucket = get_gain_bucket(gain, ranges);
+
+        // now write the bucket out to the individual gain values
+        for (size_t i = 0; i < gain_bucket.size(); i++) {
+            all_fcns.at(i).set_value(gain_bucket.at(i));
+        }
+    }
+
+    const std::vector<std::string> get_names(void)
+    {
+        return _name_to_fcns.keys();
+    }
+
+    void register_fcns(
+        const std::string& name, const gain_fcns_t& gain_fcns, size_t priority)
+    {
+        if (name.empty() or _name_to_fcns.has_key(name)) {
+            // ensure the name name is unique and non-empty
+            return register_fcns(name + "_", gain_fcns, priority);
+        }
+        _registry[priority].push_back(gain_fcns);
+        _name_to_fcns[name] = gain_fcns;
+        std::lock_guard<std::mutex> lock(_tables_mutex);
+        _gain_tables.clear();
+    }
+
+private:
+    //! get the gain function sets in order (highest priority first)
+    std::vector<gain_fcns_t> get_all_fcns(void)
+    {
+        std::vector<gain_fcns_t> all_fcns;
+        for (size_t key : uhd::sorted(_registry.keys())) {
+            const std::vector<gain_fcns_t>& fcns = _registry[key];
+            all_fcns.insert(all_fcns.begin(), fcns.begin(), fcns.end());
+        }
+        return all_fcns;
+    }
+
+    //! The gains of the elements for the overall gain start + index * step
+    struct gain_table_t
+    {
+        double start;
+        double step;
+        //! Entries are filled in when first used, empty ones are not yet known
+        std::vector<std::vector<double>> buckets;
+    };
+
+    /*! Look up the distribution of \p gain across elements with \p ranges
+     *
+     * The distribution only depends on the gain and the ranges, so it's
+     * computed once for every gain of the overall gain range, and then reused
+     * until the ranges change (e.g., when a frontend retunes to a different
+     * band). Gains that are off the overall step grid are always computed.
+     */
+    std::vector<double> get_gain_bucket(
+        const double gain, const std::vector<gain_range_t>& ranges)
+    {
+        // Don't keep too many bands, or overly fine steps, in memory
+        static const size_t MAX_NUM_TABLES      = 16;
+        static const size_t MAX_NUM_TABLE_GAINS = 16384;
+
+        double overall_start = 0, overall_stop = 0, overall_step = 0;
+        for (const gain_range_t& range : ranges) {
+            overall_start += range.start();
+            overall_stop += range.stop();
+            if (overall_step == 0) {
+                overall_step = range.step();
+            } else if (range.step()) {
+                overall_step = std::min(overall_step, range.step());
+            }
+        }
+        if (overall_step <= 0 || gain < overall_start || gain > overall_stop) {
+            return distribute(gain, ranges);
+        }
+        const double index_d   = std::round((gain - overall_start) / overall_step);
+        const double grid_gain = overall_start + index_d * overall_step;
+        if (std::abs(gain - grid_gain) > overall_step * 1e-6
+            || (overall_stop - overall_start) / overall_step >= MAX_NUM_TABLE_GAINS) {
+            return distribute(gain, ranges);
+        }
+        const size_t index = size_t(index_d);
+
+        std::lock_guard<std::mutex> lock(_tables_mutex);
+        std::vector<double> key;
+        for (const gain_range_t& range : ranges) {
+            key.insert(key.end(), {range.start(), range.stop(), range.step()});
+        }
+        auto table_it = _gain_tables.find(key);
+        if (table_it == _gain_tables.end()) {
+            if (_gain_tables.size() >= MAX_NUM_TABLES) {
+                _gain_tables.clear();
+            }
+            gain_table_t table;
+            table.start = overall_start;
+            table.step  = overall_step;
+            table.buckets.resize(
+                size_t(std::round((overall_stop - overall_start) / overall_step)) + 1);
+            table_it = _gain_tables.emplace(key, std::move(table)).first;
+        }
+        gain_table_t& table = table_it->second;
+        if (index >= table.buckets.size()) {
+            return distribute(gain, ranges);
+        }
+        if (table.buckets[index].empty()) {
+            table.buckets[index] = distribute(grid_gain, ranges);
+        }
+        return table.buckets[index];
+    }
+
+    //! Distribute \p gain across elements with \p ranges, in priority order
+    static std::vector<double> distribute(
+        const double gain, const std::vector<gain_range_t>& ranges)
+    {
         // get the max step size among the gains
         double max_step = 0;
-        for (const gain_fcns_t& fcns : all_fcns) {
-            max_step = std::max(max_step, fcns.get_range().step());
+        for (const gain_range_t& range : ranges) {
+            max_step = std::max(max_step, range.step());
         }
 
         // create gain bucket to distribute power
@@ -115,8 +235,7 @@ public:
 
         // distribute power according to priority (round to max step)
         double gain_left_to_distribute = gain;
-        for (const gain_fcns_t& fcns : all_fcns) {
-            const gain_range_t range = fcns.get_range();
+        for (const gain_range_t& range : ranges) {
             gain_bucket.push_back(floor_step(
                 uhd::clip(gain_left_to_distribute, range.start(), range.stop()),
                 max_step));
@@ -125,7 +244,7 @@ public:
 
         // get a list of indexes sorted by step size large to small
         std::vector<size_t> indexes_step_size_dec;
-        for (size_t i = 0; i < all_fcns.size(); i++) {
+        for (size_t i = 0; i < ranges.size(); i++) {
             indexes_step_size_dec.push_back(i);
         }
         std::sort(indexes_step_size_dec.begin(),
@@ -133,14 +252,14 @@ public:
             std::bind(&compare_by_step_size,
                 std::placeholders::_1,
                 std::placeholders::_2,
-                all_fcns));
-        UHD_ASSERT_THROW(all_fcns.at(indexes_step_size_dec.front()).get_range().step()
-                         >= all_fcns.at(indexes_step_size_dec.back()).get_range().step());
+                std::cref(ranges)));
+        UHD_ASSERT_THROW(ranges.at(indexes_step_size_dec.front()).step()
+                         >= ranges.at(indexes_step_size_dec.back()).step());
 
         // distribute the remainder (less than max step)
         // fill in the largest step sizes first that are less than the remainder
         for (size_t i : indexes_step_size_dec) {
-            const gain_range_t range = all_fcns.at(i).get_range();
+            const gain_range_t& range = ranges.at(i);
             double additional_gain =
                 floor_step(uhd::clip(gain_bucket.at(i) + gain_left_to_distribute,
                                range.start(),
@@ -150,43 +269,15 @@ public:
             gain_bucket.at(i) += additional_gain;
             gain_left_to_distribute -= additional_gain;
         }
-
-        // now write the bucket out to the individual gain values
-        for (size_t i = 0; i < gain_bucket.size(); i++) {
-            all_fcns.at(i).set_value(gain_bucket.at(i));
-        }
-    }
-
-    const std::vector<std::string> get_names(void)
-    {
-        return _name_to_fcns.keys();
-    }
-
-    void register_fcns(
-        const std::string& name, const gain_fcns_t& gain_fcns, size_t priority)
-    {
-        if (name.empty() or _name_to_fcns.has_key(name)) {
-            // ensure the name name is unique and non-empty
-            return register_fcns(name + "_", gain_fcns, priority);
-        }
-        _registry[priority].push_back(gain_fcns);
-        _name_to_fcns[name] = gain_fcns;
-    }
-
-private:
-    //! get the gain function sets in order (highest priority first)
-    std::vector<gain_fcns_t> get_all_fcns(void)
-    {
-        std::vector<gain_fcns_t> all_fcns;
-        for (size_t key : uhd::sorted(_registry.keys())) {
-            const std::vector<gain_fcns_t>& fcns = _registry[key];
-            all_fcns.insert(all_fcns.begin(), fcns.begin(), fcns.end());
-        }
-        return all_fcns;
+        return gain_bucket;
     }
 
     uhd::dict<size_t, std::vector<gain_fcns_t>> _registry;
     uhd::dict<std::string, gain_fcns_t> _name_to_fcns;
+
+    //! Gain tables, by the (start, stop, step) of all element ranges
+    std::map<std::vector<double>, gain_table_t> _gain_tables;
+    std::mutex _tables_mutex;
 };
 
 /***********************************************************************
@@ -11,6 +11,7 @@
 #include <uhd/utils/graph_utils.hpp>
 #include <uhd/utils/log.hpp>
 #include <boost/format.hpp>
+#include <map>
 #include <numeric>
 #include <utility>
 
@@ -38,42 +39,34 @@ std::vector<graph_edge_t> get_block_chain(const rfnoc_graph::sptr graph,
     const size_t port,
     const bool source_chain)
 {
-    // Enumerate blocks in the chain
-    auto edges = graph->enumerate_static_connections();
+    // Index the static connections by the block port the chain enters them
+    // from, so every hop is a lookup rather than a scan of all edges
+    std::map<std::pair<std::string, size_t>, graph_edge_t> edges;
+    for (auto& edge : graph->enumerate_static_connections()) {
+        edges.emplace(source_chain ? std::make_pair(edge.src_blockid, edge.src_port)
+                                   : std::make_pair(edge.dst_blockid, edge.dst_port),
+            edge);
+    }
 
     std::vector<graph_edge_t> block_chain;
     std::string current_block = start_block.to_string();
     size_t current_port       = port;
-    while (true) {
+    while (block_chain.size() < edges.size()) {
         UHD_LOG_TRACE("GRAPH_UTILS",
             "Looking for current block " << current_block << ", port " << current_port);
-        bool next_found = false;
-        for (auto& edge : edges) {
-            if ((source_chain)
-                    ? (edge.src_blockid == current_block && edge.src_port == current_port)
-                    : (edge.dst_blockid == current_block
-                        && edge.dst_port == current_port)) {
-                // If the current block is the edge's source, make the edge's
-                // destination the current block
-                next_found = true;
-                UHD_LOG_TRACE("GRAPH_UTILS", "Found next block: " + edge.dst_blockid);
-
-                block_chain.push_back(edge);
-                current_block = (source_chain) ? edge.dst_blockid : edge.src_blockid;
-                current_port  = (source_chain) ? edge.dst_port : edge.src_port;
-                // Compare our current block and port
-                if (check_terminator_block(current_block, current_port)) {
-                    // If we've found a terminating block, stop iterating through the
-                    // edges
-                    break;
-                }
-            }
-        }
-        if (not next_found) {
+        auto edge_it = edges.find({current_block, current_port});
+        if (edge_it == edges.end()) {
             UHD_LOG_TRACE(
                 "GRAPH_UTILS", "Failed to find current block in static connections");
             break;
         }
+        const auto& edge = edge_it->second;
+        // If the current block is the edge's source, make the edge's
+        // destination the current block
+        UHD_LOG_TRACE("GRAPH_UTILS", "Found next block: " + edge.dst_blockid);
+        block_chain.push_back(edge);
+        current_block = (source_chain) ? edge.dst_blockid : edge.src_blockid;
+        current_port  = (source_chain) ? edge.dst_port : edge.src_port;
         if (check_terminator_block(current_block, current_port)) {
             // If we've found a terminating block, stop iterating through the edges
             break;
@@ -0,0 +1,262 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhdlib/utils/init_timeline.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+using namespace uhd::init_timeline;
+
+namespace {
+
+const std::string LOG_ID = "INIT_TIMELINE";
+
+//! Name of the environment variable that controls the output
+constexpr char TIMELINE_ENV[] = "UHD_INIT_TIMELINE";
+
+//! Width of the name column of the logged tree
+constexpr size_t NAME_WIDTH = 56;
+
+using timeline_clock = std::chrono::steady_clock;
+
+struct span_t
+{
+    std::string name;
+    span_id_t parent;
+    span_id_t root;
+    size_t thread;
+    bool parallel;
+    timeline_clock::time_point start;
+    timeline_clock::time_point end;
+    bool open;
+};
+
+std::atomic<size_t> next_thread_index{0};
+
+//! Index of the calling thread in the trace
+size_t get_thread_index()
+{
+    thread_local const size_t index = next_thread_index++;
+    return index;
+}
+
+thread_local span_id_t current_span = NO_SPAN;
+
+std::string escape(const std::string& str)
+{
+    std::string escaped;
+    for (const char c : str) {
+        if (c == '"' || c == '\\') {
+            escaped.push_back('\\');
+        }
+        escaped.push_back(c);
+    }
+    return escaped;
+}
+
+class timeline_recorder
+{
+public:
+    timeline_recorder() : _epoch(timeline_clock::now())
+    {
+        const char* output = std::getenv(TIMELINE_ENV);
+        if (output && output[0] != '\0') {
+            _output = output;
+        }
+    }
+
+    span_id_t open(const std::string& name, const span_id_t parent, const bool parallel)
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        const span_id_t id = _spans.size() + 1;
+        const bool has_parent = parent != NO_SPAN && parent <= _spans.size();
+        const size_t thread   = get_thread_index();
+        _spans.push_back({name,
+            has_parent ? parent : NO_SPAN,
+            has_parent ? _get(parent).root : id,
+            thread,
+            // A subphase that was handed a parent, but runs on the same thread
+            // (e.g., with serialize_init) is not parallel
+            parallel && has_parent && _get(parent).thread != thread,
+            timeline_clock::now(),
+            timeline_clock::time_point(),
+            true});
+        return id;
+    }
+
+    void close(const span_id_t id)
+    {
+        std::string tree;
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            if (id == NO_SPAN || id > _spans.size()) {
+                // The timeline was cleared meanwhile
+                return;
+            }
+            span_t& span = _get(id);
+            span.end     = timeline_clock::now();
+            span.open    = false;
+            if (span.root != id) {
+                return;
+            }
+            tree = _format_tree(id);
+        }
+
+        if (_output == "log") {
+            UHD_LOG_INFO(LOG_ID, "Initialization timeline:\n" << tree);
+        } else {
+            UHD_LOG_DEBUG(LOG_ID, "Initialization timeline:\n" << tree);
+            if (!_output.empty()) {
+                try {
+                    uhd::init_timeline::dump(_output);
+                } catch (const uhd::exception& ex) {
+                    UHD_LOG_WARNING(LOG_ID, ex.what());
+                }
+            }
+        }
+    }
+
+    void dump(std::ostream& out)
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        out << "{\"traceEvents\":[";
+        bool first = true;
+        for (const span_t& span : _spans) {
+            if (span.open) {
+                continue;
+            }
+            using std::chrono::microseconds;
+            const auto start_us =
+                std::chrono::duration_cast<microseconds>(span.start - _epoch);
+            const auto dur_us =
+                std::chrono::duration_cast<microseconds>(span.end - span.start);
+            out << (first ? "\n" : ",\n") << "{\"name\":\"" << escape(span.name)
+                << "\",\"cat\":\"init\",\"ph\":\"X\",\"pid\":0,\"tid\":" << span.thread
+                << ",\"ts\":" << start_us.count() << ",\"dur\":" << dur_us.count()
+                << ",\"args\":{\"parallel\":" << (span.parallel ? "true" : "false");
+            if (span.parent != NO_SPAN) {
+                out << ",\"parent\":\"" << escape(_get(span.parent).name) << "\"";
+            }
+            out << "}}";
+            first = false;
+        }
+        out << "\n]}\n";
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _spans.clear();
+    }
+
+private:
+    span_t& _get(const span_id_t id)
+    {
+        return _spans[id - 1];
+    }
+
+    //! Formats the tree below a root span, one span per line
+    std::string _format_tree(const span_id_t root)
+    {
+        // Children always have larger IDs than their parents, so the depth of
+        // each span is known by the time it is reached
+        std::vector<std::vector<span_id_t>> children(_spans.size() + 1);
+        for (span_id_t id = root + 1; id <= _spans.size(); id++) {
+            if (_get(id).root == root) {
+                children[_get(id).parent].push_back(id);
+            }
+        }
+
+        std::ostringstream tree;
+        std::vector<std::pair<span_id_t, size_t>> stack{{root, 0}};
+        while (!stack.empty()) {
+            const span_id_t id = stack.back().first;
+            const size_t depth = stack.back().second;
+            const span_t& span = _get(id);
+            stack.pop_back();
+
+            const std::string label =
+                std::string(2 * depth, ' ') + (span.parallel ? "|| " : "") + span.name;
+            tree << "  " << std::left << std::setw(NAME_WIDTH) << label << std::right;
+            if (span.open) {
+                tree << "     (still running)";
+            } else {
+                const std::chrono::duration<double> duration = span.end - span.start;
+                tree << std::fixed << std::setprecision(3) << std::setw(9)
+                     << duration.count() << " s";
+            }
+            tree << "\n";
+            for (auto it = children[id].rbegin(); it != children[id].rend(); ++it) {
+                stack.push_back({*it, depth + 1});
+            }
+        }
+        tree << "  (|| marks phases that run in parallel to their parent's thread)";
+        return tree.str();
+    }
+
+    const timeline_clock::time_point _epoch;
+    std::string _output;
+    std::mutex _mutex;
+    std::vector<span_t> _spans;
+};
+
+timeline_recorder& get_recorder()
+{
+    static timeline_recorder recorder;
+    return recorder;
+}
+
+} // namespace
+
+span_id_t uhd::init_timeline::get_current_span()
+{
+    return current_span;
+}
+
+scoped_span::scoped_span(const std::string& name)
+    : _id(get_recorder().open(name, current_span, false)), _prev_span(current_span)
+{
+    current_span = _id;
+}
+
+scoped_span::scoped_span(const std::string& name, const span_id_t parent)
+    : _id(get_recorder().open(
+          name, parent == NO_SPAN ? current_span : parent, parent != NO_SPAN))
+    , _prev_span(current_span)
+{
+    current_span = _id;
+}
+
+scoped_span::~scoped_span()
+{
+    current_span = _prev_span;
+    get_recorder().close(_id);
+}
+
+void uhd::init_timeline::dump(const std::string& path)
+{
+    std::ofstream out(path);
+    if (!out) {
+        throw uhd::os_error("Could not open init timeline file " + path);
+    }
+    get_recorder().dump(out);
+    if (!out) {
+        throw uhd::os_error("Could not write init timeline file " + path);
+    }
+}
+
+void uhd::init_timeline::clear()
+{
+    get_recorder().clear();
+}
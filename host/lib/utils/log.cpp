@@ -15,12 +15,18 @@
 #include <uhd/version.hpp>
 #include <uhdlib/utils/isatty.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 namespace pt = boost::posix_time;
 
@@ -46,7 +52,6 @@ constexpr double READ_TIMEOUT = 0.5; // Waiting time to read from the queue
 
 constexpr char LOG_THREAD_NAME[]          = "uhd_log";
 constexpr char LOG_THREAD_NAME_FP[]       = "uhd_log_fastpath";
-constexpr char LOG_THREAD_NAME_FP_DUMMY[] = "uhd_log_fp_dummy";
 
 std::string verbosity_color(const uhd::log::severity_level& level)
 {
@@ -177,6 +182,102 @@ private:
  * Global resources for the logger
  **********************************************************************/
 
+#ifndef UHD_LOG_FASTPATH_DISABLE
+/*! A fastpath log message, as stored by the logging thread
+ *
+ * The message is either a format string literal plus its arguments, or (if
+ * format is nullptr) a copy of a plain text message.
+ */
+struct fastpath_record_t
+{
+    const char* format;
+    size_t num_args;
+    union {
+        uhd::_log::fastpath_arg_t args[uhd::_log::FASTPATH_MAX_ARGS];
+        char text[uhd::_log::FASTPATH_MAX_ARGS * sizeof(uhd::_log::fastpath_arg_t)];
+    };
+};
+
+/*! Single-producer, single-consumer ring of fastpath log records
+ *
+ * Every thread that logs on the fastpath gets its own ring, so pushing a
+ * record never locks nor allocates memory. If the ring is full, the record is
+ * dropped.
+ */
+class fastpath_ring
+{
+public:
+    //! Number of records per ring, must be a power of two
+    static constexpr size_t CAPACITY = 256;
+
+    bool push(const fastpath_record_t& record)
+    {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) == CAPACITY) {
+            return false;
+        }
+        _records[head & (CAPACITY - 1)] = record;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(fastpath_record_t& record)
+    {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        record = _records[tail & (CAPACITY - 1)];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const
+    {
+        return _tail.load(std::memory_order_acquire)
+               == _head.load(std::memory_order_acquire);
+    }
+
+private:
+    std::array<fastpath_record_t, CAPACITY> _records;
+    // Keep producer and consumer indices on separate cache lines
+    alignas(64) std::atomic<size_t> _head{0};
+    alignas(64) std::atomic<size_t> _tail{0};
+};
+
+//! Append a fastpath record, formatted, to a string
+void format_fastpath_record(const fastpath_record_t& record, std::string& out)
+{
+    if (!record.format) {
+        out += record.text;
+        return;
+    }
+    size_t arg_idx = 0;
+    for (const char* c = record.format; *c != '\0'; c++) {
+        if (c[0] != '{' || c[1] != '}' || arg_idx >= record.num_args) {
+            out += *c;
+            continue;
+        }
+        const auto& arg = record.args[arg_idx++];
+        char buf[32];
+        switch (arg.type) {
+            case uhd::_log::fastpath_arg_t::INT:
+                std::snprintf(buf, sizeof(buf), "%lld", static_cast<long long>(arg.i));
+                break;
+            case uhd::_log::fastpath_arg_t::UINT:
+                std::snprintf(
+                    buf, sizeof(buf), "%llu", static_cast<unsigned long long>(arg.u));
+                break;
+            case uhd::_log::fastpath_arg_t::REAL:
+                std::snprintf(buf, sizeof(buf), "%g", arg.r);
+                break;
+        }
+        out += buf;
+        c++;
+    }
+}
+#endif
+
 #define UHD_CONSOLE_LOGGER_KEY "console"
 #define UHD_FILE_LOGGER_KEY "file"
 
@@ -186,14 +287,7 @@ public:
     uhd::log::severity_level global_level;
 
     log_resource(void)
-        : global_level(uhd::log::off)
-        , _exit(false)
-        ,
-#ifndef UHD_LOG_FASTPATH_DISABLE
-        _fastpath_queue(10)
-        ,
-#endif
-        _log_queue(10)
+        : global_level(uhd::log::off), _exit(false), _log_queue(10)
     {
         // allow override from macro definition
 #ifdef UHD_LOG_MIN_LEVEL
@@ -236,13 +330,11 @@ public:
         }();
 
         if (enable_fastpath) {
+            _fastpath_enabled  = true;
             _pop_fastpath_task = std::make_shared<std::thread>(
                 std::thread([this]() { this->pop_fastpath_task(); }));
             uhd::set_thread_name(_pop_fastpath_task.get(), LOG_THREAD_NAME_FP);
         } else {
-            _pop_fastpath_task = std::make_shared<std::thread>(
-                std::thread([this]() { this->pop_fastpath_dummy_task(); }));
-            uhd::set_thread_name(_pop_fastpath_task.get(), LOG_THREAD_NAME_FP_DUMMY);
             _publish_log_msg("Fastpath logging disabled at runtime.");
         }
 #else
@@ -269,9 +361,6 @@ public:
             boost::this_thread::get_id());
         final_message.message = "";
         push(final_message);
-#    ifndef UHD_LOG_FASTPATH_DISABLE
-        push_fastpath("");
-#    endif
 #endif // BOOST_MSVC
 
         _pop_task->join();
@@ -281,8 +370,10 @@ public:
         }
         _pop_task.reset();
 #ifndef UHD_LOG_FASTPATH_DISABLE
-        _pop_fastpath_task->join();
-        _pop_fastpath_task.reset();
+        if (_pop_fastpath_task) {
+            _pop_fastpath_task->join();
+            _pop_fastpath_task.reset();
+        }
 #endif
     }
 
@@ -293,11 +384,18 @@ public:
     }
 
 #ifndef UHD_LOG_FASTPATH_DISABLE
-    void push_fastpath(const std::string& message)
+    void push_fastpath(const fastpath_record_t& record)
     {
-        // Never wait. If the buffer is full, we just don't see the message.
+        if (!_fastpath_enabled) {
+            return;
+        }
+        // The ring is created on the first fastpath message of this thread.
+        // It outlives the thread until the logging thread has drained it.
+        thread_local const std::shared_ptr<fastpath_ring> ring =
+            _register_fastpath_ring();
+        // Never wait. If the ring is full, we just don't see the message.
         // Too bad.
-        _fastpath_queue.push_with_haste(message);
+        ring->push(record);
     }
 #endif
 
@@ -346,44 +444,22 @@ public:
     void pop_fastpath_task()
     {
 #ifndef UHD_LOG_FASTPATH_DISABLE
-        std::string msg;
+        // The producers never signal us, so poll the rings. Back off while
+        // there's nothing to print, so an idle application doesn't spin.
+        constexpr auto MIN_IDLE_WAIT = std::chrono::microseconds(100);
+        constexpr auto MAX_IDLE_WAIT = std::chrono::microseconds(10000);
+        auto idle_wait               = MIN_IDLE_WAIT;
         while (!_exit) {
-#    ifdef BOOST_MSVC
-            // Some versions of MSVC will hang if threads are being joined after main has
-            // completed, so we need to guarantee a timeout here
-            if (_fastpath_queue.pop_with_timed_wait(msg, READ_TIMEOUT)) {
-                std::cerr << msg << std::flush;
+            if (_drain_fastpath_rings()) {
+                idle_wait = MIN_IDLE_WAIT;
+            } else {
+                std::this_thread::sleep_for(idle_wait);
+                idle_wait = std::min(idle_wait * 2, MAX_IDLE_WAIT);
             }
-#    else
-            _fastpath_queue.pop_with_wait(msg);
-            std::cerr << msg << std::flush;
-#    endif // BOOST_MSVC
         }
 
-        // Exit procedure: Clear the queue
-        while (_fastpath_queue.pop_with_haste(msg)) {
-            std::cerr << msg << std::flush;
-        }
-#endif
-    }
-
-    void pop_fastpath_dummy_task()
-    {
-#ifndef UHD_LOG_FASTPATH_DISABLE
-        std::string msg;
-        while (!_exit) {
-#    ifdef BOOST_MSVC
-            // Some versions of MSVC will hang if threads are being joined after main has
-            // completed, so we need to guarantee a timeout here
-            _fastpath_queue.pop_with_timed_wait(msg, READ_TIMEOUT);
-#    else
-            _fastpath_queue.pop_with_wait(msg);
-#    endif // BOOST_MSVC
-        }
-
-        // Exit procedure: Clear the queue
-        while (_fastpath_queue.pop_with_haste(msg))
-            ;
+        // Exit procedure: Clear the rings
+        _drain_fastpath_rings();
 #endif
     }
 
@@ -403,6 +479,47 @@ private:
     std::shared_ptr<std::thread> _pop_task;
 #ifndef UHD_LOG_FASTPATH_DISABLE
     std::shared_ptr<std::thread> _pop_fastpath_task;
+
+    std::shared_ptr<fastpath_ring> _register_fastpath_ring()
+    {
+        auto ring = std::make_shared<fastpath_ring>();
+        std::lock_guard<std::mutex> l(_fastpath_mutex);
+        _fastpath_rings.push_back(ring);
+        return ring;
+    }
+
+    /*! Print the records of all rings, and forget the rings of threads that
+     *  have exited.
+     *
+     * \return true if anything was printed
+     */
+    bool _drain_fastpath_rings()
+    {
+        {
+            std::lock_guard<std::mutex> l(_fastpath_mutex);
+            _drain_rings = _fastpath_rings;
+            // A ring we hold the only reference to belongs to an exited thread
+            _fastpath_rings.erase(std::remove_if(_fastpath_rings.begin(),
+                                      _fastpath_rings.end(),
+                                      [](const std::shared_ptr<fastpath_ring>& ring) {
+                                          return ring.use_count() == 2 && ring->empty();
+                                      }),
+                _fastpath_rings.end());
+        }
+        _drain_buf.clear();
+        fastpath_record_t record;
+        for (const auto& ring : _drain_rings) {
+            while (ring->pop(record)) {
+                format_fastpath_record(record, _drain_buf);
+            }
+        }
+        _drain_rings.clear();
+        if (_drain_buf.empty()) {
+            return false;
+        }
+        std::cerr << _drain_buf << std::flush;
+        return true;
+    }
 #endif
     uhd::log::severity_level _get_log_level(
         const std::string& log_level_str, const uhd::log::severity_level& previous_level)
@@ -492,7 +609,13 @@ private:
     using level_logfn_pair = std::pair<uhd::log::severity_level, uhd::log::log_fn_t>;
     std::map<std::string, level_logfn_pair> _loggers;
 #ifndef UHD_LOG_FASTPATH_DISABLE
-    uhd::transport::bounded_buffer<std::string> _fastpath_queue;
+    bool _fastpath_enabled = false;
+    //! Protects _fastpath_rings
+    std::mutex _fastpath_mutex;
+    std::vector<std::shared_ptr<fastpath_ring>> _fastpath_rings;
+    // Only used by the fastpath logging thread
+    std::vector<std::shared_ptr<fastpath_ring>> _drain_rings;
+    std::string _drain_buf;
 #endif
     uhd::transport::bounded_buffer<uhd::log::logging_info> _log_queue;
 };
@@ -533,13 +656,45 @@ uhd::_log::log::~log(void)
 #ifndef UHD_LOG_FASTPATH_DISABLE
 void uhd::_log::log_fastpath(const std::string& msg)
 {
-    log_rs().push_fastpath(msg);
+    log_fastpath(msg.c_str());
+}
+
+void uhd::_log::log_fastpath(const char* msg)
+{
+    // Copy the message, the pointer may not outlive this call. Long messages
+    // are truncated.
+    fastpath_record_t record;
+    record.format   = nullptr;
+    record.num_args = 0;
+    std::strncpy(record.text, msg, sizeof(record.text) - 1);
+    record.text[sizeof(record.text) - 1] = '\0';
+    log_rs().push_fastpath(record);
+}
+
+void uhd::_log::log_fastpath(
+    const char* format, const fastpath_arg_t* args, const size_t num_args)
+{
+    fastpath_record_t record;
+    record.format   = format;
+    record.num_args = std::min(num_args, FASTPATH_MAX_ARGS);
+    std::copy(args, args + record.num_args, record.args);
+    log_rs().push_fastpath(record);
 }
 #else
 void uhd::_log::log_fastpath(const std::string&)
 {
     // nop
 }
+
+void uhd::_log::log_fastpath(const char*)
+{
+    // nop
+}
+
+void uhd::_log::log_fastpath(const char*, const fastpath_arg_t*, const size_t)
+{
+    // nop
+}
 #endif
 
 /***********************************************************************
@@ -0,0 +1,48 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/utils/memory_usage.hpp>
+#include <map>
+#include <mutex>
+
+namespace {
+
+struct memory_usage_t
+{
+    std::mutex mutex;
+    std::map<std::string, size_t> bytes;
+};
+
+//! Never destroyed, as buffers may still be freed while statics are destroyed
+memory_usage_t& get_usage()
+{
+    static memory_usage_t* usage = new memory_usage_t;
+    return *usage;
+}
+
+} // namespace
+
+void uhd::add_memory_usage(const std::string& subsystem, const size_t bytes)
+{
+    memory_usage_t& usage = get_usage();
+    std::lock_guard<std::mutex> lock(usage.mutex);
+    usage.bytes[subsystem] += bytes;
+}
+
+void uhd::remove_memory_usage(const std::string& subsystem, const size_t bytes)
+{
+    memory_usage_t& usage = get_usage();
+    std::lock_guard<std::mutex> lock(usage.mutex);
+    size_t& total = usage.bytes[subsystem];
+    total         = (total > bytes) ? total - bytes : 0;
+}
+
+std::map<std::string, size_t> uhd::get_memory_usage()
+{
+    memory_usage_t& usage = get_usage();
+    std::lock_guard<std::mutex> lock(usage.mutex);
+    return usage.bytes;
+}
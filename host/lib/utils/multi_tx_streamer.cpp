@@ -0,0 +1,395 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/convert.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/multi_tx_streamer.hpp>
+#include <uhd/utils/safe_call.hpp>
+#include <uhd/utils/thread.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+using namespace uhd;
+
+multi_tx_streamer::~multi_tx_streamer() = default;
+
+namespace {
+
+constexpr char LOG_ID[] = "MULTI_TX";
+
+constexpr size_t DEFAULT_NUM_BLOCKS = 64;
+
+//! The most async messages that are queued for recv_async_msg()
+constexpr size_t MAX_ASYNC_MSGS = 1024;
+
+//! Timeout of every send() call of the workers, bounds the time to stop them
+constexpr double SEND_TIMEOUT = 0.1;
+
+struct block_t
+{
+    //! The samples of all channels, one after another
+    std::vector<char> data;
+    size_t nsamps = 0;
+    tx_metadata_t metadata;
+};
+
+//! The counters of device_status_t, which the workers update
+struct device_counters_t
+{
+    std::atomic<uint64_t> num_samps_sent{0};
+    std::atomic<uint64_t> num_late{0};
+    std::atomic<uint64_t> num_underflows{0};
+    std::atomic<uint64_t> num_seq_errors{0};
+    std::atomic<uint64_t> num_burst_acks{0};
+    std::atomic<uint64_t> num_send_errors{0};
+};
+
+struct device_t
+{
+    tx_streamer::sptr tx_stream;
+    //! The first channel of the device in the multi-device streamer
+    size_t first_chan;
+    size_t num_chans;
+    //! False if the worker has to poll for the async messages
+    bool has_async_callback = false;
+    //! The number of blocks the worker has taken out of the ring
+    uint64_t read_pos = 0;
+    //! The number of blocks the worker has sent
+    uint64_t done_pos = 0;
+    device_counters_t counters;
+    std::thread worker;
+};
+
+class multi_tx_streamer_impl : public multi_tx_streamer
+{
+public:
+    multi_tx_streamer_impl(const std::vector<tx_streamer::sptr>& tx_streams,
+        const std::string& cpu_format,
+        const uhd::device_addr_t& args)
+        : _samp_size(convert::get_bytes_per_item(cpu_format))
+        , _devices(tx_streams.size())
+    {
+        if (tx_streams.empty()) {
+            throw uhd::value_error("multi_tx_streamer: Need at least one streamer");
+        }
+        size_t max_num_samps = tx_streams.front()->get_max_num_samps();
+        for (size_t i = 0; i < tx_streams.size(); i++) {
+            _devices[i].tx_stream  = tx_streams[i];
+            _devices[i].first_chan = _num_chans;
+            _devices[i].num_chans  = tx_streams[i]->get_num_channels();
+            _num_chans += _devices[i].num_chans;
+            max_num_samps = std::min(max_num_samps, tx_streams[i]->get_max_num_samps());
+        }
+        _max_num_samps = max_num_samps;
+        _block_samps   = args.cast<size_t>("block_size", max_num_samps);
+        const size_t num_blocks = args.cast<size_t>("num_blocks", DEFAULT_NUM_BLOCKS);
+        if (_block_samps == 0 || num_blocks == 0) {
+            throw uhd::value_error(
+                "multi_tx_streamer: Block size and number of blocks must be non-zero");
+        }
+
+        _blocks.resize(num_blocks);
+        for (auto& block : _blocks) {
+            block.data.resize(_num_chans * _block_samps * _samp_size);
+        }
+
+        for (size_t i = 0; i < _devices.size(); i++) {
+            try {
+                _devices[i].tx_stream->set_async_msg_callback(
+                    [this, i](const async_metadata_t& md) { _handle_async_msg(i, md); });
+                _devices[i].has_async_callback = true;
+            } catch (const uhd::not_implemented_error&) {
+                // The worker polls for the messages between blocks
+            }
+        }
+        for (size_t i = 0; i < _devices.size(); i++) {
+            _devices[i].worker = std::thread([this, i]() { _worker_loop(i); });
+            uhd::set_thread_name(&_devices[i].worker, "multi_tx" + std::to_string(i));
+        }
+    }
+
+    ~multi_tx_streamer_impl() override
+    {
+        for (auto& device : _devices) {
+            if (device.has_async_callback) {
+                UHD_SAFE_CALL(device.tx_stream->set_async_msg_callback(nullptr);)
+            }
+        }
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            _stop = true;
+            _cond.notify_all();
+        }
+        for (auto& device : _devices) {
+            device.worker.join();
+        }
+    }
+
+    size_t get_num_channels() const override
+    {
+        return _num_chans;
+    }
+
+    size_t get_max_num_samps() const override
+    {
+        return _max_num_samps;
+    }
+
+    size_t send(const buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        const tx_metadata_t& metadata,
+        const double timeout) override
+    {
+        if (metadata.eov_positions && metadata.eov_positions_size > 0) {
+            throw uhd::value_error("multi_tx_streamer: EOV positions are not supported");
+        }
+        if (buffs.size() != _num_chans) {
+            throw uhd::value_error("multi_tx_streamer: Need one buffer per channel");
+        }
+        const auto deadline =
+            std::chrono::steady_clock::now()
+            + std::chrono::microseconds(static_cast<int64_t>(timeout * 1e6));
+
+        // Long sends are split into blocks. Only the first one starts the
+        // burst, only the last one ends it.
+        tx_metadata_t block_md = metadata;
+        size_t num_queued      = 0;
+        do {
+            block_t* block = nullptr;
+            {
+                std::unique_lock<std::mutex> l(_mutex);
+                if (!_cond.wait_until(
+                        l, deadline, [this]() { return _has_free_block(); })) {
+                    return num_queued;
+                }
+                block = &_blocks[_write_pos % _blocks.size()];
+            }
+
+            block->nsamps = std::min(_block_samps, nsamps_per_buff - num_queued);
+            for (size_t chan = 0; chan < _num_chans; chan++) {
+                std::memcpy(block->data.data() + chan * _block_samps * _samp_size,
+                    static_cast<const char*>(buffs[chan]) + num_queued * _samp_size,
+                    block->nsamps * _samp_size);
+            }
+            num_queued += block->nsamps;
+            block->metadata              = block_md;
+            block->metadata.end_of_burst = metadata.end_of_burst
+                                           && num_queued == nsamps_per_buff;
+            block_md.start_of_burst = false;
+            block_md.has_time_spec  = false;
+            block_md.has_time_ticks = false;
+
+            std::lock_guard<std::mutex> l(_mutex);
+            _write_pos++;
+            _cond.notify_all();
+        } while (num_queued < nsamps_per_buff);
+        return num_queued;
+    }
+
+    bool recv_async_msg(async_metadata_t& async_metadata, double timeout) override
+    {
+        std::unique_lock<std::mutex> l(_async_mutex);
+        if (!_async_cond.wait_for(l,
+                std::chrono::microseconds(static_cast<int64_t>(timeout * 1e6)),
+                [this]() { return !_async_msgs.empty(); })) {
+            return false;
+        }
+        async_metadata = _async_msgs.front();
+        _async_msgs.pop_front();
+        return true;
+    }
+
+    size_t get_num_devices() const override
+    {
+        return _devices.size();
+    }
+
+    device_status_t get_device_status(const size_t device) const override
+    {
+        const device_t& dev = _devices.at(device);
+        device_status_t status;
+        status.num_samps_sent  = dev.counters.num_samps_sent;
+        status.num_late        = dev.counters.num_late;
+        status.num_underflows  = dev.counters.num_underflows;
+        status.num_seq_errors  = dev.counters.num_seq_errors;
+        status.num_burst_acks  = dev.counters.num_burst_acks;
+        status.num_send_errors = dev.counters.num_send_errors;
+        std::lock_guard<std::mutex> l(_mutex);
+        status.num_blocks_queued = static_cast<size_t>(_write_pos - dev.done_pos);
+        return status;
+    }
+
+    bool wait_sent(const double timeout) override
+    {
+        std::unique_lock<std::mutex> l(_mutex);
+        return _cond.wait_for(l,
+            std::chrono::microseconds(static_cast<int64_t>(timeout * 1e6)),
+            [this]() {
+                return std::all_of(
+                    _devices.begin(), _devices.end(), [this](const device_t& dev) {
+                        return dev.done_pos == _write_pos;
+                    });
+            });
+    }
+
+private:
+    //! True if the slowest device is done with the block at the write position
+    bool _has_free_block() const
+    {
+        for (const auto& device : _devices) {
+            if (_write_pos - device.done_pos >= _blocks.size()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //! Runs on the worker thread of a device, sends the blocks to its streamer
+    void _worker_loop(const size_t device_index)
+    {
+        device_t& device = _devices[device_index];
+        std::vector<const void*> buffs(device.num_chans);
+        bool in_burst = false;
+        while (true) {
+            const block_t* block = nullptr;
+            {
+                std::unique_lock<std::mutex> l(_mutex);
+                _cond.wait(l, [&]() { return device.read_pos < _write_pos || _stop; });
+                if (_stop) {
+                    break;
+                }
+                block = &_blocks[device.read_pos % _blocks.size()];
+                device.read_pos++;
+            }
+
+            tx_metadata_t md = block->metadata;
+            size_t num_sent  = 0;
+            try {
+                // A timeout only means that the device has no credit yet
+                // (e.g., before a timed burst), keep trying
+                do {
+                    for (size_t chan = 0; chan < device.num_chans; chan++) {
+                        buffs[chan] = block->data.data()
+                                      + ((device.first_chan + chan) * _block_samps
+                                            + num_sent)
+                                            * _samp_size;
+                    }
+                    const size_t result = device.tx_stream->send(
+                        buffs, block->nsamps - num_sent, md, SEND_TIMEOUT);
+                    num_sent += result;
+                    if (result > 0) {
+                        md.start_of_burst = false;
+                        md.has_time_spec  = false;
+                        md.has_time_ticks = false;
+                    }
+                } while (num_sent < block->nsamps && !_stop);
+                device.counters.num_samps_sent += num_sent;
+                if (block->metadata.start_of_burst) {
+                    in_burst = true;
+                }
+                if (block->metadata.end_of_burst && num_sent == block->nsamps) {
+                    in_burst = false;
+                }
+            } catch (const uhd::exception& ex) {
+                device.counters.num_send_errors++;
+                UHD_LOG_ERROR(LOG_ID,
+                    "Error sending to device " << device_index << ": " << ex.what());
+            }
+            if (!device.has_async_callback) {
+                _poll_async_msgs(device_index);
+            }
+
+            std::lock_guard<std::mutex> l(_mutex);
+            device.done_pos++;
+            _cond.notify_all();
+        }
+
+        if (in_burst) {
+            tx_metadata_t md;
+            md.end_of_burst = true;
+            UHD_SAFE_CALL(device.tx_stream->send(buffs, 0, md, SEND_TIMEOUT);)
+        }
+    }
+
+    void _poll_async_msgs(const size_t device_index)
+    {
+        async_metadata_t md;
+        while (_devices[device_index].tx_stream->recv_async_msg(md, 0.0)) {
+            _handle_async_msg(device_index, md);
+        }
+    }
+
+    //! Counts a message of a device, and queues it for recv_async_msg()
+    void _handle_async_msg(const size_t device_index, const async_metadata_t& md)
+    {
+        device_t& device = _devices[device_index];
+        switch (md.event_code) {
+            case async_metadata_t::EVENT_CODE_BURST_ACK:
+                device.counters.num_burst_acks++;
+                break;
+            case async_metadata_t::EVENT_CODE_UNDERFLOW:
+            case async_metadata_t::EVENT_CODE_UNDERFLOW_IN_PACKET:
+                device.counters.num_underflows++;
+                break;
+            case async_metadata_t::EVENT_CODE_SEQ_ERROR:
+            case async_metadata_t::EVENT_CODE_SEQ_ERROR_IN_BURST:
+                device.counters.num_seq_errors++;
+                break;
+            case async_metadata_t::EVENT_CODE_TIME_ERROR:
+                device.counters.num_late++;
+                break;
+            default:
+                break;
+        }
+
+        async_metadata_t msg = md;
+        msg.channel += device.first_chan;
+        {
+            std::lock_guard<std::mutex> l(_async_mutex);
+            if (_async_msgs.size() == MAX_ASYNC_MSGS) {
+                _async_msgs.pop_front();
+            }
+            _async_msgs.push_back(msg);
+        }
+        _async_cond.notify_one();
+    }
+
+    const size_t _samp_size;
+    size_t _num_chans = 0;
+    size_t _max_num_samps;
+    size_t _block_samps;
+
+    //! Protects the positions in the ring
+    mutable std::mutex _mutex;
+    std::condition_variable _cond;
+    std::vector<block_t> _blocks;
+    //! The number of blocks that send() has put into the ring
+    uint64_t _write_pos = 0;
+    std::atomic<bool> _stop{false};
+    std::vector<device_t> _devices;
+
+    std::mutex _async_mutex;
+    std::condition_variable _async_cond;
+    std::deque<async_metadata_t> _async_msgs;
+};
+
+} // namespace
+
+multi_tx_streamer::sptr multi_tx_streamer::make(
+    const std::vector<tx_streamer::sptr>& tx_streams,
+    const std::string& cpu_format,
+    const uhd::device_addr_t& args)
+{
+    return std::make_shared<multi_tx_streamer_impl>(tx_streams, cpu_format, args);
+}
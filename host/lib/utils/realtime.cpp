@@ -0,0 +1,221 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/realtime.hpp>
+#include <boost/algorithm/string.hpp>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#ifdef HAVE_MLOCKALL
+#    include <sys/mman.h>
+#    include <unistd.h>
+#endif
+#ifdef HAVE_PTHREAD_SETSCHEDPARAM
+#    include <pthread.h>
+#endif
+
+using namespace uhd;
+
+namespace {
+
+const std::string LOG_ID = "REALTIME";
+
+constexpr int MAX_PRIORITY = 99;
+
+std::mutex config_mutex;
+realtime_config_t config;
+
+const char* get_role_name(const thread_role_t role)
+{
+    switch (role) {
+        case thread_role_t::STREAMER:
+            return "streamer";
+        case thread_role_t::IO:
+            return "io";
+        case thread_role_t::CONVERT:
+            return "convert";
+    }
+    UHD_THROW_INVALID_CODE_PATH();
+}
+
+int parse_priority(const device_addr_t& args, const std::string& key)
+{
+    const int priority = args.cast<int>(key, 0);
+    if (priority < 0 || priority > MAX_PRIORITY) {
+        throw uhd::value_error("Invalid value for " + key + ": " + args[key]
+                               + " (expected 0 to " + std::to_string(MAX_PRIORITY)
+                               + ")");
+    }
+    return priority;
+}
+
+void lock_process_memory(const realtime_config_t::lock_mode_t mode)
+{
+    if (mode == realtime_config_t::LOCK_NONE) {
+        return;
+    }
+#ifdef HAVE_MLOCKALL
+    const int flags = mode == realtime_config_t::LOCK_ALL ? (MCL_CURRENT | MCL_FUTURE)
+                                                          : MCL_CURRENT;
+    if (::mlockall(flags) != 0) {
+        UHD_LOG_WARNING(LOG_ID,
+            "Failed to lock the memory of the process ("
+                << std::strerror(errno)
+                << "). Raise the memlock limit in /etc/security/limits.conf.");
+        return;
+    }
+    UHD_LOG_INFO(LOG_ID,
+        "Locked the "
+            << (mode == realtime_config_t::LOCK_ALL ? "current and future" : "current")
+            << " memory of the process");
+#else
+    UHD_LOG_WARNING(LOG_ID, "Locking memory is not supported on this platform.");
+#endif
+}
+
+} // namespace
+
+int realtime_config_t::get_priority(const thread_role_t role) const
+{
+    switch (role) {
+        case thread_role_t::STREAMER:
+            return streamer_priority;
+        case thread_role_t::IO:
+            return io_priority;
+        case thread_role_t::CONVERT:
+            return convert_priority;
+    }
+    UHD_THROW_INVALID_CODE_PATH();
+}
+
+bool realtime_config_t::is_enabled() const
+{
+    return lock_memory != LOCK_NONE || prefault || streamer_priority != 0
+           || io_priority != 0 || convert_priority != 0;
+}
+
+realtime_config_t uhd::parse_realtime_args(const device_addr_t& args)
+{
+    realtime_config_t rt_config;
+    if (args.has_key("rt_lock_memory")) {
+        const std::string mode = boost::algorithm::to_lower_copy(args["rt_lock_memory"]);
+        if (mode == "none" || mode == "0") {
+            rt_config.lock_memory = realtime_config_t::LOCK_NONE;
+        } else if (mode == "current") {
+            rt_config.lock_memory = realtime_config_t::LOCK_CURRENT;
+        } else if (mode == "all" || mode == "1") {
+            rt_config.lock_memory = realtime_config_t::LOCK_ALL;
+        } else {
+            throw uhd::value_error("Invalid value for rt_lock_memory: "
+                                   + args["rt_lock_memory"]
+                                   + " (expected none, current or all)");
+        }
+    }
+    rt_config.prefault          = args.cast<bool>("rt_prefault", false);
+    rt_config.streamer_priority = parse_priority(args, "rt_priority_streamer");
+    rt_config.io_priority       = parse_priority(args, "rt_priority_io");
+    rt_config.convert_priority  = parse_priority(args, "rt_priority_convert");
+    return rt_config;
+}
+
+void uhd::setup_realtime_process(const realtime_config_t& rt_config)
+{
+    std::lock_guard<std::mutex> l(config_mutex);
+    if (rt_config.lock_memory > config.lock_memory) {
+        lock_process_memory(rt_config.lock_memory);
+    }
+    config = rt_config;
+}
+
+realtime_config_t uhd::get_realtime_config()
+{
+    std::lock_guard<std::mutex> l(config_mutex);
+    return config;
+}
+
+bool uhd::setup_realtime_thread(const thread_role_t role)
+{
+    const int priority = get_realtime_config().get_priority(role);
+    if (priority == 0) {
+        return true;
+    }
+#ifdef HAVE_PTHREAD_SETSCHEDPARAM
+    sched_param sp;
+    sp.sched_priority = priority;
+    const int ret     = pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+    if (ret != 0) {
+        UHD_LOG_WARNING(LOG_ID,
+            "Failed to set SCHED_FIFO priority "
+                << priority << " for a " << get_role_name(role) << " thread ("
+                << std::strerror(ret)
+                << "). Raise the rtprio limit in /etc/security/limits.conf.");
+        return false;
+    }
+    UHD_LOG_DEBUG(LOG_ID,
+        "Set SCHED_FIFO priority " << priority << " for a " << get_role_name(role)
+                                   << " thread");
+    return true;
+#else
+    UHD_LOG_WARNING(LOG_ID,
+        "Real-time scheduling is not supported on this platform, not setting the "
+        "priority of a "
+            << get_role_name(role) << " thread.");
+    return false;
+#endif
+}
+
+void uhd::prefault_memory(void* mem, const size_t size)
+{
+    if (size == 0) {
+        return;
+    }
+#ifdef HAVE_MLOCKALL
+    const size_t page_size = size_t(::sysconf(_SC_PAGESIZE));
+#else
+    // Pages are at least this large
+    const size_t page_size = 4096;
+#endif
+    // Writing faults in a private page, reading alone could map the shared
+    // zero page
+    volatile char* bytes = static_cast<volatile char*>(mem);
+    for (size_t offset = 0; offset < size; offset += page_size) {
+        bytes[offset] = bytes[offset];
+    }
+    bytes[size - 1] = bytes[size - 1];
+}
+
+bool uhd::lock_memory(void* mem, const size_t size)
+{
+#ifdef HAVE_MLOCKALL
+    if (::mlock(mem, size) != 0) {
+        UHD_LOG_WARNING(LOG_ID,
+            "Failed to lock a buffer of "
+                << size << " bytes into memory (" << std::strerror(errno)
+                << "). Raise the memlock limit in /etc/security/limits.conf.");
+        return false;
+    }
+    // mlock() also faults in the pages
+    return true;
+#else
+    prefault_memory(mem, size);
+    UHD_LOG_WARNING(LOG_ID, "Locking memory is not supported on this platform.");
+    return false;
+#endif
+}
+
+void uhd::unlock_memory(void* mem, const size_t size)
+{
+#ifdef HAVE_MLOCKALL
+    ::munlock(mem, size);
+#else
+    (void)mem;
+    (void)size;
+#endif
+}
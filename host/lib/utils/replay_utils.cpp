@@ -0,0 +1,535 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/types/stream_cmd.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/replay_utils.hpp>
+#include <uhd/utils/safe_call.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+
+namespace uhd { namespace rfnoc {
+
+namespace {
+
+constexpr char LOG_ID[] = "REPLAY_UTILS";
+
+//! Size of the chunks the data is transferred in
+constexpr size_t CHUNK_SIZE = 16 * 1024 * 1024;
+
+/*! The data is streamed as sc16, because the sc16 to sc16 converter copies
+ *  the data without touching it.
+ */
+constexpr char STREAM_FORMAT[] = "sc16";
+constexpr size_t ITEM_SIZE     = 4;
+
+//! Timeout for every chunk sent or received
+constexpr double STREAM_TIMEOUT = 1.0;
+
+//! Time the last packets may take to be written to memory after they were sent
+constexpr auto RECORD_TIMEOUT = std::chrono::seconds(1);
+
+//! Returns a pointer to the data of a chunk, given its offset and size
+using get_chunk_fn_t =
+    std::function<const void*(const uint64_t chunk_offset, const size_t chunk_size)>;
+
+void check_region(replay_block_control::sptr replay,
+    const uint64_t offset,
+    const uint64_t size,
+    const std::string& what)
+{
+    const uint64_t word_size = replay->get_word_size();
+    if (size == 0 || (size % word_size) != 0 || (offset % word_size) != 0) {
+        throw uhd::value_error(what + ": Offset and size must be non-zero multiples of "
+                               + std::to_string(word_size) + " bytes!");
+    }
+    if (offset + size > replay->get_mem_size()) {
+        throw uhd::value_error(what + ": Region exceeds the memory of the Replay block!");
+    }
+}
+
+stream_args_t make_stream_args(replay_block_control::sptr replay,
+    const size_t port,
+    const uhd::device_addr_t& streamer_args)
+{
+    stream_args_t stream_args(STREAM_FORMAT, STREAM_FORMAT);
+    stream_args.args               = streamer_args;
+    stream_args.args["block_id"]   = replay->get_block_id().to_string();
+    stream_args.args["block_port"] = std::to_string(port);
+    return stream_args;
+}
+
+void upload_chunks(rfnoc_graph::sptr graph,
+    replay_block_control::sptr replay,
+    const size_t port,
+    const uint64_t size,
+    const uint64_t offset,
+    const uhd::device_addr_t& streamer_args,
+    const get_chunk_fn_t& get_chunk)
+{
+    check_region(replay, offset, size, "replay_upload");
+
+    // The Replay block only writes whole words, so every packet must hold a
+    // whole number of them
+    stream_args_t stream_args   = make_stream_args(replay, port, streamer_args);
+    tx_streamer::sptr tx_stream = graph->create_tx_streamer(1, stream_args);
+    const size_t items_per_word = replay->get_word_size() / ITEM_SIZE;
+    const size_t spp            = tx_stream->get_max_num_samps();
+    if (spp % items_per_word != 0) {
+        tx_stream.reset();
+        stream_args.args["spp"] = std::to_string(spp - (spp % items_per_word));
+        tx_stream               = graph->create_tx_streamer(1, stream_args);
+    }
+    graph->connect(tx_stream, 0, replay->get_block_id(), port);
+    graph->commit();
+
+    replay->record(offset, size, port);
+
+    tx_metadata_t md;
+    md.start_of_burst = true;
+    for (uint64_t bytes_sent = 0; bytes_sent < size;) {
+        const size_t chunk_size =
+            static_cast<size_t>(std::min<uint64_t>(CHUNK_SIZE, size - bytes_sent));
+        const void* chunk   = get_chunk(bytes_sent, chunk_size);
+        const size_t nsamps = chunk_size / ITEM_SIZE;
+        md.end_of_burst     = (bytes_sent + chunk_size == size);
+        if (tx_stream->send(chunk, nsamps, md, STREAM_TIMEOUT) != nsamps) {
+            throw uhd::io_error("replay_upload: Timeout while sending data to "
+                                + replay->get_unique_id());
+        }
+        md.start_of_burst = false;
+        bytes_sent += chunk_size;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + RECORD_TIMEOUT;
+    while (replay->get_record_fullness(port) < size) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            throw uhd::io_error("replay_upload: Timeout while waiting for "
+                                + replay->get_unique_id()
+                                + " to record the data");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    UHD_LOG_DEBUG(
+        LOG_ID, "Uploaded " << size << " bytes to " << replay->get_unique_id());
+}
+
+/*! Reads a file chunk by chunk, reading the next chunk in the background
+ *
+ * The chunks must be requested in order, and a chunk is only valid until the
+ * next one is requested.
+ */
+class chunk_reader
+{
+public:
+    chunk_reader(const std::string& path, const uint64_t size)
+        : _file(path, std::ios::binary), _path(path), _size(size)
+    {
+        if (!_file) {
+            throw uhd::os_error("replay_upload_file: Could not open file " + path);
+        }
+        for (auto& buff : _buffs) {
+            buff.resize(static_cast<size_t>(std::min<uint64_t>(CHUNK_SIZE, size)));
+        }
+    }
+
+    ~chunk_reader()
+    {
+        // Don't leave the background read running on the buffers
+        if (_next_read.valid()) {
+            _next_read.wait();
+        }
+    }
+
+    const void* get_chunk(const uint64_t chunk_offset, const size_t chunk_size)
+    {
+        const size_t idx = _num_chunks++ % _buffs.size();
+        if (_next_read.valid()) {
+            _next_read.get();
+        } else {
+            read(idx, chunk_size);
+        }
+        // Read the next chunk while this one is sent
+        const uint64_t next_offset = chunk_offset + chunk_size;
+        if (next_offset < _size) {
+            const size_t next_size =
+                static_cast<size_t>(std::min<uint64_t>(CHUNK_SIZE, _size - next_offset));
+            const size_t next_idx = (idx + 1) % _buffs.size();
+            _next_read            = std::async(std::launch::async,
+                [this, next_idx, next_size]() { read(next_idx, next_size); });
+        }
+        return _buffs[idx].data();
+    }
+
+private:
+    void read(const size_t idx, const size_t size)
+    {
+        if (!_file.read(_buffs[idx].data(), size)) {
+            throw uhd::os_error("replay_upload_file: Could not read file " + _path);
+        }
+    }
+
+    std::ifstream _file;
+    const std::string _path;
+    const uint64_t _size;
+    std::array<std::vector<char>, 2> _buffs;
+    size_t _num_chunks = 0;
+    std::future<void> _next_read;
+};
+
+class replay_ring_reader_impl : public replay_ring_reader
+{
+public:
+    replay_ring_reader_impl(rfnoc_graph::sptr graph,
+        replay_block_control::sptr replay,
+        const size_t record_port,
+        const size_t play_port,
+        const uint64_t offset,
+        const uint64_t size,
+        const uhd::device_addr_t& streamer_args)
+        : _replay(replay)
+        , _record_port(record_port)
+        , _play_port(play_port)
+        , _offset(offset)
+        , _size(size)
+        , _word_size(replay->get_word_size())
+        // Don't move the window on by a few words at a time when the host is
+        // behind, every move stalls the recording for a moment
+        , _min_window_size(std::max<uint64_t>(_align(size / MIN_WINDOWS), _word_size))
+        , _play_size(std::min<uint64_t>(_align(CHUNK_SIZE), size))
+    {
+        check_region(replay, offset, size, "replay_ring_reader");
+        _rx_stream = graph->create_rx_streamer(
+            1, make_stream_args(replay, play_port, streamer_args));
+        graph->connect(replay->get_block_id(), play_port, _rx_stream, 0);
+        graph->commit();
+
+        _replay->record(_offset, _size, _record_port);
+        _window_size = _size;
+    }
+
+    ~replay_ring_reader_impl()
+    {
+        if (_play_issued != _read) {
+            UHD_SAFE_CALL(_replay->stop(_play_port);)
+        }
+    }
+
+    size_t read(void* buf, const size_t max_bytes, const double timeout)
+    {
+        const auto deadline = std::chrono::steady_clock::now()
+                              + std::chrono::duration_cast<std::chrono::microseconds>(
+                                  std::chrono::duration<double>(timeout));
+        service();
+        while (_play_issued == _read) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return 0;
+            }
+            std::this_thread::sleep_for(POLL_INTERVAL);
+            service();
+        }
+
+        // Only ask for what was played, so the streamer doesn't wait for more
+        const size_t nsamps = static_cast<size_t>(
+            std::min<uint64_t>(max_bytes, _play_issued - _read) / ITEM_SIZE);
+        rx_metadata_t md;
+        const size_t nsamps_recvd = _rx_stream->recv(buf, nsamps, md, timeout, false);
+        if (md.error_code != rx_metadata_t::ERROR_CODE_NONE
+            && md.error_code != rx_metadata_t::ERROR_CODE_TIMEOUT) {
+            throw uhd::io_error("replay_ring_reader: Error while receiving data from "
+                                + _replay->get_unique_id() + ": " + md.strerror());
+        }
+        _read += nsamps_recvd * ITEM_SIZE;
+        return nsamps_recvd * ITEM_SIZE;
+    }
+
+    void service()
+    {
+        _move_window();
+        _issue_play();
+    }
+
+    uint64_t get_fill() const
+    {
+        return _recorded - _read;
+    }
+
+    stats_t get_stats() const
+    {
+        stats_t stats         = _stats;
+        stats.bytes_recorded  = _recorded;
+        stats.bytes_read      = _read;
+        stats.num_write_wraps = _window_start / _size;
+        stats.num_read_wraps  = _read / _size;
+        if (_stalled) {
+            stats.stall_time += _get_stall_time();
+        }
+        return stats;
+    }
+
+private:
+    //! The window is moved on by at least 1/MIN_WINDOWS of the ring
+    static constexpr uint64_t MIN_WINDOWS = 16;
+
+    //! Time between checks for new data while read() waits
+    static constexpr std::chrono::microseconds POLL_INTERVAL{100};
+
+    /* All positions are in bytes since the start of the recording, i.e., they
+     * keep counting up when the ring wraps around. The position in the ring is
+     * the position modulo the size of the ring.
+     */
+
+    uint64_t _align(const uint64_t bytes) const
+    {
+        return bytes - (bytes % _word_size);
+    }
+
+    //! Returns the position of the next wrap after a position
+    uint64_t _next_wrap(const uint64_t pos) const
+    {
+        return (pos / _size + 1) * _size;
+    }
+
+    //! Returns the time since the recording stalled, in seconds
+    double _get_stall_time() const
+    {
+        const std::chrono::duration<double> stall_time =
+            std::chrono::steady_clock::now() - _stall_start;
+        return stall_time.count();
+    }
+
+    //! Starts a new record window, once the block has filled the current one
+    void _move_window()
+    {
+        const uint64_t fullness = _replay->get_record_fullness(_record_port);
+        _recorded               = _window_start + fullness;
+        if (fullness < _window_size) {
+            return;
+        }
+
+        // The block is stalled. Data that was played, but not received, may
+        // not have been read from the memory yet, so it's not free yet.
+        const uint64_t start = _recorded;
+        const uint64_t end   = std::min(_next_wrap(start), _align(_read) + _size);
+        if (end - start < std::min(_min_window_size, _next_wrap(start) - start)) {
+            if (!_stalled) {
+                _stalled     = true;
+                _stall_start = std::chrono::steady_clock::now();
+                if (end == _align(_read) + _size) {
+                    _stats.num_overflows++;
+                }
+            }
+            return;
+        }
+        _replay->record(_offset + (start % _size), end - start, _record_port);
+        _window_start = start;
+        _window_size  = end - start;
+        _stats.num_window_moves++;
+        if (_stalled) {
+            _stalled = false;
+            _stats.stall_time += _get_stall_time();
+        }
+    }
+
+    //! Plays back the next recorded data, once the last playback was received
+    void _issue_play()
+    {
+        // The play registers of a command may only change once it's done, so
+        // there's only one in flight
+        if (_play_issued != _read) {
+            return;
+        }
+        const uint64_t to_wrap   = _next_wrap(_play_issued) - _play_issued;
+        const uint64_t play_size =
+            std::min({_recorded - _play_issued, _play_size, to_wrap});
+        if (play_size == 0) {
+            return;
+        }
+        _replay->play(_offset + (_play_issued % _size), play_size, _play_port);
+        _play_issued += play_size;
+    }
+
+    replay_block_control::sptr _replay;
+    const size_t _record_port;
+    const size_t _play_port;
+    const uint64_t _offset;
+    const uint64_t _size;
+    const uint64_t _word_size;
+    const uint64_t _min_window_size;
+    const uint64_t _play_size;
+    rx_streamer::sptr _rx_stream;
+
+    uint64_t _window_start = 0;
+    uint64_t _window_size  = 0;
+    uint64_t _recorded     = 0;
+    uint64_t _play_issued  = 0;
+    uint64_t _read         = 0;
+
+    bool _stalled = false;
+    std::chrono::steady_clock::time_point _stall_start;
+    stats_t _stats;
+};
+
+constexpr uint64_t replay_ring_reader_impl::MIN_WINDOWS;
+constexpr std::chrono::microseconds replay_ring_reader_impl::POLL_INTERVAL;
+
+} // namespace
+
+void replay_upload(rfnoc_graph::sptr graph,
+    replay_block_control::sptr replay,
+    const size_t port,
+    const void* buf,
+    const uint64_t size,
+    const uint64_t offset,
+    const uhd::device_addr_t& streamer_args)
+{
+    upload_chunks(graph,
+        replay,
+        port,
+        size,
+        offset,
+        streamer_args,
+        [buf](const uint64_t chunk_offset, const size_t) {
+            return static_cast<const char*>(buf) + chunk_offset;
+        });
+}
+
+uint64_t replay_upload_file(rfnoc_graph::sptr graph,
+    replay_block_control::sptr replay,
+    const size_t port,
+    const std::string& path,
+    const uint64_t offset,
+    const bool use_mmap,
+    const uhd::device_addr_t& streamer_args)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw uhd::os_error("replay_upload_file: Could not open file " + path);
+    }
+    const uint64_t file_size = static_cast<uint64_t>(file.tellg());
+    file.close();
+    const uint64_t size = file_size - (file_size % replay->get_word_size());
+    if (size == 0) {
+        throw uhd::value_error("replay_upload_file: File is smaller than a memory "
+                               "word: "
+                               + path);
+    }
+
+    if (use_mmap) {
+        namespace bip = boost::interprocess;
+        std::unique_ptr<bip::mapped_region> region;
+        try {
+            const bip::file_mapping mapping(path.c_str(), bip::read_only);
+            region.reset(new bip::mapped_region(
+                mapping, bip::read_only, 0, static_cast<size_t>(size)));
+        } catch (const bip::interprocess_exception& ex) {
+            throw uhd::os_error(
+                "replay_upload_file: Could not map file " + path + ": " + ex.what());
+        }
+        // The pages are only read once, in order
+        region->advise(bip::mapped_region::advice_sequential);
+        const char* data = static_cast<const char*>(region->get_address());
+        upload_chunks(graph,
+            replay,
+            port,
+            size,
+            offset,
+            streamer_args,
+            [data](const uint64_t chunk_offset, const size_t) {
+                return data + chunk_offset;
+            });
+    } else {
+        chunk_reader reader(path, size);
+        upload_chunks(graph,
+            replay,
+            port,
+            size,
+            offset,
+            streamer_args,
+            [&reader](const uint64_t chunk_offset, const size_t chunk_size) {
+                return reader.get_chunk(chunk_offset, chunk_size);
+            });
+    }
+    return size;
+}
+
+void replay_download(rfnoc_graph::sptr graph,
+    replay_block_control::sptr replay,
+    const size_t port,
+    void* buf,
+    const uint64_t size,
+    const uint64_t offset,
+    const uhd::device_addr_t& streamer_args)
+{
+    check_region(replay, offset, size, "replay_download");
+
+    rx_streamer::sptr rx_stream =
+        graph->create_rx_streamer(1, make_stream_args(replay, port, streamer_args));
+    graph->connect(replay->get_block_id(), port, rx_stream, 0);
+    graph->commit();
+
+    replay->config_play(offset, size, port);
+    stream_cmd_t stream_cmd(stream_cmd_t::STREAM_MODE_NUM_SAMPS_AND_DONE);
+    stream_cmd.num_samps  = static_cast<size_t>(size / ITEM_SIZE);
+    stream_cmd.stream_now = true;
+    replay->issue_stream_cmd(stream_cmd, port);
+
+    char* data = static_cast<char*>(buf);
+    rx_metadata_t md;
+    for (uint64_t bytes_recvd = 0; bytes_recvd < size;) {
+        const size_t chunk_size =
+            static_cast<size_t>(std::min<uint64_t>(CHUNK_SIZE, size - bytes_recvd));
+        const size_t nsamps = rx_stream->recv(
+            data + bytes_recvd, chunk_size / ITEM_SIZE, md, STREAM_TIMEOUT, false);
+        if (md.error_code != rx_metadata_t::ERROR_CODE_NONE) {
+            replay->stop(port);
+            throw uhd::io_error("replay_download: Error while receiving data from "
+                                + replay->get_unique_id() + ": " + md.strerror());
+        }
+        bytes_recvd += nsamps * ITEM_SIZE;
+    }
+    UHD_LOG_DEBUG(
+        LOG_ID, "Downloaded " << size << " bytes from " << replay->get_unique_id());
+}
+
+replay_ring_reader::~replay_ring_reader() = default;
+
+replay_ring_reader::sptr replay_ring_reader::make(rfnoc_graph::sptr graph,
+    replay_block_control::sptr replay,
+    const size_t record_port,
+    const size_t play_port,
+    const uint64_t offset,
+    const uint64_t size,
+    const uhd::device_addr_t& streamer_args)
+{
+    return std::make_shared<replay_ring_reader_impl>(
+        graph, replay, record_port, play_port, offset, size, streamer_args);
+}
+
+std::vector<uint8_t> replay_download(rfnoc_graph::sptr graph,
+    replay_block_control::sptr replay,
+    const size_t port,
+    const uint64_t size,
+    const uint64_t offset,
+    const uhd::device_addr_t& streamer_args)
+{
+    std::vector<uint8_t> data(static_cast<size_t>(size));
+    replay_download(graph, replay, port, data.data(), size, offset, streamer_args);
+    return data;
+}
+
+}} // namespace uhd::rfnoc
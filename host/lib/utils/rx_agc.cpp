@@ -0,0 +1,296 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/convert.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/utils/rx_agc.hpp>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+using namespace uhd;
+
+rx_agc::~rx_agc() = default;
+
+namespace {
+
+//! Don't keep more changes than this if the application never asks for them
+constexpr size_t MAX_NUM_GAIN_CHANGES = 1024;
+
+//! The power of a block of silence, in dBFS
+constexpr double MIN_POWER_DBFS = -200.0;
+
+//! Returns the sum of the power of \p nsamps samples, relative to full scale
+template <typename sample_t>
+double get_power_sum(const void* buff, const size_t nsamps, const double full_scale)
+{
+    const auto* samps = static_cast<const std::complex<sample_t>*>(buff);
+    double sum        = 0.0;
+    for (size_t i = 0; i < nsamps; i++) {
+        const double re = double(samps[i].real());
+        const double im = double(samps[i].imag());
+        sum += re * re + im * im;
+    }
+    return sum / (full_scale * full_scale);
+}
+
+using power_fn_t = std::function<double(const void*, size_t)>;
+
+power_fn_t get_power_fn(const std::string& cpu_format)
+{
+    using namespace std::placeholders;
+    if (cpu_format == "fc64") {
+        return std::bind(&get_power_sum<double>, _1, _2, 1.0);
+    }
+    if (cpu_format == "fc32") {
+        return std::bind(&get_power_sum<float>, _1, _2, 1.0);
+    }
+    if (cpu_format == "sc16") {
+        return std::bind(&get_power_sum<int16_t>, _1, _2, 32767.0);
+    }
+    if (cpu_format == "sc8") {
+        return std::bind(&get_power_sum<int8_t>, _1, _2, 127.0);
+    }
+    throw uhd::value_error("rx_agc: Unsupported CPU format: " + cpu_format);
+}
+
+class rx_agc_impl : public rx_agc
+{
+public:
+    rx_agc_impl(rx_streamer::sptr rx_stream,
+        const std::string& cpu_format,
+        const double rate,
+        const uhd::gain_range_t& gain_range,
+        const double gain,
+        gain_setter_t set_gain,
+        const uhd::device_addr_t& args)
+        : _rx_stream(rx_stream)
+        , _power_sum_fn(get_power_fn(cpu_format))
+        , _bytes_per_samp(uhd::convert::get_bytes_per_item(cpu_format))
+        , _rate(rate)
+        , _gain_range(gain_range)
+        , _set_gain(set_gain)
+        , _target(args.cast<double>("target", -20.0))
+        , _block_size(args.cast<size_t>("block_size", 1024))
+        , _attack(args.cast<double>("attack", 1.0))
+        , _decay(args.cast<double>("decay", 0.1))
+        , _hysteresis(args.cast<double>("hysteresis", 1.0))
+        , _cmd_delay(args.cast<double>("cmd_delay", 1e-3))
+        , _gain(gain)
+    {
+        if (_rx_stream->get_num_channels() != 1) {
+            throw uhd::value_error("rx_agc: The streamer must have a single channel");
+        }
+        if (_rate <= 0.0) {
+            throw uhd::value_error("rx_agc: The rate must be positive");
+        }
+        if (_gain_range.empty()) {
+            throw uhd::value_error("rx_agc: The gain range must not be empty");
+        }
+        if (_block_size == 0) {
+            throw uhd::value_error("rx_agc: block_size must not be 0");
+        }
+        if (_attack <= 0.0 || _attack > 1.0 || _decay <= 0.0 || _decay > 1.0) {
+            throw uhd::value_error("rx_agc: attack and decay must be in (0, 1]");
+        }
+        if (_hysteresis < 0.0 || _cmd_delay < 0.0) {
+            throw uhd::value_error(
+                "rx_agc: hysteresis and cmd_delay must not be negative");
+        }
+    }
+
+    size_t recv(void* buff,
+        const size_t nsamps,
+        rx_metadata_t& metadata,
+        const double timeout,
+        const bool one_packet) override
+    {
+        const size_t num_rx =
+            _rx_stream->recv(buff, nsamps, metadata, timeout, one_packet);
+        if (metadata.error_code == rx_metadata_t::ERROR_CODE_OVERFLOW) {
+            // The block would have a gap, start a new one
+            _power_sum    = 0.0;
+            _num_measured = 0;
+        }
+
+        // Measure the power of each block while the samples are still hot in
+        // the cache, and correct the gain at the end of every block
+        const char* samps = static_cast<const char*>(buff);
+        size_t offset     = 0;
+        while (offset < num_rx) {
+            offset = _skip_pending(metadata, offset, num_rx);
+            if (offset == num_rx) {
+                break;
+            }
+            const size_t chunk = std::min(num_rx - offset, _block_size - _num_measured);
+            _power_sum += _power_sum_fn(samps + offset * _bytes_per_samp, chunk);
+            _num_measured += chunk;
+            offset += chunk;
+            if (_num_measured == _block_size) {
+                _update_gain(metadata, offset);
+            }
+        }
+        return num_rx;
+    }
+
+    double get_gain() const override
+    {
+        return _gain;
+    }
+
+    double get_power() const override
+    {
+        return _power;
+    }
+
+    std::vector<gain_change_t> get_gain_changes() override
+    {
+        std::vector<gain_change_t> changes;
+        changes.swap(_changes);
+        return changes;
+    }
+
+private:
+    /*! Returns the index of the first sample from \p offset on that was
+     * received after the last gain change took effect
+     */
+    size_t _skip_pending(
+        const rx_metadata_t& metadata, const size_t offset, const size_t num_rx)
+    {
+        if (!_pending) {
+            return offset;
+        }
+        if (_pending_time && metadata.has_time_spec) {
+            const time_spec_t start =
+                metadata.time_spec + time_spec_t::from_ticks(offset, _rate);
+            const double wait_samps =
+                (_pending_change_time - start).get_real_secs() * _rate;
+            if (wait_samps <= 0.0) {
+                _pending = false;
+                return offset;
+            }
+            const size_t first = offset + size_t(std::ceil(wait_samps - 1e-6));
+            if (first >= num_rx) {
+                return num_rx;
+            }
+            _pending = false;
+            return first;
+        }
+        // Without time specs, there's no telling when an untimed change took
+        // effect. Give it a block of samples.
+        const size_t skip = std::min(num_rx - offset, _num_to_skip);
+        _num_to_skip -= skip;
+        _pending = _num_to_skip > 0;
+        return offset + skip;
+    }
+
+    //! Corrects the gain after a block that ended at sample \p offset
+    void _update_gain(const rx_metadata_t& metadata, const size_t offset)
+    {
+        const double power = _power_sum / double(_block_size);
+        _power             = (power > 0.0) ? 10.0 * std::log10(power) : MIN_POWER_DBFS;
+        _power_sum         = 0.0;
+        _num_measured      = 0;
+
+        const double error = _target - std::max(_power, MIN_POWER_DBFS);
+        if (std::abs(error) <= _hysteresis) {
+            return;
+        }
+        const double gain =
+            _gain_range.clip(_gain + error * ((error < 0.0) ? _attack : _decay), true);
+        if (gain == _gain) {
+            return;
+        }
+
+        gain_change_t change;
+        change.has_time_spec = metadata.has_time_spec;
+        if (change.has_time_spec) {
+            change.time = metadata.time_spec + time_spec_t::from_ticks(offset, _rate)
+                          + time_spec_t(_cmd_delay);
+        }
+        _gain = _set_gain(gain, change.has_time_spec ? change.time : time_spec_t(0.0));
+        change.gain = _gain;
+        if (_changes.size() >= MAX_NUM_GAIN_CHANGES) {
+            _changes.erase(_changes.begin());
+        }
+        _changes.push_back(change);
+
+        _pending      = true;
+        _pending_time = change.has_time_spec;
+        _pending_change_time = change.time;
+        _num_to_skip  = _block_size;
+    }
+
+    rx_streamer::sptr _rx_stream;
+    const power_fn_t _power_sum_fn;
+    const size_t _bytes_per_samp;
+    const double _rate;
+    const uhd::gain_range_t _gain_range;
+    const gain_setter_t _set_gain;
+    const double _target;
+    const size_t _block_size;
+    const double _attack;
+    const double _decay;
+    const double _hysteresis;
+    const double _cmd_delay;
+
+    double _gain;
+    double _power        = MIN_POWER_DBFS;
+    double _power_sum    = 0.0;
+    size_t _num_measured = 0;
+
+    //! Set until the samples after the last gain change arrive
+    bool _pending      = false;
+    bool _pending_time = false;
+    time_spec_t _pending_change_time;
+    size_t _num_to_skip = 0;
+
+    std::vector<gain_change_t> _changes;
+};
+
+} // namespace
+
+rx_agc::sptr rx_agc::make(rx_streamer::sptr rx_stream,
+    const std::string& cpu_format,
+    const double rate,
+    const uhd::gain_range_t& gain_range,
+    const double gain,
+    gain_setter_t set_gain,
+    const uhd::device_addr_t& args)
+{
+    return std::make_shared<rx_agc_impl>(
+        rx_stream, cpu_format, rate, gain_range, gain, set_gain, args);
+}
+
+rx_agc::sptr rx_agc::make(rx_streamer::sptr rx_stream,
+    const std::string& cpu_format,
+    const double rate,
+    uhd::rfnoc::radio_control::sptr radio,
+    const size_t chan,
+    const uhd::device_addr_t& args)
+{
+    auto set_gain = [radio, chan](const double gain, const time_spec_t& time) {
+        const bool timed = time != time_spec_t(0.0);
+        if (timed) {
+            radio->set_command_time(time, chan);
+        }
+        radio->set_rx_gain(gain, chan);
+        if (timed) {
+            radio->clear_command_time(chan);
+        }
+        return radio->get_rx_gain(chan);
+    };
+    return make(rx_stream,
+        cpu_format,
+        rate,
+        radio->get_rx_gain_range(chan),
+        radio->get_rx_gain(chan),
+        set_gain,
+        args);
+}
@@ -0,0 +1,170 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/rx_block_receiver.hpp>
+#include <uhd/utils/thread.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+using namespace uhd;
+
+rx_block_receiver::~rx_block_receiver() = default;
+
+namespace {
+
+//! Timeout of the receive thread, so it notices when it should stop (s)
+constexpr double RECV_TIMEOUT = 0.1;
+//! How often a receive thread without free blocks checks whether it should stop
+constexpr auto STALL_POLL_INTERVAL = std::chrono::milliseconds(100);
+
+class rx_block_receiver_impl : public rx_block_receiver
+{
+public:
+    rx_block_receiver_impl(rx_streamer::sptr rx_stream,
+        const std::vector<std::vector<void*>>& blocks,
+        const size_t samps_per_block)
+        : _rx_stream(rx_stream), _samps_per_block(samps_per_block)
+    {
+        if (blocks.empty() || samps_per_block == 0) {
+            throw uhd::value_error("The block receiver needs blocks to receive into!");
+        }
+        _blocks.resize(blocks.size());
+        for (size_t i = 0; i < blocks.size(); i++) {
+            if (blocks[i].size() != rx_stream->get_num_channels()) {
+                throw uhd::value_error(
+                    "Every block needs one buffer per channel of the streamer!");
+            }
+            _blocks[i].index = i;
+            _blocks[i].buffs = blocks[i];
+            _free.push_back(i);
+        }
+        _held.assign(blocks.size(), false);
+
+        _recv_thread = std::thread([this]() { _run(); });
+        uhd::set_thread_name(&_recv_thread, "rx_block_recv");
+    }
+
+    ~rx_block_receiver_impl()
+    {
+        _running = false;
+        _free_cond.notify_one();
+        _recv_thread.join();
+    }
+
+    bool get_block(block_t& block, const double timeout)
+    {
+        std::unique_lock<std::mutex> l(_mutex);
+        if (!_filled_cond.wait_for(l,
+                std::chrono::duration<double>(timeout),
+                [this]() { return !_filled.empty(); })) {
+            return false;
+        }
+        const size_t index = _filled.front();
+        _filled.pop_front();
+        _held[index] = true;
+        block        = _blocks[index];
+        return true;
+    }
+
+    void release_block(const size_t index)
+    {
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            if (index >= _held.size() || !_held[index]) {
+                throw uhd::value_error(
+                    "Releasing a block that the application doesn't hold!");
+            }
+            _held[index] = false;
+            _free.push_back(index);
+        }
+        _free_cond.notify_one();
+    }
+
+    uint64_t get_num_stalls() const
+    {
+        return _num_stalls;
+    }
+
+private:
+    void _run()
+    {
+        while (_running) {
+            size_t index;
+            {
+                std::unique_lock<std::mutex> l(_mutex);
+                if (_free.empty()) {
+                    _num_stalls++;
+                }
+                while (_free.empty()) {
+                    _free_cond.wait_for(l, STALL_POLL_INTERVAL);
+                    if (!_running) {
+                        return;
+                    }
+                }
+                index = _free.front();
+                _free.pop_front();
+            }
+
+            // Only this thread touches blocks that are neither free nor filled
+            block_t& block = _blocks[index];
+            while (_running) {
+                try {
+                    block.nsamps = _rx_stream->recv(
+                        block.buffs, _samps_per_block, block.metadata, RECV_TIMEOUT);
+                } catch (const uhd::exception& ex) {
+                    UHD_LOG_ERROR("RX_BLOCK", "Error while receiving: " << ex.what());
+                    continue;
+                }
+                // Hand out partial blocks, the stream may have paused
+                if (block.metadata.error_code != rx_metadata_t::ERROR_CODE_TIMEOUT
+                    || block.nsamps > 0) {
+                    break;
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> l(_mutex);
+                if (_running) {
+                    _filled.push_back(index);
+                } else {
+                    _free.push_back(index);
+                }
+            }
+            _filled_cond.notify_one();
+        }
+    }
+
+    rx_streamer::sptr _rx_stream;
+    const size_t _samps_per_block;
+    std::vector<block_t> _blocks;
+
+    std::mutex _mutex;
+    std::condition_variable _free_cond;
+    std::condition_variable _filled_cond;
+    std::deque<size_t> _free;
+    std::deque<size_t> _filled;
+    //! Which blocks the application holds
+    std::vector<bool> _held;
+
+    std::atomic<bool> _running{true};
+    std::atomic<uint64_t> _num_stalls{0};
+    std::thread _recv_thread;
+};
+
+} // namespace
+
+rx_block_receiver::sptr rx_block_receiver::make(rx_streamer::sptr rx_stream,
+    const std::vector<std::vector<void*>>& blocks,
+    const size_t samps_per_block)
+{
+    return std::make_shared<rx_block_receiver_impl>(rx_stream, blocks, samps_per_block);
+}
@@ -0,0 +1,396 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/convert.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/transport/buffer_pool.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/rx_capture_buffer.hpp>
+#include <uhd/utils/thread.hpp>
+#include <uhdlib/transport/buffer_pool_alloc.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+
+using namespace uhd;
+
+rx_capture_buffer::~rx_capture_buffer() = default;
+
+namespace {
+
+//! The streamers that can push raw packets use this suffix for their formats
+constexpr char OTW_FORMAT_SUFFIX[] = "_chdr";
+
+//! A run of contiguous samples in the ring
+struct segment_t
+{
+    //! Index of the first sample, counting all samples ever written
+    uint64_t index;
+    //! Time of the first sample, in ticks of the sample rate
+    int64_t ticks;
+};
+
+//! A window that was pinned by trigger()
+struct window_t
+{
+    time_spec_t trigger_time;
+    int64_t start_ticks;
+    int64_t end_ticks;
+    rx_capture_buffer::capture_handler_t handler;
+    // Set once the ring holds the end of the window
+    uint64_t start_index = 0;
+    uint64_t end_index   = 0;
+    //! Time of the sample at start_index
+    int64_t first_ticks = 0;
+    bool complete       = true;
+};
+
+/*! RX capture buffer
+ *
+ * The packet callback (on the I/O thread) copies the packets into the ring.
+ * The worker thread converts the windows. The mutex protects the segments
+ * and the window lists, the samples in the ring are only written by the
+ * packet callback, outside the lock.
+ */
+class rx_capture_buffer_impl : public rx_capture_buffer
+{
+public:
+    rx_capture_buffer_impl(rx_streamer::sptr rx_stream,
+        const stream_args_t& stream_args,
+        const double rate,
+        const double capacity,
+        const device_addr_t& args)
+        : _rx_stream(rx_stream)
+        , _num_chans(rx_stream->get_num_channels())
+        , _rate(rate)
+        , _capacity(size_t(std::ceil(capacity * rate)))
+    {
+        if (rate <= 0.0 || _capacity == 0) {
+            throw uhd::value_error(
+                "The sample rate and the capacity of the ring must be positive!");
+        }
+        const std::string otw_format =
+            stream_args.otw_format.empty() ? "sc16" : stream_args.otw_format;
+        _convert_id.input_format  = otw_format + OTW_FORMAT_SUFFIX;
+        _convert_id.num_inputs    = 1;
+        _convert_id.output_format = stream_args.cpu_format;
+        _convert_id.num_outputs   = 1;
+        // Throws if there is no such converter
+        uhd::convert::get_converter(_convert_id);
+        _otw_bytes_per_samp = uhd::convert::get_bytes_per_item(_convert_id.input_format);
+        _cpu_bytes_per_samp = uhd::convert::get_bytes_per_item(stream_args.cpu_format);
+        _scalar =
+            args.cast<double>("scalar", otw_format == "sc8" ? 1.0 / 127 : 1.0 / 32767);
+
+        transport::buff_alloc_params_t alloc_params;
+        alloc_params.hugepage_size =
+            transport::parse_buff_hugepages(args.get("hugepages", "none"));
+        _ring = transport::make_buffer_pool(
+            _num_chans, _capacity * _otw_bytes_per_samp, alloc_params);
+        for (size_t chan = 0; chan < _num_chans; chan++) {
+            _ring_buffs.push_back(static_cast<char*>(_ring->at(chan)));
+        }
+
+        _worker = std::thread([this]() { _work(); });
+        uhd::set_thread_name(&_worker, "rx_capture");
+        try {
+            _rx_stream->set_recv_packet_callback(
+                [this](const std::vector<const void*>& buffs,
+                    const size_t nsamps,
+                    const rx_metadata_t& md) { _push(buffs, nsamps, md); },
+                true);
+        } catch (...) {
+            _stop_worker();
+            throw;
+        }
+    }
+
+    ~rx_capture_buffer_impl()
+    {
+        _rx_stream->set_recv_packet_callback({});
+        _stop_worker();
+    }
+
+    void trigger(const time_spec_t& trigger_time,
+        const double pre_time,
+        const double post_time,
+        capture_handler_t handler)
+    {
+        if (pre_time < 0.0 || post_time < 0.0) {
+            throw uhd::value_error("The capture window times must not be negative!");
+        }
+        const int64_t trigger_ticks = trigger_time.to_ticks(_rate);
+        window_t window;
+        window.trigger_time = trigger_time;
+        window.start_ticks  = trigger_ticks - int64_t(std::llround(pre_time * _rate));
+        window.end_ticks    = trigger_ticks + int64_t(std::llround(post_time * _rate));
+        window.handler      = std::move(handler);
+        if (uint64_t(window.end_ticks - window.start_ticks) > _capacity) {
+            throw uhd::value_error("The capture window is longer than the ring!");
+        }
+
+        std::lock_guard<std::mutex> l(_mutex);
+        _pending.push_back(std::move(window));
+        _seal_windows();
+    }
+
+    double get_capacity() const
+    {
+        return _capacity / _rate;
+    }
+
+    size_t get_num_pending() const
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _pending.size() + _sealed.size() + (_converting ? 1 : 0);
+    }
+
+private:
+    //! Copy a packet into the ring, runs on the I/O thread
+    void _push(const std::vector<const void*>& buffs,
+        const size_t nsamps,
+        const rx_metadata_t& md)
+    {
+        // Errors show up as a gap in the times of the packets
+        if (nsamps == 0) {
+            return;
+        }
+        const uint64_t write_index = _write_index;
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            const int64_t ticks = md.has_time_spec ? md.time_spec.to_ticks(_rate)
+                                                   : _ticks_at(write_index);
+            if (_segments.empty() || ticks != _ticks_at(write_index)) {
+                _segments.push_back(segment_t{write_index, ticks});
+            }
+            // Anything before this is about to be overwritten
+            const uint64_t oldest = _oldest_index(write_index + nsamps);
+            while (_segments.size() > 1 && _segments[1].index <= oldest) {
+                _segments.pop_front();
+            }
+            for (auto& window : _sealed) {
+                if (window.start_index < oldest) {
+                    window.complete = false;
+                }
+            }
+            if (_converting && _converting->start_index < oldest) {
+                _converting->complete = false;
+            }
+        }
+
+        const size_t pos   = size_t(write_index % _capacity);
+        const size_t first = std::min(nsamps, _capacity - pos);
+        for (size_t chan = 0; chan < _num_chans; chan++) {
+            const char* in = static_cast<const char*>(buffs[chan]);
+            std::memcpy(_ring_buffs[chan] + pos * _otw_bytes_per_samp,
+                in,
+                first * _otw_bytes_per_samp);
+            std::memcpy(_ring_buffs[chan],
+                in + first * _otw_bytes_per_samp,
+                (nsamps - first) * _otw_bytes_per_samp);
+        }
+
+        std::lock_guard<std::mutex> l(_mutex);
+        _write_index = write_index + nsamps;
+        _seal_windows();
+    }
+
+    //! Index of the oldest sample in the ring, when it holds \p write_index samples
+    uint64_t _oldest_index(const uint64_t write_index) const
+    {
+        return write_index > _capacity ? write_index - _capacity : 0;
+    }
+
+    //! Time of a sample in the last segment. Call with the lock held.
+    int64_t _ticks_at(const uint64_t index) const
+    {
+        if (_segments.empty()) {
+            return 0;
+        }
+        return _segments.back().ticks + int64_t(index - _segments.back().index);
+    }
+
+    //! Time of a sample that is in the ring. Call with the lock held.
+    int64_t _ticks_of(const uint64_t index) const
+    {
+        for (auto it = _segments.rbegin(); it != _segments.rend(); ++it) {
+            if (it->index <= index) {
+                return it->ticks + int64_t(index - it->index);
+            }
+        }
+        return 0;
+    }
+
+    /*! Find the sample at a time. Call with the lock held.
+     *
+     * \param ticks the time in ticks
+     * \param exact returns false if there is no sample at that time (it was
+     *        dropped from the ring, or is in a gap), then the next sample is
+     *        returned
+     */
+    uint64_t _index_at(const int64_t ticks, bool& exact) const
+    {
+        exact = false;
+        for (auto it = _segments.rbegin(); it != _segments.rend(); ++it) {
+            if (it->ticks > ticks) {
+                continue;
+            }
+            const uint64_t end_index =
+                it == _segments.rbegin() ? uint64_t(_write_index) : (it - 1)->index;
+            const uint64_t index = it->index + uint64_t(ticks - it->ticks);
+            if (index > end_index) {
+                // In the gap after this segment
+                return end_index;
+            }
+            const uint64_t oldest = _oldest_index(_write_index);
+            exact                 = index >= oldest;
+            return std::max(index, oldest);
+        }
+        return _segments.empty() ? uint64_t(_write_index)
+                                 : std::max(_segments.front().index,
+                                     _oldest_index(_write_index));
+    }
+
+    //! Hand the windows that have ended to the worker. Call with the lock held.
+    void _seal_windows()
+    {
+        if (_segments.empty()) {
+            return;
+        }
+        const int64_t end_ticks = _ticks_at(_write_index);
+        bool sealed             = false;
+        for (auto it = _pending.begin(); it != _pending.end();) {
+            if (it->end_ticks > end_ticks) {
+                ++it;
+                continue;
+            }
+            bool start_exact, end_exact;
+            it->start_index = _index_at(it->start_ticks, start_exact);
+            it->end_index   = _index_at(it->end_ticks, end_exact);
+            it->first_ticks = _ticks_of(it->start_index);
+            // A gap in the window makes it shorter than requested
+            it->complete = start_exact && end_exact
+                           && it->end_index - it->start_index
+                                  == uint64_t(it->end_ticks - it->start_ticks);
+            _sealed.splice(_sealed.end(), _pending, it++);
+            sealed = true;
+        }
+        if (sealed) {
+            _cond.notify_one();
+        }
+    }
+
+    //! Convert the windows, runs on the worker thread
+    void _work()
+    {
+        std::unique_lock<std::mutex> l(_mutex);
+        while (true) {
+            _cond.wait(l, [this]() { return _stop || !_sealed.empty(); });
+            if (_stop) {
+                return;
+            }
+            std::list<window_t> current;
+            current.splice(current.end(), _sealed, _sealed.begin());
+            _converting = &current.front();
+            l.unlock();
+
+            capture_t capture;
+            capture.trigger_time = _converting->trigger_time;
+            capture.time_spec = time_spec_t::from_ticks(_converting->first_ticks, _rate);
+            _convert(*_converting, capture);
+
+            l.lock();
+            capture.complete = _converting->complete;
+            _converting      = nullptr;
+            l.unlock();
+            try {
+                current.front().handler(capture);
+            } catch (const std::exception& ex) {
+                UHD_LOG_ERROR(
+                    "RX_CAPTURE", "Exception in capture handler: " << ex.what());
+            } catch (...) {
+                UHD_LOG_ERROR("RX_CAPTURE", "Unknown exception in capture handler");
+            }
+            l.lock();
+        }
+    }
+
+    //! Convert the samples of a window into a capture
+    void _convert(const window_t& window, capture_t& capture)
+    {
+        if (!_converter) {
+            _converter = uhd::convert::get_converter(_convert_id)();
+            _converter->set_scalar(_scalar);
+        }
+        const size_t nsamps = size_t(window.end_index - window.start_index);
+        capture.nsamps      = nsamps;
+        capture.buffs.assign(_num_chans, std::vector<char>(nsamps * _cpu_bytes_per_samp));
+        const size_t pos   = size_t(window.start_index % _capacity);
+        const size_t first = std::min(nsamps, _capacity - pos);
+        for (size_t chan = 0; chan < _num_chans; chan++) {
+            char* out = capture.buffs[chan].data();
+            _converter->conv(
+                _ring_buffs[chan] + pos * _otw_bytes_per_samp, out, first);
+            _converter->conv(
+                _ring_buffs[chan], out + first * _cpu_bytes_per_samp, nsamps - first);
+        }
+    }
+
+    void _stop_worker()
+    {
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            _stop = true;
+        }
+        _cond.notify_one();
+        _worker.join();
+    }
+
+    rx_streamer::sptr _rx_stream;
+    const size_t _num_chans;
+    const double _rate;
+    //! Number of samples in the ring
+    const size_t _capacity;
+    uhd::convert::id_type _convert_id;
+    size_t _otw_bytes_per_samp;
+    size_t _cpu_bytes_per_samp;
+    double _scalar;
+    uhd::convert::converter::sptr _converter;
+
+    transport::buffer_pool::sptr _ring;
+    std::vector<char*> _ring_buffs;
+    //! Number of samples written to the ring so far
+    std::atomic<uint64_t> _write_index{0};
+
+    mutable std::mutex _mutex;
+    std::condition_variable _cond;
+    std::deque<segment_t> _segments;
+    //! Windows that haven't ended yet, and ones that wait for the worker
+    std::list<window_t> _pending;
+    std::list<window_t> _sealed;
+    //! The window the worker is converting
+    window_t* _converting = nullptr;
+    bool _stop            = false;
+    std::thread _worker;
+};
+
+} // namespace
+
+rx_capture_buffer::sptr rx_capture_buffer::make(rx_streamer::sptr rx_stream,
+    const stream_args_t& stream_args,
+    const double rate,
+    const double capacity,
+    const device_addr_t& args)
+{
+    return std::make_shared<rx_capture_buffer_impl>(
+        rx_stream, stream_args, rate, capacity, args);
+}
@@ -0,0 +1,636 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/math.hpp>
+#include <uhd/utils/rx_channelizer.hpp>
+#include <uhd/utils/thread.hpp>
+#include <uhdlib/utils/fft.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace uhd;
+
+rx_channelizer::~rx_channelizer() = default;
+
+namespace {
+
+//! Timeout of the receive thread, so it notices when it should stop (s)
+constexpr double RECV_TIMEOUT = 0.1;
+
+constexpr size_t DEFAULT_NUM_CHANS     = 16;
+constexpr size_t DEFAULT_TAPS_PER_CHAN = 12;
+constexpr size_t DEFAULT_QUEUE_SIZE    = 64;
+
+using sample_t = std::complex<float>;
+
+/*! Design the prototype filter: A windowed sinc, whose response is 6 dB down
+ * at the edges of a channel
+ *
+ * The Blackman-Harris window keeps the sidelobes below -90 dB. The taps add up
+ * to one, so a tone in the middle of a channel keeps its amplitude.
+ */
+std::vector<float> design_prototype(const size_t num_chans, const size_t num_taps)
+{
+    std::vector<double> taps(num_taps);
+    const double center = double(num_taps - 1) / 2;
+    double sum          = 0;
+    for (size_t i = 0; i < num_taps; i++) {
+        const double x   = (double(i) - center) / double(num_chans);
+        const double arg = 2 * uhd::math::PI * double(i) / double(num_taps - 1);
+        const double window = 0.35875 - 0.48829 * std::cos(arg)
+                              + 0.14128 * std::cos(2 * arg) - 0.01168 * std::cos(3 * arg);
+        const double sinc =
+            (x == 0) ? 1.0 : std::sin(uhd::math::PI * x) / (uhd::math::PI * x);
+        taps[i] = sinc * window;
+        sum += taps[i];
+    }
+    std::vector<float> result(num_taps);
+    std::transform(taps.begin(), taps.end(), result.begin(), [sum](const double tap) {
+        return float(tap / sum);
+    });
+    return result;
+}
+
+//! The samples of one channel from one input packet, or an error without samples
+struct block_t
+{
+    std::vector<sample_t> samps;
+    size_t nsamps = 0;
+    rx_metadata_t metadata;
+};
+
+using block_sptr = std::shared_ptr<block_t>;
+
+//! The queue of a channel, shared by the channelizer and the channel streamer
+class channel_queue
+{
+public:
+    channel_queue(const size_t size) : _size(size) {}
+
+    //! Get a block for \p nsamps samples, recycled if possible
+    block_sptr get_block(const size_t nsamps)
+    {
+        block_sptr block;
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            if (!_free.empty()) {
+                block = std::move(_free.back());
+                _free.pop_back();
+            }
+        }
+        if (!block) {
+            block = std::make_shared<block_t>();
+        }
+        if (block->samps.size() < nsamps) {
+            block->samps.resize(nsamps);
+        }
+        block->nsamps   = nsamps;
+        block->metadata = rx_metadata_t();
+        return block;
+    }
+
+    //! Queue a block, and drop the oldest one if the queue is full
+    void push(block_sptr block)
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        if (_blocks.size() >= _size) {
+            _free.push_back(std::move(_blocks.front()));
+            _blocks.pop_front();
+            _overflow = true;
+        }
+        _blocks.push_back(std::move(block));
+        _not_empty.notify_one();
+    }
+
+    /*! Get the next block
+     *
+     * When blocks were dropped, this returns an overflow first, with the time
+     * of the block that follows the gap.
+     *
+     * \return the block, or nullptr on a timeout
+     */
+    block_sptr pop(const double timeout)
+    {
+        std::unique_lock<std::mutex> l(_mutex);
+        if (!_not_empty.wait_for(l, std::chrono::duration<double>(timeout), [this]() {
+                return !_blocks.empty();
+            })) {
+            return nullptr;
+        }
+        if (_overflow) {
+            _overflow     = false;
+            auto overflow = std::make_shared<block_t>();
+            overflow->metadata.error_code    = rx_metadata_t::ERROR_CODE_OVERFLOW;
+            overflow->metadata.has_time_spec = _blocks.front()->metadata.has_time_spec;
+            overflow->metadata.time_spec     = _blocks.front()->metadata.time_spec;
+            return overflow;
+        }
+        block_sptr block = std::move(_blocks.front());
+        _blocks.pop_front();
+        return block;
+    }
+
+    //! Return a block that was read, so its memory can be reused
+    void recycle(block_sptr block)
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        if (_free.size() < _size) {
+            _free.push_back(std::move(block));
+        }
+    }
+
+private:
+    const size_t _size;
+    std::mutex _mutex;
+    std::condition_variable _not_empty;
+    std::deque<block_sptr> _blocks;
+    std::vector<block_sptr> _free;
+    bool _overflow = false;
+};
+
+//! The streamer of one channel
+class channel_streamer : public rx_streamer
+{
+public:
+    channel_streamer(std::shared_ptr<channel_queue> queue,
+        rx_streamer::sptr input,
+        const size_t decim,
+        const size_t max_num_samps,
+        const double rate)
+        : _queue(queue)
+        , _input(input)
+        , _decim(decim)
+        , _max_num_samps(max_num_samps)
+        , _rate(rate)
+    {
+    }
+
+    size_t get_num_channels() const override
+    {
+        return 1;
+    }
+
+    size_t get_max_num_samps() const override
+    {
+        return _max_num_samps;
+    }
+
+    size_t recv(const buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        rx_metadata_t& metadata,
+        const double timeout,
+        const bool one_packet) override
+    {
+        if (buffs.size() != 1) {
+            throw uhd::value_error("rx_channelizer: A channel takes one buffer");
+        }
+        sample_t* out       = static_cast<sample_t*>(buffs[0]);
+        const auto deadline = std::chrono::steady_clock::now()
+                              + std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::duration<double>(timeout));
+        metadata     = rx_metadata_t();
+        size_t total = 0;
+        while (total < nsamps_per_buff) {
+            if (!_block) {
+                const std::chrono::duration<double> left =
+                    deadline - std::chrono::steady_clock::now();
+                _block  = _queue->pop(std::max(0.0, left.count()));
+                _offset = 0;
+                if (!_block) {
+                    if (total == 0) {
+                        metadata.error_code = rx_metadata_t::ERROR_CODE_TIMEOUT;
+                    }
+                    break;
+                }
+            }
+            // Errors are returned on their own
+            if (_block->metadata.error_code != rx_metadata_t::ERROR_CODE_NONE) {
+                if (total == 0) {
+                    metadata = _block->metadata;
+                    _release();
+                }
+                break;
+            }
+
+            const size_t nsamps =
+                std::min(nsamps_per_buff - total, _block->nsamps - _offset);
+            std::copy_n(_block->samps.data() + _offset, nsamps, out + total);
+            if (total == 0) {
+                metadata = _block->metadata;
+                metadata.time_spec += time_spec_t(double(_offset) / _rate);
+                metadata.start_of_burst =
+                    _block->metadata.start_of_burst && _offset == 0;
+                metadata.fragment_offset = _offset;
+            }
+            total += nsamps;
+            _offset += nsamps;
+            const bool done         = _offset == _block->nsamps;
+            metadata.more_fragments = !done;
+            metadata.end_of_burst   = done && _block->metadata.end_of_burst;
+            if (done) {
+                _release();
+            }
+            if (one_packet || metadata.end_of_burst || !done) {
+                break;
+            }
+        }
+        return total;
+    }
+
+    void issue_stream_cmd(const stream_cmd_t& stream_cmd) override
+    {
+        stream_cmd_t input_cmd = stream_cmd;
+        input_cmd.num_samps *= _decim;
+        _input->issue_stream_cmd(input_cmd);
+    }
+
+private:
+    void _release()
+    {
+        _queue->recycle(std::move(_block));
+        _block.reset();
+    }
+
+    std::shared_ptr<channel_queue> _queue;
+    rx_streamer::sptr _input;
+    const size_t _decim;
+    const size_t _max_num_samps;
+    const double _rate;
+
+    //! The block that recv() is reading, and how much of it was read
+    block_sptr _block;
+    size_t _offset = 0;
+};
+
+//! Runs a job on several threads at once, one of them the calling thread
+class worker_pool
+{
+public:
+    worker_pool(const size_t num_threads)
+    {
+        for (size_t i = 1; i < num_threads; i++) {
+            _threads.emplace_back([this, i]() { _work(i); });
+            uhd::set_thread_name(&_threads.back(), "rx_chan" + std::to_string(i));
+        }
+    }
+
+    ~worker_pool()
+    {
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            _stop = true;
+        }
+        _start.notify_all();
+        for (auto& thread : _threads) {
+            thread.join();
+        }
+    }
+
+    //! Call job(i) for every thread i, and wait until all calls returned
+    void run(const std::function<void(size_t)>& job)
+    {
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            _job         = &job;
+            _num_running = _threads.size();
+            _generation++;
+        }
+        _start.notify_all();
+        job(0);
+        std::unique_lock<std::mutex> l(_mutex);
+        _done.wait(l, [this]() { return _num_running == 0; });
+    }
+
+private:
+    void _work(const size_t index)
+    {
+        uint64_t generation = 0;
+        std::unique_lock<std::mutex> l(_mutex);
+        while (true) {
+            _start.wait(l, [&]() { return _stop || _generation != generation; });
+            if (_stop) {
+                return;
+            }
+            generation = _generation;
+            l.unlock();
+            (*_job)(index);
+            l.lock();
+            if (--_num_running == 0) {
+                _done.notify_one();
+            }
+        }
+    }
+
+    std::mutex _mutex;
+    std::condition_variable _start;
+    std::condition_variable _done;
+    const std::function<void(size_t)>* _job = nullptr;
+    uint64_t _generation                    = 0;
+    size_t _num_running                     = 0;
+    bool _stop                              = false;
+    std::vector<std::thread> _threads;
+};
+
+class rx_channelizer_impl : public rx_channelizer
+{
+public:
+    rx_channelizer_impl(rx_streamer::sptr rx_stream,
+        const double rate,
+        const size_t num_chans,
+        const size_t decim,
+        const size_t taps_per_chan,
+        const size_t num_threads,
+        const size_t queue_size)
+        : _rx_stream(rx_stream)
+        , _rate(rate)
+        , _num_chans(num_chans)
+        , _decim(decim)
+        , _taps_per_chan(taps_per_chan)
+        , _num_taps(num_chans * taps_per_chan)
+        , _batch_size(rx_stream->get_max_num_samps())
+        , _ifft(num_chans, true)
+        , _input(_num_taps - 1 + _batch_size)
+        , _scratch(num_threads, std::vector<sample_t>(2 * num_chans))
+        , _pool(num_threads)
+    {
+        // The taps are stored in reverse, to line up with the input samples,
+        // and twice each, to multiply the real and imaginary parts in one loop
+        const std::vector<float> prototype = design_prototype(num_chans, _num_taps);
+        _taps.resize(2 * _num_taps);
+        for (size_t i = 0; i < _num_taps; i++) {
+            _taps[2 * i]     = prototype[_num_taps - 1 - i];
+            _taps[2 * i + 1] = prototype[_num_taps - 1 - i];
+        }
+        _reset();
+
+        const size_t max_num_samps = (_batch_size + decim - 1) / decim;
+        for (size_t chan = 0; chan < num_chans; chan++) {
+            _queues.push_back(std::make_shared<channel_queue>(queue_size));
+            _channels.push_back(std::make_shared<channel_streamer>(
+                _queues.back(), rx_stream, decim, max_num_samps, get_channel_rate()));
+        }
+        _recv_thread = std::thread([this]() { _run(); });
+        uhd::set_thread_name(&_recv_thread, "rx_chan");
+    }
+
+    ~rx_channelizer_impl() override
+    {
+        _running = false;
+        _recv_thread.join();
+    }
+
+    size_t get_num_channels() const override
+    {
+        return _num_chans;
+    }
+
+    rx_streamer::sptr get_channel(const size_t chan) const override
+    {
+        _check_chan(chan);
+        return _channels[chan];
+    }
+
+    double get_channel_rate() const override
+    {
+        return _rate / double(_decim);
+    }
+
+    double get_channel_freq(const size_t chan) const override
+    {
+        _check_chan(chan);
+        const double spacing = _rate / double(_num_chans);
+        return (chan < _num_chans / 2) ? double(chan) * spacing
+                                       : (double(chan) - double(_num_chans)) * spacing;
+    }
+
+private:
+    void _check_chan(const size_t chan) const
+    {
+        if (chan >= _num_chans) {
+            throw uhd::index_error(
+                "rx_channelizer: Invalid channel " + std::to_string(chan));
+        }
+    }
+
+    //! Start over with an empty filter, after a gap in the input
+    void _reset()
+    {
+        std::fill(_input.begin(), _input.begin() + (_num_taps - 1), sample_t());
+        _input_len = _num_taps - 1;
+        _base      = -int64_t(_num_taps - 1);
+        _next_out  = 0;
+        _has_time  = false;
+    }
+
+    void _run()
+    {
+        rx_metadata_t md;
+        while (_running) {
+            size_t nsamps = 0;
+            try {
+                nsamps = _rx_stream->recv(
+                    _input.data() + _input_len, _batch_size, md, RECV_TIMEOUT, true);
+            } catch (const uhd::exception& ex) {
+                UHD_LOG_ERROR("RX_CHANNELIZER", "Failed to receive: " << ex.what());
+                continue;
+            }
+            if (md.error_code == rx_metadata_t::ERROR_CODE_TIMEOUT) {
+                continue;
+            }
+            if (md.error_code != rx_metadata_t::ERROR_CODE_NONE) {
+                for (auto& queue : _queues) {
+                    auto block      = queue->get_block(0);
+                    block->metadata = md;
+                    queue->push(std::move(block));
+                }
+                // Samples were lost, the filter can't carry on across the gap
+                if (md.error_code == rx_metadata_t::ERROR_CODE_OVERFLOW) {
+                    _reset();
+                    continue;
+                }
+            }
+            if (nsamps == 0) {
+                continue;
+            }
+
+            if (md.has_time_spec) {
+                _has_time     = true;
+                _anchor_time  = md.time_spec;
+                _anchor_index = _base + int64_t(_input_len);
+            }
+            _input_len += nsamps;
+            _process(md);
+            if (md.end_of_burst) {
+                _reset();
+            }
+        }
+    }
+
+    //! Compute the channel samples for all complete windows of the input
+    void _process(const rx_metadata_t& md)
+    {
+        const int64_t last = _base + int64_t(_input_len) - 1;
+        if (last >= _next_out) {
+            const size_t count = size_t((last - _next_out) / int64_t(_decim)) + 1;
+            rx_metadata_t block_md;
+            block_md.has_time_spec  = _has_time;
+            block_md.start_of_burst = md.start_of_burst;
+            block_md.end_of_burst   = md.end_of_burst;
+            if (_has_time) {
+                // The output goes with the newest sample of its window, delayed
+                // by half the length of the filter
+                const double delay = double(_num_taps - 1) / 2;
+                block_md.time_spec =
+                    _anchor_time
+                    + time_spec_t((double(_next_out - _anchor_index) - delay) / _rate);
+            }
+            _blocks.clear();
+            _outs.clear();
+            for (auto& queue : _queues) {
+                _blocks.push_back(queue->get_block(count));
+                _blocks.back()->metadata = block_md;
+                _outs.push_back(_blocks.back()->samps.data());
+            }
+
+            const size_t num_threads = _scratch.size();
+            _pool.run([&](const size_t thread) {
+                const size_t first = count * thread / num_threads;
+                const size_t end   = count * (thread + 1) / num_threads;
+                for (size_t i = first; i < end; i++) {
+                    _compute(_next_out + int64_t(i * _decim), i, _scratch[thread]);
+                }
+            });
+
+            for (size_t chan = 0; chan < _num_chans; chan++) {
+                _queues[chan]->push(std::move(_blocks[chan]));
+            }
+            _next_out += int64_t(count * _decim);
+        }
+
+        // Keep the samples that the next window needs
+        const size_t keep_from = size_t(_next_out - int64_t(_num_taps - 1) - _base);
+        std::memmove(_input.data(),
+            _input.data() + keep_from,
+            (_input_len - keep_from) * sizeof(sample_t));
+        _input_len -= keep_from;
+        _base += int64_t(keep_from);
+    }
+
+    /*! Compute the samples of all channels for the window that ends with the
+     * input sample \p newest, and store them at \p index of the blocks
+     *
+     * Filtering channel k and mixing it to baseband with exp(-j2pi k n / N) is
+     * an inverse DFT over the filtered input, folded into N branches and
+     * rotated by the index of the newest sample.
+     */
+    void _compute(
+        const int64_t newest, const size_t index, std::vector<sample_t>& scratch)
+    {
+        const size_t num_floats = 2 * _num_chans;
+        const float* window = reinterpret_cast<const float*>(
+            _input.data() + (newest - _base) - int64_t(_num_taps - 1));
+        float* acc = reinterpret_cast<float*>(scratch.data());
+        std::fill(acc, acc + num_floats, 0.0f);
+        for (size_t branch = 0; branch < _taps_per_chan; branch++) {
+            const float* taps = _taps.data() + branch * num_floats;
+            const float* in   = window + branch * num_floats;
+            for (size_t i = 0; i < num_floats; i++) {
+                acc[i] += taps[i] * in[i];
+            }
+        }
+
+        // The sum of branch r of the filter is at position N - 1 - r
+        sample_t* branches = scratch.data();
+        sample_t* rotated  = scratch.data() + _num_chans;
+        const size_t mask  = _num_chans - 1;
+        const size_t shift = size_t(newest) & mask;
+        for (size_t r = 0; r < _num_chans; r++) {
+            rotated[r] = branches[mask - ((r + shift) & mask)];
+        }
+        _ifft.execute(rotated);
+        for (size_t chan = 0; chan < _num_chans; chan++) {
+            _outs[chan][index] = rotated[chan];
+        }
+    }
+
+    rx_streamer::sptr _rx_stream;
+    const double _rate;
+    const size_t _num_chans;
+    const size_t _decim;
+    const size_t _taps_per_chan;
+    const size_t _num_taps;
+    const size_t _batch_size;
+    const fft_plan _ifft;
+    std::vector<float> _taps;
+
+    //! The input samples, starting with the history of the filter
+    std::vector<sample_t> _input;
+    size_t _input_len = 0;
+    //! The index of the first sample in _input, counted from the last reset
+    int64_t _base = 0;
+    //! The index of the newest sample of the next output window
+    int64_t _next_out = 0;
+    //! The time of the input sample with the index _anchor_index
+    bool _has_time = false;
+    time_spec_t _anchor_time;
+    int64_t _anchor_index = 0;
+
+    //! Per thread: the filter branches, and the rotated branches for the DFT
+    std::vector<std::vector<sample_t>> _scratch;
+    std::vector<block_sptr> _blocks;
+    std::vector<sample_t*> _outs;
+    worker_pool _pool;
+
+    std::vector<std::shared_ptr<channel_queue>> _queues;
+    std::vector<rx_streamer::sptr> _channels;
+
+    std::atomic<bool> _running{true};
+    std::thread _recv_thread;
+};
+
+} // namespace
+
+rx_channelizer::sptr rx_channelizer::make(
+    rx_streamer::sptr rx_stream, const double rate, const device_addr_t& args)
+{
+    if (rx_stream->get_num_channels() != 1) {
+        throw uhd::value_error("rx_channelizer: The streamer must have one channel");
+    }
+    if (rate <= 0) {
+        throw uhd::value_error("rx_channelizer: The sample rate must be positive");
+    }
+    const size_t num_chans = args.cast<size_t>("num_chans", DEFAULT_NUM_CHANS);
+    if (num_chans < 2 || (num_chans & (num_chans - 1)) != 0) {
+        throw uhd::value_error(
+            "rx_channelizer: num_chans must be a power of two, and at least 2");
+    }
+    const size_t decim = args.cast<size_t>("decim", num_chans);
+    if (decim == 0 || num_chans % decim != 0) {
+        throw uhd::value_error("rx_channelizer: decim must divide num_chans");
+    }
+    const size_t taps_per_chan =
+        args.cast<size_t>("taps_per_chan", DEFAULT_TAPS_PER_CHAN);
+    const size_t num_threads = args.cast<size_t>("num_threads", 1);
+    const size_t queue_size  = args.cast<size_t>("queue_size", DEFAULT_QUEUE_SIZE);
+    if (taps_per_chan == 0 || num_threads == 0 || queue_size == 0) {
+        throw uhd::value_error("rx_channelizer: taps_per_chan, num_threads and "
+                               "queue_size must be at least 1");
+    }
+    return std::make_shared<rx_channelizer_impl>(
+        rx_stream, rate, num_chans, decim, taps_per_chan, num_threads, queue_size);
+}
@@ -0,0 +1,299 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/convert.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/rx_fanout.hpp>
+#include <uhd/utils/thread.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+
+using namespace uhd;
+
+rx_fanout::~rx_fanout()             = default;
+rx_fanout::subscriber::~subscriber() = default;
+
+namespace {
+
+//! Timeout of the receive thread, so it notices when it should stop (s)
+constexpr double RECV_TIMEOUT = 0.1;
+//! How often a backpressured receive thread checks whether it should stop
+constexpr auto BACKPRESSURE_POLL_INTERVAL = std::chrono::milliseconds(100);
+
+//! A packet along with the memory of its buffers
+struct block_t : rx_fanout::packet_t
+{
+    std::vector<std::vector<char>> storage;
+    //! The same as buffs, for recv()
+    std::vector<void*> out_buffs;
+};
+
+/*! Recycles the memory of packets that no subscriber holds any more
+ *
+ * Subscribers can drop their packets after the fan-out is gone, so the pool
+ * owns itself through the deleters of the packets.
+ */
+class block_pool : public std::enable_shared_from_this<block_pool>
+{
+public:
+    block_pool(const size_t num_chans, const size_t buff_size)
+        : _num_chans(num_chans), _buff_size(buff_size)
+    {
+    }
+
+    //! Get a block, its buffers point to its storage
+    std::shared_ptr<block_t> get()
+    {
+        block_t* block = nullptr;
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            if (!_free.empty()) {
+                block = _free.back().release();
+                _free.pop_back();
+            }
+        }
+        if (!block) {
+            block = new block_t;
+            block->storage.assign(_num_chans, std::vector<char>(_buff_size));
+            for (auto& buff : block->storage) {
+                block->buffs.push_back(buff.data());
+                block->out_buffs.push_back(buff.data());
+            }
+        }
+        std::weak_ptr<block_pool> weak_pool = shared_from_this();
+        return std::shared_ptr<block_t>(block, [weak_pool](block_t* block) {
+            if (auto pool = weak_pool.lock()) {
+                pool->_put(block);
+            } else {
+                delete block;
+            }
+        });
+    }
+
+private:
+    void _put(block_t* block)
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _free.emplace_back(block);
+    }
+
+    const size_t _num_chans;
+    const size_t _buff_size;
+    std::mutex _mutex;
+    std::vector<std::unique_ptr<block_t>> _free;
+};
+
+//! The queue of a subscriber, shared by the fan-out and the subscriber
+class subscriber_queue
+{
+public:
+    subscriber_queue(const size_t size, const rx_fanout::overflow_policy_t policy)
+        : _size(size), _policy(policy)
+    {
+    }
+
+    /*! Queue a packet, called by the receive thread
+     *
+     * \return false if the subscriber is gone, or \p running went false while
+     *         waiting for room
+     */
+    bool push(rx_fanout::packet_sptr packet, const std::atomic<bool>& running)
+    {
+        std::unique_lock<std::mutex> l(_mutex);
+        if (_policy == rx_fanout::overflow_policy_t::BACKPRESSURE) {
+            while (!_closed && _packets.size() >= _size) {
+                if (!running) {
+                    return false;
+                }
+                _not_full.wait_for(l, BACKPRESSURE_POLL_INTERVAL);
+            }
+        } else if (_packets.size() >= _size) {
+            _packets.pop_front();
+            _num_dropped++;
+        }
+        if (_closed) {
+            return false;
+        }
+        _packets.push_back(std::move(packet));
+        _not_empty.notify_one();
+        return true;
+    }
+
+    rx_fanout::packet_sptr pop(const double timeout)
+    {
+        std::unique_lock<std::mutex> l(_mutex);
+        if (!_not_empty.wait_for(l, std::chrono::duration<double>(timeout), [this]() {
+                return !_packets.empty();
+            })) {
+            return nullptr;
+        }
+        rx_fanout::packet_sptr packet = std::move(_packets.front());
+        _packets.pop_front();
+        _not_full.notify_one();
+        return packet;
+    }
+
+    //! The subscriber is gone, drop its packets and stop waiting for it
+    void close()
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _closed = true;
+        _packets.clear();
+        _not_full.notify_one();
+    }
+
+    bool is_closed() const
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _closed;
+    }
+
+    size_t get_num_queued() const
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _packets.size();
+    }
+
+    uint64_t get_num_dropped() const
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _num_dropped;
+    }
+
+private:
+    const size_t _size;
+    const rx_fanout::overflow_policy_t _policy;
+    mutable std::mutex _mutex;
+    std::condition_variable _not_empty;
+    std::condition_variable _not_full;
+    std::deque<rx_fanout::packet_sptr> _packets;
+    uint64_t _num_dropped = 0;
+    bool _closed          = false;
+};
+
+class subscriber_impl : public rx_fanout::subscriber
+{
+public:
+    subscriber_impl(std::shared_ptr<subscriber_queue> queue) : _queue(queue) {}
+
+    ~subscriber_impl()
+    {
+        _queue->close();
+    }
+
+    rx_fanout::packet_sptr pop(const double timeout)
+    {
+        return _queue->pop(timeout);
+    }
+
+    size_t get_num_queued() const
+    {
+        return _queue->get_num_queued();
+    }
+
+    uint64_t get_num_dropped() const
+    {
+        return _queue->get_num_dropped();
+    }
+
+private:
+    std::shared_ptr<subscriber_queue> _queue;
+};
+
+class rx_fanout_impl : public rx_fanout
+{
+public:
+    rx_fanout_impl(rx_streamer::sptr rx_stream, const std::string& cpu_format)
+        : _rx_stream(rx_stream)
+        , _max_num_samps(rx_stream->get_max_num_samps())
+        , _pool(std::make_shared<block_pool>(rx_stream->get_num_channels(),
+              _max_num_samps * convert::get_bytes_per_item(cpu_format)))
+    {
+        _recv_thread = std::thread([this]() { _run(); });
+        uhd::set_thread_name(&_recv_thread, "rx_fanout");
+    }
+
+    ~rx_fanout_impl()
+    {
+        _running = false;
+        _recv_thread.join();
+    }
+
+    subscriber::sptr subscribe(const size_t queue_size, const overflow_policy_t policy)
+    {
+        if (queue_size == 0) {
+            throw uhd::value_error("rx_fanout: The queue size must be at least 1");
+        }
+        auto queue = std::make_shared<subscriber_queue>(queue_size, policy);
+        std::lock_guard<std::mutex> l(_mutex);
+        _queues.push_back(queue);
+        return std::make_shared<subscriber_impl>(queue);
+    }
+
+    size_t get_num_subscribers() const
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        return std::count_if(_queues.begin(), _queues.end(), [](const auto& queue) {
+            return !queue->is_closed();
+        });
+    }
+
+private:
+    void _run()
+    {
+        std::vector<std::shared_ptr<subscriber_queue>> queues;
+        while (_running) {
+            std::shared_ptr<block_t> block = _pool->get();
+            try {
+                block->nsamps = _rx_stream->recv(
+                    block->out_buffs, _max_num_samps, block->metadata, RECV_TIMEOUT, true);
+            } catch (const uhd::exception& ex) {
+                UHD_LOG_ERROR("RX_FANOUT", "Failed to receive: " << ex.what());
+                continue;
+            }
+            if (block->metadata.error_code == rx_metadata_t::ERROR_CODE_TIMEOUT) {
+                continue;
+            }
+
+            // Don't hold the lock while pushing, a backpressured subscriber
+            // can take a while
+            {
+                std::lock_guard<std::mutex> l(_mutex);
+                _queues.remove_if([](const auto& queue) { return queue->is_closed(); });
+                queues.assign(_queues.begin(), _queues.end());
+            }
+            const packet_sptr packet = std::move(block);
+            for (auto& queue : queues) {
+                queue->push(packet, _running);
+            }
+            queues.clear();
+        }
+    }
+
+    rx_streamer::sptr _rx_stream;
+    const size_t _max_num_samps;
+    std::shared_ptr<block_pool> _pool;
+
+    mutable std::mutex _mutex;
+    std::list<std::shared_ptr<subscriber_queue>> _queues;
+
+    std::atomic<bool> _running{true};
+    std::thread _recv_thread;
+};
+
+} // namespace
+
+rx_fanout::sptr rx_fanout::make(rx_streamer::sptr rx_stream, const std::string& cpu_format)
+{
+    return std::make_shared<rx_fanout_impl>(rx_stream, cpu_format);
+}
@@ -0,0 +1,207 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/convert.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/utils/rx_frame_streamer.hpp>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using namespace uhd;
+
+rx_frame_streamer::~rx_frame_streamer() = default;
+
+namespace {
+
+using steady_clock = std::chrono::steady_clock;
+
+class rx_frame_streamer_impl : public rx_frame_streamer
+{
+public:
+    rx_frame_streamer_impl(rx_streamer::sptr rx_stream,
+        const std::string& cpu_format,
+        const size_t frame_size,
+        const uhd::device_addr_t& args)
+        : _rx_stream(rx_stream)
+        , _item_size(uhd::convert::get_bytes_per_item(cpu_format))
+        , _frame_size(frame_size)
+        , _eob(args.cast<bool>("eob", false))
+        , _decim(args.cast<size_t>("decim", 1))
+        , _scratch(frame_size * _item_size)
+    {
+        if (_rx_stream->get_num_channels() != 1) {
+            throw uhd::value_error("rx_frame_streamer: The streamer must have a "
+                                   "single channel");
+        }
+        if (_frame_size == 0) {
+            throw uhd::value_error("rx_frame_streamer: The frame size must not be 0");
+        }
+        if (_decim == 0) {
+            throw uhd::value_error("rx_frame_streamer: decim must not be 0");
+        }
+        const double max_frame_rate = args.cast<double>("max_frame_rate", 0.0);
+        if (max_frame_rate < 0.0) {
+            throw uhd::value_error("rx_frame_streamer: max_frame_rate must not be "
+                                   "negative");
+        }
+        if (max_frame_rate > 0.0) {
+            _frame_period = std::chrono::duration_cast<steady_clock::duration>(
+                std::chrono::duration<double>(1.0 / max_frame_rate));
+        }
+    }
+
+    size_t get_frame_size() const override
+    {
+        return _frame_size;
+    }
+
+    size_t recv_frame(void* buff, rx_metadata_t& metadata, const double timeout) override
+    {
+        const auto deadline = steady_clock::now()
+                              + std::chrono::duration_cast<steady_clock::duration>(
+                                  std::chrono::duration<double>(timeout));
+        while (true) {
+            // Decide up front, so a skipped frame doesn't touch the buffer
+            const auto now     = steady_clock::now();
+            const bool deliver = (_num_frames % _decim == 0)
+                                 && (_frame_period == steady_clock::duration::zero()
+                                     || now >= _next_frame_time);
+            if (!_recv(deliver ? buff : _scratch.data(), metadata, deadline)) {
+                return 0;
+            }
+            _num_frames++;
+            if (deliver) {
+                if (_frame_period != steady_clock::duration::zero()) {
+                    // Keep the average rate, but don't catch up after a pause
+                    _next_frame_time += _frame_period;
+                    if (_next_frame_time < now) {
+                        _next_frame_time = now + _frame_period;
+                    }
+                }
+                return _frame_size;
+            }
+            _num_skipped++;
+        }
+    }
+
+    uint64_t get_num_frames_skipped() const override
+    {
+        return _num_skipped;
+    }
+
+    uint64_t get_num_frames_discarded() const override
+    {
+        return _num_discarded;
+    }
+
+private:
+    /*! Receives one complete frame into \p buff
+     *
+     * Returns false on errors other than overruns, or when the deadline
+     * passes. Incomplete frames are discarded.
+     */
+    bool _recv(
+        void* buff, rx_metadata_t& metadata, const steady_clock::time_point& deadline)
+    {
+        char* frame   = static_cast<char*>(buff);
+        size_t filled = 0;
+        rx_metadata_t packet_md;
+        while (true) {
+            const double timeout = std::max(0.0,
+                std::chrono::duration<double>(deadline - steady_clock::now()).count());
+            // While resynchronizing, the data is only received to find the
+            // end of the current frame
+            const size_t nsamps = _resync
+                                      ? _rx_stream->recv(_scratch.data(),
+                                          _frame_size,
+                                          packet_md,
+                                          timeout,
+                                          true)
+                                      : _rx_stream->recv(frame + filled * _item_size,
+                                          _frame_size - filled,
+                                          packet_md,
+                                          timeout,
+                                          true);
+
+            if (packet_md.error_code == rx_metadata_t::ERROR_CODE_OVERFLOW) {
+                _discard(filled);
+                // Packets carry whole frames unless frames end at EOB, so
+                // only then can streaming go on in the middle of a frame
+                _resync = _eob;
+                continue;
+            }
+            if (packet_md.error_code != rx_metadata_t::ERROR_CODE_NONE) {
+                metadata = packet_md;
+                if (filled > 0) {
+                    _discard(filled);
+                    _resync = true;
+                }
+                return false;
+            }
+
+            const bool frame_end =
+                !packet_md.more_fragments && (!_eob || packet_md.end_of_burst);
+            if (_resync) {
+                _resync = !frame_end;
+                continue;
+            }
+            if (filled == 0) {
+                metadata = packet_md;
+            }
+            filled += nsamps;
+            if (frame_end) {
+                if (filled == _frame_size) {
+                    metadata.end_of_burst = packet_md.end_of_burst;
+                    return true;
+                }
+                // Too short, or the frame started before this streamer did
+                _discard(filled);
+            } else if (filled == _frame_size) {
+                // The frame is too long
+                _discard(filled);
+                _resync = true;
+            }
+        }
+    }
+
+    //! Drops a partial frame
+    void _discard(size_t& filled)
+    {
+        if (filled > 0) {
+            _num_discarded++;
+        }
+        filled = 0;
+    }
+
+    rx_streamer::sptr _rx_stream;
+    const size_t _item_size;
+    const size_t _frame_size;
+    const bool _eob;
+    const size_t _decim;
+    steady_clock::duration _frame_period = steady_clock::duration::zero();
+
+    //! Receives frames that are skipped or discarded
+    std::vector<char> _scratch;
+    //! Set while the data up to the end of the current frame is dropped
+    bool _resync = false;
+
+    steady_clock::time_point _next_frame_time = {};
+    uint64_t _num_frames    = 0;
+    uint64_t _num_skipped   = 0;
+    uint64_t _num_discarded = 0;
+};
+
+} // namespace
+
+rx_frame_streamer::sptr rx_frame_streamer::make(rx_streamer::sptr rx_stream,
+    const std::string& cpu_format,
+    const size_t frame_size,
+    const uhd::device_addr_t& args)
+{
+    return std::make_shared<rx_frame_streamer_impl>(
+        rx_stream, cpu_format, frame_size, args);
+}
@@ -0,0 +1,201 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/convert.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/utils/rx_recorder.hpp>
+#include <uhd/utils/sc16_codec.hpp>
+#include <uhd/utils/scope_exit.hpp>
+#include <uhdlib/utils/rx_recorder_engine.hpp>
+#include <fstream>
+#include <iomanip>
+
+using namespace uhd;
+
+rx_recorder::~rx_recorder() = default;
+
+namespace {
+
+constexpr size_t DEFAULT_BLOCK_SIZE = 1024 * 1024;
+constexpr size_t DEFAULT_NUM_BLOCKS = 32;
+//! The size of each channel of a compressed block precedes its data
+constexpr size_t CHAN_HEADER_SIZE = sizeof(uint32_t);
+
+void write_u32(char* out, const uint32_t value)
+{
+    for (size_t i = 0; i < sizeof(value); i++) {
+        out[i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+uint32_t read_u32(const uint8_t* in)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < sizeof(value); i++) {
+        value |= static_cast<uint32_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+class rx_recorder_impl : public rx_recorder
+{
+public:
+    rx_recorder_impl(rx_streamer::sptr rx_stream,
+        const std::string& cpu_format,
+        const std::vector<std::string>& paths,
+        const uhd::device_addr_t& args)
+    {
+        rx_recorder_engine::config_t config;
+        config.layout     = rx_recorder_engine::layout_t::STRIPED;
+        config.chan_size  = args.cast<size_t>("block_size", DEFAULT_BLOCK_SIZE);
+        config.num_blocks = args.cast<size_t>("num_blocks", DEFAULT_NUM_BLOCKS);
+        config.direct_io  = args.cast<bool>("direct_io", true);
+        const size_t item_size = uhd::convert::get_bytes_per_item(cpu_format);
+        _compress              = args.cast<bool>("compress", false);
+        if (_compress) {
+            if (cpu_format != "sc16") {
+                throw uhd::value_error(
+                    "rx_recorder: Only sc16 samples can be compressed, not "
+                    + cpu_format);
+            }
+            const size_t num_chans = rx_stream->get_num_channels();
+            const size_t chan_size = config.chan_size;
+            const size_t max_chan_size =
+                CHAN_HEADER_SIZE
+                + uhd::sc16_codec::get_max_encoded_size(chan_size / sizeof(int16_t));
+            config.max_encoded_size = num_chans * max_chan_size;
+            config.encoder = [num_chans, chan_size](
+                                 const char* block, const size_t num_samps, char* out) {
+                char* const start = out;
+                for (size_t i = 0; i < num_chans; i++) {
+                    const size_t size = uhd::sc16_codec::encode(
+                        reinterpret_cast<const int16_t*>(block + i * chan_size),
+                        2 * num_samps,
+                        reinterpret_cast<uint8_t*>(out + CHAN_HEADER_SIZE));
+                    write_u32(out, static_cast<uint32_t>(size));
+                    out += CHAN_HEADER_SIZE + size;
+                }
+                return static_cast<size_t>(out - start);
+            };
+        }
+        _engine                = rx_recorder_engine::make(rx_stream,
+            item_size,
+            paths,
+            config,
+            [this](const rx_recorder_engine::block_info_t& info) {
+                _write_index_entry(info);
+            });
+
+        const std::string index_path = args.get("index_path", paths.front() + ".idx");
+        _index.open(index_path, std::ios::trunc);
+        if (!_index) {
+            throw uhd::os_error("rx_recorder: Could not open " + index_path);
+        }
+        _index << "# UHD RX recording, cpu_format=" << cpu_format
+               << " channels=" << rx_stream->get_num_channels()
+               << " block_size=" << config.chan_size * rx_stream->get_num_channels()
+               << " samps_per_block=" << config.chan_size / item_size
+               << (_compress ? " compressed=1" : "") << "\n";
+        for (size_t i = 0; i < paths.size(); i++) {
+            _index << "# file " << i << ": " << paths[i] << "\n";
+        }
+        _index << "# block file offset num_samps has_time_spec full_secs frac_secs "
+                  "overflow"
+               << (_compress ? " stored_size" : "") << "\n";
+    }
+
+    ~rx_recorder_impl() override
+    {
+        // The engine calls back into this object until it's stopped
+        _engine.reset();
+    }
+
+    void start() override
+    {
+        _engine->start();
+    }
+
+    void stop() override
+    {
+        // Keep the index of what was recorded, even if recording failed
+        auto flush_index = uhd::utils::scope_exit::make([this]() { _index.flush(); });
+        _engine->stop();
+        _index.flush();
+        if (!_index) {
+            throw uhd::os_error("rx_recorder: Could not write the index file");
+        }
+    }
+
+    bool is_running() const override
+    {
+        return _engine->is_running();
+    }
+
+    uint64_t get_num_samps_recorded() const override
+    {
+        return _engine->get_num_samps_recorded();
+    }
+
+    size_t get_num_overflows() const override
+    {
+        return _engine->get_num_overflows();
+    }
+
+private:
+    void _write_index_entry(const rx_recorder_engine::block_info_t& info)
+    {
+        // Blocks end at overruns and bursts, so the first segment covers the block
+        const auto& segment = info.segments.front();
+        _index << info.block_num << " " << info.file_num << " " << info.offset << " "
+               << info.num_samps << " " << segment.has_time_spec << " "
+               << segment.time_spec.get_full_secs() << " " << std::setprecision(17)
+               << segment.time_spec.get_frac_secs() << " " << segment.overflow;
+        if (_compress) {
+            _index << " " << info.stored_size;
+        }
+        _index << "\n";
+    }
+
+    bool _compress = false;
+    std::ofstream _index;
+    rx_recorder_engine::uptr _engine;
+};
+
+} // namespace
+
+rx_recorder::sptr rx_recorder::make(rx_streamer::sptr rx_stream,
+    const std::string& cpu_format,
+    const std::vector<std::string>& paths,
+    const uhd::device_addr_t& args)
+{
+    return std::make_shared<rx_recorder_impl>(rx_stream, cpu_format, paths, args);
+}
+
+std::vector<std::vector<std::complex<int16_t>>> rx_recorder::decode_block(
+    const void* data,
+    const size_t size,
+    const size_t num_channels,
+    const size_t num_samps)
+{
+    std::vector<std::vector<std::complex<int16_t>>> samps(
+        num_channels, std::vector<std::complex<int16_t>>(num_samps));
+    const uint8_t* in = static_cast<const uint8_t*>(data);
+    size_t pos        = 0;
+    for (auto& chan : samps) {
+        if (size - pos < CHAN_HEADER_SIZE) {
+            throw uhd::value_error("rx_recorder: The compressed block is truncated");
+        }
+        const size_t chan_size = read_u32(in + pos);
+        pos += CHAN_HEADER_SIZE;
+        if (size - pos < chan_size) {
+            throw uhd::value_error("rx_recorder: The compressed block is truncated");
+        }
+        uhd::sc16_codec::decode(
+            in + pos, chan_size, 2 * num_samps, reinterpret_cast<int16_t*>(chan.data()));
+        pos += chan_size;
+    }
+    return samps;
+}
@@ -0,0 +1,575 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/thread.hpp>
+#include <uhdlib/utils/rx_recorder_engine.hpp>
+#include <boost/filesystem.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#ifdef HAVE_O_DIRECT
+#    include <fcntl.h>
+#    include <unistd.h>
+#    include <cerrno>
+#endif
+
+using namespace uhd;
+
+constexpr size_t rx_recorder_engine::ALIGNMENT;
+
+namespace {
+
+constexpr char LOG_ID[] = "RX_RECORDER";
+
+//! Timeout of every recv() call, bounds the time stop() takes
+constexpr double RECV_TIMEOUT = 0.1;
+
+/*! A file that is written sequentially, in whole blocks
+ *
+ * With O_DIRECT, the data, its size and the file offset must be aligned to
+ * ALIGNMENT, which all blocks are.
+ */
+class block_file
+{
+public:
+    block_file(const std::string& path, bool direct_io) : _path(path)
+    {
+#ifdef HAVE_O_DIRECT
+        const int flags = O_WRONLY | O_CREAT | O_TRUNC;
+        _fd             = direct_io ? ::open(path.c_str(), flags | O_DIRECT, 0644) : -1;
+        if (direct_io && _fd < 0 && errno == EINVAL) {
+            // Some file systems (e.g., tmpfs) don't support O_DIRECT
+            UHD_LOG_WARNING(LOG_ID,
+                "Direct I/O is not supported for " << path
+                                                   << ", writing through the page cache");
+        }
+        if (_fd < 0) {
+            _fd = ::open(path.c_str(), flags, 0644);
+        }
+        if (_fd < 0) {
+            throw uhd::os_error("rx_recorder: Could not open " + path + ": "
+                                + std::strerror(errno));
+        }
+#else
+        if (direct_io) {
+            UHD_LOG_DEBUG(LOG_ID, "Direct I/O is not supported on this platform");
+        }
+        _file.open(path, std::ios::binary | std::ios::trunc);
+        if (!_file) {
+            throw uhd::os_error("rx_recorder: Could not open " + path);
+        }
+#endif
+    }
+
+    ~block_file()
+    {
+#ifdef HAVE_O_DIRECT
+        ::close(_fd);
+#endif
+    }
+
+    void write(const char* data, size_t size)
+    {
+#ifdef HAVE_O_DIRECT
+        while (size > 0) {
+            const ssize_t result = ::write(_fd, data, size);
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw uhd::os_error("rx_recorder: Could not write " + _path + ": "
+                                    + std::strerror(errno));
+            }
+            data += result;
+            size -= static_cast<size_t>(result);
+        }
+#else
+        if (!_file.write(data, size)) {
+            throw uhd::os_error("rx_recorder: Could not write " + _path);
+        }
+#endif
+    }
+
+    //! Cut off the padding of the last block
+    void truncate(const uint64_t size)
+    {
+#ifdef HAVE_O_DIRECT
+        if (::ftruncate(_fd, static_cast<off_t>(size)) != 0) {
+            throw uhd::os_error("rx_recorder: Could not truncate " + _path + ": "
+                                + std::strerror(errno));
+        }
+#else
+        _file.close();
+        boost::system::error_code ec;
+        boost::filesystem::resize_file(_path, size, ec);
+        if (ec) {
+            throw uhd::os_error(
+                "rx_recorder: Could not truncate " + _path + ": " + ec.message());
+        }
+#endif
+    }
+
+private:
+    const std::string _path;
+#ifdef HAVE_O_DIRECT
+    int _fd = -1;
+#else
+    std::ofstream _file;
+#endif
+};
+
+struct block_t
+{
+    //! Aligned pointer into storage
+    char* data;
+    std::vector<char> storage;
+    rx_recorder_engine::block_info_t info;
+    //! Number of files the block still needs to be written to
+    size_t pending_writes = 0;
+};
+
+class rx_recorder_engine_impl : public rx_recorder_engine
+{
+public:
+    rx_recorder_engine_impl(rx_streamer::sptr rx_stream,
+        const size_t item_size,
+        const std::vector<std::string>& paths,
+        const config_t& config,
+        block_callback_t block_callback)
+        : _rx_stream(rx_stream)
+        , _num_channels(rx_stream->get_num_channels())
+        , _item_size(item_size)
+        , _layout(config.layout)
+        , _chan_size(config.chan_size)
+        , _block_size(_chan_size * _num_channels)
+        , _samps_per_block(_chan_size / _item_size)
+        , _encoder(config.encoder)
+        , _block_callback(block_callback)
+    {
+        if (paths.empty()) {
+            throw uhd::value_error("rx_recorder: No file to record to");
+        }
+        if (_layout == layout_t::PER_CHANNEL && paths.size() != _num_channels) {
+            throw uhd::value_error("rx_recorder: Need one file per channel, got "
+                                   + std::to_string(paths.size()) + " files for "
+                                   + std::to_string(_num_channels) + " channels");
+        }
+        if (_chan_size == 0 || _chan_size % ALIGNMENT != 0
+            || _chan_size % _item_size != 0) {
+            throw uhd::value_error("rx_recorder: The block size must be a multiple of "
+                                   + std::to_string(ALIGNMENT) + " bytes");
+        }
+        if (config.num_blocks < 2) {
+            throw uhd::value_error("rx_recorder: At least two blocks are needed");
+        }
+        if (_encoder && _layout != layout_t::STRIPED) {
+            throw uhd::value_error(
+                "rx_recorder: Blocks can only be encoded with the striped layout");
+        }
+
+        for (const auto& path : paths) {
+            _files.emplace_back(new block_file(path, config.direct_io));
+        }
+        _blocks.resize(config.num_blocks);
+        for (auto& block : _blocks) {
+            block.storage.resize(_block_size + ALIGNMENT);
+            const size_t misalignment =
+                reinterpret_cast<uintptr_t>(block.storage.data()) % ALIGNMENT;
+            block.data = block.storage.data()
+                         + (misalignment ? ALIGNMENT - misalignment : 0);
+            _free_blocks.push_back(&block);
+        }
+        _write_queues.resize(paths.size());
+        if (_encoder) {
+            // Each writer encodes into a buffer of its own
+            const size_t encoded_size =
+                (config.max_encoded_size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+            _encode_buffs.resize(paths.size());
+            for (auto& buff : _encode_buffs) {
+                buff.storage.resize(encoded_size + ALIGNMENT);
+                const size_t misalignment =
+                    reinterpret_cast<uintptr_t>(buff.storage.data()) % ALIGNMENT;
+                buff.data = buff.storage.data()
+                            + (misalignment ? ALIGNMENT - misalignment : 0);
+            }
+            _file_offsets.resize(paths.size(), 0);
+        }
+    }
+
+    ~rx_recorder_engine_impl() override
+    {
+        try {
+            stop();
+        } catch (const uhd::exception& ex) {
+            UHD_LOG_ERROR(LOG_ID, "Recording failed: " << ex.what());
+        }
+    }
+
+    void start() override
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        if (_started) {
+            throw uhd::runtime_error("rx_recorder: Can only be started once");
+        }
+        _started = true;
+        _running = true;
+        for (size_t i = 0; i < _files.size(); i++) {
+            _writer_threads.emplace_back([this, i]() { _write_loop(i); });
+            uhd::set_thread_name(&_writer_threads.back(), "rx_rec_write");
+        }
+        _recv_thread = std::thread([this]() { _recv_loop(); });
+        uhd::set_thread_name(&_recv_thread, "rx_rec_recv");
+    }
+
+    void stop() override
+    {
+        _stop = true;
+        if (_recv_thread.joinable()) {
+            _recv_thread.join();
+        }
+        for (auto& thread : _writer_threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+        _writer_threads.clear();
+        _run_callbacks();
+
+        if (_layout == layout_t::PER_CHANNEL && _started && !_truncated) {
+            _truncated = true;
+            try {
+                for (auto& file : _files) {
+                    file->truncate(_num_samps * _item_size);
+                }
+            } catch (const uhd::os_error& ex) {
+                _set_error(ex.what(), false);
+            }
+        }
+
+        std::lock_guard<std::mutex> l(_mutex);
+        if (!_error.empty()) {
+            const std::string error = _error;
+            _error.clear();
+            if (_error_is_io) {
+                throw uhd::io_error(error);
+            }
+            throw uhd::os_error(error);
+        }
+    }
+
+    bool is_running() const override
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _running;
+    }
+
+    uint64_t get_num_samps_recorded() const override
+    {
+        return _num_samps;
+    }
+
+    size_t get_num_overflows() const override
+    {
+        return _num_overflows;
+    }
+
+private:
+    //! Runs on the receive thread, hands full blocks to the writer threads
+    void _recv_loop()
+    {
+        uhd::rx_metadata_t md;
+        std::vector<void*> buffs(_num_channels);
+        // Samples were lost before the next sample
+        bool gap = false;
+        while (!_stop) {
+            block_t* block = _get_free_block();
+            if (!block) {
+                break;
+            }
+            auto& info     = block->info;
+            info.num_samps = 0;
+            info.segments.clear();
+            while (info.num_samps < _samps_per_block && !_stop) {
+                for (size_t i = 0; i < _num_channels; i++) {
+                    buffs[i] = block->data + i * _chan_size + info.num_samps * _item_size;
+                }
+                const size_t num_recvd = _rx_stream->recv(buffs,
+                    static_cast<size_t>(_samps_per_block - info.num_samps),
+                    md,
+                    RECV_TIMEOUT,
+                    false);
+                if (md.error_code == uhd::rx_metadata_t::ERROR_CODE_OVERFLOW) {
+                    _num_overflows++;
+                    gap = true;
+                    // With the striped layout, every block holds contiguous
+                    // samples
+                    if (_layout == layout_t::STRIPED && info.num_samps > 0) {
+                        break;
+                    }
+                    continue;
+                }
+                if (md.error_code == uhd::rx_metadata_t::ERROR_CODE_TIMEOUT) {
+                    continue;
+                }
+                if (md.error_code != uhd::rx_metadata_t::ERROR_CODE_NONE) {
+                    _set_error("rx_recorder: Receive error: " + md.strerror(), true);
+                    break;
+                }
+                if (num_recvd == 0) {
+                    continue;
+                }
+                if (info.num_samps == 0 || gap || md.start_of_burst) {
+                    info.segments.push_back({_next_samp + info.num_samps,
+                        md.time_spec,
+                        md.has_time_spec,
+                        gap,
+                        md.start_of_burst});
+                    gap = false;
+                }
+                info.num_samps += num_recvd;
+                // With the striped layout, a new burst also starts a new block
+                if (_layout == layout_t::STRIPED && md.end_of_burst) {
+                    break;
+                }
+            }
+            _queue_block(block);
+        }
+
+        std::lock_guard<std::mutex> l(_mutex);
+        _recv_done = true;
+        _running   = false;
+        _cond.notify_all();
+    }
+
+    block_t* _get_free_block()
+    {
+        std::unique_lock<std::mutex> l(_mutex);
+        // No timeout needed, the writers always return the blocks
+        _cond.wait(l, [this]() { return !_free_blocks.empty(); });
+        if (_stop) {
+            return nullptr;
+        }
+        block_t* block = _free_blocks.front();
+        _free_blocks.pop_front();
+        return block;
+    }
+
+    void _queue_block(block_t* block)
+    {
+        auto& info = block->info;
+        if (info.num_samps == 0) {
+            std::lock_guard<std::mutex> l(_mutex);
+            _free_blocks.push_back(block);
+            return;
+        }
+        if (info.num_samps < _samps_per_block) {
+            for (size_t i = 0; i < _num_channels; i++) {
+                std::memset(block->data + i * _chan_size + info.num_samps * _item_size,
+                    0,
+                    static_cast<size_t>(_samps_per_block - info.num_samps)
+                        * _item_size);
+            }
+        }
+        info.block_num   = _num_blocks++;
+        info.first_samp  = _next_samp;
+        info.file_num    = 0;
+        info.offset      = 0;
+        info.stored_size = 0;
+        _next_samp += info.num_samps;
+        if (_layout == layout_t::STRIPED) {
+            info.file_num = info.block_num % _files.size();
+            // The writer knows where an encoded block ends up
+            if (!_encoder) {
+                info.offset      = (info.block_num / _files.size()) * _block_size;
+                info.stored_size = _block_size;
+            }
+        }
+
+        std::lock_guard<std::mutex> l(_mutex);
+        _pending_info.push_back({info, !_encoder});
+        if (_layout == layout_t::STRIPED) {
+            block->pending_writes = 1;
+            _write_queues[info.file_num].push_back(block);
+        } else {
+            block->pending_writes = _files.size();
+            for (auto& queue : _write_queues) {
+                queue.push_back(block);
+            }
+        }
+        _num_samps += info.num_samps;
+        _cond.notify_all();
+    }
+
+    //! Runs on the writer thread of a file
+    void _write_loop(const size_t file_num)
+    {
+        auto& queue = _write_queues[file_num];
+        while (true) {
+            block_t* block = nullptr;
+            {
+                std::unique_lock<std::mutex> l(_mutex);
+                _cond.wait(l, [&]() { return !queue.empty() || _recv_done; });
+                if (queue.empty()) {
+                    break;
+                }
+                block = queue.front();
+                queue.pop_front();
+            }
+            // Keep returning the blocks after an error, or the receive thread
+            // would wait for them forever
+            if (!_write_failed) {
+                try {
+                    if (_encoder) {
+                        _write_encoded(file_num, block);
+                    } else if (_layout == layout_t::STRIPED) {
+                        _files[file_num]->write(block->data, _block_size);
+                    } else {
+                        _files[file_num]->write(
+                            block->data + file_num * _chan_size, _chan_size);
+                    }
+                } catch (const uhd::os_error& ex) {
+                    _write_failed = true;
+                    _set_error(ex.what(), false);
+                }
+            }
+            {
+                std::lock_guard<std::mutex> l(_mutex);
+                if (_encoder) {
+                    auto& pending = _pending_info.at(static_cast<size_t>(
+                        block->info.block_num - _pending_info.front().info.block_num));
+                    pending.info  = block->info;
+                    pending.ready = true;
+                }
+                if (--block->pending_writes == 0) {
+                    _free_blocks.push_back(block);
+                    _cond.notify_all();
+                }
+            }
+            // The callbacks are cheap, the first writer takes care of them
+            if (file_num == 0) {
+                _run_callbacks();
+            }
+        }
+    }
+
+    //! Encodes a block, and writes it after the previous one of the file
+    void _write_encoded(const size_t file_num, block_t* block)
+    {
+        auto& buff         = _encode_buffs[file_num];
+        const size_t size  = _encoder(block->data, block->info.num_samps, buff.data);
+        const size_t total = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        std::memset(buff.data + size, 0, total - size);
+        _files[file_num]->write(buff.data, total);
+        block->info.offset      = _file_offsets[file_num];
+        block->info.stored_size = size;
+        _file_offsets[file_num] += total;
+    }
+
+    void _run_callbacks()
+    {
+        // Encoded blocks are reported in order, once they were written
+        std::vector<block_info_t> infos;
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            while (!_pending_info.empty() && _pending_info.front().ready) {
+                infos.push_back(std::move(_pending_info.front().info));
+                _pending_info.pop_front();
+            }
+        }
+        std::lock_guard<std::mutex> l(_callback_mutex);
+        for (const auto& info : infos) {
+            _block_callback(info);
+        }
+    }
+
+    void _set_error(const std::string& error, const bool is_io)
+    {
+        UHD_LOG_ERROR(LOG_ID, error);
+        std::lock_guard<std::mutex> l(_mutex);
+        if (_error.empty()) {
+            _error       = error;
+            _error_is_io = is_io;
+        }
+        _stop = true;
+    }
+
+    const rx_streamer::sptr _rx_stream;
+    const size_t _num_channels;
+    const size_t _item_size;
+    const layout_t _layout;
+    //! Bytes per channel per block
+    const size_t _chan_size;
+    //! Bytes per block
+    const size_t _block_size;
+    const uint64_t _samps_per_block;
+    const block_encoder_t _encoder;
+    const block_callback_t _block_callback;
+
+    std::vector<std::unique_ptr<block_file>> _files;
+    std::mutex _callback_mutex;
+
+    struct encode_buff_t
+    {
+        //! Aligned pointer into storage
+        char* data;
+        std::vector<char> storage;
+    };
+    //! Only used by the writer thread of each file
+    std::vector<encode_buff_t> _encode_buffs;
+    std::vector<uint64_t> _file_offsets;
+
+    struct pending_info_t
+    {
+        block_info_t info;
+        //! The block was written, and its info is complete
+        bool ready;
+    };
+
+    //! Only used by the receive thread
+    uint64_t _num_blocks = 0;
+    uint64_t _next_samp  = 0;
+
+    //! Protects everything below, up to the counters
+    mutable std::mutex _mutex;
+    std::condition_variable _cond;
+    std::vector<block_t> _blocks;
+    std::deque<block_t*> _free_blocks;
+    std::vector<std::deque<block_t*>> _write_queues;
+    std::deque<pending_info_t> _pending_info;
+    std::string _error;
+    bool _error_is_io = false;
+    bool _started     = false;
+    bool _running     = false;
+    bool _recv_done   = false;
+    bool _truncated   = false;
+
+    std::atomic<bool> _stop{false};
+    std::atomic<bool> _write_failed{false};
+    std::atomic<uint64_t> _num_samps{0};
+    std::atomic<size_t> _num_overflows{0};
+
+    std::thread _recv_thread;
+    std::vector<std::thread> _writer_threads;
+};
+
+} // namespace
+
+rx_recorder_engine::uptr rx_recorder_engine::make(rx_streamer::sptr rx_stream,
+    const size_t item_size,
+    const std::vector<std::string>& paths,
+    const config_t& config,
+    block_callback_t block_callback)
+{
+    return uptr(new rx_recorder_engine_impl(
+        rx_stream, item_size, paths, config, std::move(block_callback)));
+}
@@ -0,0 +1,368 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/math.hpp>
+#include <uhd/utils/rx_spectrum_streamer.hpp>
+#include <uhdlib/utils/fft.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace uhd;
+
+rx_spectrum_streamer::~rx_spectrum_streamer() = default;
+
+namespace {
+
+using steady_clock = std::chrono::steady_clock;
+using sample_t     = std::complex<float>;
+
+constexpr size_t DEFAULT_FFT_SIZE = 1024;
+constexpr size_t DEFAULT_NUM_AVG  = 8;
+//! The power that log output is floored at, so silence isn't -inf dB
+constexpr float MIN_POWER = 1e-20f;
+
+/*! Return a periodic window function of \p size points
+ *
+ * Periodic windows (the DFT-even variant) have the exact spectral properties
+ * of the window for a block that repeats, which is what the FFT sees.
+ */
+std::vector<float> make_window(const std::string& name, const size_t size)
+{
+    std::vector<float> window(size);
+    for (size_t i = 0; i < size; i++) {
+        const double arg = 2 * uhd::math::PI * double(i) / double(size);
+        if (name == "hann") {
+            window[i] = float(0.5 - 0.5 * std::cos(arg));
+        } else if (name == "hamming") {
+            window[i] = float(0.54 - 0.46 * std::cos(arg));
+        } else if (name == "blackman_harris") {
+            window[i] = float(0.35875 - 0.48829 * std::cos(arg)
+                              + 0.14128 * std::cos(2 * arg)
+                              - 0.01168 * std::cos(3 * arg));
+        } else if (name == "rect") {
+            window[i] = 1.0f;
+        } else {
+            throw uhd::value_error("rx_spectrum_streamer: Unknown window " + name);
+        }
+    }
+    return window;
+}
+
+class rx_spectrum_streamer_impl : public rx_spectrum_streamer
+{
+public:
+    rx_spectrum_streamer_impl(rx_streamer::sptr rx_stream,
+        const double rate,
+        const size_t fft_size,
+        std::vector<float> window,
+        const size_t hop,
+        const bool exp_avg,
+        const size_t num_avg,
+        const size_t decim,
+        const steady_clock::duration frame_period,
+        const bool log,
+        const bool shift,
+        fft_fn_t fft)
+        : _rx_stream(rx_stream)
+        , _rate(rate)
+        , _fft_size(fft_size)
+        , _window(std::move(window))
+        , _hop(hop)
+        , _exp_avg(exp_avg)
+        , _num_avg(num_avg)
+        , _decim(decim)
+        , _frame_period(frame_period)
+        , _log(log)
+        , _shift(shift)
+        , _fft(std::move(fft))
+        , _input(fft_size + rx_stream->get_max_num_samps())
+        , _work(fft_size)
+        , _avg(fft_size)
+    {
+        double window_sum = 0;
+        for (const float value : _window) {
+            window_sum += value;
+        }
+        _power_scale = float(1.0 / (window_sum * window_sum));
+    }
+
+    size_t get_fft_size() const override
+    {
+        return _fft_size;
+    }
+
+    size_t recv_frame(float* buff, rx_metadata_t& metadata, const double timeout) override
+    {
+        const auto deadline = steady_clock::now()
+                              + std::chrono::duration_cast<steady_clock::duration>(
+                                  std::chrono::duration<double>(timeout));
+        while (true) {
+            if (_len >= _fft_size) {
+                if (_process_window()) {
+                    _output(buff);
+                    metadata               = rx_metadata_t();
+                    metadata.has_time_spec = _frame_has_time;
+                    metadata.time_spec     = _frame_time;
+                    return _fft_size;
+                }
+                continue;
+            }
+            // The windows of the burst are done, the rest is too short
+            if (_burst_ended) {
+                _restart();
+            }
+
+            const double recv_timeout = std::max(0.0,
+                std::chrono::duration<double>(deadline - steady_clock::now()).count());
+            rx_metadata_t packet_md;
+            const size_t nsamps = _rx_stream->recv(_input.data() + _len,
+                _input.size() - _len,
+                packet_md,
+                recv_timeout,
+                true);
+            if (packet_md.error_code == rx_metadata_t::ERROR_CODE_OVERFLOW) {
+                _num_overflows++;
+                _restart();
+                continue;
+            }
+            if (packet_md.error_code != rx_metadata_t::ERROR_CODE_NONE) {
+                metadata = packet_md;
+                return 0;
+            }
+            if (packet_md.has_time_spec) {
+                _has_time   = true;
+                _anchor_pos = int64_t(_len);
+                _anchor     = packet_md.time_spec;
+            }
+            _len += nsamps;
+            _burst_ended = packet_md.end_of_burst;
+        }
+    }
+
+    uint64_t get_num_frames_skipped() const override
+    {
+        return _num_skipped;
+    }
+
+    uint64_t get_num_overflows() const override
+    {
+        return _num_overflows;
+    }
+
+private:
+    /*! Average the window at the start of the input, and move on to the next
+     *
+     * \return true if a frame is ready to be returned
+     */
+    bool _process_window()
+    {
+        const bool first = (_count == 0);
+        if (first || _exp_avg) {
+            _frame_has_time = _has_time;
+            _frame_time     = _anchor + time_spec_t(double(-_anchor_pos) / _rate);
+        }
+        if (first && !_exp_avg) {
+            // Decide up front, so a skipped frame isn't computed at all
+            _deliver = _decide();
+            std::fill(_avg.begin(), _avg.end(), 0.0f);
+        }
+        if (_exp_avg || _deliver) {
+            _transform();
+        }
+        _count++;
+        _advance();
+
+        if (_exp_avg) {
+            _deliver = _decide();
+        } else if (_count < _num_avg) {
+            return false;
+        } else {
+            _count = 0;
+        }
+        _num_frames++;
+        if (!_deliver) {
+            _num_skipped++;
+            return false;
+        }
+        if (_frame_period != steady_clock::duration::zero()) {
+            // Keep the average rate, but don't catch up after a pause
+            _next_frame_time += _frame_period;
+            if (_next_frame_time < _decision_time) {
+                _next_frame_time = _decision_time + _frame_period;
+            }
+        }
+        return true;
+    }
+
+    //! Decide whether the next frame is returned or skipped
+    bool _decide()
+    {
+        _decision_time = steady_clock::now();
+        return (_num_frames % _decim == 0)
+               && (_frame_period == steady_clock::duration::zero()
+                   || _decision_time >= _next_frame_time);
+    }
+
+    //! Transform the window at the start of the input, and add it to the average
+    void _transform()
+    {
+        for (size_t i = 0; i < _fft_size; i++) {
+            _work[i] = _input[i] * _window[i];
+        }
+        _fft(_work.data());
+        if (!_exp_avg) {
+            for (size_t i = 0; i < _fft_size; i++) {
+                _avg[i] += std::norm(_work[i]);
+            }
+        } else if (_count == 0) {
+            for (size_t i = 0; i < _fft_size; i++) {
+                _avg[i] = std::norm(_work[i]) * _power_scale;
+            }
+        } else {
+            const float weight = 1.0f / float(_num_avg);
+            for (size_t i = 0; i < _fft_size; i++) {
+                _avg[i] += weight * (std::norm(_work[i]) * _power_scale - _avg[i]);
+            }
+        }
+    }
+
+    //! Drop the samples of the current window that the next one doesn't need
+    void _advance()
+    {
+        std::memmove(
+            _input.data(), _input.data() + _hop, (_len - _hop) * sizeof(sample_t));
+        _len -= _hop;
+        _anchor_pos -= int64_t(_hop);
+    }
+
+    //! Write the averaged powers to \p buff, in the order and unit of the output
+    void _output(float* buff) const
+    {
+        const float scale  = _exp_avg ? 1.0f : _power_scale / float(_num_avg);
+        const size_t start = _shift ? _fft_size / 2 : 0;
+        for (size_t i = 0; i < _fft_size; i++) {
+            const float power = _avg[i] * scale;
+            buff[(i + start) % _fft_size] =
+                _log ? 10.0f * std::log10(std::max(power, MIN_POWER)) : power;
+        }
+    }
+
+    //! Start over after a gap in the samples
+    void _restart()
+    {
+        _len         = 0;
+        _count       = 0;
+        _has_time    = false;
+        _burst_ended = false;
+    }
+
+    rx_streamer::sptr _rx_stream;
+    const double _rate;
+    const size_t _fft_size;
+    const std::vector<float> _window;
+    const size_t _hop;
+    const bool _exp_avg;
+    const size_t _num_avg;
+    const size_t _decim;
+    const steady_clock::duration _frame_period;
+    const bool _log;
+    const bool _shift;
+    const fft_fn_t _fft;
+    //! Makes the power of a full scale tone 1.0
+    float _power_scale;
+
+    //! The received samples, the current window starts at the beginning
+    std::vector<sample_t> _input;
+    size_t _len       = 0;
+    bool _burst_ended = false;
+    //! The time of the sample at position _anchor_pos of the input
+    bool _has_time      = false;
+    int64_t _anchor_pos = 0;
+    time_spec_t _anchor;
+
+    std::vector<sample_t> _work;
+    //! The sum (block) or the average (exp) of the powers of the windows
+    std::vector<float> _avg;
+    //! The number of windows in the current average
+    size_t _count        = 0;
+    bool _deliver        = false;
+    bool _frame_has_time = false;
+    time_spec_t _frame_time;
+
+    steady_clock::time_point _decision_time   = {};
+    steady_clock::time_point _next_frame_time = {};
+    uint64_t _num_frames    = 0;
+    uint64_t _num_skipped   = 0;
+    uint64_t _num_overflows = 0;
+};
+
+} // namespace
+
+rx_spectrum_streamer::sptr rx_spectrum_streamer::make(rx_streamer::sptr rx_stream,
+    const double rate,
+    const device_addr_t& args,
+    fft_fn_t fft)
+{
+    if (rx_stream->get_num_channels() != 1) {
+        throw uhd::value_error("rx_spectrum_streamer: The streamer must have a "
+                               "single channel");
+    }
+    if (rate <= 0) {
+        throw uhd::value_error("rx_spectrum_streamer: The sample rate must be positive");
+    }
+    const size_t fft_size = args.cast<size_t>("fft_size", DEFAULT_FFT_SIZE);
+    if (fft_size < 2) {
+        throw uhd::value_error("rx_spectrum_streamer: fft_size must be at least 2");
+    }
+    if (!fft) {
+        // Throws for sizes that aren't a power of two
+        auto plan = std::make_shared<fft_plan>(fft_size);
+        fft       = [plan](sample_t* data) { plan->execute(data); };
+    }
+    const double overlap = args.cast<double>("overlap", 0.5);
+    if (overlap < 0.0 || overlap >= 1.0) {
+        throw uhd::value_error("rx_spectrum_streamer: overlap must be in [0, 1)");
+    }
+    const size_t hop = std::max<size_t>(
+        1, size_t(std::lround(double(fft_size) * (1.0 - overlap))));
+    const std::string averaging = args.get("averaging", "block");
+    if (averaging != "block" && averaging != "exp") {
+        throw uhd::value_error(
+            "rx_spectrum_streamer: averaging must be block or exp, not " + averaging);
+    }
+    const size_t num_avg = args.cast<size_t>("num_avg", DEFAULT_NUM_AVG);
+    const size_t decim   = args.cast<size_t>("decim", 1);
+    if (num_avg == 0 || decim == 0) {
+        throw uhd::value_error("rx_spectrum_streamer: num_avg and decim must not be 0");
+    }
+    const double max_frame_rate = args.cast<double>("max_frame_rate", 0.0);
+    if (max_frame_rate < 0.0) {
+        throw uhd::value_error("rx_spectrum_streamer: max_frame_rate must not be "
+                               "negative");
+    }
+    steady_clock::duration frame_period = steady_clock::duration::zero();
+    if (max_frame_rate > 0.0) {
+        frame_period = std::chrono::duration_cast<steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / max_frame_rate));
+    }
+    return std::make_shared<rx_spectrum_streamer_impl>(rx_stream,
+        rate,
+        fft_size,
+        make_window(args.get("window", "hann"), fft_size),
+        hop,
+        averaging == "exp",
+        num_avg,
+        decim,
+        frame_period,
+        args.cast<bool>("log", false),
+        args.cast<bool>("shift", true),
+        std::move(fft));
+}
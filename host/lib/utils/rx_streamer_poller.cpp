@@ -0,0 +1,194 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/rx_streamer_poller.hpp>
+#include <uhd/utils/safe_call.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+
+using namespace uhd;
+
+rx_streamer_poller::~rx_streamer_poller() = default;
+
+namespace {
+
+class rx_streamer_poller_impl : public rx_streamer_poller
+{
+public:
+    ~rx_streamer_poller_impl()
+    {
+        std::vector<rx_streamer::sptr> rx_streams;
+        {
+            std::lock_guard<std::mutex> l(_state->mutex);
+            for (auto& entry : _state->entries) {
+                rx_streams.push_back(entry.second->rx_stream);
+            }
+        }
+        for (auto& rx_stream : rx_streams) {
+            UHD_SAFE_CALL(rx_stream->set_recv_ready_callback({});)
+        }
+    }
+
+    void add(rx_streamer::sptr rx_stream)
+    {
+        auto entry = std::make_shared<entry_t>();
+        entry->rx_stream = rx_stream;
+        {
+            std::lock_guard<std::mutex> l(_state->mutex);
+            if (!_state->entries.emplace(rx_stream.get(), entry).second) {
+                throw uhd::value_error("rx_streamer_poller: Streamer was already added");
+            }
+        }
+        // The callback only holds weak references, so a streamer that drops
+        // its callback late doesn't keep the poller alive, or vice versa
+        std::weak_ptr<state_t> weak_state = _state;
+        std::weak_ptr<entry_t> weak_entry = entry;
+        try {
+            rx_stream->set_recv_ready_callback([weak_state, weak_entry]() {
+                auto state = weak_state.lock();
+                auto entry = weak_entry.lock();
+                if (state && entry) {
+                    state->notify(entry);
+                }
+            });
+        } catch (...) {
+            std::lock_guard<std::mutex> l(_state->mutex);
+            _state->entries.erase(rx_stream.get());
+            throw;
+        }
+        // It may already hold data that arrived before the callback was set
+        std::lock_guard<std::mutex> l(_state->mutex);
+        if (_state->entries.count(rx_stream.get())) {
+            _state->make_ready(entry);
+        }
+    }
+
+    void remove(rx_streamer::sptr rx_stream)
+    {
+        {
+            std::lock_guard<std::mutex> l(_state->mutex);
+            if (!_state->entries.count(rx_stream.get())) {
+                return;
+            }
+        }
+        // This must not hold our mutex: The streamer holds its own lock while
+        // it calls the callback, which then takes ours
+        rx_stream->set_recv_ready_callback({});
+        std::lock_guard<std::mutex> l(_state->mutex);
+        auto it = _state->entries.find(rx_stream.get());
+        if (it == _state->entries.end()) {
+            return;
+        }
+        it->second->state = IDLE;
+        _state->entries.erase(it);
+        for (auto ready = _state->ready.begin(); ready != _state->ready.end();) {
+            ready = (ready->get() == rx_stream.get()) ? _state->ready.erase(ready)
+                                                      : std::next(ready);
+        }
+    }
+
+    std::vector<rx_streamer::sptr> wait(const double timeout, const size_t max_streamers)
+    {
+        std::unique_lock<std::mutex> l(_state->mutex);
+        _state->cond.wait_for(l, std::chrono::duration<double>(timeout), [this]() {
+            return !_state->ready.empty();
+        });
+        std::vector<rx_streamer::sptr> rx_streams;
+        while (!_state->ready.empty()
+               && (max_streamers == 0 || rx_streams.size() < max_streamers)) {
+            auto it = _state->entries.find(_state->ready.front().get());
+            _state->ready.pop_front();
+            if (it == _state->entries.end() || it->second->state != READY) {
+                continue;
+            }
+            it->second->state = ACTIVE;
+            rx_streams.push_back(it->second->rx_stream);
+        }
+        return rx_streams;
+    }
+
+    void release(rx_streamer::sptr rx_stream)
+    {
+        std::lock_guard<std::mutex> l(_state->mutex);
+        auto it = _state->entries.find(rx_stream.get());
+        if (it == _state->entries.end()) {
+            throw uhd::value_error("rx_streamer_poller: Streamer was not added");
+        }
+        auto& entry = it->second;
+        if (entry->state == ACTIVE_PENDING) {
+            _state->make_ready(entry);
+        } else if (entry->state == ACTIVE) {
+            entry->state = IDLE;
+        }
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> l(_state->mutex);
+        return _state->entries.size();
+    }
+
+private:
+    enum entry_state_t {
+        //! No data since the streamer was last released
+        IDLE,
+        //! Has data, and waits to be returned by wait()
+        READY,
+        //! Handed out by wait()
+        ACTIVE,
+        //! Handed out by wait(), and more data arrived since
+        ACTIVE_PENDING
+    };
+
+    struct entry_t
+    {
+        rx_streamer::sptr rx_stream;
+        entry_state_t state = IDLE;
+    };
+
+    using entry_sptr = std::shared_ptr<entry_t>;
+
+    //! Everything the callbacks touch, so they can outlive the poller
+    struct state_t
+    {
+        //! Called with the mutex held
+        void make_ready(const entry_sptr& entry)
+        {
+            entry->state = READY;
+            ready.push_back(entry->rx_stream);
+            cond.notify_one();
+        }
+
+        void notify(const entry_sptr& entry)
+        {
+            std::lock_guard<std::mutex> l(mutex);
+            if (entry->state == IDLE && entries.count(entry->rx_stream.get())) {
+                make_ready(entry);
+            } else if (entry->state == ACTIVE) {
+                entry->state = ACTIVE_PENDING;
+            }
+        }
+
+        mutable std::mutex mutex;
+        std::condition_variable cond;
+        std::map<const rx_streamer*, entry_sptr> entries;
+        //! Streamers in the order they became ready
+        std::deque<rx_streamer::sptr> ready;
+    };
+
+    std::shared_ptr<state_t> _state = std::make_shared<state_t>();
+};
+
+} // namespace
+
+rx_streamer_poller::sptr rx_streamer_poller::make()
+{
+    return std::make_shared<rx_streamer_poller_impl>();
+}
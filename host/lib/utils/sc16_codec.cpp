@@ -0,0 +1,164 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/sc16_codec.hpp>
+#include <algorithm>
+#include <string>
+#if defined(__SSE2__) || defined(_M_X64)
+#    include <emmintrin.h>
+#    define UHD_SC16_CODEC_SSE2
+#endif
+
+using namespace uhd;
+
+namespace {
+
+constexpr uint8_t MAX_WIDTH = 16;
+
+//! Return the OR of all values, and the OR of their magnitude bits
+void scan_group(const int16_t* in, const size_t num_values, uint16_t& any, uint16_t& mag)
+{
+    size_t i = 0;
+    any      = 0;
+    mag      = 0;
+#ifdef UHD_SC16_CODEC_SSE2
+    // For a negative value, the inverted bits are the magnitude
+    __m128i any_v = _mm_setzero_si128();
+    __m128i mag_v = _mm_setzero_si128();
+    for (; i + 8 <= num_values; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        any_v           = _mm_or_si128(any_v, v);
+        mag_v           = _mm_or_si128(mag_v, _mm_xor_si128(v, _mm_srai_epi16(v, 15)));
+    }
+    any_v = _mm_or_si128(any_v, _mm_srli_si128(any_v, 8));
+    any_v = _mm_or_si128(any_v, _mm_srli_si128(any_v, 4));
+    any_v = _mm_or_si128(any_v, _mm_srli_si128(any_v, 2));
+    mag_v = _mm_or_si128(mag_v, _mm_srli_si128(mag_v, 8));
+    mag_v = _mm_or_si128(mag_v, _mm_srli_si128(mag_v, 4));
+    mag_v = _mm_or_si128(mag_v, _mm_srli_si128(mag_v, 2));
+    any   = static_cast<uint16_t>(_mm_cvtsi128_si32(any_v));
+    mag   = static_cast<uint16_t>(_mm_cvtsi128_si32(mag_v));
+#endif
+    for (; i < num_values; i++) {
+        const int16_t v = in[i];
+        any |= static_cast<uint16_t>(v);
+        mag |= static_cast<uint16_t>(v < 0 ? ~v : v);
+    }
+}
+
+/*! Return the bit width of a group
+ *
+ * A value needs its magnitude bits and a sign bit. Only a group of zeros needs
+ * no bits at all, -1 needs one.
+ */
+uint8_t get_width(const uint16_t any, uint16_t mag)
+{
+    if (any == 0) {
+        return 0;
+    }
+    uint8_t width = 1;
+    while (mag != 0) {
+        mag >>= 1;
+        width++;
+    }
+    return width;
+}
+
+size_t get_packed_size(const size_t num_values, const uint8_t width)
+{
+    return (num_values * width + 7) / 8;
+}
+
+} // namespace
+
+size_t sc16_codec::get_max_encoded_size(const size_t num_values)
+{
+    const size_t num_groups = (num_values + GROUP_SIZE - 1) / GROUP_SIZE;
+    return num_groups + num_values * sizeof(int16_t);
+}
+
+size_t sc16_codec::encode(const int16_t* in, const size_t num_values, uint8_t* out)
+{
+    uint8_t* const start = out;
+    for (size_t offset = 0; offset < num_values; offset += GROUP_SIZE) {
+        const size_t n        = std::min(GROUP_SIZE, num_values - offset);
+        const int16_t* values = in + offset;
+        uint16_t any, mag;
+        scan_group(values, n, any, mag);
+        const uint8_t width = get_width(any, mag);
+        *out++              = width;
+
+        const uint32_t mask = (1u << width) - 1;
+        uint64_t acc        = 0;
+        size_t num_bits     = 0;
+        for (size_t i = 0; i < n; i++) {
+            acc |= static_cast<uint64_t>(static_cast<uint16_t>(values[i]) & mask)
+                   << num_bits;
+            num_bits += width;
+            if (num_bits >= 32) {
+                out[0] = static_cast<uint8_t>(acc);
+                out[1] = static_cast<uint8_t>(acc >> 8);
+                out[2] = static_cast<uint8_t>(acc >> 16);
+                out[3] = static_cast<uint8_t>(acc >> 24);
+                out += 4;
+                acc >>= 32;
+                num_bits -= 32;
+            }
+        }
+        for (; num_bits > 0; num_bits -= std::min<size_t>(num_bits, 8)) {
+            *out++ = static_cast<uint8_t>(acc);
+            acc >>= 8;
+        }
+    }
+    return static_cast<size_t>(out - start);
+}
+
+size_t sc16_codec::decode(
+    const uint8_t* in, const size_t size, const size_t num_values, int16_t* out)
+{
+    size_t pos = 0;
+    for (size_t offset = 0; offset < num_values; offset += GROUP_SIZE) {
+        const size_t n = std::min(GROUP_SIZE, num_values - offset);
+        if (pos >= size) {
+            throw uhd::value_error("sc16_codec: The encoded data is truncated");
+        }
+        const uint8_t width = in[pos++];
+        if (width > MAX_WIDTH) {
+            throw uhd::value_error("sc16_codec: Invalid bit width "
+                                   + std::to_string(width) + " in the encoded data");
+        }
+        const size_t packed_size = get_packed_size(n, width);
+        if (size - pos < packed_size) {
+            throw uhd::value_error("sc16_codec: The encoded data is truncated");
+        }
+        int16_t* values = out + offset;
+        if (width == 0) {
+            std::fill(values, values + n, 0);
+            continue;
+        }
+
+        const uint8_t* packed = in + pos;
+        const uint32_t mask   = (1u << width) - 1;
+        const int shift       = 32 - width;
+        uint64_t acc          = 0;
+        size_t num_bits       = 0;
+        size_t byte_pos       = 0;
+        for (size_t i = 0; i < n; i++) {
+            while (num_bits < width) {
+                acc |= static_cast<uint64_t>(packed[byte_pos++]) << num_bits;
+                num_bits += 8;
+            }
+            // Sign-extend from the bit width
+            const uint32_t bits = (static_cast<uint32_t>(acc) & mask) << shift;
+            values[i] = static_cast<int16_t>(static_cast<int32_t>(bits) >> shift);
+            acc >>= width;
+            num_bits -= width;
+        }
+        pos += packed_size;
+    }
+    return pos;
+}
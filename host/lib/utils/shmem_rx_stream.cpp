@@ -0,0 +1,587 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/convert.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/shmem_rx_stream.hpp>
+#include <uhd/utils/thread.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <vector>
+
+#ifdef UHD_PLATFORM_LINUX
+#    include <linux/futex.h>
+#    include <linux/memfd.h>
+#    include <poll.h>
+#    include <sys/mman.h>
+#    include <sys/socket.h>
+#    include <sys/stat.h>
+#    include <sys/syscall.h>
+#    include <sys/un.h>
+#    include <unistd.h>
+#    include <climits>
+#    include <ctime>
+#endif
+
+using namespace uhd;
+
+constexpr size_t shmem_rx_publisher::DEFAULT_NUM_PACKETS;
+
+shmem_rx_publisher::~shmem_rx_publisher() = default;
+
+#ifdef UHD_PLATFORM_LINUX
+namespace {
+
+constexpr uint64_t SHMEM_RX_MAGIC = 0x5548445348525831; // "UHDSHRX1"
+constexpr size_t CACHE_LINE_SIZE  = 64;
+constexpr size_t MAX_FORMAT_LEN   = 32;
+
+//! Timeout of the receive thread, so it notices when it should stop (s)
+constexpr double RECV_TIMEOUT = 0.1;
+//! How often the accept thread checks whether it should stop (ms)
+constexpr int ACCEPT_POLL_INTERVAL_MS = 100;
+
+//! Layout of the start of the shared memory region
+struct region_hdr_t
+{
+    uint64_t magic;
+    uint64_t size;
+    uint64_t num_chans;
+    uint64_t num_packets;
+    //! Maximum number of samples in a packet
+    uint64_t max_samps;
+    uint64_t bytes_per_samp;
+    //! Offset of the first slot from the start of the region
+    uint64_t slots_offset;
+    //! Number of bytes between the start of two slots
+    uint64_t slot_stride;
+    //! Number of bytes between the start of the buffers of two channels
+    uint64_t chan_stride;
+    double rate;
+    char cpu_format[MAX_FORMAT_LEN];
+    //! Number of packets the publisher has written
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> num_published;
+    //! Counts up for every packet, clients wait on it
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> futex;
+    std::atomic<uint32_t> num_waiters;
+    std::atomic<uint32_t> closed;
+};
+
+//! The number of samples and the metadata of a packet
+struct packet_info_t
+{
+    uint64_t nsamps;
+    int64_t full_secs;
+    double frac_secs;
+    uint64_t fragment_offset;
+    uint32_t error_code;
+    uint8_t has_time_spec;
+    uint8_t more_fragments;
+    uint8_t start_of_burst;
+    uint8_t end_of_burst;
+    uint8_t out_of_sequence;
+};
+
+/*! Header of a packet slot, followed by the buffers of the channels
+ *
+ * The publisher sets seq to 2 * n + 1 while it writes packet n into the slot,
+ * and to 2 * n + 2 once it's done. Clients check it before and after reading a
+ * packet, to tell whether it was overwritten in the meantime.
+ */
+struct slot_hdr_t
+{
+    std::atomic<uint64_t> seq;
+    packet_info_t info;
+};
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(int),
+    "The futex word must be an int in shared memory");
+
+//! pad the byte count to a multiple of alignment
+size_t pad_to_boundary(const size_t bytes, const size_t alignment)
+{
+    return bytes + (alignment - bytes) % alignment;
+}
+
+//! Make the address of the Unix socket of a publisher (in the abstract namespace)
+socklen_t make_socket_addr(const std::string& name, sockaddr_un& addr)
+{
+    const std::string path = std::string(1, '\0') + "uhd-shmem-rx-" + name;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() > sizeof(addr.sun_path)) {
+        throw uhd::value_error("Shared memory stream name is too long: " + name);
+    }
+    std::memcpy(addr.sun_path, path.data(), path.size());
+    return socklen_t(offsetof(sockaddr_un, sun_path) + path.size());
+}
+
+int futex(std::atomic<uint32_t>* word, const int op, const uint32_t val, timespec* ts)
+{
+    return int(
+        ::syscall(SYS_futex, reinterpret_cast<int*>(word), op, val, ts, nullptr, 0));
+}
+
+slot_hdr_t* get_slot(region_hdr_t* region, const uint64_t index)
+{
+    uint8_t* slots = reinterpret_cast<uint8_t*>(region) + region->slots_offset;
+    return reinterpret_cast<slot_hdr_t*>(
+        slots + (index % region->num_packets) * region->slot_stride);
+}
+
+uint8_t* get_buff(region_hdr_t* region, slot_hdr_t* slot, const size_t chan)
+{
+    return reinterpret_cast<uint8_t*>(slot)
+           + pad_to_boundary(sizeof(slot_hdr_t), CACHE_LINE_SIZE)
+           + chan * region->chan_stride;
+}
+
+/*! Shared memory RX publisher
+ *
+ * One thread receives into the ring, another one hands the region to the
+ * clients that connect to the socket.
+ */
+class shmem_rx_publisher_impl : public shmem_rx_publisher
+{
+public:
+    shmem_rx_publisher_impl(rx_streamer::sptr rx_stream,
+        const std::string& cpu_format,
+        const double rate,
+        const std::string& name,
+        const size_t num_packets)
+        : _rx_stream(rx_stream), _name(name)
+    {
+        if (num_packets == 0) {
+            throw uhd::value_error("The ring needs at least one packet!");
+        }
+        if (rate <= 0.0) {
+            throw uhd::value_error("The sample rate must be positive!");
+        }
+        if (cpu_format.size() >= MAX_FORMAT_LEN) {
+            throw uhd::value_error("Invalid CPU format: " + cpu_format);
+        }
+        const size_t num_chans      = rx_stream->get_num_channels();
+        const size_t max_samps      = rx_stream->get_max_num_samps();
+        const size_t bytes_per_samp = uhd::convert::get_bytes_per_item(cpu_format);
+
+        // Lay out the region: the header, and then the slots, starting on a
+        // page boundary
+        const size_t page_size   = size_t(::sysconf(_SC_PAGESIZE));
+        const size_t chan_stride =
+            pad_to_boundary(max_samps * bytes_per_samp, CACHE_LINE_SIZE);
+        const size_t slot_stride = pad_to_boundary(sizeof(slot_hdr_t), CACHE_LINE_SIZE)
+                                   + num_chans * chan_stride;
+        const size_t slots_offset = pad_to_boundary(sizeof(region_hdr_t), page_size);
+        const size_t region_size =
+            pad_to_boundary(slots_offset + num_packets * slot_stride, page_size);
+
+        sockaddr_un addr;
+        const socklen_t addr_len = make_socket_addr(name, addr);
+        _listen_fd               = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (_listen_fd < 0) {
+            throw uhd::os_error(
+                std::string("Failed to create socket: ") + std::strerror(errno));
+        }
+        if (::bind(_listen_fd, reinterpret_cast<sockaddr*>(&addr), addr_len) != 0) {
+            const int err = errno;
+            ::close(_listen_fd);
+            if (err == EADDRINUSE) {
+                throw uhd::key_error(
+                    "There already is a shared memory stream named " + name);
+            }
+            throw uhd::os_error(
+                std::string("Failed to bind socket: ") + std::strerror(err));
+        }
+
+        _fd = int(::syscall(
+            SYS_memfd_create, ("uhd-shmem-rx-" + name).c_str(), MFD_CLOEXEC));
+        void* mem = MAP_FAILED;
+        if (_fd >= 0 && ::ftruncate(_fd, off_t(region_size)) == 0) {
+            mem = ::mmap(
+                nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+        }
+        if (mem == MAP_FAILED || ::listen(_listen_fd, SOMAXCONN) != 0) {
+            const std::string err = std::strerror(errno);
+            if (mem != MAP_FAILED) {
+                ::munmap(mem, region_size);
+            }
+            if (_fd >= 0) {
+                ::close(_fd);
+            }
+            ::close(_listen_fd);
+            throw uhd::os_error("Failed to set up shared memory region: " + err);
+        }
+
+        _region                 = new (mem) region_hdr_t();
+        _region->size           = region_size;
+        _region->num_chans      = num_chans;
+        _region->num_packets    = num_packets;
+        _region->max_samps      = max_samps;
+        _region->bytes_per_samp = bytes_per_samp;
+        _region->slots_offset   = slots_offset;
+        _region->slot_stride    = slot_stride;
+        _region->chan_stride    = chan_stride;
+        _region->rate           = rate;
+        std::strncpy(_region->cpu_format, cpu_format.c_str(), MAX_FORMAT_LEN - 1);
+        for (size_t i = 0; i < num_packets; i++) {
+            new (get_slot(_region, i)) slot_hdr_t();
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        _region->magic = SHMEM_RX_MAGIC;
+
+        UHD_LOG_DEBUG("SHMEM_RX",
+            "Publishing RX stream " << name << " with " << num_packets << " packets of "
+                                    << max_samps << " samples and " << num_chans
+                                    << " channel(s), " << region_size << " bytes");
+
+        _recv_thread = std::thread([this]() { _recv_loop(); });
+        uhd::set_thread_name(&_recv_thread, "shmem_rx");
+        _accept_thread = std::thread([this]() { _accept_loop(); });
+        uhd::set_thread_name(&_accept_thread, "shmem_rx_accept");
+    }
+
+    ~shmem_rx_publisher_impl()
+    {
+        _running = false;
+        _recv_thread.join();
+        _accept_thread.join();
+        ::close(_listen_fd);
+        // Attached clients keep their mapping, and time out from now on
+        _region->closed = 1;
+        _region->futex++;
+        futex(&_region->futex, FUTEX_WAKE, INT_MAX, nullptr);
+        ::munmap(_region, _region->size);
+        ::close(_fd);
+    }
+
+    std::string get_name() const
+    {
+        return _name;
+    }
+
+    uint64_t get_num_packets() const
+    {
+        return _num_packets;
+    }
+
+private:
+    void _recv_loop()
+    {
+        std::vector<void*> buffs(_region->num_chans);
+        rx_metadata_t md;
+        uint64_t next = 0;
+        while (_running) {
+            slot_hdr_t* slot = get_slot(_region, next);
+            slot->seq.store(2 * next + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (size_t chan = 0; chan < buffs.size(); chan++) {
+                buffs[chan] = get_buff(_region, slot, chan);
+            }
+            size_t nsamps = 0;
+            try {
+                nsamps =
+                    _rx_stream->recv(buffs, _region->max_samps, md, RECV_TIMEOUT, true);
+            } catch (const uhd::exception& ex) {
+                UHD_LOG_ERROR("SHMEM_RX", "Error while receiving: " << ex.what());
+                continue;
+            }
+            if (md.error_code == rx_metadata_t::ERROR_CODE_TIMEOUT) {
+                continue;
+            }
+            packet_info_t& info  = slot->info;
+            info.nsamps          = nsamps;
+            info.full_secs       = int64_t(md.time_spec.get_full_secs());
+            info.frac_secs       = md.time_spec.get_frac_secs();
+            info.fragment_offset = md.fragment_offset;
+            info.error_code      = uint32_t(md.error_code);
+            info.has_time_spec   = md.has_time_spec;
+            info.more_fragments  = md.more_fragments;
+            info.start_of_burst  = md.start_of_burst;
+            info.end_of_burst    = md.end_of_burst;
+            info.out_of_sequence = md.out_of_sequence;
+            slot->seq.store(2 * next + 2, std::memory_order_release);
+            next++;
+            _region->num_published.store(next, std::memory_order_release);
+            if (md.error_code == rx_metadata_t::ERROR_CODE_NONE) {
+                _num_packets++;
+            }
+            _region->futex++;
+            if (_region->num_waiters > 0) {
+                futex(&_region->futex, FUTEX_WAKE, INT_MAX, nullptr);
+            }
+        }
+    }
+
+    //! Hand the region to every client that connects
+    void _accept_loop()
+    {
+        pollfd pfd{_listen_fd, POLLIN, 0};
+        while (_running) {
+            if (::poll(&pfd, 1, ACCEPT_POLL_INTERVAL_MS) <= 0) {
+                continue;
+            }
+            const int client_fd = ::accept4(_listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (client_fd < 0) {
+                continue;
+            }
+            char byte = 0;
+            iovec iov{&byte, 1};
+            char control[CMSG_SPACE(sizeof(int))] = {};
+            msghdr msg{};
+            msg.msg_iov        = &iov;
+            msg.msg_iovlen     = 1;
+            msg.msg_control    = control;
+            msg.msg_controllen = sizeof(control);
+            cmsghdr* cmsg      = CMSG_FIRSTHDR(&msg);
+            cmsg->cmsg_level   = SOL_SOCKET;
+            cmsg->cmsg_type    = SCM_RIGHTS;
+            cmsg->cmsg_len     = CMSG_LEN(sizeof(int));
+            std::memcpy(CMSG_DATA(cmsg), &_fd, sizeof(int));
+            if (::sendmsg(client_fd, &msg, MSG_NOSIGNAL) < 0) {
+                UHD_LOG_DEBUG("SHMEM_RX",
+                    "Failed to hand stream " << _name
+                                             << " to a client: " << std::strerror(errno));
+            }
+            ::close(client_fd);
+        }
+    }
+
+    rx_streamer::sptr _rx_stream;
+    const std::string _name;
+    int _listen_fd          = -1;
+    int _fd                 = -1;
+    region_hdr_t* _region   = nullptr;
+    std::atomic<bool> _running{true};
+    std::atomic<uint64_t> _num_packets{0};
+    std::thread _recv_thread;
+    std::thread _accept_thread;
+};
+
+/*! Shared memory RX streamer
+ *
+ * Keeps its own position in the ring, so any number of them can read from
+ * the same publisher.
+ */
+class shmem_rx_streamer_impl : public rx_streamer
+{
+public:
+    shmem_rx_streamer_impl(region_hdr_t* region)
+        : _region(region), _next(region->num_published.load())
+    {
+    }
+
+    ~shmem_rx_streamer_impl()
+    {
+        ::munmap(_region, _region->size);
+    }
+
+    size_t get_num_channels() const
+    {
+        return _region->num_chans;
+    }
+
+    size_t get_max_num_samps() const
+    {
+        return _region->max_samps;
+    }
+
+    size_t recv(const buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        rx_metadata_t& metadata,
+        const double timeout = 0.1,
+        const bool /*one_packet*/ = false)
+    {
+        metadata.reset();
+        if (!_wait_for_packet(timeout)) {
+            metadata.error_code = rx_metadata_t::ERROR_CODE_TIMEOUT;
+            return 0;
+        }
+        const uint64_t published = _region->num_published.load(std::memory_order_acquire);
+        slot_hdr_t* slot         = get_slot(_region, _next);
+        const uint64_t seq       = slot->seq.load(std::memory_order_acquire);
+        if (published - _next > _region->num_packets || seq != 2 * _next + 2) {
+            return _overflow(metadata, published);
+        }
+
+        const packet_info_t info = slot->info;
+        const size_t nsamps = std::min<size_t>(nsamps_per_buff, info.nsamps - _offset);
+        for (size_t chan = 0; chan < buffs.size() && nsamps; chan++) {
+            std::memcpy(buffs[chan],
+                get_buff(_region, slot, chan) + _offset * _region->bytes_per_samp,
+                nsamps * _region->bytes_per_samp);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->seq.load(std::memory_order_relaxed) != seq) {
+            return _overflow(metadata, published);
+        }
+
+        const bool done     = _offset + nsamps >= info.nsamps;
+        metadata.error_code = static_cast<rx_metadata_t::error_code_t>(info.error_code);
+        metadata.has_time_spec   = info.has_time_spec;
+        metadata.time_spec       = time_spec_t(time_t(info.full_secs), info.frac_secs)
+                             + time_spec_t::from_ticks(_offset, _region->rate);
+        metadata.more_fragments  = info.more_fragments || !done;
+        metadata.fragment_offset = info.fragment_offset + _offset;
+        metadata.start_of_burst  = info.start_of_burst && _offset == 0;
+        metadata.end_of_burst    = info.end_of_burst && done;
+        metadata.out_of_sequence = info.out_of_sequence;
+        if (done) {
+            _next++;
+            _offset = 0;
+        } else {
+            _offset += nsamps;
+        }
+        return nsamps;
+    }
+
+    void issue_stream_cmd(const stream_cmd_t&)
+    {
+        UHD_LOG_DEBUG(
+            "SHMEM_RX", "Ignoring stream command, the publisher owns the stream");
+    }
+
+private:
+    //! Skip the packets that were overwritten, and report an overflow
+    size_t _overflow(rx_metadata_t& metadata, const uint64_t published)
+    {
+        _next               = published;
+        _offset             = 0;
+        metadata.error_code = rx_metadata_t::ERROR_CODE_OVERFLOW;
+        return 0;
+    }
+
+    bool _has_packet() const
+    {
+        return _region->num_published.load(std::memory_order_acquire) > _next;
+    }
+
+    bool _wait_for_packet(const double timeout)
+    {
+        if (_has_packet()) {
+            return true;
+        }
+        const auto timeout_point = std::chrono::steady_clock::now()
+                                   + std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                       std::chrono::duration<double>(timeout));
+        _region->num_waiters++;
+        while (!_region->closed) {
+            const uint32_t futex_val = _region->futex;
+            if (_has_packet()) {
+                break;
+            }
+            const auto remaining = timeout_point - std::chrono::steady_clock::now();
+            if (remaining <= std::chrono::nanoseconds::zero()) {
+                break;
+            }
+            const auto ns =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(remaining);
+            timespec ts{time_t(ns.count() / 1000000000), long(ns.count() % 1000000000)};
+            futex(&_region->futex, FUTEX_WAIT, futex_val, &ts);
+        }
+        _region->num_waiters--;
+        return _has_packet();
+    }
+
+    region_hdr_t* _region;
+    //! The packet to read next, and the number of its samples already read
+    uint64_t _next;
+    size_t _offset = 0;
+};
+
+//! Connect to the socket of a publisher, and map the region it hands out
+region_hdr_t* attach_region(const std::string& name)
+{
+    sockaddr_un addr;
+    const socklen_t addr_len = make_socket_addr(name, addr);
+    const int sock_fd        = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (sock_fd < 0) {
+        throw uhd::os_error(
+            std::string("Failed to create socket: ") + std::strerror(errno));
+    }
+    if (::connect(sock_fd, reinterpret_cast<sockaddr*>(&addr), addr_len) != 0) {
+        ::close(sock_fd);
+        throw uhd::io_error("There is no shared memory stream named " + name);
+    }
+    char byte = 0;
+    iovec iov{&byte, 1};
+    char control[CMSG_SPACE(sizeof(int))] = {};
+    msghdr msg{};
+    msg.msg_iov        = &iov;
+    msg.msg_iovlen     = 1;
+    msg.msg_control    = control;
+    msg.msg_controllen = sizeof(control);
+    const ssize_t len  = ::recvmsg(sock_fd, &msg, MSG_CMSG_CLOEXEC);
+    ::close(sock_fd);
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    if (len != 1 || !cmsg || cmsg->cmsg_type != SCM_RIGHTS) {
+        throw uhd::io_error("Failed to attach to shared memory stream " + name);
+    }
+    int fd;
+    std::memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+
+    struct stat fd_stat;
+    void* mem = MAP_FAILED;
+    if (::fstat(fd, &fd_stat) == 0 && size_t(fd_stat.st_size) >= sizeof(region_hdr_t)) {
+        mem = ::mmap(
+            nullptr, size_t(fd_stat.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (mem == MAP_FAILED) {
+        throw uhd::io_error("Failed to map shared memory stream " + name);
+    }
+    auto region = static_cast<region_hdr_t*>(mem);
+    if (region->magic != SHMEM_RX_MAGIC || region->size != size_t(fd_stat.st_size)) {
+        ::munmap(mem, size_t(fd_stat.st_size));
+        throw uhd::io_error(name + " is not a shared memory RX stream");
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return region;
+}
+
+} // namespace
+
+shmem_rx_publisher::sptr shmem_rx_publisher::make(rx_streamer::sptr rx_stream,
+    const std::string& cpu_format,
+    const double rate,
+    const std::string& name,
+    const size_t num_packets)
+{
+    return std::make_shared<shmem_rx_publisher_impl>(
+        rx_stream, cpu_format, rate, name, num_packets);
+}
+
+rx_streamer::sptr shmem_rx_streamer::make(
+    const std::string& name, const std::string& cpu_format)
+{
+    region_hdr_t* region = attach_region(name);
+    if (!cpu_format.empty() && cpu_format != region->cpu_format) {
+        const std::string stream_format = region->cpu_format;
+        ::munmap(region, region->size);
+        throw uhd::value_error("Shared memory stream " + name + " has CPU format "
+                               + stream_format + ", not " + cpu_format);
+    }
+    return std::make_shared<shmem_rx_streamer_impl>(region);
+}
+
+#else
+
+shmem_rx_publisher::sptr shmem_rx_publisher::make(
+    rx_streamer::sptr, const std::string&, const double, const std::string&, const size_t)
+{
+    throw uhd::not_implemented_error("Shared memory streams are only supported on Linux");
+}
+
+rx_streamer::sptr shmem_rx_streamer::make(const std::string&, const std::string&)
+{
+    throw uhd::not_implemented_error("Shared memory streams are only supported on Linux");
+}
+
+#endif
@@ -0,0 +1,496 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/convert.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/utils/byteswap.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/scope_exit.hpp>
+#include <uhd/utils/sigmf_recorder.hpp>
+#include <uhd/version.hpp>
+#include <uhdlib/utils/rx_recorder_engine.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+using namespace uhd;
+
+sigmf_recorder::~sigmf_recorder() = default;
+
+namespace {
+
+constexpr char LOG_ID[] = "SIGMF_RECORDER";
+
+constexpr size_t DEFAULT_BLOCK_SIZE = 1024 * 1024;
+constexpr size_t DEFAULT_NUM_BLOCKS = 32;
+
+constexpr char INDEX_MAGIC[8]       = {'U', 'H', 'D', 'T', 'I', 'D', 'X', '\0'};
+constexpr uint32_t INDEX_VERSION    = 1;
+constexpr uint32_t INDEX_ENTRY_SIZE = 16;
+constexpr size_t INDEX_HEADER_SIZE  = 24;
+
+std::string get_sigmf_datatype(const std::string& cpu_format)
+{
+    if (cpu_format == "fc64") {
+        return "cf64_le";
+    } else if (cpu_format == "fc32") {
+        return "cf32_le";
+    } else if (cpu_format == "sc16") {
+        return "ci16_le";
+    } else if (cpu_format == "sc8") {
+        return "ci8";
+    }
+    throw uhd::value_error("sigmf_recorder: Unsupported CPU format: " + cpu_format);
+}
+
+std::string json_string(const std::string& str)
+{
+    std::ostringstream out;
+    out << '"';
+    for (const char c : str) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                << static_cast<int>(c) << std::dec;
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+    return out.str();
+}
+
+template <typename T>
+void write_le(std::ostream& out, const T value)
+{
+    const T le_value = uhd::htowx<T>(value);
+    out.write(reinterpret_cast<const char*>(&le_value), sizeof(le_value));
+}
+
+template <typename T>
+T read_le(std::istream& in)
+{
+    T value;
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return uhd::wtohx<T>(value);
+}
+
+void write_le(std::ostream& out, const double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    write_le<uint64_t>(out, bits);
+}
+
+double read_le_double(std::istream& in)
+{
+    const uint64_t bits = read_le<uint64_t>(in);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+class sigmf_recorder_impl : public sigmf_recorder
+{
+public:
+    sigmf_recorder_impl(rx_streamer::sptr rx_stream,
+        const std::string& cpu_format,
+        const std::vector<std::string>& paths,
+        const double rate,
+        const uhd::device_addr_t& args)
+        : _paths(paths)
+        , _datatype(get_sigmf_datatype(cpu_format))
+        , _rate(rate)
+        , _args(args)
+        , _freqs(rx_stream->get_num_channels(), std::numeric_limits<double>::quiet_NaN())
+    {
+        if (rate <= 0) {
+            throw uhd::value_error("sigmf_recorder: The sample rate must be positive");
+        }
+        rx_recorder_engine::config_t config;
+        config.layout     = rx_recorder_engine::layout_t::PER_CHANNEL;
+        config.chan_size  = args.cast<size_t>("block_size", DEFAULT_BLOCK_SIZE);
+        config.num_blocks = args.cast<size_t>("num_blocks", DEFAULT_NUM_BLOCKS);
+        config.direct_io  = args.cast<bool>("direct_io", true);
+        std::vector<std::string> data_paths;
+        for (const auto& path : paths) {
+            data_paths.push_back(path + ".sigmf-data");
+        }
+        _engine = rx_recorder_engine::make(rx_stream,
+            uhd::convert::get_bytes_per_item(cpu_format),
+            data_paths,
+            config,
+            [this](const rx_recorder_engine::block_info_t& info) { _on_block(info); });
+
+        const std::string index_path =
+            args.get("index_path", paths.front() + ".uhd-tidx");
+        _index.open(index_path, std::ios::binary | std::ios::trunc);
+        if (!_index) {
+            throw uhd::os_error("sigmf_recorder: Could not open " + index_path);
+        }
+        _index.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        write_le<uint32_t>(_index, INDEX_VERSION);
+        write_le<uint32_t>(_index, INDEX_ENTRY_SIZE);
+        write_le(_index, _rate);
+    }
+
+    ~sigmf_recorder_impl() override
+    {
+        // The engine calls back into this object until it's stopped
+        try {
+            stop();
+        } catch (const uhd::exception& ex) {
+            UHD_LOG_ERROR(LOG_ID, "Recording failed: " << ex.what());
+        }
+        _engine.reset();
+    }
+
+    void start() override
+    {
+        _engine->start();
+    }
+
+    void stop() override
+    {
+        // Keep the metadata of what was recorded, even if recording failed
+        auto write_meta = uhd::utils::scope_exit::make([this]() {
+            _index.flush();
+            if (_engine->get_num_samps_recorded() > 0 && !_meta_written) {
+                _meta_written = true;
+                _write_meta_files();
+            }
+        });
+        _engine->stop();
+        _index.flush();
+        if (!_index) {
+            throw uhd::os_error("sigmf_recorder: Could not write the time index");
+        }
+    }
+
+    bool is_running() const override
+    {
+        return _engine->is_running();
+    }
+
+    uint64_t get_num_samps_recorded() const override
+    {
+        return _engine->get_num_samps_recorded();
+    }
+
+    size_t get_num_overflows() const override
+    {
+        return _engine->get_num_overflows();
+    }
+
+    void set_frequency(const double freq, const size_t chan) override
+    {
+        _check_chan(chan);
+        std::lock_guard<std::mutex> l(_tune_mutex);
+        _pending_tunes.push_back(
+            {freq, chan, false, uhd::time_spec_t(), _engine->get_num_samps_recorded()});
+    }
+
+    void set_frequency(
+        const double freq, const uhd::time_spec_t& time, const size_t chan) override
+    {
+        _check_chan(chan);
+        std::lock_guard<std::mutex> l(_tune_mutex);
+        _pending_tunes.push_back({freq, chan, true, time, 0});
+    }
+
+private:
+    struct tune_t
+    {
+        double freq;
+        size_t chan;
+        bool timed;
+        uhd::time_spec_t time;
+        //! Sample at which untimed tunes take effect
+        uint64_t samp;
+    };
+
+    struct capture_t
+    {
+        bool has_time_spec;
+        uhd::time_spec_t time_spec;
+        std::vector<double> freqs;
+    };
+
+    using segment_t = rx_recorder_engine::segment_t;
+
+    void _check_chan(const size_t chan) const
+    {
+        if (chan >= _freqs.size()) {
+            throw uhd::index_error(
+                "sigmf_recorder: Invalid channel " + std::to_string(chan));
+        }
+    }
+
+    //! Runs on a writer thread of the engine, for every block in order
+    void _on_block(const rx_recorder_engine::block_info_t& info)
+    {
+        const uint64_t block_end = info.first_samp + info.num_samps;
+        const auto& segments     = info.segments;
+        auto get_seg_end         = [&](const size_t i) {
+            return (i + 1 < segments.size()) ? segments[i + 1].first_samp : block_end;
+        };
+
+        // Find the sample of every tune that happens within this block
+        std::multimap<uint64_t, tune_t> tunes;
+        {
+            std::lock_guard<std::mutex> l(_tune_mutex);
+            auto it = _pending_tunes.begin();
+            while (it != _pending_tunes.end()) {
+                uint64_t samp = 0;
+                if (_find_tune_samp(*it, segments, block_end, samp)) {
+                    tunes.emplace(samp, *it);
+                    it = _pending_tunes.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        // Segments and tunes in the order of their samples. At the same
+        // sample, the segment goes first, so the tune shows in its capture.
+        auto tune_it = tunes.begin();
+        for (size_t i = 0; i < segments.size(); i++) {
+            const auto& segment = segments[i];
+            if (segment.first_samp == 0 || segment.overflow || segment.start_of_burst) {
+                _add_capture(segment.first_samp, segment);
+            }
+            if (segment.overflow) {
+                _overflows.push_back(segment.first_samp);
+            }
+            if (segment.has_time_spec) {
+                _write_index_entry(segment.time_spec, segment.first_samp);
+            }
+            for (; tune_it != tunes.end() && tune_it->first < get_seg_end(i);
+                 ++tune_it) {
+                _freqs[tune_it->second.chan] = tune_it->second.freq;
+                _add_capture(tune_it->first, segment);
+            }
+        }
+    }
+
+    //! Returns true if \p tune happens within the block of \p segments
+    bool _find_tune_samp(const tune_t& tune,
+        const std::vector<segment_t>& segments,
+        const uint64_t block_end,
+        uint64_t& samp) const
+    {
+        if (!tune.timed) {
+            samp = std::max(tune.samp, segments.front().first_samp);
+            return tune.samp < block_end;
+        }
+        for (size_t i = 0; i < segments.size(); i++) {
+            const auto& segment = segments[i];
+            const uint64_t seg_end =
+                (i + 1 < segments.size()) ? segments[i + 1].first_samp : block_end;
+            if (!segment.has_time_spec || tune.time <= segment.time_spec) {
+                // Tunes without timing, or tunes during a gap, take effect when
+                // the samples continue
+                samp = segment.first_samp;
+                return true;
+            }
+            const double offset = (tune.time - segment.time_spec).get_real_secs() * _rate;
+            if (offset < static_cast<double>(seg_end - segment.first_samp)) {
+                samp = segment.first_samp + static_cast<uint64_t>(std::llround(offset));
+                samp = std::min(samp, seg_end - 1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void _add_capture(const uint64_t samp, const segment_t& segment)
+    {
+        capture_t& capture    = _captures[samp];
+        capture.has_time_spec = segment.has_time_spec;
+        capture.time_spec =
+            segment.time_spec
+            + uhd::time_spec_t::from_ticks(
+                static_cast<long long>(samp - segment.first_samp), _rate);
+        capture.freqs = _freqs;
+    }
+
+    void _write_index_entry(const uhd::time_spec_t& time, const uint64_t samp)
+    {
+        const int64_t time_ns = time.to_ticks(1e9);
+        // The index can only be searched if it's sorted
+        if (_num_index_entries > 0 && time_ns <= _last_time_ns) {
+            if (!_index_warned) {
+                _index_warned = true;
+                UHD_LOG_WARNING(LOG_ID,
+                    "Device time went backwards, not adding later times to the "
+                    "time index");
+            }
+            return;
+        }
+        write_le<uint64_t>(_index, static_cast<uint64_t>(time_ns));
+        write_le<uint64_t>(_index, samp);
+        _last_time_ns = time_ns;
+        _num_index_entries++;
+    }
+
+    void _write_meta_files() const
+    {
+        for (size_t chan = 0; chan < _paths.size(); chan++) {
+            const std::string path = _paths[chan] + ".sigmf-meta";
+            std::ofstream meta(path, std::ios::trunc);
+            _write_meta(meta, chan);
+            if (!meta) {
+                UHD_LOG_ERROR(LOG_ID, "Could not write " << path);
+            }
+        }
+    }
+
+    void _write_meta(std::ostream& out, const size_t chan) const
+    {
+        out << std::setprecision(17);
+        out << "{\n    \"global\": {\n"
+            << "        \"core:datatype\": " << json_string(_datatype) << ",\n"
+            << "        \"core:sample_rate\": " << _rate << ",\n"
+            << "        \"core:version\": \"1.0.0\",\n"
+            << "        \"core:num_channels\": 1,\n"
+            << "        \"core:recorder\": "
+            << json_string("UHD " + uhd::get_version_string()) << ",\n";
+        for (const std::string key : {"description", "author", "hw"}) {
+            if (_args.has_key(key)) {
+                out << "        \"core:" << key << "\": " << json_string(_args[key])
+                    << ",\n";
+            }
+        }
+        out << "        \"core:extensions\": [{\"name\": \"uhd\", \"version\": "
+               "\"1.0.0\", \"optional\": true}],\n"
+            << "        \"uhd:channel\": " << chan << "\n    },\n";
+
+        out << "    \"captures\": [";
+        bool first = true;
+        for (const auto& entry : _captures) {
+            const capture_t& capture = entry.second;
+            out << (first ? "\n" : ",\n") << "        {\"core:sample_start\": "
+                << entry.first;
+            if (!std::isnan(capture.freqs[chan])) {
+                out << ", \"core:frequency\": " << capture.freqs[chan];
+            }
+            if (capture.has_time_spec) {
+                out << ", \"uhd:full_secs\": " << capture.time_spec.get_full_secs()
+                    << ", \"uhd:frac_secs\": " << capture.time_spec.get_frac_secs();
+            }
+            out << "}";
+            first = false;
+        }
+        out << "\n    ],\n";
+
+        out << "    \"annotations\": [";
+        first = true;
+        for (const uint64_t samp : _overflows) {
+            out << (first ? "\n" : ",\n") << "        {\"core:sample_start\": " << samp
+                << ", \"core:label\": \"overflow\", "
+                   "\"core:comment\": \"Samples were lost before this sample\"}";
+            first = false;
+        }
+        out << "\n    ]\n}\n";
+    }
+
+    const std::vector<std::string> _paths;
+    const std::string _datatype;
+    const double _rate;
+    const uhd::device_addr_t _args;
+
+    std::mutex _tune_mutex;
+    std::vector<tune_t> _pending_tunes;
+
+    //! Only used by _on_block() (and after the engine was stopped)
+    std::vector<double> _freqs;
+    std::map<uint64_t, capture_t> _captures;
+    std::vector<uint64_t> _overflows;
+    std::ofstream _index;
+    size_t _num_index_entries = 0;
+    int64_t _last_time_ns     = 0;
+    bool _index_warned        = false;
+    bool _meta_written        = false;
+
+    rx_recorder_engine::uptr _engine;
+};
+
+} // namespace
+
+sigmf_recorder::sptr sigmf_recorder::make(rx_streamer::sptr rx_stream,
+    const std::string& cpu_format,
+    const std::vector<std::string>& paths,
+    const double rate,
+    const uhd::device_addr_t& args)
+{
+    return std::make_shared<sigmf_recorder_impl>(
+        rx_stream, cpu_format, paths, rate, args);
+}
+
+uint64_t sigmf_recorder::find_sample(
+    const std::string& index_path, const uhd::time_spec_t& time)
+{
+    std::ifstream index(index_path, std::ios::binary | std::ios::ate);
+    if (!index) {
+        throw uhd::os_error("sigmf_recorder: Could not open " + index_path);
+    }
+    const uint64_t size = static_cast<uint64_t>(index.tellg());
+    index.seekg(0);
+    char magic[sizeof(INDEX_MAGIC)];
+    index.read(magic, sizeof(magic));
+    const uint32_t version    = read_le<uint32_t>(index);
+    const uint32_t entry_size = read_le<uint32_t>(index);
+    const double rate         = read_le_double(index);
+    if (!index || std::memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0
+        || version != INDEX_VERSION || entry_size != INDEX_ENTRY_SIZE) {
+        throw uhd::os_error("sigmf_recorder: Not a time index: " + index_path);
+    }
+
+    const uint64_t num_entries = (size - INDEX_HEADER_SIZE) / INDEX_ENTRY_SIZE;
+    auto read_entry            = [&](const uint64_t i) {
+        index.seekg(INDEX_HEADER_SIZE + i * INDEX_ENTRY_SIZE);
+        const int64_t time_ns = static_cast<int64_t>(read_le<uint64_t>(index));
+        const uint64_t samp   = read_le<uint64_t>(index);
+        if (!index) {
+            throw uhd::os_error("sigmf_recorder: Could not read " + index_path);
+        }
+        return std::make_pair(time_ns, samp);
+    };
+
+    // Find the last entry at or before the time
+    const int64_t time_ns = time.to_ticks(1e9);
+    if (num_entries == 0 || read_entry(0).first > time_ns) {
+        throw uhd::value_error("sigmf_recorder: Time is before the start of the "
+                               "recording");
+    }
+    uint64_t lo = 0;
+    uint64_t hi = num_entries;
+    while (hi - lo > 1) {
+        const uint64_t mid = lo + (hi - lo) / 2;
+        if (read_entry(mid).first <= time_ns) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    const auto entry = read_entry(lo);
+    uint64_t samp    = entry.second
+                    + static_cast<uint64_t>(
+                        std::llround((time_ns - entry.first) * 1e-9 * rate));
+    // Within a gap, stop at the first sample after it
+    if (lo + 1 < num_entries) {
+        samp = std::min(samp, read_entry(lo + 1).second);
+    }
+    return samp;
+}
@@ -10,34 +10,202 @@
 #include <uhd/utils/msg_task.hpp>
 #include <uhd/utils/tasks.hpp>
 #include <uhd/utils/thread.hpp>
-#include <boost/thread/barrier.hpp>
+#include <uhdlib/utils/periodic_task.hpp>
 #include <boost/thread/thread.hpp>
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <exception>
 #include <functional>
-#include <iostream>
-#include <thread>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 using namespace uhd;
 
+namespace {
+
+using steady_clock = std::chrono::steady_clock;
+
+//! How long an idle worker waits for a new task before it exits
+constexpr auto WORKER_IDLE_TIMEOUT = std::chrono::seconds(10);
+
+//! The thread name of workers that don't run a task
+constexpr char IDLE_THREAD_NAME[] = "uhd_task_idle";
+
+//! The thread name of tasks that don't have a name
+constexpr char DEFAULT_THREAD_NAME[] = "uhd_task";
+
+/*! The threads that run tasks, shared by all devices
+ *
+ * A task loop occupies a worker until the task is destroyed, and the worker
+ * is then reused for the next task, so devices and streamers that come and go
+ * don't keep creating threads. Idle workers block until they get a job, and
+ * exit after WORKER_IDLE_TIMEOUT.
+ *
+ * The pool also has a single timer thread for periodic tasks. It sleeps until
+ * the next periodic task is due, and hands the call to a worker, so periodic
+ * tasks only take up a thread while they run.
+ */
+class task_pool
+{
+public:
+    class worker
+    {
+    public:
+        using sptr = std::shared_ptr<worker>;
+
+        //! Interrupt the job at its next boost interruption point
+        void interrupt()
+        {
+            _thread.interrupt();
+        }
+
+    private:
+        friend class task_pool;
+
+        boost::thread _thread;
+        std::condition_variable _cond;
+        std::function<void()> _job;
+    };
+
+    //! Never destroyed, as tasks may still be destroyed while statics are
+    static task_pool& get()
+    {
+        static task_pool* pool = new task_pool;
+        return *pool;
+    }
+
+    /*! Run \p job on an idle worker, or on a new one
+     *
+     * \return the worker, which runs nothing else until \p job returns
+     */
+    worker::sptr run(std::function<void()> job, const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        worker::sptr w;
+        if (_idle.empty()) {
+            w          = std::make_shared<worker>();
+            w->_job    = std::move(job);
+            w->_thread = boost::thread([this, w]() { _worker_loop(w); });
+        } else {
+            w = _idle.back();
+            _idle.pop_back();
+            w->_job = std::move(job);
+            w->_cond.notify_one();
+        }
+        set_thread_name(&w->_thread, name.empty() ? DEFAULT_THREAD_NAME : name);
+        return w;
+    }
+
+    /*! Call \p fn on the timer thread once \p time has come
+     *
+     * \p fn must return quickly, because it holds up all other timers.
+     */
+    void schedule(const steady_clock::time_point& time, std::function<void()> fn)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_timer_thread.get_id() == boost::thread::id()) {
+            _timer_thread = boost::thread([this]() { _timer_loop(); });
+            set_thread_name(&_timer_thread, "uhd_task_timer");
+        }
+        _timers.emplace(time, std::move(fn));
+        _timer_cond.notify_one();
+    }
+
+private:
+    task_pool() = default;
+
+    void _worker_loop(worker::sptr w)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            std::function<void()> job = std::move(w->_job);
+            w->_job                   = nullptr;
+            lock.unlock();
+
+            job();
+            job = nullptr;
+            // An interrupt that came too late for the job must not hit the
+            // next one
+            try {
+                boost::this_thread::interruption_point();
+            } catch (const boost::thread_interrupted&) {
+            }
+
+            lock.lock();
+            set_thread_name(&w->_thread, IDLE_THREAD_NAME);
+            _idle.push_back(w);
+            if (!w->_cond.wait_for(
+                    lock, WORKER_IDLE_TIMEOUT, [&w]() { return bool(w->_job); })) {
+                _idle.remove(w);
+                w->_thread.detach();
+                return;
+            }
+        }
+    }
+
+    void _timer_loop()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            if (_timers.empty()) {
+                _timer_cond.wait(lock);
+                continue;
+            }
+            const auto next = _timers.begin();
+            if (next->first > steady_clock::now()) {
+                _timer_cond.wait_until(lock, next->first);
+                continue;
+            }
+            std::function<void()> fn = std::move(next->second);
+            _timers.erase(next);
+            lock.unlock();
+            fn();
+            lock.lock();
+        }
+    }
+
+    std::mutex _mutex;
+    std::list<worker::sptr> _idle;
+
+    boost::thread _timer_thread;
+    std::condition_variable _timer_cond;
+    std::multimap<steady_clock::time_point, std::function<void()>> _timers;
+};
+
+void do_error_msg(const std::string& msg)
+{
+    UHD_LOGGER_ERROR("UHD") << "An unexpected exception was caught in a task loop."
+                            << "The task loop will now exit, things may not work."
+                            << msg;
+}
+
+} // namespace
+
 class task_impl : public task
 {
 public:
     task_impl(const task_fcn_type& task_fcn, const std::string& name) : _exit(false)
     {
-        _task = std::thread([this, task_fcn]() { this->task_loop(task_fcn); });
-        if (not name.empty()) {
-            set_thread_name(&_task, name);
-        }
+        auto done = std::make_shared<std::promise<void>>();
+        _done     = done->get_future();
+        task_pool::get().run(
+            [this, task_fcn, done]() {
+                this->task_loop(task_fcn);
+                done->set_value();
+            },
+            name);
     }
 
     ~task_impl(void)
     {
         _exit = true;
-        if (_task.joinable()) {
-            _task.join();
-        }
+        _done.wait();
     }
 
 private:
@@ -54,15 +222,8 @@ private:
         }
     }
 
-    void do_error_msg(const std::string& msg)
-    {
-        UHD_LOGGER_ERROR("UHD")
-            << "An unexpected exception was caught in a task loop."
-            << "The task loop will now exit, things may not work." << msg;
-    }
-
     std::atomic<bool> _exit;
-    std::thread _task;
+    std::future<void> _done;
 };
 
 task::sptr task::make(const task_fcn_type& task_fcn, const std::string& name)
@@ -70,6 +231,90 @@ task::sptr task::make(const task_fcn_type& task_fcn, const std::string& name)
     return task::sptr(new task_impl(task_fcn, name));
 }
 
+class periodic_task_impl : public task
+{
+public:
+    periodic_task_impl(const task_fcn_type& task_fcn,
+        const std::chrono::milliseconds period,
+        const std::string& name)
+        : _state(std::make_shared<state_t>())
+    {
+        _state->task_fcn = task_fcn;
+        _state->period   = period;
+        _state->name     = name;
+        _state->next     = steady_clock::now();
+        _schedule(_state);
+    }
+
+    ~periodic_task_impl(void)
+    {
+        // A pending timer finds the task stopped, and does nothing
+        std::unique_lock<std::mutex> lock(_state->mutex);
+        _state->stopped = true;
+        _state->cond.wait(lock, [this]() { return !_state->running; });
+    }
+
+private:
+    //! Shared with the timer and the worker, which may outlive the task
+    struct state_t
+    {
+        task_fcn_type task_fcn;
+        std::chrono::milliseconds period;
+        std::string name;
+        steady_clock::time_point next;
+
+        std::mutex mutex;
+        std::condition_variable cond;
+        bool running = false;
+        bool stopped = false;
+    };
+
+    static void _schedule(std::shared_ptr<state_t> state)
+    {
+        task_pool::get().schedule(state->next, [state]() {
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (state->stopped) {
+                    return;
+                }
+                state->running = true;
+            }
+            task_pool::get().run([state]() { _call(state); }, state->name);
+        });
+    }
+
+    static void _call(std::shared_ptr<state_t> state)
+    {
+        bool failed = true;
+        try {
+            state->task_fcn();
+            failed = false;
+        } catch (const std::exception& e) {
+            do_error_msg(e.what());
+        } catch (...) {
+            do_error_msg("Unknown exception");
+        }
+
+        const auto now = steady_clock::now();
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->running = false;
+        if (!failed && !state->stopped) {
+            state->next = std::max(state->next + state->period, now);
+            _schedule(state);
+        }
+        state->cond.notify_all();
+    }
+
+    std::shared_ptr<state_t> _state;
+};
+
+task::sptr uhd::make_periodic_task(const task::task_fcn_type& task_fcn,
+    const std::chrono::milliseconds period,
+    const std::string& name)
+{
+    return task::sptr(new periodic_task_impl(task_fcn, period, name));
+}
+
 msg_task::~msg_task(void)
 {
     /* NOP */
@@ -84,18 +329,33 @@ msg_task::~msg_task(void)
 class msg_task_impl : public msg_task
 {
 public:
-    msg_task_impl(const task_fcn_type& task_fcn) : _spawn_barrier(2)
+    msg_task_impl(const task_fcn_type& task_fcn) : _running(true)
     {
-        (void)_thread_group.create_thread(
-            std::bind(&msg_task_impl::task_loop, this, task_fcn));
-        _spawn_barrier.wait();
+        auto done = std::make_shared<std::promise<void>>();
+        _done     = done->get_future();
+        _worker   = task_pool::get().run(
+            [this, task_fcn, done]() {
+                this->task_loop(task_fcn);
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _loop_done = true;
+                }
+                done->set_value();
+            },
+            "");
     }
 
     ~msg_task_impl(void)
     {
-        _running = false;
-        _thread_group.interrupt_all();
-        _thread_group.join_all();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _running = false;
+            // Only interrupt the worker while it still runs this task
+            if (!_loop_done) {
+                _worker->interrupt();
+            }
+        }
+        _done.wait();
     }
 
     /*
@@ -106,7 +366,7 @@ public:
      */
     msg_payload_t get_msg_from_dump_queue(uint32_t sid)
     {
-        boost::mutex::scoped_lock lock(_mutex);
+        std::lock_guard<std::mutex> lock(_mutex);
         msg_payload_t b;
         for (size_t i = 0; i < _dump_queue.size(); i++) {
             if (sid == _dump_queue[i].first) {
@@ -121,9 +381,6 @@ public:
 private:
     void task_loop(const task_fcn_type& task_fcn)
     {
-        _running = true;
-        _spawn_barrier.wait();
-
         try {
             while (_running) {
                 boost::optional<msg_type_t> buff = task_fcn();
@@ -133,7 +390,7 @@ private:
                      * pushed to the dump_queue. This way ctrl_cores can check dump_queue
                      * for missing messages.
                      */
-                    boost::mutex::scoped_lock lock(_mutex);
+                    std::lock_guard<std::mutex> lock(_mutex);
                     _dump_queue.push_back(buff.get());
                 }
             }
@@ -148,17 +405,11 @@ private:
         }
     }
 
-    void do_error_msg(const std::string& msg)
-    {
-        UHD_LOGGER_ERROR("UHD")
-            << "An unexpected exception was caught in a task loop."
-            << "The task loop will now exit, things may not work." << msg;
-    }
-
-    boost::mutex _mutex;
-    boost::thread_group _thread_group;
-    boost::barrier _spawn_barrier;
-    bool _running;
+    std::mutex _mutex;
+    std::atomic<bool> _running;
+    bool _loop_done = false;
+    task_pool::worker::sptr _worker;
+    std::future<void> _done;
 
     /*
      * This queue holds stranded messages until a radio_ctrl_core grabs them via
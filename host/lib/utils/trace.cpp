@@ -0,0 +1,246 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/static.hpp>
+#include <uhdlib/utils/trace.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace uhd::trace;
+
+std::atomic<bool> uhd::trace::detail::trace_enabled{false};
+
+namespace {
+
+//! Name of the environment variable that enables tracing
+constexpr char TRACE_FILE_ENV[] = "UHD_TRACE_FILE";
+
+struct event_info_t
+{
+    const char* name;
+    //! Chrome trace event phase: "i" (instant), "B" (begin) or "E" (end)
+    const char* phase;
+    //! Names of the arguments, nullptr if unused
+    const char* arg_names[2];
+};
+
+// Must match the order of event_t
+const std::array<event_info_t, static_cast<size_t>(event_t::NUM_EVENTS)> EVENT_INFO{{
+    {"rx_packet", "i", {"seq", "bytes"}},
+    {"rx_timeout", "i", {"timeout_ms", nullptr}},
+    {"rx_overrun", "i", {nullptr, nullptr}},
+    {"tx_packet", "i", {"seq", "bytes"}},
+    {"fc_credit_sent", "i", {"bytes", "packets"}},
+    {"fc_credit_received", "i", {"bytes", "packets"}},
+    {"convert", "B", {"nsamps", nullptr}},
+    {"convert", "E", {nullptr, nullptr}},
+    {"async_msg", "i", {"event_code", nullptr}},
+    {"io_srv_recv", "i", {"bytes", nullptr}},
+    {"io_srv_drop", "i", {nullptr, nullptr}},
+    {"offload_push", "i", {"frames_in_use", nullptr}},
+}};
+
+struct trace_record_t
+{
+    uint64_t timestamp_ns;
+    uint64_t args[2];
+    event_t event;
+};
+
+/*! Ring of the most recent events of one thread
+ *
+ * Only the owning thread writes to the ring, records are never consumed.
+ */
+class trace_ring
+{
+public:
+    //! Number of records per ring, must be a power of two
+    static constexpr size_t CAPACITY = 16384;
+
+    trace_ring(const size_t tid) : tid(tid) {}
+
+    void push(const trace_record_t& record)
+    {
+        const uint64_t head             = _head.load(std::memory_order_relaxed);
+        _records[head & (CAPACITY - 1)] = record;
+        _head.store(head + 1, std::memory_order_release);
+    }
+
+    /*! Copy the records from oldest to newest
+     *
+     * Records may be overwritten by the owning thread while they're copied.
+     * Those are dropped by checking how far the ring has moved on afterwards.
+     */
+    std::vector<trace_record_t> snapshot() const
+    {
+        const uint64_t head  = _head.load(std::memory_order_acquire);
+        const uint64_t begin = (head > CAPACITY) ? head - CAPACITY : 0;
+        std::vector<trace_record_t> records;
+        records.reserve(head - begin);
+        for (uint64_t i = begin; i < head; i++) {
+            records.push_back(_records[i & (CAPACITY - 1)]);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t new_head = _head.load(std::memory_order_relaxed);
+        if (new_head - begin > CAPACITY) {
+            const size_t num_stale =
+                std::min<uint64_t>(new_head - begin - CAPACITY, records.size());
+            records.erase(records.begin(), records.begin() + num_stale);
+        }
+        return records;
+    }
+
+    void clear()
+    {
+        _head.store(0, std::memory_order_release);
+    }
+
+    //! Thread ID in the trace
+    const size_t tid;
+
+private:
+    std::array<trace_record_t, CAPACITY> _records;
+    std::atomic<uint64_t> _head{0};
+};
+
+class trace_recorder
+{
+public:
+    trace_recorder()
+    {
+        const char* trace_file = std::getenv(TRACE_FILE_ENV);
+        if (trace_file && trace_file[0] != '\0') {
+            _trace_file = trace_file;
+            detail::trace_enabled.store(true);
+        }
+    }
+
+    ~trace_recorder()
+    {
+        if (_trace_file.empty()) {
+            return;
+        }
+        detail::trace_enabled.store(false);
+        // Never throw from a destructor, there's no one left to tell
+        try {
+            dump(_trace_file);
+        } catch (...) {
+        }
+    }
+
+    std::shared_ptr<trace_ring> make_ring()
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        // Rings outlive their threads, so the events of threads that have
+        // exited are still in the trace
+        _rings.push_back(std::make_shared<trace_ring>(_rings.size()));
+        return _rings.back();
+    }
+
+    std::vector<std::shared_ptr<trace_ring>> get_rings()
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _rings;
+    }
+
+private:
+    std::string _trace_file;
+    std::mutex _mutex;
+    std::vector<std::shared_ptr<trace_ring>> _rings;
+};
+
+trace_recorder& get_recorder()
+{
+    static trace_recorder recorder;
+    return recorder;
+}
+
+// Read the environment on startup, tracing must not wait for the first
+// event to be recorded (which it never would be)
+UHD_STATIC_BLOCK(init_trace_recorder)
+{
+    get_recorder();
+}
+
+void write_event(std::ostream& out, const size_t tid, const trace_record_t& record)
+{
+    const auto& info = EVENT_INFO.at(static_cast<size_t>(record.event));
+    out << ",\n{\"name\":\"" << info.name << "\",\"cat\":\"uhd\",\"ph\":\""
+        << info.phase << "\"";
+    if (info.phase[0] == 'i') {
+        out << ",\"s\":\"t\"";
+    }
+    out << ",\"pid\":0,\"tid\":" << tid << ",\"ts\":" << (record.timestamp_ns / 1000)
+        << "." << std::setw(3) << std::setfill('0') << (record.timestamp_ns % 1000);
+    if (info.arg_names[0]) {
+        out << ",\"args\":{\"" << info.arg_names[0] << "\":" << record.args[0];
+        if (info.arg_names[1]) {
+            out << ",\"" << info.arg_names[1] << "\":" << record.args[1];
+        }
+        out << "}";
+    }
+    out << "}";
+}
+
+} // namespace
+
+void uhd::trace::set_enabled(const bool enable)
+{
+    detail::trace_enabled.store(enable);
+}
+
+void uhd::trace::record(const event_t event, const uint64_t arg0, const uint64_t arg1)
+{
+    thread_local const std::shared_ptr<trace_ring> ring = get_recorder().make_ring();
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    ring->push({static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()),
+        {arg0, arg1},
+        event});
+}
+
+void uhd::trace::dump(std::ostream& out)
+{
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+        << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,"
+        << "\"args\":{\"name\":\"UHD\"}}";
+    for (const auto& ring : get_recorder().get_rings()) {
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":"
+            << ring->tid << ",\"args\":{\"name\":\"thread " << ring->tid << "\"}}";
+        for (const auto& record : ring->snapshot()) {
+            write_event(out, ring->tid, record);
+        }
+    }
+    out << "\n]}\n";
+}
+
+void uhd::trace::dump(const std::string& path)
+{
+    std::ofstream out(path);
+    if (!out) {
+        throw uhd::os_error("Could not open trace file for writing: " + path);
+    }
+    dump(out);
+    out.flush();
+    if (!out) {
+        throw uhd::os_error("Could not write trace file: " + path);
+    }
+}
+
+void uhd::trace::clear()
+{
+    for (const auto& ring : get_recorder().get_rings()) {
+        ring->clear();
+    }
+}
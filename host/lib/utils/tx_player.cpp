@@ -0,0 +1,391 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/thread.hpp>
+#include <uhd/utils/tx_player.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+using namespace uhd;
+
+tx_player::~tx_player() = default;
+
+namespace {
+
+constexpr char LOG_ID[] = "TX_PLAYER";
+
+constexpr size_t DEFAULT_NUM_BLOCKS = 64;
+
+//! Timeout of every send() call, bounds the time stop() takes
+constexpr double SEND_TIMEOUT = 0.1;
+
+/***********************************************************************
+ * Sample conversion
+ **********************************************************************/
+//! Converts \p nsamps samples from \p in to \p out
+using convert_fn_t = void (*)(const void* in, void* out, const size_t nsamps);
+
+//! Value of a full scale sample
+template <typename T>
+constexpr double full_scale()
+{
+    return std::is_floating_point<T>::value ? 1.0 : std::numeric_limits<T>::max();
+}
+
+template <typename in_t, typename out_t>
+void convert_samps(const void* in, void* out, const size_t nsamps)
+{
+    using calc_t = typename std::conditional<std::is_same<in_t, double>::value
+                                                 || std::is_same<out_t, double>::value,
+        double,
+        float>::type;
+    const calc_t scale = static_cast<calc_t>(full_scale<out_t>() / full_scale<in_t>());
+    const calc_t limit = static_cast<calc_t>(full_scale<out_t>());
+    const bool clip    = !std::is_floating_point<out_t>::value;
+    const in_t* in_buf = static_cast<const in_t*>(in);
+    out_t* out_buf     = static_cast<out_t*>(out);
+    // Every sample is an I and a Q item
+    for (size_t i = 0; i < 2 * nsamps; i++) {
+        calc_t value = static_cast<calc_t>(in_buf[i]) * scale;
+        if (clip) {
+            value = std::round(std::max(-limit, std::min(limit, value)));
+        }
+        out_buf[i] = static_cast<out_t>(value);
+    }
+}
+
+template <typename T>
+void copy_samps(const void* in, void* out, const size_t nsamps)
+{
+    std::memcpy(out, in, nsamps * 2 * sizeof(T));
+}
+
+template <typename in_t>
+convert_fn_t get_converter(const std::string& out_format)
+{
+    if (out_format == "fc64") {
+        return std::is_same<in_t, double>::value ? &copy_samps<double>
+                                                 : &convert_samps<in_t, double>;
+    } else if (out_format == "fc32") {
+        return std::is_same<in_t, float>::value ? &copy_samps<float>
+                                                : &convert_samps<in_t, float>;
+    } else if (out_format == "sc16") {
+        return std::is_same<in_t, int16_t>::value ? &copy_samps<int16_t>
+                                                  : &convert_samps<in_t, int16_t>;
+    } else if (out_format == "sc8") {
+        return std::is_same<in_t, int8_t>::value ? &copy_samps<int8_t>
+                                                 : &convert_samps<in_t, int8_t>;
+    }
+    throw uhd::value_error("tx_player: Unsupported format: " + out_format);
+}
+
+convert_fn_t get_converter(const std::string& in_format, const std::string& out_format)
+{
+    if (in_format == "fc64") {
+        return get_converter<double>(out_format);
+    } else if (in_format == "fc32") {
+        return get_converter<float>(out_format);
+    } else if (in_format == "sc16") {
+        return get_converter<int16_t>(out_format);
+    } else if (in_format == "sc8") {
+        return get_converter<int8_t>(out_format);
+    }
+    throw uhd::value_error("tx_player: Unsupported format: " + in_format);
+}
+
+//! Bytes per sample, for the formats that get_converter() knows
+size_t get_samp_size(const std::string& format)
+{
+    if (format == "fc64") {
+        return 16;
+    } else if (format == "fc32") {
+        return 8;
+    } else if (format == "sc16") {
+        return 4;
+    }
+    return 2;
+}
+
+/***********************************************************************
+ * Player
+ **********************************************************************/
+struct block_t
+{
+    std::vector<char> data;
+    size_t num_samps = 0;
+    //! True if this is the last block of the burst
+    bool last = false;
+};
+
+class tx_player_impl : public tx_player
+{
+public:
+    tx_player_impl(tx_streamer::sptr tx_stream,
+        const std::string& cpu_format,
+        const std::vector<std::string>& paths,
+        const uhd::device_addr_t& args)
+        : _tx_stream(tx_stream)
+        , _num_channels(tx_stream->get_num_channels())
+        , _convert(get_converter(args.get("file_format", cpu_format), cpu_format))
+        , _file_samp_size(get_samp_size(args.get("file_format", cpu_format)))
+        , _cpu_samp_size(get_samp_size(cpu_format))
+        , _block_samps(args.cast<size_t>("block_size", tx_stream->get_max_num_samps()))
+        , _loop(args.cast<bool>("loop", false))
+    {
+        const size_t num_blocks = args.cast<size_t>("num_blocks", DEFAULT_NUM_BLOCKS);
+        if (paths.size() != _num_channels) {
+            throw uhd::value_error("tx_player: Need one file per channel, got "
+                                   + std::to_string(paths.size()) + " files for "
+                                   + std::to_string(_num_channels) + " channels");
+        }
+        if (_block_samps == 0 || num_blocks == 0) {
+            throw uhd::value_error(
+                "tx_player: Block size and number of blocks must be non-zero");
+        }
+
+        namespace bip = boost::interprocess;
+        _num_file_samps = std::numeric_limits<uint64_t>::max();
+        for (const auto& path : paths) {
+            try {
+                const bip::file_mapping mapping(path.c_str(), bip::read_only);
+                _regions.emplace_back(new bip::mapped_region(mapping, bip::read_only));
+            } catch (const bip::interprocess_exception& ex) {
+                throw uhd::os_error(
+                    "tx_player: Could not map file " + path + ": " + ex.what());
+            }
+            // The pages are read once, in order (unless looping)
+            _regions.back()->advise(bip::mapped_region::advice_sequential);
+            _num_file_samps = std::min<uint64_t>(
+                _num_file_samps, _regions.back()->get_size() / _file_samp_size);
+        }
+        if (_num_file_samps == 0) {
+            throw uhd::value_error("tx_player: The files hold no samples");
+        }
+
+        _blocks.resize(num_blocks);
+        for (auto& block : _blocks) {
+            block.data.resize(_num_channels * _block_samps * _cpu_samp_size);
+            _free_blocks.push_back(&block);
+        }
+    }
+
+    ~tx_player_impl() override
+    {
+        stop();
+    }
+
+    void start() override
+    {
+        _start(false, uhd::time_spec_t());
+    }
+
+    void start(const uhd::time_spec_t& time) override
+    {
+        _start(true, time);
+    }
+
+    void stop() override
+    {
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            _stop = true;
+            _cond.notify_all();
+        }
+        if (_worker_thread.joinable()) {
+            _worker_thread.join();
+        }
+        if (_tx_thread.joinable()) {
+            _tx_thread.join();
+        }
+    }
+
+    bool wait_done(const double timeout) override
+    {
+        std::unique_lock<std::mutex> l(_mutex);
+        return _cond.wait_for(l,
+            std::chrono::microseconds(static_cast<int64_t>(timeout * 1e6)),
+            [this]() { return _done; });
+    }
+
+    uint64_t get_num_samps_sent() const override
+    {
+        return _num_samps_sent;
+    }
+
+    size_t get_num_stalls() const override
+    {
+        return _num_stalls;
+    }
+
+private:
+    void _start(const bool has_time_spec, const uhd::time_spec_t& time)
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        if (_started) {
+            throw uhd::runtime_error("tx_player: Can only be started once");
+        }
+        _started       = true;
+        _worker_thread = std::thread([this]() { _worker_loop(); });
+        uhd::set_thread_name(&_worker_thread, "tx_play_conv");
+        _tx_thread = std::thread([this, has_time_spec, time]() {
+            _tx_loop(has_time_spec, time);
+        });
+        uhd::set_thread_name(&_tx_thread, "tx_play_send");
+    }
+
+    //! Runs on the worker thread, reads and converts the samples
+    void _worker_loop()
+    {
+        uint64_t pos = 0;
+        while (true) {
+            block_t* block = nullptr;
+            {
+                std::unique_lock<std::mutex> l(_mutex);
+                _cond.wait(l, [this]() { return !_free_blocks.empty() || _stop; });
+                if (_stop) {
+                    break;
+                }
+                block = _free_blocks.front();
+                _free_blocks.pop_front();
+            }
+
+            block->num_samps = static_cast<size_t>(
+                std::min<uint64_t>(_block_samps, _num_file_samps - pos));
+            for (size_t chan = 0; chan < _num_channels; chan++) {
+                _convert(static_cast<const char*>(_regions[chan]->get_address())
+                             + pos * _file_samp_size,
+                    block->data.data() + chan * _block_samps * _cpu_samp_size,
+                    block->num_samps);
+            }
+            pos += block->num_samps;
+            block->last = false;
+            if (pos == _num_file_samps) {
+                pos         = 0;
+                block->last = !_loop;
+            }
+
+            std::lock_guard<std::mutex> l(_mutex);
+            _ready_blocks.push_back(block);
+            _cond.notify_all();
+            if (block->last) {
+                break;
+            }
+        }
+    }
+
+    //! Runs on the streaming thread, sends the converted blocks
+    void _tx_loop(const bool has_time_spec, const uhd::time_spec_t& time)
+    {
+        uhd::tx_metadata_t md;
+        md.start_of_burst = true;
+        md.has_time_spec  = has_time_spec;
+        md.time_spec      = time;
+        std::vector<const void*> buffs(_num_channels);
+        bool burst_ended = false;
+        while (!burst_ended) {
+            block_t* block = nullptr;
+            {
+                std::unique_lock<std::mutex> l(_mutex);
+                if (_ready_blocks.empty() && !_stop && !md.start_of_burst) {
+                    _num_stalls++;
+                }
+                _cond.wait(l, [this]() { return !_ready_blocks.empty() || _stop; });
+                if (_stop) {
+                    break;
+                }
+                block = _ready_blocks.front();
+                _ready_blocks.pop_front();
+            }
+
+            md.end_of_burst = block->last;
+            size_t num_sent = 0;
+            while (num_sent < block->num_samps && !_stop) {
+                for (size_t chan = 0; chan < _num_channels; chan++) {
+                    buffs[chan] = block->data.data()
+                                  + (chan * _block_samps + num_sent) * _cpu_samp_size;
+                }
+                // A timeout only means that the device isn't taking samples
+                // yet (e.g., before a timed start), keep trying
+                const size_t result = _tx_stream->send(
+                    buffs, block->num_samps - num_sent, md, SEND_TIMEOUT);
+                num_sent += result;
+                _num_samps_sent += result;
+                if (result > 0) {
+                    md.start_of_burst = false;
+                    md.has_time_spec  = false;
+                }
+            }
+            burst_ended = block->last && num_sent == block->num_samps;
+
+            std::lock_guard<std::mutex> l(_mutex);
+            _free_blocks.push_back(block);
+            _cond.notify_all();
+        }
+
+        if (!burst_ended && !md.start_of_burst) {
+            md.end_of_burst = true;
+            _tx_stream->send(buffs, 0, md, SEND_TIMEOUT);
+        }
+        UHD_LOG_DEBUG(LOG_ID,
+            "Sent " << _num_samps_sent.load() << " samples per channel, stalled "
+                    << _num_stalls.load() << " times");
+
+        std::lock_guard<std::mutex> l(_mutex);
+        _done = true;
+        _cond.notify_all();
+    }
+
+    const tx_streamer::sptr _tx_stream;
+    const size_t _num_channels;
+    const convert_fn_t _convert;
+    const size_t _file_samp_size;
+    const size_t _cpu_samp_size;
+    const size_t _block_samps;
+    const bool _loop;
+
+    std::vector<std::unique_ptr<boost::interprocess::mapped_region>> _regions;
+    uint64_t _num_file_samps;
+
+    //! Protects everything below, up to the counters
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    std::vector<block_t> _blocks;
+    std::deque<block_t*> _free_blocks;
+    std::deque<block_t*> _ready_blocks;
+    bool _started = false;
+    bool _done    = false;
+
+    std::atomic<bool> _stop{false};
+    std::atomic<uint64_t> _num_samps_sent{0};
+    std::atomic<size_t> _num_stalls{0};
+
+    std::thread _worker_thread;
+    std::thread _tx_thread;
+};
+
+} // namespace
+
+tx_player::sptr tx_player::make(tx_streamer::sptr tx_stream,
+    const std::string& cpu_format,
+    const std::vector<std::string>& paths,
+    const uhd::device_addr_t& args)
+{
+    return std::make_shared<tx_player_impl>(tx_stream, cpu_format, paths, args);
+}
@@ -7,7 +7,9 @@
 #pragma once
 
 #include <uhd/utils/chdr/chdr_packet.hpp>
+#include <uhd/utils/chdr/chdr_stream.hpp>
 #include <uhd/utils/pybind_adaptors.hpp>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
@@ -366,4 +368,123 @@ void export_utils(py::module& m)
         .value("INIT", chdr_rfnoc::STRC_INIT)
         .value("PING", chdr_rfnoc::STRC_PING)
         .value("RESYNC", chdr_rfnoc::STRC_RESYNC);
+
+    PYBIND11_NUMPY_DTYPE(chdr_packet_info_t,
+        offset,
+        payload_offset,
+        timestamp,
+        payload_size,
+        length,
+        seq_num,
+        dst_epid,
+        vc,
+        pkt_type,
+        num_mdata,
+        eob,
+        eov,
+        has_timestamp);
+
+    m.def(
+        "parse_packets",
+        [](uhd::rfnoc::chdr_w_t chdr_w, py::buffer buffer, uhd::endianness_t endianness) {
+            const py::buffer_info info = buffer.request();
+            if (info.ndim != 1 || info.strides[0] != info.itemsize) {
+                throw uhd::value_error("The packets must be in a contiguous 1-D buffer");
+            }
+            const size_t size = info.size * info.itemsize;
+            std::vector<chdr_packet_info_t>* packets;
+            {
+                py::gil_scoped_release release;
+                packets = new std::vector<chdr_packet_info_t>(
+                    parse_packets(chdr_w, info.ptr, size, endianness));
+            }
+            // The array takes ownership of the vector, so the fields aren't copied
+            py::capsule owner(packets, [](void* ptr) {
+                delete static_cast<std::vector<chdr_packet_info_t>*>(ptr);
+            });
+            return py::array_t<chdr_packet_info_t>(
+                packets->size(), packets->data(), owner);
+        },
+        py::arg("chdr_w"),
+        py::arg("buffer"),
+        py::arg("endianness") = uhd::ENDIANNESS_LITTLE);
+
+    py::class_<chdr_stream_counts_t>(m, "ChdrStreamCounts")
+        .def(py::init<>())
+        .def(py::init([](uint64_t bytes, uint64_t packets) {
+            chdr_stream_counts_t counts;
+            counts.bytes   = bytes;
+            counts.packets = packets;
+            return counts;
+        }),
+            py::arg("bytes"),
+            py::arg("packets"))
+        .def_readwrite("bytes", &chdr_stream_counts_t::bytes)
+        .def_readwrite("packets", &chdr_stream_counts_t::packets);
+
+    py::class_<chdr_stream_engine, chdr_stream_engine::sptr>(m, "ChdrStreamEngine")
+        .def(py::init(&chdr_stream_engine::make),
+            py::arg("chdr_w"),
+            py::arg("endianness"),
+            py::arg("addr"),
+            py::arg("port"),
+            py::arg("frame_size") = 8000)
+        .def(
+            "recv",
+            [](chdr_stream_engine& self, double timeout) -> py::object {
+                boost::optional<chdr_datagram_t> datagram;
+                {
+                    py::gil_scoped_release release;
+                    datagram = self.recv(timeout);
+                }
+                if (!datagram) {
+                    return py::none();
+                }
+                return py::make_tuple(
+                    py::bytes(reinterpret_cast<const char*>(datagram->data.data()),
+                        datagram->data.size()),
+                    py::make_tuple(datagram->addr, datagram->port));
+            },
+            py::arg("timeout"))
+        .def(
+            "send",
+            [](chdr_stream_engine& self,
+                py::bytes data,
+                const std::string& addr,
+                uint16_t port) {
+                const std::string buff(data);
+                self.send(buff.data(), buff.size(), addr, port);
+            },
+            py::arg("data"),
+            py::arg("addr"),
+            py::arg("port"))
+        .def("add_source",
+            &chdr_stream_engine::add_source,
+            py::arg("src_epid"),
+            py::arg("dst_epid"),
+            py::arg("addr"),
+            py::arg("port"),
+            py::arg("fc_freq"))
+        .def("start_source",
+            &chdr_stream_engine::start_source,
+            py::arg("src_epid"),
+            py::arg("spp"),
+            py::arg("bytes_per_sample"),
+            py::arg("num_samples"),
+            py::arg("rate"),
+            py::arg("timestamp") = 0)
+        .def("stop_source", &chdr_stream_engine::stop_source, py::arg("src_epid"))
+        .def("remove_source", &chdr_stream_engine::remove_source, py::arg("src_epid"))
+        .def("add_sink",
+            &chdr_stream_engine::add_sink,
+            py::arg("epid"),
+            py::arg("capacity"))
+        .def("remove_sink", &chdr_stream_engine::remove_sink, py::arg("epid"))
+        .def("get_source_counts",
+            &chdr_stream_engine::get_source_counts,
+            py::arg("src_epid"))
+        .def("get_sink_counts", &chdr_stream_engine::get_sink_counts, py::arg("epid"))
+        .def("get_sink_seq_errors",
+            &chdr_stream_engine::get_sink_seq_errors,
+            py::arg("epid"));
 }
@@ -0,0 +1,428 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/math.hpp>
+#include <uhd/utils/waveform_generator.hpp>
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace uhd;
+
+waveform_generator::~waveform_generator() = default;
+
+namespace {
+
+//! Number of independent lanes of the oscillators, a multiple of the SIMD width
+constexpr size_t LANES = 8;
+
+//! Samples per block, after which the oscillators are realigned
+constexpr size_t BLOCK_SIZE = 256;
+
+constexpr double DEFAULT_AMPL         = 0.3;
+constexpr double DEFAULT_CHIRP_PERIOD = 1e-3;
+
+const double TWO_PI = 2.0 * uhd::math::PI;
+
+double to_dbfs(const double power)
+{
+    return 10.0 * std::log10(power);
+}
+
+/***********************************************************************
+ * Oscillators
+ **********************************************************************/
+/*! Complex oscillator whose frequency changes linearly over time
+ *
+ * The phase is phase0 + omega * n + chirp_rate * n^2 / 2 at sample n. Each
+ * lane computes every LANES-th sample, so the lanes don't depend on each
+ * other and the loop vectorizes. At the start of each block, the lanes are
+ * set from the phase and its derivatives, which are kept in double precision.
+ */
+class oscillator
+{
+public:
+    void set(const double omega, const double chirp_rate, const double phase)
+    {
+        _omega      = omega;
+        _chirp_rate = chirp_rate;
+        _phase      = phase;
+    }
+
+    //! Returns the phase of the next sample
+    double get_phase() const
+    {
+        return _phase;
+    }
+
+    /*! Adds (or writes) ampl * exp(j * phase) for \p nsamps samples
+     *
+     * \param out Interleaved I and Q of the output samples
+     * \param nsamps Number of samples, at most BLOCK_SIZE
+     * \param ampl Amplitude
+     * \param add true to add to \p out, false to overwrite it
+     */
+    void run(float* out, const size_t nsamps, const float ampl, const bool add)
+    {
+        float osc_i[LANES], osc_q[LANES], rot_i[LANES], rot_q[LANES];
+        for (size_t l = 0; l < LANES; l++) {
+            const double phase = _phase_at(double(l));
+            osc_i[l]           = ampl * float(std::cos(phase));
+            osc_q[l]           = ampl * float(std::sin(phase));
+            const double step  = _phase_at(double(l + LANES)) - phase;
+            rot_i[l]           = float(std::cos(step));
+            rot_q[l]           = float(std::sin(step));
+        }
+        // The rotation of every lane advances by the same angle each time
+        const double drot_phase = _chirp_rate * double(LANES * LANES);
+        const float drot_i      = float(std::cos(drot_phase));
+        const float drot_q      = float(std::sin(drot_phase));
+
+        size_t n = 0;
+        for (; n + LANES <= nsamps; n += LANES) {
+            float* samps = out + 2 * n;
+            for (size_t l = 0; l < LANES; l++) {
+                samps[2 * l]     = (add ? samps[2 * l] : 0.0f) + osc_i[l];
+                samps[2 * l + 1] = (add ? samps[2 * l + 1] : 0.0f) + osc_q[l];
+                const float i    = osc_i[l] * rot_i[l] - osc_q[l] * rot_q[l];
+                const float q    = osc_i[l] * rot_q[l] + osc_q[l] * rot_i[l];
+                osc_i[l]         = i;
+                osc_q[l]         = q;
+                const float ri   = rot_i[l] * drot_i - rot_q[l] * drot_q;
+                const float rq   = rot_i[l] * drot_q + rot_q[l] * drot_i;
+                rot_i[l]         = ri;
+                rot_q[l]         = rq;
+            }
+        }
+        for (size_t l = 0; n + l < nsamps; l++) {
+            float* samp = out + 2 * (n + l);
+            samp[0]     = (add ? samp[0] : 0.0f) + osc_i[l];
+            samp[1]     = (add ? samp[1] : 0.0f) + osc_q[l];
+        }
+
+        _phase = std::fmod(_phase_at(double(nsamps)), TWO_PI);
+        _omega += _chirp_rate * double(nsamps);
+    }
+
+private:
+    double _phase_at(const double n) const
+    {
+        return _phase + _omega * n + 0.5 * _chirp_rate * n * n;
+    }
+
+    double _omega      = 0.0;
+    double _chirp_rate = 0.0;
+    double _phase      = 0.0;
+};
+
+/***********************************************************************
+ * Generators
+ **********************************************************************/
+class waveform_generator_impl : public waveform_generator
+{
+public:
+    waveform_generator_impl(const double ampl) : _ampl(float(ampl)) {}
+
+    void generate(std::complex<float>* buff, const size_t nsamps)
+    {
+        float* out = reinterpret_cast<float*>(buff);
+        for (size_t n = 0; n < nsamps; n += BLOCK_SIZE) {
+            fill(out + 2 * n, std::min(BLOCK_SIZE, nsamps - n));
+        }
+    }
+
+    void generate(std::complex<int16_t>* buff, const size_t nsamps)
+    {
+        // Each block is synthesized into a buffer that stays in cache
+        _scratch.resize(2 * BLOCK_SIZE);
+        int16_t* out = reinterpret_cast<int16_t*>(buff);
+        for (size_t n = 0; n < nsamps; n += BLOCK_SIZE) {
+            const size_t block = std::min(BLOCK_SIZE, nsamps - n);
+            fill(_scratch.data(), block);
+            for (size_t i = 0; i < 2 * block; i++) {
+                const float value = std::min(
+                    std::max(_scratch[i] * 32767.0f, -32768.0f), 32767.0f);
+                out[2 * n + i] = int16_t(std::lrint(value));
+            }
+        }
+    }
+
+protected:
+    //! Writes \p nsamps samples, at most BLOCK_SIZE, as interleaved I and Q
+    virtual void fill(float* out, const size_t nsamps) = 0;
+
+    const float _ampl;
+
+private:
+    std::vector<float> _scratch;
+};
+
+//! CONST, SQUARE and RAMP, which only modulate I
+class periodic_generator : public waveform_generator_impl
+{
+public:
+    enum class shape_t { CONST, SQUARE, RAMP };
+
+    periodic_generator(const shape_t shape, const double ampl, const double cycles)
+        : waveform_generator_impl(ampl)
+        , _shape(shape)
+        , _step(uint32_t(int64_t(std::llround(cycles * 4294967296.0))))
+    {
+    }
+
+    void reset()
+    {
+        _phase = 0;
+    }
+
+    double get_power() const
+    {
+        const double power = double(_ampl) * double(_ampl);
+        switch (_shape) {
+            case shape_t::SQUARE:
+                return to_dbfs(power / 2.0);
+            case shape_t::RAMP:
+                return to_dbfs(power / 3.0);
+            default:
+                return to_dbfs(power);
+        }
+    }
+
+protected:
+    void fill(float* out, const size_t nsamps)
+    {
+        // The phase is a fraction of a period, and wraps around at 2^32
+        constexpr float SCALE = 2.0f / 4294967296.0f;
+        for (size_t n = 0; n < nsamps; n++) {
+            const uint32_t phase = _phase + uint32_t(n) * _step;
+            float i;
+            switch (_shape) {
+                case shape_t::SQUARE:
+                    i = (phase >= 0x80000000) ? _ampl : 0.0f;
+                    break;
+                case shape_t::RAMP:
+                    i = (float(phase) * SCALE - 1.0f) * _ampl;
+                    break;
+                default:
+                    i = _ampl;
+                    break;
+            }
+            out[2 * n]     = i;
+            out[2 * n + 1] = 0.0f;
+        }
+        _phase += uint32_t(nsamps) * _step;
+    }
+
+private:
+    const shape_t _shape;
+    const uint32_t _step;
+    uint32_t _phase = 0;
+};
+
+//! SINE, CHIRP and MULTITONE
+class tone_generator : public waveform_generator_impl
+{
+public:
+    struct tone_t
+    {
+        double omega;
+        double phase;
+    };
+
+    /*! Constructor
+     *
+     * \param ampl Peak amplitude of the sum of the tones
+     * \param tones Frequencies in radians per sample, and initial phases
+     * \param chirp_rate Change of the frequency per sample
+     * \param sweep_len Samples after which the chirp restarts, or 0
+     */
+    tone_generator(const double ampl,
+        const std::vector<tone_t>& tones,
+        const double chirp_rate = 0.0,
+        const size_t sweep_len  = 0)
+        : waveform_generator_impl(ampl / double(tones.size()))
+        , _tones(tones)
+        , _oscs(tones.size())
+        , _chirp_rate(chirp_rate)
+        , _sweep_len(sweep_len)
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        for (size_t k = 0; k < _tones.size(); k++) {
+            _oscs[k].set(_tones[k].omega, _chirp_rate, _tones[k].phase);
+        }
+        _sweep_pos = 0;
+    }
+
+    double get_power() const
+    {
+        return to_dbfs(double(_tones.size()) * double(_ampl) * double(_ampl));
+    }
+
+protected:
+    void fill(float* out, const size_t nsamps)
+    {
+        for (size_t n = 0; n < nsamps;) {
+            size_t block = nsamps - n;
+            if (_sweep_len) {
+                block = std::min(block, _sweep_len - _sweep_pos);
+            }
+            for (size_t k = 0; k < _oscs.size(); k++) {
+                _oscs[k].run(out + 2 * n, block, _ampl, k > 0);
+            }
+            n += block;
+            if (_sweep_len && (_sweep_pos += block) == _sweep_len) {
+                // Restart the sweep, with a continuous phase
+                _sweep_pos = 0;
+                for (size_t k = 0; k < _oscs.size(); k++) {
+                    _oscs[k].set(_tones[k].omega, _chirp_rate, _oscs[k].get_phase());
+                }
+            }
+        }
+    }
+
+private:
+
+    const std::vector<tone_t> _tones;
+    std::vector<oscillator> _oscs;
+    const double _chirp_rate;
+    const size_t _sweep_len;
+    size_t _sweep_pos = 0;
+};
+
+//! NOISE, from one xorshift generator per lane
+class noise_generator : public waveform_generator_impl
+{
+public:
+    noise_generator(const double ampl, const uint32_t seed)
+        : waveform_generator_impl(ampl), _seed(seed)
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        // Spread the seed over the lanes, none of which may start at zero
+        uint64_t state = _seed;
+        for (size_t l = 0; l < 2 * LANES; l++) {
+            state += 0x9E3779B97F4A7C15ull;
+            uint64_t z = state;
+            z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z          = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            _state[l]  = uint32_t(z ^ (z >> 31)) | 1;
+        }
+    }
+
+    double get_power() const
+    {
+        return to_dbfs(2.0 * double(_ampl) * double(_ampl) / 3.0);
+    }
+
+protected:
+    void fill(float* out, const size_t nsamps)
+    {
+        const float scale = _ampl / 2147483648.0f;
+        // Each lane produces one I or Q value of a group of LANES samples
+        for (size_t n = 0; n < 2 * nsamps; n += 2 * LANES) {
+            uint32_t values[2 * LANES];
+            for (size_t l = 0; l < 2 * LANES; l++) {
+                uint32_t x = _state[l];
+                x ^= x << 13;
+                x ^= x >> 17;
+                x ^= x << 5;
+                _state[l] = x;
+                values[l] = x;
+            }
+            const size_t num = std::min(2 * LANES, 2 * nsamps - n);
+            for (size_t l = 0; l < num; l++) {
+                out[n + l] = float(int32_t(values[l])) * scale;
+            }
+        }
+    }
+
+private:
+    const uint32_t _seed;
+    uint32_t _state[2 * LANES];
+};
+
+//! Returns a frequency as a fraction of the sample rate
+double get_cycles(const double freq, const double samp_rate)
+{
+    if (std::abs(freq) > samp_rate / 2) {
+        throw uhd::value_error("Waveform frequency " + std::to_string(freq)
+                               + " Hz is outside of the Nyquist zone");
+    }
+    return freq / samp_rate;
+}
+
+} // namespace
+
+waveform_generator::sptr waveform_generator::make(
+    const std::string& wave_type, const double samp_rate, const device_addr_t& args)
+{
+    if (samp_rate <= 0.0) {
+        throw uhd::value_error("Waveform sample rate must be positive");
+    }
+    const double ampl = args.cast<double>("ampl", DEFAULT_AMPL);
+    const double freq = args.cast<double>("freq", 0.0);
+
+    if (wave_type == "CONST") {
+        return std::make_shared<periodic_generator>(
+            periodic_generator::shape_t::CONST, ampl, 0.0);
+    }
+    if (wave_type == "SQUARE" || wave_type == "RAMP") {
+        const auto shape = (wave_type == "SQUARE") ? periodic_generator::shape_t::SQUARE
+                                                   : periodic_generator::shape_t::RAMP;
+        return std::make_shared<periodic_generator>(
+            shape, ampl, get_cycles(freq, samp_rate));
+    }
+    if (wave_type == "SINE") {
+        return std::make_shared<tone_generator>(ampl,
+            std::vector<tone_generator::tone_t>{
+                {TWO_PI * get_cycles(freq, samp_rate), 0.0}});
+    }
+    if (wave_type == "CHIRP") {
+        const double start  = args.cast<double>("start_freq", -freq);
+        const double stop   = args.cast<double>("stop_freq", freq);
+        const double period = args.cast<double>("period", DEFAULT_CHIRP_PERIOD);
+        const size_t sweep_len = size_t(std::llround(period * samp_rate));
+        if (sweep_len < 1) {
+            throw uhd::value_error("Chirp period must be at least one sample");
+        }
+        const double start_omega = TWO_PI * get_cycles(start, samp_rate);
+        const double stop_omega  = TWO_PI * get_cycles(stop, samp_rate);
+        return std::make_shared<tone_generator>(ampl,
+            std::vector<tone_generator::tone_t>{{start_omega, 0.0}},
+            (stop_omega - start_omega) / double(sweep_len),
+            sweep_len);
+    }
+    if (wave_type == "MULTITONE") {
+        std::vector<std::string> freqs;
+        const std::string freqs_arg = args.get("freqs", "");
+        boost::split(freqs, freqs_arg, boost::is_any_of(":"), boost::token_compress_on);
+        freqs.erase(std::remove(freqs.begin(), freqs.end(), ""), freqs.end());
+        if (freqs.empty()) {
+            throw uhd::value_error("MULTITONE requires at least one tone in freqs");
+        }
+        // Newman phases keep the peaks of the sum low
+        std::vector<tone_generator::tone_t> tones;
+        for (size_t k = 0; k < freqs.size(); k++) {
+            const double omega = TWO_PI * get_cycles(std::stod(freqs[k]), samp_rate);
+            tones.push_back(
+                {omega, uhd::math::PI * double(k * k) / double(freqs.size())});
+        }
+        return std::make_shared<tone_generator>(ampl, tones);
+    }
+    if (wave_type == "NOISE") {
+        return std::make_shared<noise_generator>(ampl, args.cast<uint32_t>("seed", 0));
+    }
+    throw uhd::value_error("Unknown waveform type: " + wave_type);
+}
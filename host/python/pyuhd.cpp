@@ -15,6 +15,7 @@ namespace py = pybind11;
 
 #include "cal/cal_python.hpp"
 #include "rfnoc/ddc_block_control_python.hpp"
+#include "rfnoc/dmafifo_block_control_python.hpp"
 #include "rfnoc/duc_block_control_python.hpp"
 #include "rfnoc/fft_block_control_python.hpp"
 #include "rfnoc/fir_filter_block_control_python.hpp"
@@ -41,6 +42,7 @@ namespace py = pybind11;
 #include "usrp/fe_connection_python.hpp"
 #include "usrp/multi_usrp_python.hpp"
 #include "usrp/subdev_spec_python.hpp"
+#include "utils/async_python.hpp"
 #include "utils/paths_python.hpp"
 #include "utils/utils_python.hpp"
 
@@ -73,6 +75,7 @@ PYBIND11_MODULE(libpyuhd, m)
     export_metadata(types_module);
     export_sensors(types_module);
     export_tune(types_module);
+    export_futures(types_module);
 
     // Register usrp submodule
     auto usrp_module = m.def_submodule("usrp", "USRP Objects");
@@ -90,6 +93,7 @@ PYBIND11_MODULE(libpyuhd, m)
     auto rfnoc_module = m.def_submodule("rfnoc", "RFNoC Objects");
     export_rfnoc(rfnoc_module);
     export_ddc_block_control(rfnoc_module);
+    export_dmafifo_block_control(rfnoc_module);
     export_duc_block_control(rfnoc_module);
     export_fft_block_control(rfnoc_module);
     export_fosphor_block_control(rfnoc_module);
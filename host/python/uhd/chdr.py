@@ -24,6 +24,11 @@ StrsPayload = lib.chdr.StrsPayload
 StrsStatus = lib.chdr.StrsStatus
 StrcPayload = lib.chdr.StrcPayload
 StrcOpCode = lib.chdr.StrcOpCode
+# Parses a buffer of concatenated packets into a NumPy structured array
+parse_packets = lib.chdr.parse_packets
+# Streams CHDR data over UDP, for emulated devices
+ChdrStreamEngine = lib.chdr.ChdrStreamEngine
+ChdrStreamCounts = lib.chdr.ChdrStreamCounts
 
 def __get_payload(self):
     pkt_type = self.get_header().pkt_type
@@ -12,6 +12,7 @@ from . import libpyuhd as lib
 BlockID = lib.rfnoc.block_id
 Edge = lib.rfnoc.edge
 GraphEdge = lib.rfnoc.graph_edge
+BlockStatus = lib.rfnoc.block_status
 Source = lib.rfnoc.source
 ResSourceInfo = lib.rfnoc.res_source_info
 RfnocGraph = lib.rfnoc.rfnoc_graph
@@ -19,6 +20,7 @@ MBController = lib.rfnoc.mb_controller
 Timekeeper = lib.rfnoc.timekeeper
 NocBlock = lib.rfnoc.noc_block_base
 DdcBlockControl = lib.rfnoc.ddc_block_control
+DmaFifoBlockControl = lib.rfnoc.dmafifo_block_control
 DucBlockControl = lib.rfnoc.duc_block_control
 FftBlockControl = lib.rfnoc.fft_block_control
 FosphorBlockControl = lib.rfnoc.fosphor_block_control
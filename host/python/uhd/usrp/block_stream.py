@@ -0,0 +1,44 @@
+#
+# Copyright 2020 Ettus Research, a National Instruments Brand
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+""" @package usrp
+asyncio interface for receiving blocks of samples from an RXBlockRing
+"""
+
+import asyncio
+
+
+class AsyncBlockIterator:
+    """
+    Asynchronously iterate over the blocks received by an RXBlockRing.
+
+    The blocks are taken from the ring in the default executor of the event
+    loop, so other coroutines keep running while the next block is received.
+    Iteration stops once the ring was stopped and all its blocks were read.
+
+    Example:
+    >>> ring = uhd.usrp.RXBlockRing(streamer, block_size=8192)
+    >>> ring.start()
+    >>> async for block in uhd.usrp.AsyncBlockIterator(ring):
+    ...     samples = numpy.asarray(block)
+    """
+    def __init__(self, ring, timeout=0.1):
+        self._ring = ring
+        self._timeout = timeout
+
+    def __aiter__(self):
+        return self
+
+    async def __anext__(self):
+        loop = asyncio.get_event_loop()
+        while True:
+            # If the ring was stopped before get_block(), no block can follow
+            running = self._ring.is_running()
+            block = await loop.run_in_executor(
+                None, self._ring.get_block, self._timeout)
+            if block is not None:
+                return block
+            if not running:
+                raise StopAsyncIteration
@@ -26,4 +26,9 @@ FEConnection = lib.usrp.fe_connection
 StreamArgs = lib.usrp.stream_args
 RXStreamer = lib.usrp.rx_streamer
 TXStreamer = lib.usrp.tx_streamer
+RXBlock = lib.usrp.rx_block
+RXBlockRing = lib.usrp.rx_block_ring
+RXRecorder = lib.usrp.rx_recorder
+SigMFRecorder = lib.usrp.sigmf_recorder
+TXPlayer = lib.usrp.tx_player
 # pylint: enable=invalid-name
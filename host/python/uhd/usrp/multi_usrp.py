@@ -49,22 +49,20 @@ class MultiUSRP(lib.usrp.multi_usrp):
         stream_cmd.stream_now = True
         streamer.issue_stream_cmd(stream_cmd)
 
-        samps = np.array([], dtype=np.complex64)
+        # The receive loop runs in C++, straight into the result array
         while recv_samps < num_samps:
-            samps = streamer.recv(recv_buffer, metadata)
+            recv_samps += streamer.recv_num_samps(
+                result, metadata, offset=recv_samps)
 
             if metadata.error_code != lib.types.rx_metadata_error_code.none:
                 print(metadata.strerror())
-            if samps:
-                real_samps = min(num_samps - recv_samps, samps)
-                result[:, recv_samps:recv_samps + real_samps] = recv_buffer[:, 0:real_samps]
-                recv_samps += real_samps
 
         stream_cmd = lib.types.stream_cmd(lib.types.stream_mode.stop_cont)
         streamer.issue_stream_cmd(stream_cmd)
 
-        while samps:
-            samps = streamer.recv(recv_buffer, metadata)
+        # Drain the samples that were received after the capture
+        while streamer.recv(recv_buffer, metadata):
+            pass
 
         # Help the garbage collection
         streamer = None
@@ -116,9 +114,10 @@ class MultiUSRP(lib.usrp.multi_usrp):
         while send_samps < max_samps:
             real_samps = min(proto_len, max_samps-send_samps)
             if real_samps < proto_len:
-                samples = streamer.send(waveform_proto[:, :real_samps], metadata)
+                samples = streamer.send_num_samps(
+                    waveform_proto[:, :real_samps], metadata)
             else:
-                samples = streamer.send(waveform_proto, metadata)
+                samples = streamer.send_num_samps(waveform_proto, metadata)
             send_samps += samples
 
         # Help the garbage collection
@@ -0,0 +1,197 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/mock_rx_streamer.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/utils/async_streamer.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+void fill_ab(const uhd::rx_streamer::buffs_type& buffs, const size_t, const size_t nsamps)
+{
+    std::fill_n(static_cast<uint8_t*>(buffs[0]), nsamps, uint8_t(0xAB));
+}
+
+//! Returns one queued packet of u8 per recv(), the test plays the I/O thread
+std::shared_ptr<uhd::mock_rx_streamer> make_rx_streamer()
+{
+    uhd::mock_rx_streamer::stream_params params;
+    params.max_num_samps = 100;
+    params.fill          = fill_ab;
+    return std::make_shared<uhd::mock_rx_streamer>(params);
+}
+
+//! Sends as many samples as there are credits, and records the calls
+class mock_tx_streamer : public uhd::tx_streamer
+{
+public:
+    struct call_t
+    {
+        const void* buff;
+        size_t nsamps;
+        bool start_of_burst;
+        bool end_of_burst;
+    };
+
+    size_t get_num_channels() const override
+    {
+        return 1;
+    }
+
+    size_t get_max_num_samps() const override
+    {
+        return 100;
+    }
+
+    size_t send(const buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        const uhd::tx_metadata_t& metadata,
+        const double) override
+    {
+        const size_t nsamps = std::min(nsamps_per_buff, credits);
+        credits -= nsamps;
+        if (nsamps) {
+            calls.push_back(call_t{
+                buffs[0], nsamps, metadata.start_of_burst, metadata.end_of_burst});
+        }
+        return nsamps;
+    }
+
+    bool recv_async_msg(uhd::async_metadata_t&, double) override
+    {
+        return false;
+    }
+
+    void set_send_ready_callback(send_ready_callback_t callback) override
+    {
+        _callback = callback;
+    }
+
+    void add_credits(const size_t num)
+    {
+        credits += num;
+        if (_callback) {
+            _callback();
+        }
+    }
+
+    size_t credits = 0;
+    std::vector<call_t> calls;
+
+private:
+    send_ready_callback_t _callback;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_async_recv)
+{
+    auto rx       = make_rx_streamer();
+    auto async_rx = uhd::async_rx_streamer::make(rx);
+    BOOST_CHECK(rx->has_callback());
+
+    std::vector<uint8_t> buff(50);
+    uhd::rx_metadata_t md;
+    std::vector<size_t> results;
+    auto handler = [&results](const size_t num_samps) { results.push_back(num_samps); };
+
+    // Data that is already there completes right away
+    rx->push(20);
+    async_rx->async_recv(buff.data(), buff.size(), md, handler);
+    BOOST_REQUIRE_EQUAL(results.size(), 1);
+    BOOST_CHECK_EQUAL(results[0], 20);
+    BOOST_CHECK_EQUAL(buff[0], 0xAB);
+
+    // Otherwise, the next packet completes it
+    async_rx->async_recv(buff.data(), buff.size(), md, handler);
+    BOOST_CHECK_THROW(
+        async_rx->async_recv(buff.data(), buff.size(), md, handler), uhd::runtime_error);
+    BOOST_CHECK_EQUAL(results.size(), 1);
+    rx->push(30);
+    BOOST_REQUIRE_EQUAL(results.size(), 2);
+    BOOST_CHECK_EQUAL(results[1], 30);
+    BOOST_CHECK_EQUAL(md.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+
+    // A packet without a pending receive waits for the next one
+    rx->push(10);
+    BOOST_CHECK_EQUAL(results.size(), 2);
+
+    BOOST_CHECK(!async_rx->cancel());
+    rx->recv(buff.data(), buff.size(), md, 0.0, false);
+    async_rx->async_recv(buff.data(), buff.size(), md, handler);
+    BOOST_CHECK(async_rx->cancel());
+    BOOST_REQUIRE_EQUAL(results.size(), 3);
+    BOOST_CHECK_EQUAL(results[2], 0);
+    BOOST_CHECK_EQUAL(md.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+
+    async_rx.reset();
+    BOOST_CHECK(!rx->has_callback());
+}
+
+BOOST_AUTO_TEST_CASE(test_async_recv_post)
+{
+    auto rx = make_rx_streamer();
+    std::vector<std::function<void()>> posted;
+    auto async_rx = uhd::async_rx_streamer::make(
+        rx, [&posted](std::function<void()> fn) { posted.push_back(fn); });
+
+    std::vector<uint8_t> buff(50);
+    uhd::rx_metadata_t md;
+    size_t result = 0;
+    async_rx->async_recv(
+        buff.data(), buff.size(), md, [&result](const size_t n) { result = n; });
+    rx->push(40);
+    // The handler only runs on the executor
+    BOOST_REQUIRE_EQUAL(posted.size(), 1);
+    BOOST_CHECK_EQUAL(result, 0);
+    posted[0]();
+    BOOST_CHECK_EQUAL(result, 40);
+}
+
+BOOST_AUTO_TEST_CASE(test_async_send)
+{
+    auto tx       = std::make_shared<mock_tx_streamer>();
+    auto async_tx = uhd::async_tx_streamer::make(tx, "sc16");
+
+    std::vector<uint32_t> buff(100);
+    uhd::tx_metadata_t md;
+    md.start_of_burst = true;
+    md.end_of_burst   = true;
+    std::vector<size_t> results;
+    auto handler = [&results](const size_t num_samps) { results.push_back(num_samps); };
+
+    BOOST_CHECK_THROW(async_tx->async_send(buff.data(), 0, md, handler), uhd::value_error);
+
+    // The samples go out as the credits come in, continuing the burst
+    tx->credits = 30;
+    async_tx->async_send(buff.data(), buff.size(), md, handler);
+    BOOST_CHECK(results.empty());
+    tx->add_credits(50);
+    BOOST_CHECK(results.empty());
+    tx->add_credits(50);
+    BOOST_REQUIRE_EQUAL(results.size(), 1);
+    BOOST_CHECK_EQUAL(results[0], 100);
+    BOOST_REQUIRE_EQUAL(tx->calls.size(), 3);
+    BOOST_CHECK(tx->calls[0].buff == buff.data());
+    BOOST_CHECK(tx->calls[0].start_of_burst);
+    BOOST_CHECK(tx->calls[1].buff == buff.data() + 30);
+    BOOST_CHECK(!tx->calls[1].start_of_burst);
+    BOOST_CHECK(tx->calls[2].buff == buff.data() + 80);
+    BOOST_CHECK_EQUAL(tx->calls[2].nsamps, 20);
+    BOOST_CHECK(tx->calls[2].end_of_burst);
+
+    // Cancelling reports what was sent so far
+    tx->credits = 10;
+    async_tx->async_send(buff.data(), buff.size(), md, handler);
+    BOOST_CHECK(async_tx->cancel());
+    BOOST_REQUIRE_EQUAL(results.size(), 2);
+    BOOST_CHECK_EQUAL(results[1], 10);
+    BOOST_CHECK(!async_tx->cancel());
+}
@@ -0,0 +1,57 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhdlib/transport/buffer_pool_alloc.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+
+using namespace uhd::transport;
+
+BOOST_AUTO_TEST_CASE(test_parse_buff_alloc_args)
+{
+    BOOST_CHECK_EQUAL(parse_buff_hugepages("none"), 0);
+    BOOST_CHECK_EQUAL(parse_buff_hugepages("0"), 0);
+    BOOST_CHECK_EQUAL(parse_buff_hugepages("2M"), 2 << 20);
+    BOOST_CHECK_EQUAL(parse_buff_hugepages("2mb"), 2 << 20);
+    BOOST_CHECK_EQUAL(parse_buff_hugepages("1G"), 1 << 30);
+    BOOST_CHECK_THROW(parse_buff_hugepages("4k"), uhd::value_error);
+
+    BOOST_CHECK_EQUAL(parse_buff_numa_node("none"), BUFF_NUMA_NODE_NONE);
+    BOOST_CHECK_EQUAL(parse_buff_numa_node("Auto"), BUFF_NUMA_NODE_AUTO);
+    BOOST_CHECK_EQUAL(parse_buff_numa_node("1"), 1);
+    BOOST_CHECK_THROW(parse_buff_numa_node("-1"), uhd::value_error);
+    BOOST_CHECK_THROW(parse_buff_numa_node("first"), uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_make_buffer_pool)
+{
+    const size_t num_buffs = 32;
+    const size_t buff_size = 1000;
+
+    // Hugepages or NUMA binding may not be available on the machine running
+    // the test, in which case the pool falls back to regular memory.
+    buff_alloc_params_t regular, numa, hugepages;
+    numa.numa_node          = 0;
+    hugepages.hugepage_size = parse_buff_hugepages("2M");
+
+    for (const auto& params : {regular, numa, hugepages}) {
+        buffer_pool::sptr pool = make_buffer_pool(num_buffs, buff_size, params);
+        BOOST_REQUIRE_EQUAL(pool->size(), num_buffs);
+
+        const size_t alignment = params.numa_node == BUFF_NUMA_NODE_NONE
+                                         and params.hugepage_size == 0
+                                     ? 16
+                                     : 64;
+        for (size_t i = 0; i < num_buffs; i++) {
+            BOOST_CHECK_EQUAL(size_t(pool->at(i)) % alignment, 0);
+            if (i > 0) {
+                BOOST_CHECK_GE(size_t(pool->at(i)) - size_t(pool->at(i - 1)), buff_size);
+            }
+            std::memset(pool->at(i), 0xab, buff_size);
+        }
+    }
+}
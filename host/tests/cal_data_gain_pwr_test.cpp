@@ -117,6 +117,83 @@ BOOST_AUTO_TEST_CASE(test_pwr_cal_api_irreg)
 
 }
 
+BOOST_AUTO_TEST_CASE(test_pwr_cal_lookup_grid)
+{
+    auto gain_power_data    = pwr_cal::make("Mock Gain/Power Data", "ABC1234", 0);
+    constexpr int ROOM_TEMP = 20;
+    gain_power_data->set_temperature(ROOM_TEMP);
+
+    // Power goes down 10 dB per GHz, the gain steps are 1 dB apart
+    for (int freq_idx = 0; freq_idx <= 4; freq_idx++) {
+        const double freq = 1e9 + freq_idx * 0.5e9;
+        std::map<double, double> gain_power;
+        for (double gain = 0.0; gain <= 10.0; gain += 1.0) {
+            gain_power[gain] = gain - 20.0 - 5.0 * freq_idx;
+        }
+        gain_power_data->add_power_table(gain_power,
+            gain_power.cbegin()->second,
+            gain_power.crbegin()->second,
+            freq,
+            ROOM_TEMP);
+    }
+    // Some other temperature, with the power 3 dB lower
+    gain_power_data->add_power_table(
+        {{0.0, -23.0}, {10.0, -13.0}}, -23.0, -13.0, 1e9, 40);
+
+    // Record the regular look-ups, including some out of bounds
+    const std::vector<double> freqs{0.5e9, 1e9, 1.3e9, 1.75e9, 3e9, 4e9};
+    const std::vector<double> gains{-1.0, 0.0, 2.5, 7.0, 10.0, 12.0};
+    std::vector<double> exp_powers;
+    for (const double freq : freqs) {
+        for (const double gain : gains) {
+            exp_powers.push_back(gain_power_data->get_power(gain, freq));
+        }
+    }
+    const std::vector<std::pair<double, double>> freq_powers{
+        {1e9, -18.0}, {1e9, -14.0}, {2e9, -27.0}, {2e9, -22.0}, {3e9, -38.0}};
+    std::vector<double> exp_gains;
+    for (const auto& freq_power : freq_powers) {
+        exp_gains.push_back(
+            gain_power_data->get_gain(freq_power.second, freq_power.first));
+    }
+    const double exp_power_40c = gain_power_data->get_power(5.0, 1e9, 38);
+
+    // The grid holds the data points and the data is linear in between, so the
+    // power look-ups must match
+    gain_power_data->set_lookup_grid(5, 11);
+    size_t idx = 0;
+    for (const double freq : freqs) {
+        for (const double gain : gains) {
+            BOOST_CHECK_CLOSE(
+                gain_power_data->get_power(gain, freq), exp_powers[idx++], 1e-6);
+        }
+    }
+    BOOST_CHECK_CLOSE(gain_power_data->get_power(5.0, 1e9, 38), exp_power_40c, 1e-6);
+    BOOST_CHECK_CLOSE(gain_power_data->get_power(5.0, 1e9, 38), -18.0, 1e-6);
+
+    // The power axis spans all frequencies, 3 dB per grid point. Gain look-ups
+    // match on calibrated frequencies, as long as the bounding grid points are
+    // within the power limits.
+    for (size_t i = 0; i < freq_powers.size(); i++) {
+        BOOST_CHECK_CLOSE(
+            gain_power_data->get_gain(freq_powers[i].second, freq_powers[i].first),
+            exp_gains[i],
+            1e-6);
+    }
+    // Between frequencies, gains are interpolated linearly
+    BOOST_CHECK_CLOSE(gain_power_data->get_gain(-19.0, 1.25e9), 3.5, 1e-6);
+
+    // Invalid grids
+    BOOST_CHECK_THROW(gain_power_data->set_lookup_grid(1, 11), uhd::value_error);
+    BOOST_CHECK_THROW(gain_power_data->set_lookup_grid(5, 0), uhd::value_error);
+
+    // New data removes the grids
+    gain_power_data->set_lookup_grid(2, 2);
+    gain_power_data->add_power_table(
+        {{0.0, -30.0}, {10.0, -20.0}}, -30.0, -20.0, 1e9, ROOM_TEMP);
+    BOOST_CHECK_EQUAL(gain_power_data->get_power(5.0, 1e9), -25.0);
+}
+
 BOOST_AUTO_TEST_CASE(test_pwr_cal_serdes)
 {
     const std::string name   = "Mock Gain/Power Data";
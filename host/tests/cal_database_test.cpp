@@ -31,6 +31,14 @@ BOOST_AUTO_TEST_CASE(test_rc)
     // are hashed with the same git commit, and thus we also test the integrity
     // of test.cal.
     BOOST_CHECK_EQUAL(test_str, "rc::cal::test_data");
+
+    const auto test_view = database::map_cal_data("test", "", source::RC);
+    BOOST_CHECK_EQUAL_COLLECTIONS(test_data.cbegin(),
+        test_data.cend(),
+        test_view->data(),
+        test_view->data() + test_view->size());
+    BOOST_REQUIRE_THROW(
+        database::map_cal_data("does_not_exist", "", source::RC), uhd::key_error);
 }
 
 BOOST_AUTO_TEST_CASE(test_fs)
@@ -83,6 +91,29 @@ BOOST_AUTO_TEST_CASE(test_fs)
     BOOST_CHECK(database::has_cal_data("mock_data", "abcd"));
     BOOST_CHECK(fs::exists(tmp_cal_path / "mock_data_abcd.cal.BACKUP"));
 
+    // Mapping the same data twice shares the view
+    auto mock_view = database::map_cal_data("mock_data", "abcd");
+    BOOST_CHECK_EQUAL_COLLECTIONS(mock_data2.begin(),
+        mock_data2.end(),
+        mock_view->data(),
+        mock_view->data() + mock_view->size());
+    BOOST_CHECK(database::map_cal_data("mock_data", "abcd") == mock_view);
+    BOOST_CHECK(database::map_cal_data("mock_data", "1234") != mock_view);
+    // Overwriting the data leaves the existing view intact, but new look-ups
+    // see the new data
+    database::write_cal_data("mock_data", "abcd", mock_data, "BACKUP2");
+    BOOST_CHECK_EQUAL_COLLECTIONS(mock_data2.begin(),
+        mock_data2.end(),
+        mock_view->data(),
+        mock_view->data() + mock_view->size());
+    auto new_view = database::map_cal_data("mock_data", "abcd");
+    BOOST_CHECK_EQUAL_COLLECTIONS(mock_data.begin(),
+        mock_data.end(),
+        new_view->data(),
+        new_view->data() + new_view->size());
+    mock_view.reset();
+    new_view.reset();
+
     fs::remove_all(tmp_cal_path, ec);
     if (ec) {
         std::cout << "WARNING: Could not remove temp cal path." << std::endl;
@@ -121,4 +152,9 @@ BOOST_AUTO_TEST_CASE(test_flash)
         cal_data2.cend());
     BOOST_REQUIRE_THROW(database::read_cal_data("MOCK_KEY", "FOO_SERIAL", source::FLASH),
         uhd::runtime_error);
+    auto cal_view = database::map_cal_data("MOCK_KEY", "MOCK_SERIAL", source::FLASH);
+    BOOST_CHECK_EQUAL_COLLECTIONS(mock_cal_data.cbegin(),
+        mock_cal_data.cend(),
+        cal_view->data(),
+        cal_view->data() + cal_view->size());
 }
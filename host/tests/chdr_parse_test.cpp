@@ -162,3 +162,42 @@ BOOST_AUTO_TEST_CASE(serialize_deserialize_eq_test)
         serialize_deserialize_eq(packets[i], packet_data[i], i);
     }
 }
+
+BOOST_AUTO_TEST_CASE(parse_packets_test)
+{
+    for (size_t i = 0; i < 4; i++) {
+        BOOST_TEST_CHECKPOINT("Conversation #" << i);
+        std::vector<uint8_t> buffer;
+        for (size_t j = 0; j < lengths[i]; j++) {
+            uint8_t* bytes;
+            size_t length;
+            std::tie(bytes, length) = conversations[i][j];
+            buffer.insert(buffer.end(), bytes, bytes + length);
+        }
+
+        const auto infos = chdr_util::parse_packets(CHDR_W, buffer.data(), buffer.size());
+        BOOST_REQUIRE_EQUAL(infos.size(), lengths[i]);
+        size_t offset = 0;
+        for (size_t j = 0; j < lengths[i]; j++) {
+            uint8_t* bytes;
+            size_t length;
+            std::tie(bytes, length) = conversations[i][j];
+            const auto packet =
+                chdr_util::chdr_packet::deserialize(CHDR_W, bytes, bytes + length);
+            const auto& info = infos[j];
+            BOOST_CHECK_EQUAL(info.offset, offset);
+            BOOST_CHECK_EQUAL(info.length, length);
+            BOOST_CHECK_EQUAL(info.seq_num, packet.get_header().get_seq_num());
+            BOOST_CHECK_EQUAL(bool(info.has_timestamp), bool(packet.get_timestamp()));
+            BOOST_CHECK_EQUAL(info.payload_size, packet.get_payload_bytes().size());
+            BOOST_CHECK(std::equal(packet.get_payload_bytes().begin(),
+                packet.get_payload_bytes().end(),
+                buffer.begin() + info.payload_offset));
+            offset += length;
+        }
+
+        BOOST_CHECK_THROW(
+            chdr_util::parse_packets(CHDR_W, buffer.data(), buffer.size() - 1),
+            uhd::value_error);
+    }
+}
@@ -0,0 +1,182 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/rfnoc/chdr_types.hpp>
+#include <uhd/utils/chdr/chdr_packet.hpp>
+#include <uhd/utils/chdr/chdr_stream.hpp>
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+namespace chdr_util  = uhd::utils::chdr;
+namespace chdr_rfnoc = uhd::rfnoc::chdr;
+
+namespace {
+
+constexpr uhd::rfnoc::chdr_w_t CHDR_W = uhd::rfnoc::CHDR_W_64;
+constexpr uint16_t SRC_EPID           = 2;
+constexpr uint16_t DST_EPID           = 5;
+constexpr size_t SPP                  = 100;
+constexpr size_t BPS                  = 4;
+//! Header and timestamp, and the payload
+constexpr size_t PKT_SIZE  = 16 + SPP * BPS;
+constexpr size_t BUFF_SIZE = 8000;
+
+chdr_util::chdr_packet parse(std::vector<uint8_t>& buff, const size_t len)
+{
+    BOOST_REQUIRE(len > 0);
+    return chdr_util::chdr_packet::deserialize(
+        CHDR_W, buff.begin(), buff.begin() + len, uhd::ENDIANNESS_LITTLE);
+}
+
+//! Connects a source and a sink, with a buffer of capacity between them
+struct stream_fixture
+{
+    stream_fixture(const chdr_util::chdr_stream_counts_t& capacity,
+        const chdr_util::chdr_stream_counts_t& fc_freq)
+        : source(chdr_util::chdr_stream_source::make(
+              CHDR_W, uhd::ENDIANNESS_LITTLE, SRC_EPID, DST_EPID, fc_freq))
+        , sink(chdr_util::chdr_stream_sink::make(
+              CHDR_W, uhd::ENDIANNESS_LITTLE, DST_EPID, capacity))
+        , buff(BUFF_SIZE)
+        , resp(BUFF_SIZE)
+    {
+        const size_t len = source->write_strc_init(buff.data(), buff.size());
+        const auto strc  = parse(buff, len);
+        BOOST_CHECK_EQUAL(strc.get_header().get_pkt_type(), chdr_rfnoc::PKT_TYPE_STRC);
+        BOOST_CHECK_EQUAL(strc.get_header().get_dst_epid(), DST_EPID);
+        BOOST_CHECK(process(len) != 0);
+    }
+
+    //! Passes a packet to the sink, and its response to the source
+    size_t process(const size_t len)
+    {
+        const size_t resp_len =
+            sink->handle_packet(buff.data(), len, resp.data(), resp.size());
+        if (resp_len != 0) {
+            const auto strs = parse(resp, resp_len);
+            BOOST_REQUIRE_EQUAL(
+                strs.get_header().get_pkt_type(), chdr_rfnoc::PKT_TYPE_STRS);
+            BOOST_CHECK_EQUAL(strs.get_header().get_dst_epid(), SRC_EPID);
+            last_strs = strs.get_payload<chdr_rfnoc::strs_payload>();
+            source->handle_strs(last_strs);
+        }
+        return resp_len;
+    }
+
+    chdr_util::chdr_stream_source::sptr source;
+    chdr_util::chdr_stream_sink::sptr sink;
+    std::vector<uint8_t> buff;
+    std::vector<uint8_t> resp;
+    chdr_rfnoc::strs_payload last_strs;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_finite_burst)
+{
+    stream_fixture stream({100 * PKT_SIZE, 100}, {0, 0});
+    BOOST_CHECK_EQUAL(stream.last_strs.capacity_bytes, 100 * PKT_SIZE);
+    BOOST_CHECK_EQUAL(stream.last_strs.capacity_pkts, 100);
+
+    // 2.5 packets
+    stream.source->start(SPP, BPS, 250, 1000);
+    BOOST_CHECK(stream.source->is_streaming());
+    const size_t payload_sizes[] = {SPP * BPS, SPP * BPS, 50 * BPS};
+    for (size_t i = 0; i < 3; i++) {
+        const size_t len = stream.source->write_next(stream.buff.data(), BUFF_SIZE);
+        const auto pkt    = parse(stream.buff, len);
+        const auto header = pkt.get_header();
+        BOOST_CHECK_EQUAL(header.get_pkt_type(), chdr_rfnoc::PKT_TYPE_DATA_WITH_TS);
+        BOOST_CHECK_EQUAL(header.get_seq_num(), i);
+        BOOST_CHECK_EQUAL(header.get_dst_epid(), DST_EPID);
+        BOOST_CHECK_EQUAL(header.get_eob(), i == 2);
+        BOOST_CHECK_EQUAL(pkt.get_timestamp().get(), 1000 + i * SPP);
+        BOOST_CHECK_EQUAL(pkt.get_payload_bytes().size(), payload_sizes[i]);
+        stream.process(len);
+    }
+    BOOST_CHECK(!stream.source->is_streaming());
+    BOOST_CHECK_EQUAL(stream.source->write_next(stream.buff.data(), BUFF_SIZE), 0);
+    BOOST_CHECK_EQUAL(stream.source->get_num_samples_sent(), 250);
+    BOOST_CHECK_EQUAL(stream.source->get_counts().packets, 3);
+    BOOST_CHECK_EQUAL(
+        stream.sink->get_counts().bytes, stream.source->get_counts().bytes);
+    BOOST_CHECK_EQUAL(stream.sink->get_num_bursts(), 1);
+    BOOST_CHECK_EQUAL(stream.sink->get_num_seq_errors(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_flow_control)
+{
+    // Room for 4 packets, with a status every 2 packets
+    stream_fixture stream({10 * PKT_SIZE, 4}, {0, 2});
+    stream.source->start(SPP, BPS, 0, 0);
+
+    std::vector<std::vector<uint8_t>> in_flight;
+    size_t len;
+    while ((len = stream.source->write_next(stream.buff.data(), BUFF_SIZE)) != 0) {
+        in_flight.emplace_back(stream.buff.begin(), stream.buff.begin() + len);
+        BOOST_REQUIRE(in_flight.size() <= 4);
+    }
+    BOOST_CHECK_EQUAL(in_flight.size(), 4);
+
+    // Consuming the first packet sends no status yet, the second one does
+    stream.buff = in_flight[0];
+    BOOST_CHECK_EQUAL(stream.process(PKT_SIZE), 0);
+    BOOST_CHECK_EQUAL(stream.source->write_next(stream.buff.data(), BUFF_SIZE), 0);
+    stream.buff = in_flight[1];
+    BOOST_CHECK(stream.process(PKT_SIZE) != 0);
+    BOOST_CHECK_EQUAL(stream.last_strs.xfer_count_pkts, 2);
+    BOOST_CHECK_EQUAL(stream.last_strs.xfer_count_bytes, 2 * PKT_SIZE);
+    BOOST_CHECK(stream.source->write_next(stream.buff.data(), BUFF_SIZE) != 0);
+    BOOST_CHECK(stream.source->write_next(stream.buff.data(), BUFF_SIZE) != 0);
+    BOOST_CHECK_EQUAL(stream.source->write_next(stream.buff.data(), BUFF_SIZE), 0);
+
+    // A stop ends the burst with the next packet
+    stream.buff = in_flight[2];
+    stream.process(PKT_SIZE);
+    stream.buff = in_flight[3];
+    stream.process(PKT_SIZE);
+    stream.source->stop();
+    len = stream.source->write_next(stream.buff.data(), BUFF_SIZE);
+    BOOST_CHECK(parse(stream.buff, len).get_header().get_eob());
+    BOOST_CHECK(!stream.source->is_streaming());
+}
+
+BOOST_AUTO_TEST_CASE(test_sequence_errors)
+{
+    stream_fixture stream({100 * PKT_SIZE, 100}, {0, 1});
+    stream.source->start(SPP, BPS, 0, 0);
+    stream.process(stream.source->write_next(stream.buff.data(), BUFF_SIZE));
+    BOOST_CHECK_EQUAL(stream.last_strs.status, chdr_rfnoc::STRS_OKAY);
+
+    // Lose a packet
+    stream.source->write_next(stream.buff.data(), BUFF_SIZE);
+    stream.process(stream.source->write_next(stream.buff.data(), BUFF_SIZE));
+    BOOST_CHECK_EQUAL(stream.sink->get_num_seq_errors(), 1);
+    BOOST_CHECK_EQUAL(stream.last_strs.status, chdr_rfnoc::STRS_SEQERR);
+
+    stream.process(stream.source->write_next(stream.buff.data(), BUFF_SIZE));
+    BOOST_CHECK_EQUAL(stream.sink->get_num_seq_errors(), 1);
+    BOOST_CHECK_EQUAL(stream.last_strs.status, chdr_rfnoc::STRS_OKAY);
+}
+
+BOOST_AUTO_TEST_CASE(test_invalid_packets)
+{
+    stream_fixture stream({PKT_SIZE, 1}, {0, 1});
+    // Truncated header
+    BOOST_CHECK_THROW(stream.process(4), uhd::value_error);
+
+    // The length of the header exceeds the packet
+    stream.source->start(SPP, BPS, 0, 0);
+    const size_t len = stream.source->write_next(stream.buff.data(), BUFF_SIZE);
+    BOOST_CHECK_THROW(stream.process(len - 8), uhd::value_error);
+
+    // A buffer that is too small for a packet
+    stream_fixture small({PKT_SIZE, 1}, {0, 1});
+    small.source->start(SPP, BPS, 0, 0);
+    BOOST_CHECK_THROW(
+        small.source->write_next(small.buff.data(), PKT_SIZE - 1), uhd::value_error);
+}
@@ -0,0 +1,534 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Benchmark of the streamers, the CHDR data transports, and the I/O services,
+// driven by synthetic CHDR traffic instead of a radio. Unlike
+// streamer_benchmark, this runs the complete receive path on freshly generated
+// packets (so sequence numbers and timestamps are checked), and can inject
+// packet drops and reordering.
+
+#include "common/chdr_traffic_link.hpp"
+#include "common/mock_link.hpp"
+#include <uhd/convert.hpp>
+#include <uhd/rfnoc/chdr_types.hpp>
+#include <uhd/utils/safe_main.hpp>
+#include <uhdlib/rfnoc/chdr_rx_data_xport.hpp>
+#include <uhdlib/rfnoc/chdr_tx_data_xport.hpp>
+#include <uhdlib/transport/inline_io_service.hpp>
+#include <uhdlib/transport/offload_io_service.hpp>
+#include <uhdlib/transport/rx_streamer_impl.hpp>
+#include <uhdlib/transport/tx_streamer_impl.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#    include <x86intrin.h>
+#    define HAVE_CYCLE_COUNTER
+#elif defined(_M_X64) || defined(_M_IX86)
+#    include <intrin.h>
+#    define HAVE_CYCLE_COUNTER
+#endif
+
+namespace po = boost::program_options;
+using namespace uhd;
+using namespace uhd::rfnoc;
+using namespace uhd::transport;
+
+static const double TICK_RATE       = 100e6;
+static const double SAMP_RATE       = 10e6;
+static const double RX_SCALE_FACTOR = 1.0 / 32767;
+static const double TX_SCALE_FACTOR = 32767;
+static const char* OTW_FORMAT       = "sc16";
+
+//! Number of recv or send calls before the measurement starts
+static constexpr size_t NUM_WARMUP_ITERATIONS = 10000;
+
+/*!
+ * Benchmark configuration
+ */
+struct bench_config_t
+{
+    size_t num_chans;
+    size_t spp;
+    size_t num_frames;
+    size_t iterations;
+    size_t drop_every;
+    size_t drop_burst;
+    size_t reorder_every;
+    std::vector<size_t> cpu_affinity;
+};
+
+/*!
+ * Benchmark results
+ */
+struct bench_result_t
+{
+    double elapsed_secs = 0.0;
+    double cpu_secs     = 0.0;
+    uint64_t cycles     = 0;
+    uint64_t num_samps  = 0;
+    //! Duration of every recv or send call, in nanoseconds
+    std::vector<uint32_t> call_ns;
+    //! Number of calls per error code (RX only)
+    std::map<rx_metadata_t::error_code_t, size_t> num_errors;
+    uint64_t num_dropped   = 0;
+    uint64_t num_reordered = 0;
+};
+
+static inline uint64_t read_cycle_counter()
+{
+#ifdef HAVE_CYCLE_COUNTER
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/*!
+ * RX streamer, exposing the functions to configure it
+ */
+class bench_rx_streamer : public rx_streamer_impl<chdr_rx_data_xport>
+{
+public:
+    using rx_streamer_impl<chdr_rx_data_xport>::rx_streamer_impl;
+    using rx_streamer_impl<chdr_rx_data_xport>::set_tick_rate;
+    using rx_streamer_impl<chdr_rx_data_xport>::set_samp_rate;
+    using rx_streamer_impl<chdr_rx_data_xport>::set_scale_factor;
+
+    void issue_stream_cmd(const stream_cmd_t& /*stream_cmd*/) {}
+};
+
+/*!
+ * TX streamer, exposing the functions to configure it
+ */
+class bench_tx_streamer : public tx_streamer_impl<chdr_tx_data_xport>
+{
+public:
+    using tx_streamer_impl<chdr_tx_data_xport>::tx_streamer_impl;
+    using tx_streamer_impl<chdr_tx_data_xport>::set_tick_rate;
+    using tx_streamer_impl<chdr_tx_data_xport>::set_samp_rate;
+    using tx_streamer_impl<chdr_tx_data_xport>::set_scale_factor;
+
+    bool recv_async_msg(
+        uhd::async_metadata_t& /*async_metadata*/, double /*timeout = 0.1*/)
+    {
+        return false;
+    }
+};
+
+/*!
+ * Creates an I/O service by name: inline, offload_poll, offload_block, or
+ * offload_hybrid
+ */
+static io_service::sptr make_io_service(
+    const std::string& type, const bool is_rx, const bench_config_t& config)
+{
+    if (type == "inline") {
+        return inline_io_service::make();
+    }
+
+    offload_io_service::params_t params;
+    params.cpu_affinity_list = config.cpu_affinity;
+    if (type == "offload_poll") {
+        params.wait_mode   = offload_io_service::POLL;
+        params.client_type = offload_io_service::BOTH_SEND_AND_RECV;
+    } else if (type == "offload_block" || type == "offload_hybrid") {
+        params.wait_mode   = (type == "offload_block") ? offload_io_service::BLOCK
+                                                       : offload_io_service::HYBRID;
+        params.client_type = is_rx ? offload_io_service::RECV_ONLY
+                                   : offload_io_service::SEND_ONLY;
+    } else {
+        throw uhd::value_error("Invalid I/O service type: " + type);
+    }
+    return offload_io_service::make(inline_io_service::make(), params);
+}
+
+static std::shared_ptr<bench_rx_streamer> make_rx_streamer(const std::string& format,
+    io_service::sptr io_srv,
+    const bench_config_t& config,
+    std::vector<chdr_traffic_link::sptr>& traffic_links)
+{
+    const uhd::stream_args_t stream_args(format, OTW_FORMAT);
+    auto streamer = std::make_shared<bench_rx_streamer>(config.num_chans, stream_args);
+    streamer->set_tick_rate(TICK_RATE);
+    streamer->set_samp_rate(SAMP_RATE);
+
+    const chdr::chdr_packet_factory pkt_factory(CHDR_W_64, ENDIANNESS_BIG);
+    const stream_buff_params_t buff_capacity = {UINT64_MAX, UINT32_MAX};
+    const stream_buff_params_t fc_freq       = {UINT64_MAX, UINT32_MAX};
+    const chdr_rx_data_xport::fc_params_t fc_params{buff_capacity, fc_freq};
+
+    const size_t payload_size = convert::get_bytes_per_item(OTW_FORMAT) * config.spp;
+
+    for (size_t chan = 0; chan < config.num_chans; chan++) {
+        streamer->set_scale_factor(chan, RX_SCALE_FACTOR);
+
+        const sep_id_pair_t epids = {0, static_cast<sep_id_t>(chan + 1)};
+
+        chdr_traffic_link::link_params recv_params;
+        recv_params.payload_size = payload_size;
+        recv_params.num_frames   = config.num_frames;
+        recv_params.dst_epid     = epids.second;
+        recv_params.ticks_per_packet =
+            static_cast<uint64_t>(config.spp * TICK_RATE / SAMP_RATE);
+        recv_params.drop_every    = config.drop_every;
+        recv_params.drop_burst    = config.drop_burst;
+        recv_params.reorder_every = config.reorder_every;
+        const mock_send_link::link_params send_params = {payload_size, 4};
+
+        auto recv_link = std::make_shared<chdr_traffic_link>(recv_params, pkt_factory);
+        auto send_link = std::make_shared<mock_send_link>(send_params, true);
+        traffic_links.push_back(recv_link);
+
+        io_srv->attach_recv_link(recv_link);
+        io_srv->attach_send_link(send_link);
+
+        auto xport = std::make_unique<chdr_rx_data_xport>(io_srv,
+            recv_link,
+            send_link,
+            pkt_factory,
+            epids,
+            config.num_frames,
+            fc_params,
+            [io_srv, recv_link, send_link]() {
+                io_srv->detach_recv_link(recv_link);
+                io_srv->detach_send_link(send_link);
+            });
+
+        streamer->connect_channel(chan, std::move(xport));
+    }
+    return streamer;
+}
+
+static std::shared_ptr<bench_tx_streamer> make_tx_streamer(
+    const std::string& format, io_service::sptr io_srv, const bench_config_t& config)
+{
+    const uhd::stream_args_t stream_args(format, OTW_FORMAT);
+    auto streamer = std::make_shared<bench_tx_streamer>(config.num_chans, stream_args);
+    streamer->set_tick_rate(TICK_RATE);
+    streamer->set_samp_rate(SAMP_RATE);
+
+    const chdr::chdr_packet_factory pkt_factory(CHDR_W_64, ENDIANNESS_BIG);
+    const stream_buff_params_t buff_capacity = {UINT64_MAX, UINT32_MAX};
+    const chdr_tx_data_xport::fc_params_t fc_params{buff_capacity};
+
+    const size_t frame_size = convert::get_bytes_per_item(OTW_FORMAT) * config.spp + 16;
+
+    for (size_t chan = 0; chan < config.num_chans; chan++) {
+        streamer->set_scale_factor(chan, TX_SCALE_FACTOR);
+
+        const sep_id_pair_t epids = {0, static_cast<sep_id_t>(chan + 1)};
+
+        const mock_recv_link::link_params recv_params = {frame_size, 4};
+        const mock_send_link::link_params send_params = {frame_size, config.num_frames};
+
+        auto recv_link = std::make_shared<mock_recv_link>(recv_params, true);
+        auto send_link = std::make_shared<mock_send_link>(send_params, true);
+
+        io_srv->attach_recv_link(recv_link);
+        io_srv->attach_send_link(send_link);
+
+        auto xport = std::make_unique<chdr_tx_data_xport>(io_srv,
+            recv_link,
+            send_link,
+            pkt_factory,
+            epids,
+            config.num_frames,
+            fc_params,
+            [io_srv, recv_link, send_link]() {
+                io_srv->detach_recv_link(recv_link);
+                io_srv->detach_send_link(send_link);
+            });
+
+        streamer->connect_channel(chan, std::move(xport));
+    }
+    return streamer;
+}
+
+/*!
+ * Receives config.iterations packets per channel, timing every recv call
+ */
+static bench_result_t benchmark_rx(
+    const std::string& format, io_service::sptr io_srv, const bench_config_t& config)
+{
+    std::vector<chdr_traffic_link::sptr> traffic_links;
+    auto streamer = make_rx_streamer(format, io_srv, config, traffic_links);
+
+    const size_t bpi = convert::get_bytes_per_item(format);
+    std::vector<std::vector<uint8_t>> buffers(
+        config.num_chans, std::vector<uint8_t>(config.spp * bpi));
+    std::vector<void*> buff_ptrs;
+    for (auto& buffer : buffers) {
+        buff_ptrs.push_back(buffer.data());
+    }
+
+    bench_result_t result;
+    result.call_ns.reserve(config.iterations + config.iterations / 8);
+    rx_metadata_t md;
+
+    for (size_t i = 0; i < NUM_WARMUP_ITERATIONS; i++) {
+        streamer->recv(buff_ptrs, config.spp, md, 1.0, true);
+    }
+
+    const auto start_time        = std::chrono::steady_clock::now();
+    const uint64_t start_cycles  = read_cycle_counter();
+    const std::clock_t start_cpu = std::clock();
+
+    size_t num_packets = 0;
+    while (num_packets < config.iterations) {
+        const auto call_start  = std::chrono::steady_clock::now();
+        const size_t num_samps = streamer->recv(buff_ptrs, config.spp, md, 1.0, true);
+        const auto call_end    = std::chrono::steady_clock::now();
+        result.call_ns.push_back(static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(call_end - call_start)
+                .count()));
+
+        if (md.error_code != rx_metadata_t::ERROR_CODE_NONE) {
+            result.num_errors[md.error_code]++;
+            if (md.error_code == rx_metadata_t::ERROR_CODE_TIMEOUT) {
+                std::cerr << "Timeout while receiving, stopping early\n";
+                break;
+            }
+            continue;
+        }
+        result.num_samps += num_samps;
+        num_packets++;
+    }
+
+    const std::clock_t end_cpu = std::clock();
+    const uint64_t end_cycles  = read_cycle_counter();
+    const auto end_time        = std::chrono::steady_clock::now();
+
+    result.elapsed_secs = std::chrono::duration<double>(end_time - start_time).count();
+    result.cpu_secs     = double(end_cpu - start_cpu) / CLOCKS_PER_SEC;
+    result.cycles       = end_cycles - start_cycles;
+
+    // Stop the I/O service threads before reading the link counters
+    streamer.reset();
+    for (const auto& link : traffic_links) {
+        result.num_dropped += link->get_num_dropped();
+        result.num_reordered += link->get_num_reordered();
+    }
+    return result;
+}
+
+/*!
+ * Sends config.iterations packets per channel, timing every send call
+ */
+static bench_result_t benchmark_tx(
+    const std::string& format, io_service::sptr io_srv, const bench_config_t& config)
+{
+    auto streamer = make_tx_streamer(format, io_srv, config);
+
+    const size_t bpi = convert::get_bytes_per_item(format);
+    std::vector<std::vector<uint8_t>> buffers(
+        config.num_chans, std::vector<uint8_t>(config.spp * bpi));
+    std::vector<const void*> buff_ptrs;
+    for (const auto& buffer : buffers) {
+        buff_ptrs.push_back(buffer.data());
+    }
+
+    bench_result_t result;
+    result.call_ns.reserve(config.iterations);
+    tx_metadata_t md;
+    md.has_time_spec = false;
+
+    for (size_t i = 0; i < NUM_WARMUP_ITERATIONS; i++) {
+        streamer->send(buff_ptrs, config.spp, md, 1.0);
+    }
+
+    const auto start_time        = std::chrono::steady_clock::now();
+    const uint64_t start_cycles  = read_cycle_counter();
+    const std::clock_t start_cpu = std::clock();
+
+    for (size_t i = 0; i < config.iterations; i++) {
+        const auto call_start  = std::chrono::steady_clock::now();
+        const size_t num_samps = streamer->send(buff_ptrs, config.spp, md, 1.0);
+        const auto call_end    = std::chrono::steady_clock::now();
+        result.call_ns.push_back(static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(call_end - call_start)
+                .count()));
+        result.num_samps += num_samps;
+    }
+
+    const std::clock_t end_cpu = std::clock();
+    const uint64_t end_cycles  = read_cycle_counter();
+    const auto end_time        = std::chrono::steady_clock::now();
+
+    result.elapsed_secs = std::chrono::duration<double>(end_time - start_time).count();
+    result.cpu_secs     = double(end_cpu - start_cpu) / CLOCKS_PER_SEC;
+    result.cycles       = end_cycles - start_cycles;
+    return result;
+}
+
+static std::string get_error_name(const rx_metadata_t::error_code_t error_code)
+{
+    rx_metadata_t md;
+    md.error_code = error_code;
+    return md.strerror();
+}
+
+static uint32_t get_percentile(const std::vector<uint32_t>& sorted, const double p)
+{
+    if (sorted.empty()) {
+        return 0;
+    }
+    const size_t index = static_cast<size_t>(p * (sorted.size() - 1));
+    return sorted[index];
+}
+
+static void print_header(const bool csv)
+{
+    if (csv) {
+        std::cout << "direction,io_service,format,chans,spp,msps,ns_per_call_p50,"
+                     "ns_per_call_p99,ns_per_call_p999,ns_per_call_max,cpu_ns_per_samp,"
+                     "cycles_per_samp,dropped,reordered,errors\n";
+        return;
+    }
+    std::cout << boost::format("%-3s %-15s %-5s %5s %10s %8s %8s %8s %9s %8s %8s\n")
+                     % "dir" % "io_service" % "fmt" % "chans" % "Msps/chan" % "p50 ns"
+                     % "p99 ns" % "p99.9 ns" % "max ns" % "CPU ns/S" % "cyc/S";
+}
+
+static void print_result(const std::string& direction,
+    const std::string& io_srv_type,
+    const std::string& format,
+    const bench_config_t& config,
+    bench_result_t& result,
+    const bool csv)
+{
+    std::sort(result.call_ns.begin(), result.call_ns.end());
+    // Samples per channel
+    const double samps_per_chan  = double(result.num_samps);
+    const double msps            = samps_per_chan / result.elapsed_secs / 1e6;
+    const double total_samps     = samps_per_chan * config.num_chans;
+    const double cpu_ns_per_samp = result.cpu_secs * 1e9 / total_samps;
+    // The cycle counter ticks at a constant rate, so it only counts the cycles
+    // of the calling thread while it runs. Scale it by the CPU time of all
+    // threads, which includes the offload threads.
+    const double cycles_per_samp =
+        (result.cycles == 0)
+            ? 0.0
+            : double(result.cycles) * (result.cpu_secs / result.elapsed_secs)
+                  / total_samps;
+    size_t num_errors = 0;
+    for (const auto& entry : result.num_errors) {
+        num_errors += entry.second;
+    }
+
+    if (csv) {
+        std::cout << direction << "," << io_srv_type << "," << format << ","
+                  << config.num_chans << "," << config.spp << "," << msps << ","
+                  << get_percentile(result.call_ns, 0.5) << ","
+                  << get_percentile(result.call_ns, 0.99) << ","
+                  << get_percentile(result.call_ns, 0.999) << ","
+                  << get_percentile(result.call_ns, 1.0) << "," << cpu_ns_per_samp
+                  << "," << cycles_per_samp << "," << result.num_dropped << ","
+                  << result.num_reordered << "," << num_errors << "\n";
+        return;
+    }
+    std::cout << boost::format(
+                     "%-3s %-15s %-5s %5d %10.1f %8d %8d %8d %9d %8.2f %8.2f\n")
+                     % direction % io_srv_type % format % config.num_chans % msps
+                     % get_percentile(result.call_ns, 0.5)
+                     % get_percentile(result.call_ns, 0.99)
+                     % get_percentile(result.call_ns, 0.999)
+                     % get_percentile(result.call_ns, 1.0) % cpu_ns_per_samp
+                     % cycles_per_samp;
+    if (result.num_dropped || result.num_reordered || num_errors) {
+        std::cout << "    injected: " << result.num_dropped << " dropped, "
+                  << result.num_reordered << " reordered; errors:";
+        for (const auto& entry : result.num_errors) {
+            std::cout << " " << get_error_name(entry.first) << " x" << entry.second;
+        }
+        std::cout << "\n";
+    }
+}
+
+static std::vector<std::string> split_list(const std::string& list)
+{
+    std::vector<std::string> items;
+    boost::split(items, list, boost::is_any_of(","));
+    return items;
+}
+
+int UHD_SAFE_MAIN(int argc, char* argv[])
+{
+    std::string directions, formats, io_services, cpu_affinity;
+    bench_config_t config;
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "help message")
+        ("direction", po::value<std::string>(&directions)->default_value("rx,tx"), "list of directions to benchmark (rx, tx)")
+        ("formats", po::value<std::string>(&formats)->default_value("sc16,fc32"), "list of CPU formats (sc16, fc32, fc64)")
+        ("io-service", po::value<std::string>(&io_services)->default_value("inline,offload_poll,offload_block"), "list of I/O services (inline, offload_poll, offload_block, offload_hybrid)")
+        ("channels", po::value<size_t>(&config.num_chans)->default_value(1), "number of channels per streamer")
+        ("spp", po::value<size_t>(&config.spp)->default_value(1000), "samples per packet")
+        ("num-frames", po::value<size_t>(&config.num_frames)->default_value(32), "number of frames per link")
+        ("iterations", po::value<size_t>(&config.iterations)->default_value(1000000), "number of packets per channel to stream")
+        ("drop-every", po::value<size_t>(&config.drop_every)->default_value(0), "drop packets once every this many RX packets (0: never)")
+        ("drop-burst", po::value<size_t>(&config.drop_burst)->default_value(1), "number of consecutive packets to drop at a time")
+        ("reorder-every", po::value<size_t>(&config.reorder_every)->default_value(0), "swap two RX packets once every this many packets (0: never)")
+        ("cpu", po::value<std::string>(&cpu_affinity), "list of CPUs for the offload threads")
+        ("csv", "print the results as comma-separated values")
+    ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    // Print the help message
+    if (vm.count("help")) {
+        std::cout << boost::format("UHD CHDR Streamer Benchmark %s") % desc << std::endl;
+        std::cout
+            << "    Benchmark of the streamers, CHDR data transports, and I/O\n"
+               "    services, with synthetic CHDR traffic instead of a device.\n"
+               "    For every recv or send call, the time it took is recorded;\n"
+               "    the percentiles of these times are reported, along with the\n"
+               "    throughput per channel, and the CPU time per sample of all\n"
+               "    threads. The cycles per sample are derived from the CPU time\n"
+               "    and the timestamp counter (x86 only).\n"
+            << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (!cpu_affinity.empty()) {
+        for (const auto& cpu : split_list(cpu_affinity)) {
+            config.cpu_affinity.push_back(std::stoul(cpu));
+        }
+    }
+    const bool csv = vm.count("csv") > 0;
+
+    if (!csv) {
+        std::cout << "channels: " << config.num_chans << ", spp: " << config.spp
+                  << ", iterations: " << config.iterations << "\n";
+    }
+    print_header(csv);
+    for (const auto& direction : split_list(directions)) {
+        if (direction != "rx" && direction != "tx") {
+            throw uhd::value_error("Invalid direction: " + direction);
+        }
+        const bool is_rx = direction == "rx";
+        for (const auto& io_srv_type : split_list(io_services)) {
+            for (const auto& format : split_list(formats)) {
+                auto io_srv = make_io_service(io_srv_type, is_rx, config);
+                auto result = is_rx ? benchmark_rx(format, io_srv, config)
+                                    : benchmark_tx(format, io_srv, config);
+                print_result(direction, io_srv_type, format, config, result, csv);
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -209,6 +209,18 @@ BOOST_AUTO_TEST_CASE(simple_read_if_chdr_pkt)
     // Flush flags: by default, we set active is low, done is high
     BOOST_CHECK_EQUAL(mock_client0->get_flush_active(3), false);
     BOOST_CHECK_EQUAL(mock_client0->get_flush_done(3), true);
+
+    // Status of all blocks in one pass
+    const std::vector<uint32_t> noc_ids{
+        0x12AD1000, 0xDDC00000, 0xD11C0000, 0x12AD1000, 0xDDC00000, 0xD11C0000};
+    const auto all_status = mock_client0->get_all_port_status();
+    BOOST_REQUIRE_EQUAL(all_status.size(), noc_ids.size());
+    for (size_t i = 0; i < all_status.size(); i++) {
+        BOOST_CHECK_EQUAL(all_status[i].portno, i + 3);
+        BOOST_CHECK_EQUAL(all_status[i].noc_id, noc_ids[i]);
+        BOOST_CHECK_EQUAL(all_status[i].flush_active, false);
+        BOOST_CHECK_EQUAL(all_status[i].flush_done, true);
+    }
     // Flushing and Reset
     UHD_LOG_INFO("TEST", "Setting and resetting flush flags...");
     BOOST_CHECK_THROW(mock_client0->set_flush(0), uhd::index_error);
@@ -0,0 +1,172 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_CHDR_TRAFFIC_LINK_HPP
+#define INCLUDED_CHDR_TRAFFIC_LINK_HPP
+
+#include "mock_link.hpp"
+#include <uhd/exception.hpp>
+#include <uhdlib/rfnoc/chdr_packet_writer.hpp>
+#include <uhdlib/transport/link_base.hpp>
+#include <boost/shared_array.hpp>
+#include <vector>
+
+namespace uhd { namespace transport {
+
+/*!
+ * Recv link that generates an endless stream of CHDR data packets with
+ * timestamps, in place of a radio.
+ *
+ * Every packet gets the next sequence number and a timestamp that advances by
+ * a constant number of ticks per packet. The payload is written once, when the
+ * link is created, so the packets don't cost more to generate than the header.
+ * Drops and reordering can be injected with fixed patterns, which keeps runs
+ * repeatable:
+ * - Out of every drop_every packets, the last drop_burst ones are not sent.
+ * - Every reorder_every packets, two packets are swapped.
+ */
+class chdr_traffic_link : public recv_link_base<chdr_traffic_link>
+{
+public:
+    using sptr = std::shared_ptr<chdr_traffic_link>;
+
+    using base_t = recv_link_base<chdr_traffic_link>;
+
+    /*!
+     * Parameters for link creation.
+     */
+    struct link_params
+    {
+        //! Payload bytes per packet
+        size_t payload_size;
+        size_t num_frames;
+        uint16_t dst_epid;
+        //! Timestamp increment per packet
+        uint64_t ticks_per_packet;
+        //! Packet drop period, 0 for no drops
+        size_t drop_every = 0;
+        //! Number of consecutive packets that are dropped every period
+        size_t drop_burst = 1;
+        //! Packet reorder period, 0 for no reordering
+        size_t reorder_every = 0;
+    };
+
+    chdr_traffic_link(
+        const link_params& params, const rfnoc::chdr::chdr_packet_factory& pkt_factory)
+        : base_t(params.num_frames, params.payload_size + HEADER_SIZE)
+        , _params(params)
+        , _pkt_writer(pkt_factory.make_generic())
+    {
+        UHD_ASSERT_THROW(params.payload_size + HEADER_SIZE <= 0xFFFF);
+        UHD_ASSERT_THROW(params.drop_every == 0 || params.drop_burst < params.drop_every);
+        UHD_ASSERT_THROW(params.reorder_every != 1);
+
+        const size_t frame_size = params.payload_size + HEADER_SIZE;
+        _buffs.resize(params.num_frames);
+        for (auto& buff : _buffs) {
+            boost::shared_array<uint8_t> mem(new uint8_t[frame_size]);
+            // Arbitrary, but not all-zero samples
+            for (size_t i = 0; i < frame_size; i++) {
+                mem[i] = static_cast<uint8_t>(i * 7 + 3);
+            }
+            buff.set_mem(mem);
+            base_t::preload_free_buff(&buff);
+        }
+    }
+
+    //! Number of packets that were dropped so far
+    uint64_t get_num_dropped() const
+    {
+        return _num_dropped;
+    }
+
+    //! Number of packets that were sent out of order so far
+    uint64_t get_num_reordered() const
+    {
+        return _num_reordered;
+    }
+
+    adapter_id_t get_recv_adapter_id() const
+    {
+        return NULL_ADAPTER_ID;
+    }
+
+private:
+    // CHDR header and timestamp, for a CHDR width of 64 bits
+    static constexpr size_t HEADER_SIZE = 16;
+
+    // Friend declaration to allow base class to call private methods
+    friend base_t;
+
+    // Method called by recv_link_base
+    size_t get_recv_buff_derived(frame_buff& buff, int32_t)
+    {
+        const uint64_t pkt_num = _get_next_pkt_num();
+        const size_t pkt_size  = _params.payload_size + HEADER_SIZE;
+
+        rfnoc::chdr::chdr_header header;
+        header.set_pkt_type(rfnoc::chdr::PKT_TYPE_DATA_WITH_TS);
+        header.set_seq_num(static_cast<uint16_t>(pkt_num));
+        header.set_length(static_cast<uint16_t>(pkt_size));
+        header.set_dst_epid(_params.dst_epid);
+        _pkt_writer->refresh(buff.data(), header, pkt_num * _params.ticks_per_packet);
+
+        buff.set_packet_size(pkt_size);
+        return pkt_size;
+    }
+
+    // Method called by recv_link_base
+    void release_recv_buff_derived(frame_buff&) {}
+
+    bool _is_dropped(const uint64_t pkt_num) const
+    {
+        return _params.drop_every != 0
+               && (pkt_num % _params.drop_every)
+                      >= (_params.drop_every - _params.drop_burst);
+    }
+
+    uint64_t _get_next_sent_pkt_num()
+    {
+        while (_is_dropped(_next_pkt_num)) {
+            _next_pkt_num++;
+            _num_dropped++;
+        }
+        return _next_pkt_num++;
+    }
+
+    uint64_t _get_next_pkt_num()
+    {
+        if (_has_held_pkt) {
+            _has_held_pkt = false;
+            return _held_pkt_num;
+        }
+        const uint64_t pkt_num = _get_next_sent_pkt_num();
+        if (_params.reorder_every != 0 && ++_num_since_reorder == _params.reorder_every) {
+            // Send the next packet first, and this one after it
+            _num_since_reorder = 1;
+            _held_pkt_num      = pkt_num;
+            _has_held_pkt      = true;
+            _num_reordered++;
+            return _get_next_sent_pkt_num();
+        }
+        return pkt_num;
+    }
+
+    const link_params _params;
+    rfnoc::chdr::chdr_packet_writer::uptr _pkt_writer;
+    std::vector<mock_frame_buff> _buffs;
+
+    uint64_t _next_pkt_num    = 0;
+    uint64_t _held_pkt_num    = 0;
+    bool _has_held_pkt        = false;
+    size_t _num_since_reorder = 0;
+    uint64_t _num_dropped     = 0;
+    uint64_t _num_reordered   = 0;
+};
+
+}} // namespace uhd::transport
+
+#endif /*INCLUDED_CHDR_TRAFFIC_LINK_HPP*/
@@ -0,0 +1,261 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_MOCK_RX_STREAMER_HPP
+#define INCLUDED_MOCK_RX_STREAMER_HPP
+
+#include <uhd/stream.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/types/stream_cmd.hpp>
+#include <uhd/types/time_spec.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace uhd {
+
+/*!
+ * RX streamer that returns a list of packets, for testing the code that sits
+ * on top of an rx_streamer.
+ *
+ * The packets are either passed to the constructor, or pushed while the
+ * streamer is in use, which plays the I/O thread. recv() returns them in
+ * order, in fragments if they don't fit into the buffers, and waits for up to
+ * its timeout when there are no more.
+ */
+class mock_rx_streamer : public uhd::rx_streamer
+{
+public:
+    using sptr = std::shared_ptr<mock_rx_streamer>;
+
+    /*!
+     * Fills the samples of a packet, or of a fragment of it
+     *
+     * \param buffs the buffers of the channels
+     * \param first_samp the index of the first sample in the stream, which
+     *                   counts the samples lost to errors
+     * \param nsamps the number of samples to fill
+     */
+    using fill_fn_t = std::function<void(
+        const buffs_type& buffs, const size_t first_samp, const size_t nsamps)>;
+
+    /*!
+     * A packet of the stream
+     */
+    struct packet_t
+    {
+        //! The number of samples, or the number of samples lost for an error
+        size_t nsamps;
+        bool eob                                    = false;
+        uhd::rx_metadata_t::error_code_t error_code = uhd::rx_metadata_t::ERROR_CODE_NONE;
+    };
+
+    /*!
+     * Parameters of the stream
+     */
+    struct stream_params
+    {
+        size_t num_chans     = 1;
+        size_t max_num_samps = 1000;
+        //! The sample rate of the time specs, packets have none if this is 0
+        double rate = 0.0;
+        //! The time of the first sample
+        uhd::time_spec_t start_time = uhd::time_spec_t(0.0);
+        //! Return the packets over and over
+        bool repeat = false;
+        //! Support set_recv_ready_callback()
+        bool can_notify = true;
+        //! Fills the samples. By default, every sample is a byte holding the
+        //! index of its packet, plus the index of its channel.
+        fill_fn_t fill;
+    };
+
+    /*!
+     * Returns a fill function for a single channel, where sample i of the
+     * stream is signal(i)
+     */
+    template <typename sample_t>
+    static fill_fn_t fill_signal(std::function<sample_t(size_t)> signal)
+    {
+        return [signal](const buffs_type& buffs, size_t first_samp, size_t nsamps) {
+            auto* out = static_cast<sample_t*>(buffs[0]);
+            for (size_t i = 0; i < nsamps; i++) {
+                out[i] = signal(first_samp + i);
+            }
+        };
+    }
+
+    //! Returns a packet for an overflow, which loses \p nsamps samples
+    static packet_t overflow(const size_t nsamps = 0)
+    {
+        return packet_t{nsamps, false, uhd::rx_metadata_t::ERROR_CODE_OVERFLOW};
+    }
+
+    mock_rx_streamer() : mock_rx_streamer(stream_params()) {}
+
+    explicit mock_rx_streamer(
+        const stream_params& params, const std::vector<packet_t>& packets = {})
+        : _params(params), _packets(packets)
+    {
+    }
+
+    size_t get_num_channels() const override
+    {
+        return _params.num_chans;
+    }
+
+    size_t get_max_num_samps() const override
+    {
+        return _params.max_num_samps;
+    }
+
+    size_t recv(const buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        uhd::rx_metadata_t& metadata,
+        const double timeout,
+        const bool) override
+    {
+        metadata.reset();
+        std::unique_lock<std::mutex> l(_mutex);
+        if (!_has_packet()) {
+            _drained = true;
+        }
+        if (!_cond.wait_for(l, std::chrono::duration<double>(timeout), [this]() {
+                return _has_packet();
+            })) {
+            metadata.error_code = uhd::rx_metadata_t::ERROR_CODE_TIMEOUT;
+            return 0;
+        }
+        if (_index == _packets.size()) {
+            _index = 0;
+        }
+
+        const packet_t packet = _packets[_index];
+        if (packet.error_code != uhd::rx_metadata_t::ERROR_CODE_NONE) {
+            metadata.error_code = packet.error_code;
+            _next_samp += packet.nsamps;
+            _index++;
+            return 0;
+        }
+
+        const size_t nsamps = std::min(nsamps_per_buff, packet.nsamps - _offset);
+        if (_params.fill) {
+            _params.fill(buffs, _next_samp, nsamps);
+        } else {
+            for (size_t chan = 0; chan < _params.num_chans; chan++) {
+                std::memset(buffs[chan], int(_index + chan), nsamps);
+            }
+        }
+        if (_params.rate > 0.0) {
+            metadata.has_time_spec = true;
+            metadata.time_spec     = _params.start_time
+                                 + uhd::time_spec_t::from_ticks(_next_samp, _params.rate);
+        }
+        metadata.fragment_offset = _offset;
+        _offset += nsamps;
+        _next_samp += nsamps;
+        metadata.more_fragments = _offset < packet.nsamps;
+        if (!metadata.more_fragments) {
+            metadata.end_of_burst = packet.eob;
+            _offset               = 0;
+            _index++;
+        }
+        return nsamps;
+    }
+
+    void issue_stream_cmd(const uhd::stream_cmd_t& stream_cmd) override
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _last_cmd = stream_cmd;
+    }
+
+    void set_recv_ready_callback(recv_ready_callback_t callback) override
+    {
+        if (!_params.can_notify) {
+            uhd::rx_streamer::set_recv_ready_callback(callback);
+        }
+        std::lock_guard<std::mutex> l(_mutex);
+        _callback = callback;
+    }
+
+    //! Queue a packet, and notify
+    void push(const packet_t& packet)
+    {
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            _packets.push_back(packet);
+            _drained = false;
+        }
+        _cond.notify_one();
+        notify();
+    }
+
+    //! Queue a packet of \p nsamps samples, and notify
+    void push(const size_t nsamps)
+    {
+        push(packet_t{nsamps});
+    }
+
+    //! Call the ready callback, if there is one
+    void notify()
+    {
+        recv_ready_callback_t callback;
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            callback = _callback;
+        }
+        if (callback) {
+            callback();
+        }
+    }
+
+    bool has_callback() const
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        return bool(_callback);
+    }
+
+    //! Returns true once recv() ran out of packets
+    bool is_drained() const
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _drained;
+    }
+
+    uhd::stream_cmd_t get_last_stream_cmd() const
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _last_cmd;
+    }
+
+private:
+    bool _has_packet() const
+    {
+        return _index < _packets.size() || (_params.repeat && !_packets.empty());
+    }
+
+    const stream_params _params;
+    mutable std::mutex _mutex;
+    std::condition_variable _cond;
+    std::vector<packet_t> _packets;
+    //! The packet that recv() returns next, and the fragment of it
+    size_t _index  = 0;
+    size_t _offset = 0;
+    //! The index of the next sample in the stream
+    size_t _next_samp = 0;
+    bool _drained     = false;
+    recv_ready_callback_t _callback;
+    uhd::stream_cmd_t _last_cmd{uhd::stream_cmd_t::STREAM_MODE_STOP_CONTINUOUS};
+};
+
+} // namespace uhd
+
+#endif /*INCLUDED_MOCK_RX_STREAMER_HPP*/
@@ -0,0 +1,163 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_MOCK_TX_STREAMER_HPP
+#define INCLUDED_MOCK_TX_STREAMER_HPP
+
+#include <uhd/exception.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/metadata.hpp>
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace uhd {
+
+/*!
+ * TX streamer that stores the fc32 samples and the metadata it's given, for
+ * testing the code that sits on top of a tx_streamer.
+ *
+ * Every send() call takes up to max_num_samps samples. The streamer can be
+ * stalled like a congested link, and the test can post async messages, which
+ * go to the async message callback if there is one, or are queued for
+ * recv_async_msg() otherwise.
+ */
+class mock_tx_streamer : public uhd::tx_streamer
+{
+public:
+    using sptr     = std::shared_ptr<mock_tx_streamer>;
+    using sample_t = std::complex<float>;
+
+    /*!
+     * Parameters of the stream
+     */
+    struct stream_params
+    {
+        size_t num_chans     = 1;
+        size_t max_num_samps = 1000;
+        //! Support set_async_msg_callback()
+        bool can_notify = true;
+    };
+
+    mock_tx_streamer() : mock_tx_streamer(stream_params()) {}
+
+    explicit mock_tx_streamer(const stream_params& params)
+        : _params(params), _samples(params.num_chans)
+    {
+    }
+
+    size_t get_num_channels() const override
+    {
+        return _params.num_chans;
+    }
+
+    size_t get_max_num_samps() const override
+    {
+        return _params.max_num_samps;
+    }
+
+    size_t send(const buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        const uhd::tx_metadata_t& metadata,
+        const double timeout) override
+    {
+        std::unique_lock<std::mutex> l(_mutex);
+        if (!_cond.wait_for(l, std::chrono::duration<double>(timeout), [this]() {
+                return !_stalled;
+            })) {
+            return 0;
+        }
+        const size_t nsamps = std::min(nsamps_per_buff, _params.max_num_samps);
+        for (size_t chan = 0; chan < _params.num_chans; chan++) {
+            const auto* samps = static_cast<const sample_t*>(buffs[chan]);
+            _samples[chan].insert(_samples[chan].end(), samps, samps + nsamps);
+        }
+        _metadata.push_back(metadata);
+        return nsamps;
+    }
+
+    bool recv_async_msg(uhd::async_metadata_t& async_metadata, double) override
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        if (_async_msgs.empty()) {
+            return false;
+        }
+        async_metadata = _async_msgs.front();
+        _async_msgs.pop_front();
+        return true;
+    }
+
+    void set_async_msg_callback(async_msg_callback_t callback) override
+    {
+        if (!_params.can_notify) {
+            uhd::tx_streamer::set_async_msg_callback(callback);
+        }
+        std::lock_guard<std::mutex> l(_mutex);
+        _callback = callback;
+    }
+
+    //! While stalled, send() waits for up to its timeout and sends nothing
+    void set_stalled(const bool stalled)
+    {
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            _stalled = stalled;
+        }
+        _cond.notify_all();
+    }
+
+    //! Report an async message, through the callback if there is one
+    void post_async_msg(const size_t chan, const uhd::async_metadata_t::event_code_t code)
+    {
+        uhd::async_metadata_t msg;
+        msg.channel    = chan;
+        msg.event_code = code;
+        async_msg_callback_t callback;
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            callback = _callback;
+            if (!callback) {
+                _async_msgs.push_back(msg);
+            }
+        }
+        if (callback) {
+            callback(msg);
+        }
+    }
+
+    //! Returns the samples sent so far on channel \p chan
+    std::vector<sample_t> get_samples(const size_t chan) const
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _samples.at(chan);
+    }
+
+    //! Returns the metadata of every send() call that sent samples
+    std::vector<uhd::tx_metadata_t> get_metadata() const
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _metadata;
+    }
+
+private:
+    const stream_params _params;
+    mutable std::mutex _mutex;
+    std::condition_variable _cond;
+    bool _stalled = false;
+    std::vector<std::vector<sample_t>> _samples;
+    std::vector<uhd::tx_metadata_t> _metadata;
+    std::deque<uhd::async_metadata_t> _async_msgs;
+    async_msg_callback_t _callback;
+};
+
+} // namespace uhd
+
+#endif /*INCLUDED_MOCK_TX_STREAMER_HPP*/
@@ -6,6 +6,9 @@
 //
 
 #include <uhd/convert.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/utils/byteswap.hpp>
+#include <uhdlib/convert/iq_correction.hpp>
 #include <stdint.h>
 #include <boost/test/unit_test.hpp>
 #include <complex>
@@ -722,3 +725,351 @@ BOOST_AUTO_TEST_CASE(test_convert_types_fc32_and_fc32_chdr)
         test_convert_types_fc32(nsamps, id);
     }
 }
+
+/***********************************************************************
+ * Test SIMD converters against the generic ones
+ **********************************************************************/
+static void test_convert_simd_against_generic(const convert::id_type& id,
+    const size_t in_bytes,
+    const size_t out_bytes,
+    const double scalar)
+{
+    const bool float_in  = id.input_format == "fc32";
+    const bool float_out = id.output_format == "fc32";
+    const size_t max_nsamps = 100;
+    const size_t max_offset = 4;
+    const size_t buff_size  = (max_nsamps + max_offset) * sizeof(fc32_t);
+
+    // fill the input buffer. Floats are chosen to scale to integers within
+    // range, since the generic converters truncate and the SIMD ones round.
+    std::vector<uint8_t> input(buff_size);
+    if (float_in) {
+        const int range = int(scalar) - 1;
+        fc32_t* in      = reinterpret_cast<fc32_t*>(&input[0]);
+        for (size_t i = 0; i < buff_size / sizeof(fc32_t); i++) {
+            in[i] = fc32_t(float((std::rand() % (2 * range + 1)) - range) / float(scalar),
+                float((std::rand() % (2 * range + 1)) - range) / float(scalar));
+        }
+    } else {
+        for (uint8_t& in : input) {
+            in = uint8_t(std::rand());
+        }
+    }
+
+    // higher priorities are only registered for the instruction sets this
+    // machine supports (PRIORITY_SIMD, PRIORITY_SIMD_AVX2, PRIORITY_SIMD_AVX512)
+    for (const int prio : {3, 4, 5}) {
+        convert::function_type make_simd;
+        try {
+            make_simd = convert::get_converter(id, prio);
+        } catch (const uhd::key_error&) {
+            continue;
+        }
+        convert::converter::sptr generic = convert::get_converter(id, 0)();
+        convert::converter::sptr simd    = make_simd();
+        generic->set_scalar(scalar);
+        simd->set_scalar(scalar);
+
+        for (size_t offset = 0; offset < max_offset; offset++) {
+            for (size_t nsamps = 1; nsamps < max_nsamps; nsamps++) {
+                std::vector<uint8_t> generic_out(buff_size), simd_out(buff_size);
+                std::vector<const void*> in(1, &input[offset * in_bytes]);
+                std::vector<void*> out0(1, &generic_out[offset * out_bytes]);
+                std::vector<void*> out1(1, &simd_out[offset * out_bytes]);
+                generic->conv(in, out0, nsamps);
+                simd->conv(in, out1, nsamps);
+
+                bool match = generic_out == simd_out;
+                if (float_out) {
+                    const fc32_t* a = reinterpret_cast<const fc32_t*>(&generic_out[0]);
+                    const fc32_t* b = reinterpret_cast<const fc32_t*>(&simd_out[0]);
+                    match = true;
+                    for (size_t i = 0; i < buff_size / sizeof(fc32_t); i++) {
+                        match = match and std::abs(a[i] - b[i]) < 1e-6;
+                    }
+                }
+                BOOST_CHECK_MESSAGE(match,
+                    id.to_string() << " prio " << prio << " offset " << offset
+                                      << " nsamps " << nsamps);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_simd_against_generic_sc16)
+{
+    convert::id_type id;
+    id.num_inputs  = 1;
+    id.num_outputs = 1;
+
+    for (const std::string wire : {"sc16_item32_le", "sc16_item32_be", "sc16_chdr"}) {
+        id.input_format  = "fc32";
+        id.output_format = wire;
+        test_convert_simd_against_generic(id, sizeof(fc32_t), sizeof(sc16_t), 32768.);
+        std::swap(id.input_format, id.output_format);
+        test_convert_simd_against_generic(id, sizeof(sc16_t), sizeof(fc32_t), 1 / 32768.);
+    }
+
+    for (const std::string wire : {"sc16_item32_le", "sc16_item32_be"}) {
+        id.input_format  = "sc16";
+        id.output_format = wire;
+        test_convert_simd_against_generic(id, sizeof(sc16_t), sizeof(sc16_t), 1.);
+        std::swap(id.input_format, id.output_format);
+        test_convert_simd_against_generic(id, sizeof(sc16_t), sizeof(sc16_t), 1.);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_simd_against_generic_sc8)
+{
+    convert::id_type id;
+    id.num_inputs  = 1;
+    id.num_outputs = 1;
+
+    for (const std::string wire : {"sc8_item32_le", "sc8_item32_be"}) {
+        id.input_format  = "fc32";
+        id.output_format = wire;
+        test_convert_simd_against_generic(id, sizeof(fc32_t), 2, 128.);
+        // the generic converter only supports item32 aligned input
+        std::swap(id.input_format, id.output_format);
+        test_convert_simd_against_generic(id, 4, sizeof(fc32_t), 1 / 128.);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_simd_against_table_sc16_to_sc8)
+{
+    convert::id_type id;
+    id.input_format = "sc16";
+    id.num_inputs   = 1;
+    id.num_outputs  = 1;
+
+    const size_t max_nsamps = 100;
+    // Values that stay in range when scaled to sc8 (the table wraps around
+    // otherwise), with a scale factor that hits the ties of the rounding
+    std::vector<sc16_t> input(max_nsamps);
+    for (sc16_t& in : input) {
+        in = sc16_t((std::rand() % 64001) - 32000, (std::rand() % 64001) - 32000);
+    }
+    input[0] = sc16_t(128, -128);
+    input[1] = sc16_t(384, -640);
+    const double scalar = 32767. / 256;
+
+    for (const std::string wire : {"sc8_item32_le", "sc8_item32_be"}) {
+        id.output_format = wire;
+        for (const int prio : {3, 4, 5}) {
+            convert::function_type make_simd;
+            try {
+                make_simd = convert::get_converter(id, prio);
+            } catch (const uhd::key_error&) {
+                continue;
+            }
+            convert::converter::sptr table = convert::get_converter(id, 1)();
+            convert::converter::sptr simd  = make_simd();
+            table->set_scalar(scalar);
+            simd->set_scalar(scalar);
+
+            for (size_t nsamps = 1; nsamps < max_nsamps; nsamps++) {
+                std::vector<uint32_t> table_out(max_nsamps), simd_out(max_nsamps);
+                table->conv(&input[0], &table_out[0], nsamps);
+                simd->conv(&input[0], &simd_out[0], nsamps);
+                BOOST_CHECK_MESSAGE(table_out == simd_out,
+                    id.to_string() << " prio " << prio << " nsamps " << nsamps);
+            }
+
+            // Out of range values saturate
+            std::vector<sc16_t> full_scale(max_nsamps, sc16_t(32767, -32768));
+            std::vector<uint32_t> output(max_nsamps / 2);
+            simd->set_scalar(32767.);
+            simd->conv(&full_scale[0], &output[0], max_nsamps);
+            const uint32_t expected = (wire == "sc8_item32_le")
+                                          ? uhd::htowx<uint32_t>(0x7F807F80)
+                                          : uhd::htonx<uint32_t>(0x7F807F80);
+            for (const uint32_t item : output) {
+                BOOST_CHECK_EQUAL(item, expected);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_simd_against_generic_sc12)
+{
+    convert::id_type id;
+    id.num_inputs  = 1;
+    id.num_outputs = 1;
+
+    for (const std::string wire : {"sc12_item32_le", "sc12_item32_be"}) {
+        id.input_format  = "fc32";
+        id.output_format = wire;
+        test_convert_simd_against_generic(id, sizeof(fc32_t), 3, 2048.);
+        std::swap(id.input_format, id.output_format);
+        test_convert_simd_against_generic(id, 3, sizeof(fc32_t), 1 / 2048.);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_simd_against_generic_sc4)
+{
+    convert::id_type id;
+    id.num_inputs  = 1;
+    id.num_outputs = 1;
+
+    for (const std::string wire : {"sc4_item32_le", "sc4_item32_be", "sc4_chdr"}) {
+        id.input_format  = "fc32";
+        id.output_format = wire;
+        test_convert_simd_against_generic(id, sizeof(fc32_t), 1, 8.);
+        std::swap(id.input_format, id.output_format);
+        test_convert_simd_against_generic(id, 1, sizeof(fc32_t), 1 / 8.);
+
+        id.input_format  = "sc16";
+        id.output_format = wire;
+        test_convert_simd_against_generic(id, sizeof(sc16_t), 1, 1.);
+        std::swap(id.input_format, id.output_format);
+        test_convert_simd_against_generic(id, 1, sizeof(sc16_t), 1.);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_types_sc16_and_sc4)
+{
+    convert::id_type id;
+    id.num_inputs  = 1;
+    id.num_outputs = 1;
+
+    const size_t max_nsamps = 64;
+    // sc4 keeps the 4 most significant bits, so these survive the loopback
+    std::vector<sc16_t> input(max_nsamps);
+    for (size_t i = 0; i < max_nsamps; i++) {
+        input[i] = sc16_t(int16_t((i % 16) << 12), int16_t(((i / 4) % 16) << 12));
+    }
+    input[1] = sc16_t(0x1000, 0x7000);
+    input[2] = sc16_t(-32768, -4096);
+
+    for (const std::string wire : {"sc4_item32_le", "sc4_item32_be", "sc4_chdr"}) {
+        for (const int prio : {0, 3, 4, 5}) {
+            id.input_format  = "sc16";
+            id.output_format = wire;
+            convert::function_type make_pack, make_unpack;
+            try {
+                make_pack = convert::get_converter(id, prio);
+                std::swap(id.input_format, id.output_format);
+                make_unpack = convert::get_converter(id, prio);
+            } catch (const uhd::key_error&) {
+                continue;
+            }
+            convert::converter::sptr pack   = make_pack();
+            convert::converter::sptr unpack = make_unpack();
+            pack->set_scalar(1.);
+            unpack->set_scalar(1.);
+
+            for (size_t nsamps = 1; nsamps < max_nsamps; nsamps++) {
+                std::vector<uint32_t> packed(max_nsamps / 4);
+                std::vector<sc16_t> output(max_nsamps);
+                pack->conv(&input[0], &packed[0], nsamps);
+                unpack->conv(&packed[0], &output[0], nsamps);
+                BOOST_CHECK_MESSAGE(
+                    std::equal(input.begin(), input.begin() + nsamps, output.begin()),
+                    wire << " prio " << prio << " nsamps " << nsamps);
+                // The first item32 holds I0Q0 in its most significant byte
+                const uint32_t expected = (wire == "sc4_item32_le")
+                                              ? uhd::htowx<uint32_t>(0x00178F30)
+                                              : uhd::htonx<uint32_t>(0x00178F30);
+                if (nsamps >= 4) {
+                    BOOST_CHECK_EQUAL(packed[0], expected);
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_iq_correction)
+{
+    convert::id_type id;
+    id.num_inputs    = 1;
+    id.output_format = "fc32";
+    id.num_outputs   = 1;
+
+    const size_t max_nsamps = 100;
+    std::vector<uint32_t> input(max_nsamps);
+    for (uint32_t& in : input) {
+        in = uint32_t(std::rand()) ^ (uint32_t(std::rand()) << 16);
+    }
+    const double scalar = 1 / 32767.;
+
+    convert::iq_correction_t correction = convert::iq_correction_t::from_iq_balance(
+        {0.01, -0.02}, {0.001, -0.002}, 1.5);
+    correction.matrix[0][1] = 0.03;
+
+    for (const std::string wire : {"sc16_item32_le", "sc16_item32_be", "sc16_chdr"}) {
+        id.input_format = wire;
+        convert::converter::sptr plain = convert::get_converter(id, 0)();
+        plain->set_scalar(scalar);
+        std::vector<fc32_t> expected(max_nsamps);
+        plain->conv(&input[0], &expected[0], max_nsamps);
+        const auto& m = correction.matrix;
+        for (fc32_t& sample : expected) {
+            const double re = sample.real() - correction.dc_offset.real();
+            const double im = sample.imag() - correction.dc_offset.imag();
+            sample          = fc32_t(float(m[0][0] * re + m[0][1] * im),
+                float(m[1][0] * re + m[1][1] * im));
+        }
+
+        for (const int prio : {0, 3}) {
+            convert::function_type make;
+            try {
+                make = convert::get_converter(convert::get_iq_correcting_id(id), prio);
+            } catch (const uhd::key_error&) {
+                continue;
+            }
+            auto converter =
+                std::dynamic_pointer_cast<convert::iq_correcting_converter>(make());
+            BOOST_REQUIRE(converter);
+            converter->set_scalar(scalar);
+            converter->set_iq_correction(correction);
+
+            for (size_t nsamps = 1; nsamps < max_nsamps; nsamps++) {
+                std::vector<fc32_t> output(max_nsamps);
+                converter->conv(&input[0], &output[0], nsamps);
+                bool match = true;
+                for (size_t i = 0; i < nsamps; i++) {
+                    match = match and std::abs(output[i] - expected[i]) < 1e-5;
+                }
+                BOOST_CHECK_MESSAGE(
+                    match, wire << " prio " << prio << " nsamps " << nsamps);
+            }
+        }
+    }
+
+    BOOST_CHECK(convert::iq_correction_t().is_identity());
+    BOOST_CHECK(!correction.is_identity());
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_kernel)
+{
+    convert::id_type id;
+    id.input_format  = "fc32";
+    id.num_inputs    = 1;
+    id.output_format = "sc16_item32_le";
+    id.num_outputs   = 1;
+
+    // a cached lookup must give the same result as the first one
+    BOOST_CHECK_EQUAL(convert::get_converter(id, 0)()->get_kernel(),
+        convert::get_converter(id, 0)()->get_kernel());
+
+    for (const int prio : {-1, 0}) {
+        convert::converter::sptr c = convert::get_converter(id, prio)();
+        c->set_scalar(32767.);
+        const convert::converter::kernel_type kernel = c->get_kernel();
+
+        const size_t nsamps = 35;
+        std::vector<fc32_t> input(nsamps, fc32_t(0.5f, -0.25f));
+        std::vector<uint32_t> output0(nsamps), output1(nsamps);
+        c->conv(&input[0], &output0[0], nsamps);
+        kernel(c.get(), &input[0], &output1[0], nsamps);
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            output0.begin(), output0.end(), output1.begin(), output1.end());
+
+        // the kernel must pick up a new scale factor
+        c->set_scalar(16384.);
+        c->conv(&input[0], &output0[0], nsamps);
+        kernel(c.get(), &input[0], &output1[0], nsamps);
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            output0.begin(), output0.end(), output1.begin(), output1.end());
+    }
+}
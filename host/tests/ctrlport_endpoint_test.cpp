@@ -0,0 +1,309 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhdlib/rfnoc/clock_iface.hpp>
+#include <uhdlib/rfnoc/ctrlport_endpoint.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
+using namespace uhd::rfnoc;
+using namespace uhd::rfnoc::chdr;
+
+namespace {
+
+constexpr sep_id_t MY_EPID      = 2;
+constexpr uint16_t LOCAL_PORT   = 1;
+constexpr size_t BUFF_CAPACITY  = 64;
+constexpr size_t MAX_ASYNC_MSGS = 1;
+
+/*!
+ * Records the control requests sent by the endpoint, and lets the test send
+ * back responses for them
+ */
+class mock_ctrlport_device
+{
+public:
+    mock_ctrlport_device() : _client_clk("client", 100e6), _timebase_clk("tb", 100e6)
+    {
+        _client_clk.set_running(true);
+        _timebase_clk.set_running(true);
+        _ep = ctrlport_endpoint::make(
+            [this](const ctrl_payload& request, double) {
+                std::lock_guard<std::mutex> l(_mutex);
+                _requests.push_back(request);
+            },
+            MY_EPID,
+            LOCAL_PORT,
+            BUFF_CAPACITY,
+            MAX_ASYNC_MSGS,
+            _client_clk,
+            _timebase_clk);
+    }
+
+    ctrlport_endpoint& ep()
+    {
+        return *_ep;
+    }
+
+    size_t num_requests()
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _requests.size();
+    }
+
+    ctrl_payload request(const size_t index)
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _requests.at(index);
+    }
+
+    //! Respond to the oldest request. Reads return the address plus one.
+    void respond(const ctrl_status_t status = CMD_OKAY)
+    {
+        ctrl_payload response = pop_request();
+        response.is_ack = true;
+        response.status = status;
+        if (response.op_code == OP_READ) {
+            response.data_vtr[0] = response.address + 1;
+        }
+        _ep->handle_recv(response);
+    }
+
+    //! Throw away the oldest request, as though its response was lost
+    void drop()
+    {
+        pop_request();
+    }
+
+private:
+    ctrl_payload pop_request()
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        ctrl_payload request = _requests.front();
+        _requests.pop_front();
+        return request;
+    }
+
+    clock_iface _client_clk;
+    clock_iface _timebase_clk;
+    std::mutex _mutex;
+    std::deque<ctrl_payload> _requests;
+    ctrlport_endpoint::sptr _ep;
+};
+
+template <typename T>
+bool is_ready(const std::future<T>& future)
+{
+    return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_peek_poke_async)
+{
+    mock_ctrlport_device dev;
+    constexpr size_t NUM_PEEKS = 8;
+
+    // All requests go out before any response has come back
+    std::vector<std::future<uint32_t>> peeks;
+    for (size_t i = 0; i < NUM_PEEKS; i++) {
+        peeks.push_back(dev.ep().peek32_async(i * 4));
+    }
+    auto poke = dev.ep().poke32_async(0x100, 42);
+    BOOST_CHECK_EQUAL(dev.num_requests(), NUM_PEEKS + 1);
+    for (const auto& peek : peeks) {
+        BOOST_CHECK(!is_ready(peek));
+    }
+    BOOST_CHECK(!is_ready(poke));
+
+    for (size_t i = 0; i < NUM_PEEKS; i++) {
+        dev.respond();
+        BOOST_REQUIRE(is_ready(peeks[i]));
+        BOOST_CHECK_EQUAL(peeks[i].get(), i * 4 + 1);
+    }
+    dev.respond();
+    BOOST_REQUIRE(is_ready(poke));
+    BOOST_CHECK_NO_THROW(poke.get());
+}
+
+BOOST_AUTO_TEST_CASE(test_peek_async_errors)
+{
+    mock_ctrlport_device dev;
+
+    auto failed  = dev.ep().peek32_async(0x10);
+    auto dropped = dev.ep().peek32_async(0x14);
+    auto good    = dev.ep().peek32_async(0x18);
+
+    dev.respond(CMD_CMDERR);
+    dev.drop();
+    // The response for the third request also reveals the dropped one
+    dev.respond();
+
+    BOOST_REQUIRE(is_ready(failed));
+    BOOST_CHECK_THROW(failed.get(), uhd::op_failed);
+    BOOST_REQUIRE(is_ready(dropped));
+    BOOST_CHECK_THROW(dropped.get(), uhd::op_seqerr);
+    BOOST_REQUIRE(is_ready(good));
+    BOOST_CHECK_EQUAL(good.get(), 0x19);
+}
+
+BOOST_AUTO_TEST_CASE(test_peek_async_timeout)
+{
+    mock_ctrlport_device dev;
+    dev.ep().set_policy("default", uhd::device_addr_t("timeout=0.01"));
+
+    auto peek = dev.ep().peek32_async(0x10);
+    dev.drop();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // Expired transactions fail when the next one is issued
+    auto poke = dev.ep().poke32_async(0x20, 1);
+    BOOST_REQUIRE(is_ready(peek));
+    BOOST_CHECK_THROW(peek.get(), uhd::op_timeout);
+
+    dev.respond();
+    BOOST_REQUIRE(is_ready(poke));
+    BOOST_CHECK_NO_THROW(poke.get());
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_writes)
+{
+    mock_ctrlport_device dev;
+    const uhd::time_spec_t cmd_time(1.0);
+
+    dev.ep().begin_batch();
+    dev.ep().poke32(0x10, 1, cmd_time);
+    dev.ep().poke32(0x14, 2, cmd_time);
+    dev.ep().poke32(0x20, 3);
+    BOOST_CHECK_EQUAL(dev.num_requests(), 0);
+    dev.ep().end_batch();
+
+    // Without block writes, every write is its own packet, but only the first
+    // one needs the timestamp
+    BOOST_REQUIRE_EQUAL(dev.num_requests(), 3);
+    BOOST_CHECK_EQUAL(dev.request(0).op_code, OP_WRITE);
+    BOOST_CHECK(dev.request(0).has_timestamp());
+    BOOST_CHECK(!dev.request(1).has_timestamp());
+    BOOST_CHECK(!dev.request(2).has_timestamp());
+    BOOST_CHECK_EQUAL(dev.request(2).address, 0x20);
+    BOOST_CHECK_EQUAL(dev.request(2).data_vtr[0], 3);
+
+    BOOST_CHECK_THROW(dev.ep().end_batch(), uhd::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_block_writes)
+{
+    mock_ctrlport_device dev;
+    dev.ep().set_policy("default", uhd::device_addr_t("block_writes=1"));
+
+    // Nested batches are sent when the outermost one ends
+    dev.ep().begin_batch();
+    dev.ep().begin_batch();
+    for (uint32_t i = 0; i < 4; i++) {
+        dev.ep().poke32(0x100 + i * 4, i);
+    }
+    dev.ep().end_batch();
+    dev.ep().poke32(0x200, 4);
+    BOOST_CHECK_EQUAL(dev.num_requests(), 0);
+    dev.ep().end_batch();
+
+    BOOST_REQUIRE_EQUAL(dev.num_requests(), 2);
+    BOOST_CHECK_EQUAL(dev.request(0).op_code, OP_BLOCK_WRITE);
+    BOOST_CHECK_EQUAL(dev.request(0).address, 0x100);
+    BOOST_CHECK_EQUAL(dev.request(0).data_vtr.size(), 4);
+    BOOST_CHECK_EQUAL(dev.request(0).data_vtr[3], 3);
+    BOOST_CHECK_EQUAL(dev.request(1).op_code, OP_WRITE);
+    BOOST_CHECK_EQUAL(dev.request(1).address, 0x200);
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_flush_on_read)
+{
+    mock_ctrlport_device dev;
+
+    dev.ep().begin_batch();
+    dev.ep().poke32(0x10, 1);
+    auto peek = dev.ep().peek32_async(0x10);
+
+    // The read must see the write, so the batch goes out first
+    BOOST_REQUIRE_EQUAL(dev.num_requests(), 2);
+    BOOST_CHECK_EQUAL(dev.request(0).op_code, OP_WRITE);
+    BOOST_CHECK_EQUAL(dev.request(1).op_code, OP_READ);
+    dev.ep().end_batch();
+    BOOST_CHECK_EQUAL(dev.num_requests(), 2);
+
+    dev.drop();
+    dev.respond();
+    BOOST_REQUIRE(is_ready(peek));
+    BOOST_CHECK_EQUAL(peek.get(), 0x11);
+}
+
+BOOST_AUTO_TEST_CASE(test_held_writes)
+{
+    mock_ctrlport_device dev;
+    // Leaves room for two timed writes of five words each (six words are
+    // reserved for an async message)
+    dev.ep().set_policy(
+        "default", uhd::device_addr_t("buff_capacity=20,max_held_cmds=4"));
+    const uhd::time_spec_t cmd_time(1.0);
+
+    // None of these block, even though the command buffer is full
+    for (uint32_t i = 0; i < 5; i++) {
+        dev.ep().poke32(0x10, i, cmd_time + i * 0.1);
+    }
+    BOOST_CHECK_EQUAL(dev.num_requests(), 2);
+
+    // The held writes go out in order as the command buffer drains
+    for (uint32_t i = 0; i < 5; i++) {
+        for (int j = 0; j < 100 && dev.num_requests() == 0; j++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        BOOST_REQUIRE_GT(dev.num_requests(), 0);
+        BOOST_CHECK_EQUAL(dev.request(0).data_vtr[0], i);
+        dev.respond();
+    }
+
+    // Other transactions wait for held writes, and get sent as usual
+    auto peek = dev.ep().peek32_async(0x10);
+    BOOST_REQUIRE_EQUAL(dev.num_requests(), 1);
+    dev.respond();
+    BOOST_REQUIRE(is_ready(peek));
+    BOOST_CHECK_EQUAL(peek.get(), 0x11);
+}
+
+BOOST_AUTO_TEST_CASE(test_multi_peek_pipelined)
+{
+    mock_ctrlport_device dev;
+    constexpr size_t NUM_PEEKS = 10;
+    std::vector<uint32_t> addrs;
+    for (uint32_t i = 0; i < NUM_PEEKS; i++) {
+        addrs.push_back(0x100 + 0x40 * i);
+    }
+    auto peeks = std::async(
+        std::launch::async, [&dev, &addrs]() { return dev.ep().multi_peek32(addrs); });
+
+    // All reads go out before the first response comes back
+    for (int j = 0; j < 1000 && dev.num_requests() < NUM_PEEKS; j++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_REQUIRE_EQUAL(dev.num_requests(), NUM_PEEKS);
+    for (size_t i = 0; i < NUM_PEEKS; i++) {
+        BOOST_CHECK_EQUAL(dev.request(i).op_code, OP_READ);
+        BOOST_CHECK_EQUAL(dev.request(i).address, addrs[i]);
+    }
+    for (size_t i = 0; i < NUM_PEEKS; i++) {
+        dev.respond();
+    }
+    const auto values = peeks.get();
+    BOOST_REQUIRE_EQUAL(values.size(), NUM_PEEKS);
+    for (size_t i = 0; i < NUM_PEEKS; i++) {
+        BOOST_CHECK_EQUAL(values[i], addrs[i] + 1);
+    }
+}
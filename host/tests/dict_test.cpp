@@ -9,6 +9,9 @@
 #include <boost/assign/list_of.hpp>
 #include <boost/test/unit_test.hpp>
 #include <map>
+#include <ostream>
+#include <string>
+#include <vector>
 
 BOOST_AUTO_TEST_CASE(test_dict_init)
 {
@@ -57,6 +60,19 @@ BOOST_AUTO_TEST_CASE(test_dict_pop)
     BOOST_CHECK(d.keys()[1] == 1);
 }
 
+BOOST_AUTO_TEST_CASE(test_dict_pop_duplicate)
+{
+    const std::vector<std::pair<std::string, int>> pairs{{"a", 1}, {"b", 2}, {"a", 3}};
+    uhd::dict<std::string, int> d(pairs.begin(), pairs.end());
+    BOOST_CHECK_EQUAL(d.pop("a"), 1);
+    BOOST_CHECK(d.has_key("a"));
+    BOOST_CHECK_EQUAL(d["a"], 3);
+    BOOST_CHECK_EQUAL(d.size(), 2);
+    BOOST_CHECK_EQUAL(d.pop("a"), 3);
+    BOOST_CHECK(not d.has_key("a"));
+    BOOST_CHECK_EQUAL(d.size(), 1);
+}
+
 BOOST_AUTO_TEST_CASE(test_dict_update)
 {
     uhd::dict<std::string, std::string> d1 =
@@ -114,3 +130,81 @@ BOOST_AUTO_TEST_CASE(test_dict_equals)
     BOOST_CHECK(not(d0 == d2));
     BOOST_CHECK(not(d0 == d3));
 }
+
+BOOST_AUTO_TEST_CASE(test_dict_copy)
+{
+    uhd::dict<std::string, int> d0;
+    d0["a"] = 1;
+    d0["b"] = 2;
+    // The copies must not share their index with the original
+    uhd::dict<std::string, int> d1(d0);
+    uhd::dict<std::string, int> d2;
+    d2 = d0;
+    d0.pop("a");
+    d0["b"] = 3;
+    BOOST_CHECK(not d0.has_key("a"));
+    BOOST_CHECK_EQUAL(d1["a"], 1);
+    BOOST_CHECK_EQUAL(d1["b"], 2);
+    BOOST_CHECK_EQUAL(d2["a"], 1);
+    BOOST_CHECK_EQUAL(d2["b"], 2);
+
+    uhd::dict<std::string, int> d3(std::move(d1));
+    BOOST_CHECK_EQUAL(d3["a"], 1);
+    BOOST_CHECK_EQUAL(d3.size(), 2);
+    d2 = std::move(d3);
+    BOOST_CHECK_EQUAL(d2["b"], 2);
+    BOOST_CHECK_EQUAL(d3.size(), 0);
+    BOOST_CHECK(not d3.has_key("a"));
+}
+
+BOOST_AUTO_TEST_CASE(test_dict_order)
+{
+    uhd::dict<std::string, int> d;
+    d["c"] = 0;
+    d["a"] = 1;
+    d["b"] = 2;
+    d.pop("a");
+    d["a"] = 3;
+    d["c"] = 4;
+    const std::vector<std::string> keys{"c", "b", "a"};
+    BOOST_CHECK(d.keys() == keys);
+    const std::vector<int> vals{4, 2, 3};
+    BOOST_CHECK(d.vals() == vals);
+}
+
+namespace {
+
+enum class test_enum_t { A, B };
+
+//! A key type that can't be hashed
+struct unhashable_key_t
+{
+    int value;
+    bool operator==(const unhashable_key_t& rhs) const
+    {
+        return value == rhs.value;
+    }
+};
+
+std::ostream& operator<<(std::ostream& out, const unhashable_key_t& key)
+{
+    return out << key.value;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_dict_key_types)
+{
+    uhd::dict<test_enum_t, int> d0;
+    d0[test_enum_t::B] = 1;
+    BOOST_CHECK(d0.has_key(test_enum_t::B));
+    BOOST_CHECK(not d0.has_key(test_enum_t::A));
+
+    uhd::dict<unhashable_key_t, int> d1;
+    d1[unhashable_key_t{5}] = 1;
+    d1[unhashable_key_t{7}] = 2;
+    BOOST_CHECK_EQUAL(d1[unhashable_key_t{7}], 2);
+    BOOST_CHECK_EQUAL(d1.pop(unhashable_key_t{5}), 1);
+    BOOST_CHECK(not d1.has_key(unhashable_key_t{5}));
+    BOOST_CHECK_THROW(d1.get(unhashable_key_t{5}), uhd::key_error);
+}
@@ -0,0 +1,105 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/usrp/common/discovery_cache.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <thread>
+
+using namespace uhd;
+using namespace uhd::usrp;
+
+namespace {
+
+//! Finder that returns one device per call, numbered by the call count
+struct counting_finder_t
+{
+    size_t num_calls = 0;
+
+    device_addrs_t operator()(const device_addr_t& hint)
+    {
+        num_calls++;
+        device_addr_t addr(hint);
+        addr["serial"] = std::to_string(num_calls);
+        return device_addrs_t(1, addr);
+    }
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_discovery_cache_hit)
+{
+    discovery_cache cache;
+    counting_finder_t finder;
+    auto find_fn = [&finder](const device_addr_t& hint) { return finder(hint); };
+
+    const device_addr_t hint("type=x300");
+    const auto addrs = cache.find("x300", hint, find_fn);
+    BOOST_REQUIRE_EQUAL(addrs.size(), 1);
+    BOOST_CHECK_EQUAL(addrs[0]["serial"], "1");
+    BOOST_CHECK_EQUAL(cache.find("x300", hint, find_fn)[0]["serial"], "1");
+    BOOST_CHECK_EQUAL(finder.num_calls, 1);
+
+    // Results are kept per finder and hint
+    BOOST_CHECK_EQUAL(cache.find("b200", hint, find_fn)[0]["serial"], "2");
+    BOOST_CHECK_EQUAL(
+        cache.find("x300", device_addr_t("type=x300,name=foo"), find_fn)[0]["serial"],
+        "3");
+    BOOST_CHECK_EQUAL(finder.num_calls, 3);
+
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.find("x300", hint, find_fn)[0]["serial"], "4");
+}
+
+BOOST_AUTO_TEST_CASE(test_discovery_cache_expiry)
+{
+    discovery_cache cache;
+    counting_finder_t finder;
+    auto find_fn = [&finder](const device_addr_t& hint) { return finder(hint); };
+
+    const device_addr_t hint("find_cache_ttl=0.05");
+    cache.find("mpmd", hint, find_fn);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    BOOST_CHECK_EQUAL(cache.find("mpmd", hint, find_fn)[0]["serial"], "2");
+
+    // A TTL of zero bypasses the cache
+    const device_addr_t uncached_hint("find_cache_ttl=0");
+    cache.find("mpmd", uncached_hint, find_fn);
+    cache.find("mpmd", uncached_hint, find_fn);
+    BOOST_CHECK_EQUAL(finder.num_calls, 4);
+}
+
+BOOST_AUTO_TEST_CASE(test_discovery_cache_skips_empty_results)
+{
+    discovery_cache cache;
+    size_t num_calls = 0;
+    auto find_fn     = [&num_calls](const device_addr_t&) {
+        num_calls++;
+        return device_addrs_t();
+    };
+
+    cache.find("b200", device_addr_t(), find_fn);
+    cache.find("b200", device_addr_t(), find_fn);
+    BOOST_CHECK_EQUAL(num_calls, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_discovery_cache_reentrant)
+{
+    discovery_cache cache;
+    counting_finder_t finder;
+    auto find_fn = [&finder](const device_addr_t& hint) { return finder(hint); };
+
+    // Finders may call back into the cache, e.g. once per interface
+    auto outer_fn = [&](const device_addr_t& hint) {
+        device_addr_t inner_hint(hint);
+        inner_hint["addr"] = "192.168.10.255";
+        return cache.find("x300", inner_hint, find_fn);
+    };
+    const auto addrs = cache.find("x300", device_addr_t(), outer_fn);
+    BOOST_REQUIRE_EQUAL(addrs.size(), 1);
+    BOOST_CHECK_EQUAL(addrs[0]["addr"], "192.168.10.255");
+    BOOST_CHECK_EQUAL(finder.num_calls, 1);
+}
@@ -0,0 +1,157 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/types/serial.hpp>
+#include <uhd/usrp/dboard_eeprom.hpp>
+#include <uhd/utils/paths.hpp>
+#include <uhdlib/usrp/common/eeprom_cache.hpp>
+#include <uhdlib/utils/paths.hpp>
+#include <stdlib.h> // setenv or _putenv
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <iostream>
+#include <map>
+
+using namespace uhd;
+using namespace uhd::usrp;
+namespace fs = boost::filesystem;
+
+namespace {
+
+constexpr uint8_t DB_ADDR = 0x55;
+
+//! An I2C bus with one EEPROM on it, which counts the bytes read from it
+class mock_eeprom_iface : public i2c_iface
+{
+public:
+    void write_i2c(uint16_t, const byte_vector_t&) override {}
+
+    byte_vector_t read_i2c(uint16_t, size_t) override
+    {
+        return byte_vector_t();
+    }
+
+    void write_eeprom(uint16_t addr, uint16_t offset, const byte_vector_t& buf) override
+    {
+        for (size_t i = 0; i < buf.size(); i++) {
+            _contents[addr][offset + i] = buf[i];
+        }
+    }
+
+    byte_vector_t read_eeprom(uint16_t addr, uint16_t offset, size_t num_bytes) override
+    {
+        byte_vector_t bytes(num_bytes, 0xFF);
+        if (_contents.count(addr)) {
+            for (size_t i = 0; i < num_bytes; i++) {
+                bytes[i] = _contents[addr][offset + i];
+            }
+        }
+        num_bytes_read += num_bytes;
+        return bytes;
+    }
+
+    size_t num_bytes_read = 0;
+
+private:
+    std::map<uint16_t, std::map<size_t, uint8_t>> _contents;
+};
+
+//! Point the cache at a temporary directory, returns false if that didn't work
+bool use_tmp_cache_dir()
+{
+    const fs::path cache_path = fs::path(uhd::get_tmp_path()) / "EEPROM_CACHE_TEST";
+    boost::system::error_code ec;
+    fs::remove_all(cache_path, ec);
+#ifdef UHD_PLATFORM_WIN32
+    const std::string putenv_str = std::string("XDG_CACHE_HOME=") + cache_path.string();
+    _putenv(putenv_str.c_str());
+#else
+    setenv("XDG_CACHE_HOME", cache_path.string().c_str(), /* overwrite */ 1);
+#endif
+    if (uhd::get_xdg_cache_home() != cache_path) {
+        std::cout << "WARNING: Unable to update XDG_CACHE_HOME! Skipping test."
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+
+dboard_eeprom_t make_db_eeprom(const std::string& serial)
+{
+    dboard_eeprom_t eeprom;
+    eeprom.id       = dboard_id_t::from_uint16(0x0077);
+    eeprom.serial   = serial;
+    eeprom.revision = "3";
+    return eeprom;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_eeprom_cache_entries)
+{
+    if (!use_tmp_cache_dir()) {
+        return;
+    }
+    const byte_vector_t stamp{1, 2, 3};
+    const byte_vector_t contents{0xDE, 0xAD, 0xBE, 0xEF};
+
+    BOOST_CHECK(!eeprom_cache::get("test-1", stamp));
+    eeprom_cache::put("test-1", stamp, contents);
+    eeprom_cache::put("test-2", stamp, byte_vector_t());
+    auto cached = eeprom_cache::get("test-1", stamp);
+    BOOST_REQUIRE(cached);
+    BOOST_CHECK(*cached == contents);
+    cached = eeprom_cache::get("test-2", stamp);
+    BOOST_REQUIRE(cached);
+    BOOST_CHECK(cached->empty());
+
+    // A different stamp means the EEPROM changed
+    BOOST_CHECK(!eeprom_cache::get("test-1", byte_vector_t{1, 2, 4}));
+
+    eeprom_cache::invalidate("test-1");
+    BOOST_CHECK(!eeprom_cache::get("test-1", stamp));
+    BOOST_CHECK(eeprom_cache::get("test-2", stamp));
+    eeprom_cache::invalidate("test-");
+    BOOST_CHECK(!eeprom_cache::get("test-2", stamp));
+}
+
+BOOST_AUTO_TEST_CASE(test_eeprom_cache_dboard)
+{
+    if (!use_tmp_cache_dir()) {
+        return;
+    }
+    mock_eeprom_iface iface;
+    make_db_eeprom("ABCDEF").store(iface, DB_ADDR);
+
+    dboard_eeprom_t eeprom;
+    eeprom_cache::load_dboard_eeprom(eeprom, iface, DB_ADDR, "test-db55");
+    BOOST_CHECK_EQUAL(eeprom.id.to_uint16(), 0x0077);
+    BOOST_CHECK_EQUAL(eeprom.serial, "ABCDEF");
+    BOOST_CHECK_EQUAL(eeprom.revision, "3");
+    const size_t uncached_bytes = iface.num_bytes_read;
+
+    // The second load only reads the magic byte, the serial, and the checksum
+    iface.num_bytes_read = 0;
+    dboard_eeprom_t cached_eeprom;
+    eeprom_cache::load_dboard_eeprom(cached_eeprom, iface, DB_ADDR, "test-db55");
+    BOOST_CHECK_EQUAL(cached_eeprom.id.to_uint16(), 0x0077);
+    BOOST_CHECK_EQUAL(cached_eeprom.serial, "ABCDEF");
+    BOOST_CHECK_EQUAL(cached_eeprom.revision, "3");
+    BOOST_CHECK_LT(iface.num_bytes_read, uncached_bytes - 16);
+
+    // Reprogramming the EEPROM behind the cache's back changes the stamp
+    make_db_eeprom("GHIJKL").store(iface, DB_ADDR);
+    eeprom_cache::load_dboard_eeprom(eeprom, iface, DB_ADDR, "test-db55");
+    BOOST_CHECK_EQUAL(eeprom.serial, "GHIJKL");
+
+    // Empty slots cost a single byte, and match dboard_eeprom_t::load()
+    iface.num_bytes_read = 0;
+    eeprom_cache::load_dboard_eeprom(eeprom, iface, DB_ADDR + 1, "test-db56");
+    BOOST_CHECK(eeprom.id == dboard_id_t::none());
+    BOOST_CHECK_EQUAL(eeprom.serial, "");
+    BOOST_CHECK_EQUAL(iface.num_bytes_read, 1);
+    eeprom_cache::invalidate("test-");
+}
@@ -129,3 +129,28 @@ BOOST_AUTO_TEST_CASE(test_unknown_exception)
     BOOST_CHECK_EQUAL(error_code, UHD_ERROR_UNKNOWN);
     BOOST_CHECK_EQUAL(handle.last_error, "Unrecognized exception caught.");
 }
+
+UHD_INLINE uhd_error fast_call(dummy_handle_t* handle, const bool fail)
+{
+    UHD_SAFE_C_SAVE_ERROR_FAST(
+        handle, if (fail) { throw uhd::value_error("This is a fast failure."); })
+}
+
+BOOST_AUTO_TEST_CASE(test_fast_save_error)
+{
+    dummy_handle_t handle;
+    set_c_global_error_string("Untouched");
+
+    // Successful calls don't touch the global error string
+    BOOST_CHECK_EQUAL(fast_call(&handle, false), UHD_ERROR_NONE);
+    BOOST_CHECK(handle.last_error.empty());
+    BOOST_CHECK_EQUAL(get_c_global_error_string(), "Untouched");
+
+    BOOST_CHECK_EQUAL(fast_call(&handle, true), UHD_ERROR_VALUE);
+    BOOST_CHECK_EQUAL(handle.last_error, "ValueError: This is a fast failure.");
+    BOOST_CHECK_EQUAL(get_c_global_error_string(), handle.last_error);
+
+    // The handle's error is cleared by the next successful call
+    BOOST_CHECK_EQUAL(fast_call(&handle, false), UHD_ERROR_NONE);
+    BOOST_CHECK(handle.last_error.empty());
+}
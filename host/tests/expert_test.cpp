@@ -142,6 +142,36 @@ private:
 
 //=============================================================================
 
+class incr_worker_t : public worker_node_t
+{
+public:
+    incr_worker_t(const node_retriever_t& db,
+        const std::string& input,
+        const std::string& output,
+        std::shared_ptr<int> num_resolves)
+        : worker_node_t(input + "+1=" + output)
+        , _in(db, input)
+        , _out(db, output)
+        , _num_resolves(num_resolves)
+    {
+        bind_accessor(_in);
+        bind_accessor(_out);
+    }
+
+private:
+    void resolve()
+    {
+        _out = _in + 1;
+        (*_num_resolves)++;
+    }
+
+    data_reader_t<int> _in;
+    data_writer_t<int> _out;
+    std::shared_ptr<int> _num_resolves;
+};
+
+//=============================================================================
+
 #define DUMP_VARS                                                                     \
     BOOST_TEST_MESSAGE(str(                                                           \
         boost::format(                                                                \
@@ -265,3 +295,56 @@ BOOST_AUTO_TEST_CASE(test_experts)
     container->resolve_to("Consume_G");
     VALIDATE_ALL_DEPENDENCIES
 }
+
+BOOST_AUTO_TEST_CASE(test_experts_incremental)
+{
+    expert_container::sptr container = expert_factory::create_container("incremental");
+    uhd::property_tree::sptr tree    = uhd::property_tree::make();
+    auto num_x_resolves              = std::make_shared<int>(0);
+    auto num_y_resolves              = std::make_shared<int>(0);
+
+    // Two independent chains: X -> X1 -> X2 and Y -> Y1
+    expert_factory::add_prop_node<int>(
+        container, tree, "X", 0, uhd::experts::AUTO_RESOLVE_ON_WRITE);
+    expert_factory::add_data_node<int>(container, "X1", 0);
+    expert_factory::add_prop_node<int>(
+        container, tree, "X2", 0, uhd::experts::AUTO_RESOLVE_ON_READ);
+    expert_factory::add_prop_node<int>(container, tree, "Y", 0);
+    expert_factory::add_prop_node<int>(
+        container, tree, "Y1", 0, uhd::experts::AUTO_RESOLVE_ON_READ);
+    expert_factory::add_worker_node<incr_worker_t>(
+        container, container->node_retriever(), "X", "X1", num_x_resolves);
+    expert_factory::add_worker_node<incr_worker_t>(
+        container, container->node_retriever(), "X1", "X2", num_x_resolves);
+    expert_factory::add_worker_node<incr_worker_t>(
+        container, container->node_retriever(), "Y", "Y1", num_y_resolves);
+    container->resolve_all();
+    BOOST_CHECK_EQUAL(*num_x_resolves, 2);
+    BOOST_CHECK_EQUAL(*num_y_resolves, 1);
+
+    // Writing X only resolves its own chain, even if Y is dirty
+    tree->access<int>("Y").set(10);
+    tree->access<int>("X").set(5);
+    BOOST_CHECK_EQUAL(*num_x_resolves, 4);
+    BOOST_CHECK_EQUAL(*num_y_resolves, 1);
+    BOOST_CHECK_EQUAL(tree->access<int>("X2").get(), 7);
+    BOOST_CHECK_EQUAL(*num_x_resolves, 4);
+
+    // Reading Y1 resolves its upstream cone
+    BOOST_CHECK_EQUAL(tree->access<int>("Y1").get(), 11);
+    BOOST_CHECK_EQUAL(*num_y_resolves, 2);
+    BOOST_CHECK_EQUAL(tree->access<int>("Y1").get(), 11);
+    BOOST_CHECK_EQUAL(*num_y_resolves, 2);
+
+    // Changing the graph updates the order: X2 now feeds X3
+    expert_factory::add_data_node<int>(container, "X3", 0);
+    expert_factory::add_worker_node<incr_worker_t>(
+        container, container->node_retriever(), "X2", "X3", num_x_resolves);
+    tree->access<int>("X").set(6);
+    BOOST_CHECK_EQUAL(*num_x_resolves, 7);
+    BOOST_CHECK_EQUAL(
+        dynamic_cast<const data_node_t<int>&>(container->node_retriever().lookup("X3"))
+            .get(),
+        9);
+    BOOST_CHECK_EQUAL(*num_y_resolves, 2);
+}
@@ -121,3 +121,26 @@ BOOST_AUTO_TEST_CASE(test_gain_group_priority)
     // test the the higher priority gain got filled first (gain 2)
     BOOST_CHECK_CLOSE(g2.get_value(), g2.get_range().stop(), tolerance);
 }
+
+BOOST_AUTO_TEST_CASE(test_gain_group_table)
+{
+    gain_group::sptr gg = get_gain_group();
+
+    // Distributions are looked up after the first time, and don't change
+    for (double gain : {80.0, 35.5, 80.0, -7.3, 35.5}) {
+        gg->set_value(gain);
+        BOOST_CHECK_CLOSE(gg->get_value(), gain, tolerance);
+        BOOST_CHECK_CLOSE(g1.get_value() + g2.get_value(), gain, tolerance);
+    }
+    gg->set_value(35.5);
+    const double g1_gain = g1.get_value();
+    gg->set_value(80.0);
+    gg->set_value(35.5);
+    BOOST_CHECK_CLOSE(g1.get_value(), g1_gain, tolerance);
+
+    // Gains off the step grid and outside the range still get distributed
+    gg->set_value(35.52);
+    BOOST_CHECK_CLOSE(gg->get_value(), 35.5, tolerance);
+    gg->set_value(200.0);
+    BOOST_CHECK_CLOSE(gg->get_value(), 100.0, tolerance);
+}
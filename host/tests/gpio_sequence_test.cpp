@@ -0,0 +1,56 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/rfnoc/gpio_sequence.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace uhd::rfnoc;
+using namespace uhd::rfnoc::detail;
+
+using entry_t = radio_control::gpio_sequence_entry_t;
+
+BOOST_AUTO_TEST_CASE(test_gpio_sequence_sort)
+{
+    const std::vector<entry_t> sequence{{uhd::time_spec_t(2.0), "FP0", 0x1, 0x1},
+        {uhd::time_spec_t(1.0), "FP0", 0x1, 0x0},
+        {uhd::time_spec_t::ASAP, "FP0", 0x1, 0x1}};
+    const auto groups = coalesce_gpio_sequence(sequence);
+    BOOST_REQUIRE_EQUAL(groups.size(), 3);
+    BOOST_CHECK(groups[0].time == uhd::time_spec_t::ASAP);
+    BOOST_CHECK(groups[1].time == uhd::time_spec_t(1.0));
+    BOOST_CHECK(groups[2].time == uhd::time_spec_t(2.0));
+    BOOST_CHECK_EQUAL(groups[1].writes.at(0).value, 0x0);
+    BOOST_CHECK_EQUAL(groups[2].writes.at(0).value, 0x1);
+}
+
+BOOST_AUTO_TEST_CASE(test_gpio_sequence_coalesce)
+{
+    const uhd::time_spec_t time(1.5);
+    const std::vector<entry_t> sequence{{time, "FP0", 0x0F, 0xFF},
+        {time, "FP0", 0xF0, 0xA0},
+        {time, "FP0", 0x03, 0x00},
+        {time, "FP0", 0x01, 0x01, "ATR_TX"},
+        {time, "RXA", 0x01, 0x01},
+        {time, "FP0", 0x00, 0xFF}};
+    const auto groups = coalesce_gpio_sequence(sequence);
+    BOOST_REQUIRE_EQUAL(groups.size(), 1);
+    const auto& writes = groups[0].writes;
+    BOOST_REQUIRE_EQUAL(writes.size(), 3);
+    // The later entry wins
+    BOOST_CHECK_EQUAL(writes[0].bank, "FP0");
+    BOOST_CHECK_EQUAL(writes[0].attr, "OUT");
+    BOOST_CHECK_EQUAL(writes[0].mask, 0xFF);
+    BOOST_CHECK_EQUAL(writes[0].value, 0xAC);
+    BOOST_CHECK_EQUAL(writes[1].attr, "ATR_TX");
+    BOOST_CHECK_EQUAL(writes[1].value, 0x01);
+    BOOST_CHECK_EQUAL(writes[2].bank, "RXA");
+}
+
+BOOST_AUTO_TEST_CASE(test_gpio_sequence_empty)
+{
+    BOOST_CHECK(coalesce_gpio_sequence({}).empty());
+    BOOST_CHECK(coalesce_gpio_sequence({{uhd::time_spec_t(1.0), "FP0", 0, 1}}).empty());
+}
@@ -0,0 +1,55 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/rfnoc/graph_snapshot.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace uhd::rfnoc;
+
+BOOST_AUTO_TEST_CASE(test_graph_snapshot_round_trip)
+{
+    graph_snapshot_t snapshot;
+    graph_edge_t edge0(0, 1, graph_edge_t::DYNAMIC, true);
+    edge0.src_blockid = "0/Radio#0";
+    edge0.dst_blockid = "0/DDC#0";
+    graph_edge_t edge1(1, 0, graph_edge_t::STATIC, false);
+    edge1.src_blockid = "0/DDC#0";
+    edge1.dst_blockid = "1/Replay#0";
+    snapshot.edges = {edge0, edge1};
+    snapshot.properties.push_back({"0/DDC#0", "freq", 1, "1.2345678901234567e+06"});
+    snapshot.properties.push_back({"0/Radio#0", "label", 0, "two  words "});
+    snapshot.properties.push_back({"0/Radio#0", "empty", 0, ""});
+
+    const graph_snapshot_t result = graph_snapshot_t::from_string(snapshot.to_string());
+    BOOST_REQUIRE_EQUAL(result.edges.size(), 2);
+    BOOST_CHECK(result.edges[0] == edge0);
+    BOOST_CHECK(result.edges[1] == edge1);
+    BOOST_REQUIRE_EQUAL(result.properties.size(), 3);
+    for (size_t i = 0; i < result.properties.size(); i++) {
+        BOOST_CHECK(result.properties[i] == snapshot.properties[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_graph_snapshot_errors)
+{
+    BOOST_CHECK_THROW(graph_snapshot_t::from_string(""), uhd::value_error);
+    BOOST_CHECK_THROW(
+        graph_snapshot_t::from_string("uhd_graph_snapshot 2\n"), uhd::value_error);
+    BOOST_CHECK_THROW(graph_snapshot_t::from_string(
+                          "uhd_graph_snapshot 1\nedge 0/Radio#0 0 0/DDC#0 0 static\n"),
+        uhd::value_error);
+    BOOST_CHECK_THROW(graph_snapshot_t::from_string(
+                          "uhd_graph_snapshot 1\nedge 0/Radio#0 0 0/DDC#0 0 stream 1\n"),
+        uhd::value_error);
+    BOOST_CHECK_THROW(graph_snapshot_t::from_string("uhd_graph_snapshot 1\nfoo bar\n"),
+        uhd::value_error);
+
+    // Streamer connections can't be part of a snapshot
+    graph_snapshot_t snapshot;
+    snapshot.edges.emplace_back(0, 0, graph_edge_t::RX_STREAM, true);
+    BOOST_CHECK_THROW(snapshot.to_string(), uhd::value_error);
+}
@@ -0,0 +1,108 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/transport/hybrid_wait.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <thread>
+
+using namespace uhd::transport;
+using namespace std::chrono;
+
+BOOST_AUTO_TEST_CASE(test_hybrid_wait_block_only)
+{
+    hybrid_wait wait;
+    size_t num_tries      = 0;
+    int32_t block_timeout = 0;
+    const bool result     = wait.wait([&num_tries]() { return ++num_tries > 10; },
+        [&block_timeout](const int32_t timeout) {
+            block_timeout = timeout;
+            return true;
+        },
+        25);
+    BOOST_CHECK(result);
+    BOOST_CHECK_EQUAL(num_tries, 0);
+    BOOST_CHECK_EQUAL(block_timeout, 25);
+    BOOST_CHECK_EQUAL(wait.get_spin_budget().count(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_hybrid_wait_spin)
+{
+    hybrid_wait wait(1000000);
+    BOOST_CHECK(wait.get_spin_budget() == microseconds(1000000));
+
+    // The result shows up while spinning, so there's no need to block
+    size_t num_tries  = 0;
+    bool blocked      = false;
+    const bool result = wait.wait([&num_tries]() { return ++num_tries == 10; },
+        [&blocked](const int32_t) {
+            blocked = true;
+            return false;
+        },
+        -1);
+    BOOST_CHECK(result);
+    BOOST_CHECK_EQUAL(num_tries, 10);
+    BOOST_CHECK(!blocked);
+
+    // Without a timeout, the wait only tries once
+    num_tries = 0;
+    BOOST_CHECK(!wait.wait([&num_tries]() { return ++num_tries == 10; },
+        [&blocked](const int32_t) {
+            blocked = true;
+            return false;
+        },
+        0));
+    BOOST_CHECK_EQUAL(num_tries, 1);
+    BOOST_CHECK(!blocked);
+}
+
+BOOST_AUTO_TEST_CASE(test_hybrid_wait_adapts)
+{
+    constexpr size_t MAX_SPIN_US = 2000;
+    hybrid_wait wait(MAX_SPIN_US);
+    auto always       = []() { return true; };
+    auto block_always = [](const int32_t) { return true; };
+
+    // Results that come in quickly shrink the spin budget
+    for (size_t i = 0; i < 100; i++) {
+        wait.wait(always, block_always, -1);
+    }
+    BOOST_CHECK(wait.get_spin_budget() < microseconds(MAX_SPIN_US / 2));
+
+    // Results that come in further apart than the largest budget stop the
+    // spinning altogether
+    for (size_t i = 0; i < 30; i++) {
+        std::this_thread::sleep_for(microseconds(2 * MAX_SPIN_US));
+        wait.wait(always, block_always, -1);
+    }
+    BOOST_CHECK_EQUAL(wait.get_spin_budget().count(), 0);
+
+    // The budget grows again when the stream speeds up
+    for (size_t i = 0; i < 100; i++) {
+        wait.wait(always, block_always, -1);
+    }
+    BOOST_CHECK(wait.get_spin_budget().count() > 0);
+    BOOST_CHECK(wait.get_spin_budget() < microseconds(MAX_SPIN_US / 2));
+}
+
+BOOST_AUTO_TEST_CASE(test_hybrid_wait_timeout)
+{
+    hybrid_wait wait(5000);
+    int32_t block_timeout = -1;
+    const auto start_time = steady_clock::now();
+    const bool result     = wait.wait([]() { return false; },
+        [&block_timeout](const int32_t timeout) {
+            block_timeout = timeout;
+            return false;
+        },
+        100);
+    BOOST_CHECK(!result);
+    BOOST_CHECK(steady_clock::now() - start_time >= microseconds(5000));
+
+    // The time spent spinning counts against the timeout
+    BOOST_CHECK_LE(block_timeout, 95);
+    BOOST_CHECK_GE(block_timeout, 0);
+}
@@ -0,0 +1,103 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/utils/init_timeline.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace uhd;
+
+namespace {
+
+std::string dump_timeline()
+{
+    const auto path = boost::filesystem::temp_directory_path()
+                      / boost::filesystem::unique_path("init_timeline_%%%%-%%%%.json");
+    init_timeline::dump(path.string());
+    std::ifstream in(path.string());
+    std::stringstream contents;
+    contents << in.rdbuf();
+    in.close();
+    boost::filesystem::remove(path);
+    return contents.str();
+}
+
+bool has_event(const std::string& json,
+    const std::string& name,
+    const bool parallel,
+    const std::string& parent = "")
+{
+    const std::string event = "{\"name\":\"" + name + "\"";
+    const size_t pos  = json.find(event);
+    if (pos == std::string::npos) {
+        return false;
+    }
+    const std::string line = json.substr(pos, json.find('\n', pos) - pos);
+    std::string args = std::string("\"args\":{\"parallel\":")
+                       + (parallel ? "true" : "false");
+    if (!parent.empty()) {
+        args += ",\"parent\":\"" + parent + "\"";
+    }
+    return line.find(args + "}}") != std::string::npos;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_init_timeline_nesting)
+{
+    init_timeline::clear();
+    BOOST_CHECK_EQUAL(init_timeline::get_current_span(), init_timeline::NO_SPAN);
+    {
+        init_timeline::scoped_span root("root");
+        const init_timeline::span_id_t root_id = init_timeline::get_current_span();
+        BOOST_CHECK_NE(root_id, init_timeline::NO_SPAN);
+        {
+            init_timeline::scoped_span child("child");
+            init_timeline::scoped_span grandchild("grandchild");
+            BOOST_CHECK_NE(init_timeline::get_current_span(), root_id);
+        }
+        BOOST_CHECK_EQUAL(init_timeline::get_current_span(), root_id);
+        // Open spans are not dumped
+        const std::string json = dump_timeline();
+        BOOST_CHECK(has_event(json, "grandchild", false, "child"));
+        BOOST_CHECK(!has_event(json, "root", false));
+    }
+    BOOST_CHECK_EQUAL(init_timeline::get_current_span(), init_timeline::NO_SPAN);
+
+    const std::string json = dump_timeline();
+    BOOST_CHECK(has_event(json, "root", false));
+    BOOST_CHECK(has_event(json, "child", false, "root"));
+    BOOST_CHECK(has_event(json, "grandchild", false, "child"));
+
+    init_timeline::clear();
+    BOOST_CHECK(dump_timeline().find("root") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_init_timeline_parallel)
+{
+    init_timeline::clear();
+    {
+        init_timeline::scoped_span root("root");
+        const init_timeline::span_id_t parent = init_timeline::get_current_span();
+        std::thread worker([parent]() {
+            BOOST_CHECK_EQUAL(init_timeline::get_current_span(), init_timeline::NO_SPAN);
+            init_timeline::scoped_span span("worker", parent);
+            init_timeline::scoped_span sub("worker sub");
+        });
+        worker.join();
+        // A parent on the same thread doesn't make a span parallel
+        init_timeline::scoped_span serial("serial", parent);
+    }
+
+    const std::string json = dump_timeline();
+    BOOST_CHECK(has_event(json, "worker", true, "root"));
+    BOOST_CHECK(has_event(json, "worker sub", false, "worker"));
+    BOOST_CHECK(has_event(json, "serial", false, "root"));
+    init_timeline::clear();
+}
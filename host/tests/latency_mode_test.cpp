@@ -0,0 +1,77 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhdlib/usrp/common/latency_mode.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace uhd::usrp;
+
+BOOST_AUTO_TEST_CASE(test_latency_mode_default)
+{
+    const uhd::device_addr_t stream_args("spp=200");
+    const uhd::device_addr_t args = apply_latency_mode(stream_args, {});
+    BOOST_CHECK_EQUAL(args.to_string(), stream_args.to_string());
+
+    const latency_mode_args_t latency_args = read_latency_mode_args(args);
+    BOOST_CHECK(latency_args.mode == latency_mode_args_t::DEFAULT);
+    BOOST_CHECK(!latency_args.rx_fc_ack_every_pkt);
+    BOOST_CHECK(!latency_args.realtime_thread);
+    BOOST_CHECK_EQUAL(latency_args.max_fc_window_pkts, 0);
+
+    const auto capacity = get_max_fc_capacity(latency_args, 8000);
+    BOOST_CHECK_EQUAL(capacity.bytes, uhd::rfnoc::MAX_FC_CAPACITY_BYTES);
+    BOOST_CHECK_EQUAL(capacity.packets, uhd::rfnoc::MAX_FC_CAPACITY_PKTS);
+
+    // The default frequencies are 1/32 of the window
+    const auto pkt_freq = get_rx_fc_freq(latency_args, {64000, 64}, true);
+    BOOST_CHECK_EQUAL(pkt_freq.bytes, uhd::rfnoc::MAX_FC_FREQ_BYTES);
+    BOOST_CHECK_EQUAL(pkt_freq.packets, 2);
+    const auto byte_freq = get_rx_fc_freq(latency_args, {64000, 64}, false);
+    BOOST_CHECK_EQUAL(byte_freq.bytes, 2000);
+    BOOST_CHECK_EQUAL(byte_freq.packets, uhd::rfnoc::MAX_FC_FREQ_PKTS);
+
+    BOOST_CHECK_THROW(read_latency_mode_args(uhd::device_addr_t("latency_mode=fast")),
+        uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_latency_mode_ultra)
+{
+    // The explicit spp and the device arg are kept, the rest is implied
+    const uhd::device_addr_t args =
+        apply_latency_mode(uhd::device_addr_t("latency_mode=ultra,spp=100"),
+            uhd::device_addr_t("recv_offload=1,streamer_thread_cpu=3"));
+    BOOST_CHECK_EQUAL(args["spp"], "100");
+    BOOST_CHECK(!args.has_key("recv_offload"));
+    BOOST_CHECK_EQUAL(args["send_offload"], "0");
+    BOOST_CHECK_EQUAL(args["recv_offload_wait_mode"], "hybrid");
+    BOOST_CHECK_EQUAL(args["send_offload_wait_mode"], "hybrid");
+    BOOST_CHECK_EQUAL(args.cast<size_t>("num_recv_frames", 0), ULTRA_NUM_FRAMES);
+    BOOST_CHECK_EQUAL(args.cast<size_t>("num_send_frames", 0), ULTRA_NUM_FRAMES);
+
+    const latency_mode_args_t latency_args = read_latency_mode_args(args);
+    BOOST_CHECK(latency_args.mode == latency_mode_args_t::ULTRA);
+    BOOST_CHECK(latency_args.realtime_thread);
+    BOOST_REQUIRE(latency_args.streamer_thread_cpu);
+    BOOST_CHECK_EQUAL(*latency_args.streamer_thread_cpu, 3);
+    BOOST_CHECK_EQUAL(latency_args.tx_fc_freq_ratio, ULTRA_TX_FC_FREQ_RATIO);
+
+    const auto capacity = get_max_fc_capacity(latency_args, 8000);
+    BOOST_CHECK_EQUAL(capacity.bytes, ULTRA_NUM_FRAMES * 8000);
+    BOOST_CHECK_EQUAL(capacity.packets, ULTRA_NUM_FRAMES);
+
+    // Every packet gets acked, with either kind of flow control
+    const auto pkt_freq = get_rx_fc_freq(latency_args, capacity, true);
+    BOOST_CHECK_EQUAL(pkt_freq.packets, 1);
+    const auto byte_freq = get_rx_fc_freq(latency_args, capacity, false);
+    BOOST_CHECK_EQUAL(byte_freq.bytes, 1);
+
+    // The latency mode can also come from the device args
+    const uhd::device_addr_t dev_args =
+        apply_latency_mode({}, uhd::device_addr_t("latency_mode=ultra"));
+    BOOST_CHECK_EQUAL(dev_args.cast<size_t>("spp", 0), ULTRA_SPP);
+    BOOST_CHECK_EQUAL(dev_args["recv_offload"], "0");
+}
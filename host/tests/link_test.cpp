@@ -5,10 +5,70 @@
 //
 
 #include "common/mock_link.hpp"
+#include <uhdlib/transport/shared_frame_pool.hpp>
 #include <boost/test/unit_test.hpp>
+#include <cstring>
 
 using namespace uhd::transport;
 
+namespace {
+
+/*!
+ * Recv link that receives a packet into every frame, and can borrow frames
+ * from a shared pool
+ */
+class pool_recv_link : public recv_link_base<pool_recv_link>
+{
+public:
+    using base_t = recv_link_base<pool_recv_link>;
+
+    class buff_t : public frame_buff
+    {
+    public:
+        buff_t(void* mem)
+        {
+            _data = mem;
+        }
+    };
+
+    pool_recv_link(const size_t num_frames, const size_t frame_size)
+        : base_t(num_frames, frame_size), _mem(num_frames * frame_size)
+    {
+        for (size_t i = 0; i < num_frames; i++) {
+            _buffs.emplace_back(&_mem[i * frame_size]);
+        }
+        for (auto& buff : _buffs) {
+            base_t::preload_free_buff(&buff);
+        }
+    }
+
+    bool set_shared_frame_pool(shared_frame_pool::sptr pool)
+    {
+        return base_t::attach_shared_frame_pool(pool);
+    }
+
+    adapter_id_t get_recv_adapter_id() const
+    {
+        return NULL_ADAPTER_ID;
+    }
+
+private:
+    friend base_t;
+
+    size_t get_recv_buff_derived(frame_buff& buff, int32_t)
+    {
+        std::memset(buff.data(), 0xAB, get_recv_frame_size());
+        return get_recv_frame_size();
+    }
+
+    void release_recv_buff_derived(frame_buff&) {}
+
+    std::vector<uint8_t> _mem;
+    std::vector<buff_t> _buffs;
+};
+
+} // namespace
+
 BOOST_AUTO_TEST_CASE(test_send_get_release)
 {
     // Just call get_send_buff, release_send_buff, and pop_send_packet
@@ -160,3 +220,56 @@ BOOST_AUTO_TEST_CASE(test_recv_timeout)
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE(test_recv_shared_frame_pool)
+{
+    constexpr size_t frame_size = 64;
+    auto pool                   = shared_frame_pool::make(3, frame_size);
+    pool_recv_link link_a(2, frame_size);
+    pool_recv_link link_b(2, frame_size);
+
+    // Frames of the pool must be large enough for the link
+    BOOST_CHECK(!link_a.set_shared_frame_pool(shared_frame_pool::make(3, 32)));
+    BOOST_REQUIRE(link_a.set_shared_frame_pool(pool));
+    BOOST_REQUIRE(link_b.set_shared_frame_pool(pool));
+    BOOST_CHECK_EQUAL(link_a.get_num_recv_frames(), 2);
+    BOOST_CHECK_EQUAL(link_a.get_num_shared_recv_frames(), 3);
+
+    // A link uses its own frames first, then borrows the shared ones
+    std::vector<frame_buff::uptr> buffs_a;
+    for (size_t i = 0; i < 5; i++) {
+        buffs_a.push_back(link_a.get_recv_buff(0));
+        BOOST_REQUIRE(buffs_a.back());
+        BOOST_CHECK_EQUAL(pool->owns(buffs_a.back().get()), i >= 2);
+    }
+    BOOST_CHECK(!link_a.get_recv_buff(0));
+    BOOST_CHECK_EQUAL(pool->get_num_free(), 0);
+
+    // The other link still has its own frames, but no shared ones
+    std::vector<frame_buff::uptr> buffs_b;
+    for (size_t i = 0; i < 2; i++) {
+        buffs_b.push_back(link_b.get_recv_buff(0));
+        BOOST_CHECK(buffs_b.back());
+    }
+    BOOST_CHECK(!link_b.get_recv_buff(0));
+
+    // Borrowed frames must be returned before the pool is detached
+    BOOST_CHECK_THROW(link_a.set_shared_frame_pool(nullptr), uhd::assertion_error);
+    for (auto& buff : buffs_a) {
+        link_a.release_recv_buff(std::move(buff));
+    }
+    BOOST_CHECK_EQUAL(pool->get_num_free(), 3);
+    BOOST_CHECK(link_a.set_shared_frame_pool(nullptr));
+    BOOST_CHECK_EQUAL(link_a.get_num_shared_recv_frames(), 0);
+
+    // Now the other link can borrow all of them
+    for (size_t i = 0; i < 3; i++) {
+        buffs_b.push_back(link_b.get_recv_buff(0));
+        BOOST_CHECK(buffs_b.back());
+    }
+    BOOST_CHECK(!link_b.get_recv_buff(0));
+    for (auto& buff : buffs_b) {
+        link_b.release_recv_buff(std::move(buff));
+    }
+    BOOST_CHECK_EQUAL(pool->get_num_free(), 3);
+}
@@ -14,6 +14,8 @@ BOOST_AUTO_TEST_CASE(test_messages)
 {
     UHD_LOG_FASTPATH("foo");
     UHD_LOG_FASTPATH("bar");
+    UHD_LOG_FASTPATH_FMT("seq {} != {}\n", 5, 7u);
+    UHD_LOG_FASTPATH_FMT("rate {}\n", 2.5);
     uhd::log::set_log_level(uhd::log::debug);
     uhd::log::set_console_level(uhd::log::info);
     uhd::log::add_logger("test", [](const uhd::log::logging_info& I) {
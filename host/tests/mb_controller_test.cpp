@@ -4,9 +4,12 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include <uhd/exception.hpp>
 #include <uhd/rfnoc/mb_controller.hpp>
 #include <boost/test/unit_test.hpp>
+#include <chrono>
 #include <iostream>
+#include <thread>
 
 using namespace uhd;
 using namespace uhd::rfnoc;
@@ -167,3 +170,37 @@ BOOST_AUTO_TEST_CASE(test_mb_controller)
     tk->set_time_next_pps(uhd::time_spec_t(TIME_1));
     BOOST_CHECK_EQUAL(tk->get_ticks_last_pps(), TIME_1 * TICK_RATE);
 }
+
+BOOST_AUTO_TEST_CASE(test_time_estimate)
+{
+    auto mmbc = std::make_shared<mock_mb_controller>();
+    auto tk   = mmbc->get_timekeeper(0);
+    std::dynamic_pointer_cast<mock_timekeeper>(tk)->update_tick_rate(1e6);
+
+    tk->set_time_now(uhd::time_spec_t(10.0));
+    BOOST_CHECK(!tk->has_time_estimate());
+    BOOST_CHECK_THROW(tk->get_time_estimate(), uhd::runtime_error);
+    // Reading the time gives the timekeeper something to estimate from. The
+    // mock time doesn't run, so the estimate only holds for a short while.
+    const auto before = std::chrono::steady_clock::now();
+    BOOST_CHECK_EQUAL(tk->get_time_now().get_real_secs(), 10.0);
+    BOOST_REQUIRE(tk->has_time_estimate());
+    BOOST_CHECK_CLOSE(tk->get_time_estimate(before).get_real_secs(), 10.0, 1e-3);
+    const auto host_time = tk->get_host_time(uhd::time_spec_t(11.0));
+    BOOST_CHECK_CLOSE(
+        std::chrono::duration<double>(host_time - before).count(), 1.0, 1.0);
+
+    // Setting the time drops the estimate
+    tk->set_time_now(uhd::time_spec_t(0.0));
+    BOOST_CHECK(!tk->has_time_estimate());
+
+    BOOST_CHECK_THROW(mmbc->set_time_correlation_interval(1, 1.0), uhd::index_error);
+    BOOST_CHECK_THROW(mmbc->set_time_correlation_interval(0, -1.0), uhd::value_error);
+    mmbc->set_time_correlation_interval(0, 0.001);
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!tk->has_time_estimate() && std::chrono::steady_clock::now() < timeout) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_CHECK(tk->has_time_estimate());
+    mmbc->set_time_correlation_interval(0, 0.0);
+}
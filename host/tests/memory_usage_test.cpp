@@ -0,0 +1,41 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/transport/buffer_pool.hpp>
+#include <uhd/utils/memory_usage.hpp>
+#include <uhdlib/utils/memory_usage.hpp>
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+size_t get_usage(const std::string& subsystem)
+{
+    const auto usage = uhd::get_memory_usage();
+    const auto it    = usage.find(subsystem);
+    return (it == usage.end()) ? 0 : it->second;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_memory_usage_accounting)
+{
+    const size_t before = get_usage("test");
+    uhd::add_memory_usage("test", 1000);
+    uhd::add_memory_usage("test", 24);
+    BOOST_CHECK_EQUAL(get_usage("test"), before + 1024);
+    uhd::remove_memory_usage("test", 1024);
+    BOOST_CHECK_EQUAL(get_usage("test"), before);
+}
+
+BOOST_AUTO_TEST_CASE(test_memory_usage_buffer_pool)
+{
+    const size_t before = get_usage(uhd::MEMORY_USAGE_TRANSPORT);
+    {
+        auto pool = uhd::transport::buffer_pool::make(8, 1000);
+        BOOST_CHECK_GE(get_usage(uhd::MEMORY_USAGE_TRANSPORT), before + 8 * 1000);
+    }
+    BOOST_CHECK_EQUAL(get_usage(uhd::MEMORY_USAGE_TRANSPORT), before);
+}
@@ -0,0 +1,181 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/mock_tx_streamer.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/utils/multi_tx_streamer.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+namespace {
+
+constexpr size_t NUM_CHANS = 2;
+constexpr size_t SPP       = 100;
+
+uhd::mock_tx_streamer::sptr make_tx_streamer(const bool can_notify)
+{
+    uhd::mock_tx_streamer::stream_params params;
+    params.num_chans     = NUM_CHANS;
+    params.max_num_samps = SPP;
+    params.can_notify    = can_notify;
+    return std::make_shared<uhd::mock_tx_streamer>(params);
+}
+
+//! One buffer per channel, every sample holds its channel and index
+std::vector<std::vector<std::complex<float>>> make_buffs(
+    const size_t num_chans, const size_t first, const size_t num_samps)
+{
+    std::vector<std::vector<std::complex<float>>> buffs(num_chans);
+    for (size_t chan = 0; chan < num_chans; chan++) {
+        for (size_t i = first; i < first + num_samps; i++) {
+            buffs[chan].emplace_back(static_cast<float>(i), static_cast<float>(chan));
+        }
+    }
+    return buffs;
+}
+
+std::vector<const void*> get_ptrs(const std::vector<std::vector<std::complex<float>>>& b)
+{
+    std::vector<const void*> ptrs;
+    for (const auto& buff : b) {
+        ptrs.push_back(buff.data());
+    }
+    return ptrs;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_multi_tx_args)
+{
+    BOOST_CHECK_THROW(uhd::multi_tx_streamer::make({}, "fc32"), uhd::value_error);
+    auto tx_stream = make_tx_streamer(true);
+    BOOST_CHECK_THROW(uhd::multi_tx_streamer::make(
+                          {tx_stream}, "fc32", uhd::device_addr_t("num_blocks=0")),
+        uhd::value_error);
+    auto multi_tx = uhd::multi_tx_streamer::make({tx_stream, tx_stream}, "fc32");
+    BOOST_CHECK_EQUAL(multi_tx->get_num_channels(), 2 * NUM_CHANS);
+    BOOST_CHECK_EQUAL(multi_tx->get_num_devices(), 2);
+    BOOST_CHECK_EQUAL(multi_tx->get_max_num_samps(), SPP);
+}
+
+BOOST_AUTO_TEST_CASE(test_multi_tx_burst)
+{
+    constexpr size_t NUM_SAMPS = 1050;
+    std::vector<uhd::mock_tx_streamer::sptr> devices = {
+        make_tx_streamer(true),
+        make_tx_streamer(false)};
+    auto multi_tx = uhd::multi_tx_streamer::make({devices[0], devices[1]},
+        "fc32",
+        uhd::device_addr_t("block_size=256,num_blocks=2"));
+
+    const auto buffs = make_buffs(2 * NUM_CHANS, 0, NUM_SAMPS);
+    uhd::tx_metadata_t md;
+    md.start_of_burst = true;
+    md.end_of_burst   = true;
+    md.has_time_spec  = true;
+    md.time_spec      = uhd::time_spec_t(1.5);
+    BOOST_CHECK_EQUAL(multi_tx->send(get_ptrs(buffs), NUM_SAMPS, md, 1.0), NUM_SAMPS);
+    BOOST_REQUIRE(multi_tx->wait_sent(1.0));
+
+    for (size_t dev = 0; dev < devices.size(); dev++) {
+        BOOST_CHECK_EQUAL(multi_tx->get_device_status(dev).num_samps_sent, NUM_SAMPS);
+        BOOST_CHECK_EQUAL(multi_tx->get_device_status(dev).num_blocks_queued, 0);
+        // Each device got its own channels
+        for (size_t chan = 0; chan < NUM_CHANS; chan++) {
+            const auto samples = devices[dev]->get_samples(chan);
+            BOOST_REQUIRE_EQUAL(samples.size(), NUM_SAMPS);
+            for (size_t i = 0; i < NUM_SAMPS; i++) {
+                BOOST_REQUIRE_EQUAL(samples[i], buffs[dev * NUM_CHANS + chan][i]);
+            }
+        }
+        // Both devices start the burst at the same time, and end it
+        const auto dev_md = devices[dev]->get_metadata();
+        BOOST_REQUIRE(!dev_md.empty());
+        BOOST_CHECK(dev_md.front().start_of_burst);
+        BOOST_CHECK(dev_md.front().has_time_spec);
+        BOOST_CHECK_EQUAL(dev_md.front().time_spec.get_real_secs(), 1.5);
+        for (size_t i = 1; i < dev_md.size(); i++) {
+            BOOST_CHECK(!dev_md[i].start_of_burst);
+            BOOST_CHECK(!dev_md[i].has_time_spec);
+            BOOST_CHECK_EQUAL(dev_md[i].end_of_burst, i == dev_md.size() - 1);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_multi_tx_stalled_device)
+{
+    constexpr size_t NUM_BLOCKS = 4;
+    std::vector<uhd::mock_tx_streamer::sptr> devices = {
+        make_tx_streamer(true),
+        make_tx_streamer(true)};
+    auto multi_tx = uhd::multi_tx_streamer::make({devices[0], devices[1]},
+        "fc32",
+        uhd::device_addr_t("num_blocks=" + std::to_string(NUM_BLOCKS)));
+    devices[1]->set_stalled(true);
+
+    // The other device keeps sending, until the stalled one is a ring behind
+    uhd::tx_metadata_t md;
+    size_t num_sent = 0;
+    for (size_t i = 0; i < NUM_BLOCKS; i++) {
+        const auto buffs = make_buffs(2 * NUM_CHANS, num_sent, SPP);
+        num_sent += multi_tx->send(get_ptrs(buffs), SPP, md, 1.0);
+    }
+    BOOST_CHECK_EQUAL(num_sent, NUM_BLOCKS * SPP);
+    const auto buffs = make_buffs(2 * NUM_CHANS, num_sent, SPP);
+    BOOST_CHECK_EQUAL(multi_tx->send(get_ptrs(buffs), SPP, md, 0.05), 0);
+    BOOST_CHECK(!multi_tx->wait_sent(0.05));
+    BOOST_CHECK_EQUAL(multi_tx->get_device_status(0).num_samps_sent, NUM_BLOCKS * SPP);
+    BOOST_CHECK_EQUAL(multi_tx->get_device_status(0).num_blocks_queued, 0);
+    BOOST_CHECK_EQUAL(multi_tx->get_device_status(1).num_blocks_queued, NUM_BLOCKS);
+
+    devices[1]->set_stalled(false);
+    BOOST_CHECK_EQUAL(multi_tx->send(get_ptrs(buffs), SPP, md, 1.0), SPP);
+    BOOST_REQUIRE(multi_tx->wait_sent(1.0));
+    BOOST_CHECK_EQUAL(devices[1]->get_samples(0).size(), (NUM_BLOCKS + 1) * SPP);
+}
+
+BOOST_AUTO_TEST_CASE(test_multi_tx_async_msgs)
+{
+    // One device delivers its messages through the callback, the other one is
+    // polled
+    std::vector<uhd::mock_tx_streamer::sptr> devices = {
+        make_tx_streamer(true),
+        make_tx_streamer(false)};
+    auto multi_tx = uhd::multi_tx_streamer::make({devices[0], devices[1]}, "fc32");
+
+    devices[0]->post_async_msg(1, uhd::async_metadata_t::EVENT_CODE_TIME_ERROR);
+    devices[1]->post_async_msg(0, uhd::async_metadata_t::EVENT_CODE_UNDERFLOW);
+    devices[1]->post_async_msg(1, uhd::async_metadata_t::EVENT_CODE_BURST_ACK);
+    // The polled device only reads its messages between blocks
+    const auto buffs = make_buffs(2 * NUM_CHANS, 0, 10);
+    uhd::tx_metadata_t md;
+    md.end_of_burst = true;
+    multi_tx->send(get_ptrs(buffs), 10, md, 1.0);
+    BOOST_REQUIRE(multi_tx->wait_sent(1.0));
+
+    std::vector<size_t> channels;
+    uhd::async_metadata_t msg;
+    while (multi_tx->recv_async_msg(msg, 0.1)) {
+        channels.push_back(msg.channel);
+    }
+    std::sort(channels.begin(), channels.end());
+    const std::vector<size_t> expected_channels{1, 2, 3};
+    BOOST_CHECK_EQUAL_COLLECTIONS(channels.begin(),
+        channels.end(),
+        expected_channels.begin(),
+        expected_channels.end());
+
+    const auto status0 = multi_tx->get_device_status(0);
+    const auto status1 = multi_tx->get_device_status(1);
+    BOOST_CHECK_EQUAL(status0.num_late, 1);
+    BOOST_CHECK_EQUAL(status0.num_underflows, 0);
+    BOOST_CHECK_EQUAL(status1.num_underflows, 1);
+    BOOST_CHECK_EQUAL(status1.num_burst_acks, 1);
+    BOOST_CHECK_EQUAL(status1.num_late, 0);
+}
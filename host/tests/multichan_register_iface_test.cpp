@@ -178,3 +178,37 @@ BOOST_AUTO_TEST_CASE(test_peek64)
         BOOST_CHECK_EQUAL(block_reg_iface.peek64(addr, instance), data);
     }
 }
+
+BOOST_AUTO_TEST_CASE(test_shadow_regs)
+{
+    auto mock_reg_iface = std::make_shared<mock_reg_iface_t>();
+    register_iface_holder mock_holder{mock_reg_iface};
+    multichan_register_iface block_reg_iface{mock_holder, BASE_ADDR, INSTANCE_SIZE};
+    const uint32_t addr          = 0x100;
+    const uint32_t volatile_addr = 0x104;
+    const uint32_t abs_addr      = get_addr_translation(addr, 1);
+
+    mock_holder.enable_shadow_regs();
+    block_reg_iface.set_volatile(volatile_addr, 1);
+    // Never written, so this must come from the device
+    mock_reg_iface->read_memory[abs_addr]     = 0x1111;
+    mock_reg_iface->read_memory[abs_addr + 4] = 0x2222;
+    BOOST_CHECK_EQUAL(block_reg_iface.peek32(addr, 1), 0x1111);
+
+    // After writing, reads are served from the shadow copy, unless the
+    // register is volatile or the read is timed
+    block_reg_iface.poke32(addr, 0xabc, 1);
+    block_reg_iface.poke32(volatile_addr, 0xdef, 1);
+    BOOST_CHECK_EQUAL(mock_reg_iface->write_memory[abs_addr], 0xabc);
+    BOOST_CHECK_EQUAL(block_reg_iface.peek32(addr, 1), 0xabc);
+    BOOST_CHECK_EQUAL(block_reg_iface.peek32(volatile_addr, 1), 0x2222);
+    BOOST_CHECK_EQUAL(block_reg_iface.peek32(addr, 1, uhd::time_spec_t(1.0)), 0x1111);
+
+    // Block reads only use the shadow copy if all registers are in it
+    block_reg_iface.poke64(addr, 0x0000567800001234, 2);
+    BOOST_CHECK_EQUAL(block_reg_iface.peek64(addr, 2), 0x0000567800001234);
+    BOOST_CHECK_EQUAL(block_reg_iface.peek64(addr, 1), 0x0000222200001111);
+
+    mock_holder.invalidate_shadow_regs();
+    BOOST_CHECK_EQUAL(block_reg_iface.peek32(addr, 1), 0x1111);
+}
@@ -0,0 +1,218 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/transport/muxed_zero_copy_if.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace uhd::transport;
+
+namespace {
+
+constexpr size_t NUM_FRAMES = 8;
+//! The demuxer sizes the stream queues by the number of frames we report
+constexpr size_t QUEUE_SIZE = 4;
+constexpr size_t FRAME_SIZE = 64;
+
+/*! Base transport with a fixed set of frames. The first word of each frame is
+ *  the stream number, so the classifier can read it back.
+ */
+class frame_source : public zero_copy_if
+{
+public:
+    frame_source() : _mem(NUM_FRAMES * FRAME_SIZE), _mrbs(NUM_FRAMES)
+    {
+        for (size_t i = 0; i < NUM_FRAMES; i++) {
+            _mrbs[i]._source = this;
+            _mrbs[i]._mem    = &_mem[i * FRAME_SIZE];
+        }
+    }
+
+    //! Queue a frame for the given stream, returns its memory
+    uint8_t* push(const uint32_t stream_num)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        BOOST_REQUIRE(_num_out + _pending.size() < NUM_FRAMES);
+        source_mrb* mrb = &_mrbs[_next++ % NUM_FRAMES];
+        std::memcpy(mrb->_mem, &stream_num, sizeof(stream_num));
+        _pending.push_back(mrb);
+        return mrb->_mem;
+    }
+
+    //! Return the number of frames that were handed out and not released
+    size_t get_num_out()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _num_out;
+    }
+
+    managed_recv_buffer::sptr get_recv_buff(double)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_pending.empty()) {
+            return managed_recv_buffer::sptr();
+        }
+        source_mrb* mrb = _pending.front();
+        _pending.pop_front();
+        _num_out++;
+        return mrb->get_new();
+    }
+
+    size_t get_num_recv_frames() const
+    {
+        return QUEUE_SIZE;
+    }
+
+    size_t get_recv_frame_size() const
+    {
+        return FRAME_SIZE;
+    }
+
+    managed_send_buffer::sptr get_send_buff(double)
+    {
+        return managed_send_buffer::sptr();
+    }
+
+    size_t get_num_send_frames() const
+    {
+        return NUM_FRAMES;
+    }
+
+    size_t get_send_frame_size() const
+    {
+        return FRAME_SIZE;
+    }
+
+private:
+    class source_mrb : public managed_recv_buffer
+    {
+    public:
+        void release()
+        {
+            std::lock_guard<std::mutex> lock(_source->_mutex);
+            _source->_num_out--;
+        }
+
+        sptr get_new()
+        {
+            return make(this, _mem, FRAME_SIZE);
+        }
+
+        frame_source* _source;
+        uint8_t* _mem;
+    };
+
+    std::vector<uint8_t> _mem;
+    std::vector<source_mrb> _mrbs;
+    std::deque<source_mrb*> _pending;
+    size_t _next    = 0;
+    size_t _num_out = 0;
+    std::mutex _mutex;
+};
+
+uint32_t classify(void* buff, size_t)
+{
+    uint32_t stream_num;
+    std::memcpy(&stream_num, buff, sizeof(stream_num));
+    return stream_num;
+}
+
+//! Wait until cond is true, or fail after a while
+void wait_for(const std::function<bool()>& cond)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!cond() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_REQUIRE(cond());
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_muxed_zero_copy)
+{
+    auto source = std::make_shared<frame_source>();
+    auto muxed  = muxed_zero_copy_if::make(source, &classify, 4);
+    // Stream numbers don't have to be small
+    auto stream_a = muxed->make_stream(0x10000001);
+    auto stream_b = muxed->make_stream(7);
+
+    uint8_t* frame_b = source->push(7);
+    uint8_t* frame_a = source->push(0x10000001);
+
+    auto buff_a = stream_a->get_recv_buff(1.0);
+    auto buff_b = stream_b->get_recv_buff(1.0);
+    BOOST_REQUIRE(buff_a);
+    BOOST_REQUIRE(buff_b);
+    // The streams hand out the frames of the base transport, not copies
+    BOOST_CHECK(buff_a->cast<uint8_t*>() == frame_a);
+    BOOST_CHECK(buff_b->cast<uint8_t*>() == frame_b);
+    BOOST_CHECK_EQUAL(buff_a->size(), FRAME_SIZE);
+
+    // Frames go back to the base transport when the consumer releases them
+    buff_a.reset();
+    wait_for([&]() { return source->get_num_out() == 1; });
+    buff_b.reset();
+    wait_for([&]() { return source->get_num_out() == 0; });
+    BOOST_CHECK(!stream_a->get_recv_buff(0.0));
+}
+
+BOOST_AUTO_TEST_CASE(test_muxed_zero_copy_unknown_stream)
+{
+    auto source = std::make_shared<frame_source>();
+    auto muxed  = muxed_zero_copy_if::make(source, &classify, 4);
+    auto stream = muxed->make_stream(1);
+
+    source->push(2);
+    wait_for([&]() { return muxed->get_num_dropped_frames() == 1; });
+    BOOST_CHECK_EQUAL(source->get_num_out(), 0);
+
+    // Frames for removed streams are dropped as well
+    muxed->remove_stream(1);
+    source->push(1);
+    wait_for([&]() { return muxed->get_num_dropped_frames() == 2; });
+    BOOST_CHECK(!stream->get_recv_buff(0.0));
+    BOOST_CHECK_EQUAL(source->get_num_out(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_muxed_zero_copy_capacity)
+{
+    auto source = std::make_shared<frame_source>();
+    auto muxed  = muxed_zero_copy_if::make(source, &classify, 2);
+    auto stream_a = muxed->make_stream(1);
+    {
+        auto stream_b = muxed->make_stream(2);
+        BOOST_CHECK_THROW(muxed->make_stream(3), uhd::runtime_error);
+    }
+    // Destroying a stream frees up its slot
+    auto stream_c = muxed->make_stream(3);
+    source->push(3);
+    auto buff = stream_c->get_recv_buff(1.0);
+    BOOST_REQUIRE(buff);
+}
+
+BOOST_AUTO_TEST_CASE(test_muxed_zero_copy_destroy_full_stream)
+{
+    auto source = std::make_shared<frame_source>();
+    auto muxed  = muxed_zero_copy_if::make(source, &classify, 2);
+    auto stream = muxed->make_stream(1);
+    // Fill the queue of the stream, and then some. The demuxer blocks on the
+    // full queue with one more frame.
+    for (size_t i = 0; i < NUM_FRAMES - 1; i++) {
+        source->push(1);
+    }
+    wait_for([&]() { return source->get_num_out() == QUEUE_SIZE + 1; });
+    // Destroying the stream must not hang, and returns all frames
+    stream.reset();
+    wait_for([&]() { return source->get_num_out() == 0; });
+}
@@ -8,7 +8,10 @@
 #include <uhdlib/transport/offload_io_service.hpp>
 #include <boost/test/unit_test.hpp>
 #include <atomic>
+#include <chrono>
+#include <cstring>
 #include <iostream>
+#include <thread>
 
 using namespace uhd::transport;
 
@@ -147,11 +150,12 @@ constexpr auto RECV_ONLY          = offload_io_service::RECV_ONLY;
 constexpr auto SEND_ONLY          = offload_io_service::SEND_ONLY;
 constexpr auto BOTH_SEND_AND_RECV = offload_io_service::BOTH_SEND_AND_RECV;
 
-constexpr auto POLL  = offload_io_service::POLL;
-constexpr auto BLOCK = offload_io_service::BLOCK;
-using params_t       = offload_io_service::params_t;
+constexpr auto POLL   = offload_io_service::POLL;
+constexpr auto BLOCK  = offload_io_service::BLOCK;
+constexpr auto HYBRID = offload_io_service::HYBRID;
+using params_t        = offload_io_service::params_t;
 
-std::vector<offload_io_service::wait_mode_t> wait_modes({POLL, BLOCK});
+std::vector<offload_io_service::wait_mode_t> wait_modes({POLL, BLOCK, HYBRID});
 
 BOOST_AUTO_TEST_CASE(test_construction)
 {
@@ -240,6 +244,42 @@ BOOST_AUTO_TEST_CASE(test_recv)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_recv_queue_hwm)
+{
+    constexpr size_t NUM_FRAMES = 4;
+    for (const auto wait_mode : wait_modes) {
+        params_t params  = {{}, RECV_ONLY, wait_mode};
+        auto mock_io_srv = std::make_shared<mock_io_service>();
+        auto io_srv      = offload_io_service::make(mock_io_srv, params);
+        auto recv_link   = make_recv_link(NUM_FRAMES);
+        io_srv->attach_recv_link(recv_link);
+
+        auto recv_client =
+            io_srv->make_recv_client(recv_link, NUM_FRAMES, nullptr, nullptr, 0, nullptr);
+        BOOST_CHECK_EQUAL(recv_client->get_recv_queue_hwm(), 0);
+
+        for (size_t i = 0; i < NUM_FRAMES; i++) {
+            recv_link->push_back_recv_packet(
+                boost::shared_array<uint8_t>(new uint8_t[FRAME_SIZE]), FRAME_SIZE);
+        }
+        mock_io_srv->allocate_recv_frames(0, NUM_FRAMES);
+
+        // Give the offload thread time to queue all packets
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+        std::vector<frame_buff::uptr> buffs;
+        for (size_t i = 0; i < NUM_FRAMES; i++) {
+            buffs.push_back(recv_client->get_recv_buff(100));
+            BOOST_CHECK(buffs.back() != nullptr);
+        }
+        BOOST_CHECK_EQUAL(recv_client->get_recv_queue_hwm(), NUM_FRAMES);
+        for (auto& buff : buffs) {
+            recv_client->release_recv_buff(std::move(buff));
+        }
+        recv_client.reset();
+    }
+}
+
 BOOST_AUTO_TEST_CASE(test_send_recv)
 {
     auto mock_io_srv = std::make_shared<mock_io_service>();
@@ -352,3 +392,82 @@ BOOST_AUTO_TEST_CASE(test_attach_detach)
     mock_io_srv->allocate_recv_frames(2, 1);
     recv_client2->release_recv_buff(recv_client2->get_recv_buff(100));
 }
+
+BOOST_AUTO_TEST_CASE(test_poll_threads)
+{
+    constexpr size_t NUM_THREADS = 3;
+    constexpr size_t NUM_LINKS   = 8;
+
+    params_t params;
+    params.num_poll_threads = NUM_THREADS;
+    auto mock_io_srv        = std::make_shared<mock_io_service>();
+    auto io_srv             = offload_io_service::make(mock_io_srv, params);
+
+    std::vector<mock_recv_link::sptr> recv_links;
+    std::vector<mock_send_link::sptr> send_links;
+    std::vector<recv_io_if::sptr> recv_clients;
+    std::vector<send_io_if::sptr> send_clients;
+    for (size_t i = 0; i < NUM_LINKS; i++) {
+        recv_links.push_back(make_recv_link(5));
+        send_links.push_back(make_send_link(5));
+        io_srv->attach_recv_link(recv_links.back());
+        io_srv->attach_send_link(send_links.back());
+        recv_clients.push_back(io_srv->make_recv_client(
+            recv_links.back(), 2, nullptr, send_links.back(), 0, nullptr));
+        send_clients.push_back(io_srv->make_send_client(
+            send_links.back(), 2, nullptr, recv_links.back(), 0, nullptr, nullptr));
+    }
+
+    // Give each link a different load, so the threads have to rebalance while
+    // the packets are received
+    std::vector<size_t> num_packets;
+    for (size_t i = 0; i < NUM_LINKS; i++) {
+        num_packets.push_back((i % 3 == 0) ? 1000 : 10);
+        for (size_t j = 0; j < num_packets[i]; j++) {
+            boost::shared_array<uint8_t> data(new uint8_t[FRAME_SIZE]);
+            std::memcpy(data.get(), &j, sizeof(j));
+            recv_links[i]->push_back_recv_packet(data, FRAME_SIZE);
+        }
+        mock_io_srv->allocate_recv_frames(i, num_packets[i]);
+    }
+
+    // Each link must keep the order of its packets
+    for (size_t j = 0; j < 1000; j++) {
+        for (size_t i = 0; i < NUM_LINKS; i++) {
+            if (j >= num_packets[i]) {
+                continue;
+            }
+            auto buff = recv_clients[i]->get_recv_buff(1000);
+            BOOST_REQUIRE(buff != nullptr);
+            size_t seq;
+            std::memcpy(&seq, buff->data(), sizeof(seq));
+            BOOST_CHECK_EQUAL(seq, j);
+            recv_clients[i]->release_recv_buff(std::move(buff));
+
+            auto send_buff = send_clients[i]->get_send_buff(1000);
+            BOOST_REQUIRE(send_buff != nullptr);
+            send_clients[i]->release_send_buff(std::move(send_buff));
+        }
+    }
+
+    for (size_t i = 0; i < NUM_LINKS; i++) {
+        recv_clients[i].reset();
+        send_clients[i].reset();
+        io_srv->detach_recv_link(recv_links[i]);
+        io_srv->detach_send_link(send_links[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_poll_threads_invalid_params)
+{
+    auto mock_io_srv = std::make_shared<mock_io_service>();
+
+    params_t params         = {{}, RECV_ONLY, BLOCK};
+    params.num_poll_threads = 2;
+    BOOST_CHECK_THROW(offload_io_service::make(mock_io_srv, params), uhd::value_error);
+
+    params                        = params_t();
+    params.num_poll_threads       = 2;
+    params.num_shared_recv_frames = 4;
+    BOOST_CHECK_THROW(offload_io_service::make(mock_io_srv, params), uhd::value_error);
+}
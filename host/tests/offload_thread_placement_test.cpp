@@ -0,0 +1,90 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/usrp/common/offload_thread_placement.hpp>
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace uhd::usrp;
+
+namespace {
+
+/*!
+ * Two NUMA nodes with four cores each, two hyperthreads per core. CPU N and
+ * N + 8 are siblings.
+ */
+cpu_topology_t make_topology()
+{
+    cpu_topology_t topology;
+    topology.node_cpus[0] = {0, 1, 2, 3, 8, 9, 10, 11};
+    topology.node_cpus[1] = {4, 5, 6, 7, 12, 13, 14, 15};
+    for (size_t cpu = 0; cpu < 8; cpu++) {
+        topology.siblings[cpu]     = {cpu, cpu + 8};
+        topology.siblings[cpu + 8] = {cpu, cpu + 8};
+    }
+    return topology;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_parse_cpu_list)
+{
+    using cpus_t = std::vector<size_t>;
+    BOOST_CHECK(parse_cpu_list("0-3,8\n") == cpus_t({0, 1, 2, 3, 8}));
+    BOOST_CHECK(parse_cpu_list("5") == cpus_t({5}));
+    BOOST_CHECK(parse_cpu_list("4-5,0-1") == cpus_t({0, 1, 4, 5}));
+    BOOST_CHECK(parse_cpu_list("").empty());
+    BOOST_CHECK(parse_cpu_list("foo").empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_placement_numa_node)
+{
+    offload_thread_placement placement(make_topology());
+    BOOST_CHECK_EQUAL(*placement.pick_cpu(1, {}, {}), 4);
+    BOOST_CHECK_EQUAL(*placement.pick_cpu(0, {}, {}), 0);
+
+    // Unknown nodes fall back to all CPUs
+    BOOST_CHECK_EQUAL(*placement.pick_cpu(-1, {}, {}), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_placement_spreads_over_cores)
+{
+    offload_thread_placement placement(make_topology());
+    std::vector<size_t> cpus;
+    for (size_t i = 0; i < 4; i++) {
+        cpus.push_back(*placement.pick_cpu(0, {}, {}));
+    }
+    // Each thread gets a core of its own before any sibling is used
+    BOOST_CHECK(cpus == std::vector<size_t>({0, 1, 2, 3}));
+    BOOST_CHECK_EQUAL(*placement.pick_cpu(0, {}, {}), 8);
+
+    // Released CPUs are reused
+    placement.release_cpu(2);
+    BOOST_CHECK_EQUAL(*placement.pick_cpu(0, {}, {}), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_placement_avoids_irq_and_streamer_cpus)
+{
+    offload_thread_placement placement(make_topology());
+    // CPU 0 handles the interrupts, the streamer runs on CPU 9, which rules out
+    // core 1 as well
+    BOOST_CHECK_EQUAL(*placement.pick_cpu(0, {0}, {9}), 2);
+    BOOST_CHECK_EQUAL(*placement.pick_cpu(0, {0}, {9}), 3);
+
+    // The sibling of the IRQ CPU is free otherwise
+    BOOST_CHECK_EQUAL(*placement.pick_cpu(0, {0}, {9}), 8);
+
+    // Sharing a core with an offload thread beats the IRQ CPU
+    BOOST_CHECK_EQUAL(*placement.pick_cpu(0, {0}, {9}), 10);
+    BOOST_CHECK_EQUAL(*placement.pick_cpu(0, {0}, {9}), 11);
+    BOOST_CHECK_EQUAL(*placement.pick_cpu(0, {0}, {9}), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_placement_unknown_topology)
+{
+    offload_thread_placement placement{cpu_topology_t()};
+    BOOST_CHECK(!placement.pick_cpu(0, {}, {}));
+}
@@ -0,0 +1,65 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhdlib/usrp/common/path_mtu_cache.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <thread>
+
+using namespace uhd::usrp;
+
+BOOST_AUTO_TEST_CASE(test_path_mtu_cache_hit)
+{
+    path_mtu_cache cache;
+    size_t num_probes = 0;
+    auto probe        = [&num_probes]() {
+        num_probes++;
+        return size_t(8000);
+    };
+
+    BOOST_CHECK_EQUAL(cache.get_mtu("eth0", "192.168.10.2", probe), 8000);
+    BOOST_CHECK_EQUAL(cache.get_mtu("eth0", "192.168.10.2", probe), 8000);
+    BOOST_CHECK_EQUAL(num_probes, 1);
+
+    // Paths are kept per interface and device
+    cache.get_mtu("eth1", "192.168.10.2", probe);
+    cache.get_mtu("eth0", "192.168.20.2", probe);
+    BOOST_CHECK_EQUAL(num_probes, 3);
+
+    // A TTL of 0 bypasses the cache
+    cache.get_mtu("eth0", "192.168.10.2", probe, 0.0);
+    BOOST_CHECK_EQUAL(num_probes, 4);
+
+    cache.clear();
+    cache.get_mtu("eth0", "192.168.10.2", probe);
+    BOOST_CHECK_EQUAL(num_probes, 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_path_mtu_cache_expiry)
+{
+    path_mtu_cache cache;
+    size_t mtu = 1472;
+    auto probe = [&mtu]() { return mtu; };
+
+    BOOST_CHECK_EQUAL(cache.get_mtu("eth0", "192.168.10.2", probe, 0.05), 1472);
+    mtu = 8000;
+    BOOST_CHECK_EQUAL(cache.get_mtu("eth0", "192.168.10.2", probe, 0.05), 1472);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    BOOST_CHECK_EQUAL(cache.get_mtu("eth0", "192.168.10.2", probe, 0.05), 8000);
+}
+
+BOOST_AUTO_TEST_CASE(test_path_mtu_cache_failed_probe)
+{
+    path_mtu_cache cache;
+    auto failing_probe = []() -> size_t { throw uhd::runtime_error("no echo"); };
+    BOOST_CHECK_THROW(
+        cache.get_mtu("eth0", "192.168.10.2", failing_probe), uhd::runtime_error);
+
+    // Failures are not cached
+    BOOST_CHECK_EQUAL(
+        cache.get_mtu("eth0", "192.168.10.2", []() { return size_t(8000); }), 8000);
+}
@@ -0,0 +1,225 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/mock_link.hpp"
+#include <uhd/config.hpp>
+#include <uhdlib/transport/latency_probe.hpp>
+#include <uhdlib/transport/pcap_tap.hpp>
+#include <uhdlib/transport/udp_boost_asio_link.hpp>
+#include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using namespace uhd::transport;
+
+namespace {
+
+constexpr size_t FRAME_SIZE = 1024;
+
+struct block_t
+{
+    uint32_t type;
+    std::vector<uint8_t> body;
+};
+
+template <typename T>
+T read_at(const std::vector<uint8_t>& body, const size_t offset)
+{
+    T value;
+    std::memcpy(&value, body.data() + offset, sizeof(value));
+    return value;
+}
+
+std::vector<block_t> read_blocks(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    const std::vector<uint8_t> bytes(
+        (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::vector<block_t> blocks;
+    size_t offset = 0;
+    while (offset + 12 <= bytes.size()) {
+        block_t block;
+        block.type       = read_at<uint32_t>(bytes, offset);
+        const size_t len = read_at<uint32_t>(bytes, offset + 4);
+        BOOST_REQUIRE(len >= 12 && offset + len <= bytes.size());
+        BOOST_CHECK_EQUAL(read_at<uint32_t>(bytes, offset + len - 4), len);
+        block.body.assign(bytes.begin() + offset + 8, bytes.begin() + offset + len - 4);
+        blocks.push_back(block);
+        offset += len;
+    }
+    BOOST_CHECK_EQUAL(offset, bytes.size());
+    return blocks;
+}
+
+std::vector<block_t> get_packets(const std::vector<block_t>& blocks)
+{
+    std::vector<block_t> packets;
+    for (const auto& block : blocks) {
+        if (block.type == 6) {
+            packets.push_back(block);
+        }
+    }
+    return packets;
+}
+
+struct capture_fixture
+{
+    capture_fixture()
+        : path((boost::filesystem::temp_directory_path()
+                   / boost::filesystem::unique_path("uhd_pcap_%%%%%%.pcapng"))
+                   .string())
+    {
+    }
+
+    ~capture_fixture()
+    {
+        boost::filesystem::remove(path);
+    }
+
+    const std::string path;
+};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_CASE(test_pcap_links, capture_fixture)
+{
+    auto send_link = std::make_shared<mock_send_link>(
+        mock_send_link::link_params{FRAME_SIZE, 4});
+    auto recv_link = std::make_shared<mock_recv_link>(
+        mock_recv_link::link_params{FRAME_SIZE, 4});
+    const both_links_t links =
+        std::make_tuple(send_link, 4, recv_link, 4, false, false);
+    {
+        pcap_writer writer(path);
+        attach_pcap_taps(writer, links, "link0", uhd::device_addr_t("pcap_sample=2"));
+
+        for (size_t i = 0; i < 3; i++) {
+            auto buff = send_link->get_send_buff(0);
+            BOOST_REQUIRE(buff);
+            auto* data = static_cast<uint8_t*>(buff->data());
+            for (size_t j = 0; j < 100; j++) {
+                data[j] = static_cast<uint8_t>(i + j);
+            }
+            buff->set_packet_size(100);
+            send_link->release_send_buff(std::move(buff));
+        }
+
+        boost::shared_array<uint8_t> rx_data(new uint8_t[FRAME_SIZE]);
+        std::memset(rx_data.get(), 0xAB, FRAME_SIZE);
+        recv_link->push_back_recv_packet(rx_data, FRAME_SIZE);
+        auto buff = recv_link->get_recv_buff(0);
+        BOOST_REQUIRE(buff);
+        recv_link->release_recv_buff(std::move(buff));
+    }
+
+    const auto blocks = read_blocks(path);
+    BOOST_REQUIRE_GE(blocks.size(), 3);
+    BOOST_CHECK_EQUAL(blocks[0].type, 0x0A0D0D0A);
+    BOOST_CHECK_EQUAL(blocks[1].type, 1);
+    BOOST_CHECK_EQUAL(read_at<uint16_t>(blocks[1].body, 0), PCAP_LINKTYPE_CHDR);
+    BOOST_CHECK_EQUAL(read_at<uint32_t>(blocks[1].body, 4), FRAME_SIZE);
+
+    const auto packets = get_packets(blocks);
+    BOOST_REQUIRE_EQUAL(packets.size(), 4);
+    const size_t expected_len[] = {100, PCAP_DEFAULT_SNAPLEN, 100, PCAP_DEFAULT_SNAPLEN};
+    for (size_t i = 0; i < 3; i++) {
+        const auto& body = packets[i].body;
+        BOOST_CHECK_EQUAL(read_at<uint32_t>(body, 0), 0);
+        BOOST_CHECK_EQUAL(read_at<uint32_t>(body, 12), expected_len[i]);
+        BOOST_CHECK_EQUAL(read_at<uint32_t>(body, 16), 100);
+        BOOST_CHECK_EQUAL(body[20 + 5], static_cast<uint8_t>(i + 5));
+    }
+    // The received frame, the first one of its tap is captured in full
+    const auto& body = packets[3].body;
+    BOOST_CHECK_EQUAL(read_at<uint32_t>(body, 0), 1);
+    BOOST_CHECK_EQUAL(read_at<uint32_t>(body, 12), FRAME_SIZE);
+    BOOST_CHECK_EQUAL(body[20 + FRAME_SIZE - 1], 0xAB);
+    // The inbound flag
+    BOOST_CHECK_EQUAL(read_at<uint32_t>(body, 20 + FRAME_SIZE + 4), 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_pcap_drops, capture_fixture)
+{
+    constexpr size_t NUM_FRAMES = 1000;
+    const std::vector<uint8_t> frame(FRAME_SIZE, 0);
+    uint64_t num_dropped;
+    {
+        pcap_writer writer(path);
+        auto tap = writer.add_tap("tap", uhd::TX_DIRECTION, FRAME_SIZE, 16, 0, 2);
+        BOOST_CHECK_EQUAL(tap->get_snaplen(), 16);
+        for (size_t i = 0; i < NUM_FRAMES; i++) {
+            tap->capture(frame.data(), frame.size());
+        }
+        num_dropped = tap->get_num_dropped();
+    }
+    BOOST_CHECK_EQUAL(get_packets(read_blocks(path)).size() + num_dropped, NUM_FRAMES);
+}
+
+#ifdef UHD_PLATFORM_LINUX
+BOOST_FIXTURE_TEST_CASE(test_pcap_batched_udp_link, capture_fixture)
+{
+    using udp = boost::asio::ip::udp;
+    constexpr size_t NUM_PKTS = 3;
+
+    // The other end of the link
+    boost::asio::io_service io_service;
+    udp::socket peer(
+        io_service, udp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+
+    link_params_t params;
+    params.num_recv_frames = 8;
+    params.num_send_frames = 8;
+    params.recv_frame_size = FRAME_SIZE;
+    params.send_frame_size = FRAME_SIZE;
+    params.recv_buff_size  = 65536;
+    params.send_buff_size  = 65536;
+    params.recv_batch_size = 4;
+    size_t recv_socket_buff_size, send_socket_buff_size;
+    auto link = udp_boost_asio_link::make("127.0.0.1",
+        std::to_string(peer.local_endpoint().port()),
+        params,
+        recv_socket_buff_size,
+        send_socket_buff_size);
+    const udp::endpoint link_endpoint(
+        boost::asio::ip::address_v4::loopback(), link->get_local_port());
+
+    latency_probe::add_user();
+    {
+        pcap_writer writer(path);
+        BOOST_CHECK(link->set_recv_pcap_tap(
+            writer.add_tap("link0", uhd::RX_DIRECTION, FRAME_SIZE)));
+
+        for (size_t i = 0; i < NUM_PKTS; i++) {
+            const std::vector<uint8_t> packet(100 + i, static_cast<uint8_t>(i));
+            peer.send_to(boost::asio::buffer(packet), link_endpoint);
+        }
+
+        // All packets are pulled from the socket at once, but each one is
+        // stamped and captured
+        for (size_t i = 0; i < NUM_PKTS; i++) {
+            auto buff = link->get_recv_buff(1000);
+            BOOST_REQUIRE(buff);
+            BOOST_CHECK_EQUAL(buff->packet_size(), 100 + i);
+            BOOST_CHECK_NE(buff->get_timestamp(), 0);
+            link->release_recv_buff(std::move(buff));
+        }
+    }
+    latency_probe::remove_user();
+
+    const auto packets = get_packets(read_blocks(path));
+    BOOST_REQUIRE_EQUAL(packets.size(), NUM_PKTS);
+    for (size_t i = 0; i < NUM_PKTS; i++) {
+        const auto& body = packets[i].body;
+        BOOST_CHECK_EQUAL(read_at<uint32_t>(body, 12), PCAP_DEFAULT_SNAPLEN);
+        BOOST_CHECK_EQUAL(read_at<uint32_t>(body, 16), 100 + i);
+        BOOST_CHECK_EQUAL(body[20], static_cast<uint8_t>(i));
+    }
+}
+#endif
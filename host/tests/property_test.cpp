@@ -11,6 +11,8 @@
 #include <exception>
 #include <functional>
 #include <iostream>
+#include <string>
+#include <vector>
 
 
 struct coercer_type
@@ -283,3 +285,115 @@ BOOST_AUTO_TEST_CASE(test_mismatched_type_access)
     BOOST_CHECK_THROW(tree->access<double>("/stringprop"), uhd::runtime_error);
     BOOST_CHECK_THROW(tree->access<std::string>("/intprop"), uhd::runtime_error);
 }
+
+BOOST_AUTO_TEST_CASE(test_prop_handle)
+{
+    uhd::property_tree::sptr tree = uhd::property_tree::make();
+    tree->create<int>("/test/prop").set(42);
+
+    auto handle = tree->get_handle<int>("/test/prop");
+    BOOST_CHECK_EQUAL(handle->get(), 42);
+    BOOST_CHECK_EQUAL(handle.get(), &tree->access<int>("/test/prop"));
+    tree->access<int>("/test/prop").set(23);
+    BOOST_CHECK_EQUAL(handle->get(), 23);
+
+    BOOST_CHECK_THROW(tree->get_handle<double>("/test/prop"), uhd::runtime_error);
+    BOOST_CHECK_THROW(tree->get_handle<int>("/test/missing"), uhd::lookup_error);
+
+    // The handle keeps the property alive
+    tree->remove("/test/prop");
+    BOOST_CHECK(!tree->exists("/test/prop"));
+    handle->set(5);
+    BOOST_CHECK_EQUAL(handle->get(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_prop_transaction)
+{
+    uhd::property_tree::sptr tree = uhd::property_tree::make();
+    setter_type setter;
+    uhd::property<int>& prop = tree->create<int>("/prop").set(0).add_coerced_subscriber(
+        std::bind(&setter_type::doit, &setter, std::placeholders::_1));
+
+    {
+        uhd::property_tree::transaction txn(*tree);
+        prop.set(1);
+        prop.set(2);
+        tree->subtree("/")->access<int>("prop").set(3);
+        BOOST_CHECK_EQUAL(prop.get_desired(), 3);
+        BOOST_CHECK_EQUAL(setter._count, 0);
+        txn.commit();
+    }
+    // The subscriber ran once, with the last value
+    BOOST_CHECK_EQUAL(setter._count, 1);
+    BOOST_CHECK_EQUAL(setter._x, 3);
+    BOOST_CHECK_EQUAL(prop.get(), 3);
+
+    // Without a transaction, sets apply right away again
+    prop.set(4);
+    BOOST_CHECK_EQUAL(setter._count, 2);
+
+    // Reading a property applies its set
+    {
+        uhd::property_tree::transaction txn(*tree);
+        prop.set(5);
+        BOOST_CHECK_EQUAL(prop.get(), 5);
+        BOOST_CHECK_EQUAL(setter._count, 3);
+    }
+    BOOST_CHECK_EQUAL(setter._count, 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_prop_transaction_order)
+{
+    uhd::property_tree::sptr tree = uhd::property_tree::make();
+    std::vector<std::string> applied;
+    // The coercer of "freq" depends on "rate"
+    uhd::property<double>& rate = tree->create<double>("/rate").set(1.0);
+    rate.add_coerced_subscriber([&](const double) { applied.push_back("rate"); });
+    tree->create<double>("/freq")
+        .set_coercer([&](const double freq) {
+            applied.push_back("freq");
+            return freq * tree->access<double>("/rate").get();
+        })
+        .set(0.0);
+    applied.clear();
+
+    {
+        uhd::property_tree::transaction outer(*tree);
+        {
+            uhd::property_tree::transaction inner(*tree);
+            tree->access<double>("/freq").set(10.0);
+            tree->access<double>("/rate").set(2.0);
+            inner.commit();
+        }
+        BOOST_CHECK(applied.empty());
+        tree->access<double>("/freq").set(20.0);
+        outer.commit();
+    }
+    // The coercer of "freq" read "rate", which applied it before it was used
+    BOOST_REQUIRE_EQUAL(applied.size(), 2);
+    BOOST_CHECK_EQUAL(applied[0], "freq");
+    BOOST_CHECK_EQUAL(applied[1], "rate");
+    BOOST_CHECK_EQUAL(tree->access<double>("/freq").get(), 40.0);
+}
+
+BOOST_AUTO_TEST_CASE(test_prop_transaction_error)
+{
+    uhd::property_tree::sptr tree = uhd::property_tree::make();
+    setter_type setter;
+    tree->create<int>("/bad").add_coerced_subscriber([](const int x) {
+        if (x < 0) {
+            throw uhd::value_error("negative");
+        }
+    });
+    tree->create<int>("/good").add_coerced_subscriber(
+        std::bind(&setter_type::doit, &setter, std::placeholders::_1));
+
+    uhd::property_tree::transaction txn(*tree);
+    tree->access<int>("/bad").set(-1);
+    tree->access<int>("/good").set(1);
+    BOOST_CHECK_THROW(txn.commit(), uhd::value_error);
+    // The set after the failing one was dropped
+    BOOST_CHECK_EQUAL(setter._count, 0);
+    tree->access<int>("/good").set(2);
+    BOOST_CHECK_EQUAL(setter._count, 1);
+}
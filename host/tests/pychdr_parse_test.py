@@ -66,3 +66,35 @@ class CHDRParseTest(unittest.TestCase):
             chdr.ChdrWidth.W64, data)
         generated_data = bytes(generated_packet.serialize())
         self.assertEqual(generated_data, data)
+
+    def test_parse_packets(self):
+        """Parse a buffer of concatenated packets in bulk, and compare the
+        fields to those of the packets parsed one at a time
+        """
+        packets = rfnoc_packets_data.peer0 + rfnoc_packets_ctrl_mgmt.peer0
+        infos = chdr.parse_packets(chdr.ChdrWidth.W64, b"".join(packets))
+        self.assertEqual(len(infos), len(packets))
+        offset = 0
+        for info, packet_data in zip(infos, packets):
+            packet = chdr.ChdrPacket.deserialize(chdr.ChdrWidth.W64, packet_data)
+            header = packet.get_header()
+            self.assertEqual(info["offset"], offset)
+            self.assertEqual(info["length"], len(packet_data))
+            self.assertEqual(info["pkt_type"], int(header.pkt_type))
+            self.assertEqual(info["seq_num"], header.seq_num)
+            self.assertEqual(info["dst_epid"], header.dst_epid)
+            self.assertEqual(bool(info["has_timestamp"]),
+                             packet.get_timestamp() is not None)
+            if info["has_timestamp"]:
+                self.assertEqual(info["timestamp"], packet.get_timestamp())
+            payload_offset = info["payload_offset"] - offset
+            self.assertEqual(
+                packet_data[payload_offset:payload_offset + info["payload_size"]],
+                bytes(packet.get_payload_bytes()))
+            offset += len(packet_data)
+
+    def test_parse_packets_truncated(self):
+        """A truncated packet at the end of the buffer is an error"""
+        data = b"".join(rfnoc_packets_data.peer0[:2])
+        with self.assertRaises(RuntimeError):
+            chdr.parse_packets(chdr.ChdrWidth.W64, data[:-1])
@@ -0,0 +1,61 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/realtime.hpp>
+#include <boost/test/unit_test.hpp>
+#include <numeric>
+#include <vector>
+
+using namespace uhd;
+
+BOOST_AUTO_TEST_CASE(test_parse_realtime_args)
+{
+    const realtime_config_t defaults = parse_realtime_args(device_addr_t(""));
+    BOOST_CHECK(!defaults.is_enabled());
+
+    const realtime_config_t config = parse_realtime_args(device_addr_t(
+        "rt_lock_memory=current,rt_prefault=1,rt_priority_io=85,rt_priority_convert=7"));
+    BOOST_CHECK(config.is_enabled());
+    BOOST_CHECK_EQUAL(config.lock_memory, realtime_config_t::LOCK_CURRENT);
+    BOOST_CHECK(config.prefault);
+    BOOST_CHECK_EQUAL(config.get_priority(thread_role_t::STREAMER), 0);
+    BOOST_CHECK_EQUAL(config.get_priority(thread_role_t::IO), 85);
+    BOOST_CHECK_EQUAL(config.get_priority(thread_role_t::CONVERT), 7);
+    const auto lock_all = parse_realtime_args(device_addr_t("rt_lock_memory=ALL"));
+    BOOST_CHECK_EQUAL(lock_all.lock_memory, realtime_config_t::LOCK_ALL);
+
+    BOOST_CHECK_THROW(
+        parse_realtime_args(device_addr_t("rt_lock_memory=some")), uhd::value_error);
+    BOOST_CHECK_THROW(
+        parse_realtime_args(device_addr_t("rt_priority_streamer=100")), uhd::value_error);
+    BOOST_CHECK_THROW(
+        parse_realtime_args(device_addr_t("rt_priority_io=-1")), uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_realtime_config)
+{
+    realtime_config_t config;
+    config.prefault = true;
+    setup_realtime_process(config);
+    BOOST_CHECK(get_realtime_config().prefault);
+    // Without a priority for its role, a thread is left as it is
+    BOOST_CHECK(setup_realtime_thread(thread_role_t::STREAMER));
+
+    setup_realtime_process(realtime_config_t());
+    BOOST_CHECK(!get_realtime_config().is_enabled());
+}
+
+BOOST_AUTO_TEST_CASE(test_prefault_memory)
+{
+    // An odd size and offset, so the buffer does not start or end on a page
+    std::vector<uint8_t> buff(3 * 4096 + 17);
+    std::iota(buff.begin(), buff.end(), 0);
+    const std::vector<uint8_t> expected = buff;
+    prefault_memory(buff.data() + 1, buff.size() - 1);
+    prefault_memory(buff.data(), 0);
+    BOOST_CHECK(buff == expected);
+}
@@ -0,0 +1,213 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/utils/byteswap.hpp>
+#include <uhdlib/usrp/common/recv_packet_demuxer_3000.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace uhd::transport;
+using namespace uhd::usrp;
+
+namespace {
+
+constexpr size_t NUM_FRAMES = 32;
+
+//! A frame: the second word is the SID, the third one a sequence number
+class test_mrb : public managed_recv_buffer
+{
+public:
+    void release(void)
+    {
+        // The frame may be handed out again once this returns
+        const auto on_release = _on_release;
+        on_release();
+    }
+
+    sptr get_new(std::function<void()> on_release)
+    {
+        _on_release = on_release;
+        in_use      = true;
+        return make(this, _words, sizeof(_words));
+    }
+
+    uint32_t _words[3];
+    std::atomic<bool> in_use{false};
+
+private:
+    std::function<void()> _on_release;
+};
+
+//! A thread-safe transport with a fixed number of frames, like a real one
+class test_xport : public zero_copy_if
+{
+public:
+    void push_packet(const uint32_t sid, const uint32_t seq)
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _packets.emplace_back(sid, seq);
+        _cv.notify_all();
+    }
+
+    //! Waits for a packet and a free frame, like a real transport
+    managed_recv_buffer::sptr get_recv_buff(double timeout)
+    {
+        std::unique_lock<std::mutex> l(_mutex);
+        auto is_free = [](const test_mrb& mrb) { return !mrb.in_use; };
+        if (!_cv.wait_for(l, std::chrono::duration<double>(timeout), [&]() {
+                return !_packets.empty()
+                       && std::any_of(std::begin(_mrbs), std::end(_mrbs), is_free);
+            })) {
+            return managed_recv_buffer::sptr();
+        }
+        test_mrb& mrb = *std::find_if(std::begin(_mrbs), std::end(_mrbs), is_free);
+        mrb._words[0] = 0;
+        mrb._words[1] = uhd::htowx(_packets.front().first);
+        mrb._words[2] = _packets.front().second;
+        _packets.pop_front();
+        num_outstanding++;
+        return mrb.get_new([this, &mrb]() {
+            std::lock_guard<std::mutex> l(_mutex);
+            mrb.in_use = false;
+            num_outstanding--;
+            _cv.notify_all();
+        });
+    }
+
+    size_t get_num_recv_frames(void) const
+    {
+        return NUM_FRAMES;
+    }
+    size_t get_recv_frame_size(void) const
+    {
+        return sizeof(test_mrb::_words);
+    }
+    managed_send_buffer::sptr get_send_buff(double)
+    {
+        return managed_send_buffer::sptr();
+    }
+    size_t get_num_send_frames(void) const
+    {
+        return 0;
+    }
+    size_t get_send_frame_size(void) const
+    {
+        return 0;
+    }
+
+    std::atomic<size_t> num_outstanding{0};
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::deque<std::pair<uint32_t, uint32_t>> _packets;
+    test_mrb _mrbs[NUM_FRAMES];
+};
+
+uint32_t get_seq(managed_recv_buffer::sptr buff)
+{
+    return buff->cast<const uint32_t*>()[2];
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_demux_routing)
+{
+    auto xport = std::make_shared<test_xport>();
+    auto demux = recv_packet_demuxer_3000::make(xport);
+    demux->realloc_sid(0xA);
+    demux->realloc_sid(0xB);
+
+    xport->push_packet(0xB, 0);
+    xport->push_packet(0xC, 0); // Unknown SID, gets dropped
+    xport->push_packet(0xB, 1);
+    xport->push_packet(0xA, 2);
+    xport->push_packet(0xA, 3);
+
+    auto buff = demux->get_recv_buff(0xA, 0.0);
+    BOOST_REQUIRE(buff);
+    BOOST_CHECK_EQUAL(get_seq(buff), 2);
+    buff.reset();
+    // Both packets for B were queued while A read the transport
+    BOOST_CHECK_EQUAL(xport->num_outstanding, 2);
+    for (uint32_t seq = 0; seq < 2; seq++) {
+        buff = demux->get_recv_buff(0xB, 0.0);
+        BOOST_REQUIRE(buff);
+        BOOST_CHECK_EQUAL(get_seq(buff), seq);
+    }
+    BOOST_CHECK(!demux->get_recv_buff(0xB, 0.01));
+    buff = demux->get_recv_buff(0xA, 0.0);
+    BOOST_REQUIRE(buff);
+    BOOST_CHECK_EQUAL(get_seq(buff), 3);
+    buff.reset();
+    BOOST_CHECK_EQUAL(xport->num_outstanding, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_demux_realloc)
+{
+    auto xport = std::make_shared<test_xport>();
+    auto demux = recv_packet_demuxer_3000::make(xport);
+    demux->realloc_sid(0xA);
+    demux->realloc_sid(0xB);
+
+    xport->push_packet(0xB, 0);
+    xport->push_packet(0xB, 1);
+    BOOST_CHECK(!demux->get_recv_buff(0xA, 0.0));
+    BOOST_CHECK_EQUAL(xport->num_outstanding, 2);
+    // Clearing the queue releases its frames
+    demux->realloc_sid(0xB);
+    BOOST_CHECK_EQUAL(xport->num_outstanding, 0);
+    BOOST_CHECK(!demux->get_recv_buff(0xB, 0.0));
+}
+
+BOOST_AUTO_TEST_CASE(test_demux_threads)
+{
+    constexpr size_t NUM_SIDS   = 3;
+    constexpr uint32_t NUM_PKTS = 20000;
+    auto xport                  = std::make_shared<test_xport>();
+    auto demux                  = recv_packet_demuxer_3000::make(xport);
+    for (uint32_t sid = 0; sid < NUM_SIDS; sid++) {
+        demux->realloc_sid(sid);
+    }
+
+    std::vector<uint32_t> num_received(NUM_SIDS, 0);
+    std::vector<char> in_order(NUM_SIDS, true);
+    std::vector<std::thread> receivers;
+    for (uint32_t sid = 0; sid < NUM_SIDS; sid++) {
+        receivers.emplace_back([&, sid]() {
+            while (num_received[sid] < NUM_PKTS) {
+                auto buff = demux->get_recv_buff(sid, 1.0);
+                if (!buff) {
+                    return;
+                }
+                in_order[sid] = in_order[sid] && get_seq(buff) == num_received[sid];
+                num_received[sid]++;
+            }
+        });
+    }
+    for (uint32_t seq = 0; seq < NUM_PKTS; seq++) {
+        for (uint32_t sid = 0; sid < NUM_SIDS; sid++) {
+            xport->push_packet(sid, seq);
+        }
+    }
+    for (auto& receiver : receivers) {
+        receiver.join();
+    }
+
+    for (uint32_t sid = 0; sid < NUM_SIDS; sid++) {
+        BOOST_CHECK_EQUAL(num_received[sid], NUM_PKTS);
+        BOOST_CHECK(in_order[sid]);
+    }
+    BOOST_CHECK_EQUAL(xport->num_outstanding, 0);
+}
@@ -0,0 +1,70 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/rfnoc/dmafifo_block_control.hpp>
+#include <uhd/rfnoc/mock_block.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace uhd::rfnoc;
+
+// Redeclare this here, since it's only defined outside of UHD_API
+noc_block_base::make_args_t::~make_args_t() = default;
+
+namespace {
+
+constexpr noc_id_t NOC_ID     = 0xF1F00000;
+constexpr size_t NUM_CHANS    = 2;
+constexpr uint32_t REG_OFFSET = 128;
+constexpr uint32_t FIFO_MAGIC = 0xF1F0;
+constexpr uint64_t FIFO_SIZE  = 32 * 1024 * 1024;
+
+// FIFO core registers
+constexpr uint32_t REG_FIFO_INFO       = 0x0000;
+constexpr uint32_t REG_FIFO_MEM_SIZE   = 0x0008;
+constexpr uint32_t REG_FIFO_TIMEOUT    = 0x000C;
+constexpr uint32_t REG_FIFO_FULLNESS   = 0x0010;
+constexpr uint32_t REG_FIFO_ADDR_BASE  = 0x0018;
+constexpr uint32_t REG_FIFO_ADDR_MASK  = 0x0020;
+constexpr uint32_t REG_FIFO_PACKET_CNT = 0x0028;
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_dmafifo_block)
+{
+    auto block_container = get_mock_block(NOC_ID, NUM_CHANS, NUM_CHANS);
+    auto& reg_iface      = block_container.reg_iface;
+    auto set_mem64       = [&](const uint32_t addr, const uint64_t data) {
+        reg_iface->read_memory[addr]     = uint32_t(data & 0xFFFFFFFF);
+        reg_iface->read_memory[addr + 4] = uint32_t(data >> 32);
+    };
+    for (size_t chan = 0; chan < NUM_CHANS; chan++) {
+        const uint32_t base                                = chan * REG_OFFSET;
+        reg_iface->read_memory[base + REG_FIFO_INFO]       = FIFO_MAGIC << 16;
+        reg_iface->read_memory[base + REG_FIFO_MEM_SIZE]   = (64 << 16) | 30;
+        reg_iface->read_memory[base + REG_FIFO_TIMEOUT]    = 0x100;
+        reg_iface->read_memory[base + REG_FIFO_PACKET_CNT] = 10 + chan;
+        set_mem64(base + REG_FIFO_FULLNESS, 0);
+        set_mem64(base + REG_FIFO_ADDR_BASE, chan * FIFO_SIZE);
+        set_mem64(base + REG_FIFO_ADDR_MASK, FIFO_SIZE - 1);
+    }
+
+    auto test_fifo = block_container.get_block<dmafifo_block_control>();
+    BOOST_REQUIRE(test_fifo);
+
+    for (size_t chan = 0; chan < NUM_CHANS; chan++) {
+        BOOST_CHECK_EQUAL(test_fifo->get_fifo_size(chan), FIFO_SIZE);
+        BOOST_CHECK_EQUAL(test_fifo->get_fifo_fullness(chan), 0);
+        BOOST_CHECK_EQUAL(test_fifo->get_packet_count(chan), 10 + chan);
+    }
+
+    // The fill level is a 64-bit register, make sure both halves are read
+    constexpr uint64_t fullness = (uint64_t(1) << 32) + 4096;
+    set_mem64(REG_OFFSET + REG_FIFO_FULLNESS, fullness);
+    BOOST_CHECK_EQUAL(test_fifo->get_fifo_fullness(1), fullness);
+    BOOST_CHECK_EQUAL(test_fifo->get_fifo_fullness(0), 0);
+
+    BOOST_CHECK_THROW(test_fifo->get_fifo_fullness(NUM_CHANS), uhd::assertion_error);
+}
@@ -38,14 +38,18 @@ public:
     }
 
     virtual void _poke_cb(
-        uint32_t addr, uint32_t data, uhd::time_spec_t /*time*/, bool /*ack*/)
+        uint32_t addr, uint32_t data, uhd::time_spec_t time, bool /*ack*/)
     {
         if (addr == fir_filter_block_control::REG_FIR_MAX_NUM_COEFFS_ADDR) {
             throw uhd::assertion_error("Invalid write to read-only register");
         } else if (addr == fir_filter_block_control::REG_FIR_LOAD_COEFF_ADDR) {
+            if (time != uhd::time_spec_t::ASAP) {
+                throw uhd::assertion_error("Unexpected timed coefficient write");
+            }
             coeffs.push_back(uhd::narrow_cast<int16_t>(data));
         } else if (addr == fir_filter_block_control::REG_FIR_LOAD_COEFF_LAST_ADDR) {
-            last_coeff_write_pos = coeffs.size();
+            last_coeff_write_pos  = coeffs.size();
+            last_coeff_write_time = time;
             coeffs.push_back(uhd::narrow_cast<int16_t>(data));
         } else {
             throw uhd::assertion_error("Invalid write to out of bounds address");
@@ -63,11 +67,13 @@ public:
 
     void reset()
     {
-        last_coeff_write_pos = 0;
+        last_coeff_write_pos  = 0;
+        last_coeff_write_time = uhd::time_spec_t::ASAP;
         coeffs.clear();
     }
 
-    size_t last_coeff_write_pos = 0;
+    size_t last_coeff_write_pos            = 0;
+    uhd::time_spec_t last_coeff_write_time = uhd::time_spec_t::ASAP;
     std::vector<int16_t> coeffs{};
 
 private:
@@ -208,6 +214,70 @@ BOOST_FIXTURE_TEST_CASE(fir_filter_test_length_error, fir_filter_block_fixture)
     BOOST_CHECK_THROW(test_fir_filter->set_coefficients(coeffs), uhd::value_error);
 }
 
+/*
+ * This test case exercises the coefficient banks, and checks that switching
+ * banks makes only the final coefficient write timed.
+ */
+BOOST_FIXTURE_TEST_CASE(fir_filter_test_coefficient_banks, fir_filter_block_fixture)
+{
+    const size_t num_banks = test_fir_filter->get_num_coefficient_banks();
+    BOOST_REQUIRE_GT(num_banks, 1);
+    BOOST_CHECK_EQUAL(test_fir_filter->get_coefficient_bank(), 0);
+
+    // Loading a bank that is not selected does not touch the hardware
+    reg_iface->reset();
+    std::vector<int16_t> coeffs1{10, 20, 30};
+    test_fir_filter->set_bank_coefficients(1, coeffs1);
+    BOOST_CHECK(reg_iface->coeffs.empty());
+    std::vector<int16_t> bank_coeffs = test_fir_filter->get_bank_coefficients(1);
+    BOOST_REQUIRE_EQUAL(bank_coeffs.size(), MAX_NUM_COEFFS);
+    for (size_t i = 0; i < coeffs1.size(); i++) {
+        BOOST_CHECK_EQUAL(bank_coeffs.at(i), coeffs1.at(i));
+    }
+    // Bank 0 still has the impulse response
+    BOOST_CHECK_NE(test_fir_filter->get_coefficients().at(0), 0);
+
+    // Switch to bank 1 at a given time
+    const uhd::time_spec_t switch_time(1.5);
+    test_fir_filter->select_coefficient_bank(1, switch_time);
+    BOOST_CHECK_EQUAL(test_fir_filter->get_coefficient_bank(), 1);
+    BOOST_REQUIRE_EQUAL(reg_iface->coeffs.size(), MAX_NUM_COEFFS);
+    for (size_t i = 0; i < coeffs1.size(); i++) {
+        BOOST_CHECK_EQUAL(reg_iface->coeffs.at(i), coeffs1.at(i));
+    }
+    for (size_t i = coeffs1.size(); i < MAX_NUM_COEFFS; i++) {
+        BOOST_CHECK_EQUAL(reg_iface->coeffs.at(i), 0);
+    }
+    BOOST_CHECK_EQUAL(reg_iface->last_coeff_write_pos, MAX_NUM_COEFFS - 1);
+    BOOST_CHECK(reg_iface->last_coeff_write_time == switch_time);
+    BOOST_CHECK(test_fir_filter->get_coefficients() == bank_coeffs);
+
+    // set_coefficients() now updates bank 1, right away
+    reg_iface->reset();
+    std::vector<int16_t> coeffs2{-1, -2};
+    test_fir_filter->set_coefficients(coeffs2);
+    BOOST_REQUIRE_EQUAL(reg_iface->coeffs.size(), MAX_NUM_COEFFS);
+    BOOST_CHECK_EQUAL(reg_iface->coeffs.at(1), -2);
+    BOOST_CHECK(reg_iface->last_coeff_write_time == uhd::time_spec_t::ASAP);
+    BOOST_CHECK_EQUAL(test_fir_filter->get_bank_coefficients(1).at(0), -1);
+
+    // Switching back restores the impulse response
+    reg_iface->reset();
+    test_fir_filter->select_coefficient_bank(0);
+    BOOST_REQUIRE_EQUAL(reg_iface->coeffs.size(), MAX_NUM_COEFFS);
+    BOOST_CHECK_EQUAL(reg_iface->coeffs.at(0), std::numeric_limits<int16_t>::max());
+
+    BOOST_CHECK_THROW(test_fir_filter->select_coefficient_bank(num_banks),
+        uhd::value_error);
+    BOOST_CHECK_THROW(test_fir_filter->set_bank_coefficients(num_banks, coeffs1),
+        uhd::value_error);
+    BOOST_CHECK_THROW(test_fir_filter->get_bank_coefficients(num_banks),
+        uhd::value_error);
+    std::vector<int16_t> too_many(MAX_NUM_COEFFS + 1);
+    BOOST_CHECK_THROW(
+        test_fir_filter->set_bank_coefficients(2, too_many), uhd::value_error);
+}
+
 /*
  * This test case ensures that the FIR filter block can be added to
  * an RFNoC graph.
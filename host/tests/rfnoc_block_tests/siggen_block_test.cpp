@@ -51,6 +51,7 @@ public:
         if (port >= _num_ports) {
             throw uhd::assertion_error("Invalid port index");
         }
+        num_pokes++;
 
         const size_t offset = addr % siggen_block_control::REG_BLOCK_SIZE;
         if (offset == siggen_block_control::REG_ENABLE_OFFSET) {
@@ -146,6 +147,7 @@ public:
     std::vector<uint32_t> constants;
     std::vector<uint32_t> phase_increments;
     std::vector<uint32_t> phasors;
+    size_t num_pokes = 0;
 };
 
 /*
@@ -267,6 +269,67 @@ BOOST_FIXTURE_TEST_CASE(siggen_test_api, siggen_block_fixture)
     }
 }
 
+/*
+ * This test case ensures that set_config() changes all settings together, in
+ * a single write per register, and only if all of them are valid.
+ */
+BOOST_FIXTURE_TEST_CASE(siggen_test_config, siggen_block_fixture)
+{
+    for (size_t port = 0; port < NUM_PORTS; port++) {
+        siggen_config_t config;
+        config.waveform  = siggen_waveform::NOISE;
+        config.amplitude = 0.25 + (port * 0.1);
+        config.constant  = {-0.5 - (port * 0.05), 0.5 + (port * 0.05)};
+        config.phase_inc = (port * uhd::math::PI / 16.0);
+
+        reg_iface->num_pokes = 0;
+        test_siggen->set_config(config, port);
+        // Waveform, gain, constant, phase increment and Cartesian registers
+        BOOST_CHECK_EQUAL(reg_iface->num_pokes, 5);
+        BOOST_CHECK(reg_iface->waveforms.at(port) == siggen_waveform::NOISE);
+        BOOST_CHECK_EQUAL(reg_iface->gains.at(port),
+            siggen_mock_reg_iface_t::gain_to_register(config.amplitude));
+        BOOST_CHECK_EQUAL(reg_iface->constants.at(port),
+            siggen_mock_reg_iface_t::constant_to_register(config.constant));
+        BOOST_CHECK_EQUAL(reg_iface->phase_increments.at(port),
+            siggen_mock_reg_iface_t::phase_increment_to_register(config.phase_inc));
+
+        siggen_config_t readback = test_siggen->get_config(port);
+        BOOST_CHECK(readback.waveform == siggen_waveform::NOISE);
+        BOOST_CHECK_EQUAL(readback.amplitude, config.amplitude);
+        BOOST_CHECK_EQUAL(readback.constant, config.constant);
+        BOOST_CHECK_EQUAL(readback.phase_inc, config.phase_inc);
+
+        // The sine wave amplitude goes to the phasor, not the gain
+        config.waveform = siggen_waveform::SINE_WAVE;
+        test_siggen->set_config(config, port);
+        BOOST_CHECK(reg_iface->waveforms.at(port) == siggen_waveform::SINE_WAVE);
+        BOOST_CHECK_EQUAL(
+            reg_iface->gains.at(port), siggen_mock_reg_iface_t::gain_to_register(1.0));
+        BOOST_CHECK_EQUAL(reg_iface->phasors.at(port),
+            siggen_mock_reg_iface_t::phasor_to_register({config.amplitude, 0.0}));
+
+        // The amplitude is fixed at 1 in constant mode
+        config.waveform = siggen_waveform::CONSTANT;
+        test_siggen->set_config(config, port);
+        BOOST_CHECK_EQUAL(
+            reg_iface->gains.at(port), siggen_mock_reg_iface_t::gain_to_register(1.0));
+        BOOST_CHECK_EQUAL(test_siggen->get_config(port).amplitude, 1.0);
+
+        // An invalid setting changes nothing
+        siggen_config_t bad_config = config;
+        bad_config.waveform        = siggen_waveform::NOISE;
+        bad_config.amplitude       = 0.5;
+        bad_config.phase_inc       = 5 * uhd::math::PI;
+        reg_iface->num_pokes       = 0;
+        BOOST_CHECK_THROW(test_siggen->set_config(bad_config, port), uhd::value_error);
+        BOOST_CHECK_EQUAL(reg_iface->num_pokes, 0);
+        readback = test_siggen->get_config(port);
+        BOOST_CHECK(readback.waveform == siggen_waveform::CONSTANT);
+        BOOST_CHECK_EQUAL(readback.phase_inc, config.phase_inc);
+    }
+}
+
 /*
  * This test case exercises the range checking performed on the siggen
  * settings, ensuring that the appropriate exception is thrown when out of
@@ -46,6 +46,7 @@ public:
     {
         size_t chan   = addr / switchboard_block_control::REG_BLOCK_SIZE;
         size_t offset = addr % switchboard_block_control::REG_BLOCK_SIZE;
+        num_pokes++;
         if (offset == switchboard_block_control::REG_DEMUX_SELECT_ADDR) {
             output_select[chan] = data;
         } else if (offset == switchboard_block_control::REG_MUX_SELECT_ADDR) {
@@ -70,6 +71,7 @@ public:
 
     std::vector<uint32_t> input_select{};
     std::vector<uint32_t> output_select{};
+    size_t num_pokes = 0;
 };
 
 /* switchboard_block_fixture is a class which is instantiated before each test
@@ -133,6 +135,44 @@ BOOST_FIXTURE_TEST_CASE(swboard_test_exceptions, switchboard_block_fixture)
     BOOST_CHECK_EQUAL(reg_iface->input_select.at(0), 0);
 }
 
+BOOST_FIXTURE_TEST_CASE(swboard_test_routes, switchboard_block_fixture)
+{
+    using route_t = switchboard_block_control::route_t;
+    // Invalid routes are rejected when they are added
+    BOOST_CHECK_THROW(test_switchboard->add_route({{NUM_INPUTS, 0}}), uhd::value_error);
+    BOOST_CHECK_THROW(test_switchboard->add_route({{0, NUM_OUTPUTS}}), uhd::value_error);
+    BOOST_CHECK_THROW(test_switchboard->add_route({{0, 1}, {1, 1}}), uhd::value_error);
+    BOOST_CHECK_THROW(test_switchboard->select_route(0), uhd::value_error);
+
+    const size_t route_a = test_switchboard->add_route({{0, 2}, {1, 3}});
+    const size_t route_b = test_switchboard->add_route({{0, 3}, {1, 2}});
+    BOOST_CHECK_EQUAL(route_a, 0);
+    BOOST_CHECK_EQUAL(route_b, 1);
+
+    reg_iface->num_pokes = 0;
+    test_switchboard->select_route(route_a);
+    BOOST_CHECK_EQUAL(reg_iface->output_select.at(0), 2);
+    BOOST_CHECK_EQUAL(reg_iface->output_select.at(1), 3);
+    BOOST_CHECK_EQUAL(reg_iface->input_select.at(2), 0);
+    BOOST_CHECK_EQUAL(reg_iface->input_select.at(3), 1);
+    BOOST_CHECK_EQUAL(reg_iface->num_pokes, 4);
+    BOOST_CHECK((test_switchboard->get_route() == route_t{{0, 2}, {1, 3}}));
+
+    // Switching again only writes what changed
+    reg_iface->num_pokes = 0;
+    test_switchboard->select_route(route_a);
+    BOOST_CHECK_EQUAL(reg_iface->num_pokes, 0);
+    test_switchboard->select_route(route_b);
+    BOOST_CHECK_EQUAL(reg_iface->num_pokes, 4);
+    BOOST_CHECK((test_switchboard->get_route() == route_t{{0, 3}, {1, 2}}));
+
+    // connect() still works after switching away from the properties
+    test_switchboard->connect(0, 0);
+    BOOST_CHECK_EQUAL(reg_iface->output_select.at(0), 0);
+    BOOST_CHECK_EQUAL(reg_iface->input_select.at(0), 0);
+    BOOST_CHECK((test_switchboard->get_route() == route_t{{0, 0}, {1, 2}}));
+}
+
 BOOST_FIXTURE_TEST_CASE(swboard_test_graph, switchboard_block_fixture)
 {
     detail::graph_t graph{};
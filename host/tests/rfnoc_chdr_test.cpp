@@ -277,6 +277,112 @@ BOOST_AUTO_TEST_CASE(chdr_generic_packet_calculate_pyld_offset_64)
     }
 }
 
+BOOST_AUTO_TEST_CASE(chdr_generic_packet_parse_and_write_header)
+{
+    auto test_fast_path = [](const chdr_packet_factory& factory,
+                              const packet_type_t pkt_type,
+                              const size_t num_mdata) {
+        chdr_packet_writer::uptr tx_pkt = factory.make_generic();
+        chdr_packet_writer::uptr rx_pkt = factory.make_generic();
+        uint64_t buff[MAX_BUF_SIZE_WORDS];
+        const uint64_t timestamp  = rand64();
+        const size_t payload_size = 32;
+
+        chdr_header header;
+        header.set_pkt_type(pkt_type);
+        header.set_num_mdata(num_mdata);
+        header.set_seq_num(rand64() & 0xFFFF);
+        header.set_eob(true);
+        void* payload = tx_pkt->write_header(buff, header, timestamp, payload_size);
+        BOOST_CHECK(payload == tx_pkt->get_payload_ptr());
+        BOOST_CHECK_EQUAL(tx_pkt->get_payload_size(), payload_size);
+        BOOST_CHECK_EQUAL(header.get_length(), tx_pkt->get_chdr_header().get_length());
+
+        const auto view = rx_pkt->parse(buff);
+        rx_pkt->refresh(buff);
+        BOOST_CHECK(view.header == rx_pkt->get_chdr_header());
+        BOOST_CHECK(view.header == header);
+        BOOST_CHECK_EQUAL(view.has_timestamp, bool(rx_pkt->get_timestamp()));
+        if (view.has_timestamp) {
+            BOOST_CHECK_EQUAL(view.timestamp, timestamp);
+        }
+        BOOST_CHECK_EQUAL(view.payload_size, payload_size);
+        BOOST_CHECK(view.payload == payload);
+        BOOST_CHECK(view.payload == rx_pkt->get_payload_const_ptr());
+    };
+
+    for (const auto* factory :
+        {&chdr64_be_factory, &chdr64_le_factory, &chdr256_be_factory}) {
+        for (size_t num_mdata = 0; num_mdata < 3; num_mdata++) {
+            test_fast_path(*factory, PKT_TYPE_DATA_NO_TS, num_mdata);
+            test_fast_path(*factory, PKT_TYPE_DATA_WITH_TS, num_mdata);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(chdr_data_packet_layout_matches_generic)
+{
+    // The data packet layouts must read and write the same packets as the
+    // generic packet container, for every CHDR width and endianness
+    auto test_layout = [](const chdr_packet_factory& factory,
+                           const packet_type_t pkt_type,
+                           const size_t num_mdata) {
+        chdr_packet_writer::uptr pkt = factory.make_generic();
+        uint64_t buff[MAX_BUF_SIZE_WORDS];
+        uint64_t layout_buff[MAX_BUF_SIZE_WORDS];
+        const uint64_t timestamp  = rand64();
+        const size_t payload_size = 64;
+        const bool has_timestamp  = pkt_type == PKT_TYPE_DATA_WITH_TS;
+
+        chdr_header header;
+        header.set_pkt_type(pkt_type);
+        header.set_num_mdata(num_mdata);
+        header.set_seq_num(rand64() & 0xFFFF);
+        header.set_eov(true);
+        chdr_header layout_header = header;
+        pkt->write_header(buff, header, timestamp, payload_size);
+
+        visit_data_packet_layout(
+            factory.get_chdr_w(), factory.get_endianness(), [&](auto layout) {
+                using layout_t = decltype(layout);
+                BOOST_CHECK_EQUAL(layout_t::payload_offset(has_timestamp, num_mdata),
+                    pkt->calculate_payload_offset(pkt_type, num_mdata));
+
+                void* payload = layout_t::write_header(
+                    layout_buff, layout_header, timestamp, payload_size);
+                BOOST_CHECK(layout_header == header);
+                BOOST_CHECK_EQUAL(layout_buff[0], buff[0]);
+                if (has_timestamp) {
+                    BOOST_CHECK_EQUAL(layout_buff[1], buff[1]);
+                }
+                const size_t offset = static_cast<uint8_t*>(payload)
+                                      - reinterpret_cast<uint8_t*>(layout_buff);
+                BOOST_CHECK_EQUAL(
+                    offset, layout_t::payload_offset(has_timestamp, num_mdata));
+
+                BOOST_CHECK(layout_t::read_header(buff) == header);
+                const auto view = layout_t::parse(buff);
+                pkt->refresh(buff);
+                BOOST_CHECK(view.header == header);
+                BOOST_CHECK_EQUAL(view.has_timestamp, has_timestamp);
+                if (has_timestamp) {
+                    BOOST_CHECK_EQUAL(view.timestamp, timestamp);
+                }
+                BOOST_CHECK_EQUAL(view.payload_size, payload_size);
+                BOOST_CHECK(view.payload == pkt->get_payload_const_ptr());
+            });
+    };
+
+    for (const auto chdr_w : {CHDR_W_64, CHDR_W_128, CHDR_W_256, CHDR_W_512}) {
+        for (const auto endianness : {ENDIANNESS_BIG, ENDIANNESS_LITTLE}) {
+            const chdr_packet_factory factory(chdr_w, endianness);
+            for (size_t num_mdata = 0; num_mdata < 3; num_mdata++) {
+                test_layout(factory, PKT_TYPE_DATA_NO_TS, num_mdata);
+                test_layout(factory, PKT_TYPE_DATA_WITH_TS, num_mdata);
+            }
+        }
+    }
+}
 
 BOOST_AUTO_TEST_CASE(chdr_mgmt_packet_no_swap_64)
 {
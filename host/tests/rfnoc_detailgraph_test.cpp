@@ -258,3 +258,39 @@ BOOST_AUTO_TEST_CASE(test_graph_disconnect_reconnect)
 
     BOOST_CHECK_EQUAL(graph.enumerate_edges().size(), 1);
 }
+
+BOOST_AUTO_TEST_CASE(test_graph_connect_bulk)
+{
+    graph_t graph{};
+    node_accessor_t node_accessor{};
+
+    mock_radio_node_t mock_rx_radio(0);
+    mock_ddc_node_t mock_ddc{};
+    mock_radio_node_t mock_tx_radio(1);
+
+    node_accessor.init_props(&mock_rx_radio);
+    node_accessor.init_props(&mock_ddc);
+    node_accessor.init_props(&mock_tx_radio);
+
+    graph_t::graph_edge_t edge_info(0, 0, graph_t::graph_edge_t::DYNAMIC, true);
+
+    // All connections are added at once
+    graph.connect({graph_t::connection_t{&mock_rx_radio, &mock_ddc, edge_info},
+        graph_t::connection_t{&mock_ddc, &mock_tx_radio, edge_info}});
+    graph.commit();
+    BOOST_CHECK_EQUAL(graph.enumerate_edges().size(), 2);
+
+    // If one connection fails, none of them are added
+    mock_radio_node_t mock_rx_radio2(2);
+    node_accessor.init_props(&mock_rx_radio2);
+    graph_t::graph_edge_t edge_info1(1, 1, graph_t::graph_edge_t::DYNAMIC, true);
+    BOOST_REQUIRE_THROW(
+        graph.connect({graph_t::connection_t{&mock_rx_radio, &mock_tx_radio, edge_info1},
+            graph_t::connection_t{&mock_rx_radio2, &mock_ddc, edge_info}}),
+        uhd::rfnoc_error);
+    BOOST_CHECK_EQUAL(graph.enumerate_edges().size(), 2);
+
+    // Repeating existing connections is fine
+    graph.connect({graph_t::connection_t{&mock_rx_radio, &mock_ddc, edge_info}});
+    BOOST_CHECK_EQUAL(graph.enumerate_edges().size(), 2);
+}
@@ -0,0 +1,228 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/math.hpp>
+#include <uhdlib/rfnoc/host_blocks.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+using namespace uhd::rfnoc;
+
+namespace {
+
+using sample_t = host_block::sample_t;
+using packet_t = host_block::packet_t;
+
+//! Runs a single-input block on one packet, and returns its first output
+packet_t run(host_block& block, const packet_t& input)
+{
+    std::vector<packet_t> out;
+    block.process({&input}, out);
+    BOOST_REQUIRE_EQUAL(out.size(), block.get_num_output_ports());
+    return out[0];
+}
+
+packet_t make_ramp(const size_t len, const int16_t start = 0)
+{
+    packet_t packet(len);
+    for (size_t i = 0; i < len; i++) {
+        packet[i] = sample_t(int16_t(start + i), int16_t(-start - int16_t(i)));
+    }
+    return packet;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_host_block_make)
+{
+    for (const auto& name : host_block::get_block_names()) {
+        BOOST_CHECK(host_block::make(name));
+    }
+    BOOST_CHECK_THROW(host_block::make("Radio"), uhd::key_error);
+
+    auto fft = std::dynamic_pointer_cast<host_fft>(
+        host_block::make("FFT", uhd::device_addr_t("length=100")));
+    BOOST_REQUIRE(fft);
+    BOOST_CHECK_EQUAL(fft->get_length(), 64);
+
+    // Wrong number of inputs
+    auto addsub = host_block::make("AddSub");
+    packet_t packet = make_ramp(4);
+    std::vector<packet_t> out;
+    BOOST_CHECK_THROW(addsub->process({&packet}, out), uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_host_keep_one_in_n)
+{
+    host_keep_one_in_n block;
+    block.set_n(3);
+    // The count continues across packets
+    packet_t out = run(block, make_ramp(4));
+    BOOST_REQUIRE_EQUAL(out.size(), 2);
+    BOOST_CHECK_EQUAL(out[0].real(), 0);
+    BOOST_CHECK_EQUAL(out[1].real(), 3);
+    out = run(block, make_ramp(6, 4));
+    BOOST_REQUIRE_EQUAL(out.size(), 2);
+    BOOST_CHECK_EQUAL(out[0].real(), 6);
+    BOOST_CHECK_EQUAL(out[1].real(), 9);
+
+    block.set_mode(host_keep_one_in_n::mode_t::PACKET_MODE);
+    BOOST_CHECK_EQUAL(run(block, make_ramp(4)).size(), 4);
+    BOOST_CHECK(run(block, make_ramp(4)).empty());
+    BOOST_CHECK(run(block, make_ramp(4)).empty());
+    BOOST_CHECK_EQUAL(run(block, make_ramp(4)).size(), 4);
+
+    BOOST_CHECK_THROW(block.set_n(0), uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_host_moving_average)
+{
+    host_moving_average block;
+    block.set_sum_len(4);
+    block.set_divisor(4);
+    const packet_t input(10, sample_t(100, -101));
+    const packet_t out = run(block, input);
+    // The history starts out with zeros
+    const int16_t expected_i[] = {25, 50, 75, 100};
+    const int16_t expected_q[] = {-25, -50, -76, -101};
+    for (size_t i = 0; i < 4; i++) {
+        BOOST_CHECK_EQUAL(out[i].real(), expected_i[i]);
+        BOOST_CHECK_EQUAL(out[i].imag(), expected_q[i]);
+    }
+    BOOST_CHECK_EQUAL(out[9].real(), 100);
+
+    // A sum saturates
+    block.set_divisor(1);
+    const packet_t big(4, sample_t(30000, -30000));
+    const packet_t sum = run(block, big);
+    BOOST_CHECK_EQUAL(sum[3].real(), 32767);
+    BOOST_CHECK_EQUAL(sum[3].imag(), -32768);
+}
+
+BOOST_AUTO_TEST_CASE(test_host_vector_iir)
+{
+    host_vector_iir block;
+    block.set_alpha(0.5);
+    block.set_beta(1.0);
+    block.set_delay(2);
+    // An impulse repeats every delay samples, halved each time
+    packet_t input(3, sample_t(0, 0));
+    input[0] = sample_t(1000, -1000);
+    packet_t out = run(block, input);
+    BOOST_CHECK_EQUAL(out[0].real(), 1000);
+    BOOST_CHECK_EQUAL(out[1].real(), 0);
+    BOOST_CHECK_EQUAL(out[2].real(), 500);
+    BOOST_CHECK_EQUAL(out[2].imag(), -500);
+    out = run(block, packet_t(3, sample_t(0, 0)));
+    BOOST_CHECK_EQUAL(out[0].real(), 0);
+    BOOST_CHECK_EQUAL(out[1].real(), 250);
+    BOOST_CHECK_EQUAL(out[2].real(), 0);
+
+    BOOST_CHECK_THROW(block.set_alpha(1.5), uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_host_window)
+{
+    host_window block;
+    block.set_coefficients({32767, 16384, -16384});
+    const packet_t input(4, sample_t(1000, -1000));
+    packet_t out = run(block, input);
+    BOOST_CHECK_EQUAL(out[0].real(), 999);
+    BOOST_CHECK_EQUAL(out[1].real(), 500);
+    BOOST_CHECK_EQUAL(out[2].real(), -500);
+    BOOST_CHECK_EQUAL(out[2].imag(), 500);
+    // The window restarts after its length, also across packets
+    BOOST_CHECK_EQUAL(out[3].real(), 999);
+    out = run(block, input);
+    BOOST_CHECK_EQUAL(out[0].real(), 500);
+}
+
+BOOST_AUTO_TEST_CASE(test_host_logpwr)
+{
+    host_logpwr block;
+    const packet_t out = run(block, {{0, 0}, {1, 0}, {3, 4}, {-32768, -32768}});
+    BOOST_CHECK_EQUAL(out[0].real(), 0);
+    BOOST_CHECK_EQUAL(out[1].real(), 0);
+    BOOST_CHECK_EQUAL(out[2].real(), int16_t(std::lround(1024 * std::log2(25.0))));
+    BOOST_CHECK_EQUAL(out[3].real(), 31 * 1024);
+    BOOST_CHECK_EQUAL(out[3].imag(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_host_fft)
+{
+    constexpr size_t LEN = 16;
+    host_fft block;
+    block.set_length(LEN);
+    block.set_scaling(0);
+    block.set_shift_config(fft_shift::NATURAL);
+
+    // A tone at bin 2
+    packet_t input(LEN);
+    for (size_t i = 0; i < LEN; i++) {
+        const double phase = 2.0 * uhd::math::PI * 2.0 * double(i) / LEN;
+        input[i] = sample_t(int16_t(std::lround(1000 * std::cos(phase))),
+            int16_t(std::lround(1000 * std::sin(phase))));
+    }
+    packet_t out = run(block, input);
+    BOOST_REQUIRE_EQUAL(out.size(), LEN);
+    for (size_t k = 0; k < LEN; k++) {
+        if (k == 2) {
+            BOOST_CHECK_CLOSE(double(out[k].real()), 16000.0, 0.1);
+        } else {
+            BOOST_CHECK_SMALL(double(std::abs(std::complex<double>(
+                                  out[k].real(), out[k].imag()))),
+                4.0);
+        }
+    }
+
+    // Scaling of 1/N, with the zero frequency bin in the middle
+    block.set_scaling(0x2A);
+    block.set_shift_config(fft_shift::NORMAL);
+    out = run(block, input);
+    BOOST_CHECK_CLOSE(double(out[LEN / 2 + 2].real()), 1000.0, 0.1);
+
+    // The inverse of the tone at bin 2 is a tone at bin -2
+    block.set_direction(fft_direction::REVERSE);
+    block.set_shift_config(fft_shift::NATURAL);
+    block.set_magnitude(fft_magnitude::MAGNITUDE);
+    out = run(block, input);
+    BOOST_CHECK_CLOSE(double(out[LEN - 2].real()), 1000.0, 0.1);
+    BOOST_CHECK_EQUAL(out[LEN - 2].imag(), 0);
+
+    BOOST_CHECK_THROW(run(block, make_ramp(LEN + 1)), uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_host_addsub)
+{
+    host_addsub block;
+    const packet_t a{{1, 2}, {32767, -32768}};
+    const packet_t b{{3, 5}, {1, 1}};
+    std::vector<packet_t> out;
+    block.process({&a, &b}, out);
+    BOOST_REQUIRE_EQUAL(out.size(), 2);
+    BOOST_CHECK(out[0][0] == sample_t(4, 7));
+    BOOST_CHECK(out[1][0] == sample_t(-2, -3));
+    // The FPGA adders wrap around
+    BOOST_CHECK(out[0][1] == sample_t(-32768, -32767));
+    BOOST_CHECK(out[1][1] == sample_t(32766, 32767));
+
+    const packet_t c(3);
+    BOOST_CHECK_THROW(block.process({&a, &c}, out), uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_host_split_stream)
+{
+    host_split_stream block;
+    block.set_num_branches(3);
+    const packet_t input = make_ramp(8);
+    std::vector<packet_t> out;
+    block.process({&input}, out);
+    BOOST_REQUIRE_EQUAL(out.size(), 3);
+    for (const auto& branch : out) {
+        BOOST_CHECK(branch == input);
+    }
+}
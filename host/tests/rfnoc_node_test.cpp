@@ -142,6 +142,34 @@ BOOST_AUTO_TEST_CASE(test_node_prop_access)
     BOOST_CHECK_EQUAL(TN1.get_property<double>("double_prop"), 4.2);
 }
 
+BOOST_AUTO_TEST_CASE(test_node_prop_handle)
+{
+    test_node_t TN1(2, 3);
+
+    BOOST_REQUIRE_THROW(
+        TN1.get_property_handle<int>("nonexistant_prop"), uhd::lookup_error);
+    BOOST_REQUIRE_THROW(TN1.get_property_handle<int>("double_prop"), uhd::type_error);
+    BOOST_REQUIRE_THROW(
+        TN1.get_property_handle<double>("double_prop", 5), uhd::lookup_error);
+
+    property_handle<double> invalid_handle;
+    BOOST_CHECK(!invalid_handle.is_valid());
+    BOOST_REQUIRE_THROW(invalid_handle.get(), uhd::lookup_error);
+    BOOST_REQUIRE_THROW(invalid_handle.set(1.0), uhd::lookup_error);
+
+    auto handle_0 = TN1.get_property_handle<double>("multi_instance_prop", 0);
+    auto handle_1 = TN1.get_property_handle<double>("multi_instance_prop", 1);
+    BOOST_CHECK(handle_0.is_valid());
+    handle_0.set(1.5);
+    handle_1.set(-2.5);
+    BOOST_CHECK_EQUAL(handle_0.get(), 1.5);
+    BOOST_CHECK_EQUAL(handle_1.get(), -2.5);
+    // The handles and the lookup by ID access the same properties
+    BOOST_CHECK_EQUAL(TN1.get_property<double>("multi_instance_prop", 0), 1.5);
+    TN1.set_property<double>("multi_instance_prop", 3.5, 1);
+    BOOST_CHECK_EQUAL(handle_1.get(), 3.5);
+}
+
 BOOST_AUTO_TEST_CASE(test_node_accessor)
 {
     test_node_t TN1(2, 3);
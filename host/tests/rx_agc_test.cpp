@@ -0,0 +1,160 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/mock_rx_streamer.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/utils/rx_agc.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+namespace {
+
+constexpr double RATE = 1e6;
+
+/*! Streams a constant tone, and applies gain changes at their command time
+ *
+ * The tone has a power of power_dbfs at a gain of 0 dB.
+ */
+class tone_rx_streamer : public uhd::mock_rx_streamer
+{
+public:
+    tone_rx_streamer(const double power_dbfs, const bool timed)
+        : uhd::mock_rx_streamer(make_params(this, timed), {packet_t{300}})
+        , _ampl(std::pow(10.0, power_dbfs / 20.0))
+        , _timed(timed)
+    {
+    }
+
+    double set_gain(const double gain, const uhd::time_spec_t& time)
+    {
+        BOOST_CHECK_EQUAL(time != uhd::time_spec_t(0.0), _timed);
+        // Commands must be late enough not to change samples already received
+        BOOST_CHECK(!_timed || uint64_t(time.to_ticks(RATE)) >= _num_samps);
+        _changes.push_back({uint64_t(time.to_ticks(RATE)), gain});
+        return gain;
+    }
+
+private:
+    static stream_params make_params(tone_rx_streamer* self, const bool timed)
+    {
+        stream_params params;
+        params.rate   = timed ? RATE : 0.0;
+        params.repeat = true;
+        params.fill   = [self](const buffs_type& buffs, size_t first, size_t nsamps) {
+            self->fill(buffs, first, nsamps);
+        };
+        return params;
+    }
+
+    void fill(const buffs_type& buffs, const size_t first_samp, const size_t nsamps)
+    {
+        auto* samps = static_cast<std::complex<float>*>(buffs[0]);
+        for (_num_samps = first_samp; _num_samps < first_samp + nsamps; _num_samps++) {
+            // Changes take effect at their time, or right away when untimed
+            while (!_changes.empty()
+                   && (_changes.front().first <= _num_samps || !_timed)) {
+                _gain = _changes.front().second;
+                _changes.erase(_changes.begin());
+            }
+            samps[_num_samps - first_samp] =
+                std::complex<float>(float(_ampl * std::pow(10.0, _gain / 20.0)));
+        }
+    }
+
+    const double _ampl;
+    const bool _timed;
+    double _gain        = 0.0;
+    uint64_t _num_samps = 0;
+    std::vector<std::pair<uint64_t, double>> _changes;
+};
+
+uhd::rx_agc::sptr make_agc(std::shared_ptr<tone_rx_streamer> rx_stream)
+{
+    return uhd::rx_agc::make(rx_stream,
+        "fc32",
+        RATE,
+        uhd::gain_range_t(0.0, 60.0, 0.5),
+        0.0,
+        [rx_stream](const double gain, const uhd::time_spec_t& time) {
+            return rx_stream->set_gain(gain, time);
+        },
+        uhd::device_addr_t("target=-20,block_size=1000,decay=0.5,cmd_delay=1e-3"));
+}
+
+//! Receives \p nsamps samples and returns the power of the last block, in dBFS
+double recv(uhd::rx_agc& agc, const size_t nsamps)
+{
+    std::vector<std::complex<float>> buff(1000);
+    uhd::rx_metadata_t md;
+    for (size_t n = 0; n < nsamps;) {
+        n += agc.recv(buff.data(), buff.size(), md);
+    }
+    return agc.get_power();
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_rx_agc_timed)
+{
+    // A weak signal is brought up to the target
+    auto rx_stream = std::make_shared<tone_rx_streamer>(-50.0, true);
+    auto agc       = make_agc(rx_stream);
+    BOOST_CHECK_LE(std::abs(recv(*agc, 100000) + 20.0), 1.0);
+    BOOST_CHECK_GE(agc->get_gain(), 29.0);
+    BOOST_CHECK_LE(agc->get_gain(), 31.0);
+
+    const auto changes = agc->get_gain_changes();
+    BOOST_REQUIRE(!changes.empty());
+    for (size_t i = 1; i < changes.size(); i++) {
+        BOOST_CHECK(changes[i].has_time_spec);
+        BOOST_CHECK(changes[i].time > changes[i - 1].time);
+        // The samples at the old gain aren't measured again
+        BOOST_CHECK_GE(
+            changes[i].time.to_ticks(RATE) - changes[i - 1].time.to_ticks(RATE),
+            1000 + 1000);
+    }
+    BOOST_CHECK_EQUAL(changes.back().gain, agc->get_gain());
+    BOOST_CHECK(agc->get_gain_changes().empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_rx_agc_untimed)
+{
+    // A strong signal is attenuated right away, as far as the gain range goes
+    auto rx_stream = std::make_shared<tone_rx_streamer>(10.0, false);
+    auto agc       = make_agc(rx_stream);
+    recv(*agc, 10000);
+    BOOST_CHECK_EQUAL(agc->get_gain(), 0.0);
+    BOOST_CHECK(agc->get_gain_changes().empty());
+
+    rx_stream = std::make_shared<tone_rx_streamer>(-30.0, false);
+    agc       = make_agc(rx_stream);
+    BOOST_CHECK_LE(std::abs(recv(*agc, 100000) + 20.0), 1.0);
+    const auto changes = agc->get_gain_changes();
+    BOOST_REQUIRE(!changes.empty());
+    BOOST_CHECK(!changes.front().has_time_spec);
+}
+
+BOOST_AUTO_TEST_CASE(test_rx_agc_args)
+{
+    auto rx_stream = std::make_shared<tone_rx_streamer>(0.0, true);
+    auto set_gain  = [](const double gain, const uhd::time_spec_t&) { return gain; };
+    const uhd::gain_range_t range(0.0, 10.0, 1.0);
+    BOOST_CHECK_THROW(uhd::rx_agc::make(rx_stream, "sc12", RATE, range, 0.0, set_gain),
+        uhd::value_error);
+    BOOST_CHECK_THROW(uhd::rx_agc::make(rx_stream, "fc32", 0.0, range, 0.0, set_gain),
+        uhd::value_error);
+    BOOST_CHECK_THROW(uhd::rx_agc::make(rx_stream,
+                          "fc32",
+                          RATE,
+                          range,
+                          0.0,
+                          set_gain,
+                          uhd::device_addr_t("attack=2")),
+        uhd::value_error);
+}
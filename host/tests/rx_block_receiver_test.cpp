@@ -0,0 +1,78 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/mock_rx_streamer.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/utils/rx_block_receiver.hpp>
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+namespace {
+
+constexpr size_t SAMPS_PER_BLOCK = 32;
+
+/*! Returns a given number of buffers, where every item holds the index of
+ *  its buffer, and then times out
+ */
+std::shared_ptr<uhd::mock_rx_streamer> make_rx_streamer(const size_t num_buffs)
+{
+    uhd::mock_rx_streamer::stream_params params;
+    params.max_num_samps = SAMPS_PER_BLOCK;
+    return std::make_shared<uhd::mock_rx_streamer>(params,
+        std::vector<uhd::mock_rx_streamer::packet_t>(
+            num_buffs, uhd::mock_rx_streamer::packet_t{SAMPS_PER_BLOCK}));
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_block_receiver_args)
+{
+    auto rx = make_rx_streamer(0);
+    BOOST_CHECK_THROW(
+        uhd::rx_block_receiver::make(rx, {}, SAMPS_PER_BLOCK), uhd::value_error);
+    std::vector<uint8_t> buff0(SAMPS_PER_BLOCK), buff1(SAMPS_PER_BLOCK);
+    BOOST_CHECK_THROW(uhd::rx_block_receiver::make(
+                          rx, {{buff0.data(), buff1.data()}}, SAMPS_PER_BLOCK),
+        uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_block_receiver)
+{
+    auto rx = make_rx_streamer(5);
+    std::vector<std::vector<uint8_t>> memory(2, std::vector<uint8_t>(SAMPS_PER_BLOCK));
+    auto receiver = uhd::rx_block_receiver::make(
+        rx, {{memory[0].data()}, {memory[1].data()}}, SAMPS_PER_BLOCK);
+
+    // The samples go straight into the blocks of the application
+    uhd::rx_block_receiver::block_t block0, block1, block2;
+    BOOST_REQUIRE(receiver->get_block(block0, 1.0));
+    BOOST_CHECK_EQUAL(block0.index, 0);
+    BOOST_CHECK(block0.buffs.at(0) == memory[0].data());
+    BOOST_CHECK_EQUAL(block0.nsamps, SAMPS_PER_BLOCK);
+    BOOST_CHECK_EQUAL(memory[0][SAMPS_PER_BLOCK - 1], 0);
+    BOOST_REQUIRE(receiver->get_block(block1, 1.0));
+    BOOST_CHECK_EQUAL(block1.index, 1);
+    BOOST_CHECK_EQUAL(memory[1][0], 1);
+
+    // Without free blocks, the receiver waits
+    BOOST_CHECK(!receiver->get_block(block2, 0.05));
+    BOOST_CHECK_EQUAL(receiver->get_num_stalls(), 1);
+    receiver->release_block(block0.index);
+    BOOST_CHECK_THROW(receiver->release_block(block0.index), uhd::value_error);
+    BOOST_CHECK_THROW(receiver->release_block(2), uhd::value_error);
+    BOOST_REQUIRE(receiver->get_block(block2, 1.0));
+    BOOST_CHECK_EQUAL(block2.index, 0);
+    BOOST_CHECK_EQUAL(memory[0][0], 2);
+
+    receiver->release_block(block1.index);
+    receiver->release_block(block2.index);
+    for (uint8_t i = 3; i < 5; i++) {
+        BOOST_REQUIRE(receiver->get_block(block0, 1.0));
+        BOOST_CHECK_EQUAL(memory[block0.index][0], i);
+        receiver->release_block(block0.index);
+    }
+    BOOST_CHECK(!receiver->get_block(block0, 0.05));
+}
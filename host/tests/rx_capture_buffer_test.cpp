@@ -0,0 +1,177 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/mock_rx_streamer.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/utils/rx_capture_buffer.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <complex>
+#include <future>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+constexpr size_t SPP  = 100;
+constexpr double RATE = 1000.0;
+
+using sc16_t = std::complex<int16_t>;
+
+uhd::mock_rx_streamer::stream_params make_params()
+{
+    uhd::mock_rx_streamer::stream_params params;
+    params.max_num_samps = SPP;
+    return params;
+}
+
+//! Streamer that passes the packets of the test to the callback
+class mock_push_rx_streamer : public uhd::mock_rx_streamer
+{
+public:
+    mock_push_rx_streamer() : uhd::mock_rx_streamer(make_params()) {}
+
+    void set_recv_packet_callback(
+        recv_packet_callback_t callback, const bool raw) override
+    {
+        BOOST_CHECK(raw || !callback);
+        std::lock_guard<std::mutex> l(_mutex);
+        _callback = std::move(callback);
+    }
+
+    //! Push a packet, where sample i is (i, -i), and timed at i / RATE
+    void push(const size_t first_samp, const size_t nsamps = SPP)
+    {
+        std::vector<sc16_t> samps;
+        for (size_t i = first_samp; i < first_samp + nsamps; i++) {
+            samps.push_back(sc16_t(int16_t(i), -int16_t(i)));
+        }
+        uhd::rx_metadata_t md;
+        md.has_time_spec = true;
+        md.time_spec     = uhd::time_spec_t::from_ticks(first_samp, RATE);
+        std::lock_guard<std::mutex> l(_mutex);
+        _callback({samps.data()}, nsamps, md);
+    }
+
+    void push_overflow()
+    {
+        uhd::rx_metadata_t md;
+        md.error_code = uhd::rx_metadata_t::ERROR_CODE_OVERFLOW;
+        std::lock_guard<std::mutex> l(_mutex);
+        _callback({nullptr}, 0, md);
+    }
+
+private:
+    std::mutex _mutex;
+    recv_packet_callback_t _callback;
+};
+
+//! Trigger a capture, and return a future for it
+std::future<uhd::rx_capture_buffer::capture_t> trigger(
+    uhd::rx_capture_buffer::sptr capture_buffer,
+    const double trigger_time,
+    const double pre_time,
+    const double post_time)
+{
+    auto promise = std::make_shared<std::promise<uhd::rx_capture_buffer::capture_t>>();
+    capture_buffer->trigger(uhd::time_spec_t(trigger_time),
+        pre_time,
+        post_time,
+        [promise](uhd::rx_capture_buffer::capture_t& capture) {
+            promise->set_value(std::move(capture));
+        });
+    return promise->get_future();
+}
+
+uhd::rx_capture_buffer::capture_t get(std::future<uhd::rx_capture_buffer::capture_t> f)
+{
+    BOOST_REQUIRE(f.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+    return f.get();
+}
+
+sc16_t sample(const uhd::rx_capture_buffer::capture_t& capture, const size_t i)
+{
+    return reinterpret_cast<const sc16_t*>(capture.buffs.at(0).data())[i];
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_capture_buffer_args)
+{
+    auto rx = std::make_shared<uhd::mock_rx_streamer>(make_params());
+    BOOST_CHECK_THROW(
+        uhd::rx_capture_buffer::make(rx, uhd::stream_args_t("sc16", "sc16"), RATE, 1.0),
+        uhd::not_implemented_error);
+
+    auto push_rx        = std::make_shared<mock_push_rx_streamer>();
+    auto capture_buffer = uhd::rx_capture_buffer::make(
+        push_rx, uhd::stream_args_t("sc16", "sc16"), RATE, 1.0);
+    BOOST_CHECK_EQUAL(capture_buffer->get_capacity(), 1.0);
+    BOOST_CHECK_THROW(capture_buffer->trigger(uhd::time_spec_t(1.0), 0.6, 0.6, {}),
+        uhd::value_error);
+    BOOST_CHECK_THROW(capture_buffer->trigger(uhd::time_spec_t(1.0), -0.1, 0.1, {}),
+        uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_capture_buffer_windows)
+{
+    auto rx             = std::make_shared<mock_push_rx_streamer>();
+    auto capture_buffer = uhd::rx_capture_buffer::make(
+        rx, uhd::stream_args_t("sc16", "sc16"), RATE, 1.0);
+    for (size_t i = 0; i < 10; i++) {
+        rx->push(i * SPP);
+    }
+
+    // A trigger in the past is captured right away
+    auto capture = get(trigger(capture_buffer, 0.5, 0.1, 0.2));
+    BOOST_CHECK(capture.complete);
+    BOOST_CHECK_EQUAL(capture.nsamps, 300);
+    BOOST_CHECK_EQUAL(capture.time_spec.to_ticks(RATE), 400);
+    BOOST_CHECK_EQUAL(capture.trigger_time.to_ticks(RATE), 500);
+    BOOST_CHECK_EQUAL(sample(capture, 0), sc16_t(400, -400));
+    BOOST_CHECK_EQUAL(sample(capture, 299), sc16_t(699, -699));
+
+    // A trigger in the future waits for the end of its window
+    auto future = trigger(capture_buffer, 1.05, 0.5, 0.1);
+    rx->push(10 * SPP);
+    BOOST_CHECK_EQUAL(capture_buffer->get_num_pending(), 1);
+    rx->push(11 * SPP);
+    capture = get(std::move(future));
+    BOOST_CHECK(capture.complete);
+    BOOST_CHECK_EQUAL(capture.nsamps, 600);
+    BOOST_CHECK_EQUAL(sample(capture, 0), sc16_t(550, -550));
+    // That window wraps around the end of the ring
+    BOOST_CHECK_EQUAL(sample(capture, 599), sc16_t(1149, -1149));
+    BOOST_CHECK_EQUAL(capture_buffer->get_num_pending(), 0);
+
+    // Samples that have left the ring are missing
+    capture = get(trigger(capture_buffer, 0.3, 0.2, 0.1));
+    BOOST_CHECK(!capture.complete);
+    BOOST_CHECK_EQUAL(capture.nsamps, 200);
+    BOOST_CHECK_EQUAL(capture.time_spec.to_ticks(RATE), 200);
+    BOOST_CHECK_EQUAL(sample(capture, 0), sc16_t(200, -200));
+}
+
+BOOST_AUTO_TEST_CASE(test_capture_buffer_gap)
+{
+    auto rx             = std::make_shared<mock_push_rx_streamer>();
+    auto capture_buffer = uhd::rx_capture_buffer::make(
+        rx, uhd::stream_args_t("fc32", "sc16"), RATE, 1.0);
+    for (size_t i = 0; i < 5; i++) {
+        rx->push(i * SPP);
+    }
+    rx->push_overflow();
+    rx->push(7 * SPP);
+
+    auto capture = get(trigger(capture_buffer, 0.45, 0.0, 0.3));
+    BOOST_CHECK(!capture.complete);
+    BOOST_CHECK_EQUAL(capture.nsamps, 100);
+    BOOST_CHECK_EQUAL(capture.time_spec.to_ticks(RATE), 450);
+    const auto* samps = reinterpret_cast<const std::complex<float>*>(
+        capture.buffs.at(0).data());
+    BOOST_CHECK_CLOSE(samps[0].real(), 450 / 32767.0, 1e-3);
+    BOOST_CHECK_CLOSE(samps[50].real(), 700 / 32767.0, 1e-3);
+}
@@ -0,0 +1,204 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/mock_rx_streamer.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/utils/math.hpp>
+#include <uhd/utils/rx_channelizer.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using sample_t = std::complex<float>;
+
+constexpr size_t SPP     = 200;
+constexpr double RATE    = 1e6;
+constexpr double T0      = 2.0;
+constexpr size_t TAPS    = 12;
+constexpr size_t N_CHANS = 8;
+
+/*! Returns a signal in packets with time specs, and then times out
+ *
+ * There is an overflow before the packet with the index overflow_packet, if
+ * that isn't 0.
+ */
+std::shared_ptr<uhd::mock_rx_streamer> make_rx_streamer(const size_t num_packets,
+    std::function<sample_t(size_t)> signal,
+    const size_t overflow_packet = 0)
+{
+    uhd::mock_rx_streamer::stream_params params;
+    params.max_num_samps = SPP;
+    params.rate          = RATE;
+    params.start_time    = uhd::time_spec_t(T0);
+    params.fill          = uhd::mock_rx_streamer::fill_signal(signal);
+    std::vector<uhd::mock_rx_streamer::packet_t> packets(
+        num_packets, uhd::mock_rx_streamer::packet_t{SPP});
+    if (overflow_packet) {
+        packets.insert(
+            packets.begin() + overflow_packet, uhd::mock_rx_streamer::overflow());
+    }
+    return std::make_shared<uhd::mock_rx_streamer>(params, packets);
+}
+
+//! A tone in the middle of channel \p chan of N_CHANS
+sample_t tone(const size_t chan, const size_t index, const float amplitude)
+{
+    const double phase = 2 * uhd::math::PI * double(chan * index % N_CHANS) / N_CHANS;
+    return std::polar(amplitude, float(phase));
+}
+
+//! Wait until the channelizer received all input
+void wait_drained(const uhd::mock_rx_streamer& rx_stream)
+{
+    for (size_t i = 0; i < 1000 && !rx_stream.is_drained(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    BOOST_REQUIRE(rx_stream.is_drained());
+}
+
+//! Read all samples of a channel, and check that their times are contiguous
+std::vector<sample_t> read_all(uhd::rx_streamer::sptr chan, const double chan_rate)
+{
+    std::vector<sample_t> samps;
+    std::vector<sample_t> buff(chan->get_max_num_samps() / 3 + 1);
+    uhd::rx_metadata_t md;
+    while (true) {
+        const size_t nsamps = chan->recv(buff.data(), buff.size(), md, 0.2);
+        if (md.error_code == uhd::rx_metadata_t::ERROR_CODE_TIMEOUT) {
+            break;
+        }
+        BOOST_REQUIRE_EQUAL(md.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+        BOOST_REQUIRE(md.has_time_spec);
+        const double expected_time = T0 + double(samps.size()) / chan_rate
+                                     - double(N_CHANS * TAPS - 1) / 2 / RATE;
+        BOOST_REQUIRE_CLOSE(md.time_spec.get_real_secs(), expected_time, 1e-9);
+        samps.insert(samps.end(), buff.begin(), buff.begin() + nsamps);
+    }
+    return samps;
+}
+
+uhd::rx_channelizer::sptr make_channelizer(
+    uhd::rx_streamer::sptr rx_stream, const std::string& args)
+{
+    return uhd::rx_channelizer::make(rx_stream, RATE, uhd::device_addr_t(args));
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_channelizer_args)
+{
+    auto rx_stream = make_rx_streamer(0, [](size_t) {
+        return sample_t();
+    });
+    for (const std::string args : {"num_chans=12", "num_chans=1", "decim=3",
+             "taps_per_chan=0", "num_threads=0", "queue_size=0"}) {
+        BOOST_CHECK_THROW(make_channelizer(rx_stream, args), uhd::value_error);
+    }
+    BOOST_CHECK_THROW(uhd::rx_channelizer::make(rx_stream, 0.0), uhd::value_error);
+
+    auto channelizer = make_channelizer(rx_stream, "num_chans=8,decim=4");
+    BOOST_CHECK_EQUAL(channelizer->get_num_channels(), 8);
+    BOOST_CHECK_EQUAL(channelizer->get_channel_rate(), RATE / 4);
+    BOOST_CHECK_EQUAL(channelizer->get_channel_freq(1), RATE / 8);
+    BOOST_CHECK_EQUAL(channelizer->get_channel_freq(6), -2 * RATE / 8);
+    BOOST_CHECK_THROW(channelizer->get_channel(8), uhd::index_error);
+    BOOST_CHECK_EQUAL(channelizer->get_channel(0)->get_num_channels(), 1);
+
+    // Stream commands go to the input, scaled by the decimation
+    uhd::stream_cmd_t cmd(uhd::stream_cmd_t::STREAM_MODE_NUM_SAMPS_AND_DONE);
+    cmd.num_samps = 100;
+    channelizer->get_channel(3)->issue_stream_cmd(cmd);
+    BOOST_CHECK_EQUAL(rx_stream->get_last_stream_cmd().num_samps, 400);
+}
+
+BOOST_AUTO_TEST_CASE(test_channelizer_tones)
+{
+    constexpr size_t NUM_PACKETS = 100;
+    // Oversampling doesn't change what ends up in which channel
+    for (const size_t decim : {size_t(8), size_t(4)}) {
+        auto rx_stream = make_rx_streamer(NUM_PACKETS, [](size_t i) {
+            return tone(3, i, 1.0f) + tone(6, i, 0.5f);
+        });
+        auto channelizer = make_channelizer(
+            rx_stream, "num_chans=8,queue_size=1000,decim=" + std::to_string(decim));
+        wait_drained(*rx_stream);
+
+        for (size_t chan = 0; chan < N_CHANS; chan++) {
+            const auto samps =
+                read_all(channelizer->get_channel(chan), channelizer->get_channel_rate());
+            BOOST_REQUIRE_EQUAL(samps.size(), NUM_PACKETS * SPP / decim);
+            const float amplitude = (chan == 3) ? 1.0f : (chan == 6) ? 0.5f : 0.0f;
+            // Skip the samples that the start of the filter smears
+            for (size_t i = N_CHANS * TAPS / decim; i < samps.size(); i++) {
+                BOOST_REQUIRE_SMALL(std::abs(samps[i]) - amplitude, 1e-3f);
+                // A tone in the middle of the channel ends up at DC
+                BOOST_REQUIRE_SMALL(std::abs(samps[i] - samps[i - 1]), 1e-3f);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_channelizer_threads)
+{
+    constexpr size_t NUM_PACKETS = 50;
+    auto signal                  = [](size_t i) {
+        return sample_t(float(std::sin(0.001 * double(i * i))), float(i % 7) / 7);
+    };
+    std::vector<std::vector<sample_t>> results;
+    for (const size_t num_threads : {1, 3}) {
+        auto rx_stream   = make_rx_streamer(NUM_PACKETS, signal);
+        auto channelizer = make_channelizer(rx_stream,
+            "num_chans=8,queue_size=1000,num_threads=" + std::to_string(num_threads));
+        wait_drained(*rx_stream);
+        results.push_back(
+            read_all(channelizer->get_channel(5), channelizer->get_channel_rate()));
+    }
+    BOOST_REQUIRE_EQUAL(results[0].size(), NUM_PACKETS * SPP / N_CHANS);
+    BOOST_CHECK(results[0] == results[1]);
+}
+
+BOOST_AUTO_TEST_CASE(test_channelizer_overflow)
+{
+    // The input overflows, every channel sees it
+    auto rx_stream = make_rx_streamer(
+        10, [](size_t i) { return tone(1, i, 1.0f); }, 5);
+    auto channelizer = make_channelizer(rx_stream, "num_chans=8");
+    wait_drained(*rx_stream);
+    for (size_t chan = 0; chan < N_CHANS; chan++) {
+        auto chan_stream = channelizer->get_channel(chan);
+        std::vector<sample_t> buff(1000);
+        uhd::rx_metadata_t md;
+        size_t num_samps = 0;
+        while (md.error_code != uhd::rx_metadata_t::ERROR_CODE_OVERFLOW) {
+            num_samps += chan_stream->recv(buff.data(), buff.size(), md, 0.1);
+            BOOST_REQUIRE_NE(md.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+        }
+        BOOST_CHECK_EQUAL(num_samps, 5 * SPP / N_CHANS);
+    }
+
+    // A channel that isn't read overflows, and then returns the newest blocks
+    rx_stream = make_rx_streamer(
+        10, [](size_t i) { return tone(1, i, 1.0f); });
+    channelizer = make_channelizer(rx_stream, "num_chans=8,queue_size=4");
+    wait_drained(*rx_stream);
+    auto chan_stream = channelizer->get_channel(1);
+    std::vector<sample_t> buff(1000);
+    uhd::rx_metadata_t md;
+    BOOST_CHECK_EQUAL(chan_stream->recv(buff.data(), buff.size(), md, 0.1), 0);
+    BOOST_CHECK_EQUAL(md.error_code, uhd::rx_metadata_t::ERROR_CODE_OVERFLOW);
+    BOOST_CHECK_CLOSE(md.time_spec.get_real_secs(),
+        T0 + (6 * SPP - double(N_CHANS * TAPS - 1) / 2) / RATE,
+        1e-9);
+    BOOST_CHECK_EQUAL(
+        chan_stream->recv(buff.data(), buff.size(), md, 0.1), 4 * SPP / N_CHANS);
+    BOOST_CHECK_EQUAL(md.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+}
@@ -0,0 +1,134 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/mock_rx_streamer.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/utils/rx_fanout.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+constexpr size_t SPP = 16;
+
+/*! Returns queued u8 packets, every item holds the index of its packet
+ *
+ * The test plays the I/O thread.
+ */
+std::shared_ptr<uhd::mock_rx_streamer> make_rx_streamer()
+{
+    uhd::mock_rx_streamer::stream_params params;
+    params.max_num_samps = SPP;
+    return std::make_shared<uhd::mock_rx_streamer>(params);
+}
+
+//! Wait until \p done returns true, for at most a second
+template <typename done_fn_t>
+bool wait_for(done_fn_t done)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+uint8_t first_item(const uhd::rx_fanout::packet_sptr& packet)
+{
+    return *static_cast<const uint8_t*>(packet->buffs[0]);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_fanout_shared_packets)
+{
+    auto rx     = make_rx_streamer();
+    auto fanout = uhd::rx_fanout::make(rx, "u8");
+    BOOST_CHECK_THROW(fanout->subscribe(0), uhd::value_error);
+    auto sub0 = fanout->subscribe();
+    auto sub1 = fanout->subscribe();
+    BOOST_CHECK_EQUAL(fanout->get_num_subscribers(), 2);
+
+    for (size_t i = 0; i < 4; i++) {
+        rx->push(SPP);
+    }
+    rx->push(uhd::mock_rx_streamer::overflow());
+    for (uint8_t i = 0; i < 4; i++) {
+        auto packet0 = sub0->pop(1.0);
+        auto packet1 = sub1->pop(1.0);
+        BOOST_REQUIRE(packet0 && packet1);
+        // The subscribers share the same samples
+        BOOST_CHECK(packet0 == packet1);
+        BOOST_CHECK_EQUAL(packet0->nsamps, SPP);
+        BOOST_CHECK_EQUAL(first_item(packet0), i);
+    }
+    // Errors are passed on
+    auto error = sub0->pop(1.0);
+    BOOST_REQUIRE(error);
+    BOOST_CHECK_EQUAL(error->nsamps, 0);
+    BOOST_CHECK_EQUAL(error->metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_OVERFLOW);
+
+    sub1.reset();
+    BOOST_CHECK_EQUAL(fanout->get_num_subscribers(), 1);
+
+    // Subscribers may outlive the fan-out
+    fanout.reset();
+    BOOST_CHECK(!sub0->pop(0.01));
+}
+
+BOOST_AUTO_TEST_CASE(test_fanout_drop_oldest)
+{
+    auto rx     = make_rx_streamer();
+    auto fanout = uhd::rx_fanout::make(rx, "u8");
+    auto slow   = fanout->subscribe(2, uhd::rx_fanout::overflow_policy_t::DROP_OLDEST);
+    auto fast   = fanout->subscribe(8, uhd::rx_fanout::overflow_policy_t::DROP_OLDEST);
+
+    for (size_t i = 0; i < 5; i++) {
+        rx->push(SPP);
+    }
+    BOOST_REQUIRE(wait_for([&]() { return fast->get_num_queued() == 5; }));
+    // The slow subscriber keeps the newest packets, the fast one gets all
+    BOOST_CHECK_EQUAL(slow->get_num_dropped(), 3);
+    BOOST_CHECK_EQUAL(fast->get_num_dropped(), 0);
+    BOOST_CHECK_EQUAL(first_item(slow->pop()), 3);
+    BOOST_CHECK_EQUAL(first_item(slow->pop()), 4);
+    BOOST_CHECK(!slow->pop(0.0));
+}
+
+BOOST_AUTO_TEST_CASE(test_fanout_backpressure)
+{
+    auto rx     = make_rx_streamer();
+    auto fanout = uhd::rx_fanout::make(rx, "u8");
+    auto slow   = fanout->subscribe(1, uhd::rx_fanout::overflow_policy_t::BACKPRESSURE);
+    auto fast   = fanout->subscribe(8, uhd::rx_fanout::overflow_policy_t::DROP_OLDEST);
+
+    for (size_t i = 0; i < 4; i++) {
+        rx->push(SPP);
+    }
+    // The slow subscriber holds up the fan-out after its queue is full
+    BOOST_REQUIRE(wait_for([&]() { return slow->get_num_queued() == 1; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    BOOST_CHECK_LE(fast->get_num_queued(), 2);
+
+    for (uint8_t i = 0; i < 4; i++) {
+        auto packet = slow->pop(1.0);
+        BOOST_REQUIRE(packet);
+        BOOST_CHECK_EQUAL(first_item(packet), i);
+    }
+    BOOST_CHECK_EQUAL(slow->get_num_dropped(), 0);
+    BOOST_REQUIRE(wait_for([&]() { return fast->get_num_queued() == 4; }));
+
+    // A backpressured subscriber that goes away doesn't block the fan-out
+    rx->push(SPP);
+    rx->push(SPP);
+    BOOST_REQUIRE(wait_for([&]() { return slow->get_num_queued() == 1; }));
+    slow.reset();
+    BOOST_CHECK(wait_for([&]() { return fast->get_num_queued() == 6; }));
+}
@@ -0,0 +1,87 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/rfnoc/rx_flow_ctrl_state.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace uhd::rfnoc;
+
+namespace {
+
+constexpr size_t PKT_SIZE = 1000;
+
+const stream_buff_params_t CAPACITY = {MAX_FC_CAPACITY_BYTES, 64};
+
+/*! Streams packets through the flow control state
+ *
+ * The host holds \p num_buffered packets before it releases them, and
+ * responds whenever a response is due.
+ */
+void stream(
+    rx_flow_ctrl_state& fc_state, const size_t num_pkts, const size_t num_buffered)
+{
+    for (size_t i = 0; i < num_buffered; i++) {
+        fc_state.data_received(PKT_SIZE);
+    }
+    for (size_t i = 0; i < num_pkts; i++) {
+        fc_state.data_received(PKT_SIZE);
+        fc_state.xfer_done(PKT_SIZE);
+        if (fc_state.fc_resp_due()) {
+            fc_state.fc_resp_sent();
+        }
+    }
+    for (size_t i = 0; i < num_buffered; i++) {
+        fc_state.xfer_done(PKT_SIZE);
+    }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_fixed_freq)
+{
+    rx_flow_ctrl_state fc_state({1, 2}, {MAX_FC_FREQ_BYTES, 2});
+    stream(fc_state, 1000, 0);
+    BOOST_CHECK_EQUAL(fc_state.get_fc_freq().packets, 2);
+    BOOST_CHECK_EQUAL(fc_state.get_num_freq_changes(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_adaptive_freq_grows)
+{
+    rx_flow_ctrl_state fc_state({1, 2}, {MAX_FC_FREQ_BYTES, 2});
+    fc_state.enable_adaptive_freq(CAPACITY);
+
+    // The host releases packets right away, so the sender always holds plenty
+    // of credit and the frequency grows up to 1/4 of the capacity
+    stream(fc_state, 10000, 0);
+    BOOST_CHECK_EQUAL(fc_state.get_fc_freq().packets, CAPACITY.packets / 4);
+    BOOST_CHECK_GT(fc_state.get_num_freq_changes(), 0);
+    // The byte limit is disabled, and stays that way
+    BOOST_CHECK_EQUAL(fc_state.get_fc_freq().bytes, MAX_FC_FREQ_BYTES);
+}
+
+BOOST_AUTO_TEST_CASE(test_adaptive_freq_shrinks)
+{
+    rx_flow_ctrl_state fc_state({1, 2}, {MAX_FC_FREQ_BYTES, 8});
+    fc_state.enable_adaptive_freq(CAPACITY);
+
+    // The host buffers most of the capacity, so the sender runs low on credit
+    stream(fc_state, 1000, 48);
+    BOOST_CHECK_EQUAL(fc_state.get_fc_freq().packets, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_adaptive_freq_loss)
+{
+    rx_flow_ctrl_state fc_state({1, 2}, {MAX_FC_FREQ_BYTES, 16});
+    fc_state.enable_adaptive_freq(CAPACITY);
+
+    // At the upper bound, plenty of credit left, until packets get lost
+    stream(fc_state, 256, 0);
+    BOOST_CHECK_EQUAL(fc_state.get_fc_freq().packets, 16);
+    const auto counts = fc_state.get_recv_counts();
+    fc_state.resynchronize({counts.bytes + PKT_SIZE, counts.packets + 1});
+    stream(fc_state, 256, 0);
+    BOOST_CHECK_LT(fc_state.get_fc_freq().packets, 16);
+}
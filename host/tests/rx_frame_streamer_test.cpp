@@ -0,0 +1,149 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/mock_rx_streamer.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/utils/rx_frame_streamer.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <vector>
+
+namespace {
+
+using packet_t = uhd::mock_rx_streamer::packet_t;
+
+constexpr auto ERR_NONE     = uhd::rx_metadata_t::ERROR_CODE_NONE;
+constexpr auto ERR_OVERFLOW = uhd::rx_metadata_t::ERROR_CODE_OVERFLOW;
+
+/*! Streams a list of u8 packets, and then times out
+ *
+ * Every item of a packet is the index of the packet in the list. Packets
+ * that don't fit into the buffer are returned in fragments. If \p repeat is
+ * set, the list is streamed over and over.
+ */
+std::shared_ptr<uhd::mock_rx_streamer> make_rx_streamer(
+    const std::vector<packet_t>& packets, const bool repeat = false)
+{
+    uhd::mock_rx_streamer::stream_params params;
+    params.repeat = repeat;
+    return std::make_shared<uhd::mock_rx_streamer>(params, packets);
+}
+
+//! Receives frames until a timeout, and returns the first item of each
+std::vector<uint8_t> recv_all(uhd::rx_frame_streamer& streamer)
+{
+    std::vector<uint8_t> frame(streamer.get_frame_size());
+    std::vector<uint8_t> firsts;
+    uhd::rx_metadata_t md;
+    while (streamer.recv_frame(frame.data(), md) == frame.size()) {
+        // A frame is never a mix of packets that don't belong together
+        firsts.push_back(frame.front());
+    }
+    BOOST_CHECK_EQUAL(md.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+    return firsts;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_rx_frame_streamer_packets)
+{
+    // Frames are rejected if they're too short (1) or too long (3), and
+    // overruns (5) don't take the stream out of alignment
+    auto rx_stream = make_rx_streamer(std::vector<packet_t>{
+        {8, false, ERR_NONE},
+        {5, false, ERR_NONE},
+        {8, false, ERR_NONE},
+        {12, false, ERR_NONE},
+        {8, false, ERR_NONE},
+        {0, false, ERR_OVERFLOW},
+        {8, false, ERR_NONE},
+    });
+    auto streamer = uhd::rx_frame_streamer::make(rx_stream, "u8", 8);
+    const std::vector<uint8_t> expected{0, 2, 4, 6};
+    const auto firsts = recv_all(*streamer);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        firsts.begin(), firsts.end(), expected.begin(), expected.end());
+    BOOST_CHECK_EQUAL(streamer->get_num_frames_discarded(), 2);
+    BOOST_CHECK_EQUAL(streamer->get_num_frames_skipped(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_rx_frame_streamer_eob)
+{
+    auto rx_stream = make_rx_streamer(std::vector<packet_t>{
+        // The end of a frame that started before the streamer did
+        {4, false, ERR_NONE},
+        {4, true, ERR_NONE},
+        // A complete frame
+        {4, false, ERR_NONE},
+        {4, false, ERR_NONE},
+        {4, true, ERR_NONE},
+        // An overrun in the middle of a frame
+        {4, false, ERR_NONE},
+        {0, false, ERR_OVERFLOW},
+        {4, true, ERR_NONE},
+        // A frame without EOB is too long
+        {4, false, ERR_NONE},
+        {4, false, ERR_NONE},
+        {4, false, ERR_NONE},
+        {4, true, ERR_NONE},
+        // A complete frame of two packets
+        {8, false, ERR_NONE},
+        {4, true, ERR_NONE},
+    });
+    auto streamer = uhd::rx_frame_streamer::make(
+        rx_stream, "u8", 12, uhd::device_addr_t("eob=1"));
+    const std::vector<uint8_t> expected{2, 12};
+    const auto firsts = recv_all(*streamer);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        firsts.begin(), firsts.end(), expected.begin(), expected.end());
+    BOOST_CHECK_EQUAL(streamer->get_num_frames_discarded(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_rx_frame_streamer_decim)
+{
+    auto rx_stream = make_rx_streamer(
+        std::vector<packet_t>(8, packet_t{4, false, ERR_NONE}));
+    auto streamer = uhd::rx_frame_streamer::make(
+        rx_stream, "u8", 4, uhd::device_addr_t("decim=3"));
+    const std::vector<uint8_t> expected{0, 3, 6};
+    const auto firsts = recv_all(*streamer);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        firsts.begin(), firsts.end(), expected.begin(), expected.end());
+    BOOST_CHECK_EQUAL(streamer->get_num_frames_skipped(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_rx_frame_streamer_frame_rate)
+{
+    // An endless stream of frames, as fast as they can be received
+    auto rx_stream = make_rx_streamer(
+        std::vector<packet_t>{{4, false, ERR_NONE}}, true);
+    auto streamer = uhd::rx_frame_streamer::make(
+        rx_stream, "u8", 4, uhd::device_addr_t("max_frame_rate=20"));
+    std::vector<uint8_t> frame(4);
+    uhd::rx_metadata_t md;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < 4; i++) {
+        BOOST_REQUIRE_EQUAL(streamer->recv_frame(frame.data(), md, 1.0), 4);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    // The first frame comes right away, the others every 50 ms
+    BOOST_CHECK(elapsed >= std::chrono::milliseconds(150));
+    BOOST_CHECK(elapsed < std::chrono::milliseconds(1000));
+    BOOST_CHECK_GT(streamer->get_num_frames_skipped(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_rx_frame_streamer_args)
+{
+    auto rx_stream = make_rx_streamer(std::vector<packet_t>{});
+    BOOST_CHECK_THROW(uhd::rx_frame_streamer::make(rx_stream, "u8", 0), uhd::value_error);
+    BOOST_CHECK_THROW(
+        uhd::rx_frame_streamer::make(rx_stream, "u8", 4, uhd::device_addr_t("decim=0")),
+        uhd::value_error);
+    BOOST_CHECK_THROW(uhd::rx_frame_streamer::make(
+                          rx_stream, "u8", 4, uhd::device_addr_t("max_frame_rate=-1")),
+        uhd::value_error);
+}
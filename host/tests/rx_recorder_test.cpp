@@ -0,0 +1,234 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/mock_rx_streamer.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/utils/paths.hpp>
+#include <uhd/utils/rx_recorder.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+constexpr size_t NUM_CHANS     = 2;
+constexpr size_t BLOCK_SIZE    = 4096;
+constexpr size_t BLOCK_SAMPS   = BLOCK_SIZE / 4;
+constexpr uint32_t CHAN_OFFSET = 1000000;
+constexpr uint32_t SPP         = 300;
+constexpr uint32_t GAP_START   = 2500;
+constexpr uint32_t GAP_SIZE    = 100;
+constexpr uint32_t NUM_SAMPS   = 5000;
+
+void fill_counter(
+    const uhd::rx_streamer::buffs_type& buffs, const size_t first_samp, const size_t nsamps)
+{
+    for (size_t chan = 0; chan < NUM_CHANS; chan++) {
+        uint32_t* buff = static_cast<uint32_t*>(buffs[chan]);
+        for (size_t i = 0; i < nsamps; i++) {
+            buff[i] = uint32_t(first_samp + i + chan * CHAN_OFFSET);
+        }
+    }
+}
+
+/*! Streams a counter (as 32-bit sc16 items), with an overrun in between
+ *
+ * The counter skips GAP_SIZE values at GAP_START, and stops at NUM_SAMPS
+ * samples.
+ */
+std::shared_ptr<uhd::mock_rx_streamer> make_rx_streamer()
+{
+    uhd::mock_rx_streamer::stream_params params;
+    params.num_chans     = NUM_CHANS;
+    params.max_num_samps = SPP;
+    params.rate          = 1e6;
+    params.fill          = fill_counter;
+    std::vector<uhd::mock_rx_streamer::packet_t> packets;
+    for (uint32_t n = 0; n < GAP_START; n += SPP) {
+        packets.push_back({std::min(SPP, GAP_START - n)});
+    }
+    packets.push_back(uhd::mock_rx_streamer::overflow(GAP_SIZE));
+    for (uint32_t n = GAP_START; n < NUM_SAMPS; n += SPP) {
+        packets.push_back({std::min(SPP, NUM_SAMPS - n)});
+    }
+    return std::make_shared<uhd::mock_rx_streamer>(params, packets);
+}
+
+std::vector<uint32_t> read_block(const fs::path& path, const size_t offset)
+{
+    std::ifstream file(path.string(), std::ios::binary);
+    file.seekg(offset);
+    std::vector<uint32_t> block(NUM_CHANS * BLOCK_SAMPS);
+    file.read(reinterpret_cast<char*>(block.data()), NUM_CHANS * BLOCK_SIZE);
+    BOOST_REQUIRE(file);
+    return block;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_rx_recorder_args)
+{
+    auto rx_stream = make_rx_streamer();
+    BOOST_CHECK_THROW(uhd::rx_recorder::make(rx_stream, "sc16", {}), uhd::value_error);
+    BOOST_CHECK_THROW(uhd::rx_recorder::make(rx_stream,
+                          "sc16",
+                          {"rx_recorder_test.dat"},
+                          uhd::device_addr_t("block_size=1000")),
+        uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_rx_recorder)
+{
+    const fs::path tmp_dir = fs::path(uhd::get_tmp_path()) / "RX_RECORDER_TEST";
+    fs::create_directory(tmp_dir);
+    const std::vector<std::string> paths{
+        (tmp_dir / "rec0.dat").string(), (tmp_dir / "rec1.dat").string()};
+
+    auto rx_stream = make_rx_streamer();
+    auto recorder  = uhd::rx_recorder::make(rx_stream,
+        "sc16",
+        paths,
+        uhd::device_addr_t("block_size=4096,num_blocks=3"));
+    recorder->start();
+    BOOST_CHECK_THROW(recorder->start(), uhd::runtime_error);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!rx_stream->is_drained() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_CHECK(recorder->is_running());
+    recorder->stop();
+    BOOST_CHECK(!recorder->is_running());
+    BOOST_CHECK_EQUAL(recorder->get_num_samps_recorded(), NUM_SAMPS);
+    BOOST_CHECK_EQUAL(recorder->get_num_overflows(), 1);
+
+    // Blocks: [0, 1024), [1024, 2048), [2048, 2500), overrun, [2600, 3624),
+    // [3624, 4648), [4648, 5100)
+    const std::vector<uint32_t> first_samps{0, 1024, 2048, 2600, 3624, 4648};
+    const std::vector<uint32_t> num_samps{1024, 1024, 452, 1024, 1024, 452};
+    BOOST_CHECK_EQUAL(fs::file_size(paths[0]), 3 * NUM_CHANS * BLOCK_SIZE);
+    BOOST_CHECK_EQUAL(fs::file_size(paths[1]), 3 * NUM_CHANS * BLOCK_SIZE);
+    for (size_t i = 0; i < first_samps.size(); i++) {
+        const auto block = read_block(paths[i % 2], (i / 2) * NUM_CHANS * BLOCK_SIZE);
+        for (size_t chan = 0; chan < NUM_CHANS; chan++) {
+            const uint32_t* samps = block.data() + chan * BLOCK_SAMPS;
+            BOOST_CHECK_EQUAL(samps[0], first_samps[i] + chan * CHAN_OFFSET);
+            BOOST_CHECK_EQUAL(samps[num_samps[i] - 1],
+                first_samps[i] + num_samps[i] - 1 + chan * CHAN_OFFSET);
+            if (num_samps[i] < BLOCK_SAMPS) {
+                BOOST_CHECK_EQUAL(samps[num_samps[i]], 0);
+            }
+        }
+    }
+
+    std::ifstream index(paths[0] + ".idx");
+    std::string line;
+    std::vector<std::string> entries;
+    while (std::getline(index, line)) {
+        if (line[0] != '#') {
+            entries.push_back(line);
+        }
+    }
+    BOOST_REQUIRE_EQUAL(entries.size(), first_samps.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        std::istringstream entry(entries[i]);
+        size_t block_num, file_num, offset, nsamps;
+        bool has_time_spec, overflow;
+        int64_t full_secs;
+        double frac_secs;
+        entry >> block_num >> file_num >> offset >> nsamps >> has_time_spec
+            >> full_secs >> frac_secs >> overflow;
+        BOOST_CHECK_EQUAL(block_num, i);
+        BOOST_CHECK_EQUAL(file_num, i % 2);
+        BOOST_CHECK_EQUAL(offset, (i / 2) * NUM_CHANS * BLOCK_SIZE);
+        BOOST_CHECK_EQUAL(nsamps, num_samps[i]);
+        BOOST_CHECK(has_time_spec);
+        BOOST_CHECK_EQUAL(full_secs, 0);
+        BOOST_CHECK_SMALL(frac_secs - first_samps[i] / 1e6, 1e-9);
+        BOOST_CHECK_EQUAL(overflow, i == 3);
+    }
+
+    fs::remove_all(tmp_dir);
+}
+
+BOOST_AUTO_TEST_CASE(test_rx_recorder_compressed)
+{
+    const fs::path tmp_dir = fs::path(uhd::get_tmp_path()) / "RX_RECORDER_Z_TEST";
+    fs::create_directory(tmp_dir);
+    const std::vector<std::string> paths{(tmp_dir / "rec0.dat").string()};
+
+    auto rx_stream = make_rx_streamer();
+    BOOST_CHECK_THROW(uhd::rx_recorder::make(
+                          rx_stream, "fc32", paths, uhd::device_addr_t("compress=1")),
+        uhd::value_error);
+    auto recorder = uhd::rx_recorder::make(rx_stream,
+        "sc16",
+        paths,
+        uhd::device_addr_t("block_size=4096,num_blocks=3,compress=1"));
+    recorder->start();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!rx_stream->is_drained() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    recorder->stop();
+    BOOST_CHECK_EQUAL(recorder->get_num_samps_recorded(), NUM_SAMPS);
+
+    std::ifstream index(paths[0] + ".idx");
+    std::string line;
+    std::getline(index, line);
+    BOOST_CHECK(line.find("compressed=1") != std::string::npos);
+    std::ifstream file(paths[0], std::ios::binary);
+    uint64_t next_offset = 0;
+    uint32_t num_decoded = 0;
+    while (std::getline(index, line)) {
+        if (line[0] == '#') {
+            continue;
+        }
+        std::istringstream entry(line);
+        size_t block_num, file_num, offset, nsamps, stored_size;
+        bool has_time_spec, overflow;
+        int64_t full_secs;
+        double frac_secs;
+        entry >> block_num >> file_num >> offset >> nsamps >> has_time_spec
+            >> full_secs >> frac_secs >> overflow >> stored_size;
+        BOOST_REQUIRE(entry);
+        // The blocks are padded to 4 kiB, and follow each other
+        BOOST_CHECK_EQUAL(offset, next_offset);
+        BOOST_CHECK_EQUAL(offset % 4096, 0);
+        next_offset = offset + (stored_size + 4095) / 4096 * 4096;
+
+        std::vector<char> data(stored_size);
+        file.seekg(offset);
+        file.read(data.data(), stored_size);
+        BOOST_REQUIRE(file);
+        const auto samps =
+            uhd::rx_recorder::decode_block(data.data(), stored_size, NUM_CHANS, nsamps);
+        const uint32_t first_samp = static_cast<uint32_t>(frac_secs * 1e6 + 0.5);
+        for (size_t chan = 0; chan < NUM_CHANS; chan++) {
+            BOOST_REQUIRE_EQUAL(samps[chan].size(), nsamps);
+            for (size_t i = 0; i < nsamps; i++) {
+                uint32_t value;
+                std::memcpy(&value, &samps[chan][i], sizeof(value));
+                BOOST_REQUIRE_EQUAL(value, first_samp + i + chan * CHAN_OFFSET);
+            }
+        }
+        BOOST_CHECK_THROW(uhd::rx_recorder::decode_block(
+                              data.data(), stored_size - 1, NUM_CHANS, nsamps),
+            uhd::value_error);
+        num_decoded += nsamps;
+    }
+    BOOST_CHECK_EQUAL(num_decoded, NUM_SAMPS);
+    BOOST_CHECK_EQUAL(fs::file_size(paths[0]), next_offset);
+
+    fs::remove_all(tmp_dir);
+}
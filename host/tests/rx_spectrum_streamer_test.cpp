@@ -0,0 +1,192 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/mock_rx_streamer.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/utils/math.hpp>
+#include <uhd/utils/rx_spectrum_streamer.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <vector>
+
+namespace {
+
+using sample_t = std::complex<float>;
+
+constexpr size_t SPP  = 100;
+constexpr double RATE = 1e6;
+constexpr double T0   = 3.0;
+constexpr size_t N    = 64;
+
+/*! Returns a signal in packets with time specs, and then times out
+ *
+ * A packet can be received in fragments. There is an overflow before the
+ * packet with the index overflow_packet, if that isn't 0.
+ */
+std::shared_ptr<uhd::mock_rx_streamer> make_rx_streamer(const size_t num_packets,
+    std::function<sample_t(size_t)> signal,
+    const size_t overflow_packet = 0)
+{
+    uhd::mock_rx_streamer::stream_params params;
+    params.max_num_samps = SPP;
+    params.rate          = RATE;
+    params.start_time    = uhd::time_spec_t(T0);
+    params.fill          = uhd::mock_rx_streamer::fill_signal(signal);
+    std::vector<uhd::mock_rx_streamer::packet_t> packets(
+        num_packets, uhd::mock_rx_streamer::packet_t{SPP});
+    if (overflow_packet) {
+        packets.insert(
+            packets.begin() + overflow_packet, uhd::mock_rx_streamer::overflow());
+    }
+    return std::make_shared<uhd::mock_rx_streamer>(params, packets);
+}
+
+//! A tone in the middle of bin \p bin of an N point FFT
+sample_t tone(const size_t bin, const size_t index, const float amplitude)
+{
+    const double phase = 2 * uhd::math::PI * double(bin * index % N) / N;
+    return std::polar(amplitude, float(phase));
+}
+
+uhd::rx_spectrum_streamer::sptr make_spectrum(uhd::rx_streamer::sptr rx_stream,
+    const std::string& args,
+    uhd::rx_spectrum_streamer::fft_fn_t fft = nullptr)
+{
+    return uhd::rx_spectrum_streamer::make(
+        rx_stream, RATE, uhd::device_addr_t(args), fft);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_spectrum_args)
+{
+    auto rx_stream = make_rx_streamer(0, [](size_t) {
+        return sample_t();
+    });
+    for (const std::string args : {"fft_size=1000", "fft_size=1", "overlap=1",
+             "overlap=-0.5", "window=kaiser", "averaging=median", "num_avg=0",
+             "decim=0", "max_frame_rate=-1"}) {
+        BOOST_CHECK_THROW(make_spectrum(rx_stream, args), uhd::value_error);
+    }
+    BOOST_CHECK_THROW(
+        uhd::rx_spectrum_streamer::make(rx_stream, 0.0), uhd::value_error);
+    // Any size works with an FFT of one's own
+    auto spectrum = make_spectrum(rx_stream, "fft_size=1000", [](sample_t*) {});
+    BOOST_CHECK_EQUAL(spectrum->get_fft_size(), 1000);
+
+    float buff[1000];
+    uhd::rx_metadata_t md;
+    BOOST_CHECK_EQUAL(spectrum->recv_frame(buff, md, 0.0), 0);
+    BOOST_CHECK_EQUAL(md.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+}
+
+BOOST_AUTO_TEST_CASE(test_spectrum_tone)
+{
+    for (const std::string window : {"rect", "hann", "hamming", "blackman_harris"}) {
+        auto rx_stream = make_rx_streamer(
+            10, [](size_t i) { return tone(5, i, 0.5f) + tone(60, i, 0.1f); });
+        auto spectrum = make_spectrum(rx_stream,
+            "fft_size=64,num_avg=2,log=1,window=" + window);
+
+        std::vector<float> frame(N);
+        uhd::rx_metadata_t md;
+        BOOST_REQUIRE_EQUAL(spectrum->recv_frame(frame.data(), md), N);
+        // The bins are shifted, DC is in the middle
+        BOOST_CHECK_CLOSE(frame[N / 2 + 5], 20 * std::log10(0.5f), 1e-3);
+        BOOST_CHECK_CLOSE(frame[60 - N / 2], 20 * std::log10(0.1f), 1e-3);
+        // Everything else is leakage of the window, if anything
+        BOOST_CHECK_LT(frame[N / 2], -30.0f);
+    }
+
+    auto rx_stream = make_rx_streamer(
+        10, [](size_t i) { return tone(5, i, 0.5f); });
+    auto spectrum = make_spectrum(rx_stream, "fft_size=64,window=rect,shift=0");
+    std::vector<float> frame(N);
+    uhd::rx_metadata_t md;
+    BOOST_REQUIRE_EQUAL(spectrum->recv_frame(frame.data(), md), N);
+    for (size_t bin = 0; bin < N; bin++) {
+        BOOST_CHECK_SMALL(frame[bin] - (bin == 5 ? 0.25f : 0.0f), 1e-5f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_spectrum_frames)
+{
+    // Every frame averages 4 windows, which overlap by half
+    auto rx_stream = make_rx_streamer(
+        20, [](size_t i) { return tone(1, i, 1.0f); });
+    size_t num_ffts = 0;
+    auto spectrum   = make_spectrum(rx_stream,
+        "fft_size=64,num_avg=4,overlap=0.5,decim=2",
+        [&num_ffts](sample_t*) { num_ffts++; });
+
+    std::vector<float> frame(N);
+    uhd::rx_metadata_t md;
+    size_t num_frames = 0;
+    while (spectrum->recv_frame(frame.data(), md)) {
+        BOOST_REQUIRE(md.has_time_spec);
+        // Only every other frame is returned, each starts 4 * 32 samples later
+        BOOST_CHECK_CLOSE(md.time_spec.get_real_secs(),
+            T0 + double(2 * 4 * 32 * num_frames) / RATE,
+            1e-9);
+        num_frames++;
+    }
+    BOOST_CHECK_EQUAL(md.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+    // 2000 samples are 61 windows, i.e., 15 frames
+    BOOST_CHECK_EQUAL(num_frames, 8);
+    BOOST_CHECK_EQUAL(spectrum->get_num_frames_skipped(), 7);
+    // Frames that are skipped aren't computed
+    BOOST_CHECK_EQUAL(num_ffts, 4 * num_frames);
+}
+
+BOOST_AUTO_TEST_CASE(test_spectrum_exp_average)
+{
+    // The tone switches off halfway through
+    auto rx_stream = make_rx_streamer(
+        20, [](size_t i) { return i < 1000 ? tone(3, i, 1.0f) : sample_t(); });
+    auto spectrum =
+        make_spectrum(rx_stream, "fft_size=64,overlap=0,averaging=exp,num_avg=4");
+
+    std::vector<float> frame(N);
+    uhd::rx_metadata_t md;
+    std::vector<float> powers;
+    size_t num_frames = 0;
+    while (spectrum->recv_frame(frame.data(), md)) {
+        // One frame per window
+        BOOST_CHECK_CLOSE(md.time_spec.get_real_secs(),
+            T0 + double(64 * num_frames) / RATE,
+            1e-9);
+        num_frames++;
+        powers.push_back(frame[N / 2 + 3]);
+    }
+    BOOST_REQUIRE_EQUAL(powers.size(), 2000 / 64);
+    // 15 windows hold the tone, the 16th only partly
+    for (size_t i = 0; i < 15; i++) {
+        BOOST_CHECK_CLOSE(powers[i], 1.0f, 1e-3);
+    }
+    for (size_t i = 16; i < powers.size(); i++) {
+        BOOST_CHECK_CLOSE(powers[i], powers[i - 1] * 0.75f, 1e-3);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_spectrum_overflow)
+{
+    // The overflow comes after 5 packets, i.e., 7 windows without overlap
+    auto rx_stream = make_rx_streamer(
+        10, [](size_t i) { return tone(1, i, 1.0f); }, 5);
+    auto spectrum = make_spectrum(rx_stream, "fft_size=64,overlap=0,num_avg=4");
+
+    std::vector<float> frame(N);
+    uhd::rx_metadata_t md;
+    BOOST_REQUIRE_EQUAL(spectrum->recv_frame(frame.data(), md), N);
+    BOOST_CHECK_CLOSE(md.time_spec.get_real_secs(), T0, 1e-9);
+    // The second frame starts over after the overflow
+    BOOST_REQUIRE_EQUAL(spectrum->recv_frame(frame.data(), md), N);
+    BOOST_CHECK_CLOSE(md.time_spec.get_real_secs(), T0 + 500 / RATE, 1e-9);
+    BOOST_CHECK_EQUAL(spectrum->get_num_overflows(), 1);
+    BOOST_CHECK_EQUAL(spectrum->recv_frame(frame.data(), md), 0);
+}
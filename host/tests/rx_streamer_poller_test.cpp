@@ -0,0 +1,116 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/mock_rx_streamer.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/utils/rx_streamer_poller.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace {
+
+//! Keeps the ready callback, so the test can play the I/O thread
+std::shared_ptr<uhd::mock_rx_streamer> make_rx_streamer(const bool can_notify = true)
+{
+    uhd::mock_rx_streamer::stream_params params;
+    params.can_notify = can_notify;
+    return std::make_shared<uhd::mock_rx_streamer>(params);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_poller_add_remove)
+{
+    auto poller = uhd::rx_streamer_poller::make();
+    auto rx0    = make_rx_streamer();
+    auto rx1    = make_rx_streamer(false);
+
+    poller->add(rx0);
+    BOOST_CHECK(rx0->has_callback());
+    BOOST_CHECK_THROW(poller->add(rx0), uhd::value_error);
+    BOOST_CHECK_THROW(poller->add(rx1), uhd::not_implemented_error);
+    BOOST_CHECK_EQUAL(poller->size(), 1);
+    BOOST_CHECK_THROW(poller->release(rx1), uhd::value_error);
+
+    poller->remove(rx0);
+    BOOST_CHECK(!rx0->has_callback());
+    BOOST_CHECK_EQUAL(poller->size(), 0);
+    // Removing twice, or something that was never added, is fine
+    poller->remove(rx0);
+    poller->remove(rx1);
+    BOOST_CHECK(poller->wait(0.0).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_poller_wait)
+{
+    auto poller = uhd::rx_streamer_poller::make();
+    std::vector<std::shared_ptr<uhd::mock_rx_streamer>> rxs;
+    for (size_t i = 0; i < 3; i++) {
+        rxs.push_back(make_rx_streamer());
+        poller->add(rxs.back());
+    }
+
+    // New streamers are ready, and are handed out only once
+    BOOST_CHECK_EQUAL(poller->wait(0.0, 2).size(), 2);
+    auto ready = poller->wait(0.0);
+    BOOST_REQUIRE_EQUAL(ready.size(), 1);
+    BOOST_CHECK(ready[0] == rxs[2]);
+    BOOST_CHECK(poller->wait(0.0).empty());
+    for (auto& rx : rxs) {
+        poller->release(rx);
+    }
+    BOOST_CHECK(poller->wait(0.0).empty());
+
+    // Ready in the order of the notifications, no matter how many
+    rxs[1]->notify();
+    rxs[0]->notify();
+    rxs[1]->notify();
+    ready = poller->wait(0.0);
+    BOOST_REQUIRE_EQUAL(ready.size(), 2);
+    BOOST_CHECK(ready[0] == rxs[1]);
+    BOOST_CHECK(ready[1] == rxs[0]);
+
+    // Data that arrives while a streamer is handed out makes it ready again
+    // when it's released
+    rxs[0]->notify();
+    poller->release(rxs[1]);
+    BOOST_CHECK(poller->wait(0.0).empty());
+    poller->release(rxs[0]);
+    ready = poller->wait(0.0);
+    BOOST_REQUIRE_EQUAL(ready.size(), 1);
+    BOOST_CHECK(ready[0] == rxs[0]);
+    poller->release(rxs[0]);
+
+    // Removed streamers aren't handed out
+    rxs[2]->notify();
+    poller->remove(rxs[2]);
+    BOOST_CHECK(poller->wait(0.0).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_poller_wakeup)
+{
+    auto poller = uhd::rx_streamer_poller::make();
+    auto rx     = make_rx_streamer();
+    poller->add(rx);
+    poller->wait(0.0);
+    poller->release(rx);
+
+    std::thread notifier([rx]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        rx->notify();
+    });
+    const auto ready = poller->wait(5.0);
+    notifier.join();
+    BOOST_REQUIRE_EQUAL(ready.size(), 1);
+    BOOST_CHECK(ready[0] == rx);
+
+    // The streamer doesn't keep the poller alive
+    poller.reset();
+    BOOST_CHECK(!rx->has_callback());
+    rx->notify();
+}
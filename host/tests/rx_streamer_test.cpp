@@ -5,6 +5,7 @@
 //
 
 #include "../common/mock_link.hpp"
+#include <uhd/utils/math.hpp>
 #include <uhdlib/transport/rx_streamer_impl.hpp>
 #include <boost/test/unit_test.hpp>
 #include <iostream>
@@ -53,7 +54,10 @@ public:
         const int32_t timeout_ms)
     {
         frame_buff::uptr buff = _recv_link->get_recv_buff(timeout_ms);
-        mock_header_t header  = *(reinterpret_cast<mock_header_t*>(buff->data()));
+        if (!buff) {
+            return std::make_tuple(std::move(buff), packet_info_t(), false);
+        }
+        mock_header_t header = *(reinterpret_cast<mock_header_t*>(buff->data()));
 
         packet_info_t info;
         info.eob           = header.eob;
@@ -122,6 +126,24 @@ public:
     {
         rx_streamer_impl::set_scale_factor(chan, scale_factor);
     }
+
+    void set_report_gaps(const bool enable)
+    {
+        rx_streamer_impl::set_report_gaps(enable);
+    }
+
+    void add_rx_tag(const size_t chan,
+        const uhd::rx_tag_t::tag_type_t type,
+        const uint64_t time_ticks)
+    {
+        rx_streamer_impl::add_rx_tag(chan, type, time_ticks);
+    }
+
+    void set_iq_correction(
+        const size_t chan, const uhd::convert::iq_correction_t& correction)
+    {
+        rx_streamer_impl::set_iq_correction(chan, correction);
+    }
 };
 
 }} // namespace uhd::transport
@@ -138,9 +160,10 @@ static const double SCALE_FACTOR = 2;
 /*!
  * Helper functions
  */
-static std::vector<mock_recv_link::sptr> make_links(const size_t num)
+static std::vector<mock_recv_link::sptr> make_links(
+    const size_t num, const size_t frame_size = FRAME_SIZE)
 {
-    const mock_recv_link::link_params params = {FRAME_SIZE, 1};
+    const mock_recv_link::link_params params = {frame_size, 1};
 
     std::vector<mock_recv_link::sptr> links;
 
@@ -154,9 +177,11 @@ static std::vector<mock_recv_link::sptr> make_links(const size_t num)
 static std::shared_ptr<mock_rx_streamer> make_rx_streamer(
     std::vector<mock_recv_link::sptr> recv_links,
     const std::string& host_format,
-    const std::string& otw_format = "sc16")
+    const std::string& otw_format = "sc16",
+    const std::string& args       = "")
 {
-    const uhd::stream_args_t stream_args(host_format, otw_format);
+    uhd::stream_args_t stream_args(host_format, otw_format);
+    stream_args.args = uhd::device_addr_t(args);
     auto streamer = std::make_shared<mock_rx_streamer>(recv_links.size(), stream_args);
     streamer->set_tick_rate(TICK_RATE);
     streamer->set_samp_rate(SAMP_RATE);
@@ -241,6 +266,221 @@ BOOST_AUTO_TEST_CASE(test_recv_one_channel_one_packet)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_recv_iq_correction)
+{
+    const std::string format("fc32");
+
+    auto recv_links = make_links(2);
+    auto streamer   = make_rx_streamer(recv_links, format);
+
+    const size_t num_samps = 20;
+    std::vector<std::vector<std::complex<float>>> buffer(
+        2, std::vector<std::complex<float>>(num_samps));
+    std::vector<void*> buffers = {buffer[0].data(), buffer[1].data()};
+    uhd::rx_metadata_t metadata;
+
+    // Correct the first channel only
+    const auto correction =
+        uhd::convert::iq_correction_t::from_iq_balance({0.0, 0.5}, {1.0, 0.5}, 2.0);
+    streamer->set_iq_correction(0, correction);
+
+    for (const bool corrected : {true, false}) {
+        mock_header_t header;
+        for (size_t ch = 0; ch < 2; ch++) {
+            push_back_recv_packet(recv_links[ch], header, num_samps);
+        }
+        BOOST_CHECK_EQUAL(
+            streamer->recv(buffers, num_samps, metadata, 1.0, false), num_samps);
+
+        for (size_t j = 0; j < num_samps; j++) {
+            const auto value =
+                std::complex<float>((j * 2) * SCALE_FACTOR, (j * 2 + 1) * SCALE_FACTOR);
+            BOOST_CHECK_EQUAL(value, buffer[1][j]);
+            if (corrected) {
+                const float i = value.real() - 1.0f;
+                const float q = value.imag() - 0.5f;
+                BOOST_CHECK_EQUAL(std::complex<float>(2 * i, i + 2 * q), buffer[0][j]);
+            } else {
+                BOOST_CHECK_EQUAL(value, buffer[0][j]);
+            }
+        }
+
+        // The identity goes back to the regular converter
+        streamer->set_iq_correction(0, uhd::convert::iq_correction_t());
+    }
+
+    // Interleaved output always converts all channels at once
+    auto interleaved = make_rx_streamer(make_links(2), format, "sc16", "interleave=1");
+    BOOST_CHECK_THROW(
+        interleaved->set_iq_correction(0, correction), uhd::not_implemented_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_recv_host_dsp)
+{
+    const std::string format("fc32");
+    uhd::rx_metadata_t metadata;
+
+    // A frequency shift alone multiplies each sample with the NCO
+    {
+        auto recv_links = make_links(1);
+        const std::string args = "host_freq_shift=" + std::to_string(SAMP_RATE / 8);
+        auto streamer          = make_rx_streamer(recv_links, format, "sc16", args);
+        const size_t num_samps = 20;
+        std::vector<std::complex<float>> buff(num_samps);
+        push_back_recv_packet(recv_links[0], mock_header_t(), num_samps);
+        BOOST_CHECK_EQUAL(
+            streamer->recv(buff.data(), num_samps, metadata, 1.0, false), num_samps);
+        for (size_t j = 0; j < num_samps; j++) {
+            const auto value =
+                std::complex<float>((j * 2) * SCALE_FACTOR, (j * 2 + 1) * SCALE_FACTOR)
+                * std::polar(1.0f, float(j * uhd::math::PI / 4));
+            BOOST_CHECK_SMALL(std::abs(value - buff[j]), 1e-3f);
+        }
+    }
+
+    // Resampling a ramp, the outputs of the symmetric phases of the filter lie
+    // on the ramp, delayed by half the length of the filter
+    for (const size_t interp : {1, 2}) {
+        const size_t decim     = 3 - interp;
+        const size_t num_taps  = polyphase_resampler::TAPS_PER_PHASE * decim;
+        const size_t pkt_samps = 100;
+        const size_t num_pkts  = 10;
+        const size_t num_out   = pkt_samps * num_pkts * interp / decim;
+        const double host_rate = SAMP_RATE * interp / decim;
+        const std::string args = "host_rate=" + std::to_string(host_rate);
+        auto recv_links        = make_links(1);
+        auto streamer          = make_rx_streamer(recv_links, format, "sc16", args);
+
+        for (size_t i = 0; i < num_pkts; i++) {
+            mock_header_t header;
+            header.has_tsf = true;
+            header.tsf     = 1000 + i * pkt_samps * TICK_RATE / SAMP_RATE;
+            push_back_recv_packet(recv_links[0], header, pkt_samps, i * pkt_samps);
+        }
+        std::vector<std::complex<float>> buff(num_out);
+        BOOST_CHECK_EQUAL(
+            streamer->recv(buff.data(), num_out, metadata, 1.0, false), num_out);
+        BOOST_CHECK_EQUAL(metadata.time_spec.to_ticks(TICK_RATE), 1000);
+
+        const double delay = (num_taps - 1) / 2.0;
+        for (size_t j = 2 * num_taps; j < num_out; j++) {
+            const double n = double(j * decim) / interp - delay;
+            BOOST_CHECK_CLOSE(buff[j].real(), 2 * n * SCALE_FACTOR, 0.01);
+            BOOST_CHECK_CLOSE(buff[j].imag(), (2 * n + 1) * SCALE_FACTOR, 0.01);
+        }
+    }
+
+    BOOST_CHECK_THROW(make_rx_streamer(make_links(1), "fc64", "sc16", "host_rate=1e6"),
+        uhd::value_error);
+    BOOST_CHECK_THROW(
+        make_rx_streamer(make_links(2), format, "sc16", "host_rate=1e6,interleave=1"),
+        uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_recv_convert_threads)
+{
+    const std::string format("fc32");
+    const size_t num_samps = 1000;
+
+    auto recv_links = make_links(2, 8000);
+    auto streamer   = make_rx_streamer(recv_links, format, "sc16", "convert_threads=3");
+
+    std::vector<std::vector<std::complex<float>>> buffer(
+        2, std::vector<std::complex<float>>(num_samps));
+    std::vector<void*> buffers = {buffer[0].data(), buffer[1].data()};
+    uhd::rx_metadata_t metadata;
+
+    // The workers have to follow changes to the converter of a channel
+    const auto correction =
+        uhd::convert::iq_correction_t::from_iq_balance({0.0, 0.5}, {1.0, 0.5}, 2.0);
+    streamer->set_iq_correction(0, correction);
+    streamer->set_scale_factor(1, 2 * SCALE_FACTOR);
+
+    for (size_t pkt = 0; pkt < 3; pkt++) {
+        for (size_t ch = 0; ch < 2; ch++) {
+            push_back_recv_packet(recv_links[ch], mock_header_t(), num_samps);
+        }
+        BOOST_CHECK_EQUAL(
+            streamer->recv(buffers, num_samps, metadata, 1.0, false), num_samps);
+        BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+
+        for (size_t j = 0; j < num_samps; j++) {
+            const auto value =
+                std::complex<float>((j * 2) * SCALE_FACTOR, (j * 2 + 1) * SCALE_FACTOR);
+            const float i = value.real() - 1.0f;
+            const float q = value.imag() - 0.5f;
+            BOOST_CHECK_EQUAL(std::complex<float>(2 * i, i + 2 * q), buffer[0][j]);
+            BOOST_CHECK_EQUAL(2.0f * value, buffer[1][j]);
+        }
+    }
+
+    BOOST_CHECK_THROW(
+        make_rx_streamer(make_links(2), format, "sc16", "convert_threads=2,interleave=1"),
+        uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_recv_signal_stats)
+{
+    const std::string format("fc32");
+    const size_t num_samps = 1001;
+    std::vector<std::complex<float>> buff(num_samps);
+    uhd::rx_metadata_t metadata;
+
+    double sum_power = 0.0, peak_power = 0.0;
+    std::complex<double> sum;
+    for (size_t j = 0; j < num_samps; j++) {
+        const std::complex<double> value(
+            (j * 2) * SCALE_FACTOR, (j * 2 + 1) * SCALE_FACTOR);
+        sum_power += std::norm(value);
+        peak_power = std::max(peak_power, std::norm(value));
+        sum += value;
+    }
+
+    // The workers of the convert pool each collect the statistics of a part
+    // of the samples
+    for (const std::string args :
+        {"signal_stats=1", "signal_stats=1,convert_threads=2"}) {
+        auto recv_links = make_links(1, 8000);
+        auto streamer   = make_rx_streamer(recv_links, format, "sc16", args);
+
+        push_back_recv_packet(recv_links[0], mock_header_t(), num_samps);
+        BOOST_CHECK_EQUAL(
+            streamer->recv(buff.data(), num_samps, metadata, 1.0, false), num_samps);
+        uhd::signal_stats_t stats = streamer->get_signal_stats(0);
+        BOOST_CHECK_EQUAL(stats.num_samps, num_samps);
+        BOOST_CHECK_CLOSE(stats.sum_power, sum_power, 1e-3);
+        BOOST_CHECK_CLOSE(stats.peak_power, peak_power, 1e-3);
+        BOOST_CHECK_CLOSE(stats.get_dc_offset().real(), sum.real() / num_samps, 1e-3);
+        BOOST_CHECK_CLOSE(stats.get_dc_offset().imag(), sum.imag() / num_samps, 1e-3);
+        BOOST_CHECK_EQUAL(stats.num_clipped, 0);
+
+        // (32766, 32767) and (-32768, -32767) have two clipped values
+        push_back_recv_packet(recv_links[0], mock_header_t(), 2, 16383);
+        BOOST_CHECK_EQUAL(streamer->recv(buff.data(), 2, metadata, 1.0, false), 2);
+        stats = streamer->get_signal_stats(0, false);
+        BOOST_CHECK_EQUAL(stats.num_samps, 2);
+        BOOST_CHECK_EQUAL(stats.num_clipped, 2);
+        BOOST_CHECK_EQUAL(
+            buff[1], std::complex<float>(-32768 * SCALE_FACTOR, -32767 * SCALE_FACTOR));
+        BOOST_CHECK_EQUAL(streamer->get_signal_stats(0).num_samps, 2);
+        BOOST_CHECK_EQUAL(streamer->get_signal_stats(0).num_samps, 0);
+
+        // The statistics and IQ correction need different converters
+        const auto correction =
+            uhd::convert::iq_correction_t::from_iq_balance({0.5, 0.0});
+        BOOST_CHECK_THROW(
+            streamer->set_iq_correction(0, correction), uhd::not_implemented_error);
+        streamer->set_signal_stats_enabled(false);
+        BOOST_CHECK_THROW(streamer->get_signal_stats(0), uhd::not_implemented_error);
+    }
+
+    auto interleaved = make_rx_streamer(make_links(2), format, "sc16", "interleave=1");
+    BOOST_CHECK_THROW(
+        interleaved->set_signal_stats_enabled(true), uhd::not_implemented_error);
+    auto sc16 = make_rx_streamer(make_links(1), "sc16");
+    BOOST_CHECK_THROW(sc16->set_signal_stats_enabled(true), uhd::not_implemented_error);
+}
+
 BOOST_AUTO_TEST_CASE(test_recv_one_channel_multi_packet)
 {
     const size_t NUM_BUFFS_TO_TEST = 5;
@@ -317,6 +557,7 @@ BOOST_AUTO_TEST_CASE(test_recv_one_channel_multi_packet_with_eob)
         BOOST_CHECK_EQUAL(num_samps_ret, spp * 2);
         BOOST_CHECK_EQUAL(metadata.end_of_burst, true);
         BOOST_CHECK_EQUAL(metadata.has_time_spec, false);
+        BOOST_CHECK_EQUAL(metadata.burst_index, i);
     }
 }
 
@@ -376,6 +617,104 @@ BOOST_AUTO_TEST_CASE(test_recv_two_channel_one_packet)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_recv_two_channel_sample_offset)
+{
+    // The packets of channel 1 start a few samples later than the ones of
+    // channel 0, as after a timed start with an offset that isn't a whole
+    // packet. The streamer aligns the channels to the sample.
+    const std::string format("sc16");
+    const size_t num_chans        = 2;
+    const size_t num_samps        = 20;
+    const size_t offset_samps     = 4;
+    const size_t num_pkts         = 5;
+    const uint64_t ticks_per_samp = static_cast<uint64_t>(TICK_RATE / SAMP_RATE);
+
+    auto recv_links = make_links(num_chans);
+    auto streamer   = make_rx_streamer(recv_links, format);
+
+    // The data of each sample is its time, so aligned samples are equal
+    for (size_t i = 0; i < num_pkts; i++) {
+        for (size_t ch = 0; ch < num_chans; ch++) {
+            const size_t start = i * num_samps + ch * offset_samps;
+            mock_header_t header;
+            header.has_tsf = true;
+            header.tsf     = start * ticks_per_samp;
+            push_back_recv_packet(recv_links[ch], header, num_samps, start);
+        }
+    }
+
+    const size_t total_samps = (num_pkts - 1) * num_samps;
+    std::vector<std::vector<std::complex<uint16_t>>> buffer(num_chans);
+    std::vector<void*> buffers;
+    for (size_t ch = 0; ch < num_chans; ch++) {
+        buffer[ch].resize(total_samps);
+        buffers.push_back(&buffer[ch].front());
+    }
+
+    uhd::rx_metadata_t metadata;
+    const size_t num_samps_ret =
+        streamer->recv(buffers, total_samps, metadata, 1.0, false);
+    BOOST_CHECK_EQUAL(num_samps_ret, total_samps);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+    BOOST_CHECK_EQUAL(metadata.time_ticks, offset_samps * ticks_per_samp);
+
+    for (size_t samp = 0; samp < total_samps; samp++) {
+        const uint16_t val = (offset_samps + samp) * 2;
+        for (size_t ch = 0; ch < num_chans; ch++) {
+            BOOST_CHECK_EQUAL(buffer[ch][samp], std::complex<uint16_t>(val, val + 1));
+        }
+    }
+
+    // The rest of the last packet of channel 0 is still there
+    std::vector<std::complex<uint16_t>> rest(num_samps);
+    const size_t num_rest = streamer->recv(
+        std::vector<void*>(num_chans, &rest.front()), num_samps, metadata, 0.0, true);
+    BOOST_CHECK_EQUAL(num_rest, num_samps - offset_samps);
+    BOOST_CHECK_EQUAL(metadata.time_ticks, (offset_samps + total_samps) * ticks_per_samp);
+}
+
+BOOST_AUTO_TEST_CASE(test_recv_multi_channel_interleaved)
+{
+    const size_t NUM_PKTS_TO_TEST = 3;
+    const std::string format("fc32");
+
+    const size_t num_chans = 4;
+
+    auto recv_links = make_links(num_chans);
+    auto streamer   = make_rx_streamer(recv_links, format, "sc16", "interleave=1");
+
+    const size_t num_samps = 20;
+
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        mock_header_t header;
+        for (size_t ch = 0; ch < num_chans; ch++) {
+            push_back_recv_packet(
+                recv_links[ch], header, num_samps, (i * num_chans + ch) * num_samps);
+        }
+    }
+
+    // Receive all packets at once, so that packets are written to an offset
+    // into the buffer
+    const size_t total_samps = NUM_PKTS_TO_TEST * num_samps;
+    std::vector<std::complex<float>> buffer(total_samps * num_chans);
+
+    uhd::rx_metadata_t metadata;
+    const size_t num_samps_ret =
+        streamer->recv(&buffer.front(), total_samps, metadata, 1.0, false);
+    BOOST_CHECK_EQUAL(num_samps_ret, total_samps);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+
+    for (size_t samp = 0; samp < total_samps; samp++) {
+        const size_t pkt = samp / num_samps;
+        for (size_t ch = 0; ch < num_chans; ch++) {
+            const size_t n = (pkt * num_chans + ch) * num_samps + samp % num_samps;
+            const std::complex<float> value(
+                (n * 2) * SCALE_FACTOR, (n * 2 + 1) * SCALE_FACTOR);
+            BOOST_CHECK_EQUAL(value, buffer[samp * num_chans + ch]);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(test_recv_one_channel_packet_fragment)
 {
     const size_t NUM_PKTS_TO_TEST = 5;
@@ -416,6 +755,8 @@ BOOST_AUTO_TEST_CASE(test_recv_one_channel_packet_fragment)
             const size_t ticks_per_sample = static_cast<size_t>(TICK_RATE / SAMP_RATE);
             const size_t expected_ticks   = ticks_per_sample * total_samps_read;
             BOOST_CHECK_EQUAL(metadata.time_spec.to_ticks(TICK_RATE), expected_ticks);
+            BOOST_CHECK(metadata.has_time_ticks);
+            BOOST_CHECK_EQUAL(metadata.time_ticks, expected_ticks);
 
             for (size_t samp = 0; samp < num_samps; samp++) {
                 const size_t pkt_idx = samp + total_samps_read;
@@ -429,6 +770,510 @@ BOOST_AUTO_TEST_CASE(test_recv_one_channel_packet_fragment)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_recv_zero_copy)
+{
+    const size_t NUM_PKTS_TO_TEST = 3;
+    const size_t NUM_CHANS        = 2;
+    const size_t num_samps        = 20;
+    const std::string format("fc32");
+
+    auto recv_links = make_links(NUM_CHANS);
+    auto streamer   = make_rx_streamer(recv_links, format);
+
+    // Links only have a single frame, so each packet can only be received
+    // after the previous one was released
+    std::vector<const void*> buffs;
+    uhd::rx_metadata_t metadata;
+
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        for (size_t ch = 0; ch < NUM_CHANS; ch++) {
+            mock_header_t header;
+            header.has_tsf = true;
+            header.tsf     = i * num_samps;
+            push_back_recv_packet(recv_links[ch], header, num_samps, ch * 100);
+        }
+
+        const size_t num_samps_ret = streamer->recv_zero_copy(buffs, metadata, 1.0);
+
+        BOOST_CHECK_EQUAL(num_samps_ret, num_samps);
+        BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+        BOOST_CHECK_EQUAL(metadata.more_fragments, false);
+        BOOST_CHECK_EQUAL(metadata.fragment_offset, 0);
+        BOOST_CHECK_EQUAL(metadata.time_spec.to_ticks(TICK_RATE), i * num_samps);
+        BOOST_REQUIRE_EQUAL(buffs.size(), NUM_CHANS);
+
+        for (size_t ch = 0; ch < NUM_CHANS; ch++) {
+            // Samples are handed out in the over-the-wire format, unscaled
+            auto samps = reinterpret_cast<const std::complex<uint16_t>*>(buffs[ch]);
+            for (size_t samp = 0; samp < num_samps; samp++) {
+                const uint16_t val = (ch * 100 + samp) * 2;
+                BOOST_CHECK_EQUAL(samps[samp], std::complex<uint16_t>(val, val + 1));
+            }
+        }
+
+        // Buffers must be released before receiving again
+        std::vector<std::complex<float>> buff(num_samps);
+        std::vector<void*> recv_buffs(NUM_CHANS, buff.data());
+        BOOST_CHECK_THROW(streamer->recv_zero_copy(buffs, metadata, 1.0),
+            uhd::runtime_error);
+        BOOST_CHECK_THROW(streamer->recv(recv_buffs, num_samps, metadata, 1.0, false),
+            uhd::runtime_error);
+
+        streamer->release_recv_buffs();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_recv_zero_copy_fragment)
+{
+    const std::string format("fc32");
+
+    auto recv_links = make_links(1);
+    auto streamer   = make_rx_streamer(recv_links, format);
+
+    // Receive the first quarter of a packet with recv(), the rest zero-copy
+    const size_t num_samps = 40;
+    const size_t num_read  = num_samps / 4;
+    mock_header_t header;
+    header.has_tsf = true;
+    header.tsf     = 0;
+    push_back_recv_packet(recv_links[0], header, num_samps);
+
+    std::vector<std::complex<float>> buff(num_read);
+    uhd::rx_metadata_t metadata;
+    BOOST_CHECK_EQUAL(
+        streamer->recv(buff.data(), buff.size(), metadata, 1.0, false), num_read);
+    BOOST_CHECK_EQUAL(metadata.more_fragments, true);
+
+    std::vector<const void*> buffs;
+    const size_t num_samps_ret = streamer->recv_zero_copy(buffs, metadata, 1.0);
+    BOOST_CHECK_EQUAL(num_samps_ret, num_samps - num_read);
+    BOOST_CHECK_EQUAL(metadata.more_fragments, false);
+    BOOST_CHECK_EQUAL(metadata.fragment_offset, num_read);
+    BOOST_CHECK_EQUAL(metadata.time_spec.to_ticks(SAMP_RATE), num_read);
+
+    auto samps = reinterpret_cast<const std::complex<uint16_t>*>(buffs[0]);
+    for (size_t samp = 0; samp < num_samps_ret; samp++) {
+        const uint16_t val = (num_read + samp) * 2;
+        BOOST_CHECK_EQUAL(samps[samp], std::complex<uint16_t>(val, val + 1));
+    }
+    streamer->release_recv_buffs();
+
+    // The next packet can be received normally
+    push_back_recv_packet(recv_links[0], header, num_samps);
+    buff.resize(num_samps);
+    BOOST_CHECK_EQUAL(
+        streamer->recv(buff.data(), buff.size(), metadata, 1.0, false), num_samps);
+    BOOST_CHECK_EQUAL(metadata.more_fragments, false);
+}
+
+BOOST_AUTO_TEST_CASE(test_recv_stats)
+{
+    const size_t NUM_PKTS_TO_TEST = 4;
+    const size_t NUM_CHANS        = 2;
+    const size_t num_samps        = 20;
+    const std::string format("fc32");
+
+    auto recv_links = make_links(NUM_CHANS);
+    auto streamer   = make_rx_streamer(recv_links, format, "sc16", "enable_stats=1");
+
+    std::vector<std::complex<float>> buff(num_samps * NUM_CHANS);
+    std::vector<void*> buffs = {buff.data(), buff.data() + num_samps};
+    uhd::rx_metadata_t metadata;
+
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        // Only count the first half of the packets
+        streamer->set_stats_enabled(i < NUM_PKTS_TO_TEST / 2);
+        for (size_t ch = 0; ch < NUM_CHANS; ch++) {
+            mock_header_t header;
+            push_back_recv_packet(recv_links[ch], header, num_samps);
+        }
+        BOOST_CHECK_EQUAL(streamer->recv(buffs, num_samps, metadata, 1.0, false),
+            num_samps);
+    }
+
+    const uhd::streamer_stats_t stats = streamer->get_stats();
+    BOOST_CHECK(!stats.enabled);
+    BOOST_REQUIRE_EQUAL(stats.chans.size(), NUM_CHANS);
+    for (const auto& chan : stats.chans) {
+        BOOST_CHECK_EQUAL(chan.packets, NUM_PKTS_TO_TEST / 2);
+        BOOST_CHECK_EQUAL(chan.bytes,
+            NUM_PKTS_TO_TEST / 2 * num_samps * sizeof(std::complex<uint16_t>));
+    }
+    BOOST_CHECK_EQUAL(stats.seq_errors, 0);
+    BOOST_CHECK_EQUAL(
+        stats.wait_time_hist.size(), uhd::streamer_stats_t::NUM_WAIT_TIME_BUCKETS);
+
+    // Packets were always available, so receiving never had to wait
+    BOOST_CHECK_EQUAL(stats.stalls, 0);
+    BOOST_CHECK_EQUAL(stats.wait_time_ns, 0);
+    BOOST_CHECK(stats.latency.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_recv_latency_probe)
+{
+    const size_t NUM_PKTS_TO_TEST = 4;
+    const size_t num_samps        = 20;
+    const std::string format("fc32");
+
+    auto recv_links = make_links(1);
+    auto streamer =
+        make_rx_streamer(recv_links, format, "sc16", "enable_latency_probe=1");
+
+    std::vector<std::complex<float>> buff(num_samps);
+    uhd::rx_metadata_t metadata;
+
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        // Only measure the first half of the packets
+        streamer->set_latency_probe_enabled(i < NUM_PKTS_TO_TEST / 2);
+        mock_header_t header;
+        push_back_recv_packet(recv_links[0], header, num_samps);
+        BOOST_CHECK_EQUAL(
+            streamer->recv(buff.data(), num_samps, metadata, 1.0, false), num_samps);
+    }
+
+    // The probe is independent of the other statistics
+    const uhd::streamer_stats_t stats = streamer->get_stats();
+    BOOST_CHECK(!stats.enabled);
+    BOOST_CHECK_EQUAL(stats.chans[0].packets, 0);
+    BOOST_REQUIRE_EQUAL(stats.latency.size(), 2);
+    for (const std::string stage : {"link_to_streamer", "link_to_recv_return"}) {
+        const auto& latency = stats.latency.at(stage);
+        BOOST_CHECK_EQUAL(latency.count, NUM_PKTS_TO_TEST / 2);
+        BOOST_CHECK_LE(latency.max_ns, latency.total_ns);
+        BOOST_REQUIRE_EQUAL(
+            latency.hist.size(), uhd::streamer_stats_t::NUM_WAIT_TIME_BUCKETS);
+        uint64_t hist_total = 0;
+        for (const uint64_t bucket : latency.hist) {
+            hist_total += bucket;
+        }
+        BOOST_CHECK_EQUAL(hist_total, latency.count);
+    }
+    BOOST_CHECK_LE(stats.latency.at("link_to_streamer").total_ns,
+        stats.latency.at("link_to_recv_return").total_ns);
+}
+
+BOOST_AUTO_TEST_CASE(test_recv_arrival_skew)
+{
+    const size_t NUM_PKTS_TO_TEST = 4;
+    const size_t NUM_CHANS        = 3;
+    const size_t num_samps        = 20;
+    const std::string format("fc32");
+
+    auto recv_links = make_links(NUM_CHANS);
+    auto streamer =
+        make_rx_streamer(recv_links, format, "sc16", "enable_latency_probe=1");
+    streamer->set_latency_probe_enabled(true);
+
+    std::vector<std::complex<float>> buff(num_samps * NUM_CHANS);
+    std::vector<void*> buffs;
+    for (size_t ch = 0; ch < NUM_CHANS; ch++) {
+        buffs.push_back(&buff[ch * num_samps]);
+    }
+    uhd::rx_metadata_t metadata;
+
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        for (size_t ch = 0; ch < NUM_CHANS; ch++) {
+            mock_header_t header;
+            push_back_recv_packet(recv_links[ch], header, num_samps);
+        }
+        BOOST_CHECK_EQUAL(streamer->recv(buffs, num_samps, metadata, 1.0, false),
+            num_samps);
+    }
+
+    const uhd::streamer_stats_t stats = streamer->get_stats();
+    BOOST_REQUIRE_EQUAL(stats.chans.size(), NUM_CHANS);
+    for (const auto& chan : stats.chans) {
+        BOOST_CHECK_EQUAL(chan.skew_count, NUM_PKTS_TO_TEST);
+        BOOST_CHECK_LE(chan.skew_max_ns, chan.skew_total_ns);
+    }
+    // The links receive the packets in the order of the channels, so the
+    // first channel is never late
+    BOOST_CHECK_EQUAL(stats.chans[0].skew_total_ns, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_recv_timestamp_gap)
+{
+    // Test that a gap in the timestamps is reported as an overflow with the
+    // number of lost samples, and that streaming then resumes with the packet
+    // after the gap
+    const std::string format("fc32");
+    const size_t num_samps        = 20;
+    const size_t num_lost_samps   = 3 * num_samps;
+    const uint64_t ticks_per_samp = static_cast<uint64_t>(TICK_RATE / SAMP_RATE);
+
+    auto recv_links = make_links(1);
+    auto streamer   = make_rx_streamer(recv_links, format);
+    streamer->set_report_gaps(true);
+
+    // Receive one packet per call, and then as many as fit into the buffer
+    for (const size_t buff_samps : {num_samps, 4 * num_samps}) {
+        std::vector<std::complex<float>> buff(buff_samps);
+        uhd::rx_metadata_t metadata;
+
+        uint64_t tsf = 1000;
+        mock_header_t header;
+        header.has_tsf = true;
+        for (size_t i = 0; i < 2; i++) {
+            header.tsf = tsf;
+            push_back_recv_packet(recv_links[0], header, num_samps);
+            tsf += num_samps * ticks_per_samp;
+        }
+        const uint64_t lost_tsf = tsf;
+        tsf += num_lost_samps * ticks_per_samp;
+        header.tsf = tsf;
+        header.eob = true;
+        push_back_recv_packet(recv_links[0], header, num_samps);
+
+        size_t num_samps_recv = 0;
+        while (num_samps_recv < 2 * num_samps) {
+            const size_t ret =
+                streamer->recv(buff.data(), buff.size(), metadata, 1.0, false);
+            BOOST_REQUIRE_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+            num_samps_recv += ret;
+        }
+        BOOST_CHECK_EQUAL(num_samps_recv, 2 * num_samps);
+
+        BOOST_CHECK_EQUAL(
+            streamer->recv(buff.data(), buff.size(), metadata, 1.0, false), 0);
+        BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_OVERFLOW);
+        BOOST_CHECK(!metadata.out_of_sequence);
+        BOOST_CHECK_EQUAL(metadata.num_lost_samps, num_lost_samps);
+        BOOST_CHECK(metadata.has_time_spec);
+        BOOST_CHECK_EQUAL(metadata.time_ticks, lost_tsf);
+        BOOST_CHECK_EQUAL(metadata.time_spec.to_ticks(TICK_RATE), lost_tsf);
+
+        BOOST_CHECK_EQUAL(
+            streamer->recv(buff.data(), buff.size(), metadata, 1.0, false), num_samps);
+        BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+        BOOST_CHECK_EQUAL(metadata.time_ticks, tsf);
+        BOOST_CHECK(metadata.end_of_burst);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_recv_tags)
+{
+    // Test that the tags are placed at the first sample after their time
+    const std::string format("fc32");
+    const size_t num_samps        = 20;
+    const uint64_t ticks_per_samp = static_cast<uint64_t>(TICK_RATE / SAMP_RATE);
+    const uint64_t start_tsf      = 1000;
+
+    auto recv_links = make_links(1);
+    auto streamer   = make_rx_streamer(recv_links, format);
+
+    mock_header_t header;
+    header.has_tsf = true;
+    for (size_t i = 0; i < 3; i++) {
+        header.tsf = start_tsf + i * num_samps * ticks_per_samp;
+        push_back_recv_packet(recv_links[0], header, num_samps);
+    }
+
+    // Before the first sample, between two samples, and in the second packet
+    streamer->add_rx_tag(0, uhd::rx_tag_t::TAG_GAIN, start_tsf - 5);
+    streamer->add_rx_tag(0, uhd::rx_tag_t::TAG_FREQ, start_tsf + 3 * ticks_per_samp + 1);
+    streamer->add_rx_tag(
+        0, uhd::rx_tag_t::TAG_FREQ, start_tsf + (num_samps + 2) * ticks_per_samp);
+
+    std::vector<std::complex<float>> buff(3 * num_samps);
+    std::vector<uhd::rx_tag_t> tags(2);
+    uhd::rx_metadata_t metadata;
+    metadata.tags      = tags.data();
+    metadata.tags_size = tags.size();
+
+    // The tag array fills up in the first packet, so recv() returns early
+    BOOST_CHECK_EQUAL(
+        streamer->recv(buff.data(), buff.size(), metadata, 1.0, false), num_samps);
+    BOOST_REQUIRE_EQUAL(metadata.tags_count, 2);
+    BOOST_CHECK_EQUAL(tags[0].type, uhd::rx_tag_t::TAG_GAIN);
+    BOOST_CHECK_EQUAL(tags[0].offset, 0);
+    BOOST_CHECK_EQUAL(tags[0].time_ticks, start_tsf - 5);
+    BOOST_CHECK_EQUAL(tags[1].type, uhd::rx_tag_t::TAG_FREQ);
+    BOOST_CHECK_EQUAL(tags[1].offset, 4);
+    BOOST_CHECK_EQUAL(tags[1].channel, 0);
+
+    BOOST_CHECK_EQUAL(
+        streamer->recv(buff.data(), 2 * num_samps, metadata, 1.0, false), 2 * num_samps);
+    BOOST_REQUIRE_EQUAL(metadata.tags_count, 1);
+    BOOST_CHECK_EQUAL(tags[0].offset, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_recv_packet_records)
+{
+    // Test that recv() reports the timing and flags of every packet
+    const std::string format("fc32");
+    const size_t num_samps        = 20;
+    const uint64_t ticks_per_samp = static_cast<uint64_t>(TICK_RATE / SAMP_RATE);
+
+    auto recv_links = make_links(1);
+    auto streamer   = make_rx_streamer(recv_links, format);
+
+    mock_header_t header;
+    header.has_tsf = true;
+    for (size_t i = 0; i < 3; i++) {
+        header.tsf = 1000 + i * num_samps * ticks_per_samp;
+        header.eob = (i == 2);
+        push_back_recv_packet(recv_links[0], header, num_samps);
+    }
+
+    std::vector<std::complex<float>> buff(3 * num_samps);
+    std::vector<uhd::rx_packet_info_t> packets(2);
+    uhd::rx_metadata_t metadata;
+    metadata.packets      = packets.data();
+    metadata.packets_size = packets.size();
+
+    // The record array fills up after two packets, so recv() returns early
+    BOOST_CHECK_EQUAL(
+        streamer->recv(buff.data(), buff.size(), metadata, 1.0, false), 2 * num_samps);
+    BOOST_REQUIRE_EQUAL(metadata.packets_count, 2);
+    for (size_t i = 0; i < 2; i++) {
+        BOOST_CHECK_EQUAL(packets[i].offset, i * num_samps);
+        BOOST_CHECK_EQUAL(packets[i].num_samps, num_samps);
+        BOOST_CHECK_EQUAL(packets[i].time_ticks, 1000 + i * num_samps * ticks_per_samp);
+        BOOST_CHECK_EQUAL(packets[i].flags, uhd::rx_packet_info_t::HAS_TIME_TICKS);
+    }
+
+    // A fragment, and the end of the burst
+    const uint64_t last_tsf = 1000 + 2 * num_samps * ticks_per_samp;
+    BOOST_CHECK_EQUAL(
+        streamer->recv(buff.data(), num_samps / 2, metadata, 1.0, false), num_samps / 2);
+    BOOST_REQUIRE_EQUAL(metadata.packets_count, 1);
+    BOOST_CHECK_EQUAL(packets[0].time_ticks, last_tsf);
+    BOOST_CHECK_EQUAL(packets[0].flags,
+        uhd::rx_packet_info_t::HAS_TIME_TICKS | uhd::rx_packet_info_t::MORE_FRAGMENTS
+            | uhd::rx_packet_info_t::END_OF_BURST);
+    BOOST_CHECK_EQUAL(
+        streamer->recv(buff.data(), num_samps / 2, metadata, 1.0, false), num_samps / 2);
+    BOOST_REQUIRE_EQUAL(metadata.packets_count, 1);
+    BOOST_CHECK_EQUAL(packets[0].offset, 0);
+    BOOST_CHECK_EQUAL(packets[0].time_ticks, last_tsf + num_samps / 2 * ticks_per_samp);
+    BOOST_CHECK_EQUAL(packets[0].flags,
+        uhd::rx_packet_info_t::HAS_TIME_TICKS | uhd::rx_packet_info_t::END_OF_BURST);
+}
+
+BOOST_AUTO_TEST_CASE(test_recv_disconnect_channel)
+{
+    // Test that a transport taken from a streamer, while it still holds part
+    // of a packet, can be connected to a new streamer
+    const std::string format("fc32");
+    const size_t num_samps = 20;
+
+    auto recv_links = make_links(1);
+    auto streamer   = make_rx_streamer(recv_links, format);
+
+    std::vector<std::complex<float>> buff(num_samps);
+    uhd::rx_metadata_t metadata;
+    mock_header_t header;
+    push_back_recv_packet(recv_links[0], header, num_samps);
+    BOOST_CHECK_EQUAL(
+        streamer->recv(buff.data(), num_samps / 2, metadata, 1.0, false),
+        num_samps / 2);
+    BOOST_CHECK(metadata.more_fragments);
+
+    auto xport = streamer->disconnect_channel(0);
+    BOOST_REQUIRE(xport);
+    streamer.reset();
+
+    uhd::stream_args_t stream_args(format, "sc16");
+    auto new_streamer = std::make_shared<mock_rx_streamer>(1, stream_args);
+    new_streamer->set_tick_rate(TICK_RATE);
+    new_streamer->set_samp_rate(SAMP_RATE);
+    new_streamer->set_scale_factor(0, SCALE_FACTOR);
+    new_streamer->connect_channel(0, std::move(xport));
+
+    header.has_tsf = true;
+    header.tsf     = 1000;
+    push_back_recv_packet(recv_links[0], header, num_samps);
+    BOOST_CHECK_EQUAL(
+        new_streamer->recv(buff.data(), num_samps, metadata, 1.0, false), num_samps);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+    BOOST_CHECK_EQUAL(metadata.time_ticks, 1000);
+}
+
+BOOST_AUTO_TEST_CASE(test_recv_channel_activation)
+{
+    // Channel 1 is switched off, then joins in the middle of a packet, and
+    // then channel 0 leaves in the middle of a packet
+    const std::string format("sc16");
+    const size_t num_chans        = 2;
+    const size_t num_samps        = 20;
+    const size_t join_samp        = 30;
+    const size_t leave_samp       = 50;
+    const uint64_t ticks_per_samp = static_cast<uint64_t>(TICK_RATE / SAMP_RATE);
+
+    auto recv_links = make_links(num_chans);
+    auto streamer   = make_rx_streamer(recv_links, format);
+
+    // The data of each sample is its time
+    auto push_packets = [&](const size_t start) {
+        for (size_t ch = 0; ch < num_chans; ch++) {
+            mock_header_t header;
+            header.has_tsf = true;
+            header.tsf     = start * ticks_per_samp;
+            push_back_recv_packet(recv_links[ch], header, num_samps, start);
+        }
+    };
+    auto sample = [](const size_t samp) {
+        const uint16_t val = samp * 2;
+        return std::complex<uint16_t>(val, val + 1);
+    };
+
+    std::vector<std::vector<std::complex<uint16_t>>> buffer(
+        num_chans, std::vector<std::complex<uint16_t>>(num_samps));
+    std::vector<void*> buffers = {buffer[0].data(), buffer[1].data()};
+    uhd::rx_metadata_t metadata;
+
+    // Channel 1 returns zeros, its packets are dropped
+    streamer->set_channel_active(1, false);
+    BOOST_CHECK(!streamer->is_channel_active(1));
+    BOOST_CHECK_THROW(streamer->set_channel_active(0, false), uhd::runtime_error);
+    push_packets(0);
+    BOOST_CHECK_EQUAL(
+        streamer->recv(buffers, num_samps, metadata, 1.0, true), num_samps);
+    BOOST_CHECK_EQUAL(metadata.time_ticks, 0);
+    for (size_t samp = 0; samp < num_samps; samp++) {
+        BOOST_CHECK_EQUAL(buffer[0][samp], sample(samp));
+        BOOST_CHECK_EQUAL(buffer[1][samp], std::complex<uint16_t>(0, 0));
+    }
+
+    // Channel 1 joins at a sample within the next packet. recv() stops
+    // before it, and returns both channels from it on.
+    streamer->set_channel_active(1,
+        true,
+        uhd::time_spec_t::from_ticks(join_samp * ticks_per_samp, TICK_RATE));
+    BOOST_CHECK(streamer->is_channel_active(1));
+    push_packets(num_samps);
+    push_packets(2 * num_samps);
+    size_t num_ret = streamer->recv(buffers, num_samps, metadata, 1.0, true);
+    BOOST_CHECK_EQUAL(num_ret, join_samp - num_samps);
+    BOOST_CHECK_EQUAL(metadata.time_ticks, num_samps * ticks_per_samp);
+    for (size_t samp = 0; samp < num_ret; samp++) {
+        BOOST_CHECK_EQUAL(buffer[0][samp], sample(num_samps + samp));
+        BOOST_CHECK_EQUAL(buffer[1][samp], std::complex<uint16_t>(0, 0));
+    }
+    num_ret = streamer->recv(buffers, num_samps, metadata, 1.0, true);
+    BOOST_CHECK_EQUAL(num_ret, 2 * num_samps - join_samp);
+    BOOST_CHECK_EQUAL(metadata.time_ticks, join_samp * ticks_per_samp);
+    for (size_t samp = 0; samp < num_ret; samp++) {
+        BOOST_CHECK_EQUAL(buffer[0][samp], sample(join_samp + samp));
+        BOOST_CHECK_EQUAL(buffer[1][samp], sample(join_samp + samp));
+    }
+
+    // Channel 0 leaves, the metadata then comes from channel 1
+    streamer->set_channel_active(0,
+        false,
+        uhd::time_spec_t::from_ticks(leave_samp * ticks_per_samp, TICK_RATE));
+    num_ret = streamer->recv(buffers, num_samps, metadata, 1.0, true);
+    BOOST_CHECK_EQUAL(num_ret, leave_samp - 2 * num_samps);
+    num_ret = streamer->recv(buffers, num_samps, metadata, 1.0, true);
+    BOOST_CHECK_EQUAL(num_ret, 3 * num_samps - leave_samp);
+    BOOST_CHECK_EQUAL(metadata.time_ticks, leave_samp * ticks_per_samp);
+    for (size_t samp = 0; samp < num_ret; samp++) {
+        BOOST_CHECK_EQUAL(buffer[0][samp], std::complex<uint16_t>(0, 0));
+        BOOST_CHECK_EQUAL(buffer[1][samp], sample(leave_samp + samp));
+    }
+    BOOST_CHECK_THROW(streamer->set_channel_active(1, false), uhd::runtime_error);
+}
+
 BOOST_AUTO_TEST_CASE(test_recv_seq_error)
 {
     // Test that when we get a sequence error the error is returned in the
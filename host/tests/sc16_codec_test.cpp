@@ -0,0 +1,91 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/sc16_codec.hpp>
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include <vector>
+
+using namespace uhd;
+
+namespace {
+
+//! Encodes and decodes values, and returns the size of the encoded data
+size_t round_trip(const std::vector<int16_t>& values)
+{
+    std::vector<uint8_t> encoded(sc16_codec::get_max_encoded_size(values.size()));
+    const size_t size = sc16_codec::encode(values.data(), values.size(), encoded.data());
+    BOOST_REQUIRE(size <= encoded.size());
+
+    std::vector<int16_t> decoded(values.size());
+    BOOST_CHECK_EQUAL(
+        sc16_codec::decode(encoded.data(), size, values.size(), decoded.data()), size);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        values.begin(), values.end(), decoded.begin(), decoded.end());
+    return size;
+}
+
+std::vector<int16_t> make_noise(const size_t num_values, const int16_t amplitude)
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int16_t> dist(-amplitude, amplitude);
+    std::vector<int16_t> values(num_values);
+    for (auto& value : values) {
+        value = dist(gen);
+    }
+    return values;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_sc16_codec_round_trip)
+{
+    for (const int16_t amplitude : {1, 7, 100, 2047, 16384, 32767}) {
+        BOOST_TEST_MESSAGE("Amplitude: " << amplitude);
+        round_trip(make_noise(10 * sc16_codec::GROUP_SIZE, amplitude));
+    }
+    // A partial last group, and less than one group
+    round_trip(make_noise(3 * sc16_codec::GROUP_SIZE + 5, 300));
+    round_trip(make_noise(3, 300));
+    BOOST_CHECK_EQUAL(round_trip({}), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_sc16_codec_sizes)
+{
+    constexpr size_t GROUP_SIZE = sc16_codec::GROUP_SIZE;
+    // A group of zeros is just its width byte
+    BOOST_CHECK_EQUAL(round_trip(std::vector<int16_t>(4 * GROUP_SIZE, 0)), 4);
+    // -1 takes one bit, full scale all 16 bits
+    BOOST_CHECK_EQUAL(
+        round_trip(std::vector<int16_t>(GROUP_SIZE, -1)), 1 + GROUP_SIZE / 8);
+    BOOST_CHECK_EQUAL(round_trip(std::vector<int16_t>(GROUP_SIZE, -32768)),
+        sc16_codec::get_max_encoded_size(GROUP_SIZE));
+    BOOST_CHECK_EQUAL(round_trip(std::vector<int16_t>(GROUP_SIZE, 32767)),
+        sc16_codec::get_max_encoded_size(GROUP_SIZE));
+    // 8-bit values in a 16-bit container compress to about half
+    const size_t num_values = 1000 * GROUP_SIZE;
+    const size_t size       = round_trip(make_noise(num_values, 127));
+    BOOST_CHECK_EQUAL(size, num_values + num_values / GROUP_SIZE);
+}
+
+BOOST_AUTO_TEST_CASE(test_sc16_codec_corrupt)
+{
+    const auto values = make_noise(2 * sc16_codec::GROUP_SIZE + 1, 1000);
+    std::vector<uint8_t> encoded(sc16_codec::get_max_encoded_size(values.size()));
+    const size_t size = sc16_codec::encode(values.data(), values.size(), encoded.data());
+    std::vector<int16_t> decoded(values.size());
+
+    for (const size_t truncated : {size_t(0), size_t(1), size - 1}) {
+        BOOST_CHECK_THROW(
+            sc16_codec::decode(encoded.data(), truncated, values.size(), decoded.data()),
+            uhd::value_error);
+    }
+    encoded[0] = 17;
+    BOOST_CHECK_THROW(
+        sc16_codec::decode(encoded.data(), size, values.size(), decoded.data()),
+        uhd::value_error);
+}
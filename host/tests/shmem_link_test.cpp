@@ -0,0 +1,121 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhdlib/transport/shmem_link.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <vector>
+
+using namespace uhd::transport;
+
+namespace {
+
+constexpr size_t NUM_FRAMES = 4;
+constexpr size_t FRAME_SIZE = 1000;
+
+link_params_t make_params()
+{
+    link_params_t params;
+    params.num_recv_frames = NUM_FRAMES;
+    params.num_send_frames = NUM_FRAMES;
+    params.recv_frame_size = FRAME_SIZE;
+    params.send_frame_size = FRAME_SIZE;
+    return params;
+}
+
+void send_frame(send_link_if* link, const uint32_t value, const size_t len)
+{
+    auto buff = link->get_send_buff(0);
+    BOOST_REQUIRE(buff);
+    uint32_t* data = static_cast<uint32_t*>(buff->data());
+    for (size_t i = 0; i < len / sizeof(uint32_t); i++) {
+        data[i] = value + uint32_t(i);
+    }
+    buff->set_packet_size(len);
+    link->release_send_buff(std::move(buff));
+}
+
+void check_frame(recv_link_if* link, const uint32_t value, const size_t len)
+{
+    auto buff = link->get_recv_buff(0);
+    BOOST_REQUIRE(buff);
+    BOOST_REQUIRE_EQUAL(buff->packet_size(), len);
+    const uint32_t* data = static_cast<uint32_t*>(buff->data());
+    for (size_t i = 0; i < len / sizeof(uint32_t); i++) {
+        BOOST_CHECK_EQUAL(data[i], value + uint32_t(i));
+    }
+    link->release_recv_buff(std::move(buff));
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_shmem_link_loopback)
+{
+    auto links = shmem_link::make_pair("loopback", make_params());
+    BOOST_CHECK_EQUAL(links.first->get_num_send_frames(), NUM_FRAMES);
+    BOOST_CHECK_EQUAL(links.second->get_num_recv_frames(), NUM_FRAMES);
+    BOOST_CHECK_EQUAL(links.second->get_recv_frame_size(), FRAME_SIZE);
+    BOOST_CHECK_EQUAL(
+        links.first->get_send_adapter_id(), links.second->get_recv_adapter_id());
+
+    send_frame(links.first.get(), 100, FRAME_SIZE);
+    send_frame(links.first.get(), 200, 8);
+    check_frame(links.second.get(), 100, FRAME_SIZE);
+    check_frame(links.second.get(), 200, 8);
+
+    send_frame(links.second.get(), 300, 64);
+    check_frame(links.first.get(), 300, 64);
+
+    // Nothing left in either direction
+    BOOST_CHECK(!links.first->get_recv_buff(0));
+    BOOST_CHECK(!links.second->get_recv_buff(0));
+    BOOST_CHECK(!links.second->get_recv_buff(10));
+}
+
+BOOST_AUTO_TEST_CASE(test_shmem_link_full_and_wraparound)
+{
+    auto links = shmem_link::make_pair("wraparound", make_params());
+
+    for (uint32_t round = 0; round < 3 * NUM_FRAMES; round++) {
+        // Fill the ring; the sender has to wait for frames to be released
+        for (size_t i = 0; i < NUM_FRAMES; i++) {
+            send_frame(links.first.get(), round * 1000 + uint32_t(i), 16);
+        }
+        auto buff = links.first->get_send_buff(10);
+        BOOST_CHECK(!buff);
+        for (size_t i = 0; i < NUM_FRAMES; i++) {
+            check_frame(links.second.get(), round * 1000 + uint32_t(i), 16);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_shmem_link_empty_frames)
+{
+    auto links = shmem_link::make_pair("empty", make_params());
+
+    // Frames released without data still take up a slot, and are skipped by
+    // the receiver
+    auto buff = links.first->get_send_buff(0);
+    BOOST_REQUIRE(buff);
+    buff->set_packet_size(0);
+    links.first->release_send_buff(std::move(buff));
+    send_frame(links.first.get(), 7, 32);
+
+    check_frame(links.second.get(), 7, 32);
+    BOOST_CHECK(!links.second->get_recv_buff(0));
+
+    // All slots are free again
+    for (size_t i = 0; i < NUM_FRAMES; i++) {
+        send_frame(links.first.get(), uint32_t(i), 4);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_shmem_link_attach_invalid)
+{
+    auto link = shmem_link::make("invalid", make_params());
+    BOOST_CHECK_THROW(shmem_link::attach("invalid", -1), uhd::os_error);
+}
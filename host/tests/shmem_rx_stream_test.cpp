@@ -0,0 +1,152 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/mock_rx_streamer.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/utils/shmem_rx_stream.hpp>
+#include <boost/test/unit_test.hpp>
+#include <unistd.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t SPP     = 16;
+constexpr double RATE    = 1e6;
+constexpr double TIMEOUT = 1.0;
+
+/*! Returns queued u8 packets on two channels, every item holds the index of
+ *  its packet plus the index of its channel
+ *
+ * Packets are timed, the first one starts at 0 s.
+ */
+std::shared_ptr<uhd::mock_rx_streamer> make_rx_streamer()
+{
+    uhd::mock_rx_streamer::stream_params params;
+    params.num_chans     = 2;
+    params.max_num_samps = SPP;
+    params.rate          = RATE;
+    return std::make_shared<uhd::mock_rx_streamer>(params);
+}
+
+//! Make a name that doesn't collide with parallel runs of the test
+std::string make_name(const std::string& name)
+{
+    return name + "-" + std::to_string(::getpid());
+}
+
+//! Wait until \p done returns true, for at most a second
+template <typename done_fn_t>
+bool wait_for(done_fn_t done)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_shmem_rx_attach)
+{
+    const std::string name = make_name("attach");
+    BOOST_CHECK_THROW(uhd::shmem_rx_streamer::make(name), uhd::io_error);
+
+    auto rx        = make_rx_streamer();
+    auto publisher = uhd::shmem_rx_publisher::make(rx, "u8", RATE, name);
+    BOOST_CHECK_EQUAL(publisher->get_name(), name);
+    BOOST_CHECK_THROW(
+        uhd::shmem_rx_publisher::make(rx, "u8", RATE, name), uhd::key_error);
+    BOOST_CHECK_THROW(uhd::shmem_rx_streamer::make(name, "fc32"), uhd::value_error);
+
+    auto client = uhd::shmem_rx_streamer::make(name, "u8");
+    BOOST_CHECK_EQUAL(client->get_num_channels(), 2);
+    BOOST_CHECK_EQUAL(client->get_max_num_samps(), SPP);
+
+    // Clients time out once the publisher is gone
+    publisher.reset();
+    std::vector<uint8_t> buff0(SPP), buff1(SPP);
+    std::vector<void*> buffs{buff0.data(), buff1.data()};
+    uhd::rx_metadata_t md;
+    BOOST_CHECK_EQUAL(client->recv(buffs, SPP, md, TIMEOUT), 0);
+    BOOST_CHECK_EQUAL(md.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+}
+
+BOOST_AUTO_TEST_CASE(test_shmem_rx_clients)
+{
+    auto rx        = make_rx_streamer();
+    auto publisher = uhd::shmem_rx_publisher::make(rx, "u8", RATE, make_name("clients"));
+    auto client0   = uhd::shmem_rx_streamer::make(publisher->get_name());
+    auto client1   = uhd::shmem_rx_streamer::make(publisher->get_name());
+
+    std::vector<uint8_t> buff0(SPP), buff1(SPP);
+    std::vector<void*> buffs{buff0.data(), buff1.data()};
+    uhd::rx_metadata_t md;
+    BOOST_CHECK_EQUAL(client0->recv(buffs, SPP, md, 0.0), 0);
+    BOOST_CHECK_EQUAL(md.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+
+    for (size_t i = 0; i < 3; i++) {
+        rx->push(SPP);
+    }
+    rx->push(uhd::mock_rx_streamer::overflow());
+    // Both clients get every packet
+    for (auto& client : {client0, client1}) {
+        for (uint8_t i = 0; i < 3; i++) {
+            BOOST_CHECK_EQUAL(client->recv(buffs, SPP, md, TIMEOUT), SPP);
+            BOOST_CHECK_EQUAL(md.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+            BOOST_CHECK_EQUAL(buff0[SPP - 1], i);
+            BOOST_CHECK_EQUAL(buff1[0], i + 1);
+            BOOST_CHECK(md.has_time_spec);
+            BOOST_CHECK_EQUAL(md.time_spec.to_ticks(RATE), i * SPP);
+        }
+        BOOST_CHECK_EQUAL(client->recv(buffs, SPP, md, TIMEOUT), 0);
+        BOOST_CHECK_EQUAL(md.error_code, uhd::rx_metadata_t::ERROR_CODE_OVERFLOW);
+    }
+    BOOST_CHECK_EQUAL(publisher->get_num_packets(), 3);
+
+    // Reading part of a packet
+    rx->push(SPP);
+    BOOST_CHECK_EQUAL(client0->recv(buffs, SPP / 4, md, TIMEOUT), SPP / 4);
+    BOOST_CHECK(md.more_fragments);
+    BOOST_CHECK_EQUAL(client0->recv(buffs, SPP, md, TIMEOUT), SPP * 3 / 4);
+    BOOST_CHECK(!md.more_fragments);
+    BOOST_CHECK_EQUAL(md.fragment_offset, SPP / 4);
+    BOOST_CHECK_EQUAL(md.time_spec.to_ticks(RATE), 3 * SPP + SPP / 4);
+    // Packet 3 was the overflow
+    BOOST_CHECK_EQUAL(buff0[0], 4);
+}
+
+BOOST_AUTO_TEST_CASE(test_shmem_rx_slow_client)
+{
+    constexpr size_t NUM_PACKETS = 4;
+    auto rx                      = make_rx_streamer();
+    auto publisher               = uhd::shmem_rx_publisher::make(
+        rx, "u8", RATE, make_name("slow"), NUM_PACKETS);
+    auto client = uhd::shmem_rx_streamer::make(publisher->get_name());
+
+    // The publisher doesn't wait for the client, which misses the packets
+    // that were overwritten
+    for (size_t i = 0; i < 2 * NUM_PACKETS; i++) {
+        rx->push(SPP);
+    }
+    BOOST_REQUIRE(wait_for([&]() { return publisher->get_num_packets() == 8; }));
+
+    std::vector<uint8_t> buff0(SPP), buff1(SPP);
+    std::vector<void*> buffs{buff0.data(), buff1.data()};
+    uhd::rx_metadata_t md;
+    BOOST_CHECK_EQUAL(client->recv(buffs, SPP, md, TIMEOUT), 0);
+    BOOST_CHECK_EQUAL(md.error_code, uhd::rx_metadata_t::ERROR_CODE_OVERFLOW);
+    // It continues with the next packet
+    rx->push(SPP);
+    BOOST_CHECK_EQUAL(client->recv(buffs, SPP, md, TIMEOUT), SPP);
+    BOOST_CHECK_EQUAL(md.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+    BOOST_CHECK_EQUAL(buff0[0], 2 * NUM_PACKETS);
+}
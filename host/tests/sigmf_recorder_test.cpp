@@ -0,0 +1,196 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/mock_rx_streamer.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/utils/paths.hpp>
+#include <uhd/utils/sigmf_recorder.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+namespace fs = boost::filesystem;
+namespace pt = boost::property_tree;
+
+namespace {
+
+constexpr size_t NUM_CHANS     = 2;
+constexpr double RATE          = 1e6;
+constexpr uint32_t CHAN_OFFSET = 1000000;
+constexpr uint32_t SPP         = 300;
+constexpr uint32_t GAP_START   = 2500;
+constexpr uint32_t GAP_SIZE    = 100;
+constexpr uint32_t NUM_SAMPS   = 5000;
+
+//! Device time of counter value \p counter
+uhd::time_spec_t get_time(const uint32_t counter)
+{
+    return uhd::time_spec_t(1.0) + uhd::time_spec_t::from_ticks(counter, RATE);
+}
+
+void fill_counter(
+    const uhd::rx_streamer::buffs_type& buffs, const size_t first_samp, const size_t nsamps)
+{
+    for (size_t chan = 0; chan < NUM_CHANS; chan++) {
+        uint32_t* buff = static_cast<uint32_t*>(buffs[chan]);
+        for (size_t i = 0; i < nsamps; i++) {
+            buff[i] = uint32_t(first_samp + i + chan * CHAN_OFFSET);
+        }
+    }
+}
+
+/*! Streams a counter (as 32-bit sc16 items), with an overrun in between
+ *
+ * The counter skips GAP_SIZE values at GAP_START, and stops at NUM_SAMPS
+ * samples. The device time is 1 s plus the counter value in microseconds.
+ */
+std::shared_ptr<uhd::mock_rx_streamer> make_rx_streamer()
+{
+    uhd::mock_rx_streamer::stream_params params;
+    params.num_chans     = NUM_CHANS;
+    params.max_num_samps = SPP;
+    params.rate          = RATE;
+    params.start_time    = get_time(0);
+    params.fill          = fill_counter;
+    std::vector<uhd::mock_rx_streamer::packet_t> packets;
+    for (uint32_t n = 0; n < GAP_START; n += SPP) {
+        packets.push_back({std::min(SPP, GAP_START - n)});
+    }
+    packets.push_back(uhd::mock_rx_streamer::overflow(GAP_SIZE));
+    for (uint32_t n = GAP_START; n < NUM_SAMPS; n += SPP) {
+        packets.push_back({std::min(SPP, NUM_SAMPS - n)});
+    }
+    return std::make_shared<uhd::mock_rx_streamer>(params, packets);
+}
+
+std::vector<pt::ptree> get_list(const pt::ptree& meta, const std::string& key)
+{
+    std::vector<pt::ptree> list;
+    for (const auto& entry : meta.get_child(key)) {
+        list.push_back(entry.second);
+    }
+    return list;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_sigmf_recorder_args)
+{
+    auto rx_stream = make_rx_streamer();
+    BOOST_CHECK_THROW(
+        uhd::sigmf_recorder::make(rx_stream, "sc12", {"a", "b"}, RATE), uhd::value_error);
+    BOOST_CHECK_THROW(
+        uhd::sigmf_recorder::make(rx_stream, "sc16", {"a", "b"}, 0), uhd::value_error);
+    BOOST_CHECK_THROW(
+        uhd::sigmf_recorder::make(rx_stream, "sc16", {"a"}, RATE), uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_sigmf_recorder)
+{
+    const fs::path tmp_dir = fs::path(uhd::get_tmp_path()) / "SIGMF_RECORDER_TEST";
+    fs::create_directory(tmp_dir);
+    const std::vector<std::string> paths{
+        (tmp_dir / "rec0").string(), (tmp_dir / "rec1").string()};
+
+    auto rx_stream = make_rx_streamer();
+    auto recorder  = uhd::sigmf_recorder::make(rx_stream,
+        "sc16",
+        paths,
+        RATE,
+        uhd::device_addr_t("block_size=4096,num_blocks=3,author=Test"));
+    recorder->set_frequency(1e9, 0);
+    // At counter value 4000, which is sample 3900 because of the gap
+    recorder->set_frequency(2e9, get_time(4000), 1);
+    BOOST_CHECK_THROW(recorder->set_frequency(1e9, NUM_CHANS), uhd::index_error);
+    recorder->start();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!rx_stream->is_drained() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    recorder->stop();
+    BOOST_CHECK(!recorder->is_running());
+    BOOST_CHECK_EQUAL(recorder->get_num_samps_recorded(), NUM_SAMPS);
+    BOOST_CHECK_EQUAL(recorder->get_num_overflows(), 1);
+
+    for (size_t chan = 0; chan < NUM_CHANS; chan++) {
+        const std::string data_path = paths[chan] + ".sigmf-data";
+        BOOST_REQUIRE_EQUAL(fs::file_size(data_path), NUM_SAMPS * 4);
+        std::vector<uint32_t> samps(NUM_SAMPS);
+        std::ifstream data(data_path, std::ios::binary);
+        data.read(reinterpret_cast<char*>(samps.data()), NUM_SAMPS * 4);
+        BOOST_REQUIRE(data);
+        for (uint32_t i = 0; i < NUM_SAMPS; i++) {
+            const uint32_t counter = (i < GAP_START) ? i : i + GAP_SIZE;
+            if (samps[i] != counter + chan * CHAN_OFFSET) {
+                BOOST_ERROR("Wrong sample " << i << " in channel " << chan);
+                break;
+            }
+        }
+
+        pt::ptree meta;
+        pt::read_json(paths[chan] + ".sigmf-meta", meta);
+        BOOST_CHECK_EQUAL(meta.get<std::string>("global.core:datatype"), "ci16_le");
+        BOOST_CHECK_EQUAL(meta.get<double>("global.core:sample_rate"), RATE);
+        BOOST_CHECK_EQUAL(meta.get<std::string>("global.core:author"), "Test");
+        BOOST_CHECK_EQUAL(meta.get<size_t>("global.uhd:channel"), chan);
+
+        // Captures: start, overrun, tune of channel 1
+        const auto captures = get_list(meta, "captures");
+        BOOST_REQUIRE_EQUAL(captures.size(), 3);
+        const std::vector<uint64_t> sample_starts{0, GAP_START, 3900};
+        const std::vector<uint32_t> counters{0, GAP_START + GAP_SIZE, 4000};
+        for (size_t i = 0; i < captures.size(); i++) {
+            BOOST_CHECK_EQUAL(
+                captures[i].get<uint64_t>("core:sample_start"), sample_starts[i]);
+            const uhd::time_spec_t time(captures[i].get<int64_t>("uhd:full_secs"),
+                captures[i].get<double>("uhd:frac_secs"));
+            BOOST_CHECK_SMALL((time - get_time(counters[i])).get_real_secs(), 1e-9);
+            const auto freq = captures[i].get_optional<double>("core:frequency");
+            if (chan == 0) {
+                BOOST_REQUIRE(freq);
+                BOOST_CHECK_EQUAL(*freq, 1e9);
+            } else if (i < 2) {
+                BOOST_CHECK(!freq);
+            } else {
+                BOOST_REQUIRE(freq);
+                BOOST_CHECK_EQUAL(*freq, 2e9);
+            }
+        }
+
+        const auto annotations = get_list(meta, "annotations");
+        BOOST_REQUIRE_EQUAL(annotations.size(), 1);
+        BOOST_CHECK_EQUAL(
+            annotations[0].get<uint64_t>("core:sample_start"), GAP_START);
+        BOOST_CHECK_EQUAL(annotations[0].get<std::string>("core:label"), "overflow");
+    }
+
+    const std::string index_path = paths[0] + ".uhd-tidx";
+    BOOST_CHECK_EQUAL(uhd::sigmf_recorder::find_sample(index_path, get_time(0)), 0);
+    BOOST_CHECK_EQUAL(
+        uhd::sigmf_recorder::find_sample(index_path, get_time(1500)), 1500);
+    // Within the gap, and right after it
+    BOOST_CHECK_EQUAL(
+        uhd::sigmf_recorder::find_sample(index_path, get_time(2550)), GAP_START);
+    BOOST_CHECK_EQUAL(uhd::sigmf_recorder::find_sample(
+                          index_path, get_time(GAP_START + GAP_SIZE)),
+        GAP_START);
+    BOOST_CHECK_EQUAL(
+        uhd::sigmf_recorder::find_sample(index_path, get_time(4321)), 4221);
+    BOOST_CHECK_THROW(
+        uhd::sigmf_recorder::find_sample(index_path, uhd::time_spec_t(0.5)),
+        uhd::value_error);
+    BOOST_CHECK_THROW(
+        uhd::sigmf_recorder::find_sample((tmp_dir / "none").string(), get_time(0)),
+        uhd::os_error);
+
+    fs::remove_all(tmp_dir);
+}
@@ -0,0 +1,67 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/utils/spsc_queue.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <thread>
+
+using namespace uhd;
+
+BOOST_AUTO_TEST_CASE(test_spsc_queue_fill_and_drain)
+{
+    constexpr size_t capacity = 5;
+    spsc_queue<size_t> queue(capacity);
+    size_t item = 0;
+
+    BOOST_CHECK_EQUAL(queue.capacity(), capacity);
+    BOOST_CHECK(!queue.pop(item));
+    BOOST_CHECK(!queue.peek(item));
+
+    // Wrap around the end of the buffer a few times
+    for (size_t round = 0; round < 3; round++) {
+        for (size_t i = 0; i < capacity; i++) {
+            BOOST_CHECK(queue.push(round * capacity + i));
+        }
+        BOOST_CHECK(!queue.push(0));
+        BOOST_CHECK_EQUAL(queue.read_available(), capacity);
+
+        for (size_t i = 0; i < capacity; i++) {
+            BOOST_CHECK(queue.peek(item));
+            BOOST_CHECK_EQUAL(item, round * capacity + i);
+            BOOST_CHECK(queue.pop(item));
+            BOOST_CHECK_EQUAL(item, round * capacity + i);
+        }
+        BOOST_CHECK_EQUAL(queue.read_available(), 0);
+        BOOST_CHECK(!queue.pop(item, 1));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_spsc_queue_threads)
+{
+    constexpr size_t num_items = 100000;
+    spsc_queue<size_t> queue(16);
+
+    std::thread producer([&queue]() {
+        for (size_t i = 0; i < num_items; i++) {
+            while (!queue.push(i)) {
+                std::this_thread::yield();
+            }
+            // Give the consumer the chance to go to sleep now and then
+            if (i % 10000 == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        }
+    });
+
+    size_t item = 0;
+    for (size_t i = 0; i < num_items; i++) {
+        BOOST_REQUIRE(queue.pop(item, 1000));
+        BOOST_REQUIRE_EQUAL(item, i);
+    }
+    producer.join();
+    BOOST_CHECK_EQUAL(queue.read_available(), 0);
+}
@@ -37,7 +37,7 @@ class mock_rx_data_xport
 public:
     using uptr = std::unique_ptr<mock_rx_data_xport>;
 
-    struct buff_t
+    struct buff_t : public uhd::transport::frame_buff
     {
         using uptr = std::unique_ptr<buff_t>;
         std::vector<uint8_t> data;
@@ -97,12 +97,16 @@ class mock_tx_data_xport
 public:
     using uptr = std::unique_ptr<mock_tx_data_xport>;
 
-    struct buff_t
+    struct buff_t : public uhd::transport::frame_buff
     {
         using uptr = std::unique_ptr<buff_t>;
-        std::vector<uint8_t> data;
 
-        void set_packet_size(const size_t) {}
+        buff_t(const size_t size) : storage(size)
+        {
+            _data = storage.data();
+        }
+
+        std::vector<uint8_t> storage;
     };
 
     struct packet_info_t
@@ -116,8 +120,7 @@ public:
 
     mock_tx_data_xport(const size_t buff_size) : _buff_size(buff_size)
     {
-        _buff = std::make_unique<buff_t>();
-        _buff->data.resize(buff_size);
+        _buff = std::make_unique<buff_t>(buff_size);
     }
 
     buff_t::uptr get_send_buff(const int32_t /*timeout_ms*/)
@@ -128,11 +131,16 @@ public:
     std::pair<void*, size_t> write_packet_header(
         buff_t::uptr& buff, const packet_info_t& info)
     {
-        uint8_t* data                             = buff->data.data();
+        uint8_t* data                             = buff->storage.data();
         *(reinterpret_cast<packet_info_t*>(data)) = info;
         return std::make_pair(data + sizeof(info), sizeof(info) + info.payload_bytes);
     }
 
+    size_t get_payload_offset(const bool /*has_tsf*/) const
+    {
+        return sizeof(packet_info_t);
+    }
+
     void release_send_buff(buff_t::uptr buff)
     {
         _buff = std::move(buff);
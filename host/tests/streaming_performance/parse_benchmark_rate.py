@@ -10,6 +10,7 @@ values printed at the end of execution.
 import collections
 import re
 import csv
+import json
 
 Results = collections.namedtuple(
     'Results',
@@ -118,6 +119,44 @@ def parse(result_str):
     else:
         return None
 
+def parse_time_series(series_str):
+    """
+    Parses the time series written by benchmark_rate with --stats_interval,
+    either as JSON lines or CSV. Returns a list with a dict per interval, which
+    maps the field names to numerical values. Lines that are not part of the
+    time series (e.g., the regular output on stdout) are skipped.
+    """
+    series = []
+    lines = series_str.splitlines()
+    csv_header = None
+    for line in lines:
+        line = line.strip()
+        if line.startswith("{"):
+            try:
+                series.append(json.loads(line))
+            except ValueError:
+                pass
+        elif line.startswith("time,"):
+            csv_header = line.split(",")
+        elif csv_header is not None and line:
+            values = line.split(",")
+            if len(values) == len(csv_header):
+                series.append(
+                    {key: float(val) for key, val in zip(csv_header, values)})
+    return series
+
+def find_rate_drops(series, expected_rate, tolerance=0.1):
+    """
+    Returns the intervals of a time series in which any channel streamed at
+    less than (1 - tolerance) times the expected rate, to correlate rate drops
+    with the error counts and streamer statistics of the same interval.
+    """
+    return [
+        interval for interval in series
+        if any(val < (1.0 - tolerance) * expected_rate
+               for key, val in interval.items() if "_sps_ch" in key)
+    ]
+
 def write_benchmark_rate_csv(results, file_name):
     with open(file_name, 'w', newline='') as f:
         w = csv.writer(f)
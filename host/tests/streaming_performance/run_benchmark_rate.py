@@ -8,6 +8,7 @@ example.
 """
 import argparse
 import subprocess
+import parse_benchmark_rate
 
 def run(path, params):
     """
@@ -21,6 +22,17 @@ def run(path, params):
 
     return subprocess.run(proc_params, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
 
+def get_time_series(proc, params):
+    """
+    Returns the time series of a benchmark rate run (see
+    parse_benchmark_rate.parse_time_series()), read from the stats file if one
+    was given, otherwise from the output.
+    """
+    if params.get("stats_file"):
+        with open(params["stats_file"]) as stats_file:
+            return parse_benchmark_rate.parse_time_series(stats_file.read())
+    return parse_benchmark_rate.parse_time_series(proc.stdout.decode('ASCII'))
+
 def create_parser():
     parser = argparse.ArgumentParser()
     parser.add_argument("--args", type=str, help="single uhd device address args")
@@ -40,6 +52,10 @@ def create_parser():
     parser.add_argument("--random", type=str, help="Run with random values of samples in send() and recv()")
     parser.add_argument("--rx_channels", type=str, help="which RX channel(s) to use")
     parser.add_argument("--tx_channels", type=str, help="which TX channel(s) to use")
+    parser.add_argument("--multi_streamer", type=str, help="none, shared or per_channel")
+    parser.add_argument("--stats_interval", type=str, help="time series interval in seconds")
+    parser.add_argument("--stats_file", type=str, help="file for the time series")
+    parser.add_argument("--stats_format", type=str, help="format of the time series (json, csv)")
     return parser
 
 def parse_args():
@@ -84,3 +100,8 @@ if __name__ == "__main__":
 
     print("STDOUT")
     print(proc.stdout.decode('ASCII'))
+
+    if "stats_interval" in benchmark_rate_params:
+        print("TIME SERIES")
+        for interval in get_time_series(proc, benchmark_rate_params):
+            print(interval)
@@ -0,0 +1,326 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/transport/frame_buff.hpp>
+#include <uhdlib/transport/striped_xport.hpp>
+#include <boost/test/unit_test.hpp>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace uhd::transport;
+
+namespace {
+
+class mock_frame_buff : public frame_buff
+{
+public:
+    mock_frame_buff()
+    {
+        _data = &_mem;
+    }
+
+private:
+    uint64_t _mem = 0;
+};
+
+/*!
+ * Lane that returns packets with the sequence numbers it was given
+ */
+class mock_rx_lane
+{
+public:
+    using uptr   = std::unique_ptr<mock_rx_lane>;
+    using buff_t = frame_buff;
+
+    struct packet_info_t
+    {
+        bool eob             = false;
+        bool eov             = false;
+        bool has_tsf         = false;
+        uint64_t tsf         = 0;
+        size_t payload_bytes = 0;
+        const void* payload  = nullptr;
+        uint16_t seq_num     = 0;
+    };
+
+    mock_rx_lane(const size_t max_payload_size) : _max_payload_size(max_payload_size) {}
+
+    size_t get_max_payload_size() const
+    {
+        return _max_payload_size;
+    }
+
+    void push_back_packet(const uint16_t seq_num)
+    {
+        _seq_nums.push_back(seq_num);
+    }
+
+    std::tuple<frame_buff::uptr, packet_info_t, bool> get_recv_buff(const int32_t)
+    {
+        if (_seq_nums.empty() || num_held > 0) {
+            return std::make_tuple(frame_buff::uptr(), packet_info_t(), false);
+        }
+        packet_info_t info;
+        info.seq_num = _seq_nums.front();
+        _seq_nums.pop_front();
+        num_held++;
+        // The lanes' own sequence checks fail when striping
+        return std::make_tuple(frame_buff::uptr(&_buff), info, true);
+    }
+
+    void release_recv_buff(frame_buff::uptr buff)
+    {
+        BOOST_CHECK_EQUAL(buff.release(), &_buff);
+        num_held--;
+        num_released++;
+    }
+
+    size_t num_held     = 0;
+    size_t num_released = 0;
+
+private:
+    const size_t _max_payload_size;
+    std::deque<uint16_t> _seq_nums;
+    mock_frame_buff _buff;
+};
+
+/*!
+ * Lane that records the sequence numbers of the packets sent through it
+ */
+class mock_tx_lane
+{
+public:
+    using uptr   = std::unique_ptr<mock_tx_lane>;
+    using buff_t = frame_buff;
+
+    struct packet_info_t
+    {
+        bool eob             = false;
+        bool eov             = false;
+        bool has_tsf         = false;
+        uint64_t tsf         = 0;
+        size_t payload_bytes = 0;
+    };
+
+    mock_tx_lane(const size_t max_payload_size) : _max_payload_size(max_payload_size) {}
+
+    size_t get_max_payload_size() const
+    {
+        return _max_payload_size;
+    }
+
+    size_t get_payload_offset(const bool has_tsf) const
+    {
+        return has_tsf ? 16 : 8;
+    }
+
+    frame_buff::uptr get_send_buff(const int32_t)
+    {
+        if (credits == 0) {
+            return frame_buff::uptr();
+        }
+        credits--;
+        return frame_buff::uptr(&_buff);
+    }
+
+    void set_next_seq_num(const uint16_t seq_num)
+    {
+        _seq_num = seq_num;
+    }
+
+    std::pair<void*, size_t> write_packet_header(
+        frame_buff::uptr& buff, const packet_info_t& info)
+    {
+        _written_seq_num = _seq_num++;
+        return std::make_pair(buff->data(), info.payload_bytes + 8);
+    }
+
+    void release_send_buff(frame_buff::uptr buff)
+    {
+        BOOST_CHECK_EQUAL(buff.release(), &_buff);
+        sent_seq_nums.push_back(_written_seq_num);
+    }
+
+    size_t credits = 1000;
+    std::vector<uint16_t> sent_seq_nums;
+
+private:
+    const size_t _max_payload_size;
+    uint16_t _seq_num         = 0;
+    uint16_t _written_seq_num = 0;
+    mock_frame_buff _buff;
+};
+
+struct rx_fixture
+{
+    rx_fixture(const size_t num_lanes)
+    {
+        std::vector<mock_rx_lane::uptr> lanes;
+        for (size_t i = 0; i < num_lanes; i++) {
+            lanes.emplace_back(new mock_rx_lane(1000 - i));
+            lane_ptrs.push_back(lanes.back().get());
+        }
+        xport.reset(new striped_rx_xport<mock_rx_lane>(std::move(lanes)));
+    }
+
+    //! Receives a packet, checks its sequence number, and releases it
+    void check_recv(const uint16_t seq_num, const bool seq_error)
+    {
+        frame_buff::uptr buff;
+        mock_rx_lane::packet_info_t info;
+        bool got_seq_error;
+        std::tie(buff, info, got_seq_error) = xport->get_recv_buff(0);
+        BOOST_REQUIRE(buff);
+        BOOST_CHECK_EQUAL(info.seq_num, seq_num);
+        BOOST_CHECK_EQUAL(got_seq_error, seq_error);
+        xport->release_recv_buff(std::move(buff));
+    }
+
+    void check_timeout()
+    {
+        BOOST_CHECK(!std::get<0>(xport->get_recv_buff(0)));
+    }
+
+    std::vector<mock_rx_lane*> lane_ptrs;
+    striped_rx_xport<mock_rx_lane>::uptr xport;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_striped_rx_in_order)
+{
+    rx_fixture fixture(2);
+    BOOST_CHECK_EQUAL(fixture.xport->get_num_lanes(), 2);
+    BOOST_CHECK_EQUAL(fixture.xport->get_max_payload_size(), 999);
+
+    // The first lane lags behind, the packets still come out in order
+    for (uint16_t seq_num = 1; seq_num < 10; seq_num += 2) {
+        fixture.lane_ptrs[1]->push_back_packet(seq_num);
+    }
+    for (uint16_t seq_num = 0; seq_num < 10; seq_num += 2) {
+        fixture.lane_ptrs[0]->push_back_packet(seq_num);
+    }
+    for (uint16_t seq_num = 0; seq_num < 10; seq_num++) {
+        fixture.check_recv(seq_num, false);
+    }
+    fixture.check_timeout();
+    BOOST_CHECK_EQUAL(fixture.lane_ptrs[0]->num_released, 5);
+    BOOST_CHECK_EQUAL(fixture.lane_ptrs[1]->num_released, 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_striped_rx_waits_for_lane)
+{
+    rx_fixture fixture(2);
+    fixture.lane_ptrs[1]->push_back_packet(1);
+    fixture.lane_ptrs[1]->push_back_packet(3);
+
+    // Packet 0 has not arrived yet on the first lane
+    fixture.check_timeout();
+    fixture.lane_ptrs[0]->push_back_packet(0);
+    fixture.check_recv(0, false);
+    fixture.check_recv(1, false);
+    fixture.check_timeout();
+    fixture.lane_ptrs[0]->push_back_packet(2);
+    fixture.check_recv(2, false);
+    fixture.check_recv(3, false);
+}
+
+BOOST_AUTO_TEST_CASE(test_striped_rx_lost_packet)
+{
+    rx_fixture fixture(2);
+    // Packet 2 is lost on the first lane
+    for (const uint16_t seq_num : {0, 1, 3, 4, 5, 6, 7}) {
+        fixture.lane_ptrs[seq_num % 2]->push_back_packet(seq_num);
+    }
+
+    fixture.check_recv(0, false);
+    fixture.check_recv(1, false);
+    fixture.check_recv(3, true);
+    for (uint16_t seq_num = 4; seq_num < 8; seq_num++) {
+        fixture.check_recv(seq_num, false);
+    }
+    fixture.check_timeout();
+}
+
+BOOST_AUTO_TEST_CASE(test_striped_rx_resync)
+{
+    rx_fixture fixture(2);
+    // The stream starts with packets the transport doesn't expect
+    for (uint16_t seq_num = 100; seq_num < 106; seq_num++) {
+        fixture.lane_ptrs[seq_num % 2]->push_back_packet(seq_num);
+    }
+
+    fixture.check_recv(100, true);
+    for (uint16_t seq_num = 101; seq_num < 106; seq_num++) {
+        fixture.check_recv(seq_num, false);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_striped_rx_seq_num_wraparound)
+{
+    rx_fixture fixture(2);
+    fixture.lane_ptrs[0]->push_back_packet(0);
+    fixture.check_recv(0, false);
+
+    // Skip ahead to just before the wraparound
+    for (size_t i = 0; i < 5; i++) {
+        const uint16_t seq_num = uint16_t(0xfffd + i);
+        fixture.lane_ptrs[(1 + i) % 2]->push_back_packet(seq_num);
+    }
+    fixture.check_recv(0xfffd, true);
+    for (const uint16_t seq_num : {0xfffe, 0xffff, 0x0000, 0x0001}) {
+        fixture.check_recv(seq_num, false);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_striped_rx_no_lanes)
+{
+    BOOST_CHECK_THROW(striped_rx_xport<mock_rx_lane>(std::vector<mock_rx_lane::uptr>()),
+        uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_striped_tx)
+{
+    constexpr size_t NUM_LANES   = 3;
+    constexpr size_t NUM_PACKETS = 10;
+
+    std::vector<mock_tx_lane::uptr> lanes;
+    std::vector<mock_tx_lane*> lane_ptrs;
+    for (size_t i = 0; i < NUM_LANES; i++) {
+        lanes.emplace_back(new mock_tx_lane(2000 + i));
+        lane_ptrs.push_back(lanes.back().get());
+    }
+    striped_tx_xport<mock_tx_lane> xport(std::move(lanes));
+    BOOST_CHECK_EQUAL(xport.get_max_payload_size(), 2000);
+    BOOST_CHECK_EQUAL(xport.get_payload_offset(true), 16);
+
+    for (size_t i = 0; i < NUM_PACKETS; i++) {
+        auto buff = xport.get_send_buff(0);
+        BOOST_REQUIRE(buff);
+        mock_tx_lane::packet_info_t info;
+        info.payload_bytes = 100;
+        BOOST_CHECK_EQUAL(xport.write_packet_header(buff, info).second, 108);
+        xport.release_send_buff(std::move(buff));
+    }
+
+    for (size_t lane = 0; lane < NUM_LANES; lane++) {
+        std::cout << "lane check " << lane << std::endl;
+        const auto& seq_nums = lane_ptrs[lane]->sent_seq_nums;
+        BOOST_CHECK_EQUAL(
+            seq_nums.size(), (NUM_PACKETS - lane + NUM_LANES - 1) / NUM_LANES);
+        for (size_t i = 0; i < seq_nums.size(); i++) {
+            BOOST_CHECK_EQUAL(seq_nums[i], lane + i * NUM_LANES);
+        }
+    }
+
+    // A lane without credits holds back the stream, the other lanes don't
+    // jump ahead
+    lane_ptrs[NUM_PACKETS % NUM_LANES]->credits = 0;
+    BOOST_CHECK(!xport.get_send_buff(0));
+    BOOST_CHECK(!xport.get_send_buff(0));
+}
@@ -5,8 +5,13 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include <uhd/exception.hpp>
+#include <uhd/utils/msg_task.hpp>
 #include <uhd/utils/tasks.hpp>
+#include <uhdlib/utils/periodic_task.hpp>
 #include <boost/test/unit_test.hpp>
+#include <boost/thread/thread.hpp>
+#include <atomic>
 #include <chrono>
 #include <iostream>
 #include <thread>
@@ -26,3 +31,72 @@ BOOST_AUTO_TEST_CASE(tasks_test)
         test_vec.push_back(uhd::task::make([i]() { test_tasks_sleep(i); }));
     }
 }
+
+BOOST_AUTO_TEST_CASE(periodic_task_test)
+{
+    std::atomic<size_t> num_calls{0};
+    const auto start = std::chrono::steady_clock::now();
+    {
+        auto task = uhd::make_periodic_task(
+            [&num_calls]() { num_calls++; }, std::chrono::milliseconds(20));
+        std::this_thread::sleep_for(std::chrono::milliseconds(110));
+    }
+    // Destroying the task doesn't wait for the period to end
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    BOOST_CHECK(elapsed < std::chrono::milliseconds(500));
+    // The first call comes right away, then one every 20 ms
+    BOOST_CHECK_GE(num_calls.load(), 3);
+    BOOST_CHECK_LE(num_calls.load(), 7);
+
+    // The task is not called after it's destroyed
+    const size_t final_calls = num_calls;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    BOOST_CHECK_EQUAL(num_calls.load(), final_calls);
+}
+
+BOOST_AUTO_TEST_CASE(periodic_task_throw_test)
+{
+    // A task that throws is not called again
+    std::atomic<size_t> num_calls{0};
+    auto task = uhd::make_periodic_task(
+        [&num_calls]() {
+            num_calls++;
+            throw uhd::runtime_error("periodic_task_throw_test");
+        },
+        std::chrono::milliseconds(5));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    BOOST_CHECK_EQUAL(num_calls.load(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(msg_task_test)
+{
+    // The destructor interrupts a task function that is blocked in boost
+    std::atomic<size_t> num_calls{0};
+    auto task = uhd::msg_task::make([&num_calls]() {
+        if (num_calls++ == 0) {
+            return boost::optional<uhd::msg_task::msg_type_t>(
+                std::make_pair(uint32_t(42), uhd::msg_task::msg_payload_t(4, 0xAB)));
+        }
+        boost::this_thread::sleep_for(boost::chrono::seconds(10));
+        return boost::optional<uhd::msg_task::msg_type_t>();
+    });
+    while (num_calls < 2) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_CHECK(task->get_msg_from_dump_queue(41).empty());
+    BOOST_CHECK_EQUAL(task->get_msg_from_dump_queue(42).size(), 4);
+
+    const auto start = std::chrono::steady_clock::now();
+    task.reset();
+    BOOST_CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+
+    // The interrupt doesn't hit the next task that runs on the same thread
+    std::atomic<bool> slept{false};
+    auto next_task = uhd::task::make([&slept]() {
+        boost::this_thread::sleep_for(boost::chrono::milliseconds(1));
+        slept = true;
+    });
+    while (!slept) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
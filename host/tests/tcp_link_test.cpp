@@ -0,0 +1,217 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/rfnoc/chdr_types.hpp>
+#include <uhdlib/transport/tcp_link.hpp>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace uhd::transport;
+
+namespace {
+
+constexpr size_t NUM_FRAMES = 4;
+constexpr size_t FRAME_SIZE = 1000;
+
+link_params_t make_params()
+{
+    link_params_t params;
+    params.num_recv_frames = NUM_FRAMES;
+    params.num_send_frames = NUM_FRAMES;
+    params.recv_frame_size = FRAME_SIZE;
+    params.send_frame_size = FRAME_SIZE;
+    params.recv_buff_size  = 0;
+    params.send_buff_size  = 0;
+    return params;
+}
+
+//! Make a CHDR packet of len bytes, with the payload words counting up from value
+std::vector<uint8_t> make_packet(const uint32_t value, const size_t len)
+{
+    std::vector<uint8_t> packet(len, 0);
+    uhd::rfnoc::chdr::chdr_header header;
+    header.set_length(uint16_t(len));
+    const uint64_t flat_hdr = header.pack();
+    std::memcpy(packet.data(), &flat_hdr, sizeof(flat_hdr));
+    for (size_t i = 8; i + sizeof(uint32_t) <= len; i += sizeof(uint32_t)) {
+        const uint32_t word = value + uint32_t(i);
+        std::memcpy(&packet[i], &word, sizeof(word));
+    }
+    return packet;
+}
+
+//! The other end of the connection
+class tcp_peer
+{
+public:
+    tcp_peer()
+    {
+        _listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        BOOST_REQUIRE(_listen_fd >= 0);
+        struct sockaddr_in sa;
+        std::memset(&sa, 0, sizeof(sa));
+        sa.sin_family      = AF_INET;
+        sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        BOOST_REQUIRE(
+            ::bind(_listen_fd, reinterpret_cast<struct sockaddr*>(&sa), sizeof(sa)) == 0);
+        BOOST_REQUIRE(::listen(_listen_fd, 1) == 0);
+        socklen_t sa_len = sizeof(sa);
+        ::getsockname(_listen_fd, reinterpret_cast<struct sockaddr*>(&sa), &sa_len);
+        _port = ntohs(sa.sin_port);
+    }
+
+    ~tcp_peer()
+    {
+        if (_fd >= 0) {
+            ::close(_fd);
+        }
+        ::close(_listen_fd);
+    }
+
+    //! Make a link to this peer, and accept its connection
+    tcp_link::sptr connect(const link_params_t& params,
+        const uhd::device_addr_t& link_args = uhd::device_addr_t())
+    {
+        auto link = tcp_link::make("127.0.0.1",
+            std::to_string(_port),
+            params,
+            uhd::ENDIANNESS_LITTLE,
+            link_args);
+        _fd = ::accept(_listen_fd, nullptr, nullptr);
+        BOOST_REQUIRE(_fd >= 0);
+        return link;
+    }
+
+    void write(const std::vector<uint8_t>& data)
+    {
+        BOOST_REQUIRE_EQUAL(
+            ::send(_fd, data.data(), data.size(), 0), ssize_t(data.size()));
+    }
+
+    std::vector<uint8_t> read(const size_t len)
+    {
+        std::vector<uint8_t> data(len);
+        size_t num_read = 0;
+        while (num_read < len) {
+            const ssize_t ret = ::recv(_fd, &data[num_read], len - num_read, 0);
+            BOOST_REQUIRE(ret > 0);
+            num_read += size_t(ret);
+        }
+        return data;
+    }
+
+private:
+    int _listen_fd = -1;
+    int _fd        = -1;
+    uint16_t _port = 0;
+};
+
+void check_frame(
+    const frame_buff::uptr& buff, const uint32_t value, const size_t len)
+{
+    BOOST_REQUIRE(buff);
+    BOOST_REQUIRE_EQUAL(buff->packet_size(), len);
+    const std::vector<uint8_t> expected = make_packet(value, len);
+    BOOST_CHECK(std::memcmp(buff->data(), expected.data(), len) == 0);
+}
+
+void send_frame(send_link_if* link, const uint32_t value, const size_t len)
+{
+    auto buff = link->get_send_buff(1000);
+    BOOST_REQUIRE(buff);
+    const std::vector<uint8_t> packet = make_packet(value, len);
+    std::memcpy(buff->data(), packet.data(), len);
+    buff->set_packet_size(len);
+    link->release_send_buff(std::move(buff));
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_tcp_link_coalesced_recv)
+{
+    tcp_peer peer;
+    auto link = peer.connect(make_params());
+    BOOST_CHECK(!link->get_recv_buff(0));
+
+    // Several packets in one write come out as separate frames, straight out
+    // of the receive ring
+    std::vector<uint8_t> data;
+    for (size_t i = 0; i < 3; i++) {
+        const auto packet = make_packet(uint32_t(i * 100), 16 + i * 8);
+        data.insert(data.end(), packet.begin(), packet.end());
+    }
+    peer.write(data);
+
+    auto buff0 = link->get_recv_buff(1000);
+    auto buff1 = link->get_recv_buff(1000);
+    auto buff2 = link->get_recv_buff(1000);
+    check_frame(buff0, 0, 16);
+    check_frame(buff1, 100, 24);
+    check_frame(buff2, 200, 32);
+    BOOST_CHECK(static_cast<uint8_t*>(buff1->data())
+                == static_cast<uint8_t*>(buff0->data()) + 16);
+    BOOST_CHECK(static_cast<uint8_t*>(buff2->data())
+                == static_cast<uint8_t*>(buff1->data()) + 24);
+    // Out-of-order releases are fine
+    link->release_recv_buff(std::move(buff1));
+    link->release_recv_buff(std::move(buff2));
+    link->release_recv_buff(std::move(buff0));
+    BOOST_CHECK(!link->get_recv_buff(0));
+}
+
+BOOST_AUTO_TEST_CASE(test_tcp_link_split_recv)
+{
+    tcp_peer peer;
+    auto link = peer.connect(make_params());
+
+    // A packet may be split across reads, and packets keep coming in across
+    // the end of the ring
+    const size_t len = 808;
+    for (size_t i = 0; i < 64; i++) {
+        const auto packet = make_packet(uint32_t(i), len);
+        peer.write(std::vector<uint8_t>(packet.begin(), packet.begin() + 100));
+        BOOST_CHECK(!link->get_recv_buff(0));
+        peer.write(std::vector<uint8_t>(packet.begin() + 100, packet.end()));
+        auto buff = link->get_recv_buff(1000);
+        check_frame(buff, uint32_t(i), len);
+        link->release_recv_buff(std::move(buff));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_tcp_link_bad_length)
+{
+    tcp_peer peer;
+    auto link = peer.connect(make_params());
+
+    peer.write(make_packet(0, FRAME_SIZE + 8));
+    BOOST_CHECK_THROW(link->get_recv_buff(1000), uhd::io_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_tcp_link_send)
+{
+    for (const bool zerocopy : {false, true}) {
+        tcp_peer peer;
+        uhd::device_addr_t link_args;
+        if (zerocopy) {
+            link_args["tcp_zerocopy"] = "1";
+        }
+        auto link = peer.connect(make_params(), link_args);
+
+        // More frames than there are send frames, so the slots get reused
+        for (size_t i = 0; i < 8 * NUM_FRAMES; i++) {
+            const size_t len = 16 + 8 * (i % 100);
+            send_frame(link.get(), uint32_t(i), len);
+            BOOST_CHECK(peer.read(len) == make_packet(uint32_t(i), len));
+        }
+    }
+}
@@ -0,0 +1,76 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhdlib/rfnoc/time_correlator.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+
+using uhd::rfnoc::detail::time_correlator;
+using clock_t_ = time_correlator::clock_t;
+
+namespace {
+
+clock_t_::duration usecs(const double us)
+{
+    return std::chrono::duration_cast<clock_t_::duration>(
+        std::chrono::duration<double, std::micro>(us));
+}
+
+double secs(const clock_t_::duration duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_time_correlator_drift)
+{
+    time_correlator corr;
+    BOOST_CHECK(!corr.is_valid());
+    BOOST_CHECK_THROW(corr.to_device_time(clock_t_::now()), uhd::runtime_error);
+
+    // The device clock runs 10 ppm fast, and its time starts at 100 s. Reads
+    // take 100 us, except for every fourth, which takes 5 ms and is off.
+    constexpr double DRIFT = 10e-6;
+    const clock_t_::time_point t0 = clock_t_::now();
+    auto device_time = [&](const clock_t_::time_point t) {
+        return uhd::time_spec_t(100.0) + uhd::time_spec_t(secs(t - t0) * (1 + DRIFT));
+    };
+    for (size_t i = 0; i < 32; i++) {
+        const auto before = t0 + usecs(i * 100e3);
+        const auto rtt    = usecs(i % 4 == 3 ? 5000 : 100);
+        const auto read   = (i % 4 == 3) ? before + rtt / 10 : before + rtt / 2;
+        corr.add_sample(before, before + rtt, device_time(read));
+    }
+    BOOST_REQUIRE(corr.is_valid());
+    BOOST_CHECK_CLOSE(corr.get_drift(), DRIFT, 1.0);
+    const auto t = t0 + usecs(5e6);
+    BOOST_CHECK_SMALL((corr.to_device_time(t) - device_time(t)).get_real_secs(), 1e-7);
+    BOOST_CHECK_SMALL(secs(corr.to_host_time(device_time(t)) - t), 1e-7);
+
+    corr.reset();
+    BOOST_CHECK(!corr.is_valid());
+    BOOST_CHECK_EQUAL(corr.get_drift(), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(test_time_correlator_jump)
+{
+    time_correlator corr;
+    const clock_t_::time_point t0 = clock_t_::now();
+    for (size_t i = 0; i < 4; i++) {
+        const auto t = t0 + usecs(i * 1000);
+        corr.add_sample(t, t, uhd::time_spec_t(secs(t - t0)));
+    }
+    BOOST_CHECK_SMALL(corr.to_device_time(t0 + usecs(10e3)).get_real_secs() - 0.01, 1e-9);
+
+    // The device time was set to 0 at the next PPS edge. This sample doesn't
+    // fit the estimate, so the correlator starts over instead of averaging.
+    const auto t = t0 + usecs(1e6);
+    corr.add_sample(t, t, uhd::time_spec_t(0.0));
+    BOOST_CHECK_SMALL(corr.to_device_time(t).get_real_secs(), 1e-9);
+    BOOST_CHECK_SMALL(corr.to_device_time(t + usecs(1e3)).get_real_secs() - 1e-3, 1e-9);
+}
@@ -0,0 +1,82 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/utils/trace.hpp>
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace uhd;
+
+namespace {
+
+size_t count_occurrences(const std::string& str, const std::string& substr)
+{
+    size_t count = 0;
+    for (size_t pos = str.find(substr); pos != std::string::npos;
+         pos        = str.find(substr, pos + 1)) {
+        count++;
+    }
+    return count;
+}
+
+std::string get_trace()
+{
+    std::stringstream ss;
+    trace::dump(ss);
+    return ss.str();
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_trace_disabled)
+{
+    trace::set_enabled(false);
+    trace::clear();
+    UHD_TRACE(RX_PACKET, 1, 100);
+    BOOST_CHECK(!trace::is_enabled());
+    BOOST_CHECK_EQUAL(count_occurrences(get_trace(), "\"rx_packet\""), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_trace_events)
+{
+    trace::set_enabled(true);
+    trace::clear();
+    UHD_TRACE(RX_PACKET, 7, 1024);
+    UHD_TRACE(CONVERT_BEGIN, 256);
+    UHD_TRACE(CONVERT_END);
+    std::thread([]() { UHD_TRACE(ASYNC_MSG, 4); }).join();
+    trace::set_enabled(false);
+
+    const std::string trace = get_trace();
+    BOOST_CHECK_EQUAL(trace.substr(0, 2), "{\"");
+    BOOST_CHECK_EQUAL(count_occurrences(trace, "\"args\":{\"seq\":7,\"bytes\":1024}"), 1);
+    BOOST_CHECK_EQUAL(count_occurrences(trace, "\"args\":{\"nsamps\":256}"), 1);
+    BOOST_CHECK_EQUAL(count_occurrences(trace, "\"ph\":\"B\""), 1);
+    BOOST_CHECK_EQUAL(count_occurrences(trace, "\"ph\":\"E\""), 1);
+    // The event of the other thread is kept after the thread exited
+    BOOST_CHECK_EQUAL(count_occurrences(trace, "\"args\":{\"event_code\":4}"), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_trace_keeps_newest)
+{
+    trace::set_enabled(true);
+    trace::clear();
+    std::thread([]() {
+        for (size_t i = 0; i < 100000; i++) {
+            UHD_TRACE(TX_PACKET, i, 0);
+        }
+    }).join();
+    trace::set_enabled(false);
+
+    const std::string trace = get_trace();
+    const size_t num_packets = count_occurrences(trace, "\"tx_packet\"");
+    BOOST_CHECK_GT(num_packets, 0);
+    BOOST_CHECK_LT(num_packets, 100000);
+    BOOST_CHECK_EQUAL(count_occurrences(trace, "\"seq\":99999,"), 1);
+    BOOST_CHECK_EQUAL(count_occurrences(trace, "\"seq\":0,"), 0);
+}
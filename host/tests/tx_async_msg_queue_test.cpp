@@ -0,0 +1,127 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/rfnoc/tx_async_msg_queue.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace uhd;
+using namespace uhd::rfnoc;
+
+namespace {
+
+async_metadata_t make_msg(const size_t channel, const uint64_t tick)
+{
+    async_metadata_t md;
+    md.channel       = channel;
+    md.event_code    = async_metadata_t::EVENT_CODE_BURST_ACK;
+    md.has_time_spec = true;
+    md.time_spec     = time_spec_t::from_ticks(tick, 1e6);
+    return md;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_fifo_order)
+{
+    tx_async_msg_queue queue(4);
+    async_metadata_t md;
+    BOOST_CHECK(!queue.recv_async_msg(md, 0));
+
+    for (size_t i = 0; i < 4; i++) {
+        queue.enqueue(make_msg(i, i));
+    }
+    // The queue is full, so this is dropped
+    queue.enqueue(make_msg(4, 4));
+    BOOST_CHECK_EQUAL(queue.get_num_dropped(), 1);
+
+    for (size_t i = 0; i < 4; i++) {
+        BOOST_REQUIRE(queue.recv_async_msg(md, 0));
+        BOOST_CHECK_EQUAL(md.channel, i);
+    }
+    BOOST_CHECK(!queue.recv_async_msg(md, 0));
+
+    // There is room again after popping
+    queue.enqueue(make_msg(5, 5));
+    BOOST_REQUIRE(queue.recv_async_msg(md, 0));
+    BOOST_CHECK_EQUAL(md.channel, 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_blocking_wait)
+{
+    using namespace std::chrono;
+    tx_async_msg_queue queue(16);
+    async_metadata_t md;
+
+    auto start = steady_clock::now();
+    BOOST_CHECK(!queue.recv_async_msg(md, 20));
+    BOOST_CHECK(steady_clock::now() - start >= milliseconds(20));
+
+    // A message that arrives while waiting ends the wait
+    std::thread producer([&queue]() {
+        std::this_thread::sleep_for(milliseconds(10));
+        queue.enqueue(make_msg(1, 1));
+    });
+    start = steady_clock::now();
+    BOOST_CHECK(queue.recv_async_msg(md, 5000));
+    BOOST_CHECK(steady_clock::now() - start < milliseconds(2500));
+    BOOST_CHECK_EQUAL(md.channel, 1);
+    producer.join();
+}
+
+BOOST_AUTO_TEST_CASE(test_multiple_producers)
+{
+    constexpr size_t NUM_PRODUCERS = 4;
+    constexpr size_t NUM_MSGS      = 1000;
+    tx_async_msg_queue queue(NUM_PRODUCERS * NUM_MSGS);
+
+    std::vector<std::thread> producers;
+    for (size_t chan = 0; chan < NUM_PRODUCERS; chan++) {
+        producers.emplace_back([&queue, chan]() {
+            for (size_t i = 0; i < NUM_MSGS; i++) {
+                queue.enqueue(make_msg(chan, i));
+            }
+        });
+    }
+
+    // Messages of each producer arrive in order
+    std::vector<uint64_t> next_tick(NUM_PRODUCERS, 0);
+    async_metadata_t md;
+    for (size_t i = 0; i < NUM_PRODUCERS * NUM_MSGS; i++) {
+        BOOST_REQUIRE(queue.recv_async_msg(md, 1000));
+        BOOST_REQUIRE_LT(md.channel, NUM_PRODUCERS);
+        BOOST_CHECK_EQUAL(md.time_spec.to_ticks(1e6), next_tick[md.channel]);
+        next_tick[md.channel]++;
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    BOOST_CHECK(!queue.recv_async_msg(md, 0));
+    BOOST_CHECK_EQUAL(queue.get_num_dropped(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_callback)
+{
+    tx_async_msg_queue queue(16);
+    std::vector<size_t> channels;
+    queue.set_callback(
+        [&channels](const async_metadata_t& md) { channels.push_back(md.channel); });
+
+    queue.enqueue(make_msg(3, 0));
+    BOOST_REQUIRE_EQUAL(channels.size(), 1);
+    BOOST_CHECK_EQUAL(channels[0], 3);
+    async_metadata_t md;
+    BOOST_CHECK(!queue.recv_async_msg(md, 0));
+
+    // Without a callback, messages are queued again
+    queue.set_callback(nullptr);
+    queue.enqueue(make_msg(4, 0));
+    BOOST_CHECK_EQUAL(channels.size(), 1);
+    BOOST_REQUIRE(queue.recv_async_msg(md, 0));
+    BOOST_CHECK_EQUAL(md.channel, 4);
+}
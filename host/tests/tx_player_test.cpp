@@ -0,0 +1,142 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/mock_tx_streamer.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/utils/paths.hpp>
+#include <uhd/utils/tx_player.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <complex>
+#include <fstream>
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+constexpr size_t NUM_CHANS = 2;
+constexpr size_t SPP       = 100;
+constexpr size_t NUM_SAMPS = 1050;
+
+uhd::mock_tx_streamer::sptr make_tx_streamer()
+{
+    uhd::mock_tx_streamer::stream_params params;
+    params.num_chans     = NUM_CHANS;
+    params.max_num_samps = SPP;
+    return std::make_shared<uhd::mock_tx_streamer>(params);
+}
+
+//! Creates one sc16 file per channel, holding a ramp
+class player_fixture
+{
+public:
+    player_fixture() : tmp_dir(fs::path(uhd::get_tmp_path()) / "TX_PLAYER_TEST")
+    {
+        fs::create_directory(tmp_dir);
+        for (size_t chan = 0; chan < NUM_CHANS; chan++) {
+            const std::string name = "play" + std::to_string(chan) + ".dat";
+            paths.push_back((tmp_dir / name).string());
+            std::ofstream file(paths.back(), std::ios::binary);
+            for (size_t i = 0; i < NUM_SAMPS; i++) {
+                const int16_t samp[2] = {
+                    static_cast<int16_t>(i + chan * 10000), static_cast<int16_t>(-1)};
+                file.write(reinterpret_cast<const char*>(samp), sizeof(samp));
+            }
+        }
+    }
+
+    ~player_fixture()
+    {
+        fs::remove_all(tmp_dir);
+    }
+
+    void check_samples(const size_t first, const size_t num_samps)
+    {
+        for (size_t chan = 0; chan < NUM_CHANS; chan++) {
+            const auto samples = tx_stream->get_samples(chan);
+            for (size_t i = first; i < first + num_samps; i++) {
+                const auto samp = samples.at(i);
+                const float expected =
+                    static_cast<float>((i % NUM_SAMPS) + chan * 10000) / 32767;
+                BOOST_REQUIRE_CLOSE(samp.real(), expected, 1e-3);
+                BOOST_REQUIRE_CLOSE(samp.imag(), -1.0f / 32767, 1e-3);
+            }
+        }
+    }
+
+    const fs::path tmp_dir;
+    std::vector<std::string> paths;
+    uhd::mock_tx_streamer::sptr tx_stream = make_tx_streamer();
+};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_CASE(test_tx_player_args, player_fixture)
+{
+    BOOST_CHECK_THROW(
+        uhd::tx_player::make(tx_stream, "fc32", {paths[0]}), uhd::value_error);
+    BOOST_CHECK_THROW(uhd::tx_player::make(tx_stream, "fc16", paths), uhd::value_error);
+    BOOST_CHECK_THROW(uhd::tx_player::make(tx_stream,
+                          "fc32",
+                          {paths[0], (tmp_dir / "missing.dat").string()},
+                          uhd::device_addr_t("file_format=sc16")),
+        uhd::os_error);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_tx_player, player_fixture)
+{
+    auto player = uhd::tx_player::make(tx_stream,
+        "fc32",
+        paths,
+        uhd::device_addr_t("file_format=sc16,block_size=256,num_blocks=2"));
+    player->start(uhd::time_spec_t(1.5));
+    BOOST_CHECK_THROW(player->start(), uhd::runtime_error);
+    BOOST_REQUIRE(player->wait_done(10.0));
+    player->stop();
+
+    BOOST_CHECK_EQUAL(player->get_num_samps_sent(), NUM_SAMPS);
+    BOOST_REQUIRE_EQUAL(tx_stream->get_samples(0).size(), NUM_SAMPS);
+    check_samples(0, NUM_SAMPS);
+
+    // Blocks of 256 samples, sent in packets of up to 100 samples
+    const auto md = tx_stream->get_metadata();
+    BOOST_REQUIRE_EQUAL(md.size(), 4 * 3 + 1);
+    BOOST_CHECK(md.front().start_of_burst);
+    BOOST_CHECK(md.front().has_time_spec);
+    BOOST_CHECK_EQUAL(md.front().time_spec.get_real_secs(), 1.5);
+    for (size_t i = 1; i < md.size(); i++) {
+        BOOST_CHECK(!md[i].start_of_burst);
+        BOOST_CHECK(!md[i].has_time_spec);
+    }
+    BOOST_CHECK(md.back().end_of_burst);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_tx_player_loop, player_fixture)
+{
+    auto player = uhd::tx_player::make(tx_stream,
+        "fc32",
+        paths,
+        uhd::device_addr_t("file_format=sc16,block_size=300,num_blocks=4,loop=1"));
+    player->start();
+    while (player->get_num_samps_sent() < 3 * NUM_SAMPS) {
+        BOOST_REQUIRE(!player->wait_done(0.001));
+    }
+    player->stop();
+    BOOST_CHECK(player->wait_done(0.0));
+
+    // All samples the player sent are in order, and the burst was ended
+    const size_t num_samps = tx_stream->get_samples(0).size();
+    BOOST_CHECK_EQUAL(player->get_num_samps_sent(), num_samps);
+    check_samples(0, num_samps);
+    const auto md = tx_stream->get_metadata();
+    BOOST_CHECK(md.front().start_of_burst);
+    BOOST_CHECK(!md.front().has_time_spec);
+    BOOST_CHECK(md.back().end_of_burst);
+    for (size_t i = 0; i < md.size() - 1; i++) {
+        BOOST_CHECK(!md[i].end_of_burst);
+    }
+}
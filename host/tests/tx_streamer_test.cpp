@@ -5,10 +5,14 @@
 //
 
 #include "../common/mock_link.hpp"
+#include <uhd/utils/math.hpp>
 #include <uhdlib/transport/tx_streamer_impl.hpp>
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <memory>
+#include <thread>
 
 namespace uhd { namespace transport {
 
@@ -47,6 +51,11 @@ public:
         return std::make_pair(data + sizeof(info), sizeof(info) + info.payload_bytes);
     }
 
+    size_t get_payload_offset(const bool /*has_tsf*/) const
+    {
+        return sizeof(packet_info_t);
+    }
+
     void release_send_buff(buff_t::uptr buff)
     {
         _send_link->release_send_buff(std::move(buff));
@@ -88,6 +97,14 @@ public:
         tx_streamer_impl::set_scale_factor(chan, scale_factor);
     }
 
+    void set_late_burst_drop(time_estimate_fn_t get_time_estimate,
+        const double margin,
+        late_burst_fn_t late_burst_cb)
+    {
+        tx_streamer_impl::set_late_burst_drop(
+            std::move(get_time_estimate), margin, std::move(late_burst_cb));
+    }
+
     bool recv_async_msg(
         uhd::async_metadata_t& /*async_metadata*/, double /*timeout = 0.1*/)
     {
@@ -123,9 +140,12 @@ static std::vector<mock_send_link::sptr> make_links(const size_t num)
 }
 
 static std::shared_ptr<mock_tx_streamer> make_tx_streamer(
-    std::vector<mock_send_link::sptr> send_links, const std::string& format)
+    std::vector<mock_send_link::sptr> send_links,
+    const std::string& format,
+    const std::string& args = "")
 {
-    const uhd::stream_args_t stream_args(format, "sc16");
+    uhd::stream_args_t stream_args(format, "sc16");
+    stream_args.args = uhd::device_addr_t(args);
     auto streamer = std::make_shared<mock_tx_streamer>(send_links.size(), stream_args);
     streamer->set_tick_rate(TICK_RATE);
     streamer->set_samp_rate(SAMP_RATE);
@@ -248,6 +268,87 @@ BOOST_AUTO_TEST_CASE(test_send_one_channel_one_packet)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_send_host_dsp)
+{
+    const std::string format("fc32");
+    const std::complex<float> value(1000, -500);
+    mock_tx_data_xport::packet_info_t info;
+    std::complex<uint16_t>* data;
+    size_t packet_samps;
+    boost::shared_array<uint8_t> frame_buff;
+
+    // A frequency shift alone multiplies each sample with the NCO
+    {
+        auto send_links        = make_links(1);
+        const std::string args = "host_freq_shift=" + std::to_string(SAMP_RATE / 8);
+        auto streamer          = make_tx_streamer(send_links, format, args);
+
+        const size_t num_samps = 20;
+        std::vector<std::complex<float>> buff(num_samps, value);
+        uhd::tx_metadata_t metadata;
+        BOOST_CHECK_EQUAL(streamer->send(&buff.front(), num_samps, metadata, 1.0),
+            num_samps);
+        std::tie(info, data, packet_samps, frame_buff) = pop_send_packet(send_links[0]);
+        BOOST_REQUIRE_EQUAL(packet_samps, num_samps);
+        for (size_t j = 0; j < num_samps; j++) {
+            const auto expected = value * float(SCALE_FACTOR)
+                                  * std::polar(1.0f, float(j * uhd::math::PI / 4));
+            BOOST_CHECK_LE(std::abs(int16_t(data[j].real()) - expected.real()), 0.5f);
+            BOOST_CHECK_LE(std::abs(int16_t(data[j].imag()) - expected.imag()), 0.5f);
+        }
+    }
+
+    // Interpolating a burst, the filter is flushed before the end of burst
+    {
+        auto send_links        = make_links(1);
+        const std::string args = "host_rate=" + std::to_string(SAMP_RATE / 2);
+        auto streamer          = make_tx_streamer(send_links, format, args);
+
+        const size_t num_samps = 100;
+        const size_t num_taps  = polyphase_resampler::TAPS_PER_PHASE;
+        std::vector<std::complex<float>> buff(num_samps, value);
+        uhd::tx_metadata_t metadata;
+        metadata.start_of_burst = true;
+        metadata.end_of_burst   = true;
+        metadata.has_time_spec  = true;
+        metadata.time_spec      = uhd::time_spec_t(1.0);
+        BOOST_CHECK_EQUAL(streamer->send(&buff.front(), num_samps, metadata, 1.0),
+            num_samps);
+
+        // The input and the zeros that flush the filter, at twice the rate. The
+        // zeros go out in a packet of their own.
+        const size_t num_flush = 2 * (num_taps - 1);
+        BOOST_REQUIRE_EQUAL(send_links[0]->get_num_packets(), 3);
+        std::tie(info, data, packet_samps, frame_buff) = pop_send_packet(send_links[0]);
+        BOOST_REQUIRE_EQUAL(packet_samps, 2 * num_samps);
+        BOOST_CHECK(info.has_tsf);
+        BOOST_CHECK_EQUAL(info.tsf, TICK_RATE);
+        BOOST_CHECK(!info.eob);
+        // Once the filter has settled, the output is the input at twice the rate
+        for (size_t j = 2 * num_taps; j < packet_samps; j++) {
+            BOOST_CHECK_EQUAL(int16_t(data[j].real()), value.real() * SCALE_FACTOR);
+            BOOST_CHECK_EQUAL(int16_t(data[j].imag()), value.imag() * SCALE_FACTOR);
+        }
+
+        // And it decays to zero after the input ends
+        std::tie(info, data, packet_samps, frame_buff) = pop_send_packet(send_links[0]);
+        BOOST_REQUIRE_EQUAL(packet_samps, num_flush);
+        BOOST_CHECK_EQUAL(info.tsf, TICK_RATE + 2 * num_samps * TICK_RATE / SAMP_RATE);
+        BOOST_CHECK(!info.eob);
+        BOOST_CHECK_EQUAL(data[num_flush - 1], std::complex<uint16_t>(0, 0));
+
+        std::tie(info, data, packet_samps, frame_buff) = pop_send_packet(send_links[0]);
+        BOOST_CHECK(info.eob);
+        BOOST_CHECK_EQUAL(
+            info.tsf, TICK_RATE + (2 * num_samps + num_flush) * TICK_RATE / SAMP_RATE);
+    }
+
+    BOOST_CHECK_THROW(
+        make_tx_streamer(make_links(1), "fc64", "host_rate=1e6"), uhd::value_error);
+    BOOST_CHECK_THROW(
+        make_tx_streamer(make_links(1), format, "host_rate=1e10"), uhd::value_error);
+}
+
 BOOST_AUTO_TEST_CASE(test_send_one_channel_eov_lte_spp)
 {
     const size_t NUM_PKTS_TO_TEST = 30;
@@ -556,6 +657,282 @@ BOOST_AUTO_TEST_CASE(test_send_one_channel_multi_packet)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_send_time_ticks)
+{
+    // A sample rate that does not divide the tick rate, and a start time that
+    // a double can't hold after adding a fraction of a tick
+    const double samp_rate    = 3e6;
+    const uint64_t start_tick = (uint64_t(1) << 53) + 1;
+    const std::string format("fc32");
+
+    auto send_links = make_links(1);
+    auto streamer   = make_tx_streamer(send_links, format);
+    streamer->set_samp_rate(samp_rate);
+
+    uhd::tx_metadata_t metadata;
+    metadata.has_time_spec  = true;
+    metadata.has_time_ticks = true;
+    metadata.time_ticks     = start_tick;
+    metadata.end_of_burst   = true;
+
+    const size_t spp       = streamer->get_max_num_samps();
+    const size_t num_samps = spp * 4;
+    std::vector<std::complex<float>> buff(num_samps);
+    BOOST_CHECK_EQUAL(streamer->send(&buff.front(), num_samps, metadata, 1.0), num_samps);
+
+    // Each timestamp is the offset of the packet rounded to a tick, added to
+    // the exact start time
+    size_t samps_checked = 0;
+    while (samps_checked < num_samps) {
+        mock_tx_data_xport::packet_info_t info;
+        std::complex<uint16_t>* data;
+        size_t packet_samps;
+        boost::shared_array<uint8_t> frame_buff;
+
+        std::tie(info, data, packet_samps, frame_buff) = pop_send_packet(send_links[0]);
+        BOOST_CHECK(info.has_tsf);
+        BOOST_CHECK_EQUAL(info.tsf,
+            start_tick + uint64_t(std::llround(samps_checked * TICK_RATE / samp_rate)));
+        samps_checked += packet_samps;
+    }
+    BOOST_CHECK_EQUAL(samps_checked, num_samps);
+}
+
+BOOST_AUTO_TEST_CASE(test_send_bursts)
+{
+    const std::string format("fc32");
+
+    auto send_links = make_links(1);
+    auto streamer   = make_tx_streamer(send_links, format);
+
+    const size_t spp = streamer->get_max_num_samps();
+    std::vector<std::complex<float>> buff(spp * 3);
+    for (size_t i = 0; i < buff.size(); i++) {
+        buff[i] = std::complex<float>(i * 2, i * 2 + 1);
+    }
+
+    // A short burst, one that fragments, and one of exactly spp samples
+    const std::vector<size_t> burst_lens = {10, spp * 2 + 5, spp};
+    std::vector<uhd::tx_streamer::burst_t> bursts;
+    for (size_t i = 0; i < burst_lens.size(); i++) {
+        uhd::tx_streamer::burst_t burst;
+        burst.buffs     = {&buff.front()};
+        burst.nsamps    = burst_lens[i];
+        burst.time_spec = uhd::time_spec_t(0.001 * (i + 1));
+        bursts.push_back(burst);
+    }
+    BOOST_CHECK_EQUAL(streamer->send_bursts(bursts, 1.0), bursts.size());
+
+    for (size_t i = 0; i < bursts.size(); i++) {
+        const uint64_t start_tick = bursts[i].time_spec.to_ticks(TICK_RATE);
+        size_t samps_checked      = 0;
+        while (samps_checked < bursts[i].nsamps) {
+            mock_tx_data_xport::packet_info_t info;
+            std::complex<uint16_t>* data;
+            size_t packet_samps;
+            boost::shared_array<uint8_t> frame_buff;
+
+            std::tie(info, data, packet_samps, frame_buff) =
+                pop_send_packet(send_links[0]);
+            BOOST_CHECK_EQUAL(
+                packet_samps, std::min(spp, bursts[i].nsamps - samps_checked));
+            for (size_t j = 0; j < packet_samps; j++) {
+                const size_t n = j + samps_checked;
+                const std::complex<uint16_t> value(
+                    (n * 2) * SCALE_FACTOR, (n * 2 + 1) * SCALE_FACTOR);
+                BOOST_CHECK_EQUAL(value, data[j]);
+            }
+            BOOST_CHECK(info.has_tsf);
+            BOOST_CHECK_EQUAL(
+                info.tsf, start_tick + samps_checked * TICK_RATE / SAMP_RATE);
+            samps_checked += packet_samps;
+            BOOST_CHECK_EQUAL(info.eob, samps_checked == bursts[i].nsamps);
+        }
+    }
+    BOOST_CHECK_EQUAL(send_links[0]->get_num_packets(), 0);
+
+    // Invalid bursts are rejected before anything is sent
+    bursts[1].nsamps = 0;
+    BOOST_CHECK_THROW(streamer->send_bursts(bursts, 1.0), uhd::value_error);
+    BOOST_CHECK_EQUAL(send_links[0]->get_num_packets(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_send_segments)
+{
+    const std::string format("fc32");
+
+    auto send_links = make_links(2);
+    auto streamer   = make_tx_streamer(send_links, format);
+
+    const size_t spp    = streamer->get_max_num_samps();
+    const size_t nsamps = spp * 2 + 5;
+    std::vector<std::complex<float>> buff(nsamps);
+    for (size_t i = 0; i < buff.size(); i++) {
+        buff[i] = std::complex<float>(i * 2, i * 2 + 1);
+    }
+
+    // The channels are split up differently, and segments span packets
+    std::vector<uhd::tx_streamer::segments_type> segments(2);
+    segments[0] = {{&buff[0], 3}, {&buff[3], spp}, {&buff[spp + 3], spp + 2}};
+    segments[1] = {
+        {&buff[0], spp + 7}, {&buff[spp + 7], 0}, {&buff[spp + 7], spp - 2}};
+
+    uhd::tx_metadata_t metadata;
+    metadata.has_time_spec  = true;
+    metadata.time_spec      = uhd::time_spec_t(0.001);
+    metadata.start_of_burst = true;
+    metadata.end_of_burst   = true;
+    BOOST_CHECK_EQUAL(streamer->send_segments(segments, metadata, 1.0), nsamps);
+
+    const uint64_t start_tick = metadata.time_spec.to_ticks(TICK_RATE);
+    for (size_t ch = 0; ch < 2; ch++) {
+        size_t samps_checked = 0;
+        while (samps_checked < nsamps) {
+            mock_tx_data_xport::packet_info_t info;
+            std::complex<uint16_t>* data;
+            size_t packet_samps;
+            boost::shared_array<uint8_t> frame_buff;
+
+            std::tie(info, data, packet_samps, frame_buff) =
+                pop_send_packet(send_links[ch]);
+            BOOST_CHECK_EQUAL(packet_samps, std::min(spp, nsamps - samps_checked));
+            for (size_t j = 0; j < packet_samps; j++) {
+                const size_t n = j + samps_checked;
+                const std::complex<uint16_t> value(
+                    (n * 2) * SCALE_FACTOR, (n * 2 + 1) * SCALE_FACTOR);
+                BOOST_CHECK_EQUAL(value, data[j]);
+            }
+            BOOST_CHECK(info.has_tsf);
+            BOOST_CHECK_EQUAL(
+                info.tsf, start_tick + samps_checked * TICK_RATE / SAMP_RATE);
+            samps_checked += packet_samps;
+            BOOST_CHECK_EQUAL(info.eob, samps_checked == nsamps);
+        }
+        BOOST_CHECK_EQUAL(send_links[ch]->get_num_packets(), 0);
+    }
+
+    // The channels must have the same number of samples
+    segments[1].pop_back();
+    BOOST_CHECK_THROW(streamer->send_segments(segments, metadata, 1.0), uhd::value_error);
+    BOOST_CHECK_EQUAL(send_links[0]->get_num_packets(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_send_cyclic)
+{
+    const std::string format("fc32");
+
+    auto send_links = make_links(1);
+    auto streamer   = make_tx_streamer(send_links, format);
+
+    // A waveform that takes one full packet and one short one
+    const size_t spp    = streamer->get_max_num_samps();
+    const size_t nsamps = spp + 5;
+    std::vector<std::complex<float>> buff(nsamps);
+    for (size_t i = 0; i < buff.size(); i++) {
+        buff[i] = std::complex<float>(i * 2, i * 2 + 1);
+    }
+
+    uhd::tx_metadata_t metadata;
+    metadata.has_time_spec = true;
+    metadata.time_spec     = uhd::time_spec_t(0.001);
+    BOOST_CHECK_THROW(
+        streamer->start_cyclic(&buff.front(), 0, metadata), uhd::value_error);
+    streamer->start_cyclic(&buff.front(), nsamps, metadata);
+
+    // Nothing else can be sent until the transmission stops
+    BOOST_CHECK_THROW(
+        streamer->send(&buff.front(), nsamps, metadata, 1.0), uhd::runtime_error);
+    BOOST_CHECK_THROW(
+        streamer->start_cyclic(&buff.front(), nsamps, metadata), uhd::runtime_error);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    streamer->stop_cyclic(1.0);
+
+    // The waveform repeats in one burst, the last packet only ends it
+    const uint64_t start_tick = metadata.time_spec.to_ticks(TICK_RATE);
+    size_t samps_checked      = 0;
+    size_t num_mismatches     = 0;
+    while (send_links[0]->get_num_packets() > 1) {
+        mock_tx_data_xport::packet_info_t info;
+        std::complex<uint16_t>* data;
+        size_t packet_samps;
+        boost::shared_array<uint8_t> frame_buff;
+
+        std::tie(info, data, packet_samps, frame_buff) = pop_send_packet(send_links[0]);
+        const size_t pos = samps_checked % nsamps;
+        BOOST_REQUIRE_EQUAL(packet_samps, pos == 0 ? spp : nsamps - spp);
+        for (size_t j = 0; j < packet_samps; j++) {
+            const size_t n = j + pos;
+            const std::complex<uint16_t> value(
+                (n * 2) * SCALE_FACTOR, (n * 2 + 1) * SCALE_FACTOR);
+            num_mismatches += (value != data[j]);
+        }
+        BOOST_REQUIRE(info.has_tsf);
+        BOOST_REQUIRE_EQUAL(
+            info.tsf, start_tick + samps_checked * TICK_RATE / SAMP_RATE);
+        BOOST_REQUIRE(!info.eob);
+        samps_checked += packet_samps;
+    }
+    BOOST_CHECK_EQUAL(num_mismatches, 0);
+
+    mock_tx_data_xport::packet_info_t info;
+    std::complex<uint16_t>* data;
+    size_t packet_samps;
+    boost::shared_array<uint8_t> frame_buff;
+    std::tie(info, data, packet_samps, frame_buff) = pop_send_packet(send_links[0]);
+    BOOST_CHECK(info.eob);
+    BOOST_CHECK_EQUAL(info.tsf, start_tick + samps_checked * TICK_RATE / SAMP_RATE);
+
+    // The streamer can send again
+    metadata.has_time_spec = false;
+    BOOST_CHECK_EQUAL(streamer->send(&buff.front(), 10, metadata, 1.0), 10);
+}
+
+BOOST_AUTO_TEST_CASE(test_send_signal_stats)
+{
+    auto send_links = make_links(1);
+    auto streamer   = make_tx_streamer(send_links, "fc32", "signal_stats=1");
+
+    // One sample saturates in both I and Q, with the scale factor of 2
+    std::vector<std::complex<float>> buff(11);
+    for (size_t i = 0; i < buff.size(); i++) {
+        buff[i] = std::complex<float>(i * 2, i * 2 + 1);
+    }
+    buff[3] = std::complex<float>(20000, -20000);
+    buff[5] = std::complex<float>(16383, -16384);
+
+    uhd::tx_metadata_t metadata;
+    BOOST_CHECK_EQUAL(streamer->send(buff.data(), buff.size(), metadata, 1.0), 11);
+
+    mock_tx_data_xport::packet_info_t info;
+    std::complex<uint16_t>* data;
+    size_t packet_samps;
+    boost::shared_array<uint8_t> frame_buff;
+    std::tie(info, data, packet_samps, frame_buff) = pop_send_packet(send_links[0]);
+    BOOST_REQUIRE_EQUAL(packet_samps, 11);
+    BOOST_CHECK_EQUAL(data[3], std::complex<uint16_t>(0x7FFF, 0x8000));
+    BOOST_CHECK_EQUAL(data[5], std::complex<uint16_t>(0x7FFE, 0x8000));
+
+    double sum_power = 0.0;
+    std::complex<double> sum;
+    for (const auto& sample : buff) {
+        sum_power += std::norm(std::complex<double>(sample));
+        sum += std::complex<double>(sample);
+    }
+    const uhd::signal_stats_t stats = streamer->get_signal_stats(0);
+    BOOST_CHECK_EQUAL(stats.num_samps, 11);
+    BOOST_CHECK_EQUAL(stats.num_clipped, 2);
+    BOOST_CHECK_CLOSE(stats.sum_power, sum_power, 1e-3);
+    BOOST_CHECK_CLOSE(stats.peak_power, 8e8, 1e-3);
+    BOOST_CHECK_CLOSE(stats.sum.real(), sum.real(), 1e-3);
+    BOOST_CHECK_CLOSE(stats.sum.imag(), sum.imag(), 1e-3);
+    BOOST_CHECK_EQUAL(streamer->get_signal_stats(0).num_samps, 0);
+
+    streamer->set_signal_stats_enabled(false);
+    BOOST_CHECK_THROW(streamer->get_signal_stats(0), uhd::not_implemented_error);
+    auto sc16 = make_tx_streamer(make_links(1), "sc16");
+    BOOST_CHECK_THROW(sc16->set_signal_stats_enabled(true), uhd::not_implemented_error);
+}
+
 BOOST_AUTO_TEST_CASE(test_send_two_channel_one_packet)
 {
     const size_t NUM_PKTS_TO_TEST = 30;
@@ -618,6 +995,194 @@ BOOST_AUTO_TEST_CASE(test_send_two_channel_one_packet)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_send_zero_copy)
+{
+    const size_t NUM_PKTS_TO_TEST = 10;
+    const size_t NUM_CHANS        = 2;
+    const std::string format("fc32");
+
+    auto send_links = make_links(NUM_CHANS);
+    auto streamer   = make_tx_streamer(send_links, format);
+
+    uhd::tx_metadata_t metadata;
+    metadata.has_time_spec = true;
+    metadata.time_spec     = uhd::time_spec_t(0.0);
+
+    std::vector<void*> buffs;
+    size_t num_accum_samps = 0;
+
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        const size_t num_samps = 10 + i;
+        metadata.end_of_burst  = (i == NUM_PKTS_TO_TEST - 1);
+
+        const size_t max_samps = streamer->get_send_buffs(buffs, metadata, 1.0);
+        BOOST_CHECK_EQUAL(max_samps, streamer->get_max_num_samps());
+        BOOST_REQUIRE_EQUAL(buffs.size(), NUM_CHANS);
+
+        // Buffers must be committed before sending again
+        BOOST_CHECK_THROW(
+            streamer->get_send_buffs(buffs, metadata, 1.0), uhd::runtime_error);
+
+        // Samples are written in the over-the-wire format, unscaled
+        for (size_t ch = 0; ch < NUM_CHANS; ch++) {
+            auto samps = static_cast<std::complex<uint16_t>*>(buffs[ch]);
+            for (size_t j = 0; j < num_samps; j++) {
+                samps[j] = std::complex<uint16_t>(ch * 100 + j * 2, j * 2 + 1);
+            }
+        }
+
+        BOOST_CHECK_THROW(streamer->commit_send_buffs(0), uhd::value_error);
+        streamer->commit_send_buffs(num_samps);
+        BOOST_CHECK_THROW(streamer->commit_send_buffs(num_samps), uhd::runtime_error);
+        metadata.time_spec += uhd::time_spec_t(0, num_samps, SAMP_RATE);
+
+        for (size_t ch = 0; ch < NUM_CHANS; ch++) {
+            mock_tx_data_xport::packet_info_t info;
+            std::complex<uint16_t>* data;
+            size_t packet_samps;
+            boost::shared_array<uint8_t> frame_buff;
+
+            std::tie(info, data, packet_samps, frame_buff) =
+                pop_send_packet(send_links[ch]);
+            BOOST_CHECK_EQUAL(num_samps, packet_samps);
+
+            for (size_t j = 0; j < num_samps; j++) {
+                const std::complex<uint16_t> value(ch * 100 + j * 2, j * 2 + 1);
+                BOOST_CHECK_EQUAL(value, data[j]);
+            }
+
+            BOOST_CHECK(info.has_tsf);
+            BOOST_CHECK_EQUAL(info.tsf, num_accum_samps * TICK_RATE / SAMP_RATE);
+            BOOST_CHECK_EQUAL(info.eob, i == NUM_PKTS_TO_TEST - 1);
+        }
+        num_accum_samps += num_samps;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_send_stats)
+{
+    const size_t NUM_PKTS_TO_TEST = 5;
+    const size_t num_samps        = 20;
+    const std::string format("fc32");
+
+    auto send_links = make_links(1);
+    auto streamer   = make_tx_streamer(send_links, format);
+
+    BOOST_CHECK(!streamer->get_stats().enabled);
+    streamer->set_stats_enabled(true);
+
+    std::vector<std::complex<float>> buff(num_samps);
+    uhd::tx_metadata_t metadata;
+
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        BOOST_CHECK_EQUAL(
+            streamer->send(buff.data(), num_samps, metadata, 1.0), num_samps);
+        send_links[0]->pop_send_packet();
+    }
+
+    // Sends that can't get a frame buffer stall and time out
+    send_links[0]->set_simulate_io_timeout(true);
+    BOOST_CHECK_EQUAL(streamer->send(buff.data(), num_samps, metadata, 0.0), 0);
+    BOOST_CHECK_EQUAL(streamer->send(buff.data(), num_samps, metadata, 0.0), 0);
+
+    const uhd::streamer_stats_t stats = streamer->get_stats();
+    BOOST_CHECK(stats.enabled);
+    BOOST_REQUIRE_EQUAL(stats.chans.size(), 1);
+    BOOST_CHECK_EQUAL(stats.chans[0].packets, NUM_PKTS_TO_TEST);
+    BOOST_CHECK_EQUAL(stats.chans[0].bytes,
+        NUM_PKTS_TO_TEST * num_samps * sizeof(std::complex<uint16_t>));
+    BOOST_CHECK_EQUAL(stats.stalls, 2);
+
+    uint64_t hist_total = 0;
+    for (const uint64_t bucket : stats.wait_time_hist) {
+        hist_total += bucket;
+    }
+    BOOST_CHECK_EQUAL(hist_total, stats.stalls);
+    BOOST_CHECK(stats.latency.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_send_drop_late_bursts)
+{
+    const std::string format("fc32");
+
+    auto send_links = make_links(1);
+    auto streamer   = make_tx_streamer(send_links, format);
+    streamer->set_stats_enabled(true);
+
+    boost::optional<uhd::time_spec_t> now(uhd::time_spec_t(1.0));
+    std::vector<uhd::time_spec_t> late_bursts;
+    streamer->set_late_burst_drop([&now]() { return now; },
+        0.001,
+        [&late_bursts](const uhd::time_spec_t& time) { late_bursts.push_back(time); });
+
+    const size_t spp = streamer->get_max_num_samps();
+    std::vector<std::complex<float>> buff(spp * 2);
+
+    // A late burst is dropped as a whole, also the part that comes with
+    // later calls to send(), but it counts as sent
+    uhd::tx_metadata_t metadata;
+    metadata.start_of_burst = true;
+    metadata.has_time_spec  = true;
+    metadata.time_spec      = uhd::time_spec_t(0.5);
+    BOOST_CHECK_EQUAL(streamer->send(buff.data(), spp * 2, metadata, 0.0), spp * 2);
+    metadata.start_of_burst = false;
+    metadata.has_time_spec  = false;
+    metadata.end_of_burst   = true;
+    BOOST_CHECK_EQUAL(streamer->send(buff.data(), 10, metadata, 0.0), 10);
+    BOOST_CHECK_EQUAL(send_links[0]->get_num_packets(), 0);
+    BOOST_REQUIRE_EQUAL(late_bursts.size(), 1);
+    BOOST_CHECK(late_bursts[0] == uhd::time_spec_t(0.5));
+
+    // A burst that is late by less than the margin goes out
+    metadata.start_of_burst = true;
+    metadata.has_time_spec  = true;
+    metadata.time_spec      = uhd::time_spec_t(0.9995);
+    BOOST_CHECK_EQUAL(streamer->send(buff.data(), 10, metadata, 0.0), 10);
+    BOOST_CHECK_EQUAL(send_links[0]->get_num_packets(), 1);
+    send_links[0]->pop_send_packet();
+
+    // As does any burst while the device time is not known
+    now                = boost::none;
+    metadata.time_spec = uhd::time_spec_t(0.5);
+    BOOST_CHECK_EQUAL(streamer->send(buff.data(), 10, metadata, 0.0), 10);
+    BOOST_CHECK_EQUAL(send_links[0]->get_num_packets(), 1);
+    send_links[0]->pop_send_packet();
+
+    BOOST_CHECK_EQUAL(late_bursts.size(), 1);
+    BOOST_CHECK_EQUAL(streamer->get_stats().late_bursts, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_send_latency_probe)
+{
+    const size_t NUM_PKTS_TO_TEST = 4;
+    const size_t num_samps        = 20;
+    const std::string format("fc32");
+
+    auto send_links = make_links(1);
+    auto streamer   = make_tx_streamer(send_links, format);
+    streamer->set_latency_probe_enabled(true);
+
+    std::vector<std::complex<float>> buff(num_samps);
+    uhd::tx_metadata_t metadata;
+
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        BOOST_CHECK_EQUAL(
+            streamer->send(buff.data(), num_samps, metadata, 1.0), num_samps);
+        send_links[0]->pop_send_packet();
+    }
+    streamer->set_latency_probe_enabled(false);
+    BOOST_CHECK_EQUAL(streamer->send(buff.data(), num_samps, metadata, 1.0), num_samps);
+
+    const uhd::streamer_stats_t stats = streamer->get_stats();
+    BOOST_REQUIRE_EQUAL(stats.latency.size(), 2);
+    const auto& to_release = stats.latency.at("send_to_release");
+    const auto& to_link    = stats.latency.at("send_to_link");
+    BOOST_CHECK_EQUAL(to_release.count, NUM_PKTS_TO_TEST);
+    // The mock link transmits the packet when the streamer releases it
+    BOOST_CHECK_EQUAL(to_link.count, NUM_PKTS_TO_TEST);
+    BOOST_CHECK_LE(to_release.total_ns, to_link.total_ns);
+}
+
 BOOST_AUTO_TEST_CASE(test_meta_data_cache)
 {
     auto send_links = make_links(1);
@@ -0,0 +1,113 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/transport/udp_link_qualification.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace uhd::transport;
+
+namespace {
+
+//! 10 Gbps, in bytes per second
+constexpr double LINK_RATE = 1.25e9;
+
+//! A host that is set up for 10 Gbps links
+udp_host_info_t make_good_host()
+{
+    udp_host_info_t host;
+    host.ifname        = "eth0";
+    host.rmem_max      = 50000000;
+    host.if_mtu        = 9000;
+    host.rx_ring       = 4096;
+    host.rx_ring_max   = 4096;
+    host.cpu_governors = {"performance"};
+    return host;
+}
+
+link_params_t make_params()
+{
+    link_params_t params;
+    params.recv_frame_size = 8000;
+    params.num_recv_frames = 32;
+    params.recv_buff_size  = 25000000;
+    return params;
+}
+
+link_verdict_t get_check(
+    const udp_link_qualification_t& qualification, const std::string& name)
+{
+    for (const auto& check : qualification.checks) {
+        if (check.name == name) {
+            return check.verdict;
+        }
+    }
+    BOOST_FAIL("No check named " + name);
+    return link_verdict_t::UNKNOWN;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_qualify_good_host)
+{
+    const auto qualification =
+        qualify_udp_link(make_good_host(), make_params(), LINK_RATE);
+    BOOST_CHECK(qualification.get_verdict() == link_verdict_t::PASS);
+    BOOST_CHECK_EQUAL(qualification.to_string(),
+        "verdict=pass,rcvbuf=pass,nic_ring=pass,mtu=pass,cpu_governor=pass");
+}
+
+BOOST_AUTO_TEST_CASE(test_qualify_misconfigured_host)
+{
+    udp_host_info_t host = make_good_host();
+    host.rmem_max        = 10000000;
+    host.rx_ring         = 512;
+    host.if_mtu          = 1500;
+    host.cpu_governors   = {"performance", "powersave"};
+    auto qualification   = qualify_udp_link(host, make_params(), LINK_RATE);
+    BOOST_CHECK(get_check(qualification, "rcvbuf") == link_verdict_t::WARN);
+    BOOST_CHECK(get_check(qualification, "nic_ring") == link_verdict_t::WARN);
+    BOOST_CHECK(get_check(qualification, "mtu") == link_verdict_t::WARN);
+    BOOST_CHECK(get_check(qualification, "cpu_governor") == link_verdict_t::WARN);
+    BOOST_CHECK(qualification.get_verdict() == link_verdict_t::WARN);
+    for (const auto& check : qualification.checks) {
+        BOOST_CHECK(check.detail.find("Please") != std::string::npos);
+    }
+
+    // The default rmem_max of many distributions holds far less than 1 ms
+    host.rmem_max = 212992;
+    qualification = qualify_udp_link(host, make_params(), LINK_RATE);
+    BOOST_CHECK(get_check(qualification, "rcvbuf") == link_verdict_t::FAIL);
+    BOOST_CHECK(qualification.get_verdict() == link_verdict_t::FAIL);
+
+    // Checks that cannot run don't change the verdict
+    qualification = qualify_udp_link(udp_host_info_t(), make_params(), LINK_RATE);
+    BOOST_CHECK(qualification.get_verdict() == link_verdict_t::PASS);
+    BOOST_CHECK_EQUAL(qualification.to_string(),
+        "verdict=pass,rcvbuf=unknown,nic_ring=unknown,mtu=unknown,"
+        "cpu_governor=unknown");
+}
+
+BOOST_AUTO_TEST_CASE(test_autotune_link_params)
+{
+    udp_host_info_t host = make_good_host();
+    host.if_mtu          = 1500;
+    const uhd::device_addr_t no_args;
+
+    const auto tuned =
+        autotune_udp_link_params(host, make_params(), LINK_RATE, no_args, no_args);
+    BOOST_CHECK_EQUAL(tuned.recv_frame_size, 1500 - UDP_IPV4_HEADER_SIZE);
+    // 1 ms at 10 Gbps
+    BOOST_CHECK_EQUAL(tuned.num_recv_frames, 850);
+    BOOST_CHECK_EQUAL(tuned.recv_buff_size, 25000000);
+
+    // Explicit values are kept
+    const uhd::device_addr_t device_args("recv_frame_size=1000");
+    const uhd::device_addr_t link_args("num_recv_frames=16");
+    const auto kept =
+        autotune_udp_link_params(host, make_params(), LINK_RATE, device_args, link_args);
+    BOOST_CHECK_EQUAL(kept.recv_frame_size, 8000);
+    BOOST_CHECK_EQUAL(kept.num_recv_frames, 32);
+}
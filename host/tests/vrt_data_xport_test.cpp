@@ -0,0 +1,269 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "../common/mock_zero_copy.hpp"
+#include <uhdlib/transport/rx_streamer_impl.hpp>
+#include <uhdlib/transport/tx_streamer_impl.hpp>
+#include <uhdlib/transport/vrt_data_xport.hpp>
+#include <boost/test/unit_test.hpp>
+#include <complex>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace uhd::transport;
+
+namespace {
+
+constexpr double TICK_RATE  = 100e6;
+constexpr double SAMP_RATE  = 10e6;
+constexpr uint32_t TEST_SID = 0x00000010;
+
+const std::string OTW_FORMAT_SUFFIX = "_item32_le";
+
+/*!
+ * Streamer that has its inline messages handled like the B200 does
+ */
+class test_rx_streamer : public rx_streamer_impl<vrt_rx_data_xport>
+{
+public:
+    test_rx_streamer(const uhd::stream_args_t& stream_args)
+        : rx_streamer_impl<vrt_rx_data_xport>(1, stream_args, OTW_FORMAT_SUFFIX)
+    {
+        set_tick_rate(TICK_RATE);
+        set_samp_rate(SAMP_RATE);
+        set_overrun_handler([this]() { num_overruns++; });
+    }
+
+    void connect(mock_zero_copy& xport, const size_t max_payload_size)
+    {
+        connect_channel(0,
+            vrt_rx_data_xport::uptr(new vrt_rx_data_xport(
+                [&xport](double timeout) { return xport.get_recv_buff(timeout); },
+                &vrt::chdr::if_hdr_unpack_le,
+                max_payload_size,
+                [this](const uhd::rx_metadata_t::error_code_t error_code) {
+                    if (error_code == uhd::rx_metadata_t::ERROR_CODE_OVERFLOW) {
+                        set_stopped_due_to_overrun();
+                    }
+                })));
+    }
+
+    void issue_stream_cmd(const uhd::stream_cmd_t&) {}
+
+    size_t num_overruns = 0;
+};
+
+class test_tx_streamer : public tx_streamer_impl<vrt_tx_data_xport>
+{
+public:
+    test_tx_streamer(const uhd::stream_args_t& stream_args)
+        : tx_streamer_impl<vrt_tx_data_xport>(1, stream_args, OTW_FORMAT_SUFFIX)
+    {
+        set_tick_rate(TICK_RATE);
+        set_samp_rate(SAMP_RATE);
+    }
+
+    void connect(mock_zero_copy& xport, const size_t max_payload_size)
+    {
+        connect_channel(0,
+            vrt_tx_data_xport::uptr(new vrt_tx_data_xport(
+                [&xport](double timeout) { return xport.get_send_buff(timeout); },
+                &vrt::chdr::if_hdr_pack_le,
+                TEST_SID,
+                max_payload_size)));
+    }
+
+    bool recv_async_msg(uhd::async_metadata_t&, double)
+    {
+        return false;
+    }
+};
+
+uhd::stream_args_t make_stream_args()
+{
+    uhd::stream_args_t stream_args("fc32", "sc16");
+    return stream_args;
+}
+
+vrt::if_packet_info_t make_data_ifpi()
+{
+    vrt::if_packet_info_t ifpi;
+    ifpi.link_type           = vrt::if_packet_info_t::LINK_TYPE_CHDR;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 0;
+    ifpi.packet_count        = 0;
+    ifpi.sob                 = false;
+    ifpi.eob                 = false;
+    ifpi.has_sid             = true;
+    ifpi.sid                 = TEST_SID;
+    ifpi.has_cid             = false;
+    ifpi.has_tsi             = false;
+    ifpi.has_tsf             = true;
+    ifpi.tsf                 = 0;
+    ifpi.has_tlr             = false;
+    return ifpi;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_vrt_rx_data_xport_normal)
+{
+    constexpr size_t NUM_PKTS_TO_TEST = 10;
+    mock_zero_copy xport(vrt::if_packet_info_t::LINK_TYPE_CHDR);
+
+    vrt::if_packet_info_t ifpi = make_data_ifpi();
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        ifpi.num_payload_words32 = 10 + i;
+        ifpi.num_payload_bytes   = ifpi.num_payload_words32 * sizeof(uint32_t);
+        ifpi.eob                 = (i == NUM_PKTS_TO_TEST - 1);
+        std::vector<uint32_t> data(ifpi.num_payload_words32, uint32_t(i));
+        xport.push_back_recv_packet<uint32_t, uhd::ENDIANNESS_LITTLE>(ifpi, data);
+        ifpi.packet_count++;
+        ifpi.tsf += ifpi.num_payload_words32 * size_t(TICK_RATE / SAMP_RATE);
+    }
+
+    test_rx_streamer streamer(make_stream_args());
+    streamer.connect(xport, 100 * sizeof(uint32_t));
+    BOOST_CHECK_EQUAL(streamer.get_max_num_samps(), 100);
+
+    size_t num_accum_samps = 0;
+    std::vector<std::complex<float>> buff(100);
+    uhd::rx_metadata_t metadata;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        std::cout << "data check " << i << std::endl;
+        const size_t num_samps_ret =
+            streamer.recv(&buff.front(), buff.size(), metadata, 1.0, true);
+        BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+        BOOST_CHECK(metadata.has_time_spec);
+        BOOST_CHECK_EQUAL(metadata.time_spec.to_ticks(SAMP_RATE), num_accum_samps);
+        BOOST_CHECK_EQUAL(metadata.end_of_burst, i == NUM_PKTS_TO_TEST - 1);
+        BOOST_CHECK_EQUAL(num_samps_ret, 10 + i);
+        num_accum_samps += num_samps_ret;
+    }
+
+    streamer.recv(&buff.front(), buff.size(), metadata, 0.1, true);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+}
+
+BOOST_AUTO_TEST_CASE(test_vrt_rx_data_xport_sequence_error)
+{
+    mock_zero_copy xport(vrt::if_packet_info_t::LINK_TYPE_CHDR);
+
+    vrt::if_packet_info_t ifpi = make_data_ifpi();
+    ifpi.num_payload_words32   = 10;
+    ifpi.num_payload_bytes     = ifpi.num_payload_words32 * sizeof(uint32_t);
+    std::vector<uint32_t> data(ifpi.num_payload_words32, 0);
+    for (const size_t packet_count : {0, 1, 3}) {
+        ifpi.packet_count = packet_count;
+        xport.push_back_recv_packet<uint32_t, uhd::ENDIANNESS_LITTLE>(ifpi, data);
+    }
+
+    test_rx_streamer streamer(make_stream_args());
+    streamer.connect(xport, 100 * sizeof(uint32_t));
+
+    std::vector<std::complex<float>> buff(100);
+    uhd::rx_metadata_t metadata;
+    for (size_t i = 0; i < 2; i++) {
+        streamer.recv(&buff.front(), buff.size(), metadata, 1.0, true);
+        BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+    }
+    streamer.recv(&buff.front(), buff.size(), metadata, 1.0, true);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_OVERFLOW);
+    BOOST_CHECK(metadata.out_of_sequence);
+}
+
+BOOST_AUTO_TEST_CASE(test_vrt_rx_data_xport_inline_overflow)
+{
+    constexpr size_t NUM_PKTS_TO_TEST = 4;
+    mock_zero_copy xport(vrt::if_packet_info_t::LINK_TYPE_CHDR);
+
+    vrt::if_packet_info_t ifpi = make_data_ifpi();
+    ifpi.num_payload_words32   = 10;
+    ifpi.num_payload_bytes     = ifpi.num_payload_words32 * sizeof(uint32_t);
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        std::vector<uint32_t> data(ifpi.num_payload_words32, 0);
+        xport.push_back_recv_packet<uint32_t, uhd::ENDIANNESS_LITTLE>(ifpi, data);
+        ifpi.packet_count++;
+        ifpi.tsf += ifpi.num_payload_words32 * size_t(TICK_RATE / SAMP_RATE);
+    }
+
+    // The radio stops after sending the overflow message, anything that
+    // follows it is flushed before the overrun handler restarts the radio
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_CONTEXT;
+    ifpi.num_payload_words32 = 1;
+    ifpi.num_payload_bytes   = sizeof(uint32_t);
+    xport.push_back_inline_message_packet<uhd::ENDIANNESS_LITTLE>(
+        ifpi, uhd::rx_metadata_t::ERROR_CODE_OVERFLOW);
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 10;
+    ifpi.num_payload_bytes   = ifpi.num_payload_words32 * sizeof(uint32_t);
+    std::vector<uint32_t> data(ifpi.num_payload_words32, 0);
+    xport.push_back_recv_packet<uint32_t, uhd::ENDIANNESS_LITTLE>(ifpi, data);
+
+    test_rx_streamer streamer(make_stream_args());
+    streamer.connect(xport, 100 * sizeof(uint32_t));
+
+    std::vector<std::complex<float>> buff(100);
+    uhd::rx_metadata_t metadata;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        std::cout << "data check " << i << std::endl;
+        const size_t num_samps_ret =
+            streamer.recv(&buff.front(), buff.size(), metadata, 1.0, true);
+        BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+        BOOST_CHECK_EQUAL(num_samps_ret, 10);
+    }
+    BOOST_CHECK_EQUAL(streamer.num_overruns, 0);
+
+    const size_t num_samps_ret =
+        streamer.recv(&buff.front(), buff.size(), metadata, 1.0, true);
+    BOOST_CHECK_EQUAL(num_samps_ret, 0);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_OVERFLOW);
+    BOOST_CHECK(!metadata.out_of_sequence);
+    BOOST_CHECK(metadata.has_time_spec);
+    BOOST_CHECK_EQUAL(metadata.time_spec.to_ticks(SAMP_RATE), NUM_PKTS_TO_TEST * 10);
+    BOOST_CHECK_EQUAL(streamer.num_overruns, 1);
+
+    streamer.recv(&buff.front(), buff.size(), metadata, 0.1, true);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+}
+
+BOOST_AUTO_TEST_CASE(test_vrt_tx_data_xport)
+{
+    constexpr size_t NUM_PKTS_TO_TEST = 5;
+    constexpr size_t NUM_SAMPS        = 20;
+    mock_zero_copy xport(vrt::if_packet_info_t::LINK_TYPE_CHDR);
+    xport.set_reuse_send_memory(false);
+
+    test_tx_streamer streamer(make_stream_args());
+    streamer.connect(xport, 100 * sizeof(uint32_t));
+    BOOST_CHECK_EQUAL(streamer.get_max_num_samps(), 100);
+
+    std::vector<std::complex<float>> buff(NUM_SAMPS);
+    uhd::tx_metadata_t metadata;
+    metadata.start_of_burst = true;
+    metadata.has_time_spec  = true;
+    metadata.time_spec      = uhd::time_spec_t(0.0);
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        metadata.end_of_burst = (i == NUM_PKTS_TO_TEST - 1);
+        const size_t num_sent = streamer.send(&buff.front(), buff.size(), metadata, 1.0);
+        BOOST_CHECK_EQUAL(num_sent, NUM_SAMPS);
+        metadata.start_of_burst = false;
+        metadata.has_time_spec  = false;
+    }
+
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        std::cout << "packet check " << i << std::endl;
+        vrt::if_packet_info_t ifpi;
+        xport.pop_send_packet<uhd::ENDIANNESS_LITTLE>(ifpi);
+        BOOST_CHECK(ifpi.packet_type == vrt::if_packet_info_t::PACKET_TYPE_DATA);
+        BOOST_CHECK_EQUAL(ifpi.sid, TEST_SID);
+        BOOST_CHECK_EQUAL(ifpi.packet_count, i);
+        BOOST_CHECK_EQUAL(ifpi.num_payload_bytes, NUM_SAMPS * sizeof(uint32_t));
+        BOOST_CHECK_EQUAL(ifpi.has_tsf, i == 0);
+        BOOST_CHECK_EQUAL(ifpi.eob, i == NUM_PKTS_TO_TEST - 1);
+    }
+}
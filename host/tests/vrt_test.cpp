@@ -177,3 +177,51 @@ BOOST_AUTO_TEST_CASE(test_with_chdr)
     if_packet_info.num_payload_words32 = 24;
     pack_and_unpack(if_packet_info);
 }
+
+BOOST_AUTO_TEST_CASE(test_with_sid_tsf_le)
+{
+    // The layout of regular data packets, both with and without time
+    for (const bool has_tsf : {true, false}) {
+        vrt::if_packet_info_t if_packet_info;
+        if_packet_info.packet_count        = 5;
+        if_packet_info.has_sid             = true;
+        if_packet_info.has_tsf             = has_tsf;
+        if_packet_info.eob                 = true;
+        if_packet_info.sid                 = 0x12345678;
+        if_packet_info.tsf                 = 0x0123456789abcdefull;
+        if_packet_info.num_payload_words32 = 55;
+        if_packet_info.num_payload_bytes   = 55 * sizeof(uint32_t);
+        uint32_t packet_buff[2048];
+        vrt::if_hdr_pack_le(packet_buff, if_packet_info);
+
+        const size_t num_header_words32 = has_tsf ? 4 : 2;
+        BOOST_CHECK_EQUAL(if_packet_info.num_header_words32, num_header_words32);
+        BOOST_CHECK_EQUAL(if_packet_info.num_packet_words32, num_header_words32 + 55);
+        BOOST_CHECK_EQUAL(uhd::wtohx(packet_buff[0]),
+            uint32_t((1 << 28) | (1 << 24) | (has_tsf ? (1 << 20) : 0) | (5 << 16)
+                     | (num_header_words32 + 55)));
+        BOOST_CHECK_EQUAL(uhd::wtohx(packet_buff[1]), 0x12345678u);
+        if (has_tsf) {
+            BOOST_CHECK_EQUAL(uhd::wtohx(packet_buff[2]), 0x01234567u);
+            BOOST_CHECK_EQUAL(uhd::wtohx(packet_buff[3]), 0x89abcdefu);
+        }
+
+        vrt::if_packet_info_t if_packet_info_out;
+        if_packet_info_out.num_packet_words32 = if_packet_info.num_packet_words32;
+        vrt::if_hdr_unpack_le(packet_buff, if_packet_info_out);
+        BOOST_CHECK_EQUAL(if_packet_info_out.packet_count, 5);
+        BOOST_CHECK(if_packet_info_out.has_sid);
+        BOOST_CHECK_EQUAL(if_packet_info_out.sid, 0x12345678u);
+        BOOST_CHECK_EQUAL(if_packet_info_out.has_tsf, has_tsf);
+        if (has_tsf) {
+            BOOST_CHECK_EQUAL(if_packet_info_out.tsf, 0x0123456789abcdefull);
+        }
+        BOOST_CHECK(not if_packet_info_out.has_tsi);
+        BOOST_CHECK(not if_packet_info_out.has_tlr);
+        BOOST_CHECK(not if_packet_info_out.sob);
+        BOOST_CHECK(if_packet_info_out.eob);
+        BOOST_CHECK_EQUAL(if_packet_info_out.num_header_words32, num_header_words32);
+        BOOST_CHECK_EQUAL(if_packet_info_out.num_payload_words32, 55);
+        BOOST_CHECK_EQUAL(if_packet_info_out.num_payload_bytes, 55 * sizeof(uint32_t));
+    }
+}
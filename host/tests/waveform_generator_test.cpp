@@ -0,0 +1,151 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/math.hpp>
+#include <uhd/utils/waveform_generator.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+using uhd::waveform_generator;
+
+namespace {
+
+constexpr double SAMP_RATE = 1e6;
+
+//! Generates \p nsamps samples, in calls of varying sizes
+std::vector<std::complex<float>> generate(
+    waveform_generator& gen, const size_t nsamps)
+{
+    std::vector<std::complex<float>> samps(nsamps);
+    size_t chunk = 1;
+    for (size_t n = 0; n < nsamps; n += chunk, chunk = chunk * 7 % 601 + 1) {
+        gen.generate(&samps[n], std::min(chunk, nsamps - n));
+    }
+    return samps;
+}
+
+double mean_power_dbfs(const std::vector<std::complex<float>>& samps)
+{
+    double power = 0.0;
+    for (const auto& samp : samps) {
+        power += std::norm(std::complex<double>(samp));
+    }
+    return 10.0 * std::log10(power / samps.size());
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_sine)
+{
+    auto gen = waveform_generator::make(
+        "SINE", SAMP_RATE, uhd::device_addr_t("ampl=0.5,freq=-62500"));
+    const auto samps = generate(*gen, 100000);
+    // The phase doesn't drift over long runs
+    for (size_t n = 0; n < samps.size(); n += 97) {
+        const double phase = -2.0 * uhd::math::PI * double(n % 16) / 16.0;
+        BOOST_CHECK_SMALL(
+            std::abs(std::complex<double>(samps[n]) - std::polar(0.5, phase)), 1e-5);
+    }
+    BOOST_CHECK_CLOSE(gen->get_power(), 20.0 * std::log10(0.5), 1e-6);
+
+    // sc16 output is the same waveform, scaled to full scale
+    gen->reset();
+    std::vector<std::complex<int16_t>> samps_sc16(1000);
+    gen->generate(samps_sc16.data(), samps_sc16.size());
+    for (size_t n = 0; n < samps_sc16.size(); n++) {
+        BOOST_CHECK_LE(std::abs(samps_sc16[n].real() - samps[n].real() * 32767.0f), 1.0);
+        BOOST_CHECK_LE(std::abs(samps_sc16[n].imag() - samps[n].imag() * 32767.0f), 1.0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_chirp)
+{
+    // Sweeps from -100 kHz to 100 kHz in 1000 samples
+    auto gen = waveform_generator::make("CHIRP",
+        SAMP_RATE,
+        uhd::device_addr_t("ampl=1.0,freq=100e3,period=1e-3"));
+    const auto samps = generate(*gen, 2500);
+    for (size_t n = 0; n + 1 < samps.size(); n++) {
+        BOOST_CHECK_CLOSE(std::abs(samps[n]), 1.0, 0.01);
+        // The frequency between two samples, in Hz
+        const double freq = std::arg(std::complex<double>(samps[n + 1])
+                                     * std::conj(std::complex<double>(samps[n])))
+                            * SAMP_RATE / (2.0 * uhd::math::PI);
+        // The sweep restarts after the period, with a continuous phase
+        BOOST_CHECK_CLOSE(freq, -100e3 + 200.0 * (n % 1000 + 0.5), 0.5);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_multitone)
+{
+    auto gen = waveform_generator::make("MULTITONE",
+        SAMP_RATE,
+        uhd::device_addr_t("ampl=0.8,freqs=-100e3:50e3:200e3:300e3"));
+    const auto samps = generate(*gen, 10000);
+    for (const auto& samp : samps) {
+        BOOST_CHECK_LE(std::abs(samp), 0.8 + 1e-5);
+    }
+    BOOST_CHECK_CLOSE(mean_power_dbfs(samps), gen->get_power(), 1.0);
+    BOOST_CHECK_CLOSE(
+        gen->get_power(), 20.0 * std::log10(0.8) - 10.0 * std::log10(4.0), 1e-4);
+
+    BOOST_CHECK_THROW(waveform_generator::make("MULTITONE", SAMP_RATE),
+        uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_noise)
+{
+    auto gen = waveform_generator::make(
+        "NOISE", SAMP_RATE, uhd::device_addr_t("ampl=0.5,seed=42"));
+    const auto samps = generate(*gen, 100000);
+    std::complex<double> mean(0.0, 0.0);
+    for (const auto& samp : samps) {
+        BOOST_CHECK_LT(std::abs(samp.real()), 0.5 + 1e-6);
+        BOOST_CHECK_LT(std::abs(samp.imag()), 0.5 + 1e-6);
+        mean += std::complex<double>(samp);
+    }
+    BOOST_CHECK_SMALL(std::abs(mean / double(samps.size())), 0.01);
+    BOOST_CHECK_CLOSE(mean_power_dbfs(samps), gen->get_power(), 1.0);
+
+    // The noise is reproducible
+    gen->reset();
+    BOOST_CHECK(generate(*gen, 1000) == std::vector<std::complex<float>>(
+                                            samps.begin(), samps.begin() + 1000));
+    auto other = waveform_generator::make(
+        "NOISE", SAMP_RATE, uhd::device_addr_t("ampl=0.5,seed=43"));
+    BOOST_CHECK(generate(*other, 10)[0] != samps[0]);
+}
+
+BOOST_AUTO_TEST_CASE(test_periodic)
+{
+    auto gen = waveform_generator::make(
+        "SQUARE", SAMP_RATE, uhd::device_addr_t("ampl=0.5,freq=250e3"));
+    auto samps = generate(*gen, 8);
+    const float square[] = {0.0f, 0.0f, 0.5f, 0.5f, 0.0f, 0.0f, 0.5f, 0.5f};
+    for (size_t n = 0; n < 8; n++) {
+        BOOST_CHECK_EQUAL(samps[n].real(), square[n]);
+        BOOST_CHECK_EQUAL(samps[n].imag(), 0.0f);
+    }
+
+    gen = waveform_generator::make(
+        "RAMP", SAMP_RATE, uhd::device_addr_t("ampl=0.5,freq=250e3"));
+    samps                = generate(*gen, 5);
+    const float ramp[] = {-0.5f, -0.25f, 0.0f, 0.25f, -0.5f};
+    for (size_t n = 0; n < 5; n++) {
+        BOOST_CHECK_CLOSE(samps[n].real() + 1.0f, ramp[n] + 1.0f, 1e-4);
+    }
+
+    gen = waveform_generator::make("CONST", SAMP_RATE);
+    BOOST_CHECK_CLOSE(generate(*gen, 3)[2].real(), 0.3f, 1e-4);
+
+    BOOST_CHECK_THROW(waveform_generator::make(
+                          "SINE", SAMP_RATE, uhd::device_addr_t("freq=600e3")),
+        uhd::value_error);
+    BOOST_CHECK_THROW(waveform_generator::make("TRIANGLE", SAMP_RATE), uhd::value_error);
+}
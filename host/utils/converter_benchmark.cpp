@@ -9,22 +9,40 @@
 #include <uhd/exception.hpp>
 #include <uhd/types/dict.hpp>
 #include <uhd/utils/safe_main.hpp>
+#include <uhd/utils/thread.hpp>
 #include <stdint.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/program_options.hpp>
+#include <atomic>
 #include <chrono>
 #include <complex>
+#include <exception>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <thread>
+#ifdef __linux__
+#    include <unistd.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#    include <x86intrin.h>
+#    define HAVE_CYCLE_COUNTER
+#elif defined(_M_X64) || defined(_M_IX86)
+#    include <intrin.h>
+#    define HAVE_CYCLE_COUNTER
+#endif
 
 namespace po = boost::program_options;
 using namespace uhd::convert;
 
 enum buf_init_t { RANDOM, INC };
 
+//! Converter benchmark mode
+enum bench_mode_t { SINGLE, SWEEP, REGRESSION };
+
 // Convert `sc16_item32_le' -> `sc16'
 // Finds the first _ in format and returns the string
 // until then. Returns the entire string if no _ is found.
@@ -41,12 +59,16 @@ std::string format_to_type(const std::string& format)
     return ret_val;
 }
 
-void configure_conv(
-    converter::sptr conv, const std::string& in_type, const std::string& out_type)
+void configure_conv(converter::sptr conv,
+    const std::string& in_type,
+    const std::string& out_type,
+    const bool verbose = true)
 {
     if (in_type == "sc16") {
         if (out_type == "fc32") {
-            std::cout << "Setting scalar to 1./32767." << std::endl;
+            if (verbose) {
+                std::cout << "Setting scalar to 1./32767." << std::endl;
+            }
             conv->set_scalar(1. / 32767.);
             return;
         }
@@ -54,13 +76,17 @@ void configure_conv(
 
     if (in_type == "fc32") {
         if (out_type == "sc16") {
-            std::cout << "Setting scalar to 32767." << std::endl;
+            if (verbose) {
+                std::cout << "Setting scalar to 32767." << std::endl;
+            }
             conv->set_scalar(32767.);
             return;
         }
     }
 
-    std::cout << "No configuration required." << std::endl;
+    if (verbose) {
+        std::cout << "No configuration required." << std::endl;
+    }
 }
 
 template <typename T>
@@ -209,6 +235,247 @@ double run_benchmark(converter::sptr conv,
     return duration.count();
 }
 
+static inline uint64_t read_cycle_counter()
+{
+#ifdef HAVE_CYCLE_COUNTER
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+//! Returns the SIMD features of this CPU that converters can make use of
+std::vector<std::string> get_cpu_features()
+{
+    std::vector<std::string> features;
+#if (defined(__GNUC__) || defined(__clang__)) \
+    && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) {
+        features.push_back("sse2");
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        features.push_back("ssse3");
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        features.push_back("sse4.1");
+    }
+    if (__builtin_cpu_supports("avx")) {
+        features.push_back("avx");
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        features.push_back("avx2");
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        features.push_back("avx512f");
+    }
+    if (__builtin_cpu_supports("avx512bw")) {
+        features.push_back("avx512bw");
+    }
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    features.push_back("neon");
+#endif
+    return features;
+}
+
+/*!
+ * Data cache sizes in bytes, as reported by the OS, or typical values if the OS
+ * doesn't report them.
+ */
+struct cache_sizes_t
+{
+    size_t l1d = 32 * 1024;
+    size_t l2  = 1024 * 1024;
+    size_t l3  = 8 * 1024 * 1024;
+};
+
+cache_sizes_t get_cache_sizes()
+{
+    cache_sizes_t sizes;
+#if defined(__linux__) && defined(_SC_LEVEL1_DCACHE_SIZE)
+    auto get_size = [](const int name, const size_t default_size) {
+        const long size = sysconf(name);
+        return (size > 0) ? static_cast<size_t>(size) : default_size;
+    };
+    sizes.l1d = get_size(_SC_LEVEL1_DCACHE_SIZE, sizes.l1d);
+    sizes.l2  = get_size(_SC_LEVEL2_CACHE_SIZE, sizes.l2);
+    sizes.l3  = get_size(_SC_LEVEL3_CACHE_SIZE, sizes.l3);
+#endif
+    return sizes;
+}
+
+/*!
+ * Input sizes at which the buffers (inputs and outputs) fit into the given
+ * cache level, or don't fit into any cache
+ */
+std::vector<std::pair<std::string, size_t>> get_cache_regimes(
+    const cache_sizes_t& caches, const size_t bytes_per_samp)
+{
+    const std::vector<std::pair<std::string, size_t>> footprints{
+        {"L1", caches.l1d / 2},
+        {"L2", caches.l2 / 2},
+        {"L3", caches.l3 / 2},
+        {"DRAM", std::max<size_t>(caches.l3 * 8, 256 * 1024 * 1024)}};
+    std::vector<std::pair<std::string, size_t>> regimes;
+    for (const auto& footprint : footprints) {
+        // Keep the number of samples a multiple of 16, for the packed formats
+        const size_t n_samples = std::max<size_t>(
+            (footprint.second / bytes_per_samp) / 16 * 16, 16);
+        regimes.push_back({footprint.first, n_samples});
+    }
+    return regimes;
+}
+
+struct buffer_setup_t
+{
+    std::string in_type;
+    std::string out_type;
+    size_t n_inputs;
+    size_t n_outputs;
+    buf_init_t seed_mode;
+
+    size_t get_bytes_per_samp() const
+    {
+        return n_inputs * get_bytes_per_item(in_type)
+               + n_outputs * get_bytes_per_item(out_type);
+    }
+};
+
+struct bench_result_t
+{
+    //! Wall clock time of all iterations on all threads, in seconds
+    double duration = 0.0;
+    //! Cycles per thread (at the rate of the timestamp counter), 0 if unknown
+    double cycles         = 0.0;
+    size_t n_samples      = 0;
+    size_t iterations     = 0;
+    size_t n_threads      = 1;
+    size_t bytes_per_samp = 0;
+
+    //! Bytes read and written per second, by all threads
+    double get_gbps() const
+    {
+        return double(bytes_per_samp) * n_samples * iterations * n_threads / duration
+               / 1e9;
+    }
+
+    //! Time per sample of one thread
+    double get_ns_per_samp() const
+    {
+        return duration * 1e9 / (double(n_samples) * iterations);
+    }
+
+    double get_cycles_per_samp() const
+    {
+        return cycles / (double(n_samples) * iterations);
+    }
+};
+
+/*!
+ * Runs a converter on n_threads threads at once, every thread on its own buffers
+ *
+ * With more than one thread, thread N is pinned to CPU N. Every thread
+ * allocates and fills its buffers itself, so they're local to its CPU, and runs
+ * one conversion before the timed ones start, to warm up the caches.
+ */
+bench_result_t run_threaded_benchmark(const std::function<converter::sptr()>& make_conv,
+    const buffer_setup_t& setup,
+    const size_t n_samples,
+    const size_t iterations,
+    const size_t n_threads)
+{
+    std::atomic<size_t> num_ready{0};
+    std::atomic<bool> go{false};
+    std::vector<uint64_t> cycles(n_threads, 0);
+    std::vector<std::exception_ptr> errors(n_threads);
+    std::vector<std::thread> threads;
+
+    for (size_t thread_idx = 0; thread_idx < n_threads; thread_idx++) {
+        threads.emplace_back([&, thread_idx]() {
+            try {
+                if (n_threads > 1) {
+                    uhd::set_thread_affinity({thread_idx});
+                }
+                converter::sptr conv  = make_conv();
+                const size_t in_size  = get_bytes_per_item(setup.in_type);
+                const size_t out_size = get_bytes_per_item(setup.out_type);
+                std::vector<std::vector<char>> input_buffers(
+                    setup.n_inputs, std::vector<char>(in_size * n_samples, 0));
+                std::vector<std::vector<char>> output_buffers(
+                    setup.n_outputs, std::vector<char>(out_size * n_samples, 0));
+                init_buffers(input_buffers, setup.in_type, in_size, setup.seed_mode);
+                std::vector<const void*> input_buf_refs;
+                std::vector<void*> output_buf_refs;
+                for (const auto& buffer : input_buffers) {
+                    input_buf_refs.push_back(buffer.data());
+                }
+                for (auto& buffer : output_buffers) {
+                    output_buf_refs.push_back(buffer.data());
+                }
+                conv->conv(input_buf_refs, output_buf_refs, n_samples);
+
+                num_ready++;
+                while (!go) {
+                    std::this_thread::yield();
+                }
+                const uint64_t start_cycles = read_cycle_counter();
+                for (size_t i = 0; i < iterations; i++) {
+                    conv->conv(input_buf_refs, output_buf_refs, n_samples);
+                }
+                cycles[thread_idx] = read_cycle_counter() - start_cycles;
+            } catch (...) {
+                errors[thread_idx] = std::current_exception();
+                num_ready++;
+            }
+        });
+    }
+
+    while (num_ready < n_threads) {
+        std::this_thread::yield();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    go               = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    bench_result_t result;
+    result.duration = std::chrono::duration<double>(stop - start).count();
+    for (const uint64_t thread_cycles : cycles) {
+        result.cycles += double(thread_cycles) / n_threads;
+    }
+    result.n_samples      = n_samples;
+    result.iterations     = iterations;
+    result.n_threads      = n_threads;
+    result.bytes_per_samp = setup.get_bytes_per_samp();
+    return result;
+}
+
+//! Returns the number of iterations that take about as long as \p duration
+size_t get_iterations_for_duration(const std::function<converter::sptr()>& make_conv,
+    const buffer_setup_t& setup,
+    const size_t n_samples,
+    const double duration)
+{
+    // Run long enough to not just measure the clock
+    size_t iterations = 1;
+    while (true) {
+        const auto result =
+            run_threaded_benchmark(make_conv, setup, n_samples, iterations, 1);
+        if (result.duration > 0.01 || iterations > (1 << 24)) {
+            return std::max<size_t>(1, size_t(duration / result.duration * iterations));
+        }
+        iterations *= 8;
+    }
+}
+
 template <typename T>
 std::string void_ptr_to_hexstring(const void* v_ptr, size_t index)
 {
@@ -266,10 +533,14 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     std::string in_format, out_format;
     std::string priorities;
     std::string seed_mode;
+    std::string mode;
     priority_type prio = -1, max_prio;
     size_t iterations, n_samples;
     size_t n_inputs, n_outputs;
+    size_t n_threads;
+    double duration;
     buf_init_t buf_seed_mode = RANDOM;
+    bench_mode_t bench_mode  = SINGLE;
 
     /// Command line arguments
     po::options_description desc("Converter benchmark options:");
@@ -287,6 +558,9 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         ("debug-converter", "Skip benchmark and print conversion results. Implies iterations==1 and will only run on a single converter.")
         ("seed-mode", po::value<std::string>(&seed_mode)->default_value("random"), "How to initialize the data: random, incremental")
         ("hex", "When using debug mode, dump memory in hex")
+        ("mode", po::value<std::string>(&mode)->default_value("single"), "Benchmark mode: 'single' (one input size), 'sweep' (input sizes that fit into the L1, L2, and L3 caches, or only into DRAM), or 'regression' (sweep all priorities, print JSON)")
+        ("threads", po::value<size_t>(&n_threads)->default_value(1), "Number of threads converting at the same time, each on its own CPU")
+        ("duration", po::value<double>(&duration)->default_value(0.5), "Seconds per measurement in sweep and regression modes")
     ;
     // clang-format on
     po::variables_map vm;
@@ -305,6 +579,11 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
                "MILLISECONDS>\n"
                "  When using for converter debugging, every line is formatted as\n"
                "  <INPUT_VALUE>,<OUTPUT_VALUE>\n"
+               "  The sweep mode outputs one line per priority and input size. The\n"
+               "  regression mode outputs a JSON object with the results of all\n"
+               "  priorities, and the fastest priority for every input size.\n"
+               "  Throughput (GB/s) counts the bytes read and written by all threads.\n"
+               "  Cycles are counted at the rate of the timestamp counter (x86 only).\n"
             << std::endl;
         return EXIT_FAILURE;
     }
@@ -320,11 +599,42 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
             << std::endl;
     }
 
+    if (mode == "single") {
+        bench_mode = SINGLE;
+    } else if (mode == "sweep") {
+        bench_mode = SWEEP;
+    } else if (mode == "regression") {
+        bench_mode = REGRESSION;
+        // Compare every priority there is
+        priorities = "all";
+    } else {
+        std::cout << "Invalid argument: --mode must be 'single', 'sweep', or "
+                     "'regression'."
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (n_threads == 0) {
+        std::cout << "Invalid argument: --threads must be at least 1." << std::endl;
+        return EXIT_FAILURE;
+    }
+
     bool debug_mode = vm.count("debug-converter") > 0;
     if (debug_mode) {
         iterations = 1;
+        bench_mode = SINGLE;
+        n_threads  = 1;
     }
 
+    const std::vector<std::string> cpu_features = get_cpu_features();
+    const cache_sizes_t cache_sizes             = get_cache_sizes();
+    std::cout << "CPU features: "
+              << (cpu_features.empty() ? "none detected"
+                                       : boost::algorithm::join(cpu_features, " "))
+              << std::endl;
+    std::cout << "Data caches: L1 " << cache_sizes.l1d / 1024 << " KiB, L2 "
+              << cache_sizes.l2 / 1024 << " KiB, L3 " << cache_sizes.l3 / 1024 << " KiB"
+              << std::endl;
+
     /// Create the converter(s) //////////////////////////////////////////////
     id_type converter_id;
     converter_id.input_format  = in_format;
@@ -374,20 +684,26 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     const std::string out_type = format_to_type(out_format);
     const size_t in_size       = get_bytes_per_item(in_type);
     const size_t out_size      = get_bytes_per_item(out_type);
-    // Create the buffers and fill them with random data & zeros, respectively
-    std::vector<std::vector<char>> input_buffers(
-        n_inputs, std::vector<char>(in_size * n_samples, 0));
-    std::vector<std::vector<char>> output_buffers(
-        n_outputs, std::vector<char>(out_size * n_samples, 0));
-    init_buffers(input_buffers, in_type, in_size, buf_seed_mode);
-    // Create ref vectors for the converter:
+    const buffer_setup_t buffer_setup{
+        in_type, out_type, n_inputs, n_outputs, buf_seed_mode};
+    // The benchmarks create their own buffers, on their own threads. Debug mode
+    // uses these:
+    std::vector<std::vector<char>> input_buffers;
+    std::vector<std::vector<char>> output_buffers;
     std::vector<const void*> input_buf_refs(n_inputs);
     std::vector<void*> output_buf_refs(n_outputs);
-    for (size_t i = 0; i < n_inputs; i++) {
-        input_buf_refs[i] = reinterpret_cast<const void*>(&input_buffers[i][0]);
-    }
-    for (size_t i = 0; i < n_outputs; i++) {
-        output_buf_refs[i] = reinterpret_cast<void*>(&output_buffers[i][0]);
+    if (debug_mode) {
+        // Create the buffers and fill them with random data & zeros, respectively
+        input_buffers.resize(n_inputs, std::vector<char>(in_size * n_samples, 0));
+        output_buffers.resize(n_outputs, std::vector<char>(out_size * n_samples, 0));
+        init_buffers(input_buffers, in_type, in_size, buf_seed_mode);
+        // Create ref vectors for the converter:
+        for (size_t i = 0; i < n_inputs; i++) {
+            input_buf_refs[i] = reinterpret_cast<const void*>(&input_buffers[i][0]);
+        }
+        for (size_t i = 0; i < n_outputs; i++) {
+            output_buf_refs[i] = reinterpret_cast<void*>(&output_buffers[i][0]);
+        }
     }
 
     /// Final configurations to the converter:
@@ -396,21 +712,113 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         std::cout << "* [" << prio_i << "]: ";
         configure_conv(conv_list[prio_i], in_type, out_type);
     }
+    // Every thread needs a converter of its own
+    auto get_conv_factory = [&](const priority_type prio_i) {
+        return [&, prio_i]() {
+            converter::sptr conv = get_converter(converter_id, prio_i)();
+            configure_conv(conv, in_type, out_type, false);
+            return conv;
+        };
+    };
 
     /// Run the benchmark for every converter ////////////////////////////////
     std::cout << "{{{" << std::endl;
-    if (not debug_mode) {
-        std::cout << "prio,duration_ms,avg_duration_ms,n_samples,iterations" << std::endl;
+    if (not debug_mode && bench_mode == SINGLE) {
+        std::cout << "prio,duration_ms,avg_duration_ms,n_samples,iterations,threads,gbps,"
+                     "cycles_per_samp"
+                  << std::endl;
         for (priority_type prio_i : conv_list.keys()) {
-            double duration = run_benchmark(conv_list[prio_i],
-                input_buf_refs,
-                output_buf_refs,
+            const auto result = run_threaded_benchmark(get_conv_factory(prio_i),
+                buffer_setup,
                 n_samples,
-                iterations);
-            std::cout << boost::format("%i,%d,%d,%d,%d") % prio_i % (duration * 1000)
-                             % (duration * 1000.0 / iterations) % n_samples % iterations
+                iterations,
+                n_threads);
+            std::cout << boost::format("%i,%d,%d,%d,%d,%d,%.3f,%.3f") % prio_i
+                             % (result.duration * 1000)
+                             % (result.duration * 1000.0 / iterations) % n_samples
+                             % iterations % n_threads % result.get_gbps()
+                             % result.get_cycles_per_samp()
+                      << std::endl;
+        }
+    }
+
+    /// Or sweep the input sizes across the cache levels //////////////////////
+    if (bench_mode == SWEEP || bench_mode == REGRESSION) {
+        const auto regimes =
+            get_cache_regimes(cache_sizes, buffer_setup.get_bytes_per_samp());
+        // Results per priority, in the order of the regimes
+        std::map<priority_type, std::vector<bench_result_t>> results;
+        if (bench_mode == SWEEP) {
+            std::cout << "prio,regime,n_samples,footprint_bytes,iterations,threads,gbps,"
+                         "ns_per_samp,cycles_per_samp"
                       << std::endl;
         }
+        for (priority_type prio_i : conv_list.keys()) {
+            for (const auto& regime : regimes) {
+                const auto make_conv           = get_conv_factory(prio_i);
+                const size_t regime_iterations = get_iterations_for_duration(
+                    make_conv, buffer_setup, regime.second, duration);
+                const auto result = run_threaded_benchmark(make_conv,
+                    buffer_setup,
+                    regime.second,
+                    regime_iterations,
+                    n_threads);
+                results[prio_i].push_back(result);
+                if (bench_mode == SWEEP) {
+                    std::cout << boost::format("%i,%s,%d,%d,%d,%d,%.3f,%.4f,%.3f")
+                                     % prio_i % regime.first % regime.second
+                                     % (regime.second * result.bytes_per_samp)
+                                     % regime_iterations % n_threads % result.get_gbps()
+                                     % result.get_ns_per_samp()
+                                     % result.get_cycles_per_samp()
+                              << std::endl;
+                }
+            }
+        }
+
+        if (bench_mode == REGRESSION) {
+            std::cout << "{\n  \"converter\": \"" << converter_id.input_format << "_"
+                      << converter_id.num_inputs << "_" << converter_id.output_format
+                      << "_" << converter_id.num_outputs << "\",\n"
+                      << "  \"cpu_features\": [";
+            for (size_t i = 0; i < cpu_features.size(); i++) {
+                std::cout << (i ? ", " : "") << "\"" << cpu_features[i] << "\"";
+            }
+            std::cout << "],\n  \"caches\": {\"l1d\": " << cache_sizes.l1d
+                      << ", \"l2\": " << cache_sizes.l2 << ", \"l3\": " << cache_sizes.l3
+                      << "},\n  \"threads\": " << n_threads << ",\n  \"results\": [";
+            bool first = true;
+            for (const auto& entry : results) {
+                for (size_t i = 0; i < regimes.size(); i++) {
+                    const auto& result = entry.second[i];
+                    std::cout << (first ? "\n" : ",\n")
+                              << boost::format(
+                                     "    {\"prio\": %i, \"regime\": \"%s\", "
+                                     "\"n_samples\": %d, \"iterations\": %d, "
+                                     "\"gbps\": %.3f, \"ns_per_samp\": %.4f, "
+                                     "\"cycles_per_samp\": %.3f}")
+                                     % entry.first % regimes[i].first
+                                     % result.n_samples % result.iterations
+                                     % result.get_gbps() % result.get_ns_per_samp()
+                                     % result.get_cycles_per_samp();
+                    first = false;
+                }
+            }
+            std::cout << "\n  ],\n  \"fastest\": {";
+            for (size_t i = 0; i < regimes.size(); i++) {
+                priority_type fastest = -1;
+                double best_gbps      = 0.0;
+                for (const auto& entry : results) {
+                    if (entry.second[i].get_gbps() > best_gbps) {
+                        best_gbps = entry.second[i].get_gbps();
+                        fastest   = entry.first;
+                    }
+                }
+                std::cout << (i ? ", " : "") << "\"" << regimes[i].first
+                          << "\": " << fastest;
+            }
+            std::cout << "}\n}" << std::endl;
+        }
     }
 
     /// Or run debug mode, which runs one conversion and prints the results ////
@@ -33,6 +33,12 @@ TABLE_SETUP = {
     'avg_duration_ms': {
         'title': 'Avg. Duration (ms)',
     },
+    'gbps': {
+        'title': 'Throughput (GB/s)',
+    },
+    'cycles_per_samp': {
+        'title': 'Cycles/Sample',
+    },
 }
 
 def run_benchmark(args):
@@ -165,6 +171,19 @@ def setup_argparse():
         "--hex", action='store_true',
         help="In debug mode, display data as hex values.",
     )
+    parser.add_argument(
+        "--mode", choices=('single', 'sweep', 'regression'),
+        help="Benchmark one input size, sweep input sizes across the cache "
+             "levels, or sweep all priorities and print JSON",
+    )
+    parser.add_argument(
+        "--threads", type=int,
+        help="Number of threads converting at the same time",
+    )
+    parser.add_argument(
+        "--duration", type=float,
+        help="Seconds per measurement in sweep and regression modes",
+    )
     return parser
 
 def main():
@@ -175,6 +194,8 @@ def main():
     print(header_out)
     if args.debug_converter:
         print_debug_table(args, csv_output)
+    elif args.mode in ('sweep', 'regression'):
+        print(csv_output.strip())
     else:
         print_stats_table(args, csv_output)
 
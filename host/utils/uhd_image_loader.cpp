@@ -16,6 +16,8 @@
 #include <csignal>
 #include <cstdlib>
 #include <iostream>
+#include <string>
+#include <vector>
 
 namespace fs = boost::filesystem;
 namespace po = boost::program_options;
@@ -52,7 +54,8 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     // clang-format off
     desc.add_options()
         ("help", "help message")
-        ("args", po::value<std::string>()->default_value(""), "Device args, optional loader args")
+        ("args", po::value<std::vector<std::string>>()->composing(), "Device args, optional loader args (repeat to load several devices in parallel)")
+        ("max-parallel", po::value<size_t>()->default_value(0), "Maximum number of devices to load at the same time (0 means no limit)")
         ("fw-path", po::value<std::string>()->default_value(""), "Firmware path (uses default if none specified)")
         ("fpga-path", po::value<std::string>()->default_value(""), "FPGA path (uses default if none specified)")
         ("out-path", po::value<std::string>()->default_value(""), "Output path/filename of the downloaded FPGA .bit file")
@@ -81,7 +84,10 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
 
     // Convert user options
     uhd::image_loader::image_loader_args_t image_loader_args;
-    image_loader_args.args          = vm["args"].as<std::string>();
+    const std::vector<std::string> device_args =
+        vm.count("args") ? vm["args"].as<std::vector<std::string>>()
+                         : std::vector<std::string>{""};
+    image_loader_args.args          = device_args.front();
     image_loader_args.load_firmware = (vm.count("no-fw") == 0);
     image_loader_args.load_fpga     = (vm.count("no-fpga") == 0);
     image_loader_args.download      = (vm.count("download") != 0);
@@ -90,8 +96,13 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     image_loader_args.out_path      = vm["out-path"].as<std::string>();
 
     // Force user to specify a device
-    if (not image_loader_args.args.has_key("type")) {
-        throw uhd::runtime_error("You must specify a device type.");
+    for (const std::string& args : device_args) {
+        if (not uhd::device_addr_t(args).has_key("type")) {
+            throw uhd::runtime_error("You must specify a device type.");
+        }
+    }
+    if (device_args.size() > 1 and image_loader_args.download) {
+        throw uhd::runtime_error("Images can only be downloaded from one device.");
     }
 
     // Clean up paths, if given
@@ -125,6 +136,25 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     device_type = image_loader_args.args.get("type", "");
 
     std::signal(SIGINT, &sigint_handler);
+    if (device_args.size() > 1) {
+        // All devices share the paths, and thus the image files
+        std::vector<uhd::image_loader::image_loader_args_t> all_args;
+        for (const std::string& args : device_args) {
+            all_args.push_back(image_loader_args);
+            all_args.back().args = args;
+        }
+        const std::vector<bool> found = uhd::image_loader::load_all(
+            all_args, vm["max-parallel"].as<size_t>());
+        int ret = EXIT_SUCCESS;
+        for (size_t i = 0; i < found.size(); i++) {
+            if (not found[i]) {
+                std::cerr << "No applicable UHD devices found for: " << device_args[i]
+                          << std::endl;
+                ret = EXIT_FAILURE;
+            }
+        }
+        return ret;
+    }
     if (not uhd::image_loader::load(image_loader_args)) {
         std::cerr << "No applicable UHD devices found" << std::endl;
         return EXIT_FAILURE;
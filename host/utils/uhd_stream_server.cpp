@@ -0,0 +1,133 @@
+//
+// Copyright 2020 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/types/tune_request.hpp>
+#include <uhd/usrp/multi_usrp.hpp>
+#include <uhd/utils/safe_main.hpp>
+#include <uhd/utils/shmem_rx_stream.hpp>
+#include <uhd/utils/thread.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <thread>
+
+namespace po = boost::program_options;
+
+static bool stop_signal_called = false;
+void sig_int_handler(int)
+{
+    stop_signal_called = true;
+}
+
+int UHD_SAFE_MAIN(int argc, char* argv[])
+{
+    std::string args, name, cpu_format, wire_format, channel_list, ant, subdev, ref;
+    double rate, freq, gain;
+    size_t num_packets;
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "help message")
+        ("args", po::value<std::string>(&args)->default_value(""), "multi uhd device address args")
+        ("name", po::value<std::string>(&name)->default_value("usrp"), "name of the stream, clients attach with this name")
+        ("format", po::value<std::string>(&cpu_format)->default_value("fc32"), "CPU sample format (e.g., fc32 or sc16)")
+        ("otw", po::value<std::string>(&wire_format)->default_value("sc16"), "over the wire sample format")
+        ("channels", po::value<std::string>(&channel_list)->default_value("0"), "which channel(s) to use (specify \"0\", \"1\", \"0,1\", etc)")
+        ("packets", po::value<size_t>(&num_packets)->default_value(uhd::shmem_rx_publisher::DEFAULT_NUM_PACKETS), "number of packets in the shared memory ring")
+        ("rate", po::value<double>(&rate)->default_value(1e6), "rate of incoming samples")
+        ("freq", po::value<double>(&freq), "RF center frequency in Hz")
+        ("gain", po::value<double>(&gain), "gain for the RF chain")
+        ("ant", po::value<std::string>(&ant), "antenna selection")
+        ("subdev", po::value<std::string>(&subdev), "subdevice specification")
+        ("ref", po::value<std::string>(&ref), "reference source (internal, external, mimo)")
+    ;
+    // clang-format on
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << boost::format("UHD Stream Server %s") % desc << std::endl;
+        std::cout
+            << std::endl
+            << "Streams from a USRP, and shares the RX stream with other processes.\n"
+               "They read it with a uhd::shmem_rx_streamer of the same name.\n"
+            << std::endl;
+        return ~0;
+    }
+
+    uhd::set_thread_priority_safe();
+
+    std::cout << boost::format("Creating the usrp device with: %s...") % args
+              << std::endl;
+    uhd::usrp::multi_usrp::sptr usrp = uhd::usrp::multi_usrp::make(args);
+    if (vm.count("ref")) {
+        usrp->set_clock_source(ref);
+    }
+    if (vm.count("subdev")) {
+        usrp->set_rx_subdev_spec(subdev);
+    }
+
+    std::vector<std::string> channel_strings;
+    std::vector<size_t> channels;
+    boost::split(channel_strings, channel_list, boost::is_any_of("\"',"));
+    for (const auto& channel : channel_strings) {
+        const size_t chan = std::stoul(channel);
+        if (chan >= usrp->get_rx_num_channels()) {
+            throw std::runtime_error("Invalid channel(s) specified.");
+        }
+        channels.push_back(chan);
+    }
+
+    std::cout << boost::format("Setting RX Rate: %f Msps...") % (rate / 1e6) << std::endl;
+    usrp->set_rx_rate(rate, channels.front());
+    rate = usrp->get_rx_rate(channels.front());
+    std::cout << boost::format("Actual RX Rate: %f Msps...") % (rate / 1e6) << std::endl;
+    for (const size_t chan : channels) {
+        usrp->set_rx_rate(rate, chan);
+        if (vm.count("freq")) {
+            usrp->set_rx_freq(uhd::tune_request_t(freq), chan);
+        }
+        if (vm.count("gain")) {
+            usrp->set_rx_gain(gain, chan);
+        }
+        if (vm.count("ant")) {
+            usrp->set_rx_antenna(ant, chan);
+        }
+    }
+
+    uhd::stream_args_t stream_args(cpu_format, wire_format);
+    stream_args.channels             = channels;
+    uhd::rx_streamer::sptr rx_stream = usrp->get_rx_stream(stream_args);
+    auto publisher =
+        uhd::shmem_rx_publisher::make(rx_stream, cpu_format, rate, name, num_packets);
+
+    uhd::stream_cmd_t stream_cmd(uhd::stream_cmd_t::STREAM_MODE_START_CONTINUOUS);
+    stream_cmd.stream_now = channels.size() == 1;
+    stream_cmd.time_spec  = usrp->get_time_now() + uhd::time_spec_t(0.1);
+    rx_stream->issue_stream_cmd(stream_cmd);
+
+    std::signal(SIGINT, &sig_int_handler);
+    std::cout << boost::format("Serving RX stream \"%s\" (%s, %d channel(s)), press "
+                               "Ctrl + C to stop...")
+                     % name % cpu_format % channels.size()
+              << std::endl;
+    while (not stop_signal_called) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    rx_stream->issue_stream_cmd(uhd::stream_cmd_t::STREAM_MODE_STOP_CONTINUOUS);
+    std::cout << boost::format("Published %d packets") % publisher->get_num_packets()
+              << std::endl;
+    publisher.reset();
+
+    std::cout << std::endl << "Done!" << std::endl << std::endl;
+    return EXIT_SUCCESS;
+}
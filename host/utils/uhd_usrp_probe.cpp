@@ -11,9 +11,11 @@
 #include <uhd/rfnoc_graph.hpp>
 #include <uhd/types/ranges.hpp>
 #include <uhd/types/sensors.hpp>
+#include <uhd/types/time_spec.hpp>
 #include <uhd/usrp/dboard_eeprom.hpp>
 #include <uhd/usrp/dboard_id.hpp>
 #include <uhd/usrp/mboard_eeprom.hpp>
+#include <uhd/usrp/subdev_spec.hpp>
 #include <uhd/utils/cast.hpp>
 #include <uhd/utils/safe_main.hpp>
 #include <uhd/version.hpp>
@@ -21,8 +23,14 @@
 #include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/program_options.hpp>
+#include <cmath>
+#include <complex>
 #include <cstdlib>
+#include <functional>
+#include <future>
+#include <iomanip>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <vector>
 
@@ -209,17 +217,53 @@ static std::string get_rfnoc_connections_pp_string(rfnoc::rfnoc_graph::sptr grap
     return ss.str();
 }
 
+/*! Run get_pp_string(i) for i = 0...num_items-1, and concatenate the results
+ *
+ * With parallel, every item is read on its own thread. Only use that for items
+ * that belong to different motherboards, their properties don't share any
+ * hardware.
+ */
+static std::string get_pp_strings(const size_t num_items,
+    const bool parallel,
+    const std::function<std::string(size_t)>& get_pp_string)
+{
+    std::vector<std::future<std::string>> pp_strings;
+    for (size_t i = 0; i < num_items; i++) {
+        pp_strings.push_back(std::async(
+            parallel ? std::launch::async : std::launch::deferred, get_pp_string, i));
+    }
+    std::string result;
+    for (auto& pp_string : pp_strings) {
+        result += pp_string.get();
+    }
+    return result;
+}
+
 static std::string get_rfnoc_pp_string(
-    rfnoc::rfnoc_graph::sptr graph, property_tree::sptr tree)
+    rfnoc::rfnoc_graph::sptr graph, property_tree::sptr tree, const bool parallel)
 {
     std::stringstream ss;
     ss << make_border(get_rfnoc_blocks_pp_string(graph));
     ss << make_border(get_rfnoc_connections_pp_string(graph));
-    auto radio_blocks = graph->find_blocks("Radio");
-    for (std::string block : radio_blocks) {
-        ss << make_border(get_dboard_pp_string("TX", tree, "blocks" / block / "dboard"));
-        ss << make_border(get_dboard_pp_string("RX", tree, "blocks" / block / "dboard"));
-    }
+    // The radios of one motherboard are read on the same thread
+    std::map<size_t, std::vector<std::string>> mb_radios;
+    for (const rfnoc::block_id_t& block_id : graph->find_blocks("Radio")) {
+        mb_radios[block_id.get_device_no()].push_back(block_id.to_string());
+    }
+    std::vector<std::vector<std::string>> radio_groups;
+    for (const auto& radios : mb_radios) {
+        radio_groups.push_back(radios.second);
+    }
+    ss << get_pp_strings(radio_groups.size(), parallel, [&](const size_t mb_idx) {
+        std::string pp_string;
+        for (const std::string& block : radio_groups[mb_idx]) {
+            pp_string +=
+                make_border(get_dboard_pp_string("TX", tree, "blocks" / block / "dboard"));
+            pp_string +=
+                make_border(get_dboard_pp_string("RX", tree, "blocks" / block / "dboard"));
+        }
+        return pp_string;
+    });
     return ss.str();
 }
 
@@ -305,15 +349,16 @@ static std::string get_mboard_pp_string(property_tree::sptr tree, const fs_path&
 }
 
 
-static std::string get_device_pp_string(property_tree::sptr tree)
+static std::string get_device_pp_string(property_tree::sptr tree, const bool parallel)
 {
     std::stringstream ss;
     ss << boost::format("Device: %s") % (tree->access<std::string>("/name").get())
        << std::endl;
     // ss << std::endl;
-    for (const std::string& name : tree->list("/mboards")) {
-        ss << make_border(get_mboard_pp_string(tree, "/mboards/" + name));
-    }
+    const std::vector<std::string> mboards = tree->list("/mboards");
+    ss << get_pp_strings(mboards.size(), parallel, [&](const size_t mb_idx) {
+        return make_border(get_mboard_pp_string(tree, "/mboards/" + mboards[mb_idx]));
+    });
     return ss.str();
 }
 
@@ -327,6 +372,252 @@ void print_tree(const uhd::fs_path& path, uhd::property_tree::sptr tree)
 
 namespace {
 
+/***********************************************************************
+ * JSON dump of the property tree
+ **********************************************************************/
+std::string to_json(const std::string& str)
+{
+    std::stringstream ss;
+    ss << '"';
+    for (const char c : str) {
+        if (c == '"' || c == '\\') {
+            ss << '\\' << c;
+        } else if (c == '\n') {
+            ss << "\\n";
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            ss << boost::format("\\u%04x") % int(c);
+        } else {
+            ss << c;
+        }
+    }
+    ss << '"';
+    return ss.str();
+}
+
+std::string to_json(const double value)
+{
+    if (!std::isfinite(value)) {
+        return "null";
+    }
+    std::stringstream ss;
+    ss << std::setprecision(15) << value;
+    return ss.str();
+}
+
+std::string to_json(const bool value)
+{
+    return value ? "true" : "false";
+}
+
+std::string to_json(const int value)
+{
+    return std::to_string(value);
+}
+
+std::string to_json(const size_t value)
+{
+    return std::to_string(value);
+}
+
+std::string to_json(const std::complex<double>& value)
+{
+    return "[" + to_json(value.real()) + ", " + to_json(value.imag()) + "]";
+}
+
+std::string to_json(const time_spec_t& value)
+{
+    return to_json(value.get_real_secs());
+}
+
+std::string to_json(const meta_range_t& range)
+{
+    if (range.empty()) {
+        return "null";
+    }
+    return "{\"start\": " + to_json(range.start()) + ", \"stop\": "
+           + to_json(range.stop()) + ", \"step\": " + to_json(range.step()) + "}";
+}
+
+std::string to_json(const sensor_value_t& sensor)
+{
+    return "{\"name\": " + to_json(sensor.name) + ", \"value\": " + to_json(sensor.value)
+           + ", \"unit\": " + to_json(sensor.unit) + "}";
+}
+
+std::string to_json(const usrp::dboard_eeprom_t& eeprom)
+{
+    return "{\"id\": " + to_json(eeprom.id.to_pp_string())
+           + ", \"serial\": " + to_json(eeprom.serial)
+           + ", \"revision\": " + to_json(eeprom.revision) + "}";
+}
+
+std::string to_json(const usrp::subdev_spec_t& spec)
+{
+    return to_json(spec.to_string());
+}
+
+template <typename key_type, typename value_type>
+std::string to_json(const dict<key_type, value_type>& dict)
+{
+    std::string json = "{";
+    for (const auto& key : dict.keys()) {
+        json += (json.size() > 1 ? ", " : "") + to_json(key) + ": " + to_json(dict[key]);
+    }
+    return json + "}";
+}
+
+template <typename T>
+std::string to_json(const std::vector<T>& values)
+{
+    std::string json = "[";
+    for (const auto& value : values) {
+        json += (json.size() > 1 ? ", " : "") + to_json(value);
+    }
+    return json + "]";
+}
+
+/*! Tries to read the property at path as a T, and writes it to json
+ *
+ * \return false if the property is not a T
+ */
+template <typename T>
+bool get_json_value(property_tree::sptr tree, const fs_path& path, std::string& json)
+{
+    property<T>* prop;
+    try {
+        prop = &tree->access<T>(path);
+    } catch (const uhd::runtime_error&) {
+        return false;
+    }
+    if (prop->empty()) {
+        json = "null";
+        return true;
+    }
+    try {
+        json = to_json(prop->get());
+    } catch (const std::exception& ex) {
+        json = "{\"error\": " + to_json(std::string(ex.what())) + "}";
+    }
+    return true;
+}
+
+/*! Returns the value of the property at path as JSON
+ *
+ * Nodes without a property, and properties of types that aren't supported,
+ * are null.
+ */
+std::string get_json_value(property_tree::sptr tree, const fs_path& path)
+{
+    std::string json = "null";
+    // The most common types go first, every miss costs an exception
+    get_json_value<std::string>(tree, path, json)
+        or get_json_value<double>(tree, path, json)
+        or get_json_value<meta_range_t>(tree, path, json)
+        or get_json_value<bool>(tree, path, json)
+        or get_json_value<std::vector<std::string>>(tree, path, json)
+        or get_json_value<sensor_value_t>(tree, path, json)
+        or get_json_value<int>(tree, path, json)
+        or get_json_value<std::complex<double>>(tree, path, json)
+        or get_json_value<usrp::dboard_eeprom_t>(tree, path, json)
+        or get_json_value<time_spec_t>(tree, path, json)
+        or get_json_value<device_addr_t>(tree, path, json)
+        or get_json_value<usrp::subdev_spec_t>(tree, path, json)
+        or get_json_value<usrp::mboard_eeprom_t>(tree, path, json)
+        or get_json_value<std::vector<double>>(tree, path, json)
+        or get_json_value<std::vector<size_t>>(tree, path, json)
+        or get_json_value<size_t>(tree, path, json);
+    return json;
+}
+
+using json_values_t = std::map<std::string, std::string>;
+
+void read_json_values(
+    property_tree::sptr tree, const fs_path& path, json_values_t& values)
+{
+    values[path] = get_json_value(tree, path);
+    for (const std::string& name : tree->list(path)) {
+        read_json_values(tree, path / name, values);
+    }
+}
+
+/*! Reads the values of all properties of the tree
+ *
+ * With parallel, the subtrees of each motherboard (/mboards/N and /blocks/N)
+ * are read on their own thread.
+ */
+json_values_t read_json_values(property_tree::sptr tree, const bool parallel)
+{
+    json_values_t values;
+    std::vector<fs_path> mb_paths;
+    if (parallel) {
+        for (const char* group : {"mboards", "blocks"}) {
+            if (!tree->exists(fs_path("/") / group)) {
+                continue;
+            }
+            for (const std::string& name : tree->list(fs_path("/") / group)) {
+                mb_paths.push_back(fs_path("/") / group / name);
+            }
+        }
+    }
+    std::map<std::string, std::vector<fs_path>> mb_groups;
+    for (const fs_path& path : mb_paths) {
+        mb_groups[path.leaf()].push_back(path);
+    }
+    std::vector<std::future<json_values_t>> mb_values;
+    for (const auto& group : mb_groups) {
+        mb_values.push_back(std::async(std::launch::async, [tree, group]() {
+            json_values_t values;
+            for (const fs_path& path : group.second) {
+                read_json_values(tree, path, values);
+            }
+            return values;
+        }));
+    }
+
+    // Everything else is read on this thread
+    std::function<void(const fs_path&)> read_rest = [&](const fs_path& path) {
+        if (std::find(mb_paths.begin(), mb_paths.end(), path) != mb_paths.end()) {
+            return;
+        }
+        values[path] = get_json_value(tree, path);
+        for (const std::string& name : tree->list(path)) {
+            read_rest(path / name);
+        }
+    };
+    read_rest("/");
+    for (auto& future : mb_values) {
+        const json_values_t group_values = future.get();
+        values.insert(group_values.begin(), group_values.end());
+    }
+    return values;
+}
+
+/*! Writes the property tree as one JSON object, with the paths as keys
+ *
+ * \param values The values of the properties. If empty, only the structure of
+ *               the tree is written, and all values are null.
+ */
+void print_json_tree(const std::string& device_args,
+    property_tree::sptr tree,
+    const json_values_t& values)
+{
+    std::cout << "{\n  \"args\": " << to_json(device_args)
+              << ",\n  \"version\": " << to_json(uhd::get_version_string())
+              << ",\n  \"tree\": {";
+    bool first = true;
+    std::function<void(const fs_path&)> print_node = [&](const fs_path& path) {
+        const auto value = values.find(path);
+        std::cout << (first ? "\n" : ",\n") << "    " << to_json(std::string(path))
+                  << ": " << (value == values.end() ? "null" : value->second);
+        first = false;
+        for (const std::string& name : tree->list(path)) {
+            print_node(path / name);
+        }
+    };
+    print_node("/");
+    std::cout << "\n  }\n}" << std::endl;
+}
+
 uint32_t str2uint32(const std::string& str)
 {
     if (str.find("0x") == 0) {
@@ -403,6 +694,9 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         ("version", "print the version string and exit")
         ("args", po::value<std::string>()->default_value(""), "device address args")
         ("tree", "specify to print a complete property tree")
+        ("json", "print the complete property tree with its values as JSON")
+        ("structure-only", "with --json, only print the structure of the tree and skip all value reads")
+        ("parallel", "read the properties of each motherboard on its own thread")
         ("string", po::value<std::string>(), "query a string value from the property tree")
         ("double", po::value<std::string>(), "query a double precision floating point value from the property tree")
         ("int", po::value<std::string>(), "query a integer value from the property tree")
@@ -495,12 +789,18 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         return EXIT_SUCCESS;
     }
 
+    const bool parallel = vm.count("parallel") != 0;
     if (vm.count("tree") != 0) {
         print_tree("/", tree);
+    } else if (vm.count("json") != 0) {
+        print_json_tree(vm["args"].as<std::string>(),
+            tree,
+            vm.count("structure-only") ? json_values_t()
+                                       : read_json_values(tree, parallel));
     } else if (not vm.count("init-only")) {
-        std::string device_pp_string = get_device_pp_string(tree);
+        std::string device_pp_string = get_device_pp_string(tree, parallel);
         if (graph) {
-            device_pp_string += get_rfnoc_pp_string(graph, tree);
+            device_pp_string += get_rfnoc_pp_string(graph, tree, parallel);
         }
         std::cout << make_border(device_pp_string) << std::endl;
     }
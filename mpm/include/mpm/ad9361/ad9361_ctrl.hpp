@@ -46,6 +46,8 @@ void export_catalina(py::module& top_module)
         .def("set_active_chains", &ad9361_ctrl::set_active_chains)
         .def("set_timing_mode", &ad9361_ctrl::set_timing_mode)
         .def("tune", &ad9361_ctrl::tune)
+        .def("set_hop_set", &ad9361_ctrl::set_hop_set)
+        .def("hop", &ad9361_ctrl::hop)
         .def("set_dc_offset", &ad9361_ctrl::set_dc_offset)
         .def("set_dc_offset_auto", &ad9361_ctrl::set_dc_offset_auto)
         .def("set_iq_balance", &ad9361_ctrl::set_iq_balance)
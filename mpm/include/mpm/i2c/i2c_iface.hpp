@@ -9,6 +9,7 @@
 #include <boost/noncopyable.hpp>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace mpm { namespace i2c {
@@ -53,6 +54,20 @@ public:
      */
     virtual int transfer(
         std::vector<uint8_t>* tx, std::vector<uint8_t>* rx, bool do_close = true) = 0;
+
+    //! A (tx, rx) pair, see batch_transfer()
+    using xfer_t = std::pair<std::vector<uint8_t>, std::vector<uint8_t>>;
+
+    /*!
+     * \param xfers List of (tx, rx) pairs. Every pair is handled like a call to
+     *              transfer() with these vectors.
+     * \param do_close If true, close file descriptor at end of function
+     *
+     * Runs all transactions with as few syscalls as possible. Unlike separate
+     * calls to transfer(), consecutive transactions may be separated by a
+     * repeated start condition instead of a stop condition.
+     */
+    virtual void batch_transfer(std::vector<xfer_t>& xfers, bool do_close = true) = 0;
 };
 
 }}; /* namespace mpm::i2c */
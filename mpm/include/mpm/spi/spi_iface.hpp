@@ -10,6 +10,7 @@
 #include <boost/noncopyable.hpp>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace mpm { namespace spi {
 
@@ -36,6 +37,24 @@ public:
      */
     virtual uint32_t transfer24_16(const uint32_t data) = 0;
 
+    /*! Run a series of transfer24_8() xfers with as few syscalls as possible
+     *
+     * \param data The write data for each xfer
+     *
+     * \return 8 bits worth of the return xfer, for each xfer
+     */
+    virtual std::vector<uint32_t> batch_transfer24_8(
+        const std::vector<uint32_t>& data) = 0;
+
+    /*! Run a series of transfer24_16() xfers with as few syscalls as possible
+     *
+     * \param data The write data for each xfer
+     *
+     * \return 16 bits worth of the return xfer, for each xfer
+     */
+    virtual std::vector<uint32_t> batch_transfer24_16(
+        const std::vector<uint32_t>& data) = 0;
+
     /*!
      * \param device The path to the spidev used (e.g. "/dev/spidev0.0")
      * \param speed_hz Transaction speed in Hz
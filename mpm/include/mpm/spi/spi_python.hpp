@@ -18,5 +18,18 @@ void export_spi(py::module& top_module)
     m.def("make_spidev", &mpm::spi::spi_iface::make_spidev);
 
     py::class_<mpm::spi::spi_iface, std::shared_ptr<mpm::spi::spi_iface>>(m, "spi_iface")
-        .def("transfer24_8", &mpm::spi::spi_iface::transfer24_8);
+        .def("transfer24_8", &mpm::spi::spi_iface::transfer24_8)
+        .def("batch_transfer24_8",
+            [](mpm::spi::spi_iface& self, const py::sequence& py_data) {
+                std::vector<uint32_t> data;
+                data.reserve(py_data.size());
+                for (const auto& py_value : py_data) {
+                    data.push_back(py_value.cast<uint32_t>());
+                }
+                py::list py_results;
+                for (const uint32_t result : self.batch_transfer24_8(data)) {
+                    py_results.append(result);
+                }
+                return py_results;
+            });
 }
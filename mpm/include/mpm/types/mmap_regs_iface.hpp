@@ -10,9 +10,32 @@
 #include <boost/noncopyable.hpp>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace mpm { namespace types {
 
+/*! One step of a register sequence, see mmap_regs_iface::run_sequence()
+ */
+struct reg_op_t
+{
+    enum class op_t {
+        //! Read \p addr
+        PEEK = 0,
+        //! Write \p data to \p addr
+        POKE = 1,
+        //! Read \p addr until the bits in \p mask match \p data
+        POLL = 2,
+        //! Wait for \p timeout_us microseconds
+        SLEEP = 3
+    };
+
+    op_t op;
+    uint32_t addr       = 0;
+    uint32_t data       = 0;
+    uint32_t mask       = 0xFFFFFFFF;
+    uint32_t timeout_us = 0;
+};
+
 class mmap_regs_iface : public boost::noncopyable
 {
 public:
@@ -37,6 +60,19 @@ public:
     //! Read data from \p addr
     uint32_t peek32(const uint32_t addr);
 
+    /*! Run a sequence of register accesses in one go
+     *
+     * This saves the per-access overhead of calling peek32() and poke32() from
+     * Python for long init sequences.
+     *
+     * \returns the values read by the PEEK and POLL steps, in order. For POLL
+     *          steps, this is the last value that was read.
+     * \throws mpm::runtime_error if a POLL step does not match within its
+     *         timeout. The steps after it are not run.
+     * \throws mpm::value_error if an address is outside of the mapped region
+     */
+    std::vector<uint32_t> run_sequence(const std::vector<reg_op_t>& ops);
+
 private:
     void log(mpm::types::log_level_t level, const std::string path, const char* comment);
 
@@ -7,7 +7,10 @@
 #pragma once
 
 #include <boost/noncopyable.hpp>
+#include <cstdint>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace mpm { namespace types {
 
@@ -33,6 +36,57 @@ public:
     /*! Write a 16-bit value to a given address
      */
     virtual void poke16(const uint32_t addr, const uint16_t data) = 0;
+
+    /*! Return the 8-bit values from a list of addresses
+     *
+     * The default implementation calls peek8() for every address. Implementations
+     * may batch the accesses, so they take fewer bus transactions.
+     */
+    virtual std::vector<uint8_t> peeks8(const std::vector<uint32_t>& addrs)
+    {
+        std::vector<uint8_t> result;
+        result.reserve(addrs.size());
+        for (const uint32_t addr : addrs) {
+            result.push_back(peek8(addr));
+        }
+        return result;
+    }
+
+    /*! Write a list of (address, 8-bit value) pairs, in order
+     *
+     * The default implementation calls poke8() for every pair.
+     */
+    virtual void pokes8(const std::vector<std::pair<uint32_t, uint8_t>>& addr_vals)
+    {
+        for (const auto& addr_val : addr_vals) {
+            poke8(addr_val.first, addr_val.second);
+        }
+    }
+
+    /*! Return the 16-bit values from a list of addresses
+     *
+     * The default implementation calls peek16() for every address.
+     */
+    virtual std::vector<uint16_t> peeks16(const std::vector<uint32_t>& addrs)
+    {
+        std::vector<uint16_t> result;
+        result.reserve(addrs.size());
+        for (const uint32_t addr : addrs) {
+            result.push_back(peek16(addr));
+        }
+        return result;
+    }
+
+    /*! Write a list of (address, 16-bit value) pairs, in order
+     *
+     * The default implementation calls poke16() for every pair.
+     */
+    virtual void pokes16(const std::vector<std::pair<uint32_t, uint16_t>>& addr_vals)
+    {
+        for (const auto& addr_val : addr_vals) {
+            poke16(addr_val.first, addr_val.second);
+        }
+    }
 };
 
 }}; // namespace mpm::types
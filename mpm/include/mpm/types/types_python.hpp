@@ -12,6 +12,30 @@
 #include "mmap_regs_iface.hpp"
 #include "regs_iface.hpp"
 
+//! Convert a Python list of register addresses
+std::vector<uint32_t> _to_addrs(const py::sequence& py_addrs)
+{
+    std::vector<uint32_t> addrs;
+    addrs.reserve(py_addrs.size());
+    for (const auto& py_addr : py_addrs) {
+        addrs.push_back(py_addr.cast<uint32_t>());
+    }
+    return addrs;
+}
+
+//! Convert a Python list of (address, value) pairs
+template <typename data_t>
+std::vector<std::pair<uint32_t, data_t>> _to_addr_vals(const py::sequence& py_addr_vals)
+{
+    std::vector<std::pair<uint32_t, data_t>> addr_vals;
+    addr_vals.reserve(py_addr_vals.size());
+    for (const auto& py_addr_val : py_addr_vals) {
+        const auto addr_val = py_addr_val.cast<py::sequence>();
+        addr_vals.emplace_back(addr_val[0].cast<uint32_t>(), addr_val[1].cast<data_t>());
+    }
+    return addr_vals;
+}
+
 void export_types(py::module& top_module)
 {
     using namespace mpm::types;
@@ -21,11 +45,36 @@ void export_types(py::module& top_module)
         .def("lock", &lockable::lock)
         .def("unlock", &lockable::unlock);
 
+    // The batched accesses take a list of addresses, or a list of
+    // (address, value) pairs
     py::class_<regs_iface, std::shared_ptr<regs_iface>>(m, "regs_iface")
         .def("peek8", &regs_iface::peek8)
         .def("poke8", &regs_iface::poke8)
         .def("peek16", &regs_iface::peek16)
-        .def("poke16", &regs_iface::poke16);
+        .def("poke16", &regs_iface::poke16)
+        .def("peeks8",
+            [](regs_iface& self, const py::sequence& py_addrs) {
+                py::list py_results;
+                for (const uint8_t result : self.peeks8(_to_addrs(py_addrs))) {
+                    py_results.append(result);
+                }
+                return py_results;
+            })
+        .def("pokes8",
+            [](regs_iface& self, const py::sequence& py_addr_vals) {
+                self.pokes8(_to_addr_vals<uint8_t>(py_addr_vals));
+            })
+        .def("peeks16",
+            [](regs_iface& self, const py::sequence& py_addrs) {
+                py::list py_results;
+                for (const uint16_t result : self.peeks16(_to_addrs(py_addrs))) {
+                    py_results.append(result);
+                }
+                return py_results;
+            })
+        .def("pokes16", [](regs_iface& self, const py::sequence& py_addr_vals) {
+            self.pokes16(_to_addr_vals<uint16_t>(py_addr_vals));
+        });
 
     py::class_<log_buf, std::shared_ptr<log_buf>>(m, "log_buf")
         .def_static("make_singleton", &log_buf::make_singleton)
@@ -43,5 +92,32 @@ void export_types(py::module& top_module)
         .def("open", &mmap_regs_iface::open)
         .def("close", &mmap_regs_iface::close)
         .def("peek32", &mmap_regs_iface::peek32)
-        .def("poke32", &mmap_regs_iface::poke32);
+        .def("poke32", &mmap_regs_iface::poke32)
+        // Takes a list of (op, addr, data, mask, timeout_us) tuples, see
+        // usrp_mpm.sys_utils.reg_sequence
+        .def("run_sequence", [](mmap_regs_iface& self, const py::list& py_ops) {
+            std::vector<reg_op_t> ops;
+            ops.reserve(py_ops.size());
+            for (const auto& py_op : py_ops) {
+                const auto op_tuple = py_op.cast<py::tuple>();
+                reg_op_t op;
+                op.op         = static_cast<reg_op_t::op_t>(op_tuple[0].cast<int>());
+                op.addr       = op_tuple[1].cast<uint32_t>();
+                op.data       = op_tuple[2].cast<uint32_t>();
+                op.mask       = op_tuple[3].cast<uint32_t>();
+                op.timeout_us = op_tuple[4].cast<uint32_t>();
+                ops.push_back(op);
+            }
+            // Release the GIL, polls and sleeps may take a while
+            std::vector<uint32_t> results;
+            {
+                py::gil_scoped_release release;
+                results = self.run_sequence(ops);
+            }
+            py::list py_results;
+            for (const uint32_t result : results) {
+                py_results.append(result);
+            }
+            return py_results;
+        });
 }
@@ -93,7 +93,80 @@ public:
         }
     }
 
+    std::vector<uint8_t> peeks8(const std::vector<uint32_t>& addrs)
+    {
+        std::vector<mpm::i2c::i2c_iface::xfer_t> xfers;
+        xfers.reserve(addrs.size());
+        for (const uint32_t addr : addrs) {
+            xfers.emplace_back(_addr_bytes(addr), std::vector<uint8_t>(1));
+        }
+
+        _i2c_iface->batch_transfer(xfers);
+
+        std::vector<uint8_t> result;
+        result.reserve(xfers.size());
+        for (const auto& xfer : xfers) {
+            result.push_back(xfer.second[0]);
+        }
+        return result;
+    }
+
+    void pokes8(const std::vector<std::pair<uint32_t, uint8_t>>& addr_vals)
+    {
+        std::vector<mpm::i2c::i2c_iface::xfer_t> xfers;
+        xfers.reserve(addr_vals.size());
+        for (const auto& addr_val : addr_vals) {
+            std::vector<uint8_t> tx = _addr_bytes(addr_val.first);
+            tx.push_back(addr_val.second);
+            xfers.emplace_back(std::move(tx), std::vector<uint8_t>());
+        }
+
+        _i2c_iface->batch_transfer(xfers);
+    }
+
+    std::vector<uint16_t> peeks16(const std::vector<uint32_t>& addrs)
+    {
+        std::vector<mpm::i2c::i2c_iface::xfer_t> xfers;
+        xfers.reserve(addrs.size());
+        for (const uint32_t addr : addrs) {
+            xfers.emplace_back(_addr_bytes(addr), std::vector<uint8_t>(2));
+        }
+
+        _i2c_iface->batch_transfer(xfers);
+
+        std::vector<uint16_t> result;
+        result.reserve(xfers.size());
+        for (const auto& xfer : xfers) {
+            result.push_back(uint16_t(xfer.second[0]) << 8 | xfer.second[1]);
+        }
+        return result;
+    }
+
+    void pokes16(const std::vector<std::pair<uint32_t, uint16_t>>& addr_vals)
+    {
+        std::vector<mpm::i2c::i2c_iface::xfer_t> xfers;
+        xfers.reserve(addr_vals.size());
+        for (const auto& addr_val : addr_vals) {
+            std::vector<uint8_t> tx = _addr_bytes(addr_val.first);
+            tx.push_back((addr_val.second >> 8) & 0xff);
+            tx.push_back(addr_val.second & 0xff);
+            xfers.emplace_back(std::move(tx), std::vector<uint8_t>());
+        }
+
+        _i2c_iface->batch_transfer(xfers);
+    }
+
 private:
+    //! Return the register address as it goes on the bus, MSB first
+    std::vector<uint8_t> _addr_bytes(const uint32_t addr) const
+    {
+        std::vector<uint8_t> tx(_reg_addr_size);
+        for (size_t i = 0; i < _reg_addr_size; i++) {
+            tx[i] = 0xff & (addr >> 8 * (_reg_addr_size - i - 1));
+        }
+        return tx;
+    }
+
     mpm::i2c::i2c_iface::sptr _i2c_iface;
 
     const size_t _reg_addr_size;
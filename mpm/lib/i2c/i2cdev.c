@@ -83,3 +83,52 @@ int i2cdev_transfer(int fd, uint16_t addr, int ten_bit_addr,
     return 0;
 }
 
+int i2cdev_transfer_batch(int fd, uint16_t addr, int ten_bit_addr,
+                          uint8_t **txs, size_t *tx_lens,
+                          uint8_t **rxs, size_t *rx_lens,
+                          size_t num_xfers)
+{
+    int err;
+    struct i2c_msg msgs[I2C_RDWR_IOCTL_MAX_MSGS];
+    size_t xfer = 0;
+    const uint16_t flags = ten_bit_addr ? I2C_M_TEN : 0;
+
+    while (xfer < num_xfers) {
+        int num_msgs = 0;
+        struct i2c_rdwr_ioctl_data i2c_data = {
+            .msgs = msgs,
+        };
+
+        // Fill up one ioctl, without splitting a transfer across two of them
+        while (xfer < num_xfers && num_msgs + 2 <= I2C_RDWR_IOCTL_MAX_MSGS) {
+            if (txs[xfer] && tx_lens[xfer] > 0) {
+                msgs[num_msgs].addr = addr;
+                msgs[num_msgs].buf = txs[xfer];
+                msgs[num_msgs].len = tx_lens[xfer];
+                msgs[num_msgs].flags = flags;
+                num_msgs++;
+            }
+            if (rxs[xfer] && rx_lens[xfer] > 0) {
+                msgs[num_msgs].addr = addr;
+                msgs[num_msgs].buf = rxs[xfer];
+                msgs[num_msgs].len = rx_lens[xfer];
+                msgs[num_msgs].flags = flags | I2C_M_RD;
+                num_msgs++;
+            }
+            xfer++;
+        }
+
+        i2c_data.nmsgs = num_msgs;
+        if (num_msgs <= 0)
+            continue;
+
+        err = ioctl(fd, I2C_RDWR, &i2c_data);
+        if (err < 0) {
+            fprintf(stderr, "%s: Failed I2C_RDWR: %d\n", __func__, err);
+            perror("ioctl: \n");
+            return err;
+        }
+    }
+
+    return 0;
+}
@@ -52,6 +52,29 @@ int i2cdev_open(int *fd, const char *device, const unsigned int timeout_ms);
 int i2cdev_transfer(int fd, uint16_t addr, int ten_bit_addr,
                     uint8_t *tx, size_t tx_len,
                     uint8_t *rx, size_t rx_len);
+
+/*! Do a series of i2c transactions over i2cdev, in as few ioctls as possible
+ * Every transaction is a write of tx_lens[i] bytes from txs[i], followed by
+ * a read of rx_lens[i] bytes into rxs[i], like i2cdev_transfer(). Either one
+ * may be empty.
+ * Transactions within the same ioctl are separated by repeated start
+ * conditions, not stop conditions, so the device must support that.
+ *
+ * \param fd File descriptor for the i2cdev bus segment
+ * \param addr i2c device address
+ * \param ten_bit_addr Nonzero if true (typically 0)
+ * \param txs Buffers of data to be written to device
+ * \param tx_lens Number of non-addr bytes to be written, for each transaction
+ * \param rxs Buffers where read data can be stored
+ * \param rx_lens Number of bytes to be read, for each transaction
+ * \param num_xfers Number of transactions
+ *
+ * \returns 0 if all is golden
+ */
+int i2cdev_transfer_batch(int fd, uint16_t addr, int ten_bit_addr,
+                          uint8_t **txs, size_t *tx_lens,
+                          uint8_t **rxs, size_t *rx_lens,
+                          size_t num_xfers);
 #ifdef __cplusplus
 }
 #endif
@@ -83,6 +83,40 @@ public:
         return ret;
     }
 
+    void batch_transfer(std::vector<xfer_t>& xfers, bool do_close)
+    {
+        std::vector<uint8_t*> txs, rxs;
+        std::vector<size_t> tx_lens, rx_lens;
+        for (auto& xfer : xfers) {
+            txs.push_back(xfer.first.data());
+            tx_lens.push_back(xfer.first.size());
+            rxs.push_back(xfer.second.data());
+            rx_lens.push_back(xfer.second.size());
+        }
+
+        if (_fd < 0) {
+            _open();
+        }
+
+        int ret = i2cdev_transfer_batch(_fd,
+            _addr,
+            _ten_bit_addr,
+            txs.data(),
+            tx_lens.data(),
+            rxs.data(),
+            rx_lens.data(),
+            xfers.size());
+
+        if (do_close) {
+            close(_fd);
+            _fd = -ENODEV;
+        }
+
+        if (ret) {
+            throw mpm::runtime_error("I2C Transaction failed!");
+        }
+    }
+
 private:
     const std::string _device;
     int _fd;
@@ -72,6 +72,54 @@ public:
         _spi_iface->transfer24_16(transaction);
     }
 
+    std::vector<uint8_t> peeks8(const std::vector<uint32_t>& addrs)
+    {
+        std::vector<uint32_t> transactions;
+        transactions.reserve(addrs.size());
+        for (const uint32_t addr : addrs) {
+            transactions.push_back(0 | (addr << _addr_shift) | _read_flags);
+        }
+
+        const auto data = _spi_iface->batch_transfer24_8(transactions);
+        return std::vector<uint8_t>(data.cbegin(), data.cend());
+    }
+
+    void pokes8(const std::vector<std::pair<uint32_t, uint8_t>>& addr_vals)
+    {
+        std::vector<uint32_t> transactions;
+        transactions.reserve(addr_vals.size());
+        for (const auto& addr_val : addr_vals) {
+            transactions.push_back(0 | _write_flags | (addr_val.first << _addr_shift)
+                                   | (addr_val.second << _data_shift));
+        }
+
+        _spi_iface->batch_transfer24_8(transactions);
+    }
+
+    std::vector<uint16_t> peeks16(const std::vector<uint32_t>& addrs)
+    {
+        std::vector<uint32_t> transactions;
+        transactions.reserve(addrs.size());
+        for (const uint32_t addr : addrs) {
+            transactions.push_back(0 | (addr << _addr_shift) | _read_flags);
+        }
+
+        const auto data = _spi_iface->batch_transfer24_16(transactions);
+        return std::vector<uint16_t>(data.cbegin(), data.cend());
+    }
+
+    void pokes16(const std::vector<std::pair<uint32_t, uint16_t>>& addr_vals)
+    {
+        std::vector<uint32_t> transactions;
+        transactions.reserve(addr_vals.size());
+        for (const auto& addr_val : addr_vals) {
+            transactions.push_back(0 | _write_flags | (addr_val.first << _addr_shift)
+                                   | (addr_val.second << _data_shift));
+        }
+
+        _spi_iface->batch_transfer24_16(transactions);
+    }
+
 private:
     mpm::spi::spi_iface::sptr _spi_iface;
 
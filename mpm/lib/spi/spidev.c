@@ -138,3 +138,40 @@ int transfer(
     return 0;
 }
 
+
+int transfer_batch(
+        int fd,
+        uint8_t *tx, uint8_t *rx, uint32_t len, uint32_t num_xfers,
+        uint32_t speed_hz, uint8_t bits_per_word, uint16_t delay_us
+) {
+    int err;
+    uint32_t i;
+
+    if (num_xfers == 0 || num_xfers > SPI_MAX_BATCH_SIZE) {
+        return -EINVAL;
+    }
+
+    struct spi_ioc_transfer tr[SPI_MAX_BATCH_SIZE];
+    memset(tr, 0, num_xfers * sizeof(struct spi_ioc_transfer));
+    for (i = 0; i < num_xfers; i++) {
+        tr[i].tx_buf = (unsigned long) (tx + i * len);
+        tr[i].rx_buf = (unsigned long) (rx + i * len);
+        tr[i].len = len;
+        tr[i].speed_hz = speed_hz;
+        tr[i].delay_usecs = delay_us;
+        tr[i].bits_per_word = bits_per_word;
+        // Deassert chip select between transfers, but not after the last one
+        tr[i].cs_change = (i + 1 < num_xfers) ? 1 : 0;
+        tr[i].tx_nbits = 1; // Standard SPI
+        tr[i].rx_nbits = 1; // Standard SPI
+    }
+
+    err = ioctl(fd, SPI_IOC_MESSAGE(num_xfers), tr);
+    if (err < 0) {
+        fprintf(stderr, "%s: Failed ioctl: %d\n", __func__, err);
+        perror("ioctl: \n");
+        return err;
+    }
+
+    return 0;
+}
@@ -43,3 +43,32 @@ int transfer(
         uint32_t speed_hz, uint8_t bits_per_word, uint16_t delay_us
 );
 
+/*! Maximum number of transfers per call to transfer_batch()
+ *
+ * The size of the transfer array is limited by the size field of the ioctl
+ * number, and spidev limits the total number of bytes per message.
+ */
+#define SPI_MAX_BATCH_SIZE 256
+
+/*! Do a series of SPI transactions over spidev, in a single ioctl
+ *
+ * The chip select is deasserted between the transactions, so this behaves
+ * like calling transfer() num_xfers times.
+ *
+ * \param tx Buffer of data to be written, num_xfers * len bytes
+ * \param rx Must match tx buffer length; result will be written here
+ * \param len Number of bytes per transaction
+ * \param num_xfers Number of transactions, at most SPI_MAX_BATCH_SIZE
+ * \param speed_hz Speed of the transactions in Hz
+ * \param bits_per_word 8, dude
+ * \param delay_us Delay between transfers
+ *
+ * Assumption: spidev was configured properly beforehand.
+ *
+ * \returns 0 if all is golden
+ */
+int transfer_batch(
+        int fd,
+        uint8_t *tx, uint8_t *rx, uint32_t len, uint32_t num_xfers,
+        uint32_t speed_hz, uint8_t bits_per_word, uint16_t delay_us
+);
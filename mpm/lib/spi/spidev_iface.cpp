@@ -13,6 +13,7 @@ extern "C" {
 #include <fcntl.h>
 #include <linux/spi/spidev.h>
 #include <boost/format.hpp>
+#include <algorithm>
 #include <iostream>
 
 using namespace mpm::spi;
@@ -79,7 +80,61 @@ public:
         return uint32_t(rx[1] << 8 | rx[2]);
     }
 
+    std::vector<uint32_t> batch_transfer24_8(const std::vector<uint32_t>& data)
+    {
+        std::vector<uint32_t> result = batch_transfer24(data);
+        for (auto& value : result) {
+            value &= 0xFF;
+        }
+        return result;
+    }
+
+    std::vector<uint32_t> batch_transfer24_16(const std::vector<uint32_t>& data)
+    {
+        std::vector<uint32_t> result = batch_transfer24(data);
+        for (auto& value : result) {
+            value &= 0xFFFF;
+        }
+        return result;
+    }
+
 private:
+    //! Run 24-bit xfers, SPI_MAX_BATCH_SIZE per ioctl. Returns the full readback.
+    std::vector<uint32_t> batch_transfer24(const std::vector<uint32_t>& data)
+    {
+        constexpr size_t XFER_LEN = 3;
+        std::vector<uint8_t> tx(data.size() * XFER_LEN);
+        std::vector<uint8_t> rx(tx.size());
+        for (size_t i = 0; i < data.size(); i++) {
+            tx[i * XFER_LEN]     = (data[i] >> 16) & 0xFF;
+            tx[i * XFER_LEN + 1] = (data[i] >> 8) & 0xFF;
+            tx[i * XFER_LEN + 2] = data[i] & 0xFF;
+        }
+
+        for (size_t offset = 0; offset < data.size(); offset += SPI_MAX_BATCH_SIZE) {
+            const uint32_t num_xfers =
+                std::min<size_t>(SPI_MAX_BATCH_SIZE, data.size() - offset);
+            if (transfer_batch(_fd,
+                    &tx[offset * XFER_LEN],
+                    &rx[offset * XFER_LEN],
+                    XFER_LEN,
+                    num_xfers,
+                    _speed,
+                    _bits,
+                    _delay)
+                != 0) {
+                throw mpm::runtime_error(str(boost::format("SPI Transaction failed!")));
+            }
+        }
+
+        std::vector<uint32_t> result(data.size());
+        for (size_t i = 0; i < data.size(); i++) {
+            result[i] = uint32_t(rx[i * XFER_LEN]) << 16
+                        | uint32_t(rx[i * XFER_LEN + 1]) << 8 | rx[i * XFER_LEN + 2];
+        }
+        return result;
+    }
+
     int _fd;
     const uint32_t _mode;
     uint32_t _speed = 2000000;
@@ -12,8 +12,10 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <boost/format.hpp>
+#include <chrono>
 #include <iostream>
 #include <sstream>
+#include <thread>
 
 using namespace mpm::types;
 
@@ -93,6 +95,52 @@ uint32_t mmap_regs_iface::peek32(const uint32_t addr)
     return _mmap[addr / sizeof(uint32_t)];
 }
 
+std::vector<uint32_t> mmap_regs_iface::run_sequence(const std::vector<reg_op_t>& ops)
+{
+    MPM_ASSERT_THROW(_mmap);
+    // The registers may change under our feet, so make sure every access in
+    // the sequence actually goes out to the bus
+    volatile uint32_t* regs = _mmap;
+    std::vector<uint32_t> results;
+    for (const auto& op : ops) {
+        if (op.op != reg_op_t::op_t::SLEEP && op.addr + sizeof(uint32_t) > _length) {
+            throw mpm::value_error(
+                str(boost::format("Register address 0x%X is out of range!") % op.addr));
+        }
+        switch (op.op) {
+            case reg_op_t::op_t::PEEK:
+                results.push_back(uint32_t(regs[op.addr / sizeof(uint32_t)]));
+                break;
+            case reg_op_t::op_t::POKE:
+                regs[op.addr / sizeof(uint32_t)] = op.data;
+                break;
+            case reg_op_t::op_t::POLL: {
+                const auto deadline = std::chrono::steady_clock::now()
+                                      + std::chrono::microseconds(op.timeout_us);
+                uint32_t value = regs[op.addr / sizeof(uint32_t)];
+                while ((value & op.mask) != (op.data & op.mask)) {
+                    if (std::chrono::steady_clock::now() > deadline) {
+                        throw mpm::runtime_error(
+                            str(boost::format("Timeout polling register 0x%X "
+                                              "(Readback: 0x%X, expected: 0x%X)")
+                                % op.addr % (value & op.mask) % (op.data & op.mask)));
+                    }
+                    std::this_thread::sleep_for(std::chrono::microseconds(10));
+                    value = regs[op.addr / sizeof(uint32_t)];
+                }
+                results.push_back(value);
+                break;
+            }
+            case reg_op_t::op_t::SLEEP:
+                std::this_thread::sleep_for(std::chrono::microseconds(op.timeout_us));
+                break;
+            default:
+                throw mpm::value_error("Invalid register sequence operation!");
+        }
+    }
+    return results;
+}
+
 void mmap_regs_iface::log(
     mpm::types::log_level_t level, const std::string path, const char* comment)
 {
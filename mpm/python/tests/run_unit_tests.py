@@ -10,8 +10,9 @@ USRP MPM Python Unit testing framework
 import unittest
 import sys
 import argparse
-from sys_utils_tests import TestNet
+from sys_utils_tests import TestNet, TestRegSequence
 from mpm_utils_tests import TestMpmUtils
+from telemetry_tests import TestTelemetry
 
 import importlib.util
 if importlib.util.find_spec("xmlrunner"):
@@ -20,7 +21,9 @@ if importlib.util.find_spec("xmlrunner"):
 TESTS = {
     '__all__': {
         TestNet,
+        TestRegSequence,
         TestMpmUtils,
+        TestTelemetry,
     },
     'n3xx': set(),
 }
@@ -10,6 +10,7 @@ Tests related to usrp_mpm.sys_utils
 from base_tests import TestBase
 import unittest
 from usrp_mpm.sys_utils import net
+from usrp_mpm.sys_utils.reg_sequence import RegSequence
 import platform
 
 
@@ -133,5 +134,54 @@ class TestNet(TestBase):
         expected_string = '2F:16:AB:BF:90:63'
         self.assertEqual(expected_string, net.byte_to_mac(byte_str).upper())
 
+
+class TestRegSequence(TestBase):
+    """
+    Tests usrp_mpm.sys_utils.reg_sequence on a register interface that only
+    provides peek32() and poke32()
+    """
+    class FakeRegs(object):
+        """
+        Registers that count up on every read of address 0x4
+        """
+        def __init__(self):
+            self.regs = {0x4: 0}
+            self.accesses = []
+
+        def peek32(self, addr):
+            self.accesses.append(('peek', addr))
+            if addr == 0x4:
+                self.regs[addr] += 1
+            return self.regs.get(addr, 0)
+
+        def poke32(self, addr, val):
+            self.accesses.append(('poke', addr, val))
+            self.regs[addr] = val
+
+    def test_run(self):
+        """
+        Test that the steps run in order, and that the peek and poll results
+        are returned.
+        """
+        regs = self.FakeRegs()
+        seq = RegSequence()
+        seq.poke32(0x0, 0x123456789)
+        seq.peek32(0x0)
+        seq.poll32(0x4, 0x3, mask=0xF, timeout=1.0)
+        seq.sleep(0.001)
+        self.assertEqual(seq.run(regs), [0x23456789, 3])
+        self.assertEqual(regs.accesses[:2], [('poke', 0x0, 0x23456789), ('peek', 0x0)])
+        self.assertEqual(len(regs.accesses), 5)
+
+    def test_poll_timeout(self):
+        """
+        Test that a poll that doesn't match raises, and the following steps are
+        not run.
+        """
+        regs = self.FakeRegs()
+        seq = RegSequence().poll32(0x0, 0x1, timeout=0.001).poke32(0x8, 0x1)
+        self.assertRaises(RuntimeError, seq.run, regs)
+        self.assertNotIn(0x8, regs.regs)
+
 if __name__ == '__main__':
     unittest.main()
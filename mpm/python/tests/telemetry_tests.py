@@ -0,0 +1,88 @@
+#
+# Copyright 2020 Ettus Research, a National Instruments Brand
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+"""
+Tests for the telemetry publisher
+"""
+
+import socket
+import unittest
+from base_tests import TestBase
+from usrp_mpm import telemetry
+from usrp_mpm.mpmlog import get_main_logger
+
+TEST_VALUES = {
+    'ref_locked': {
+        'name': 'ref_locked', 'type': 'BOOLEAN', 'unit': 'locked',
+        'value': 'true'},
+    'temp': {
+        'name': 'temperature', 'type': 'REALNUM', 'unit': 'C',
+        'value': '42.5'},
+    'fan': {
+        'name': 'cooling fan', 'type': 'INTEGER', 'unit': 'rpm',
+        'value': '3000'},
+}
+
+
+class TestTelemetry(TestBase):
+    """
+    Tests for the telemetry record format and the publisher
+    """
+    def test_record(self):
+        """
+        Records unpack to what was packed, minus the sensors that can't be
+        sent
+        """
+        values = dict(TEST_VALUES)
+        values['gps_tpv'] = {
+            'name': 'gps_tpv', 'type': 'STRING', 'unit': '', 'value': '{}'}
+        values['bad'] = {
+            'name': 'bad', 'type': 'REALNUM', 'unit': '', 'value': 'n/a'}
+        record = telemetry.pack_record(7, 1234567890, values)
+        seq, timestamp_ns, unpacked = telemetry.unpack_record(record)
+        self.assertEqual(seq, 7)
+        self.assertEqual(timestamp_ns, 1234567890)
+        self.assertEqual(unpacked, TEST_VALUES)
+        with self.assertRaises(ValueError):
+            telemetry.unpack_record(record[:-1])
+        with self.assertRaises(ValueError):
+            telemetry.unpack_record(b'XXXX' + record[4:])
+
+    def test_publisher(self):
+        """
+        Subscribers get records until they unsubscribe
+        """
+        sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        sock.bind(('127.0.0.1', 0))
+        sock.settimeout(2)
+        port = sock.getsockname()[1]
+        publisher = telemetry.TelemetryPublisher(
+            lambda: TEST_VALUES, get_main_logger().getChild('Telemetry'))
+        try:
+            lease_time = publisher.subscribe('127.0.0.1', port, 1000)
+            self.assertEqual(lease_time, publisher.LEASE_TIME)
+            seqs = []
+            for _ in range(3):
+                seq, _, values = telemetry.unpack_record(sock.recv(2048))
+                self.assertEqual(values, TEST_VALUES)
+                seqs.append(seq)
+            self.assertEqual(seqs, sorted(seqs))
+            publisher.unsubscribe('127.0.0.1', port)
+            # Drain whatever was sent before the unsubscribe went through
+            sock.settimeout(0.5)
+            try:
+                while True:
+                    sock.recv(2048)
+            except socket.timeout:
+                pass
+            with self.assertRaises(socket.timeout):
+                sock.recv(2048)
+        finally:
+            publisher.stop()
+            sock.close()
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -12,6 +12,7 @@ from six import iteritems
 from builtins import hex
 from builtins import object
 from usrp_mpm.mpmlog import get_logger
+from usrp_mpm.sys_utils.reg_sequence import RegSequence
 
 class NIJESDCore(object):
     """
@@ -143,14 +144,16 @@ class NIJESDCore(object):
         reg_val = ((self.tx_driver_swing & 0x0F) << 16) | \
                   ((self.tx_precursor    & 0x1F) <<  8) | \
                   ((self.tx_postcursor   & 0x1F) <<  0)
-        self.regs.poke32(self.MGT_TX_TRANSCEIVER_CONTROL, reg_val)
-        time.sleep(0.001)
+        seq = RegSequence()
+        seq.poke32(self.MGT_TX_TRANSCEIVER_CONTROL, reg_val)
+        seq.sleep(0.001)
         # Bypass scrambler and char replacement. If the scrambler is bypassed,
         # then the char replacement is also disabled.
         reg_val = {True: 0x01, False: 0x10}[self.bypass_scrambler]
-        self.regs.poke32(self.MGT_TX_SCRAMBLER_CONTROL, reg_val)
+        seq.poke32(self.MGT_TX_SCRAMBLER_CONTROL, reg_val)
         # Check for Framer in Idle state
-        rb = self.regs.peek32(self.MGT_TRANSMITTER_CONTROL)
+        seq.peek32(self.MGT_TRANSMITTER_CONTROL)
+        rb, = seq.run(self.regs)
         if rb & 0x100 != 0x100:
             raise RuntimeError('TX Framer is not idle after reset')
         # Enable incoming DAC Sync
@@ -248,20 +251,19 @@ class NIJESDCore(object):
         assert tx_or_rx.lower() in ('rx', 'tx')
         mgt_reg = {'tx': self.MGT_TX_RESET_CONTROL, 'rx': self.MGT_RX_RESET_CONTROL}[tx_or_rx]
         self.log.trace("Resetting %s MGTs..." % tx_or_rx.upper())
-        self.regs.poke32(mgt_reg, 0x10)
+        seq = RegSequence().poke32(mgt_reg, 0x10)
         if not reset_only:
-            self.regs.poke32(mgt_reg, 0x20)
-            rb = -1
-            for _ in range(20):
-                rb = self.regs.peek32(mgt_reg)
-                if rb & 0xFFFF0000 == 0x000F0000:
-                    self.log.trace("%s MGT Reset Cleared!" % tx_or_rx.upper())
-                    return True
-                time.sleep(0.001)
-            raise RuntimeError('Timeout in GT {trx} Reset (Readback: 0x{rb:X})'.format(
+            seq.poke32(mgt_reg, 0x20)
+            seq.poll32(mgt_reg, 0x000F0000, mask=0xFFFF0000, timeout=0.020)
+        try:
+            seq.run(self.regs)
+        except RuntimeError as ex:
+            raise RuntimeError('Timeout in GT {trx} Reset ({ex})'.format(
                 trx=tx_or_rx.upper(),
-                rb=(rb & 0xFFFF0000),
+                ex=ex,
             ))
+        if not reset_only:
+            self.log.trace("%s MGT Reset Cleared!" % tx_or_rx.upper())
         return True
 
     def _gt_pll_power_control(self, qplls = 0, cplls = 0):
@@ -56,7 +56,11 @@ class AD9695Rh(object):
         """
         Apply a series of pokes.
         pokes8((0,1),(0,2)) is the same as calling poke8(0,1), poke8(0,2).
+        If the register interface supports it, the pokes are batched.
         """
+        if hasattr(self.regs, 'pokes8'):
+            self.regs.pokes8(list(addr_vals))
+            return
         for addr, val in addr_vals:
             self.regs.poke8(addr, val)
 
@@ -67,7 +67,11 @@ class DAC37J82Rh(object):
         """
         Apply a series of pokes.
         pokes16((0,1),(0,2)) is the same as calling poke16(0,1), poke16(0,2).
+        If the register interface supports it, the pokes are batched.
         """
+        if hasattr(self.regs, 'pokes16'):
+            self.regs.pokes16(list(addr_vals))
+            return
         for addr, val in addr_vals:
             self.regs.poke16(addr, val)
 
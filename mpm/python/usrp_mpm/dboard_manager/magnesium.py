@@ -497,6 +497,20 @@ class Magnesium(BfrfsEEPROM, DboardManagerBase):
         self.cpld.poke16(addr, data)
         return self.cpld.peek16(addr)
 
+    def cpld_peeks(self, addrs):
+        """
+        Batched version of cpld_peek(). Reads the CPLD registers at all
+        addresses in addrs, and returns their values as a list.
+        """
+        return self._spi_ifaces['cpld'].peeks16(addrs)
+
+    def cpld_pokes(self, addr_vals):
+        """
+        Batched version of cpld_poke(). Writes a list of (addr, data) pairs to
+        the CPLD, in order.
+        """
+        self._spi_ifaces['cpld'].pokes16(addr_vals)
+
     def dump_jesd_core(self):
         " Debug method to dump all JESD core regs "
         with open_uio(
@@ -518,6 +518,20 @@ class Rhodium(BfrfsEEPROM, DboardManagerBase):
         self.cpld.poke16(addr, data)
         return self.cpld.peek16(addr)
 
+    def cpld_peeks(self, addrs):
+        """
+        Batched version of cpld_peek(). Reads the CPLD registers at all
+        addresses in addrs, and returns their values as a list.
+        """
+        return self._spi_ifaces['cpld'].peeks16(addrs)
+
+    def cpld_pokes(self, addr_vals):
+        """
+        Batched version of cpld_poke(). Writes a list of (addr, data) pairs to
+        the CPLD, in order.
+        """
+        self._spi_ifaces['cpld'].pokes16(addr_vals)
+
     def lmk_peek(self, addr):
         """
         Debug for accessing the LMK via the RPC shell.
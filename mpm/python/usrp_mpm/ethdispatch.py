@@ -12,6 +12,7 @@ from builtins import object
 import netaddr
 from usrp_mpm.mpmlog import get_logger
 from usrp_mpm.sys_utils.uio import UIO
+from usrp_mpm.sys_utils.reg_sequence import RegSequence
 
 
 class EthDispatcherCtrl(object):
@@ -33,8 +34,89 @@ class EthDispatcherCtrl(object):
     def __init__(self, label):
         self.log = get_logger(label)
         self._regs = UIO(label=label, read_only=False)
-        self.poke32 = self._regs.poke32
         self.peek32 = self._regs.peek32
+        # Register values written by configure(), by address
+        self._config_regs = {}
+
+    def poke32(self, addr, val):
+        " Write a register, bypassing configure() "
+        self._config_regs.pop(addr, None)
+        self._regs.poke32(addr, val)
+
+    def configure(self, ip_addr, bridge_mode=False, bridge_mac_addr=None,
+                  vita_port=None, forward_policy=None, internal_iface=None):
+        """
+        Program the whole dispatcher configuration in one pass.
+
+        The register writes are collected first, and then submitted as a
+        single register sequence, so the dispatcher goes from the old to the
+        new configuration without Python running in between. Registers that
+        already hold the requested value from a previous call are not written
+        again, so reconfiguring an interface with an unchanged configuration
+        doesn't disturb the traffic going through it.
+
+        Arguments:
+        ip_addr -- Own IPv4 address. In bridge mode, this is the address of
+                   the bridge.
+        bridge_mode -- Enable bridge mode. This requires bridge_mac_addr.
+        bridge_mac_addr -- MAC address for outgoing packets in bridge mode
+        vita_port -- UDP port for CHDR traffic. Leave at None to keep the
+                     current port.
+        forward_policy -- Tuple (forward_eth, forward_bcast), see
+                          set_forward_policy(). Leave at None to keep the
+                          current policy.
+        internal_iface -- Tuple (mac_addr, ip_addr) of the FPGA side of the
+                          internal interface, see setup_internal_interface()
+        """
+        assert not (bridge_mode and internal_iface)
+        writes = []
+        if bridge_mode:
+            mac_addr_int = int(netaddr.EUI(bridge_mac_addr))
+            writes += [
+                (self.BRIDGE_INTERNAL_MAC_LO_OFFSET, mac_addr_int & 0xFFFFFFFF),
+                (self.BRIDGE_INTERNAL_MAC_HI_OFFSET, mac_addr_int >> 32),
+                (self.BRIDGE_INTERNAL_IP_OFFSET, int(netaddr.IPAddress(ip_addr))),
+            ]
+            if vita_port is not None:
+                writes.append((self.BRIDGE_INTERNAL_PORT_OFFSET, vita_port))
+        else:
+            writes.append((self.ETH_IP_OFFSET, int(netaddr.IPAddress(ip_addr))))
+            if vita_port is not None:
+                writes.append((self.ETH_PORT_OFFSET, vita_port))
+            if internal_iface is not None:
+                mac_addr_int = int(netaddr.EUI(internal_iface[0]))
+                writes += [
+                    (self.BRIDGE_INTERNAL_MAC_LO_OFFSET, mac_addr_int & 0xFFFFFFFF),
+                    (self.BRIDGE_INTERNAL_MAC_HI_OFFSET, mac_addr_int >> 32),
+                    (self.BRIDGE_INTERNAL_IP_OFFSET,
+                     int(netaddr.IPAddress(internal_iface[1]))),
+                ]
+        # Enable goes last, once the addresses it relies on are in place
+        if bridge_mode or internal_iface is not None:
+            writes.append((self.BRIDGE_INTERNAL_ENABLE_OFFSET, 1))
+        if forward_policy is not None:
+            forward_eth, forward_bcast = forward_policy
+            writes.append((
+                self.FORWARD_ETH_BCAST_OFFSET,
+                int(bool(forward_eth) << 1) | int(bool(forward_bcast))
+            ))
+        seq = RegSequence()
+        for addr, value in writes:
+            if self._config_regs.get(addr) != value:
+                self.log.trace("Writing to address 0x{:04X}: 0x{:04X}".format(
+                    addr, value))
+                seq.poke32(addr, value)
+        if not seq.ops:
+            self.log.trace("Dispatcher configuration is unchanged.")
+            return
+        self.log.debug(
+            "Configuring dispatcher: IP address `{}'{}{}".format(
+                ip_addr,
+                ", bridge mode" if bridge_mode else "",
+                ", internal interface" if internal_iface is not None else ""))
+        with self._regs:
+            seq.run(self._regs)
+        self._config_regs.update(writes)
 
     def set_bridge_mode(self, bridge_mode):
         " Enable/Disable Bridge Mode "
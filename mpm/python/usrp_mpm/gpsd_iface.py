@@ -15,6 +15,7 @@ import select
 import datetime
 import math
 import re
+import threading
 from usrp_mpm.mpmlog import get_logger
 
 
@@ -171,6 +172,136 @@ class GPSDIface(object):
         return result.get(resp_class, [{}])[0]
 
 
+class GPSDWatcher(object):
+    """
+    Keeps the latest reports from GPSd in memory.
+
+    A background thread consumes the WATCH stream of GPSd and stores the most
+    recent TPV and SKY reports, so queries don't have to go out to GPSd. If
+    the connection drops, the thread keeps trying to reconnect.
+
+    TPV reports with mode 0 (no information yet) are discarded, and reports
+    older than MAX_REPORT_AGE seconds are not handed out.
+    """
+    # Reports older than this many seconds are considered stale
+    MAX_REPORT_AGE = 5
+    # How often the watcher thread checks whether it should stop, in seconds
+    POLL_INTERVAL = 1
+    # How long to wait before reconnecting to GPSd, in seconds
+    RECONNECT_INTERVAL = 1
+
+    def __init__(self, log):
+        self.log = log
+        self._cond = threading.Condition()
+        # Maps the report class to a tuple (report, time.monotonic() of arrival)
+        self._reports = {}
+        self._gpsd_iface = None
+        self._running = False
+        self._thread = None
+
+    def start(self):
+        """
+        Connect to GPSd and start watching it. Raises if GPSd can't be reached.
+        """
+        self._gpsd_iface = self._connect()
+        self._running = True
+        self._thread = threading.Thread(
+            target=self._watch, name='GPSDWatcher', daemon=True)
+        self._thread.start()
+
+    def stop(self):
+        """
+        Stop the watcher thread and close the connection to GPSd
+        """
+        self._running = False
+        if self._thread is not None:
+            self._thread.join()
+            self._thread = None
+        self._disconnect()
+
+    def wait_for_report(self, resp_class, pred=None, timeout=15):
+        """
+        Return the latest report of class resp_class ('TPV' or 'SKY').
+
+        If there is no recent report, or pred(report) is False, this waits for
+        the next report that is. Returns an empty dictionary if no such report
+        arrives within timeout seconds.
+        """
+        end_time = time.monotonic() + timeout
+        with self._cond:
+            while True:
+                report, arrival = self._reports.get(resp_class, ({}, 0))
+                now = time.monotonic()
+                if report and now - arrival < self.MAX_REPORT_AGE \
+                        and (pred is None or pred(report)):
+                    return report
+                if now >= end_time:
+                    return {}
+                self._cond.wait(min(end_time - now, self.POLL_INTERVAL))
+
+    def _connect(self):
+        """Open a new connection to GPSd, with WATCH enabled"""
+        gpsd_iface = GPSDIface()
+        try:
+            gpsd_iface.open()
+        except Exception:
+            gpsd_iface.close()
+            raise
+        return gpsd_iface
+
+    def _disconnect(self):
+        """Close the connection to GPSd, if any"""
+        if self._gpsd_iface is not None:
+            self._gpsd_iface.close()
+            self._gpsd_iface = None
+
+    def _watch(self):
+        """Watcher thread: Read reports from GPSd until stop() is called"""
+        buf = b''
+        connected = True
+        while self._running:
+            try:
+                if self._gpsd_iface is None:
+                    self._gpsd_iface = self._connect()
+                    self.log.info("Reconnected to GPSd.")
+                    connected = True
+                    buf = b''
+                sock = self._gpsd_iface.gpsd_socket
+                if not select.select([sock], [], [], self.POLL_INTERVAL)[0]:
+                    continue
+                data = sock.recv(4096)
+                if not data:
+                    raise ConnectionResetError("GPSd closed the connection")
+                lines = (buf + data).split(b'\n')
+                buf = lines.pop()
+                for line in lines:
+                    self._update(line)
+            except (OSError, ValueError) as ex:
+                # Only complain once per lost connection
+                if connected:
+                    self.log.warning("Lost connection to GPSd (%s), reconnecting.", ex)
+                    connected = False
+                self._disconnect()
+                time.sleep(self.RECONNECT_INTERVAL)
+
+    def _update(self, line):
+        """Store the report in line, if it's one we keep"""
+        try:
+            report = json.loads(line.decode('ascii'))
+        except ValueError:
+            # This includes JSON and Unicode decode errors
+            self.log.warning("Could not decode GPSd report: %s", line)
+            return
+        resp_class = report.get('class', '')
+        if resp_class not in ('TPV', 'SKY'):
+            return
+        if resp_class == 'TPV' and report.get('mode', 0) == 0:
+            return
+        with self._cond:
+            self._reports[resp_class] = (report, time.monotonic())
+            self._cond.notify_all()
+
+
 class GPSDIfaceExtension(object):
     """
     Wrapper class that facilitates the 'extension' of a `context` object. The
@@ -179,6 +310,9 @@ class GPSDIfaceExtension(object):
     will then add the GPSDIfaceExtension methods to the `context` object's
     methods. The `context` object can then call the convenience functions to
     retrieve GPS information from GPSd.
+
+    The GPS information is served from a GPSDWatcher, so most calls return
+    right away without talking to GPSd.
     For example:
 
     class foo:
@@ -189,12 +323,19 @@ class GPSDIfaceExtension(object):
             # we can call `get_gps_time`
             print(self.get_gps_time())
     """
+    # How long to wait for a report before warning, in seconds
+    REPORT_TIMEOUT = 15
+
     def __init__(self):
-        self._gpsd_iface = GPSDIface()
-        self._log = self._gpsd_iface.log
+        try:
+            self._log = get_logger('GPSDIface')
+        except AssertionError:
+            from usrp_mpm.mpmlog import get_main_logger
+            self._log = get_main_logger('GPSDIface')
+        self._watcher = GPSDWatcher(self._log)
         self._initialized = False
         try:
-            self._gpsd_iface.open()
+            self._watcher.start()
             self._initialized = True
         except (ConnectionRefusedError, ConnectionResetError):
             self._log.warning(
@@ -202,7 +343,22 @@ class GPSDIfaceExtension(object):
 
     def __del__(self):
         if self._initialized:
-            self._gpsd_iface.close()
+            self._watcher.stop()
+
+    def _get_report(self, resp_class, pred=None):
+        """
+        Get the latest report of class resp_class from the watcher. Waits for
+        one to arrive if necessary.
+        """
+        while True:
+            report = self._watcher.wait_for_report(
+                resp_class, pred, timeout=self.REPORT_TIMEOUT)
+            if report:
+                self._log.trace("GPS info: {}".format(report))
+                return report
+            self._log.warning(
+                "No %s report from GPSd within %d seconds, still waiting.",
+                resp_class, self.REPORT_TIMEOUT)
 
     def extend(self, context):
         """Register the GSPDIfaceExtension object's public function with `context`"""
@@ -232,37 +388,25 @@ class GPSDIfaceExtension(object):
             time_dt = datetime.datetime.strptime(time_str, "%Y-%m-%dT%H:%M:%S.%fZ")
             epoch_dt = datetime.datetime(1970, 1, 1)
             return (time_dt - epoch_dt).total_seconds()
-        # Read responses from GPSD until we get a non-trivial mode and until next second.
-        gps_time_prev = 0
-        while True:
-            gps_info = self._gpsd_iface.get_gps_info(resp_class='tpv', timeout=15)
-            gps_mode = gps_info.get("mode", 0)
-            gps_time = parse_time(gps_info.get("time", ""))
-            if gps_mode == 0:
-                self._log.warning("GPSD reported invalid mode."
-                                  "Return from GPSD is %s", gps_info)
-                continue
-            if gps_time_prev == 0:
-                gps_time_prev = gps_time
-                continue
-            else:
-                if int(gps_time) - int(gps_time_prev) >= 1:
-                    return {
-                        'name': 'gps_time',
-                        'type': 'INTEGER',
-                        'unit': 'seconds',
-                        'value': str(int(gps_time)),
-                    }
+        # Wait for the first TPV report of the next second
+        has_time = lambda report: 'time' in report
+        gps_time_prev = int(parse_time(self._get_report('TPV', has_time)['time']))
+        gps_info = self._get_report(
+            'TPV',
+            lambda report: has_time(report) \
+                and int(parse_time(report['time'])) > gps_time_prev)
+        return {
+            'name': 'gps_time',
+            'type': 'INTEGER',
+            'unit': 'seconds',
+            'value': str(int(parse_time(gps_info['time']))),
+        }
 
     def get_gps_tpv_sensor(self):
         """Get a TPV response from GPSd as a sensor dict"""
-        self._log.trace("Polling GPS TPV results from GPSD")
-        # Read responses from GPSD until we get a non-trivial mode
-        while True:
-            gps_info = self._gpsd_iface.get_gps_info(resp_class='tpv', timeout=15)
-            self._log.trace("GPS info: {}".format(gps_info))
-            if gps_info.get("mode", 0) > 0:
-                break
+        self._log.trace("Getting GPS TPV results")
+        # The watcher only keeps TPV reports with a non-trivial mode
+        gps_info = self._get_report('TPV')
         # Return the JSON'd results
         gps_tpv = json.dumps(gps_info)
         return {
@@ -274,9 +418,8 @@ class GPSDIfaceExtension(object):
 
     def get_gps_sky_sensor(self):
         """Get a SKY response from GPSd as a sensor dict"""
-        self._log.trace("Polling GPS SKY results from GPSD")
-        # Just get the first SKY result
-        gps_info = self._gpsd_iface.get_gps_info(resp_class='sky', timeout=15)
+        self._log.trace("Getting GPS SKY results")
+        gps_info = self._get_report('SKY')
         # Return the JSON'd results
         gps_sky = json.dumps(gps_info)
         return {
@@ -304,16 +447,9 @@ class GPSDIfaceExtension(object):
 
             return checksum
 
-        self._log.trace("Polling GPS TPV and SKY results from GPSD")
-        # Read responses from GPSD until we get both a SKY response and TPV
-        # response in non-trivial mode
-        while True:
-            gps_info = self._gpsd_iface.get_gps_info(resp_class='', timeout=15)
-            self._log.trace("GPS info: {}".format(gps_info))
-            tpv_sensor_data = gps_info.get('tpv', [{}])[0]
-            sky_sensor_data = gps_info.get('sky', [{}])[0]
-            if tpv_sensor_data and sky_sensor_data and tpv_sensor_data.get("mode", 0) > 0:
-                break
+        self._log.trace("Getting GPS TPV and SKY results")
+        tpv_sensor_data = self._get_report('TPV')
+        sky_sensor_data = self._get_report('SKY')
 
         gpgga = "$GPGGA,"
 
@@ -395,12 +531,7 @@ class GPSDIfaceExtension(object):
         if not self._initialized:
             self._log.warning("Cannot query GPS lock, GPSd not initialized!")
             return False
-        # Read responses from GPSD until we get a non-trivial mode
-        while True:
-            gps_info = self._gpsd_iface.get_gps_info(resp_class='tpv', timeout=15)
-            self._log.trace("GPS info: {}".format(gps_info))
-            if gps_info.get("mode", 0) > 0:
-                break
+        gps_info = self._get_report('TPV')
         # 2 == 2D fix, 3 == 3D fix.
         # https://gpsd.gitlab.io/gpsd/gpsd_json.html
         return gps_info.get("mode", 0) >= 2
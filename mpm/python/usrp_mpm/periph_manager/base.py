@@ -11,6 +11,8 @@ Mboard implementation base class
 from __future__ import print_function
 import os
 from hashlib import md5
+import threading
+import time
 from time import sleep
 from concurrent import futures
 from builtins import str
@@ -98,6 +100,9 @@ class PeriphManagerBase(object):
     # A list of available sensors on the motherboard. This dictionary is a map
     # of the form sensor_name -> method name
     mboard_sensor_callback_map = {}
+    # The motherboard sensors that go into telemetry records (see
+    # get_telemetry()). Only list sensors that are quick to read.
+    telemetry_sensors = []
     # This is a sanity check value to see if the correct number of
     # daughterboards are detected. If somewhere along the line more than
     # max_num_dboards dboards are found, an error or warning is raised,
@@ -498,15 +503,31 @@ class PeriphManagerBase(object):
             return False
         if not self.dboards:
             return True
+        num_dboards = len(self.dboards)
+        progress = {'done': 0}
+        progress_lock = threading.Lock()
+        def _init_dboard(slot, dboard):
+            " Init one dboard, and report the progress "
+            start_time = time.time()
+            result = dboard.init(args)
+            with progress_lock:
+                progress['done'] += 1
+                self.log.info(
+                    "Initialized dboard in slot {} ({}/{} done) in {:.1f} s."
+                    .format(slot, progress['done'], num_dboards,
+                            time.time() - start_time))
+            return result
         if args.get("serialize_init", False):
             self.log.debug("Initializing dboards serially...")
-            return all((dboard.init(args) for dboard in self.dboards))
+            return all((
+                _init_dboard(slot, dboard)
+                for slot, dboard in enumerate(self.dboards)
+            ))
         self.log.debug("Initializing dboards in parallel...")
-        num_workers = len(self.dboards)
-        with futures.ThreadPoolExecutor(max_workers=num_workers) as executor:
+        with futures.ThreadPoolExecutor(max_workers=num_dboards) as executor:
             init_futures = [
-                executor.submit(dboard.init, args)
-                for dboard in self.dboards
+                executor.submit(_init_dboard, slot, dboard)
+                for slot, dboard in enumerate(self.dboards)
             ]
             return all([
                 x.result()
@@ -774,6 +795,28 @@ class PeriphManagerBase(object):
             self, self.mboard_sensor_callback_map.get(sensor_name)
         )()
 
+    @no_rpc
+    def get_telemetry(self):
+        """
+        Return the values that go into telemetry records (see telemetry.py),
+        as a dictionary key -> sensor dictionary (see get_mb_sensor()).
+
+        By default, these are the motherboard sensors listed in
+        telemetry_sensors. Sensors that fail to read are left out, so one bad
+        sensor doesn't take the rest down with it. Device-specific values,
+        such as status counters, can be added by overriding this method.
+        """
+        values = {}
+        for sensor_name in self.telemetry_sensors:
+            if sensor_name not in self.mboard_sensor_callback_map:
+                continue
+            try:
+                values[sensor_name] = self.get_mb_sensor(sensor_name)
+            except Exception as ex:
+                self.log.trace("Can't read sensor %s for telemetry: %s",
+                               sensor_name, str(ex))
+        return values
+
     ##########################################################################
     # EEPROMS
     ##########################################################################
@@ -92,6 +92,7 @@ class e31x(ZynqComponents, PeriphManagerBase):
         'temp_fpga' : 'get_fpga_temp_sensor',
         'temp_mb' : 'get_mb_temp_sensor',
     }
+    telemetry_sensors = ['ref_locked', 'temp_fpga', 'temp_mb']
     # The E310 has a single EEPROM that stores both DB and MB information
     dboard_eeprom_addr = "e0004000.i2c"
     dboard_eeprom_path_index = 0
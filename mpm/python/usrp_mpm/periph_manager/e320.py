@@ -98,6 +98,10 @@ class e320(ZynqComponents, PeriphManagerBase):
         'temp_rf_channelB' : 'get_rf_channelB_temp_sensor',
         'temp_main_power' : 'get_main_power_temp_sensor',
     }
+    telemetry_sensors = [
+        'ref_locked', 'gps_locked', 'fan', 'temp_fpga', 'temp_internal',
+        'temp_rf_channelA', 'temp_rf_channelB', 'temp_main_power',
+    ]
     max_num_dboards = 1
 
     # We're on a Zynq target, so the following two come from the Zynq standard
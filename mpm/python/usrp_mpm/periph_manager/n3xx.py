@@ -133,6 +133,7 @@ class n3xx(ZynqComponents, PeriphManagerBase):
         'temp': 'get_temp_sensor',
         'fan': 'get_fan_sensor',
     }
+    telemetry_sensors = ['ref_locked', 'gps_locked', 'temp', 'fan']
     dboard_eeprom_addr = "e0004000.i2c"
     dboard_eeprom_offset = 0
     dboard_eeprom_max_len = 64
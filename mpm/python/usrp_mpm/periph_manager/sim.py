@@ -62,6 +62,11 @@ class SimEthDispatcher:
                 self.log.warning("Cannot change ip address on simulator! Requested: {}, Actual: {}"
                                  .format(addr, real_addr))
 
+    def configure(self, ip_addr, **_):
+        """The simulator only knows about the IP address, see set_ipv4_addr()
+        """
+        self.set_ipv4_addr(ip_addr)
+
 class sim(PeriphManagerBase):
     """This is a periph manager that is designed to run on a regular
     computer rather than the arm core on an SDR
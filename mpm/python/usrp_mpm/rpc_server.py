@@ -10,6 +10,8 @@ Implemented RPC Servers
 from __future__ import print_function
 import traceback
 import copy
+import functools
+import time
 from random import choice
 from string import ascii_letters, digits
 from multiprocessing import Process
@@ -20,8 +22,12 @@ from gevent.pool import Pool
 from gevent import signal
 from gevent import spawn_later
 from gevent import Greenlet
+from gevent import get_hub
+from gevent.lock import Semaphore
 from gevent import monkey
 monkey.patch_all()
+# Identifies the OS thread we're running in, not the greenlet
+_get_thread_ident = monkey.get_original('_thread', 'get_ident')
 from builtins import str, bytes
 from builtins import range
 from six import iteritems
@@ -29,13 +35,14 @@ from contextlib import contextmanager
 from mprpc import RPCServer
 from usrp_mpm.mpmlog import get_main_logger
 from usrp_mpm.mpmutils import to_binary_str
+from usrp_mpm.telemetry import TelemetryPublisher
 from usrp_mpm.sys_utils import watchdog
 from usrp_mpm.sys_utils import net
 
 TIMEOUT_INTERVAL = 5.0 # Seconds before claim expires (default value)
 TOKEN_LEN = 16 # Length of the token string
 # Compatibility number for MPM
-MPM_COMPAT_NUM = (3, 0)
+MPM_COMPAT_NUM = (3, 1)
 
 def no_claim(func):
     " Decorator for functions that require no token check "
@@ -47,6 +54,14 @@ def no_rpc(func):
     func._norpc = True
     return func
 
+def long_running(func):
+    """
+    Decorator for functions that may take a long time to complete. These run
+    in a worker thread, so they don't hold up other RPC calls in the meantime.
+    """
+    func._long_running = True
+    return func
+
 class MPMServer(RPCServer):
     """
     Main MPM RPC class which holds the periph_manager object and translates
@@ -72,6 +87,9 @@ class MPMServer(RPCServer):
             TIMEOUT_INTERVAL
         ))
         self.session_id = None
+        # Session hash of the last successful init(). As long as this is set,
+        # the device state is kept across sessions (see init()).
+        self._warm_session_hash = None
         # Create the periph_manager for this device
         # This call will be forwarded to the device specific implementation
         # e.g. in periph_manager/n3xx.py
@@ -93,6 +111,14 @@ class MPMServer(RPCServer):
         self._mb_methods = []
         self.claimed_methods = copy.copy(self.default_claimed_methods)
         self._last_error = ""
+        # Only one long-running call at a time, see _run_in_worker()
+        self._worker_lock = Semaphore()
+        self._server_thread_ident = _get_thread_ident()
+        # Maps RPC method names to [number of calls, total time, max time]
+        self._rpc_stats = {}
+        self._telemetry = TelemetryPublisher(
+            self._get_telemetry, self.log.getChild('Telemetry'))
+        self._add_server_commands()
         self._init_rpc_calls(self.periph_manager)
         # We call the server __init__ function here, and not earlier, because
         # first the commands need to be registered
@@ -162,6 +188,53 @@ class MPMServer(RPCServer):
             getattr(self, storage).append(command_name)
 
 
+    def _add_server_commands(self):
+        """
+        Wrap the RPC methods of this class, so they get latency metrics and
+        can run in a worker thread like the component methods.
+        """
+        for method_name in (
+                m for m in vars(MPMServer)
+                if not m.startswith('_') \
+                    and callable(getattr(self, m)) \
+                    and not getattr(getattr(self, m), '_norpc', False)
+            ):
+            method = getattr(self, method_name)
+            wrapper = functools.partial(self._run_command, method_name, method)
+            wrapper = functools.update_wrapper(wrapper, method)
+            setattr(self, method_name, wrapper)
+
+    def _run_command(self, command, function, *args):
+        """
+        Call function, and record how long it took. Long-running functions go
+        to a worker thread, unless we're already in one.
+        """
+        start_time = time.monotonic()
+        try:
+            if getattr(function, '_long_running', False) \
+                    and _get_thread_ident() == self._server_thread_ident:
+                return self._run_in_worker(function, args)
+            return function(*args)
+        finally:
+            duration = time.monotonic() - start_time
+            stats = self._rpc_stats.setdefault(command, [0, 0.0, 0.0])
+            stats[0] += 1
+            stats[1] += duration
+            stats[2] = max(stats[2], duration)
+
+    def _run_in_worker(self, function, args):
+        """
+        Run function in a thread of the gevent thread pool, and wait for it
+        cooperatively. Other RPC calls, such as claim, reclaim, or sensor
+        reads, keep getting served until it returns.
+
+        Long-running calls are serialized, and the claim timeout is disabled
+        while they run, since the client can't reclaim in the middle of its
+        own call.
+        """
+        with self._worker_lock, self._timeout_disabler():
+            return get_hub().threadpool.apply(function, args)
+
     def _add_claimed_command(self, function, command):
         """
         Adds a method with the name command to the RPC server
@@ -183,7 +256,7 @@ class MPMServer(RPCServer):
                 # Because we can only reach this point with a valid claim,
                 # there's no harm in resetting the timer
                 self._reset_timer()
-                return function(*args)
+                return self._run_command(command, function, *args)
             except Exception as ex:
                 self.log.error(
                     "Uncaught exception in method %s :%s \n %s ",
@@ -208,7 +281,7 @@ class MPMServer(RPCServer):
         def new_unclaimed_function(*args):
             " Define a function that does not require a claim token check "
             try:
-                return function(*args)
+                return self._run_command(command, function, *args)
             except Exception as ex:
                 self.log.error(
                     "Uncaught exception in method %s :%s\n %s ",
@@ -239,6 +312,52 @@ class MPMServer(RPCServer):
                     and callable(getattr(self, method))
         ]
 
+    def get_rpc_stats(self):
+        """
+        Returns the latency metrics of all RPC methods that were called since
+        the RPC server started, as a dictionary method_name -> stats. stats is
+        a dictionary with the number of calls ('count'), and the mean and
+        maximum time it took to execute them, in milliseconds ('mean_ms',
+        'max_ms'). The time a call spent waiting for the RPC server before it
+        started executing is not included.
+        This is a safe method which can be called without a claim on the device
+        """
+        return {
+            method_name: {
+                'count': stats[0],
+                'mean_ms': 1000 * stats[1] / stats[0],
+                'max_ms': 1000 * stats[2],
+            }
+            for method_name, stats in iteritems(self._rpc_stats)
+        }
+
+    def subscribe_telemetry(self, port, rate):
+        """
+        Send telemetry records (see telemetry.py) to UDP port `port` of the
+        caller, `rate` times a second. Subscriptions expire, so this needs to
+        be called again before the returned lease time (in seconds) runs out.
+        Calling it again also updates the rate.
+        This is a safe method which can be called without a claim on the device
+        """
+        return self._telemetry.subscribe(self.client_host, int(port), rate)
+
+    def unsubscribe_telemetry(self, port):
+        """
+        Stop sending telemetry records to UDP port `port` of the caller.
+        This is a safe method which can be called without a claim on the device
+        """
+        self._telemetry.unsubscribe(self.client_host, int(port))
+
+    def _get_telemetry(self):
+        """
+        Returns the current telemetry values of the peripheral manager. This
+        runs in the telemetry publisher thread.
+        """
+        periph_manager = self.periph_manager
+        if periph_manager is None:
+            return {}
+        return periph_manager.get_telemetry()
+
     def ping(self, data=None):
         """
         Take in data as argument and send it back
@@ -247,6 +366,34 @@ class MPMServer(RPCServer):
         self.log.debug("I was pinged from: %s:%s", self.client_host, self.client_port)
         return data
 
+    def multi_call(self, calls):
+        """
+        Execute a list of RPC calls, and return all their results at once.
+        This saves a network round trip per call.
+
+        calls -- A list of [method_name, args] pairs. The calls are executed in
+                 order. Methods that require a claim need the token as their
+                 first argument, like when calling them directly.
+
+        Returns a list of [error, result] pairs, one per call. error is an
+        empty string if the call succeeded, and result is None if it failed. A
+        failing call does not stop the remaining calls.
+        This is a safe method which can be called without a claim on the device
+        """
+        results = []
+        for method_name, args in calls:
+            method = getattr(self, method_name, None)
+            if method_name.startswith('_') or method_name == 'multi_call' \
+                    or not callable(method):
+                results.append(
+                    ["Unknown RPC method `{}'".format(method_name), None])
+                continue
+            try:
+                results.append(["", method(*args)])
+            except Exception as ex:
+                results.append([str(ex) or type(ex).__name__, None])
+        return results
+
     ###########################################################################
     # Claiming logic
     ###########################################################################
@@ -331,12 +478,14 @@ class MPMServer(RPCServer):
         )
         return False
 
-    def _unclaim(self):
+    def _unclaim(self, warm=True):
         """
         Unconditional unclaim - for internal use
 
-        Resets and deinitalizes the periph manager as well.
+        Resets and deinitalizes the periph manager as well, unless `warm` is
+        True and the session was initialized for a warm reconnect.
         """
+        warm = warm and self._warm_session_hash is not None
         self.log.debug("Releasing claim on session `{}'".format(
             self.session_id
         ))
@@ -349,7 +498,11 @@ class MPMServer(RPCServer):
             self.periph_manager.claimed = False
             self.periph_manager.unclaim()
             self.periph_manager.set_connection_type(None)
-            self.periph_manager.deinit()
+            if warm:
+                self.log.debug("Keeping device state for a warm reconnect.")
+            else:
+                self._drop_warm_session()
+                self.periph_manager.deinit()
         except BaseException as ex:
             self._last_error = str(ex)
             self.log.error("deinit() failed: %s", str(ex))
@@ -374,23 +527,30 @@ class MPMServer(RPCServer):
             self._reset_timer()
         else:
             self.log.warning("A timeout event occured!")
-            self._unclaim()
+            # The session ended abnormally, so we don't trust the device state
+            self._unclaim(warm=False)
 
     def _reset_timer(self):
         """
         Reset unclaim timer. After calling this, call this function again
         within 'timeout' seconds to avoid a timeout event.
         """
+        # The timer lives on the hub of the server thread. Worker threads
+        # don't need to touch it, timeouts are disabled while they run.
+        if _get_thread_ident() != self._server_thread_ident:
+            return
         self._timer.kill()
         self._timer = spawn_later(self._timeout_interval, self._timeout_event)
 
     @contextmanager
     def _timeout_disabler(self):
+        # These may nest, e.g., when update_component() runs in a worker
+        prev_disable_timeouts = self._disable_timeouts
         self._disable_timeouts = True
         try:
             yield self
         finally:
-            self._disable_timeouts = False
+            self._disable_timeouts = prev_disable_timeouts
 
     ###########################################################################
     # Status queries
@@ -442,6 +602,7 @@ class MPMServer(RPCServer):
     ###########################################################################
     # Session initialization
     ###########################################################################
+    @long_running
     def init(self, token, args):
         """
         Initialize device. See PeriphManagerBase for details. This is forwarded
@@ -455,6 +616,17 @@ class MPMServer(RPCServer):
             )
             self._last_error = "init() called without valid claim."
             raise RuntimeError("init() called without valid claim.")
+        session_hash = args.get("session_hash")
+        if session_hash and session_hash == self._warm_session_hash:
+            self.log.info(
+                "Session configuration unchanged, skipping init() "
+                "(warm reconnect).")
+            return True
+        # The state of the previous session was kept, but doesn't match
+        if self._warm_session_hash is not None:
+            self._drop_warm_session()
+            self.periph_manager.deinit()
+        result = False
         try:
             result = self.periph_manager.init(args)
         except Exception as ex:
@@ -462,8 +634,20 @@ class MPMServer(RPCServer):
             self.log.error("init() failed with error: %s", str(ex))
         finally:
             self.log.debug("init() result: {}".format(result))
+        if result and session_hash:
+            self._warm_session_hash = session_hash
         return result
 
+    def _drop_warm_session(self):
+        """
+        Forget the session hash of the previous session, the next init() will
+        fully initialize the device.
+        """
+        if self._warm_session_hash is not None:
+            self.log.debug("Dropping device state of session %s",
+                           self._warm_session_hash)
+        self._warm_session_hash = None
+
     ###########################################################################
     # Update components
     ###########################################################################
@@ -482,11 +666,13 @@ class MPMServer(RPCServer):
             unpack_params={'max_buffer_size': 50000000, 'raw': False},
         )
 
+    @long_running
     def reset_mgr(self):
         """
         Reset the Peripheral Manager for this RPC server.
         """
         self.log.info("Resetting peripheral manager.")
+        self._drop_warm_session()
         self.periph_manager.tear_down()
         self.periph_manager = None
         self.periph_manager = self._mgr_generator()
@@ -495,6 +681,7 @@ class MPMServer(RPCServer):
         # methods from the old peripheral manager (the one before reset)
         self.clear_method_registry()
 
+    @long_running
     def update_component(self, token, file_metadata_l, data_l):
         """"
         Updates the device component files specified by the metadata and data
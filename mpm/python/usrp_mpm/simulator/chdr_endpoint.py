@@ -9,11 +9,14 @@ Graph.
 """
 
 from threading import Thread
-import socket
-from uhd.chdr import ChdrPacket, ChdrWidth, PacketType
+from uhd.chdr import ChdrPacket, ChdrWidth, Endianness, ChdrStreamEngine, \
+    ChdrStreamCounts
 from .rfnoc_graph import XbarNode, XportNode, StreamEndpointNode, RFNoCGraph, NodeType
 
 CHDR_W = ChdrWidth.W64
+CHDR_PORT = 49153
+# The size of an sc16 sample
+BYTES_PER_SAMPLE = 4
 
 class ChdrEndpoint:
     """This class is created by the sim periph_manager
@@ -21,12 +24,18 @@ class ChdrEndpoint:
     traffic to the appropriate destination, and responding to said
     traffic.
 
+    The data packets of the streams don't go through Python. The
+    ChdrStreamEngine generates and consumes them in C++, and handles the
+    flow control of the streams. Only the management and control traffic
+    is returned to socket_worker.
+
     The extra_args parameter is passed in from the periph_manager, and
     coresponds to the --default_args flag of usrp_hwd.py on the
     command line
     """
     def __init__(self, log, extra_args):
         self.log = log.getChild("ChdrEndpoint")
+        self.engine = ChdrStreamEngine(CHDR_W, Endianness.LITTLE, "0.0.0.0", CHDR_PORT)
         self.thread = Thread(target=self.socket_worker, daemon=True)
         self.thread.start()
         self.graph = RFNoCGraph(self.get_default_nodes(), self.log, 1, self.begin_tx,
@@ -53,16 +62,34 @@ class ChdrEndpoint:
         return nodes
 
     def send_strc(self, stream_ep, addr):
-        pass # TODO: currently not implemented
+        """Set up the output stream of stream_ep, and send its STRC INIT
+        packet to the host at addr
+        """
+        regs = stream_ep.ep_regs
+        fc_freq = ChdrStreamCounts(regs.fc_freq_bytes, regs.fc_freq_pkts)
+        self.log.debug("Initializing Stream EPID:{} -> EPID:{} at {}"
+                       .format(stream_ep.epid, stream_ep.dst_epid, addr))
+        self.engine.add_source(stream_ep.epid, stream_ep.dst_epid,
+                               addr[0], addr[1], fc_freq)
 
     def begin_tx(self, src_epid, stream_spec):
-        pass # TODO: currently not implemented
+        """Start streaming to the host, paced to the sample rate of the
+        stream_spec
+        """
+        num_samples = 0 if stream_spec.is_continuous else stream_spec.total_samples
+        rate = stream_spec.sample_rate or 0.0
+        self.engine.start_source(src_epid, stream_spec.packet_samples, BYTES_PER_SAMPLE,
+                                 num_samples, rate)
 
     def end_tx(self, src_epid):
-        pass # TODO: currently not implemented
+        """Stop streaming to the host"""
+        self.engine.stop_source(src_epid)
 
     def begin_rx(self, dst_epid):
-        pass # TODO: currently not implemented
+        """Set up an input stream, which consumes the data from the host"""
+        stream_ep = self.graph.find_ep_by_id(dst_epid)
+        regs = stream_ep.ep_regs
+        self.engine.add_sink(dst_epid, ChdrStreamCounts(regs.cap_bytes, regs.cap_pkts))
 
     def socket_worker(self):
         """This is the method that runs in a background thread. It
@@ -70,19 +97,16 @@ class ChdrEndpoint:
         in.
         """
         self.log.info("Starting ChdrEndpoint Thread")
-        main_sock = socket.socket(socket.AF_INET,
-                                  socket.SOCK_DGRAM)
-        main_sock.bind(("0.0.0.0", 49153))
 
         while True:
-            # This allows us to block on multiple sockets at the same time
-            buffer = bytearray(8000) # Max MTU
-            # received Data over socket
-            n_bytes, sender = main_sock.recvfrom_into(buffer)
+            datagram = self.engine.recv(1.0)
+            if datagram is None:
+                continue
+            buffer, sender = datagram
             self.log.trace("received {} bytes of data from {}"
-                           .format(n_bytes, sender))
+                           .format(len(buffer), sender))
             try:
-                packet = ChdrPacket.deserialize(CHDR_W, buffer[:n_bytes])
+                packet = ChdrPacket.deserialize(CHDR_W, buffer)
                 self.log.trace("Decoded Packet: {}".format(packet.to_string_with_payload()))
                 entry_xport = (1, NodeType.XPORT, 0)
                 pkt_type = packet.get_header().pkt_type
@@ -92,7 +116,7 @@ class ChdrEndpoint:
                     data = response.serialize()
                     self.log.trace("Returning Packet: {}"
                                    .format(packet.to_string_with_payload()))
-                    main_sock.sendto(bytes(data), sender)
+                    self.engine.send(bytes(data), *sender)
             except BaseException as ex:
                 self.log.warning("Unable to decode packet: {}"
                                  .format(ex))
@@ -85,6 +85,11 @@ class StreamEpRegs:
         self.update_status_in = update_status_in
         self.cap_pkts = cap_pkts
         self.cap_bytes = cap_bytes
+        # The flow control parameters of the output stream
+        self.fc_freq_bytes = 0
+        self.fc_freq_pkts = 0
+        self.fc_headroom_bytes = 0
+        self.fc_headroom_pkts = 0
 
     def read(self, addr):
         if addr == REG_EPID_SELF:
@@ -117,8 +122,15 @@ class StreamEpRegs:
         elif addr == REG_OSTRM_DST_EPID:
             self.log.debug("Setting Dest EPID to {}".format(val))
             self.set_dst_epid(val)
-        elif REG_OSTRM_FC_FREQ_BYTES_LO <= addr <= REG_OSTRM_FC_HEADROOM:
-            pass # TODO: implement these Flow Control parameters
+        elif addr == REG_OSTRM_FC_FREQ_BYTES_LO:
+            self.fc_freq_bytes = (self.fc_freq_bytes & ~0xFFFFFFFF) | val
+        elif addr == REG_OSTRM_FC_FREQ_BYTES_HI:
+            self.fc_freq_bytes = (self.fc_freq_bytes & 0xFFFFFFFF) | (val << 32)
+        elif addr == REG_OSTRM_FC_FREQ_PKTS:
+            self.fc_freq_pkts = val
+        elif addr == REG_OSTRM_FC_HEADROOM:
+            self.fc_headroom_bytes = val & 0xFFFF
+            self.fc_headroom_pkts = (val >> 16) & 0xFF
         elif addr == REG_ISTRM_CTRL_STATUS:
             status = CtrlStatusWord.parse(val)
             self.log.debug("Setting EPID Input Stream Ctrl Status: {}".format(status))
@@ -0,0 +1,99 @@
+#
+# Copyright 2020 Ettus Research, a National Instruments Brand
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+"""
+Register sequences that run in one go
+"""
+
+import time
+from builtins import object
+
+# These must match mpm::types::reg_op_t::op_t
+PEEK = 0
+POKE = 1
+POLL = 2
+SLEEP = 3
+
+class RegSequence(object):
+    """
+    A list of register accesses that can be submitted at once.
+
+    Register interfaces that provide a run_sequence() method (like UIO) run
+    the whole sequence in C++, which saves the Python overhead of every single
+    access. For all other register interfaces, the sequence falls back to
+    peek32() and poke32().
+
+    >>> seq = RegSequence()
+    >>> seq.poke32(0x10, 0x1)
+    >>> seq.poll32(0x14, 0x1, mask=0x1, timeout=0.01)
+    >>> seq.peek32(0x18)
+    >>> poll_rb, rb = seq.run(regs)
+    """
+    def __init__(self):
+        # Tuples of (op, addr, data, mask, timeout_us)
+        self.ops = []
+
+    def peek32(self, addr):
+        """
+        Read addr. The value goes into the list returned by run().
+        """
+        self.ops.append((PEEK, addr, 0, 0xFFFFFFFF, 0))
+        return self
+
+    def poke32(self, addr, val):
+        """
+        Write val to addr
+        """
+        self.ops.append((POKE, addr, val & 0xFFFFFFFF, 0xFFFFFFFF, 0))
+        return self
+
+    def poll32(self, addr, val, mask=0xFFFFFFFF, timeout=0.001):
+        """
+        Read addr until the bits in mask are equal to val, and fail if that
+        does not happen within timeout seconds. The last value read goes into
+        the list returned by run().
+        """
+        self.ops.append((POLL, addr, val & 0xFFFFFFFF, mask & 0xFFFFFFFF,
+                         int(timeout * 1e6)))
+        return self
+
+    def sleep(self, duration):
+        """
+        Wait for duration seconds
+        """
+        self.ops.append((SLEEP, 0, 0, 0xFFFFFFFF, int(duration * 1e6)))
+        return self
+
+    def run(self, regs):
+        """
+        Run the sequence on regs.
+
+        Returns the values read by peek32() and poll32() steps, in order.
+        Raises a RuntimeError if a poll32() step times out; the following
+        steps are not run then.
+        """
+        if hasattr(regs, 'run_sequence'):
+            return regs.run_sequence(self)
+        results = []
+        for op, addr, data, mask, timeout_us in self.ops:
+            if op == PEEK:
+                results.append(regs.peek32(addr))
+            elif op == POKE:
+                regs.poke32(addr, data)
+            elif op == POLL:
+                deadline = time.monotonic() + timeout_us / 1e6
+                value = regs.peek32(addr)
+                while (value & mask) != (data & mask):
+                    if time.monotonic() > deadline:
+                        raise RuntimeError(
+                            "Timeout polling register 0x{:X} "
+                            "(Readback: 0x{:X}, expected: 0x{:X})".format(
+                                addr, value & mask, data & mask))
+                    time.sleep(10e-6)
+                    value = regs.peek32(addr)
+                results.append(value)
+            elif op == SLEEP:
+                time.sleep(timeout_us / 1e6)
+        return results
@@ -13,6 +13,7 @@ from builtins import object
 import pyudev
 import usrp_mpm.libpyusrp_periphs as lib
 from usrp_mpm.mpmlog import get_logger
+from usrp_mpm.sys_utils import reg_sequence
 
 UIO_SYSFS_BASE_DIR = '/sys/class/uio'
 UIO_DEV_BASE_DIR = '/dev'
@@ -204,3 +205,13 @@ class UIO(object):
         """
         assert not self._read_only
         return self._uio.poke32(addr, val)
+
+    def run_sequence(self, seq):
+        """
+        Runs a RegSequence (see usrp_mpm.sys_utils.reg_sequence) in C++, and
+        returns the values read by its peek and poll steps.
+        Will throw if read_only was set to True and the sequence writes.
+        """
+        assert not self._read_only or \
+            all(op[0] != reg_sequence.POKE for op in seq.ops)
+        return self._uio.run_sequence(seq.ops)
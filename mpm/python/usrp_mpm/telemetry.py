@@ -0,0 +1,262 @@
+#
+# Copyright 2020 Ettus Research, a National Instruments Brand
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+"""
+Telemetry publisher: Pushes device status to subscribed hosts over UDP
+
+Hosts subscribe with a UDP port and a rate, and then receive a telemetry
+record that many times a second, until their subscription runs out. This is a
+lot cheaper than reading the same values via RPC calls, and the host gets the
+values without waiting for a round trip.
+
+Every record is a single UDP datagram. All values are little endian:
+
+    Header:
+        4 bytes: Magic ('MPMT')
+        1 byte:  Version of the record format
+        1 byte:  Reserved (zero)
+        2 bytes: Number of entries
+        4 bytes: Sequence number, counts up by one for every record
+        8 bytes: System time the values were read at (ns since the epoch)
+
+    Entries, one after the other:
+        1 byte:  Type ('b', 'i', or 'r', like uhd::sensor_value_t)
+        1 byte:  Length of the key
+        1 byte:  Length of the sensor name
+        1 byte:  Length of the unit
+        Key, name, and unit, no terminating zeros
+        8 bytes: Value. int64 for booleans and integers, a double for reals.
+
+The key is the name the host asks for the sensor by (e.g. 'temp'), the other
+fields are the same as in a sensor dictionary. String sensors are not sent.
+"""
+
+import socket
+import struct
+import threading
+import time
+from builtins import object
+from six import iteritems
+
+MAGIC = b'MPMT'
+VERSION = 1
+HEADER_FMT = '<4sBBHIQ'
+ENTRY_FMT = '<cBBB'
+VALUE_FMT = {
+    'BOOLEAN': ('b', '<q', lambda value: int(value == 'true')),
+    'INTEGER': ('i', '<q', lambda value: int(float(value))),
+    'REALNUM': ('r', '<d', float),
+}
+MAX_STR_LEN = 255
+
+
+def pack_record(seq, timestamp_ns, values):
+    """
+    Pack a telemetry record.
+
+    values is a dictionary key -> sensor dictionary (see get_mb_sensor()).
+    Sensors with a type that can't be sent, or with a value that doesn't match
+    their type, are skipped.
+    """
+    entries = []
+    for key, sensor in sorted(iteritems(values)):
+        if sensor.get('type') not in VALUE_FMT:
+            continue
+        type_char, value_fmt, convert = VALUE_FMT[sensor['type']]
+        try:
+            value = struct.pack(value_fmt, convert(sensor['value']))
+        except (KeyError, ValueError, struct.error):
+            continue
+        strs = [
+            s.encode('utf-8')[:MAX_STR_LEN]
+            for s in (key, sensor.get('name', key), sensor.get('unit', ''))
+        ]
+        entries.append(
+            struct.pack(ENTRY_FMT, type_char.encode('ascii'), *[len(s) for s in strs])
+            + b''.join(strs)
+            + value
+        )
+    header = struct.pack(HEADER_FMT, MAGIC, VERSION, 0, len(entries),
+                         seq & 0xFFFFFFFF, timestamp_ns)
+    return header + b''.join(entries)
+
+
+def unpack_record(record):
+    """
+    Unpack a telemetry record. Returns a tuple (seq, timestamp_ns, values),
+    where values is a dictionary key -> sensor dictionary.
+
+    Raises a ValueError if the record is malformed.
+    """
+    type_names = {
+        type_char: type_name for type_name, (type_char, _, _) in iteritems(VALUE_FMT)
+    }
+    try:
+        magic, version, _, num_entries, seq, timestamp_ns = \
+            struct.unpack_from(HEADER_FMT, record)
+        if magic != MAGIC or version != VERSION:
+            raise ValueError("Not a telemetry record.")
+        offset = struct.calcsize(HEADER_FMT)
+        values = {}
+        for _ in range(num_entries):
+            type_char, key_len, name_len, unit_len = \
+                struct.unpack_from(ENTRY_FMT, record, offset)
+            offset += struct.calcsize(ENTRY_FMT)
+            key, name, unit = [
+                record[start:start + length].decode('utf-8')
+                for start, length in (
+                    (offset, key_len),
+                    (offset + key_len, name_len),
+                    (offset + key_len + name_len, unit_len))
+            ]
+            offset += key_len + name_len + unit_len
+            type_name = type_names[type_char.decode('ascii')]
+            value, = struct.unpack_from(VALUE_FMT[type_name][1], record, offset)
+            offset += 8
+            if type_name == 'BOOLEAN':
+                value = 'true' if value else 'false'
+            values[key] = {
+                'name': name,
+                'type': type_name,
+                'unit': unit,
+                'value': str(value),
+            }
+    except (struct.error, KeyError, UnicodeDecodeError) as ex:
+        raise ValueError("Malformed telemetry record: {}".format(ex))
+    return seq, timestamp_ns, values
+
+
+class TelemetryPublisher(object):
+    """
+    Sends telemetry records to subscribed hosts.
+
+    The values are read by calling get_values(), which returns a dictionary
+    key -> sensor dictionary. They are read once per record, no matter how
+    many hosts are due for it.
+
+    Subscriptions are leases: They expire LEASE_TIME seconds after the host
+    subscribed, unless it subscribes again in the meantime. That way, hosts
+    that go away without unsubscribing don't get records forever.
+    """
+    # Subscriptions expire after this many seconds
+    LEASE_TIME = 30
+    # Limits for the record rate of a subscription, in Hz
+    MIN_RATE = 0.1
+    MAX_RATE = 100.0
+    # Maximum number of subscriptions
+    MAX_SUBSCRIBERS = 16
+    # How often the publisher thread checks for work if nobody is due, in
+    # seconds
+    POLL_INTERVAL = 1
+
+    def __init__(self, get_values, log):
+        self.log = log
+        self._get_values = get_values
+        self._lock = threading.Lock()
+        self._wakeup = threading.Event()
+        # Maps (addr, port) -> [period, next send time, expiry time]
+        self._subscribers = {}
+        self._socket = None
+        self._thread = None
+        self._seq = 0
+
+    def subscribe(self, addr, port, rate):
+        """
+        Send records to addr:port, rate times a second, or renew an existing
+        subscription at a new rate. Returns the lease time in seconds.
+        """
+        rate = min(max(float(rate), self.MIN_RATE), self.MAX_RATE)
+        now = time.monotonic()
+        with self._lock:
+            if (addr, port) not in self._subscribers:
+                if len(self._subscribers) >= self.MAX_SUBSCRIBERS:
+                    raise RuntimeError("Too many telemetry subscriptions.")
+                self.log.debug("New telemetry subscription from %s:%d at %.1f Hz",
+                               addr, port, rate)
+                self._subscribers[(addr, port)] = [1.0 / rate, now, 0]
+            subscriber = self._subscribers[(addr, port)]
+            subscriber[0] = 1.0 / rate
+            subscriber[2] = now + self.LEASE_TIME
+            if self._thread is None:
+                self._socket = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+                self._thread = threading.Thread(
+                    target=self._run, name='TelemetryPublisher', daemon=True)
+                self._thread.start()
+        self._wakeup.set()
+        return self.LEASE_TIME
+
+    def unsubscribe(self, addr, port):
+        """
+        Stop sending records to addr:port
+        """
+        with self._lock:
+            if self._subscribers.pop((addr, port), None) is not None:
+                self.log.debug("Dropped telemetry subscription from %s:%d",
+                               addr, port)
+
+    def stop(self):
+        """
+        Drop all subscriptions and stop the publisher thread
+        """
+        with self._lock:
+            self._subscribers = {}
+            thread = self._thread
+            self._thread = None
+        self._wakeup.set()
+        if thread is not None:
+            thread.join()
+
+    def _run(self):
+        """
+        Publisher thread: Sends records to all subscribers that are due, then
+        sleeps until the next one is.
+        """
+        sock = self._socket
+        while True:
+            now = time.monotonic()
+            with self._lock:
+                if self._thread is not threading.current_thread():
+                    break
+                for dest in [dest for dest, (_, _, expiry)
+                             in iteritems(self._subscribers) if expiry <= now]:
+                    self.log.debug("Telemetry subscription from %s:%d expired",
+                                   *dest)
+                    del self._subscribers[dest]
+                due = [dest for dest, (_, next_send, _)
+                       in iteritems(self._subscribers) if next_send <= now]
+            if due:
+                record = self._make_record()
+                for dest in due:
+                    try:
+                        sock.sendto(record, dest)
+                    except OSError as ex:
+                        self.log.debug("Can't send telemetry to %s:%d: %s",
+                                       dest[0], dest[1], str(ex))
+            with self._lock:
+                for dest in due:
+                    subscriber = self._subscribers.get(dest)
+                    if subscriber is not None:
+                        # Don't try to catch up if we fell behind
+                        subscriber[1] = max(subscriber[1] + subscriber[0], now)
+                next_send = min(
+                    [subscriber[1] for subscriber in self._subscribers.values()]
+                    + [now + self.POLL_INTERVAL])
+            self._wakeup.wait(max(next_send - time.monotonic(), 0))
+            self._wakeup.clear()
+        sock.close()
+
+    def _make_record(self):
+        """
+        Read the values, and pack them into a record
+        """
+        timestamp_ns = int(time.time() * 1e9)
+        try:
+            values = self._get_values()
+        except Exception as ex:
+            self.log.debug("Can't read telemetry values: %s", str(ex))
+            values = {}
+        record = pack_record(self._seq, timestamp_ns, values)
+        self._seq = (self._seq + 1) & 0xFFFFFFFF
+        return record
@@ -92,12 +92,17 @@ class XportMgrUDP:
             self.log.info("No CHDR interfaces found!")
         return valid_iface_infos_filtered
 
-    def _update_dispatchers(self):
+    def _update_dispatchers(self, forward_policy=None):
         """
         Updates the self._eth_dispatchers dictionary, makes sure that all IP
-        addresses are programmed correctly.
+        addresses are programmed correctly. Every dispatcher is configured in
+        a single pass (see EthDispatcherCtrl.configure()).
 
         After calling this, _chdr_ifaces and _eth_dispatchers are in sync.
+
+        Arguments:
+        forward_policy -- Tuple (forward_eth, forward_bcast) to program into
+                          all dispatchers, or None to leave the policy as is
         """
         if self._bridge_mode:
             bridge_iface = list(self._chdr_ifaces.keys())[0]
@@ -113,13 +118,11 @@ class XportMgrUDP:
             }
             for dispatcher, table in iteritems(self._eth_dispatchers):
                 self.log.info("this dispatcher: {}".format(dispatcher))
-                table.set_ipv4_addr(
+                table.configure(
                     self._chdr_ifaces[bridge_iface]['ip_addr'],
-                    self._bridge_mode
-                )
-                table.set_bridge_mode(self._bridge_mode)
-                table.set_bridge_mac_addr(
-                    self._chdr_ifaces[bridge_iface]['mac_addr']
+                    bridge_mode=True,
+                    bridge_mac_addr=self._chdr_ifaces[bridge_iface]['mac_addr'],
+                    forward_policy=forward_policy,
                 )
         else:
             ifaces_to_remove = [
@@ -135,13 +138,18 @@ class XportMgrUDP:
                 if iface not in self._eth_dispatchers:
                     self._eth_dispatchers[iface] = \
                         self.eth_dispatcher_cls(self.iface_config[iface]['label'])
-                self._eth_dispatchers[iface].set_ipv4_addr(
-                    self._chdr_ifaces[iface]['ip_addr']
-                )
+                internal_iface = None
                 if self.iface_config[iface]['type'] == 'internal':
                     #TODO: Get MAC address from EEPROM
-                    internal_ip_addr = self.get_fpga_internal_ip_address(iface)
-                    self._eth_dispatchers[iface].setup_internal_interface(self.get_fpga_int_mac_address(iface), internal_ip_addr)
+                    internal_iface = (
+                        self.get_fpga_int_mac_address(iface),
+                        self.get_fpga_internal_ip_address(iface),
+                    )
+                self._eth_dispatchers[iface].configure(
+                    self._chdr_ifaces[iface]['ip_addr'],
+                    forward_policy=forward_policy,
+                    internal_iface=internal_iface,
+                )
 
     def init(self, args):
         """
@@ -150,16 +158,15 @@ class XportMgrUDP:
         self._chdr_ifaces = self._init_interfaces(self._possible_chdr_ifaces)
         if "bridge_mode" in args:
             self._bridge_mode = args.get("bridge_mode")
-        self._update_dispatchers()
+        forward_policy = None
         if self._bridge_mode:
-            for _, table in iteritems(self._eth_dispatchers):
-                table.set_forward_policy(True, False)
+            forward_policy = (True, False)
         elif 'forward_eth' in args or 'forward_bcast' in args:
-            for _, table in iteritems(self._eth_dispatchers):
-                table.set_forward_policy(
-                    args.get('forward_eth', False),
-                    args.get('forward_bcast', False)
-                )
+            forward_policy = (
+                args.get('forward_eth', False),
+                args.get('forward_bcast', False)
+            )
+        self._update_dispatchers(forward_policy)
 
     def deinit(self):
         " Clean up after a session terminates "
@@ -16,6 +16,7 @@ extern "C" {
 
 #include <glib.h>
 #include <epan/packet.h>
+#include <wiretap/wtap.h>
 
 #ifdef __cplusplus
 }
@@ -716,4 +717,6 @@ void proto_reg_handoff_rfnoc(void)
 
     rfnoc_handle = create_dissector_handle(dissect_rfnoc, proto_rfnoc);
     dissector_add_uint_with_preference("udp.port", current_port, rfnoc_handle);
+    /* Captures of the UHD link layer (pcap_file device arg) */
+    dissector_add_uint("wtap_encap", WTAP_ENCAP_USER0, rfnoc_handle);
 }